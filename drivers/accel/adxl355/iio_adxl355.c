@@ -55,6 +55,7 @@
 #define ACCEL_AXIS_X (uint32_t) 0
 #define ACCEL_AXIS_Y (uint32_t) 1
 #define ACCEL_AXIS_Z (uint32_t) 2
+#define ADXL355_FIFO_MAX_SETS	32
 
 static const int adxl355_iio_odr_table[11][2] = {
 	{4000, 0},
@@ -987,6 +988,43 @@ static int adxl355_iio_update_channels(void* dev, uint32_t mask)
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Drains the FIFO in one transaction and writes all the complete
+ *        sample sets to the buffer.
+ *
+ * @param dev_data  - The iio device data structure.
+ * @param adxl355   - The device structure.
+ *
+ * @return ret - Result of the handling procedure.
+*******************************************************************************/
+static int32_t adxl355_fifo_trigger_handler(struct iio_device_data *dev_data,
+		struct adxl355_dev *adxl355)
+{
+	uint32_t raw_x[ADXL355_FIFO_MAX_SETS];
+	uint32_t raw_y[ADXL355_FIFO_MAX_SETS];
+	uint32_t raw_z[ADXL355_FIFO_MAX_SETS];
+	uint32_t vals[3];
+	uint8_t entries;
+	uint8_t j;
+	int ret;
+
+	ret = adxl355_get_raw_fifo_data(adxl355, &entries, raw_x, raw_y, raw_z);
+	if (ret)
+		return ret;
+
+	for (j = 0; j < entries / 3; j++) {
+		vals[0] = no_os_sign_extend32(raw_x[j], 19);
+		vals[1] = no_os_sign_extend32(raw_y[j], 19);
+		vals[2] = no_os_sign_extend32(raw_z[j], 19);
+
+		ret = iio_buffer_push_vals(dev_data->buffer, vals);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Handles trigger: reads one data-set and writes it to the buffer.
  *
@@ -997,9 +1035,8 @@ static int adxl355_iio_update_channels(void* dev, uint32_t mask)
 *******************************************************************************/
 static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 {
-	int32_t data_buff[3];
+	uint32_t vals[3];
 	uint32_t x,y,z;
-	uint8_t i = 0;
 
 	struct adxl355_iio_dev *iio_adxl355;
 	struct adxl355_dev *adxl355;
@@ -1014,22 +1051,16 @@ static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 
 	adxl355 = iio_adxl355->adxl355_dev;
 
+	if (iio_adxl355->fifo_watermark)
+		return adxl355_fifo_trigger_handler(dev_data, adxl355);
+
 	adxl355_get_raw_xyz(adxl355, &x, &y, &z);
 
-	if (dev_data->buffer->active_mask & NO_OS_BIT(0)) {
-		data_buff[0] = no_os_sign_extend32(x, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(1)) {
-		data_buff[i] = no_os_sign_extend32(y, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(2)) {
-		data_buff[i] = no_os_sign_extend32(z, 19);
-		i++;
-	}
+	vals[0] = no_os_sign_extend32(x, 19);
+	vals[1] = no_os_sign_extend32(y, 19);
+	vals[2] = no_os_sign_extend32(z, 19);
 
-	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+	return iio_buffer_push_vals(dev_data->buffer, vals);
 }
 
 /***************************************************************************//**
@@ -1065,6 +1096,28 @@ int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	// Map the FIFO watermark to INT1 instead of data ready
+	if (init_param->fifo_watermark) {
+		union adxl355_int_mask int_map = { .value = 0 };
+
+		if (init_param->fifo_watermark > ADXL355_FIFO_MAX_SETS) {
+			ret = -EINVAL;
+			goto error_config;
+		}
+
+		ret = adxl355_set_fifo_samples(desc->adxl355_dev,
+					       init_param->fifo_watermark * 3);
+		if (ret)
+			goto error_config;
+
+		int_map.fields.FULL_EN1 = 1;
+		ret = adxl355_config_int_pins(desc->adxl355_dev, int_map);
+		if (ret)
+			goto error_config;
+
+		desc->fifo_watermark = init_param->fifo_watermark;
+	}
+
 	// Set operation mode
 	ret = adxl355_set_op_mode(desc->adxl355_dev, ADXL355_MEAS_TEMP_ON_DRDY_ON);
 	if (ret)
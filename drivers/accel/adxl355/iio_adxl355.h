@@ -59,10 +59,14 @@ struct adxl355_iio_dev {
 	int adxl355_hpf_3db_table[7][2];
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+	uint8_t fifo_watermark;
 };
 
 struct adxl355_iio_dev_init_param {
 	struct adxl355_init_param *adxl355_dev_init;
+	/** Number of sample sets after which INT1 fires, 0 to trigger on each
+	 *  data ready. When set, the trigger handler drains the whole FIFO. */
+	uint8_t fifo_watermark;
 };
 
 /******************************************************************************/
@@ -41,8 +41,11 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include "adxl362.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -185,6 +188,74 @@ void adxl362_get_fifo_value(struct adxl362_dev *dev,
 		buffer[index] = spi_buffer[index + 1];
 }
 
+/***************************************************************************//**
+ * @brief Drains all the FIFO entries in a single SPI transfer and unpacks
+ *        them into x, y, z sample sets. Temperature entries are skipped.
+ *
+ * @param dev  - The device structure.
+ * @param x    - X axis samples, 171 entries large.
+ * @param y    - Y axis samples, 171 entries large.
+ * @param z    - Z axis samples, 171 entries large.
+ * @param sets - Number of complete x, y, z sample sets read.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t adxl362_get_fifo_xyz(struct adxl362_dev *dev,
+			     int16_t *x,
+			     int16_t *y,
+			     int16_t *z,
+			     uint16_t *sets)
+{
+	uint16_t nx = 0, ny = 0, nz = 0;
+	uint16_t entries, entry;
+	uint8_t reg[2] = {0};
+	int16_t val;
+	uint16_t i;
+	int32_t ret;
+
+	adxl362_get_register_value(dev, reg, ADXL362_REG_FIFO_L, 2);
+	entries = ((reg[1] & 0x3) << 8) | reg[0];
+	if (entries > ADXL362_FIFO_MAX_ENTRIES)
+		return -EIO;
+
+	*sets = 0;
+	if (!entries)
+		return 0;
+
+	memset(dev->fifo_buffer, 0, entries * 2 + 1);
+	dev->fifo_buffer[0] = ADXL362_WRITE_FIFO;
+	ret = no_os_spi_write_and_read(dev->spi_desc, dev->fifo_buffer,
+				       entries * 2 + 1);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < entries; i++) {
+		entry = no_os_get_unaligned_le16(&dev->fifo_buffer[1 + i * 2]);
+		/* 12 bit data sign extended over bits 13:12 */
+		val = no_os_sign_extend32(entry & 0x3FFF, 13);
+
+		switch (ADXL362_FIFO_ENTRY_CH(entry)) {
+		case ADXL362_FIFO_CH_X:
+			x[nx++] = val;
+			break;
+		case ADXL362_FIFO_CH_Y:
+			if (ny < nx)
+				y[ny++] = val;
+			break;
+		case ADXL362_FIFO_CH_Z:
+			if (nz < ny)
+				z[nz++] = val;
+			break;
+		default:
+			break;
+		}
+	}
+
+	*sets = nz;
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Resets the device via SPI communication bus.
  *
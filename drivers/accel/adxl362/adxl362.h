@@ -124,6 +124,14 @@
 #define ADXL362_FIFO_STREAM             2
 #define ADXL362_FIFO_TRIGGERED          3
 
+/* FIFO entry format */
+#define ADXL362_FIFO_MAX_ENTRIES        512
+#define ADXL362_FIFO_ENTRY_CH(x)        (((x) >> 14) & 0x3)
+#define ADXL362_FIFO_CH_X               0
+#define ADXL362_FIFO_CH_Y               1
+#define ADXL362_FIFO_CH_Z               2
+#define ADXL362_FIFO_CH_TEMP            3
+
 /* ADXL362_REG_INTMAP1 */
 #define ADXL362_INTMAP1_INT_LOW         (1 << 7)
 #define ADXL362_INTMAP1_AWAKE           (1 << 6)
@@ -205,6 +213,8 @@ struct adxl362_dev {
 	struct no_os_spi_desc	*spi_desc;
 	/** Measurement Range: */
 	uint8_t		selected_range;
+	/** FIFO read buffer: command byte followed by 512 two byte entries. */
+	uint8_t		fifo_buffer[1 + ADXL362_FIFO_MAX_ENTRIES * 2];
 };
 
 /**
@@ -244,6 +254,13 @@ void adxl362_get_fifo_value(struct adxl362_dev *dev,
 			    uint8_t *buffer,
 			    uint16_t bytes_number);
 
+/*! Drains the FIFO in one transfer and unpacks the x, y, z sample sets. */
+int32_t adxl362_get_fifo_xyz(struct adxl362_dev *dev,
+			     int16_t *x,
+			     int16_t *y,
+			     int16_t *z,
+			     uint16_t *sets);
+
 /*! Resets the device via SPI communication bus. */
 void adxl362_software_reset(struct adxl362_dev *dev);
 
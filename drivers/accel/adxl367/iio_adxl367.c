@@ -52,6 +52,11 @@
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
+/* 512 FIFO entries, 4 entries per x, y, z, temperature set */
+#define ADXL367_FIFO_MAX_SETS		128
+/* The watermark is given in entries, fifo_setup() takes 8 bits */
+#define ADXL367_FIFO_MAX_WATERMARK	(0xFF / 4)
+
 static const int adxl367_iio_odr_table[6][2] = {
 	{12, 500000},
 	{25,      0},
@@ -67,6 +72,7 @@ static const int adxl367_iio_scale_table[3][2] = {
 	{0, 9577975}
 };
 
+static int32_t adxl367_trigger_handler(struct iio_device_data *dev_data);
 static struct iio_device adxl367_iio_dev;
 
 /******************************************************************************/
@@ -715,6 +721,90 @@ static int adxl367_iio_read_samples(void* dev, int* buff, uint32_t samples)
 	return samples;
 }
 
+/***************************************************************************//**
+ * @brief Drains the FIFO in one transaction and writes all the complete
+ *        sample sets to the buffer.
+ *
+ * @param dev_data  - The iio device data structure.
+ * @param adxl367   - The device structure.
+ *
+ * @return ret - Result of the handling procedure.
+*******************************************************************************/
+static int32_t adxl367_fifo_trigger_handler(struct iio_device_data *dev_data,
+		struct adxl367_dev *adxl367)
+{
+	int16_t x[ADXL367_FIFO_MAX_SETS];
+	int16_t y[ADXL367_FIFO_MAX_SETS];
+	int16_t z[ADXL367_FIFO_MAX_SETS];
+	int16_t temp[ADXL367_FIFO_MAX_SETS];
+	uint32_t vals[4];
+	uint16_t entries, j;
+	int ret;
+
+	ret = adxl367_read_raw_fifo(adxl367, x, y, z, temp, &entries);
+	if (ret)
+		return ret;
+
+	for (j = 0; j < entries / 4; j++) {
+		vals[0] = x[j];
+		vals[1] = y[j];
+		vals[2] = z[j];
+		vals[3] = temp[j];
+
+		ret = iio_buffer_push_vals(dev_data->buffer, vals);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Handles trigger: reads one data-set, or the whole FIFO if a
+ *        watermark is configured, and writes it to the buffer.
+ *
+ * @param dev_data  - The iio device data structure.
+ *
+ * @return ret - Result of the handling procedure.
+*******************************************************************************/
+static int32_t adxl367_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct adxl367_iio_dev *iio_adxl367;
+	struct adxl367_dev *adxl367;
+	uint32_t vals[4];
+	int16_t x, y, z, temp;
+	int ret;
+
+	if (!dev_data)
+		return -EINVAL;
+
+	iio_adxl367 = (struct adxl367_iio_dev *)dev_data->dev;
+
+	if (!iio_adxl367->adxl367_dev)
+		return -EINVAL;
+
+	adxl367 = iio_adxl367->adxl367_dev;
+
+	if (iio_adxl367->fifo_watermark)
+		return adxl367_fifo_trigger_handler(dev_data, adxl367);
+
+	ret = adxl367_get_raw_xyz(adxl367, &x, &y, &z);
+	if (ret)
+		return ret;
+
+	vals[0] = x;
+	vals[1] = y;
+	vals[2] = z;
+	if (dev_data->buffer->active_mask & NO_OS_BIT(3)) {
+		ret = adxl367_read_raw_temp(adxl367, &temp);
+		if (ret)
+			return ret;
+		vals[3] = temp;
+	}
+
+	return iio_buffer_push_vals(dev_data->buffer, vals);
+}
+
 /***************************************************************************//**
  * @brief Initializes the ADXL367 IIO driver
  *
@@ -751,6 +841,28 @@ int adxl367_iio_init(struct adxl367_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	// Stream x, y, z and temperature through the FIFO, watermark on INT1
+	if (init_param->fifo_watermark) {
+		struct adxl367_int_map int_map = { .fifo_watermark = 1 };
+
+		if (init_param->fifo_watermark > ADXL367_FIFO_MAX_WATERMARK) {
+			ret = -EINVAL;
+			goto error_config;
+		}
+
+		ret = adxl367_fifo_setup(desc->adxl367_dev, ADXL367_STREAM_MODE,
+					 ADXL367_FIFO_FORMAT_XYZT,
+					 init_param->fifo_watermark * 4);
+		if (ret)
+			goto error_config;
+
+		ret = adxl367_int_map(desc->adxl367_dev, &int_map, 1);
+		if (ret)
+			goto error_config;
+
+		desc->fifo_watermark = init_param->fifo_watermark;
+	}
+
 	// Enter measure mode
 	ret = adxl367_set_power_mode(desc->adxl367_dev, ADXL367_OP_MEASURE);
 	if (ret)
@@ -893,6 +1005,7 @@ static struct iio_device adxl367_iio_dev = {
 	.num_ch = NO_OS_ARRAY_SIZE(adxl367_channels),
 	.channels = adxl367_channels,
 	.pre_enable = (int32_t (*)())adxl367_iio_update_channels,
+	.trigger_handler = (int32_t (*)())adxl367_trigger_handler,
 	.read_dev = (int32_t (*)())adxl367_iio_read_samples,
 	.debug_reg_read = (int32_t (*)())adxl367_iio_read_reg,
 	.debug_reg_write = (int32_t (*)())adxl367_iio_write_reg
@@ -43,6 +43,12 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include "iio.h"
+#include "no_os_irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+extern struct iio_trigger adxl367_iio_trig_desc;
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -52,10 +58,14 @@ struct adxl367_iio_dev {
 	struct iio_device *iio_dev;
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+	uint8_t fifo_watermark;
 };
 
 struct adxl367_iio_init_param {
 	struct adxl367_init_param *adxl367_initial_param;
+	/** Number of sample sets after which INT1 fires, 0 to trigger on each
+	 *  data ready. When set, the trigger handler drains the whole FIFO. */
+	uint8_t fifo_watermark;
 };
 
 /******************************************************************************/
@@ -40,24 +40,25 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <string.h>
 #include "ad74413r.h"
 #include "no_os_crc8.h"
 #include "no_os_delay.h"
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_regmap.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
-#define AD74413R_FRAME_SIZE 		4
 #define AD74413R_CRC_POLYNOMIAL 	0x7
 #define AD74413R_DIN_DEBOUNCE_LEN 	NO_OS_BIT(5)
 
 /******************************************************************************/
 /************************ Variable Declarations ******************************/
 /******************************************************************************/
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+static const uint8_t *_crc_table;
 
 static const unsigned int ad74413r_debounce_map[AD74413R_DIN_DEBOUNCE_LEN] = {
 	0,     13,    18,    24,    32,    42,    56,    75,
@@ -245,14 +246,71 @@ int ad74413r_reg_read_raw(struct ad74413r_desc *desc, uint32_t addr,
 }
 
 /**
- * @brief Write a register's value
- * @param desc  - The device structure.
+ * @brief Read the raw frames of several registers in one SPI transfer. Each
+ * frame writes READ_SELECT for the next register while returning the one
+ * selected by the previous frame, so nb registers take nb + 1 frames instead
+ * of 2 * nb.
+ * @param desc - The device structure.
+ * @param addr - The registers' addresses.
+ * @param nb - The number of registers, at most AD74413R_BURST_MAX.
+ * @param frames - The raw comm frames, AD74413R_FRAME_SIZE bytes each.
+ * @return 0 in case of success, -EINVAL on a CRC error, negative error
+ * 	   otherwise.
+ */
+int ad74413r_reg_read_burst_raw(struct ad74413r_desc *desc,
+				const uint8_t *addr, uint32_t nb,
+				uint8_t *frames)
+{
+	uint8_t tx[(AD74413R_BURST_MAX + 1) * AD74413R_FRAME_SIZE];
+	uint8_t first[AD74413R_FRAME_SIZE];
+	struct no_os_spi_msg msgs[AD74413R_BURST_MAX + 1] = { 0 };
+	uint8_t *frame;
+	uint32_t i;
+	int ret;
+
+	if (!nb || nb > AD74413R_BURST_MAX)
+		return -EINVAL;
+
+	for (i = 0; i <= nb; i++) {
+		if (i < nb)
+			ad74413r_format_reg_write(AD74413R_READ_SELECT, addr[i],
+						  &tx[i * AD74413R_FRAME_SIZE]);
+		else
+			ad74413r_format_reg_write(AD74413R_NOP, AD74413R_NOP,
+						  &tx[i * AD74413R_FRAME_SIZE]);
+
+		msgs[i].tx_buff = &tx[i * AD74413R_FRAME_SIZE];
+		msgs[i].rx_buff = i ? &frames[(i - 1) * AD74413R_FRAME_SIZE] :
+				  first;
+		msgs[i].bytes_number = AD74413R_FRAME_SIZE;
+		/* SYNC must go high after each frame */
+		msgs[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, msgs, nb + 1);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb; i++) {
+		frame = &frames[i * AD74413R_FRAME_SIZE];
+		if (no_os_crc8(_crc_table, frame, 3, 0) != frame[3])
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write a register's value over SPI, bypassing the register cache
+ * @param dev - The device structure.
  * @param addr - The register's address.
  * @param val - The register's value.
  * @return 0 in case of success, negative error otherwise
  */
-int ad74413r_reg_write(struct ad74413r_desc *desc, uint32_t addr, uint16_t val)
+static int ad74413r_bus_write(void *dev, uint32_t addr, uint32_t val)
 {
+	struct ad74413r_desc *desc = dev;
+
 	ad74413r_format_reg_write(addr, val, desc->comm_buff);
 
 	return no_os_spi_write_and_read(desc->comm_desc, desc->comm_buff,
@@ -260,16 +318,17 @@ int ad74413r_reg_write(struct ad74413r_desc *desc, uint32_t addr, uint16_t val)
 }
 
 /**
- * @brief Read a register's value
- * @param desc  - The device structure.
+ * @brief Read a register's value over SPI, bypassing the register cache
+ * @param dev - The device structure.
  * @param addr - The register's address.
  * @param val - The register's read value.
  * @return 0 in case of success, negative error otherwise
  */
-int ad74413r_reg_read(struct ad74413r_desc *desc, uint32_t addr, uint16_t *val)
+static int ad74413r_bus_read(void *dev, uint32_t addr, uint32_t *val)
 {
-	int ret;
+	struct ad74413r_desc *desc = dev;
 	uint8_t expected_crc;
+	int ret;
 
 	ret = ad74413r_reg_read_raw(desc, addr, desc->comm_buff);
 	if (ret)
@@ -284,6 +343,68 @@ int ad74413r_reg_read(struct ad74413r_desc *desc, uint32_t addr, uint16_t *val)
 	return 0;
 }
 
+/**
+ * @brief Whether a register may change without being written by the driver.
+ * Only the configuration registers are cached.
+ * @param addr - The register's address.
+ * @return true if the register must always be read from the device.
+ */
+static bool ad74413r_volatile_reg(uint32_t addr)
+{
+	switch (addr) {
+	case AD74413R_CH_FUNC_SETUP(0) ... AD74413R_DIN_CONFIG(3):
+	case AD74413R_GPO_CONFIG(0) ... AD74413R_DAC_CLR_CODE(3):
+	case AD74413R_DIN_THRESH:
+	case AD74413R_DIAG_ASSIGN:
+	case AD74413R_ALERT_MASK:
+		return false;
+	default:
+		return true;
+	}
+}
+
+/**
+ * @brief Write a register's value
+ * @param desc  - The device structure.
+ * @param addr - The register's address.
+ * @param val - The register's value.
+ * @return 0 in case of success, negative error otherwise
+ */
+int ad74413r_reg_write(struct ad74413r_desc *desc, uint32_t addr, uint16_t val)
+{
+	if (desc->regmap)
+		return no_os_regmap_write(desc->regmap, addr, val);
+
+	return ad74413r_bus_write(desc, addr, val);
+}
+
+/**
+ * @brief Read a register's value
+ * @param desc  - The device structure.
+ * @param addr - The register's address.
+ * @param val - The register's read value.
+ * @return 0 in case of success, negative error otherwise
+ */
+int ad74413r_reg_read(struct ad74413r_desc *desc, uint32_t addr, uint16_t *val)
+{
+	uint32_t reg_val;
+	int ret;
+
+	if (!desc->regmap) {
+		ret = ad74413r_bus_read(desc, addr, &reg_val);
+		if (ret)
+			return ret;
+	} else {
+		ret = no_os_regmap_read(desc->regmap, addr, &reg_val);
+		if (ret)
+			return ret;
+	}
+
+	*val = reg_val;
+
+	return 0;
+}
+
 /**
  * @brief Update a register's field.
  * @param desc  - The device structure.
@@ -299,6 +420,10 @@ int ad74413r_reg_update(struct ad74413r_desc *desc, uint32_t addr,
 	int ret;
 	uint16_t c_val;
 
+	if (desc->regmap)
+		return no_os_regmap_update_bits(desc->regmap, addr, mask,
+						no_os_field_prep(mask, val));
+
 	ret = ad74413r_reg_read(desc, addr, &c_val);
 	if (ret)
 		return ret;
@@ -414,9 +539,46 @@ int ad74413r_reset(struct ad74413r_desc *desc)
 	/* Time taken for device reset (datasheet value = 1ms) */
 	no_os_mdelay(1);
 
+	if (desc->regmap)
+		return no_os_regmap_cache_drop(desc->regmap);
+
 	return 0;
 }
 
+/**
+ * @brief Compute the fixed point ADC scale of a channel, for the range of its
+ * current function. The resistance measurement is not linear and has none.
+ * @param desc - The device structure.
+ * @param ch - The channel index.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad74413r_adc_scale_update(struct ad74413r_desc *desc, uint32_t ch)
+{
+	struct no_os_scale *scale = &desc->adc_scale[ch];
+
+	switch (desc->channel_configs[ch].function) {
+	case AD74413R_VOLTAGE_OUT:
+		/* uA */
+		return no_os_scale_set(scale, AD74413R_RANGE_5V_SCALE * 1000,
+				       AD74413R_RSENSE * AD74413R_RANGE_5V_SCALE_DIV,
+				       AD74413R_RANGE_5V_OFFSET);
+	case AD74413R_CURRENT_IN_EXT:
+	case AD74413R_CURRENT_IN_LOOP:
+	case AD74413R_CURRENT_IN_EXT_HART:
+	case AD74413R_CURRENT_IN_LOOP_HART:
+		/* uA */
+		return no_os_scale_set(scale, AD74413R_RANGE_2V5_SCALE * 1000,
+				       AD74413R_RANGE_2V5_SCALE_DIV * AD74413R_RSENSE,
+				       0);
+	case AD74413R_RESISTANCE:
+		return 0;
+	default:
+		/* uV */
+		return no_os_scale_set(scale, AD74413R_RANGE_10V_SCALE * 1000,
+				       AD74413R_RANGE_10V_SCALE_DIV, 0);
+	}
+}
+
 /**
  * @brief Set the operation mode for a specific channel
  * @param desc - The device structure.
@@ -455,7 +617,7 @@ int ad74413r_set_channel_function(struct ad74413r_desc *desc,
 
 	desc->channel_configs[ch].function = ch_func;
 
-	return 0;
+	return ad74413r_adc_scale_update(desc, ch);
 }
 
 /**
@@ -700,6 +862,61 @@ int ad74413r_set_adc_conv_seq(struct ad74413r_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Start reading a continuous conversion sequence: the next
+ * ad74413r_scan_read() reads all the registers of the scan.
+ * @param scan - The scan, with addr, decimation and nb set.
+ */
+void ad74413r_scan_reset(struct ad74413r_scan *scan)
+{
+	memset(scan->skip, 0, sizeof(scan->skip));
+}
+
+/**
+ * @brief Read the registers of a scan that are due, in a single burst, after
+ * an ADC_RDY of a continuous conversion sequence. The frames of the decimated
+ * registers that are not due are left as read last time.
+ * @param desc - The device structure.
+ * @param scan - The scan, its frames are updated.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74413r_scan_read(struct ad74413r_desc *desc, struct ad74413r_scan *scan)
+{
+	uint8_t frames[AD74413R_BURST_MAX][AD74413R_FRAME_SIZE];
+	uint8_t addr[AD74413R_BURST_MAX];
+	uint8_t idx[AD74413R_BURST_MAX];
+	uint32_t i, n = 0;
+	int ret;
+
+	if (scan->nb > AD74413R_BURST_MAX)
+		return -EINVAL;
+
+	for (i = 0; i < scan->nb; i++) {
+		if (scan->skip[i]) {
+			scan->skip[i]--;
+			continue;
+		}
+
+		addr[n] = scan->addr[i];
+		idx[n++] = i;
+	}
+
+	if (!n)
+		return 0;
+
+	ret = ad74413r_reg_read_burst_raw(desc, addr, n, &frames[0][0]);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < n; i++) {
+		memcpy(scan->frames[idx[i]], frames[i], AD74413R_FRAME_SIZE);
+		if (scan->decimation[idx[i]] > 1)
+			scan->skip[idx[i]] = scan->decimation[idx[i]] - 1;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Get a single ADC raw value for a specific channel, then power down the ADC.
  * @param desc - The device structure.
@@ -837,6 +1054,39 @@ int ad74413r_adc_get_value(struct ad74413r_desc *desc, uint32_t ch,
 	return 0;
 }
 
+/**
+ * @brief Convert a buffer of ADC codes of a channel, using the fixed point scale
+ * precomputed when the channel function was set, instead of dividing each
+ * sample as ad74413r_adc_get_value() does.
+ * @param desc - The device structure.
+ * @param ch - The channel index.
+ * @param codes - The ADC codes.
+ * @param val - The values in uV or uA, depending on the operation mode. May be
+ * the same memory as codes.
+ * @param nb - The number of codes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74413r_adc_codes_to_value(struct ad74413r_desc *desc, uint32_t ch,
+				const int32_t *codes, int32_t *val, uint32_t nb)
+{
+	if (!desc || ch >= AD74413R_N_CHANNELS)
+		return -EINVAL;
+
+	switch (desc->channel_configs[ch].function) {
+	case AD74413R_RESISTANCE:
+		return -ENOTSUP;
+	case AD74413R_CURRENT_IN_EXT_HART:
+	case AD74413R_CURRENT_IN_LOOP_HART:
+		if (desc->chip_id == AD74412R)
+			return -ENOTSUP;
+		break;
+	default:
+		break;
+	}
+
+	return no_os_scale_buffer(&desc->adc_scale[ch], codes, val, nb);
+}
+
 /**
  * @brief Read the die's temperature from the diagnostic register.
  * @param desc - The device structure.
@@ -1177,6 +1427,7 @@ int ad74413r_init(struct ad74413r_desc **desc,
 		  struct ad74413r_init_param *init_param)
 {
 	int ret;
+	uint32_t i;
 	struct ad74413r_desc *descriptor;
 
 	if (!init_param)
@@ -1190,13 +1441,32 @@ int ad74413r_init(struct ad74413r_desc **desc,
 	if (ret)
 		goto err;
 
-	no_os_crc8_populate_msb(_crc_table, AD74413R_CRC_POLYNOMIAL);
+	_crc_table = no_os_crc8_get_table(AD74413R_CRC_POLYNOMIAL);
+	if (!_crc_table) {
+		ret = -ENOMEM;
+		goto comm_err;
+	}
 
 	ret = no_os_gpio_get_optional(&descriptor->reset_gpio,
 				      init_param->reset_gpio_param);
 	if (ret)
 		goto comm_err;
 
+	if (init_param->reg_cache) {
+		struct no_os_regmap_config regmap_config = {
+			.max_reg = AD74413R_SILICON_REV,
+			.mode = NO_OS_REGMAP_WRITE_THROUGH,
+			.volatile_reg = ad74413r_volatile_reg,
+			.reg_read = ad74413r_bus_read,
+			.reg_write = ad74413r_bus_write,
+			.dev = descriptor,
+		};
+
+		ret = no_os_regmap_init(&descriptor->regmap, regmap_config);
+		if (ret)
+			goto free_reset;
+	}
+
 	ret = ad74413r_reset(descriptor);
 	if (ret)
 		goto free_reset;
@@ -1211,11 +1481,19 @@ int ad74413r_init(struct ad74413r_desc **desc,
 
 	descriptor->chip_id = init_param->chip_id;
 
+	/* All the channels are high impedance after reset */
+	for (i = 0; i < AD74413R_N_CHANNELS; i++) {
+		ret = ad74413r_adc_scale_update(descriptor, i);
+		if (ret)
+			goto free_reset;
+	}
+
 	*desc = descriptor;
 
 	return 0;
 
 free_reset:
+	no_os_regmap_remove(descriptor->regmap);
 	no_os_gpio_remove(descriptor->reset_gpio);
 comm_err:
 	no_os_spi_remove(descriptor->comm_desc);
@@ -1252,6 +1530,7 @@ int ad74413r_remove(struct ad74413r_desc *desc)
 	if (ret)
 		return ret;
 
+	no_os_regmap_remove(desc->regmap);
 	no_os_free(desc);
 
 	return 0;
@@ -43,6 +43,7 @@
 #include "stdbool.h"
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_scale.h"
 
 #define AD74413R_N_CHANNELS             4
 #define AD74413R_N_DIAG_CHANNELS	4
@@ -155,6 +156,11 @@
 #define AD74413R_ADC_RESOLUTION			16
 #define AD74413R_ADC_CODE_MAX			65536
 
+/** Maximum number of registers read by ad74413r_reg_read_burst_raw() */
+#define AD74413R_BURST_MAX			(AD74413R_N_CHANNELS + \
+						 AD74413R_N_DIAG_CHANNELS)
+#define AD74413R_FRAME_SIZE			4
+
 /** The number of possible DAC values */
 #define AD74413R_THRESHOLD_DAC_RANGE		29
 /** The comparator's value can be set betwen 0 - 16 V*/
@@ -303,6 +309,8 @@ struct ad74413r_init_param {
 	enum ad74413r_chip_id chip_id;
 	struct no_os_spi_init_param comm_param;
 	struct no_os_gpio_init_param *reset_gpio_param;
+	/** Cache the configuration registers, saving the reads of updates */
+	bool reg_cache;
 };
 
 /**
@@ -349,6 +357,26 @@ union ad74413r_live_status {
 	uint16_t value;
 };
 
+/**
+ * @brief Registers read together on each ADC_RDY of a continuous conversion
+ * sequence by ad74413r_scan_read().
+ */
+struct ad74413r_scan {
+	/** Registers to read, in scan order */
+	uint8_t addr[AD74413R_BURST_MAX];
+	/**
+	 * Read a register on one sequence out of decimation[i], its last frame
+	 * is kept in between. 0 and 1 read it on every sequence.
+	 */
+	uint16_t decimation[AD74413R_BURST_MAX];
+	/** Number of registers */
+	uint32_t nb;
+	/** Last frame read for each register */
+	uint8_t frames[AD74413R_BURST_MAX][AD74413R_FRAME_SIZE];
+	/** Sequences left until each register is read again */
+	uint16_t skip[AD74413R_BURST_MAX];
+};
+
 /**
  * @brief AD74413r device descriptor.
  */
@@ -358,6 +386,10 @@ struct ad74413r_desc {
 	uint8_t comm_buff[4];
 	struct ad74413r_channel_config channel_configs[AD74413R_N_CHANNELS];
 	struct no_os_gpio_desc *reset_gpio;
+	/** Configuration register cache, NULL if not used */
+	struct no_os_regmap *regmap;
+	/** ADC code to uV or uA, updated with the channel function */
+	struct no_os_scale adc_scale[AD74413R_N_CHANNELS];
 };
 
 /** Converts a millivolt value in the corresponding DAC 13 bit code */
@@ -377,6 +409,16 @@ int ad74413r_reg_read_raw(struct ad74413r_desc *, uint32_t, uint8_t *);
 /** Read a register's value */
 int ad74413r_reg_read(struct ad74413r_desc *, uint32_t, uint16_t *);
 
+/** Read the raw frames of several registers in one SPI transfer */
+int ad74413r_reg_read_burst_raw(struct ad74413r_desc *, const uint8_t *,
+				uint32_t, uint8_t *);
+
+/** Start reading a continuous conversion sequence with ad74413r_scan_read */
+void ad74413r_scan_reset(struct ad74413r_scan *);
+
+/** Read the registers of a scan that are due after an ADC_RDY */
+int ad74413r_scan_read(struct ad74413r_desc *, struct ad74413r_scan *);
+
 /** Update a register's field */
 int ad74413r_reg_update(struct ad74413r_desc *, uint32_t, uint16_t,
 			uint16_t);
@@ -452,6 +494,10 @@ int ad74413r_get_adc_single(struct ad74413r_desc *, uint32_t, uint16_t *, bool);
 int ad74413r_adc_get_value(struct ad74413r_desc *, uint32_t,
 			   struct ad74413r_decimal *);
 
+/** Convert a buffer of ADC codes of a channel to uV or uA, in fixed point */
+int ad74413r_adc_codes_to_value(struct ad74413r_desc *, uint32_t,
+				const int32_t *, int32_t *, uint32_t);
+
 /** Read the die's temperature from the diagnostic register */
 int ad74413r_get_temp(struct ad74413r_desc *, uint32_t, uint16_t *);
 
@@ -169,6 +169,12 @@ static int ad74413r_iio_read_diag_function_avail(void *dev, char *buf,
 		uint32_t len,
 		const struct iio_ch_info *channel,
 		intptr_t priv);
+static int ad74413r_iio_read_decimation(void *dev, char *buf, uint32_t len,
+					const struct iio_ch_info *channel,
+					intptr_t priv);
+static int ad74413r_iio_write_decimation(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t priv);
 static int ad74413r_iio_update_channels(void *dev, uint32_t mask);
 static int ad74413r_iio_buffer_disable(void *dev);
 static int ad74413r_iio_read_samples(void *dev, uint32_t *buf,
@@ -203,6 +209,11 @@ static struct iio_attribute ad74413r_iio_adc_resistance_attrs[] = {
 		.show = ad74413r_iio_read_sampling_freq_avail,
 		.priv = AD74413R_ADC
 	},
+	{
+		.name = "decimation",
+		.show = ad74413r_iio_read_decimation,
+		.store = ad74413r_iio_write_decimation,
+	},
 	{
 		.name = "processed",
 		.show = ad74413r_iio_read_processed
@@ -222,6 +233,11 @@ static struct iio_attribute ad74413r_iio_adc_attrs[] = {
 		.show = ad74413r_iio_read_sampling_freq_avail,
 		.priv = AD74413R_ADC
 	},
+	{
+		.name = "decimation",
+		.show = ad74413r_iio_read_decimation,
+		.store = ad74413r_iio_write_decimation,
+	},
 	{
 		.name = "raw",
 		.show = ad74413r_iio_read_raw,
@@ -295,6 +311,11 @@ static struct iio_attribute ad74413r_iio_digital_attrs[] = {
 		.show = ad74413r_iio_read_sampling_freq_avail,
 		.priv = AD74413R_ADC
 	},
+	{
+		.name = "decimation",
+		.show = ad74413r_iio_read_decimation,
+		.store = ad74413r_iio_write_decimation,
+	},
 	{
 		.name = "raw",
 		.show = ad74413r_iio_read_raw,
@@ -322,6 +343,11 @@ static struct iio_attribute ad74413r_iio_adc_diag_attrs[] = {
 		.show = ad74413r_iio_read_sampling_freq_avail,
 		.priv = AD74413R_DIAG,
 	},
+	{
+		.name = "decimation",
+		.show = ad74413r_iio_read_decimation,
+		.store = ad74413r_iio_write_decimation,
+	},
 	{
 		.name = "diag_function",
 		.show = ad74413r_iio_read_diag_function,
@@ -442,7 +468,7 @@ static int _get_ch_by_idx(struct iio_device *iio_dev, int scan_index,
 			  uint32_t *ch)
 {
 	size_t i;
-	struct iio_channel *chan;
+	const struct iio_channel *chan;
 
 	for (i = 0; i < iio_dev->num_ch; i++) {
 		chan = &iio_dev->channels[i];
@@ -782,6 +808,58 @@ static int ad74413r_iio_read_sampling_freq_avail(void *dev, char *buf,
 	return strlen(buf);
 }
 
+/**
+ * @brief Read the buffer decimation of a specific channel
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return The length of the value in case of success, error code otherwise
+ */
+static int ad74413r_iio_read_decimation(void *dev, char *buf, uint32_t len,
+					const struct iio_ch_info *channel,
+					intptr_t priv)
+{
+	struct ad74413r_iio_desc *iio_desc = dev;
+	int32_t val;
+
+	val = no_os_max(iio_desc->decimation[channel->ch_num], 1);
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Set the buffer decimation of a specific channel: its result is read
+ * on one conversion sequence out of the decimation and repeated in the scans
+ * in between. Applied when the buffer is enabled.
+ * @param dev - The iio device structure.
+ * @param buf - Value to be written to attribute.
+ * @param len - Length of the data in "buf".
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ad74413r_iio_write_decimation(void *dev, char *buf, uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t priv)
+{
+	struct ad74413r_iio_desc *iio_desc = dev;
+	int32_t val;
+	int ret;
+
+	ret = iio_parse_value(buf, IIO_VAL_INT, &val, NULL);
+	if (ret)
+		return ret;
+
+	if (val < 1 || val > UINT16_MAX)
+		return -EINVAL;
+
+	iio_desc->decimation[channel->ch_num] = val;
+
+	return 0;
+}
+
 /**
  * @brief Read the scale attribute for a specific channel
  * @param dev - The iio device structure.
@@ -1357,6 +1435,34 @@ free_channels:
 	return ret;
 }
 
+/**
+ * @brief Add the result register of a channel to the buffer scan.
+ * @param iio_desc - The iio device structure.
+ * @param ch - The channel number, the diagnostics channels come after the
+ * 	       I/O channels.
+ */
+static void ad74413r_iio_scan_add(struct ad74413r_iio_desc *iio_desc,
+				  uint32_t ch)
+{
+	struct ad74413r_scan *scan = &iio_desc->scan;
+	enum ad74413r_op_mode function;
+
+	if (ch < AD74413R_N_CHANNELS) {
+		function = iio_desc->channel_configs[ch].function;
+		if (function == AD74413R_DIGITAL_INPUT ||
+		    function == AD74413R_DIGITAL_INPUT_LOOP)
+			scan->addr[scan->nb] = AD74413R_DIN_COMP_OUT;
+		else
+			scan->addr[scan->nb] = AD74413R_ADC_RESULT(ch);
+	} else {
+		scan->addr[scan->nb] = AD74413R_DIAG_RESULT(ch - AD74413R_N_CHANNELS);
+	}
+
+	scan->decimation[scan->nb] = iio_desc->decimation[ch];
+	iio_desc->scan_ch[scan->nb] = ch;
+	scan->nb++;
+}
+
 /**
  * @brief Enable IIO channels and start the ADC conversions in continuous mode.
  * @param dev - The iio device structure.
@@ -1372,6 +1478,7 @@ static int ad74413r_iio_update_channels(void *dev, uint32_t mask)
 
 	iio_desc->active_channels = mask;
 	iio_desc->no_of_active_channels = no_os_hweight8(mask);
+	iio_desc->scan.nb = 0;
 
 	for (i = 0; i < AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS; i++) {
 		if (mask & NO_OS_BIT(i)) {
@@ -1394,9 +1501,14 @@ static int ad74413r_iio_update_channels(void *dev, uint32_t mask)
 
 			if (ret)
 				return ret;
+
+			ad74413r_iio_scan_add(iio_desc, ch);
 		}
 	}
 
+	ad74413r_scan_reset(&iio_desc->scan);
+
+	/* The sequence is programmed once, ADC_RDY then paces the scans */
 	ret = ad74413r_set_adc_conv_seq(iio_desc->ad74413r_desc, AD74413R_START_CONT);
 	if (ret)
 		return ret;
@@ -1471,7 +1583,8 @@ static int ad74413r_iio_read_samples(void *dev, uint32_t *buf, uint32_t samples)
 }
 
 /**
- * @brief Read a sample for each enabled channel.
+ * @brief Read a sample for each enabled channel, the results of all the
+ * channels due in this conversion sequence are read in a single burst.
  * @param dev_data - The iio device data structure.
  * @return 0 in case of success, an error code otherwise.
  */
@@ -1480,48 +1593,29 @@ static int ad74413r_iio_trigger_handler(struct iio_device_data *dev_data)
 	int ret;
 	uint32_t i;
 	uint32_t ch;
-	uint32_t diag_ch_idx;
 	uint32_t digital_val;
-	uint8_t buff[32] = {0};
-	uint32_t buffer_idx = 0;
+	uint8_t buff[AD74413R_BURST_MAX * AD74413R_FRAME_SIZE] = {0};
+	uint8_t *frame;
 	struct ad74413r_iio_desc *iio_desc;
-	struct ad74413r_channel_config *config;
-	struct ad74413r_desc *desc;
+	struct ad74413r_scan *scan;
 
 	iio_desc = dev_data->dev;
-	desc = iio_desc->ad74413r_desc;
-	config = iio_desc->channel_configs;
+	scan = &iio_desc->scan;
 
-	for (i = 0; i < AD74413R_N_CHANNELS + AD74413R_N_CHANNELS; i++) {
-		if (iio_desc->active_channels & NO_OS_BIT(i)) {
-			ret = _get_ch_by_idx(iio_desc->iio_dev, i, &ch);
-			if (ret)
-				continue;
-
-			if (ch < AD74413R_N_DIAG_CHANNELS) {
-				if (config[ch].function == AD74413R_DIGITAL_INPUT ||
-				    config[ch].function == AD74413R_DIGITAL_INPUT_LOOP) {
-					ret = ad74413r_reg_read_raw(desc, AD74413R_DIN_COMP_OUT,
-								    &buff[buffer_idx]);
-					digital_val = no_os_field_get(AD74413R_DIN_COMP_CH(ch),
-								      buff[buffer_idx + 2]);
-					buff[buffer_idx + 1] = 0x0;
-					buff[buffer_idx + 2] = !!digital_val;
-				} else {
-					ret = ad74413r_reg_read_raw(desc, AD74413R_ADC_RESULT(ch),
-								    &buff[buffer_idx]);
-				}
-			} else {
-				diag_ch_idx = ch - AD74413R_N_DIAG_CHANNELS;
-				ret = ad74413r_reg_read_raw(desc,
-							    AD74413R_DIAG_RESULT(diag_ch_idx),
-							    &buff[buffer_idx]);
-			}
+	ret = ad74413r_scan_read(iio_desc->ad74413r_desc, scan);
+	if (ret)
+		return ret;
 
-			if (ret)
-				return ret;
+	for (i = 0; i < scan->nb; i++) {
+		frame = &buff[i * AD74413R_FRAME_SIZE];
+		memcpy(frame, scan->frames[i], AD74413R_FRAME_SIZE);
 
-			buffer_idx += 4;
+		ch = iio_desc->scan_ch[i];
+		if (scan->addr[i] == AD74413R_DIN_COMP_OUT) {
+			digital_val = no_os_field_get(AD74413R_DIN_COMP_CH(ch),
+						      frame[2]);
+			frame[1] = 0x0;
+			frame[2] = !!digital_val;
 		}
 	}
 
@@ -1593,7 +1687,7 @@ int ad74413r_iio_remove(struct ad74413r_iio_desc *desc)
 	if (ret)
 		return ret;
 
-	no_os_free(desc->iio_dev->channels);
+	no_os_free((void *)desc->iio_dev->channels);
 	no_os_free(desc);
 
 	return 0;
@@ -88,6 +88,12 @@ struct ad74413r_iio_desc {
 	enum ad74413r_conv_seq conv_state;
 	struct ad74413r_diag_channel_config
 		diag_channel_configs[AD74413R_N_DIAG_CHANNELS];
+	/** Per channel decimation of the buffer, by channel number */
+	uint16_t decimation[AD74413R_N_CHANNELS + AD74413R_N_DIAG_CHANNELS];
+	/** Registers read on each ADC_RDY while the buffer is enabled */
+	struct ad74413r_scan scan;
+	/** Channel number of each register of the scan */
+	uint8_t scan_ch[AD74413R_BURST_MAX];
 };
 
 /**
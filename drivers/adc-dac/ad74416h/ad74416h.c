@@ -57,7 +57,7 @@
 /******************************************************************************/
 /************************ Variable Declarations ******************************/
 /******************************************************************************/
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+static const uint8_t *_crc_table;
 
 static const unsigned int ad74416h_debounce_map[AD74416H_DIN_DEBOUNCE_LEN] = {
 	0,     13,    18,    24,    32,    42,    56,    75,
@@ -197,6 +197,62 @@ int ad74416h_reg_read_raw(struct ad74416h_desc *desc, uint32_t addr,
 	return no_os_spi_write_and_read(desc->spi_desc, val, AD74416H_FRAME_SIZE);
 }
 
+/**
+ * @brief Read several registers in one SPI transfer. Each frame writes
+ * READ_SELECT for the next register while returning the one selected by the
+ * previous frame, so nb registers take nb + 1 frames instead of 2 * nb.
+ * @param desc - The device structure.
+ * @param addr - The registers' addresses.
+ * @param val - The registers' values.
+ * @param nb - The number of registers, at most AD74416H_BURST_MAX.
+ * @return 0 in case of success, -EINVAL on a CRC error, negative error
+ * 	   otherwise.
+ */
+int ad74416h_reg_read_burst(struct ad74416h_desc *desc, const uint8_t *addr,
+			    uint16_t *val, uint32_t nb)
+{
+	uint8_t tx[(AD74416H_BURST_MAX + 1) * AD74416H_FRAME_SIZE];
+	uint8_t rx[(AD74416H_BURST_MAX + 1) * AD74416H_FRAME_SIZE];
+	struct no_os_spi_msg msgs[AD74416H_BURST_MAX + 1] = { 0 };
+	uint8_t *frame;
+	uint32_t i;
+	int ret;
+
+	if (!nb || nb > AD74416H_BURST_MAX)
+		return -EINVAL;
+
+	for (i = 0; i <= nb; i++) {
+		if (i < nb)
+			ad74416h_format_reg_write(desc->dev_addr,
+						  AD74416H_READ_SELECT, addr[i],
+						  &tx[i * AD74416H_FRAME_SIZE]);
+		else
+			ad74416h_format_reg_write(desc->dev_addr, AD74416H_NOP,
+						  AD74416H_NOP,
+						  &tx[i * AD74416H_FRAME_SIZE]);
+
+		msgs[i].tx_buff = &tx[i * AD74416H_FRAME_SIZE];
+		msgs[i].rx_buff = &rx[i * AD74416H_FRAME_SIZE];
+		msgs[i].bytes_number = AD74416H_FRAME_SIZE;
+		/* SYNC must go high after each frame */
+		msgs[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->spi_desc, msgs, nb + 1);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb; i++) {
+		frame = &rx[(i + 1) * AD74416H_FRAME_SIZE];
+		if (no_os_crc8(_crc_table, frame, 4, 0) != frame[4])
+			return -EINVAL;
+
+		val[i] = no_os_get_unaligned_be16(&frame[2]);
+	}
+
+	return 0;
+}
+
 /**
  * @brief Write a register's value
  * @param desc  - The device structure.
@@ -294,25 +350,62 @@ int ad74416h_nb_active_channels(struct ad74416h_desc *desc,
 int ad74416h_get_raw_adc_result(struct ad74416h_desc *desc, uint32_t ch,
 				uint32_t *val)
 {
-	uint32_t val_msb, val_lsb;
+	if (ch >= AD74416H_N_CHANNELS)
+		return -EINVAL;
+
+	return ad74416h_get_raw_adc_results(desc, NO_OS_BIT(ch), val);
+}
+
+/**
+ * @brief Read the raw ADC conversion values of several channels, with both
+ * result registers of each channel, in a single SPI transfer.
+ * @param desc - The device structure.
+ * @param ch_mask - The channels to read.
+ * @param val - The ADC raw conversion values, one for each channel of the
+ * 		mask, in channel order.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad74416h_get_raw_adc_results(struct ad74416h_desc *desc, uint8_t ch_mask,
+				 uint32_t *val)
+{
+	uint8_t addr[AD74416H_BURST_MAX];
+	uint16_t regs[AD74416H_BURST_MAX];
+	bool upr = desc->id == ID_AD74416H;
+	uint32_t ch, n = 0, i = 0;
 	int ret;
 
-	if (desc->id == ID_AD74416H) {
-		ret = ad74416h_reg_read(desc, AD74416H_ADC_RESULT_UPR(ch),
-					&val_msb);
-		if (ret)
-			return ret;
+	ch_mask &= NO_OS_GENMASK(AD74416H_N_CHANNELS - 1, 0);
+	if (!ch_mask)
+		return -EINVAL;
+
+	for (ch = 0; ch < AD74416H_N_CHANNELS; ch++) {
+		if (!(ch_mask & NO_OS_BIT(ch)))
+			continue;
+
+		if (upr)
+			addr[n++] = AD74416H_ADC_RESULT_UPR(ch);
+		addr[n++] = AD74416H_ADC_RESULT(ch);
 	}
 
-	ret = ad74416h_reg_read(desc, AD74416H_ADC_RESULT(ch), &val_lsb);
+	ret = ad74416h_reg_read_burst(desc, addr, regs, n);
 	if (ret)
 		return ret;
 
-	if (desc->id == ID_AD74416H)
-		*val = (no_os_field_get(AD74416H_CONV_RES_UPR_MSK, val_msb) << 16) |
-		       no_os_field_get(AD74416H_CONV_RESULT_MSK, val_lsb);
-	else
-		*val = no_os_field_get(AD74416H_CONV_RESULT_MSK, val_lsb);
+	for (n = 0; n < AD74416H_N_CHANNELS; n++) {
+		if (!(ch_mask & NO_OS_BIT(n)))
+			continue;
+
+		if (upr) {
+			*val = (no_os_field_get(AD74416H_CONV_RES_UPR_MSK,
+						regs[i]) << 16) |
+			       no_os_field_get(AD74416H_CONV_RESULT_MSK,
+					       regs[i + 1]);
+			i += 2;
+		} else {
+			*val = no_os_field_get(AD74416H_CONV_RESULT_MSK, regs[i++]);
+		}
+		val++;
+	}
 
 	return 0;
 }
@@ -1014,7 +1107,11 @@ int ad74416h_init(struct ad74416h_desc **desc,
 	descriptor->id = init_param->id;
 	descriptor->dev_addr = init_param->dev_addr;
 
-	no_os_crc8_populate_msb(_crc_table, AD74416H_CRC_POLYNOMIAL);
+	_crc_table = no_os_crc8_get_table(AD74416H_CRC_POLYNOMIAL);
+	if (!_crc_table) {
+		ret = -ENOMEM;
+		goto comm_err;
+	}
 
 	ret = no_os_gpio_get_optional(&descriptor->reset_gpio,
 				      init_param->reset_gpio_param);
@@ -420,6 +420,8 @@
 #define AD74416H_TEMP_SCALE_DIV			1000
 
 #define AD74416H_FRAME_SIZE 			5
+/** Maximum number of registers read by ad74416h_reg_read_burst() */
+#define AD74416H_BURST_MAX			(2 * AD74416H_N_CHANNELS)
 #define AD74416H_THRESHOLD_DAC_RANGE		98
 #define AD74416H_THRESHOLD_RANGE		30000
 #define AD74416H_DAC_RANGE			12000
@@ -661,6 +663,10 @@ int ad74416h_reg_read_raw(struct ad74416h_desc *, uint32_t, uint8_t *);
 /** Read a register's value */
 int ad74416h_reg_read(struct ad74416h_desc *, uint32_t, uint16_t *);
 
+/** Read several registers in one SPI transfer */
+int ad74416h_reg_read_burst(struct ad74416h_desc *, const uint8_t *,
+			    uint16_t *, uint32_t);
+
 /** Update a register's field */
 int ad74416h_reg_update(struct ad74416h_desc *, uint32_t, uint16_t,
 			uint16_t);
@@ -690,6 +696,9 @@ int ad74416h_set_channel_i_limit(struct ad74416h_desc *, uint32_t,
 int ad74416h_get_raw_adc_result(struct ad74416h_desc *, uint32_t,
 				uint32_t *);
 
+/** Read the raw ADC results of several channels in one SPI transfer */
+int ad74416h_get_raw_adc_results(struct ad74416h_desc *, uint8_t, uint32_t *);
+
 /** Enable/disable a specific ADC channel */
 int ad74416h_set_adc_channel_enable(struct ad74416h_desc *, uint32_t,
 				    bool);
@@ -49,6 +49,7 @@
 #endif
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /**
  * @brief Device resolution
@@ -61,6 +62,17 @@ const uint16_t ad400x_device_resol[] = {
 	[ID_ADAQ4003] = 18
 };
 
+/**
+ * @brief Device maximum sample rate, in Hz
+ */
+const uint32_t ad400x_device_sample_rate[] = {
+	[ID_AD4003] = 2000000,
+	[ID_AD4007] = 1000000,
+	[ID_AD4011] = 500000,
+	[ID_AD4020] = 1800000,
+	[ID_ADAQ4003] = 2000000
+};
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -143,6 +155,108 @@ int32_t ad400x_spi_single_conversion(struct ad400x_dev *dev,
 	return ret;
 }
 
+/**
+ * Start timer paced acquisition.
+ *
+ * The PWM drives CNV at sample_rate_hz and its pulse finished interrupt (or
+ * the BUSY falling edge) must call ad400x_stream_trigger(). The result of each
+ * conversion is read by DMA while the next one is already scheduled, 3-wire CS
+ * mode without busy indicator.
+ * @param dev - The device structure.
+ * @param cnv_pwm_init - CNV PWM parameters, period and duty cycle are set by
+ *			 the driver.
+ * @param sample_rate_hz - Sample rate, up to the rate of the part.
+ * @param ring - Ring buffer, nb_blocks * block_samples *
+ *		 AD400X_STREAM_FRAME_BYTES large.
+ * @param block_samples - Number of samples in a block.
+ * @param nb_blocks - Number of blocks in the ring, at least 2.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad400x_stream_start(struct ad400x_dev *dev,
+			    struct no_os_pwm_init_param *cnv_pwm_init,
+			    uint32_t sample_rate_hz, uint8_t *ring,
+			    uint32_t block_samples, uint32_t nb_blocks)
+{
+	struct no_os_sar_stream_init_param param = {
+		.cnv_pwm_init = cnv_pwm_init,
+		.sample_rate_hz = sample_rate_hz,
+		.cnv_high_ns = AD400X_TCONV_NS,
+		.frame_bytes = AD400X_STREAM_FRAME_BYTES,
+		.ring = ring,
+		.block_samples = block_samples,
+		.nb_blocks = nb_blocks,
+	};
+
+	if (!dev || dev->stream ||
+	    sample_rate_hz > ad400x_device_sample_rate[dev->dev_id])
+		return -EINVAL;
+
+	param.spi_desc = dev->spi_desc;
+
+	return no_os_sar_stream_init(&dev->stream, &param);
+}
+
+/**
+ * Read the last conversion, called on each conversion tick.
+ * @param dev - The device structure.
+ * @return 0 in case of success, -EBUSY if the sample was dropped, negative
+ *	   error code otherwise.
+ */
+int32_t ad400x_stream_trigger(struct ad400x_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	return no_os_sar_stream_trigger(dev->stream);
+}
+
+/**
+ * Get the oldest complete block of samples.
+ * @param dev - The device structure.
+ * @param data - Conversion results, block_samples large.
+ * @return 0 in case of success, -EAGAIN if no block is available, negative
+ *	   error code otherwise.
+ */
+int32_t ad400x_stream_read(struct ad400x_dev *dev, uint32_t *data)
+{
+	uint8_t shift, *frame;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !data)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_read(dev->stream, &frame);
+	if (ret)
+		return ret;
+
+	shift = 8 * AD400X_STREAM_FRAME_BYTES - ad400x_device_resol[dev->dev_id];
+	for (i = 0; i < dev->stream->block_samples; i++) {
+		data[i] = no_os_get_unaligned_be24(frame) >> shift;
+		frame += AD400X_STREAM_FRAME_BYTES;
+	}
+
+	return 0;
+}
+
+/**
+ * Stop timer paced acquisition.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad400x_stream_stop(struct ad400x_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_remove(dev->stream);
+	dev->stream = NULL;
+
+	return ret;
+}
+
 /**
  * Initialize the device.
  * @param device - The device structure.
@@ -170,13 +284,15 @@ int32_t ad400x_init(struct ad400x_dev **device,
 	if (!dev)
 		return -1;
 
+	dev->dev_id = init_param->dev_id;
+	dev->stream = NULL;
+
 	ret = no_os_spi_init(&dev->spi_desc, &init_param->spi_init);
 	if (ret < 0)
 		goto error;
 
 #if !defined(USE_STANDARD_SPI)
 	dev->reg_access_speed = init_param->reg_access_speed;
-	dev->dev_id = init_param->dev_id;
 
 	spi_engine_set_transfer_width(dev->spi_desc, 16);
 #endif
@@ -213,6 +329,9 @@ int32_t ad400x_remove(struct ad400x_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->stream)
+		ad400x_stream_stop(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	no_os_free(dev);
@@ -47,6 +47,7 @@
 #else
 #include "no_os_spi.h"
 #endif
+#include "no_os_sar_stream.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -60,6 +61,11 @@
 #define AD400X_SPAN_COMPRESSION(x)	(((x) & 0x1) << 3)
 #define AD400X_EN_STATUS_BITS(x)	(((x) & 0x1) << 4)
 
+/* Conversion time, CNV is held high this long when streaming */
+#define AD400X_TCONV_NS			320
+/* Bytes read for one sample when streaming */
+#define AD400X_STREAM_FRAME_BYTES	3
+
 enum ad400x_supported_dev_ids {
 	ID_AD4003,
 	ID_AD4007,
@@ -69,6 +75,7 @@ enum ad400x_supported_dev_ids {
 };
 
 extern const uint16_t ad400x_device_resol[];
+extern const uint32_t ad400x_device_sample_rate[];
 
 struct ad400x_dev {
 	/* SPI */
@@ -77,6 +84,8 @@ struct ad400x_dev {
 	uint32_t reg_access_speed;
 	/* Device Settings */
 	enum ad400x_supported_dev_ids dev_id;
+	/* Timer paced acquisition, NULL when not running */
+	struct no_os_sar_stream *stream;
 };
 
 struct ad400x_init_param {
@@ -102,5 +111,16 @@ int32_t ad400x_remove(struct ad400x_dev *dev);
 /* Execute a single conversion */
 int32_t ad400x_spi_single_conversion(struct ad400x_dev *dev,
 				     uint32_t *adc_data);
+/* Start timer paced acquisition at the given sample rate */
+int32_t ad400x_stream_start(struct ad400x_dev *dev,
+			    struct no_os_pwm_init_param *cnv_pwm_init,
+			    uint32_t sample_rate_hz, uint8_t *ring,
+			    uint32_t block_samples, uint32_t nb_blocks);
+/* Read the last conversion, called on each conversion tick */
+int32_t ad400x_stream_trigger(struct ad400x_dev *dev);
+/* Get the oldest complete block of samples */
+int32_t ad400x_stream_read(struct ad400x_dev *dev, uint32_t *data);
+/* Stop timer paced acquisition */
+int32_t ad400x_stream_stop(struct ad400x_dev *dev);
 
 #endif /* SRC_AD400X_H_ */
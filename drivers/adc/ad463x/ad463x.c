@@ -238,9 +238,7 @@ int32_t ad463x_exit_reg_cfg_mode(struct ad463x_dev *dev)
 	if (ret != 0)
 		return ret;
 
-	spi_engine_set_speed(dev->spi_desc, dev->spi_desc->max_speed_hz);
-
-	return ret;
+	return no_os_spi_set_speed(dev->spi_desc, NO_OS_SPI_SPEED_DATA);
 }
 
 /**
@@ -340,7 +338,8 @@ static int32_t ad463x_init_gpio(struct ad463x_dev *dev,
  * @brief Read from device.
  *        Enter register mode to read/write registers
  * @param [in] dev - ad469x_dev device handler.
- * @param [out] buf - data buffer.
+ * @param [out] buf - data buffer. When deinterleave_lanes is set, it must
+ * 		hold one word per lane and channel for each sample.
  * @param [in] samples - sample number.
  * @return 0 in case of success, -1 otherwise.
  */
@@ -349,6 +348,7 @@ int32_t ad463x_read_data(struct ad463x_dev *dev,
 			 uint16_t samples)
 {
 	int32_t ret;
+	uint32_t nb_words;
 	uint32_t commands_data[1] = {0};
 	struct spi_engine_offload_message msg;
 	uint32_t spi_eng_msg_cmds[3] = {
@@ -374,6 +374,21 @@ int32_t ad463x_read_data(struct ad463x_dev *dev,
 	if (ret != 0)
 		return ret;
 
+	if (dev->deinterleave_lanes && dev->lanes_per_ch > 1) {
+		nb_words = samples * AD463X_NUM_CHANNELS * dev->lanes_per_ch;
+		if (dev->dcache_invalidate_range)
+			dev->dcache_invalidate_range(msg.rx_addr,
+						     nb_words * sizeof(*buf));
+
+		/* Each lane word holds the bits clocked out on one SDO */
+		no_os_spi_lanes_deinterleave(buf, buf, nb_words,
+					     dev->lanes_per_ch,
+					     dev->capture_data_width,
+					     NO_OS_SPI_LANES_BIT_INTERLEAVED);
+
+		return 0;
+	}
+
 	if (dev->dcache_invalidate_range)
 		dev->dcache_invalidate_range(msg.rx_addr, samples * 2);
 
@@ -392,10 +407,11 @@ int32_t ad463x_init(struct ad463x_dev **device,
 {
 	struct ad463x_dev *dev;
 	int32_t ret;
+	struct no_os_spi_init_param spi_init;
 	uint8_t data = 0;
 	uint8_t sample_width;
 
-	if (!init_param || !device)
+	if (!init_param || !device || !init_param->spi_init)
 		return -1;
 
 	if (init_param->clock_mode == AD463X_SPI_COMPATIBLE_MODE &&
@@ -427,7 +443,15 @@ int32_t ad463x_init(struct ad463x_dev **device,
 		goto error_clkgen;
 	}
 
-	ret = no_os_spi_init(&dev->spi_desc, init_param->spi_init);
+	/* Registers at reg_access_speed, conversion data at max_speed_hz */
+	spi_init = *init_param->spi_init;
+	if (init_param->reg_access_speed) {
+		if (!spi_init.data_speed_hz)
+			spi_init.data_speed_hz = spi_init.max_speed_hz;
+		spi_init.max_speed_hz = init_param->reg_access_speed;
+	}
+
+	ret = no_os_spi_init(&dev->spi_desc, &spi_init);
 	if (ret != 0)
 		goto error_clkgen;
 
@@ -440,6 +464,7 @@ int32_t ad463x_init(struct ad463x_dev **device,
 	dev->data_rate = init_param->data_rate;
 	dev->device_id = init_param->device_id;
 	dev->dcache_invalidate_range = init_param->dcache_invalidate_range;
+	dev->deinterleave_lanes = init_param->deinterleave_lanes;
 
 	if (dev->output_mode > AD463X_16_DIFF_8_COM)
 		sample_width = 32;
@@ -448,18 +473,22 @@ int32_t ad463x_init(struct ad463x_dev **device,
 
 	switch (dev->lane_mode) {
 	case AD463X_ONE_LANE_PER_CH:
+		dev->lanes_per_ch = 1;
 		dev->capture_data_width = sample_width;
 		break;
 
 	case AD463X_TWO_LANES_PER_CH:
+		dev->lanes_per_ch = 2;
 		dev->capture_data_width = sample_width / 2;
 		break;
 
 	case AD463X_FOUR_LANES_PER_CH:
+		dev->lanes_per_ch = 4;
 		dev->capture_data_width = sample_width / 4;
 		break;
 
 	case AD463X_SHARED_TWO_CH:
+		dev->lanes_per_ch = 1;
 		dev->capture_data_width = sample_width * 2;
 		break;
 	default:
@@ -472,12 +501,24 @@ int32_t ad463x_init(struct ad463x_dev **device,
 
 	dev->read_bytes_no = dev->capture_data_width / 8;
 
+	if (dev->deinterleave_lanes && dev->lanes_per_ch > 1) {
+		if (dev->data_rate == AD463X_DDR_MODE) {
+			pr_err("Lane deinterleaving not available in DDR mode\n");
+			goto error_spi;
+		}
+
+		ret = spi_engine_set_sdi_lanes(dev->spi_desc, dev->lanes_per_ch *
+					       AD463X_NUM_CHANNELS);
+		if (ret != 0) {
+			pr_err("SPI engine has too few SDI lanes\n");
+			goto error_spi;
+		}
+	}
+
 	ret = spi_engine_set_transfer_width(dev->spi_desc, dev->reg_data_width);
 	if (ret != 0)
 		goto error_spi;
 
-	spi_engine_set_speed(dev->spi_desc, dev->reg_access_speed);
-
 	ret = ad463x_spi_reg_read(dev, AD463X_CONFIG_TIMING, &data);
 	if (ret != 0)
 		goto error_spi;
@@ -146,6 +146,8 @@
 
 #define AD463X_TRIGGER_PULSE_WIDTH_NS	0x0A
 
+#define AD463X_NUM_CHANNELS		2
+
 #define AD463X_GAIN_MAX_VAL_SCALED	19997
 
 /**
@@ -204,6 +206,12 @@ struct ad463x_init_param {
 	uint8_t data_rate;
 	/** Output Mode */
 	uint8_t output_mode;
+	/**
+	 * Rebuild the samples spread over several lanes in software, for HDL
+	 * designs without a data reorder core. Needs an SPI engine with one SDI
+	 * per lane and SDR mode.
+	 */
+	bool deinterleave_lanes;
 	/** Invalidate the Data cache for the given address range */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
 };
@@ -235,12 +243,16 @@ struct ad463x_dev {
 	uint8_t capture_data_width;
 	/** Lane Mode */
 	uint8_t lane_mode;
+	/** Number of SDO lanes carrying one channel */
+	uint8_t lanes_per_ch;
 	/** Clock Mode */
 	uint8_t clock_mode;
 	/** Data Rate Mode */
 	uint8_t data_rate;
 	/** Output Mode */
 	uint8_t output_mode;
+	/** Rebuild the samples spread over several lanes in software */
+	bool deinterleave_lanes;
 	/** Invalidate the Data cache for the given address range */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
 };
@@ -748,6 +748,196 @@ int32_t ad469x_seq_read_data(struct ad469x_dev *dev,
 	return 0;
 }
 
+#if !defined(USE_STANDARD_SPI)
+/**
+ * @brief Start a hardware paced capture with the advanced sequencer. The
+ *        sequencer is programmed once with one slot per channel, the PWM
+ *        triggers the conversions at the aggregate rate and the SPI Engine
+ *        offload streams the results into a ring of blocks, without CPU
+ *        involvement between samples. The ring may be the memory of an IIO
+ *        input buffer.
+ *        Must be called in register mode, the device is left in conversion
+ *        mode until ad469x_seq_stream_stop().
+ * @param [in] dev - ad469x_dev device handler.
+ * @param [in] channels - Channel of each slot, each channel at most once.
+ * @param [in] nb_slots - Number of slots.
+ * @param [in] rate_hz - Aggregate sample rate, over all the slots.
+ * @param [in] ring - Memory of the ring, nb_blocks * scans_per_block scans.
+ * @param [in] scans_per_block - Number of scans in a block.
+ * @param [in] nb_blocks - Number of blocks in the ring, at least 2.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad469x_seq_stream_start(struct ad469x_dev *dev,
+				const uint8_t *channels,
+				uint8_t nb_slots,
+				uint32_t rate_hz,
+				uint32_t *ring,
+				uint32_t scans_per_block,
+				uint32_t nb_blocks)
+{
+	struct spi_engine_offload_message msg;
+	uint32_t spi_eng_msg_cmds[3] = {
+		CS_LOW,
+		WRITE_READ(1),
+		CS_HIGH
+	};
+	/* NOP, the sequencer picks the channel */
+	uint32_t commands_data[1] = { 0 };
+	uint16_t mask = 0;
+	uint8_t slot_size;
+	uint8_t i;
+	int32_t ret;
+
+	if (!dev || !channels || !ring || !rate_hz || !scans_per_block)
+		return -EINVAL;
+
+	if (!nb_slots || nb_slots > AD469x_CHANNEL_NO)
+		return -EINVAL;
+
+	for (i = 0; i < nb_slots; i++) {
+		if (channels[i] >= AD469x_CHANNEL_NO ||
+		    (mask & NO_OS_BIT(channels[i])))
+			return -EINVAL;
+		mask |= NO_OS_BIT(channels[i]);
+	}
+
+	ret = ad469x_set_channel_sequence(dev, AD469x_advanced_seq);
+	if (ret != 0)
+		return ret;
+
+	ret = ad469x_adv_sequence_set_num_slots(dev, nb_slots);
+	if (ret != 0)
+		return ret;
+
+	/* IIO scans hold the channels in ascending order, temperature last */
+	for (i = 0; i < nb_slots; i++) {
+		ret = ad469x_adv_sequence_set_slot(dev, i, channels[i]);
+		if (ret != 0)
+			return ret;
+		dev->stream_scan_pos[i] = no_os_hweight16(mask &
+					  (NO_OS_BIT(channels[i]) - 1));
+	}
+	dev->stream_scan_pos[nb_slots] = nb_slots;
+
+	ret = ad469x_enter_conversion_mode(dev);
+	if (ret != 0)
+		return ret;
+
+	ret = no_os_pwm_set_period(dev->trigger_pwm_desc,
+				   NO_OS_DIV_ROUND_CLOSEST(1000000000, rate_hz));
+	if (ret != 0)
+		goto error;
+
+	ret = spi_engine_offload_init(dev->spi_desc, dev->offload_init_param);
+	if (ret != 0)
+		goto error;
+
+	msg.commands = spi_eng_msg_cmds;
+	msg.no_commands = NO_OS_ARRAY_SIZE(spi_eng_msg_cmds);
+	msg.rx_addr = (uint32_t)ring;
+	msg.commands_data = commands_data;
+
+	slot_size = nb_slots + dev->temp_enabled;
+	dev->stream_scans_per_block = scans_per_block;
+
+	ret = spi_engine_offload_stream_start(dev->spi_desc, msg,
+					      scans_per_block * slot_size *
+					      sizeof(*ring), nb_blocks);
+	if (ret != 0)
+		goto error;
+
+	ret = no_os_pwm_enable(dev->trigger_pwm_desc);
+	if (ret != 0)
+		goto error_stream;
+
+	return 0;
+
+error_stream:
+	spi_engine_offload_stream_stop(dev->spi_desc);
+error:
+	ad469x_exit_conversion_mode(dev);
+
+	return ret;
+}
+
+/**
+ * @brief Wait for the next block of the advanced sequencer capture and
+ *        rearrange it, in place, from slot order to the IIO scan layout:
+ *        one word per enabled channel in ascending channel order, followed by
+ *        the temperature when enabled, with the oversampling padding removed.
+ *        The block may be used until the ring comes around to it again.
+ * @param [in] dev - ad469x_dev device handler.
+ * @param [out] block - Address of the block.
+ * @param [in] timeout_ms - Number of ms to wait for the block.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad469x_seq_stream_read(struct ad469x_dev *dev,
+			       uint32_t **block,
+			       uint32_t timeout_ms)
+{
+	uint32_t scan[AD469x_CHANNEL_NO + 1];
+	uint32_t block_addr;
+	uint32_t *samples;
+	uint8_t slot_size;
+	uint32_t i;
+	uint8_t j;
+	int32_t ret;
+
+	if (!dev || !block)
+		return -EINVAL;
+
+	ret = spi_engine_offload_stream_wait(dev->spi_desc, &block_addr,
+					     timeout_ms);
+	if (ret != 0)
+		return ret;
+
+	slot_size = dev->num_slots + dev->temp_enabled;
+	if (dev->dcache_invalidate_range)
+		dev->dcache_invalidate_range(block_addr, dev->stream_scans_per_block *
+					     slot_size * sizeof(*samples));
+
+	samples = (uint32_t *)block_addr;
+	for (i = 0; i < dev->stream_scans_per_block; i++) {
+		for (j = 0; j < slot_size; j++) {
+			ret = ad469x_adv_seq_osr_get_util_data(dev, j, &samples[j]);
+			if (ret != 0)
+				return ret;
+			scan[dev->stream_scan_pos[j]] = samples[j];
+		}
+		memcpy(samples, scan, slot_size * sizeof(*samples));
+		samples += slot_size;
+	}
+
+	*block = (uint32_t *)block_addr;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the capture started by ad469x_seq_stream_start() and go back to
+ *        register mode.
+ * @param [in] dev - ad469x_dev device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad469x_seq_stream_stop(struct ad469x_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	ret = no_os_pwm_disable(dev->trigger_pwm_desc);
+	if (ret != 0)
+		return ret;
+
+	ret = spi_engine_offload_stream_stop(dev->spi_desc);
+	if (ret != 0)
+		return ret;
+
+	return ad469x_exit_conversion_mode(dev);
+}
+#endif
+
 /**
  * @brief Read from device.
  *        Enter register mode to read/write registers
@@ -345,6 +345,12 @@ struct ad469x_dev {
 	bool temp_enabled;
 	/** Number of active channel slots, for advanced sequencer */
 	uint8_t num_slots;
+#if !defined(USE_STANDARD_SPI)
+	/** Position of each advanced sequencer slot in an IIO scan */
+	uint8_t stream_scan_pos[AD469x_CHANNEL_NO + 1];
+	/** Number of scans in a block of the streaming ring */
+	uint32_t stream_scans_per_block;
+#endif
 };
 
 /******************************************************************************/
@@ -383,6 +389,25 @@ int32_t ad469x_seq_read_data(struct ad469x_dev *dev,
 			     uint32_t *buf,
 			     uint16_t samples);
 
+#if !defined(USE_STANDARD_SPI)
+/* Start a hardware paced advanced sequencer capture */
+int32_t ad469x_seq_stream_start(struct ad469x_dev *dev,
+				const uint8_t *channels,
+				uint8_t nb_slots,
+				uint32_t rate_hz,
+				uint32_t *ring,
+				uint32_t scans_per_block,
+				uint32_t nb_blocks);
+
+/* Wait for the next block of the capture, in IIO scan layout */
+int32_t ad469x_seq_stream_read(struct ad469x_dev *dev,
+			       uint32_t **block,
+			       uint32_t timeout_ms);
+
+/* Stop the advanced sequencer capture */
+int32_t ad469x_seq_stream_stop(struct ad469x_dev *dev);
+#endif
+
 /* Set channel sequence */
 int32_t ad469x_set_channel_sequence(struct ad469x_dev *dev,
 				    enum ad469x_channel_sequencing seq);
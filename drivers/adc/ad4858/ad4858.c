@@ -649,47 +649,47 @@ int ad4858_perform_conv(struct ad4858_dev *dev)
 }
 
 /**
- * @brief Read ADC conversion data over SPI.
+ * @brief Get the number of bytes of a conversion result, for all channels.
  * @param dev - Pointer to the device structure.
- * @param data - Pointer to adc conversion data structure.
+ * @param nb_bytes - Number of bytes, depending on the packet format.
  * @return 0 in case of success, negative error code otherwise.
- * @note As this is a simultaneously sampling ADC, data for all channels
- * is acquired/read in a single SPI read function call.
  */
-int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
+static int ad4858_data_nb_bytes(struct ad4858_dev *dev, uint16_t *nb_bytes)
 {
-	int ret;
-	uint16_t nb_bytes;
-	uint8_t indx;
-	uint8_t chn;
-	uint8_t buff[32] = {0};
-	// Buffer index offset for each channel while reading 20-bit conversion result
-	uint8_t buff_chn_offset[] = { 0, 2, 5, 7, 10, 12, 15, 17 };
-
-	if (!dev || !data)
-		return -EINVAL;
-
 	switch (dev->packet_format) {
 	case AD4858_PACKET_20_BIT:
-		nb_bytes = (20 * AD4858_NUM_CHANNELS) >> 3;
+		*nb_bytes = (20 * AD4858_NUM_CHANNELS) >> 3;
 		break;
 
 	case AD4858_PACKET_24_BIT:
-		nb_bytes = (24 * AD4858_NUM_CHANNELS) >> 3;
+		*nb_bytes = (24 * AD4858_NUM_CHANNELS) >> 3;
 		break;
 
 	case AD4858_PACKET_32_BIT:
-		nb_bytes = (32 * AD4858_NUM_CHANNELS) >> 3;
+		*nb_bytes = (32 * AD4858_NUM_CHANNELS) >> 3;
 		break;
 
 	default:
 		return -EINVAL;
 	}
 
-	/* Read SPI data */
-	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
-	if (ret)
-		return ret;
+	return 0;
+}
+
+/**
+ * @brief Decode a conversion result read over SPI.
+ * @param dev - Pointer to the device structure.
+ * @param buff - Data read over SPI.
+ * @param data - Pointer to adc conversion data structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad4858_decode_data(struct ad4858_dev *dev, const uint8_t *buff,
+			      struct ad4858_conv_data *data)
+{
+	uint8_t indx;
+	uint8_t chn;
+	// Buffer index offset for each channel while reading 20-bit conversion result
+	uint8_t buff_chn_offset[] = { 0, 2, 5, 7, 10, 12, 15, 17 };
 
 	switch (dev->packet_format) {
 	case AD4858_PACKET_20_BIT:
@@ -717,7 +717,6 @@ int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 			data->or_ur_status[chn] = (buff[indx + 2] >> 3) & 0x1;
 			data->chn_id[chn] = buff[indx + 2] & 0x7;
 		}
-		chn = 0;
 		break;
 
 	case AD4858_PACKET_32_BIT:
@@ -740,6 +739,35 @@ int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 	return 0;
 }
 
+/**
+ * @brief Read ADC conversion data over SPI.
+ * @param dev - Pointer to the device structure.
+ * @param data - Pointer to adc conversion data structure.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note As this is a simultaneously sampling ADC, data for all channels
+ * is acquired/read in a single SPI read function call.
+ */
+int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
+{
+	int ret;
+	uint16_t nb_bytes;
+	uint8_t buff[32] = {0};
+
+	if (!dev || !data)
+		return -EINVAL;
+
+	ret = ad4858_data_nb_bytes(dev, &nb_bytes);
+	if (ret)
+		return ret;
+
+	/* Read SPI data */
+	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
+	if (ret)
+		return ret;
+
+	return ad4858_decode_data(dev, buff, data);
+}
+
 /**
  * @brief Read ADC data (for all channels).
  * @param dev - Pointer to the device structure.
@@ -760,6 +788,149 @@ int ad4858_read_data(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 	return ad4858_spi_data_read(dev, data);
 }
 
+/**
+ * @brief Set up the grouped acquisition of several AD4858 sharing CNV and an
+ * SPI bus. The reads of all the devices are queued on the bus together and
+ * served back to back, with DMA when the platform supports it.
+ * @param group - Pointer to the group structure (memory is allocated within
+ * this function).
+ * @param devs - Devices of the group, all with the same packet format. The
+ * first one drives CNV and reports BUSY for all of them.
+ * @param nb_devs - Number of devices.
+ * @param chn_mask - Channels of each device placed in a frame, bit n for
+ * channel n.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad4858_group_init(struct ad4858_group **group, struct ad4858_dev **devs,
+		      uint8_t nb_devs, const uint8_t *chn_mask)
+{
+	struct ad4858_group *grp;
+	uint16_t nb_bytes;
+	uint8_t i;
+	int ret;
+
+	if (!group || !devs || !nb_devs || !chn_mask)
+		return -EINVAL;
+
+	ret = ad4858_data_nb_bytes(devs[0], &nb_bytes);
+	if (ret)
+		return ret;
+
+	for (i = 1; i < nb_devs; i++)
+		if (devs[i]->packet_format != devs[0]->packet_format)
+			return -EINVAL;
+
+	grp = (struct ad4858_group *)calloc(1, sizeof(*grp));
+	if (!grp)
+		return -ENOMEM;
+
+	grp->reqs = calloc(nb_devs, sizeof(*grp->reqs));
+	grp->msgs = calloc(nb_devs, sizeof(*grp->msgs));
+	grp->buff = calloc(nb_devs, nb_bytes);
+	grp->chn_mask = calloc(nb_devs, sizeof(*grp->chn_mask));
+	if (!grp->reqs || !grp->msgs || !grp->buff || !grp->chn_mask) {
+		ad4858_group_remove(grp);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < nb_devs; i++) {
+		grp->msgs[i].tx_buff = &grp->buff[i * nb_bytes];
+		grp->msgs[i].rx_buff = &grp->buff[i * nb_bytes];
+		grp->msgs[i].bytes_number = nb_bytes;
+		grp->msgs[i].cs_change = 1;
+
+		grp->reqs[i].desc = devs[i]->spi_desc;
+		grp->reqs[i].msgs = &grp->msgs[i];
+		grp->reqs[i].len = 1;
+
+		grp->chn_mask[i] = chn_mask[i];
+	}
+
+	grp->devs = devs;
+	grp->nb_devs = nb_devs;
+	grp->nb_bytes = nb_bytes;
+
+	*group = grp;
+
+	return 0;
+}
+
+/**
+ * @brief Perform a conversion on all the devices of a group and read it as one
+ * frame: the enabled channels of the first device, in channel order, then the
+ * ones of the next device and so on. The frame is laid out as an IIO scan of
+ * 32-bit samples and may be pushed with iio_buffer_push_scan().
+ * @param group - Pointer to the group structure.
+ * @param frame - Raw conversion results of the enabled channels.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad4858_group_read(struct ad4858_group *group, uint32_t *frame)
+{
+	struct ad4858_conv_data data;
+	uint32_t timeout = 10000;
+	uint8_t i, chn;
+	int ret;
+
+	if (!group || !frame)
+		return -EINVAL;
+
+	ret = ad4858_perform_conv(group->devs[0]);
+	if (ret)
+		return ret;
+
+	memset(group->buff, 0, group->nb_devs * group->nb_bytes);
+
+	for (i = 0; i < group->nb_devs; i++) {
+		ret = no_os_spi_submit(&group->reqs[i]);
+		if (ret)
+			return ret;
+	}
+
+	/* Requests of equal priority are served in order, the last one ends */
+	while (!group->reqs[group->nb_devs - 1].done && timeout) {
+		no_os_udelay(1);
+		timeout--;
+	}
+	if (!group->reqs[group->nb_devs - 1].done)
+		return -ETIMEDOUT;
+
+	for (i = 0; i < group->nb_devs; i++) {
+		if (group->reqs[i].status)
+			return group->reqs[i].status;
+
+		ret = ad4858_decode_data(group->devs[i],
+					 &group->buff[i * group->nb_bytes], &data);
+		if (ret)
+			return ret;
+
+		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++)
+			if (group->chn_mask[i] & NO_OS_BIT(chn))
+				*frame++ = data.raw[chn];
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the memory allocated by ad4858_group_init. The devices are left
+ * untouched.
+ * @param group - Pointer to the group structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ad4858_group_remove(struct ad4858_group *group)
+{
+	if (!group)
+		return -EINVAL;
+
+	free(group->reqs);
+	free(group->msgs);
+	free(group->buff);
+	free(group->chn_mask);
+	free(group);
+
+	return 0;
+}
+
 /**
  * @brief Perform an AD4858 software reset.
  * @param dev - Pointer to the device structure.
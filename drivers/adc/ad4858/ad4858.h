@@ -262,6 +262,27 @@ struct ad4858_conv_data {
 	uint32_t softspan_id[AD4858_NUM_CHANNELS];
 };
 
+/**
+ * @struct ad4858_group
+ * @brief AD4858 devices sharing CNV and an SPI bus, read as one frame
+ */
+struct ad4858_group {
+	/** Devices, the first one drives CNV. */
+	struct ad4858_dev **devs;
+	/** Number of devices. */
+	uint8_t nb_devs;
+	/** Channels of each device placed in a frame. */
+	uint8_t *chn_mask;
+	/** Bytes read from each device. */
+	uint16_t nb_bytes;
+	/** One read request per device. */
+	struct no_os_spi_request *reqs;
+	/** One read message per device. */
+	struct no_os_spi_msg *msgs;
+	/** Read data of all the devices. */
+	uint8_t *buff;
+};
+
 /**
  * @struct ad4858_init_param
  * @brief AD4858 init parameters structure used for initializing the ad4858_dev
@@ -445,6 +466,16 @@ int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data);
 /* Perform conversion and read ADC data (for all channels). */
 int ad4858_read_data(struct ad4858_dev *dev, struct ad4858_conv_data *data);
 
+/* Set up the grouped acquisition of several devices. */
+int ad4858_group_init(struct ad4858_group **group, struct ad4858_dev **devs,
+		      uint8_t nb_devs, const uint8_t *chn_mask);
+
+/* Perform a conversion and read one frame from all the devices of a group. */
+int ad4858_group_read(struct ad4858_group *group, uint32_t *frame);
+
+/* Free the memory allocated by ad4858_group_init. */
+int ad4858_group_remove(struct ad4858_group *group);
+
 /* Enable/Disable channel sleep */
 int ad4858_enable_ch_sleep(struct ad4858_dev* dev, uint8_t chn,
 			   enum ad4858_ch_sleep_value sleep_status);
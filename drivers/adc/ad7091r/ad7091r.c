@@ -41,8 +41,10 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <errno.h>
 #include "ad7091r.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -73,6 +75,8 @@ int8_t ad7091r_init(struct ad7091r_dev **device,
 	if (!dev)
 		return -1;
 
+	dev->stream = NULL;
+
 	status = no_os_spi_init(&dev->spi_desc, &init_param.spi_init);
 	/* Ensures that last state of SDO is high. */
 	no_os_spi_write_and_read(dev->spi_desc, &tmp_val, 1);
@@ -94,6 +98,9 @@ int32_t ad7091r_remove(struct ad7091r_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->stream)
+		ad7091r_stream_stop(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	no_os_free(dev);
@@ -186,6 +193,123 @@ void ad7091r_power_up(struct ad7091r_dev *dev)
 }
 
 
+/***************************************************************************//**
+ * @brief Starts timer paced acquisition at the given sample rate.
+ *
+ * The PWM only serves as timebase, its pulse finished interrupt must call
+ * ad7091r_stream_trigger(). Each tick reads the previous conversion and then
+ * pulls CONVST low to start the next one, both by DMA, so the conversion runs
+ * between ticks instead of being waited for.
+ *
+ * @param dev            - The device structure.
+ * @param tick_pwm_init  - Timebase PWM parameters, period and duty cycle are
+ *                         set by the driver.
+ * @param sample_rate_hz - Sample rate, up to AD7091R_SAMPLE_RATE_MAX.
+ * @param ring           - Ring buffer, nb_blocks * block_samples *
+ *                         AD7091R_STREAM_FRAME_BYTES large.
+ * @param block_samples  - Number of samples in a block.
+ * @param nb_blocks      - Number of blocks in the ring, at least 2.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7091r_stream_start(struct ad7091r_dev *dev,
+			     struct no_os_pwm_init_param *tick_pwm_init,
+			     uint32_t sample_rate_hz, uint8_t *ring,
+			     uint32_t block_samples, uint32_t nb_blocks)
+{
+	struct no_os_sar_stream_init_param param = {
+		.cnv_pwm_init = tick_pwm_init,
+		.sample_rate_hz = sample_rate_hz,
+		.cnv_high_ns = AD7091R_TCONV_NS,
+		.frame_bytes = AD7091R_STREAM_FRAME_BYTES,
+		.frame_tx = {0xFF, 0xFF},
+		.cnv_cmd = {0xBF},
+		.cnv_cmd_bytes = 1,
+		.ring = ring,
+		.block_samples = block_samples,
+		.nb_blocks = nb_blocks,
+	};
+	uint8_t write_byte = 0xBF;
+	int32_t ret;
+
+	if (!dev || dev->stream || sample_rate_hz > AD7091R_SAMPLE_RATE_MAX)
+		return -EINVAL;
+
+	param.spi_desc = dev->spi_desc;
+
+	/* The first tick reads this conversion. */
+	ret = no_os_spi_write_and_read(dev->spi_desc, &write_byte, 1);
+	if (ret)
+		return ret;
+
+	return no_os_sar_stream_init(&dev->stream, &param);
+}
+
+/***************************************************************************//**
+ * @brief Reads the last conversion, called on each conversion tick.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, -EBUSY if the sample was dropped, negative
+ *         error code otherwise.
+*******************************************************************************/
+int32_t ad7091r_stream_trigger(struct ad7091r_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	return no_os_sar_stream_trigger(dev->stream);
+}
+
+/***************************************************************************//**
+ * @brief Gets the oldest complete block of samples.
+ *
+ * @param dev  - The device structure.
+ * @param data - 12-bit conversion results, block_samples large.
+ *
+ * @return 0 in case of success, -EAGAIN if no block is available, negative
+ *         error code otherwise.
+*******************************************************************************/
+int32_t ad7091r_stream_read(struct ad7091r_dev *dev, uint16_t *data)
+{
+	uint8_t *frame;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !data)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_read(dev->stream, &frame);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < dev->stream->block_samples; i++)
+		data[i] = no_os_get_unaligned_be16(frame + i *
+						   AD7091R_STREAM_FRAME_BYTES) >> 4;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Stops timer paced acquisition.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7091r_stream_stop(struct ad7091r_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_remove(dev->stream);
+	dev->stream = NULL;
+
+	return ret;
+}
+
 /***************************************************************************//**
  * @brief Converts a 12-bit raw sample to volts.
  *
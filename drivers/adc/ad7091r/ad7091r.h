@@ -45,6 +45,17 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_spi.h"
+#include "no_os_sar_stream.h"
+
+/******************************************************************************/
+/******************************** AD7091R *************************************/
+/******************************************************************************/
+/* Maximum sample rate */
+#define AD7091R_SAMPLE_RATE_MAX		1000000
+/* Conversion time */
+#define AD7091R_TCONV_NS		650
+/* Bytes read for one sample when streaming */
+#define AD7091R_STREAM_FRAME_BYTES	2
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -53,6 +64,8 @@
 struct ad7091r_dev {
 	/* SPI */
 	struct no_os_spi_desc	*spi_desc;
+	/* Timer paced acquisition, NULL when not running */
+	struct no_os_sar_stream	*stream;
 };
 
 struct ad7091r_init_param {
@@ -83,6 +96,21 @@ void ad7091r_power_down(struct ad7091r_dev *dev);
 /*! Powers up the device. */
 void ad7091r_power_up(struct ad7091r_dev *dev);
 
+/*! Starts timer paced acquisition at the given sample rate. */
+int32_t ad7091r_stream_start(struct ad7091r_dev *dev,
+			     struct no_os_pwm_init_param *tick_pwm_init,
+			     uint32_t sample_rate_hz, uint8_t *ring,
+			     uint32_t block_samples, uint32_t nb_blocks);
+
+/*! Reads the last conversion, called on each conversion tick. */
+int32_t ad7091r_stream_trigger(struct ad7091r_dev *dev);
+
+/*! Gets the oldest complete block of samples. */
+int32_t ad7091r_stream_read(struct ad7091r_dev *dev, uint16_t *data);
+
+/*! Stops timer paced acquisition. */
+int32_t ad7091r_stream_stop(struct ad7091r_dev *dev);
+
 /*! Converts a 12-bit raw sample to volts. */
 float ad7091r_convert_to_volts(int16_t raw_sample, float v_ref);
 
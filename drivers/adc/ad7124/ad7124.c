@@ -43,6 +43,7 @@
 /******************************************************************************/
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "ad7124.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
@@ -987,6 +988,279 @@ int ad7124_set_power_mode(struct ad7124_dev *device,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Add a conversion to the scan being built by the continuous read mode
+ *        and hand the scan over once every enabled channel is in.
+ * @param dev  - The device structure.
+ * @param chan - Channel of the conversion, from the appended status.
+ * @param data - Conversion result.
+*******************************************************************************/
+static void ad7124_cont_read_store(struct ad7124_dev *dev, uint8_t chan,
+				   int32_t data)
+{
+	uint32_t next;
+
+	if (dev->cont_cnt)
+		next = dev->cont_mask & ~NO_OS_GENMASK(dev->cont_last, 0);
+	else
+		next = dev->cont_mask;
+
+	/* The sequencer skipped or repeated a channel, restart the scan. */
+	if (!next || chan != no_os_find_first_set_bit(next)) {
+		dev->cont_errors++;
+		dev->cont_cnt = 0;
+		if (chan != no_os_find_first_set_bit(dev->cont_mask))
+			return;
+	}
+
+	dev->cont_scan[dev->cont_cnt++] = data;
+	dev->cont_last = chan;
+
+	if (dev->cont_cnt == no_os_hweight16(dev->cont_mask)) {
+		dev->cont_cb(dev->cont_ctx, dev->cont_scan, dev->cont_cnt);
+		dev->cont_cnt = 0;
+	}
+}
+
+/***************************************************************************//**
+ * @brief DOUT/RDY falling edge handler of the continuous read mode. Reads the
+ *        data register with the status appended, without a command byte.
+ * @param ctx - The device structure.
+*******************************************************************************/
+static void ad7124_cont_read_isr(void *ctx)
+{
+	struct ad7124_dev *dev = ctx;
+	uint8_t buf[6] = { 0 };
+	uint8_t crc_buf[6];
+	struct no_os_spi_msg msg = {
+		.tx_buff = buf,
+		.rx_buff = buf,
+		.bytes_number = (dev->use_crc != AD7124_DISABLE_CRC) ? 5 : 4,
+		/* Keep CS asserted so that RDY shows up on DOUT. */
+		.cs_change = 0,
+	};
+	int32_t data;
+
+	/* DOUT toggles while the data is clocked out. */
+	if (no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number))
+		return;
+
+	if (no_os_spi_transfer(dev->spi_desc, &msg, 1))
+		goto out;
+
+	if (dev->use_crc == AD7124_USE_CRC) {
+		crc_buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_RD |
+			     AD7124_COMM_REG_RA(AD7124_DATA_REG);
+		memcpy(&crc_buf[1], buf, 5);
+		if (ad7124_compute_crc8(crc_buf, 6)) {
+			dev->cont_errors++;
+			goto out;
+		}
+	}
+
+	data = no_os_get_unaligned_be24(buf);
+	dev->regs[AD7124_Data].value = data;
+	dev->regs[AD7124_Status].value = buf[3];
+
+	ad7124_cont_read_store(dev, AD7124_STATUS_REG_CH_ACTIVE(buf[3]), data);
+
+out:
+	no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+}
+
+/***************************************************************************//**
+ * @brief Start the continuous read mode. The ADC converts the enabled channels
+ *        continuously and every RDY falling edge on DOUT triggers the read of
+ *        the result, so the SPI bus is not used to poll the status. CS stays
+ *        asserted until ad7124_cont_read_stop() is called.
+ * @param dev - The device structure.
+ * @param cb  - Called from the interrupt with one sample of every enabled
+ *              channel, in channel order.
+ * @param ctx - Parameter passed to the callback.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_cont_read_start(struct ad7124_dev *dev,
+			   void (*cb)(void *ctx, int32_t *scan,
+				      uint32_t nb_channels),
+			   void *ctx)
+{
+	struct ad7124_st_reg *ctrl;
+	uint8_t buf[4];
+	struct no_os_spi_msg msg = {
+		.tx_buff = buf,
+		.rx_buff = buf,
+		.bytes_number = (dev && dev->use_crc != AD7124_DISABLE_CRC) ? 4 : 3,
+		.cs_change = 0,
+	};
+	uint16_t mask = 0;
+	uint32_t value;
+	uint8_t i;
+	int ret;
+
+	if (!dev || !cb)
+		return -EINVAL;
+
+	if (!dev->gpio_rdy || !dev->irq_ctrl)
+		return -ENOTSUP;
+
+	if (dev->cont_cb)
+		return -EBUSY;
+
+	for (i = 0; i < AD7124_MAX_CHANNELS; i++)
+		if (dev->regs[AD7124_Channel_0 + i].value &
+		    AD7124_CH_MAP_REG_CH_ENABLE)
+			mask |= NO_OS_BIT(i);
+	if (!mask)
+		return -EINVAL;
+
+	if (dev->check_ready) {
+		ret = ad7124_wait_for_spi_ready(dev, dev->spi_rdy_poll_cnt);
+		if (ret)
+			return ret;
+	}
+
+	dev->cont_mask = mask;
+	dev->cont_cnt = 0;
+	dev->cont_errors = 0;
+	dev->cont_ctx = ctx;
+	dev->cont_cb = cb;
+
+	ctrl = &dev->regs[AD7124_ADC_Control];
+	value = (ctrl->value & ~AD7124_ADC_CTRL_REG_MODE_MSK) |
+		AD7124_ADC_CTRL_REG_MODE(AD7124_CONTINUOUS) |
+		AD7124_ADC_CTRL_REG_CONT_READ | AD7124_ADC_CTRL_REG_DATA_STATUS;
+
+	buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_WR |
+		 AD7124_COMM_REG_RA(ctrl->addr);
+	no_os_put_unaligned_be16(value, &buf[1]);
+	if (dev->use_crc != AD7124_DISABLE_CRC)
+		buf[3] = ad7124_compute_crc8(buf, 3);
+
+	ret = no_os_spi_transfer(dev->spi_desc, &msg, 1);
+	if (ret)
+		goto error;
+
+	ctrl->value = value;
+	dev->mode = AD7124_CONTINUOUS;
+
+	ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		goto error_cont;
+
+	return 0;
+
+error_cont:
+	ad7124_cont_read_stop(dev);
+error:
+	dev->cont_cb = NULL;
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Leave the continuous read mode. A data read command issued while RDY
+ *        is low takes the interface back to register accesses.
+ * @param dev - The device structure.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_cont_read_stop(struct ad7124_dev *dev)
+{
+	uint8_t buf[6] = { 0 };
+	int16_t timeout;
+	uint8_t rdy = NO_OS_GPIO_HIGH;
+	int ret;
+
+	if (!dev || !dev->gpio_rdy || !dev->irq_ctrl)
+		return -EINVAL;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		return ret;
+
+	dev->cont_cb = NULL;
+
+	for (timeout = dev->spi_rdy_poll_cnt; timeout > 0; timeout--) {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+		if (rdy == NO_OS_GPIO_LOW)
+			break;
+	}
+	if (rdy != NO_OS_GPIO_LOW)
+		return -ETIMEDOUT;
+
+	buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_RD |
+		 AD7124_COMM_REG_RA(AD7124_DATA_REG);
+	ret = no_os_spi_write_and_read(dev->spi_desc, buf,
+				       (dev->use_crc != AD7124_DISABLE_CRC) ?
+				       6 : 5);
+	if (ret)
+		return ret;
+
+	return ad7124_reg_write_msk(dev, AD7124_ADC_CTRL_REG, 0,
+				    AD7124_ADC_CTRL_REG_CONT_READ);
+}
+
+/***************************************************************************//**
+ * @brief Set up the optional DOUT/RDY GPIO and its interrupt, used by the
+ *        continuous read mode. The interrupt is enabled by
+ *        ad7124_cont_read_start().
+ * @param dev        - The device structure.
+ * @param init_param - The structure that contains the device initial
+ * 		               parameters.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int ad7124_rdy_irq_init(struct ad7124_dev *dev,
+			       struct ad7124_init_param *init_param)
+{
+	int ret;
+
+	dev->irq_ctrl = NULL;
+	dev->cont_cb = NULL;
+
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param->gpio_rdy);
+	if (ret)
+		return ret;
+
+	if (!dev->gpio_rdy || !init_param->irq_ctrl)
+		return 0;
+
+	ret = no_os_gpio_direction_input(dev->gpio_rdy);
+	if (ret)
+		goto error_gpio;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = ad7124_cont_read_isr,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  dev->gpio_rdy->number, &dev->irq_cb);
+	if (ret)
+		goto error_gpio;
+
+	ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+					  dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_irq;
+
+	dev->irq_ctrl = init_param->irq_ctrl;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl,
+				      dev->gpio_rdy->number, &dev->irq_cb);
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
+	dev->gpio_rdy = NULL;
+
+	return ret;
+}
+
 /***************************************************************************//**
  * @brief Initializes the AD7124.
  * @param device     - The device structure.
@@ -1096,6 +1370,10 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 			goto error_spi;
 	}
 
+	ret = ad7124_rdy_irq_init(dev, init_param);
+	if (ret)
+		goto error_spi;
+
 	*device = dev;
 
 	return 0;
@@ -1117,6 +1395,19 @@ int32_t ad7124_remove(struct ad7124_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->irq_ctrl) {
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		ret = no_os_irq_unregister_callback(dev->irq_ctrl,
+						    dev->gpio_rdy->number,
+						    &dev->irq_cb);
+		if (ret)
+			return ret;
+	}
+
+	ret = no_os_gpio_remove(dev->gpio_rdy);
+	if (ret)
+		return ret;
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		return ret;
@@ -46,6 +46,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
 
@@ -495,6 +497,19 @@ struct ad7124_dev {
 	struct ad7124_channel_setup setups[AD7124_MAX_SETUPS];
 	/* Channel Mapping*/
 	struct ad7124_channel_map chan_map[AD7124_MAX_CHANNELS];
+	/* GPIO wired to DOUT/RDY, used by the continuous read mode */
+	struct no_os_gpio_desc	*gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	struct no_os_callback_desc irq_cb;
+	/* Continuous read: called with one sample of every enabled channel */
+	void (*cont_cb)(void *ctx, int32_t *scan, uint32_t nb_channels);
+	void *cont_ctx;
+	uint16_t cont_mask;
+	int8_t cont_last;
+	uint8_t cont_cnt;
+	int32_t cont_scan[AD7124_MAX_CHANNELS];
+	/* Conversions dropped for a bad CRC or an out of order channel */
+	uint32_t cont_errors;
 };
 
 struct ad7124_init_param {
@@ -516,6 +531,9 @@ struct ad7124_init_param {
 	struct ad7124_channel_setup setups[AD7124_MAX_SETUPS];
 	/* Channel Mapping*/
 	struct ad7124_channel_map chan_map[AD7124_MAX_CHANNELS];
+	/* Optional GPIO wired to DOUT/RDY and its interrupt controller */
+	struct no_os_gpio_init_param *gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
 };
 
 /******************************************************************************/
@@ -644,6 +662,15 @@ int ad7124_enable_buffers(struct ad7124_dev* device,
 int ad7124_set_power_mode(struct ad7124_dev *device,
 			  enum ad7124_power_mode mode);
 
+/* Start reading conversions from the DOUT/RDY interrupt */
+int ad7124_cont_read_start(struct ad7124_dev *dev,
+			   void (*cb)(void *ctx, int32_t *scan,
+				      uint32_t nb_channels),
+			   void *ctx);
+
+/* Leave the continuous read mode */
+int ad7124_cont_read_stop(struct ad7124_dev *dev);
+
 /* Initializes the AD7124 */
 int32_t ad7124_setup(struct ad7124_dev **device,
 		     struct ad7124_init_param *init_param);
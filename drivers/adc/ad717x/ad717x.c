@@ -45,6 +45,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include "ad717x.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
@@ -54,6 +55,9 @@
 #define COMM_ERR    -2 /* Communication error on receive */
 #define TIMEOUT     -3 /* A timeout has occured */
 
+/* Number of RDY polls done when leaving the continuous read mode */
+#define AD717X_CONT_READ_STOP_POLLS	10000
+
 /***************************************************************************//**
  * @brief Set channel status - Enable/Disable
  * @param device - AD717x Device descriptor.
@@ -379,8 +383,28 @@ int ad717x_single_read(ad717x_dev* device,  uint8_t id, int32_t *adc_raw_data)
 }
 
 /***************************************************************************//**
-* @brief  Searches through the list of registers of the driver instance and
-*         retrieves a pointer to the register that matches the given address.
+* @brief  Builds the address to slot index of the register list of the driver
+*         instance, used by AD717X_GetReg().
+*
+* @param device - The handler of the instance of the driver.
+*
+* @return None.
+*******************************************************************************/
+static void ad717x_index_regs(ad717x_dev *device)
+{
+	uint8_t i;
+
+	memset(device->reg_index, AD717X_REG_NONE, sizeof(device->reg_index));
+
+	/* The first entry wins when an address appears twice (COMM/STATUS) */
+	for (i = device->num_regs; i > 0; i--)
+		if (device->regs[i - 1].addr < AD717X_REG_ADDR_NO)
+			device->reg_index[device->regs[i - 1].addr] = i - 1;
+}
+
+/***************************************************************************//**
+* @brief  Retrieves a pointer to the register of the driver instance that
+*         matches the given address.
 *
 * @param device - The handler of the instance of the driver.
 * @param reg_address - The address to be used to find the register.
@@ -390,20 +414,11 @@ int ad717x_single_read(ad717x_dev* device,  uint8_t id, int32_t *adc_raw_data)
 ad717x_st_reg *AD717X_GetReg(ad717x_dev *device,
 			     uint8_t reg_address)
 {
-	uint8_t i;
-	ad717x_st_reg *reg = 0;
-
-	if (!device || !device->regs)
+	if (!device || !device->regs || reg_address >= AD717X_REG_ADDR_NO ||
+	    device->reg_index[reg_address] == AD717X_REG_NONE)
 		return 0;
 
-	for (i = 0; i < device->num_regs; i++) {
-		if (device->regs[i].addr == reg_address) {
-			reg = &device->regs[i];
-			break;
-		}
-	}
-
-	return reg;
+	return &device->regs[device->reg_index[reg_address]];
 }
 
 /***************************************************************************//**
@@ -773,6 +788,300 @@ int32_t ad717x_configure_device_odr(ad717x_dev *dev,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Add a conversion to the scan being built by the continuous read mode
+ *        and hand the scan over once every enabled channel is in.
+ * @param dev  - The device structure.
+ * @param chan - Channel of the conversion, from the appended status.
+ * @param data - Conversion result.
+*******************************************************************************/
+static void ad717x_cont_read_store(ad717x_dev *dev, uint8_t chan,
+				   int32_t data)
+{
+	uint32_t next;
+
+	if (dev->cont_cnt)
+		next = dev->cont_mask & ~NO_OS_GENMASK(dev->cont_last, 0);
+	else
+		next = dev->cont_mask;
+
+	/* The sequencer skipped or repeated a channel, restart the scan. */
+	if (!next || chan != no_os_find_first_set_bit(next)) {
+		dev->cont_errors++;
+		dev->cont_cnt = 0;
+		if (chan != no_os_find_first_set_bit(dev->cont_mask))
+			return;
+	}
+
+	dev->cont_scan[dev->cont_cnt++] = data;
+	dev->cont_last = chan;
+
+	if (dev->cont_cnt == no_os_hweight16(dev->cont_mask)) {
+		dev->cont_cb(dev->cont_ctx, dev->cont_scan, dev->cont_cnt);
+		dev->cont_cnt = 0;
+	}
+}
+
+/***************************************************************************//**
+ * @brief DOUT/RDY falling edge handler of the continuous read mode. Reads the
+ *        data register with the status appended, without a command byte.
+ * @param ctx - The device structure.
+*******************************************************************************/
+static void ad717x_cont_read_isr(void *ctx)
+{
+	ad717x_dev *dev = ctx;
+	ad717x_st_reg *data_reg;
+	uint8_t buf[7] = { 0 };
+	uint8_t check_buf[8];
+	struct no_os_spi_msg msg = {
+		.tx_buff = buf,
+		.rx_buff = buf,
+		/* Keep CS asserted so that RDY shows up on DOUT. */
+		.cs_change = 0,
+	};
+	uint32_t data = 0;
+	uint8_t check8 = 0;
+	uint8_t i;
+
+	/* DOUT toggles while the data is clocked out. */
+	if (no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number))
+		return;
+
+	/* Data followed by the status byte */
+	data_reg = AD717X_GetReg(dev, AD717X_DATA_REG);
+	msg.bytes_number = (dev->useCRC != AD717X_DISABLE) ? data_reg->size + 1 :
+			   data_reg->size;
+
+	if (no_os_spi_transfer(dev->spi_desc, &msg, 1))
+		goto out;
+
+	if (dev->useCRC != AD717X_DISABLE) {
+		check_buf[0] = AD717X_COMM_REG_WEN | AD717X_COMM_REG_RD |
+			       AD717X_COMM_REG_RA(AD717X_DATA_REG);
+		memcpy(&check_buf[1], buf, msg.bytes_number);
+		if (dev->useCRC == AD717X_USE_CRC)
+			check8 = AD717X_ComputeCRC8(check_buf, msg.bytes_number + 1);
+		else
+			check8 = AD717X_ComputeXOR8(check_buf, msg.bytes_number + 1);
+		if (check8) {
+			dev->cont_errors++;
+			goto out;
+		}
+	}
+
+	for (i = 0; i < data_reg->size - 1; i++)
+		data = (data << 8) | buf[i];
+	data_reg->value = data;
+
+	ad717x_cont_read_store(dev, AD717X_STATUS_REG_CH(buf[i]), data);
+
+out:
+	no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+}
+
+/***************************************************************************//**
+ * @brief Start the continuous read mode. The ADC converts the enabled channels
+ *        continuously and every RDY falling edge on DOUT triggers the read of
+ *        the result, so the SPI bus is not used to poll the status. CS stays
+ *        asserted until ad717x_cont_read_stop() is called.
+ * @param dev - The device structure.
+ * @param cb  - Called from the interrupt with one sample of every enabled
+ *              channel, in channel order.
+ * @param ctx - Parameter passed to the callback.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad717x_cont_read_start(ad717x_dev *dev,
+			   void (*cb)(void *ctx, int32_t *scan,
+				      uint32_t nb_channels),
+			   void *ctx)
+{
+	ad717x_st_reg *ifmode;
+	ad717x_st_reg *chmap;
+	uint8_t buf[4];
+	struct no_os_spi_msg msg = {
+		.tx_buff = buf,
+		.rx_buff = buf,
+		.cs_change = 0,
+	};
+	uint16_t mask = 0;
+	uint32_t value;
+	uint8_t i;
+	int ret;
+
+	if (!dev || !cb)
+		return -EINVAL;
+
+	if (!dev->gpio_rdy || !dev->irq_ctrl)
+		return -ENOTSUP;
+
+	if (dev->cont_cb)
+		return -EBUSY;
+
+	ifmode = AD717X_GetReg(dev, AD717X_IFMODE_REG);
+	if (!ifmode)
+		return -EINVAL;
+
+	for (i = 0; i < dev->num_channels; i++) {
+		chmap = AD717X_GetReg(dev, AD717X_CHMAP0_REG + i);
+		if (chmap && (chmap->value & AD717X_CHMAP_REG_CH_EN))
+			mask |= NO_OS_BIT(i);
+	}
+	if (!mask)
+		return -EINVAL;
+
+	ret = ad717x_set_adc_mode(dev, CONTINUOUS);
+	if (ret)
+		return ret;
+
+	dev->cont_mask = mask;
+	dev->cont_cnt = 0;
+	dev->cont_errors = 0;
+	dev->cont_ctx = ctx;
+	dev->cont_cb = cb;
+
+	value = ifmode->value | AD717X_IFMODE_REG_CONT_READ |
+		AD717X_IFMODE_REG_DATA_STAT;
+
+	buf[0] = AD717X_COMM_REG_WEN | AD717X_COMM_REG_WR |
+		 AD717X_COMM_REG_RA(AD717X_IFMODE_REG);
+	buf[1] = (value >> 8) & 0xFF;
+	buf[2] = value & 0xFF;
+	msg.bytes_number = 3;
+	if (dev->useCRC != AD717X_DISABLE) {
+		buf[3] = AD717X_ComputeCRC8(buf, 3);
+		msg.bytes_number++;
+	}
+
+	ret = no_os_spi_transfer(dev->spi_desc, &msg, 1);
+	if (ret)
+		goto error;
+
+	ifmode->value = value;
+	AD717X_ComputeDataregSize(dev);
+
+	ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		goto error_cont;
+
+	return 0;
+
+error_cont:
+	ad717x_cont_read_stop(dev);
+error:
+	dev->cont_cb = NULL;
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Leave the continuous read mode. A data read command issued while RDY
+ *        is low takes the interface back to register accesses.
+ * @param dev - The device structure.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad717x_cont_read_stop(ad717x_dev *dev)
+{
+	ad717x_st_reg *ifmode;
+	ad717x_st_reg *data_reg;
+	uint8_t buf[8] = { 0 };
+	uint32_t timeout;
+	uint8_t rdy = NO_OS_GPIO_HIGH;
+	int ret;
+
+	if (!dev || !dev->gpio_rdy || !dev->irq_ctrl)
+		return -EINVAL;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret)
+		return ret;
+
+	dev->cont_cb = NULL;
+
+	for (timeout = AD717X_CONT_READ_STOP_POLLS; timeout > 0; timeout--) {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+		if (rdy == NO_OS_GPIO_LOW)
+			break;
+	}
+	if (rdy != NO_OS_GPIO_LOW)
+		return -ETIMEDOUT;
+
+	data_reg = AD717X_GetReg(dev, AD717X_DATA_REG);
+	buf[0] = AD717X_COMM_REG_WEN | AD717X_COMM_REG_RD |
+		 AD717X_COMM_REG_RA(AD717X_DATA_REG);
+	ret = no_os_spi_write_and_read(dev->spi_desc, buf,
+				       (dev->useCRC != AD717X_DISABLE) ?
+				       data_reg->size + 2 : data_reg->size + 1);
+	if (ret)
+		return ret;
+
+	ifmode = AD717X_GetReg(dev, AD717X_IFMODE_REG);
+	ifmode->value &= ~AD717X_IFMODE_REG_CONT_READ;
+
+	return AD717X_WriteRegister(dev, AD717X_IFMODE_REG);
+}
+
+/***************************************************************************//**
+ * @brief Set up the optional DOUT/RDY GPIO and its interrupt, used by the
+ *        continuous read mode. The interrupt is enabled by
+ *        ad717x_cont_read_start().
+ * @param dev        - The device structure.
+ * @param init_param - The structure that contains the device initial
+ * 		               parameters.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int ad717x_rdy_irq_init(ad717x_dev *dev,
+			       ad717x_init_param *init_param)
+{
+	int ret;
+
+	dev->irq_ctrl = NULL;
+	dev->cont_cb = NULL;
+
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param->gpio_rdy);
+	if (ret)
+		return ret;
+
+	if (!dev->gpio_rdy || !init_param->irq_ctrl)
+		return 0;
+
+	ret = no_os_gpio_direction_input(dev->gpio_rdy);
+	if (ret)
+		goto error_gpio;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = ad717x_cont_read_isr,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  dev->gpio_rdy->number, &dev->irq_cb);
+	if (ret)
+		goto error_gpio;
+
+	ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+					  dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_irq;
+
+	dev->irq_ctrl = init_param->irq_ctrl;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl,
+				      dev->gpio_rdy->number, &dev->irq_cb);
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
+	dev->gpio_rdy = NULL;
+
+	return ret;
+}
+
 /***************************************************************************//**
 * @brief Initializes the AD717X.
 *
@@ -797,6 +1106,7 @@ int32_t AD717X_Init(ad717x_dev **device,
 
 	dev->regs = init_param.regs;
 	dev->num_regs = init_param.num_regs;
+	ad717x_index_regs(dev);
 
 	/* Initialize the SPI communication. */
 	ret = no_os_spi_init(&dev->spi_desc, &init_param.spi_init);
@@ -896,6 +1206,11 @@ int32_t AD717X_Init(ad717x_dev **device,
 		if (ret < 0)
 			return ret;
 	}
+
+	ret = ad717x_rdy_irq_init(dev, &init_param);
+	if (ret)
+		return ret;
+
 	*device = dev;
 
 	return ret;
@@ -910,6 +1225,19 @@ int32_t AD717X_remove(ad717x_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->irq_ctrl) {
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		ret = no_os_irq_unregister_callback(dev->irq_ctrl,
+						    dev->gpio_rdy->number,
+						    &dev->irq_cb);
+		if (ret)
+			return ret;
+	}
+
+	ret = no_os_gpio_remove(dev->gpio_rdy);
+	if (ret)
+		return ret;
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	no_os_free(dev);
@@ -48,6 +48,8 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_util.h"
 #include <stdbool.h>
 
@@ -251,6 +253,10 @@ typedef enum {
 	AD717X_USE_XOR,
 } ad717x_crc_mode;
 
+/* Size of the register address space */
+#define AD717X_REG_ADDR_NO    0x40
+#define AD717X_REG_NONE       0xFF
+
 /*! AD717X register info */
 typedef struct {
 	int32_t addr;
@@ -272,6 +278,8 @@ typedef struct {
 	/* Device Settings */
 	ad717x_st_reg		*regs;
 	uint8_t			num_regs;
+	/* Slot of each register address in regs, AD717X_REG_NONE if absent */
+	uint8_t			reg_index[AD717X_REG_ADDR_NO];
 	ad717x_crc_mode		useCRC;
 	/* Active Device */
 	enum ad717x_device_type active_device;
@@ -289,6 +297,19 @@ typedef struct {
 	struct ad717x_filtcon filter_configuration[AD717x_MAX_SETUPS];
 	/* ADC Mode */
 	enum ad717x_mode mode;
+	/* GPIO wired to DOUT/RDY, used by the continuous read mode */
+	struct no_os_gpio_desc	*gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	struct no_os_callback_desc irq_cb;
+	/* Continuous read: called with one sample of every enabled channel */
+	void (*cont_cb)(void *ctx, int32_t *scan, uint32_t nb_channels);
+	void *cont_ctx;
+	uint16_t cont_mask;
+	int8_t cont_last;
+	uint8_t cont_cnt;
+	int32_t cont_scan[AD717x_MAX_CHANNELS];
+	/* Conversions dropped for a bad checksum or an out of order channel */
+	uint32_t cont_errors;
 } ad717x_dev;
 
 typedef struct {
@@ -315,6 +336,9 @@ typedef struct {
 	struct ad717x_filtcon filter_configuration[AD717x_MAX_SETUPS];
 	/* ADC Mode */
 	enum ad717x_mode mode;
+	/* Optional GPIO wired to DOUT/RDY and its interrupt controller */
+	struct no_os_gpio_init_param *gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
 } ad717x_init_param;
 
 /*****************************************************************************/
@@ -571,6 +595,15 @@ uint8_t AD717X_ComputeXOR8(uint8_t * pBuf,
 /*! Updates the CRC settings. */
 int32_t AD717X_UpdateCRCSetting(ad717x_dev *device);
 
+/*! Starts reading conversions from the DOUT/RDY interrupt. */
+int ad717x_cont_read_start(ad717x_dev *dev,
+			   void (*cb)(void *ctx, int32_t *scan,
+				      uint32_t nb_channels),
+			   void *ctx);
+
+/*! Leaves the continuous read mode. */
+int ad717x_cont_read_stop(ad717x_dev *dev);
+
 /*! Initializes the AD717X. */
 int32_t AD717X_Init(ad717x_dev **device,
 		    ad717x_init_param init_param);
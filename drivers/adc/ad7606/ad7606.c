@@ -65,8 +65,8 @@ struct ad7606_chip_info {
 	uint32_t sw_range_table_sz;
 };
 
-NO_OS_DECLARE_CRC8_TABLE(ad7606_crc8);
-NO_OS_DECLARE_CRC16_TABLE(ad7606_crc16);
+static const uint8_t *ad7606_crc8;
+static const uint16_t *ad7606_crc16;
 
 static const struct ad7606_range ad7606_range_table[] = {
 	{-5000, 5000, false},	/* RANGE pin LOW */
@@ -460,7 +460,7 @@ int32_t ad7606_convst(struct ad7606_dev *dev)
 int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 {
 	uint32_t sz;
-	int32_t ret, i;
+	int32_t ret;
 	uint16_t crc, icrc;
 	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
 	uint8_t sbits = dev->config.status_header ? 8 : 0;
@@ -506,16 +506,10 @@ int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 			return ret;
 		break;
 	case 16:
-		for(i = 0; i < nchannels; i++) {
-			if (dev->config.status_header) {
-				data[i] = (uint32_t)dev->data[i*3] << 16;
-				data[i] |= (uint32_t)dev->data[i*3+1] << 8;
-				data[i] |= (uint32_t)dev->data[i*3+2];
-			} else {
-				data[i] = (uint32_t)dev->data[i*2] << 8;
-				data[i] |= (uint32_t)dev->data[i*2+1];
-			}
-		}
+		if (dev->config.status_header)
+			no_os_get_unaligned_be24_array(dev->data, data, nchannels);
+		else
+			no_os_get_unaligned_be16_array(dev->data, data, nchannels);
 		break;
 	default:
 		ret = -ENOTSUP;
@@ -525,6 +519,70 @@ int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 	return ret;
 }
 
+/***************************************************************************//**
+ * @brief Read conversion data over the memory mapped parallel bus.
+ *
+ * One 16-bit bus read (RD strobe) per channel, starting with channel 1.
+ *
+ * @param dev        - The device structure.
+ * @param data       - Pointer to location of buffer where to store the data.
+ *
+ * @return ret - return code.
+ *         Example: -ENOSYS - Parallel bus not available.
+ *                  -ENOTSUP - Device bits per sample or status header not
+ *                             supported on the parallel bus.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7606_par_data_read(struct ad7606_dev *dev, uint32_t *data)
+{
+	volatile uint16_t *bus = (volatile uint16_t *)dev->par_baseaddr;
+	uint8_t i;
+
+	if (!bus)
+		return -ENOSYS;
+
+	if (ad7606_chip_info_tbl[dev->device_id].bits != 16 ||
+	    dev->config.status_header)
+		return -ENOTSUP;
+
+	for (i = 0; i < dev->num_channels; i++)
+		data[i] = *bus;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Read conversions over the parallel bus by DMA, without CPU
+ *        involvement per conversion.
+ *
+ * CONVST has to be driven by a timer or PWM, each BUSY falling edge issues
+ * the DMA requests reading a whole scan. Each 32-bit word of buf holds two
+ * consecutive channels, the lower one in the low half word.
+ *
+ * @param dev        - The device structure.
+ * @param buf        - Buffer of nb_scans * num_channels / 2 words.
+ * @param nb_scans   - Number of scans to read.
+ *
+ * @return ret - return code.
+ *         Example: -ENOSYS - Parallel bus DMA not available.
+ *                  -ENOTSUP - Device bits per sample or status header not
+ *                             supported on the parallel bus.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7606_par_stream_read(struct ad7606_dev *dev, uint32_t *buf,
+			       uint32_t nb_scans)
+{
+	if (!dev->par_baseaddr || !dev->par_dma_read)
+		return -ENOSYS;
+
+	if (ad7606_chip_info_tbl[dev->device_id].bits != 16 ||
+	    dev->config.status_header)
+		return -ENOTSUP;
+
+	return dev->par_dma_read(dev->par_dma_ctx, dev->par_baseaddr, buf,
+				 nb_scans * dev->num_channels / 2);
+}
+
 /***************************************************************************//**
  * @brief Blocking conversion start and data read.
  *
@@ -571,6 +629,9 @@ int32_t ad7606_read(struct ad7606_dev *dev, uint32_t * data)
 		no_os_udelay(tconv_max[dev->oversampling.os_ratio]);
 	}
 
+	if (dev->par_baseaddr)
+		return ad7606_par_data_read(dev, data);
+
 	return ad7606_spi_data_read(dev, data);
 }
 
@@ -732,9 +793,11 @@ static int32_t ad7606_request_gpios(struct ad7606_dev *dev,
 		return ret;
 
 	if (dev->gpio_par_ser) {
-		/* Driver currently supports only serial interface, therefore,
-		 * if available, pull the GPIO HIGH. */
-		ret = no_os_gpio_direction_output(dev->gpio_par_ser, NO_OS_GPIO_HIGH);
+		/* Select the parallel interface only if the memory mapped bus
+		 * is available, serial otherwise. */
+		ret = no_os_gpio_direction_output(dev->gpio_par_ser,
+						  dev->par_baseaddr ? NO_OS_GPIO_LOW :
+						  NO_OS_GPIO_HIGH);
 		if (ret < 0)
 			return ret;
 	}
@@ -794,6 +857,65 @@ int32_t ad7606_set_oversampling(struct ad7606_dev *dev,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Split an averaging ratio between on-chip oversampling and host
+ *        decimation, and apply the on-chip part.
+ *
+ * The largest on-chip ratio whose conversion time fits the trigger period is
+ * selected, since it costs no host cycles. If split->decimation is higher than
+ * 1, the remainder has to be done with a CIC decimator on the host, e.g. with
+ * a no_os_dsp_scan chain of no_os_dsp_cic stages. CONVST has to be pulsed at
+ * split->conv_rate_hz.
+ *
+ * @param dev         - The device structure.
+ * @param out_rate_hz - Requested output rate.
+ * @param ratio       - Requested total averaging ratio, i.e. noise reduction
+ *                      of sqrt(ratio).
+ * @param readout_ns  - Time needed to read one conversion out of the device.
+ * @param split       - The selected split.
+ *
+ * @return ret - return code.
+ *         Example: -EINVAL - Invalid parameters.
+ *                  -ERANGE - Output rate not reachable with this ratio.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7606_split_oversampling(struct ad7606_dev *dev, uint32_t out_rate_hz,
+				  uint32_t ratio, uint32_t readout_ns,
+				  struct no_os_dsp_os_split *split)
+{
+	uint32_t tconv_ns[NO_OS_ARRAY_SIZE(tconv_max)];
+	struct ad7606_oversampling oversampling = {0};
+	unsigned int nb_osr;
+	unsigned int i;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!ad7606_chip_info_tbl[dev->device_id].has_oversampling)
+		nb_osr = AD7606_OSR_1 + 1;
+	else if (dev->sw_mode)
+		nb_osr = AD7606_OSR_256 + 1;
+	else
+		nb_osr = AD7606_OSR_64 + 1;
+
+	for (i = 0; i < nb_osr; i++)
+		tconv_ns[i] = tconv_max[i] * 1000;
+
+	ret = no_os_dsp_os_split(tconv_ns, nb_osr, out_rate_hz, ratio,
+				 readout_ns, split);
+	if (ret)
+		return ret;
+
+	if (nb_osr == 1)
+		return 0;
+
+	oversampling.os_pad = dev->oversampling.os_pad;
+	oversampling.os_ratio = split->osr_idx;
+
+	return ad7606_set_oversampling(dev, oversampling);
+}
+
 /* Internal function to find the index of a given operation range in the
  * operation range table specific to a device. */
 static int8_t ad7606_find_range(struct ad7606_dev *dev,
@@ -1114,8 +1236,10 @@ int32_t ad7606_init(struct ad7606_dev **device,
 	uint8_t reg, id;
 	int32_t i, ret;
 
-	no_os_crc8_populate_msb(ad7606_crc8, 0x7);
-	no_os_crc16_populate_msb(ad7606_crc16, 0x755b);
+	ad7606_crc8 = no_os_crc8_get_table(0x7);
+	ad7606_crc16 = no_os_crc16_get_table(0x755b);
+	if (!ad7606_crc8 || !ad7606_crc16)
+		return -ENOMEM;
 
 	dev = (struct ad7606_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
@@ -1124,6 +1248,9 @@ int32_t ad7606_init(struct ad7606_dev **device,
 	dev->device_id = init_param->device_id;
 	dev->num_channels = ad7606_chip_info_tbl[dev->device_id].num_channels;
 	dev->max_dout_lines = ad7606_chip_info_tbl[dev->device_id].max_dout_lines;
+	dev->par_baseaddr = init_param->par_baseaddr;
+	dev->par_dma_read = init_param->par_dma_read;
+	dev->par_dma_ctx = init_param->par_dma_ctx;
 	if (ad7606_chip_info_tbl[dev->device_id].has_registers)
 		dev->sw_mode = init_param->sw_mode;
 
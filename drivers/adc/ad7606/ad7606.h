@@ -49,6 +49,7 @@
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 #include "no_os_util.h"
+#include "no_os_dsp.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -315,6 +316,13 @@ struct ad7606_dev {
 	struct ad7606_range range_ch[AD7606_MAX_CHANNELS];
 	/** Data buffer (used internally by the SPI communication functions) */
 	uint8_t data[28];
+	/** Memory mapped parallel bus (FMC/FSMC bank), 0 if not wired */
+	uintptr_t par_baseaddr;
+	/** Optional DMA read from the parallel bus, paced by BUSY */
+	int32_t (*par_dma_read)(void *ctx, uintptr_t src, uint32_t *dst,
+				uint32_t nb_words);
+	/** First parameter of par_dma_read */
+	void *par_dma_ctx;
 };
 
 /**
@@ -360,6 +368,15 @@ struct ad7606_init_param {
 	uint8_t gain_ch[AD7606_MAX_CHANNELS];
 	/** Channel operating range */
 	struct ad7606_range range_ch[AD7606_MAX_CHANNELS];
+	/** Memory mapped parallel bus (FMC/FSMC bank) for conversion data,
+	 *  0 to read the data over SPI */
+	uintptr_t par_baseaddr;
+	/** Optional DMA read of nb_words 32-bit words from src, one request
+	 *  per BUSY falling edge (e.g. stm32_fmc_dma_read) */
+	int32_t (*par_dma_read)(void *ctx, uintptr_t src, uint32_t *dst,
+				uint32_t nb_words);
+	/** First parameter of par_dma_read */
+	void *par_dma_ctx;
 };
 
 int32_t ad7606_spi_reg_read(struct ad7606_dev *dev,
@@ -374,12 +391,20 @@ int32_t ad7606_spi_write_mask(struct ad7606_dev *dev,
 			      uint32_t val);
 int32_t ad7606_spi_data_read(struct ad7606_dev *dev,
 			     uint32_t *data);
+int32_t ad7606_par_data_read(struct ad7606_dev *dev,
+			     uint32_t *data);
 int32_t ad7606_read(struct ad7606_dev *dev,
 		    uint32_t *data);
+int32_t ad7606_par_stream_read(struct ad7606_dev *dev,
+			       uint32_t *buf,
+			       uint32_t nb_scans);
 int32_t ad7606_convst(struct ad7606_dev *dev);
 int32_t ad7606_reset(struct ad7606_dev *dev);
 int32_t ad7606_set_oversampling(struct ad7606_dev *dev,
 				struct ad7606_oversampling oversampling);
+int32_t ad7606_split_oversampling(struct ad7606_dev *dev, uint32_t out_rate_hz,
+				  uint32_t ratio, uint32_t readout_ns,
+				  struct no_os_dsp_os_split *split);
 int32_t ad7606_set_ch_range(struct ad7606_dev *dev, uint8_t ch,
 			    struct ad7606_range range);
 int32_t ad7606_set_ch_offset(struct ad7606_dev *dev, uint8_t ch,
@@ -69,6 +69,8 @@
 #define AD7616_GET_BIT(v, b)		((v >> b) & 1)
 #define AD7616_TOGGLE_TIMEOUT_DELAY	(8192 * 1024)
 #define SPI_ENGINE_WORDS_PER_READ	1
+/* Conversion cycle of one channel pair, 1 MSPS */
+#define AD7616_TCONV_NS			1000
 
 /**
  * @brief Compute the CRC for one channel. See CRC chapter in the datasheet
@@ -606,6 +608,59 @@ int32_t ad7616_set_oversampling_ratio(struct ad7616_dev *dev,
 	return 0;
 }
 
+/**
+ * @brief Split an averaging ratio between on-chip oversampling and host
+ *        decimation, and apply the on-chip part.
+ *
+ * The conversion time accounts for all the sequencer layers, which are
+ * converted on each trigger in burst mode. The largest on-chip ratio that
+ * fits the trigger period is selected, since it costs no host cycles. If
+ * split->decimation is higher than 1, the remainder has to be done with a CIC
+ * decimator on the host, e.g. with a no_os_dsp_scan chain of no_os_dsp_cic
+ * stages. If a trigger PWM is used, its period is set to
+ * split->conv_rate_hz.
+ * @param dev - ad7616_dev device handler.
+ * @param out_rate_hz - Requested output rate.
+ * @param ratio - Requested total averaging ratio, i.e. noise reduction of
+ *		  sqrt(ratio).
+ * @param readout_ns - Time needed to read one burst out of the device.
+ * @param split - The selected split.
+ * @return 0 in case of success, -ERANGE if the output rate can't be reached
+ *	   with this ratio, negative error code otherwise.
+ */
+int32_t ad7616_split_oversampling(struct ad7616_dev *dev, uint32_t out_rate_hz,
+				  uint32_t ratio, uint32_t readout_ns,
+				  struct no_os_dsp_os_split *split)
+{
+	uint32_t tconv_ns[AD7616_OSR_128 + 1];
+	unsigned int i;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(tconv_ns); i++)
+		tconv_ns[i] = (AD7616_TCONV_NS << i) * dev->layers_nb;
+
+	ret = no_os_dsp_os_split(tconv_ns, NO_OS_ARRAY_SIZE(tconv_ns),
+				 out_rate_hz, ratio, readout_ns, split);
+	if (ret)
+		return ret;
+
+	ret = ad7616_set_oversampling_ratio(dev, split->osr_idx);
+	if (ret)
+		return ret;
+
+	if (dev->trigger_pwm_desc) {
+		ret = no_os_pwm_set_period(dev->trigger_pwm_desc,
+					   1000000000 / split->conv_rate_hz);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
 #ifdef XILINX_PLATFORM
 /**
  * @brief Read from device in serial mode.
@@ -721,9 +776,17 @@ int32_t ad7616_par_read(struct ad7616_dev *dev, uint8_t reg_addr,
 	no_os_mdelay(1);
 
 	return 0;
-#endif
+#else
+	volatile uint16_t *bus = (volatile uint16_t *)dev->par_baseaddr;
+
+	if (!bus)
+		return -ENOSYS;
+
+	*bus = (reg_addr & 0x3F) << 9;
+	*reg_data = *bus & 0xFF;
 
-	return -ENOSYS;
+	return 0;
+#endif
 }
 
 /**
@@ -743,9 +806,16 @@ int32_t ad7616_par_write(struct ad7616_dev *dev, uint8_t reg_addr,
 	no_os_mdelay(1);
 
 	return 0;
-#endif
+#else
+	volatile uint16_t *bus = (volatile uint16_t *)dev->par_baseaddr;
 
-	return -ENOSYS;
+	if (!bus)
+		return -ENOSYS;
+
+	*bus = 0x8000 | ((reg_addr & 0x3F) << 9) | (reg_data & 0xFF);
+
+	return 0;
+#endif
 }
 
 /**
@@ -801,9 +871,40 @@ int32_t ad7616_read_data_parallel(struct ad7616_dev *dev,
 	no_os_axi_io_write(dev->core_baseaddr, AD7616_REG_UP_CTRL, AD7616_CTRL_RESETN);
 
 	return 0;
-#endif
+#else
+	volatile uint32_t *bus = (volatile uint32_t *)dev->par_baseaddr;
+	uint32_t i, j;
+	int32_t ret;
+
+	if (!bus)
+		return -ENOSYS;
+
+	/* Hardware paced: PWM on CONVST, DMA request on each BUSY edge */
+	if (dev->par_dma_read && dev->trigger_pwm_desc) {
+		ret = no_os_pwm_enable(dev->trigger_pwm_desc);
+		if (ret != 0)
+			return ret;
+
+		ret = dev->par_dma_read(dev->par_dma_ctx, dev->par_baseaddr, buf,
+					samples * dev->layers_nb);
+
+		no_os_pwm_disable(dev->trigger_pwm_desc);
+
+		return ret;
+	}
+
+	/* The bus splits each 32-bit load in channel A and B RD strobes */
+	for (i = 0; i < samples; i++) {
+		ret = ad7616_toggle_conv(dev);
+		if (ret != 0)
+			return ret;
+
+		for (j = 0; j < dev->layers_nb; j++)
+			*buf++ = *bus;
+	}
 
-	return -ENOSYS;
+	return 0;
+#endif
 }
 
 #ifdef XILINX_PLATFORM
@@ -976,7 +1077,20 @@ int32_t ad7616_setup(struct ad7616_dev **device,
 
 	ad7616_core_setup(dev);
 #else
-	dev->interface = AD7616_SERIAL;
+	dev->par_baseaddr = init_param->par_baseaddr;
+	dev->par_dma_read = init_param->par_dma_read;
+	dev->par_dma_ctx = init_param->par_dma_ctx;
+	if (dev->par_baseaddr)
+		dev->interface = AD7616_PARALLEL;
+	else
+		dev->interface = AD7616_SERIAL;
+
+	if (init_param->trigger_pwm_init) {
+		ret = no_os_pwm_init(&dev->trigger_pwm_desc,
+				     init_param->trigger_pwm_init);
+		if (ret != 0)
+			goto cleanup;
+	}
 #endif
 
 	if (dev->interface == AD7616_SERIAL) {
@@ -1074,10 +1188,11 @@ void ad7616_remove(struct ad7616_dev *dev)
 #ifdef XILINX_PLATFORM
 	if (dev->clkgen)
 		axi_clkgen_remove(dev->clkgen);
-
-	no_os_pwm_remove(dev->trigger_pwm_desc);
 #endif
 
+	if (dev->trigger_pwm_desc)
+		no_os_pwm_remove(dev->trigger_pwm_desc);
+
 	if (dev->interface == AD7616_SERIAL)
 		no_os_spi_remove(dev->spi_desc);
 
@@ -41,11 +41,12 @@
 #define AD7616_H_
 
 #include "no_os_gpio.h"
+#include "no_os_dsp.h"
 
 #include <stdint.h>
+#include "no_os_pwm.h"
 
 #ifdef XILINX_PLATFORM
-#include "no_os_pwm.h"
 #include "clk_axi_clkgen.h"
 #endif
 
@@ -194,6 +195,11 @@ struct ad7616_dev {
 	struct no_os_gpio_desc	*gpio_busy;
 	/* AXI Core */
 	uint32_t core_baseaddr;
+	/* Memory mapped parallel bus (FMC/FSMC bank) */
+	uintptr_t par_baseaddr;
+	int32_t (*par_dma_read)(void *ctx, uintptr_t src, uint32_t *dst,
+				uint32_t nb_words);
+	void *par_dma_ctx;
 	/* Device Settings */
 	enum ad7616_interface	interface;
 	enum ad7616_mode			mode;
@@ -228,6 +234,15 @@ struct ad7616_init_param {
 	struct no_os_gpio_init_param		*gpio_busy_param;
 	/* Core */
 	uint32_t			core_baseaddr;
+	/* Memory mapped parallel bus (FMC/FSMC bank) used instead of SPI on
+	 * the non FPGA platforms, 0 if not wired. */
+	uintptr_t			par_baseaddr;
+	/* Optional DMA read of nb_words 32-bit words from src, one request per
+	 * BUSY falling edge (e.g. stm32_fmc_dma_read). Each word holds the
+	 * channel A and B results of one conversion. */
+	int32_t (*par_dma_read)(void *ctx, uintptr_t src, uint32_t *dst,
+				uint32_t nb_words);
+	void				*par_dma_ctx;
 	/* Device Settings */
 	enum ad7616_mode			mode;
 	enum ad7616_range		va[8];
@@ -295,6 +310,10 @@ int32_t ad7616_set_mode(struct ad7616_dev *dev,
 /* Set the oversampling ratio. */
 int32_t ad7616_set_oversampling_ratio(struct ad7616_dev *dev,
 				      enum ad7616_osr osr);
+/* Split an averaging ratio between on-chip oversampling and host decimation. */
+int32_t ad7616_split_oversampling(struct ad7616_dev *dev, uint32_t out_rate_hz,
+				  uint32_t ratio, uint32_t readout_ns,
+				  struct no_os_dsp_os_split *split);
 /* Read data in serial mode. */
 int32_t ad7616_read_data_serial(struct ad7616_dev *dev,
 				struct ad7616_conversion_result *results,
@@ -48,6 +48,10 @@
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_util.h"
+
+static const uint8_t *ad77681_crc8_table;
 
 /******************************************************************************/
 /************************** Functions Implementation **************************/
@@ -63,21 +67,10 @@ uint8_t ad77681_compute_crc8(uint8_t *data,
 			     uint8_t data_size,
 			     uint8_t init_val)
 {
-	uint8_t i;
-	uint8_t crc = init_val;
+	if (!ad77681_crc8_table)
+		ad77681_crc8_table = no_os_crc8_get_table(AD77681_CRC8_POLY);
 
-	while (data_size) {
-		for (i = 0x80; i != 0; i >>= 1) {
-			if (((crc & 0x80) != 0) != ((*data & i) != 0)) {
-				crc <<= 1;
-				crc ^= AD77681_CRC8_POLY;
-			} else
-				crc <<= 1;
-		}
-		data++;
-		data_size--;
-	}
-	return crc;
+	return no_os_crc8(ad77681_crc8_table, data, data_size, init_val);
 }
 
 /**
@@ -427,6 +420,33 @@ int32_t ad77681_data_to_voltage(struct ad77681_dev *dev,
 	return 0;
 }
 
+/**
+ * Conversion of a buffer of measured data to microvolts, in fixed point
+ * @param dev - The device structure.
+ * @param raw_code - ADC raw code measurements
+ * @param microvolts - Converted ADC codes, may be the same memory as raw_code
+ * @param nb_samples - Number of codes
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad77681_data_to_microvolts(struct ad77681_dev *dev,
+				   const uint32_t *raw_code,
+				   int32_t *microvolts,
+				   uint32_t nb_samples)
+{
+	uint32_t i;
+
+	if (!dev || !raw_code || !microvolts)
+		return -EINVAL;
+
+	for (i = 0; i < nb_samples; i++)
+		microvolts[i] = no_os_sign_extend32(raw_code[i],
+						    AD7768_N_BITS - 1);
+
+	/* ((2*Vref)*code)/2^24	*/
+	return no_os_scale_buffer(&dev->scale, microvolts, microvolts,
+				  nb_samples);
+}
+
 /**
  * Update ADCs sample rate depending on MCLK, MCLK_DIV and filter settings
  * @param dev - The device structure.
@@ -1790,6 +1810,15 @@ int32_t ad77681_setup(struct ad77681_dev **device,
 	dev->sample_rate = init_param.sample_rate;
 	dev->data_frame_byte = init_param.data_frame_byte;
 
+	/* vref is in mV */
+	ret = no_os_scale_set(&dev->scale, 2 * 1000 * dev->vref,
+			      AD7768_FULL_SCALE, 0);
+	if (ret) {
+		no_os_free(dev);
+		no_os_free(stat);
+		return ret;
+	}
+
 	ret = no_os_spi_init(&dev->spi_desc, &init_param.spi_eng_dev_init);
 	if (ret < 0) {
 		no_os_free(dev);
@@ -41,6 +41,7 @@
 #define SRC_AD77681_H_
 
 #include "no_os_spi.h"
+#include "no_os_scale.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -549,6 +550,7 @@ struct ad77681_dev {
 	uint16_t                        mclk;               /* Mater clock*/
 	uint32_t                        sample_rate;        /* Sample rate*/
 	uint8_t                         data_frame_byte;    /* SPI 8bit frames*/
+	struct no_os_scale              scale;              /* Code to uV */
 };
 
 struct ad77681_init_param {
@@ -639,6 +641,10 @@ int32_t ad77681_clear_error_flags(struct ad77681_dev *dev);
 int32_t ad77681_data_to_voltage(struct ad77681_dev *dev,
 				uint32_t *raw_code,
 				double *voltage);
+int32_t ad77681_data_to_microvolts(struct ad77681_dev *dev,
+				   const uint32_t *raw_code,
+				   int32_t *microvolts,
+				   uint32_t nb_samples);
 int32_t ad77681_CRC_status_handling(struct ad77681_dev *dev,
 				    uint16_t *data_buffer);
 int32_t ad77681_set_AINn_buffer(struct ad77681_dev *dev,
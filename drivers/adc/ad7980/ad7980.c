@@ -41,8 +41,10 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <errno.h>
 #include "ad7980.h"           // AD7980 definitions.
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -69,6 +71,8 @@ int8_t ad7980_init(struct ad7980_dev **device,
 	if (!dev)
 		return -1;
 
+	dev->stream = NULL;
+
 	/* SPI */
 	status = no_os_spi_init(&dev->spi_desc, &init_param.spi_init);
 	/* GPIO */
@@ -94,6 +98,9 @@ int32_t ad7980_remove(struct ad7980_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->stream)
+		ad7980_stream_stop(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	ret |= no_os_gpio_remove(dev->gpio_cs);
@@ -132,6 +139,128 @@ uint16_t ad7980_conversion(struct ad7980_dev *dev)
 	return(received_data);
 }
 
+/***************************************************************************//**
+ * @brief Starts timer paced acquisition at the given sample rate.
+ *
+ * The PWM drives CNV, high for the conversion time, and its pulse finished
+ * interrupt must call ad7980_stream_trigger(). The result is read by DMA while
+ * CNV is low and the PWM already schedules the next conversion. The chip
+ * select GPIO stays low while streaming.
+ *
+ * @param dev            - The device structure.
+ * @param cnv_pwm_init   - CNV PWM parameters, period and duty cycle are set by
+ *                         the driver.
+ * @param sample_rate_hz - Sample rate, up to AD7980_SAMPLE_RATE_MAX.
+ * @param ring           - Ring buffer, nb_blocks * block_samples *
+ *                         AD7980_STREAM_FRAME_BYTES large.
+ * @param block_samples  - Number of samples in a block.
+ * @param nb_blocks      - Number of blocks in the ring, at least 2.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7980_stream_start(struct ad7980_dev *dev,
+			    struct no_os_pwm_init_param *cnv_pwm_init,
+			    uint32_t sample_rate_hz, uint8_t *ring,
+			    uint32_t block_samples, uint32_t nb_blocks)
+{
+	struct no_os_sar_stream_init_param param = {
+		.cnv_pwm_init = cnv_pwm_init,
+		.sample_rate_hz = sample_rate_hz,
+		.cnv_high_ns = AD7980_TCONV_NS,
+		.frame_bytes = AD7980_STREAM_FRAME_BYTES,
+		.frame_tx = {0xFF, 0xFF},
+		.ring = ring,
+		.block_samples = block_samples,
+		.nb_blocks = nb_blocks,
+	};
+	int32_t ret;
+
+	if (!dev || dev->stream || sample_rate_hz > AD7980_SAMPLE_RATE_MAX)
+		return -EINVAL;
+
+	param.spi_desc = dev->spi_desc;
+
+	if (dev->gpio_cs) {
+		ret = AD7980_CS_LOW;
+		if (ret)
+			return ret;
+	}
+
+	ret = no_os_sar_stream_init(&dev->stream, &param);
+	if (ret && dev->gpio_cs)
+		AD7980_CS_HIGH;
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Reads the last conversion, called on each conversion tick.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, -EBUSY if the sample was dropped, negative
+ *         error code otherwise.
+*******************************************************************************/
+int32_t ad7980_stream_trigger(struct ad7980_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	return no_os_sar_stream_trigger(dev->stream);
+}
+
+/***************************************************************************//**
+ * @brief Gets the oldest complete block of samples.
+ *
+ * @param dev  - The device structure.
+ * @param data - Conversion results, block_samples large.
+ *
+ * @return 0 in case of success, -EAGAIN if no block is available, negative
+ *         error code otherwise.
+*******************************************************************************/
+int32_t ad7980_stream_read(struct ad7980_dev *dev, uint16_t *data)
+{
+	uint8_t *frame;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !data)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_read(dev->stream, &frame);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < dev->stream->block_samples; i++)
+		data[i] = no_os_get_unaligned_be16(frame + i *
+						   AD7980_STREAM_FRAME_BYTES);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Stops timer paced acquisition.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7980_stream_stop(struct ad7980_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_remove(dev->stream);
+	dev->stream = NULL;
+
+	if (dev->gpio_cs)
+		AD7980_CS_HIGH;
+
+	return ret;
+}
+
 /***************************************************************************//**
  * @brief Converts a 16-bit raw sample to volts.
  *
@@ -45,6 +45,7 @@
 #include <stdint.h>
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
+#include "no_os_sar_stream.h"
 
 /******************************************************************************/
 /******************************** AD7980 **************************************/
@@ -55,6 +56,13 @@
 #define AD7980_CS_HIGH          no_os_gpio_set_value(dev->gpio_cs,  \
 			        NO_OS_GPIO_HIGH)
 
+/* Maximum sample rate */
+#define AD7980_SAMPLE_RATE_MAX	1000000
+/* Conversion time, CNV is held high this long when streaming */
+#define AD7980_TCONV_NS		710
+/* Bytes read for one sample when streaming */
+#define AD7980_STREAM_FRAME_BYTES	2
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -64,6 +72,8 @@ struct ad7980_dev {
 	struct no_os_spi_desc	*spi_desc;
 	/* GPIO */
 	struct no_os_gpio_desc	*gpio_cs;
+	/* Timer paced acquisition, NULL when not running */
+	struct no_os_sar_stream	*stream;
 };
 
 struct ad7980_init_param {
@@ -87,6 +97,21 @@ int32_t ad7980_remove(struct ad7980_dev *dev);
 /*! Initiates conversion and reads data. */
 uint16_t ad7980_conversion(struct ad7980_dev *dev);
 
+/*! Starts timer paced acquisition at the given sample rate. */
+int32_t ad7980_stream_start(struct ad7980_dev *dev,
+			    struct no_os_pwm_init_param *cnv_pwm_init,
+			    uint32_t sample_rate_hz, uint8_t *ring,
+			    uint32_t block_samples, uint32_t nb_blocks);
+
+/*! Reads the last conversion, called on each conversion tick. */
+int32_t ad7980_stream_trigger(struct ad7980_dev *dev);
+
+/*! Gets the oldest complete block of samples. */
+int32_t ad7980_stream_read(struct ad7980_dev *dev, uint16_t *data);
+
+/*! Stops timer paced acquisition. */
+int32_t ad7980_stream_stop(struct ad7980_dev *dev);
+
 /*! Converts a 16-bit raw sample to volts. */
 float ad7980_convert_to_volts(uint16_t raw_sample, float v_ref);
 
@@ -292,6 +292,7 @@
 
 #define AD9081_USE_FLOATING_TYPE 0
 #define AD9081_USE_SPI_BURST_MODE 0
+#define AD9081_NCO_BATCH_XFER_BYTES 24
 
 /*============= ENUMS ==============*/
 
@@ -726,6 +727,19 @@ typedef struct {
 	uint8_t phy_src_err_cnt; /*!< PRBS Test Source Error Count */
 } adi_ad9081_prbs_test_t;
 
+/*!
+ * @brief DDC NCO Batch Update Entry
+ */
+typedef struct {
+	uint8_t ddcs; /*!< Coarse or fine DDCs selection, depending on fine */
+	uint8_t fine; /*!< 0: coarse DDCs, 1: fine DDCs */
+	int64_t shift_hz; /*!< NCO frequency shift in Hz */
+	uint64_t ftw; /*!< Frequency tuning word */
+	uint64_t phase_offset; /*!< Phase offset word */
+	uint64_t modulus_a; /*!< Modulus A word */
+	uint64_t modulus_b; /*!< Modulus B word */
+} adi_ad9081_adc_nco_batch_t;
+
 /*!
  * @brief JESD SPO Structure
  */
@@ -3198,6 +3212,85 @@ int32_t
 adi_ad9081_adc_ddc_fine_chip_xfer_status_get(adi_ad9081_device_t *device,
 					     uint8_t fddcs, uint8_t *status);
 
+/**
+ * @ingroup rx_nco_setup
+ * @brief  Precompute the NCO words of a batch of DDC NCO updates
+ *         Call after adi_ad9081_device_startup_rx().
+ *
+ *         Fills ftw, phase_offset, modulus_a and modulus_b of every entry
+ *         from its ddcs, fine and shift_hz members. The fine DDCs of an
+ *         entry must share the same coarse DDC decimation.
+ *
+ * @param  device     Pointer to the device structure
+ * @param  batch      Array of NCO updates
+ * @param  num        Number of entries in batch
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_adc_ddc_nco_batch_calc(adi_ad9081_device_t *device,
+					  adi_ad9081_adc_nco_batch_t *batch,
+					  uint8_t num);
+
+/**
+ * @ingroup rx_nco_setup
+ * @brief  Configure the DDCs for batched NCO updates
+ *         Call after adi_ad9081_device_startup_rx().
+ *
+ *         The phase increment and phase offset written afterwards are held
+ *         until the chip transfer, either by
+ *         adi_ad9081_adc_ddc_nco_batch_commit() or by the chip transfer GPIO.
+ *
+ * @param  device     Pointer to the device structure
+ * @param  cddcs      Coarse DDCs selection, @see adi_ad9081_adc_coarse_ddc_select_e
+ * @param  fddcs      Fine DDCs selection, @see adi_ad9081_adc_fine_ddc_select_e
+ * @param  gpio_xfer  0: chip transfer by SPI, 1: chip transfer by GPIO
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_adc_ddc_nco_batch_prepare(adi_ad9081_device_t *device,
+					     uint8_t cddcs, uint8_t fddcs,
+					     uint8_t gpio_xfer);
+
+/**
+ * @ingroup rx_nco_setup
+ * @brief  Write a precomputed batch of DDC NCO updates
+ *         Call after adi_ad9081_adc_ddc_nco_batch_prepare().
+ *
+ *         Every entry is written with a page select and a single streaming
+ *         SPI transfer of the phase increment, phase offset and modulus
+ *         words. The new values take effect on the chip transfer.
+ *
+ * @param  device     Pointer to the device structure
+ * @param  batch      Array of NCO updates, @see adi_ad9081_adc_ddc_nco_batch_calc
+ * @param  num        Number of entries in batch
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_adc_ddc_nco_batch_write(adi_ad9081_device_t *device,
+					   adi_ad9081_adc_nco_batch_t *batch,
+					   uint8_t num);
+
+/**
+ * @ingroup rx_nco_setup
+ * @brief  Apply the written NCO updates with a single chip transfer
+ *         Call after adi_ad9081_adc_ddc_nco_batch_write().
+ *
+ *         All the selected coarse DDCs, then all the selected fine DDCs, are
+ *         updated by one broadcast register write each.
+ *
+ * @param  device     Pointer to the device structure
+ * @param  cddcs      Coarse DDCs selection, @see adi_ad9081_adc_coarse_ddc_select_e
+ * @param  fddcs      Fine DDCs selection, @see adi_ad9081_adc_fine_ddc_select_e
+ *
+ * @return API_CMS_ERROR_OK                     API Completed Successfully
+ * @return <0                                   Failed. @see adi_cms_error_e for details.
+ */
+int32_t adi_ad9081_adc_ddc_nco_batch_commit(adi_ad9081_device_t *device,
+					    uint8_t cddcs, uint8_t fddcs);
+
 /**
  * @ingroup rx_nco_setup
  * @brief  Do some pre-settings for nco sync.
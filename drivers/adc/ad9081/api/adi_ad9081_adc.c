@@ -2339,6 +2339,217 @@ adi_ad9081_adc_ddc_fine_chip_xfer_status_get(adi_ad9081_device_t *device,
 	return API_CMS_ERROR_OK;
 }
 
+static int32_t adi_ad9081_adc_ddc_fine_nco_clk_get(adi_ad9081_device_t *device,
+						   uint8_t fddc,
+						   uint64_t *nco_clk_hz)
+{
+	int32_t err;
+	uint8_t cddc, cc2r_en, cddc_dcm;
+	uint64_t adc_freq_hz;
+
+	err = adi_ad9081_adc_xbar_find_cddc(device, fddc, &cddc);
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_adc_ddc_coarse_select_set(device, cddc);
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_bf_get(device, REG_COARSE_DEC_CTRL_ADDR,
+				    BF_COARSE_DEC_SEL_INFO, &cddc_dcm, 1);
+	AD9081_ERROR_RETURN(err);
+	err = adi_ad9081_hal_bf_get(device, REG_COARSE_DEC_CTRL_ADDR,
+				    BF_COARSE_C2R_EN_INFO, &cc2r_en, 1);
+	AD9081_ERROR_RETURN(err);
+	cddc_dcm = adi_ad9081_adc_ddc_coarse_dcm_decode(cddc_dcm);
+	adc_freq_hz = device->dev_info.adc_freq_hz;
+#ifdef __KERNEL__
+	adc_freq_hz = div_u64(adc_freq_hz, cddc_dcm);
+#else
+	adc_freq_hz = adc_freq_hz / cddc_dcm;
+#endif
+	*nco_clk_hz = (cc2r_en > 0) ? (adc_freq_hz * 2) : adc_freq_hz;
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_adc_ddc_nco_batch_calc(adi_ad9081_device_t *device,
+					  adi_ad9081_adc_nco_batch_t *batch,
+					  uint8_t num)
+{
+	int32_t err;
+	uint8_t i, fddc;
+	uint64_t nco_clk_hz;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(batch);
+	AD9081_LOG_FUNC();
+
+	for (i = 0; i < num; i++) {
+		if (batch[i].fine > 0) {
+			AD9081_INVALID_PARAM_RETURN(batch[i].ddcs == 0);
+			/* all fddcs of an entry are expected to share the decimation */
+			fddc = batch[i].ddcs & (~batch[i].ddcs + 1);
+			err = adi_ad9081_adc_ddc_fine_nco_clk_get(device, fddc,
+								  &nco_clk_hz);
+			AD9081_ERROR_RETURN(err);
+			err = adi_ad9081_hal_calc_tx_nco_ftw(device, nco_clk_hz,
+							     batch[i].shift_hz,
+							     &batch[i].ftw);
+			AD9081_ERROR_RETURN(err);
+			batch[i].phase_offset = 0;
+		} else {
+			err = adi_ad9081_hal_calc_rx_nco_ftw(
+				device, device->dev_info.adc_freq_hz,
+				batch[i].shift_hz, &batch[i].ftw);
+			AD9081_ERROR_RETURN(err);
+			/* same as adi_ad9081_adc_ddc_coarse_nco_ftw_set() */
+			batch[i].phase_offset =
+				(batch[i].ddcs &
+				 (AD9081_ADC_CDDC_0 | AD9081_ADC_CDDC_1)) ?
+					(batch[i].ftw << 3) :
+					0;
+		}
+		batch[i].modulus_a = 0;
+		batch[i].modulus_b = 0;
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_adc_ddc_nco_batch_prepare(adi_ad9081_device_t *device,
+					     uint8_t cddcs, uint8_t fddcs,
+					     uint8_t gpio_xfer)
+{
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_LOG_FUNC();
+
+	if (cddcs > 0) {
+		err = adi_ad9081_adc_ddc_coarse_nco_channel_update_mode_set(
+			device, cddcs, 1);
+		AD9081_ERROR_RETURN(err);
+		err = adi_ad9081_adc_ddc_coarse_gpio_chip_xfer_mode_set(
+			device, cddcs, gpio_xfer > 0 ? 1 : 0);
+		AD9081_ERROR_RETURN(err);
+	}
+	if (fddcs > 0) {
+		err = adi_ad9081_adc_ddc_fine_nco_channel_update_mode_set(
+			device, fddcs, 1);
+		AD9081_ERROR_RETURN(err);
+		err = adi_ad9081_adc_ddc_fine_gpio_chip_xfer_mode_set(
+			device, fddcs, gpio_xfer > 0 ? 1 : 0);
+		AD9081_ERROR_RETURN(err);
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_adc_ddc_nco_batch_write(adi_ad9081_device_t *device,
+					   adi_ad9081_adc_nco_batch_t *batch,
+					   uint8_t num)
+{
+	int32_t err;
+	uint8_t i, j, cpage_val, words[AD9081_NCO_BATCH_XFER_BYTES];
+	uint8_t in_data[AD9081_NCO_BATCH_XFER_BYTES + 2];
+	uint64_t val;
+	uint32_t addr;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_NULL_POINTER_RETURN(batch);
+	AD9081_NULL_POINTER_RETURN(device->hal_info.spi_xfer);
+	AD9081_LOG_FUNC();
+
+	err = adi_ad9081_hal_reg_get(device, REG_ADC_COARSE_PAGE_ADDR,
+				     &cpage_val);
+	AD9081_ERROR_RETURN(err);
+
+	for (i = 0; i < num; i++) {
+		AD9081_INVALID_PARAM_RETURN((batch[i].ftw >> 48) > 0);
+		AD9081_INVALID_PARAM_RETURN((batch[i].phase_offset >> 48) > 0);
+		AD9081_INVALID_PARAM_RETURN((batch[i].modulus_a >> 48) > 0);
+		AD9081_INVALID_PARAM_RETURN((batch[i].modulus_b >> 48) > 0);
+
+		if (batch[i].fine > 0) {
+			AD9081_INVALID_PARAM_RETURN(batch[i].ddcs >
+						    AD9081_ADC_FDDC_ALL);
+			err = adi_ad9081_hal_reg_set(
+				device, REG_FINE_DDC_PAGE_ADDR, batch[i].ddcs);
+			AD9081_ERROR_RETURN(err);
+			addr = REG_FINE_DDC_PHASE_INC0_ADDR;
+		} else {
+			AD9081_INVALID_PARAM_RETURN(batch[i].ddcs >
+						    AD9081_ADC_CDDC_ALL);
+			cpage_val = (batch[i].ddcs << 4) | (cpage_val & 0x0f);
+			err = adi_ad9081_hal_reg_set(
+				device, REG_ADC_COARSE_PAGE_ADDR, cpage_val);
+			AD9081_ERROR_RETURN(err);
+			addr = REG_COARSE_DDC_PHASE_INC0_ADDR;
+		}
+
+		/* phase inc, phase offset, modulus a and b are contiguous */
+		for (j = 0; j < AD9081_NCO_BATCH_XFER_BYTES; j++) {
+			switch (j / 6) {
+			case 0:
+				val = batch[i].ftw;
+				break;
+			case 1:
+				val = batch[i].phase_offset;
+				break;
+			case 2:
+				val = batch[i].modulus_a;
+				break;
+			default:
+				val = batch[i].modulus_b;
+				break;
+			}
+			words[j] = (uint8_t)((val >> (8 * (j % 6))) & 0xFF);
+		}
+
+		if (device->hal_info.addr_inc == SPI_ADDR_INC_AUTO) {
+			for (j = 0; j < AD9081_NCO_BATCH_XFER_BYTES; j++)
+				in_data[j + 2] = words[j];
+		} else { /* streaming addresses are decremented */
+			addr += AD9081_NCO_BATCH_XFER_BYTES - 1;
+			for (j = 0; j < AD9081_NCO_BATCH_XFER_BYTES; j++)
+				in_data[j + 2] =
+					words[AD9081_NCO_BATCH_XFER_BYTES - 1 - j];
+		}
+		in_data[0] = (addr >> 8) & 0x3F;
+		in_data[1] = (addr >> 0) & 0xFF;
+		if (API_CMS_ERROR_OK !=
+		    device->hal_info.spi_xfer(device->hal_info.user_data,
+					      in_data, NULL,
+					      sizeof(in_data)))
+			return API_CMS_ERROR_SPI_XFER;
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
+int32_t adi_ad9081_adc_ddc_nco_batch_commit(adi_ad9081_device_t *device,
+					    uint8_t cddcs, uint8_t fddcs)
+{
+	int32_t err;
+	AD9081_NULL_POINTER_RETURN(device);
+	AD9081_LOG_FUNC();
+
+	/* the page registers broadcast a single write to all selected DDCs */
+	if (cddcs > 0) {
+		err = adi_ad9081_adc_ddc_coarse_select_set(device, cddcs);
+		AD9081_ERROR_RETURN(err);
+		err = adi_ad9081_hal_bf_set(device,
+					    REG_COARSE_DDC_TRANSFER_CTRL_ADDR,
+					    BF_COARSE_DDC0_CHIP_TRANSFER_INFO,
+					    1);
+		AD9081_ERROR_RETURN(err);
+	}
+	if (fddcs > 0) {
+		err = adi_ad9081_adc_ddc_fine_select_set(device, fddcs);
+		AD9081_ERROR_RETURN(err);
+		err = adi_ad9081_hal_bf_set(device,
+					    REG_FINE_DDC_TRANSFER_CTRL_ADDR,
+					    BF_FINE_DDC0_CHIP_TRANSFER_INFO, 1);
+		AD9081_ERROR_RETURN(err);
+	}
+
+	return API_CMS_ERROR_OK;
+}
+
 int32_t adi_ad9081_adc_ddc_fine_psw_set(adi_ad9081_device_t *device,
 					uint8_t fddcs, uint64_t psw)
 {
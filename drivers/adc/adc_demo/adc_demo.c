@@ -93,6 +93,8 @@ int32_t adc_demo_init(struct adc_demo_desc **desc,
 	for(int i = 0; i < TOTAL_ADC_CHANNELS; i++)
 		adesc->adc_ch_attr[i] = param->dev_ch_attr[i];
 	adesc->adc_global_attr = param->dev_global_attr;
+	adesc->bench = param->bench;
+	adesc->bench_rate = param->bench_rate;
 	*desc = adesc;
 
 	return 0;
@@ -131,6 +133,10 @@ int32_t update_adc_channels(void *dev, uint32_t mask)
 	desc->active_ch = mask;
 	/* If a real device. Here needs to be selected the channels to be read*/
 
+	/* The benchmark ramp and its pacing restart with each stream */
+	desc->bench_scan = 0;
+	desc->bench_start = no_os_get_time();
+
 	return 0;
 }
 
@@ -45,8 +45,10 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "iio_types.h"
 #include "no_os_irq.h"
+#include "no_os_delay.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -75,6 +77,14 @@ struct adc_demo_desc {
 	uint32_t ext_buff_len;
 	/** Array of buffers for each channel*/
 	uint16_t **ext_buff;
+	/** Benchmark mode, a continuous ramp is streamed */
+	bool bench;
+	/** Benchmark rate in scans per second, 0 for as fast as possible */
+	uint32_t bench_rate;
+	/** Index of the next benchmark scan */
+	uint64_t bench_scan;
+	/** Time at which the benchmark stream was enabled */
+	struct no_os_time bench_start;
 };
 
 /**
@@ -90,11 +100,20 @@ struct adc_demo_init_param {
 	uint32_t ext_buff_len;
 	/**Array of buffers for each channel*/
 	uint16_t **ext_buff;
+	/**
+	 * Benchmark mode. Instead of ext_buff or sine_lut, the channels stream
+	 * the index of the scan plus the channel number, with no end, so a
+	 * host can measure the throughput and detect lost samples.
+	 */
+	bool bench;
+	/** Benchmark rate in scans per second, 0 for as fast as possible */
+	uint32_t bench_rate;
 };
 
 enum iio_adc_demo_attributes {
 	ADC_CHANNEL_ATTR,
 	ADC_GLOBAL_ATTR,
+	ADC_BENCH_RATE_ATTR,
 };
 
 extern const uint16_t sine_lut[128];
@@ -42,6 +42,7 @@
 #include <stdlib.h>
 #include "no_os_error.h"
 #include "no_os_util.h"
+#include "no_os_delay.h"
 #include "iio_adc_demo.h"
 #include "iio.h"
 
@@ -94,6 +95,8 @@ int get_adc_demo_attr(void *device, char *buf, uint32_t len,
 		return snprintf(buf,len,"%"PRIu32"",desc->adc_global_attr);
 	case ADC_CHANNEL_ATTR:
 		return snprintf(buf,len,"%"PRIu32"",desc->adc_ch_attr[channel->ch_num]);
+	case ADC_BENCH_RATE_ATTR:
+		return snprintf(buf, len, "%"PRIu32"", desc->bench_rate);
 	default:
 		return -EINVAL;
 	}
@@ -128,6 +131,9 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 	case ADC_CHANNEL_ATTR:
 		desc->adc_ch_attr[channel->ch_num] = value;
 		return len;
+	case ADC_BENCH_RATE_ATTR:
+		desc->bench_rate = value;
+		return len;
 	default:
 		return -EINVAL;
 	}
@@ -135,6 +141,67 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 	return -EINVAL;
 }
 
+/**
+ * @brief Wait until the benchmark scans generated so far are due at bench_rate.
+ * @param desc - descriptor for the adc
+ */
+static void adc_demo_bench_pace(struct adc_demo_desc *desc)
+{
+	struct no_os_time now;
+	int64_t elapsed_us;
+	int64_t due_us;
+
+	if (!desc->bench_rate)
+		return;
+
+	due_us = desc->bench_scan * 1000000 / desc->bench_rate;
+	now = no_os_get_time();
+	elapsed_us = (int64_t)(now.s - desc->bench_start.s) * 1000000 +
+		     (int64_t)now.us - desc->bench_start.us;
+	if (due_us > elapsed_us)
+		no_os_udelay(due_us - elapsed_us);
+}
+
+/**
+ * @brief Fill the buffer with the benchmark ramp: each sample is the index of
+ * its scan plus its channel number, truncated to 16 bits.
+ * @param desc - descriptor for the adc
+ * @param buffer - iio buffer to be filled
+ * @return the number of generated scans, negative error code otherwise.
+ */
+static int32_t adc_demo_bench_submit(struct adc_demo_desc *desc,
+				     struct iio_buffer *buffer)
+{
+	uint8_t chs[TOTAL_ADC_CHANNELS];
+	uint32_t nb_scans;
+	uint32_t nb_ch = 0;
+	uint32_t ch = -1;
+	uint16_t *buf;
+	uint32_t i, j;
+	int ret;
+
+	while (get_next_ch_idx(desc->active_ch, ch, &ch) &&
+	       nb_ch < TOTAL_ADC_CHANNELS)
+		chs[nb_ch++] = ch;
+
+	ret = iio_buffer_get_block(buffer, (void **)&buf);
+	if (ret)
+		return ret;
+
+	nb_scans = buffer->size / buffer->bytes_per_scan;
+	for (i = 0; i < nb_scans; i++, desc->bench_scan++)
+		for (j = 0; j < nb_ch; j++)
+			*buf++ = (uint16_t)(desc->bench_scan + chs[j]);
+
+	ret = iio_buffer_block_done(buffer);
+	if (ret)
+		return ret;
+
+	adc_demo_bench_pace(desc);
+
+	return nb_scans;
+}
+
 /**
  * @brief function for reading samples from the device.
  * @param dev_data  - The iio device data structure.
@@ -154,6 +221,9 @@ int32_t adc_submit_samples(struct iio_device_data *dev_data)
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
 
+	if (desc->bench)
+		return adc_demo_bench_submit(desc, dev_data->buffer);
+
 	if(desc->ext_buff == NULL) {
 		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
 		for(i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan; i++) {
@@ -245,6 +315,21 @@ struct iio_attribute adc_channel_attributes[] = {
 
 struct iio_attribute iio_adc_global_attributes[] = {
 	ADC_DEMO_ATTR("adc_global_attr", ADC_GLOBAL_ATTR),
+	/* Rate of the benchmark stream, in scans per second */
+	ADC_DEMO_ATTR("sampling_frequency", ADC_BENCH_RATE_ATTR),
+	END_ATTRIBUTES_ARRAY,
+};
+
+/*
+ * Runtime statistics of the firmware, see NO_OS_PROFILING, NO_OS_COUNTERS and
+ * NO_OS_BUS_TRACE
+ */
+struct iio_attribute iio_adc_debug_attributes[] = {
+	IIO_PROFILE_DEBUG_ATTR,
+	IIO_COUNTERS_DEBUG_ATTR,
+#ifdef NO_OS_BUS_TRACE
+	IIO_BUS_TRACE_DEBUG_ATTR,
+#endif
 	END_ATTRIBUTES_ARRAY,
 };
 
@@ -282,7 +367,7 @@ struct iio_device adc_demo_iio_descriptor = {
 	.num_ch = TOTAL_ADC_CHANNELS,
 	.channels = iio_adc_channels,
 	.attributes = iio_adc_global_attributes,
-	.debug_attributes = NULL,
+	.debug_attributes = iio_adc_debug_attributes,
 	.buffer_attributes = NULL,
 	.pre_enable = update_adc_channels,
 	.post_disable = close_adc_channels,
@@ -286,6 +286,39 @@ int adm1177_read_conv(struct adm1177_dev *device,
 	}
 }
 
+/**************************************************************************//**
+ * @brief - Reads the voltage and current in a single read, for
+ *	    no_os_telemetry.
+ *
+ * @param dev - The device structure.
+ *
+ * @param vals - The values, indexed by enum adm1177_telemetry_val.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+******************************************************************************/
+static int adm1177_telemetry_refresh(void *dev, int32_t *vals)
+{
+	struct adm1177_dev *device = dev;
+	uint16_t conv_voltage, conv_current;
+	int ret;
+
+	if (device->last_command != ADM1177_VOLTAGE_AND_CURRENT_EN)
+		return -EINVAL;
+
+	ret = adm1177_read_conv(device, &conv_voltage, &conv_current);
+	if (ret)
+		return ret;
+
+	vals[ADM1177_TLM_VOLTAGE] = conv_voltage;
+	vals[ADM1177_TLM_CURRENT] = conv_current;
+
+	return 0;
+}
+
+const struct no_os_telemetry_ops adm1177_telemetry_ops = {
+	.refresh = adm1177_telemetry_refresh,
+};
+
 /**************************************************************************//**
  * @brief - Converts the raw sample from the Readback into uV.
  *
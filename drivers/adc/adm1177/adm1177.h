@@ -45,6 +45,7 @@
 #include "no_os_i2c.h"
 #include "no_os_util.h"
 #include "no_os_units.h"
+#include "no_os_telemetry.h"
 
 /* ADM1177 Slave Address */
 #define	ADM1177_ADDRESS			0x5A
@@ -101,6 +102,13 @@ enum adm1177_vrange {
 	ADM1177_VRANGE_HIGH,
 };
 
+/* Values of a telemetry snapshot, raw 12-bit codes */
+enum adm1177_telemetry_val {
+	ADM1177_TLM_VOLTAGE,
+	ADM1177_TLM_CURRENT,
+	ADM1177_TLM_NB,
+};
+
 struct adm1177_dev {
 	struct no_os_i2c_desc   *i2c_desc;
 	enum adm1177_last_command last_command;
@@ -134,6 +142,12 @@ int adm1177_read_conv(struct adm1177_dev *device,
 		      uint16_t* conv_voltage,
 		      uint16_t* conv_current);
 
+/*
+ * no_os_telemetry operations, both conversions in one read. The device must be
+ * converting voltage and current.
+ */
+extern const struct no_os_telemetry_ops adm1177_telemetry_ops;
+
 /* Converts the raw sample of the voltage from the ADC in uV */
 int adm1177_to_microvolts(struct adm1177_dev *device,
 			  uint16_t raw_sample,
@@ -60,6 +60,17 @@ static int adm1177_iio_read_raw(void *device, char *buf, uint32_t len,
 	uint16_t conv_voltage;
 	uint16_t conv_current;
 
+	if (iiodev->telemetry) {
+		ret = no_os_telemetry_get(iiodev->telemetry,
+					  channel->type == IIO_VOLTAGE ?
+					  ADM1177_TLM_VOLTAGE : ADM1177_TLM_CURRENT,
+					  &value);
+		if (ret)
+			return ret;
+
+		return iio_format_value(buf, len, IIO_VAL_INT, 1, &value);
+	}
+
 	switch (channel->type) {
 	case IIO_VOLTAGE:
 		ret = adm1177_read_conv(desc, &conv_voltage, &conv_current);
@@ -242,9 +253,29 @@ int adm1177_iio_init(struct adm1177_iio_dev **iio_dev,
 	if (ret)
 		goto error_desc;
 
+	if (init_param->telemetry) {
+		struct no_os_telemetry_init_param tlm_param = {
+			.ops = &adm1177_telemetry_ops,
+			.dev = desc->adm1177_dev,
+			.nb_vals = ADM1177_TLM_NB,
+			.wq = init_param->telemetry_wq,
+		};
+
+		ret = no_os_telemetry_init(&desc->telemetry, &tlm_param);
+		if (ret)
+			goto error_desc;
+
+		/* Publish a first snapshot before the attributes are read */
+		ret = no_os_telemetry_refresh(desc->telemetry);
+		if (ret)
+			goto error_tlm;
+	}
+
 	*iio_dev = desc;
 
 	return 0;
+error_tlm:
+	no_os_telemetry_remove(desc->telemetry);
 error_desc:
 	no_os_free(desc);
 
@@ -259,6 +290,7 @@ int adm1177_iio_remove(struct adm1177_iio_dev *desc)
 	if (ret)
 		return ret;
 
+	no_os_telemetry_remove(desc->telemetry);
 	no_os_free(desc);
 
 	return 0;
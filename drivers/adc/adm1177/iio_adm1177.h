@@ -42,6 +42,7 @@
 
 #include "iio.h"
 #include "iio_types.h"
+#include "no_os_telemetry.h"
 
 struct adm1177_iio_dev {
 	struct adm1177_dev *adm1177_dev;
@@ -49,10 +50,21 @@ struct adm1177_iio_dev {
 
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+
+	/* Snapshot serving the raw attributes, NULL to read the device */
+	struct no_os_telemetry *telemetry;
 };
 
 struct adm1177_iio_init_param {
 	struct adm1177_init_param *adm1177_initial;
+	/*
+	 * Serve the raw attributes from a snapshot refreshed by
+	 * no_os_telemetry_refresh() or no_os_telemetry_schedule(), so that
+	 * polling them causes no bus traffic. Buffers still read the device.
+	 */
+	bool telemetry;
+	/* Optional, work queue of no_os_telemetry_schedule() */
+	struct no_os_workqueue *telemetry_wq;
 };
 
 int adm1177_iio_init(struct adm1177_iio_dev **iio_dev,
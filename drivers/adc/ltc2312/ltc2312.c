@@ -49,8 +49,10 @@ ongoing work.
 /******************************************************************************/
 #include <stdlib.h>
 #include <math.h>
+#include <errno.h>
 #include "ltc2312.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -75,6 +77,8 @@ int32_t ltc2312_setup(struct ltc2312_dev **device,
 	if(!dev)
 		return -1;
 
+	dev->stream = NULL;
+
 	ret = no_os_spi_init(&dev->spi_desc, &init_param->spi_init);
 	if(ret != 0)
 		goto error;
@@ -104,6 +108,9 @@ int32_t ltc2312_remove(struct ltc2312_dev *dev)
 	if(!dev)
 		return -1;
 
+	if (dev->stream)
+		ltc2312_stream_stop(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if(ret != 0)
 		return ret;
@@ -192,6 +199,117 @@ int32_t ltc2312_read(struct ltc2312_dev *dev, uint16_t *ptr_adc_code)
 	return ret;
 }
 
+/**
+ * Starts timer paced acquisition at the given sample rate.
+ *
+ * The PWM only serves as timebase, its pulse finished interrupt must call
+ * ltc2312_stream_trigger(). Each read by DMA returns the previous conversion
+ * and its chip select edge starts the next one, so the conversion runs between
+ * ticks instead of being waited for.
+ *
+ * @param [in] dev            - The device structure.
+ * @param [in] tick_pwm_init  - Timebase PWM parameters, period and duty cycle
+ *                              are set by the driver.
+ * @param [in] sample_rate_hz - Sample rate, up to LTC2312_SAMPLE_RATE_MAX.
+ * @param [in] ring           - Ring buffer, nb_blocks * block_samples *
+ *                              LTC2312_READ_BYTES_NUMBER large.
+ * @param [in] block_samples  - Number of samples in a block.
+ * @param [in] nb_blocks      - Number of blocks in the ring, at least 2.
+ *
+ * @return 0 for success, or negative error code otherwise.
+ */
+int32_t ltc2312_stream_start(struct ltc2312_dev *dev,
+			     struct no_os_pwm_init_param *tick_pwm_init,
+			     uint32_t sample_rate_hz, uint8_t *ring,
+			     uint32_t block_samples, uint32_t nb_blocks)
+{
+	struct no_os_sar_stream_init_param param = {
+		.cnv_pwm_init = tick_pwm_init,
+		.sample_rate_hz = sample_rate_hz,
+		.cnv_high_ns = LTC2312_TCONV_NS,
+		.frame_bytes = LTC2312_READ_BYTES_NUMBER,
+		/* The first read returns a stale conversion. */
+		.discard = 1,
+		.ring = ring,
+		.block_samples = block_samples,
+		.nb_blocks = nb_blocks,
+	};
+
+	if (!dev || dev->stream || sample_rate_hz > LTC2312_SAMPLE_RATE_MAX)
+		return -EINVAL;
+
+	param.spi_desc = dev->spi_desc;
+
+	return no_os_sar_stream_init(&dev->stream, &param);
+}
+
+/**
+ * Reads the last conversion, called on each conversion tick.
+ *
+ * @param [in] dev - The device structure.
+ *
+ * @return 0 for success, -EBUSY if the sample was dropped, or negative error
+ *         code otherwise.
+ */
+int32_t ltc2312_stream_trigger(struct ltc2312_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	return no_os_sar_stream_trigger(dev->stream);
+}
+
+/**
+ * Gets the oldest complete block of samples.
+ *
+ * @param [in]  dev  - The device structure.
+ * @param [out] data - ADC codes, block_samples large.
+ *
+ * @return 0 for success, -EAGAIN if no block is available, or negative error
+ *         code otherwise.
+ */
+int32_t ltc2312_stream_read(struct ltc2312_dev *dev, uint16_t *data)
+{
+	uint8_t *frame;
+	uint8_t shift;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !data)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_read(dev->stream, &frame);
+	if (ret)
+		return ret;
+
+	shift = ltc2312_get_shift(dev);
+	for (i = 0; i < dev->stream->block_samples; i++)
+		data[i] = no_os_get_unaligned_be16(frame + i *
+						   LTC2312_READ_BYTES_NUMBER) >> shift;
+
+	return 0;
+}
+
+/**
+ * Stops timer paced acquisition.
+ *
+ * @param [in] dev - The device structure.
+ *
+ * @return 0 for success, or negative error code otherwise.
+ */
+int32_t ltc2312_stream_stop(struct ltc2312_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	ret = no_os_sar_stream_remove(dev->stream);
+	dev->stream = NULL;
+
+	return ret;
+}
+
 /**
  * Calculates the LTC2312 input voltage given the binary data and LSB weight.
  *
@@ -59,12 +59,18 @@ ongoing work.
 #define LTC2312_READ_BYTES_NUMBER 2
 #define LTC2312_READ_VALUES_NUMBER 100
 
+/* Maximum sample rate */
+#define LTC2312_SAMPLE_RATE_MAX 500000
+/* Conversion time */
+#define LTC2312_TCONV_NS 1300
+
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_delay.h"
 #include "no_os_spi.h"
+#include "no_os_sar_stream.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -79,6 +85,8 @@ struct ltc2312_dev {
 	enum device_type type;
 	/* SPI */
 	struct no_os_spi_desc *spi_desc;
+	/* Timer paced acquisition, NULL when not running */
+	struct no_os_sar_stream *stream;
 };
 
 struct ltc2312_init_param {
@@ -101,6 +109,21 @@ int32_t ltc2312_remove(struct ltc2312_dev *dev);
 /* Reads the LTC2315 and returns 32-bit data in offset binary format. */
 int32_t ltc2312_read(struct ltc2312_dev *dev, uint16_t *ptr_adc_code);
 
+/* Starts timer paced acquisition at the given sample rate. */
+int32_t ltc2312_stream_start(struct ltc2312_dev *dev,
+			     struct no_os_pwm_init_param *tick_pwm_init,
+			     uint32_t sample_rate_hz, uint8_t *ring,
+			     uint32_t block_samples, uint32_t nb_blocks);
+
+/* Reads the last conversion, called on each conversion tick. */
+int32_t ltc2312_stream_trigger(struct ltc2312_dev *dev);
+
+/* Gets the oldest complete block of samples. */
+int32_t ltc2312_stream_read(struct ltc2312_dev *dev, uint16_t *data);
+
+/* Stops timer paced acquisition. */
+int32_t ltc2312_stream_stop(struct ltc2312_dev *dev);
+
 /* Calculates the LTC2315 input voltage given the binary data and LSB weight. */
 void ltc2312_code_to_voltage(struct ltc2312_dev *dev, uint16_t adc_code,
 			     float vref, float *voltage);
@@ -51,7 +51,7 @@
 #include "no_os_spi.h"
 #include "no_os_alloc.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ad413x_crc8);
+static const uint8_t *ad413x_crc8;
 uint32_t timeout = 0xFFFFFF;
 
 /******************************************************************************/
@@ -919,7 +919,9 @@ int32_t ad413x_init(struct ad413x_dev **device,
 	int32_t ret;
 	int32_t i;
 
-	no_os_crc8_populate_msb(ad413x_crc8, AD413X_CRC8_POLY);
+	ad413x_crc8 = no_os_crc8_get_table(AD413X_CRC8_POLY);
+	if (!ad413x_crc8)
+		return -ENOMEM;
 
 	dev = (struct ad413x_dev *)no_os_malloc(sizeof(*dev));
 	if (!dev)
@@ -660,10 +660,13 @@ static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
 	uint32_t i = 0;
 	uint32_t s = 0;
 
+	/* Keep the largest buffer around, FIFO bursts are read repeatedly */
 	if (!iobuf_alloc_sz) {
 		iobuf = no_os_malloc(iobuf_sz);
 		if (!iobuf)
 			return -ENOMEM;
+
+		iobuf_alloc_sz = iobuf_sz;
 	}
 
 	if (iobuf_alloc_sz < iobuf_sz) {
@@ -672,6 +675,7 @@ static int AD5940_FIFORd_Fast(struct no_os_spi_desc *spi, uint32_t *pBuffer,
 			return -ENOMEM;
 
 		iobuf = buf;
+		iobuf_alloc_sz = iobuf_sz;
 	}
 
 	// zero-out everything, needed for bytes 1 through 6 (dummy bytes).
@@ -39,6 +39,9 @@
 *******************************************************************************/
 #include <errno.h>
 #include "bia_measurement.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_dsp.h"
 
 /* Initial AD5940 settings */
 AppBiaCfg_Type AppBiaCfg = {
@@ -777,6 +780,327 @@ int AppBiaISR(struct ad5940_dev *dev, void *pBuff, uint32_t *pCount)
 	return 0;
 }
 
+/* Streaming mode state, see AppBiaStreamCfg_Type */
+static struct {
+	struct no_os_irq_ctrl_desc *IrqCtrl;
+	uint32_t IrqId;
+	struct no_os_callback_desc IrqCb;
+	uint32_t Batch;          /* Configured measurements per interrupt */
+	uint32_t WordsPerMeas;   /* DFT words per measurement, 2 or 4 */
+	int32_t Fifo[BIA_STREAM_MAX_BATCH * BIA_STREAM_NB_SAMPLES];
+	int32_t *Blocks;         /* BIA_STREAM_NB_BLOCKS blocks of BlockScans scans */
+	uint32_t BlockScans;
+	uint32_t Fill;           /* Scans already written to the block at Wr */
+	uint32_t Wr;
+	uint32_t Rd;
+	volatile uint32_t Count; /* Complete blocks not yet released */
+	volatile uint32_t Overruns;
+	bool Inited;
+	bool Started;
+} AppBiaStream;
+
+/* Store one measurement, already converted to polar form */
+static void AppBiaStreamPush(const int32_t *pRes)
+{
+	int32_t *pScan;
+
+	if (AppBiaStream.Count == BIA_STREAM_NB_BLOCKS) {
+		AppBiaStream.Overruns++;
+		return;
+	}
+
+	pScan = &AppBiaStream.Blocks[(AppBiaStream.Wr * AppBiaStream.BlockScans +
+				      AppBiaStream.Fill) * BIA_STREAM_NB_SAMPLES];
+	memcpy(pScan, pRes, AppBiaStream.WordsPerMeas * sizeof(*pScan));
+	memset(pScan + AppBiaStream.WordsPerMeas, 0,
+	       (BIA_STREAM_NB_SAMPLES - AppBiaStream.WordsPerMeas) * sizeof(*pScan));
+
+	if (++AppBiaStream.Fill == AppBiaStream.BlockScans) {
+		AppBiaStream.Fill = 0;
+		AppBiaStream.Wr = (AppBiaStream.Wr + 1) % BIA_STREAM_NB_BLOCKS;
+		AppBiaStream.Count++;
+	}
+}
+
+/*
+  GP0 handler of the streaming mode. All the complete measurements in the FIFO
+  are read in a single burst, then converted to magnitude and phase as one
+  batch once the AFE is allowed to sleep again.
+ */
+static void AppBiaStreamIrq(void *ctx)
+{
+	struct ad5940_dev *dev = ctx;
+	uint32_t FifoCnt = 0;
+	uint32_t WordCnt = 0;
+	uint32_t i;
+	int ret;
+
+	ret = ad5940_WakeUp(dev, 10);
+	if (ret < 0 || ret > 10) {
+		AppBiaStream.Overruns++;
+		return;
+	}
+
+	ret = ad5940_SleepKeyCtrlS(dev, SLPKEY_LOCK);
+	if (ret < 0)
+		return;
+
+	ret = ad5940_FIFOGetCnt(dev, &FifoCnt);
+	if (ret < 0)
+		goto unlock;
+
+	WordCnt = no_os_min(FifoCnt / AppBiaStream.WordsPerMeas,
+			    BIA_STREAM_MAX_BATCH) * AppBiaStream.WordsPerMeas;
+	if (WordCnt) {
+		ret = ad5940_FIFORd(dev, (uint32_t *)AppBiaStream.Fifo, WordCnt);
+		if (ret < 0)
+			WordCnt = 0;
+	}
+
+	ret = ad5940_INTCClrFlag(dev, AFEINTSRC_DATAFIFOTHRESH);
+	if (ret < 0)
+		goto unlock;
+
+	ret = AppEITRegModify(dev, AppBiaStream.Fifo, &WordCnt);
+	if (ret < 0)
+		goto unlock;
+
+	if (AppBiaCfg.SweepCfg.SweepEn) {
+		/* The WG is already set to SweepNextFreq for the next measurement */
+		AppBiaCfg.FreqofData = AppBiaCfg.SweepCurrFreq;
+		AppBiaCfg.SweepCurrFreq = AppBiaCfg.SweepNextFreq;
+		ad5940_SweepNext(dev, &AppBiaCfg.SweepCfg, &AppBiaCfg.SweepNextFreq);
+	}
+
+unlock:
+	ad5940_SleepKeyCtrlS(dev, SLPKEY_UNLOCK);
+
+	if (!WordCnt)
+		return;
+
+	signExtend18To32((uint32_t *)AppBiaStream.Fifo, WordCnt);
+	no_os_dsp_polar(AppBiaStream.Fifo, WordCnt / 2, AppBiaStream.Fifo);
+
+	for (i = 0; i < WordCnt; i += AppBiaStream.WordsPerMeas)
+		AppBiaStreamPush(&AppBiaStream.Fifo[i]);
+}
+
+/* Start the measurements and produce blocks of block_scans measurements */
+static int32_t AppBiaStreamStart(void *device, uint32_t block_scans)
+{
+	struct ad5940_dev *dev = device;
+	uint32_t Batch;
+	int ret;
+
+	if (!AppBiaStream.Inited || AppBiaStream.Started || !block_scans)
+		return -EINVAL;
+	/* AppBiaInit() must have programmed the sequences */
+	if (AppBiaCfg.BiaInited == false || AppBiaCfg.bParamsChanged == true)
+		return -EAGAIN;
+
+	AppBiaStream.Blocks = no_os_calloc(BIA_STREAM_NB_BLOCKS * block_scans *
+					   BIA_STREAM_NB_SAMPLES, sizeof(int32_t));
+	if (!AppBiaStream.Blocks)
+		return -ENOMEM;
+
+	AppBiaStream.BlockScans = block_scans;
+	AppBiaStream.WordsPerMeas = AppBiaCfg.bImpedanceReadMode ? 4 : 2;
+	AppBiaStream.Fill = 0;
+	AppBiaStream.Wr = 0;
+	AppBiaStream.Rd = 0;
+	AppBiaStream.Count = 0;
+	AppBiaStream.Overruns = 0;
+
+	Batch = AppBiaStream.Batch ? AppBiaStream.Batch : BIA_STREAM_MAX_BATCH;
+	Batch = no_os_min(Batch, block_scans);
+	/* The frequency can only change between two FIFO reads */
+	if (AppBiaCfg.SweepCfg.SweepEn)
+		Batch = 1;
+
+	ret = ad5940_WakeUp(dev, 10);
+	if (ret < 0)
+		goto error;
+	if (ret > 10) {
+		ret = -EIO;
+		goto error;
+	}
+
+	/* Flush the FIFO so that the batches stay aligned to measurements */
+	ret = ad5940_FIFOCtrlS(dev, FIFOSRC_DFT, false);
+	if (ret < 0)
+		goto error;
+	ret = ad5940_FIFOCtrlS(dev, FIFOSRC_DFT, true);
+	if (ret < 0)
+		goto error;
+	ret = ad5940_FIFOThrshSet(dev, Batch * AppBiaStream.WordsPerMeas);
+	if (ret < 0)
+		goto error;
+	ret = ad5940_INTCClrFlag(dev, AFEINTSRC_ALLINT);
+	if (ret < 0)
+		goto error;
+
+	ret = no_os_irq_enable(AppBiaStream.IrqCtrl, AppBiaStream.IrqId);
+	if (ret < 0)
+		goto error;
+
+	ret = AppBiaCtrl(dev, BIACTRL_START, 0);
+	if (ret < 0)
+		goto error_irq;
+
+	AppBiaStream.Started = true;
+
+	return 0;
+
+error_irq:
+	no_os_irq_disable(AppBiaStream.IrqCtrl, AppBiaStream.IrqId);
+error:
+	no_os_free(AppBiaStream.Blocks);
+	AppBiaStream.Blocks = NULL;
+
+	return ret;
+}
+
+/* Stop the measurements and restore the single measurement FIFO threshold */
+static int32_t AppBiaStreamStop(void *device)
+{
+	struct ad5940_dev *dev = device;
+	int ret;
+
+	if (!AppBiaStream.Started)
+		return 0;
+
+	ret = no_os_irq_disable(AppBiaStream.IrqCtrl, AppBiaStream.IrqId);
+	if (ret < 0)
+		return ret;
+
+	ret = AppBiaCtrl(dev, BIACTRL_STOPNOW, 0);
+	if (ret < 0)
+		return ret;
+
+	ret = ad5940_FIFOThrshSet(dev, AppBiaCfg.FifoThresh);
+	if (ret < 0)
+		return ret;
+
+	no_os_free(AppBiaStream.Blocks);
+	AppBiaStream.Blocks = NULL;
+	AppBiaStream.Started = false;
+
+	return 0;
+}
+
+/* Get the oldest complete block, -EAGAIN if none */
+static int32_t AppBiaStreamGetBlock(void *device, void **block)
+{
+	if (!AppBiaStream.Count)
+		return -EAGAIN;
+
+	*block = &AppBiaStream.Blocks[AppBiaStream.Rd * AppBiaStream.BlockScans *
+						 BIA_STREAM_NB_SAMPLES];
+
+	return 0;
+}
+
+/* Give back the block returned by AppBiaStreamGetBlock() */
+static int32_t AppBiaStreamReleaseBlock(void *device)
+{
+	int ret;
+
+	ret = no_os_irq_disable(AppBiaStream.IrqCtrl, AppBiaStream.IrqId);
+	if (ret < 0)
+		return ret;
+
+	AppBiaStream.Rd = (AppBiaStream.Rd + 1) % BIA_STREAM_NB_BLOCKS;
+	AppBiaStream.Count--;
+
+	return no_os_irq_enable(AppBiaStream.IrqCtrl, AppBiaStream.IrqId);
+}
+
+/* Number of measurements dropped since start */
+static int32_t AppBiaStreamGetOverruns(void *device, uint32_t *overruns)
+{
+	*overruns = AppBiaStream.Overruns;
+
+	return 0;
+}
+
+const struct no_os_ain_stream_ops AppBiaStreamOps = {
+	.start = AppBiaStreamStart,
+	.stop = AppBiaStreamStop,
+	.get_block = AppBiaStreamGetBlock,
+	.release_block = AppBiaStreamReleaseBlock,
+	.get_overruns = AppBiaStreamGetOverruns,
+};
+
+/* Describe the streamed scans for a no_os_ain stream */
+void AppBiaStreamGetFormat(struct no_os_ain_stream_format *format)
+{
+	format->nb_samples = BIA_STREAM_NB_SAMPLES;
+	format->realbits = 32;
+	format->storagebits = 32;
+	format->shift = 0;
+	format->is_signed = true;
+	format->is_big_endian = false;
+}
+
+/* Hook the streaming mode to the GP0 interrupt. The IRQ stays disabled until the stream starts */
+int AppBiaStreamInit(struct ad5940_dev *dev, AppBiaStreamCfg_Type *pStreamCfg)
+{
+	int ret;
+
+	if (!dev || !pStreamCfg || !pStreamCfg->IrqCtrl ||
+	    pStreamCfg->Batch > BIA_STREAM_MAX_BATCH)
+		return -EINVAL;
+	if (AppBiaStream.Inited)
+		return -EBUSY;
+
+	AppBiaStream.IrqCtrl = pStreamCfg->IrqCtrl;
+	AppBiaStream.IrqId = pStreamCfg->IrqId;
+	AppBiaStream.Batch = pStreamCfg->Batch;
+	AppBiaStream.IrqCb.callback = AppBiaStreamIrq;
+	AppBiaStream.IrqCb.ctx = dev;
+	AppBiaStream.IrqCb.event = NO_OS_EVT_GPIO;
+	AppBiaStream.IrqCb.peripheral = NO_OS_GPIO_IRQ;
+
+	ret = no_os_irq_register_callback(AppBiaStream.IrqCtrl, AppBiaStream.IrqId,
+					  &AppBiaStream.IrqCb);
+	if (ret < 0)
+		return ret;
+
+	/* GP0 is driven low while an INTC0 flag is set */
+	ret = no_os_irq_trigger_level_set(AppBiaStream.IrqCtrl, AppBiaStream.IrqId,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret < 0) {
+		no_os_irq_unregister_callback(AppBiaStream.IrqCtrl, AppBiaStream.IrqId,
+					      &AppBiaStream.IrqCb);
+		return ret;
+	}
+
+	AppBiaStream.Inited = true;
+
+	return 0;
+}
+
+int AppBiaStreamRemove(struct ad5940_dev *dev)
+{
+	int ret;
+
+	if (!AppBiaStream.Inited)
+		return 0;
+
+	ret = AppBiaStreamStop(dev);
+	if (ret < 0)
+		return ret;
+
+	ret = no_os_irq_unregister_callback(AppBiaStream.IrqCtrl, AppBiaStream.IrqId,
+					    &AppBiaStream.IrqCb);
+	if (ret < 0)
+		return ret;
+
+	AppBiaStream.Inited = false;
+
+	return 0;
+}
+
 /**
  * @}
  */
@@ -45,6 +45,8 @@
 #include <string.h>
 #include <math.h>
 #include "ad5940.h"
+#include "no_os_irq.h"
+#include "no_os_ain.h"
 
 #define MAXSWEEP_POINTS 100 /* Need to know how much buffer is needed to save RTIA calibration result */
 
@@ -109,11 +111,34 @@ typedef struct {
 #define BIACTRL_GETFREQ 3  /* Get Current frequency of returned data from ISR */
 #define BIACTRL_SHUTDOWN 4 /* Note: shutdown here means turn off everything and put AFE to hibernate mode. The word 'SHUT DOWN' is only used here. */
 
+#define BIA_STREAM_NB_BLOCKS 3   /* Blocks of measurements buffered for the reader */
+#define BIA_STREAM_MAX_BATCH 64  /* Maximum measurements drained per FIFO threshold interrupt */
+#define BIA_STREAM_NB_SAMPLES 4  /* Voltage magnitude and phase, current magnitude and phase */
+
+/*
+  Streaming mode: the measurement sequence runs from the wakeup timer and the
+  data FIFO threshold interrupt on GP0 drains whole batches of DFT results in
+  one burst. Each measurement is turned into a scan of BIA_STREAM_NB_SAMPLES
+  int32 values: magnitude in DFT units and phase in microradians, for the
+  voltage and, in impedance read mode, the current. The current pair is zero
+  otherwise.
+ */
+typedef struct {
+	struct no_os_irq_ctrl_desc *IrqCtrl; /* IRQ controller the GP0 pin is routed through */
+	uint32_t IrqId;                      /* GPIO line of the GP0 pin */
+	uint32_t Batch;                      /* Measurements per FIFO threshold interrupt, 0 for BIA_STREAM_MAX_BATCH. Forced to 1 when sweeping */
+} AppBiaStreamCfg_Type;
+
+extern const struct no_os_ain_stream_ops AppBiaStreamOps;
+
 int AppBiaGetCfg(void *pCfg);
 int AppBiaInit(struct ad5940_dev *dev, uint32_t *pBuffer, uint32_t nBufferSize);
 int AppBiaISR(struct ad5940_dev *dev, void *pBuff, uint32_t *pCountd);
 int AppBiaCtrl(struct ad5940_dev *dev, int32_t BcmCtrl, void *pPara);
 void signExtend18To32(uint32_t *const pData, uint16_t nLen);
 fImpCar_Type computeImpedance(uint32_t *const pData);
+int AppBiaStreamInit(struct ad5940_dev *dev, AppBiaStreamCfg_Type *pStreamCfg);
+int AppBiaStreamRemove(struct ad5940_dev *dev);
+void AppBiaStreamGetFormat(struct no_os_ain_stream_format *format);
 
 #endif /* BIA_MEASUREMENT_H_ */
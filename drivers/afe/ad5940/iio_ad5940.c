@@ -271,18 +271,31 @@ struct iio_attribute ad5940_iio_global_attr[] = {
 	END_ATTRIBUTES_ARRAY,
 };
 
+/* Program the sequences again if a parameter changed before streaming */
+static int32_t ad5940_iio_pre_enable(void *device, uint32_t mask)
+{
+	struct ad5940_iio_dev *iiodev = (struct ad5940_iio_dev *)device;
+	AppBiaCfg_Type *pBiaCfg;
+
+	AppBiaGetCfg(&pBiaCfg);
+	if (pBiaCfg->bParamsChanged)
+		return AppBiaInit(iiodev->ad5940, iiodev->AppBuff, 512);
+
+	return 0;
+}
+
 static struct iio_device ad5940_iio_device = {
 	.attributes = ad5940_iio_global_attr,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
-	.pre_enable = NULL,
+	.pre_enable = ad5940_iio_pre_enable,
 	.post_disable = NULL,
 	.read_dev = NULL,
 	.debug_reg_read = (int32_t (*)())_ad5940_read_register2,
 	.debug_reg_write = (int32_t (*)())_ad5940_write_register2
 };
 
-static struct iio_attribute ad5940_channel_attributes[] = {
+static const struct iio_attribute ad5940_channel_attributes[] = {
 	{
 		.name = "raw",
 		.show = ad5940_iio_read_chan_raw,
@@ -290,13 +303,46 @@ static struct iio_attribute ad5940_channel_attributes[] = {
 	END_ATTRIBUTES_ARRAY
 };
 
+static const struct scan_type ad5940_stream_scan_type = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+#define AD5940_STREAM_CHANNEL(_idx, _name) {	\
+	.name = _name,					\
+	.ch_type = IIO_VOLTAGE,				\
+	.channel = _idx,				\
+	.scan_index = _idx,				\
+	.scan_type = &ad5940_stream_scan_type,		\
+	.indexed = true,				\
+}
+
+/*
+ * The "bia" channel, then the scan elements of AppBiaStreamOps in the order
+ * of the streamed scans, which are only exposed when streaming is enabled.
+ */
+static const struct iio_channel ad5940_channels[1 + BIA_STREAM_NB_SAMPLES] = {
+	{
+		.name = "bia",
+		.ch_type = IIO_VOLTAGE,
+		.indexed = true,
+		.attributes = ad5940_channel_attributes,
+	},
+	AD5940_STREAM_CHANNEL(1, "voltage_magnitude"),
+	AD5940_STREAM_CHANNEL(2, "voltage_phase"),
+	AD5940_STREAM_CHANNEL(3, "current_magnitude"),
+	AD5940_STREAM_CHANNEL(4, "current_phase"),
+};
+
 int32_t ad5940_iio_init(struct ad5940_iio_dev **iio_dev,
 			struct ad5940_iio_init_param *init_param)
 {
 	int32_t ret;
 	struct ad5940_iio_dev *desc;
 	AppBiaCfg_Type *pBiaCfg;
-	uint16_t ch;
 
 	if (!iio_dev || !init_param)
 		return -EINVAL;
@@ -307,21 +353,24 @@ int32_t ad5940_iio_init(struct ad5940_iio_dev **iio_dev,
 
 	desc->iio = &ad5940_iio_device;
 
-	desc->iio->channels = (struct iio_channel *)no_os_calloc(1,
-			      sizeof(struct iio_channel));
-	if (!desc->iio->channels)
-		goto error_1;
+	desc->iio->channels = ad5940_channels;
 	desc->iio->num_ch = 1;
-
-	ch = 0;
-	desc->iio->channels[ch].name = "bia";
-	desc->iio->channels[ch].ch_type = IIO_VOLTAGE;
-	desc->iio->channels[ch].indexed = true;
-	desc->iio->channels[ch].attributes = ad5940_channel_attributes;
+	if (init_param->stream_cfg)
+		desc->iio->num_ch += BIA_STREAM_NB_SAMPLES;
 
 	ret = ad5940_init(&desc->ad5940, init_param->ad5940_init);
 	if (ret)
-		goto error_2;
+		goto error_1;
+
+	if (init_param->stream_cfg) {
+		ret = AppBiaStreamInit(desc->ad5940, init_param->stream_cfg);
+		if (ret)
+			goto error_3;
+
+		desc->stream.dev = desc->ad5940;
+		desc->stream.ops = &AppBiaStreamOps;
+		AppBiaStreamGetFormat(&desc->stream.format);
+	}
 
 	AppBiaGetCfg(&pBiaCfg);
 	pBiaCfg->bParamsChanged = true;
@@ -348,13 +397,15 @@ int32_t ad5940_iio_init(struct ad5940_iio_dev **iio_dev,
 
 	ret = AppBiaInit(desc->ad5940, desc->AppBuff, 512);
 	if (ret < 0)
-		goto error_2;
+		goto error_4;
 
 	*iio_dev = desc;
 
 	return 0;
-error_2:
-	no_os_free(desc->iio->channels);
+error_4:
+	AppBiaStreamRemove(desc->ad5940);
+error_3:
+	ad5940_remove(desc->ad5940);
 error_1:
 	no_os_free(desc);
 
@@ -365,11 +416,14 @@ int32_t ad5940_iio_remove(struct ad5940_iio_dev *desc)
 {
 	int32_t ret;
 
+	ret = AppBiaStreamRemove(desc->ad5940);
+	if (ret != 0)
+		return ret;
+
 	ret = ad5940_remove(desc->ad5940);
 	if (ret != 0)
 		return ret;
 
-	no_os_free(desc->iio->channels);
 	no_os_free(desc);
 
 	return 0;
@@ -41,6 +41,7 @@
 
 #include "iio.h"
 #include "ad5940.h"
+#include "bia_measurement.h"
 
 enum ad5940_iio_attr {
 	AD5940_IIO_EXCITATION_FREQUENCY,
@@ -56,10 +57,13 @@ struct ad5940_iio_dev {
 	bool magnitude_mode;
 	bool gpio1;
 	uint32_t AppBuff[512];
+	struct no_os_ain_stream stream;
 };
 
 struct ad5940_iio_init_param {
 	struct ad5940_init_param *ad5940_init;
+	/* Optional, enables the buffered magnitude and phase channels */
+	AppBiaStreamCfg_Type *stream_cfg;
 };
 
 int32_t ad5940_iio_init(struct ad5940_iio_dev **iio_dev,
@@ -0,0 +1,168 @@
+/***************************************************************************//**
+ *   @file   no_os_ain.c
+ *   @brief  Implementation of the analog input stream interface
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "no_os_ain.h"
+#include "no_os_error.h"
+
+/**
+ * @brief Start producing blocks.
+ * @param stream - The stream.
+ * @param block_scans - Number of scans in a block.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_ain_stream_start(struct no_os_ain_stream *stream,
+			       uint32_t block_scans)
+{
+	int32_t ret;
+
+	if (!stream || !stream->ops || !stream->ops->start || !block_scans)
+		return -EINVAL;
+
+	if (stream->started)
+		return -EBUSY;
+
+	ret = stream->ops->start(stream->dev, block_scans);
+	if (ret)
+		return ret;
+
+	stream->block_scans = block_scans;
+	stream->held = false;
+	stream->started = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop producing blocks. A held block is given back first.
+ * @param stream - The stream.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_ain_stream_stop(struct no_os_ain_stream *stream)
+{
+	if (!stream || !stream->ops || !stream->ops->stop)
+		return -EINVAL;
+
+	if (!stream->started)
+		return 0;
+
+	if (stream->held)
+		no_os_ain_stream_release_block(stream);
+
+	stream->started = false;
+
+	return stream->ops->stop(stream->dev);
+}
+
+/**
+ * @brief Get the oldest complete block. Only one block can be held at a time.
+ * @param stream - The stream.
+ * @param block - Start of the block, block_scans scans of
+ *		  no_os_ain_stream_scan_bytes() bytes.
+ * @return 0 in case of success, -EAGAIN if no block is ready, negative error
+ *	   code otherwise.
+ */
+int32_t no_os_ain_stream_get_block(struct no_os_ain_stream *stream,
+				   void **block)
+{
+	int32_t ret;
+
+	if (!stream || !stream->ops || !stream->ops->get_block || !block)
+		return -EINVAL;
+
+	if (!stream->started || stream->held)
+		return -EBUSY;
+
+	ret = stream->ops->get_block(stream->dev, block);
+	if (ret)
+		return ret;
+
+	stream->held = true;
+
+	return 0;
+}
+
+/**
+ * @brief Give back the block returned by no_os_ain_stream_get_block().
+ * @param stream - The stream.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_ain_stream_release_block(struct no_os_ain_stream *stream)
+{
+	if (!stream || !stream->ops || !stream->ops->release_block)
+		return -EINVAL;
+
+	if (!stream->held)
+		return -EINVAL;
+
+	stream->held = false;
+
+	return stream->ops->release_block(stream->dev);
+}
+
+/**
+ * @brief Get the number of scans or blocks lost since start.
+ * @param stream - The stream.
+ * @param overruns - Number of overruns.
+ * @return 0 in case of success, -ENOSYS if the driver does not count them,
+ *	   negative error code otherwise.
+ */
+int32_t no_os_ain_stream_get_overruns(struct no_os_ain_stream *stream,
+				      uint32_t *overruns)
+{
+	if (!stream || !stream->ops || !overruns)
+		return -EINVAL;
+
+	if (!stream->ops->get_overruns)
+		return -ENOSYS;
+
+	return stream->ops->get_overruns(stream->dev, overruns);
+}
+
+/**
+ * @brief Size of a scan in bytes.
+ * @param stream - The stream.
+ * @return Bytes in a scan, 0 if stream is NULL.
+ */
+uint32_t no_os_ain_stream_scan_bytes(struct no_os_ain_stream *stream)
+{
+	if (!stream)
+		return 0;
+
+	return stream->format.nb_samples * (stream->format.storagebits / 8);
+}
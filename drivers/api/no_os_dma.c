@@ -44,6 +44,12 @@
 #include "no_os_irq.h"
 #include "no_os_alloc.h"
 #include "no_os_list.h"
+#include "no_os_profile.h"
+
+#ifdef NO_OS_PROFILING
+/* Time from no_os_dma_xfer_start() to the completion of the transfer */
+static struct no_os_profile dma_xfer_profile = NO_OS_PROFILE_INIT("dma_xfer");
+#endif
 
 /**
  * @brief Default handler for cycling though the channel's list of transfers
@@ -53,30 +59,36 @@
 static void default_sg_callback(void *context)
 {
 	struct no_os_dma_default_handler_data *data = context;
-	struct no_os_dma_xfer_desc *next_xfer;
+	struct no_os_dma_xfer_desc *next_xfer = NULL;
 	struct no_os_dma_xfer_desc *old_xfer;
-	uint32_t list_size;
-	int ret;
+	struct no_os_ilist_node *node;
 
 	/* Handle the next transfer from the SG list */
-	ret = no_os_list_get_first(data->channel->sg_list, (void **)&old_xfer);
-	if (ret) {
+	node = no_os_ilist_get_first(&data->channel->sg_list);
+	if (!node) {
 		/*
-		 * This should only happen if the list descriptor is NULL.
 		 * The case in which there is no transfer left in the list should
 		 * have been handled in the previous interrupt.
 		 */
 		no_os_dma_xfer_abort(data->desc, data->channel);
 		return;
 	}
+	old_xfer = NO_OS_ILIST_ENTRY(node, struct no_os_dma_xfer_desc, sg_node);
+
+#ifdef NO_OS_PROFILING
+	no_os_profile_add(&dma_xfer_profile,
+			  no_os_get_cycles() - data->channel->start_cycles);
+#endif
 
-	no_os_list_read_first(data->channel->sg_list, (void **)&next_xfer);
-	no_os_list_get_size(data->channel->sg_list, &list_size);
+	node = no_os_ilist_first(&data->channel->sg_list);
+	if (node)
+		next_xfer = NO_OS_ILIST_ENTRY(node, struct no_os_dma_xfer_desc,
+					      sg_node);
 	if (old_xfer->xfer_complete_cb)
 		old_xfer->xfer_complete_cb(old_xfer, next_xfer,
 					   old_xfer->xfer_complete_ctx);
 
-	if (!list_size) {
+	if (!next_xfer) {
 		no_os_irq_disable(data->desc->irq_ctrl, data->channel->irq_num);
 		data->channel->free = true;
 		return;
@@ -87,6 +99,31 @@ static void default_sg_callback(void *context)
 	no_os_dma_xfer_start(data->desc, data->channel);
 }
 
+/**
+ * @brief Handler for cyclic transfers. Queues the next period and reports the
+ * 	  completed one, without any list operations.
+ * @param context - structure which stores the state of the current channel
+ * 		    and DMA controller state.
+ */
+static void cyclic_period_callback(void *context)
+{
+	struct no_os_dma_default_handler_data *data = context;
+	struct no_os_dma_cyclic_desc *cyclic = data->channel->cyclic;
+	uint32_t done;
+
+	if (!cyclic)
+		return;
+
+	done = cyclic->period;
+	cyclic->period = (done + 1) % cyclic->num_periods;
+
+	if (data->desc->platform_ops->dma_cyclic_next)
+		data->desc->platform_ops->dma_cyclic_next(data->channel, cyclic);
+
+	if (cyclic->period_cb)
+		cyclic->period_cb(cyclic, done, cyclic->period_ctx);
+}
+
 /**
  * @brief Initialize the DMA controller.
  * @param desc - Structure containing the state of the DMA controller
@@ -97,7 +134,7 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 		   struct no_os_dma_init_param *param)
 {
 	int ret;
-	uint32_t i, j;
+	uint32_t i;
 	void *mutex;
 
 	if (!param || !param->platform_ops)
@@ -118,23 +155,11 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 	(*desc)->platform_ops = param->platform_ops;
 
 	for (i = 0; i < param->num_ch; i++) {
-		ret = no_os_list_init(&(*desc)->channels[i].sg_list, NO_OS_LIST_QUEUE, NULL);
-		if (ret)
-			goto list_err;
-
+		no_os_ilist_init(&(*desc)->channels[i].sg_list);
 		no_os_mutex_init(&(*desc)->channels[i].mutex);
 	}
 
 	(*desc)->ref++;
-	no_os_mutex_unlock(mutex);
-
-	return 0;
-
-list_err:
-	for (j = 0; j < i; j++)
-		no_os_list_remove((*desc)->channels[i].sg_list);
-
-	no_os_dma_remove(*desc);
 unlock:
 	no_os_mutex_unlock(mutex);
 
@@ -158,10 +183,7 @@ int no_os_dma_remove(struct no_os_dma_desc *desc)
 		return 0;
 
 	for (i = 0; i < desc->num_ch; i++) {
-		ret = no_os_list_remove(desc->channels->sg_list);
-		if (ret)
-			return ret;
-
+		no_os_ilist_init(&desc->channels[i].sg_list);
 		no_os_mutex_remove(desc->channels[i].mutex);
 	}
 
@@ -276,7 +298,7 @@ int no_os_dma_config_xfer(struct no_os_dma_desc *desc,
 	 * there are no ongoing transfers on this channel.
 	 */
 	for (i = 0; i < len; i++)
-		no_os_list_add_last(ch->sg_list, &xfer[i]);
+		no_os_ilist_add_last(&ch->sg_list, &xfer[i].sg_node);
 
 	if (desc->irq_ctrl) {
 		ch->irq_ctx.desc = desc;
@@ -312,6 +334,82 @@ unlock:
 	return ret;
 }
 
+/**
+ * @brief Configure a cyclic transfer on a channel. Once started using
+ * 	  no_os_dma_xfer_start(), the periods are transferred endlessly until
+ * 	  no_os_dma_xfer_abort() is called.
+ * @param desc - Structure containing the state of the DMA controller
+ * @param cyclic - Cyclic transfer. Must be valid until the transfer is aborted.
+ * @param ch - Previously acquired channel, for which the transfer will be configured.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dma_config_cyclic(struct no_os_dma_desc *desc,
+			    struct no_os_dma_cyclic_desc *cyclic,
+			    struct no_os_dma_ch *ch)
+{
+	int ret;
+
+	struct no_os_callback_desc period_callback = {
+		.callback = cyclic_period_callback,
+	};
+
+	if (!desc || !desc->platform_ops || !cyclic || !ch)
+		return -EINVAL;
+
+	if (!cyclic->num_periods || !cyclic->xfer.length ||
+	    cyclic->xfer.length % cyclic->num_periods)
+		return -EINVAL;
+
+	if (!desc->platform_ops->dma_config_cyclic || !desc->irq_ctrl)
+		return -ENOSYS;
+
+	switch (cyclic->xfer.xfer_type) {
+	case MEM_TO_DEV:
+	case MEM_TO_MEM:
+		period_callback.event = NO_OS_EVT_DMA_TX_COMPLETE;
+		break;
+	case DEV_TO_MEM:
+		period_callback.event = NO_OS_EVT_DMA_RX_COMPLETE;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	no_os_mutex_lock(ch->mutex);
+
+	cyclic->period_len = cyclic->xfer.length / cyclic->num_periods;
+	cyclic->period = 0;
+	ch->cyclic = cyclic;
+
+	ret = desc->platform_ops->dma_config_cyclic(ch, cyclic);
+	if (ret)
+		goto abort_xfer;
+
+	ch->irq_ctx.desc = desc;
+	ch->irq_ctx.channel = ch;
+	period_callback.ctx = &ch->irq_ctx;
+	period_callback.peripheral = cyclic->xfer.periph;
+	period_callback.handle = (void *)ch->id;
+
+	ret = no_os_irq_register_callback(desc->irq_ctrl, ch->irq_num,
+					  &period_callback);
+	if (ret)
+		goto abort_xfer;
+
+	no_os_irq_set_priority(desc->irq_ctrl, ch->irq_num,
+			       cyclic->xfer.irq_priority);
+
+	no_os_mutex_unlock(ch->mutex);
+
+	return 0;
+
+abort_xfer:
+	ch->cyclic = NULL;
+	no_os_mutex_unlock(ch->mutex);
+
+	return ret;
+}
+
 /**
  * @brief Lock a DMA channel, so it won't be acquired even if it's free.
  * @param ch - Reference to the DMA channel
@@ -371,6 +469,9 @@ int no_os_dma_xfer_start(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
 	if (desc->irq_ctrl)
 		no_os_irq_enable(desc->irq_ctrl, ch->irq_num);
 
+#ifdef NO_OS_PROFILING
+	ch->start_cycles = no_os_get_cycles();
+#endif
 	ret = desc->platform_ops->dma_xfer_start(desc, ch);
 
 	no_os_mutex_unlock(ch->mutex);
@@ -386,7 +487,6 @@ int no_os_dma_xfer_start(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
  */
 int no_os_dma_xfer_abort(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
 {
-	void *discard;
 	int ret;
 
 	if (!desc || !desc->platform_ops || !ch)
@@ -400,9 +500,8 @@ int no_os_dma_xfer_abort(struct no_os_dma_desc *desc, struct no_os_dma_ch *ch)
 	if (desc->irq_ctrl)
 		no_os_irq_disable(desc->irq_ctrl, ch->irq_num);
 
-	do {
-		ret = no_os_list_get_first(ch->sg_list, &discard);
-	} while (!ret);
+	no_os_ilist_init(&ch->sg_list);
+	ch->cyclic = NULL;
 
 	ret = desc->platform_ops->dma_xfer_abort(desc, ch);
 
@@ -41,6 +41,18 @@
 #include "no_os_gpio.h"
 #include <stdlib.h>
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_static_ops.h"
+
+/* Platform ops of a descriptor, fixed when named in no_os_platform_config.h */
+#ifdef NO_OS_GPIO_PLATFORM_OPS
+#define GPIO_OPS(desc)	(&NO_OS_GPIO_PLATFORM_OPS)
+#define GPIO_OPS_VALID(ops)	((ops) == &NO_OS_GPIO_PLATFORM_OPS)
+#else
+#define GPIO_OPS(desc)	((desc)->platform_ops)
+#define GPIO_OPS_VALID(ops)	((ops) != NULL)
+#endif
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -57,7 +69,7 @@ int32_t no_os_gpio_get(struct no_os_gpio_desc **desc,
 {
 	int32_t ret;
 
-	if (!param || !param->platform_ops)
+	if (!param || !GPIO_OPS_VALID(param->platform_ops))
 		return -EINVAL;
 
 	if (!param->platform_ops->gpio_ops_get)
@@ -88,7 +100,7 @@ int32_t no_os_gpio_get_optional(struct no_os_gpio_desc **desc,
 		return 0;
 	}
 
-	if (!param->platform_ops)
+	if (!GPIO_OPS_VALID(param->platform_ops))
 		return -EINVAL;
 
 	if (!param->platform_ops->gpio_ops_get_optional)
@@ -113,10 +125,10 @@ int32_t no_os_gpio_remove(struct no_os_gpio_desc *desc)
 		if (!desc->platform_ops)
 			return -EINVAL;
 
-		if (!desc->platform_ops->gpio_ops_remove)
+		if (!GPIO_OPS(desc)->gpio_ops_remove)
 			return -ENOSYS;
 
-		return desc->platform_ops->gpio_ops_remove(desc);
+		return GPIO_OPS(desc)->gpio_ops_remove(desc);
 	}
 
 	return 0;
@@ -133,10 +145,10 @@ int32_t no_os_gpio_direction_input(struct no_os_gpio_desc *desc)
 		if (!desc->platform_ops)
 			return -EINVAL;
 
-		if (!desc->platform_ops->gpio_ops_direction_input)
+		if (!GPIO_OPS(desc)->gpio_ops_direction_input)
 			return -ENOSYS;
 
-		return desc->platform_ops->gpio_ops_direction_input(desc);
+		return GPIO_OPS(desc)->gpio_ops_direction_input(desc);
 	}
 
 	return 0;
@@ -157,10 +169,10 @@ int32_t no_os_gpio_direction_output(struct no_os_gpio_desc *desc,
 		if (!desc->platform_ops)
 			return -EINVAL;
 
-		if (!desc->platform_ops->gpio_ops_direction_output)
+		if (!GPIO_OPS(desc)->gpio_ops_direction_output)
 			return -ENOSYS;
 
-		return desc->platform_ops->
+		return GPIO_OPS(desc)->
 		       gpio_ops_direction_output(desc, value);
 	}
 
@@ -182,10 +194,10 @@ int32_t no_os_gpio_get_direction(struct no_os_gpio_desc *desc,
 		if (!desc->platform_ops)
 			return -EINVAL;
 
-		if (!desc->platform_ops->gpio_ops_get_direction)
+		if (!GPIO_OPS(desc)->gpio_ops_get_direction)
 			return -ENOSYS;
 
-		return desc->platform_ops->
+		return GPIO_OPS(desc)->
 		       gpio_ops_get_direction(desc, direction);
 	}
 
@@ -207,10 +219,10 @@ int32_t no_os_gpio_set_value(struct no_os_gpio_desc *desc,
 		if (!desc->platform_ops)
 			return -EINVAL;
 
-		if (!desc->platform_ops->gpio_ops_set_value)
+		if (!GPIO_OPS(desc)->gpio_ops_set_value)
 			return -ENOSYS;
 
-		return desc->platform_ops->gpio_ops_set_value(desc, value);
+		return GPIO_OPS(desc)->gpio_ops_set_value(desc, value);
 	}
 
 	return 0;
@@ -231,11 +243,287 @@ int32_t no_os_gpio_get_value(struct no_os_gpio_desc *desc,
 		if (!desc->platform_ops)
 			return -EINVAL;
 
-		if (!desc->platform_ops->gpio_ops_set_value)
+		if (!GPIO_OPS(desc)->gpio_ops_set_value)
 			return -ENOSYS;
 
-		return desc->platform_ops->gpio_ops_get_value(desc, value);
+		return GPIO_OPS(desc)->gpio_ops_get_value(desc, value);
 	}
 
 	return 0;
 }
+
+/**
+ * @brief Set the masked pins of the port of the specified GPIO in one access.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins of the port to be written, bit n is pin n of the port.
+ * @param value - New values of the masked pins.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_port_set_value(struct no_os_gpio_desc *desc,
+				  uint32_t mask, uint32_t value)
+{
+	if (desc) {
+		if (!desc->platform_ops)
+			return -EINVAL;
+
+		if (!GPIO_OPS(desc)->gpio_ops_port_set_value)
+			return -ENOSYS;
+
+		return GPIO_OPS(desc)->gpio_ops_port_set_value(desc, mask,
+				value);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the masked pins of the port of the specified GPIO in one access.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins of the port to be read, bit n is pin n of the port.
+ * @param value - Values of the masked pins, the other bits are cleared.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_port_get_value(struct no_os_gpio_desc *desc,
+				  uint32_t mask, uint32_t *value)
+{
+	if (desc) {
+		if (!desc->platform_ops)
+			return -EINVAL;
+
+		if (!GPIO_OPS(desc)->gpio_ops_port_get_value)
+			return -ENOSYS;
+
+		return GPIO_OPS(desc)->gpio_ops_port_get_value(desc, mask,
+				value);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Obtain the descriptors of a set of GPIOs.
+ * @param array - The GPIO descriptor array.
+ * @param param - Array of count GPIO initialization parameters.
+ * @param count - Number of GPIOs, 32 at most.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_array_get(struct no_os_gpio_desc_array **array,
+			     const struct no_os_gpio_init_param *param,
+			     uint32_t count)
+{
+	struct no_os_gpio_desc_array *descs;
+	int32_t ret;
+	uint32_t i;
+
+	if (!array || !param || !count || count > 32)
+		return -EINVAL;
+
+	descs = no_os_calloc(1, sizeof(*descs));
+	if (!descs)
+		return -ENOMEM;
+
+	descs->desc = no_os_calloc(count, sizeof(*descs->desc));
+	if (!descs->desc) {
+		ret = -ENOMEM;
+		goto free_array;
+	}
+
+	for (descs->count = 0; descs->count < count; descs->count++) {
+		ret = no_os_gpio_get(&descs->desc[descs->count],
+				     &param[descs->count]);
+		if (ret)
+			goto free_gpios;
+	}
+
+	*array = descs;
+
+	return 0;
+
+free_gpios:
+	for (i = 0; i < descs->count; i++)
+		no_os_gpio_remove(descs->desc[i]);
+	no_os_free(descs->desc);
+free_array:
+	no_os_free(descs);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_gpio_array_get().
+ * @param array - The GPIO descriptor array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_array_remove(struct no_os_gpio_desc_array *array)
+{
+	int32_t ret = 0;
+	uint32_t i;
+
+	if (!array)
+		return -EINVAL;
+
+	for (i = 0; i < array->count; i++) {
+		if (no_os_gpio_remove(array->desc[i]))
+			ret = -EIO;
+	}
+
+	no_os_free(array->desc);
+	no_os_free(array);
+
+	return ret;
+}
+
+/**
+ * @brief Collect the pins of the array that are on the same port as pin
+ * first and can be accessed in a single port operation with it.
+ * @param array - The GPIO descriptor array.
+ * @param first - Index of the first pin of the group.
+ * @param group - Indexes of the array in the group, bit i is desc[i].
+ * @return Mask of the grouped pins in the port, 0 if pin first can only be
+ * accessed on its own.
+ */
+static uint32_t no_os_gpio_array_group(struct no_os_gpio_desc_array *array,
+				       uint32_t first, uint32_t *group)
+{
+	struct no_os_gpio_desc *desc = array->desc[first];
+	struct no_os_gpio_desc *pin;
+	uint32_t mask = 0;
+	uint32_t i;
+
+	*group = 0;
+	if (desc->number < 0 || desc->number > 31)
+		return 0;
+
+	for (i = first; i < array->count; i++) {
+		pin = array->desc[i];
+		if (!pin || pin->platform_ops != desc->platform_ops ||
+		    pin->port != desc->port ||
+		    pin->number < 0 || pin->number > 31)
+			continue;
+
+		mask |= NO_OS_BIT(pin->number);
+		*group |= NO_OS_BIT(i);
+	}
+
+	return mask;
+}
+
+/**
+ * @brief Set the values of a set of GPIOs. Pins sharing a port are written
+ * with a single port access when the platform supports it.
+ * @param array - The GPIO descriptor array.
+ * @param values - New values, bit i is the value of desc[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_array_set_value(struct no_os_gpio_desc_array *array,
+				   uint32_t values)
+{
+	struct no_os_gpio_desc *desc;
+	uint32_t done = 0;
+	uint32_t group;
+	uint32_t mask;
+	uint32_t port;
+	int32_t ret;
+	uint32_t i;
+	uint32_t j;
+
+	if (!array)
+		return -EINVAL;
+
+	for (i = 0; i < array->count; i++) {
+		if (done & NO_OS_BIT(i))
+			continue;
+
+		desc = array->desc[i];
+		if (!desc || !desc->platform_ops)
+			return -EINVAL;
+
+		mask = 0;
+		if (GPIO_OPS(desc)->gpio_ops_port_set_value)
+			mask = no_os_gpio_array_group(array, i, &group);
+
+		if (!mask) {
+			ret = no_os_gpio_set_value(desc, (values >> i) & 1);
+			if (ret)
+				return ret;
+			done |= NO_OS_BIT(i);
+			continue;
+		}
+
+		port = 0;
+		for (j = i; j < array->count; j++)
+			if ((group & NO_OS_BIT(j)) && (values & NO_OS_BIT(j)))
+				port |= NO_OS_BIT(array->desc[j]->number);
+
+		ret = no_os_gpio_port_set_value(desc, mask, port);
+		if (ret)
+			return ret;
+
+		done |= group;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the values of a set of GPIOs. Pins sharing a port are read
+ * with a single port access when the platform supports it.
+ * @param array - The GPIO descriptor array.
+ * @param values - Values of the pins, bit i is the value of desc[i].
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_array_get_value(struct no_os_gpio_desc_array *array,
+				   uint32_t *values)
+{
+	struct no_os_gpio_desc *desc;
+	uint32_t result = 0;
+	uint32_t done = 0;
+	uint32_t group;
+	uint32_t mask;
+	uint32_t port;
+	uint8_t value;
+	int32_t ret;
+	uint32_t i;
+	uint32_t j;
+
+	if (!array || !values)
+		return -EINVAL;
+
+	for (i = 0; i < array->count; i++) {
+		if (done & NO_OS_BIT(i))
+			continue;
+
+		desc = array->desc[i];
+		if (!desc || !desc->platform_ops)
+			return -EINVAL;
+
+		mask = 0;
+		if (GPIO_OPS(desc)->gpio_ops_port_get_value)
+			mask = no_os_gpio_array_group(array, i, &group);
+
+		if (!mask) {
+			ret = no_os_gpio_get_value(desc, &value);
+			if (ret)
+				return ret;
+			if (value)
+				result |= NO_OS_BIT(i);
+			done |= NO_OS_BIT(i);
+			continue;
+		}
+
+		ret = no_os_gpio_port_get_value(desc, mask, &port);
+		if (ret)
+			return ret;
+
+		for (j = i; j < array->count; j++)
+			if ((group & NO_OS_BIT(j)) &&
+			    (port & NO_OS_BIT(array->desc[j]->number)))
+				result |= NO_OS_BIT(j);
+
+		done |= group;
+	}
+
+	*values = result;
+
+	return 0;
+}
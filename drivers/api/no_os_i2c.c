@@ -43,12 +43,37 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_bus_trace.h"
+#include "no_os_static_ops.h"
+
+/* Platform ops of a descriptor, fixed when named in no_os_platform_config.h */
+#ifdef NO_OS_I2C_PLATFORM_OPS
+#define I2C_OPS(desc)	(&NO_OS_I2C_PLATFORM_OPS)
+#define I2C_OPS_VALID(ops)	((ops) == &NO_OS_I2C_PLATFORM_OPS)
+#else
+#define I2C_OPS(desc)	((desc)->platform_ops)
+#define I2C_OPS_VALID(ops)	((ops) != NULL)
+#endif
 
 /**
  * @brief i2c_table contains the pointers towards the i2c buses
 */
 static void *i2c_table[I2C_MAX_BUS_NUMBER + 1];
 
+#ifdef NO_OS_BUS_TRACE
+/* Total length of a list of messages, for the bus tracer */
+static uint32_t no_os_i2c_msgs_len(struct no_os_i2c_msg *msgs,
+				   uint32_t nb_msgs)
+{
+	uint32_t bytes = 0;
+
+	while (nb_msgs--)
+		bytes += msgs[nb_msgs].len;
+
+	return bytes;
+}
+#endif
+
 /**
  * @brief Initialize the I2C communication peripheral.
  * @param desc - The I2C descriptor.
@@ -60,7 +85,7 @@ int32_t no_os_i2c_init(struct no_os_i2c_desc **desc,
 {
 	int32_t ret;
 
-	if (!param || !param->platform_ops)
+	if (!param || !I2C_OPS_VALID(param->platform_ops))
 		return -EINVAL;
 
 	if (!param->platform_ops->i2c_ops_init)
@@ -124,10 +149,10 @@ int32_t no_os_i2c_remove(struct no_os_i2c_desc *desc)
 	if (desc->bus)
 		no_os_i2cbus_remove(desc->bus->device_id);
 
-	if (!desc->platform_ops->i2c_ops_remove)
+	if (!I2C_OPS(desc)->i2c_ops_remove)
 		return -ENOSYS;
 
-	return desc->platform_ops->i2c_ops_remove(desc);
+	return I2C_OPS(desc)->i2c_ops_remove(desc);
 }
 
 /**
@@ -172,13 +197,16 @@ int32_t no_os_i2c_write(struct no_os_i2c_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->i2c_ops_write)
+	if (!I2C_OPS(desc)->i2c_ops_write)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->bus->mutex);
-	ret = desc->platform_ops->i2c_ops_write(desc, data, bytes_number,
+	no_os_bus_lock(desc->bus->mutex);
+	NO_OS_BUS_TRACE_BEGIN(start);
+	ret = I2C_OPS(desc)->i2c_ops_write(desc, data, bytes_number,
 						stop_bit);
-	no_os_mutex_unlock(desc->bus->mutex);
+	NO_OS_BUS_TRACE_END(start, NO_OS_BUS_TRACE_I2C, desc->device_id,
+			    desc->slave_address, bytes_number, ret);
+	no_os_bus_unlock(desc->bus->mutex);
 
 	return ret;
 }
@@ -203,13 +231,124 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->i2c_ops_read)
+	if (!I2C_OPS(desc)->i2c_ops_read)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->bus->mutex);
-	ret = desc->platform_ops->i2c_ops_read(desc, data, bytes_number,
+	no_os_bus_lock(desc->bus->mutex);
+	NO_OS_BUS_TRACE_BEGIN(start);
+	ret = I2C_OPS(desc)->i2c_ops_read(desc, data, bytes_number,
 					       stop_bit);
-	no_os_mutex_unlock(desc->bus->mutex);
+	NO_OS_BUS_TRACE_END(start, NO_OS_BUS_TRACE_I2C, desc->device_id,
+			    desc->slave_address, bytes_number, ret);
+	no_os_bus_unlock(desc->bus->mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Transfer a list of messages joined by repeated starts. The stop
+ * condition is only generated after the last message. The bus is locked once
+ * for the whole list. Platforms without a combined transfer fall back to a
+ * sequence of reads and writes, limited to 255 bytes per message.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t nb_msgs)
+{
+	int32_t ret = 0;
+	uint32_t i;
+
+	if (!desc || !desc->platform_ops || !msgs || !nb_msgs)
+		return -EINVAL;
+
+	if (!I2C_OPS(desc)->i2c_ops_transfer &&
+	    (!I2C_OPS(desc)->i2c_ops_write ||
+	     !I2C_OPS(desc)->i2c_ops_read))
+		return -ENOSYS;
+
+	no_os_bus_lock(desc->bus->mutex);
+	NO_OS_BUS_TRACE_BEGIN(start);
+	if (I2C_OPS(desc)->i2c_ops_transfer) {
+		ret = I2C_OPS(desc)->i2c_ops_transfer(desc, msgs, nb_msgs);
+		goto unlock;
+	}
+
+	for (i = 0; i < nb_msgs; i++) {
+		if (msgs[i].len > UINT8_MAX) {
+			ret = -EINVAL;
+			break;
+		}
+
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			ret = I2C_OPS(desc)->i2c_ops_read(desc, msgs[i].buf,
+							       msgs[i].len,
+							       i == nb_msgs - 1);
+		else
+			ret = I2C_OPS(desc)->i2c_ops_write(desc, msgs[i].buf,
+								msgs[i].len,
+								i == nb_msgs - 1);
+		if (ret)
+			break;
+	}
+unlock:
+	NO_OS_BUS_TRACE_END(start, NO_OS_BUS_TRACE_I2C, desc->device_id,
+			    desc->slave_address, no_os_i2c_msgs_len(msgs, nb_msgs),
+			    ret);
+	no_os_bus_unlock(desc->bus->mutex);
 
 	return ret;
 }
+
+/**
+ * @brief Write data to a slave device and read its answer after a repeated
+ * start, e.g. a register address followed by the register value.
+ * @param desc - The I2C descriptor.
+ * @param tx - The data to write.
+ * @param tx_len - Number of bytes to write.
+ * @param rx - The buffer where to store the read data.
+ * @param rx_len - Number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_i2c_write_read(struct no_os_i2c_desc *desc,
+			     uint8_t *tx, uint32_t tx_len,
+			     uint8_t *rx, uint32_t rx_len)
+{
+	struct no_os_i2c_msg msgs[2] = {
+		{ .buf = tx, .len = tx_len },
+		{ .buf = rx, .len = rx_len, .flags = NO_OS_I2C_M_RD },
+	};
+
+	return no_os_i2c_transfer(desc, msgs, 2);
+}
+
+/**
+ * @brief Start the transfer of a list of messages joined by repeated starts
+ * and return. The bus is not locked: the caller must not start other
+ * transfers on it, nor touch the messages, until the callback is invoked.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @param callback - Invoked, usually from interrupt context, with ctx and the
+ * 		     result of the transfer once it is done.
+ * @param ctx - Parameter for the callback.
+ * @return 0 if the transfer was started, negative error code otherwise.
+ */
+int32_t no_os_i2c_transfer_async(struct no_os_i2c_desc *desc,
+				 struct no_os_i2c_msg *msgs,
+				 uint32_t nb_msgs,
+				 void (*callback)(void *ctx, int32_t status),
+				 void *ctx)
+{
+	if (!desc || !desc->platform_ops || !msgs || !nb_msgs)
+		return -EINVAL;
+
+	if (!I2C_OPS(desc)->i2c_ops_transfer_async)
+		return -ENOSYS;
+
+	return I2C_OPS(desc)->i2c_ops_transfer_async(desc, msgs, nb_msgs,
+			callback, ctx);
+}
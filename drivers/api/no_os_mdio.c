@@ -123,3 +123,42 @@ int no_os_mdio_read(struct no_os_mdio_desc *desc, uint32_t reg, uint16_t *val)
 
 	return desc->ops->read(desc, reg, val);
 }
+
+/**
+ * @brief Read and write a list of registers using MDIO, in order.
+ * 	  Implementations of the transfer op can share the frames common to the
+ * 	  accesses, e.g. the clause 45 address frame of consecutive registers.
+ * 	  Without it, the accesses are done one by one with the read and write
+ * 	  ops.
+ * @param desc - The MDIO descriptor.
+ * @param xfers - Register accesses, the values read are stored in their val.
+ * @param nb - Number of register accesses.
+ * @return 0 in case of success, error code otherwise. The accesses following
+ * 	   the first one that failed are not done.
+ */
+int no_os_mdio_transfer(struct no_os_mdio_desc *desc,
+			struct no_os_mdio_xfer *xfers, uint32_t nb)
+{
+	int ret;
+	uint32_t i;
+
+	if (!desc || !desc->ops || (nb && !xfers))
+		return -EINVAL;
+
+	if (desc->ops->transfer)
+		return desc->ops->transfer(desc, xfers, nb);
+
+	if (!desc->ops->read || !desc->ops->write)
+		return -ENOSYS;
+
+	for (i = 0; i < nb; i++) {
+		if (xfers[i].write)
+			ret = desc->ops->write(desc, xfers[i].reg, xfers[i].val);
+		else
+			ret = desc->ops->read(desc, xfers[i].reg, &xfers[i].val);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
@@ -43,12 +43,37 @@
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_bus_trace.h"
+#include "no_os_static_ops.h"
+
+/* Platform ops of a descriptor, fixed when named in no_os_platform_config.h */
+#ifdef NO_OS_SPI_PLATFORM_OPS
+#define SPI_OPS(desc)	(&NO_OS_SPI_PLATFORM_OPS)
+#define SPI_OPS_VALID(ops)	((ops) == &NO_OS_SPI_PLATFORM_OPS)
+#else
+#define SPI_OPS(desc)	((desc)->platform_ops)
+#define SPI_OPS_VALID(ops)	((ops) != NULL)
+#endif
 
 /**
  * @brief spi_table contains the pointers towards the SPI buses
 */
 static void *spi_table[SPI_MAX_BUS_NUMBER + 1];
 
+#ifdef NO_OS_BUS_TRACE
+/* Total length of a list of messages, for the bus tracer */
+static uint32_t no_os_spi_msgs_len(struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t bytes = 0;
+
+	while (len--)
+		bytes += msgs[len].bytes_number;
+
+	return bytes;
+}
+#endif
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -60,7 +85,7 @@ int32_t no_os_spi_init(struct no_os_spi_desc **desc,
 {
 	int32_t ret;
 
-	if (!param || !param->platform_ops)
+	if (!param || !SPI_OPS_VALID(param->platform_ops))
 		return -EINVAL;
 
 	if (!param->platform_ops->init)
@@ -82,6 +107,21 @@ int32_t no_os_spi_init(struct no_os_spi_desc **desc,
 	(*desc)->platform_ops = param->platform_ops;
 	(*desc)->parent = param->parent;
 	(*desc)->platform_delays = param->platform_delays;
+	(*desc)->config_speed_hz = (*desc)->max_speed_hz;
+	(*desc)->data_speed_hz = param->data_speed_hz;
+
+	/* Reject a data rate the dividers can't reach now, not on the first read */
+	if (param->data_speed_hz && param->data_speed_hz != (*desc)->max_speed_hz &&
+	    param->platform_ops->set_speed) {
+		ret = param->platform_ops->set_speed(*desc, param->data_speed_hz);
+		if (!ret)
+			ret = param->platform_ops->set_speed(*desc,
+							     (*desc)->max_speed_hz);
+		if (ret) {
+			no_os_spi_remove(*desc);
+			return ret;
+		}
+	}
 
 	return 0;
 }
@@ -108,6 +148,8 @@ int32_t no_os_spibus_init(const struct no_os_spi_init_param *param)
 	bus->bit_order = param->bit_order;
 	bus->platform_ops = param->platform_ops;
 	bus->extra = param->extra;
+	bus->xfers.name = "spi_xfers";
+	bus->xfers.index = param->device_id;
 
 	spi_table[param->device_id] = bus;
 
@@ -127,9 +169,9 @@ int32_t no_os_spi_remove(struct no_os_spi_desc *desc)
 	if (desc->bus)
 		no_os_spibus_remove(desc->bus->device_id);
 
-	if (!desc->platform_ops->remove)
+	if (!SPI_OPS(desc)->remove)
 		return -ENOSYS;
-	return desc->platform_ops->remove(desc);
+	return SPI_OPS(desc)->remove(desc);
 }
 
 /**
@@ -146,6 +188,7 @@ void no_os_spibus_remove(uint32_t bus_number)
 
 	if (bus->slave_number == 0) {
 		no_os_mutex_remove(bus->mutex);
+		NO_OS_COUNTER_REMOVE(bus->xfers);
 
 		if (bus) {
 			no_os_free(bus);
@@ -171,12 +214,16 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->write_and_read)
+	if (!SPI_OPS(desc)->write_and_read)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->bus->mutex);
-	ret =  desc->platform_ops->write_and_read(desc, data, bytes_number);
-	no_os_mutex_unlock(desc->bus->mutex);
+	no_os_bus_lock(desc->bus->mutex);
+	NO_OS_BUS_TRACE_BEGIN(start);
+	ret =  SPI_OPS(desc)->write_and_read(desc, data, bytes_number);
+	NO_OS_BUS_TRACE_END(start, NO_OS_BUS_TRACE_SPI, desc->device_id,
+			    desc->chip_select, bytes_number, ret);
+	NO_OS_COUNTER_ADD(desc->bus->xfers, 1);
+	no_os_bus_unlock(desc->bus->mutex);
 
 	return ret;
 }
@@ -198,10 +245,18 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer)
-		return desc->platform_ops->transfer(desc, msgs, len);
+	if (SPI_OPS(desc)->transfer) {
+		NO_OS_BUS_TRACE_BEGIN(start);
+		NO_OS_COUNTER_ADD(desc->bus->xfers, len);
+		ret = SPI_OPS(desc)->transfer(desc, msgs, len);
+		NO_OS_BUS_TRACE_END(start, NO_OS_BUS_TRACE_SPI, desc->device_id,
+				    desc->chip_select,
+				    no_os_spi_msgs_len(msgs, len), ret);
+
+		return ret;
+	}
 
-	no_os_mutex_lock(desc->bus->mutex);
+	no_os_bus_lock(desc->bus->mutex);
 
 	for (i = 0; i < len; i++) {
 		if (msgs[i].rx_buff != msgs[i].tx_buff || !msgs[i].tx_buff) {
@@ -216,7 +271,7 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 	}
 
 out:
-	no_os_mutex_unlock(desc->bus->mutex);
+	no_os_bus_unlock(desc->bus->mutex);
 	return ret;
 }
 
@@ -231,11 +286,21 @@ int32_t no_os_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
 				    struct no_os_spi_msg *msgs,
 				    uint32_t len)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !msgs || !len)
 		return -EINVAL;
 
-	if (desc->platform_ops->dma_transfer_sync)
-		return desc->platform_ops->dma_transfer_sync(desc, msgs, len);
+	if (SPI_OPS(desc)->dma_transfer_sync) {
+		NO_OS_BUS_TRACE_BEGIN(start);
+		NO_OS_COUNTER_ADD(desc->bus->xfers, len);
+		ret = SPI_OPS(desc)->dma_transfer_sync(desc, msgs, len);
+		NO_OS_BUS_TRACE_END(start, NO_OS_BUS_TRACE_SPI, desc->device_id,
+				    desc->chip_select,
+				    no_os_spi_msgs_len(msgs, len), ret);
+
+		return ret;
+	}
 
 	return -ENOSYS;
 }
@@ -260,9 +325,375 @@ int32_t no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops || !msgs || !len)
 		return -EINVAL;
 
-	if (desc->platform_ops->dma_transfer_async)
-		return desc->platform_ops->dma_transfer_async(desc, msgs, len,
+	if (SPI_OPS(desc)->dma_transfer_async) {
+		NO_OS_COUNTER_ADD(desc->bus->xfers, len);
+		return SPI_OPS(desc)->dma_transfer_async(desc, msgs, len,
 				callback, ctx);
+	}
 
 	return -ENOSYS;
 }
+
+/**
+ * @brief Write a large buffer as a list of chip select framed chunks. The
+ * 	  chunks are sent by DMA, without touching the buffer, when the platform
+ * 	  supports it, otherwise by write_and_read() which overwrites the buffer
+ * 	  with the received data.
+ * @param desc - The SPI descriptor.
+ * @param data - Data to be written.
+ * @param len - Number of bytes to be written.
+ * @param max_chunk - Maximum number of bytes per chip select assertion.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_write_chunked(struct no_os_spi_desc *desc, uint8_t *data,
+				uint32_t len, uint32_t max_chunk)
+{
+	struct no_os_spi_msg msgs[NO_OS_SPI_CHUNKED_MSGS];
+	uint32_t cnt, n;
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops || (!data && len) || !max_chunk ||
+	    max_chunk > UINT16_MAX)
+		return -EINVAL;
+
+	while (len) {
+		n = no_os_min(len, max_chunk);
+		if (!SPI_OPS(desc)->dma_transfer_sync) {
+			ret = no_os_spi_write_and_read(desc, data, n);
+			if (ret)
+				return ret;
+
+			data += n;
+			len -= n;
+			continue;
+		}
+
+		for (cnt = 0; cnt < NO_OS_SPI_CHUNKED_MSGS && len; cnt++) {
+			n = no_os_min(len, max_chunk);
+			msgs[cnt] = (struct no_os_spi_msg) {
+				.tx_buff = data,
+				.bytes_number = n,
+				.cs_change = 1,
+			};
+			data += n;
+			len -= n;
+		}
+
+		ret = no_os_spi_transfer_dma_sync(desc, msgs, cnt);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Take the highest priority request out of the bus queue. Clears the
+ * 	  busy flag once the queue is empty.
+ * @param bus - The SPI bus descriptor.
+ * @return The request, NULL if the queue is empty.
+ */
+static struct no_os_spi_request *no_os_spi_queue_pop(struct no_os_spibus_desc
+		*bus)
+{
+	struct no_os_spi_request *req;
+	uint32_t flags;
+
+	flags = no_os_critical_enter();
+	req = bus->queue;
+	if (req)
+		bus->queue = req->next;
+	else
+		bus->queue_busy = false;
+	no_os_critical_exit(flags);
+
+	return req;
+}
+
+static void no_os_spi_queue_serve(struct no_os_spibus_desc *bus);
+
+/**
+ * @brief Complete a request and serve the next ones in the bus queue.
+ * @param ctx - The completed request.
+ */
+static void no_os_spi_request_complete(void *ctx)
+{
+	struct no_os_spi_request *req = ctx;
+	struct no_os_spibus_desc *bus = req->desc->bus;
+
+	req->done = true;
+	if (req->complete)
+		req->complete(req, req->ctx);
+
+	no_os_spi_queue_serve(bus);
+}
+
+/**
+ * @brief Serve the bus queue. If the platform can transfer asynchronously, a
+ * 	  request is started and the next one is served from its completion.
+ * 	  Otherwise, or if the asynchronous transfer returns -ENOSYS, the
+ * 	  requests are transferred one after the other, including the ones
+ * 	  submitted meanwhile, e.g from interrupts.
+ * @param bus - The SPI bus descriptor.
+ */
+static void no_os_spi_queue_serve(struct no_os_spibus_desc *bus)
+{
+	struct no_os_spi_request *req;
+	int32_t ret;
+
+	while ((req = no_os_spi_queue_pop(bus))) {
+		ret = -ENOSYS;
+		if (SPI_OPS(req->desc)->dma_transfer_async) {
+			ret = SPI_OPS(req->desc)->dma_transfer_async(req->desc,
+									  req->msgs, req->len,
+					no_os_spi_request_complete, req);
+			if (!ret)
+				return;
+		}
+		/* Layered drivers, e.g. demux_spi, defer to their controller */
+		if (ret == -ENOSYS)
+			ret = no_os_spi_transfer(req->desc, req->msgs, req->len);
+
+		req->status = ret;
+		req->done = true;
+		if (req->complete)
+			req->complete(req, req->ctx);
+	}
+}
+
+/**
+ * @brief Queue a request on the bus of its SPI device. Requests are served by
+ * 	  priority, so that a high rate device sharing the bus doesn't wait for
+ * 	  the slow traffic queued before it. If the bus is idle, serving starts
+ * 	  right away. The request is done once its done flag is set and its
+ * 	  complete callback was called.
+ * @param req - The request. Must be valid until it's done.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_submit(struct no_os_spi_request *req)
+{
+	struct no_os_spi_request **pos;
+	struct no_os_spibus_desc *bus;
+	uint32_t flags;
+	bool serve;
+
+	if (!req || !req->desc || !req->desc->bus || !req->desc->platform_ops ||
+	    !req->msgs || !req->len)
+		return -EINVAL;
+
+	bus = req->desc->bus;
+	req->status = 0;
+	req->done = false;
+
+	flags = no_os_critical_enter();
+	pos = &bus->queue;
+	while (*pos && (*pos)->priority >= req->priority)
+		pos = &(*pos)->next;
+	req->next = *pos;
+	*pos = req;
+
+	serve = !bus->queue_busy;
+	bus->queue_busy = true;
+	no_os_critical_exit(flags);
+
+	if (serve)
+		no_os_spi_queue_serve(bus);
+
+	return 0;
+}
+
+/**
+ * @brief Validate a sequence of messages and translate it into platform
+ * 	  descriptors, so that it can be replayed without rebuilding them.
+ * @param seq - The sequence to be initialized.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages. Must be valid until the sequence is removed.
+ * @param len - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_seq_init(struct no_os_spi_seq **seq,
+			   struct no_os_spi_desc *desc,
+			   struct no_os_spi_msg *msgs,
+			   uint32_t len)
+{
+	struct no_os_spi_seq *sequence;
+	int32_t ret;
+	uint32_t i;
+
+	if (!seq || !desc || !desc->platform_ops || !msgs || !len)
+		return -EINVAL;
+
+	for (i = 0; i < len; i++) {
+		if (!msgs[i].bytes_number)
+			return -EINVAL;
+
+		/* The write_and_read fallback works in place. */
+		if (!SPI_OPS(desc)->seq_run && !SPI_OPS(desc)->transfer &&
+		    (msgs[i].rx_buff != msgs[i].tx_buff || !msgs[i].tx_buff))
+			return -EINVAL;
+	}
+
+	sequence = no_os_calloc(1, sizeof(*sequence));
+	if (!sequence)
+		return -ENOMEM;
+
+	sequence->desc = desc;
+	sequence->msgs = msgs;
+	sequence->len = len;
+
+	if (SPI_OPS(desc)->seq_prepare) {
+		ret = SPI_OPS(desc)->seq_prepare(sequence);
+		if (ret) {
+			no_os_free(sequence);
+			return ret;
+		}
+	}
+
+	*seq = sequence;
+
+	return 0;
+}
+
+/**
+ * @brief Replay a sequence of messages and wait until all of them are done.
+ * @param seq - The sequence.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_seq_run(struct no_os_spi_seq *seq)
+{
+	int32_t ret;
+
+	if (!seq)
+		return -EINVAL;
+
+	if (!SPI_OPS(seq->desc)->seq_run)
+		return no_os_spi_transfer(seq->desc, seq->msgs, seq->len);
+
+	no_os_bus_lock(seq->desc->bus->mutex);
+	ret = SPI_OPS(seq->desc)->seq_run(seq, NULL, NULL);
+	no_os_bus_unlock(seq->desc->bus->mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Start replaying a sequence of messages. The function returns once the
+ * 	  first message is started and a callback is invoked when all of them are
+ * 	  done.
+ * @param seq - The sequence.
+ * @param callback - A function which will be called after all the messages are done.
+ * @param ctx - User specific data which should be passed to the callback function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_seq_run_async(struct no_os_spi_seq *seq,
+				void (*callback)(void *),
+				void *ctx)
+{
+	if (!seq || !callback)
+		return -EINVAL;
+
+	if (!SPI_OPS(seq->desc)->seq_run)
+		return -ENOSYS;
+
+	return SPI_OPS(seq->desc)->seq_run(seq, callback, ctx);
+}
+
+/**
+ * @brief Free the resources allocated by no_os_spi_seq_init().
+ * @param seq - The sequence.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_seq_remove(struct no_os_spi_seq *seq)
+{
+	int32_t ret;
+
+	if (!seq)
+		return -EINVAL;
+
+	if (SPI_OPS(seq->desc)->seq_release) {
+		ret = SPI_OPS(seq->desc)->seq_release(seq);
+		if (ret)
+			return ret;
+	}
+
+	no_os_free(seq);
+
+	return 0;
+}
+
+/**
+ * @brief Switch the device to the rate of a speed profile.
+ *
+ * The platform is only asked to change its dividers when the rate of the
+ * profile differs from the active one, so a driver may select the data profile
+ * before every read. Platforms without a set_speed op stay at max_speed_hz.
+ * @param desc - The SPI descriptor.
+ * @param speed - Speed profile to switch to.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_set_speed(struct no_os_spi_desc *desc,
+			    enum no_os_spi_speed speed)
+{
+	uint32_t speed_hz;
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	speed_hz = desc->config_speed_hz;
+	if (speed == NO_OS_SPI_SPEED_DATA && desc->data_speed_hz)
+		speed_hz = desc->data_speed_hz;
+
+	if (speed_hz == desc->max_speed_hz || !SPI_OPS(desc)->set_speed)
+		return 0;
+
+	ret = SPI_OPS(desc)->set_speed(desc, speed_hz);
+	if (ret)
+		return ret;
+
+	desc->max_speed_hz = speed_hz;
+
+	return 0;
+}
+
+/**
+ * @brief Rebuild data words received on several SDO lanes.
+ *
+ * The input holds, for every output word, one word per lane in lane order,
+ * each carrying the lane_bits bits clocked out on that lane. dst may be the
+ * same buffer as src.
+ * @param dst - Buffer for nb_words / nb_lanes rebuilt words.
+ * @param src - Buffer of nb_words lane words.
+ * @param nb_words - Number of lane words in src.
+ * @param nb_lanes - Number of lanes a data word is spread over.
+ * @param lane_bits - Number of bits of a data word carried by one lane.
+ * @param format - How the device spreads the data word over the lanes.
+ */
+void no_os_spi_lanes_deinterleave(uint32_t *dst, const uint32_t *src,
+				  uint32_t nb_words, uint8_t nb_lanes,
+				  uint8_t lane_bits,
+				  enum no_os_spi_lane_format format)
+{
+	uint32_t i, word, lane_word;
+	uint8_t lane, bit;
+
+	if (!dst || !src || !nb_lanes || !lane_bits)
+		return;
+
+	for (i = 0; i < nb_words / nb_lanes; i++, src += nb_lanes) {
+		word = 0;
+		if (format == NO_OS_SPI_LANES_WORD_SLICED) {
+			for (lane = 0; lane < nb_lanes; lane++)
+				word = (word << lane_bits) |
+				       (src[lane] & NO_OS_GENMASK(lane_bits - 1, 0));
+		} else {
+			for (bit = lane_bits; bit > 0; bit--) {
+				for (lane = 0; lane < nb_lanes; lane++) {
+					lane_word = src[lane] >> (bit - 1);
+					word = (word << 1) | (lane_word & 1);
+				}
+			}
+		}
+		dst[i] = word;
+	}
+}
@@ -40,15 +40,45 @@
 #include <inttypes.h>
 #include "no_os_uart.h"
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_util.h"
+#include "no_os_static_ops.h"
+
+/* Platform ops of a descriptor, fixed when named in no_os_platform_config.h */
+#ifdef NO_OS_UART_PLATFORM_OPS
+#define UART_OPS(desc)	(&NO_OS_UART_PLATFORM_OPS)
+#define UART_OPS_VALID(ops)	((ops) == &NO_OS_UART_PLATFORM_OPS)
+#else
+#define UART_OPS(desc)	((desc)->platform_ops)
+#define UART_OPS_VALID(ops)	((ops) != NULL)
+#endif
 
 /**
  * @brief - UART mutex
 */
 static void *uart_mutex_table[UART_MAX_NUMBER + 1];
 
+/**
+ * @brief Buffered stdout, one producer (the stdio writes) and one consumer
+ * (no_os_uart_stdio_poll(), also called from the TX done interrupt).
+ */
+static struct {
+	struct no_os_uart_desc *desc;
+	uint8_t *buf;
+	uint32_t size;
+	enum no_os_uart_stdio_overflow overflow;
+	/** Next byte written by the producer */
+	volatile uint32_t head;
+	/** Next byte to be sent */
+	volatile uint32_t tail;
+	/** Set while a poll runs, a nested poll only asks for another pass */
+	volatile bool draining;
+	volatile bool drain_again;
+	uint32_t dropped;
+} uart_stdio_buf;
+
 /**
  * @brief Initialize the UART communication peripheral.
  * @param desc - The UART descriptor.
@@ -60,7 +90,7 @@ int32_t no_os_uart_init(struct no_os_uart_desc **desc,
 {
 	int32_t ret;
 
-	if (!param || !param->platform_ops
+	if (!param || !UART_OPS_VALID(param->platform_ops)
 	    || param->device_id >= NO_OS_ARRAY_SIZE(uart_mutex_table))
 		return -EINVAL;
 
@@ -89,13 +119,13 @@ int32_t no_os_uart_remove(struct no_os_uart_desc *desc)
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->remove)
+	if (!UART_OPS(desc)->remove)
 		return -ENOSYS;
 
 	no_os_mutex_remove(desc->mutex);
 	uart_mutex_table[desc->device_id] = NULL;
 
-	return desc->platform_ops->remove(desc);
+	return UART_OPS(desc)->remove(desc);
 }
 
 /**
@@ -108,10 +138,10 @@ uint32_t no_os_uart_get_errors(struct no_os_uart_desc *desc)
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->get_errors)
+	if (!UART_OPS(desc)->get_errors)
 		return -ENOSYS;
 
-	return desc->platform_ops->get_errors(desc);
+	return UART_OPS(desc)->get_errors(desc);
 }
 
 /**
@@ -130,12 +160,12 @@ int32_t no_os_uart_read(struct no_os_uart_desc *desc,
 	if (!desc || !desc->platform_ops || !data)
 		return -EINVAL;
 
-	if (!desc->platform_ops->read)
+	if (!UART_OPS(desc)->read)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->mutex);
-	ret = desc->platform_ops->read(desc, data, bytes_number);
-	no_os_mutex_unlock(desc->mutex);
+	no_os_bus_lock(desc->mutex);
+	ret = UART_OPS(desc)->read(desc, data, bytes_number);
+	no_os_bus_unlock(desc->mutex);
 
 	return ret;
 }
@@ -156,12 +186,12 @@ int32_t no_os_uart_write(struct no_os_uart_desc *desc,
 	if (!desc || !desc->platform_ops || !data)
 		return -EINVAL;
 
-	if (!desc->platform_ops->write)
+	if (!UART_OPS(desc)->write)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->mutex);
-	ret = desc->platform_ops->write(desc, data, bytes_number);
-	no_os_mutex_unlock(desc->mutex);
+	no_os_bus_lock(desc->mutex);
+	ret = UART_OPS(desc)->write(desc, data, bytes_number);
+	no_os_bus_unlock(desc->mutex);
 
 	return ret;
 }
@@ -182,12 +212,12 @@ int32_t no_os_uart_read_nonblocking(struct no_os_uart_desc *desc,
 	if (!desc || !desc->platform_ops || !data)
 		return -EINVAL;
 
-	if (!desc->platform_ops->read_nonblocking)
+	if (!UART_OPS(desc)->read_nonblocking)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->mutex);
-	ret = desc->platform_ops->read_nonblocking(desc, data, bytes_number);
-	no_os_mutex_unlock(desc->mutex);
+	no_os_bus_lock(desc->mutex);
+	ret = UART_OPS(desc)->read_nonblocking(desc, data, bytes_number);
+	no_os_bus_unlock(desc->mutex);
 
 	return ret;
 }
@@ -208,12 +238,12 @@ int32_t no_os_uart_write_nonblocking(struct no_os_uart_desc *desc,
 	if (!desc || !desc->platform_ops || !data)
 		return -EINVAL;
 
-	if (!desc->platform_ops->write_nonblocking)
+	if (!UART_OPS(desc)->write_nonblocking)
 		return -ENOSYS;
 
-	no_os_mutex_lock(desc->mutex);
-	ret = desc->platform_ops->write_nonblocking(desc, data, bytes_number);
-	no_os_mutex_unlock(desc->mutex);
+	no_os_bus_lock(desc->mutex);
+	ret = UART_OPS(desc)->write_nonblocking(desc, data, bytes_number);
+	no_os_bus_unlock(desc->mutex);
 
 	return ret;
 }
@@ -224,3 +254,189 @@ void __attribute__((weak)) no_os_uart_stdio(struct no_os_uart_desc *desc)
 	/* This can optionally be implemented under drivers/platform.
 	 * It does nothing if unimplemented. */
 }
+
+/**
+ * @brief Buffer the stdout written to a UART, a printf() returns once its
+ * text is copied in the buffer.
+ *
+ * The buffer is sent with the write_nonblocking op of the UART, which must
+ * copy the data and return the number of bytes queued, or -EBUSY while the
+ * previous transfer runs (stm32 with DMA TX). The next part is sent by the
+ * following write or no_os_uart_stdio_poll(), which the UART driver calls
+ * from its TX done interrupt when it has one.
+ * @param desc - The UART set with no_os_uart_stdio().
+ * @param buf - Buffer of the pending output, NULL to write synchronously.
+ * @param size - Size of buf, size - 1 bytes can be pending.
+ * @param overflow - What a write does when the buffer is full.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_uart_stdio_buffered(struct no_os_uart_desc *desc, uint8_t *buf,
+				  uint32_t size,
+				  enum no_os_uart_stdio_overflow overflow)
+{
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops || (buf && size < 2))
+		return -EINVAL;
+
+	if (buf && !UART_OPS(desc)->write_nonblocking)
+		return -ENOSYS;
+
+	/* The output buffered so far is sent before it changes */
+	ret = no_os_uart_stdio_flush();
+	if (ret)
+		return ret;
+
+	uart_stdio_buf.buf = NULL;
+	uart_stdio_buf.desc = desc;
+	uart_stdio_buf.size = size;
+	uart_stdio_buf.overflow = overflow;
+	uart_stdio_buf.head = 0;
+	uart_stdio_buf.tail = 0;
+	uart_stdio_buf.dropped = 0;
+	uart_stdio_buf.buf = buf;
+
+	return 0;
+}
+
+/**
+ * @brief Start sending the buffered stdout. Called from the TX done interrupt
+ * of the UART or periodically, it only queues data, it doesn't wait.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_uart_stdio_poll(void)
+{
+	struct no_os_uart_desc *desc = uart_stdio_buf.desc;
+	uint32_t head, tail, len;
+	int32_t ret = 0;
+
+	if (!uart_stdio_buf.buf)
+		return 0;
+
+again:
+	if (uart_stdio_buf.draining) {
+		uart_stdio_buf.drain_again = true;
+		return 0;
+	}
+	uart_stdio_buf.draining = true;
+
+	while (true) {
+		uart_stdio_buf.drain_again = false;
+		head = uart_stdio_buf.head;
+		tail = uart_stdio_buf.tail;
+		if (head == tail)
+			break;
+
+		len = (head > tail ? head : uart_stdio_buf.size) - tail;
+		ret = UART_OPS(desc)->write_nonblocking(desc,
+							uart_stdio_buf.buf + tail, len);
+		if (ret > 0) {
+			uart_stdio_buf.tail = (tail + ret) % uart_stdio_buf.size;
+			continue;
+		}
+		if (ret && ret != -EBUSY)
+			break;
+
+		ret = 0;
+		/* The transfer may have ended during the call */
+		if (!uart_stdio_buf.drain_again)
+			break;
+	}
+
+	uart_stdio_buf.draining = false;
+	if (!ret && uart_stdio_buf.drain_again)
+		goto again;
+
+	return ret;
+}
+
+/**
+ * @brief Write stdout data, called by the platform _write(). The data is
+ * copied in the buffer set by no_os_uart_stdio_buffered() for this UART, and
+ * written synchronously otherwise.
+ * @param desc - The UART descriptor.
+ * @param data - The data.
+ * @param bytes_number - Number of bytes to write.
+ * @return bytes_number in case of success, dropped bytes included, negative
+ * error code otherwise.
+ */
+int32_t no_os_uart_stdio_write(struct no_os_uart_desc *desc,
+			       const uint8_t *data, uint32_t bytes_number)
+{
+	uint32_t head, room;
+	uint32_t i = 0;
+	int32_t ret;
+
+	if (!uart_stdio_buf.buf || uart_stdio_buf.desc != desc)
+		return no_os_uart_write(desc, data, bytes_number);
+
+	while (i < bytes_number) {
+		head = uart_stdio_buf.head;
+		room = (uart_stdio_buf.tail + uart_stdio_buf.size - head - 1) %
+		       uart_stdio_buf.size;
+		if (!room) {
+			if (uart_stdio_buf.overflow == NO_OS_UART_STDIO_DROP) {
+				uart_stdio_buf.dropped += bytes_number - i;
+				break;
+			}
+
+			ret = no_os_uart_stdio_poll();
+			if (ret)
+				return ret;
+			continue;
+		}
+
+		room = no_os_min(room, uart_stdio_buf.size - head);
+		room = no_os_min(room, bytes_number - i);
+		memcpy(uart_stdio_buf.buf + head, data + i, room);
+		/* The data is in the buffer before the consumer can see it */
+		__sync_synchronize();
+		uart_stdio_buf.head = (head + room) % uart_stdio_buf.size;
+		i += room;
+	}
+
+	ret = no_os_uart_stdio_poll();
+	if (ret)
+		return ret;
+
+	return bytes_number;
+}
+
+/**
+ * @brief Send all the buffered stdout with blocking writes, e.g. from a fault
+ * handler before a reset. Interrupts are not needed unless the blocking write
+ * of the UART relies on them.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_uart_stdio_flush(void)
+{
+	struct no_os_uart_desc *desc = uart_stdio_buf.desc;
+	uint32_t head, tail, len;
+	int32_t ret;
+
+	if (!uart_stdio_buf.buf)
+		return 0;
+
+	while (true) {
+		head = uart_stdio_buf.head;
+		tail = uart_stdio_buf.tail;
+		if (head == tail)
+			return 0;
+
+		len = (head > tail ? head : uart_stdio_buf.size) - tail;
+		ret = UART_OPS(desc)->write(desc, uart_stdio_buf.buf + tail, len);
+		if (ret < 0)
+			return ret;
+
+		uart_stdio_buf.tail = (head > tail ? head : 0);
+	}
+}
+
+/**
+ * @brief Number of stdout bytes dropped because the buffer was full.
+ * @return The number of bytes dropped since no_os_uart_stdio_buffered().
+ */
+uint32_t no_os_uart_stdio_dropped(void)
+{
+	return uart_stdio_buf.dropped;
+}
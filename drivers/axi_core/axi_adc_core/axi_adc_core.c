@@ -62,7 +62,7 @@ int32_t axi_adc_read(struct axi_adc *adc,
 		     uint32_t reg_addr,
 		     uint32_t *reg_data)
 {
-	no_os_axi_io_read(adc->base, reg_addr, reg_data);
+	*reg_data = no_os_axi_io_read32(adc->base, reg_addr);
 
 	return 0;
 }
@@ -78,7 +78,7 @@ int32_t axi_adc_write(struct axi_adc *adc,
 		      uint32_t reg_addr,
 		      uint32_t reg_data)
 {
-	no_os_axi_io_write(adc->base, reg_addr, reg_data);
+	no_os_axi_io_write32(adc->base, reg_addr, reg_data);
 
 	return 0;
 }
@@ -53,6 +53,7 @@
 #define AXI_ADC_RSTN			NO_OS_BIT(0)
 
 #define AXI_ADC_REG_CNTRL		0x0044
+#define AXI_ADC_SYNC			NO_OS_BIT(3)
 #define AXI_ADC_R1_MODE			NO_OS_BIT(2)
 #define AXI_ADC_DDR_EDGESEL		NO_OS_BIT(1)
 #define AXI_ADC_PIN_MODE		NO_OS_BIT(0)
@@ -82,6 +83,9 @@
 #define ADC_DELAY_WDATA(x)		(((x) & 0x1F) << 0)
 #define ADC_TO_DELAY_WDATA(x)		(((x) >> 0) & 0x1F)
 
+#define AXI_ADC_REG_SYNC_STATUS		0x0068
+#define AXI_ADC_SYNC_STATUS		NO_OS_BIT(0)
+
 #define AXI_ADC_REG_CHAN_CNTRL(c)	(0x0400 + (c) * 0x40)
 #define AXI_ADC_PN_SEL			NO_OS_BIT(10)
 #define AXI_ADC_IQCOR_ENB		NO_OS_BIT(9)
@@ -0,0 +1,288 @@
+/***************************************************************************//**
+ *   @file   axi_adc_mcs.c
+ *   @brief  Synchronized capture across several AXI ADC cores.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
+#include "jesd204.h"
+#include "axi_adc_mcs.h"
+
+/******************************************************************************/
+/************************** Functions Implementation **************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the multi-chip sync of a set of ADC cores.
+ * @param mcs - The multi-chip sync descriptor.
+ * @param init - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_adc_mcs_init(struct axi_adc_mcs **mcs,
+			 const struct axi_adc_mcs_init *init)
+{
+	struct axi_adc_mcs *desc;
+
+	if (!mcs || !init || !init->adcs || !init->dmacs || !init->nb_devs)
+		return -EINVAL;
+
+	if (!init->jdev && !init->trigger)
+		return -EINVAL;
+
+	desc = no_os_calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->offsets = no_os_calloc(init->nb_devs, sizeof(*desc->offsets));
+	if (!desc->offsets) {
+		no_os_free(desc);
+		return -ENOMEM;
+	}
+
+	desc->adcs = init->adcs;
+	desc->group.dmacs = init->dmacs;
+	desc->group.nb_dmacs = init->nb_devs;
+	desc->jdev = init->jdev;
+	desc->trigger = init->trigger;
+	desc->trigger_ctx = init->trigger_ctx;
+	desc->timeout_ms = init->timeout_ms ? init->timeout_ms : 1000;
+
+	*mcs = desc;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by axi_adc_mcs_init().
+ * @param mcs - The multi-chip sync descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_adc_mcs_remove(struct axi_adc_mcs *mcs)
+{
+	if (!mcs)
+		return -EINVAL;
+
+	no_os_free(mcs->offsets);
+	no_os_free(mcs);
+
+	return 0;
+}
+
+/**
+ * @brief Arm the external sync of every ADC core. The cores hold their data
+ *        until the next SYSREF or trigger.
+ * @param mcs - The multi-chip sync descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t axi_adc_mcs_arm(struct axi_adc_mcs *mcs)
+{
+	uint32_t reg, i;
+	int32_t ret;
+
+	for (i = 0; i < mcs->group.nb_dmacs; i++) {
+		ret = axi_adc_read(mcs->adcs[i], AXI_ADC_REG_CNTRL, &reg);
+		if (ret)
+			return ret;
+
+		ret = axi_adc_write(mcs->adcs[i], AXI_ADC_REG_CNTRL,
+				    reg | AXI_ADC_SYNC);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Wait for all the ADC cores to see the sync event.
+ * @param mcs - The multi-chip sync descriptor.
+ * @return 0 in case of success, -ETIMEDOUT if a core is still armed.
+ */
+static int32_t axi_adc_mcs_wait_sync(struct axi_adc_mcs *mcs)
+{
+	uint32_t timeout = mcs->timeout_ms;
+	uint32_t reg, i;
+	int32_t ret;
+
+	for (i = 0; i < mcs->group.nb_dmacs; i++) {
+		while (true) {
+			ret = axi_adc_read(mcs->adcs[i], AXI_ADC_REG_SYNC_STATUS,
+					   &reg);
+			if (ret)
+				return ret;
+
+			if (!(reg & AXI_ADC_SYNC_STATUS))
+				break;
+
+			if (!timeout--)
+				return -ETIMEDOUT;
+
+			no_os_mdelay(1);
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Capture on all the ADC cores, starting on the same sample. The cores
+ *        are armed, the DMAs started, then a single SYSREF (or the trigger
+ *        callback) releases all of them at once.
+ * @param mcs - The multi-chip sync descriptor.
+ * @param transfers - One transfer for each ADC core, in order.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_adc_mcs_capture(struct axi_adc_mcs *mcs,
+			    struct axi_dma_transfer **transfers)
+{
+	uint32_t i;
+	int32_t ret;
+
+	if (!mcs || !transfers)
+		return -EINVAL;
+
+	ret = axi_adc_mcs_arm(mcs);
+	if (ret)
+		return ret;
+
+	ret = axi_dmac_group_start(&mcs->group, transfers);
+	if (ret)
+		return ret;
+
+	if (mcs->jdev)
+		ret = jesd204_sysref_async(mcs->jdev);
+	else
+		ret = mcs->trigger(mcs->trigger_ctx);
+	if (ret)
+		goto error;
+
+	ret = axi_adc_mcs_wait_sync(mcs);
+	if (ret)
+		goto error;
+
+	for (i = 0; i < mcs->group.nb_dmacs; i++) {
+		ret = axi_dmac_transfer_wait_completion(mcs->group.dmacs[i],
+							mcs->timeout_ms);
+		if (ret)
+			goto error;
+	}
+
+	return 0;
+
+error:
+	axi_dmac_group_stop(&mcs->group);
+
+	return ret;
+}
+
+/**
+ * @brief Measure the sample offset of each device against the first one, from
+ *        captures of a signal common to all of them. The offset is the lag
+ *        with the highest cross-correlation.
+ * @param mcs - The multi-chip sync descriptor.
+ * @param data - Captured samples of each device.
+ * @param nb_samples - Number of samples of the measured channel per device.
+ * @param stride - Distance, in samples, between two samples of the channel.
+ * @param max_lag - Largest offset searched, in samples.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_adc_mcs_measure(struct axi_adc_mcs *mcs, const int16_t **data,
+			    uint32_t nb_samples, uint32_t stride,
+			    uint32_t max_lag)
+{
+	int64_t corr, best_corr;
+	int32_t lag, best_lag;
+	uint32_t i, n, len;
+	const int16_t *ref, *buf;
+
+	if (!mcs || !data || !stride || max_lag >= nb_samples)
+		return -EINVAL;
+
+	ref = data[0];
+	mcs->offsets[0] = 0;
+	for (i = 1; i < mcs->group.nb_dmacs; i++) {
+		buf = data[i];
+		best_corr = INT64_MIN;
+		best_lag = 0;
+		for (lag = -(int32_t)max_lag; lag <= (int32_t)max_lag; lag++) {
+			len = nb_samples - (lag < 0 ? -lag : lag);
+			corr = 0;
+			for (n = 0; n < len; n++) {
+				if (lag >= 0)
+					corr += (int32_t)ref[n * stride] *
+						buf[(n + lag) * stride];
+				else
+					corr += (int32_t)ref[(n - lag) * stride] *
+						buf[n * stride];
+			}
+
+			/* Compare the mean, the overlap shrinks with the lag. */
+			corr /= len;
+			if (corr > best_corr) {
+				best_corr = corr;
+				best_lag = lag;
+			}
+		}
+
+		mcs->offsets[i] = best_lag;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the offset measured by axi_adc_mcs_measure().
+ * @param mcs - The multi-chip sync descriptor.
+ * @param dev - Index of the device.
+ * @param offset - Number of samples the device is behind the first one, a
+ *                 negative value if it is ahead.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_adc_mcs_get_offset(struct axi_adc_mcs *mcs, uint32_t dev,
+			       int32_t *offset)
+{
+	if (!mcs || !offset || dev >= mcs->group.nb_dmacs)
+		return -EINVAL;
+
+	*offset = mcs->offsets[dev];
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+/***************************************************************************//**
+ *   @file   axi_adc_mcs.h
+ *   @brief  Synchronized capture across several AXI ADC cores.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef AXI_ADC_MCS_H_
+#define AXI_ADC_MCS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "axi_adc_core.h"
+#include "axi_dmac.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+struct jesd204_dev;
+
+/**
+ * @struct axi_adc_mcs_init
+ * @brief Multi-chip sync initialization parameters.
+ */
+struct axi_adc_mcs_init {
+	/** ADC cores, the first one is the alignment reference */
+	struct axi_adc **adcs;
+	/** DMAC of each ADC core */
+	struct axi_dmac **dmacs;
+	/** Number of ADC cores */
+	uint32_t nb_devs;
+	/** Top device of the JESD204 topology, used to issue the SYSREF */
+	struct jesd204_dev *jdev;
+	/** Trigger used instead of the SYSREF when jdev is NULL */
+	int32_t (*trigger)(void *ctx);
+	void *trigger_ctx;
+	/** Timeout of the trigger and of the captures, in ms */
+	uint32_t timeout_ms;
+};
+
+/**
+ * @struct axi_adc_mcs
+ * @brief Multi-chip sync descriptor.
+ */
+struct axi_adc_mcs {
+	struct axi_adc **adcs;
+	struct axi_dmac_group group;
+	struct jesd204_dev *jdev;
+	int32_t (*trigger)(void *ctx);
+	void *trigger_ctx;
+	uint32_t timeout_ms;
+	/** Sample offset of each device against the first one */
+	int32_t *offsets;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+int32_t axi_adc_mcs_init(struct axi_adc_mcs **mcs,
+			 const struct axi_adc_mcs_init *init);
+int32_t axi_adc_mcs_remove(struct axi_adc_mcs *mcs);
+int32_t axi_adc_mcs_capture(struct axi_adc_mcs *mcs,
+			    struct axi_dma_transfer **transfers);
+int32_t axi_adc_mcs_measure(struct axi_adc_mcs *mcs, const int16_t **data,
+			    uint32_t nb_samples, uint32_t stride,
+			    uint32_t max_lag);
+int32_t axi_adc_mcs_get_offset(struct axi_adc_mcs *mcs, uint32_t dev,
+			       int32_t *offset);
+
+#endif
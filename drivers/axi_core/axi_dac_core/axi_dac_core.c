@@ -348,7 +348,7 @@ int32_t axi_dac_read(struct axi_dac *dac,
 		     uint32_t reg_addr,
 		     uint32_t *reg_data)
 {
-	no_os_axi_io_read(dac->base, reg_addr, reg_data);
+	*reg_data = no_os_axi_io_read32(dac->base, reg_addr);
 
 	return 0;
 }
@@ -364,7 +364,7 @@ int32_t axi_dac_write(struct axi_dac *dac,
 		      uint32_t reg_addr,
 		      uint32_t reg_data)
 {
-	no_os_axi_io_write(dac->base, reg_addr, reg_data);
+	no_os_axi_io_write32(dac->base, reg_addr, reg_data);
 
 	return 0;
 }
@@ -783,7 +783,7 @@ uint32_t axi_dac_set_sine_lut(struct axi_dac *dac,
 			data_i1 = (sine_lut[index_i1 / 2] << 20);
 			data_q1 = (sine_lut[index_q1 / 2] << 4);
 
-			no_os_axi_io_write(address, index_mem * 4, data_i1 | data_q1);
+			no_os_axi_io_write32(address, index_mem * 4, data_i1 | data_q1);
 
 			index_i2 = index_i1;
 			index_q2 = index_q1;
@@ -794,7 +794,7 @@ uint32_t axi_dac_set_sine_lut(struct axi_dac *dac,
 			data_i2 = (sine_lut[index_i2 / 2] << 20);
 			data_q2 = (sine_lut[index_q2 / 2] << 4);
 
-			no_os_axi_io_write(address, (index_mem + 1) * 4, data_i2 | data_q2);
+			no_os_axi_io_write32(address, (index_mem + 1) * 4, data_i2 | data_q2);
 
 		}
 	} else {
@@ -806,7 +806,7 @@ uint32_t axi_dac_set_sine_lut(struct axi_dac *dac,
 			data_i1 = (sine_lut[index_i1] << 20);
 			data_q1 = (sine_lut[index_q1] << 4);
 
-			no_os_axi_io_write(address, index * 4, data_i1 | data_q1);
+			no_os_axi_io_write32(address, index * 4, data_i1 | data_q1);
 		}
 	}
 
@@ -835,7 +835,7 @@ int32_t axi_dac_set_buff(struct axi_dac *dac,
 		data_i = (buff[index]);
 		data_q = (buff[index + 1] << 16);
 
-		no_os_axi_io_write(address, index * 2, data_i | data_q);
+		no_os_axi_io_write32(address, index * 2, data_i | data_q);
 	}
 
 	return 0;
@@ -862,7 +862,7 @@ int32_t axi_dac_load_custom_data(struct axi_dac *dac,
 		/* Send the same data on all the channels */
 		for (chan = 0; chan < num_tx_channels; chan++) {
 
-			no_os_axi_io_write(address, index_mem * sizeof(uint32_t),
+			no_os_axi_io_write32(address, index_mem * sizeof(uint32_t),
 					   custom_data_iq[index]);
 
 			index_mem++;
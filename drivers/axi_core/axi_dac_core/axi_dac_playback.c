@@ -0,0 +1,314 @@
+/***************************************************************************//**
+ *   @file   axi_dac_playback.c
+ *   @brief  Waveform playback scheduler for the AXI DAC cores.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "no_os_util.h"
+#include "axi_dac_playback.h"
+
+/******************************************************************************/
+/************************** Functions Implementation **************************/
+/******************************************************************************/
+
+/**
+ * @brief Pick the waveform of the next DMA buffer. A finite segment is played
+ *        its number of times, a cyclic one until another segment is scheduled.
+ * @param playback - The playback descriptor.
+ * @return The waveform, NULL if the schedule is over.
+ */
+static struct axi_dac_waveform *
+axi_dac_playback_next(struct axi_dac_playback *playback)
+{
+	struct axi_dac_segment *seg;
+
+	if (!playback->cyclic && playback->left) {
+		playback->left--;
+	} else if (playback->head != playback->tail) {
+		seg = &playback->queue[playback->tail];
+		playback->current = seg->waveform;
+		playback->cyclic = !seg->repeat;
+		playback->left = seg->repeat ? seg->repeat - 1 : 0;
+		playback->tail = (playback->tail + 1) % AXI_DAC_PLAYBACK_QUEUE_LEN;
+	} else if (!playback->cyclic) {
+		return NULL;
+	}
+
+	return &playback->waveforms[playback->current];
+}
+
+/**
+ * @brief Hand the next buffer of the schedule to the DMAC.
+ * @param playback - The playback descriptor.
+ * @return 0 in case of success, -ENODATA if the schedule is over, negative
+ *         error code otherwise.
+ */
+static int32_t axi_dac_playback_issue(struct axi_dac_playback *playback)
+{
+	struct axi_dac_waveform *wf;
+	struct axi_dma_transfer transfer = {
+		.cyclic = NO,
+	};
+
+	wf = axi_dac_playback_next(playback);
+	if (!wf)
+		return -ENODATA;
+
+	transfer.size = wf->size;
+	transfer.src_addr = wf->addr;
+
+	return axi_dmac_transfer_queue(playback->dmac, &transfer);
+}
+
+/**
+ * @brief DMAC callback, keeps one buffer queued behind the running one so that
+ *        consecutive buffers play without a gap.
+ * @param ctx - The playback descriptor.
+ */
+static void axi_dac_playback_block_done(void *ctx)
+{
+	struct axi_dac_playback *playback = ctx;
+	bool starved;
+
+	if (!playback->running || playback->dmac->next_queued)
+		return;
+
+	starved = !playback->dmac->active;
+	if (!axi_dac_playback_issue(playback) && starved)
+		playback->underruns++;
+}
+
+/**
+ * @brief Initialize the playback scheduler.
+ * @param playback - The playback descriptor.
+ * @param init - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_dac_playback_init(struct axi_dac_playback **playback,
+			      const struct axi_dac_playback_init *init)
+{
+	struct axi_dac_playback *pb;
+
+	if (!playback || !init || !init->dmac || !init->ddr_size)
+		return -EINVAL;
+
+	if (init->dmac->irq_option != IRQ_ENABLED ||
+	    init->dmac->direction != DMA_MEM_TO_DEV)
+		return -ENOTSUP;
+
+	pb = no_os_calloc(1, sizeof(*pb));
+	if (!pb)
+		return -ENOMEM;
+
+	pb->dac = init->dac;
+	pb->dmac = init->dmac;
+	pb->ddr_base = init->ddr_base;
+	pb->ddr_size = init->ddr_size;
+	pb->dcache_flush_range = init->dcache_flush_range;
+
+	*playback = pb;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the playback and free the scheduler. The DDR region is left
+ *        untouched.
+ * @param playback - The playback descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_dac_playback_remove(struct axi_dac_playback *playback)
+{
+	if (!playback)
+		return -EINVAL;
+
+	axi_dac_playback_stop(playback);
+	no_os_free(playback);
+
+	return 0;
+}
+
+/**
+ * @brief Copy a waveform into the DDR region of the library.
+ * @param playback - The playback descriptor.
+ * @param samples - Samples, in the layout expected by the DAC core.
+ * @param size - Size in bytes.
+ * @param waveform - Index of the waveform, used to schedule it.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_dac_playback_add(struct axi_dac_playback *playback,
+			     const void *samples, uint32_t size,
+			     uint32_t *waveform)
+{
+	struct axi_dac_waveform *wf;
+	uint32_t offset;
+
+	if (!playback || !samples || !size || !waveform)
+		return -EINVAL;
+
+	if (playback->num_waveforms == AXI_DAC_PLAYBACK_MAX_WAVEFORMS)
+		return -ENOMEM;
+
+	offset = no_os_align(playback->ddr_base + playback->ddr_used,
+			     AXI_DAC_PLAYBACK_ALIGN) - playback->ddr_base;
+	if (offset > playback->ddr_size || size > playback->ddr_size - offset)
+		return -ENOMEM;
+
+	wf = &playback->waveforms[playback->num_waveforms];
+	wf->addr = playback->ddr_base + offset;
+	wf->size = size;
+
+	memcpy((void *)(uintptr_t)wf->addr, samples, size);
+	if (playback->dcache_flush_range)
+		playback->dcache_flush_range(wf->addr, size);
+
+	playback->ddr_used = offset + size;
+	*waveform = playback->num_waveforms++;
+
+	return 0;
+}
+
+/**
+ * @brief Append a segment to the schedule. It starts once the previous
+ *        finite segment is done or, after a cyclic one, at the next buffer
+ *        boundary following the buffer already queued on the DMAC.
+ * @param playback - The playback descriptor.
+ * @param waveform - Waveform index returned by axi_dac_playback_add().
+ * @param repeat - Number of plays, 0 to play it until the next segment.
+ * @return 0 in case of success, -EBUSY if the schedule is full, negative error
+ *         code otherwise.
+ */
+int32_t axi_dac_playback_schedule(struct axi_dac_playback *playback,
+				  uint32_t waveform, uint32_t repeat)
+{
+	uint32_t head, flags;
+	int32_t ret = 0;
+
+	if (!playback || waveform >= playback->num_waveforms)
+		return -EINVAL;
+
+	head = (playback->head + 1) % AXI_DAC_PLAYBACK_QUEUE_LEN;
+	if (head == playback->tail)
+		return -EBUSY;
+
+	playback->queue[playback->head].waveform = waveform;
+	playback->queue[playback->head].repeat = repeat;
+	playback->head = head;
+
+	/* Restart a playback that ran out of segments. */
+	flags = no_os_critical_enter();
+	if (playback->running && !playback->dmac->active) {
+		ret = axi_dac_playback_issue(playback);
+		if (!ret)
+			ret = axi_dac_playback_issue(playback);
+		if (ret == -ENODATA)
+			ret = 0;
+	}
+	no_os_critical_exit(flags);
+
+	return ret;
+}
+
+/**
+ * @brief Start playing the schedule.
+ * @param playback - The playback descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_dac_playback_start(struct axi_dac_playback *playback)
+{
+	int32_t ret;
+
+	if (!playback)
+		return -EINVAL;
+
+	if (playback->running)
+		return -EBUSY;
+
+	if (playback->dac) {
+		ret = axi_dac_set_datasel(playback->dac, -1, AXI_DAC_DATA_SEL_DMA);
+		if (ret)
+			return ret;
+	}
+
+	playback->underruns = 0;
+	axi_dmac_set_block_callback(playback->dmac, axi_dac_playback_block_done,
+				    playback);
+	playback->running = true;
+
+	/* Start the first buffer and queue the second one behind it. */
+	ret = axi_dac_playback_issue(playback);
+	if (!ret)
+		ret = axi_dac_playback_issue(playback);
+	if (ret && ret != -ENODATA) {
+		axi_dac_playback_stop(playback);
+		return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Stop the playback. Segments not started yet stay scheduled.
+ * @param playback - The playback descriptor.
+ */
+void axi_dac_playback_stop(struct axi_dac_playback *playback)
+{
+	if (!playback)
+		return;
+
+	playback->running = false;
+	axi_dmac_set_block_callback(playback->dmac, NULL, NULL);
+	axi_dmac_transfer_stop(playback->dmac);
+	playback->cyclic = false;
+	playback->left = 0;
+}
+
+/**
+ * @brief Check if the schedule played to its end.
+ * @param playback - The playback descriptor.
+ * @return true when the DMAC has nothing left to play.
+ */
+bool axi_dac_playback_idle(struct axi_dac_playback *playback)
+{
+	return !playback->dmac->active && !playback->dmac->next_queued &&
+	       playback->head == playback->tail;
+}
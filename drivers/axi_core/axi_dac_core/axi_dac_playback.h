@@ -0,0 +1,144 @@
+/***************************************************************************//**
+ *   @file   axi_dac_playback.h
+ *   @brief  Waveform playback scheduler for the AXI DAC cores.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef AXI_DAC_PLAYBACK_H_
+#define AXI_DAC_PLAYBACK_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "axi_dac_core.h"
+#include "axi_dmac.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define AXI_DAC_PLAYBACK_MAX_WAVEFORMS	32
+#define AXI_DAC_PLAYBACK_QUEUE_LEN	32
+/* Waveforms are placed in DDR on this boundary */
+#define AXI_DAC_PLAYBACK_ALIGN		64
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct axi_dac_waveform
+ * @brief Waveform of the library, held in DDR.
+ */
+struct axi_dac_waveform {
+	/** DDR address of the samples */
+	uint32_t addr;
+	/** Size in bytes */
+	uint32_t size;
+};
+
+/**
+ * @struct axi_dac_segment
+ * @brief Entry of the playback schedule.
+ */
+struct axi_dac_segment {
+	/** Waveform index returned by axi_dac_playback_add() */
+	uint32_t waveform;
+	/** Number of times the waveform is played, 0 to play it cyclically until
+	 *  the next segment is scheduled */
+	uint32_t repeat;
+};
+
+/**
+ * @struct axi_dac_playback_init
+ * @brief Playback scheduler initialization parameters.
+ */
+struct axi_dac_playback_init {
+	/** DAC core switched to DMA data, may be NULL */
+	struct axi_dac *dac;
+	/** TX DMAC, must use IRQ_ENABLED */
+	struct axi_dmac *dmac;
+	/** DDR region of the waveform library */
+	uint32_t ddr_base;
+	/** Size in bytes of the DDR region */
+	uint32_t ddr_size;
+	/** Function pointer to flush the data cache for the given address range */
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+};
+
+/**
+ * @struct axi_dac_playback
+ * @brief Playback scheduler descriptor.
+ */
+struct axi_dac_playback {
+	struct axi_dac *dac;
+	struct axi_dmac *dmac;
+	uint32_t ddr_base;
+	uint32_t ddr_size;
+	/** Bytes of the DDR region taken by the library */
+	uint32_t ddr_used;
+	void (*dcache_flush_range)(uint32_t address, uint32_t bytes_count);
+	struct axi_dac_waveform waveforms[AXI_DAC_PLAYBACK_MAX_WAVEFORMS];
+	uint32_t num_waveforms;
+	/** Scheduled segments, written by the caller and read by the ISR */
+	struct axi_dac_segment queue[AXI_DAC_PLAYBACK_QUEUE_LEN];
+	volatile uint32_t head;
+	volatile uint32_t tail;
+	/** Waveform being handed to the DMAC */
+	uint32_t current;
+	/** Plays of the current waveform not handed to the DMAC yet */
+	uint32_t left;
+	/** Set while the current waveform repeats until the next segment */
+	bool cyclic;
+	volatile bool running;
+	/** Number of times the DMAC ran out of queued buffers */
+	volatile uint32_t underruns;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+int32_t axi_dac_playback_init(struct axi_dac_playback **playback,
+			      const struct axi_dac_playback_init *init);
+int32_t axi_dac_playback_remove(struct axi_dac_playback *playback);
+int32_t axi_dac_playback_add(struct axi_dac_playback *playback,
+			     const void *samples, uint32_t size,
+			     uint32_t *waveform);
+int32_t axi_dac_playback_schedule(struct axi_dac_playback *playback,
+				  uint32_t waveform, uint32_t repeat);
+int32_t axi_dac_playback_start(struct axi_dac_playback *playback);
+void axi_dac_playback_stop(struct axi_dac_playback *playback);
+bool axi_dac_playback_idle(struct axi_dac_playback *playback);
+
+#endif
@@ -48,8 +48,110 @@
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_mutex.h"
 #include "axi_dmac.h"
 
+/*******************************************************************************
+ * @brief Load the queued transfer and submit its first sub-transfer. Called
+ *			from the ISRs so that the next transfer starts without a gap.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_start_queued(struct axi_dmac *dmac)
+{
+	uint32_t burst_size;
+
+	dmac->transfer.size = dmac->next_transfer.size;
+	dmac->transfer.src_addr = dmac->next_transfer.src_addr;
+	dmac->transfer.dest_addr = dmac->next_transfer.dest_addr;
+	dmac->transfer.cyclic = NO;
+	dmac->remaining_size = dmac->next_transfer.size;
+	dmac->next_src_addr = dmac->next_transfer.src_addr;
+	dmac->next_dest_addr = dmac->next_transfer.dest_addr;
+	dmac->next_queued = false;
+
+	if (dmac->remaining_size > dmac->max_length)
+		burst_size = dmac->max_length;
+	else
+		burst_size = dmac->remaining_size - 1;
+
+	if (dmac->direction == DMA_DEV_TO_MEM) {
+		dmac->init_addr = dmac->next_dest_addr;
+		axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
+		dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
+	} else {
+		dmac->init_addr = dmac->next_src_addr;
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
+		dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
+	}
+
+	dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
+	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+	axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+}
+
+/*******************************************************************************
+ * @brief Send the buffer of the transfer just finished on the DMAC set by
+ *			axi_dmac_transfer_forward(), if any.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_forward(struct axi_dmac *dmac)
+{
+	struct axi_dma_transfer forward = {
+		.size = dmac->transfer.size,
+		.cyclic = dmac->forward_cyclic,
+		.src_addr = dmac->transfer.dest_addr,
+	};
+
+	if (dmac->forward_to)
+		axi_dmac_transfer_start(dmac->forward_to, &forward);
+}
+
+/*******************************************************************************
+ * @brief Notify the owner set by axi_dmac_set_block_callback(), if any, that a
+ *			transfer ended. It may queue the next one from the callback.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_block_done(struct axi_dmac *dmac)
+{
+	if (dmac->block_done_cb)
+		dmac->block_done_cb(dmac->block_done_ctx);
+}
+
+/*******************************************************************************
+ * @brief Handle the interrupt of a scatter-gather transfer. The DMAC walks the
+ *			descriptor chain by itself, so only completions are accounted.
+ *
+ * @param dmac - DMAC istance.
+ * @param reg_val - Pending interrupts.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_sg_isr(struct axi_dmac *dmac, uint32_t reg_val)
+{
+	if (!(reg_val & AXI_DMAC_IRQ_EOT))
+		return;
+
+	/* Each block raises EOT once its last descriptor is done. */
+	dmac->blocks_done++;
+	if (dmac->transfer.cyclic != CYCLIC) {
+		dmac->transfer.transfer_done = true;
+		dmac->sg_active = false;
+		dmac->active = false;
+	}
+}
+
 /*******************************************************************************
  * @brief ISR for dev to mem DMA transfer. It computes the next transfer params,
  *			if any, and sets the transfer structure fields accordingly.
@@ -61,6 +163,7 @@
 void axi_dmac_dev_to_mem_isr(void *instance)
 {
 	struct axi_dmac *dmac = (struct axi_dmac *)instance;
+	bool switched = dmac->switch_pending;
 	uint32_t burst_size;
 	uint32_t reg_val;
 
@@ -68,6 +171,11 @@ void axi_dmac_dev_to_mem_isr(void *instance)
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
+	if (dmac->sg_active) {
+		axi_dmac_sg_isr(dmac, reg_val);
+		return;
+	}
+
 	if (reg_val & AXI_DMAC_IRQ_SOT) {
 		if (dmac->remaining_size) {
 			/* See if remaining size is bigger than max transfer size and
@@ -91,12 +199,29 @@ void axi_dmac_dev_to_mem_isr(void *instance)
 
 			/* Trigger the next transfer. */
 			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+		} else if (dmac->next_queued && !dmac->switch_pending) {
+			/* Last sub-transfer started; queue the next transfer. */
+			axi_dmac_start_queued(dmac);
+			dmac->switch_pending = true;
 		}
 	}
 	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if (!dmac->remaining_size) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_dest_addr = 0;
+		if (switched) {
+			/* The transfer before the queued one is done. */
+			dmac->switch_pending = false;
+			dmac->blocks_done++;
+			axi_dmac_block_done(dmac);
+		} else if (!dmac->remaining_size) {
+			dmac->blocks_done++;
+			if (dmac->next_queued) {
+				axi_dmac_start_queued(dmac);
+			} else {
+				dmac->transfer.transfer_done = true;
+				dmac->active = false;
+				dmac->next_dest_addr = 0;
+				axi_dmac_forward(dmac);
+			}
+			axi_dmac_block_done(dmac);
 		}
 	}
 }
@@ -112,6 +237,7 @@ void axi_dmac_dev_to_mem_isr(void *instance)
 void axi_dmac_mem_to_dev_isr(void *instance)
 {
 	struct axi_dmac *dmac = (struct axi_dmac *)instance;
+	bool switched = dmac->switch_pending;
 	uint32_t burst_size;
 	uint32_t reg_val;
 
@@ -119,6 +245,11 @@ void axi_dmac_mem_to_dev_isr(void *instance)
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
+	if (dmac->sg_active) {
+		axi_dmac_sg_isr(dmac, reg_val);
+		return;
+	}
+
 	if (reg_val & AXI_DMAC_IRQ_SOT) {
 		if ((dmac->transfer.cyclic == CYCLIC) &&
 		    (dmac->next_src_addr >= (dmac->init_addr + dmac->transfer.size - 1))) {
@@ -148,12 +279,28 @@ void axi_dmac_mem_to_dev_isr(void *instance)
 
 			/* Trigger the current transfer */
 			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+		} else if (dmac->next_queued && !dmac->switch_pending) {
+			/* Last sub-transfer started; queue the next transfer. */
+			axi_dmac_start_queued(dmac);
+			dmac->switch_pending = true;
 		}
 	}
 	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if ((!dmac->remaining_size) && (dmac->transfer.cyclic != CYCLIC)) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_src_addr = 0;
+		if (switched) {
+			/* The transfer before the queued one is done. */
+			dmac->switch_pending = false;
+			dmac->blocks_done++;
+			axi_dmac_block_done(dmac);
+		} else if ((!dmac->remaining_size) && (dmac->transfer.cyclic != CYCLIC)) {
+			dmac->blocks_done++;
+			if (dmac->next_queued) {
+				axi_dmac_start_queued(dmac);
+			} else {
+				dmac->transfer.transfer_done = true;
+				dmac->active = false;
+				dmac->next_src_addr = 0;
+			}
+			axi_dmac_block_done(dmac);
 		}
 	}
 }
@@ -176,6 +323,11 @@ void axi_dmac_mem_to_mem_isr(void *instance)
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
+	if (dmac->sg_active) {
+		axi_dmac_sg_isr(dmac, reg_val);
+		return;
+	}
+
 	if (reg_val & AXI_DMAC_IRQ_SOT) {
 		if (dmac->remaining_size) {
 			/** See if remaining size is bigger than max transfer size and
@@ -213,6 +365,7 @@ void axi_dmac_mem_to_mem_isr(void *instance)
 		if (!dmac->remaining_size) {
 			if(dmac->next_src_addr > (dmac->init_addr + dmac->transfer.size)) {
 				dmac->transfer.transfer_done = true;
+				dmac->active = false;
 				dmac->next_src_addr = 0;
 				dmac->next_dest_addr = 0;
 			}
@@ -220,6 +373,46 @@ void axi_dmac_mem_to_mem_isr(void *instance)
 	}
 }
 
+/*******************************************************************************
+ * @brief Shared ISR for a group of DMACs wired to the same interrupt. It runs
+ *			the ISR matching the direction of each DMAC with pending
+ *			interrupts.
+ *
+ * @param instance - the axi_dmac_group that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_group_isr(void *instance)
+{
+	struct axi_dmac_group *group = (struct axi_dmac_group *)instance;
+	struct axi_dmac *dmac;
+	uint32_t reg_val;
+	uint32_t i;
+
+	for (i = 0; i < group->nb_dmacs; i++) {
+		dmac = group->dmacs[i];
+		axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+		if (!reg_val)
+			continue;
+
+		switch (dmac->direction) {
+		case DMA_DEV_TO_MEM:
+			axi_dmac_dev_to_mem_isr(dmac);
+			break;
+		case DMA_MEM_TO_DEV:
+			axi_dmac_mem_to_dev_isr(dmac);
+			break;
+		case DMA_MEM_TO_MEM:
+			axi_dmac_mem_to_mem_isr(dmac);
+			break;
+		default:
+			/* Unknown direction, only clear the interrupts. */
+			axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
+			break;
+		}
+	}
+}
+
 /*******************************************************************************
  * @brief Wrapper for AXI IO through UIO/devmem read function.
  *
@@ -233,7 +426,7 @@ int32_t axi_dmac_read(struct axi_dmac *dmac,
 		      uint32_t reg_addr,
 		      uint32_t *reg_data)
 {
-	no_os_axi_io_read(dmac->base, reg_addr, reg_data);
+	*reg_data = no_os_axi_io_read32(dmac->base, reg_addr);
 
 	return 0;
 }
@@ -251,7 +444,7 @@ int32_t axi_dmac_write(struct axi_dmac *dmac,
 		       uint32_t reg_addr,
 		       uint32_t reg_data)
 {
-	no_os_axi_io_write(dmac->base, reg_addr, reg_data);
+	no_os_axi_io_write32(dmac->base, reg_addr, reg_data);
 
 	return 0;
 }
@@ -298,6 +491,12 @@ static int32_t axi_dmac_detect_caps(struct axi_dmac *dmac)
 	/* Restore initial value for AXI_DMAC_REG_FLAGS register */
 	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, initial_reg_val);
 
+	/* Check if HW scatter-gather possible */
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0xffffffff);
+	axi_dmac_read(dmac, AXI_DMAC_REG_SG_ADDRESS, &reg_val);
+	dmac->hw_sg = reg_val != 0;
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0x0);
+
 	/* Get maximum burst size and set value. */
 	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, dmac->max_length);
 	axi_dmac_read(dmac, AXI_DMAC_REG_X_LENGTH, &dmac->max_length);
@@ -369,22 +568,171 @@ int32_t axi_dmac_remove(struct axi_dmac *dmac)
 }
 
 /*******************************************************************************
- * @brief Start a DMA transfer.
+ * @brief Build a hardware descriptor chain covering a list of segments.
+ *			Segments longer than the maximum transfer length are split over
+ *			several descriptors. If dma_transfer->cyclic is CYCLIC the chain is
+ *			closed into a ring and each segment is reported as one block, so
+ *			it can be waited for with axi_dmac_transfer_wait_block.
+ *
+ * @param dmac - DMAC istance.
+ * @param dma_transfer - Transfer to set up for axi_dmac_transfer_start.
+ * @param descs - Descriptor storage, visible to the DMAC.
+ * @param nb_descs - Number of descriptors in descs.
+ * @param segs - Segments to transfer, in order.
+ * @param nb_segs - Number of segments.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_sg_prepare(struct axi_dmac *dmac,
+			    struct axi_dma_transfer *dma_transfer,
+			    struct axi_dmac_sg_desc *descs, uint32_t nb_descs,
+			    const struct axi_dma_segment *segs, uint32_t nb_segs)
+{
+	struct axi_dmac_sg_desc *desc = descs;
+	uint32_t src_addr, dest_addr;
+	uint32_t remaining, len;
+	uint32_t total = 0;
+	uint32_t i;
+
+	if (!dmac || !dma_transfer || !descs || !segs || !nb_segs)
+		return -EINVAL;
+
+	if (!dmac->hw_sg)
+		return -ENOTSUP;
+
+	if ((uintptr_t)descs % sizeof(*descs))
+		return -EINVAL;
+
+	if (dma_transfer->cyclic == CYCLIC && dmac->irq_option != IRQ_ENABLED)
+		return -ENOTSUP;
+
+	for (i = 0; i < nb_segs; i++) {
+		if (!segs[i].size)
+			return -EINVAL;
+
+		remaining = segs[i].size;
+		src_addr = segs[i].src_addr;
+		dest_addr = segs[i].dest_addr;
+		while (remaining) {
+			if (desc == descs + nb_descs)
+				return -ENOSPC;
+
+			len = no_os_min(remaining - 1, dmac->max_length);
+
+			desc->flags = 0;
+			desc->id = desc - descs;
+			desc->src_addr = src_addr;
+			desc->dest_addr = dest_addr;
+			desc->x_len = len;
+			desc->y_len = 0;
+			desc->src_stride = 0;
+			desc->dest_stride = 0;
+			desc->next_sg_addr = (uintptr_t)(desc + 1);
+
+			if (dmac->direction != DMA_DEV_TO_MEM)
+				src_addr += len + 1;
+			if (dmac->direction != DMA_MEM_TO_DEV)
+				dest_addr += len + 1;
+			remaining -= len + 1;
+			desc++;
+		}
+
+		/* Report every block of a ring, a chain only once at its end. */
+		if (dma_transfer->cyclic == CYCLIC)
+			desc[-1].flags = AXI_DMAC_SG_FLAG_IRQ;
+		total += segs[i].size;
+	}
+
+	desc--;
+	if (dma_transfer->cyclic == CYCLIC)
+		desc->next_sg_addr = (uintptr_t)descs;
+	else
+		desc->flags = AXI_DMAC_SG_FLAG_LAST | AXI_DMAC_SG_FLAG_IRQ;
+
+	dma_transfer->size = total;
+	dma_transfer->src_addr = segs[0].src_addr;
+	dma_transfer->dest_addr = segs[0].dest_addr;
+	dma_transfer->sg_desc = descs;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Start a scatter-gather transfer prepared by axi_dmac_sg_prepare. The
+ *			DMAC fetches the whole chain without CPU involvement.
  *
  * @param dmac - DMAC istance.
  * @param dma_transfer - Structure containing transfer details.
  *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+static int32_t axi_dmac_sg_start(struct axi_dmac *dmac,
+				 struct axi_dma_transfer *dma_transfer, bool submit)
+{
+	uint64_t sg_addr = (uintptr_t)dma_transfer->sg_desc;
+	uint32_t reg_val;
+
+	if (!dmac->hw_sg)
+		return -ENOTSUP;
+
+	dmac->transfer.transfer_done = false;
+	dmac->transfer.size = dma_transfer->size;
+	dmac->transfer.cyclic = dma_transfer->cyclic;
+	dmac->transfer.src_addr = dma_transfer->src_addr;
+	dmac->transfer.dest_addr = dma_transfer->dest_addr;
+	dmac->next_queued = false;
+	dmac->switch_pending = false;
+	dmac->remaining_size = 0;
+
+	/* The ring is closed by the descriptors, not by the cyclic flag. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val & ~DMA_CYCLIC);
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
+	if (!(reg_val & AXI_DMAC_CTRL_ENABLE) || !(reg_val & AXI_DMAC_CTRL_ENABLE_SG)) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL,
+			       AXI_DMAC_CTRL_ENABLE | AXI_DMAC_CTRL_ENABLE_SG);
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+	}
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+	if (reg_val & AXI_DMAC_QUEUE_FULL)
+		return -EBUSY;
+
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, (uint32_t)sg_addr);
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS_HIGH, (uint32_t)(sg_addr >> 32));
+	dmac->sg_active = dmac->irq_option == IRQ_ENABLED;
+	dmac->active = true;
+	if (submit)
+		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Program a DMA transfer.
+ *
+ * @param dmac - DMAC istance.
+ * @param dma_transfer - Structure containing transfer details.
+ * @param submit - Whether to submit the transfer. If false, the caller has to
+ *			write AXI_DMAC_REG_TRANSFER_SUBMIT to start it.
+ *
  * @return 0 for success, -1 in case of failure.
 *******************************************************************************/
-int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
-				struct axi_dma_transfer *dma_transfer)
+static int32_t axi_dmac_transfer_load(struct axi_dmac *dmac,
+				      struct axi_dma_transfer *dma_transfer,
+				      bool submit)
 {
 	uint32_t reg_val, burst_size;
 
-	if (dma_transfer->size == 0)
-		return 0; /* Nothing to do. */
+	if (dma_transfer->sg_desc)
+		return axi_dmac_sg_start(dmac, dma_transfer, submit);
 
 	/* Set current transfer parameters. */
+	dmac->transfer.transfer_done = false;
+	dmac->next_queued = false;
+	dmac->switch_pending = false;
 	dmac->transfer.size = dma_transfer->size;
 	dmac->transfer.cyclic = dma_transfer->cyclic;
 	dmac->transfer.dest_addr = dma_transfer->dest_addr;
@@ -424,9 +772,9 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 		axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
 	}
 
-	/* Enable DMA if not already enabled. */
+	/* Enable DMA if not already enabled, leaving scatter-gather mode. */
 	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
-	if (!(reg_val & AXI_DMAC_CTRL_ENABLE)) {
+	if (!(reg_val & AXI_DMAC_CTRL_ENABLE) || (reg_val & AXI_DMAC_CTRL_ENABLE_SG)) {
 		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
 		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_ENABLE);
 		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
@@ -487,7 +835,10 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 		/* Specify the length of the transfer and trigger transfer. */
 		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
 		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+		dmac->active = true;
+		if (submit)
+			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT,
+				       AXI_DMAC_TRANSFER_SUBMIT);
 	} else {
 		return -1;
 	}
@@ -495,6 +846,214 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 	return 0;
 }
 
+/*******************************************************************************
+ * @brief Start a DMA transfer.
+ *
+ * @param dmac - DMAC istance.
+ * @param dma_transfer - Structure containing transfer details.
+ *
+ * @return 0 for success, -1 in case of failure.
+*******************************************************************************/
+int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
+				struct axi_dma_transfer *dma_transfer)
+{
+	if (dma_transfer->size == 0)
+		return 0; /* Nothing to do. */
+
+	return axi_dmac_transfer_load(dmac, dma_transfer, true);
+}
+
+/*******************************************************************************
+ * @brief Start one transfer on each DMAC of a group at the same time. All the
+ *			transfers are programmed first, then submitted back to back
+ *			with the interrupts disabled.
+ *
+ * @param group - DMACs to start.
+ * @param dma_transfers - One transfer for each DMAC of the group, in order.
+ *
+ * @return 0 for success, negative error code otherwise. On failure, none of
+ *			the transfers is started.
+*******************************************************************************/
+int32_t axi_dmac_group_start(struct axi_dmac_group *group,
+			     struct axi_dma_transfer **dma_transfers)
+{
+	uint32_t flags;
+	uint32_t i, j;
+	int32_t ret;
+
+	if (!group || !group->dmacs || !group->nb_dmacs || !dma_transfers)
+		return -EINVAL;
+
+	for (i = 0; i < group->nb_dmacs; i++) {
+		if (!dma_transfers[i] || !dma_transfers[i]->size) {
+			ret = -EINVAL;
+			goto error;
+		}
+
+		ret = axi_dmac_transfer_load(group->dmacs[i], dma_transfers[i],
+					     false);
+		if (ret)
+			goto error;
+	}
+
+	flags = no_os_critical_enter();
+	for (i = 0; i < group->nb_dmacs; i++)
+		axi_dmac_write(group->dmacs[i], AXI_DMAC_REG_TRANSFER_SUBMIT,
+			       AXI_DMAC_TRANSFER_SUBMIT);
+	no_os_critical_exit(flags);
+
+	return 0;
+
+error:
+	for (j = 0; j < i; j++)
+		axi_dmac_transfer_stop(group->dmacs[j]);
+
+	return ret;
+}
+
+/*******************************************************************************
+ * @brief Stop the transfers of all the DMACs of a group.
+ *
+ * @param group - DMACs to stop.
+ *
+ * @return None
+*******************************************************************************/
+void axi_dmac_group_stop(struct axi_dmac_group *group)
+{
+	uint32_t i;
+
+	for (i = 0; i < group->nb_dmacs; i++)
+		axi_dmac_transfer_stop(group->dmacs[i]);
+}
+
+/*******************************************************************************
+ * @brief Forward each transfer finished by an RX DMAC to a TX DMAC, which
+ *			sends the received buffer as it is, without a CPU copy.
+ *
+ * @note Requires the RX DMAC IRQ. Only plain transfers started with
+ *			axi_dmac_transfer_start() or axi_dmac_group_start() are
+ *			forwarded, not the ones added by axi_dmac_transfer_queue()
+ *			or scatter-gather chains.
+ *			A cyclic TX transfer runs until stopped, so later RX
+ *			transfers should then stop the TX DMAC first.
+ *
+ * @param rx_dmac - DEV_TO_MEM DMAC filling the buffers.
+ * @param tx_dmac - MEM_TO_DEV DMAC sending them, NULL to stop forwarding.
+ * @param cyclic - Whether the TX DMAC repeats the forwarded buffer.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_transfer_forward(struct axi_dmac *rx_dmac,
+				  struct axi_dmac *tx_dmac,
+				  enum cyclic_transfer cyclic)
+{
+	if (!rx_dmac || rx_dmac->direction != DMA_DEV_TO_MEM)
+		return -EINVAL;
+
+	if (tx_dmac && tx_dmac->direction != DMA_MEM_TO_DEV)
+		return -EINVAL;
+
+	if (tx_dmac && rx_dmac->irq_option != IRQ_ENABLED)
+		return -ENOTSUP;
+
+	rx_dmac->forward_cyclic = cyclic;
+	rx_dmac->forward_to = tx_dmac;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Queue a DMA transfer to be started by the ISR right after the current
+ *			one, without a gap between them. If no transfer is running it is
+ *			started immediately. Only one transfer can be queued at a time.
+ *
+ * @note Requires the DMA IRQ and non cyclic, non scatter-gather transfers.
+ *
+ * @param dmac - DMAC istance.
+ * @param dma_transfer - Structure containing transfer details.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_transfer_queue(struct axi_dmac *dmac,
+				struct axi_dma_transfer *dma_transfer)
+{
+	if (!dmac || !dma_transfer || !dma_transfer->size)
+		return -EINVAL;
+
+	if (dmac->irq_option != IRQ_ENABLED || dma_transfer->cyclic == CYCLIC ||
+	    dma_transfer->sg_desc)
+		return -ENOTSUP;
+
+	if (dmac->next_queued)
+		return -EBUSY;
+
+	if (!dmac->active)
+		return axi_dmac_transfer_start(dmac, dma_transfer);
+
+	dmac->next_transfer.size = dma_transfer->size;
+	dmac->next_transfer.src_addr = dma_transfer->src_addr;
+	dmac->next_transfer.dest_addr = dma_transfer->dest_addr;
+	dmac->next_queued = true;
+
+	/* The current transfer may have ended before seeing the queued one. */
+	if (!dmac->active && dmac->next_queued)
+		return axi_dmac_transfer_start(dmac, dma_transfer);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Set a function called from the ISR each time a non cyclic transfer
+ *			ends. It can keep the DMAC busy by calling
+ *			axi_dmac_transfer_queue().
+ *
+ * @param dmac - DMAC istance.
+ * @param cb - Callback, NULL to remove it.
+ * @param ctx - Parameter passed to the callback.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_set_block_callback(struct axi_dmac *dmac,
+				 void (*cb)(void *ctx), void *ctx)
+{
+	if (!dmac)
+		return;
+
+	dmac->block_done_cb = NULL;
+	dmac->block_done_ctx = ctx;
+	dmac->block_done_cb = cb;
+}
+
+/*******************************************************************************
+ * @brief Wait for the next transfer to end when using axi_dmac_transfer_queue.
+ *
+ * @param dmac - DMAC istance.
+ * @param done_count - Number of transfers already waited for. Incremented when
+ *			the next transfer is done.
+ * @param timeout_ms - Number of ms to wait for completion of transfer.
+ *
+ * @return 0 for success, -ETIMEDOUT in case no transfer ended in time.
+*******************************************************************************/
+int32_t axi_dmac_transfer_wait_block(struct axi_dmac *dmac,
+				     uint32_t *done_count, uint32_t timeout_ms)
+{
+	uint32_t timeout = 0;
+
+	if (!dmac || !done_count)
+		return -EINVAL;
+
+	while (dmac->blocks_done == *done_count) {
+		timeout++;
+		no_os_mdelay(1);
+		if (timeout == timeout_ms)
+			return -ETIMEDOUT;
+	}
+
+	(*done_count)++;
+
+	return 0;
+}
+
 /*******************************************************************************
  * @brief Wait for DMA transfer to be completed.
  *
@@ -543,5 +1102,9 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 *******************************************************************************/
 void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
+	dmac->next_queued = false;
+	dmac->switch_pending = false;
+	dmac->sg_active = false;
+	dmac->active = false;
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
 }
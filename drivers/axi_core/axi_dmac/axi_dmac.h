@@ -62,6 +62,7 @@
 #define AXI_DMAC_CTRL_ENABLE		NO_OS_BIT(0)
 #define AXI_DMAC_CTRL_DISABLE		0u
 #define AXI_DMAC_CTRL_PAUSE			NO_OS_BIT(1)
+#define AXI_DMAC_CTRL_ENABLE_SG		NO_OS_BIT(2)
 
 #define AXI_DMAC_REG_TRANSFER_ID		0x404
 #define AXI_DMAC_REG_TRANSFER_SUBMIT	0x408
@@ -75,6 +76,12 @@
 #define AXI_DMAC_REG_DEST_STRIDE		0x420
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
+#define AXI_DMAC_REG_SG_ADDRESS			0x47c
+#define AXI_DMAC_REG_SG_ADDRESS_HIGH	0x4bc
+
+/* Hardware scatter-gather descriptor flags */
+#define AXI_DMAC_SG_FLAG_LAST			NO_OS_BIT(0)
+#define AXI_DMAC_SG_FLAG_IRQ			NO_OS_BIT(1)
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -103,12 +110,39 @@ enum cyclic_transfer {
 	CYCLIC = 1
 };
 
+/*
+ * Hardware scatter-gather descriptor, as fetched by the DMAC. The chain must be
+ * visible to the DMAC, so place it in non cached memory or flush it before
+ * starting the transfer.
+ */
+struct axi_dmac_sg_desc {
+	uint32_t flags;
+	uint32_t id;
+	uint64_t dest_addr;
+	uint64_t src_addr;
+	uint64_t next_sg_addr;
+	uint32_t y_len;
+	uint32_t x_len;
+	uint32_t src_stride;
+	uint32_t dest_stride;
+	uint64_t reserved[2];
+} __attribute__((aligned(64)));
+
+/* One contiguous fragment of a scatter-gather transfer */
+struct axi_dma_segment {
+	uint32_t size;
+	uint32_t src_addr;
+	uint32_t dest_addr;
+};
+
 struct axi_dma_transfer {
 	uint32_t size;
 	volatile bool transfer_done;
 	enum cyclic_transfer cyclic;
 	uint32_t src_addr;
 	uint32_t dest_addr;
+	/* Descriptor chain set by axi_dmac_sg_prepare, NULL for a plain transfer */
+	struct axi_dmac_sg_desc *sg_desc;
 };
 
 struct axi_dmac {
@@ -117,6 +151,7 @@ struct axi_dmac {
 	enum use_irq irq_option;
 	enum dma_direction direction;
 	bool hw_cyclic;
+	bool hw_sg;
 	uint32_t max_length;
 	volatile struct axi_dma_transfer transfer;
 	//Current sub-transfer properties
@@ -124,6 +159,29 @@ struct axi_dmac {
 	uint32_t remaining_size;
 	uint32_t next_src_addr;
 	uint32_t next_dest_addr;
+	//Transfer started by the ISR right after the current one
+	volatile struct axi_dma_transfer next_transfer;
+	volatile bool next_queued;
+	//Set after switching to next_transfer, until the previous one ends
+	volatile bool switch_pending;
+	//Set while a transfer is running
+	volatile bool active;
+	//Number of transfers done, used to wait for queued transfers
+	volatile uint32_t blocks_done;
+	//Set while a scatter-gather chain is running
+	volatile bool sg_active;
+	//DMAC sending each finished transfer, set by axi_dmac_transfer_forward
+	struct axi_dmac *forward_to;
+	enum cyclic_transfer forward_cyclic;
+	//Called from the ISR each time a non cyclic transfer ends
+	void (*block_done_cb)(void *ctx);
+	void *block_done_ctx;
+};
+
+/* DMACs started together and optionally sharing one interrupt */
+struct axi_dmac_group {
+	struct axi_dmac **dmacs;
+	uint32_t nb_dmacs;
 };
 
 struct axi_dmac_init {
@@ -139,6 +197,7 @@ void axi_dmac_dev_to_mem_isr(void *instance);
 void axi_dmac_mem_to_dev_isr(void *instance);
 void axi_dmac_mem_to_mem_isr(void *instance);
 void axi_dmac_write_isr(void *instance);
+void axi_dmac_group_isr(void *instance);
 int32_t axi_dmac_read(struct axi_dmac *dmac, uint32_t reg_addr,
 		      uint32_t *reg_data);
 int32_t axi_dmac_write(struct axi_dmac *dmac, uint32_t reg_addr,
@@ -151,6 +210,22 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 				struct axi_dma_transfer *dma_transfer);
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
+int32_t axi_dmac_transfer_queue(struct axi_dmac *dmac,
+				struct axi_dma_transfer *dma_transfer);
+int32_t axi_dmac_transfer_wait_block(struct axi_dmac *dmac,
+				     uint32_t *done_count, uint32_t timeout_ms);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
+void axi_dmac_set_block_callback(struct axi_dmac *dmac,
+				 void (*cb)(void *ctx), void *ctx);
+int32_t axi_dmac_group_start(struct axi_dmac_group *group,
+			     struct axi_dma_transfer **dma_transfers);
+void axi_dmac_group_stop(struct axi_dmac_group *group);
+int32_t axi_dmac_transfer_forward(struct axi_dmac *rx_dmac,
+				  struct axi_dmac *tx_dmac,
+				  enum cyclic_transfer cyclic);
+int32_t axi_dmac_sg_prepare(struct axi_dmac *dmac,
+			    struct axi_dma_transfer *dma_transfer,
+			    struct axi_dmac_sg_desc *descs, uint32_t nb_descs,
+			    const struct axi_dma_segment *segs, uint32_t nb_segs);
 
 #endif
@@ -68,8 +68,7 @@
 #define AXI_PWMGEN_RESET		NO_OS_BIT(0)
 #define AXI_PWMGEN_CHANNEL_DISABLE	0
 #define AXI_PWMGEN_MAX_CHANNELS(p)	(((p)->hw_major_ver == 1) ? 4 : 16)
-#define NSEC_PER_USEC			1000L
-#define USEC_PER_SEC			1000000L
+#define NSEC_PER_SEC			1000000000ULL
 #define AXI_PWMGEN_VERSION_MAJOR(x)	(((x) >> 16) & 0xff)
 #define AXI_PWMGEN_VERSION_MINOR(x)	(((x) >> 8) & 0xff)
 #define AXI_PWMGEN_VERSION_PATCH(x)	((x) & 0xff)
@@ -91,14 +90,27 @@ static int32_t axi_pwmgen_write_mask(uint32_t base, uint32_t offset,
 				     uint32_t mask,
 				     uint32_t data)
 {
-	int32_t ret;
 	uint32_t temp;
 
-	ret = no_os_axi_io_read(base, offset, &temp);
-	if (ret != 0)
-		return ret;
+	temp = no_os_axi_io_read32(base, offset);
+	no_os_axi_io_write32(base, offset, (temp & ~mask) | (data & mask));
+
+	return 0;
+}
 
-	return no_os_axi_io_write(base, offset, (temp & ~mask) | (data & mask));
+/**
+ * @brief Convert a duration to cycles of the reference clock, rounded up.
+ *
+ * @param [in] axi_desc - AXI PWM descriptor.
+ * @param [in] ns - Duration in nanoseconds.
+ * @return The number of cycles.
+ */
+static uint32_t axi_pwmgen_ns_to_cnt(struct axi_pwm_desc *axi_desc,
+				     uint32_t ns)
+{
+	uint64_t tmp = (uint64_t)axi_desc->ref_clock_Hz * ns + NSEC_PER_SEC - 1;
+
+	return no_os_div_u64(tmp, NSEC_PER_SEC);
 }
 
 /**
@@ -118,6 +130,8 @@ int32_t axi_pwm_enable(struct no_os_pwm_desc *desc)
 	if (ret != 0)
 		return ret;
 
+	desc->enabled = true;
+
 	return no_os_axi_io_write(axi_desc->base_addr, AXI_PWMGEN_REG_CONFIG,
 				  AXI_PWMGEN_LOAD_CONIG);
 }
@@ -139,6 +153,8 @@ int32_t axi_pwm_disable(struct no_os_pwm_desc *desc)
 	if (ret != 0)
 		return ret;
 
+	desc->enabled = false;
+
 	return no_os_axi_io_write(axi_desc->base_addr, AXI_PWMGEN_REG_CONFIG,
 				  AXI_PWMGEN_LOAD_CONIG);
 }
@@ -153,12 +169,10 @@ int32_t axi_pwm_disable(struct no_os_pwm_desc *desc)
 int32_t axi_pwm_set_period(struct no_os_pwm_desc *desc, uint32_t period_ns)
 {
 	struct axi_pwm_desc *axi_desc = desc->extra;
-	uint32_t tmp, period_cnt;
+	uint32_t period_cnt;
 	int32_t ret;
 
-	/* Downscale by 1000 in order to avoid overflow when multiplying */
-	tmp = (axi_desc->ref_clock_Hz / NSEC_PER_USEC) * period_ns;
-	period_cnt = NO_OS_DIV_ROUND_UP(tmp, USEC_PER_SEC);
+	period_cnt = axi_pwmgen_ns_to_cnt(axi_desc, period_ns);
 	axi_desc->ch_period = period_cnt;
 	ret = no_os_axi_io_write(axi_desc->base_addr,
 				 AXI_PWMGEN_CHX_PERIOD(axi_desc, axi_desc->channel),
@@ -197,15 +211,13 @@ int32_t axi_pwm_set_duty_cycle(struct no_os_pwm_desc *desc,
 			       uint32_t duty_cycle_ns)
 {
 	struct axi_pwm_desc *axi_desc = desc->extra;
-	uint32_t tmp, duty_cnt;
+	uint32_t duty_cnt;
 	int32_t ret;
 
 	if (duty_cycle_ns > desc->period_ns)
 		duty_cycle_ns = desc->period_ns;
 
-	/* Downscale by 1000 */
-	tmp = (axi_desc->ref_clock_Hz / NSEC_PER_USEC) * duty_cycle_ns;
-	duty_cnt = NO_OS_DIV_ROUND_UP(tmp, USEC_PER_SEC);
+	duty_cnt = axi_pwmgen_ns_to_cnt(axi_desc, duty_cycle_ns);
 	ret = no_os_axi_io_write(axi_desc->base_addr,
 				 AXI_PWMGEN_CHX_DUTY(axi_desc, axi_desc->channel),
 				 duty_cnt);
@@ -242,12 +254,10 @@ int32_t axi_pwm_get_duty_cycle(struct no_os_pwm_desc *desc,
 int32_t axi_pwm_set_phase(struct no_os_pwm_desc *desc, uint32_t phase_ns)
 {
 	struct axi_pwm_desc *axi_desc = desc->extra;
-	uint32_t tmp, phase_cnt;
+	uint32_t phase_cnt;
 	int32_t ret;
 
-	/* Downscale by 1000 */
-	tmp = (axi_desc->ref_clock_Hz / NSEC_PER_USEC) * phase_ns;
-	phase_cnt = NO_OS_DIV_ROUND_UP(tmp, USEC_PER_SEC);
+	phase_cnt = axi_pwmgen_ns_to_cnt(axi_desc, phase_ns);
 	ret = no_os_axi_io_write(axi_desc->base_addr,
 				 AXI_PWMGEN_CHX_PHASE(axi_desc, axi_desc->channel),
 				 phase_cnt);
@@ -273,6 +283,65 @@ int32_t axi_pwm_get_phase(struct no_os_pwm_desc *desc, uint32_t *phase_ns)
 	return 0;
 }
 
+/**
+ * @brief Update period, duty cycle and phase of several channels of a core
+ * without glitches.
+ *
+ * The registers of all the channels are written first, then the core loads
+ * the new values together at the end of the running period, so a trigger
+ * never sees a period mixing old and new settings. The duty cycles are
+ * clipped to the periods like in axi_pwm_set_duty_cycle().
+ *
+ * @param [in] desc - Descriptors of the channels, all of the same core.
+ * @param [in] cfg - New settings of each channel.
+ * @param [in] nb_channels - Number of channels.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_pwm_group_update(struct no_os_pwm_desc **desc,
+			     const struct axi_pwm_group_cfg *cfg,
+			     uint32_t nb_channels)
+{
+	struct axi_pwm_desc *axi_desc;
+	uint32_t base_addr, duty_ns;
+	uint32_t i;
+
+	if (!desc || !cfg || !nb_channels)
+		return -EINVAL;
+
+	base_addr = ((struct axi_pwm_desc *)desc[0]->extra)->base_addr;
+	for (i = 1; i < nb_channels; i++) {
+		axi_desc = desc[i]->extra;
+		if (axi_desc->base_addr != base_addr)
+			return -EINVAL;
+	}
+
+	for (i = 0; i < nb_channels; i++) {
+		axi_desc = desc[i]->extra;
+		duty_ns = no_os_min(cfg[i].duty_cycle_ns, cfg[i].period_ns);
+
+		axi_desc->ch_period = axi_pwmgen_ns_to_cnt(axi_desc,
+				      cfg[i].period_ns);
+		no_os_axi_io_write32(base_addr,
+				     AXI_PWMGEN_CHX_PERIOD(axi_desc, axi_desc->channel),
+				     desc[i]->enabled ? axi_desc->ch_period : 0);
+		no_os_axi_io_write32(base_addr,
+				     AXI_PWMGEN_CHX_DUTY(axi_desc, axi_desc->channel),
+				     axi_pwmgen_ns_to_cnt(axi_desc, duty_ns));
+		no_os_axi_io_write32(base_addr,
+				     AXI_PWMGEN_CHX_PHASE(axi_desc, axi_desc->channel),
+				     axi_pwmgen_ns_to_cnt(axi_desc, cfg[i].phase_ns));
+
+		desc[i]->period_ns = cfg[i].period_ns;
+		desc[i]->duty_cycle_ns = duty_ns;
+		desc[i]->phase_ns = cfg[i].phase_ns;
+	}
+
+	no_os_axi_io_write32(base_addr, AXI_PWMGEN_REG_CONFIG,
+			     AXI_PWMGEN_LOAD_CONIG);
+
+	return 0;
+}
+
 /**
  * @brief Initialize the pwm axi generator and the handler associated with it.
  *
@@ -79,6 +79,27 @@ struct axi_pwm_desc {
 	uint32_t hw_major_ver;
 };
 
+/**
+ * @struct axi_pwm_group_cfg
+ * @brief New settings of one channel of a group update
+ */
+struct axi_pwm_group_cfg {
+	/** PWM period */
+	uint32_t period_ns;
+	/** PWM duty cycle */
+	uint32_t duty_cycle_ns;
+	/** PWM phase */
+	uint32_t phase_ns;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Update channels of a core together, at the next period boundary */
+int32_t axi_pwm_group_update(struct no_os_pwm_desc **desc,
+			     const struct axi_pwm_group_cfg *cfg,
+			     uint32_t nb_channels);
+
 /**
  * @brief AXI specific PWM platform ops structure
  */
@@ -46,8 +46,10 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "iio.h"
 #include "iio_axi_adc.h"
 
@@ -56,6 +58,7 @@
 /******************************************************************************/
 
 #define STORAGE_BITS 16
+#define CAPTURE_TIMEOUT_MS	10000
 
 /**
  * @brief get_cf_calibphase().
@@ -293,10 +296,123 @@ static int set_sampling_frequency(void *device, char *buf, uint32_t len,
 }
 
 
+/**
+ * @brief Show the number of scans of a deep capture, 0 when streaming.
+ * @param device - Physical instance of a iio_axi_adc_desc device.
+ * @param buf - Where value is stored.
+ * @param len - Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @return Length of chars written in buf, or negative value on failure.
+ */
+static int get_capture_depth(void *device, char *buf, uint32_t len,
+			     const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_adc_desc *iio_adc = device;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1,
+				(int32_t *)&iio_adc->capture_depth);
+}
+
+/**
+ * @brief Set the number of scans of a deep capture. When not 0, the first
+ * refill of the buffer captures this many scans to the buffer memory at once,
+ * up to its size, and the refills that follow only hand out the next chunk of
+ * the capture, without copying it. A new capture is started once it is all
+ * read. 0 to stream, each refill capturing its own chunk.
+ * @param device - Physical instance of a iio_axi_adc_desc device.
+ * @param buf - Value to be written to attribute.
+ * @param len - Length of the data in "buf".
+ * @param channel - Channel properties.
+ * @return Number of bytes written to device, or negative value on failure.
+ */
+static int set_capture_depth(void *device, char *buf, uint32_t len,
+			     const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_adc_desc *iio_adc = device;
+	int32_t val;
+	int ret;
+
+	ret = iio_parse_value(buf, IIO_VAL_INT, &val, NULL);
+	if (ret)
+		return ret;
+	if (val < 0)
+		return -EINVAL;
+
+	iio_adc->capture_depth = val;
+	iio_adc->capture_len = 0;
+
+	return len;
+}
+
+/**
+ * @brief Show the scan of the capture the next refill starts with.
+ * @param device - Physical instance of a iio_axi_adc_desc device.
+ * @param buf - Where value is stored.
+ * @param len - Maximum length of value to be stored in buf.
+ * @param channel - Channel properties.
+ * @return Length of chars written in buf, or negative value on failure.
+ */
+static int get_capture_offset(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_adc_desc *iio_adc = device;
+	int32_t val = 0;
+
+	if (iio_adc->capture_len)
+		val = iio_adc->capture_pos / iio_adc->capture_scan_bytes;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Seek in the capture held in the buffer, the next refill starts with
+ * the given scan.
+ * @param device - Physical instance of a iio_axi_adc_desc device.
+ * @param buf - Value to be written to attribute.
+ * @param len - Length of the data in "buf".
+ * @param channel - Channel properties.
+ * @return Number of bytes written to device, or negative value on failure.
+ */
+static int set_capture_offset(void *device, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct iio_axi_adc_desc *iio_adc = device;
+	int32_t val;
+	int ret;
+
+	ret = iio_parse_value(buf, IIO_VAL_INT, &val, NULL);
+	if (ret)
+		return ret;
+	if (!iio_adc->capture_len || val < 0 ||
+	    (uint64_t)val * iio_adc->capture_scan_bytes >= iio_adc->capture_len)
+		return -EINVAL;
+
+	iio_adc->capture_pos = val * iio_adc->capture_scan_bytes;
+
+	return len;
+}
+
+/**
+ * List containing the attributes of the device.
+ */
+static const struct iio_attribute iio_axi_adc_attributes[] = {
+	{
+		.name = "capture_depth",
+		.show = get_capture_depth,
+		.store = set_capture_depth,
+	},
+	{
+		.name = "capture_offset",
+		.show = get_capture_offset,
+		.store = set_capture_offset,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
 /**
  * List containing attributes, corresponding to "voltage" channels.
  */
-static struct iio_attribute iio_voltage_attributes[] = {
+static const struct iio_attribute iio_voltage_attributes[] = {
 	{
 		.name = "calibphase",
 		.show = get_calibphase,
@@ -336,55 +452,368 @@ int32_t iio_axi_adc_prepare_transfer(void *dev, uint32_t mask)
 	struct iio_axi_adc_desc *iio_adc = dev;
 
 	iio_adc->mask = mask;
+	/* The layout of the scans may change, capture again */
+	iio_adc->capture_len = 0;
 
 	return axi_adc_update_active_channels(iio_adc->adc, mask);
 }
 
 /**
- * @brief Update active channels
- * @param dev - Instance of the iio_axi_adc
- * @param buff - Buffer where to read samples
- * @param nb_samples - Number of samples
- * @return 0 in case of success or negative value otherwise.
+ * @brief Start or queue a DMA transfer into a block of the buffer.
+ * @param iio_adc - IIO axi adc descriptor.
+ * @param buffer - IIO buffer.
+ * @param idx - Offset of the block in the buffer.
+ * @param queue - Queue the transfer after the running one instead of starting
+ * it.
+ * @return 0 in case of success, negative error code otherwise.
  */
-int32_t	iio_axi_adc_read_dev(void *dev, void *buff, uint32_t nb_samples)
+static int32_t iio_axi_adc_start_block(struct iio_axi_adc_desc *iio_adc,
+				       struct iio_buffer *buffer, uint32_t idx,
+				       bool queue)
 {
-	struct iio_axi_adc_desc *iio_adc;
-	int ret, bytes;
+	struct axi_dma_transfer transfer = {
+		.size = buffer->size,
+		.transfer_done = 0,
+		.cyclic = NO,
+		.src_addr = 0,
+		.dest_addr = (uintptr_t)(buffer->buf->buff + idx),
+	};
 
-	if (!dev)
-		return -1;
+	if (queue)
+		return axi_dmac_transfer_queue(iio_adc->dmac, &transfer);
+
+	return axi_dmac_transfer_start(iio_adc->dmac, &transfer);
+}
 
-	iio_adc = (struct iio_axi_adc_desc *)dev;
-	bytes = nb_samples * no_os_hweight32(iio_adc->mask) *
-		(iio_adc->scan_type_common->storagebits / 8);
+/**
+ * @brief Copy the samples of the enabled channels out of full width scans,
+ * where every channel has a sample of the same size, in channel order.
+ * @param layout - Layout of the scans of the buffer.
+ * @param src - Full width scans.
+ * @param src_scan - Size of a full width scan.
+ * @param dst - Where to write the scans of the buffer.
+ * @param samples - Number of scans.
+ */
+static void iio_axi_adc_extract(const struct iio_scan_layout *layout,
+				const uint8_t *src, uint32_t src_scan,
+				uint8_t *dst, uint32_t samples)
+{
+	const uint16_t *src16;
+	uint16_t *dst16;
+	uint32_t i, e, stride;
+
+	if (layout->nb == 1 && layout->bytes[0] == 2) {
+		/* Single 16 bit channel, a strided copy */
+		src16 = (const uint16_t *)src + layout->ch[0];
+		dst16 = (uint16_t *)dst;
+		stride = src_scan / 2;
+		for (i = 0; i < samples; i++)
+			dst16[i] = src16[i * stride];
+		return;
+	}
 
+	for (i = 0; i < samples; i++) {
+		for (e = 0; e < layout->nb; e++)
+			memcpy(dst + layout->offset[e],
+			       src + layout->ch[e] * layout->bytes[e],
+			       layout->bytes[e]);
+		src += src_scan;
+		dst += layout->scan_bytes;
+	}
+}
+
+/**
+ * @brief Fill the next block of the buffer when the DMA receives all the
+ * channels but only some are enabled: the full width scans are captured in
+ * the staging buffer and the enabled channels extracted to the block.
+ * @param iio_adc - IIO axi adc descriptor.
+ * @param buffer - IIO buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t iio_axi_adc_submit_extract(struct iio_axi_adc_desc *iio_adc,
+		struct iio_buffer *buffer)
+{
+	uint32_t scan = iio_adc->adc->num_channels *
+			(iio_adc->scan_type_common->storagebits / 8);
+	uint32_t size = scan * buffer->samples;
 	struct axi_dma_transfer transfer = {
-		// Number of bytes to writen/read
-		.size = bytes,
-		// Transfer done flag
+		.size = size,
 		.transfer_done = 0,
-		// Signal transfer mode
 		.cyclic = NO,
-		// Address of data source
 		.src_addr = 0,
-		// Address of data destination
-		.dest_addr = (uintptr_t)buff
 	};
+	void *buff;
+	int32_t ret;
+
+	if (iio_adc->staging_size < size) {
+		no_os_free(iio_adc->staging);
+		iio_adc->staging_size = 0;
+		iio_adc->staging = no_os_calloc(size, sizeof(uint8_t));
+		if (!iio_adc->staging)
+			return -ENOMEM;
+		iio_adc->staging_size = size;
+	}
+	transfer.dest_addr = (uintptr_t)iio_adc->staging;
+
 	ret = axi_dmac_transfer_start(iio_adc->dmac, &transfer);
-	if (ret < 0)
+	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
-	/* Wait until transfer finishes */
+
 	ret = axi_dmac_transfer_wait_completion(iio_adc->dmac, 500);
-	if(ret)
+	if (ret) {
+		axi_dmac_transfer_stop(iio_adc->dmac);
 		return ret;
+	}
+
+	if (iio_adc->dcache_invalidate_range)
+		iio_adc->dcache_invalidate_range((uintptr_t)iio_adc->staging,
+						 size);
+
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	iio_axi_adc_extract(&buffer->layout, iio_adc->staging, scan, buff,
+			    buffer->samples);
+
+	return iio_buffer_block_done(buffer);
+}
+
+/**
+ * @brief Hand out the next chunk of a deep capture. Once the capture is all
+ * read, a new one is made: a single DMA transfer fills the whole buffer
+ * memory, up to capture_depth scans. The chunks are then committed in place,
+ * the client reads them straight from the buffer memory.
+ * @param iio_adc - IIO axi adc descriptor.
+ * @param buffer - IIO buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t iio_axi_adc_submit_deep(struct iio_axi_adc_desc *iio_adc,
+				       struct iio_buffer *buffer)
+{
+	struct no_os_circular_buffer *cb = buffer->buf;
+	struct axi_dma_transfer transfer = {
+		.transfer_done = 0,
+		.cyclic = NO,
+		.src_addr = 0,
+		.dest_addr = (uintptr_t)cb->buff,
+	};
+	uint64_t len;
+	void *buff;
+	int32_t ret;
+
+	if (iio_adc->capture_pos + buffer->size > iio_adc->capture_len) {
+		iio_adc->capture_len = 0;
+
+		len = no_os_min((uint64_t)iio_adc->capture_depth *
+				buffer->bytes_per_scan, (uint64_t)cb->size);
+		len -= len % buffer->size;
+		if (!len)
+			return -EINVAL;
+
+		transfer.size = len;
+		ret = axi_dmac_transfer_start(iio_adc->dmac, &transfer);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		ret = axi_dmac_transfer_wait_completion(iio_adc->dmac,
+							iio_adc->capture_timeout_ms);
+		if (ret) {
+			axi_dmac_transfer_stop(iio_adc->dmac);
+			return ret;
+		}
+
+		if (iio_adc->dcache_invalidate_range)
+			iio_adc->dcache_invalidate_range((uintptr_t)cb->buff, len);
+
+		iio_adc->capture_len = len;
+		iio_adc->capture_pos = 0;
+		iio_adc->capture_scan_bytes = buffer->bytes_per_scan;
+	}
+
+	/* The chunk is already in place, only commit it */
+	cb->write.idx = iio_adc->capture_pos;
+	cb->read.idx = iio_adc->capture_pos;
+	cb->read.spin_count = cb->write.spin_count;
+
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = iio_buffer_block_done(buffer);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	iio_adc->capture_pos += buffer->size;
+
+	return 0;
+}
+
+/**
+ * @brief Fill the next block of the buffer with data from the DMA.
+ * When the buffer has more than one block and the DMA uses interrupts, the
+ * capture is continuous: the transfer for the following block is queued in
+ * the DMA before waiting for the current one, so the blocks are filled
+ * alternately without a gap while the previous one is sent to the client.
+ * Without interrupts, the next transfer is started once the current one is
+ * done.
+ * @param dev - IIO device data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t iio_axi_adc_submit(struct iio_device_data *dev)
+{
+	struct iio_axi_adc_desc *iio_adc;
+	struct iio_buffer *buffer;
+	bool ping_pong;
+	void *buff;
+	int32_t ret;
+
+	if (!dev || !dev->dev || !dev->buffer)
+		return -EINVAL;
+
+	iio_adc = (struct iio_axi_adc_desc *)dev->dev;
+	buffer = dev->buffer;
+	if (iio_adc->capture_depth)
+		return iio_axi_adc_submit_deep(iio_adc, buffer);
+
+	if (iio_adc->dma_full_width &&
+	    buffer->layout.nb != iio_adc->adc->num_channels)
+		return iio_axi_adc_submit_extract(iio_adc, buffer);
+
+	ping_pong = buffer->nb_blocks > 1 &&
+		    iio_adc->dmac->irq_option == IRQ_ENABLED;
+
+	if (!iio_adc->block_pending) {
+		iio_adc->pending_idx = buffer->buf->write.idx;
+		iio_adc->blocks_waited = iio_adc->dmac->blocks_done;
+		ret = iio_axi_adc_start_block(iio_adc, buffer,
+					      iio_adc->pending_idx, false);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		iio_adc->block_pending = true;
+	}
+
+	if (ping_pong && !iio_adc->next_pending) {
+		iio_adc->next_idx = (iio_adc->pending_idx + buffer->size) %
+				    buffer->buf->size;
+		ret = iio_axi_adc_start_block(iio_adc, buffer,
+					      iio_adc->next_idx, true);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto stop;
+		iio_adc->next_pending = true;
+	}
+
+	/* Wait until transfer finishes */
+	if (ping_pong)
+		ret = axi_dmac_transfer_wait_block(iio_adc->dmac,
+						   &iio_adc->blocks_waited, 500);
+	else
+		ret = axi_dmac_transfer_wait_completion(iio_adc->dmac, 500);
+	if (ret)
+		goto stop;
 
 	if (iio_adc->dcache_invalidate_range)
-		iio_adc->dcache_invalidate_range((uintptr_t)buff, bytes);
+		iio_adc->dcache_invalidate_range((uintptr_t)(buffer->buf->buff +
+						 iio_adc->pending_idx),
+						 buffer->size);
+
+	/* The DMA wrote the block in place, only commit it */
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto stop;
+
+	ret = iio_buffer_block_done(buffer);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto stop;
+
+	iio_adc->block_pending = iio_adc->next_pending;
+	iio_adc->pending_idx = iio_adc->next_idx;
+	iio_adc->next_pending = false;
+
+	if (!ping_pong && buffer->nb_blocks > 1) {
+		iio_adc->pending_idx = buffer->buf->write.idx;
+		iio_adc->blocks_waited = iio_adc->dmac->blocks_done;
+		ret = iio_axi_adc_start_block(iio_adc, buffer,
+					      iio_adc->pending_idx, false);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		iio_adc->block_pending = true;
+	}
 
 	return 0;
+
+stop:
+	axi_dmac_transfer_stop(iio_adc->dmac);
+	iio_adc->block_pending = false;
+	iio_adc->next_pending = false;
+
+	return ret;
 }
 
+/**
+ * @brief Stop the queued DMA transfer, if any, when the buffer is closed.
+ * @param dev - IIO axi adc descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t iio_axi_adc_end_transfer(void *dev)
+{
+	struct iio_axi_adc_desc *iio_adc = dev;
+
+	if (!iio_adc)
+		return -EINVAL;
+
+	if (iio_adc->block_pending) {
+		axi_dmac_transfer_stop(iio_adc->dmac);
+		iio_adc->block_pending = false;
+		iio_adc->next_pending = false;
+	}
+
+	no_os_free(iio_adc->staging);
+	iio_adc->staging = NULL;
+	iio_adc->staging_size = 0;
+
+	return 0;
+}
+
+static const struct scan_type iio_axi_adc_scan_type = {
+	.sign = 's',
+	.realbits = STORAGE_BITS,
+	.storagebits = STORAGE_BITS,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+#define IIO_AXI_ADC_CHANNEL(_idx, _scan) {		\
+	.name = "voltage" #_idx,			\
+	.ch_type = IIO_VOLTAGE,				\
+	.channel = _idx,				\
+	.scan_index = _idx,				\
+	.scan_type = _scan,				\
+	.attributes = iio_voltage_attributes,		\
+	.ch_out = false,				\
+	.indexed = true,				\
+}
+
+#define IIO_AXI_ADC_CHANNELS(_scan)					\
+	IIO_AXI_ADC_CHANNEL(0, _scan), IIO_AXI_ADC_CHANNEL(1, _scan),	\
+	IIO_AXI_ADC_CHANNEL(2, _scan), IIO_AXI_ADC_CHANNEL(3, _scan),	\
+	IIO_AXI_ADC_CHANNEL(4, _scan), IIO_AXI_ADC_CHANNEL(5, _scan),	\
+	IIO_AXI_ADC_CHANNEL(6, _scan), IIO_AXI_ADC_CHANNEL(7, _scan),	\
+	IIO_AXI_ADC_CHANNEL(8, _scan), IIO_AXI_ADC_CHANNEL(9, _scan),	\
+	IIO_AXI_ADC_CHANNEL(10, _scan), IIO_AXI_ADC_CHANNEL(11, _scan),	\
+	IIO_AXI_ADC_CHANNEL(12, _scan), IIO_AXI_ADC_CHANNEL(13, _scan),	\
+	IIO_AXI_ADC_CHANNEL(14, _scan), IIO_AXI_ADC_CHANNEL(15, _scan)
+
+/* Channels shared by all the instances using the default data format */
+static const struct iio_channel iio_axi_adc_channels[] = {
+	IIO_AXI_ADC_CHANNELS(&iio_axi_adc_scan_type)
+};
+
+/* Channels shared by all the instances without DMA */
+static const struct iio_channel iio_axi_adc_channels_no_dma[] = {
+	IIO_AXI_ADC_CHANNELS(NULL)
+};
+
 /**
  * @brief Delete iio_device.
  * @param iio_device - Structure describing a device, channels and attributes.
@@ -396,11 +825,11 @@ static int iio_axi_adc_delete_device_descriptor(
 	if (!desc)
 		return -1;
 
-	if (desc->dev_descriptor.channels)
-		no_os_free(desc->dev_descriptor.channels);
-
-	if (desc->ch_names)
+	/* Only the channels of a custom data format are allocated */
+	if (desc->ch_names) {
+		no_os_free((void *)desc->dev_descriptor.channels);
 		no_os_free(desc->ch_names);
+	}
 
 	return 0;
 }
@@ -415,44 +844,49 @@ static int iio_axi_adc_delete_device_descriptor(
 static int32_t iio_axi_adc_create_device_descriptor(
 	struct iio_axi_adc_desc *desc, struct iio_device *iio_device)
 {
-	static struct iio_channel default_channel = {
-		.ch_type = IIO_VOLTAGE,
-		.attributes = iio_voltage_attributes,
-		.ch_out = false,
-		.indexed = true,
-	};
+	struct iio_channel *channels;
 	int32_t i;
 	int32_t ret;
 
-	default_channel.scan_type = desc->scan_type_common;
-
-	if (!desc->dmac)
-		default_channel.scan_type = NULL;
-
 	iio_device->num_ch = desc->adc->num_channels;
-	iio_device->attributes = NULL; /* no device attribute */
-	iio_device->channels = no_os_calloc(iio_device->num_ch,
-					    sizeof(struct iio_channel));
-	if (!iio_device->channels)
-		goto error;
+	iio_device->attributes = desc->dmac ? iio_axi_adc_attributes : NULL;
+	iio_device->pre_enable = iio_axi_adc_prepare_transfer;
+	iio_device->post_disable = iio_axi_adc_end_transfer;
+	iio_device->submit = iio_axi_adc_submit;
+
+	if (iio_device->num_ch <= NO_OS_ARRAY_SIZE(iio_axi_adc_channels)) {
+		if (!desc->dmac) {
+			iio_device->channels = iio_axi_adc_channels_no_dma;
+			return 0;
+		}
+		if (desc->scan_type_common == &iio_axi_adc_scan_type) {
+			iio_device->channels = iio_axi_adc_channels;
+			return 0;
+		}
+	}
+
+	channels = no_os_calloc(iio_device->num_ch, sizeof(*channels));
+	if (!channels)
+		return -1;
 
 	desc->ch_names = no_os_calloc(iio_device->num_ch, sizeof(*desc->ch_names));
-	if (!desc->ch_names)
-		goto error;
+	if (!desc->ch_names) {
+		no_os_free(channels);
+		return -1;
+	}
+	iio_device->channels = channels;
 
 	for (i = 0; i < iio_device->num_ch; i++) {
-		default_channel.channel = i;
-		iio_device->channels[i] = default_channel;
-		iio_device->channels[i].name = desc->ch_names[i];
-		iio_device->channels[i].scan_index = i;
+		channels[i] = iio_axi_adc_channels[0];
+		channels[i].channel = i;
+		channels[i].name = desc->ch_names[i];
+		channels[i].scan_index = i;
+		channels[i].scan_type = desc->dmac ? desc->scan_type_common : NULL;
 		ret = sprintf(desc->ch_names[i], "voltage%"PRIi32"", i);
 		if (ret < 0)
 			goto error;
 	}
 
-	iio_device->pre_enable = iio_axi_adc_prepare_transfer;
-	iio_device->read_dev = iio_axi_adc_read_dev;
-
 	return 0;
 error:
 	iio_axi_adc_delete_device_descriptor(desc);
@@ -485,14 +919,6 @@ int32_t iio_axi_adc_init(struct iio_axi_adc_desc **desc,
 	struct iio_axi_adc_desc *iio_axi_adc_inst;
 	int32_t status;
 
-	static struct scan_type scan_type = {
-		.sign = 's',
-		.realbits = STORAGE_BITS,
-		.storagebits = STORAGE_BITS,
-		.shift = 0,
-		.is_big_endian = false
-	};
-
 	if (!init)
 		return -1;
 
@@ -510,11 +936,15 @@ int32_t iio_axi_adc_init(struct iio_axi_adc_desc **desc,
 		iio_axi_adc_inst->dcache_invalidate_range = init->dcache_invalidate_range;
 	}
 	iio_axi_adc_inst->get_sampling_frequency = init->get_sampling_frequency;
+	iio_axi_adc_inst->dma_full_width = init->dma_full_width;
+	iio_axi_adc_inst->capture_timeout_ms = init->capture_timeout_ms ?
+					       init->capture_timeout_ms :
+					       CAPTURE_TIMEOUT_MS;
 
 	if (init->scan_type_common)
 		iio_axi_adc_inst->scan_type_common = init->scan_type_common;
 	else
-		iio_axi_adc_inst->scan_type_common = &scan_type;
+		iio_axi_adc_inst->scan_type_common = &iio_axi_adc_scan_type;
 
 	status = iio_axi_adc_create_device_descriptor(iio_axi_adc_inst,
 			&iio_axi_adc_inst->dev_descriptor);
@@ -544,6 +974,7 @@ int32_t iio_axi_adc_remove(struct iio_axi_adc_desc *desc)
 	if (status < 0)
 		return status;
 
+	no_os_free(desc->staging);
 	no_os_free(desc);
 
 	return 0;
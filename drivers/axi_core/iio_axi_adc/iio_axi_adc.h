@@ -73,7 +73,34 @@ struct iio_axi_adc_desc {
 	/** Channel names */
 	char (*ch_names)[20];
 	/** Custom data format */
-	struct scan_type *scan_type_common;
+	const struct scan_type *scan_type_common;
+	/** Set while a DMA transfer is running for the next buffer block */
+	bool block_pending;
+	/** Offset in the buffer of the block being filled */
+	uint32_t pending_idx;
+	/** Set while the transfer of the following block is queued */
+	bool next_pending;
+	/** Offset in the buffer of the queued block */
+	uint32_t next_idx;
+	/** Number of DMA transfers already waited for */
+	uint32_t blocks_waited;
+	/** Set if the DMA receives the samples of all the channels */
+	bool dma_full_width;
+	/** Where the DMA writes the full width scans, if not all the channels
+	 *  are enabled */
+	uint8_t *staging;
+	/** Size of staging in bytes */
+	uint32_t staging_size;
+	/** Scans captured at once in deep capture mode, 0 to stream */
+	uint32_t capture_depth;
+	/** Bytes of the capture held in the buffer, 0 if none */
+	uint32_t capture_len;
+	/** Offset of the next chunk of the capture to be read */
+	uint32_t capture_pos;
+	/** Size of a scan of the capture */
+	uint32_t capture_scan_bytes;
+	/** Timeout of a deep capture in milliseconds */
+	uint32_t capture_timeout_ms;
 };
 
 /**
@@ -93,6 +120,13 @@ struct iio_axi_adc_init_param {
 	/** Custom data format (unpopulated if not used, set to default)
 	    Common to all channels */
 	struct scan_type *scan_type_common;
+	/** Set if the HDL has no channel packer (util_cpack2) in front of the
+	 *  DMA, which then receives the samples of all the channels, enabled or
+	 *  not. The enabled channels are extracted in software. */
+	bool dma_full_width;
+	/** Timeout of a deep capture in milliseconds, see the capture_depth
+	 *  attribute. 10 s if 0 */
+	uint32_t capture_timeout_ms;
 };
 
 /******************************************************************************/
@@ -410,7 +410,7 @@ static int set_altvoltage_sampling_frequency(void *device, char *buf,
 /**
  * List containing attributes, corresponding to "voltage" channels.
  */
-static struct iio_attribute iio_voltage_attributes[] = {
+static const struct iio_attribute iio_voltage_attributes[] = {
 	{
 		.name = "calibscale",
 		.show = get_voltage_calibscale,
@@ -432,7 +432,7 @@ static struct iio_attribute iio_voltage_attributes[] = {
 /**
  * List containing attributes, corresponding to "altvoltage" channels.
  */
-static struct iio_attribute iio_altvoltage_attributes[] = {
+static const struct iio_attribute iio_altvoltage_attributes[] = {
 	{
 		.name = "raw",
 		.show = get_altvoltage_raw,
@@ -526,6 +526,111 @@ int32_t iio_axi_dac_write_data(void *dev, void *buff, uint32_t nb_samples)
 	return axi_dmac_transfer_start(iio_dac->dmac, &transfer);
 }
 
+/**
+ * @brief Send the next block of the buffer to the DAC.
+ * Cyclic buffers are sent with iio_axi_dac_write_data. For non cyclic buffers,
+ * when the DMA uses interrupts, each block is queued in the DMA behind the one
+ * being sent so that the output has no gap. The function returns once a block
+ * is free for the client, so with two blocks one is filled while the other one
+ * is sent.
+ * @param dev - IIO device data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t iio_axi_dac_submit(struct iio_device_data *dev)
+{
+	struct iio_axi_dac_desc *iio_dac;
+	struct iio_buffer *buffer;
+	uint32_t max_queued;
+	void *buff;
+	int32_t ret;
+
+	if (!dev || !dev->dev || !dev->buffer)
+		return -EINVAL;
+
+	iio_dac = (struct iio_axi_dac_desc *)dev->dev;
+	buffer = dev->buffer;
+
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (buffer->cyclic_info.is_cyclic ||
+	    iio_dac->dmac->irq_option != IRQ_ENABLED) {
+		ret = iio_axi_dac_write_data(iio_dac, buff, buffer->samples);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return iio_buffer_block_done(buffer);
+	}
+
+	struct axi_dma_transfer transfer = {
+		.size = buffer->size,
+		.transfer_done = 0,
+		.cyclic = NO,
+		.src_addr = (uintptr_t)buff,
+		.dest_addr = 0
+	};
+
+	if (iio_dac->dcache_flush_range)
+		iio_dac->dcache_flush_range((uintptr_t)buff, buffer->size);
+
+	if (!iio_dac->dmac->active) {
+		/* All the queued blocks were sent */
+		iio_dac->blocks_queued = 0;
+		iio_dac->blocks_waited = iio_dac->dmac->blocks_done;
+	} else if (iio_dac->dmac->next_queued) {
+		/* Wait for a free place in the DMA queue */
+		ret = axi_dmac_transfer_wait_block(iio_dac->dmac,
+						   &iio_dac->blocks_waited, 500);
+		if (ret)
+			goto stop;
+		iio_dac->blocks_queued--;
+	}
+
+	ret = axi_dmac_transfer_queue(iio_dac->dmac, &transfer);
+	if (ret)
+		goto stop;
+	iio_dac->blocks_queued++;
+
+	/* The next block written by the client must not be in use by the DMA */
+	max_queued = buffer->nb_blocks - 1;
+	while (iio_dac->blocks_queued > max_queued) {
+		ret = axi_dmac_transfer_wait_block(iio_dac->dmac,
+						   &iio_dac->blocks_waited, 500);
+		if (ret)
+			goto stop;
+		iio_dac->blocks_queued--;
+	}
+
+	return iio_buffer_block_done(buffer);
+
+stop:
+	axi_dmac_transfer_stop(iio_dac->dmac);
+	iio_dac->blocks_queued = 0;
+
+	return ret;
+}
+
+/**
+ * @brief Stop the non cyclic DMA transfers, if any, when the buffer is closed.
+ * @param dev - IIO axi dac descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t iio_axi_dac_end_transfer(void *dev)
+{
+	struct iio_axi_dac_desc *iio_dac = dev;
+
+	if (!iio_dac)
+		return -EINVAL;
+
+	if (iio_dac->blocks_queued) {
+		axi_dmac_transfer_stop(iio_dac->dmac);
+		iio_dac->blocks_queued = 0;
+	}
+
+	return 0;
+}
+
 enum ch_type {
 	CH_VOLTGE,
 	CH_ALTVOLTGE,
@@ -543,7 +648,7 @@ static int iio_axi_dac_delete_device_descriptor(
 		return -1;
 
 	if (desc->dev_descriptor.channels)
-		no_os_free(desc->dev_descriptor.channels);
+		no_os_free((void *)desc->dev_descriptor.channels);
 
 	if (desc->ch_names)
 		no_os_free(desc->ch_names);
@@ -561,7 +666,7 @@ static int iio_axi_dac_delete_device_descriptor(
 static int32_t iio_axi_dac_create_device_descriptor(
 	struct iio_axi_dac_desc *desc, struct iio_device *iio_device)
 {
-	static struct scan_type scan_type = {
+	static const struct scan_type scan_type = {
 		.sign = 's',
 		.realbits = STORAGE_BITS,
 		.storagebits = STORAGE_BITS,
@@ -569,7 +674,7 @@ static int32_t iio_axi_dac_create_device_descriptor(
 		.is_big_endian = false
 	};
 
-	static struct iio_channel default_voltage_channel = {
+	static const struct iio_channel default_voltage_channel = {
 		.ch_type = IIO_VOLTAGE,
 		.scan_type = &scan_type,
 		.attributes = iio_voltage_attributes,
@@ -577,7 +682,7 @@ static int32_t iio_axi_dac_create_device_descriptor(
 		.indexed = true,
 	};
 
-	static struct iio_channel default_altvoltage_channel = {
+	static const struct iio_channel default_altvoltage_channel = {
 		.ch_type = IIO_ALTVOLTAGE,
 		.scan_type = NULL,
 		.attributes = iio_altvoltage_attributes,
@@ -585,31 +690,31 @@ static int32_t iio_axi_dac_create_device_descriptor(
 		.indexed = true,
 	};
 
+	struct iio_channel *channels;
 	int32_t i, j, altvoltage_ch, voltage_ch_no, altvoltage_ch_no;
 	int32_t ret;
 	char ch;
 
-	if (!desc->dmac)
-		default_voltage_channel.scan_type = NULL;
-
 	voltage_ch_no = desc->dac->num_channels;
 	altvoltage_ch_no = desc->dac->num_channels * 2;
 	iio_device->num_ch = voltage_ch_no + altvoltage_ch_no;
 	iio_device->attributes = NULL; /* no device attribute */
-	iio_device->channels = no_os_calloc(iio_device->num_ch,
-					    sizeof(struct iio_channel));
-	if (!iio_device->channels)
+	channels = no_os_calloc(iio_device->num_ch, sizeof(*channels));
+	if (!channels)
 		goto error;
+	iio_device->channels = channels;
 
 	desc->ch_names = no_os_calloc(iio_device->num_ch, sizeof(*desc->ch_names));
 	if (!desc->ch_names)
 		goto error;
 
 	for (i = 0; i < voltage_ch_no; i++) {
-		default_voltage_channel.channel = i;
-		iio_device->channels[i] = default_voltage_channel;
-		iio_device->channels[i].scan_index = i;
-		iio_device->channels[i].name = desc->ch_names[i];
+		channels[i] = default_voltage_channel;
+		channels[i].channel = i;
+		channels[i].scan_index = i;
+		channels[i].name = desc->ch_names[i];
+		if (!desc->dmac)
+			channels[i].scan_type = NULL;
 		ret = sprintf(desc->ch_names[i], "voltage%"PRIi32"", i);
 		if (ret < 0)
 			goto error;
@@ -617,10 +722,10 @@ static int32_t iio_axi_dac_create_device_descriptor(
 
 	for (i = voltage_ch_no; i < voltage_ch_no + altvoltage_ch_no; i++) {
 		altvoltage_ch = i - voltage_ch_no;
-		default_altvoltage_channel.channel = altvoltage_ch;
-		iio_device->channels[i] = default_altvoltage_channel;
-		iio_device->channels[i].scan_index = altvoltage_ch;
-		iio_device->channels[i].name = desc->ch_names[i];
+		channels[i] = default_altvoltage_channel;
+		channels[i].channel = altvoltage_ch;
+		channels[i].scan_index = altvoltage_ch;
+		channels[i].name = desc->ch_names[i];
 
 		ch = 'Q';
 		if (altvoltage_ch % 4 == 0 || altvoltage_ch % 4 == 1)
@@ -633,6 +738,10 @@ static int32_t iio_axi_dac_create_device_descriptor(
 	}
 	iio_device->pre_enable = iio_axi_dac_prepare_transfer;
 	iio_device->write_dev = iio_axi_dac_write_data;
+	if (desc->dmac) {
+		iio_device->submit = iio_axi_dac_submit;
+		iio_device->post_disable = iio_axi_dac_end_transfer;
+	}
 
 	return 0;
 
@@ -68,6 +68,10 @@ struct iio_axi_dac_desc {
 	struct iio_device dev_descriptor;
 	/** Channel names */
 	char (*ch_names)[20];
+	/** Number of non cyclic blocks queued in the DMA */
+	uint32_t blocks_queued;
+	/** Number of DMA transfers already waited for */
+	uint32_t blocks_waited;
 };
 
 /**
@@ -42,6 +42,7 @@
 /******************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 #include "no_os_axi_io.h"
 #include "no_os_util.h"
@@ -191,6 +192,38 @@ int adxcvr_drp_read(struct adxcvr *xcvr,
 	return 0;
 }
 
+/**
+ * @brief Record a DRP write in a lane rate settings cache entry. A later write
+ * to the same register replaces the recorded value.
+ * @param entry - The cache entry.
+ * @param drp_port - The DRP Port.
+ * @param reg - DRP Register address.
+ * @param val - Data written.
+ */
+static void adxcvr_settings_record(struct adxcvr_settings *entry,
+				   unsigned int drp_port,
+				   unsigned int reg,
+				   unsigned int val)
+{
+	bool common = drp_port < ADXCVR_DRP_PORT_CHANNEL(0);
+	uint32_t i;
+
+	for (i = 0; i < entry->num_regs; i++) {
+		if (entry->regs[i].reg == reg && entry->regs[i].common == common) {
+			entry->regs[i].val = val;
+			return;
+		}
+	}
+
+	/* Overflow is caught when the recording is finished */
+	if (entry->num_regs++ >= ADXCVR_SETTINGS_MAX_REGS)
+		return;
+
+	entry->regs[i].reg = reg;
+	entry->regs[i].val = val;
+	entry->regs[i].common = common;
+}
+
 /**
  * @brief AXI ADXCVR DPR Port Write
  * @param xcvr - The device structure.
@@ -222,6 +255,10 @@ int adxcvr_drp_write(struct adxcvr *xcvr,
 	if (ret < 0)
 		return ret;
 
+	if (xcvr->settings_rec && (drp_port == ADXCVR_DRP_PORT_COMMON(0) ||
+				   drp_port == ADXCVR_DRP_PORT_CHANNEL(0)))
+		adxcvr_settings_record(xcvr->settings_rec, drp_port, reg, val);
+
 	return 0;
 }
 
@@ -303,15 +340,70 @@ static const struct clk_ops clkout_ops = {
 };
 
 /**
- * @brief AXI ADXCVR Clock Set Rate
+ * @brief Find the lane rate settings cache entry of a lane rate.
+ * @param xcvr - The device structure.
+ * @param rate - The lane rate (kHz).
+ * @param parent_rate - The reference clock rate (kHz).
+ * @return The cache entry, NULL if the lane rate isn't cached.
+ */
+static struct adxcvr_settings *adxcvr_settings_find(struct adxcvr *xcvr,
+		unsigned long rate,
+		unsigned long parent_rate)
+{
+	uint32_t i;
+
+	for (i = 0; i < xcvr->num_settings; i++) {
+		if (xcvr->settings[i].lane_rate_khz == rate &&
+		    xcvr->settings[i].ref_rate_khz == parent_rate &&
+		    xcvr->settings[i].lpm_enable == xcvr->lpm_enable &&
+		    xcvr->settings[i].num_regs &&
+		    xcvr->settings[i].num_regs <= ADXCVR_SETTINGS_MAX_REGS)
+			return &xcvr->settings[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Program all the lanes from a lane rate settings cache entry. The
+ * registers are broadcast to all the channel and common DRP ports, skipping
+ * the divider search and the per lane read-modify-write accesses.
+ * @param xcvr - The device structure.
+ * @param entry - The cache entry.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int adxcvr_settings_apply(struct adxcvr *xcvr,
+				 const struct adxcvr_settings *entry)
+{
+	unsigned int drp_port;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < entry->num_regs; i++) {
+		if (entry->regs[i].common)
+			drp_port = ADXCVR_DRP_PORT_COMMON(ADXCVR_BROADCAST);
+		else
+			drp_port = ADXCVR_DRP_PORT_CHANNEL(ADXCVR_BROADCAST);
+
+		ret = adxcvr_drp_write(xcvr, drp_port, entry->regs[i].reg,
+				       entry->regs[i].val);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Compute and program the PLL, divider and CDR settings of a lane rate.
  * @param xcvr - The device structure.
  * @param rate - The output rate (kHz).
  * @param parent_rate - The parent rate (kHz).
  * @return Returns 0 in case of success or negative error code otherwise.
  */
-int adxcvr_clk_set_rate(struct adxcvr *xcvr,
-			unsigned long rate,
-			unsigned long parent_rate)
+static int adxcvr_clk_program_rate(struct adxcvr *xcvr,
+				   unsigned long rate,
+				   unsigned long parent_rate)
 {
 	struct xilinx_xcvr_cpll_config cpll_conf;
 	struct xilinx_xcvr_qpll_config qpll_conf;
@@ -422,12 +514,138 @@ int adxcvr_clk_set_rate(struct adxcvr *xcvr,
 			return ret;
 	}
 
+	return 0;
+}
+
+/**
+ * @brief AXI ADXCVR Clock Set Rate. A lane rate found in the settings cache
+ * is applied from the cache, otherwise the settings are computed and the
+ * resulting DRP writes are recorded in the cache.
+ * @param xcvr - The device structure.
+ * @param rate - The output rate (kHz).
+ * @param parent_rate - The parent rate (kHz).
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int adxcvr_clk_set_rate(struct adxcvr *xcvr,
+			unsigned long rate,
+			unsigned long parent_rate)
+{
+	struct adxcvr_settings *entry;
+	int ret;
+
+	entry = adxcvr_settings_find(xcvr, rate, parent_rate);
+	if (entry) {
+		pr_debug("%s: %lu kHz from the settings cache\n", __func__, rate);
+		ret = adxcvr_settings_apply(xcvr, entry);
+		if (ret < 0)
+			return ret;
+
+		xcvr->lane_rate_khz = rate;
+
+		return 0;
+	}
+
+	if (xcvr->num_settings) {
+		entry = &xcvr->settings[xcvr->settings_next];
+		memset(entry, 0, sizeof(*entry));
+		xcvr->settings_rec = entry;
+	}
+
+	ret = adxcvr_clk_program_rate(xcvr, rate, parent_rate);
+	xcvr->settings_rec = NULL;
+	if (ret < 0) {
+		if (entry)
+			entry->num_regs = 0;
+		return ret;
+	}
+
+	if (entry && entry->num_regs <= ADXCVR_SETTINGS_MAX_REGS) {
+		entry->lane_rate_khz = rate;
+		entry->ref_rate_khz = parent_rate;
+		entry->lpm_enable = xcvr->lpm_enable;
+		xcvr->settings_next = (xcvr->settings_next + 1) % xcvr->num_settings;
+	} else if (entry) {
+		entry->num_regs = 0;
+	}
 
 	xcvr->lane_rate_khz = rate;
 
 	return 0;
 }
 
+/**
+ * @brief Get the settings cache entry of the current lane rate.
+ * @param xcvr - The device structure.
+ * @param lane - The lane.
+ * @param entry - The cache entry.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int adxcvr_eye_entry(struct adxcvr *xcvr, uint32_t lane,
+			    struct adxcvr_settings **entry)
+{
+	if (lane >= xcvr->num_lanes || lane >= ADXCVR_MAX_LANES)
+		return -EINVAL;
+
+	*entry = adxcvr_settings_find(xcvr, xcvr->lane_rate_khz,
+				      xcvr->ref_rate_khz);
+	if (!*entry)
+		return -ENOENT;
+
+	return 0;
+}
+
+/**
+ * @brief AXI ADXCVR Store a lane eye-scan result for the current lane rate.
+ * The result is kept in the settings cache entry of the lane rate, so it
+ * can be saved to storage and reused for lane tuning along the settings.
+ * @param xcvr - The device structure.
+ * @param lane - The lane.
+ * @param eye - The eye-scan result.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int adxcvr_eye_store(struct adxcvr *xcvr, uint32_t lane,
+		     const struct adxcvr_eye *eye)
+{
+	struct adxcvr_settings *entry;
+	int ret;
+
+	ret = adxcvr_eye_entry(xcvr, lane, &entry);
+	if (ret)
+		return ret;
+
+	entry->eye[lane] = *eye;
+	entry->eye_valid_mask |= NO_OS_BIT(lane);
+
+	return 0;
+}
+
+/**
+ * @brief AXI ADXCVR Get the stored lane eye-scan result for the current
+ * lane rate.
+ * @param xcvr - The device structure.
+ * @param lane - The lane.
+ * @param eye - The eye-scan result.
+ * @return Returns 0 in case of success, -ENOENT if there is no stored result
+ * or negative error code otherwise.
+ */
+int adxcvr_eye_get(struct adxcvr *xcvr, uint32_t lane,
+		   struct adxcvr_eye *eye)
+{
+	struct adxcvr_settings *entry;
+	int ret;
+
+	ret = adxcvr_eye_entry(xcvr, lane, &entry);
+	if (ret)
+		return ret;
+
+	if (!(entry->eye_valid_mask & NO_OS_BIT(lane)))
+		return -ENOENT;
+
+	*eye = entry->eye[lane];
+
+	return 0;
+}
+
 /**
  * @brief AXI ADXCVR Status Read
  * @param xcvr - The device structure.
@@ -587,6 +805,8 @@ int32_t adxcvr_init(struct adxcvr **ad_xcvr,
 
 	xcvr->lane_rate_khz = init->lane_rate_khz;
 	xcvr->ref_rate_khz = init->ref_rate_khz;
+	xcvr->settings = init->settings;
+	xcvr->num_settings = init->settings ? init->num_settings : 0;
 
 	adxcvr_read(xcvr, ADXCVR_REG_SYNTH, &synth_conf);
 	xcvr->tx_enable = (synth_conf >> 8) & 1;
@@ -62,6 +62,57 @@
 #define ADXCVR_REFCLK_DIV2	4
 #define ADXCVR_PROGDIV_CLK	5 /* GTHE3, GTHE4, GTYE4 only */
 
+#define ADXCVR_MAX_LANES		32
+#define ADXCVR_SETTINGS_MAX_REGS	32
+
+/**
+ * @struct adxcvr_drp_reg
+ * @brief DRP register value recorded while programming a lane rate.
+ */
+struct adxcvr_drp_reg {
+	/** DRP register address */
+	uint16_t reg;
+	/** Value written to the register */
+	uint16_t val;
+	/** True for a QPLL (common) register, false for a channel register */
+	bool common;
+};
+
+/**
+ * @struct adxcvr_eye
+ * @brief Eye-scan result of a lane, stored along the lane rate settings.
+ */
+struct adxcvr_eye {
+	/** Horizontal eye opening in 1/1000 UI */
+	uint16_t width;
+	/** Vertical eye opening in mV */
+	uint16_t height;
+	/** Number of bits sampled for the result */
+	uint64_t samples;
+};
+
+/**
+ * @struct adxcvr_settings
+ * @brief PLL, divider and CDR settings of a lane rate. Lane 0 and the first
+ * QPLL are recorded, all the lanes are programmed with the same values.
+ */
+struct adxcvr_settings {
+	/** Lane rate in KHz, 0 for an unused entry */
+	uint32_t lane_rate_khz;
+	/** Reference Clock rate */
+	uint32_t ref_rate_khz;
+	/** LPM mode the CDR settings were computed for */
+	bool lpm_enable;
+	/** Number of valid entries in regs */
+	uint32_t num_regs;
+	/** DRP writes in programming order */
+	struct adxcvr_drp_reg regs[ADXCVR_SETTINGS_MAX_REGS];
+	/** Lanes with a stored eye-scan result */
+	uint32_t eye_valid_mask;
+	/** Stored eye-scan results */
+	struct adxcvr_eye eye[ADXCVR_MAX_LANES];
+};
+
 /**
  * @struct adxcvr
  * @brief ADI JESD204B/C AXI_ADXCVR Highspeed Transceiver Device structure.
@@ -97,6 +148,14 @@ struct adxcvr {
 	struct xilinx_xcvr xlx_xcvr;
 	/** Exported no-OS output clock */
 	struct no_os_clk_desc *clk_out;
+	/** Lane rate settings cache */
+	struct adxcvr_settings *settings;
+	/** Number of entries in the settings cache */
+	uint32_t num_settings;
+	/** Next cache entry to be replaced */
+	uint32_t settings_next;
+	/** Cache entry being recorded */
+	struct adxcvr_settings *settings_rec;
 };
 
 /**
@@ -125,6 +184,10 @@ struct adxcvr_init {
 	uint32_t ref_rate_khz;
 	/** Export no-OS output clock */
 	bool export_no_os_clk;
+	/** Optional lane rate settings cache, may be preloaded from storage */
+	struct adxcvr_settings *settings;
+	/** Number of entries in the settings cache */
+	uint32_t num_settings;
 };
 
 /**
@@ -160,6 +223,12 @@ int32_t adxcvr_remove(struct adxcvr *xcvr);
 int adxcvr_clk_set_rate(struct adxcvr *xcvr,
 			unsigned long rate,
 			unsigned long parent_rate);
+/** AXI ADXCVR Store a lane eye-scan result for the current lane rate */
+int adxcvr_eye_store(struct adxcvr *xcvr, uint32_t lane,
+		     const struct adxcvr_eye *eye);
+/** AXI ADXCVR Get the stored lane eye-scan result for the current lane rate */
+int adxcvr_eye_get(struct adxcvr *xcvr, uint32_t lane,
+		   struct adxcvr_eye *eye);
 /** AXI ADXCVR Write */
 int32_t adxcvr_write(struct adxcvr *xcvr, uint32_t reg_addr, uint32_t reg_val);
 /** AXI ADXCVR Read */
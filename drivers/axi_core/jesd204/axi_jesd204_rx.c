@@ -293,6 +293,27 @@ uint32_t axi_jesd204_rx_status_read(struct axi_jesd204_rx *jesd)
 	return 0;
 }
 
+/**
+ * @brief Get the JESD204 RX link status as a string.
+ * @param jesd - The device structure.
+ * @return The link status, "disabled" if the link isn't enabled.
+ */
+const char *axi_jesd204_rx_link_status_str(struct axi_jesd204_rx *jesd)
+{
+	uint32_t link_disabled;
+	uint32_t link_status;
+
+	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LINK_STATE, &link_disabled);
+	if (link_disabled & 0x1)
+		return "disabled";
+
+	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LINK_STATUS, &link_status);
+
+	return (jesd->encoder == JESD204_ENCODER_8B10B) ?
+	       axi_jesd204_rx_link_status_label[link_status & 0x3] :
+	       axi_jesd204_rx_link_status_64b66b_l[link_status & 0x3];
+}
+
 /**
  * @brief Read the JESD204 RX Lane Errors.
  * @param jesd - The JESD204 RX Device Structure.
@@ -451,7 +472,7 @@ bool axi_jesd204_rx_check_lane_status(struct axi_jesd204_rx *jesd,
 {
 	uint32_t status;
 	uint32_t errors;
-	char error_str[sizeof(" (4294967295 errors)")];
+	char error_str[sizeof(" (4294967295 errors)")] = "";
 
 	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LANE_STATUS(lane), &status);
 
@@ -508,6 +529,88 @@ int32_t axi_jesd204_rx_watchdog(struct axi_jesd204_rx *jesd)
 	return 0;
 }
 
+/**
+ * @brief Accumulate the lane error counters of the peripheral.
+ * The hardware counters are cleared when the link is enabled again, so the
+ * totals keep counting across link restarts.
+ * @param jesd - The device structure.
+ * @return None.
+ */
+static void axi_jesd204_rx_update_lane_errors(struct axi_jesd204_rx *jesd)
+{
+	uint32_t errors;
+	uint32_t i;
+
+	if (PCORE_VERSION_MINOR(jesd->version) < 2)
+		return;
+
+	for (i = 0; i < no_os_min(jesd->num_lanes, AXI_JESD204_RX_MAX_LANES); i++) {
+		axi_jesd204_rx_read(jesd, JESD204_RX_REG_LANE_ERRORS(i), &errors);
+		if (errors >= jesd->lane_errors_last[i])
+			jesd->lane_errors[i] += errors - jesd->lane_errors_last[i];
+		else
+			jesd->lane_errors[i] += errors;
+		jesd->lane_errors_last[i] = errors;
+	}
+}
+
+/**
+ * @brief JESD204 RX link health monitor, to be called periodically.
+ * The lane status is only checked while the link reports DATA. On a link drop
+ * or a lane losing sync, the link is rebuilt through the JESD204 FSM when the
+ * peripheral was initialized with axi_jesd204_rx_init(), without touching the
+ * rest of the topology. Otherwise the link is disabled and enabled again, like
+ * the watchdog does.
+ * @param jesd - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t axi_jesd204_rx_monitor(struct axi_jesd204_rx *jesd)
+{
+	uint32_t link_disabled;
+	uint32_t link_status;
+	uint32_t desync = 0;
+	uint32_t i;
+	int32_t ret;
+
+	if (!jesd)
+		return -EINVAL;
+
+	axi_jesd204_rx_update_lane_errors(jesd);
+
+	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LINK_STATE, &link_disabled);
+	if (link_disabled & 0x1)
+		return 0;
+
+	axi_jesd204_rx_read(jesd, JESD204_RX_REG_LINK_STATUS, &link_status);
+	link_status &= 0x3;
+	if (link_status == JESD204_LINK_STATUS_DATA) {
+		for (i = 0; i < no_os_min(jesd->num_lanes, AXI_JESD204_RX_MAX_LANES); i++)
+			if (axi_jesd204_rx_check_lane_status(jesd, i))
+				desync |= NO_OS_BIT(i);
+	} else {
+		pr_warning("%s: Link%"PRIu32" dropped (%s), restarting link\n",
+			   jesd->name, jesd->link_id,
+			   (jesd->encoder == JESD204_ENCODER_8B10B) ?
+			   axi_jesd204_rx_link_status_label[link_status] :
+			   axi_jesd204_rx_link_status_64b66b_l[link_status]);
+	}
+
+	jesd->lane_desync_mask = desync;
+	if (link_status == JESD204_LINK_STATUS_DATA && !desync)
+		return 0;
+
+	jesd->link_restarts++;
+	if (jesd->jdev)
+		return jesd204_fsm_link_restart(jesd->jdev, jesd->link_id);
+
+	ret = axi_jesd204_rx_write(jesd, JESD204_RX_REG_LINK_DISABLE, 0x1);
+	if (ret)
+		return ret;
+	no_os_mdelay(100);
+
+	return axi_jesd204_rx_write(jesd, JESD204_RX_REG_LINK_DISABLE, 0x0);
+}
+
 /**
  * @brief Apply the JESD204 RX configuration.
  * @param jesd - The device structure.
@@ -641,6 +744,8 @@ static int axi_jesd204_rx_jesd204_link_pre_setup(struct jesd204_dev *jdev,
 	pr_debug("%s:%d link_num %u reason %s\n", __func__, __LINE__,
 		 lnk->link_id, jesd204_state_op_reason_str(reason));
 
+	jesd->link_id = lnk->link_id;
+
 	ret = jesd204_link_get_device_clock(lnk, &link_rate);
 	pr_debug("%s: Link%u device clock rate %lu (%d)\n",
 		 __func__, lnk->link_id, link_rate, ret);
@@ -47,6 +47,11 @@
 #include "jesd204.h"
 #include "no_os_clk.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define AXI_JESD204_RX_MAX_LANES	32
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -85,6 +90,16 @@ struct axi_jesd204_rx {
 	struct no_os_clk_desc *lane_clk;
 	/** JESD204 FSM device */
 	struct jesd204_dev *jdev;
+	/** Link ID in the JESD204 topology */
+	uint32_t link_id;
+	/** Lane errors counted by axi_jesd204_rx_monitor() */
+	uint32_t lane_errors[AXI_JESD204_RX_MAX_LANES];
+	/** Last value of the hardware lane error counters */
+	uint32_t lane_errors_last[AXI_JESD204_RX_MAX_LANES];
+	/** Lanes found out of sync by the last axi_jesd204_rx_monitor() */
+	uint32_t lane_desync_mask;
+	/** Link restarts done by axi_jesd204_rx_monitor() */
+	uint32_t link_restarts;
 };
 
 /**
@@ -113,6 +128,12 @@ struct jesd204_rx_init {
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
+/** JESD204 RX AXI Data Write */
+int32_t axi_jesd204_rx_write(struct axi_jesd204_rx *jesd,
+			     uint32_t reg_addr, uint32_t reg_val);
+/** JESD204 RX AXI Data Read */
+int32_t axi_jesd204_rx_read(struct axi_jesd204_rx *jesd,
+			    uint32_t reg_addr, uint32_t *reg_val);
 /** JESD204 RX Lane Clock Enable */
 int32_t axi_jesd204_rx_lane_clk_enable(struct axi_jesd204_rx *jesd);
 /** JESD204 RX Lane Clock Disable */
@@ -124,6 +145,13 @@ int32_t axi_jesd204_rx_laneinfo_read(struct axi_jesd204_rx *jesd,
 				     uint32_t lane);
 /** JESD204 RX Watchdog */
 int32_t axi_jesd204_rx_watchdog(struct axi_jesd204_rx *jesd);
+/** JESD204 RX Link Status */
+const char *axi_jesd204_rx_link_status_str(struct axi_jesd204_rx *jesd);
+/** JESD204 RX link health monitor */
+int32_t axi_jesd204_rx_monitor(struct axi_jesd204_rx *jesd);
+/** JESD204 RX Lane Errors */
+int32_t axi_jesd204_rx_get_lane_errors(struct axi_jesd204_rx *jesd,
+				       uint32_t lane, uint32_t *errors);
 /** Device initialization */
 int32_t axi_jesd204_rx_init_legacy(struct axi_jesd204_rx **jesd204,
 				   const struct jesd204_rx_init *init);
@@ -0,0 +1,139 @@
+/***************************************************************************//**
+ *   @file   iio_axi_jesd204_rx.c
+ *   @brief  IIO interface of the JESD204 RX link health monitor
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "no_os_util.h"
+#include "iio_axi_jesd204_rx.h"
+
+enum axi_jesd204_rx_iio_attr {
+	AXI_JESD204_RX_IIO_LANE_ERRORS,
+	AXI_JESD204_RX_IIO_LANE_DESYNC,
+};
+
+/**
+ * @brief Show the link restarts done by the monitor.
+ * @param device - The struct axi_jesd204_rx.
+ * @param buf - Output buffer.
+ * @param len - Size of the buffer.
+ * @param channel - Unused.
+ * @param priv - Unused.
+ * @return Length of the output, negative error code otherwise.
+ */
+static int axi_jesd204_rx_iio_show_restarts(void *device, char *buf,
+		uint32_t len, const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct axi_jesd204_rx *jesd = device;
+
+	return snprintf(buf, len, "%"PRIu32, jesd->link_restarts);
+}
+
+/**
+ * @brief Show one value per lane, space separated.
+ * @param device - The struct axi_jesd204_rx.
+ * @param buf - Output buffer.
+ * @param len - Size of the buffer.
+ * @param channel - Unused.
+ * @param priv - enum axi_jesd204_rx_iio_attr.
+ * @return Length of the output, negative error code otherwise.
+ */
+static int axi_jesd204_rx_iio_show_lanes(void *device, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
+{
+	struct axi_jesd204_rx *jesd = device;
+	uint32_t i, val;
+	int pos = 0;
+
+	buf[0] = '\0';
+	for (i = 0; i < no_os_min(jesd->num_lanes, AXI_JESD204_RX_MAX_LANES); i++) {
+		if (priv == AXI_JESD204_RX_IIO_LANE_ERRORS)
+			val = jesd->lane_errors[i];
+		else
+			val = !!(jesd->lane_desync_mask & NO_OS_BIT(i));
+
+		pos += snprintf(buf + pos, len - pos, i ? " %"PRIu32 : "%"PRIu32, val);
+		if ((uint32_t)pos >= len)
+			return len - 1;
+	}
+
+	return pos;
+}
+
+/**
+ * @brief Show the link status.
+ * @param device - The struct axi_jesd204_rx.
+ * @param buf - Output buffer.
+ * @param len - Size of the buffer.
+ * @param channel - Unused.
+ * @param priv - Unused.
+ * @return Length of the output, negative error code otherwise.
+ */
+static int axi_jesd204_rx_iio_show_status(void *device, char *buf, uint32_t len,
+		const struct iio_ch_info *channel, intptr_t priv)
+{
+	return snprintf(buf, len, "%s", axi_jesd204_rx_link_status_str(device));
+}
+
+static struct iio_attribute axi_jesd204_rx_iio_attrs[] = {
+	{
+		.name = "link_status",
+		.show = axi_jesd204_rx_iio_show_status,
+	},
+	{
+		.name = "link_restarts",
+		.show = axi_jesd204_rx_iio_show_restarts,
+	},
+	{
+		.name = "lane_errors",
+		.priv = AXI_JESD204_RX_IIO_LANE_ERRORS,
+		.show = axi_jesd204_rx_iio_show_lanes,
+	},
+	{
+		.name = "lane_desync",
+		.priv = AXI_JESD204_RX_IIO_LANE_DESYNC,
+		.show = axi_jesd204_rx_iio_show_lanes,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/** IIO Descriptor */
+struct iio_device const axi_jesd204_rx_iio_descriptor = {
+	.attributes = axi_jesd204_rx_iio_attrs,
+	.debug_reg_read = (int32_t (*)())axi_jesd204_rx_read,
+	.debug_reg_write = (int32_t (*)())axi_jesd204_rx_write,
+};
@@ -49,8 +49,10 @@ significant delays */
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sleep.h>
 #include <inttypes.h>
+#include <xil_cache.h>
 
 #include "axi_dmac.h"
 #include "no_os_axi_io.h"
@@ -64,6 +66,7 @@ significant delays */
 const struct no_os_spi_platform_ops spi_eng_platform_ops = {
 	.init = &spi_engine_init,
 	.write_and_read = &spi_engine_write_and_read,
+	.set_speed = &spi_engine_apply_speed,
 	.remove = &spi_engine_remove
 };
 
@@ -94,7 +97,7 @@ int32_t spi_engine_write(struct spi_engine_desc *desc,
 			 uint32_t reg_addr,
 			 uint32_t reg_data)
 {
-	no_os_axi_io_write(desc->spi_engine_baseaddr, reg_addr, reg_data);
+	no_os_axi_io_write32(desc->spi_engine_baseaddr, reg_addr, reg_data);
 
 	return 0;
 }
@@ -112,7 +115,7 @@ int32_t spi_engine_read(struct spi_engine_desc *desc,
 			uint32_t reg_addr,
 			uint32_t *reg_data)
 {
-	no_os_axi_io_read(desc->spi_engine_baseaddr, reg_addr, reg_data);
+	*reg_data = no_os_axi_io_read32(desc->spi_engine_baseaddr, reg_addr);
 	return 0;
 }
 
@@ -142,6 +145,31 @@ int32_t spi_engine_set_transfer_width(struct no_os_spi_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Set the number of SDI lanes received by the offload
+ *
+ * On multi lane cores, every read word is received on all the lanes at once
+ * and the offload stores one word per lane. The default of 1 only keeps the
+ * first lane.
+ * @param desc Decriptor containing SPI interface parameters
+ * @param lanes The number of lanes, at most the number of SDI lanes of the
+ * 	  engine
+ * @return 0 in case of success, -EINVAL otherwise
+ */
+int32_t spi_engine_set_sdi_lanes(struct no_os_spi_desc *desc, uint8_t lanes)
+{
+	struct spi_engine_desc	*desc_extra;
+
+	desc_extra = desc->extra;
+
+	if (!lanes || lanes > desc_extra->max_sdi_lanes)
+		return -EINVAL;
+
+	desc_extra->sdi_lanes = lanes;
+
+	return 0;
+}
+
 /**
  * @brief Set SPI engine clock frequency
  *
@@ -159,6 +187,34 @@ void spi_engine_set_speed(struct no_os_spi_desc *desc,
 			       (2 * speed_hz) - 1;
 }
 
+/**
+ * @brief Set SPI engine clock frequency, checked against the divider range
+ *
+ * A speed above ref_clk_hz / 2 runs at ref_clk_hz / 2.
+ * @param desc Decriptor containing SPI Engine's parameters
+ * @param speed_hz SPI engine transfer speed
+ * @return 0 in case of success, -EINVAL if the speed is below the slowest
+ * the divider can reach
+ */
+int32_t spi_engine_apply_speed(struct no_os_spi_desc *desc, uint32_t speed_hz)
+{
+	struct spi_engine_desc	*desc_extra;
+	uint32_t		div;
+
+	if (!desc || !speed_hz)
+		return -EINVAL;
+
+	desc_extra = desc->extra;
+
+	div = desc_extra->ref_clk_hz / (2 * speed_hz);
+	if (div > 256)
+		return -EINVAL;
+
+	desc_extra->clk_div = div ? div - 1 : 0;
+
+	return 0;
+}
+
 /**
  * @brief Set the number of words transfered in a single transaction
  *
@@ -665,7 +721,14 @@ int32_t spi_engine_init(struct no_os_spi_desc **desc,
 
 	/* Get current data width */
 	spi_engine_read(eng_desc, SPI_ENGINE_REG_DATA_WIDTH, &data_width);
-	eng_desc->max_data_width = data_width;
+	eng_desc->max_data_width = no_os_field_get(SPI_ENGINE_DATA_WIDTH_MSK,
+						   data_width);
+	eng_desc->max_sdi_lanes = no_os_field_get(SPI_ENGINE_NUM_OF_SDI_MSK,
+						  data_width);
+	/* Cores with a single SDI leave the lane count at 0 */
+	if (!eng_desc->max_sdi_lanes)
+		eng_desc->max_sdi_lanes = 1;
+	eng_desc->sdi_lanes = 1;
 
 	spi_engine_set_transfer_width(*desc, spi_engine_init->data_width);
 
@@ -748,6 +811,268 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 	return ret;
 }
 
+/**
+ * @brief Translate a program command to the word written in the command fifo
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param cmd Command, in the format used by spi_engine_write_cmd()
+ * @param word Command fifo word
+ * @return int32_t - 0 if the command is translated
+ *		   - -EINVAL if the command format is invalid
+ */
+static int32_t spi_engine_program_cmd(struct no_os_spi_desc *desc,
+				      uint32_t cmd, uint32_t *word)
+{
+	struct spi_engine_desc	*eng_desc = desc->extra;
+	uint8_t			engine_command;
+	uint8_t			modifier;
+	uint8_t			parameter;
+	uint32_t		sleep_div;
+	uint8_t			mask;
+
+	engine_command = (cmd >> 12) & 0x0F;
+	modifier = (cmd >> 8) & 0x0F;
+	parameter = cmd & 0xFF;
+
+	switch (engine_command) {
+	case SPI_ENGINE_INST_TRANSFER:
+		if (!parameter)
+			return -EINVAL;
+		/* The words number is zero based */
+		parameter = spi_get_words_number(eng_desc, parameter) - 1;
+		*word = SPI_ENGINE_CMD_TRANSFER(modifier, parameter);
+		break;
+	case SPI_ENGINE_INST_ASSERT:
+		mask = 0xFF;
+		if (!parameter)
+			mask ^= NO_OS_BIT(desc->chip_select);
+		*word = SPI_ENGINE_CMD_ASSERT(eng_desc->cs_delay, mask);
+		break;
+	case SPI_ENGINE_INST_SYNC_SLEEP:
+		if (modifier == SPI_ENGINE_MISC_SLEEP) {
+			spi_get_sleep_div(desc, parameter, &sleep_div);
+			*word = SPI_ENGINE_CMD_SLEEP(sleep_div);
+		} else {
+			*word = cmd;
+		}
+		break;
+	case SPI_ENGINE_INST_CONFIG:
+		*word = cmd;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Build a program, a sequence of SPI engine commands written to the
+ * engine as a whole by spi_engine_program_run(). The commands are translated
+ * once, with the clock divider, data width, mode and chip select of desc, so
+ * the program has to be built again if any of them changes.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param prog The new program
+ * @param cmds Commands of the program, as CS_LOW, WRITE(n), READ(n),
+ *	WRITE_READ(n), SLEEP(ns) or CS_HIGH. Can be a const table, it is not
+ *	used after the call.
+ * @param nb_cmds Number of commands
+ * @return int32_t - 0 on success
+ *		   - -EINVAL if a command is invalid
+ *		   - -ENOMEM if the memory allocation failed
+ */
+int32_t spi_engine_program_init(struct no_os_spi_desc *desc,
+				struct spi_engine_program **prog,
+				const uint32_t *cmds, uint32_t nb_cmds)
+{
+	struct spi_engine_desc		*eng_desc;
+	struct spi_engine_program	*p;
+	uint32_t			words;
+	uint32_t			i;
+	int32_t				ret;
+
+	if (!desc || !prog || !cmds || !nb_cmds)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+
+	p = (struct spi_engine_program *)no_os_calloc(1, sizeof(*p));
+	if (!p)
+		return -ENOMEM;
+
+	/* Clock divider, data width and mode, then the commands and a sync */
+	p->nb_cmds = nb_cmds + 4;
+	p->cmds = (uint32_t *)no_os_calloc(p->nb_cmds, sizeof(*p->cmds));
+	p->xfers = (uint16_t *)no_os_calloc(nb_cmds, sizeof(*p->xfers));
+	if (!p->cmds || !p->xfers) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	p->cmds[0] = SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CLK_DIV,
+					   eng_desc->clk_div);
+	p->cmds[1] = SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
+					   eng_desc->data_width);
+	p->cmds[2] = SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CONFIG,
+					   desc->mode);
+
+	for (i = 0; i < nb_cmds; i++) {
+		ret = spi_engine_program_cmd(desc, cmds[i], &p->cmds[i + 3]);
+		if (ret)
+			goto error;
+
+		if (((cmds[i] >> 12) & 0x0F) != SPI_ENGINE_INST_TRANSFER)
+			continue;
+
+		/* Direction and number of bytes of the transfer */
+		p->xfers[p->nb_xfers++] = cmds[i] & 0xFFF;
+		words = spi_get_words_number(eng_desc, cmds[i] & 0xFF);
+		if (cmds[i] & (SPI_ENGINE_INSTRUCTION_TRANSFER_W << 8))
+			p->nb_tx += words;
+		if (cmds[i] & (SPI_ENGINE_INSTRUCTION_TRANSFER_R << 8))
+			p->nb_rx += words;
+	}
+
+	p->tx = (uint32_t *)no_os_calloc(p->nb_tx + p->nb_rx, sizeof(*p->tx));
+	if (!p->tx && (p->nb_tx + p->nb_rx)) {
+		ret = -ENOMEM;
+		goto error;
+	}
+	p->rx = p->tx + p->nb_tx;
+
+	*prog = p;
+
+	return 0;
+
+error:
+	spi_engine_program_remove(p);
+
+	return ret;
+}
+
+/**
+ * @brief Run a program: write its commands and the tx words, wait for the end
+ * of the program and read the rx words. Only the sync id is updated between
+ * runs, the caller only rewrites the data words in prog->tx.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param prog The program
+ * @return int32_t This function allways returns 0
+ */
+int32_t spi_engine_program_run(struct no_os_spi_desc *desc,
+			       struct spi_engine_program *prog)
+{
+	struct spi_engine_desc	*eng_desc = desc->extra;
+	uint32_t		sync_id;
+	uint32_t		i;
+
+	/* The offload has to be disabled, as in spi_engine_write_and_read() */
+	if (eng_desc->offload_config) {
+		eng_desc->offload_config = OFFLOAD_DISABLED;
+		spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
+	}
+
+	prog->cmds[prog->nb_cmds - 1] = SPI_ENGINE_CMD_SYNC(_sync_id);
+
+	for (i = 0; i < prog->nb_cmds; i++)
+		spi_engine_write(eng_desc, SPI_ENGINE_REG_CMD_FIFO,
+				 prog->cmds[i]);
+
+	for (i = 0; i < prog->nb_tx; i++)
+		spi_engine_write(eng_desc, SPI_ENGINE_REG_SDO_DATA_FIFO,
+				 prog->tx[i]);
+
+	do {
+		spi_engine_read(eng_desc, SPI_ENGINE_REG_SYNC_ID, &sync_id);
+	} while (sync_id != _sync_id);
+	_sync_id++;
+
+	for (i = 0; i < prog->nb_rx; i++)
+		spi_engine_read(eng_desc, SPI_ENGINE_REG_SDI_DATA_FIFO,
+				&prog->rx[i]);
+
+	return 0;
+}
+
+/**
+ * @brief Run a program on a byte buffer, like spi_engine_write_and_read() does
+ * for a single transfer. The bytes of each transfer follow those of the
+ * previous one in data. The bytes of the write transfers are sent, those of
+ * the read transfers are overwritten with the received bytes.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param prog The program
+ * @param data Bytes of all the transfers of the program
+ * @return int32_t This function allways returns 0
+ */
+int32_t spi_engine_program_transfer(struct no_os_spi_desc *desc,
+				    struct spi_engine_program *prog,
+				    uint8_t *data)
+{
+	struct spi_engine_desc	*eng_desc = desc->extra;
+	uint8_t			word_len;
+	uint8_t			*d;
+	uint8_t			shift;
+	uint32_t		t, r;
+	uint32_t		i, j;
+	uint8_t			bytes;
+	int32_t			ret;
+
+	word_len = spi_get_word_lenght(eng_desc);
+
+	/* Pack the bytes into engine WORDS */
+	memset(prog->tx, 0, prog->nb_tx * sizeof(*prog->tx));
+	for (i = 0, t = 0, d = data; i < prog->nb_xfers; i++) {
+		bytes = prog->xfers[i] & 0xFF;
+		if (prog->xfers[i] & (SPI_ENGINE_INSTRUCTION_TRANSFER_W << 8)) {
+			for (j = 0; j < bytes; j++) {
+				shift = eng_desc->data_width - (j % word_len + 1) * 8;
+				prog->tx[t + j / word_len] |= d[j] << shift;
+			}
+			t += spi_get_words_number(eng_desc, bytes);
+		}
+		d += bytes;
+	}
+
+	ret = spi_engine_program_run(desc, prog);
+	if (ret)
+		return ret;
+
+	for (i = 0, r = 0, d = data; i < prog->nb_xfers; i++) {
+		bytes = prog->xfers[i] & 0xFF;
+		if (prog->xfers[i] & (SPI_ENGINE_INSTRUCTION_TRANSFER_R << 8)) {
+			for (j = 0; j < bytes; j++) {
+				shift = eng_desc->data_width - (j % word_len + 1) * 8;
+				d[j] = prog->rx[r + j / word_len] >> shift;
+			}
+			r += spi_get_words_number(eng_desc, bytes);
+		}
+		d += bytes;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources used by a program
+ *
+ * @param prog The program
+ * @return int32_t This function allways returns 0
+ */
+int32_t spi_engine_program_remove(struct spi_engine_program *prog)
+{
+	if (!prog)
+		return 0;
+
+	no_os_free(prog->cmds);
+	no_os_free(prog->xfers);
+	no_os_free(prog->tx);
+	no_os_free(prog);
+
+	return 0;
+}
+
 /**
  * @brief Initialize the SPI engine's offload module
  *
@@ -759,11 +1084,12 @@ int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 				const struct spi_engine_offload_init_param *param)
 {
 	struct spi_engine_desc	*eng_desc;
-	struct axi_dmac_init	dmac_init;
+	struct axi_dmac_init	dmac_init = {0};
 
 	eng_desc = desc->extra;
 
 	eng_desc->offload_config = param->offload_config;
+	dmac_init.irq_option = param->dma_irq_option;
 
 	if(!(param->dma_flags)) {
 		eng_desc->cyclic = CYCLIC;
@@ -794,29 +1120,22 @@ int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 }
 
 /**
- * @brief Initiate a SPI transfer in offload mode
+ * @brief Reset the offload module and load the commands and data of a message
  *
  * @param desc Decriptor containing SPI interface parameters
- * @param msg Offload message that get's to be transferred
- * @param no_samples Number of time the messages will be transferred
- * @return int32_t This function allways returns 0
+ * @param msg Offload message that get's loaded
+ * @return int32_t - 0 on success
+ *		   - -1 if the memory allocation failed
  */
-int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
-				    struct spi_engine_offload_message msg,
-				    uint32_t no_samples)
+static int32_t spi_engine_offload_load(struct no_os_spi_desc *desc,
+				       struct spi_engine_offload_message *msg)
 {
 	struct spi_engine_msg	transfer;
 	struct spi_engine_desc	*eng_desc;
 	uint32_t 		i;
-	uint8_t 		word_length;
 
 	eng_desc = desc->extra;
 
-	/* Check if offload is disabled */
-	if(!((eng_desc->offload_config & OFFLOAD_TX_EN) |
-	     (eng_desc->offload_config & OFFLOAD_RX_EN)))
-		return -1;
-
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 1);
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 0);
 
@@ -828,19 +1147,49 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 	if (!transfer.cmds)
 		return -1;
 
-	transfer.tx_buf = msg.commands_data;
+	transfer.tx_buf = msg->commands_data;
 
 	/* Load the commands into the message */
 	transfer.cmds->next = NULL;
-	transfer.cmds->cmd = msg.commands[0];
+	transfer.cmds->cmd = msg->commands[0];
 	i = 1;
-	while(i < msg.no_commands) {
-		spi_engine_queue_add_cmd(&transfer.cmds, msg.commands[i++]);
+	while(i < msg->no_commands) {
+		spi_engine_queue_add_cmd(&transfer.cmds, msg->commands[i++]);
 
 	}
 
 	spi_engine_transfer_message(desc, &transfer);
 
+	spi_engine_queue_no_os_free(&transfer.cmds);
+
+	return 0;
+}
+
+/**
+ * @brief Initiate a SPI transfer in offload mode
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msg Offload message that get's to be transferred
+ * @param no_samples Number of time the messages will be transferred
+ * @return int32_t This function allways returns 0
+ */
+int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
+				    struct spi_engine_offload_message msg,
+				    uint32_t no_samples)
+{
+	struct spi_engine_desc	*eng_desc;
+	uint8_t 		word_length;
+
+	eng_desc = desc->extra;
+
+	/* Check if offload is disabled */
+	if(!((eng_desc->offload_config & OFFLOAD_TX_EN) |
+	     (eng_desc->offload_config & OFFLOAD_RX_EN)))
+		return -1;
+
+	if (spi_engine_offload_load(desc, &msg))
+		return -1;
+
 	/* Start transfer */
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0001);
 
@@ -864,7 +1213,8 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 	if(eng_desc->offload_config & OFFLOAD_RX_EN) {
 		struct axi_dma_transfer rx_transfer = {
 			// Number of bytes to write/read
-			.size = word_length * eng_desc->offload_tx_len * no_samples,
+			.size = word_length * eng_desc->offload_tx_len * no_samples *
+			eng_desc->sdi_lanes,
 			// Transfer done flag
 			.transfer_done = 0,
 			// Signal transfer mode
@@ -880,7 +1230,208 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 
 	usleep(1000);
 
-	spi_engine_queue_no_os_free(&transfer.cmds);
+	return 0;
+}
+
+/**
+ * @brief Submit the next block of the offload stream to the RX DMAC, when the
+ *	  DMAC has no scatter-gather support.
+ *
+ * @param eng_desc Engine descriptor holding the stream state
+ * @return int32_t - 0 on success
+ *		   - negative error code otherwise
+ */
+static int32_t spi_engine_offload_stream_queue(struct spi_engine_desc *eng_desc)
+{
+	struct axi_dma_transfer rx_transfer = {
+		.size = eng_desc->stream_block_size,
+		.cyclic = NO,
+		.dest_addr = eng_desc->stream_addr + eng_desc->stream_block_size *
+			     (eng_desc->stream_queued % eng_desc->stream_nb_blocks)
+	};
+	int32_t ret;
+
+	ret = axi_dmac_transfer_queue(eng_desc->offload_rx_dma, &rx_transfer);
+	if (ret)
+		return ret;
+
+	eng_desc->stream_queued++;
+
+	return 0;
+}
+
+/**
+ * @brief Start an endless capture in offload mode. The offload module is
+ *	  triggered continuously and the RX DMAC fills a ring of nb_blocks
+ *	  blocks, starting at msg.rx_addr, without CPU involvement between
+ *	  samples. The ring may be the memory of an IIO input buffer: when its
+ *	  size is nb_blocks * block_size, each block returned by
+ *	  spi_engine_offload_stream_wait() is the one iio_buffer_get_block()
+ *	  hands out, to be released with iio_buffer_block_done().
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msg Offload message transferred on each trigger
+ * @param block_size Size of a block in bytes
+ * @param nb_blocks Number of blocks in the ring
+ * @return int32_t - 0 on success
+ *		   - negative error code otherwise
+ */
+int32_t spi_engine_offload_stream_start(struct no_os_spi_desc *desc,
+					struct spi_engine_offload_message msg,
+					uint32_t block_size, uint32_t nb_blocks)
+{
+	struct axi_dma_transfer	rx_transfer = {0};
+	struct axi_dma_segment	*segs;
+	struct spi_engine_desc	*eng_desc;
+	struct axi_dmac		*dmac;
+	uint32_t		nb_descs;
+	uint32_t		i;
+	int32_t			ret;
+
+	if (!desc || !block_size || nb_blocks < 2)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+	dmac = eng_desc->offload_rx_dma;
+	if (!(eng_desc->offload_config & OFFLOAD_RX_EN) || !dmac ||
+	    dmac->irq_option != IRQ_ENABLED)
+		return -ENOTSUP;
+
+	eng_desc->stream_addr = msg.rx_addr;
+	eng_desc->stream_block_size = block_size;
+	eng_desc->stream_nb_blocks = nb_blocks;
+	eng_desc->stream_done = dmac->blocks_done;
+	eng_desc->stream_queued = 0;
+
+	if (dmac->hw_sg) {
+		segs = no_os_calloc(nb_blocks, sizeof(*segs));
+		if (!segs)
+			return -ENOMEM;
+
+		for (i = 0; i < nb_blocks; i++) {
+			segs[i].size = block_size;
+			segs[i].dest_addr = msg.rx_addr + i * block_size;
+		}
+
+		nb_descs = nb_blocks * NO_OS_DIV_ROUND_UP(block_size,
+							  dmac->max_length + 1);
+		eng_desc->stream_descs_mem = no_os_calloc(nb_descs + 1,
+							  sizeof(struct axi_dmac_sg_desc));
+		if (!eng_desc->stream_descs_mem) {
+			no_os_free(segs);
+			return -ENOMEM;
+		}
+		eng_desc->stream_descs = (struct axi_dmac_sg_desc *)
+					 (((uintptr_t)eng_desc->stream_descs_mem +
+					   sizeof(struct axi_dmac_sg_desc) - 1) &
+					  ~(uintptr_t)(sizeof(struct axi_dmac_sg_desc) - 1));
+
+		rx_transfer.cyclic = CYCLIC;
+		ret = axi_dmac_sg_prepare(dmac, &rx_transfer, eng_desc->stream_descs,
+					  nb_descs, segs, nb_blocks);
+		no_os_free(segs);
+		if (ret)
+			goto free_descs;
+
+		/* The DMAC fetches the descriptors from memory */
+		Xil_DCacheFlushRange((uintptr_t)eng_desc->stream_descs,
+				     nb_descs * sizeof(struct axi_dmac_sg_desc));
+		ret = axi_dmac_transfer_start(dmac, &rx_transfer);
+	} else {
+		/* Keep one block queued behind the running one. */
+		ret = spi_engine_offload_stream_queue(eng_desc);
+		if (!ret)
+			ret = spi_engine_offload_stream_queue(eng_desc);
+	}
+	if (ret)
+		goto stop_dma;
+
+	ret = spi_engine_offload_load(desc, &msg);
+	if (ret)
+		goto stop_dma;
+
+	/* Start the offload, it runs on each trigger until stopped */
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0001);
+
+	return 0;
+
+stop_dma:
+	axi_dmac_transfer_stop(dmac);
+free_descs:
+	no_os_free(eng_desc->stream_descs_mem);
+	eng_desc->stream_descs_mem = NULL;
+	eng_desc->stream_descs = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Wait for the next block of the offload stream to be filled. The block
+ *	  may be processed until the ring comes around to it again.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param block_addr Address of the filled block
+ * @param timeout_ms Number of ms to wait for the block
+ * @return int32_t - 0 on success
+ *		   - negative error code otherwise
+ */
+int32_t spi_engine_offload_stream_wait(struct no_os_spi_desc *desc,
+				       uint32_t *block_addr,
+				       uint32_t timeout_ms)
+{
+	struct spi_engine_desc	*eng_desc;
+	uint32_t		block;
+	int32_t			ret;
+
+	if (!desc || !block_addr)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+	if (!eng_desc->stream_nb_blocks)
+		return -EINVAL;
+
+	block = eng_desc->stream_done;
+	ret = axi_dmac_transfer_wait_block(eng_desc->offload_rx_dma,
+					   &eng_desc->stream_done, timeout_ms);
+	if (ret)
+		return ret;
+
+	if (!eng_desc->stream_descs) {
+		ret = spi_engine_offload_stream_queue(eng_desc);
+		if (ret)
+			return ret;
+	}
+
+	*block_addr = eng_desc->stream_addr + eng_desc->stream_block_size *
+		      (block % eng_desc->stream_nb_blocks);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the offload stream started by spi_engine_offload_stream_start().
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @return int32_t - 0 on success
+ *		   - negative error code otherwise
+ */
+int32_t spi_engine_offload_stream_stop(struct no_os_spi_desc *desc)
+{
+	struct spi_engine_desc	*eng_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0000);
+	if (eng_desc->offload_rx_dma)
+		axi_dmac_transfer_stop(eng_desc->offload_rx_dma);
+
+	no_os_free(eng_desc->stream_descs_mem);
+	eng_desc->stream_descs_mem = NULL;
+	eng_desc->stream_descs = NULL;
+	eng_desc->stream_nb_blocks = 0;
 
 	return 0;
 }
@@ -135,9 +135,51 @@ struct spi_engine_desc {
 	uint8_t			data_width;
 	/** The maximum data width supported by the engine */
 	uint8_t 		max_data_width;
+	/** Number of SDI lanes stored by the offload for each read word */
+	uint8_t			sdi_lanes;
+	/** Number of SDI lanes of the engine */
+	uint8_t			max_sdi_lanes;
+	/** Descriptor ring used by the offload stream, NULL if not needed */
+	struct axi_dmac_sg_desc	*stream_descs;
+	/** Allocation holding stream_descs, which must be aligned */
+	void			*stream_descs_mem;
+	/** Address of the offload stream ring */
+	uint32_t		stream_addr;
+	/** Size of one offload stream block in bytes */
+	uint32_t		stream_block_size;
+	/** Number of blocks in the offload stream ring */
+	uint32_t		stream_nb_blocks;
+	/** Number of offload stream blocks waited for */
+	uint32_t		stream_done;
+	/** Number of offload stream blocks submitted to the DMAC */
+	uint32_t		stream_queued;
 };
 
 
+/**
+ * @struct spi_engine_program
+ * @brief  Sequence of SPI engine commands built once by
+ * spi_engine_program_init() and run as a whole by spi_engine_program_run()
+ */
+struct spi_engine_program {
+	/** Words written to the command fifo, the last one is the sync */
+	uint32_t	*cmds;
+	/** Number of words in cmds */
+	uint32_t	nb_cmds;
+	/** Direction and number of bytes of each transfer */
+	uint16_t	*xfers;
+	/** Number of transfers */
+	uint32_t	nb_xfers;
+	/** Words sent by the write transfers, set before each run */
+	uint32_t	*tx;
+	/** Number of words in tx */
+	uint32_t	nb_tx;
+	/** Words received by the read transfers of the last run */
+	uint32_t	*rx;
+	/** Number of words in rx */
+	uint32_t	nb_rx;
+};
+
 /**
  * @struct spi_engine_offload_init_param
  * @brief  Structure containing the init parameters needed by the offload module
@@ -151,6 +193,11 @@ struct spi_engine_offload_init_param {
 	uint32_t	*dma_flags;
 	/** Offload's module transfer direction : TX, RX or both */
 	uint8_t		offload_config;
+	/**
+	 * Whether the DMAC interrupts are used. Required by the offload stream,
+	 * the user has to connect the DMAC ISR.
+	 */
+	enum use_irq	dma_irq_option;
 };
 
 /**
@@ -203,6 +250,23 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 /* Free the resources used by the SPI engine device */
 int32_t spi_engine_remove(struct no_os_spi_desc *desc);
 
+/* Build a program from a sequence of SPI engine commands */
+int32_t spi_engine_program_init(struct no_os_spi_desc *desc,
+				struct spi_engine_program **prog,
+				const uint32_t *cmds, uint32_t nb_cmds);
+
+/* Run a program with the words in prog->tx */
+int32_t spi_engine_program_run(struct no_os_spi_desc *desc,
+			       struct spi_engine_program *prog);
+
+/* Run a program on a byte buffer holding the bytes of all its transfers */
+int32_t spi_engine_program_transfer(struct no_os_spi_desc *desc,
+				    struct spi_engine_program *prog,
+				    uint8_t *data);
+
+/* Free the resources used by a program */
+int32_t spi_engine_program_remove(struct spi_engine_program *prog);
+
 /* Initialize the SPI engine offload module */
 int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 				const struct spi_engine_offload_init_param *param);
@@ -212,12 +276,31 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 				    struct spi_engine_offload_message msg,
 				    uint32_t no_samples);
 
+/* Start an endless offload capture into a ring of blocks */
+int32_t spi_engine_offload_stream_start(struct no_os_spi_desc *desc,
+					struct spi_engine_offload_message msg,
+					uint32_t block_size, uint32_t nb_blocks);
+
+/* Wait for the next block of the offload stream */
+int32_t spi_engine_offload_stream_wait(struct no_os_spi_desc *desc,
+				       uint32_t *block_addr,
+				       uint32_t timeout_ms);
+
+/* Stop the offload stream */
+int32_t spi_engine_offload_stream_stop(struct no_os_spi_desc *desc);
+
 /* Set SPI transfer width */
 int32_t spi_engine_set_transfer_width(struct no_os_spi_desc *desc,
 				      uint8_t data_wdith);
 
+/* Set the number of SDI lanes received by the offload */
+int32_t spi_engine_set_sdi_lanes(struct no_os_spi_desc *desc, uint8_t lanes);
+
 /* Set SPI transfer speed */
 void spi_engine_set_speed(struct no_os_spi_desc *desc,
 			  uint32_t speed_hz);
 
+/* Set SPI transfer speed, failing if the clock divider can't reach it */
+int32_t spi_engine_apply_speed(struct no_os_spi_desc *desc, uint32_t speed_hz);
+
 #endif // SPI_ENGINE_H
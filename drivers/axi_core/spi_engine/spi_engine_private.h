@@ -90,6 +90,8 @@
 #define SPI_ENGINE_CONFIG_CPHA			NO_OS_BIT(0)
 #define SPI_ENGINE_CONFIG_CPOL			NO_OS_BIT(1)
 #define SPI_ENGINE_CONFIG_3WIRE			NO_OS_BIT(2)
+#define SPI_ENGINE_DATA_WIDTH_MSK		NO_OS_GENMASK(15, 0)
+#define SPI_ENGINE_NUM_OF_SDI_MSK		NO_OS_GENMASK(23, 16)
 #define SPI_ENGINE_VERSION_MAJOR(x) 		((x >> 16) & 0xff)
 #define SPI_ENGINE_VERSION_MINOR(x) 		((x >> 8) & 0xff)
 #define SPI_ENGINE_VERSION_PATCH(x) 		(x & 0xff)
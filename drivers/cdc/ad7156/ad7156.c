@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include "ad7156.h"
 #include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -111,12 +113,20 @@ int8_t ad7156_init(struct ad7156_dev **device,
 	int8_t status = -1;
 	uint8_t test = 0;
 
-	dev = (struct ad7156_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad7156_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
 	dev->ad7156_channel1_range = init_param.ad7156_channel1_range;
 	dev->ad7156_channel2_range = init_param.ad7156_channel2_range;
+	dev->ts_timer = init_param.ts_timer;
+
+	if (init_param.ring_depth &&
+	    no_os_lfring_init(&dev->ring, sizeof(struct ad7156_sample),
+			      init_param.ring_depth, false)) {
+		no_os_free(dev);
+		return -1;
+	}
 
 	status = no_os_i2c_init(&dev->i2c_desc, &init_param.i2c_init);
 	ad7156_get_register_value(dev,
@@ -145,6 +155,7 @@ int32_t ad7156_remove(struct ad7156_dev *dev)
 
 	status = no_os_i2c_remove(dev->i2c_desc);
 
+	no_os_lfring_remove(dev->ring);
 	no_os_free(dev);
 
 	return status;
@@ -557,3 +568,119 @@ float ad7156_wait_read_channel_capacitance(struct ad7156_dev *dev,
 
 	return p_fdata;
 }
+
+/***************************************************************************//**
+ * @brief Starts the continuous conversions. The part has no conversion ready
+ *        pin, so the results are read by ad7156_cont_poll(), called from a
+ *        periodic timer interrupt at least as fast as the conversion rate.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7156_cont_start(struct ad7156_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->ring)
+		return -ENOTSUP;
+
+	no_os_lfring_flush(dev->ring);
+	dev->cont_overruns = 0;
+	dev->cont_errors = 0;
+
+	ad7156_set_power_mode(dev, AD7156_CONV_MODE_CONT_CONV);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Stops the continuous conversions. The conversions left in the ring
+ *        can still be read.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7156_cont_stop(struct ad7156_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	ad7156_set_power_mode(dev, AD7156_CONV_MODE_IDLE);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Reads the status and the data of both channels in one I2C transfer
+ *        and stores them in the ring if a channel has a new result. Reading
+ *        the data registers sets the RDY bits back.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 1 if a conversion was stored, 0 if there was none, negative error
+ *         code otherwise.
+*******************************************************************************/
+int32_t ad7156_cont_poll(struct ad7156_dev *dev)
+{
+	uint8_t reg = AD7156_REG_STATUS;
+	uint8_t buf[AD7156_CONT_BURST_LEN];
+	struct no_os_i2c_msg msgs[2] = {
+		{ .buf = &reg, .len = 1 },
+		{ .buf = buf, .len = AD7156_CONT_BURST_LEN, .flags = NO_OS_I2C_M_RD },
+	};
+	struct ad7156_sample sample;
+	int32_t ret;
+
+	if (!dev || !dev->ring)
+		return -EINVAL;
+
+	sample.timestamp = 0;
+	if (dev->ts_timer)
+		no_os_timer_get_elapsed_time_nsec(dev->ts_timer, &sample.timestamp);
+
+	ret = no_os_i2c_transfer(dev->i2c_desc, msgs, 2);
+	if (ret) {
+		dev->cont_errors++;
+		return ret;
+	}
+
+	sample.status = buf[AD7156_REG_STATUS];
+	if ((sample.status & (AD7156_STATUS_RDY1 | AD7156_STATUS_RDY2)) ==
+	    (AD7156_STATUS_RDY1 | AD7156_STATUS_RDY2))
+		return 0;
+
+	sample.data[0] = no_os_get_unaligned_be16(&buf[AD7156_REG_CH1_DATA_H]);
+	sample.data[1] = no_os_get_unaligned_be16(&buf[AD7156_REG_CH2_DATA_H]);
+
+	if (!no_os_lfring_push(dev->ring, &sample, 1)) {
+		dev->cont_overruns++;
+		return -ENOSPC;
+	}
+
+	return 1;
+}
+
+/***************************************************************************//**
+ * @brief Takes the conversions stored by ad7156_cont_poll(), oldest first.
+ *
+ * @param dev        - The device structure.
+ * @param samples    - Where to store the conversions.
+ * @param nb_samples - Maximum number of conversions to take.
+ *
+ * @return Number of conversions taken, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7156_cont_read(struct ad7156_dev *dev,
+			 struct ad7156_sample *samples,
+			 uint32_t nb_samples)
+{
+	if (!dev || !samples)
+		return -EINVAL;
+
+	if (!dev->ring)
+		return -ENOTSUP;
+
+	return no_os_lfring_pop(dev->ring, samples, nb_samples);
+}
@@ -44,6 +44,8 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_i2c.h"
+#include "no_os_timer.h"
+#include "no_os_lfring.h"
 
 /******************************************************************************/
 /*************************** AD7156 Definitions *******************************/
@@ -149,16 +151,36 @@
 #define AD7156_CHANNEL1                 1
 #define AD7156_CHANNEL2                 2
 
+/*!< Status and data registers, read in one burst by the continuous mode */
+#define AD7156_CONT_BURST_LEN           (AD7156_REG_CH2_DATA_L + 1)
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/* Conversions read by the continuous mode */
+struct ad7156_sample {
+	/* Time of the read in ns, 0 without a timestamp timer */
+	uint64_t timestamp;
+	/* Channel 1 and channel 2 data registers */
+	uint16_t data[2];
+	/* Status register, RDY1/RDY2 are low for the new results */
+	uint8_t status;
+};
+
 struct ad7156_dev {
 	/* I2C */
 	struct no_os_i2c_desc	*i2c_desc;
 	/* Device Settings */
 	float ad7156_channel1_range;
 	float ad7156_channel2_range;
+	/* Continuous mode */
+	struct no_os_timer_desc	*ts_timer;
+	struct no_os_lfring	*ring;
+	/* Conversions dropped because the ring was full */
+	uint32_t		cont_overruns;
+	/* Polls that failed on an I2C error */
+	uint32_t		cont_errors;
 };
 
 struct ad7156_init_param {
@@ -167,6 +189,11 @@ struct ad7156_init_param {
 	/* Device Settings */
 	float ad7156_channel1_range;
 	float ad7156_channel2_range;
+	/* Optional running timer, timestamps the conversions */
+	struct no_os_timer_desc		*ts_timer;
+	/* Conversions buffered by the continuous mode, power of 2. 0 if the
+	   continuous mode is not used */
+	uint32_t			ring_depth;
 };
 
 /******************************************************************************/
@@ -248,4 +275,19 @@ float ad7156_read_channel_capacitance(struct ad7156_dev *dev,
 float ad7156_wait_read_channel_capacitance(struct ad7156_dev *dev,
 		uint8_t channel);
 
+/*!< Starts the continuous conversions read by ad7156_cont_poll(). */
+int32_t ad7156_cont_start(struct ad7156_dev *dev);
+
+/*!< Stops the continuous conversions. */
+int32_t ad7156_cont_stop(struct ad7156_dev *dev);
+
+/*!< Reads the status and both results in one burst and stores the new
+    conversions. Meant to be called from a periodic timer interrupt. */
+int32_t ad7156_cont_poll(struct ad7156_dev *dev);
+
+/*!< Takes the conversions stored by ad7156_cont_poll(). */
+int32_t ad7156_cont_read(struct ad7156_dev *dev,
+			 struct ad7156_sample *samples,
+			 uint32_t nb_samples);
+
 #endif	/* __AD7156_H__ */
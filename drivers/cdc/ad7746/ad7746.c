@@ -44,6 +44,150 @@
 #include "no_os_alloc.h"
 #include "ad7746.h"
 
+/***************************************************************************//**
+ * @brief Completion of the burst read started by the RDY interrupt. Stores the
+ *        conversion in the ring.
+ *
+ * @param ctx - Device descriptor pointer.
+ * @param status - Result of the I2C transfer.
+*******************************************************************************/
+static void ad7746_cont_done(void *ctx, int32_t status)
+{
+	struct ad7746_dev *dev = ctx;
+	struct ad7746_sample sample;
+
+	if (status) {
+		dev->cont_errors++;
+		goto out;
+	}
+
+	sample.timestamp = dev->cont_ts;
+	sample.status = dev->cont_buf[AD7746_REG_STATUS];
+	sample.cap_data =
+		no_os_get_unaligned_be24(&dev->cont_buf[AD7746_REG_CAP_DATA_HIGH]);
+	sample.vt_data =
+		no_os_get_unaligned_be24(&dev->cont_buf[AD7746_REG_VT_DATA_HIGH]);
+
+	if (!no_os_lfring_push(dev->ring, &sample, 1))
+		dev->cont_overruns++;
+out:
+	dev->cont_busy = false;
+}
+
+/***************************************************************************//**
+ * @brief RDY falling edge handler of the continuous mode. Timestamps the
+ *        conversion and reads the status and both data registers in one
+ *        transfer, asynchronously when the I2C driver supports it. The read
+ *        of the data registers takes RDY back high.
+ *
+ * @param ctx - Device descriptor pointer.
+*******************************************************************************/
+static void ad7746_cont_isr(void *ctx)
+{
+	struct ad7746_dev *dev = ctx;
+	uint64_t ts = 0;
+	int32_t ret;
+
+	if (dev->ts_timer)
+		no_os_timer_get_elapsed_time_nsec(dev->ts_timer, &ts);
+
+	if (dev->cont_busy) {
+		dev->cont_overruns++;
+		return;
+	}
+
+	dev->cont_busy = true;
+	dev->cont_ts = ts;
+
+	if (!dev->cont_sync) {
+		ret = no_os_i2c_transfer_async(dev->i2c_dev, dev->cont_msgs, 2,
+					       ad7746_cont_done, dev);
+		if (ret != -ENOSYS) {
+			if (ret)
+				ad7746_cont_done(dev, ret);
+			return;
+		}
+		dev->cont_sync = true;
+	}
+
+	ret = no_os_i2c_transfer(dev->i2c_dev, dev->cont_msgs, 2);
+	ad7746_cont_done(dev, ret);
+}
+
+/***************************************************************************//**
+ * @brief Set up the optional RDY GPIO, its interrupt and the ring used by the
+ *        continuous mode. The interrupt is enabled by ad7746_cont_start().
+ *
+ * @param dev - Device descriptor pointer.
+ * @param init_param - Pointer to the configuration of the driver.
+ * @return ret - return code.
+*******************************************************************************/
+static int32_t ad7746_rdy_irq_init(struct ad7746_dev *dev,
+				   struct ad7746_init_param *init_param)
+{
+	int32_t ret;
+
+	dev->ts_timer = init_param->ts_timer;
+
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param->gpio_rdy);
+	if (ret)
+		return ret;
+
+	if (!dev->gpio_rdy || !init_param->irq_ctrl)
+		return 0;
+
+	ret = no_os_gpio_direction_input(dev->gpio_rdy);
+	if (ret)
+		goto error_gpio;
+
+	ret = no_os_lfring_init(&dev->ring, sizeof(struct ad7746_sample),
+				init_param->ring_depth ? init_param->ring_depth :
+				AD7746_CONT_RING_DEPTH, false);
+	if (ret)
+		goto error_gpio;
+
+	dev->reg_addr = AD7746_REG_STATUS;
+	dev->cont_msgs[0].buf = &dev->reg_addr;
+	dev->cont_msgs[0].len = 1;
+	dev->cont_msgs[1].buf = dev->cont_buf;
+	dev->cont_msgs[1].len = AD7746_CONT_BURST_LEN;
+	dev->cont_msgs[1].flags = NO_OS_I2C_M_RD;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = ad7746_cont_isr,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  dev->gpio_rdy->number, &dev->irq_cb);
+	if (ret)
+		goto error_ring;
+
+	ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+					  dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_irq;
+
+	dev->irq_ctrl = init_param->irq_ctrl;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl,
+				      dev->gpio_rdy->number, &dev->irq_cb);
+error_ring:
+	no_os_lfring_remove(dev->ring);
+	dev->ring = NULL;
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
+	dev->gpio_rdy = NULL;
+
+	return ret;
+}
+
 /***************************************************************************//**
  * @brief Initialize the ad7606 device structure.
  *
@@ -95,6 +239,10 @@ int32_t ad7746_init(struct ad7746_dev **device,
 	if (ret < 0)
 		goto error_2;
 
+	ret = ad7746_rdy_irq_init(dev, init_param);
+	if (ret < 0)
+		goto error_2;
+
 	*device = dev;
 
 	return 0;
@@ -189,6 +337,15 @@ int32_t ad7746_remove(struct ad7746_dev *dev)
 	if (!dev)
 		return 0;
 
+	if (dev->irq_ctrl) {
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		no_os_irq_unregister_callback(dev->irq_ctrl,
+					      dev->gpio_rdy->number,
+					      &dev->irq_cb);
+	}
+
+	no_os_gpio_remove(dev->gpio_rdy);
+	no_os_lfring_remove(dev->ring);
 	no_os_i2c_remove(dev->i2c_dev);
 	dev->i2c_dev = NULL;
 	no_os_free(dev);
@@ -559,3 +716,108 @@ int32_t ad7746_calibrate(struct ad7746_dev *dev, enum ad7746_md md)
 
 	return ret;
 }
+
+/***************************************************************************//**
+ * @brief Start the continuous mode. The part converts the enabled capacitive
+ *        and voltage/temperature channels continuously and each RDY falling
+ *        edge reads the results into the ring, so the status register is not
+ *        polled. The conversions are taken with ad7746_cont_read().
+ *
+ * @param dev - Device descriptor pointer.
+ *
+ * @return return code.
+ *         Example: -EINVAL - Wrong input values.
+ *                  -ENOTSUP - No RDY GPIO or interrupt controller.
+ *                  -EBUSY - Continuous mode already started.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7746_cont_start(struct ad7746_dev *dev)
+{
+	struct ad7746_config c;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->irq_ctrl)
+		return -ENOTSUP;
+
+	if (dev->cont_on)
+		return -EBUSY;
+
+	no_os_lfring_flush(dev->ring);
+	dev->cont_busy = false;
+	dev->cont_overruns = 0;
+	dev->cont_errors = 0;
+
+	c = dev->setup.config;
+	c.md = AD7746_MODE_CONT;
+	ret = ad7746_set_config(dev, c);
+	if (ret < 0)
+		return ret;
+
+	ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret < 0)
+		return ret;
+
+	dev->cont_on = true;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Stop the continuous mode and put the part in idle mode. The
+ *        conversions left in the ring can still be read.
+ *
+ * @param dev - Device descriptor pointer.
+ *
+ * @return return code.
+ *         Example: -EINVAL - Wrong input values.
+ *                  -ETIMEDOUT - The last read did not complete.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7746_cont_stop(struct ad7746_dev *dev)
+{
+	struct ad7746_config c;
+	int32_t ret, timeout = 100;
+
+	if (!dev || !dev->cont_on)
+		return -EINVAL;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+	if (ret < 0)
+		return ret;
+
+	dev->cont_on = false;
+
+	while (dev->cont_busy && timeout--)
+		no_os_udelay(100);
+	if (dev->cont_busy)
+		return -ETIMEDOUT;
+
+	c = dev->setup.config;
+	c.md = AD7746_MODE_IDLE;
+
+	return ad7746_set_config(dev, c);
+}
+
+/***************************************************************************//**
+ * @brief Take the conversions read by the continuous mode, oldest first.
+ *
+ * @param dev - Device descriptor pointer.
+ * @param samples - Where to store the conversions.
+ * @param nb_samples - Maximum number of conversions to take.
+ *
+ * @return Number of conversions taken, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7746_cont_read(struct ad7746_dev *dev, struct ad7746_sample *samples,
+			 uint32_t nb_samples)
+{
+	if (!dev || !samples)
+		return -EINVAL;
+
+	if (!dev->ring)
+		return -ENOTSUP;
+
+	return no_os_lfring_pop(dev->ring, samples, nb_samples);
+}
@@ -44,6 +44,10 @@
 #include <stdbool.h>
 #include "no_os_util.h"
 #include "no_os_i2c.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#include "no_os_lfring.h"
 
 /* AD7746 Slave Address */
 #define AD7746_ADDRESS			0x48
@@ -74,6 +78,11 @@
 
 #define AD7746_NUM_REGISTERS		(AD7746_REG_VOLT_GAINL + 1u)
 
+/* Status and data registers, read in one burst by the continuous mode */
+#define AD7746_CONT_BURST_LEN		(AD7746_REG_VT_DATA_LOW + 1u)
+/* Default number of conversions buffered by the continuous mode */
+#define AD7746_CONT_RING_DEPTH		32u
+
 /* AD7746_REG_STATUS bits */
 #define AD7746_STATUS_EXCERR_MSK	NO_OS_BIT(3)
 #define AD7746_STATUS_RDY_MSK		NO_OS_BIT(2)
@@ -180,10 +189,30 @@ struct ad7746_setup {
 	struct ad7746_config config;
 };
 
+/* Conversion read by the continuous mode */
+struct ad7746_sample {
+	/* Time of the RDY falling edge in ns, 0 without a timestamp timer */
+	uint64_t timestamp;
+	/* Capacitive data register */
+	uint32_t cap_data;
+	/* Voltage/temperature data register */
+	uint32_t vt_data;
+	/* Status register, RDYCAP/RDYVT are low for the new results */
+	uint8_t status;
+};
+
 struct ad7746_init_param {
 	struct no_os_i2c_init_param i2c_init;
 	enum ad7746_id id;
 	struct ad7746_setup setup;
+	/* Optional GPIO wired to RDY and its interrupt controller */
+	struct no_os_gpio_init_param *gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/* Optional running timer, timestamps the conversions */
+	struct no_os_timer_desc *ts_timer;
+	/* Conversions buffered by the continuous mode, power of 2. 0 for the
+	 * default */
+	uint32_t ring_depth;
 };
 
 struct ad7746_dev {
@@ -191,6 +220,25 @@ struct ad7746_dev {
 	enum ad7746_id id;
 	uint8_t buf[AD7746_NUM_REGISTERS + 1u];
 	struct ad7746_setup setup;
+	/* GPIO wired to RDY, used by the continuous mode */
+	struct no_os_gpio_desc *gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	struct no_os_callback_desc irq_cb;
+	struct no_os_timer_desc *ts_timer;
+	/* Continuous mode: conversions read from the RDY interrupt */
+	struct no_os_lfring *ring;
+	uint8_t reg_addr;
+	uint8_t cont_buf[AD7746_CONT_BURST_LEN];
+	struct no_os_i2c_msg cont_msgs[2];
+	uint64_t cont_ts;
+	volatile bool cont_busy;
+	bool cont_sync;
+	bool cont_on;
+	/* Conversions dropped because the ring was full or a read was still
+	 * in progress */
+	uint32_t cont_overruns;
+	/* Conversions dropped for an I2C error */
+	uint32_t cont_errors;
 };
 
 int32_t ad7746_init(struct ad7746_dev **device,
@@ -213,5 +261,9 @@ int32_t ad7746_set_volt_gain(struct ad7746_dev *dev, uint16_t gain);
 int32_t ad7746_get_vt_data(struct ad7746_dev *dev, uint32_t *vt_data);
 int32_t ad7746_get_cap_data(struct ad7746_dev *dev, uint32_t *cap_data);
 int32_t ad7746_calibrate(struct ad7746_dev *dev, enum ad7746_md md);
+int32_t ad7746_cont_start(struct ad7746_dev *dev);
+int32_t ad7746_cont_stop(struct ad7746_dev *dev);
+int32_t ad7746_cont_read(struct ad7746_dev *dev, struct ad7746_sample *samples,
+			 uint32_t nb_samples);
 
 #endif // _AD7746_H
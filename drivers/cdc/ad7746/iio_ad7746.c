@@ -170,6 +170,28 @@ static int32_t ad7746_select_channel(void *device,
 	return delay;
 }
 
+// convert a data register to the raw value of a channel
+static int32_t ad7746_iio_code_to_raw(enum iio_chan_type type, int16_t ch_num,
+				      uint32_t reg)
+{
+	int32_t value = (reg & 0xffffff) - 0x800000;
+
+	switch (type) {
+	case IIO_TEMP:
+		/*
+		* temperature in milli degrees Celsius
+		* T = ((*val / 2048) - 4096) * 1000
+		*/
+		return (value * 125) / 256;
+	case IIO_VOLTAGE:
+		if (ch_num == 1) /* supply_raw */
+			return value * 6;
+		return value;
+	default:
+		return value;
+	}
+}
+
 static int ad7746_iio_read_raw(void *device, char *buf, uint32_t len,
 			       const struct iio_ch_info *channel, intptr_t priv)
 {
@@ -179,6 +201,9 @@ static int ad7746_iio_read_raw(void *device, char *buf, uint32_t len,
 	uint32_t reg;
 	struct ad7746_config c;
 
+	if (desc->cont_on)
+		return -EBUSY;
+
 	ret = ad7746_select_channel(iiodev, channel);
 	if (ret < 0)
 		return ret;
@@ -197,37 +222,19 @@ static int ad7746_iio_read_raw(void *device, char *buf, uint32_t len,
 
 	switch (channel->type) {
 	case IIO_TEMP:
-		ret = ad7746_get_vt_data(desc, &reg);
-		if (ret < 0)
-			return ret;
-
-		value = (reg & 0xffffff) - 0x800000;
-		/*
-		* temperature in milli degrees Celsius
-		* T = ((*val / 2048) - 4096) * 1000
-		*/
-		value = (value * 125) / 256;
-		break;
 	case IIO_VOLTAGE:
 		ret = ad7746_get_vt_data(desc, &reg);
-		if (ret < 0)
-			return ret;
-
-		value = (reg & 0xffffff) - 0x800000;
-
-		if (channel->ch_num == 1) /* supply_raw */
-			value = value * 6;
 		break;
 	case IIO_CAPACITANCE:
 		ret = ad7746_get_cap_data(desc, &reg);
-		if (ret < 0)
-			return ret;
-
-		value = (reg & 0xffffff) - 0x800000;
 		break;
 	default:
 		return -EINVAL;
 	}
+	if (ret < 0)
+		return ret;
+
+	value = ad7746_iio_code_to_raw(channel->type, channel->ch_num, reg);
 
 	return iio_format_value(buf, len, IIO_VAL_INT, 1, &value);
 }
@@ -651,12 +658,30 @@ enum ad7746_chan {
 	TEMP_EXT,
 	CIN1,
 	CIN1_DIFF,
+	/* Before CIN2, which is dropped from the end for AD7745/AD7747 */
+	TIMESTAMP,
 	CIN2,
 	CIN2_DIFF,
 };
 
+static const struct scan_type ad7746_iio_scan_type = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.is_big_endian = false,
+};
+
+static const struct scan_type ad7746_iio_ts_scan_type = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.is_big_endian = false,
+};
+
 static struct iio_channel ad7746_channels[] = {
 	[VIN] = {
+		.scan_index = VIN,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_VOLTAGE,
 		.indexed = true,
 		.channel = 0,
@@ -665,6 +690,8 @@ static struct iio_channel ad7746_channels[] = {
 		.ch_out = false,
 	},
 	[VIN_VDD] = {
+		.scan_index = VIN_VDD,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_VOLTAGE,
 		.indexed = true,
 		.channel = 1,
@@ -673,6 +700,8 @@ static struct iio_channel ad7746_channels[] = {
 		.ch_out = false,
 	},
 	[TEMP_INT] = {
+		.scan_index = TEMP_INT,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_TEMP,
 		.indexed = true,
 		.channel = 0,
@@ -681,6 +710,8 @@ static struct iio_channel ad7746_channels[] = {
 		.ch_out = false,
 	},
 	[TEMP_EXT] = {
+		.scan_index = TEMP_EXT,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_TEMP,
 		.indexed = true,
 		.channel = 1,
@@ -689,6 +720,8 @@ static struct iio_channel ad7746_channels[] = {
 		.ch_out = false,
 	},
 	[CIN1] = {
+		.scan_index = CIN1,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_CAPACITANCE,
 		.indexed = true,
 		.channel = 0,
@@ -696,6 +729,8 @@ static struct iio_channel ad7746_channels[] = {
 		.ch_out = false,
 	},
 	[CIN1_DIFF] = {
+		.scan_index = CIN1_DIFF,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_CAPACITANCE,
 		.diferential = true,
 		.indexed = true,
@@ -705,7 +740,15 @@ static struct iio_channel ad7746_channels[] = {
 		.address = AD7746_CAPSETUP_CAPDIFF_MSK,
 		.ch_out = false,
 	},
+	[TIMESTAMP] = {
+		.ch_type = IIO_TIMESTAMP,
+		.scan_index = TIMESTAMP,
+		.scan_type = &ad7746_iio_ts_scan_type,
+		.ch_out = false,
+	},
 	[CIN2] = {
+		.scan_index = CIN2,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_CAPACITANCE,
 		.indexed = true,
 		.channel = 1,
@@ -714,6 +757,8 @@ static struct iio_channel ad7746_channels[] = {
 		.ch_out = false,
 	},
 	[CIN2_DIFF] = {
+		.scan_index = CIN2_DIFF,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_type = IIO_CAPACITANCE,
 		.diferential = true,
 		.indexed = true,
@@ -725,14 +770,127 @@ static struct iio_channel ad7746_channels[] = {
 	}
 };
 
+// fill the iio_ch_info of a channel of the table
+static void ad7746_iio_ch_info(uint32_t idx, struct iio_ch_info *info)
+{
+	info->ch_num = ad7746_channels[idx].channel;
+	info->ch_out = false;
+	info->type = ad7746_channels[idx].ch_type;
+	info->differential = ad7746_channels[idx].diferential;
+	info->address = ad7746_channels[idx].address;
+}
+
+// select the enabled channels and start the RDY driven conversions
+static int32_t ad7746_iio_pre_enable(void *device, uint32_t mask)
+{
+	struct ad7746_iio_dev *iiodev = (struct ad7746_iio_dev *)device;
+	struct ad7746_dev *desc = iiodev->ad7746_dev;
+	struct iio_ch_info vt_info, cap_info;
+	uint32_t vt_mask = mask & NO_OS_GENMASK(TEMP_EXT, VIN);
+	uint32_t cap_mask = mask & (NO_OS_GENMASK(CIN1_DIFF, CIN1) |
+				    NO_OS_GENMASK(CIN2_DIFF, CIN2));
+	struct ad7746_vt vt;
+	int32_t ret;
+
+	if (!desc->irq_ctrl)
+		return -ENOTSUP;
+
+	/* One capacitive and one voltage/temperature conversion at a time */
+	if (no_os_hweight32(vt_mask) > 1 || no_os_hweight32(cap_mask) > 1 ||
+	    !(vt_mask | cap_mask))
+		return -EINVAL;
+
+	if (vt_mask) {
+		ad7746_iio_ch_info(no_os_find_first_set_bit(vt_mask), &vt_info);
+		ret = ad7746_select_channel(iiodev, &vt_info);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (cap_mask) {
+		ad7746_iio_ch_info(no_os_find_first_set_bit(cap_mask), &cap_info);
+		ret = ad7746_select_channel(iiodev, &cap_info);
+		if (ret < 0)
+			return ret;
+
+		/* Selecting the capacitive channel disabled the VT one */
+		if (vt_mask) {
+			vt = desc->setup.vt;
+			vt.vten = true;
+			ret = ad7746_set_vt(desc, vt);
+			if (ret < 0)
+				return ret;
+		}
+	}
+
+	return ad7746_cont_start(desc);
+}
+
+static int32_t ad7746_iio_post_disable(void *device)
+{
+	struct ad7746_iio_dev *iiodev = (struct ad7746_iio_dev *)device;
+
+	return ad7746_cont_stop(iiodev->ad7746_dev);
+}
+
+// push the conversions read from the RDY interrupt, with their timestamps
+static int32_t ad7746_iio_submit(struct iio_device_data *iio_dev_data)
+{
+	struct ad7746_iio_dev *iiodev = iio_dev_data->dev;
+	struct ad7746_dev *desc = iiodev->ad7746_dev;
+	struct iio_buffer *buffer = iio_dev_data->buffer;
+	struct iio_scan_layout *layout = &buffer->layout;
+	struct ad7746_sample sample;
+	/* Largest scan: VT, timestamp, CIN2 and the padding to 8 bytes */
+	uint64_t scan[3];
+	uint8_t *p = (uint8_t *)scan;
+	uint32_t i, e, ch, timeout;
+	int32_t ret, value;
+
+	for (i = 0; i < buffer->samples; i++) {
+		timeout = 1000;
+		while (!(ret = ad7746_cont_read(desc, &sample, 1))) {
+			if (!timeout--)
+				return -ETIMEDOUT;
+			no_os_mdelay(1);
+		}
+		if (ret < 0)
+			return ret;
+
+		for (e = 0; e < layout->nb; e++) {
+			ch = layout->ch[e];
+			if (ch == TIMESTAMP) {
+				memcpy(&p[layout->offset[e]], &sample.timestamp,
+				       layout->bytes[e]);
+			} else {
+				value = ad7746_iio_code_to_raw(
+						ad7746_channels[ch].ch_type,
+						ad7746_channels[ch].channel,
+						ad7746_channels[ch].ch_type ==
+						IIO_CAPACITANCE ?
+						sample.cap_data : sample.vt_data);
+				memcpy(&p[layout->offset[e]], &value,
+				       layout->bytes[e]);
+			}
+		}
+
+		ret = iio_buffer_push_scan(buffer, scan);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
 static struct iio_device ad7746_iio_device = {
 	.num_ch = NO_OS_ARRAY_SIZE(ad7746_channels),
 	.channels = ad7746_channels,
 	.attributes = NULL,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
-	.pre_enable = NULL,
-	.post_disable = NULL,
+	.pre_enable = ad7746_iio_pre_enable,
+	.post_disable = ad7746_iio_post_disable,
+	.submit = ad7746_iio_submit,
 	.read_dev = NULL,
 	.debug_reg_read = (int32_t (*)())_ad7746_read_register2,
 	.debug_reg_write = (int32_t (*)())_ad7746_write_register2
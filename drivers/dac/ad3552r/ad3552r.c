@@ -1121,7 +1121,11 @@ int32_t ad3552r_init(struct ad3552r_desc **desc,
 	if (NO_OS_IS_ERR_VALUE(err))
 		goto err;
 
-	no_os_crc8_populate_msb(ldesc->crc_table, AD3552R_CRC_POLY);
+	ldesc->crc_table = no_os_crc8_get_table(AD3552R_CRC_POLY);
+	if (!ldesc->crc_table) {
+		err = -ENOMEM;
+		goto err_spi;
+	}
 
 	err = no_os_gpio_get_optional(&ldesc->reset,
 				      param->reset_gpio_param_optional);
@@ -1195,6 +1199,8 @@ err:
 
 int32_t ad3552r_remove(struct ad3552r_desc *desc)
 {
+	if (desc->stream)
+		ad3552r_stream_remove(desc);
 	if (desc->ldac)
 		no_os_gpio_remove(desc->ldac);
 	if (desc->reset)
@@ -1355,6 +1361,114 @@ int32_t ad3552r_write_samples(struct ad3552r_desc *desc, uint16_t *data,
 	return 0;
 }
 
+/*
+ * Each tick writes one frame: the codes of the streamed channels to the input
+ * registers when the PWM drives LDAC. Otherwise a single channel is written
+ * to its DAC register and both channels to the input registers followed by
+ * the software LDAC register, as ad3552r_write_all_channels() does.
+ */
+int32_t ad3552r_stream_init(struct ad3552r_desc *desc, uint32_t ch_mask,
+			    struct no_os_dac_stream_init_param *param)
+{
+	uint8_t ch, is_fast, nb_ch;
+
+	if (!desc || !param || desc->stream || !ch_mask ||
+	    ch_mask > AD3552R_MASK_ALL_CH)
+		return -EINVAL;
+
+	/* Frames are prepared once, without CRC */
+	if (desc->crc_en)
+		return -EINVAL;
+
+	ch = no_os_find_first_set_bit(ch_mask);
+	nb_ch = no_os_hweight32(ch_mask);
+	if (nb_ch == AD3552R_MAX_NUM_CH &&
+	    desc->ch_data[0].fast_en != desc->ch_data[1].fast_en)
+		return -EINVAL;
+
+	is_fast = desc->ch_data[ch].fast_en;
+	param->spi_desc = desc->spi;
+	param->ldac_pulse_ns = AD3552R_STREAM_LDAC_PULSE_NS;
+	param->frame_bytes = 1 + nb_ch * (is_fast ? 2 : 3);
+	if (nb_ch == AD3552R_MAX_NUM_CH && !param->ldac_pwm)
+		param->frame_bytes++;
+
+	desc->stream_ch_mask = ch_mask;
+	desc->stream_ldac = param->ldac_pwm;
+
+	return no_os_dac_stream_init(&desc->stream, param);
+}
+
+int32_t ad3552r_stream_write(struct ad3552r_desc *desc, const uint16_t *data)
+{
+	struct no_os_dac_stream *stream;
+	uint8_t ch, nb_ch, is_fast, instr, *frame, *p;
+	uint32_t i, j;
+	int32_t err;
+
+	if (!desc || !desc->stream || !data)
+		return -EINVAL;
+
+	stream = desc->stream;
+	err = no_os_dac_stream_get_block(stream, &frame);
+	if (NO_OS_IS_ERR_VALUE(err))
+		return err;
+
+	nb_ch = no_os_hweight32(desc->stream_ch_mask);
+	/* Both channels are written from the channel 1 address downwards */
+	ch = nb_ch == AD3552R_MAX_NUM_CH ? 1 :
+	     no_os_find_first_set_bit(desc->stream_ch_mask);
+	is_fast = desc->ch_data[ch].fast_en;
+	instr = ad3552r_get_code_reg_addr(ch, !desc->stream_ldac &&
+					  nb_ch == 1, is_fast);
+	instr &= AD3552R_ADDR_MASK;
+
+	for (i = 0; i < stream->block_samples; i++) {
+		p = frame;
+		*p++ = instr;
+		for (j = 0; j < nb_ch; j++) {
+			no_os_put_unaligned_be16(*data++, p);
+			p += 2;
+			if (!is_fast)
+				*p++ = 0;
+		}
+		if (nb_ch == AD3552R_MAX_NUM_CH && !desc->stream_ldac)
+			*p = AD3552R_MASK_ALL_CH;
+		frame += stream->frame_bytes;
+	}
+
+	return no_os_dac_stream_block_done(stream);
+}
+
+int32_t ad3552r_stream_start(struct ad3552r_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	return no_os_dac_stream_start(desc->stream);
+}
+
+int32_t ad3552r_stream_trigger(struct ad3552r_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	return no_os_dac_stream_trigger(desc->stream);
+}
+
+int32_t ad3552r_stream_remove(struct ad3552r_desc *desc)
+{
+	int32_t err;
+
+	if (!desc || !desc->stream)
+		return -EINVAL;
+
+	err = no_os_dac_stream_remove(desc->stream);
+	desc->stream = NULL;
+
+	return err;
+}
+
 #ifdef AD3552R_DEBUG
 
 int32_t ad3552r_get_status(struct ad3552r_desc *desc, uint32_t *status,
@@ -52,6 +52,7 @@
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
 #include "no_os_crc8.h"
+#include "no_os_dac_stream.h"
 
 /*****************************************************************************/
 /******************** Macros and Constants Definitions ***********************/
@@ -170,6 +171,10 @@
 #define AD3552R_STORAGE_BITS_FAST_MODE			16
 #define AD3552R_MAX_OFFSET				511
 #define AD3552R_LDAC_PULSE_US				1
+/* LDAC pulse of the stream PWM */
+#define AD3552R_STREAM_LDAC_PULSE_NS			100
+/* Largest frame of a stream sample, to size the ring */
+#define AD3552R_STREAM_MAX_FRAME			8
 #define AD3552R_BOTH_CH_SELECT			(NO_OS_BIT(0) | NO_OS_BIT(1))
 #define AD3552R_BOTH_CH_DESELECT		0x0
 
@@ -401,10 +406,16 @@ struct ad3552r_desc {
 	struct no_os_gpio_desc *ldac;
 	struct no_os_gpio_desc *reset;
 	struct ad3552r_ch_data ch_data[AD3552R_MAX_NUM_CH];
-	uint8_t crc_table[NO_OS_CRC8_TABLE_SIZE];
+	const uint8_t *crc_table;
 	uint8_t chip_id;
 	uint8_t crc_en : 1;
 	uint8_t is_simultaneous : 1;
+	/* Timer paced stream, NULL when not used */
+	struct no_os_dac_stream *stream;
+	/* Channels updated by the stream */
+	uint32_t stream_ch_mask;
+	/* Set if the stream PWM drives LDAC */
+	bool stream_ldac;
 };
 
 struct ad3552r_custom_output_range_cfg {
@@ -513,4 +524,20 @@ int32_t ad3552r_write_samples(struct ad3552r_desc *desc, uint16_t *data,
 			      enum ad3552r_write_mode mode);
 
 int32_t ad3552r_simulatneous_update_enable(struct ad3552r_desc *desc);
+
+/* Timer paced waveform output of the channels in ch_mask. The driver sets the
+ * frame fields of param, the ring is sized with AD3552R_STREAM_MAX_FRAME. */
+int32_t ad3552r_stream_init(struct ad3552r_desc *desc, uint32_t ch_mask,
+			    struct no_os_dac_stream_init_param *param);
+
+/* Queue one block of codes, interleaved when both channels are streamed.
+ * Returns -EAGAIN if the ring is full. */
+int32_t ad3552r_stream_write(struct ad3552r_desc *desc, const uint16_t *data);
+
+int32_t ad3552r_stream_start(struct ad3552r_desc *desc);
+
+/* Call on each tick of the stream PWM */
+int32_t ad3552r_stream_trigger(struct ad3552r_desc *desc);
+
+int32_t ad3552r_stream_remove(struct ad3552r_desc *desc);
 #endif /* _AD3552R_H_ */
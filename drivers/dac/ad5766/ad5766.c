@@ -45,6 +45,7 @@
 #include "ad5766.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************** Functions Implementation **************************/
@@ -282,6 +283,71 @@ int32_t ad5766_set_dac_reg_all(struct ad5766_dev *dev,
 				    data);
 }
 
+/**
+ * Stage a code for the selected channel. Nothing is sent to the device until
+ * ad5766_commit() is called, staging a channel twice keeps the last code.
+ * @param dev - The device structure.
+ * @param dac - The selected channel.
+ * @param data - The register data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad5766_stage_code(struct ad5766_dev *dev,
+			  enum ad5766_dac dac,
+			  uint16_t data)
+{
+	if (!dev || dac > AD5766_DAC_15)
+		return -EINVAL;
+
+	dev->staged_code[dac] = data;
+	dev->staged_mask |= AD5766_LDAC(dac);
+
+	return 0;
+}
+
+/**
+ * Write the staged codes to the input registers and update all the staged
+ * channels with a single software LDAC. The input register writes and the
+ * LDAC command are sent as one chain of chip select framed messages, by DMA
+ * when the SPI platform supports it.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad5766_commit(struct ad5766_dev *dev)
+{
+	uint8_t buf[(AD5766_NUM_CHANNELS + 1) * AD5766_FRAME_BYTES];
+	uint8_t *frame = buf;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->staged_mask)
+		return 0;
+
+	for (i = 0; i < AD5766_NUM_CHANNELS; i++) {
+		if (!(dev->staged_mask & AD5766_LDAC(i)))
+			continue;
+
+		frame[0] = AD5766_CMD_WR_IN_REG(i);
+		no_os_put_unaligned_be16(dev->staged_code[i], &frame[1]);
+		frame += AD5766_FRAME_BYTES;
+	}
+
+	frame[0] = AD5766_CMD_SW_LDAC;
+	no_os_put_unaligned_be16(dev->staged_mask, &frame[1]);
+	frame += AD5766_FRAME_BYTES;
+
+	ret = no_os_spi_write_chunked(dev->spi_desc, buf, frame - buf,
+				      AD5766_FRAME_BYTES);
+	if (ret)
+		return ret;
+
+	dev->staged_mask = 0;
+
+	return 0;
+}
+
 /**
  * Initialize the device.
  * @param device - The device structure.
@@ -295,7 +361,7 @@ int32_t ad5766_init(struct ad5766_dev **device,
 	struct ad5766_dev *dev;
 	int32_t ret;
 
-	dev = (struct ad5766_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad5766_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev) {
 		return -1;
 	}
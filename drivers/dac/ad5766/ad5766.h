@@ -95,6 +95,9 @@
 #define AD5766_50(x)			(2 << (2 * ((x) & 0xF)))
 #define AD5766_25(x)			(3 << (2 * ((x) & 0xF)))
 
+#define AD5766_NUM_CHANNELS		16
+#define AD5766_FRAME_BYTES		3
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -145,6 +148,9 @@ struct ad5766_dev {
 	struct no_os_gpio_desc		*gpio_reset;
 	/* Device Settings */
 	enum ad5766_state	daisy_chain_en;
+	/* Codes staged for the next ad5766_commit() */
+	uint16_t		staged_code[AD5766_NUM_CHANNELS];
+	uint16_t		staged_mask;
 };
 
 struct ad5766_init_param {
@@ -209,6 +215,12 @@ int32_t ad5766_set_dac_reg(struct ad5766_dev *dev,
 /* Set the DAC register for all channels. */
 int32_t ad5766_set_dac_reg_all(struct ad5766_dev *dev,
 			       uint16_t data);
+/* Stage a code for the selected channel, written by ad5766_commit(). */
+int32_t ad5766_stage_code(struct ad5766_dev *dev,
+			  enum ad5766_dac dac,
+			  uint16_t data);
+/* Write the staged codes and update the staged channels together. */
+int32_t ad5766_commit(struct ad5766_dev *dev);
 /* Initialize the device. */
 int32_t ad5766_init(struct ad5766_dev **device,
 		    struct ad5766_init_param init_param);
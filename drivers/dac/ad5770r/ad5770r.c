@@ -574,6 +574,88 @@ int32_t ad5770r_set_sw_ldac(struct ad5770r_dev *dev,
 	return ret;
 }
 
+/**
+ * Stage an input register value. Nothing is sent to the device until
+ * ad5770r_commit() is called.
+ * @param dev - The device structure.
+ * @param dac_input - value that will be set in the register.
+ * @param channel - the selected channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad5770r_stage_dac_input(struct ad5770r_dev *dev,
+				uint16_t dac_input, enum ad5770r_channels channel)
+{
+	if (!dev || channel > AD5770R_CH5)
+		return -EINVAL;
+
+	dev->staged_value[channel] = dac_input;
+	dev->staged_mask |= AD5770R_SW_LDAC_CH(1, channel);
+
+	return 0;
+}
+
+/**
+ * Write the staged input register values and update all the staged channels
+ * with a single software LDAC. All the writes are sent as one chain of SPI
+ * messages, by DMA when the SPI platform supports it.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad5770r_commit(struct ad5770r_dev *dev)
+{
+	struct no_os_spi_msg msgs[AD5770R_CH5 + 2];
+	uint8_t buf[AD5770R_CH5 + 2][3];
+	uint32_t n = 0;
+	uint8_t i;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->staged_mask)
+		return 0;
+
+	for (i = 0; i <= AD5770R_CH5; i++) {
+		if (!(dev->staged_mask & AD5770R_SW_LDAC_CH(1, i)))
+			continue;
+
+		buf[n][0] = AD5770R_REG_WRITE(AD5770R_CH0_INPUT_MSB + 2 * i);
+		buf[n][1] = (uint8_t)((dev->staged_value[i] & 0x3FC0) >> 6);
+		buf[n][2] = (uint8_t)AD5770R_CH_DAC_DATA_LSB(dev->staged_value[i]);
+		msgs[n] = (struct no_os_spi_msg) {
+			.tx_buff = buf[n],
+			.bytes_number = 3,
+			.cs_change = 1,
+		};
+		n++;
+	}
+
+	buf[n][0] = AD5770R_REG_WRITE(AD5770R_SW_LDAC);
+	buf[n][1] = dev->staged_mask;
+	msgs[n] = (struct no_os_spi_msg) {
+		.tx_buff = buf[n],
+		.bytes_number = 2,
+		.cs_change = 1,
+	};
+	n++;
+
+	ret = no_os_spi_transfer_dma_sync(dev->spi_desc, msgs, n);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_transfer(dev->spi_desc, msgs, n);
+	if (ret)
+		return ret;
+
+	for (i = 0; i <= AD5770R_CH5; i++) {
+		if (dev->staged_mask & AD5770R_SW_LDAC_CH(1, i)) {
+			dev->input_value[i] = dev->staged_value[i];
+			dev->dac_value[i] = dev->staged_value[i];
+		}
+	}
+	dev->staged_mask = 0;
+
+	return 0;
+}
+
 /**
  * Get status value.
  * @param dev - The device structure.
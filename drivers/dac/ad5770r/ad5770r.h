@@ -319,6 +319,8 @@ struct ad5770r_dev {
 	struct ad5770r_channel_switches		mask_channel_sel;
 	struct ad5770r_channel_switches		sw_ldac;
 	uint16_t				input_value[6];
+	uint16_t				staged_value[6];
+	uint8_t					staged_mask;
 };
 
 struct ad5770r_init_param {
@@ -394,6 +396,9 @@ int32_t ad5770r_set_mask_channel(struct ad5770r_dev *dev,
 				 const struct ad5770r_channel_switches *mask_channel_sel);
 int32_t ad5770r_set_sw_ldac(struct ad5770r_dev *dev,
 			    const struct ad5770r_channel_switches *sw_ldac);
+int32_t ad5770r_stage_dac_input(struct ad5770r_dev *dev,
+				uint16_t dac_input, enum ad5770r_channels channel);
+int32_t ad5770r_commit(struct ad5770r_dev *dev);
 int32_t ad5770r_get_status(struct ad5770r_dev *dev,
 			   uint8_t *status);
 int32_t ad5770r_get_interface_status(struct ad5770r_dev *dev,
@@ -88,6 +88,7 @@ int32_t ad5791_init(struct ad5791_dev **device,
 		return -1;
 
 	dev->act_device = init_param.act_device;
+	dev->stream = NULL;
 
 	/* GPIO */
 	status = no_os_gpio_get(&dev->gpio_reset, &init_param.gpio_reset);
@@ -119,6 +120,9 @@ int32_t ad5791_remove(struct ad5791_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->stream)
+		ad5791_stream_remove(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	ret |= no_os_gpio_remove(dev->gpio_reset);
@@ -472,3 +476,127 @@ int ad5791_clear_async(struct ad5791_dev *dev)
 	/* If no gpio is assigned use SW CLR */
 	return ad5791_soft_instruction(dev, AD5791_SOFT_CTRL_CLR);
 }
+
+/***************************************************************************//**
+ * @brief	Prepare timer paced waveform output.
+ *
+ * Each tick of the PWM writes the next code to the DAC register. When the PWM
+ * drives LDAC (param->ldac_pwm), the output updates on its LDAC pulse.
+ * Otherwise the LDAC GPIO is held low while streaming and the output updates
+ * at the end of each write.
+ *
+ * @param	dev   - The device structure.
+ * @param	param - Stream parameters, the frame fields are set by the
+ *			driver. The ring holds AD5791_STREAM_FRAME_BYTES per
+ *			sample.
+ * @return	0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad5791_stream_init(struct ad5791_dev *dev,
+		       struct no_os_dac_stream_init_param *param)
+{
+	int ret;
+
+	if (!dev || !param || dev->stream)
+		return -EINVAL;
+
+	param->spi_desc = dev->spi_desc;
+	param->ldac_pulse_ns = AD5791_STREAM_LDAC_PULSE_NS;
+	param->frame_bytes = AD5791_STREAM_FRAME_BYTES;
+
+	ret = no_os_dac_stream_init(&dev->stream, param);
+	if (ret)
+		return ret;
+
+	if (!param->ldac_pwm && dev->gpio_ldac) {
+		ret = AD5791_LDAC_LOW;
+		if (ret) {
+			no_os_dac_stream_remove(dev->stream);
+			dev->stream = NULL;
+		}
+	}
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief	Queue one block of DAC codes.
+ *
+ * @param	dev  - The device structure.
+ * @param	data - block_samples codes, right aligned to the resolution of
+ *		       the part.
+ * @return	0 in case of success, -EAGAIN if the ring is full, negative
+ *		error code otherwise.
+*******************************************************************************/
+int ad5791_stream_write(struct ad5791_dev *dev, const uint32_t *data)
+{
+	uint8_t shift, *frame;
+	uint32_t i, word;
+	int ret;
+
+	if (!dev || !dev->stream || !data)
+		return -EINVAL;
+
+	ret = no_os_dac_stream_get_block(dev->stream, &frame);
+	if (ret)
+		return ret;
+
+	shift = MAX_RESOLUTION - chip_info[dev->act_device].resolution;
+	for (i = 0; i < dev->stream->block_samples; i++) {
+		word = AD5791_WRITE | AD5791_ADDR_REG(AD5791_REG_DAC) |
+		       ((data[i] << shift) & 0xFFFFF);
+		no_os_put_unaligned_be24(word, frame);
+		frame += AD5791_STREAM_FRAME_BYTES;
+	}
+
+	return no_os_dac_stream_block_done(dev->stream);
+}
+
+/***************************************************************************//**
+ * @brief	Start timer paced waveform output.
+ *
+ * @param	dev - The device structure.
+ * @return	0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad5791_stream_start(struct ad5791_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	return no_os_dac_stream_start(dev->stream);
+}
+
+/***************************************************************************//**
+ * @brief	Write the next code, called on each tick of the stream PWM.
+ *
+ * @param	dev - The device structure.
+ * @return	0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad5791_stream_trigger(struct ad5791_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	return no_os_dac_stream_trigger(dev->stream);
+}
+
+/***************************************************************************//**
+ * @brief	Stop timer paced waveform output.
+ *
+ * @param	dev - The device structure.
+ * @return	0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad5791_stream_remove(struct ad5791_dev *dev)
+{
+	int ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	ret = no_os_dac_stream_remove(dev->stream);
+	dev->stream = NULL;
+
+	if (dev->gpio_ldac)
+		AD5791_LDAC_HIGH;
+
+	return ret;
+}
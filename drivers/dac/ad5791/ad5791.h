@@ -49,6 +49,7 @@
 #include "no_os_spi.h"
 #include "no_os_util.h"
 #include "no_os_error.h"
+#include "no_os_dac_stream.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -85,6 +86,8 @@ struct ad5791_dev {
 	struct no_os_gpio_desc	*gpio_ldac;
 	/* Device Settings */
 	enum ad5791_type act_device;
+	/* Timer paced stream, NULL when not used */
+	struct no_os_dac_stream	*stream;
 };
 
 struct ad5791_init_param {
@@ -126,6 +129,11 @@ struct ad5791_init_param {
 /********************************** AD5791 ************************************/
 /******************************************************************************/
 
+/* LDAC pulse of the stream PWM, the minimum is 14ns */
+#define AD5791_STREAM_LDAC_PULSE_NS	100
+/* Frame of a stream sample */
+#define AD5791_STREAM_FRAME_BYTES	3
+
 /* Maximum resolution */
 #define MAX_RESOLUTION          20
 
@@ -217,4 +225,20 @@ int ad5791_ldac_trigger(struct ad5791_dev *dev);
 /*! Clear DAC channel output with the clearcode. */
 int ad5791_clear_async(struct ad5791_dev *dev);
 
+/*! Prepare timer paced waveform output. */
+int ad5791_stream_init(struct ad5791_dev *dev,
+		       struct no_os_dac_stream_init_param *param);
+
+/*! Queue one block of DAC codes. */
+int ad5791_stream_write(struct ad5791_dev *dev, const uint32_t *data);
+
+/*! Start timer paced waveform output. */
+int ad5791_stream_start(struct ad5791_dev *dev);
+
+/*! Write the next code, called on each tick of the stream PWM. */
+int ad5791_stream_trigger(struct ad5791_dev *dev);
+
+/*! Stop timer paced waveform output. */
+int ad5791_stream_remove(struct ad5791_dev *dev);
+
 #endif /* __AD5791_H__ */
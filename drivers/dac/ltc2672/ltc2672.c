@@ -197,6 +197,84 @@ int ltc2672_set_code_channel(struct ltc2672_dev *device, uint16_t code,
 	return ltc2672_transaction(device, command, false);
 }
 
+/**
+ * @brief stages the dac code for a channel, nothing is sent to the device
+ * until ltc2672_commit() is called
+ * @param device - ltc2672 descriptor
+ * @param code - The code to be written
+ * @param out_ch - channel to set the code
+ * @return 0 in case of success, negative error code otherwise
+ */
+int ltc2672_stage_code_channel(struct ltc2672_dev *device, uint16_t code,
+			       enum ltc2672_dac_ch out_ch)
+{
+	if (!device)
+		return -EINVAL;
+
+	if ((device->id == LTC2672_12 && code > LTC2672_12BIT_RESO)
+	    || (device->id == LTC2672_16 && code > LTC2672_16BIT_RESO)
+	    || out_ch < LTC2672_DAC0 || out_ch > LTC2672_DAC4)
+		return -EINVAL;
+
+	device->staged_code[out_ch] = code;
+	device->staged_mask |= NO_OS_BIT(out_ch);
+
+	return 0;
+}
+
+/**
+ * @brief writes the staged codes to the input registers and updates all
+ * channels at once. The last staged write carries the update command, the
+ * writes are sent as one chain of chip select framed 24 bit commands, by DMA
+ * when the SPI platform supports it.
+ * @param device - ltc2672 descriptor
+ * @return 0 in case of success, negative error code otherwise
+ */
+int ltc2672_commit(struct ltc2672_dev *device)
+{
+	uint8_t buf[LTC2672_TOTAL_CHANNELS * 3];
+	uint32_t command, n = 0;
+	uint8_t comm;
+	uint16_t code;
+	int ret, i;
+
+	if (!device)
+		return -EINVAL;
+
+	if (!device->staged_mask)
+		return 0;
+
+	for (i = LTC2672_DAC0; i <= LTC2672_DAC4; i++) {
+		if (!(device->staged_mask & NO_OS_BIT(i)))
+			continue;
+
+		if (device->staged_mask >> (i + 1))
+			comm = LTC2672_CODE_TO_CHANNEL_X;
+		else
+			comm = LTC2672_CODE_TO_CHANNEL_X_PWRUP_UPD_CHANNEL_ALL;
+
+		/* Switching to V- results in constant -80mA output */
+		if (device->out_spans[i] == LTC2672_VMINUS_VREF)
+			code = LTC2672_DUMMY;
+		else if (device->id == LTC2672_12)
+			code = device->staged_code[i] << LTC2672_BIT_SHIFT_12BIT;
+		else
+			code = device->staged_code[i];
+
+		command = LTC2672_COMMAND24_GENERATE(comm, i, code);
+		no_os_put_unaligned_be24(command, &buf[n]);
+		n += 3;
+	}
+
+	ret = no_os_spi_write_chunked(device->comm_desc, buf, n, 3);
+	if (ret)
+		return ret;
+
+	device->staged_mask = 0;
+
+	return 0;
+}
+
 /**
  * @brief set the current for a selected DAC channel
  * @param device - ltc2672 descriptor
@@ -193,6 +193,9 @@ struct ltc2672_dev {
 	uint32_t prev_command;
 	/* Global toggle bit flag */
 	bool global_toggle;
+	/* Codes staged for the next ltc2672_commit() */
+	uint16_t staged_code[LTC2672_TOTAL_CHANNELS];
+	uint8_t staged_mask;
 };
 
 /**
@@ -223,6 +226,13 @@ uint32_t ltc2672_current_to_code(struct ltc2672_dev *device, uint32_t,
 int ltc2672_set_code_channel(struct ltc2672_dev *device, uint16_t code,
 			     enum ltc2672_dac_ch out_ch);
 
+/** Stage the dac code for a selected DAC channel */
+int ltc2672_stage_code_channel(struct ltc2672_dev *device, uint16_t code,
+			       enum ltc2672_dac_ch out_ch);
+
+/** Write the staged codes and update all DAC channels together */
+int ltc2672_commit(struct ltc2672_dev *device);
+
 /** Set the current for a selected DAC channel */
 int ltc2672_set_current_channel(struct ltc2672_dev *, uint32_t,
 				enum ltc2672_dac_ch);
@@ -806,7 +806,7 @@ int max2201x_iio_remove(struct max2201x_iio_desc *iio_desc)
 		return -ENODEV;
 
 	if (iio_desc->iio_dev->channels)
-		no_os_free(iio_desc->iio_dev->channels);
+		no_os_free((void *)iio_desc->iio_dev->channels);
 	if (iio_desc->max2201x_desc)
 		max2201x_remove(iio_desc->max2201x_desc);
 
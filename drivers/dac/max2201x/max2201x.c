@@ -44,7 +44,7 @@
 #include "no_os_alloc.h"
 #include "no_os_crc8.h"
 
-NO_OS_DECLARE_CRC8_TABLE(table);
+static const uint8_t *table;
 
 /**
  * @brief Obtain the GPIO decriptor.
@@ -646,8 +646,13 @@ int max2201x_init(struct max2201x_desc **desc,
 		}
 	}
 
-	if (param->crc_en)
-		no_os_crc8_populate_msb(table, 0x31);
+	if (param->crc_en) {
+		table = no_os_crc8_get_table(0x31);
+		if (!table) {
+			ret = -ENOMEM;
+			goto error;
+		}
+	}
 
 	ret = max2201x_reg_update(descriptor, MAX2201X_GEN_CNFG, MAX2201X_CRC_MASK,
 				  no_os_field_prep(MAX2201X_CRC_MASK, param->crc_en));
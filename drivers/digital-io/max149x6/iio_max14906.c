@@ -630,7 +630,7 @@ int max14906_iio_remove(struct max14906_iio_desc *iio_desc)
 	if (!iio_desc)
 		return -ENODEV;
 
-	no_os_free(iio_desc->iio_dev->channels);
+	no_os_free((void *)iio_desc->iio_dev->channels);
 	max14906_remove(iio_desc->max14906_desc);
 	no_os_free(iio_desc);
 
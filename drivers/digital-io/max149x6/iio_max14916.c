@@ -286,7 +286,7 @@ int max14916_iio_remove(struct max14916_iio_desc *iio_desc)
 	if (!iio_desc)
 		return -ENODEV;
 
-	no_os_free(iio_desc->iio_dev->channels);
+	no_os_free((void *)iio_desc->iio_dev->channels);
 	max14916_remove(iio_desc->max14916_desc);
 	no_os_free(iio_desc);
 
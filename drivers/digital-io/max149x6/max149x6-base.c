@@ -43,55 +43,65 @@
 #include "max149x6-base.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_crc_table.h"
+
+/*
+ * CRC5 polynomial x^5 + x^4 + x^2 + 1 (0x15) left aligned in a byte, so whole
+ * bytes are processed through a CRC-8 lookup table built at compile time.
+ */
+#define MAX149X6_CRC_POLY	(0x15 << 3)
+#define MAX149X6_CRC_INIT	(0x1f << 3)
+
+static const uint8_t max149x6_crc_table[NO_OS_CRC8_TABLE_SIZE] = {
+	NO_OS_CRC8_MSB_TABLE(MAX149X6_CRC_POLY)
+};
 
 /**
- * @brief Compute the CRC5 value for an array of bytes when writing to MAX149X6
- * @param data - array of data to encode
- * @return the resulted CRC5
+ * @brief Feed the most significant bits of a byte to a left aligned CRC5
+ * @param crc - current CRC, left aligned
+ * @param data - bits to process, msb first
+ * @param nb_bits - number of bits to process
+ * @return the updated CRC, left aligned
  */
-static uint8_t max149x6_crc(uint8_t *data, bool encode)
+static uint8_t max149x6_crc_bits(uint8_t crc, uint8_t data, int nb_bits)
 {
-	uint8_t crc5_start = 0x1f;
-	uint8_t crc5_poly = 0x15;
-	uint8_t crc5_result = crc5_start;
-	uint8_t extra_byte = 0x00;
-	uint8_t data_bit;
-	uint8_t result_bit;
 	int i;
 
-	/*
-	 * This is a custom implementation of a CRC5 algorithm, detailed here:
-	 * https://www.analog.com/en/app-notes/how-to-program-the-max14906-quadchannel-industrial-digital-output-digital-input.html
-	 */
-
-	for (i = (encode) ? 0 : 2; i < 8; i++) {
-		data_bit = (data[0] >> (7 - i)) & 0x01;
-		result_bit = (crc5_result & 0x10) >> 4;
-		if (data_bit ^ result_bit)
-			crc5_result = crc5_poly ^ ((crc5_result << 1) & 0x1f);
+	for (i = 0; i < nb_bits; i++) {
+		if ((crc ^ data) & 0x80)
+			crc = (uint8_t)(crc << 1) ^ MAX149X6_CRC_POLY;
 		else
-			crc5_result = (crc5_result << 1) & 0x1f;
+			crc = (uint8_t)(crc << 1);
+		data <<= 1;
 	}
 
-	for (i = 0; i < 8; i++) {
-		data_bit = (data[1] >> (7 - i)) & 0x01;
-		result_bit = (crc5_result & 0x10) >> 4;
-		if (data_bit ^ result_bit)
-			crc5_result = crc5_poly ^ ((crc5_result << 1) & 0x1f);
-		else
-			crc5_result = (crc5_result << 1) & 0x1f;
-	}
+	return crc;
+}
 
-	for (i = 0; i < 3; i++) {
-		data_bit = (extra_byte >> (7 - i)) & 0x01;
-		result_bit = (crc5_result & 0x10) >> 4;
-		if (data_bit ^ result_bit)
-			crc5_result = crc5_poly ^ ((crc5_result << 1) & 0x1f);
-		else
-			crc5_result = (crc5_result << 1) & 0x1f;
-	}
+/**
+ * @brief Compute the CRC5 value of a MAX149X6 frame
+ *
+ * This is the CRC5 algorithm detailed here:
+ * https://www.analog.com/en/app-notes/how-to-program-the-max14906-quadchannel-industrial-digital-output-digital-input.html
+ * @param data - array of data to encode
+ * @param encode - true for a command, false to check a response whose 2 most
+ * 		   significant bits are not covered by the CRC
+ * @return the resulted CRC5
+ */
+static uint8_t max149x6_crc(uint8_t *data, bool encode)
+{
+	uint8_t crc = MAX149X6_CRC_INIT;
+
+	if (encode)
+		crc = max149x6_crc_table[crc ^ data[0]];
+	else
+		crc = max149x6_crc_bits(crc, data[0] << 2, 6);
 
-	return crc5_result;
+	crc = max149x6_crc_table[crc ^ data[1]];
+	crc = max149x6_crc_bits(crc, 0, 3);
+
+	return crc >> 3;
 }
 
 /**
@@ -190,3 +200,244 @@ int max149x6_reg_update(struct max149x6_desc *desc, uint32_t addr,
 
 	return max149x6_reg_write(desc, addr, reg_val);
 }
+
+/**
+ * @brief Timer interrupt handler running one I/O image cycle
+ * @param context - the I/O image cycle
+ */
+static void max149x6_cycle_irq(void *context)
+{
+	struct max149x6_cycle *cycle = context;
+	int ret;
+
+	ret = max149x6_cycle_run(cycle);
+	if (cycle->cycle_done)
+		cycle->cycle_done(cycle->ctx, ret);
+}
+
+/**
+ * @brief Initialize an I/O image cycle
+ *
+ * Each cycle exchanges all the listed registers in a single SPI transfer, one
+ * chip select framed message per register, instead of one transfer per
+ * register access.
+ * @param cycle - the I/O image cycle
+ * @param desc - device descriptor for the MAX149X6
+ * @param param - the cycle parameters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_init(struct max149x6_cycle **cycle,
+			struct max149x6_desc *desc,
+			const struct max149x6_cycle_init_param *param)
+{
+	struct max149x6_cycle *c;
+	uint32_t i, n;
+	int ret;
+
+	if (!cycle || !desc || !param ||
+	    (param->nb_read && !param->read_regs) ||
+	    (param->nb_write && !param->write_regs) ||
+	    !(param->nb_read + param->nb_write) ||
+	    param->nb_read + param->nb_write > MAX149X6_CYCLE_MAX_REGS ||
+	    (param->timer && !param->irq_ctrl))
+		return -EINVAL;
+
+	c = no_os_calloc(1, sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	c->desc = desc;
+	c->nb_read = param->nb_read;
+	c->nb_write = param->nb_write;
+	n = c->nb_write + c->nb_read;
+
+	for (i = 0; i < n; i++) {
+		if (i < c->nb_write)
+			c->addr[i] = param->write_regs[i];
+		else
+			c->addr[i] = param->read_regs[i - c->nb_write];
+
+		c->msgs[i].tx_buff = c->frames[i];
+		c->msgs[i].rx_buff = c->frames[i];
+		c->msgs[i].bytes_number = MAX149X6_FRAME_SIZE + desc->crc_en;
+		c->msgs[i].cs_change = 1;
+	}
+
+	if (param->timer) {
+		c->timer = param->timer;
+		c->irq_ctrl = param->irq_ctrl;
+		c->irq_id = param->irq_id;
+		c->cycle_done = param->cycle_done;
+		c->ctx = param->ctx;
+		c->timer_cb.callback = max149x6_cycle_irq;
+		c->timer_cb.ctx = c;
+		c->timer_cb.event = NO_OS_EVT_TIM_ELAPSED;
+		c->timer_cb.peripheral = NO_OS_TIM_IRQ;
+		c->timer_cb.handle = param->irq_handle;
+
+		ret = no_os_irq_register_callback(c->irq_ctrl, c->irq_id,
+						  &c->timer_cb);
+		if (ret) {
+			no_os_free(c);
+			return ret;
+		}
+	}
+
+	*cycle = c;
+
+	return 0;
+}
+
+/**
+ * @brief Exchange the I/O image with the device
+ *
+ * The output image is written and the input image is read in one SPI
+ * transfer. The input image is only updated if every read frame passes the
+ * CRC check.
+ * @param cycle - the I/O image cycle
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_run(struct max149x6_cycle *cycle)
+{
+	struct max149x6_desc *desc;
+	uint8_t *frame;
+	uint32_t i, n;
+	int ret;
+
+	if (!cycle)
+		return -EINVAL;
+
+	desc = cycle->desc;
+	n = cycle->nb_write + cycle->nb_read;
+
+	for (i = 0; i < n; i++) {
+		frame = cycle->frames[i];
+		frame[0] = no_os_field_prep(MAX149X6_CHIP_ADDR_MASK, desc->chip_address) |
+			   no_os_field_prep(MAX149X6_ADDR_MASK, cycle->addr[i]) |
+			   no_os_field_prep(MAX149X6_RW_MASK, i < cycle->nb_write);
+		frame[1] = i < cycle->nb_write ? cycle->out[i] : 0;
+		if (desc->crc_en)
+			frame[2] = max149x6_crc(frame, true);
+	}
+
+	ret = no_os_spi_transfer_dma_sync(desc->comm_desc, cycle->msgs, n);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_transfer(desc->comm_desc, cycle->msgs, n);
+	if (ret)
+		return ret;
+
+	if (desc->crc_en) {
+		for (i = cycle->nb_write; i < n; i++) {
+			frame = cycle->frames[i];
+			if (max149x6_crc(frame, false) != frame[2]) {
+				cycle->crc_errors++;
+				return -EINVAL;
+			}
+		}
+	}
+
+	for (i = cycle->nb_write; i < n; i++)
+		cycle->in[i] = cycle->frames[i][1];
+
+	return 0;
+}
+
+/**
+ * @brief Set a register of the output image
+ * @param cycle - the I/O image cycle
+ * @param idx - index of the register in write_regs
+ * @param val - value written by the next cycle
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_set(struct max149x6_cycle *cycle, uint32_t idx, uint8_t val)
+{
+	if (!cycle || idx >= cycle->nb_write)
+		return -EINVAL;
+
+	cycle->out[idx] = val;
+
+	return 0;
+}
+
+/**
+ * @brief Get a register of the input image
+ * @param cycle - the I/O image cycle
+ * @param idx - index of the register in read_regs
+ * @param val - value read by the last successful cycle
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_get(struct max149x6_cycle *cycle, uint32_t idx, uint8_t *val)
+{
+	if (!cycle || !val || idx >= cycle->nb_read)
+		return -EINVAL;
+
+	*val = cycle->in[cycle->nb_write + idx];
+
+	return 0;
+}
+
+/**
+ * @brief Start running the cycle on each scan timer period
+ * @param cycle - the I/O image cycle
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_start(struct max149x6_cycle *cycle)
+{
+	int ret;
+
+	if (!cycle || !cycle->timer)
+		return -EINVAL;
+
+	ret = no_os_irq_enable(cycle->irq_ctrl, cycle->irq_id);
+	if (ret)
+		return ret;
+
+	return no_os_timer_start(cycle->timer);
+}
+
+/**
+ * @brief Stop the timed cycles
+ * @param cycle - the I/O image cycle
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_stop(struct max149x6_cycle *cycle)
+{
+	int ret;
+
+	if (!cycle || !cycle->timer)
+		return -EINVAL;
+
+	ret = no_os_timer_stop(cycle->timer);
+	if (ret)
+		return ret;
+
+	return no_os_irq_disable(cycle->irq_ctrl, cycle->irq_id);
+}
+
+/**
+ * @brief Free the resources allocated by max149x6_cycle_init()
+ * @param cycle - the I/O image cycle
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_cycle_remove(struct max149x6_cycle *cycle)
+{
+	int ret;
+
+	if (!cycle)
+		return -EINVAL;
+
+	if (cycle->timer) {
+		ret = max149x6_cycle_stop(cycle);
+		if (ret)
+			return ret;
+
+		ret = no_os_irq_unregister_callback(cycle->irq_ctrl, cycle->irq_id,
+						    &cycle->timer_cb);
+		if (ret)
+			return ret;
+	}
+
+	no_os_free(cycle);
+
+	return 0;
+}
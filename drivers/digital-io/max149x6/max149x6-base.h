@@ -45,10 +45,15 @@
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 #include "no_os_util.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
 
 /* Common Frame Size */
 #define MAX149X6_FRAME_SIZE		2
 
+/* Maximum number of registers exchanged in one I/O image cycle */
+#define MAX149X6_CYCLE_MAX_REGS		16
+
 /* Common Registers */
 #define MAX149X6_CHIP_ADDR_MASK		NO_OS_GENMASK(7, 6)
 #define MAX149X6_ADDR_MASK		NO_OS_GENMASK(4, 1)
@@ -81,6 +86,55 @@ struct max149x6_desc {
 	bool crc_en;
 };
 
+/**
+ * @brief I/O image cycle initialization parameters.
+ */
+struct max149x6_cycle_init_param {
+	/** Registers read each cycle, e.g. input levels and diagnostics */
+	const uint8_t *read_regs;
+	uint32_t nb_read;
+	/** Registers written each cycle, e.g. the output states */
+	const uint8_t *write_regs;
+	uint32_t nb_write;
+	/** Optional scan timer, NULL if cycles are run by the application */
+	struct no_os_timer_desc *timer;
+	/** Interrupt controller of the scan timer */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** Interrupt line of the scan timer */
+	uint32_t irq_id;
+	/** Platform specific handle of the scan timer interrupt */
+	void *irq_handle;
+	/** Optional, called after each timed cycle with its result */
+	void (*cycle_done)(void *ctx, int ret);
+	/** Context passed to cycle_done */
+	void *ctx;
+};
+
+/**
+ * @brief I/O image exchanged with a MAX149X6 in one SPI transfer per cycle.
+ */
+struct max149x6_cycle {
+	struct max149x6_desc *desc;
+	uint32_t nb_read;
+	uint32_t nb_write;
+	/** Register addresses, the written ones first */
+	uint8_t addr[MAX149X6_CYCLE_MAX_REGS];
+	/** Output image, sent by the next cycle */
+	uint8_t out[MAX149X6_CYCLE_MAX_REGS];
+	/** Input image, updated by each successful cycle */
+	uint8_t in[MAX149X6_CYCLE_MAX_REGS];
+	uint8_t frames[MAX149X6_CYCLE_MAX_REGS][MAX149X6_FRAME_SIZE + 1];
+	struct no_os_spi_msg msgs[MAX149X6_CYCLE_MAX_REGS];
+	/** Number of cycles rejected because of a CRC mismatch */
+	uint32_t crc_errors;
+	struct no_os_timer_desc *timer;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	uint32_t irq_id;
+	struct no_os_callback_desc timer_cb;
+	void (*cycle_done)(void *ctx, int ret);
+	void *ctx;
+};
+
 /** Write the value of a device register */
 int max149x6_reg_write(struct max149x6_desc *, uint32_t, uint32_t);
 
@@ -90,4 +144,26 @@ int max149x6_reg_read(struct max149x6_desc *, uint32_t, uint32_t *);
 /** Update the value of a device register */
 int max149x6_reg_update(struct max149x6_desc *, uint32_t, uint32_t, uint32_t);
 
+/** Initialize an I/O image cycle */
+int max149x6_cycle_init(struct max149x6_cycle **, struct max149x6_desc *,
+			const struct max149x6_cycle_init_param *);
+
+/** Exchange the I/O image with the device */
+int max149x6_cycle_run(struct max149x6_cycle *);
+
+/** Set a register of the output image */
+int max149x6_cycle_set(struct max149x6_cycle *, uint32_t, uint8_t);
+
+/** Get a register of the input image */
+int max149x6_cycle_get(struct max149x6_cycle *, uint32_t, uint8_t *);
+
+/** Start running the cycle on each scan timer period */
+int max149x6_cycle_start(struct max149x6_cycle *);
+
+/** Stop the timed cycles */
+int max149x6_cycle_stop(struct max149x6_cycle *);
+
+/** Free the resources allocated by max149x6_cycle_init() */
+int max149x6_cycle_remove(struct max149x6_cycle *);
+
 #endif
@@ -42,47 +42,48 @@
 #include "max22190.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_crc_table.h"
+
+/*
+ * CRC5 polynomial x^5 + x^4 + x^2 + 1 (0x35) left aligned in a byte, so whole
+ * bytes are processed through a CRC-8 lookup table built at compile time.
+ */
+#define MAX22190_CRC_POLY	(0x15 << 3)
+#define MAX22190_CRC_INIT	0x7
+
+static const uint8_t max22190_crc_table[NO_OS_CRC8_TABLE_SIZE] = {
+	NO_OS_CRC8_MSB_TABLE(MAX22190_CRC_POLY)
+};
 
 /**
  * @brief Compute the CRC5 value for MAX22190
+ *
+ * This is the CRC algorithm described here:
+ * https://www.analog.com/en/design-notes/guidelines-to-implement-crc-algorithm.html
+ * The 19 data bits are divided by the polynomial and the 5 bit initial value
+ * appended to them is added to the remainder.
  * @param data - Data array to calculate CRC for.
  * @return CRC result.
 */
 static uint8_t max22190_crc(uint8_t *data)
 {
-	int length = 19;
-	uint8_t crc_step, tmp;
-	uint8_t crc_init = 0x7;
-	uint8_t crc_poly = 0x35;
+	uint8_t crc;
+	uint8_t bits = data[2];
 	int i;
 
-	/**
-	 * This is the C custom implementation of CRC function for MAX22190, and
-	 * can be found here:
-	 * https://www.analog.com/en/design-notes/guidelines-to-implement-crc-algorithm.html
-	*/
-	uint32_t datainput = (uint32_t)((data[0] << 16) + (data[1] << 8) + data[2]);
-
-	datainput = (datainput & 0xFFFFE0) + crc_init;
-
-	tmp = (uint8_t)((datainput & 0xFC0000) >> 18);
-
-	if ((tmp & 0x20) == 0x20)
-		crc_step = (uint8_t)(tmp ^ crc_poly);
-	else
-		crc_step = tmp;
-
-	for (i = 0; i < length - 1; i++) {
-		tmp = (uint8_t)(((crc_step & 0x1F) << 1) +
-				((datainput >> (length -2 - i)) & 0x01));
+	crc = max22190_crc_table[data[0]];
+	crc = max22190_crc_table[crc ^ data[1]];
 
-		if ((tmp & 0x20) == 0x20)
-			crc_step = (uint8_t)(tmp ^ crc_poly);
+	for (i = 0; i < 3; i++) {
+		if ((crc ^ bits) & 0x80)
+			crc = (uint8_t)(crc << 1) ^ MAX22190_CRC_POLY;
 		else
-			crc_step = tmp;
+			crc = (uint8_t)(crc << 1);
+		bits <<= 1;
 	}
 
-	return (uint8_t)(crc_step & 0x1F);
+	return (crc >> 3) ^ MAX22190_CRC_INIT;
 }
 
 /**
@@ -508,3 +509,241 @@ int max22190_remove(struct max22190_desc *desc)
 
 	return 0;
 }
+
+/**
+ * @brief Timer interrupt handler running one I/O image cycle
+ * @param context - The I/O image cycle.
+ */
+static void max22190_cycle_irq(void *context)
+{
+	struct max22190_cycle *cycle = context;
+	int ret;
+
+	ret = max22190_cycle_run(cycle);
+	if (cycle->cycle_done)
+		cycle->cycle_done(cycle->ctx, ret);
+}
+
+/**
+ * @brief Initialize an I/O image cycle.
+ *
+ * Each cycle exchanges all the listed registers in a single SPI transfer, one
+ * chip select framed message per register.
+ * @param cycle - The I/O image cycle.
+ * @param desc - MAX22190 device descriptor.
+ * @param param - The cycle parameters.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_init(struct max22190_cycle **cycle,
+			struct max22190_desc *desc,
+			const struct max22190_cycle_init_param *param)
+{
+	struct max22190_cycle *c;
+	uint32_t i, n;
+	int ret;
+
+	if (!cycle || !desc || !param ||
+	    (param->nb_read && !param->read_regs) ||
+	    (param->nb_write && !param->write_regs) ||
+	    !(param->nb_read + param->nb_write) ||
+	    param->nb_read + param->nb_write > MAX22190_CYCLE_MAX_REGS ||
+	    (param->timer && !param->irq_ctrl))
+		return -EINVAL;
+
+	c = no_os_calloc(1, sizeof(*c));
+	if (!c)
+		return -ENOMEM;
+
+	c->desc = desc;
+	c->nb_read = param->nb_read;
+	c->nb_write = param->nb_write;
+	n = c->nb_write + c->nb_read;
+
+	for (i = 0; i < n; i++) {
+		if (i < c->nb_write)
+			c->addr[i] = param->write_regs[i];
+		else
+			c->addr[i] = param->read_regs[i - c->nb_write];
+
+		c->msgs[i].tx_buff = c->frames[i];
+		c->msgs[i].rx_buff = c->frames[i];
+		c->msgs[i].bytes_number = MAX22190_FRAME_SIZE + desc->crc_en;
+		c->msgs[i].cs_change = 1;
+	}
+
+	if (param->timer) {
+		c->timer = param->timer;
+		c->irq_ctrl = param->irq_ctrl;
+		c->irq_id = param->irq_id;
+		c->cycle_done = param->cycle_done;
+		c->ctx = param->ctx;
+		c->timer_cb.callback = max22190_cycle_irq;
+		c->timer_cb.ctx = c;
+		c->timer_cb.event = NO_OS_EVT_TIM_ELAPSED;
+		c->timer_cb.peripheral = NO_OS_TIM_IRQ;
+		c->timer_cb.handle = param->irq_handle;
+
+		ret = no_os_irq_register_callback(c->irq_ctrl, c->irq_id,
+						  &c->timer_cb);
+		if (ret) {
+			no_os_free(c);
+			return ret;
+		}
+	}
+
+	*cycle = c;
+
+	return 0;
+}
+
+/**
+ * @brief Exchange the I/O image with the device.
+ *
+ * The input image is only updated if every read frame passes the CRC check.
+ * @param cycle - The I/O image cycle.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_run(struct max22190_cycle *cycle)
+{
+	struct max22190_desc *desc;
+	uint8_t *frame;
+	uint32_t i, n;
+	int ret;
+
+	if (!cycle)
+		return -EINVAL;
+
+	desc = cycle->desc;
+	n = cycle->nb_write + cycle->nb_read;
+
+	for (i = 0; i < n; i++) {
+		frame = cycle->frames[i];
+		frame[0] = no_os_field_prep(MAX22190_ADDR_MASK, cycle->addr[i]) |
+			   no_os_field_prep(MAX22190_RW_MASK, i < cycle->nb_write);
+		frame[1] = i < cycle->nb_write ? cycle->out[i] : 0;
+		frame[2] = 0;
+		if (desc->crc_en)
+			frame[2] = max22190_crc(frame);
+	}
+
+	ret = no_os_spi_transfer_dma_sync(desc->comm_desc, cycle->msgs, n);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_transfer(desc->comm_desc, cycle->msgs, n);
+	if (ret)
+		return ret;
+
+	if (desc->crc_en) {
+		for (i = cycle->nb_write; i < n; i++) {
+			frame = cycle->frames[i];
+			if (max22190_crc(frame) != (frame[2] & 0x1F)) {
+				cycle->crc_errors++;
+				return -EINVAL;
+			}
+		}
+	}
+
+	for (i = cycle->nb_write; i < n; i++)
+		cycle->in[i] = cycle->frames[i][1];
+
+	return 0;
+}
+
+/**
+ * @brief Set a register of the output image.
+ * @param cycle - The I/O image cycle.
+ * @param idx - Index of the register in write_regs.
+ * @param val - Value written by the next cycle.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_set(struct max22190_cycle *cycle, uint32_t idx, uint8_t val)
+{
+	if (!cycle || idx >= cycle->nb_write)
+		return -EINVAL;
+
+	cycle->out[idx] = val;
+
+	return 0;
+}
+
+/**
+ * @brief Get a register of the input image.
+ * @param cycle - The I/O image cycle.
+ * @param idx - Index of the register in read_regs.
+ * @param val - Value read by the last successful cycle.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_get(struct max22190_cycle *cycle, uint32_t idx, uint8_t *val)
+{
+	if (!cycle || !val || idx >= cycle->nb_read)
+		return -EINVAL;
+
+	*val = cycle->in[cycle->nb_write + idx];
+
+	return 0;
+}
+
+/**
+ * @brief Start running the cycle on each scan timer period.
+ * @param cycle - The I/O image cycle.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_start(struct max22190_cycle *cycle)
+{
+	int ret;
+
+	if (!cycle || !cycle->timer)
+		return -EINVAL;
+
+	ret = no_os_irq_enable(cycle->irq_ctrl, cycle->irq_id);
+	if (ret)
+		return ret;
+
+	return no_os_timer_start(cycle->timer);
+}
+
+/**
+ * @brief Stop the timed cycles.
+ * @param cycle - The I/O image cycle.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_stop(struct max22190_cycle *cycle)
+{
+	int ret;
+
+	if (!cycle || !cycle->timer)
+		return -EINVAL;
+
+	ret = no_os_timer_stop(cycle->timer);
+	if (ret)
+		return ret;
+
+	return no_os_irq_disable(cycle->irq_ctrl, cycle->irq_id);
+}
+
+/**
+ * @brief Free the resources allocated by max22190_cycle_init().
+ * @param cycle - The I/O image cycle.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_cycle_remove(struct max22190_cycle *cycle)
+{
+	int ret;
+
+	if (!cycle)
+		return -EINVAL;
+
+	if (cycle->timer) {
+		ret = max22190_cycle_stop(cycle);
+		if (ret)
+			return ret;
+
+		ret = no_os_irq_unregister_callback(cycle->irq_ctrl, cycle->irq_id,
+						    &cycle->timer_cb);
+		if (ret)
+			return ret;
+	}
+
+	no_os_free(cycle);
+
+	return 0;
+}
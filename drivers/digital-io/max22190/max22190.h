@@ -44,8 +44,11 @@
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 #include "no_os_util.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
 
 #define MAX22190_FRAME_SIZE		2
+#define MAX22190_CYCLE_MAX_REGS		16
 #define MAX22190_CHANNELS		8
 #define MAX22190_FAULT2_ENABLES		5
 
@@ -100,6 +103,55 @@ struct max22190_desc {
 	bool crc_en;
 };
 
+/**
+ * @brief I/O image cycle initialization parameters.
+ */
+struct max22190_cycle_init_param {
+	/** Registers read each cycle, e.g. input levels and faults */
+	const uint8_t *read_regs;
+	uint32_t nb_read;
+	/** Registers written each cycle */
+	const uint8_t *write_regs;
+	uint32_t nb_write;
+	/** Optional scan timer, NULL if cycles are run by the application */
+	struct no_os_timer_desc *timer;
+	/** Interrupt controller of the scan timer */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** Interrupt line of the scan timer */
+	uint32_t irq_id;
+	/** Platform specific handle of the scan timer interrupt */
+	void *irq_handle;
+	/** Optional, called after each timed cycle with its result */
+	void (*cycle_done)(void *ctx, int ret);
+	/** Context passed to cycle_done */
+	void *ctx;
+};
+
+/**
+ * @brief I/O image exchanged with a MAX22190 in one SPI transfer per cycle.
+ */
+struct max22190_cycle {
+	struct max22190_desc *desc;
+	uint32_t nb_read;
+	uint32_t nb_write;
+	/** Register addresses, the written ones first */
+	uint8_t addr[MAX22190_CYCLE_MAX_REGS];
+	/** Output image, sent by the next cycle */
+	uint8_t out[MAX22190_CYCLE_MAX_REGS];
+	/** Input image, updated by each successful cycle */
+	uint8_t in[MAX22190_CYCLE_MAX_REGS];
+	uint8_t frames[MAX22190_CYCLE_MAX_REGS][MAX22190_FRAME_SIZE + 1];
+	struct no_os_spi_msg msgs[MAX22190_CYCLE_MAX_REGS];
+	/** Number of cycles rejected because of a CRC mismatch */
+	uint32_t crc_errors;
+	struct no_os_timer_desc *timer;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	uint32_t irq_id;
+	struct no_os_callback_desc timer_cb;
+	void (*cycle_done)(void *ctx, int ret);
+	void *ctx;
+};
+
 enum max22190_delay {
 	MAX22190_DELAY_50US,
 	MAX22190_DELAY_100US,
@@ -163,6 +215,28 @@ int max22190_reg_write(struct max22190_desc *, uint32_t, uint32_t);
 /** Update the register of the MAX22190 device. */
 int max22190_reg_update(struct max22190_desc *, uint32_t, uint32_t, uint32_t);
 
+/** Initialize an I/O image cycle. */
+int max22190_cycle_init(struct max22190_cycle **, struct max22190_desc *,
+			const struct max22190_cycle_init_param *);
+
+/** Exchange the I/O image with the device. */
+int max22190_cycle_run(struct max22190_cycle *);
+
+/** Set a register of the output image. */
+int max22190_cycle_set(struct max22190_cycle *, uint32_t, uint8_t);
+
+/** Get a register of the input image. */
+int max22190_cycle_get(struct max22190_cycle *, uint32_t, uint8_t *);
+
+/** Start running the cycle on each scan timer period. */
+int max22190_cycle_start(struct max22190_cycle *);
+
+/** Stop the timed cycles. */
+int max22190_cycle_stop(struct max22190_cycle *);
+
+/** Free the resources allocated by max22190_cycle_init(). */
+int max22190_cycle_remove(struct max22190_cycle *);
+
 /** Initialize and configure the MAX14916 device. */
 int max22190_init(struct max22190_desc **, struct max22190_init_param *);
 
@@ -872,7 +872,7 @@ int max22196_iio_remove(struct max22196_iio_desc *iio_desc)
 		return -ENODEV;
 
 	max22196_remove(iio_desc->max22196_desc);
-	no_os_free(iio_desc->iio_dev->channels);
+	no_os_free((void *)iio_desc->iio_dev->channels);
 	no_os_free(iio_desc);
 
 	return 0;
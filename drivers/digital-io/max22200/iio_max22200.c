@@ -1088,7 +1088,7 @@ int max22200_iio_remove(struct max22200_iio_desc *iio_desc)
 	if (!iio_desc)
 		return -ENODEV;
 
-	no_os_free(iio_desc->iio_dev->channels);
+	no_os_free((void *)iio_desc->iio_dev->channels);
 	max22200_remove(iio_desc->max22200_desc);
 	no_os_free(iio_desc);
 
@@ -45,12 +45,111 @@
 #include "display.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include <string.h>
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define DISPLAY_CHARSZ		8U
+
+extern const uint8_t no_os_chr_8x8[128][8];
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
 
+/***************************************************************************//**
+ * @brief Frees the framebuffer of a display.
+ *
+ * @param dev - The device structure.
+*******************************************************************************/
+static void display_fb_free(struct display_dev *dev)
+{
+	no_os_free(dev->fb_tx);
+	no_os_free(dev->dirty_last);
+	no_os_free(dev->dirty_first);
+	no_os_free(dev->fb);
+}
+
+/***************************************************************************//**
+ * @brief Allocates the framebuffer of a display, cleared and fully dirty.
+ *
+ * @param dev - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+static int32_t display_fb_alloc(struct display_dev *dev)
+{
+	uint16_t width = dev->cols_nb * DISPLAY_CHARSZ;
+	uint8_t i;
+
+	if (!dev->controller_ops->write_page)
+		return -ENOSYS;
+
+	dev->fb = no_os_calloc(dev->rows_nb, width);
+	dev->dirty_first = no_os_calloc(dev->rows_nb, sizeof(*dev->dirty_first));
+	dev->dirty_last = no_os_calloc(dev->rows_nb, sizeof(*dev->dirty_last));
+	dev->fb_tx = no_os_calloc(width, sizeof(*dev->fb_tx));
+	if (!dev->fb || !dev->dirty_first || !dev->dirty_last || !dev->fb_tx) {
+		display_fb_free(dev);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < dev->rows_nb; i++)
+		dev->dirty_last[i] = width - 1;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Marks a span of a framebuffer page as changed.
+ *
+ * @param dev   - The device structure.
+ * @param page  - Page.
+ * @param first - First column.
+ * @param last  - Last column.
+*******************************************************************************/
+static void display_fb_dirty(struct display_dev *dev, uint8_t page,
+			     uint16_t first, uint16_t last)
+{
+	if (dev->dirty_first[page] == DISPLAY_CLEAN) {
+		dev->dirty_first[page] = first;
+		dev->dirty_last[page] = last;
+		return;
+	}
+
+	dev->dirty_first[page] = no_os_min(dev->dirty_first[page], first);
+	dev->dirty_last[page] = no_os_max(dev->dirty_last[page], last);
+}
+
+/***************************************************************************//**
+ * @brief Prints a character on the character grid, in the framebuffer if
+ * there is one.
+ *
+ * @param dev    - The device structure.
+ * @param chr    - Character.
+ * @param row    - Row, a page of the display.
+ * @param column - Column, in characters.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+static int32_t display_put_char(struct display_dev *dev, char chr,
+				uint8_t row, uint8_t column)
+{
+	uint16_t x = column * DISPLAY_CHARSZ;
+
+	if (!dev->fb)
+		return dev->controller_ops->print_char(dev, chr, row, column);
+
+	if (row >= dev->rows_nb || column >= dev->cols_nb)
+		return -EINVAL;
+
+	memcpy(&dev->fb[row * dev->cols_nb * DISPLAY_CHARSZ + x],
+	       no_os_chr_8x8[chr & 0x7F], DISPLAY_CHARSZ);
+	display_fb_dirty(dev, row, x, x + DISPLAY_CHARSZ - 1);
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Initializes the display peripheral.
  *
@@ -68,7 +167,7 @@ int32_t display_init(struct display_dev **device,
 	if (!device || !param)
 		return -EINVAL;
 
-	dev = (struct display_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct display_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 	dev->cols_nb = param->cols_nb;
@@ -76,8 +175,17 @@ int32_t display_init(struct display_dev **device,
 	dev->controller_ops = param->controller_ops;
 	dev->extra = param->extra;
 
+	if (param->framebuffer) {
+		ret = display_fb_alloc(dev);
+		if (ret != 0) {
+			no_os_free(dev);
+			return ret;
+		}
+	}
+
 	ret = dev->controller_ops->init(dev);
 	if (ret != 0) {
+		display_fb_free(dev);
 		no_os_free(dev);
 		return -1;
 	}
@@ -103,6 +211,7 @@ int32_t display_remove(struct display_dev *device)
 	ret = device->controller_ops->remove(device);
 	if (ret != 0)
 		return -1;
+	display_fb_free(device);
 	no_os_free(device);
 
 	return ret;
@@ -167,6 +276,15 @@ int32_t display_clear(struct display_dev *device)
 	if (!device)
 		return -EINVAL;
 
+	if (device->fb) {
+		memset(device->fb, 0, device->rows_nb * device->cols_nb *
+		       DISPLAY_CHARSZ);
+		for (i = 0; i < device->rows_nb; i++)
+			display_fb_dirty(device, i, 0,
+					 device->cols_nb * DISPLAY_CHARSZ - 1);
+		return 0;
+	}
+
 	for(i = 0; i < device->rows_nb; i++)
 		for(j = 0; j < device->cols_nb; j++) {
 			ret = device->controller_ops->print_char(device, ' ', i, j);
@@ -201,14 +319,14 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 	for(i = 0; i < len; i++) {
 		if(r < device->rows_nb) {
 			if(c < device->cols_nb) {
-				ret = device->controller_ops->print_char(device, msg[i], r, c);
+				ret = display_put_char(device, msg[i], r, c);
 				if (ret != 0)
 					return -1;
 				c++;
 			} else {
 				c=0U;
 				r++;
-				ret = device->controller_ops->print_char(device, msg[i], r, c);
+				ret = display_put_char(device, msg[i], r, c);
 				if (ret != 0)
 					return -1;
 				c++;
@@ -234,5 +352,225 @@ int32_t display_print_char(struct display_dev *device, char chr,
 	if (!device)
 		return -EINVAL;
 
-	return device->controller_ops->print_char(device, chr, row, column);
+	return display_put_char(device, chr, row, column);
+}
+
+/***************************************************************************//**
+ * @brief Sends the changed parts of the framebuffer to the display.
+ *
+ * Each page with changes is written with a single burst covering its
+ * changed columns.
+ *
+ * @param device - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_flush(struct display_dev *device)
+{
+	uint16_t width;
+	uint16_t first;
+	uint16_t len;
+	int32_t ret;
+	uint8_t i;
+
+	if (!device || !device->fb)
+		return -EINVAL;
+
+	width = device->cols_nb * DISPLAY_CHARSZ;
+	for (i = 0; i < device->rows_nb; i++) {
+		first = device->dirty_first[i];
+		if (first == DISPLAY_CLEAN)
+			continue;
+
+		len = device->dirty_last[i] - first + 1;
+		memcpy(device->fb_tx, &device->fb[i * width + first], len);
+		ret = device->controller_ops->write_page(device, i, first,
+				device->fb_tx, len);
+		if (ret != 0)
+			return ret;
+
+		device->dirty_first[i] = DISPLAY_CLEAN;
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Sets or clears a framebuffer pixel. Pixels out of the display are
+ * ignored.
+ *
+ * @param device - The device structure.
+ * @param x      - Column.
+ * @param y      - Line, bit y % 8 of page y / 8.
+ * @param on     - Pixel state.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_draw_pixel(struct display_dev *device, uint16_t x, uint16_t y,
+			   bool on)
+{
+	uint16_t width;
+	uint8_t *byte;
+
+	if (!device || !device->fb)
+		return -EINVAL;
+
+	width = device->cols_nb * DISPLAY_CHARSZ;
+	if (x >= width || y >= device->rows_nb * 8U)
+		return 0;
+
+	byte = &device->fb[(y / 8) * width + x];
+	if (on)
+		*byte |= NO_OS_BIT(y % 8);
+	else
+		*byte &= ~NO_OS_BIT(y % 8);
+	display_fb_dirty(device, y / 8, x, x);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Fills a framebuffer rectangle.
+ *
+ * @param device - The device structure.
+ * @param x      - Left column.
+ * @param y      - Top line.
+ * @param w      - Width.
+ * @param h      - Height.
+ * @param on     - Pixel state.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_fill_rect(struct display_dev *device, uint16_t x, uint16_t y,
+			  uint16_t w, uint16_t h, bool on)
+{
+	uint16_t i, j;
+	int32_t ret;
+
+	for (j = y; j < y + h; j++)
+		for (i = x; i < x + w; i++) {
+			ret = display_draw_pixel(device, i, j, on);
+			if (ret != 0)
+				return ret;
+		}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Draws text at any pixel position of the framebuffer, with the
+ * 8x8 font.
+ *
+ * @param device - The device structure.
+ * @param msg    - char string pointer
+ * @param x      - Left column.
+ * @param y      - Top line.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_draw_text(struct display_dev *device, const char *msg,
+			  uint16_t x, uint16_t y)
+{
+	const uint8_t *glyph;
+	uint16_t i, j;
+	int32_t ret;
+
+	if (!device || !device->fb || !msg)
+		return -EINVAL;
+
+	for (; *msg; msg++, x += DISPLAY_CHARSZ) {
+		glyph = no_os_chr_8x8[*msg & 0x7F];
+		for (i = 0; i < DISPLAY_CHARSZ; i++)
+			for (j = 0; j < 8; j++) {
+				ret = display_draw_pixel(device, x + i, y + j,
+							 glyph[i] & NO_OS_BIT(j));
+				if (ret != 0)
+					return ret;
+			}
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Draws a horizontal bar filled in proportion to value.
+ *
+ * @param device - The device structure.
+ * @param x      - Left column.
+ * @param y      - Top line.
+ * @param w      - Width, including the outline.
+ * @param h      - Height, including the outline.
+ * @param value  - Value shown, clamped to min and max.
+ * @param min    - Value of an empty bar.
+ * @param max    - Value of a full bar.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_draw_bar(struct display_dev *device, uint16_t x, uint16_t y,
+			 uint16_t w, uint16_t h, int32_t value, int32_t min,
+			 int32_t max)
+{
+	uint16_t fill;
+	int32_t ret;
+
+	if (w < 3 || h < 3 || max <= min)
+		return -EINVAL;
+
+	value = no_os_clamp(value, min, max);
+	fill = (int64_t)(value - min) * (w - 2) / ((int64_t)max - min);
+
+	ret = display_fill_rect(device, x, y, w, h, true);
+	if (ret != 0)
+		return ret;
+
+	return display_fill_rect(device, x + 1 + fill, y + 1, w - 2 - fill,
+				 h - 2, false);
+}
+
+/***************************************************************************//**
+ * @brief Draws the last samples of a series as a sparkline, one sample per
+ * column, the consecutive samples joined by vertical segments.
+ *
+ * @param device    - The device structure.
+ * @param x         - Left column.
+ * @param y         - Top line.
+ * @param w         - Width, the number of samples shown.
+ * @param h         - Height.
+ * @param values    - The series, oldest first.
+ * @param nb_values - Number of samples in the series.
+ * @param min       - Value drawn on the bottom line.
+ * @param max       - Value drawn on the top line.
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t display_draw_sparkline(struct display_dev *device, uint16_t x,
+			       uint16_t y, uint16_t w, uint16_t h,
+			       const int32_t *values, uint32_t nb_values,
+			       int32_t min, int32_t max)
+{
+	uint16_t prev = 0;
+	uint16_t cur;
+	uint32_t first;
+	uint32_t i;
+	uint16_t j;
+	int32_t ret;
+
+	if (!values || !h || max <= min)
+		return -EINVAL;
+
+	ret = display_fill_rect(device, x, y, w, h, false);
+	if (ret != 0)
+		return ret;
+
+	first = nb_values > w ? nb_values - w : 0;
+	for (i = first; i < nb_values; i++) {
+		cur = (int64_t)(no_os_clamp(values[i], min, max) - min) *
+		      (h - 1) / ((int64_t)max - min);
+		cur = y + h - 1 - cur;
+		if (i == first)
+			prev = cur;
+
+		for (j = no_os_min(prev, cur); j <= no_os_max(prev, cur); j++) {
+			ret = display_draw_pixel(device, x + i - first, j, true);
+			if (ret != 0)
+				return ret;
+		}
+		prev = cur;
+	}
+
+	return 0;
 }
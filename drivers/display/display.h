@@ -44,9 +44,16 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Marks a framebuffer page without changes */
+#define DISPLAY_CLEAN		0xFFFF
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -63,6 +70,14 @@ struct display_dev {
 	const struct display_controller_ops *controller_ops;
 	/**  Display extra parameters (device specific) */
 	void		               *extra;
+	/** Off-screen framebuffer, rows_nb pages of cols_nb * 8 columns */
+	uint8_t                    *fb;
+	/** First dirty column of each page, DISPLAY_CLEAN if clean */
+	uint16_t                   *dirty_first;
+	/** Last dirty column of each page */
+	uint16_t                   *dirty_last;
+	/** Copy of a page span handed to the controller */
+	uint8_t                    *fb_tx;
 };
 
 /**
@@ -78,6 +93,11 @@ struct display_init_param {
 	const struct display_controller_ops *controller_ops;
 	/**  Display extra parameters (device specific) */
 	void		               *extra;
+	/**
+	 * Draw in an off-screen framebuffer, sent by display_flush(). Needs
+	 * the write_page controller op.
+	 */
+	bool                       framebuffer;
 };
 
 /**
@@ -97,6 +117,12 @@ struct display_controller_ops {
 			      uint8_t);
 	/** Removes resources allocated by device */
 	int32_t (*remove)(struct display_dev *);
+	/**
+	 * Optional, write len bytes of a page from a column in one burst. The
+	 * data buffer may be overwritten.
+	 */
+	int32_t (*write_page)(struct display_dev *, uint8_t, uint16_t,
+			      uint8_t *, uint16_t);
 };
 
 /******************************************************************************/
@@ -131,4 +157,30 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 int32_t display_print_char(struct display_dev *device, char chr,
 			   uint8_t row, uint8_t column);
 
+/** Sends the changed parts of the framebuffer to the display. */
+int32_t display_flush(struct display_dev *device);
+
+/** Sets or clears a framebuffer pixel. */
+int32_t display_draw_pixel(struct display_dev *device, uint16_t x, uint16_t y,
+			   bool on);
+
+/** Fills a framebuffer rectangle. */
+int32_t display_fill_rect(struct display_dev *device, uint16_t x, uint16_t y,
+			  uint16_t w, uint16_t h, bool on);
+
+/** Draws text at any pixel position of the framebuffer. */
+int32_t display_draw_text(struct display_dev *device, const char *msg,
+			  uint16_t x, uint16_t y);
+
+/** Draws a horizontal bar filled in proportion to value. */
+int32_t display_draw_bar(struct display_dev *device, uint16_t x, uint16_t y,
+			 uint16_t w, uint16_t h, int32_t value, int32_t min,
+			 int32_t max);
+
+/** Draws the last samples of a series as a sparkline. */
+int32_t display_draw_sparkline(struct display_dev *device, uint16_t x,
+			       uint16_t y, uint16_t w, uint16_t h,
+			       const int32_t *values, uint32_t nb_values,
+			       int32_t min, int32_t max);
+
 #endif
@@ -355,6 +355,53 @@ int nhd_c12832a1z_write_data(struct nhd_c12832a1z_dev *dev, uint8_t data)
 	return no_os_spi_write_and_read(dev->spi_desc, &data, 1U);
 }
 
+/**
+ * @brief nhd_c12832a1z write a span of a display page in a single burst.
+ * @param dev - The device structure.
+ * @param page - Page, 0 to NR_PAGES - 1.
+ * @param column - First column.
+ * @param data - Page bytes, overwritten by the transfer.
+ * @param len - Number of columns.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int nhd_c12832a1z_write_page(struct nhd_c12832a1z_dev *dev, uint8_t page,
+			     uint8_t column, uint8_t *data, uint16_t len)
+{
+	int ret;
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.rx_buff = data,
+		.bytes_number = len,
+	};
+
+	if (page >= NR_PAGES || column + len > NR_COLUMNS)
+		return -EINVAL;
+
+	ret = nhd_c12832a1z_write_cmd(dev, PAGE_START_ADDR + page);
+	if (ret)
+		return ret;
+
+	// column address upper 4 bits + 0x10
+	ret = nhd_c12832a1z_write_cmd(dev, 0x10 | (column >> 4));
+	if (ret)
+		return ret;
+
+	// column address lower 4 bits + 0x00
+	ret = nhd_c12832a1z_write_cmd(dev, column & 0x0F);
+	if (ret)
+		return ret;
+
+	ret = no_os_gpio_set_value(dev->dc_pin, NHD_C12832A1Z_DC_DATA);
+	if (ret)
+		return ret;
+
+	ret = no_os_spi_transfer_dma_sync(dev->spi_desc, &msg, 1);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_write_and_read(dev->spi_desc, data, len);
+
+	return ret;
+}
+
 /**
  * @brief nhd_c12832a1z print string on LCD.
  * @param dev - The device structure.
@@ -366,7 +413,6 @@ int nhd_c12832a1z_print_string(struct nhd_c12832a1z_dev *dev, char *msg)
 	int ret;
 	unsigned int i, j;
 	uint8_t framebuffer_memory[NR_PAGES][NR_COLUMNS] = { 0 };
-	uint8_t page = PAGE_START_ADDR;
 	int32_t count = strlen(msg);
 	int32_t t_cursor = 0;
 
@@ -391,30 +437,11 @@ int nhd_c12832a1z_print_string(struct nhd_c12832a1z_dev *dev, char *msg)
 	if (ret)
 		return ret;
 
-	for (i = 0; i < 4; i++) {
-		// 32pixel display / 8 pixels per page = 4 pages
-		ret = nhd_c12832a1z_write_cmd(dev, page); // send page address
-		if (ret)
-			return ret;
-
-		// Sets the most significant 4 bits of the display RAM column address.
-		ret = nhd_c12832a1z_write_cmd(dev, 0x10); // column address upper 4 bits + 0x10
-		// Sets the least significant 4 bits of the display RAM column address.
-		if (ret)
-			return ret;
-
-		ret = nhd_c12832a1z_write_cmd(dev, 0x00); // column address lower 4 bits + 0x00
+	for (i = 0; i < NR_PAGES; i++) {
+		ret = nhd_c12832a1z_write_page(dev, i, 0, framebuffer_memory[i],
+					       NR_COLUMNS);
 		if (ret)
 			return ret;
-
-		for (j = 0; j < 128; j++) {
-			// 128 columns wide
-			ret = nhd_c12832a1z_write_data(dev,
-						       framebuffer_memory[i][j]); // send picture data
-			if (ret)
-				return ret;
-		}
-		page++; // after 128 columns, go to next page
 	}
 
 	return nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_ON);
@@ -429,7 +456,7 @@ int nhd_c12832a1z_clear_lcd(struct nhd_c12832a1z_dev *dev)
 {
 	int ret;
 	unsigned int i;
-	uint8_t page = PAGE_START_ADDR;
+	uint8_t blank[NR_COLUMNS];
 
 	ret = nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_OFF);
 	if (ret)
@@ -440,25 +467,11 @@ int nhd_c12832a1z_clear_lcd(struct nhd_c12832a1z_dev *dev)
 	if (ret)
 		return ret;
 	for (i = 0; i < NR_PAGES; i++) {
-		// 32pixel display / 8 pixels per page = 4 pages
-		ret = nhd_c12832a1z_write_cmd(dev, page); // send page address
-		if (ret)
-			return ret;
-		// Sets the most significant 4 bits of the display RAM column address.
-		ret = nhd_c12832a1z_write_cmd(dev, 0x10); // column address upper 4 bits + 0x10
-		// Sets the least significant 4 bits of the display RAM column address.
-		if (ret)
-			return ret;
-		ret = nhd_c12832a1z_write_cmd(dev, 0x00); // column address lower 4 bits + 0x00
+		// The transfer overwrites the buffer with the received bytes
+		memset(blank, 0, sizeof(blank));
+		ret = nhd_c12832a1z_write_page(dev, i, 0, blank, NR_COLUMNS);
 		if (ret)
 			return ret;
-		for (unsigned int j = 0; j < NR_COLUMNS; j++) {
-			// 128 columns wide
-			ret = nhd_c12832a1z_write_data(dev, 0x00); // send picture data
-			if (ret)
-				return ret;
-		}
-		page++; // after 128 columns, go to next page
 	}
 
 	return nhd_c12832a1z_write_cmd(dev, NHD_C12832A1Z_DISP_ON);
@@ -121,6 +121,10 @@ int nhd_c12832a1z_write_cmd(struct nhd_c12832a1z_dev *dev, uint8_t cmd);
 /* nhd_c12832a1z write data */
 int nhd_c12832a1z_write_data(struct nhd_c12832a1z_dev *dev, uint8_t data);
 
+/* nhd_c12832a1z write a span of a display page in a single burst */
+int nhd_c12832a1z_write_page(struct nhd_c12832a1z_dev *dev, uint8_t page,
+			     uint8_t column, uint8_t *data, uint16_t len);
+
 /* nhd_c12832a1z print string on LCD */
 int nhd_c12832a1z_print_string(struct nhd_c12832a1z_dev *dev, char *msg);
 
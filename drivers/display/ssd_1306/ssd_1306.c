@@ -64,6 +64,7 @@ const struct display_controller_ops ssd1306_ops = {
 	.display_on_off = &ssd_1306_display_on_off,
 	.move_cursor = &ssd_1306_move_cursor,
 	.print_char = &ssd_1306_print_ascii,
+	.write_page = &ssd_1306_write_page,
 	.remove = &ssd_1306_remove
 };
 
@@ -239,6 +240,55 @@ int32_t ssd_1306_print_ascii(struct display_dev *device, uint8_t ascii,
 	return no_os_spi_write_and_read(extra->spi_desc, ch, SSD1306_CHARSZ);
 }
 
+/***************************************************************************//**
+ * @brief Writes a span of a display page in a single burst.
+ *
+ * @param device - The device structure.
+ * @param page   - page
+ * @param column - first column, in pixels
+ * @param data   - page bytes, overwritten by the transfer
+ * @param len    - number of columns
+ * @return Returns 0 in case of success or negative error code otherwise.
+*******************************************************************************/
+int32_t ssd_1306_write_page(struct display_dev *device, uint8_t page,
+			    uint16_t column, uint8_t *data, uint16_t len)
+{
+	int32_t ret;
+	uint8_t command[3];
+	ssd_1306_extra *extra;
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.rx_buff = data,
+		.bytes_number = len,
+	};
+
+	extra = device->extra;
+	ret = no_os_gpio_set_value(extra->dc_pin, SSD1306_DC_CMD);
+	if (ret != 0)
+		return -1;
+	command[0] = 0x21;
+	command[1] = column;
+	command[2] = column + len - 1U;
+	ret = no_os_spi_write_and_read(extra->spi_desc, command, 3U);
+	if (ret != 0)
+		return -1;
+	command[0] = 0x22;
+	command[1] = page;
+	command[2] = page;
+	ret = no_os_spi_write_and_read(extra->spi_desc, command, 3U);
+	if (ret != 0)
+		return -1;
+	ret = no_os_gpio_set_value(extra->dc_pin, SSD1306_DC_DATA);
+	if (ret != 0)
+		return -1;
+
+	ret = no_os_spi_transfer_dma_sync(extra->spi_desc, &msg, 1);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_write_and_read(extra->spi_desc, data, len);
+
+	return ret;
+}
+
 /***************************************************************************//**
  * @brief Removes resources allocated by device.
  *
@@ -89,6 +89,10 @@ int32_t ssd_1306_move_cursor(struct display_dev *device, uint8_t row,
 int32_t ssd_1306_print_ascii(struct display_dev *device, uint8_t ascii,
 			     uint8_t row, uint8_t column);
 
+/** Writes a span of a display page in a single burst. */
+int32_t ssd_1306_write_page(struct display_dev *device, uint8_t page,
+			    uint16_t column, uint8_t *data, uint16_t len);
+
 /** Removes resources allocated by device. */
 int32_t ssd_1306_remove(struct display_dev *device);
 
@@ -43,10 +43,15 @@
 /***************************** Include Files *********************************/
 /*****************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "adas1000.h"
 #include "no_os_crc.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
+
+static void adas1000_stream_done(void *ctx);
 
 /*****************************************************************************/
 /************************ Function Definitions *******************************/
@@ -152,6 +157,9 @@ int32_t adas1000_read(struct adas1000_dev *device, uint8_t reg_addr,
 	uint8_t buff[4];
 	uint8_t buff_size = 4;
 
+	if (device->stream)
+		return -EBUSY;
+
 	*reg_data = 0;
 
 	buff[0] = reg_addr;
@@ -179,6 +187,9 @@ int32_t adas1000_write(struct adas1000_dev *device, uint8_t reg_addr,
 	uint8_t buff[4];
 	uint8_t buff_size = 4;
 
+	if (device->stream)
+		return -EBUSY;
+
 	buff[0] = ADAS1000_COMM_WRITE | reg_addr;
 	buff[1] = reg_data >> 16;
 	buff[2] = reg_data >> 8;
@@ -411,12 +422,267 @@ uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device, uint8_t *buff)
 
 	/** Select the CRC poly and word size based on the frame rate. */
 	if(device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
-		NO_OS_DECLARE_CRC16_TABLE(adas1000_crc16);
-		no_os_crc16_populate_msb(adas1000_crc16, CRC_POLY_128KHZ);
-		return no_os_crc16(adas1000_crc16, buff, device->frame_size, (uint16_t)crc);
+		return no_os_crc16(no_os_crc16_get_table(CRC_POLY_128KHZ), buff,
+				   device->frame_size, (uint16_t)crc);
 	} else {
-		NO_OS_DECLARE_CRC24_TABLE(adas1000_crc24);
-		no_os_crc24_populate_msb(adas1000_crc24, CRC_POLY_2KHZ_16KHZ);
-		return no_os_crc24(adas1000_crc24, buff, device->frame_size, crc);
+		return no_os_crc24(no_os_crc24_get_table(CRC_POLY_2KHZ_16KHZ), buff,
+				   device->frame_size, crc);
 	}
 }
+
+/**
+ * @brief Starts the DMA read of the next block of the ring.
+ * @param device - Device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adas1000_stream_next(struct adas1000_dev *device)
+{
+	struct adas1000_stream *stream = device->stream;
+	uint32_t block_size = stream->block_frames * stream->frame_size;
+	int32_t ret;
+
+	stream->msg.rx_buff = stream->ring +
+			      (stream->wr % stream->nb_blocks) * block_size;
+	stream->busy = true;
+	ret = no_os_spi_transfer_dma_async(device->spi_desc, &stream->msg, 1,
+					   adas1000_stream_done, device);
+	if (ret)
+		stream->busy = false;
+
+	return ret;
+}
+
+/**
+ * @brief Called when a block is read, in interrupt context. The next block is
+ *	  read right away while the ring has room, the SPI clock set by
+ *	  adas1000_compute_spi_freq() pacing the reads with the frame rate.
+ * @param ctx - Device structure.
+ */
+static void adas1000_stream_done(void *ctx)
+{
+	struct adas1000_dev *device = ctx;
+	struct adas1000_stream *stream = device->stream;
+
+	stream->wr++;
+	stream->busy = false;
+
+	if (!stream->stop && stream->wr - stream->rd < stream->nb_blocks)
+		adas1000_stream_next(device);
+}
+
+/**
+ * @brief Starts reading frames continuously into a ring of blocks.
+ *
+ * Only the words selected by param->inactive_words are kept in the frames,
+ * which shortens the transfers. The caller routes the DRDY falling edge to
+ * adas1000_stream_trigger() to start the first block and to resume once the
+ * ring had been full. Blocks are then read back to back by DMA, without CPU
+ * involvement per frame, and checked in batches by adas1000_stream_read().
+ *
+ * Register accesses return -EBUSY while streaming.
+ * @param device - Device structure.
+ * @param param - Stream parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_start(struct adas1000_dev *device,
+			      const struct adas1000_stream_init_param *param)
+{
+	struct no_os_crc_init_param crc_param = { 0 };
+	struct adas1000_stream *stream;
+	int32_t ret;
+
+	if (!device || device->stream || !param || !param->block_frames ||
+	    param->nb_blocks < 2 ||
+	    (param->inactive_words & ~ADAS1000_FRMCTL_WORD_MASK))
+		return -EINVAL;
+
+	ret = adas1000_set_inactive_framewords(device, param->inactive_words);
+	if (ret)
+		return ret;
+
+	stream = (struct adas1000_stream *)no_os_calloc(1, sizeof(*stream));
+	if (!stream)
+		return -ENOMEM;
+
+	stream->frame_size = device->frame_size;
+	stream->block_frames = param->block_frames;
+	stream->nb_blocks = param->nb_blocks;
+	stream->buf = param->buf;
+	stream->msg.bytes_number = stream->block_frames * stream->frame_size;
+	stream->msg.cs_change = 1;
+
+	stream->ring = (uint8_t *)no_os_calloc(stream->nb_blocks,
+					       stream->msg.bytes_number);
+	if (!stream->ring) {
+		ret = -ENOMEM;
+		goto free_stream;
+	}
+
+	if (!(param->inactive_words & ADAS1000_FRMCTL_CRCDIS)) {
+		if (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
+			crc_param.width = 16;
+			crc_param.polynomial = CRC_POLY_128KHZ;
+			stream->crc_check = CRC_CHECK_CONST_128KHz;
+		} else {
+			crc_param.width = 24;
+			crc_param.polynomial = CRC_POLY_2KHZ_16KHZ;
+			stream->crc_check = CRC_CHECK_CONST_2KHZ_16KHZ;
+		}
+		crc_param.platform_ops = param->crc_ops;
+
+		ret = no_os_crc_init(&stream->crc, &crc_param);
+		if (ret)
+			goto free_ring;
+	}
+
+	/** The FRAMES command starts the frame read mode. */
+	ret = adas1000_write(device, ADAS1000_FRAMES, 0);
+	if (ret)
+		goto remove_crc;
+
+	device->stream = stream;
+
+	return 0;
+
+remove_crc:
+	if (stream->crc)
+		no_os_crc_remove(stream->crc);
+free_ring:
+	no_os_free(stream->ring);
+free_stream:
+	no_os_free(stream);
+
+	return ret;
+}
+
+/**
+ * @brief Starts reading the next block, called on the DRDY falling edge.
+ * @param device - Device structure.
+ * @return 0 in case of success, -EBUSY if a block is already being read or
+ *	   the ring is full, negative error code otherwise.
+ */
+int32_t adas1000_stream_trigger(struct adas1000_dev *device)
+{
+	struct adas1000_stream *stream;
+
+	if (!device || !device->stream)
+		return -EINVAL;
+
+	stream = device->stream;
+	if (stream->busy)
+		return -EBUSY;
+
+	if (stream->wr - stream->rd >= stream->nb_blocks) {
+		stream->overruns++;
+		return -EBUSY;
+	}
+
+	return adas1000_stream_next(device);
+}
+
+/**
+ * @brief Checks the oldest complete block and returns its valid frames.
+ *
+ * Frames whose header is not ready or whose CRC does not match are dropped
+ * and the valid ones are moved to the start of the block, which stays valid
+ * until the next call. They are also written to the stream buffer, if any.
+ * @param device - Device structure.
+ * @param frames - Valid frames, in the adas1000_read_data() layout.
+ * @param nb_frames - Number of valid frames.
+ * @return 0 in case of success, -EAGAIN if no block is available, negative
+ *	   error code otherwise.
+ */
+int32_t adas1000_stream_read(struct adas1000_dev *device, uint8_t **frames,
+			     uint32_t *nb_frames)
+{
+	struct adas1000_stream *stream;
+	uint8_t *block, *frame;
+	uint32_t i, n = 0;
+	uint32_t crc;
+	int32_t ret;
+
+	if (!device || !device->stream || !frames || !nb_frames)
+		return -EINVAL;
+
+	stream = device->stream;
+	if (stream->held) {
+		stream->rd++;
+		stream->held = false;
+	}
+
+	if (stream->wr == stream->rd)
+		return -EAGAIN;
+
+	block = stream->ring + (stream->rd % stream->nb_blocks) *
+		stream->block_frames * stream->frame_size;
+
+	for (i = 0; i < stream->block_frames; i++) {
+		frame = block + i * stream->frame_size;
+
+		if (*frame & ADAS1000_RDY_MASK) {
+			stream->not_ready++;
+			continue;
+		}
+
+		if (stream->crc) {
+			ret = no_os_crc_compute(stream->crc, frame,
+						stream->frame_size,
+						NO_OS_GENMASK(stream->crc->width - 1, 0),
+						&crc);
+			if (ret)
+				return ret;
+
+			if (crc != stream->crc_check) {
+				stream->crc_errors++;
+				continue;
+			}
+		}
+
+		if (frame != block + n * stream->frame_size)
+			memmove(block + n * stream->frame_size, frame,
+				stream->frame_size);
+		n++;
+	}
+
+	if (stream->buf && n)
+		no_os_cb_write(stream->buf, block, n * stream->frame_size);
+
+	*frames = block;
+	*nb_frames = n;
+	stream->held = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stops the frame stream and leaves the frame read mode.
+ * @param device - Device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adas1000_stream_stop(struct adas1000_dev *device)
+{
+	struct adas1000_stream *stream;
+	uint32_t timeout = 10000;
+	uint32_t reg;
+
+	if (!device || !device->stream)
+		return -EINVAL;
+
+	stream = device->stream;
+	/** Keep the completion from chaining another block. */
+	stream->stop = true;
+	while (stream->busy && --timeout)
+		no_os_udelay(1);
+
+	device->stream = NULL;
+	if (stream->crc)
+		no_os_crc_remove(stream->crc);
+	no_os_free(stream->ring);
+	no_os_free(stream);
+
+	if (!timeout)
+		return -ETIMEDOUT;
+
+	/** Reading a register stops the frame read mode. */
+	return adas1000_read(device, ADAS1000_FRMCTL, &reg);
+}
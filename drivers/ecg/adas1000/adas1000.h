@@ -49,6 +49,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_crc.h"
+#include "no_os_circular_buffer.h"
 
 /******************************************************************************/
 /* ADAS1000 SPI Registers Memory Map */
@@ -1073,6 +1075,54 @@
 #define CRC_POLY_128KHZ				               0x00001021ul
 #define CRC_CHECK_CONST_128KHz			         0x00001D0Ful
 
+struct adas1000_stream_init_param {
+	/** Words excluded from the frames, see adas1000_set_inactive_framewords() */
+	uint32_t inactive_words;
+	/** Number of frames read by one DMA transfer */
+	uint32_t block_frames;
+	/** Number of blocks in the ring, at least 2 */
+	uint32_t nb_blocks;
+	/** Hardware CRC unit, NULL to check the frame CRC in software */
+	const struct no_os_crc_platform_ops *crc_ops;
+	/** Optional buffer, e.g. of an IIO device, receiving the valid frames */
+	struct no_os_circular_buffer *buf;
+};
+
+struct adas1000_stream {
+	/** Read of one block */
+	struct no_os_spi_msg msg;
+	/** Ring of nb_blocks * block_frames frames */
+	uint8_t *ring;
+	/** Frame size in bytes */
+	uint32_t frame_size;
+	/** Number of frames in a block */
+	uint32_t block_frames;
+	/** Number of blocks in the ring */
+	uint32_t nb_blocks;
+	/** Number of completed blocks */
+	volatile uint32_t wr;
+	/** Number of consumed blocks */
+	uint32_t rd;
+	/** Set while a block is being read */
+	volatile bool busy;
+	/** Set when stopping, no further block is started */
+	volatile bool stop;
+	/** Set while the caller holds the block returned by the last read */
+	bool held;
+	/** CRC engine, NULL if the CRC word is excluded from the frames */
+	struct no_os_crc_desc *crc;
+	/** CRC of a valid frame, including its CRC word */
+	uint32_t crc_check;
+	/** Buffer receiving the valid frames, may be NULL */
+	struct no_os_circular_buffer *buf;
+	/** Number of DRDY events dropped because the ring was full */
+	uint32_t overruns;
+	/** Number of frames dropped because their header was not ready */
+	uint32_t not_ready;
+	/** Number of frames dropped because of a CRC mismatch */
+	uint32_t crc_errors;
+};
+
 struct adas1000_dev {
 	/** SPI Descriptor */
 	struct no_os_spi_desc *spi_desc;
@@ -1082,6 +1132,8 @@ struct adas1000_dev {
 	uint32_t frame_rate;
 	/** Number of inactive words in a frame */
 	uint32_t inactive_words_no;
+	/** Frame stream, NULL when not running */
+	struct adas1000_stream *stream;
 };
 
 struct adas1000_init_param {
@@ -1146,4 +1198,18 @@ int32_t adas1000_read_data(struct adas1000_dev *device, uint8_t *data_buff,
 uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device,
 				    uint8_t *buff);
 
+/* Starts reading frames continuously into a ring of blocks */
+int32_t adas1000_stream_start(struct adas1000_dev *device,
+			      const struct adas1000_stream_init_param *param);
+
+/* Starts reading the next block, called on the DRDY falling edge */
+int32_t adas1000_stream_trigger(struct adas1000_dev *device);
+
+/* Checks the oldest complete block and returns its valid frames */
+int32_t adas1000_stream_read(struct adas1000_dev *device, uint8_t **frames,
+			     uint32_t *nb_frames);
+
+/* Stops the frame stream */
+int32_t adas1000_stream_stop(struct adas1000_dev *device);
+
 #endif /* _ADAS1000_H_ */
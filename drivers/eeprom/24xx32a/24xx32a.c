@@ -105,8 +105,39 @@ error_eeprom_dev:
 	return ret;
 }
 
+/**
+ * @brief 	Wait for the end of the last page write by ACK polling
+ * @param	eeprom_dev - EEPROM device
+ * @return	0 in case of success, negative error code otherwise
+ */
+static int32_t eeprom_24xx32a_wait_ready(struct eeprom_24xx32a_dev *eeprom_dev)
+{
+	uint8_t buff[2] = {0};
+	uint32_t tries;
+	int32_t ret;
+
+	if (!eeprom_dev->write_pending)
+		return 0;
+
+	/* The device does not acknowledge its address during a write cycle */
+	for (tries = 0; tries < EEPROM_24XX32A_ACK_POLL_TRIES; tries++) {
+		ret = no_os_i2c_write(eeprom_dev->i2c_desc, buff, sizeof(buff), 1);
+		if (!ret) {
+			eeprom_dev->write_pending = false;
+			return 0;
+		}
+
+		no_os_udelay(EEPROM_24XX32A_ACK_POLL_US);
+	}
+
+	return -ETIMEDOUT;
+}
+
 /**
  * @brief 	Read the 24XX32A EEPROM data
+ *
+ * The data is read sequentially in a single transaction, the device
+ * increments the address internally.
  * @param	desc - EEPROM descriptor
  * @param	address - EEPROM address/location to read
  * @param	data - EEPROM data (pointer)
@@ -117,36 +148,37 @@ int32_t eeprom_24xx32a_read(struct no_os_eeprom_desc *desc, uint32_t address,
 			    uint8_t *data, uint16_t bytes)
 {
 	int32_t ret;
-	uint16_t indx;
 	uint8_t buff[2];
-	uint32_t curr_address = address;
 	struct eeprom_24xx32a_dev *eeprom_dev;
 
 	if (!desc || !desc->extra || !data)
 		return -EINVAL;
 
-	eeprom_dev = desc->extra;
+	if (!bytes)
+		return 0;
 
-	/* Perform byte by byte read */
-	for (indx = 0; indx < bytes; indx++) {
-		no_os_put_unaligned_be16(curr_address, buff);
+	eeprom_dev = desc->extra;
 
-		ret = no_os_i2c_write(eeprom_dev->i2c_desc, buff, sizeof(buff), 1);
-		if (ret)
-			return ret;
+	ret = eeprom_24xx32a_wait_ready(eeprom_dev);
+	if (ret)
+		return ret;
 
-		ret = no_os_i2c_read(eeprom_dev->i2c_desc, &data[indx], 1, 1);
-		if (ret)
-			return ret;
+	no_os_put_unaligned_be16(address, buff);
 
-		curr_address++;
-	}
+	/* Repeated start between the address and the data */
+	ret = no_os_i2c_write(eeprom_dev->i2c_desc, buff, sizeof(buff), 0);
+	if (ret)
+		return ret;
 
-	return 0;
+	return no_os_i2c_read(eeprom_dev->i2c_desc, data, bytes, 1);
 }
 
 /**
  * @brief 	Write the 24XX32A EEPROM data
+ *
+ * The data is split at page boundaries and each page is written in one
+ * transaction. The end of a write cycle is detected by ACK polling before
+ * the next access, so the last page completes in the background.
  * @param	desc - EEPROM descriptor
  * @param	address - EEPROM address/location to write
  * @param	data - EEPROM data (pointer)
@@ -157,11 +189,8 @@ int32_t eeprom_24xx32a_write(struct no_os_eeprom_desc *desc, uint32_t address,
 			     uint8_t *data, uint16_t bytes)
 {
 	int32_t ret;
-	uint16_t indx;
-	uint8_t buff[34];
-	uint8_t page;
-	uint8_t pagecount = bytes / 32 + (bytes % 32 ? 1 : 0);
-	uint32_t curr_address = address;
+	uint16_t len;
+	uint8_t buff[EEPROM_24XX32A_PAGE_SIZE + 2];
 	struct eeprom_24xx32a_dev *eeprom_dev;
 
 	if (!desc || !desc->extra || !data)
@@ -169,34 +198,26 @@ int32_t eeprom_24xx32a_write(struct no_os_eeprom_desc *desc, uint32_t address,
 
 	eeprom_dev = desc->extra;
 
-	if (address % 32 == 0) {
-		/* Perform page write */
-		for (page = 0; page < pagecount; page++) {
-			no_os_put_unaligned_be16(address + page * 32, buff);
-			memcpy(&buff[2], &data[page * 32], 32);
-
-			ret = no_os_i2c_write(eeprom_dev->i2c_desc, buff, sizeof(buff), 1);
-			if (ret)
-				return ret;
+	while (bytes) {
+		len = EEPROM_24XX32A_PAGE_SIZE -
+		      address % EEPROM_24XX32A_PAGE_SIZE;
+		len = no_os_min(len, bytes);
 
-			/* Write cycle time (typ 5msec as per datasheet) */
-			no_os_mdelay(5);
-		}
-	} else {
-		/* Perform byte by byte write */
-		for (indx = 0; indx < bytes; indx++) {
-			no_os_put_unaligned_be16(curr_address, buff);
-			buff[2] = data[indx];
+		ret = eeprom_24xx32a_wait_ready(eeprom_dev);
+		if (ret)
+			return ret;
 
-			ret = no_os_i2c_write(eeprom_dev->i2c_desc, buff, 3, 1);
-			if (ret)
-				return ret;
+		no_os_put_unaligned_be16(address, buff);
+		memcpy(&buff[2], data, len);
 
-			/* Write cycle time (typ 5msec as per datasheet) */
-			no_os_mdelay(5);
+		ret = no_os_i2c_write(eeprom_dev->i2c_desc, buff, len + 2, 1);
+		if (ret)
+			return ret;
 
-			curr_address++;
-		}
+		eeprom_dev->write_pending = true;
+		address += len;
+		data += len;
+		bytes -= len;
 	}
 
 	return 0;
@@ -45,8 +45,18 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_i2c.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define EEPROM_24XX32A_PAGE_SIZE	32
+/* ACK polling covers the 5 ms maximum write cycle time with margin */
+#define EEPROM_24XX32A_ACK_POLL_US	100
+#define EEPROM_24XX32A_ACK_POLL_TRIES	100
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -67,6 +77,8 @@ struct eeprom_24xx32a_init_param {
 struct eeprom_24xx32a_dev {
 	/** I2C descriptor*/
 	struct no_os_i2c_desc *i2c_desc;
+	/** A page write cycle may still be in progress */
+	bool write_pending;
 };
 
 /**
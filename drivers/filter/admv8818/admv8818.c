@@ -50,18 +50,31 @@
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 
-static const unsigned long long freq_range_hpf[4][2] = {
-	{1750000000ULL, 3550000000ULL},
-	{3400000000ULL, 7250000000ULL},
-	{6600000000, 12000000000},
-	{12500000000, 19900000000}
+/* Band edges and state spacing, precomputed so that tuning needs no division */
+#define ADMV8818_BAND(start, stop)	{start, stop, ((stop) - (start)) / 15}
+
+/**
+ * @struct admv8818_band
+ * @brief Frequency range of a filter band, covered by 16 states.
+ */
+struct admv8818_band {
+	unsigned long long start;
+	unsigned long long stop;
+	unsigned long long step;
 };
 
-static const unsigned long long freq_range_lpf[4][2] = {
-	{2050000000ULL, 3850000000ULL},
-	{3350000000ULL, 7250000000ULL},
-	{7000000000, 13000000000},
-	{12550000000, 18500000000}
+static const struct admv8818_band hpf_bands[4] = {
+	ADMV8818_BAND(1750000000ULL, 3550000000ULL),
+	ADMV8818_BAND(3400000000ULL, 7250000000ULL),
+	ADMV8818_BAND(6600000000ULL, 12000000000ULL),
+	ADMV8818_BAND(12500000000ULL, 19900000000ULL)
+};
+
+static const struct admv8818_band lpf_bands[4] = {
+	ADMV8818_BAND(2050000000ULL, 3850000000ULL),
+	ADMV8818_BAND(3350000000ULL, 7250000000ULL),
+	ADMV8818_BAND(7000000000ULL, 13000000000ULL),
+	ADMV8818_BAND(12550000000ULL, 18500000000ULL)
 };
 
 /******************************************************************************/
@@ -137,38 +150,38 @@ int admv8818_spi_update_bits(struct admv8818_dev *dev, uint8_t reg_addr,
 }
 
 /**
- * @brief Set the HPF Frequency.
- * @param dev - The device structure.
- * @param freq - The HPF Frequency to be set.
- * @return Returns 0 in case of success or negative error code.
+ * @brief Compute the HPF band and state closest to a frequency.
+ * @param freq - The HPF Frequency.
+ * @param band - The band, 0 to bypass the filter.
+ * @param state - The state within the band.
  */
-int admv8818_hpf_select(struct admv8818_dev *dev, unsigned long long freq)
+static void admv8818_hpf_code(unsigned long long freq, unsigned int *band,
+			      unsigned int *state)
 {
-	unsigned int hpf_step = 0, hpf_band = 0, i, j;
-	unsigned long long freq_step;
-	int ret;
+	unsigned int i, j;
 
-	if (freq < freq_range_hpf[0][0])
-		goto hpf_write;
+	*band = 0;
+	*state = 0;
 
-	if (freq > freq_range_hpf[3][1]) {
-		hpf_step = 15;
-		hpf_band = 4;
+	if (freq < hpf_bands[0].start)
+		return;
 
-		goto hpf_write;
+	if (freq > hpf_bands[3].stop) {
+		*state = 15;
+		*band = 4;
+
+		return;
 	}
 
 	/* Find and compute the closest HPF band and state relative to the input frequency */
 	for (i = 0; i < 4; i++) {
-		freq_step = (freq_range_hpf[i][1] - freq_range_hpf[i][0]) / 15;
-
-		if (freq > freq_range_hpf[i][0] &&
-		    (freq < freq_range_hpf[i][1] + freq_step)) {
-			hpf_band = i + 1;
+		if (freq > hpf_bands[i].start &&
+		    (freq < hpf_bands[i].stop + hpf_bands[i].step)) {
+			*band = i + 1;
 
 			for (j = 1; j <= 16; j++) {
-				if (freq < (freq_range_hpf[i][0] + (freq_step * j))) {
-					hpf_step = j - 1;
+				if (freq < (hpf_bands[i].start + (hpf_bands[i].step * j))) {
+					*state = j - 1;
 					break;
 				}
 			}
@@ -178,11 +191,24 @@ int admv8818_hpf_select(struct admv8818_dev *dev, unsigned long long freq)
 
 	/* Close HPF frequency gap between 12 and 12.5 GHz */
 	if (freq >= 12000 * HZ_PER_MHZ && freq <= 12500 * HZ_PER_MHZ) {
-		hpf_band = 3;
-		hpf_step = 15;
+		*band = 3;
+		*state = 15;
 	}
+}
+
+/**
+ * @brief Set the HPF Frequency.
+ * @param dev - The device structure.
+ * @param freq - The HPF Frequency to be set.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int admv8818_hpf_select(struct admv8818_dev *dev, unsigned long long freq)
+{
+	unsigned int hpf_step, hpf_band;
+	int ret;
+
+	admv8818_hpf_code(freq, &hpf_band, &hpf_step);
 
-hpf_write:
 	ret = admv8818_spi_update_bits(dev, ADMV8818_REG_WR0_SW,
 				       ADMV8818_SW_IN_SET_WR0_MSK |
 				       ADMV8818_SW_IN_WR0_MSK,
@@ -225,51 +251,64 @@ int admv8818_read_hpf_freq(struct admv8818_dev *dev, unsigned long long *freq)
 	hpf_state = no_os_field_get(ADMV8818_HPF_WR0_MSK, data);
 
 	/* Compute HPF value based on the band and state values read from the registers */
-	*freq = (freq_range_hpf[hpf_band - 1][1] - freq_range_hpf[hpf_band - 1][0]) /
-		15;
-	*freq = freq_range_hpf[hpf_band - 1][0] + (*freq * hpf_state);
+	*freq = hpf_bands[hpf_band - 1].start +
+		hpf_bands[hpf_band - 1].step * hpf_state;
 
 	return 0;
 }
 
 /**
- * @brief Set the LPF Frequency.
- * @param dev - The device structure.
- * @param freq - The LPF Frequency to be set.
- * @return Returns 0 in case of success or negative error code.
+ * @brief Compute the LPF band and state closest to a frequency.
+ * @param freq - The LPF Frequency.
+ * @param band - The band, 0 to bypass the filter.
+ * @param state - The state within the band.
  */
-int admv8818_lpf_select(struct admv8818_dev *dev, unsigned long long freq)
+static void admv8818_lpf_code(unsigned long long freq, unsigned int *band,
+			      unsigned int *state)
 {
-	unsigned int lpf_step = 0, lpf_band = 0, i, j;
-	unsigned long long freq_step;
-	int ret;
+	unsigned int i, j;
 
-	if (freq > freq_range_lpf[3][1])
-		goto lpf_write;
+	*band = 0;
+	*state = 0;
 
-	if (freq < freq_range_lpf[0][0]) {
-		lpf_band = 1;
+	if (freq > lpf_bands[3].stop)
+		return;
 
-		goto lpf_write;
+	if (freq < lpf_bands[0].start) {
+		*band = 1;
+
+		return;
 	}
 
 	/* Find and compute the closest LPF band and state relative to the input frequency */
 	for (i = 0; i < 4; i++) {
-		if (freq > freq_range_lpf[i][0] && freq < freq_range_lpf[i][1]) {
-			lpf_band = i + 1;
-			freq_step = (freq_range_lpf[i][1] - freq_range_lpf[i][0]) / 15;
+		if (freq > lpf_bands[i].start && freq < lpf_bands[i].stop) {
+			*band = i + 1;
 
 			for (j = 0; j <= 15; j++) {
-				if (freq < (freq_range_lpf[i][0] + (freq_step * j))) {
-					lpf_step = j;
+				if (freq < (lpf_bands[i].start + (lpf_bands[i].step * j))) {
+					*state = j;
 					break;
 				}
 			}
 			break;
 		}
 	}
+}
+
+/**
+ * @brief Set the LPF Frequency.
+ * @param dev - The device structure.
+ * @param freq - The LPF Frequency to be set.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int admv8818_lpf_select(struct admv8818_dev *dev, unsigned long long freq)
+{
+	unsigned int lpf_step, lpf_band;
+	int ret;
+
+	admv8818_lpf_code(freq, &lpf_band, &lpf_step);
 
-lpf_write:
 	ret = admv8818_spi_update_bits(dev, ADMV8818_REG_WR0_SW,
 				       ADMV8818_SW_OUT_SET_WR0_MSK |
 				       ADMV8818_SW_OUT_WR0_MSK,
@@ -312,13 +351,84 @@ int admv8818_read_lpf_freq(struct admv8818_dev *dev, unsigned long long *freq)
 	lpf_state = no_os_field_get(ADMV8818_LPF_WR0_MSK, data);
 
 	/* Compute LPF value based on the band and state values read from the registers */
-	*freq = (freq_range_lpf[lpf_band - 1][1] - freq_range_lpf[lpf_band - 1][0]) /
-		15;
-	*freq = freq_range_lpf[lpf_band - 1][0] + (*freq * lpf_state);
+	*freq = lpf_bands[lpf_band - 1].start +
+		lpf_bands[lpf_band - 1].step * lpf_state;
 
 	return 0;
 }
 
+/**
+ * @brief Compute the WR0 register values that set both filters.
+ * @param hpf_freq - The HPF Frequency.
+ * @param lpf_freq - The LPF Frequency.
+ * @param regs - The register values.
+ */
+static void admv8818_filter_regs_get(unsigned long long hpf_freq,
+				     unsigned long long lpf_freq,
+				     struct admv8818_filter_regs *regs)
+{
+	unsigned int hpf_band, hpf_state, lpf_band, lpf_state;
+
+	admv8818_hpf_code(hpf_freq, &hpf_band, &hpf_state);
+	admv8818_lpf_code(lpf_freq, &lpf_band, &lpf_state);
+
+	regs->sw = no_os_field_prep(ADMV8818_SW_IN_SET_WR0_MSK, 1) |
+		   no_os_field_prep(ADMV8818_SW_IN_WR0_MSK, hpf_band) |
+		   no_os_field_prep(ADMV8818_SW_OUT_SET_WR0_MSK, 1) |
+		   no_os_field_prep(ADMV8818_SW_OUT_WR0_MSK, lpf_band);
+	regs->filter = no_os_field_prep(ADMV8818_HPF_WR0_MSK, hpf_state) |
+		       no_os_field_prep(ADMV8818_LPF_WR0_MSK, lpf_state);
+}
+
+/**
+ * @brief Write the WR0 switch and filter registers in a single SPI transfer.
+ *	  Both registers are fully known, so no read is needed.
+ * @param dev - The device structure.
+ * @param regs - The register values.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int admv8818_filter_regs_write(struct admv8818_dev *dev,
+				      const struct admv8818_filter_regs *regs)
+{
+	uint8_t buff[2][ADMV8818_BUFF_SIZE_BYTES] = {
+		{ADMV8818_REG_WR0_SW, regs->sw},
+		{ADMV8818_REG_WR0_FILTER, regs->filter},
+	};
+	struct no_os_spi_msg msgs[2] = {
+		{
+			.tx_buff = buff[0],
+			.bytes_number = ADMV8818_BUFF_SIZE_BYTES,
+			.cs_change = 1,
+		},
+		{
+			.tx_buff = buff[1],
+			.bytes_number = ADMV8818_BUFF_SIZE_BYTES,
+			.cs_change = 1,
+		},
+	};
+
+	return no_os_spi_transfer(dev->spi_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+}
+
+/**
+ * @brief Set the HPF and LPF Frequencies together, with a single SPI transfer
+ *	  instead of the read-modify-write cycles of the separate selects.
+ * @param dev - The device structure.
+ * @param hpf_freq - The HPF Frequency to be set.
+ * @param lpf_freq - The LPF Frequency to be set.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int admv8818_filters_select(struct admv8818_dev *dev,
+			    unsigned long long hpf_freq,
+			    unsigned long long lpf_freq)
+{
+	struct admv8818_filter_regs regs;
+
+	admv8818_filter_regs_get(hpf_freq, lpf_freq, &regs);
+
+	return admv8818_filter_regs_write(dev, &regs);
+}
+
 /**
  * @brief Set the RF Input Band Select.
  * @param dev - The device structure.
@@ -326,13 +436,55 @@ int admv8818_read_lpf_freq(struct admv8818_dev *dev, unsigned long long *freq)
  */
 int admv8818_rfin_select(struct admv8818_dev *dev)
 {
-	int ret;
+	return admv8818_filters_select(dev, dev->rf_in, dev->rf_in);
+}
 
-	ret = admv8818_hpf_select(dev, dev->rf_in);
-	if (ret)
-		return ret;
+/**
+ * @brief Precompute the register values of a list of RF input frequencies, so
+ *	  that admv8818_hop() only has to write them. Replaces the previous list.
+ * @param dev - The device structure.
+ * @param freqs - The RF input frequencies, both filters are centered on them.
+ * @param nb_freqs - Number of frequencies, 0 to free the list.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int admv8818_set_hop_list(struct admv8818_dev *dev,
+			  const unsigned long long *freqs,
+			  unsigned int nb_freqs)
+{
+	struct admv8818_filter_regs *hops = NULL;
+	unsigned int i;
+
+	if (nb_freqs) {
+		if (!freqs)
+			return -EINVAL;
+
+		hops = no_os_calloc(nb_freqs, sizeof(*hops));
+		if (!hops)
+			return -ENOMEM;
+
+		for (i = 0; i < nb_freqs; i++)
+			admv8818_filter_regs_get(freqs[i], freqs[i], &hops[i]);
+	}
+
+	no_os_free(dev->hops);
+	dev->hops = hops;
+	dev->nb_hops = nb_freqs;
+
+	return 0;
+}
+
+/**
+ * @brief Switch both filters to an entry of the hop list.
+ * @param dev - The device structure.
+ * @param index - Index in the list given to admv8818_set_hop_list().
+ * @return Returns 0 in case of success or negative error code.
+ */
+int admv8818_hop(struct admv8818_dev *dev, unsigned int index)
+{
+	if (index >= dev->nb_hops)
+		return -EINVAL;
 
-	return admv8818_lpf_select(dev, dev->rf_in);
+	return admv8818_filter_regs_write(dev, &dev->hops[index]);
 }
 
 /**
@@ -423,6 +575,7 @@ int admv8818_remove(struct admv8818_dev *dev)
 	if (ret)
 		return ret;
 
+	no_os_free(dev->hops);
 	no_os_free(dev);
 
 	return 0;
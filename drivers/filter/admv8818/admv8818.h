@@ -134,6 +134,17 @@ struct admv8818_init_param {
 	enum admv8818_filter_mode	mode;
 };
 
+/**
+ * @struct admv8818_filter_regs
+ * @brief WR0 register values that set both filters.
+ */
+struct admv8818_filter_regs {
+	/** ADMV8818_REG_WR0_SW */
+	uint8_t sw;
+	/** ADMV8818_REG_WR0_FILTER */
+	uint8_t filter;
+};
+
 /**
  * @struct admv8818_dev
  * @brief ADMV8818 Device Descriptor.
@@ -145,6 +156,10 @@ struct admv8818_dev {
 	unsigned long long		rf_in;
 	/* Filter Mode */
 	enum admv8818_filter_mode	mode;
+	/** Precomputed registers of the hop list */
+	struct admv8818_filter_regs	*hops;
+	/** Number of entries of the hop list */
+	unsigned int			nb_hops;
 };
 
 /** ADMV8818 SPI write */
@@ -171,9 +186,22 @@ int admv8818_lpf_select(struct admv8818_dev *dev, unsigned long long freq);
 /** Get the LPF Frequency */
 int admv8818_read_lpf_freq(struct admv8818_dev *dev, unsigned long long *freq);
 
+/** Set the HPF and LPF Frequencies in a single SPI transfer */
+int admv8818_filters_select(struct admv8818_dev *dev,
+			    unsigned long long hpf_freq,
+			    unsigned long long lpf_freq);
+
 /** Set the RF Input Band Select */
 int admv8818_rfin_select(struct admv8818_dev *dev);
 
+/** Precompute the registers of a list of RF input frequencies */
+int admv8818_set_hop_list(struct admv8818_dev *dev,
+			  const unsigned long long *freqs,
+			  unsigned int nb_freqs);
+
+/** Switch both filters to an entry of the hop list */
+int admv8818_hop(struct admv8818_dev *dev, unsigned int index);
+
 /** ADMV8818 Initialization */
 int admv8818_init(struct admv8818_dev **device,
 		  struct admv8818_init_param *init_param);
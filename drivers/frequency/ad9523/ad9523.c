@@ -45,6 +45,8 @@
 #include <stdio.h>
 #include "ad9523.h"
 #include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
 
 /* Helpers to avoid excess line breaks */
 #define AD_IFE(_pde, _a, _b) ((dev->pdata->_pde) ? _a : _b)
@@ -436,7 +438,7 @@ int32_t ad9523_setup(struct ad9523_dev **device,
 	uint32_t version_id;
 	struct ad9523_dev *dev;
 
-	dev = (struct ad9523_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad9523_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
@@ -738,3 +740,149 @@ int32_t ad9523_remove(struct ad9523_dev *dev)
 
 	return ret;
 }
+
+/***************************************************************************//**
+ * @brief Get the channel divider and the rate of its clock provider.
+ *
+ * @param dev - The device structure.
+ * @param chan - Channel number.
+ * @param reg_data - Channel clock distribution register value.
+ * @param parent_rate - Rate of the clock provider of the channel.
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+static int32_t ad9523_clk_get_channel(struct ad9523_dev *dev, uint32_t chan,
+				      uint32_t *reg_data, uint64_t *parent_rate)
+{
+	if (!dev || chan >= AD9523_NUM_CHAN)
+		return -EINVAL;
+
+	*parent_rate = dev->ad9523_st.vco_out_freq[dev->ad9523_st.vco_out_map[chan]];
+	if (!*parent_rate)
+		return -EINVAL;
+
+	return ad9523_spi_read(dev, AD9523_CHANNEL_CLOCK_DIST(chan), reg_data);
+}
+
+/***************************************************************************//**
+ * @brief Get the rate of a channel.
+ *
+ * @param dev - The device structure.
+ * @param chan - Channel number.
+ * @param rate - The channel rate.
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+int32_t ad9523_clk_recalc_rate(struct ad9523_dev *dev, uint32_t chan,
+			       uint64_t *rate)
+{
+	uint64_t parent_rate;
+	uint32_t ret;
+	int32_t err;
+
+	err = ad9523_clk_get_channel(dev, chan, &ret, &parent_rate);
+	if (err < 0)
+		return err;
+
+	*rate = NO_OS_DIV_ROUND_CLOSEST_ULL(parent_rate,
+					    AD9523_CLK_DIST_DIV_REV(ret));
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Calculate the closest rate a channel can output.
+ *
+ * @param dev - The device structure.
+ * @param chan - Channel number.
+ * @param rate - The desired rate.
+ * @param rounded_rate - The closest possible rate.
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+int32_t ad9523_clk_round_rate(struct ad9523_dev *dev, uint32_t chan,
+			      uint64_t rate, uint64_t *rounded_rate)
+{
+	uint64_t parent_rate;
+	uint32_t div;
+
+	if (!dev || !rate || chan >= AD9523_NUM_CHAN)
+		return -EINVAL;
+
+	parent_rate = dev->ad9523_st.vco_out_freq[dev->ad9523_st.vco_out_map[chan]];
+	div = NO_OS_DIV_ROUND_CLOSEST_ULL(parent_rate, rate);
+	div = no_os_clamp(div, 1U, 1024U);
+
+	*rounded_rate = NO_OS_DIV_ROUND_CLOSEST_ULL(parent_rate, div);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Set the rate of a channel.
+ *
+ * The channel divider is double buffered and only takes effect on the IO
+ * update, so the output switches to the new rate without a runt pulse. The
+ * registers are left untouched when the divider does not change.
+ *
+ * @param dev - The device structure.
+ * @param chan - Channel number.
+ * @param rate - The desired rate.
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+int32_t ad9523_clk_set_rate(struct ad9523_dev *dev, uint32_t chan,
+			    uint64_t rate)
+{
+	uint64_t parent_rate;
+	uint32_t reg_data, div;
+	int32_t ret;
+
+	if (!rate)
+		return -EINVAL;
+
+	ret = ad9523_clk_get_channel(dev, chan, &reg_data, &parent_rate);
+	if (ret < 0)
+		return ret;
+
+	div = NO_OS_DIV_ROUND_CLOSEST_ULL(parent_rate, rate);
+	div = no_os_clamp(div, 1U, 1024U);
+
+	if ((reg_data & AD9523_CLK_DIST_DIV(0x400)) == AD9523_CLK_DIST_DIV(div))
+		return 0;
+
+	reg_data &= ~AD9523_CLK_DIST_DIV(0x400);
+	reg_data |= AD9523_CLK_DIST_DIV(div);
+
+	ret = ad9523_spi_write(dev, AD9523_CHANNEL_CLOCK_DIST(chan), reg_data);
+	if (ret < 0)
+		return ret;
+
+	return ad9523_io_update(dev);
+}
+
+static int ad9523_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
+{
+	return ad9523_clk_recalc_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
+static int ad9523_round_rate(struct no_os_clk_desc *desc, uint64_t rate,
+			     uint64_t *rounded_rate)
+{
+	return ad9523_clk_round_rate(desc->dev_desc, desc->hw_ch_num, rate,
+				     rounded_rate);
+}
+
+static int ad9523_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	return ad9523_clk_set_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
+/**
+ * @brief ad9523 clock ops
+ */
+const struct no_os_clk_platform_ops ad9523_clk_ops = {
+	.clk_recalc_rate = &ad9523_recalc_rate,
+	.clk_round_rate = &ad9523_round_rate,
+	.clk_set_rate = &ad9523_set_rate,
+};
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include "no_os_delay.h"
 #include "no_os_spi.h"
+#include "no_os_clk.h"
 
 /******************************************************************************/
 /****************************** AD9523 ****************************************/
@@ -524,4 +525,18 @@ int32_t ad9523_setup(struct ad9523_dev **device,
 int32_t ad9523_remove(struct ad9523_dev *dev);
 
 int32_t ad9523_status(struct ad9523_dev *dev);
+
+/* Get the rate of a channel. */
+int32_t ad9523_clk_recalc_rate(struct ad9523_dev *dev, uint32_t chan,
+			       uint64_t *rate);
+
+/* Calculate the closest rate a channel can output. */
+int32_t ad9523_clk_round_rate(struct ad9523_dev *dev, uint32_t chan,
+			      uint64_t rate, uint64_t *rounded_rate);
+
+/* Set the rate of a channel. */
+int32_t ad9523_clk_set_rate(struct ad9523_dev *dev, uint32_t chan,
+			    uint64_t rate);
+
+extern const struct no_os_clk_platform_ops ad9523_clk_ops;
 #endif // __AD9523_H__
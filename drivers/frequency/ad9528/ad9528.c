@@ -1229,7 +1229,7 @@ int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 			    uint32_t rate)
 {
 	uint32_t signal_source;
-	uint32_t reg_val;
+	uint32_t reg_val, old_val;
 	uint32_t tmp;
 	int ret;
 
@@ -1270,10 +1270,15 @@ int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 	tmp = NO_OS_DIV_ROUND_CLOSEST(dev->ad9528_st.vco_out_freq[signal_source], rate);
 	tmp = no_os_clamp(tmp, 1, 256);
 
+	old_val = reg_val;
 	reg_val &= ~(AD9528_CLK_DIST_CTRL_MASK | AD9528_CLK_DIST_DIV_MASK);
 	reg_val |= AD9528_CLK_DIST_DIV(tmp);
 	reg_val |= AD9528_CLK_DIST_CTRL(signal_source);
 
+	/* Leave a running output alone if its divider does not change */
+	if (reg_val == old_val)
+		return 0;
+
 	ret = ad9528_spi_write_n(dev,
 				 AD9528_CHANNEL_OUTPUT(chan),
 				 reg_val);
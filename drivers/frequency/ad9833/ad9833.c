@@ -45,6 +45,7 @@
 #include "ad9833.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************** Constants Definitions *****************************/
@@ -451,6 +452,165 @@ void ad9833_select_phase_reg(struct ad9833_dev *dev,
 	}
 }
 
+/**************************************************************************//**
+ * @brief Precompute the tuning words of a frequency sweep.
+ *
+ * @param dev      - The device structure.
+ * @param sweep    - The sweep structure.
+ * @param freq     - Frequency values, one per step.
+ * @param ftw      - Buffer of nb_steps tuning words, owned by the caller.
+ * @param nb_steps - Number of steps, at least 2.
+ * @param cyclic   - Restart from the first step after the last one.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+******************************************************************************/
+int32_t ad9833_sweep_init(struct ad9833_dev *dev,
+			  struct ad9833_sweep *sweep,
+			  const uint32_t *freq,
+			  uint32_t *ftw,
+			  uint32_t nb_steps,
+			  bool cyclic)
+{
+	uint32_t i;
+
+	if (!dev || !sweep || !freq || !ftw || nb_steps < 2)
+		return -EINVAL;
+
+	for (i = 0; i < nb_steps; i++)
+		ftw[i] = (uint32_t)(freq[i] * chip_info[dev->act_device].freq_const);
+
+	sweep->ftw = ftw;
+	sweep->nb_steps = nb_steps;
+	sweep->cyclic = cyclic;
+	sweep->cur = 0;
+	sweep->staged = 0;
+	sweep->active_reg = 0;
+
+	return 0;
+}
+
+/**************************************************************************//**
+ * @brief Write one tuning word to a frequency register, optionally preceded
+ *        by a control word. The 16 bit words are sent as one chain of FSYNC
+ *        framed words, by DMA when the SPI platform supports it.
+ *
+ * @param dev  - The device structure.
+ * @param ctrl - Send the control register value first.
+ * @param reg  - Number of the frequency register. (0 / 1)
+ * @param ftw  - The tuning word.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+******************************************************************************/
+static int32_t ad9833_sweep_load(struct ad9833_dev *dev, bool ctrl,
+				 uint8_t reg, uint32_t ftw)
+{
+	uint16_t addr = reg ? BIT_F1ADDRESS : BIT_F0ADDRESS;
+	uint8_t buf[6];
+	uint8_t len = 0;
+
+	if (ctrl) {
+		no_os_put_unaligned_be16(dev->ctrl_reg_value, &buf[len]);
+		len += 2;
+	}
+	no_os_put_unaligned_be16(addr + (ftw & 0x0003FFF), &buf[len]);
+	len += 2;
+	no_os_put_unaligned_be16(addr + ((ftw & 0xFFFC000) >> 14), &buf[len]);
+	len += 2;
+
+	return no_os_spi_write_chunked(dev->spi_desc, buf, len, 2);
+}
+
+/**************************************************************************//**
+ * @brief Output the first step of a sweep and stage the second one in the
+ *        other frequency register.
+ *
+ * @param dev   - The device structure.
+ * @param sweep - The sweep structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+******************************************************************************/
+int32_t ad9833_sweep_start(struct ad9833_dev *dev,
+			   struct ad9833_sweep *sweep)
+{
+	int32_t ret;
+
+	if (!dev || !sweep || !sweep->ftw)
+		return -EINVAL;
+
+	dev->ctrl_reg_value |= AD9833_CTRLB28;
+	ret = ad9833_sweep_load(dev, true, 0, sweep->ftw[0]);
+	if (ret)
+		return ret;
+
+	ret = ad9833_sweep_load(dev, false, 1, sweep->ftw[1]);
+	if (ret)
+		return ret;
+
+	ad9833_select_freq_reg(dev, 0);
+
+	sweep->cur = 0;
+	sweep->staged = 1;
+	sweep->active_reg = 0;
+
+	return 0;
+}
+
+/**************************************************************************//**
+ * @brief Switch the output to the staged step and stage the next one in the
+ *        register that was just released. With the software programming
+ *        method the switch and the load go out in a single SPI chain.
+ *
+ * @param dev   - The device structure.
+ * @param sweep - The sweep structure.
+ *
+ * @return 0 in case of success, -ENODATA if a non cyclic sweep already
+ *         reached its last step, negative error code otherwise.
+******************************************************************************/
+int32_t ad9833_sweep_step(struct ad9833_dev *dev,
+			  struct ad9833_sweep *sweep)
+{
+	uint32_t next;
+	int32_t ret;
+
+	if (!dev || !sweep || !sweep->ftw)
+		return -EINVAL;
+
+	if (sweep->staged == sweep->cur)
+		return -ENODATA;
+
+	sweep->active_reg ^= 1;
+	sweep->cur = sweep->staged;
+
+	next = sweep->cur + 1;
+	if (next == sweep->nb_steps) {
+		if (!sweep->cyclic) {
+			ad9833_select_freq_reg(dev, sweep->active_reg);
+			return 0;
+		}
+		next = 0;
+	}
+
+	if (dev->prog_method == 0) {
+		if (sweep->active_reg)
+			dev->ctrl_reg_value |= AD9833_CTRLFSEL;
+		else
+			dev->ctrl_reg_value &= ~AD9833_CTRLFSEL;
+
+		ret = ad9833_sweep_load(dev, true, !sweep->active_reg,
+					sweep->ftw[next]);
+	} else {
+		ad9833_select_freq_reg(dev, sweep->active_reg);
+		ret = ad9833_sweep_load(dev, false, !sweep->active_reg,
+					sweep->ftw[next]);
+	}
+	if (ret)
+		return ret;
+
+	sweep->staged = next;
+
+	return 0;
+}
+
 /**************************************************************************//**
  * @brief Sets the programming method. (only for AD9834 & AD9838)
  *
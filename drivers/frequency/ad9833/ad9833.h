@@ -44,6 +44,7 @@
 /******************************* Include Files ********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_delay.h"
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
@@ -139,6 +140,20 @@ struct ad9833_init_param {
 	enum ad9833_type		act_device;
 };
 
+/* Precomputed frequency sweep, played through FREQ0/FREQ1 ping-pong */
+struct ad9833_sweep {
+	/* Frequency tuning words, one per step */
+	uint32_t			*ftw;
+	uint32_t			nb_steps;
+	/* Restart from the first step after the last one */
+	bool				cyclic;
+	/* Step output now and the step staged in the other register */
+	uint32_t			cur;
+	uint32_t			staged;
+	/* Frequency register in use (0 / 1) */
+	uint8_t				active_reg;
+};
+
 struct ad9833_chip_info {
 	uint32_t	mclk;
 	float		freq_const;
@@ -176,6 +191,19 @@ void ad9833_select_phase_reg(struct ad9833_dev *dev,
 void ad9833_sleep_mode(struct ad9833_dev *dev,
 		       uint8_t sleep_mode);
 
+/* Precompute the tuning words of a frequency sweep. */
+int32_t ad9833_sweep_init(struct ad9833_dev *dev,
+			  struct ad9833_sweep *sweep,
+			  const uint32_t *freq,
+			  uint32_t *ftw,
+			  uint32_t nb_steps,
+			  bool cyclic);
+/* Output the first step of a sweep and stage the second one. */
+int32_t ad9833_sweep_start(struct ad9833_dev *dev,
+			   struct ad9833_sweep *sweep);
+/* Switch to the staged step and stage the next one. */
+int32_t ad9833_sweep_step(struct ad9833_dev *dev,
+			  struct ad9833_sweep *sweep);
 void ad9834_select_prog_method(struct ad9833_dev *dev,
 			       uint8_t value);
 
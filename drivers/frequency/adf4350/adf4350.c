@@ -43,6 +43,7 @@
 /******************************************************************************/
 #include <malloc.h>
 #include <stdio.h>
+#include <string.h>
 #include "adf4350.h"
 #include "no_os_alloc.h"
 
@@ -139,38 +140,37 @@ uint32_t gcd(uint32_t x, uint32_t y)
 }
 
 /***************************************************************************//**
- * @brief Sets the ADF4350 frequency.
+ * @brief Computes the divider settings of an output frequency.
  *
  * @param dev - The device structure.
- * @param freq - The desired frequency value.
- *
- * @return calculatedFrequency - The actual frequency value that was set.
+ * @param freq - The desired frequency value, within the output range.
+ * @param sol - The computed solution.
 *******************************************************************************/
-int64_t adf4350_set_freq(adf4350_dev *dev,
-			 uint64_t freq)
+static void adf4350_solve(adf4350_dev *dev,
+			  uint64_t freq,
+			  struct adf4350_freq_cache *sol)
 {
 	uint64_t tmp;
-	uint32_t div_gcd, prescaler, chspc;
+	uint32_t div_gcd, chspc;
 	uint16_t mdiv, r_cnt = 0;
-	uint8_t band_sel_div;
-	int32_t ret;
 
-	if ((freq > ADF4350_MAX_OUT_FREQ) || (freq < ADF4350_MIN_OUT_FREQ))
-		return -1;
+	sol->freq = freq;
+	sol->clkin = dev->clkin;
+	sol->chspc = dev->chspc;
 
 	if (freq > ADF4350_MAX_FREQ_45_PRESC) {
-		prescaler = ADF4350_REG1_PRESCALER;
+		sol->prescaler = ADF4350_REG1_PRESCALER;
 		mdiv = 75;
 	} else {
-		prescaler = 0;
+		sol->prescaler = 0;
 		mdiv = 23;
 	}
 
-	dev->r4_rf_div_sel = 0;
+	sol->r4_rf_div_sel = 0;
 
 	while (freq < ADF4350_MIN_VCO_FREQ) {
 		freq <<= 1;
-		dev->r4_rf_div_sel++;
+		sol->r4_rf_div_sel++;
 	}
 
 	/*
@@ -186,49 +186,112 @@ int64_t adf4350_set_freq(adf4350_dev *dev,
 		do {
 			do {
 				r_cnt = adf4350_tune_r_cnt(dev, r_cnt);
-				dev->r1_mod = dev->fpfd / chspc;
+				sol->r1_mod = dev->fpfd / chspc;
 				if (r_cnt > ADF4350_MAX_R_CNT) {
 					/* try higher spacing values */
 					chspc++;
 					r_cnt = 0;
 				}
-			} while ((dev->r1_mod > ADF4350_MAX_MODULUS) && r_cnt);
+			} while ((sol->r1_mod > ADF4350_MAX_MODULUS) && r_cnt);
 		} while (r_cnt == 0);
 
 
-		tmp = freq * (uint64_t)dev->r1_mod + (dev->fpfd > 1);
+		tmp = freq * (uint64_t)sol->r1_mod + (dev->fpfd > 1);
 
 		tmp = (tmp / dev->fpfd);	/* Div round closest (n + d/2)/d */
 
-		dev->r0_fract = tmp % dev->r1_mod;
-		tmp = tmp / dev->r1_mod;
+		sol->r0_fract = tmp % sol->r1_mod;
+		tmp = tmp / sol->r1_mod;
 
-		dev->r0_int = tmp;
-	} while (mdiv > dev->r0_int);
+		sol->r0_int = tmp;
+	} while (mdiv > sol->r0_int);
 
-	band_sel_div = dev->fpfd % ADF4350_MAX_BANDSEL_CLK >
-		       ADF4350_MAX_BANDSEL_CLK / 2 ?
-		       dev->fpfd / ADF4350_MAX_BANDSEL_CLK + 1 :
-		       dev->fpfd / ADF4350_MAX_BANDSEL_CLK;
+	sol->band_sel_div = dev->fpfd % ADF4350_MAX_BANDSEL_CLK >
+			    ADF4350_MAX_BANDSEL_CLK / 2 ?
+			    dev->fpfd / ADF4350_MAX_BANDSEL_CLK + 1 :
+			    dev->fpfd / ADF4350_MAX_BANDSEL_CLK;
 
-	if (dev->r0_fract && dev->r1_mod) {
-		div_gcd = gcd(dev->r1_mod, dev->r0_fract);
-		dev->r1_mod /= div_gcd;
-		dev->r0_fract /= div_gcd;
+	if (sol->r0_fract && sol->r1_mod) {
+		div_gcd = gcd(sol->r1_mod, sol->r0_fract);
+		sol->r1_mod /= div_gcd;
+		sol->r0_fract /= div_gcd;
 	} else {
-		dev->r0_fract = 0;
-		dev->r1_mod = 1;
+		sol->r0_fract = 0;
+		sol->r1_mod = 1;
+	}
+
+	sol->fpfd = dev->fpfd;
+	sol->r_cnt = r_cnt;
+	sol->valid = 1;
+}
+
+/***************************************************************************//**
+ * @brief Looks up or computes the divider settings of an output frequency.
+ *        The last ADF4350_FREQ_CACHE_SIZE solutions are kept, so retuning
+ *        to a recently used frequency skips the solver.
+ *
+ * @param dev - The device structure.
+ * @param freq - The desired frequency value, within the output range.
+ *
+ * @return The solution.
+*******************************************************************************/
+static struct adf4350_freq_cache *adf4350_get_solution(adf4350_dev *dev,
+		uint64_t freq)
+{
+	struct adf4350_freq_cache *sol;
+	uint8_t i;
+
+	for (i = 0; i < ADF4350_FREQ_CACHE_SIZE; i++) {
+		sol = &dev->freq_cache[i];
+		if (sol->valid && sol->freq == freq && sol->clkin == dev->clkin &&
+		    sol->chspc == dev->chspc)
+			return sol;
 	}
 
+	sol = &dev->freq_cache[dev->freq_cache_next];
+	dev->freq_cache_next = (dev->freq_cache_next + 1) %
+			       ADF4350_FREQ_CACHE_SIZE;
+	adf4350_solve(dev, freq, sol);
+
+	return sol;
+}
+
+/***************************************************************************//**
+ * @brief Sets the ADF4350 frequency. Only the registers whose value changed
+ *        are written.
+ *
+ * @param dev - The device structure.
+ * @param freq - The desired frequency value.
+ *
+ * @return calculatedFrequency - The actual frequency value that was set.
+*******************************************************************************/
+int64_t adf4350_set_freq(adf4350_dev *dev,
+			 uint64_t freq)
+{
+	struct adf4350_freq_cache *sol;
+	uint64_t tmp;
+	int32_t ret;
+
+	if ((freq > ADF4350_MAX_OUT_FREQ) || (freq < ADF4350_MIN_OUT_FREQ))
+		return -1;
+
+	sol = adf4350_get_solution(dev, freq);
+
+	dev->fpfd = sol->fpfd;
+	dev->r0_int = sol->r0_int;
+	dev->r0_fract = sol->r0_fract;
+	dev->r1_mod = sol->r1_mod;
+	dev->r4_rf_div_sel = sol->r4_rf_div_sel;
+
 	dev->regs[ADF4350_REG0] = ADF4350_REG0_INT(dev->r0_int) |
 				  ADF4350_REG0_FRACT(dev->r0_fract);
 
 	dev->regs[ADF4350_REG1] = ADF4350_REG1_PHASE(1) |
 				  ADF4350_REG1_MOD(dev->r1_mod) |
-				  prescaler;
+				  sol->prescaler;
 
 	dev->regs[ADF4350_REG2] =
-		ADF4350_REG2_10BIT_R_CNT(r_cnt) |
+		ADF4350_REG2_10BIT_R_CNT(sol->r_cnt) |
 		ADF4350_REG2_DOUBLE_BUFF_EN |
 		(dev->pdata->ref_doubler_en ? ADF4350_REG2_RMULT2_EN : 0) |
 		(dev->pdata->ref_div2_en ? ADF4350_REG2_RDIV2_EN : 0) |
@@ -245,7 +308,7 @@ int64_t adf4350_set_freq(adf4350_dev *dev,
 	dev->regs[ADF4350_REG4] =
 		ADF4350_REG4_FEEDBACK_FUND |
 		ADF4350_REG4_RF_DIV_SEL(dev->r4_rf_div_sel) |
-		ADF4350_REG4_8BIT_BAND_SEL_CLKDIV(band_sel_div) |
+		ADF4350_REG4_8BIT_BAND_SEL_CLKDIV(sol->band_sel_div) |
 		ADF4350_REG4_RF_OUT_EN |
 		(dev->pdata->r4_user_settings &
 		 (ADF4350_REG4_OUTPUT_PWR(0x3) |
@@ -282,11 +345,14 @@ int32_t adf4350_setup(adf4350_dev **device,
 	adf4350_dev *dev;
 	int32_t ret;
 
-	dev = (adf4350_dev *)no_os_malloc(sizeof(*dev));
+	dev = (adf4350_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev) {
 		return -1;
 	}
 
+	/* Make sure the first adf4350_sync_config() writes every register */
+	memset(dev->regs_hw, 0xFF, sizeof(dev->regs_hw));
+
 	/* SPI */
 	ret = no_os_spi_init(&dev->spi_desc, &init_param.spi_init);
 
@@ -126,6 +126,9 @@
 #define ADF4350_MAX_MODULUS			4095
 #define ADF4350_MAX_R_CNT			1023
 
+/* Number of divider solutions kept by adf4350_set_freq() */
+#define ADF4350_FREQ_CACHE_SIZE		8
+
 /******************************************************************************/
 /************************ Types Definitions ***********************************/
 /******************************************************************************/
@@ -180,6 +183,22 @@ typedef struct {
 	uint32_t	aux_output_power;
 } adf4350_init_param;
 
+/* Divider solution of one output frequency */
+struct adf4350_freq_cache {
+	uint64_t	freq;
+	uint32_t	clkin;
+	uint32_t	chspc;
+	uint32_t	fpfd;
+	uint32_t	r0_int;
+	uint32_t	r0_fract;
+	uint32_t	r1_mod;
+	uint32_t	r4_rf_div_sel;
+	uint32_t	prescaler;
+	uint16_t	r_cnt;
+	uint8_t		band_sel_div;
+	uint8_t		valid;
+};
+
 typedef struct {
 	struct no_os_spi_desc	*spi_desc;
 	struct adf4350_platform_data *pdata;
@@ -194,6 +213,8 @@ typedef struct {
 	uint32_t	regs[6];
 	uint32_t	regs_hw[6];
 	uint32_t 	val;
+	struct adf4350_freq_cache freq_cache[ADF4350_FREQ_CACHE_SIZE];
+	uint8_t		freq_cache_next;
 } adf4350_dev;
 
 /******************************************************************************/
@@ -44,9 +44,11 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_reg_seq.h"
 #include "adf4371.h"
 
 /******************************************************************************/
@@ -188,12 +190,7 @@ static const struct adf4371_pwrdown adf4371_pwrdown_ch[4] = {
 	[ADF4371_CH_RF32] = { ADF4371_REG(0x25), 4 },
 };
 
-struct reg_sequence {
-	uint16_t reg;
-	uint8_t val;
-};
-
-static const struct reg_sequence adf4371_reg_defaults[] = {
+static const struct no_os_reg_seq adf4371_reg_defaults[] = {
 	{ ADF4371_REG(0x01), 0x00 },
 	{ ADF4371_REG(0x12), 0x40 },
 	{ ADF4371_REG(0x1E), 0x48 },
@@ -250,6 +247,19 @@ static int32_t adf4371_write(struct adf4371_dev *dev,
 	return no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
 }
 
+/**
+ * Format the instruction of a register write.
+ * @param reg - The first register address.
+ * @param cmd - Buffer of 2 bytes for the instruction.
+ */
+static void adf4371_format_write(uint16_t reg, uint8_t *cmd)
+{
+	uint16_t val = ADF4371_WRITE | ADF4371_ADDR(reg);
+
+	cmd[0] = val >> 8;
+	cmd[1] = val & 0xFF;
+}
+
 /**
  * SPI register write bulk to device.
  * @param dev - The device structure.
@@ -404,7 +414,67 @@ static void adf4371_pll_fract_n_compute(uint64_t vco,
 }
 
 /**
- * Set the output frequency for one channel.
+ * Look up or compute the PLL parameters of a VCO frequency. The last
+ * ADF4371_FREQ_CACHE_SIZE solutions are kept, so retuning to a recently used
+ * frequency skips the divisions.
+ * @param dev - The device structure.
+ * @param vco - The VCO frequency.
+ * @return None.
+ */
+static void adf4371_pll_fract_n_solve(struct adf4371_dev *dev, uint64_t vco)
+{
+	struct adf4371_freq_cache *sol;
+	uint8_t i;
+
+	for (i = 0; i < ADF4371_FREQ_CACHE_SIZE; i++) {
+		sol = &dev->freq_cache[i];
+		if (sol->valid && sol->vco == vco && sol->fpfd == dev->fpfd)
+			goto out;
+	}
+
+	sol = &dev->freq_cache[dev->freq_cache_next];
+	dev->freq_cache_next = (dev->freq_cache_next + 1) % ADF4371_FREQ_CACHE_SIZE;
+
+	adf4371_pll_fract_n_compute(vco, dev->fpfd, &sol->integer, &sol->fract1,
+				    &sol->fract2, &sol->mod2);
+	sol->vco = vco;
+	sol->fpfd = dev->fpfd;
+	sol->valid = true;
+out:
+	dev->integer = sol->integer;
+	dev->fract1 = sol->fract1;
+	dev->fract2 = sol->fract2;
+	dev->mod2 = sol->mod2;
+}
+
+/**
+ * Write the fractional divider registers 0x11...0x1A. In delta mode only the
+ * span of bytes that changed since the last write is sent.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adf4371_write_frac(struct adf4371_dev *dev)
+{
+	struct adf4371_freq_regs *hw = &dev->freq_regs_hw;
+	uint8_t first = 0, last = NO_OS_ARRAY_SIZE(dev->buf) - 1;
+
+	if (dev->delta_write && hw->valid) {
+		while (first <= last && dev->buf[first] == hw->frac[first])
+			first++;
+		if (first > last)
+			return 0;
+		while (dev->buf[last] == hw->frac[last])
+			last--;
+	}
+
+	return adf4371_write_bulk(dev, ADF4371_REG(0x11) + first,
+				  &dev->buf[first], last - first + 1);
+}
+
+/**
+ * Set the output frequency for one channel. The update takes effect on the
+ * write of REG 0x10, which is always written last. With delta_write set,
+ * the other frequency registers are only written when their value changed.
  * @param dev - The device structure.
  * @param freq - The output frequency.
  * @param channel - The selected channel.
@@ -414,6 +484,8 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 				uint64_t freq,
 				uint32_t channel)
 {
+	struct adf4371_freq_regs *hw = &dev->freq_regs_hw;
+	bool delta = dev->delta_write && hw->valid;
 	uint32_t cp_bleed;
 	uint8_t int_mode = 0;
 	int32_t ret;
@@ -449,8 +521,7 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 		return -1;
 	}
 
-	adf4371_pll_fract_n_compute(freq, dev->fpfd, &dev->integer, &dev->fract1,
-				    &dev->fract2, &dev->mod2);
+	adf4371_pll_fract_n_solve(dev, freq);
 
 	dev->buf[0] = dev->integer >> 8;
 	dev->buf[1] = 0x40; /* REG12 default */
@@ -464,22 +535,26 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 	dev->buf[8] = dev->mod2 & 0xFF;
 	dev->buf[9] = ADF4371_MOD2WORD(dev->mod2 >> 8);
 
-	ret = adf4371_write_bulk(dev, ADF4371_REG(0x11), dev->buf, 10);
+	ret = adf4371_write_frac(dev);
 	if (ret < 0)
 		return ret;
 	/*
 	 * The R counter allows the input reference frequency to be
 	 * divided down to produce the reference clock to the PFD
 	 */
-	ret = adf4371_write(dev, ADF4371_REG(0x1F), dev->ref_div_factor);
-	if (ret < 0)
-		return ret;
+	if (!delta || hw->ref_div != dev->ref_div_factor) {
+		ret = adf4371_write(dev, ADF4371_REG(0x1F), dev->ref_div_factor);
+		if (ret < 0)
+			return ret;
+	}
 
-	ret = adf4371_update(dev, ADF4371_REG(0x24),
-			     ADF4371_RF_DIV_SEL_MSK,
-			     ADF4371_RF_DIV_SEL(dev->rf_div_sel));
-	if (ret < 0)
-		return ret;
+	if (!delta || hw->rf_div_sel != dev->rf_div_sel) {
+		ret = adf4371_update(dev, ADF4371_REG(0x24),
+				     ADF4371_RF_DIV_SEL_MSK,
+				     ADF4371_RF_DIV_SEL(dev->rf_div_sel));
+		if (ret < 0)
+			return ret;
+	}
 
 	/*
 	 * The optimum bleed current is set by ((4/N) × ICP)/3.75,
@@ -487,9 +562,11 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 	 */
 	cp_bleed = NO_OS_DIV_ROUND_UP(400 * dev->cp_settings.icp, dev->integer * 375);
 	cp_bleed = no_os_clamp(cp_bleed, 1U, 255U);
-	ret = adf4371_write(dev, ADF4371_REG(0x26), cp_bleed);
-	if (ret < 0)
-		return ret;
+	if (!delta || hw->cp_bleed != cp_bleed) {
+		ret = adf4371_write(dev, ADF4371_REG(0x26), cp_bleed);
+		if (ret < 0)
+			return ret;
+	}
 	/*
 	 * Set to 1 when in INT mode (when FRAC1 = FRAC2 = 0),
 	 * and set to 0 when in FRAC mode.
@@ -497,11 +574,24 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 	if (dev->fract1 == 0 && dev->fract2 == 0)
 		int_mode = 0x01;
 
-	ret = adf4371_write(dev, ADF4371_REG(0x2B), int_mode);
+	if (!delta || hw->int_mode != int_mode) {
+		ret = adf4371_write(dev, ADF4371_REG(0x2B), int_mode);
+		if (ret < 0)
+			return ret;
+	}
+
+	ret = adf4371_write(dev, ADF4371_REG(0x10), dev->integer & 0xFF);
 	if (ret < 0)
 		return ret;
 
-	return adf4371_write(dev, ADF4371_REG(0x10), dev->integer & 0xFF);
+	memcpy(hw->frac, dev->buf, sizeof(hw->frac));
+	hw->ref_div = dev->ref_div_factor;
+	hw->rf_div_sel = dev->rf_div_sel;
+	hw->cp_bleed = cp_bleed;
+	hw->int_mode = int_mode;
+	hw->valid = true;
+
+	return 0;
 }
 
 /**
@@ -572,6 +662,7 @@ static int32_t adf4371_channel_config(struct adf4371_dev *dev)
  */
 static int32_t adf4371_setup(struct adf4371_dev *dev)
 {
+	struct no_os_reg_seq_config seq_cfg;
 	uint32_t vco_alc_timeout = 1;
 	uint32_t synth_timeout = 2;
 	uint32_t vco_band_div;
@@ -581,12 +672,13 @@ static int32_t adf4371_setup(struct adf4371_dev *dev)
 	uint8_t mask;
 	uint8_t val;
 	int32_t ret;
-	int32_t i;
 
 	ret = adf4371_write(dev, ADF4371_REG(0x0), ADF4371_RESET_CMD);
 	if (ret < 0)
 		return ret;
 
+	dev->freq_regs_hw.valid = false;
+
 	if (dev->spi_3wire_en)
 		en = false;
 
@@ -596,13 +688,16 @@ static int32_t adf4371_setup(struct adf4371_dev *dev)
 	if (ret < 0)
 		return ret;
 
-	for (i = 0; i < NO_OS_ARRAY_SIZE(adf4371_reg_defaults); i++) {
-		ret = adf4371_write(dev,
-				    adf4371_reg_defaults[i].reg,
-				    adf4371_reg_defaults[i].val);
-		if (ret < 0)
-			return ret;
-	}
+	/* Address ascension is still off, stream the defaults descending. */
+	seq_cfg.spi = dev->spi_desc;
+	seq_cfg.cmd_size = 2;
+	seq_cfg.format_cmd = adf4371_format_write;
+	seq_cfg.max_burst = NO_OS_ARRAY_SIZE(adf4371_reg_defaults);
+	seq_cfg.descending = true;
+	ret = no_os_reg_seq_write(&seq_cfg, adf4371_reg_defaults,
+				  NO_OS_ARRAY_SIZE(adf4371_reg_defaults));
+	if (ret < 0)
+		return ret;
 
 	if (dev->differential_ref_clk) {
 		ret = adf4371_update(dev, ADF4371_REG(0x22),
@@ -794,6 +889,8 @@ int32_t adf4371_init(struct adf4371_dev **device,
 
 	dev->muxout_1v8_en = init_param->muxout_level_1v8_enable;
 
+	dev->delta_write = init_param->delta_write;
+
 	dev->num_channels = 4;
 
 	for (i = 0; i < init_param->num_channels; i++) {
@@ -48,6 +48,9 @@
 /******************************************************************************/
 /********************** Macros and Types Declarations *************************/
 /******************************************************************************/
+/* Number of divider solutions kept by the driver */
+#define ADF4371_FREQ_CACHE_SIZE		8
+
 struct adf4371_channel_config {
 	bool		enable;
 	uint64_t	freq;
@@ -63,6 +66,27 @@ struct adf4371_chan_spec {
 	uint64_t	power_up_frequency;
 };
 
+/* Divider solution of one VCO frequency */
+struct adf4371_freq_cache {
+	uint64_t	vco;
+	uint32_t	fpfd;
+	uint32_t	integer;
+	uint32_t	fract1;
+	uint32_t	fract2;
+	uint32_t	mod2;
+	bool		valid;
+};
+
+/* Last frequency register values written to the device */
+struct adf4371_freq_regs {
+	uint8_t		frac[10];
+	uint8_t		ref_div;
+	uint8_t		rf_div_sel;
+	uint8_t		cp_bleed;
+	uint8_t		int_mode;
+	bool		valid;
+};
+
 struct adf4371_dev {
 	struct no_os_spi_desc	*spi_desc;
 	bool		spi_3wire_en;
@@ -84,6 +108,10 @@ struct adf4371_dev {
 	uint32_t	mod2;
 	uint32_t	rf_div_sel;
 	uint8_t		buf[10];
+	bool		delta_write;
+	struct adf4371_freq_regs	freq_regs_hw;
+	struct adf4371_freq_cache	freq_cache[ADF4371_FREQ_CACHE_SIZE];
+	uint8_t		freq_cache_next;
 };
 
 struct adf4371_init_param {
@@ -98,6 +126,8 @@ struct adf4371_init_param {
 	bool		muxout_level_1v8_enable;
 	uint32_t	num_channels;
 	struct adf4371_chan_spec	*channels;
+	/* Only write the frequency registers that changed on retune */
+	bool		delta_write;
 };
 
 /******************************************************************************/
@@ -272,6 +272,44 @@ int32_t adf4377_soft_reset(struct adf4377_dev *dev)
 	return -1;
 }
 
+/**
+ * @brief Update a frequency register, keeping a copy of its value. In delta
+ *        mode the copy replaces the read back and unchanged values are not
+ *        written.
+ * @param dev - The device structure.
+ * @param reg_addr - The register address.
+ * @param hw - The copy of the register value.
+ * @param mask - Mask for specific register bits to be updated.
+ * @param data - Data written to the device (requires prior bit shifting).
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t adf4377_freq_reg_update(struct adf4377_dev *dev,
+				       uint8_t reg_addr, uint8_t *hw,
+				       uint8_t mask, uint8_t data)
+{
+	bool delta = dev->delta_write && dev->freq_regs_valid;
+	uint8_t val;
+	int32_t ret;
+
+	if (!delta) {
+		ret = adf4377_spi_read(dev, reg_addr, hw);
+		if (ret < 0)
+			return ret;
+	}
+
+	val = (*hw & ~mask) | data;
+	if (delta && val == *hw)
+		return 0;
+
+	ret = adf4377_spi_write(dev, reg_addr, val);
+	if (ret < 0)
+		return ret;
+
+	*hw = val;
+
+	return 0;
+}
+
 /**
  * Set the output frequency.
  * @param dev - The device structure.
@@ -298,18 +336,20 @@ int32_t adf4377_set_freq(struct adf4377_dev *dev, uint64_t freq)
 
 	dev->n_int = freq / dev->f_pfd;
 
-	ret = adf4377_spi_write_mask(dev, ADF4377_REG(0x11),
-				     ADF4377_EN_RDBLR_MSK | ADF4377_N_INT_MSB_MSK,
-				     ADF4377_EN_RDBLR(dev->ref_doubler_en) | ADF4377_N_INT_MSB(dev->n_int >> 8));
+	ret = adf4377_freq_reg_update(dev, ADF4377_REG(0x11), &dev->reg11_hw,
+				      ADF4377_EN_RDBLR_MSK | ADF4377_N_INT_MSB_MSK,
+				      ADF4377_EN_RDBLR(dev->ref_doubler_en) | ADF4377_N_INT_MSB(dev->n_int >> 8));
 	if (ret < 0)
 		return ret;
 
-	ret = adf4377_spi_write_mask(dev, ADF4377_REG(0x12),
-				     ADF4377_R_DIV_MSK | ADF4377_CLKOUT_DIV_MSK,
-				     ADF4377_CLKOUT_DIV(dev->clkout_div_sel) | ADF4377_R_DIV(dev->ref_div_factor));
+	ret = adf4377_freq_reg_update(dev, ADF4377_REG(0x12), &dev->reg12_hw,
+				      ADF4377_R_DIV_MSK | ADF4377_CLKOUT_DIV_MSK,
+				      ADF4377_CLKOUT_DIV(dev->clkout_div_sel) | ADF4377_R_DIV(dev->ref_div_factor));
 	if (ret < 0)
 		return ret;
 
+	dev->freq_regs_valid = true;
+
 	ret = adf4377_spi_write(dev, ADF4377_REG(0x10), ADF4377_N_INT_LSB(dev->n_int));
 	if (ret < 0)
 		return ret;
@@ -345,6 +385,7 @@ static int32_t adf4377_setup(struct adf4377_dev *dev)
 	uint16_t synth_lock_timeout, vco_alc_timeout, adc_clk_div, vco_band_div;
 
 	dev->ref_div_factor = 0;
+	dev->freq_regs_valid = false;
 
 	/* Set Default Registers */
 	ret = adf4377_set_default(dev);
@@ -537,6 +578,7 @@ int32_t adf4377_init(struct adf4377_dev **device,
 	dev->ref_doubler_en = init_param->ref_doubler_en;
 	dev->f_clk = init_param->f_clk;
 	dev->clkout_op = init_param->clkout_op;
+	dev->delta_write = init_param->delta_write;
 
 	/* GPIO Chip Enable */
 	ret = no_os_gpio_get_optional(&dev->gpio_ce, init_param->gpio_ce_param);
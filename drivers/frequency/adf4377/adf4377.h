@@ -641,6 +641,8 @@ struct adf4377_init_param {
 	uint8_t ref_doubler_en;
 	/** Output Amplitude */
 	uint8_t	clkout_op;
+	/** Only write the frequency registers that changed on retune */
+	bool delta_write;
 };
 
 /**
@@ -682,6 +684,13 @@ struct adf4377_dev {
 	uint16_t n_int;
 	/** Output Amplitude */
 	uint8_t	clkout_op;
+	/** Only write the frequency registers that changed on retune */
+	bool delta_write;
+	/** Last values written to REG 0x11 and REG 0x12 */
+	uint8_t reg11_hw;
+	uint8_t reg12_hw;
+	/** reg11_hw and reg12_hw hold the device values */
+	bool freq_regs_valid;
 };
 
 /******************************************************************************/
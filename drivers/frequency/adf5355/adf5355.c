@@ -42,6 +42,7 @@
 /******************************************************************************/
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 #include "no_os_error.h"
 #include <malloc.h>
 #include "no_os_delay.h"
@@ -119,6 +120,65 @@ static void adf5355_pll_fract_n_compute(uint64_t vco,
 	*fract2 /= gcd_div;
 }
 
+/**
+ * Look up or compute the PLL parameters of a VCO frequency. The last
+ * ADF5355_FREQ_CACHE_SIZE solutions are kept, so retuning to a recently used
+ * frequency skips the divisions.
+ * @param dev - The device structure.
+ * @param vco - The VCO frequency.
+ * @return None.
+ */
+static void adf5355_pll_fract_n_solve(struct adf5355_dev *dev, uint64_t vco)
+{
+	struct adf5355_freq_cache *sol;
+	uint8_t i;
+
+	for (i = 0; i < ADF5355_FREQ_CACHE_SIZE; i++) {
+		sol = &dev->freq_cache[i];
+		if (sol->valid && sol->vco == vco && sol->fpfd == dev->fpfd)
+			goto out;
+	}
+
+	sol = &dev->freq_cache[dev->freq_cache_next];
+	dev->freq_cache_next = (dev->freq_cache_next + 1) % ADF5355_FREQ_CACHE_SIZE;
+
+	adf5355_pll_fract_n_compute(vco, dev->fpfd, &sol->integer, &sol->fract1,
+				    &sol->fract2, &sol->mod2,
+				    ((dev->dev_id == ADF4356)
+				     || (dev->dev_id == ADF5356)) ? ADF5356_MAX_MODULUS2 : ADF5355_MAX_MODULUS2);
+	sol->vco = vco;
+	sol->fpfd = dev->fpfd;
+	sol->valid = true;
+out:
+	dev->integer = sol->integer;
+	dev->fract1 = sol->fract1;
+	dev->fract2 = sol->fract2;
+	dev->mod2 = sol->mod2;
+}
+
+/**
+ * Write a register unless delta writes are enabled and the device already
+ * holds the value.
+ * @param dev - The device structure.
+ * @param reg_addr - The register address.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adf5355_write_changed(struct adf5355_dev *dev, uint8_t reg_addr)
+{
+	int32_t ret;
+
+	if (dev->delta_write && dev->regs_hw[reg_addr] == dev->regs[reg_addr])
+		return 0;
+
+	ret = adf5355_write(dev, reg_addr, dev->regs[reg_addr]);
+	if (ret != 0)
+		return ret;
+
+	dev->regs_hw[reg_addr] = dev->regs[reg_addr];
+
+	return 0;
+}
+
 /**
  * ADF5355 Register configuration
  * @param dev - The device structure.
@@ -140,20 +200,21 @@ static int32_t adf5355_reg_config(struct adf5355_dev *dev, bool sync_all)
 				return ret;
 		}
 
+		memcpy(dev->regs_hw, dev->regs, sizeof(dev->regs_hw));
 		dev->all_synced = true;
 
 	} else {
 		if((dev->dev_id == ADF4356) || (dev->dev_id == ADF5356)) {
-			ret = adf5355_write(dev, ADF5355_REG(13), dev->regs[ADF5355_REG(13)]);
+			ret = adf5355_write_changed(dev, ADF5355_REG(13));
 			if (ret != 0)
 				return ret;
 		}
 
-		ret = adf5355_write(dev, ADF5355_REG(10), dev->regs[ADF5355_REG(10)]);
+		ret = adf5355_write_changed(dev, ADF5355_REG(10));
 		if (ret != 0)
 			return ret;
 
-		ret = adf5355_write(dev, ADF5355_REG(6), dev->regs[ADF5355_REG(6)]);
+		ret = adf5355_write_changed(dev, ADF5355_REG(6));
 		if (ret != 0)
 			return ret;
 
@@ -162,11 +223,11 @@ static int32_t adf5355_reg_config(struct adf5355_dev *dev, bool sync_all)
 		if (ret != 0)
 			return ret;
 
-		ret = adf5355_write(dev, ADF5355_REG(2), dev->regs[ADF5355_REG(2)]);
+		ret = adf5355_write_changed(dev, ADF5355_REG(2));
 		if (ret != 0)
 			return ret;
 
-		ret = adf5355_write(dev, ADF5355_REG(1), dev->regs[ADF5355_REG(1)]);
+		ret = adf5355_write_changed(dev, ADF5355_REG(1));
 		if (ret != 0)
 			return ret;
 
@@ -241,10 +302,7 @@ static int32_t adf5355_set_freq(struct adf5355_dev *dev,
 		freq >>= 1;
 	}
 
-	adf5355_pll_fract_n_compute(freq, dev->fpfd, &dev->integer, &dev->fract1,
-				    &dev->fract2, &dev->mod2,
-				    ((dev->dev_id == ADF4356)
-				     || (dev->dev_id == ADF5356)) ? ADF5356_MAX_MODULUS2 : ADF5355_MAX_MODULUS2);
+	adf5355_pll_fract_n_solve(dev, freq);
 
 	prescaler = (dev->integer >= ADF5355_MIN_INT_PRESCALER_89);
 
@@ -295,7 +353,7 @@ static int32_t adf5355_set_freq(struct adf5355_dev *dev,
 
 	dev->freq_req = freq;
 
-	return adf5355_reg_config(dev, dev->all_synced);
+	return adf5355_reg_config(dev, dev->all_synced && !dev->delta_write);
 }
 
 /**
@@ -496,6 +554,7 @@ int32_t adf5355_init(struct adf5355_dev **device,
 	dev->ref_div2_en = init_param->ref_div2_en;
 	dev->mux_out_sel = init_param->mux_out_sel;
 	dev->outb_sel_fund = init_param->outb_sel_fund;
+	dev->delta_write = init_param->delta_write;
 	dev->num_channels = 2;
 
 	switch (dev->dev_id) {
@@ -171,6 +171,9 @@
 
 #define ADF5355_SPI_NO_BYTES                    4
 
+/* Number of divider solutions kept by the driver */
+#define ADF5355_FREQ_CACHE_SIZE                 8
+
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
@@ -208,6 +211,20 @@ enum adf5355_mux_out_sel {
 	ADF5355_MUXOUT_DIGITAL_LOCK_DETECT,
 };
 
+/**
+ * @struct adf5355_freq_cache
+ * @brief  Divider solution of one VCO frequency.
+ */
+struct adf5355_freq_cache {
+	uint64_t                    vco;
+	uint32_t                    fpfd;
+	uint32_t                    integer;
+	uint32_t                    fract1;
+	uint32_t                    fract2;
+	uint32_t                    mod2;
+	bool                        valid;
+};
+
 /**
  * @struct adf5355_dev
  * @brief  Device descriptor.
@@ -217,6 +234,10 @@ struct adf5355_dev {
 	enum adf5355_device_id      dev_id;
 	bool                        all_synced;
 	uint32_t                    regs[ADF5355_REG_NUM];
+	uint32_t                    regs_hw[ADF5355_REG_NUM];
+	bool                        delta_write;
+	struct adf5355_freq_cache   freq_cache[ADF5355_FREQ_CACHE_SIZE];
+	uint8_t                     freq_cache_next;
 	uint64_t                    freq_req;
 	uint8_t                     freq_req_chan;
 	uint8_t                     num_channels;
@@ -276,6 +297,8 @@ struct adf5355_init_param {
 	uint8_t		                ref_div2_en;
 	enum adf5355_mux_out_sel    mux_out_sel;
 	bool                        outb_sel_fund;
+	/* Only write the frequency registers that changed on retune */
+	bool                        delta_write;
 };
 
 /******************************************************************************/
@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <malloc.h>
+#include <string.h>
 #include "adf5902.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
@@ -902,6 +903,107 @@ int32_t adf5902f_compute_frequency(struct adf5902_dev *dev, uint64_t *freq)
 	return ret;
 }
 
+/**
+ * @brief Append a register word to a sweep plan.
+ * @param plan - The sweep plan.
+ * @param reg_addr - The register address.
+ * @param data - Data value to write.
+ */
+static void adf5902_sweep_plan_add(struct adf5902_sweep_plan *plan,
+				   uint8_t reg_addr, uint32_t data)
+{
+	no_os_put_unaligned_be32(data | reg_addr,
+				 &plan->buf[plan->nb_words * ADF5902_BUFF_SIZE_BYTES]);
+	plan->nb_words++;
+}
+
+/**
+ * @brief Precompute the ramp registers of a chirp set. The plan can be built
+ *	  while another chirp set is running and loaded later with
+ *	  adf5902_sweep_plan_load(), as many times as needed.
+ * @param dev - The device structure.
+ * @param cfg - The chirp set configuration.
+ * @param plan - The precomputed register words.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int32_t adf5902_sweep_plan_build(struct adf5902_dev *dev,
+				 const struct adf5902_sweep_cfg *cfg,
+				 struct adf5902_sweep_plan *plan)
+{
+	uint32_t i;
+
+	if (!dev || !cfg || !plan)
+		return -EINVAL;
+
+	if (cfg->delay_words_no > ADF5902_MAX_DELAY_WORD_NO ||
+	    cfg->slopes_no > ADF5902_MAX_SLOPE_NO ||
+	    cfg->clk2_div_no > ADF5902_MAX_CLK2_DIV_NO)
+		return -EINVAL;
+
+	plan->nb_words = 0;
+
+	for (i = 0; i < cfg->delay_words_no; i++)
+		adf5902_sweep_plan_add(plan, ADF5902_REG16, ADF5902_REG16_RESERVED |
+				       ADF5902_REG16_DEL_START_WORD(cfg->delay_wd[i]) |
+				       ADF5902_REG16_RAMP_DEL(cfg->ramp_delay_en) |
+				       ADF5902_REG16_TX_DATA_TRIG(cfg->tx_trig_en) |
+				       ADF5902_REG16_DEL_SEL(i));
+
+	for (i = 0; i < cfg->slopes_no; i++) {
+		adf5902_sweep_plan_add(plan, ADF5902_REG15, ADF5902_REG15_RESERVED |
+				       ADF5902_REG15_STEP_WORD(cfg->slopes[i].step_word) |
+				       ADF5902_REG15_STEP_SEL(i));
+		adf5902_sweep_plan_add(plan, ADF5902_REG14, ADF5902_REG14_RESERVED |
+				       ADF5902_REG14_DEV_WORD(cfg->slopes[i].dev_word) |
+				       ADF5902_REG14_DEV_OFFSET(cfg->slopes[i].dev_offset) |
+				       ADF5902_REG14_DEV_SEL(i));
+	}
+
+	for (i = 0; i < cfg->clk2_div_no; i++)
+		adf5902_sweep_plan_add(plan, ADF5902_REG13, ADF5902_REG13_RESERVED |
+				       ADF5902_REG13_CLK_DIV_2(cfg->clk2_div[i]) |
+				       ADF5902_REG13_CLK_DIV_SEL(i) |
+				       ADF5902_REG13_CLK_DIV_MODE(dev->clk_div_mode) |
+				       ADF5902_REG13_LE_SEL(dev->le_sel));
+
+	adf5902_sweep_plan_add(plan, ADF5902_REG11, ADF5902_REG11_RESERVED |
+			       ADF5902_REG11_RAMP_MODE(cfg->ramp_mode));
+
+	/* Writing R5 with RAMP_ON set starts the ramp */
+	adf5902_sweep_plan_add(plan, ADF5902_REG5, ADF5902_REG5_RESERVED |
+			       ADF5902_REG5_FRAC_MSB_WORD(dev->frac_msb) |
+			       ADF5902_REG5_INTEGER_WORD(dev->int_div) |
+			       ADF5902_REG5_RAMP_ON(ADF5902_RAMP_ON_ENABLED));
+
+	return 0;
+}
+
+/**
+ * @brief Load a precomputed chirp set and start the ramp. The register words
+ *	  are sent as one chain of LE framed words, by DMA when the SPI
+ *	  platform supports it.
+ * @param dev - The device structure.
+ * @param plan - The precomputed register words.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int32_t adf5902_sweep_plan_load(struct adf5902_dev *dev,
+				const struct adf5902_sweep_plan *plan)
+{
+	uint8_t buf[ADF5902_SWEEP_MAX_WORDS * ADF5902_BUFF_SIZE_BYTES];
+	uint32_t len;
+
+	if (!dev || !plan || !plan->nb_words ||
+	    plan->nb_words > ADF5902_SWEEP_MAX_WORDS)
+		return -EINVAL;
+
+	/* Keep the plan reusable, the non DMA path overwrites the buffer */
+	len = plan->nb_words * ADF5902_BUFF_SIZE_BYTES;
+	memcpy(buf, plan->buf, len);
+
+	return no_os_spi_write_chunked(dev->spi_desc, buf, len,
+				       ADF5902_BUFF_SIZE_BYTES);
+}
+
 /**
  * @brief Free resoulces allocated for ADF5902
  * @param dev - The device structure.
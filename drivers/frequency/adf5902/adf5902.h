@@ -415,6 +415,10 @@
 #define ADF5902_BUFF_SIZE_BYTES		4
 #define ADF5902_FRAC_MSB_MSK		0xFFF
 #define ADF5902_FRAC_LSB_MSK		0x1FFF
+/* R16 x4, R15/R14 x4, R13 x4, R11 and R5 */
+#define ADF5902_SWEEP_MAX_WORDS		(ADF5902_MAX_DELAY_WORD_NO + \
+					 2 * ADF5902_MAX_SLOPE_NO + \
+					 ADF5902_MAX_CLK2_DIV_NO + 2)
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -482,6 +486,34 @@ struct adf5902_init_param {
 	uint8_t			ramp_mode;
 };
 
+struct adf5902_sweep_cfg {
+	/* Ramp delay enable */
+	uint8_t			ramp_delay_en;
+	/* TX Data trigger */
+	uint8_t			tx_trig_en;
+	/* Delay words number */
+	uint8_t			delay_words_no;
+	/* Delay Words */
+	uint16_t		delay_wd[ADF5902_MAX_DELAY_WORD_NO];
+	/* Number of deviaton parameters */
+	uint8_t			slopes_no;
+	/* Slope structure */
+	struct slope		slopes[ADF5902_MAX_SLOPE_NO];
+	/* 12-bit Clock Divider number */
+	uint8_t			clk2_div_no;
+	/* 12-bit Clock Divider */
+	uint16_t		clk2_div[ADF5902_MAX_CLK2_DIV_NO];
+	/* Ramp Mode */
+	uint8_t			ramp_mode;
+};
+
+struct adf5902_sweep_plan {
+	/* Number of register words */
+	uint32_t		nb_words;
+	/* Register words, formatted for SPI */
+	uint8_t			buf[ADF5902_SWEEP_MAX_WORDS * ADF5902_BUFF_SIZE_BYTES];
+};
+
 struct adf5902_dev {
 	/* SPI Descriptor */
 	struct no_os_spi_desc		*spi_desc;
@@ -576,6 +608,15 @@ int32_t adf5902_read_temp(struct adf5902_dev *dev, float *temp);
 /* ADF5902 Measure Output locked frequency */
 int32_t adf5902f_compute_frequency(struct adf5902_dev *dev, uint64_t *freq);
 
+/** ADF5902 Precompute the ramp registers of a chirp set */
+int32_t adf5902_sweep_plan_build(struct adf5902_dev *dev,
+				 const struct adf5902_sweep_cfg *cfg,
+				 struct adf5902_sweep_plan *plan);
+
+/** ADF5902 Load a chirp set and start the ramp */
+int32_t adf5902_sweep_plan_load(struct adf5902_dev *dev,
+				const struct adf5902_sweep_plan *plan);
+
 /** ADF5902 Resources Deallocation */
 int32_t adf5902_remove(struct adf5902_dev *dev);
 
@@ -474,15 +474,27 @@ int32_t hmc7044_clk_set_rate(struct hmc7044_dev *dev, uint32_t chan_num,
 		return -1;
 
 	div = hmc7044_calc_out_div(rate, dev->pll2_freq);
-	chan->divider = div;
+	if (div == chan->divider)
+		return 0;
 
-	ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_1(chan->num),
-			    HMC7044_DIV_LSB(div));
-	if(ret < 0)
-		return ret;
+	/* Only write the divider bytes that change */
+	if (HMC7044_DIV_LSB(div) != HMC7044_DIV_LSB(chan->divider)) {
+		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_1(chan->num),
+				    HMC7044_DIV_LSB(div));
+		if(ret < 0)
+			return ret;
+	}
 
-	return hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_2(chan->num),
-			     HMC7044_DIV_MSB(div));
+	if (HMC7044_DIV_MSB(div) != HMC7044_DIV_MSB(chan->divider)) {
+		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_2(chan->num),
+				    HMC7044_DIV_MSB(div));
+		if(ret < 0)
+			return ret;
+	}
+
+	chan->divider = div;
+
+	return 0;
 }
 
 static int hmc7044_info(struct hmc7044_dev *dev)
@@ -607,3 +607,157 @@ int ltc6953_read_part(struct ltc6953_dev *dev, uint8_t *part)
 
 	return 0;
 }
+
+/**
+ * @brief Find the output divider closest to a desired rate.
+ *
+ * The divider is Mx = (MPx + 1) * 2**MDx, where MDx may only be non zero for
+ * MPx >= 16.
+ * @param dev - The device structure.
+ * @param rate - Desired output rate.
+ * @param mp - MPx setting of the closest divider.
+ * @param md - MDx setting of the closest divider.
+ * @return The closest possible output rate, 0 if it cannot be computed.
+ */
+static uint64_t ltc6953_solve_divider(struct ltc6953_dev *dev, uint64_t rate,
+				      uint8_t *mp, uint8_t *md)
+{
+	uint64_t vco = (uint64_t)dev->vco_frequency;
+	uint64_t best_rate = 0, diff, best_diff = UINT64_MAX;
+	uint32_t prescaler, out_rate;
+	int j;
+
+	if (!vco || !rate)
+		return 0;
+
+	for (j = 0; j < 7; j++) {
+		prescaler = NO_OS_DIV_ROUND_CLOSEST_ULL(vco, rate << j);
+		prescaler = no_os_clamp(prescaler, j ? 17U : 1U, 32U);
+		out_rate = NO_OS_DIV_ROUND_CLOSEST_ULL(vco, prescaler << j);
+
+		diff = out_rate > rate ? out_rate - rate : rate - out_rate;
+		if (diff < best_diff) {
+			best_diff = diff;
+			best_rate = out_rate;
+			*mp = prescaler - 1;
+			*md = j;
+		}
+	}
+
+	return best_rate;
+}
+
+/**
+ * @brief Get LTC6953 single channel rate.
+ * @param dev - The device structure.
+ * @param channel - Output channel [0-10]
+ * @param rate - The channel rate.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int ltc6953_clk_recalc_rate(struct ltc6953_dev *dev, uint32_t channel,
+			    uint64_t *rate)
+{
+	int ret;
+	uint8_t readval;
+	uint32_t divider;
+
+	if (!dev || !rate || channel > 10)
+		return -EINVAL;
+
+	ret = ltc6953_read(dev, LTC6953_REG_OUTPUT_DIVIDER(channel), &readval);
+	if (ret)
+		return ret;
+
+	divider = (no_os_field_get(LTC6953_MP_MSK, readval) + 1) <<
+		  no_os_field_get(LTC6953_MD_MSK, readval);
+
+	*rate = NO_OS_DIV_ROUND_CLOSEST_ULL((uint64_t)dev->vco_frequency,
+					    divider);
+
+	return 0;
+}
+
+/**
+ * @brief Round LTC6953 single channel rate.
+ * @param dev - The device structure.
+ * @param channel - Output channel [0-10]
+ * @param rate - The desired rate.
+ * @param rounded_rate - The closest possible rate.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int ltc6953_clk_round_rate(struct ltc6953_dev *dev, uint32_t channel,
+			   uint64_t rate, uint64_t *rounded_rate)
+{
+	uint8_t mp, md;
+
+	if (!dev || !rounded_rate || channel > 10)
+		return -EINVAL;
+
+	*rounded_rate = ltc6953_solve_divider(dev, rate, &mp, &md);
+	if (!*rounded_rate)
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * @brief Set LTC6953 single channel rate.
+ *
+ * The divider register is only written when its value changes. The output
+ * phase is not realigned, issue a SYNC/EZSync request afterwards if the
+ * outputs must stay phase aligned.
+ * @param dev - The device structure.
+ * @param channel - Output channel [0-10]
+ * @param rate - The desired rate.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int ltc6953_clk_set_rate(struct ltc6953_dev *dev, uint32_t channel,
+			 uint64_t rate)
+{
+	int ret;
+	uint8_t mp, md;
+	uint8_t readval, writeval;
+
+	if (!dev || channel > 10)
+		return -EINVAL;
+
+	if (!ltc6953_solve_divider(dev, rate, &mp, &md))
+		return -EINVAL;
+
+	ret = ltc6953_read(dev, LTC6953_REG_OUTPUT_DIVIDER(channel), &readval);
+	if (ret)
+		return ret;
+
+	writeval = no_os_field_prep(LTC6953_MP_MSK, mp) |
+		   no_os_field_prep(LTC6953_MD_MSK, md);
+	if (writeval == readval)
+		return 0;
+
+	return ltc6953_write(dev, LTC6953_REG_OUTPUT_DIVIDER(channel), writeval);
+}
+
+static int ltc6953_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
+{
+	return ltc6953_clk_recalc_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
+static int ltc6953_round_rate(struct no_os_clk_desc *desc, uint64_t rate,
+			      uint64_t *rounded_rate)
+{
+	return ltc6953_clk_round_rate(desc->dev_desc, desc->hw_ch_num, rate,
+				      rounded_rate);
+}
+
+static int ltc6953_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	return ltc6953_clk_set_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
+/**
+ * @brief ltc6953 clock ops
+ */
+const struct no_os_clk_platform_ops ltc6953_clk_ops = {
+	.clk_recalc_rate = &ltc6953_recalc_rate,
+	.clk_round_rate = &ltc6953_round_rate,
+	.clk_set_rate = &ltc6953_set_rate,
+};
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_clk.h"
 #include "no_os_error.h"
 
 /******************************************************************************/
@@ -277,4 +278,18 @@ int ltc6953_read_rev(struct ltc6953_dev *dev, uint8_t *rev);
 /** LTC6953 Get Part Number **/
 int ltc6953_read_part(struct ltc6953_dev *dev, uint8_t *part);
 
+/** LTC6953 Get single channel rate **/
+int ltc6953_clk_recalc_rate(struct ltc6953_dev *dev, uint32_t channel,
+			    uint64_t *rate);
+
+/** LTC6953 Round single channel rate **/
+int ltc6953_clk_round_rate(struct ltc6953_dev *dev, uint32_t channel,
+			   uint64_t rate, uint64_t *rounded_rate);
+
+/** LTC6953 Set single channel rate **/
+int ltc6953_clk_set_rate(struct ltc6953_dev *dev, uint32_t channel,
+			 uint64_t rate);
+
+extern const struct no_os_clk_platform_ops ltc6953_clk_ops;
+
 #endif // __LTC6953_H__
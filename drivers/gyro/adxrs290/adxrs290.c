@@ -45,6 +45,7 @@
 #include <string.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 #include "adxrs290.h"
 
 /******************************************************************************/
@@ -249,6 +250,46 @@ int32_t adxrs290_get_temp_data(struct adxrs290_dev *dev, int16_t *temp)
 	return ret;
 }
 
+/**
+ * @brief Convert the data registers read by a burst.
+ * @param data - DATAX0 to TEMP1.
+ * @param result - Values of the channels, indexed by enum adxrs290_channel.
+ */
+static void adxrs290_burst_decode(uint8_t *data, int16_t *result)
+{
+	uint8_t ch_idx;
+
+	for (ch_idx = 0; ch_idx < ADXRS290_CHANNEL_COUNT; ch_idx++)
+		result[ch_idx] = (int16_t)no_os_get_unaligned_le16(
+					 &data[2 * ch_idx]);
+
+	result[ADXRS290_CHANNEL_TEMP] =
+		(int16_t)(result[ADXRS290_CHANNEL_TEMP] << 4) >> 4;
+}
+
+/**
+ * @brief Read DATAX0 to TEMP1 in one transfer. A single read command is sent,
+ *	  the address is incremented by the device for the next bytes.
+ * @param dev - Device handler.
+ * @param result - Values of the channels, indexed by enum adxrs290_channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adxrs290_burst_read(struct adxrs290_dev *dev, int16_t *result)
+{
+	uint8_t data[ADXRS290_BURST_LEN] = {
+		ADXRS290_READ_REG(ADXRS290_REG_DATAX0)
+	};
+	int32_t ret;
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, data, ADXRS290_BURST_LEN);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	adxrs290_burst_decode(&data[1], result);
+
+	return 0;
+}
+
 /**
  * @brief Get the burst data.
  * @param dev - Device handler.
@@ -259,35 +300,41 @@ int32_t adxrs290_get_temp_data(struct adxrs290_dev *dev, int16_t *temp)
 int32_t adxrs290_get_burst_data(struct adxrs290_dev *dev, int16_t *burst_data,
 				uint8_t *ch_cnt)
 {
-	int32_t		ret = 0;
-	uint8_t		data_bytes = ADXRS290_CHANNEL_COUNT*2;
-	uint8_t		data[data_bytes + 1];
-	int16_t		result;
+	int16_t		result[ADXRS290_CHANNEL_COUNT];
+	int32_t		ret;
 	uint8_t		ch_idx;
-	uint8_t		i;
 
-	for (i = 0; i < data_bytes; i++)
-		data[i] = 0x80 | (ADXRS290_REG_DATAX0 + i);
-
-	data[data_bytes] = 0;
-
-	ret = no_os_spi_write_and_read(dev->spi_desc, data, data_bytes + 1);
+	ret = adxrs290_burst_read(dev, result);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	i = 1;
 	*ch_cnt = 0;
-	for (ch_idx = 0; ch_idx < ADXRS290_CHANNEL_COUNT; ch_idx++) {
-		result = (((int16_t)data[i+1]) << 8) | data[i];
-		i += 2;
-		if (ch_idx == ADXRS290_CHANNEL_TEMP)
-			result = (result << 4) >> 4;
-
+	for (ch_idx = 0; ch_idx < ADXRS290_CHANNEL_COUNT; ch_idx++)
 		if ((1 << ch_idx) & dev->ch_mask)
-			burst_data[(*ch_cnt)++] = result;
-	}
+			burst_data[(*ch_cnt)++] = result[ch_idx];
 
-	return ret;
+	return 0;
+}
+
+/**
+ * @brief Read all the channels in one burst.
+ * @param dev - Device handler.
+ * @param scan - The channels and the time of the read, 0 without a timestamp
+ *		 timer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_read_scan(struct adxrs290_dev *dev,
+			   struct adxrs290_scan *scan)
+{
+	if (!dev || !scan)
+		return -EINVAL;
+
+	scan->timestamp = 0;
+	if (dev->ts_timer)
+		no_os_timer_get_elapsed_time_nsec(dev->ts_timer,
+						  &scan->timestamp);
+
+	return adxrs290_burst_read(dev, scan->data);
 }
 
 /**
@@ -329,6 +376,233 @@ int32_t adxrs290_get_data_ready(struct adxrs290_dev *dev, bool *rdy)
 	return ret;
 }
 
+/**
+ * @brief Store the scan read by the data ready interrupt in the ring.
+ * @param dev - Device handler.
+ * @param status - Result of the SPI transfer.
+ */
+static void adxrs290_stream_push(struct adxrs290_dev *dev, int32_t status)
+{
+	struct adxrs290_scan scan;
+
+	if (status) {
+		dev->stream_errors++;
+		goto out;
+	}
+
+	scan.timestamp = dev->stream_ts;
+	adxrs290_burst_decode(&dev->stream_buf[1], scan.data);
+
+	if (!no_os_lfring_push(dev->ring, &scan, 1))
+		dev->stream_overruns++;
+out:
+	/* The transfer is done in place, restore the read command */
+	memset(dev->stream_buf, 0, ADXRS290_BURST_LEN);
+	dev->stream_buf[0] = ADXRS290_READ_REG(ADXRS290_REG_DATAX0);
+	dev->stream_busy = false;
+}
+
+/**
+ * @brief Completion of the asynchronous burst read.
+ * @param ctx - Device handler.
+ */
+static void adxrs290_stream_done(void *ctx)
+{
+	adxrs290_stream_push(ctx, 0);
+}
+
+/**
+ * @brief Data ready handler of the streaming mode. Timestamps the scan and
+ *	  reads all the channels in one transfer, asynchronously when the SPI
+ *	  driver supports it. The read takes the sync pin back low.
+ * @param ctx - Device handler.
+ */
+static void adxrs290_stream_isr(void *ctx)
+{
+	struct adxrs290_dev *dev = ctx;
+	uint64_t ts = 0;
+	int32_t ret;
+
+	if (dev->ts_timer)
+		no_os_timer_get_elapsed_time_nsec(dev->ts_timer, &ts);
+
+	if (dev->stream_busy) {
+		dev->stream_overruns++;
+		return;
+	}
+
+	dev->stream_busy = true;
+	dev->stream_ts = ts;
+
+	if (!dev->stream_sync) {
+		ret = no_os_spi_seq_run_async(dev->seq, adxrs290_stream_done,
+					      dev);
+		if (ret != -ENOSYS) {
+			if (ret)
+				adxrs290_stream_push(dev, ret);
+			return;
+		}
+		dev->stream_sync = true;
+	}
+
+	ret = no_os_spi_seq_run(dev->seq);
+	adxrs290_stream_push(dev, ret);
+}
+
+/**
+ * @brief Set up the data ready interrupt, the ring and the burst read used by
+ *	  the streaming mode. The interrupt is enabled by
+ *	  adxrs290_stream_start().
+ * @param dev - Device handler.
+ * @param init_param - The structure that contains the device initial
+ *		       parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adxrs290_stream_init(struct adxrs290_dev *dev,
+				    const struct adxrs290_init_param *init_param)
+{
+	int32_t ret;
+
+	dev->ts_timer = init_param->ts_timer;
+
+	if (!dev->gpio_sync || !init_param->irq_ctrl)
+		return 0;
+
+	ret = no_os_lfring_init(&dev->ring, sizeof(struct adxrs290_scan),
+				init_param->ring_depth ? init_param->ring_depth :
+				ADXRS290_STREAM_RING_DEPTH, false);
+	if (ret)
+		return ret;
+
+	dev->stream_buf[0] = ADXRS290_READ_REG(ADXRS290_REG_DATAX0);
+	dev->stream_msg.tx_buff = dev->stream_buf;
+	dev->stream_msg.rx_buff = dev->stream_buf;
+	dev->stream_msg.bytes_number = ADXRS290_BURST_LEN;
+	dev->stream_msg.cs_change = 1;
+
+	ret = no_os_spi_seq_init(&dev->seq, dev->spi_desc, &dev->stream_msg, 1);
+	if (ret)
+		goto error_ring;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = adxrs290_stream_isr,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  dev->gpio_sync->number, &dev->irq_cb);
+	if (ret)
+		goto error_seq;
+
+	/* The sync pin is high from a new scan until it is read */
+	ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+					  dev->gpio_sync->number,
+					  NO_OS_IRQ_EDGE_RISING);
+	if (ret)
+		goto error_irq;
+
+	dev->irq_ctrl = init_param->irq_ctrl;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl,
+				      dev->gpio_sync->number, &dev->irq_cb);
+error_seq:
+	no_os_spi_seq_remove(dev->seq);
+	dev->seq = NULL;
+error_ring:
+	no_os_lfring_remove(dev->ring);
+	dev->ring = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Start reading the scans from the data ready interrupt. The pending
+ *	  scan is read first, so that the sync pin goes low and the next scan
+ *	  raises an edge.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_stream_start(struct adxrs290_dev *dev)
+{
+	int16_t result[ADXRS290_CHANNEL_COUNT];
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->irq_ctrl)
+		return -ENOTSUP;
+
+	if (dev->stream_on)
+		return -EBUSY;
+
+	no_os_lfring_flush(dev->ring);
+	dev->stream_busy = false;
+	dev->stream_overruns = 0;
+	dev->stream_errors = 0;
+
+	ret = adxrs290_burst_read(dev, result);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_sync->number);
+	if (ret)
+		return ret;
+
+	dev->stream_on = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the streaming mode. The scans left in the ring can still be
+ *	  read.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_stream_stop(struct adxrs290_dev *dev)
+{
+	int32_t ret, timeout = 100;
+
+	if (!dev || !dev->stream_on)
+		return -EINVAL;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_sync->number);
+	if (ret)
+		return ret;
+
+	dev->stream_on = false;
+
+	while (dev->stream_busy && timeout--)
+		no_os_udelay(100);
+
+	return dev->stream_busy ? -ETIMEDOUT : 0;
+}
+
+/**
+ * @brief Take the scans read by the streaming mode, oldest first.
+ * @param dev - Device handler.
+ * @param scans - Where to store the scans.
+ * @param nb_scans - Maximum number of scans to take.
+ * @return Number of scans taken, negative error code otherwise.
+ */
+int32_t adxrs290_stream_read(struct adxrs290_dev *dev,
+			     struct adxrs290_scan *scans, uint32_t nb_scans)
+{
+	if (!dev || !scans)
+		return -EINVAL;
+
+	if (!dev->ring)
+		return -ENOTSUP;
+
+	return no_os_lfring_pop(dev->ring, scans, nb_scans);
+}
+
 /**
  * Initialize the device.
  * @param device - The device structure.
@@ -343,7 +617,7 @@ int32_t adxrs290_init(struct adxrs290_dev **device,
 	int32_t ret = 0;
 	uint8_t val = 0;
 
-	dev = (struct adxrs290_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct adxrs290_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
 
@@ -394,6 +668,10 @@ int32_t adxrs290_init(struct adxrs290_dev **device,
 	// Enable all channels by default
 	dev->ch_mask = ADXRS290_CHANNEL_MASK;
 
+	ret = adxrs290_stream_init(dev, init_param);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto error_gpio;
+
 	*device = dev;
 
 	return ret;
@@ -417,6 +695,15 @@ error_dev:
  */
 int32_t adxrs290_remove(struct adxrs290_dev *dev)
 {
+	if (dev->stream_on)
+		adxrs290_stream_stop(dev);
+
+	if (dev->irq_ctrl)
+		no_os_irq_unregister_callback(dev->irq_ctrl,
+					      dev->gpio_sync->number,
+					      &dev->irq_cb);
+	no_os_spi_seq_remove(dev->seq);
+	no_os_lfring_remove(dev->ring);
 	no_os_spi_remove(dev->spi_desc);
 	no_os_gpio_remove(dev->gpio_sync);
 	no_os_free(dev);
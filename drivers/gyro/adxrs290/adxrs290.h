@@ -48,6 +48,9 @@
 #include <stdbool.h>
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#include "no_os_lfring.h"
 #include "no_os_util.h"
 
 /******************************************************************************/
@@ -95,6 +98,10 @@
 #define ADXRS290_MAX_TRANSITION_TIME_MS 100
 #define ADXRS290_CHANNEL_COUNT			3
 #define ADXRS290_CHANNEL_MASK			0x07
+/* Read command and DATAX0 to TEMP1, read in one burst */
+#define ADXRS290_BURST_LEN			(1 + ADXRS290_CHANNEL_COUNT * 2)
+/* Default number of scans buffered by the streaming mode */
+#define ADXRS290_STREAM_RING_DEPTH		32
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -156,6 +163,17 @@ enum adxrs290_hpf {
 	ADXRS290_HPF_11HZ30
 };
 
+/**
+ * @struct adxrs290_scan
+ * @brief Scan read by the streaming mode
+ */
+struct adxrs290_scan {
+	/** Time of the data ready edge in ns, 0 without a timestamp timer */
+	uint64_t	timestamp;
+	/** Rate and temperature data, indexed by enum adxrs290_channel */
+	int16_t		data[ADXRS290_CHANNEL_COUNT];
+};
+
 /**
  * @struct adxrs290_init_param
  * @brief Device driver initialization structure
@@ -171,6 +189,15 @@ struct adxrs290_init_param {
 	enum adxrs290_lpf	lpf;
 	/** Initial hpf settings */
 	enum adxrs290_hpf	hpf;
+	/**
+	 * Optional. Interrupt controller of gpio_sync, enables the streaming
+	 * mode. The GPIO trigger can't be used on the same line.
+	 */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	/** Optional running timer, timestamps the scans */
+	struct no_os_timer_desc	*ts_timer;
+	/** Scans buffered by the streaming mode, power of 2. 0 for default */
+	uint32_t		ring_depth;
 };
 
 /**
@@ -184,6 +211,23 @@ struct adxrs290_dev {
 	struct no_os_gpio_desc	*gpio_sync;
 	/** Active Channels */
 	uint8_t			ch_mask;
+	/** Interrupt controller of gpio_sync, used by the streaming mode */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	struct no_os_callback_desc	irq_cb;
+	struct no_os_timer_desc	*ts_timer;
+	/** Streaming mode: scans read from the data ready interrupt */
+	struct no_os_lfring	*ring;
+	struct no_os_spi_seq	*seq;
+	struct no_os_spi_msg	stream_msg;
+	uint8_t			stream_buf[ADXRS290_BURST_LEN];
+	uint64_t		stream_ts;
+	volatile bool		stream_busy;
+	bool			stream_sync;
+	bool			stream_on;
+	/** Scans dropped because the ring was full or a read was pending */
+	uint32_t		stream_overruns;
+	/** Scans dropped for a SPI error */
+	uint32_t		stream_errors;
 };
 
 /******************************************************************************/
@@ -224,12 +268,26 @@ int32_t adxrs290_get_temp_data(struct adxrs290_dev *dev, int16_t *temp);
 int32_t adxrs290_get_burst_data(struct adxrs290_dev *dev, int16_t *burst_data,
 				uint8_t *ch_cnt);
 
+/* Read all the channels in one burst, with the time of the read */
+int32_t adxrs290_read_scan(struct adxrs290_dev *dev,
+			   struct adxrs290_scan *scan);
+
 /* Set the ADXRS290 active channels */
 int32_t adxrs290_set_active_channels(struct adxrs290_dev *dev, uint32_t mask);
 
 /* Get the data ready state */
 int32_t adxrs290_get_data_ready(struct adxrs290_dev *dev, bool *rdy);
 
+/* Start reading the scans from the data ready interrupt. */
+int32_t adxrs290_stream_start(struct adxrs290_dev *dev);
+
+/* Stop the streaming mode. */
+int32_t adxrs290_stream_stop(struct adxrs290_dev *dev);
+
+/* Take the scans read by the streaming mode. */
+int32_t adxrs290_stream_read(struct adxrs290_dev *dev,
+			     struct adxrs290_scan *scans, uint32_t nb_scans);
+
 /* Init. the comm. peripheral and checks if the ADXRS290 part is present. */
 int32_t adxrs290_init(struct adxrs290_dev **device,
 		      const struct adxrs290_init_param *init_param);
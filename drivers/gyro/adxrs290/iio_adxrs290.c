@@ -44,6 +44,7 @@
 #include "adxrs290.h"
 #include "no_os_util.h"
 #include "no_os_error.h"
+#include "no_os_delay.h"
 #include "iio.h"
 
 /*
@@ -175,52 +176,116 @@ static int set_adxrs290_iio_ch_lpf(void *device, char *buf, uint32_t len,
 	return -1;
 }
 
+/* Index of the timestamp channel, after the channels read from the device */
+#define ADXRS290_IIO_TIMESTAMP	ADXRS290_CHANNEL_COUNT
+/* Scans taken from the streaming mode at once */
+#define ADXRS290_IIO_BATCH	16
+
 static int32_t adxrs290_update_active_channels(void *device, uint32_t mask)
 {
 	struct adxrs290_dev *dev = device;
 
 	adxrs290_set_active_channels(dev, mask);
 
+	if (dev->irq_ctrl)
+		return adxrs290_stream_start(dev);
+
 	return 0;
 }
 
-static int32_t adxrs290_read_samples(void *device, uint16_t *buff,
-				     uint32_t nb_samples)
+static int32_t adxrs290_post_disable(void *device)
 {
-	struct adxrs290_dev	*dev = device;
-	uint32_t		i;
-	uint32_t		offset;
-	int16_t			data[ADXRS290_CHANNEL_COUNT];
-	uint8_t			ch_cnt;
-	bool			rdy;
-
-	offset = 0;
-	for (i = 0; i < nb_samples; i++) {
-		/* Stop until data is available.
-		 * This will not block at first data since sync pin will
-		 * will always be high until read. */
-		while(true) {
-			adxrs290_get_data_ready(dev, &rdy);
-			if (rdy == true)
-				break;
+	struct adxrs290_dev *dev = device;
+
+	if (dev->stream_on)
+		return adxrs290_stream_stop(dev);
+
+	return 0;
+}
+
+// push a scan to the buffer, laid out as the enabled channels
+static int adxrs290_push_scan(struct iio_buffer *buffer,
+			      struct adxrs290_scan *scan)
+{
+	struct iio_scan_layout *layout = &buffer->layout;
+	/* Largest scan: X, Y, temperature, padding and timestamp */
+	uint64_t data[2];
+	uint8_t *p = (uint8_t *)data;
+	uint32_t e, ch;
+
+	for (e = 0; e < layout->nb; e++) {
+		ch = layout->ch[e];
+		if (ch == ADXRS290_IIO_TIMESTAMP)
+			memcpy(&p[layout->offset[e]], &scan->timestamp,
+			       sizeof(scan->timestamp));
+		else
+			memcpy(&p[layout->offset[e]], &scan->data[ch],
+			       sizeof(scan->data[ch]));
+	}
+
+	return iio_buffer_push_scan(buffer, data);
+}
+
+// fill the buffer from the streaming mode, or by polling the sync pin
+static int32_t adxrs290_submit(struct iio_device_data *iio_dev_data)
+{
+	struct adxrs290_dev *dev = iio_dev_data->dev;
+	struct iio_buffer *buffer = iio_dev_data->buffer;
+	struct adxrs290_scan scans[ADXRS290_IIO_BATCH];
+	uint32_t i, j, n, timeout;
+	bool rdy;
+	int32_t ret;
+
+	for (i = 0; i < buffer->samples; i += n) {
+		n = no_os_min(buffer->samples - i, (uint32_t)ADXRS290_IIO_BATCH);
+
+		if (dev->stream_on) {
+			timeout = 1000;
+			while (!(ret = adxrs290_stream_read(dev, scans, n))) {
+				if (!timeout--)
+					return -ETIMEDOUT;
+				no_os_mdelay(1);
+			}
+			if (ret < 0)
+				return ret;
+			n = ret;
+		} else {
+			/* Stop until data is available. This will not block
+			 * at first data since sync pin will always be high
+			 * until read. */
+			for (j = 0; j < n; j++) {
+				do {
+					ret = adxrs290_get_data_ready(dev, &rdy);
+					if (ret)
+						return ret;
+				} while (!rdy);
+
+				ret = adxrs290_read_scan(dev, &scans[j]);
+				if (ret)
+					return ret;
+			}
+		}
+
+		for (j = 0; j < n; j++) {
+			ret = adxrs290_push_scan(buffer, &scans[j]);
+			if (ret)
+				return ret;
 		}
-		adxrs290_get_burst_data(dev, data, &ch_cnt);
-		memcpy(&buff[offset], data, ch_cnt*sizeof(int16_t));
-		offset += ch_cnt;
 	}
 
-	return nb_samples;
+	return 0;
 }
 
 static int32_t adxrs290_trigger_handler(struct iio_device_data *device)
 {
-	struct adxrs290_dev	*dev = device->dev;
-	int16_t			data[ADXRS290_CHANNEL_COUNT];
-	uint8_t			ch_cnt;
+	struct adxrs290_scan	scan;
+	int32_t			ret;
 
-	adxrs290_get_burst_data(dev, data, &ch_cnt);
+	ret = adxrs290_read_scan(device->dev, &scan);
+	if (ret)
+		return ret;
 
-	return iio_buffer_push_scan(device->buffer, data);
+	return adxrs290_push_scan(device->buffer, &scan);
 }
 
 static struct iio_attribute adxrs290_iio_vel_attrs[] = {
@@ -277,6 +342,14 @@ static struct scan_type scan_type_temp = {
 	.is_big_endian = false
 };
 
+static struct scan_type scan_type_ts = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false
+};
+
 static struct iio_channel adxrs290_iio_channels[] = {
 	{
 		.ch_type = IIO_ANGL_VEL,
@@ -305,18 +378,24 @@ static struct iio_channel adxrs290_iio_channels[] = {
 		.scan_type = &scan_type_temp,
 		.attributes = adxrs290_iio_temp_attrs,
 		.ch_out = false,
+	},
+	{
+		.ch_type = IIO_TIMESTAMP,
+		.scan_index = ADXRS290_IIO_TIMESTAMP,
+		.scan_type = &scan_type_ts,
+		.ch_out = false,
 	}
 };
 
 struct iio_device adxrs290_iio_descriptor = {
-	.num_ch = 3,
+	.num_ch = NO_OS_ARRAY_SIZE(adxrs290_iio_channels),
 	.channels = adxrs290_iio_channels,
 	.attributes = NULL,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
 	.pre_enable = adxrs290_update_active_channels,
-	.post_disable = NULL,
-	.read_dev = (int32_t (*)())adxrs290_read_samples,
+	.post_disable = adxrs290_post_disable,
+	.submit = adxrs290_submit,
 	.trigger_handler = (int32_t (*)())adxrs290_trigger_handler,
 	.debug_reg_read = (int32_t (*)())adxrs290_reg_read,
 	.debug_reg_write = (int32_t (*)())adxrs290_reg_write
@@ -43,6 +43,192 @@
 #include <stdlib.h>
 #include "adxrs453.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+
+/***************************************************************************//**
+ * @brief Sets the parity bit of a command, for odd parity over the 32 bits.
+ *
+ * @param command - The command, with bit 0 cleared.
+ *
+ * @return The command with its parity bit.
+*******************************************************************************/
+static uint32_t adxrs453_cmd_parity(uint32_t command)
+{
+	if (!(no_os_hweight32(command) & 1))
+		command |= 1;
+
+	return command;
+}
+
+/***************************************************************************//**
+ * @brief Writes the sensor data command in the frame of the streaming mode.
+ *
+ * @param dev - The device structure.
+ *
+ * @return None.
+*******************************************************************************/
+static void adxrs453_stream_cmd(struct adxrs453_dev *dev)
+{
+	uint32_t command = (uint32_t)ADXRS453_SENSOR_DATA << 24;
+
+	no_os_put_unaligned_be32(adxrs453_cmd_parity(command),
+				 dev->stream_frame);
+}
+
+/***************************************************************************//**
+ * @brief Stores the response of the last frame of the streaming mode in the
+ *        ring. It answers the command of the previous frame, which is
+ *        discarded when it was not a sensor data command.
+ *
+ * @param dev    - The device structure.
+ * @param status - Result of the SPI transfer.
+ *
+ * @return None.
+*******************************************************************************/
+static void adxrs453_stream_push(struct adxrs453_dev *dev, int32_t status)
+{
+	struct adxrs453_sample sample = {0};
+
+	if (status) {
+		/* The response to the next frame can't be trusted either */
+		dev->stream_errors++;
+		dev->stream_primed = false;
+		goto out;
+	}
+
+	if (dev->stream_primed) {
+		sample.timestamp = dev->stream_prev_ts;
+		sample.frame = no_os_get_unaligned_be32(dev->stream_frame);
+		if (!no_os_lfring_push(dev->ring, &sample, 1))
+			dev->stream_overruns++;
+	}
+	dev->stream_primed = true;
+out:
+	/* The transfer is done in place, restore the command */
+	adxrs453_stream_cmd(dev);
+	dev->stream_busy = false;
+}
+
+/***************************************************************************//**
+ * @brief Completion of the asynchronous frame of the streaming mode.
+ *
+ * @param ctx - The device structure.
+ *
+ * @return None.
+*******************************************************************************/
+static void adxrs453_stream_done(void *ctx)
+{
+	adxrs453_stream_push(ctx, 0);
+}
+
+/***************************************************************************//**
+ * @brief Pace timer handler of the streaming mode. Sends one sensor data
+ *        command, asynchronously when the SPI driver supports it. The
+ *        response carries the sample latched by the previous command, so
+ *        each sample costs a single frame.
+ *
+ * @param ctx - The device structure.
+ *
+ * @return None.
+*******************************************************************************/
+static void adxrs453_stream_isr(void *ctx)
+{
+	struct adxrs453_dev *dev = ctx;
+	uint64_t ts = 0;
+	int32_t ret;
+
+	if (dev->ts_timer)
+		no_os_timer_get_elapsed_time_nsec(dev->ts_timer, &ts);
+
+	if (dev->stream_busy) {
+		dev->stream_overruns++;
+		return;
+	}
+
+	dev->stream_busy = true;
+	dev->stream_prev_ts = dev->stream_ts;
+	dev->stream_ts = ts;
+
+	if (!dev->stream_sync) {
+		ret = no_os_spi_seq_run_async(dev->seq, adxrs453_stream_done,
+					      dev);
+		if (ret != -ENOSYS) {
+			if (ret)
+				adxrs453_stream_push(dev, ret);
+			return;
+		}
+		dev->stream_sync = true;
+	}
+
+	ret = no_os_spi_seq_run(dev->seq);
+	adxrs453_stream_push(dev, ret);
+}
+
+/***************************************************************************//**
+ * @brief Sets up the ring, the frame and the pace timer interrupt used by the
+ *        streaming mode. The interrupt is enabled by adxrs453_stream_start().
+ *
+ * @param dev        - The device structure.
+ * @param init_param - The structure that contains the device initial
+ * 		       parameters.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int32_t adxrs453_stream_init(struct adxrs453_dev *dev,
+				    struct adxrs453_init_param *init_param)
+{
+	int32_t ret;
+
+	dev->ts_timer = init_param->ts_timer;
+
+	if (!init_param->pace_timer || !init_param->irq_ctrl)
+		return 0;
+
+	ret = no_os_lfring_init(&dev->ring, sizeof(struct adxrs453_sample),
+				init_param->ring_depth ? init_param->ring_depth :
+				ADXRS453_STREAM_RING_DEPTH, false);
+	if (ret)
+		return ret;
+
+	adxrs453_stream_cmd(dev);
+	dev->stream_msg.tx_buff = dev->stream_frame;
+	dev->stream_msg.rx_buff = dev->stream_frame;
+	dev->stream_msg.bytes_number = 4;
+	dev->stream_msg.cs_change = 1;
+
+	ret = no_os_spi_seq_init(&dev->seq, dev->spi_desc, &dev->stream_msg, 1);
+	if (ret)
+		goto error_ring;
+
+	dev->timer_cb = (struct no_os_callback_desc) {
+		.callback = adxrs453_stream_isr,
+		.ctx = dev,
+		.event = NO_OS_EVT_TIM_ELAPSED,
+		.peripheral = NO_OS_TIM_IRQ,
+		.handle = init_param->irq_handle,
+	};
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  init_param->irq_id, &dev->timer_cb);
+	if (ret)
+		goto error_seq;
+
+	dev->pace_timer = init_param->pace_timer;
+	dev->irq_ctrl = init_param->irq_ctrl;
+	dev->irq_id = init_param->irq_id;
+
+	return 0;
+
+error_seq:
+	no_os_spi_seq_remove(dev->seq);
+	dev->seq = NULL;
+error_ring:
+	no_os_lfring_remove(dev->ring);
+	dev->ring = NULL;
+
+	return ret;
+}
 
 /***************************************************************************//**
  * @brief Initializes the ADXRS453 and checks if the device is present.
@@ -63,7 +249,7 @@ int32_t adxrs453_init(struct adxrs453_dev **device,
 	int32_t status = 0;
 	uint16_t adxrs453_id = 0;
 
-	dev = (struct adxrs453_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct adxrs453_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
@@ -74,6 +260,9 @@ int32_t adxrs453_init(struct adxrs453_dev **device,
 	if((adxrs453_id >> 8) != 0x52)
 		status = -1;
 
+	if (!status)
+		status = adxrs453_stream_init(dev, &init_param);
+
 	*device = dev;
 
 	return status;
@@ -90,6 +279,15 @@ int32_t adxrs453_remove(struct adxrs453_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->stream_on)
+		adxrs453_stream_stop(dev);
+
+	if (dev->irq_ctrl)
+		no_os_irq_unregister_callback(dev->irq_ctrl, dev->irq_id,
+					      &dev->timer_cb);
+	no_os_spi_seq_remove(dev->seq);
+	no_os_lfring_remove(dev->ring);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	no_os_free(dev);
@@ -258,3 +456,130 @@ float adxrs453_get_temperature(struct adxrs453_dev *dev)
 
 	return temperature;
 }
+
+/***************************************************************************//**
+ * @brief Starts sending a sensor data command on each pace timer period. No
+ *        other command may be sent to the device until the streaming mode
+ *        is stopped.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t adxrs453_stream_start(struct adxrs453_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->pace_timer)
+		return -ENOTSUP;
+
+	if (dev->stream_on)
+		return -EBUSY;
+
+	no_os_lfring_flush(dev->ring);
+	dev->stream_busy = false;
+	/* The first response answers the last command sent outside */
+	dev->stream_primed = false;
+	dev->stream_overruns = 0;
+	dev->stream_errors = 0;
+	dev->stream_bad_frames = 0;
+
+	ret = no_os_irq_enable(dev->irq_ctrl, dev->irq_id);
+	if (ret)
+		return ret;
+
+	ret = no_os_timer_start(dev->pace_timer);
+	if (ret) {
+		no_os_irq_disable(dev->irq_ctrl, dev->irq_id);
+		return ret;
+	}
+
+	dev->stream_on = true;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Stops the streaming mode. The samples left in the ring can still be
+ *        read.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t adxrs453_stream_stop(struct adxrs453_dev *dev)
+{
+	int32_t ret, timeout = 100;
+
+	if (!dev || !dev->stream_on)
+		return -EINVAL;
+
+	ret = no_os_timer_stop(dev->pace_timer);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->irq_id);
+	if (ret)
+		return ret;
+
+	dev->stream_on = false;
+
+	while (dev->stream_busy && timeout--)
+		no_os_udelay(100);
+
+	return dev->stream_busy ? -ETIMEDOUT : 0;
+}
+
+/***************************************************************************//**
+ * @brief Takes the samples read by the streaming mode, oldest first, and
+ *        checks them together. A response must have odd parity over bits
+ *        31:16 (P0) and over the whole frame (P1) and carry valid sensor
+ *        data, the other ones are dropped and counted in stream_bad_frames.
+ *
+ * @param dev        - The device structure.
+ * @param samples    - Where to store the samples.
+ * @param nb_samples - Maximum number of samples to take.
+ *
+ * @return Number of valid samples stored, negative error code otherwise.
+*******************************************************************************/
+int32_t adxrs453_stream_read(struct adxrs453_dev *dev,
+			     struct adxrs453_sample *samples,
+			     uint32_t nb_samples)
+{
+	uint32_t frame, i, nb_valid = 0;
+	int32_t ret;
+
+	if (!dev || !samples)
+		return -EINVAL;
+
+	if (!dev->ring)
+		return -ENOTSUP;
+
+	ret = no_os_lfring_pop(dev->ring, samples, nb_samples);
+	if (ret <= 0)
+		return ret;
+
+	for (i = 0; i < (uint32_t)ret; i++) {
+		frame = samples[i].frame;
+		if (!(no_os_hweight32(frame) & 1) ||
+		    !(no_os_hweight16(frame >> 16) & 1) ||
+		    no_os_field_get(ADXRS453_RESP_ST_MSK, frame) !=
+		    ADXRS453_ST_SENSOR_DATA) {
+			dev->stream_bad_frames++;
+			continue;
+		}
+
+		samples[nb_valid].timestamp = samples[i].timestamp;
+		samples[nb_valid].frame = frame;
+		samples[nb_valid].rate =
+			(int16_t)no_os_field_get(ADXRS453_RESP_RATE_MSK, frame);
+		samples[nb_valid].fault =
+			no_os_field_get(ADXRS453_RESP_FAULT_MSK, frame);
+		nb_valid++;
+	}
+
+	return nb_valid;
+}
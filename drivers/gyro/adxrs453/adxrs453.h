@@ -43,7 +43,12 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#include "no_os_lfring.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************** ADXRS453 Definitions ******************************/
@@ -63,18 +68,78 @@
 #define ADXRS453_REG_SN_HIGH    0x0E
 #define ADXRS453_REG_SN_LOW     0x10
 
+/* Fields of the response to a sensor data command */
+#define ADXRS453_RESP_ST_MSK    NO_OS_GENMASK(27, 26)
+#define ADXRS453_RESP_RATE_MSK  NO_OS_GENMASK(25, 10)
+#define ADXRS453_RESP_FAULT_MSK NO_OS_GENMASK(9, 1)
+#define ADXRS453_ST_SENSOR_DATA 1
+
+/* Rate data LSBs per degree/second */
+#define ADXRS453_RATE_SCALE     80
+
+/* Default number of samples buffered by the streaming mode */
+#define ADXRS453_STREAM_RING_DEPTH 64
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/* Sample read by the streaming mode */
+struct adxrs453_sample {
+	/* Time of the command that latched the sample in ns, 0 without a
+	 * timestamp timer */
+	uint64_t	timestamp;
+	/* Response to the sensor data command */
+	uint32_t	frame;
+	/* Rate data, ADXRS453_RATE_SCALE LSBs per degree/second */
+	int16_t		rate;
+	/* Fault bits of the response */
+	uint16_t	fault;
+};
+
 struct adxrs453_dev {
 	/* SPI */
 	struct no_os_spi_desc	*spi_desc;
+	/* Streaming mode: sensor data commands sent on each pace timer period */
+	struct no_os_timer_desc		*pace_timer;
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	uint32_t			irq_id;
+	struct no_os_callback_desc	timer_cb;
+	struct no_os_timer_desc		*ts_timer;
+	struct no_os_lfring		*ring;
+	struct no_os_spi_seq		*seq;
+	struct no_os_spi_msg		stream_msg;
+	uint8_t				stream_frame[4];
+	/* Time of the last command and of the one before it */
+	uint64_t			stream_ts;
+	uint64_t			stream_prev_ts;
+	volatile bool			stream_busy;
+	bool				stream_sync;
+	bool				stream_on;
+	/* Set once a sensor data command was sent, its response is valid */
+	bool				stream_primed;
+	/* Samples dropped because the ring was full or a frame was pending */
+	uint32_t			stream_overruns;
+	/* Samples dropped for a SPI error */
+	uint32_t			stream_errors;
+	/* Samples dropped for a parity error or an invalid status */
+	uint32_t			stream_bad_frames;
 };
 
 struct adxrs453_init_param {
 	/* SPI */
 	struct no_os_spi_init_param	spi_init;
+	/* Optional streaming mode: timer pacing the sensor data commands, its
+	 * interrupt controller, line and platform specific handle */
+	struct no_os_timer_desc		*pace_timer;
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	uint32_t			irq_id;
+	void				*irq_handle;
+	/* Optional running timer, timestamps the samples */
+	struct no_os_timer_desc		*ts_timer;
+	/* Samples buffered by the streaming mode, power of 2. 0 for the
+	 * default */
+	uint32_t			ring_depth;
 };
 
 /******************************************************************************/
@@ -106,4 +171,15 @@ float adxrs453_get_rate(struct adxrs453_dev *dev);
 /*! Reads the temperature sensor data and converts it to degrees Celsius. */
 float adxrs453_get_temperature(struct adxrs453_dev *dev);
 
+/*! Starts sending a sensor data command on each pace timer period. */
+int32_t adxrs453_stream_start(struct adxrs453_dev *dev);
+
+/*! Stops the streaming mode. */
+int32_t adxrs453_stream_stop(struct adxrs453_dev *dev);
+
+/*! Takes the samples read by the streaming mode and checks them. */
+int32_t adxrs453_stream_read(struct adxrs453_dev *dev,
+			     struct adxrs453_sample *samples,
+			     uint32_t nb_samples);
+
 #endif // __ADXRS453_H__
@@ -41,9 +41,12 @@
 /***************************** Include Files *********************************/
 /*****************************************************************************/
 #include <stdlib.h>
+#include <stdbool.h>
 #include "ad5933.h"
 #include <math.h>
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
 
 /******************************************************************************/
 /************************** Constants Definitions *****************************/
@@ -74,7 +77,7 @@ int32_t ad5933_init(struct ad5933_dev **device,
 	struct ad5933_dev *dev;
 	int32_t status;
 
-	dev = (struct ad5933_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad5933_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
@@ -326,6 +329,11 @@ void ad5933_config_sweep(struct ad5933_dev *dev,
 				  AD5933_REG_INC_NUM,
 				  inc_num_reg,
 				  2);
+
+	/* Store the sweep, ad5933_sweep() times the points from it. */
+	dev->start_freq = start_freq;
+	dev->inc_freq = inc_freq;
+	dev->inc_num = inc_num_reg;
 }
 
 /***************************************************************************//**
@@ -489,4 +497,202 @@ void ad5933_set_settling_time(struct ad5933_dev *dev,
 				  AD5933_REG_SETTLING_CYCLES,
 				  number_cycles | (multiplier << 9),
 				  2);
+
+	dev->settling_cycles = number_cycles & 0x1FF;
+	dev->settling_mult = multiplier;
+}
+
+/***************************************************************************//**
+ * @brief Writes the function field of the control register.
+ *
+ * @param dev           - The device structure.
+ * @param freq_function - Function to be executed.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int32_t ad5933_write_function(struct ad5933_dev *dev,
+				     uint8_t freq_function)
+{
+	uint8_t write_data[2];
+
+	write_data[0] = AD5933_REG_CONTROL_HB;
+	write_data[1] = AD5933_CONTROL_FUNCTION(freq_function) |
+			AD5933_CONTROL_RANGE(dev->current_range) |
+			AD5933_CONTROL_PGA_GAIN(dev->current_gain);
+
+	return no_os_i2c_write(dev->i2c_desc, write_data, 2, 1);
+}
+
+/***************************************************************************//**
+ * @brief Reads consecutive registers with a single block read command.
+ *
+ * @param dev              - The device structure.
+ * @param register_address - Address of the first register.
+ * @param data             - Buffer for the register bytes.
+ * @param bytes_number     - Number of bytes.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int32_t ad5933_block_read(struct ad5933_dev *dev,
+				 uint8_t register_address,
+				 uint8_t *data,
+				 uint8_t bytes_number)
+{
+	uint8_t write_data[2];
+	int32_t ret;
+
+	write_data[0] = AD5933_ADDR_POINTER;
+	write_data[1] = register_address;
+	ret = no_os_i2c_write(dev->i2c_desc, write_data, 2, 1);
+	if (ret)
+		return ret;
+
+	write_data[0] = AD5933_BLOCK_READ;
+	write_data[1] = bytes_number;
+	ret = no_os_i2c_write(dev->i2c_desc, write_data, 2, 0);
+	if (ret)
+		return ret;
+
+	return no_os_i2c_read(dev->i2c_desc, data, bytes_number, 1);
+}
+
+/***************************************************************************//**
+ * @brief Computes the time needed to settle and convert one sweep point.
+ *
+ * @param dev  - The device structure.
+ * @param freq - Output frequency of the point in Hz.
+ *
+ * @return Time in microseconds.
+*******************************************************************************/
+static uint32_t ad5933_point_time_us(struct ad5933_dev *dev, uint32_t freq)
+{
+	uint64_t settle_us = 0;
+	uint32_t mult;
+
+	mult = dev->settling_mult == AD5933_SETTLING_X4 ? 4 :
+	       dev->settling_mult + 1;
+	if (freq)
+		settle_us = (uint64_t)dev->settling_cycles * mult * 1000000 / freq;
+
+	return settle_us + (uint64_t)AD5933_DFT_SAMPLES * AD5933_ADC_CLK_DIV *
+	       1000000 / dev->current_sys_clk;
+}
+
+/***************************************************************************//**
+ * @brief Waits for the DFT of the current point to complete.
+ *
+ * @param dev     - The device structure.
+ * @param wait_us - Time after which the data is expected to be valid.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int32_t ad5933_wait_data_valid(struct ad5933_dev *dev, uint32_t wait_us)
+{
+	uint32_t tries = AD5933_SWEEP_POLL_MAX;
+	uint8_t status;
+	int32_t ret;
+
+	if (wait_us)
+		no_os_udelay(wait_us);
+
+	while (tries--) {
+		ret = ad5933_block_read(dev, AD5933_REG_STATUS, &status, 1);
+		if (ret)
+			return ret;
+		if (status & AD5933_STAT_DATA_VALID)
+			return 0;
+	}
+
+	return -ETIMEDOUT;
+}
+
+/***************************************************************************//**
+ * @brief Runs the sweep set by ad5933_config_sweep() and returns the real and
+ *        imaginary data of all the points.
+ *
+ * Instead of polling the status from the start of each point, the driver
+ * waits for the settling and DFT time of the point and only then checks the
+ * status. When the time to convert a point is longer than the I2C readout,
+ * the next increment is issued as soon as a point is valid and the data of
+ * that point is read while the next one settles. The data registers only
+ * change at the end of the next DFT.
+ *
+ * @param dev       - The device structure.
+ * @param points    - Buffer for the sweep points.
+ * @param nb_points - Number of points, inc_num + 1.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad5933_sweep(struct ad5933_dev *dev,
+		     struct ad5933_sweep_point *points,
+		     uint16_t nb_points)
+{
+	uint32_t read_us, point_us, freq;
+	uint8_t data[4];
+	bool pipelined;
+	uint16_t i;
+	int32_t ret;
+
+	if (!dev || !points || nb_points != dev->inc_num + 1)
+		return -EINVAL;
+
+	/*
+	 * Status, block read and increment transfers, 9 bits per byte plus
+	 * margin for the start and stop conditions.
+	 */
+	read_us = 0;
+	if (dev->i2c_desc->max_speed_hz)
+		read_us = 2 * 18 * 9 * 1000000 / dev->i2c_desc->max_speed_hz;
+
+	/* The last point settles the fastest. */
+	freq = dev->start_freq + dev->inc_num * dev->inc_freq;
+	pipelined = read_us && ad5933_point_time_us(dev, freq) > read_us;
+
+	ret = ad5933_write_function(dev, AD5933_FUNCTION_STANDBY);
+	if (ret)
+		return ret;
+	ad5933_reset(dev);
+	ret = ad5933_write_function(dev, AD5933_FUNCTION_INIT_START_FREQ);
+	if (ret)
+		return ret;
+	ret = ad5933_write_function(dev, AD5933_FUNCTION_START_SWEEP);
+	if (ret)
+		return ret;
+
+	point_us = ad5933_point_time_us(dev, dev->start_freq);
+	for (i = 0; i < nb_points; i++) {
+		ret = ad5933_wait_data_valid(dev, point_us);
+		if (ret)
+			return ret;
+
+		freq = dev->start_freq + (i + 1) * dev->inc_freq;
+		point_us = ad5933_point_time_us(dev, freq);
+
+		if (pipelined && i + 1 < nb_points) {
+			ret = ad5933_write_function(dev, AD5933_FUNCTION_INC_FREQ);
+			if (ret)
+				return ret;
+		}
+
+		ret = ad5933_block_read(dev, AD5933_REG_REAL_DATA, data, 4);
+		if (ret)
+			return ret;
+
+		points[i].real_data = (short)(data[0] << 8 | data[1]);
+		points[i].imag_data = (short)(data[2] << 8 | data[3]);
+
+		if (i + 1 == nb_points)
+			break;
+
+		if (pipelined) {
+			/* The readout already covered part of the settling. */
+			point_us = point_us > read_us ? point_us - read_us : 0;
+		} else {
+			ret = ad5933_write_function(dev, AD5933_FUNCTION_INC_FREQ);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return ad5933_write_function(dev, AD5933_FUNCTION_STANDBY);
 }
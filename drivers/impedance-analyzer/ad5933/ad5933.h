@@ -115,6 +115,9 @@
 /* AD5933 Specifications */
 #define AD5933_INTERNAL_SYS_CLK     16000000ul      // 16MHz
 #define AD5933_MAX_INC_NUM          511             // Maximum increment number
+#define AD5933_DFT_SAMPLES          1024            // Samples per DFT
+#define AD5933_ADC_CLK_DIV          16              // ADC rate is MCLK / 16
+#define AD5933_SWEEP_POLL_MAX       1000            // Status reads per point
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -128,6 +131,17 @@ struct ad5933_dev {
 	uint8_t current_clock_source;
 	uint8_t current_gain;
 	uint8_t current_range;
+	/* Sweep Settings */
+	uint32_t start_freq;
+	uint32_t inc_freq;
+	uint16_t inc_num;
+	uint16_t settling_cycles;
+	uint8_t settling_mult;
+};
+
+struct ad5933_sweep_point {
+	short real_data;
+	short imag_data;
 };
 
 struct ad5933_init_param {
@@ -208,4 +222,9 @@ void ad5933_set_settling_time(struct ad5933_dev *dev,
 			      uint8_t mulitplier,
 			      uint16_t number_cycles);
 
+/*! Runs the configured sweep and returns the data of all the points. */
+int32_t ad5933_sweep(struct ad5933_dev *dev,
+		     struct ad5933_sweep_point *points,
+		     uint16_t nb_points);
+
 #endif /* __AD5933_H__ */
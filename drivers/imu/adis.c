@@ -69,6 +69,9 @@
 #define ADIS_MSG_SIZE_32_BIT_BURST 	32 /* in bytes */
 #define ADIS_CHECKSUM_SIZE		2  /* in bytes */
 #define ADIS_CHECKSUM_BUF_IDX		0
+#define ADIS_MSG_SIZE_16_BIT_BURST_FIFO	20 /* in bytes */
+#define ADIS_MSG_SIZE_32_BIT_BURST_FIFO	34 /* in bytes */
+#define ADIS_CHECKSUM_BUF_IDX_FIFO	2
 #define ADIS_SIGN_BIT_POS		15
 #define ADIS_DIAG_IDX_16_BIT_BURST	0
 #define ADIS_XGYRO_IDX_16_BIT_BURST	2
@@ -162,6 +165,8 @@ error_spi:
  */
 void adis_remove(struct adis_dev *adis)
 {
+	if (adis->stream)
+		adis_burst_stream_stop(adis);
 	if (adis->gpio_reset)
 		no_os_gpio_remove(adis->gpio_reset);
 	if (adis->spi_desc)
@@ -2561,6 +2566,257 @@ int adis_read_burst_data(struct adis_dev *adis, uint8_t buff_size,
 	return 0;
 }
 
+/**
+ * @brief DMA completion callback of a burst stream batch.
+ * @param ctx - The adis device.
+ */
+static void adis_burst_stream_done(void *ctx)
+{
+	struct adis_dev *adis = ctx;
+
+	adis->stream->wr++;
+	adis->stream->busy = false;
+}
+
+/**
+ * @brief Start batched burst capture into a ring.
+ *
+ * Each call to adis_burst_stream_trigger() reads batch_size burst frames in a
+ * single DMA transfer. On devices with a FIFO, the FIFO watermark is set to
+ * batch_size and routed to the data ready pin, so the trigger fires once per
+ * batch instead of once per sample. Devices without a FIFO only support a
+ * batch size of 1.
+ * @param adis       - The adis device.
+ * @param burst32    - True if 32-bit data is requested for accel and gyro.
+ * @param burst_sel  - 0 for accel/gyro data, 1 for delta angle/velocity data.
+ * @param batch_size - Number of burst frames captured on each trigger.
+ * @param ring       - Ring buffer, nb_batches * batch_size frames large. The
+ *		       frame size is msg_size + ADIS_READ_BURST_DATA_CMD_SIZE,
+ *		       see adis_burst_stream::stride.
+ * @param nb_batches - Number of batches in the ring, at least 2.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis_burst_stream_start(struct adis_dev *adis, bool burst32,
+			    uint8_t burst_sel, uint32_t batch_size,
+			    uint8_t *ring, uint32_t nb_batches)
+{
+	struct adis_burst_stream *stream;
+	bool has_fifo;
+	uint32_t i;
+	int ret;
+
+	if (!adis || !ring || !batch_size || nb_batches < 2 || adis->stream)
+		return -EINVAL;
+
+	has_fifo = adis->info->flags & ADIS_HAS_FIFO;
+	if (!has_fifo && batch_size > 1)
+		return -EINVAL;
+
+	if (!(adis->info->flags & ADIS_HAS_BURST_DELTA_DATA) && burst_sel)
+		return -EINVAL;
+
+	if (!(adis->info->flags & ADIS_HAS_BURST32) && burst32)
+		return -EINVAL;
+
+	if (adis->info->flags & ADIS_HAS_BURST32) {
+		if (adis->burst32 != burst32) {
+			ret = adis_write_burst32(adis, burst32);
+			if (ret)
+				return ret;
+		}
+		if (adis->burst_sel != burst_sel) {
+			ret = adis_write_burst_sel(adis, burst_sel);
+			if (ret)
+				return ret;
+		}
+	}
+
+	stream = no_os_calloc(1, sizeof(*stream));
+	if (!stream)
+		return -ENOMEM;
+
+	if (has_fifo) {
+		stream->msg_size = burst32 ? ADIS_MSG_SIZE_32_BIT_BURST_FIFO :
+				   ADIS_MSG_SIZE_16_BIT_BURST_FIFO;
+		/* Diag data not calculated in the checksum for FIFO devices. */
+		stream->checksum_idx = ADIS_CHECKSUM_BUF_IDX_FIFO;
+	} else if (adis->info->flags & ADIS_HAS_BURST32) {
+		stream->msg_size = burst32 ? ADIS_MSG_SIZE_32_BIT_BURST :
+				   ADIS_MSG_SIZE_16_BIT_BURST;
+		stream->checksum_idx = ADIS_CHECKSUM_BUF_IDX;
+	} else {
+		stream->msg_size = ADIS_MSG_SIZE_32_BIT_BURST;
+		stream->checksum_idx = ADIS_CHECKSUM_BUF_IDX;
+	}
+	stream->stride = stream->msg_size + ADIS_READ_BURST_DATA_CMD_SIZE;
+	stream->ring = ring;
+	stream->nb_batches = nb_batches;
+	stream->batch_size = batch_size;
+
+	stream->tx = no_os_calloc(stream->stride, sizeof(*stream->tx));
+	if (!stream->tx) {
+		ret = -ENOMEM;
+		goto free_stream;
+	}
+	stream->tx[0] = ADIS_READ_BURST_DATA_CMD_MSB;
+	stream->tx[1] = ADIS_READ_BURST_DATA_CMD_LSB;
+
+	stream->msgs = no_os_calloc(batch_size, sizeof(*stream->msgs));
+	if (!stream->msgs) {
+		ret = -ENOMEM;
+		goto free_tx;
+	}
+	for (i = 0; i < batch_size; i++) {
+		stream->msgs[i].tx_buff = stream->tx;
+		stream->msgs[i].bytes_number = stream->stride;
+		stream->msgs[i].cs_change = 1;
+		stream->msgs[i].cs_change_delay = adis->info->cs_change_delay;
+	}
+
+	if (has_fifo) {
+		ret = adis_cmd_fifo_flush(adis);
+		if (ret)
+			goto free_msgs;
+		ret = adis_write_fifo_wm_lvl(adis, batch_size);
+		if (ret)
+			goto free_msgs;
+		ret = adis_write_fifo_wm_int_en(adis, 1);
+		if (ret)
+			goto free_msgs;
+		ret = adis_write_fifo_en(adis, 1);
+		if (ret)
+			goto free_msgs;
+	}
+
+	adis->stream = stream;
+
+	return 0;
+
+free_msgs:
+	no_os_free(stream->msgs);
+free_tx:
+	no_os_free(stream->tx);
+free_stream:
+	no_os_free(stream);
+
+	return ret;
+}
+
+/**
+ * @brief Capture one batch of burst frames into the next free ring slot.
+ *
+ * Meant to be called from the data ready (or FIFO watermark) interrupt. The
+ * transfer runs by DMA, the call returns as soon as it is started.
+ * @param adis - The adis device.
+ * @return 0 in case of success, -EBUSY if the trigger was dropped because the
+ *	   ring is full or a batch is still in flight, error code otherwise.
+ */
+int adis_burst_stream_trigger(struct adis_dev *adis)
+{
+	struct adis_burst_stream *stream;
+	uint8_t *slot;
+	uint32_t i;
+	int ret;
+
+	if (!adis || !adis->stream)
+		return -EINVAL;
+
+	stream = adis->stream;
+	if (stream->busy || stream->wr - stream->rd >= stream->nb_batches) {
+		stream->overruns++;
+		return -EBUSY;
+	}
+
+	slot = stream->ring + (stream->wr % stream->nb_batches) *
+	       stream->batch_size * stream->stride;
+	for (i = 0; i < stream->batch_size; i++)
+		stream->msgs[i].rx_buff = slot + i * stream->stride;
+
+	stream->busy = true;
+	ret = no_os_spi_transfer_dma_async(adis->spi_desc, stream->msgs,
+					   stream->batch_size,
+					   adis_burst_stream_done, adis);
+	if (ret)
+		stream->busy = false;
+
+	return ret;
+}
+
+/**
+ * @brief Get the oldest captured batch and validate the checksum of all its
+ *	  frames. The batch stays valid until the next call.
+ * @param adis  - The adis device.
+ * @param batch - Start of the batch. Frame i payload starts at
+ *		  batch + i * stride + ADIS_READ_BURST_DATA_CMD_SIZE.
+ * @return 0 in case of success, -EAGAIN if no batch is available, -EBADMSG if
+ *	   at least one frame of the batch failed checksum validation.
+ */
+int adis_burst_stream_read(struct adis_dev *adis, uint8_t **batch)
+{
+	struct adis_burst_stream *stream;
+	uint32_t i, errors = 0;
+	uint8_t *frame;
+
+	if (!adis || !adis->stream || !batch)
+		return -EINVAL;
+
+	stream = adis->stream;
+	if (stream->held) {
+		stream->rd++;
+		stream->held = false;
+	}
+
+	if (stream->wr == stream->rd)
+		return -EAGAIN;
+
+	*batch = stream->ring + (stream->rd % stream->nb_batches) *
+		 stream->batch_size * stream->stride;
+	stream->held = true;
+
+	for (i = 0; i < stream->batch_size; i++) {
+		frame = *batch + i * stream->stride + ADIS_READ_BURST_DATA_CMD_SIZE;
+		if (!adis_validate_checksum(frame, stream->msg_size,
+					    stream->checksum_idx))
+			errors++;
+	}
+
+	/* Diagnosis flags reflect the newest frame of the batch. */
+	adis_update_diag_flags(adis, frame[0]);
+
+	stream->checksum_errors += errors;
+	adis->diag_flags.checksum_err = errors != 0;
+
+	return errors ? -EBADMSG : 0;
+}
+
+/**
+ * @brief Stop batched burst capture and free its resources.
+ * @param adis - The adis device.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis_burst_stream_stop(struct adis_dev *adis)
+{
+	struct adis_burst_stream *stream;
+	uint32_t timeout = 10000;
+
+	if (!adis || !adis->stream)
+		return -EINVAL;
+
+	stream = adis->stream;
+	while (stream->busy && --timeout)
+		no_os_udelay(1);
+
+	if (adis->info->flags & ADIS_HAS_FIFO)
+		adis_write_fifo_wm_int_en(adis, 0);
+
+	adis->stream = NULL;
+	no_os_free(stream->msgs);
+	no_os_free(stream->tx);
+	no_os_free(stream);
+
+	return timeout ? 0 : -ETIMEDOUT;
+}
+
 /**
  * @brief Update external clock frequency.
  * @param adis     - The adis device.
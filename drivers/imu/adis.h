@@ -180,6 +180,41 @@ struct adis_scale_fractional_log2 {
 	uint32_t power;
 };
 
+/** @struct adis_burst_stream
+ *  @brief Batched burst capture state. Each batch holds batch_size burst
+ *  frames of stride bytes, frame payload starting after the burst command.
+ */
+struct adis_burst_stream {
+	/** Ring of nb_batches batches, provided by the user. */
+	uint8_t				*ring;
+	/** Number of batches in the ring. */
+	uint32_t			nb_batches;
+	/** Number of burst frames read on each trigger. */
+	uint32_t			batch_size;
+	/** Size of one frame in the ring, burst command included. */
+	uint32_t			stride;
+	/** Burst payload size, checksum included. */
+	uint8_t				msg_size;
+	/** First payload byte covered by the checksum. */
+	uint8_t				checksum_idx;
+	/** Burst command, replayed for every frame of a batch. */
+	uint8_t				*tx;
+	/** One SPI message per frame of a batch. */
+	struct no_os_spi_msg		*msgs;
+	/** Batches captured, incremented on DMA completion. */
+	volatile uint32_t		wr;
+	/** Batches consumed by adis_burst_stream_read(). */
+	uint32_t			rd;
+	/** Set while a batch transfer is in flight. */
+	volatile bool			busy;
+	/** Set while the last returned batch is held by the caller. */
+	bool				held;
+	/** Triggers dropped because the ring was full or a batch in flight. */
+	uint32_t			overruns;
+	/** Frames which failed checksum validation. */
+	uint32_t			checksum_errors;
+};
+
 /** @struct adis_dev
  *  @brief ADIS device descriptor structure
  */
@@ -210,6 +245,8 @@ struct adis_dev {
 	bool				burst32;
 	/** Burst data selection: 0 for accel/gyro data; 1 for delta angle/ delta velocity data. */
 	uint8_t				burst_sel;
+	/** Burst stream state, NULL if no stream is running. */
+	struct adis_burst_stream	*stream;
 };
 
 /** @struct adis_init_param
@@ -600,6 +637,20 @@ int adis_read_burst_data(struct adis_dev *adis, uint8_t buff_size,
 			 uint16_t *buff, bool burst32, uint8_t burst_sel,
 			 bool fifo_pop);
 
+/*! Start batched burst capture into a ring. */
+int adis_burst_stream_start(struct adis_dev *adis, bool burst32,
+			    uint8_t burst_sel, uint32_t batch_size,
+			    uint8_t *ring, uint32_t nb_batches);
+
+/*! Capture one batch, to be called from the data ready interrupt. */
+int adis_burst_stream_trigger(struct adis_dev *adis);
+
+/*! Get the oldest captured batch, after checksum validation. */
+int adis_burst_stream_read(struct adis_dev *adis, uint8_t **batch);
+
+/*! Stop batched burst capture. */
+int adis_burst_stream_stop(struct adis_dev *adis);
+
 /*! Update external clock frequency. */
 int adis_update_ext_clk_freq(struct adis_dev *adis, uint32_t clk_freq);
 
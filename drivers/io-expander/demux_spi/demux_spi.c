@@ -44,6 +44,7 @@
 #include "demux_spi.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -56,8 +57,11 @@
  */
 const struct no_os_spi_platform_ops demux_spi_platform_ops = {
 	.init = demux_spi_init,
+	.write_and_read = demux_spi_write_and_read,
+	.transfer = demux_spi_transfer,
+	.dma_transfer_sync = demux_spi_transfer_dma_sync,
+	.dma_transfer_async = demux_spi_transfer_dma_async,
 	.remove = demux_spi_remove,
-	.write_and_read = demux_spi_write_and_read
 };
 
 /**
@@ -72,7 +76,7 @@ int32_t demux_spi_init(struct no_os_spi_desc **desc,
 	int32_t ret;
 
 	struct no_os_spi_desc *descriptor;
-	struct no_os_spi_desc *spi_dev_desc;
+	struct demux_spi_desc *demux;
 	struct no_os_spi_init_param *spi_dev_param;
 
 	if (!param)
@@ -82,23 +86,33 @@ int32_t demux_spi_init(struct no_os_spi_desc **desc,
 	if (!descriptor)
 		return -1;
 
+	demux = (struct demux_spi_desc *)no_os_calloc(1, sizeof(*demux));
+	if (!demux)
+		goto error_desc;
+
 	descriptor->chip_select = param->chip_select;
 	descriptor->max_speed_hz = param->max_speed_hz;
 	descriptor->mode = param->mode;
 
 	spi_dev_param = param->extra;
 
-	ret = no_os_spi_init(&spi_dev_desc, spi_dev_param);
-	if (ret != 0) {
-		no_os_free(descriptor);
-		return -1;
-	}
+	ret = no_os_spi_init(&demux->spi, spi_dev_param);
+	if (ret != 0)
+		goto error_demux;
 
-	(descriptor->extra) = spi_dev_desc;
+	demux->select = CS_OFFSET | param->chip_select;
+	descriptor->extra = demux;
 
 	*desc = descriptor;
 
-	return ret;
+	return 0;
+
+error_demux:
+	no_os_free(demux);
+error_desc:
+	no_os_free(descriptor);
+
+	return -1;
 }
 
 /**
@@ -108,19 +122,83 @@ int32_t demux_spi_init(struct no_os_spi_desc **desc,
  */
 int32_t demux_spi_remove(struct no_os_spi_desc *desc)
 {
+	struct demux_spi_desc *demux;
+
 	if (!desc)
 		return -1;
 
-	if (no_os_spi_remove(desc->extra))
+	demux = desc->extra;
+	if (no_os_spi_remove(demux->spi))
 		return -1;
 
+	no_os_free(demux->msgs);
+	no_os_free(demux);
 	no_os_free(desc);
 
 	return 0;
 }
 
+/**
+ * @brief Insert the select byte at the start of each chip select frame of a
+ * list of messages. The result is kept in the demux descriptor, valid until
+ * the next call.
+ * @param demux - The demux descriptor.
+ * @param msgs - The messages of the device.
+ * @param len - Number of messages.
+ * @param nb - Number of messages of the result.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t demux_spi_frame(struct demux_spi_desc *demux,
+			       struct no_os_spi_msg *msgs, uint32_t len,
+			       uint32_t *nb)
+{
+	struct no_os_spi_msg *framed;
+	uint32_t i, n;
+	bool start;
+
+	if (!msgs || !len)
+		return -EINVAL;
+
+	n = len + 1;
+	for (i = 0; i + 1 < len; i++)
+		if (msgs[i].cs_change)
+			n++;
+
+	if (n > demux->nb_msgs) {
+		framed = no_os_calloc(n, sizeof(*framed));
+		if (!framed)
+			return -ENOMEM;
+		no_os_free(demux->msgs);
+		demux->msgs = framed;
+		demux->nb_msgs = n;
+	}
+
+	n = 0;
+	start = true;
+	for (i = 0; i < len; i++) {
+		if (start) {
+			demux->msgs[n] = (struct no_os_spi_msg) {
+				.tx_buff = &demux->select,
+				.bytes_number = 1,
+				.cs_delay_first = msgs[i].cs_delay_first,
+			};
+			n++;
+		}
+		demux->msgs[n] = msgs[i];
+		demux->msgs[n].cs_delay_first = 0;
+		start = msgs[i].cs_change;
+		n++;
+	}
+	*nb = n;
+
+	return 0;
+}
+
 /**
  * @brief Write and read data to/from SPI demux layer.
+ * The select byte and the data are sent as one chip select frame, in place,
+ * when the controller supports transfer(). Otherwise they are copied to a
+ * single buffer.
  * @param desc - The SPI descriptor.
  * @param data - The buffer with the transmitted/received data.
  * @param bytes_number - Number of bytes to write/read.
@@ -129,23 +207,37 @@ int32_t demux_spi_remove(struct no_os_spi_desc *desc)
 int32_t demux_spi_write_and_read(struct no_os_spi_desc *desc, uint8_t *data,
 				 uint16_t bytes_number)
 {
+	struct demux_spi_desc *demux;
+	struct no_os_spi_desc *spi_dev;
 	int32_t ret;
-	uint8_t cs;
 	uint8_t *buff;
 
-	struct no_os_spi_desc *spi_dev;
-
 	if (!desc)
 		return -1;
 
+	demux = desc->extra;
+	spi_dev = demux->spi;
+
+	if (spi_dev->platform_ops->transfer) {
+		struct no_os_spi_msg msgs[] = {
+			{
+				.tx_buff = &demux->select,
+				.bytes_number = 1,
+			}, {
+				.tx_buff = data,
+				.rx_buff = data,
+				.bytes_number = bytes_number,
+			},
+		};
+
+		return no_os_spi_transfer(spi_dev, msgs, NO_OS_ARRAY_SIZE(msgs));
+	}
+
 	buff = no_os_malloc(sizeof(*buff) * (bytes_number+1));
 	if (!buff)
 		return -1;
 
-	spi_dev = desc->extra;
-	cs = CS_OFFSET | desc->chip_select;
-
-	buff[0] = cs;
+	buff[0] = demux->select;
 	memcpy((buff+1), data, bytes_number);
 
 	ret = no_os_spi_write_and_read(spi_dev, buff, bytes_number+1);
@@ -157,3 +249,91 @@ int32_t demux_spi_write_and_read(struct no_os_spi_desc *desc, uint8_t *data,
 	return ret;
 }
 
+/**
+ * @brief Transfer a list of messages through the demux, the select byte is
+ * sent at the start of each chip select frame.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t demux_spi_transfer(struct no_os_spi_desc *desc,
+			   struct no_os_spi_msg *msgs, uint32_t len)
+{
+	struct demux_spi_desc *demux;
+	uint32_t nb;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	demux = desc->extra;
+	ret = demux_spi_frame(demux, msgs, len, &nb);
+	if (ret)
+		return ret;
+
+	return no_os_spi_transfer(demux->spi, demux->msgs, nb);
+}
+
+/**
+ * @brief Transfer a list of messages through the demux by DMA, if the
+ * controller supports it, otherwise with its transfer().
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t demux_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
+				    struct no_os_spi_msg *msgs, uint32_t len)
+{
+	struct demux_spi_desc *demux;
+	uint32_t nb;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	demux = desc->extra;
+	ret = demux_spi_frame(demux, msgs, len, &nb);
+	if (ret)
+		return ret;
+
+	if (!demux->spi->platform_ops->dma_transfer_sync)
+		return no_os_spi_transfer(demux->spi, demux->msgs, nb);
+
+	return no_os_spi_transfer_dma_sync(demux->spi, demux->msgs, nb);
+}
+
+/**
+ * @brief Start a DMA transfer through the demux and return, if the controller
+ * supports it. Requests queued with no_os_spi_submit() on a demux device are
+ * served this way, or by demux_spi_transfer() when it returns -ENOSYS.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages, valid until the callback.
+ * @param len - Number of messages.
+ * @param callback - Invoked once the transfer is done.
+ * @param ctx - Parameter of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t demux_spi_transfer_dma_async(struct no_os_spi_desc *desc,
+				     struct no_os_spi_msg *msgs, uint32_t len,
+				     void (*callback)(void *), void *ctx)
+{
+	struct demux_spi_desc *demux;
+	uint32_t nb;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	demux = desc->extra;
+	if (!demux->spi->platform_ops->dma_transfer_async)
+		return -ENOSYS;
+
+	ret = demux_spi_frame(demux, msgs, len, &nb);
+	if (ret)
+		return ret;
+
+	return no_os_spi_transfer_dma_async(demux->spi, demux->msgs, nb,
+					    callback, ctx);
+}
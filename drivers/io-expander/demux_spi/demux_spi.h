@@ -56,6 +56,21 @@
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/**
+ * @struct demux_spi_desc
+ * @brief Demux specific SPI descriptor
+ */
+struct demux_spi_desc {
+	/** SPI descriptor of the controller in front of the demux */
+	struct no_os_spi_desc *spi;
+	/** Select byte sent at the start of each chip select frame */
+	uint8_t select;
+	/** Messages with the select bytes inserted, grown on demand */
+	struct no_os_spi_msg *msgs;
+	/** Number of entries of msgs */
+	uint32_t nb_msgs;
+};
+
 /**
  * @struct no_os_spi_desc
  * @brief Structure initialization with the platform specific SPI functions
@@ -77,4 +92,17 @@ int32_t demux_spi_remove(struct no_os_spi_desc *desc);
 int32_t demux_spi_write_and_read(struct no_os_spi_desc *desc, uint8_t *data,
 				 uint16_t bytes_number);
 
+/* Transfer a list of messages through the demux. */
+int32_t demux_spi_transfer(struct no_os_spi_desc *desc,
+			   struct no_os_spi_msg *msgs, uint32_t len);
+
+/* Transfer a list of messages through the demux by DMA. */
+int32_t demux_spi_transfer_dma_sync(struct no_os_spi_desc *desc,
+				    struct no_os_spi_msg *msgs, uint32_t len);
+
+/* Start a DMA transfer through the demux and return. */
+int32_t demux_spi_transfer_dma_async(struct no_os_spi_desc *desc,
+				     struct no_os_spi_msg *msgs, uint32_t len,
+				     void (*callback)(void *), void *ctx);
+
 #endif /* SRC_DEMUX_SPI_H_ */
@@ -815,3 +815,43 @@ int ltc4306_get_downstream_channel(struct ltc4306_dev *dev,
 
 	return 0;
 }
+
+/***************************************************************************//**
+ * @brief Connect the downstream buses of a mask and disconnect the others, in
+ * 		a single write of the FET bits. Used by no_os_i2c_mux, which calls
+ * 		it with the upstream bus locked. The connection requirement is
+ * 		left to the part: a bus that is not high fails to connect when
+ * 		conn_req is 0, which is reported in LTC4306_FAILED_CONN.
+ *
+ * @param mux - The multiplexer descriptor, its dev is the device structure.
+ * @param mask - Buses to connect, bit n being bus n + 1.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int ltc4306_i2c_mux_select(struct no_os_i2c_mux *mux, uint32_t mask)
+{
+	struct ltc4306_dev *dev = mux->dev;
+	uint8_t buf[2] = {LTC4306_CTRL_REG3, 0};
+	int ret;
+	int i;
+
+	if (mask & ~NO_OS_GENMASK(LTC4306_MAX_CHANNEL_INDEX - 1, 0))
+		return -EINVAL;
+
+	for (i = 0; i < LTC4306_MAX_CHANNEL_INDEX; i++)
+		if (mask & NO_OS_BIT(i))
+			buf[1] |= LTC4306_FET_STATE(i + 1);
+
+	ret = no_os_i2c_mux_write(mux, buf, 2);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < LTC4306_MAX_CHANNEL_INDEX; i++)
+		dev->is_closed[i] = mask & NO_OS_BIT(i);
+
+	return 0;
+}
+
+const struct no_os_i2c_mux_ops ltc4306_i2c_mux_ops = {
+	.select = ltc4306_i2c_mux_select,
+};
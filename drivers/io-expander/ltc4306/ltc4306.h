@@ -45,6 +45,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "no_os_i2c.h"
+#include "no_os_i2c_mux.h"
 #include "no_os_util.h"
 
 /******************************************************************************/
@@ -135,6 +136,12 @@ struct ltc4306_init_param {
 	struct no_os_i2c_init_param	i2c_init;
 };
 
+/*
+ * no_os_i2c_mux operations, dev being the ltc4306_dev. Channel n of the
+ * multiplexer is downstream bus n + 1.
+ */
+extern const struct no_os_i2c_mux_ops ltc4306_i2c_mux_ops;
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
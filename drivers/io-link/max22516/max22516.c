@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include "max22516.h"
 #include "no_os_delay.h"
 #include "no_os_error.h"
@@ -883,3 +884,263 @@ int max22516_remove(struct max22516_dev *dev)
 
 	return ret;
 }
+
+/**
+ * @brief MAX22516 process data exchange completion.
+ * @param req - The SPI request of the exchange.
+ * @param ctx - The process data engine.
+ */
+static void max22516_pd_complete(struct no_os_spi_request *req, void *ctx)
+{
+	struct max22516_pd_engine *engine = ctx;
+
+	if (!req->status) {
+		engine->pdout_idx ^= 1;
+		engine->pdout_seq++;
+	}
+
+	engine->pdin_inflight = 0xFF;
+	engine->busy = false;
+
+	if (engine->cycle_done)
+		engine->cycle_done(engine->ctx, engine->int_frame[1], req->status);
+}
+
+/**
+ * @brief MAX22516 IRQ pin handler, queues one process data exchange.
+ *
+ * The exchange reads IOL_INT and the PDOUT FIFO and writes the preloaded
+ * PDIN frame followed by PDIN_DATA_RDY, all in a single SPI request.
+ * @param ctx - The process data engine.
+ */
+static void max22516_pd_irq(void *ctx)
+{
+	struct max22516_pd_engine *engine = ctx;
+	uint8_t *pdout, *pdin;
+	uint32_t n = 0;
+
+	if (engine->busy) {
+		engine->overruns++;
+		return;
+	}
+
+	engine->busy = true;
+
+	engine->int_frame[0] = MAX22516_SPI_READ_CMD | REG_IOL_INT;
+	engine->msgs[n].tx_buff = engine->int_frame;
+	engine->msgs[n].rx_buff = engine->int_frame;
+	engine->msgs[n].bytes_number = 2;
+	engine->msgs[n++].cs_change = 1;
+
+	if (engine->pd_out_len) {
+		pdout = engine->pdout_frame[engine->pdout_idx ^ 1];
+		pdout[0] = MAX22516_SPI_READ_CMD | REG_PDOUT_FIFO;
+		engine->msgs[n].tx_buff = pdout;
+		engine->msgs[n].rx_buff = pdout;
+		engine->msgs[n].bytes_number = engine->pd_out_len + 1;
+		engine->msgs[n++].cs_change = 1;
+	}
+
+	if (engine->pd_in_len) {
+		engine->pdin_inflight = engine->pdin_idx;
+		pdin = engine->pdin_frame[engine->pdin_inflight];
+		engine->msgs[n].tx_buff = pdin;
+		engine->msgs[n].rx_buff = engine->discard;
+		engine->msgs[n].bytes_number = engine->pd_in_len + 1;
+		engine->msgs[n++].cs_change = 1;
+
+		engine->msgs[n].tx_buff = engine->rdy_frame;
+		engine->msgs[n].rx_buff = engine->discard;
+		engine->msgs[n].bytes_number = 2;
+		engine->msgs[n++].cs_change = 1;
+	}
+
+	engine->req.len = n;
+
+	no_os_spi_submit(&engine->req);
+}
+
+/**
+ * @brief MAX22516 process data engine initialization.
+ *
+ * The exchange runs from the IRQ pin interrupt, so the PDIN data must be
+ * set with max22516_pd_in_set() ahead of the cycle that sends it.
+ * @param engine - The process data engine.
+ * @param dev - The device structure.
+ * @param param - The engine initialization parameters.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int max22516_pd_init(struct max22516_pd_engine **engine,
+		     struct max22516_dev *dev,
+		     const struct max22516_pd_init_param *param)
+{
+	struct max22516_pd_engine *e;
+	int ret;
+
+	if (!engine || !dev || !param || !param->irq_ctrl ||
+	    param->pd_in_len > MAX22516_PD_MAX_BYTES ||
+	    param->pd_out_len > MAX22516_PD_MAX_BYTES ||
+	    !(param->pd_in_len + param->pd_out_len))
+		return -EINVAL;
+
+	e = no_os_calloc(1, sizeof(*e));
+	if (!e)
+		return -ENOMEM;
+
+	e->dev = dev;
+	e->pd_in_len = param->pd_in_len;
+	e->pd_out_len = param->pd_out_len;
+	e->pdin_frame[0][0] = REG_PDIN_FIFO;
+	e->pdin_frame[1][0] = REG_PDIN_FIFO;
+	e->pdin_inflight = 0xFF;
+	e->rdy_frame[0] = REG_PDIN_DATA_RDY;
+	e->rdy_frame[1] = 1;
+	e->irq_ctrl = param->irq_ctrl;
+	e->irq_id = param->irq_id;
+	e->cycle_done = param->cycle_done;
+	e->ctx = param->ctx;
+
+	e->req.desc = dev->spi_desc;
+	e->req.msgs = e->msgs;
+	e->req.priority = param->priority;
+	e->req.complete = max22516_pd_complete;
+	e->req.ctx = e;
+
+	e->irq_cb.callback = max22516_pd_irq;
+	e->irq_cb.ctx = e;
+	e->irq_cb.event = NO_OS_EVT_GPIO;
+	e->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+	ret = no_os_irq_register_callback(e->irq_ctrl, e->irq_id, &e->irq_cb);
+	if (ret)
+		goto error_engine;
+
+	/* The IRQ pin is active low */
+	ret = no_os_irq_trigger_level_set(e->irq_ctrl, e->irq_id,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_irq;
+
+	*engine = e;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(e->irq_ctrl, e->irq_id, &e->irq_cb);
+error_engine:
+	no_os_free(e);
+
+	return ret;
+}
+
+/**
+ * @brief MAX22516 process data engine deallocation.
+ * @param engine - The process data engine.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int max22516_pd_remove(struct max22516_pd_engine *engine)
+{
+	int ret;
+
+	if (!engine)
+		return -EINVAL;
+
+	ret = no_os_irq_disable(engine->irq_ctrl, engine->irq_id);
+	if (ret)
+		return ret;
+
+	/* The request must not be freed while it is still queued */
+	if (engine->busy)
+		return -EBUSY;
+
+	ret = no_os_irq_unregister_callback(engine->irq_ctrl, engine->irq_id,
+					    &engine->irq_cb);
+	if (ret)
+		return ret;
+
+	no_os_free(engine);
+
+	return 0;
+}
+
+/**
+ * @brief MAX22516 start the process data exchange.
+ * @param engine - The process data engine.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int max22516_pd_start(struct max22516_pd_engine *engine)
+{
+	if (!engine)
+		return -EINVAL;
+
+	return no_os_irq_enable(engine->irq_ctrl, engine->irq_id);
+}
+
+/**
+ * @brief MAX22516 stop the process data exchange.
+ * @param engine - The process data engine.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int max22516_pd_stop(struct max22516_pd_engine *engine)
+{
+	if (!engine)
+		return -EINVAL;
+
+	return no_os_irq_disable(engine->irq_ctrl, engine->irq_id);
+}
+
+/**
+ * @brief MAX22516 set the PDIN data sent from the next cycle on.
+ *
+ * The data is written into the frame that is not being sent, which then
+ * becomes the one sent by the following exchanges.
+ * @param engine - The process data engine.
+ * @param data - pd_in_len bytes of process data.
+ * @return Returns 0 in case of success, -EBUSY if both frames are in use
+ * (retry after the current exchange) or negative error code otherwise.
+ */
+int max22516_pd_in_set(struct max22516_pd_engine *engine, const uint8_t *data)
+{
+	uint8_t idx;
+
+	if (!engine || !data || !engine->pd_in_len)
+		return -EINVAL;
+
+	idx = engine->pdin_idx ^ 1;
+	if (engine->pdin_inflight == idx)
+		return -EBUSY;
+
+	memcpy(&engine->pdin_frame[idx][1], data, engine->pd_in_len);
+	engine->pdin_idx = idx;
+
+	return 0;
+}
+
+/**
+ * @brief MAX22516 get the latest PDOUT data.
+ * @param engine - The process data engine.
+ * @param data - pd_out_len bytes of process data.
+ * @param seq - Sequence number of the data, may be NULL. It changes each
+ * time new data is received.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int max22516_pd_out_get(struct max22516_pd_engine *engine, uint8_t *data,
+			uint32_t *seq)
+{
+	uint32_t s;
+
+	if (!engine || !data || !engine->pd_out_len)
+		return -EINVAL;
+
+	/* Retry if an exchange completed during the copy */
+	do {
+		s = engine->pdout_seq;
+		memcpy(data, &engine->pdout_frame[engine->pdout_idx][1],
+		       engine->pd_out_len);
+	} while (s != engine->pdout_seq);
+
+	if (seq)
+		*seq = s;
+
+	return 0;
+}
@@ -48,6 +48,7 @@
 #include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_util.h"
 
 /******************************************************************************/
@@ -227,6 +228,7 @@
 #define MAX22516_SPI_DUMMY_DATA		0x00
 #define MAX22516_BUFF_SIZE_BYTES     	64
 #define MAX22516_SPI_READ_CMD		NO_OS_BIT(7)
+#define MAX22516_PD_MAX_BYTES		32
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -252,6 +254,80 @@ struct max22516_dev {
 	uint8_t comm_buff[MAX22516_BUFF_SIZE_BYTES];
 };
 
+/**
+ * @struct max22516_pd_init_param
+ * @brief MAX22516 process data engine initialization parameters.
+ */
+struct max22516_pd_init_param {
+	/** Number of PDIN bytes sent to the master each cycle */
+	uint8_t pd_in_len;
+	/** Number of PDOUT bytes received from the master each cycle */
+	uint8_t pd_out_len;
+	/** IRQ controller the IRQ pin is routed through */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** GPIO line of the IRQ pin */
+	uint32_t irq_id;
+	/** Priority of the exchange on the SPI bus queue */
+	uint8_t priority;
+	/** Called from interrupt context after each exchange, may be NULL */
+	void (*cycle_done)(void *ctx, uint8_t iol_int, int32_t status);
+	/** Parameter for the cycle_done callback */
+	void *ctx;
+};
+
+/**
+ * @struct max22516_pd_engine
+ * @brief MAX22516 process data engine.
+ *
+ * PDIN and PDOUT are double buffered: the application fills the PDIN frame
+ * that is not being sent and reads the PDOUT frame that is not being
+ * received, so the exchange never waits on the main loop.
+ */
+struct max22516_pd_engine {
+	/** MAX22516 device */
+	struct max22516_dev *dev;
+	/** Number of PDIN bytes */
+	uint8_t pd_in_len;
+	/** Number of PDOUT bytes */
+	uint8_t pd_out_len;
+	/** IOL_INT read frame */
+	uint8_t int_frame[2];
+	/** Preloaded PDIN_FIFO write frames */
+	uint8_t pdin_frame[2][MAX22516_PD_MAX_BYTES + 1];
+	/** PDIN frame sent on the next cycle */
+	volatile uint8_t pdin_idx;
+	/** PDIN frame being sent, 0xFF if none */
+	volatile uint8_t pdin_inflight;
+	/** PDOUT_FIFO read frames */
+	uint8_t pdout_frame[2][MAX22516_PD_MAX_BYTES + 1];
+	/** PDOUT frame holding the latest data */
+	volatile uint8_t pdout_idx;
+	/** Incremented each time new PDOUT data is available */
+	volatile uint32_t pdout_seq;
+	/** PDIN_DATA_RDY write frame */
+	uint8_t rdy_frame[2];
+	/** Receive buffer for the write only messages */
+	uint8_t discard[MAX22516_PD_MAX_BYTES + 1];
+	/** Messages of one exchange */
+	struct no_os_spi_msg msgs[4];
+	/** SPI bus request of one exchange */
+	struct no_os_spi_request req;
+	/** IRQ pin callback */
+	struct no_os_callback_desc irq_cb;
+	/** IRQ controller */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** GPIO line of the IRQ pin */
+	uint32_t irq_id;
+	/** Set while an exchange is queued or in progress */
+	volatile bool busy;
+	/** Number of IRQs dropped because an exchange was still running */
+	volatile uint32_t overruns;
+	/** Cycle done callback */
+	void (*cycle_done)(void *ctx, uint8_t iol_int, int32_t status);
+	/** Parameter for the cycle_done callback */
+	void *ctx;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -390,4 +466,25 @@ int max22516_init(struct max22516_dev **device,
 /* MAX22516 Resources Deallocation */
 int max22516_remove(struct max22516_dev *dev);
 
+/* MAX22516 process data engine initialization */
+int max22516_pd_init(struct max22516_pd_engine **engine,
+		     struct max22516_dev *dev,
+		     const struct max22516_pd_init_param *param);
+
+/* MAX22516 process data engine deallocation */
+int max22516_pd_remove(struct max22516_pd_engine *engine);
+
+/* MAX22516 start the process data exchange */
+int max22516_pd_start(struct max22516_pd_engine *engine);
+
+/* MAX22516 stop the process data exchange */
+int max22516_pd_stop(struct max22516_pd_engine *engine);
+
+/* MAX22516 set the PDIN data of the next cycles */
+int max22516_pd_in_set(struct max22516_pd_engine *engine, const uint8_t *data);
+
+/* MAX22516 get the latest PDOUT data */
+int max22516_pd_out_get(struct max22516_pd_engine *engine, uint8_t *data,
+			uint32_t *seq);
+
 #endif /* MAX22516_H_ */
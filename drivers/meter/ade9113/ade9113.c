@@ -51,8 +51,8 @@
 #include "no_os_crc16.h"
 #include "no_os_print_log.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ade9113_crc8);
-NO_OS_DECLARE_CRC16_TABLE(ade9113_crc16);
+static const uint8_t *ade9113_crc8;
+static const uint16_t *ade9113_crc16;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -212,6 +212,33 @@ static int ade9113_update_bits(struct ade9113_dev *dev, uint8_t reg_addr,
 	return ade9113_write(dev, reg_addr, data, ADE9113_S_OP);
 }
 
+/**
+ * @brief Store the last read waveforms in the capture ring.
+ * @param dev - The device structure.
+ */
+static void ade9113_capture_scan(struct ade9113_dev *dev)
+{
+	int32_t *scan;
+
+	if (!dev->fill && dev->count == ADE9113_CAPTURE_NB_BLOCKS - 1) {
+		/* Keep one block free for the reader */
+		dev->overruns++;
+		return;
+	}
+
+	scan = &dev->blocks[(dev->wr * dev->block_scans + dev->fill) *
+					 ADE9113_CAPTURE_NB_CHAN];
+	scan[0] = dev->i_wav;
+	scan[1] = dev->v1_wav;
+	scan[2] = dev->v2_wav;
+
+	if (++dev->fill == dev->block_scans) {
+		dev->fill = 0;
+		dev->wr = (dev->wr + 1) % ADE9113_CAPTURE_NB_BLOCKS;
+		dev->count++;
+	}
+}
+
 /**
  * @brief GPIO interrupt handler for data ready.
  * @param dev - The device structure.
@@ -232,6 +259,9 @@ static void ade9113_irq_handler(void *dev)
 	if (ret)
 		return;
 
+	if (desc->blocks)
+		ade9113_capture_scan(desc);
+
 	/* Reenable interrupt */
 	ret = no_os_irq_enable(desc->irq_ctrl,
 			       desc->gpio_rdy->number);
@@ -319,11 +349,13 @@ int ade9113_init(struct ade9113_dev **device,
 			goto error_gpio;
 	}
 
-	/* Create the CRC-8 lookup table for polynomial ADE9113_CRC8_POLY */
-	no_os_crc8_populate_msb(ade9113_crc8, ADE9113_CRC8_POLY);
-
-	/* Create the CRC-16 lookup table for polynomial ADE9113_CRC8_POLY */
-	no_os_crc16_populate_msb(ade9113_crc16, ADE9113_CRC16_POLY);
+	/* Get the shared CRC-8 and CRC-16 lookup tables */
+	ade9113_crc8 = no_os_crc8_get_table(ADE9113_CRC8_POLY);
+	ade9113_crc16 = no_os_crc16_get_table(ADE9113_CRC16_POLY);
+	if (!ade9113_crc8 || !ade9113_crc16) {
+		ret = -ENOMEM;
+		goto error_gpio;
+	}
 
 	/* CRC enabled by default */
 	dev->crc_en = 1;
@@ -397,6 +429,8 @@ int ade9113_remove(struct ade9113_dev *dev)
 {
 	int ret;
 
+	no_os_free(dev->blocks);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		return ret;
@@ -2309,3 +2343,139 @@ int ade9113_drdy_int_disable(struct ade9113_dev *dev)
 {
 	return no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
 }
+
+/**
+ * @brief Start capturing the waveforms into blocks of scans.
+ *
+ * Scans are stored by the driver's DRDY handler, so the capture only runs if
+ * no external drdy_callback was given at initialization.
+ * @param device - The device structure.
+ * @param block_scans - Scans in a block.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9113_stream_start(void *device, uint32_t block_scans)
+{
+	struct ade9113_dev *dev = device;
+	int32_t *blocks;
+	int ret;
+
+	if (!block_scans || dev->blocks)
+		return -EINVAL;
+
+	blocks = (int32_t *)no_os_calloc(ADE9113_CAPTURE_NB_BLOCKS * block_scans *
+					 ADE9113_CAPTURE_NB_CHAN, sizeof(*blocks));
+	if (!blocks)
+		return -ENOMEM;
+
+	ret = ade9113_drdy_int_disable(dev);
+	if (ret) {
+		no_os_free(blocks);
+		return ret;
+	}
+
+	dev->blocks = blocks;
+	dev->block_scans = block_scans;
+	dev->fill = 0;
+	dev->wr = 0;
+	dev->rd = 0;
+	dev->count = 0;
+	dev->overruns = 0;
+
+	return ade9113_drdy_int_enable(dev);
+}
+
+/**
+ * @brief Stop capturing the waveforms.
+ * @param device - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9113_stream_stop(void *device)
+{
+	struct ade9113_dev *dev = device;
+	int ret;
+
+	ret = ade9113_drdy_int_disable(dev);
+	if (ret)
+		return ret;
+
+	no_os_free(dev->blocks);
+	dev->blocks = NULL;
+
+	return ade9113_drdy_int_enable(dev);
+}
+
+/**
+ * @brief Get the oldest complete block of scans.
+ * @param device - The device structure.
+ * @param block - The block of interleaved I, V1, V2 scans.
+ * @return 0 in case of success, -EAGAIN if no block is ready.
+ */
+static int32_t ade9113_stream_get_block(void *device, void **block)
+{
+	struct ade9113_dev *dev = device;
+
+	if (!dev->count)
+		return -EAGAIN;
+
+	*block = &dev->blocks[dev->rd * dev->block_scans *
+					ADE9113_CAPTURE_NB_CHAN];
+
+	return 0;
+}
+
+/**
+ * @brief Give back the block returned by ade9113_stream_get_block().
+ * @param device - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9113_stream_release_block(void *device)
+{
+	struct ade9113_dev *dev = device;
+	int ret;
+
+	ret = ade9113_drdy_int_disable(dev);
+	if (ret)
+		return ret;
+
+	dev->rd = (dev->rd + 1) % ADE9113_CAPTURE_NB_BLOCKS;
+	dev->count--;
+
+	return ade9113_drdy_int_enable(dev);
+}
+
+/**
+ * @brief Get the number of scans dropped since start.
+ * @param device - The device structure.
+ * @param overruns - Number of dropped scans.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9113_stream_get_overruns(void *device, uint32_t *overruns)
+{
+	struct ade9113_dev *dev = device;
+
+	*overruns = dev->overruns;
+
+	return 0;
+}
+
+const struct no_os_ain_stream_ops ade9113_stream_ops = {
+	.start = ade9113_stream_start,
+	.stop = ade9113_stream_stop,
+	.get_block = ade9113_stream_get_block,
+	.release_block = ade9113_stream_release_block,
+	.get_overruns = ade9113_stream_get_overruns,
+};
+
+/**
+ * @brief Describe the captured blocks for a no_os_ain stream.
+ * @param format - Sample layout of the blocks.
+ */
+void ade9113_get_stream_format(struct no_os_ain_stream_format *format)
+{
+	format->nb_samples = ADE9113_CAPTURE_NB_CHAN;
+	format->realbits = 24;
+	format->storagebits = 32;
+	format->shift = 0;
+	format->is_signed = true;
+	format->is_big_endian = false;
+}
@@ -49,6 +49,7 @@
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
 #include "no_os_irq.h"
+#include "no_os_ain.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -218,6 +219,10 @@
 /* Nominal reference voltage */
 #define ADE9113_VREF				(883883)
 
+/* Capture ring: I, V1 and V2 waveforms per scan */
+#define ADE9113_CAPTURE_NB_CHAN			3
+#define ADE9113_CAPTURE_NB_BLOCKS		3
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -373,8 +378,25 @@ struct ade9113_dev {
 	struct no_os_irq_ctrl_desc 	*irq_ctrl;
 	/** IRQ callback used to handle interrupt routine for GPIO RDY */
 	struct no_os_callback_desc	irq_cb;
+	/** Capture ring of ADE9113_CAPTURE_NB_BLOCKS blocks, NULL if stopped */
+	int32_t				*blocks;
+	/** Scans in a capture block */
+	uint32_t			block_scans;
+	/** Scans already stored in the block being filled */
+	uint32_t			fill;
+	/** Block being filled */
+	uint32_t			wr;
+	/** Oldest complete block */
+	uint32_t			rd;
+	/** Complete blocks in the ring */
+	volatile uint32_t		count;
+	/** Scans dropped because the ring was full */
+	volatile uint32_t		overruns;
 };
 
+/** Waveform capture block producer, fed from the driver's DRDY handler */
+extern const struct no_os_ain_stream_ops ade9113_stream_ops;
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -782,4 +804,7 @@ int ade9113_drdy_int_enable(struct ade9113_dev *dev);
 /* DRDY inerrupt disable. */
 int ade9113_drdy_int_disable(struct ade9113_dev *dev);
 
+/* Describe the captured blocks for a no_os_ain stream. */
+void ade9113_get_stream_format(struct no_os_ain_stream_format *format);
+
 #endif // __ADE9113_H__
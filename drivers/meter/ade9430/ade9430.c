@@ -42,6 +42,7 @@
 /******************************************************************************/
 #include <stdlib.h>
 #include <errno.h>
+#include <math.h>
 #include "ade9430.h"
 #include "no_os_delay.h"
 #include "no_os_units.h"
@@ -350,6 +351,12 @@ int ade9430_remove(struct ade9430_dev *dev)
 {
 	int ret;
 
+	if (dev->wfb) {
+		ret = ade9430_wfb_remove(dev);
+		if (ret)
+			return ret;
+	}
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		return ret;
@@ -358,3 +365,422 @@ int ade9430_remove(struct ade9430_dev *dev)
 
 	return 0;
 }
+
+/**
+ * @brief Page full interrupt handler, reads the filled half of the waveform
+ * 	  buffer in one burst and stores its scans in the capture ring.
+ * @param context - The device structure.
+ */
+static void ade9430_wfb_irq_handler(void *context)
+{
+	struct ade9430_dev *dev = context;
+	struct ade9430_wfb *wfb = dev->wfb;
+	uint32_t status, trg_stat, set, c;
+	uint16_t addr;
+	uint8_t *word;
+	int32_t *scan;
+	int ret;
+
+	ret = ade9430_read(dev, ADE9430_REG_STATUS0, &status);
+	if (ret || !(status & ADE9430_STATUS0_PAGE_FULL))
+		return;
+
+	ret = ade9430_write(dev, ADE9430_REG_STATUS0, ADE9430_STATUS0_PAGE_FULL);
+	if (ret)
+		return;
+
+	ret = ade9430_read(dev, ADE9430_REG_WFB_TRG_STAT, &trg_stat);
+	if (ret)
+		return;
+
+	/* Pages 7 and 15 raise the interrupt, read the half that was filled */
+	addr = ADE9430_WFB_ADDR;
+	if (no_os_field_get(ADE9430_WFB_LAST_PAGE, trg_stat) >=
+	    ADE9430_WFB_NB_PAGES / 2)
+		addr += ADE9430_WFB_HALF_WORDS;
+
+	memset(wfb->raw, 0, 2 + ADE9430_WFB_HALF_WORDS * 4);
+	wfb->raw[0] = addr >> 4;
+	wfb->raw[1] = ADE9430_SPI_READ | addr << 4;
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, wfb->raw,
+				       2 + ADE9430_WFB_HALF_WORDS * 4);
+	if (ret)
+		return;
+
+	for (set = 0; set < ADE9430_WFB_HALF_SETS; set++) {
+		if (!wfb->fill && wfb->count == ADE9430_WFB_NB_BLOCKS - 1) {
+			/* Keep one block free for the reader, drop the rest */
+			wfb->overruns++;
+			return;
+		}
+
+		word = &wfb->raw[2 + set * ADE9430_WFB_SET_WORDS * 4];
+		scan = &wfb->blocks[(wfb->wr * wfb->block_scans + wfb->fill) *
+						 ADE9430_WFB_NB_CHAN];
+		for (c = 0; c < ADE9430_WFB_NB_CHAN; c++)
+			scan[c] = (int32_t)no_os_get_unaligned_be32(&word[c * 4]);
+
+		if (++wfb->fill == wfb->block_scans) {
+			wfb->fill = 0;
+			wfb->wr = (wfb->wr + 1) % ADE9430_WFB_NB_BLOCKS;
+			wfb->count++;
+		}
+	}
+}
+
+/**
+ * @brief Initialize the waveform buffer capture.
+ * @param dev - The device structure.
+ * @param init_param - The waveform capture parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_init(struct ade9430_dev *dev,
+		     const struct ade9430_wfb_init_param *init_param)
+{
+	struct ade9430_wfb *wfb;
+	int ret;
+
+	if (!dev || !init_param || !init_param->irq_ctrl || dev->wfb)
+		return -EINVAL;
+
+	switch (init_param->src) {
+	case ADE9430_WF_SRC_SINC4:
+	case ADE9430_WF_SRC_SINC4_IIR_LPF:
+	case ADE9430_WF_SRC_DSP:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	wfb = (struct ade9430_wfb *)no_os_calloc(1, sizeof(*wfb));
+	if (!wfb)
+		return -ENOMEM;
+
+	wfb->raw = (uint8_t *)no_os_calloc(2 + ADE9430_WFB_HALF_WORDS * 4,
+					   sizeof(*wfb->raw));
+	if (!wfb->raw) {
+		ret = -ENOMEM;
+		goto error_wfb;
+	}
+
+	wfb->irq_ctrl = init_param->irq_ctrl;
+	wfb->irq_id = init_param->irq_id;
+	wfb->src = init_param->src;
+	wfb->sample_rate = init_param->src == ADE9430_WF_SRC_SINC4 ? 32000 : 8000;
+
+	wfb->irq_cb.callback = ade9430_wfb_irq_handler;
+	wfb->irq_cb.ctx = dev;
+	wfb->irq_cb.event = NO_OS_EVT_GPIO;
+	wfb->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+	ret = no_os_irq_register_callback(wfb->irq_ctrl, wfb->irq_id,
+					  &wfb->irq_cb);
+	if (ret)
+		goto error_raw;
+
+	ret = no_os_irq_trigger_level_set(wfb->irq_ctrl, wfb->irq_id,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_cb;
+
+	dev->wfb = wfb;
+
+	return 0;
+
+error_cb:
+	no_os_irq_unregister_callback(wfb->irq_ctrl, wfb->irq_id, &wfb->irq_cb);
+error_raw:
+	no_os_free(wfb->raw);
+error_wfb:
+	no_os_free(wfb);
+
+	return ret;
+}
+
+/**
+ * @brief Start the waveform capture.
+ * @param device - The device structure.
+ * @param block_scans - Scans in a block.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9430_wfb_start(void *device, uint32_t block_scans)
+{
+	struct ade9430_dev *dev = device;
+	struct ade9430_wfb *wfb = dev->wfb;
+	uint32_t cfg;
+	int ret;
+
+	if (!wfb || !block_scans)
+		return -EINVAL;
+
+	wfb->blocks = (int32_t *)no_os_calloc(ADE9430_WFB_NB_BLOCKS * block_scans *
+					      ADE9430_WFB_NB_CHAN,
+					      sizeof(*wfb->blocks));
+	if (!wfb->blocks)
+		return -ENOMEM;
+
+	wfb->block_scans = block_scans;
+	wfb->fill = 0;
+	wfb->wr = 0;
+	wfb->rd = 0;
+	wfb->count = 0;
+	wfb->overruns = 0;
+
+	/* Fixed data rate, all channels, continuous fill with no trigger */
+	cfg = no_os_field_prep(ADE9430_WF_IN_EN, 1) |
+	      no_os_field_prep(ADE9430_WF_SRC, wfb->src) |
+	      no_os_field_prep(ADE9430_WF_MODE, ADE9430_WF_MODE_CONT_STOP_TRIG) |
+	      no_os_field_prep(ADE9430_WF_CAP_SEL, 1);
+	ret = ade9430_write(dev, ADE9430_REG_WFB_CFG, cfg);
+	if (ret)
+		goto error;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_TRG_CFG, 0);
+	if (ret)
+		goto error;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_PG_IRQEN,
+			    NO_OS_BIT(ADE9430_WFB_NB_PAGES / 2 - 1) |
+			    NO_OS_BIT(ADE9430_WFB_NB_PAGES - 1));
+	if (ret)
+		goto error;
+
+	ret = ade9430_write(dev, ADE9430_REG_STATUS0, ADE9430_STATUS0_PAGE_FULL);
+	if (ret)
+		goto error;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_MASK0, ADE9430_MASK0_PAGE_FULL,
+				  ADE9430_MASK0_PAGE_FULL);
+	if (ret)
+		goto error;
+
+	ret = no_os_irq_enable(wfb->irq_ctrl, wfb->irq_id);
+	if (ret)
+		goto error;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_CFG,
+			    cfg | no_os_field_prep(ADE9430_WF_CAP_EN, 1));
+	if (ret) {
+		no_os_irq_disable(wfb->irq_ctrl, wfb->irq_id);
+		goto error;
+	}
+
+	return 0;
+
+error:
+	no_os_free(wfb->blocks);
+	wfb->blocks = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Stop the waveform capture.
+ * @param device - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9430_wfb_stop(void *device)
+{
+	struct ade9430_dev *dev = device;
+	struct ade9430_wfb *wfb = dev->wfb;
+	int ret;
+
+	if (!wfb || !wfb->blocks)
+		return -EINVAL;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_WFB_CFG, ADE9430_WF_CAP_EN, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_MASK0, ADE9430_MASK0_PAGE_FULL,
+				  0);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_disable(wfb->irq_ctrl, wfb->irq_id);
+	if (ret)
+		return ret;
+
+	no_os_free(wfb->blocks);
+	wfb->blocks = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Get the oldest complete block of scans.
+ * @param device - The device structure.
+ * @param block - The block of interleaved scans.
+ * @return 0 in case of success, -EAGAIN if no block is ready.
+ */
+static int32_t ade9430_wfb_get_block(void *device, void **block)
+{
+	struct ade9430_dev *dev = device;
+	struct ade9430_wfb *wfb = dev->wfb;
+
+	if (!wfb->count)
+		return -EAGAIN;
+
+	*block = &wfb->blocks[wfb->rd * wfb->block_scans * ADE9430_WFB_NB_CHAN];
+
+	return 0;
+}
+
+/**
+ * @brief Give back the block returned by ade9430_wfb_get_block().
+ * @param device - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9430_wfb_release_block(void *device)
+{
+	struct ade9430_dev *dev = device;
+	struct ade9430_wfb *wfb = dev->wfb;
+	int ret;
+
+	ret = no_os_irq_disable(wfb->irq_ctrl, wfb->irq_id);
+	if (ret)
+		return ret;
+
+	wfb->rd = (wfb->rd + 1) % ADE9430_WFB_NB_BLOCKS;
+	wfb->count--;
+
+	return no_os_irq_enable(wfb->irq_ctrl, wfb->irq_id);
+}
+
+/**
+ * @brief Get the number of half buffers dropped since start.
+ * @param device - The device structure.
+ * @param overruns - Number of dropped half buffers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ade9430_wfb_get_overruns(void *device, uint32_t *overruns)
+{
+	struct ade9430_dev *dev = device;
+
+	*overruns = dev->wfb->overruns;
+
+	return 0;
+}
+
+const struct no_os_ain_stream_ops ade9430_wfb_stream_ops = {
+	.start = ade9430_wfb_start,
+	.stop = ade9430_wfb_stop,
+	.get_block = ade9430_wfb_get_block,
+	.release_block = ade9430_wfb_release_block,
+	.get_overruns = ade9430_wfb_get_overruns,
+};
+
+/**
+ * @brief Describe the captured blocks for a no_os_ain stream.
+ * @param format - Sample layout of the blocks.
+ */
+void ade9430_wfb_get_format(struct no_os_ain_stream_format *format)
+{
+	format->nb_samples = ADE9430_WFB_NB_CHAN;
+	format->realbits = 32;
+	format->storagebits = 32;
+	format->shift = 0;
+	format->is_signed = true;
+	format->is_big_endian = false;
+}
+
+/**
+ * @brief Release the waveform buffer capture resources.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_remove(struct ade9430_dev *dev)
+{
+	struct ade9430_wfb *wfb;
+	int ret;
+
+	if (!dev || !dev->wfb)
+		return -EINVAL;
+
+	wfb = dev->wfb;
+	if (wfb->blocks) {
+		ret = ade9430_wfb_stop(dev);
+		if (ret)
+			return ret;
+	}
+
+	ret = no_os_irq_unregister_callback(wfb->irq_ctrl, wfb->irq_id,
+					    &wfb->irq_cb);
+	if (ret)
+		return ret;
+
+	no_os_free(wfb->raw);
+	no_os_free(wfb);
+	dev->wfb = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Extract one channel from captured scans.
+ * @param scans - Interleaved scans, as returned in the capture blocks.
+ * @param nb_scans - Number of scans.
+ * @param chan - Channel index, 0 to ADE9430_WFB_NB_CHAN - 1 in the order
+ * 		 IA, VA, IB, VB, IC, VC, IN.
+ * @param samples - Buffer of nb_scans samples of the channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_get_channel(const int32_t *scans, uint32_t nb_scans,
+			    uint8_t chan, int32_t *samples)
+{
+	uint32_t i;
+
+	if (!scans || !samples || chan >= ADE9430_WFB_NB_CHAN)
+		return -EINVAL;
+
+	for (i = 0; i < nb_scans; i++)
+		samples[i] = scans[i * ADE9430_WFB_NB_CHAN + chan];
+
+	return 0;
+}
+
+/**
+ * @brief Compute harmonic magnitudes of one channel of captured scans.
+ *
+ * Each harmonic is evaluated with a Goertzel filter, which is cheaper than a
+ * full FFT when only the first harmonics of the line are needed. Leakage is
+ * lowest when the scans cover an integer number of line cycles.
+ * @param dev - The device structure.
+ * @param scans - Interleaved scans, as returned in the capture blocks.
+ * @param nb_scans - Number of scans.
+ * @param chan - Channel index, see ade9430_wfb_get_channel().
+ * @param line_freq - Line frequency in Hz.
+ * @param nb_harmonics - Number of harmonics, the fundamental included.
+ * @param magnitude - Peak amplitude of each harmonic, in ADC codes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_harmonics(struct ade9430_dev *dev, const int32_t *scans,
+			  uint32_t nb_scans, uint8_t chan, float line_freq,
+			  uint8_t nb_harmonics, float *magnitude)
+{
+	float coeff, s0, s1, s2;
+	uint32_t i;
+	uint8_t h;
+
+	if (!dev || !dev->wfb || !scans || !magnitude || !nb_scans ||
+	    chan >= ADE9430_WFB_NB_CHAN || line_freq <= 0 ||
+	    nb_harmonics * line_freq >= dev->wfb->sample_rate / 2)
+		return -EINVAL;
+
+	for (h = 1; h <= nb_harmonics; h++) {
+		coeff = 2 * cosf(2 * M_PI * h * line_freq / dev->wfb->sample_rate);
+		s1 = 0;
+		s2 = 0;
+		for (i = 0; i < nb_scans; i++) {
+			s0 = scans[i * ADE9430_WFB_NB_CHAN + chan] + coeff * s1 - s2;
+			s2 = s1;
+			s1 = s0;
+		}
+
+		magnitude[h - 1] = 2 * sqrtf(s1 * s1 + s2 * s2 - coeff * s1 * s2) /
+				   nb_scans;
+	}
+
+	return 0;
+}
@@ -47,6 +47,8 @@
 #include <string.h>
 #include "no_os_util.h"
 #include "no_os_spi.h"
+#include "no_os_irq.h"
+#include "no_os_ain.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -766,7 +768,7 @@
 /* ADE9430_REG_WFB_CFG Bit Definition */
 #define ADE9430_WF_IN_EN		NO_OS_BIT(12)
 #define ADE9430_WF_SRC			NO_OS_GENMASK(9, 8)
-#define ADE9430_WF_MODE			NO_OS_BIT(7, 6)
+#define ADE9430_WF_MODE			NO_OS_GENMASK(7, 6)
 #define ADE9430_WF_CAP_SEL		NO_OS_BIT(5)
 #define ADE9430_WF_CAP_EN		NO_OS_BIT(4)
 #define ADE9430_BURST_CHAN		NO_OS_GENMASK(3, 0)
@@ -851,6 +853,22 @@
 #define ADE9430_V_RES_NV		13357ULL
 #define ADE9430_W_RES_UW		7203ULL
 
+/* Waveform Buffer Definitions */
+#define ADE9430_WFB_ADDR		0x0800
+#define ADE9430_WFB_NB_PAGES		16
+#define ADE9430_WFB_PAGE_WORDS		128
+/* Fixed data rate sample set: IA, VA, IB, VB, IC, VC, IN and a pad word */
+#define ADE9430_WFB_SET_WORDS		8
+#define ADE9430_WFB_NB_CHAN		7
+/* Half of the buffer is read on each page full interrupt */
+#define ADE9430_WFB_HALF_WORDS		(ADE9430_WFB_NB_PAGES / 2 * \
+					 ADE9430_WFB_PAGE_WORDS)
+#define ADE9430_WFB_HALF_SETS		(ADE9430_WFB_HALF_WORDS / \
+					 ADE9430_WFB_SET_WORDS)
+/* Blocks in the capture ring, one held, one ready and one being filled */
+#define ADE9430_WFB_NB_BLOCKS		3
+#define ADE9430_WF_MODE_CONT_STOP_TRIG	1
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -875,6 +893,65 @@ enum ade9430_egy_model {
 	ADE9430_EGY_NR_SAMPLES
 };
 
+/**
+ * @enum ade9430_wf_src
+ * @brief ADE9430 fixed data rate waveform buffer sources.
+ */
+enum ade9430_wf_src {
+	/* Sinc4 output, 32 kSPS */
+	ADE9430_WF_SRC_SINC4 = 0,
+	/* Sinc4 and IIR low pass filter output, 8 kSPS */
+	ADE9430_WF_SRC_SINC4_IIR_LPF = 2,
+	/* Current and voltage channel DSP output, 8 kSPS */
+	ADE9430_WF_SRC_DSP = 3
+};
+
+/**
+ * @struct ade9430_wfb_init_param
+ * @brief ADE9430 waveform capture initialization parameters.
+ */
+struct ade9430_wfb_init_param {
+	/** Interrupt controller the IRQ0 pin is connected to */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	/** Interrupt line of the IRQ0 pin */
+	uint32_t			irq_id;
+	/** Waveform buffer source */
+	enum ade9430_wf_src		src;
+};
+
+/**
+ * @struct ade9430_wfb
+ * @brief ADE9430 waveform capture state.
+ */
+struct ade9430_wfb {
+	/** Interrupt controller the IRQ0 pin is connected to */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	/** Interrupt line of the IRQ0 pin */
+	uint32_t			irq_id;
+	/** Page full callback */
+	struct no_os_callback_desc	irq_cb;
+	/** Waveform buffer source */
+	enum ade9430_wf_src		src;
+	/** Sample rate of the source in Hz */
+	uint32_t			sample_rate;
+	/** Burst read buffer, command and half of the waveform buffer */
+	uint8_t				*raw;
+	/** Capture ring of ADE9430_WFB_NB_BLOCKS blocks */
+	int32_t				*blocks;
+	/** Scans in a block */
+	uint32_t			block_scans;
+	/** Scans already stored in the block being filled */
+	uint32_t			fill;
+	/** Block being filled */
+	uint32_t			wr;
+	/** Oldest complete block */
+	uint32_t			rd;
+	/** Complete blocks in the ring */
+	volatile uint32_t		count;
+	/** Half buffers dropped because the ring was full */
+	volatile uint32_t		overruns;
+};
+
 /**
  * @struct ade9430_init_param
  * @brief ADE9430 Device initialization parameters.
@@ -901,8 +978,13 @@ struct ade9430_dev {
 	uint32_t			vrms_val;
 	/** Variable storing the temperature value in degrees */
 	int32_t				temp_deg;
+	/** Waveform capture state, NULL if not initialized */
+	struct ade9430_wfb		*wfb;
 };
 
+/** Waveform capture block producer, blocks hold ADE9430_WFB_NB_CHAN scans */
+extern const struct no_os_ain_stream_ops ade9430_wfb_stream_ops;
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -936,4 +1018,23 @@ int ade9430_init(struct ade9430_dev **device,
 /* Remove the device and release resources. */
 int ade9430_remove(struct ade9430_dev *dev);
 
+/* Initialize the waveform buffer capture. */
+int ade9430_wfb_init(struct ade9430_dev *dev,
+		     const struct ade9430_wfb_init_param *init_param);
+
+/* Release the waveform buffer capture resources. */
+int ade9430_wfb_remove(struct ade9430_dev *dev);
+
+/* Describe the captured blocks for a no_os_ain stream. */
+void ade9430_wfb_get_format(struct no_os_ain_stream_format *format);
+
+/* Extract one channel from captured scans. */
+int ade9430_wfb_get_channel(const int32_t *scans, uint32_t nb_scans,
+			    uint8_t chan, int32_t *samples);
+
+/* Compute harmonic magnitudes of one channel of captured scans. */
+int ade9430_wfb_harmonics(struct ade9430_dev *dev, const int32_t *scans,
+			  uint32_t nb_scans, uint8_t chan, float line_freq,
+			  uint8_t nb_harmonics, float *magnitude);
+
 #endif // __ADE9430_H__
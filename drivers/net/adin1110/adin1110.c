@@ -50,7 +50,7 @@
 
 #define ADIN1110_CRC_POLYNOMIAL	0x7
 
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+static const uint8_t *_crc_table;
 
 struct _adin1110_priv {
 	uint32_t phy_id;
@@ -412,6 +412,9 @@ int adin1110_set_mac_addr(struct adin1110_desc *desc,
 			break;
 	}
 
+	if (i == ADIN1110_ADDR_FILT_LEN)
+		return -ENOSPC;
+
 	ret = adin1110_reg_write(desc, ADIN1110_MAC_ADDR_FILT_UPR_REG(i), addr_upr);
 	if (ret)
 		return ret;
@@ -422,7 +425,8 @@ int adin1110_set_mac_addr(struct adin1110_desc *desc,
 }
 
 /**
- * @brief Drop a MAC address filter.
+ * @brief Drop a MAC address filter. Only one of the filters matching the
+ * address is dropped, an address set twice has to be cleared twice.
  * @param desc - the device descriptor
  * @param mac_address - the MAC filter to be cleared
  * @return 0 in case of success, negative error code otherwise
@@ -457,9 +461,7 @@ int adin1110_clear_mac_addr(struct adin1110_desc *desc,
 			if (ret)
 				return ret;
 
-			ret = adin1110_reg_write(desc, ADIN1110_MAC_ADDR_FILT_LWR_REG(i), 0);
-			if (ret)
-				return ret;
+			return adin1110_reg_write(desc, ADIN1110_MAC_ADDR_FILT_LWR_REG(i), 0);
 		}
 	}
 
@@ -486,36 +488,46 @@ int adin1110_broadcast_filter(struct adin1110_desc *desc, bool enabled)
 }
 
 /**
- * @brief Write a frame to the TX FIFO.
+ * @brief Write a frame, split in multiple fragments, to the TX FIFO. The
+ * fragments are sent in a single SPI transaction, without being copied, unless
+ * the frame is short enough for the copy to be cheaper than the additional
+ * SPI messages.
  * @param desc - the device descriptor
  * @param port - the port for the frame to be transmitted on.
- * @param eth_buff - the frame to be transmitted.
+ * @param frags - the fragments of the frame, starting with the destination MAC.
+ * @param nb_frags - number of fragments (at most ADIN1110_TX_MAX_FRAGS).
  * @return 0 in case of success, negative error code otherwise
  */
-int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
-			struct adin1110_eth_buff *eth_buff)
+int adin1110_write_fifo_sg(struct adin1110_desc *desc, uint32_t port,
+			   const struct adin1110_frag *frags, uint32_t nb_frags)
 {
+	static uint8_t tx_pad[64];
+	struct no_os_spi_msg xfer[ADIN1110_TX_MAX_FRAGS + 2] = {0};
 	uint32_t header_len = ADIN1110_WR_HEADER_LEN;
+	uint32_t frame_len = 0;
 	uint32_t frame_offset;
+	uint32_t nb_msgs = 0;
 	uint32_t padding = 0;
 	uint32_t padded_len;
 	uint32_t round_len;
 	uint32_t tx_space;
+	uint32_t i;
 	int ret;
 
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.cs_change = 1,
-	};
-
 	if (port >= driver_data[desc->chip_type].num_ports)
 		return -EINVAL;
 
+	if (!frags || !nb_frags || nb_frags > ADIN1110_TX_MAX_FRAGS)
+		return -EINVAL;
+
+	for (i = 0; i < nb_frags; i++)
+		frame_len += frags[i].len;
+
 	/* The minimum frame length is 64 bytes */
-	if (eth_buff->len + ADIN1110_FCS_LEN < 64)
-		padding = 64 - (eth_buff->len + ADIN1110_FCS_LEN);
+	if (frame_len + ADIN1110_FCS_LEN < 64)
+		padding = 64 - (frame_len + ADIN1110_FCS_LEN);
 
-	padded_len = eth_buff->len + padding + ADIN1110_FRAME_HEADER_LEN;
+	padded_len = frame_len + padding + ADIN1110_FRAME_HEADER_LEN;
 
 	/** Align the frame length to 4 bytes */
 	round_len = no_os_align(padded_len, 4);
@@ -545,30 +557,82 @@ int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
 
 	/* Set the port on which to send the frame */
 	no_os_put_unaligned_be16(port, &desc->data[header_len]);
-	xfer.bytes_number = round_len + header_len;
 	frame_offset = header_len + ADIN1110_FRAME_HEADER_LEN;
 
-	memcpy(&desc->data[frame_offset], (void *)&eth_buff->mac_dest[0],
-	       ADIN1110_ETH_HDR_LEN);
-	frame_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(&desc->data[frame_offset], eth_buff->payload,
-	       eth_buff->len - ADIN1110_ETH_HDR_LEN);
+	if (frame_len <= ADIN1110_TX_COPY_THRESHOLD) {
+		for (i = 0; i < nb_frags; i++) {
+			memcpy(&desc->data[frame_offset], frags[i].data,
+			       frags[i].len);
+			frame_offset += frags[i].len;
+		}
+
+		xfer[0].tx_buff = desc->data;
+		xfer[0].bytes_number = round_len + header_len;
+		xfer[0].cs_change = 1;
 
-	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+		return no_os_spi_transfer(desc->comm_desc, xfer, 1);
+	}
+
+	/* Keep CS asserted between the header, fragments and padding */
+	xfer[nb_msgs].tx_buff = desc->data;
+	xfer[nb_msgs++].bytes_number = frame_offset;
+
+	for (i = 0; i < nb_frags; i++) {
+		if (!frags[i].len)
+			continue;
+
+		xfer[nb_msgs].tx_buff = (uint8_t *)frags[i].data;
+		xfer[nb_msgs++].bytes_number = frags[i].len;
+	}
+
+	if (round_len > frame_len + ADIN1110_FRAME_HEADER_LEN) {
+		xfer[nb_msgs].tx_buff = tx_pad;
+		xfer[nb_msgs++].bytes_number = round_len - frame_len -
+					       ADIN1110_FRAME_HEADER_LEN;
+	}
+
+	xfer[nb_msgs - 1].cs_change = 1;
+
+	return no_os_spi_transfer(desc->comm_desc, xfer, nb_msgs);
 }
 
 /**
- * @brief Read a frame from the RX FIFO.
+ * @brief Write a frame to the TX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port for the frame to be transmitted on.
+ * @param eth_buff - the frame to be transmitted.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
+			struct adin1110_eth_buff *eth_buff)
+{
+	struct adin1110_frag frags[2] = {
+		{
+			.data = &eth_buff->mac_dest[0],
+			.len = ADIN1110_ETH_HDR_LEN,
+		},
+		{
+			.data = eth_buff->payload,
+			.len = eth_buff->len - ADIN1110_ETH_HDR_LEN,
+		},
+	};
+
+	return adin1110_write_fifo_sg(desc, port, frags, NO_OS_ARRAY_SIZE(frags));
+}
+
+/**
+ * @brief Read a frame from the RX FIFO, without copying it out of the SPI
+ * buffer. The frame is valid until the next transfer done on the device.
  * @param desc - the device descriptor
  * @param port - the port from which the frame shall be received.
- * @param eth_buff - the frame to be received.
+ * @param frame - will point to the frame, starting with the destination MAC.
+ * @param len - length of the frame (0 if the FIFO is empty).
  * @return 0 in case of success, negative error code otherwise
  */
-int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
-		       struct adin1110_eth_buff *eth_buff)
+int adin1110_read_fifo_raw(struct adin1110_desc *desc, uint32_t port,
+			   uint8_t **frame, uint32_t *len)
 {
 	uint32_t field_offset = ADIN1110_RD_HEADER_LEN;
-	uint32_t payload_length;
 	uint32_t fifo_fsize_reg;
 	uint32_t rounded_len;
 	uint32_t frame_size;
@@ -591,6 +655,8 @@ int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 		fifo_fsize_reg = ADIN2111_RX_P2_FSIZE_REG;
 	}
 
+	*len = 0;
+
 	ret = adin1110_reg_read(desc, fifo_fsize_reg, &frame_size);
 	if (ret)
 		return ret;
@@ -622,16 +688,77 @@ int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 	if (ret)
 		return ret;
 
-	payload_length = frame_size - ADIN1110_FRAME_HEADER_LEN - ADIN1110_ETH_HDR_LEN;
-	memcpy((void *)&eth_buff->mac_dest[0], &desc->data[field_offset],
-	       ADIN1110_ETH_HDR_LEN);
-	field_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(eth_buff->payload, &desc->data[field_offset], payload_length);
-	eth_buff->len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+	*frame = &desc->data[field_offset];
+	*len = frame_size - ADIN1110_FRAME_HEADER_LEN;
 
 	return 0;
 }
 
+/**
+ * @brief Read a frame from the RX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frame shall be received.
+ * @param eth_buff - the frame to be received.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
+		       struct adin1110_eth_buff *eth_buff)
+{
+	uint8_t *frame;
+	uint32_t len;
+	int ret;
+
+	ret = adin1110_read_fifo_raw(desc, port, &frame, &len);
+	if (ret)
+		return ret;
+
+	if (!len)
+		return 0;
+
+	memcpy((void *)&eth_buff->mac_dest[0], frame, ADIN1110_ETH_HDR_LEN);
+	memcpy(eth_buff->payload, &frame[ADIN1110_ETH_HDR_LEN],
+	       len - ADIN1110_ETH_HDR_LEN);
+	eth_buff->len = len;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the interrupt flags set in STATUS1. Should be called before
+ * draining the RX FIFO, so that a frame received in the meantime asserts the
+ * INT pin again.
+ * @param desc - the device descriptor
+ * @param status - the STATUS1 value before clearing (may be NULL).
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_irq_ack(struct adin1110_desc *desc, uint32_t *status)
+{
+	uint32_t val;
+	int ret;
+
+	ret = adin1110_reg_read(desc, ADIN1110_STATUS1_REG, &val);
+	if (ret)
+		return ret;
+
+	if (status)
+		*status = val;
+
+	/* The flags are write 1 to clear */
+	return adin1110_reg_write(desc, ADIN1110_STATUS1_REG, val);
+}
+
+/**
+ * @brief INT pin handler. Only flags the pending frames, since the FIFO
+ * can't be read from interrupt context.
+ * @param ctx - the device descriptor
+ */
+static void adin1110_int_handler(void *ctx)
+{
+	struct adin1110_desc *desc = ctx;
+
+	desc->rx_pending = true;
+}
+
 /**
  * @brief Reset the MAC device.
  * @param desc - the device descriptor
@@ -892,7 +1019,11 @@ int adin1110_init(struct adin1110_desc **desc,
 	if (ret)
 		goto free_rst_gpio;
 
-	no_os_crc8_populate_msb(_crc_table, ADIN1110_CRC_POLYNOMIAL);
+	_crc_table = no_os_crc8_get_table(ADIN1110_CRC_POLYNOMIAL);
+	if (!_crc_table) {
+		ret = -ENOMEM;
+		goto free_spi;
+	}
 	strncpy((char *)descriptor->mac_address, (char *)param->mac_address,
 		ADIN1110_MAC_LEN);
 
@@ -921,10 +1052,42 @@ int adin1110_init(struct adin1110_desc **desc,
 	if (ret)
 		goto free_spi;
 
+	if (param->int_irq_desc) {
+		descriptor->int_irq_desc = param->int_irq_desc;
+		descriptor->int_pin = param->int_pin;
+		descriptor->int_cb.callback = adin1110_int_handler;
+		descriptor->int_cb.ctx = descriptor;
+		descriptor->int_cb.event = NO_OS_EVT_GPIO;
+		descriptor->int_cb.peripheral = NO_OS_GPIO_IRQ;
+		/* Frames received before the IRQ is enabled are drained first */
+		descriptor->rx_pending = true;
+
+		ret = no_os_irq_register_callback(descriptor->int_irq_desc,
+						  descriptor->int_pin,
+						  &descriptor->int_cb);
+		if (ret)
+			goto free_spi;
+
+		/* The INT pin is active low */
+		ret = no_os_irq_trigger_level_set(descriptor->int_irq_desc,
+						  descriptor->int_pin,
+						  NO_OS_IRQ_EDGE_FALLING);
+		if (ret)
+			goto free_irq;
+
+		ret = no_os_irq_enable(descriptor->int_irq_desc,
+				       descriptor->int_pin);
+		if (ret)
+			goto free_irq;
+	}
+
 	*desc = descriptor;
 
 	return 0;
 
+free_irq:
+	no_os_irq_unregister_callback(descriptor->int_irq_desc,
+				      descriptor->int_pin, &descriptor->int_cb);
 free_spi:
 	no_os_spi_remove(descriptor->comm_desc);
 free_rst_gpio:
@@ -947,6 +1110,18 @@ int adin1110_remove(struct adin1110_desc *desc)
 	if (!desc)
 		return -EINVAL;
 
+	if (desc->int_irq_desc) {
+		ret = no_os_irq_disable(desc->int_irq_desc, desc->int_pin);
+		if (ret)
+			return ret;
+
+		ret = no_os_irq_unregister_callback(desc->int_irq_desc,
+						    desc->int_pin,
+						    &desc->int_cb);
+		if (ret)
+			return ret;
+	}
+
 	ret = no_os_spi_remove(desc->comm_desc);
 	if (ret)
 		return ret;
@@ -43,6 +43,7 @@
 #include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_util.h"
 
 #define ADIN1110_BUFF_LEN			1530
@@ -51,6 +52,11 @@
 #define ADIN1110_ETH_HDR_LEN			14
 #define ADIN1110_ADDR_FILT_LEN			16
 
+/* Maximum number of fragments a TX frame may be split in */
+#define ADIN1110_TX_MAX_FRAGS			8
+/* Frames up to this length are copied into a single SPI message */
+#define ADIN1110_TX_COPY_THRESHOLD		128
+
 #define ADIN1110_FCS_LEN			4
 #define ADIN1110_MAC_LEN			6
 
@@ -209,6 +215,11 @@ struct adin1110_desc {
 	uint8_t data[ADIN1110_BUFF_LEN];
 	struct no_os_gpio_desc *reset_gpio;
 	bool append_crc;
+	/* INT pin - optional, used to avoid polling the RX FIFO */
+	struct no_os_irq_ctrl_desc *int_irq_desc;
+	uint32_t int_pin;
+	struct no_os_callback_desc int_cb;
+	volatile bool rx_pending;
 };
 
 /**
@@ -220,6 +231,12 @@ struct adin1110_init_param {
 	struct no_os_gpio_init_param reset_param;
 	uint8_t mac_address[ADIN1110_ETH_ALEN];
 	bool append_crc;
+	/*
+	 * INT pin - optional. The IRQ controller should be already initialized
+	 * and handle the GPIO the INT pin is connected to.
+	 */
+	struct no_os_irq_ctrl_desc *int_irq_desc;
+	uint32_t int_pin;
 };
 
 /**
@@ -233,6 +250,14 @@ struct adin1110_eth_buff {
 	uint8_t *payload;
 };
 
+/**
+ * @brief Fragment of a frame, used for scatter-gather TX.
+ */
+struct adin1110_frag {
+	const uint8_t *data;
+	uint32_t len;
+};
+
 /* Reset both the MAC and PHY. */
 int adin1110_sw_reset(struct adin1110_desc *);
 
@@ -249,10 +274,21 @@ int adin1110_reg_read(struct adin1110_desc *, uint16_t, uint32_t *);
 int adin1110_write_fifo(struct adin1110_desc *, uint32_t,
 			struct adin1110_eth_buff *);
 
+/* Write a frame split in multiple fragments to the TX FIFO */
+int adin1110_write_fifo_sg(struct adin1110_desc *, uint32_t,
+			   const struct adin1110_frag *, uint32_t);
+
 /* Read a frame from the RX FIFO */
 int adin1110_read_fifo(struct adin1110_desc *, uint32_t,
 		       struct adin1110_eth_buff *);
 
+/* Read a frame from the RX FIFO, leaving it in the SPI buffer */
+int adin1110_read_fifo_raw(struct adin1110_desc *, uint32_t, uint8_t **,
+			   uint32_t *);
+
+/* Clear the STATUS1 interrupt flags, returning their previous state */
+int adin1110_irq_ack(struct adin1110_desc *, uint32_t *);
+
 /* Write a PHY register using clause 22 */
 int adin1110_mdio_write(struct adin1110_desc *, uint32_t, uint32_t, uint16_t);
 
@@ -281,6 +317,10 @@ int adin1110_set_promisc(struct adin1110_desc *, uint32_t, bool);
 int adin1110_set_mac_addr(struct adin1110_desc *desc,
 			  uint8_t mac_address[ADIN1110_ETH_ALEN]);
 
+/* Drop a MAC filter set by adin1110_set_mac_addr() */
+int adin1110_clear_mac_addr(struct adin1110_desc *desc,
+			    uint8_t mac_address[ADIN1110_ETH_ALEN]);
+
 /* Enable/disable the forwarding (to host) of broadcast frames */
 int adin1110_broadcast_filter(struct adin1110_desc *, bool);
 
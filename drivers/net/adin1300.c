@@ -255,6 +255,30 @@ bool adin1300_link_is_up(struct adin1300_desc *dev)
 	return false;
 }
 
+/* Interrupt flags, link and resolved speed, read in a single MDIO batch. */
+int adin1300_get_status(struct adin1300_desc *dev,
+			struct adin1300_status *status)
+{
+	int ret;
+	struct no_os_mdio_xfer xfers[] = {
+		{ .reg = ADIN1300_IRQ_STATUS },
+		{ .reg = ADIN1300_PHY_STATUS_1 },
+	};
+
+	if (!dev || !status)
+		return -EINVAL;
+
+	ret = no_os_mdio_transfer(dev->mdio, xfers, NO_OS_ARRAY_SIZE(xfers));
+	if (ret)
+		return ret;
+
+	status->irq_status = xfers[0].val;
+	status->link = no_os_field_get(ADIN1300_LINK_STAT_MASK, xfers[1].val);
+	status->speed = no_os_field_get(ADIN1300_HCD_TECH_MASK, xfers[1].val);
+
+	return 0;
+}
+
 enum adin1300_speed adin1300_resolved_speed(struct adin1300_desc *dev)
 {
 	uint16_t val;
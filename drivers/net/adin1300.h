@@ -143,6 +143,13 @@ struct adin1300_rgmii_config {
 
 };
 
+struct adin1300_status {
+	/* ADIN1300_IRQ_STATUS, its flags are cleared by the read */
+	uint16_t irq_status;
+	bool link;
+	enum adin1300_speed speed;
+};
+
 struct adin1300_init_param {
 	struct no_os_gpio_init_param *reset_param;
 	struct no_os_mdio_init_param mdio_param;
@@ -178,6 +185,8 @@ int adin1300_config_speed(struct adin1300_desc *dev,
 			  enum adin1300_speed speed_cap);
 enum adin1300_speed adin1300_resolved_speed(struct adin1300_desc *dev);
 bool adin1300_link_is_up(struct adin1300_desc *dev);
+int adin1300_get_status(struct adin1300_desc *dev,
+			struct adin1300_status *status);
 
 
 
@@ -143,6 +143,55 @@ int max24287_read(struct max24287_desc *dev, uint8_t addr, uint16_t *val)
 	return ret;
 }
 
+/*
+ * Read up to MAX24287_MAX_BATCH registers in a single MDIO batch, the page
+ * is only selected when it changes and page 0 is restored at the end.
+ */
+int max24287_read_regs(struct max24287_desc *dev, const uint8_t *addrs,
+		       uint16_t *vals, unsigned int nb)
+{
+	int ret;
+	unsigned int i;
+	unsigned int n = 0;
+	uint8_t page = 0;
+	struct no_os_mdio_xfer xfers[2 * MAX24287_MAX_BATCH + 1];
+
+	if (!dev || !addrs || !vals || nb > MAX24287_MAX_BATCH)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++) {
+		if (MAX24287_PAGE(addrs[i]) != page) {
+			page = MAX24287_PAGE(addrs[i]);
+			xfers[n++] = (struct no_os_mdio_xfer) {
+				.reg = MAX24287_PAGESEL,
+				.val = 0x10 | page,
+				.write = true,
+			};
+		}
+		xfers[n++] = (struct no_os_mdio_xfer) {
+			.reg = MAX24287_ADDR(addrs[i]),
+		};
+	}
+
+	if (page)
+		xfers[n++] = (struct no_os_mdio_xfer) {
+			.reg = MAX24287_PAGESEL,
+			.val = 0x10,
+			.write = true,
+		};
+
+	ret = no_os_mdio_transfer(dev->mdio, xfers, n);
+	if (ret)
+		return ret;
+
+	for (i = 0, n = 0; i < nb; n++) {
+		if (!xfers[n].write)
+			vals[i++] = xfers[n].val;
+	}
+
+	return 0;
+}
+
 int max24287_write_bits(struct max24287_desc *dev, uint8_t addr, uint16_t val,
 			uint16_t bitmask)
 {
@@ -258,11 +307,12 @@ int max24287_config_link(struct max24287_desc *dev, bool up)
 bool max24287_link_is_up(struct max24287_desc *dev)
 {
 	int ret;
-	uint16_t val;
+	uint16_t val[2];
+	/* The link status is latched low, the second read has the current one */
+	const uint8_t addrs[] = {MAX24287_BMSR, MAX24287_BMSR};
 
-	ret = max24287_read(dev, MAX24287_BMSR, &val);
-	ret = max24287_read(dev, MAX24287_BMSR, &val);
-	if (!ret && no_os_field_get(MAX24287_LINK_ST_MASK, val))
+	ret = max24287_read_regs(dev, addrs, val, NO_OS_ARRAY_SIZE(addrs));
+	if (!ret && no_os_field_get(MAX24287_LINK_ST_MASK, val[1]))
 		return true;
 
 	return false;
@@ -73,6 +73,8 @@
 #define MAX24287_PAGESEL	31
 #define MAX24287_PAGE_MASK	NO_OS_GENMASK(1, 0)
 
+#define MAX24287_MAX_BATCH	8
+
 enum max24287_parallel {
 	MAX24287_TBI,
 	MAX24287_RTBI,
@@ -116,6 +118,8 @@ int max24287_init(struct max24287_desc **dev,
 int max24287_remove(struct max24287_desc *dev);
 int max24287_write(struct max24287_desc *dev, uint8_t addr, uint16_t val);
 int max24287_read(struct max24287_desc *dev, uint8_t addr, uint16_t *val);
+int max24287_read_regs(struct max24287_desc *dev, const uint8_t *addrs,
+		       uint16_t *vals, unsigned int nb);
 int max24287_write_bits(struct max24287_desc *dev, uint8_t addr, uint16_t val,
 			uint16_t bitmask);
 int max24287_hard_reset(struct max24287_desc *dev);
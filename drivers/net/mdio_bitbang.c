@@ -47,19 +47,26 @@
 struct mdio_bitbang_extra {
 	struct no_os_gpio_desc *mdc;
 	struct no_os_gpio_desc *mdio;
+	// MDC and MDIO are pins of the same port, driven with port accesses
+	bool port;
+	uint32_t mdc_mask;
+	uint32_t mdio_mask;
+	// level last driven on MDIO, to skip the writes that don't change it
+	uint8_t mdio_level;
 };
 
 int mdio_bitbang_init(struct no_os_mdio_desc **dev,
 		      struct no_os_mdio_init_param *ip)
 {
-	int ret;
+	int ret = -ENOMEM;
 	struct mdio_bitbang_init_param *mbip = ip->extra;
+	const struct no_os_gpio_platform_ops *ops;
 
 	struct mdio_bitbang_extra *mbe = no_os_calloc(1, sizeof(*mbe));
 	if (!mbe)
 		return -ENOMEM;
 
-	struct no_os_mdio_desc *d = no_os_calloc(1, sizeof(*dev));
+	struct no_os_mdio_desc *d = no_os_calloc(1, sizeof(*d));
 	if (!d)
 		goto error;
 
@@ -79,6 +86,16 @@ int mdio_bitbang_init(struct no_os_mdio_desc **dev,
 	ret = no_os_gpio_direction_output(mbe->mdio, NO_OS_GPIO_HIGH);
 	if (ret)
 		goto error_2;
+	mbe->mdio_level = NO_OS_GPIO_HIGH;
+
+	ops = mbe->mdc->platform_ops;
+	if (ops == mbe->mdio->platform_ops && ops->gpio_ops_port_set_value &&
+	    ops->gpio_ops_port_get_value && mbe->mdc->port == mbe->mdio->port &&
+	    mbe->mdc->number < 32 && mbe->mdio->number < 32) {
+		mbe->port = true;
+		mbe->mdc_mask = NO_OS_BIT(mbe->mdc->number);
+		mbe->mdio_mask = NO_OS_BIT(mbe->mdio->number);
+	}
 
 	d->extra = mbe;
 	*dev = d;
@@ -96,12 +113,67 @@ error:
 	return ret;
 }
 
+/*
+ * Clock out the n most significant bits of bits, MDIO is latched by the PHY on
+ * the rising edge of MDC. On a single port, MDC is pulled low and the next bit
+ * is set in the same write, one write per edge instead of three GPIO calls.
+ */
+static void mdio_bitbang_out(struct mdio_bitbang_extra *mbe, uint32_t bits,
+			     int n)
+{
+	int i;
+	uint8_t bit;
+
+	for (i = 31; i > 31 - n; i--) {
+		bit = (bits >> i) & 0x1;
+		if (mbe->port) {
+			no_os_gpio_port_set_value(mbe->mdc,
+						  mbe->mdc_mask | mbe->mdio_mask,
+						  bit ? mbe->mdio_mask : 0);
+			no_os_gpio_port_set_value(mbe->mdc, mbe->mdc_mask,
+						  mbe->mdc_mask);
+		} else {
+			if (bit != mbe->mdio_level)
+				no_os_gpio_set_value(mbe->mdio, bit);
+			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_HIGH);
+			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_LOW);
+		}
+		mbe->mdio_level = bit;
+	}
+
+	if (mbe->port)
+		no_os_gpio_port_set_value(mbe->mdc, mbe->mdc_mask, 0);
+}
+
+static uint16_t mdio_bitbang_in(struct mdio_bitbang_extra *mbe)
+{
+	int i;
+	uint8_t state;
+	uint32_t port;
+	uint16_t data = 0;
+
+	for (i = 15; i >= 0; i--) {
+		if (mbe->port) {
+			no_os_gpio_port_get_value(mbe->mdc, mbe->mdio_mask, &port);
+			state = !!port;
+			no_os_gpio_port_set_value(mbe->mdc, mbe->mdc_mask,
+						  mbe->mdc_mask);
+			no_os_gpio_port_set_value(mbe->mdc, mbe->mdc_mask, 0);
+		} else {
+			no_os_gpio_get_value(mbe->mdio, &state);
+			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_HIGH);
+			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_LOW);
+		}
+		data = (data << 1) | (state ? 1 : 0);
+	}
+
+	return data;
+}
+
 static int mdio_rw(struct no_os_mdio_desc *dev, bool c45, uint16_t op,
 		   uint32_t reg, uint16_t *data)
 {
-	int i;
 	uint32_t frame;
-	uint8_t state;
 	struct mdio_bitbang_extra *mbe = dev->extra;
 	uint8_t start = c45 ? NO_OS_MDIO_C45_START : NO_OS_MDIO_C22_START;
 	uint8_t regaddr = c45 ? no_os_field_get(NO_OS_MDIO_C45_DEVADDR_MASK, reg) : reg;
@@ -115,68 +187,91 @@ static int mdio_rw(struct no_os_mdio_desc *dev, bool c45, uint16_t op,
 
 	// preamble
 	no_os_gpio_direction_output(mbe->mdio, NO_OS_GPIO_HIGH);
-	for (i = 31; i >= 0; i--) {
-		no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_HIGH);
-		no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_LOW);
-	}
+	mbe->mdio_level = NO_OS_GPIO_HIGH;
+	mdio_bitbang_out(mbe, 0xffffffff, 32);
 
 	// start, read, phyaddr, regaddr
-	for (i = 31; i >= 16; i--) {
-		no_os_gpio_set_value(mbe->mdio, (bool)(frame & (1u << i)));
-		no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_HIGH);
-		no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_LOW);
-	}
+	mdio_bitbang_out(mbe, frame, 16);
 
 	if (op == NO_OS_MDIO_OP_WRITE || op == NO_OS_MDIO_OP_ADDRESS) {
 		data2 = op == NO_OS_MDIO_OP_ADDRESS ? (uint16_t)reg : *data;
-		for (i = 15; i >= 0; i--) {
-			no_os_gpio_set_value(mbe->mdio, (data2 >> i) & 0x1);
-			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_HIGH);
-			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_LOW);
-		}
+		mdio_bitbang_out(mbe, (uint32_t)data2 << 16, 16);
 	} else {
-		*data = 0;
 		no_os_gpio_direction_input(mbe->mdio);
-		for (i = 15; i >= 0; i--) {
-			no_os_gpio_get_value(mbe->mdio, &state);
-			if (state)
-				*data |= 1;
-			if (i)
-				*data <<= 1;
-			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_HIGH);
-			no_os_gpio_set_value(mbe->mdc, NO_OS_GPIO_LOW);
-		}
+		*data = mdio_bitbang_in(mbe);
 	}
 
 	return 0;
 }
 
-int mdio_bitbang_write(struct no_os_mdio_desc *dev, uint32_t reg, uint16_t in)
+/*
+ * In clause 45 frames, NO_OS_MDIO_OP_READ is the post-read-increment-address
+ * operation: the PHY moves to the next register after a read and stays on the
+ * register after a write. The address frame is only sent when the register
+ * accessed is not the one the PHY already points to, so a run of consecutive
+ * registers costs one address frame.
+ */
+int mdio_bitbang_transfer(struct no_os_mdio_desc *dev,
+			  struct no_os_mdio_xfer *xfers, uint32_t nb)
 {
 	int ret;
-	bool c45 = dev->c45 && reg >= NO_OS_MDIO_C22_REGS;
+	bool c45;
+	uint32_t i;
+	uint32_t reg;
+	uint32_t next = 0; // clause 45 addresses have bit 31 set, 0 is unknown
+
+	for (i = 0; i < nb; i++) {
+		reg = xfers[i].reg;
+		c45 = dev->c45 && reg >= NO_OS_MDIO_C22_REGS;
+
+		if (c45 && reg != next) {
+			ret = mdio_rw(dev, c45, NO_OS_MDIO_OP_ADDRESS, reg, NULL);
+			if (ret)
+				return ret;
+		}
 
-	if (c45) {
-		ret = mdio_rw(dev, c45, NO_OS_MDIO_OP_ADDRESS, reg, NULL);
+		ret = mdio_rw(dev, c45, xfers[i].write ? NO_OS_MDIO_OP_WRITE :
+			      NO_OS_MDIO_OP_READ, reg, &xfers[i].val);
 		if (ret)
 			return ret;
+
+		if (c45 && xfers[i].write)
+			next = reg;
+		else if (c45)
+			next = (reg & ~NO_OS_MDIO_DATA_MASK) | (uint16_t)(reg + 1);
+		else
+			next = 0;
 	}
 
-	return mdio_rw(dev, c45, NO_OS_MDIO_OP_WRITE, reg, &in);
+	return 0;
+}
+
+int mdio_bitbang_write(struct no_os_mdio_desc *dev, uint32_t reg, uint16_t in)
+{
+	struct no_os_mdio_xfer xfer = {
+		.reg = reg,
+		.val = in,
+		.write = true,
+	};
+
+	return mdio_bitbang_transfer(dev, &xfer, 1);
 }
 
 int mdio_bitbang_read(struct no_os_mdio_desc *dev, uint32_t reg, uint16_t *out)
 {
 	int ret;
-	bool c45 = dev->c45 && reg >= NO_OS_MDIO_C22_REGS;
+	struct no_os_mdio_xfer xfer = {
+		.reg = reg,
+	};
 
-	if (c45) {
-		ret = mdio_rw(dev, c45, NO_OS_MDIO_OP_ADDRESS, reg, NULL);
-		if (ret)
-			return ret;
-	}
+	ret = mdio_bitbang_transfer(dev, &xfer, 1);
+	if (ret)
+		return ret;
+
+	if (out)
+		*out = xfer.val;
 
-	return mdio_rw(dev, c45, NO_OS_MDIO_OP_READ, reg, out);
+	return 0;
 }
 
 int mdio_bitbang_remove(struct no_os_mdio_desc *dev)
@@ -195,5 +290,6 @@ struct no_os_mdio_ops mdio_bitbang_ops = {
 	.init = mdio_bitbang_init,
 	.write = mdio_bitbang_write,
 	.read = mdio_bitbang_read,
+	.transfer = mdio_bitbang_transfer,
 	.remove = mdio_bitbang_remove,
 };
@@ -88,7 +88,7 @@ int32_t adpd410x_reg_read_bytes(struct adpd410x_dev *dev, uint16_t address,
 				uint8_t *data, uint16_t num_bytes)
 {
 	int32_t ret;
-	uint8_t i;
+	uint16_t i;
 	uint8_t *buff;
 
 	switch (dev->dev_type) {
@@ -566,7 +566,8 @@ int32_t adpd410x_read_fifo(struct adpd410x_dev *dev, uint32_t *data,
 			   uint8_t datawidth)
 {
 	int32_t ret = 0;
-	uint8_t *data_byte_buff, i, j;
+	uint8_t *data_byte_buff;
+	uint16_t i, j;
 	uint16_t next_packet_size, bytes_read = 0,
 				   total_bytes = num_samples * datawidth;
 	if (datawidth > 4 || total_bytes > ADPD410X_FIFO_DEPTH || data == NULL)
@@ -654,6 +655,307 @@ int32_t adpd410x_get_data(struct adpd410x_dev *dev, uint32_t *data)
 	return adpd410x_get_data_packet(dev, data, ts_no, dual_chan);
 }
 
+/* INTX sources used by the FIFO drain */
+#define ADPD410X_FIFO_STREAM_INTS	(BITM_INT_ENABLE_XD_INTX_EN_FIFO_TH | \
+					 BITM_INT_ENABLE_XD_INTX_EN_FIFO_OFLOW)
+
+/**
+ * @brief Unpack one FIFO sample.
+ * @param p - Sample bytes, in FIFO order.
+ * @param width - Number of bytes of the sample.
+ * @return The sample value.
+ */
+static inline uint32_t adpd410x_unpack_sample(const uint8_t *p, uint8_t width)
+{
+	switch (width) {
+	case 1:
+		return p[0];
+	case 2:
+		return (p[0] << 8) | p[1];
+	case 3:
+		return (p[0] << 8) | p[1] | (p[2] << 16);
+	case 4:
+		return (p[0] << 8) | p[1] | ((uint32_t)p[2] << 24) | (p[3] << 16);
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Split the packets of a FIFO burst into samples, in time slot order.
+ * @param s - FIFO stream descriptor.
+ * @param data - Unpacked samples, nb_ch per packet.
+ * @param packets - Number of packets in the burst.
+ */
+static void adpd410x_fifo_unpack(struct adpd410x_fifo_stream *s,
+				 uint32_t *data, uint16_t packets)
+{
+	const uint8_t *p = s->raw;
+	uint32_t i, n = (uint32_t)packets * s->nb_ch;
+	uint8_t ch;
+
+	/* All the samples have the same width, unpack the burst in one pass. */
+	switch (s->common_width) {
+	case 2:
+		for (i = 0; i < n; i++, p += 2)
+			data[i] = (p[0] << 8) | p[1];
+		return;
+	case 3:
+		for (i = 0; i < n; i++, p += 3)
+			data[i] = (p[0] << 8) | p[1] | (p[2] << 16);
+		return;
+	case 4:
+		for (i = 0; i < n; i++, p += 4)
+			data[i] = (p[0] << 8) | p[1] | ((uint32_t)p[2] << 24) |
+				  (p[3] << 16);
+		return;
+	default:
+		break;
+	}
+
+	for (i = 0; i < n; i += s->nb_ch) {
+		for (ch = 0; ch < s->nb_ch; ch++) {
+			data[i + ch] = adpd410x_unpack_sample(p, s->width[ch]);
+			p += s->width[ch];
+		}
+	}
+}
+
+/**
+ * @brief Start draining the FIFO on its threshold interrupt.
+ *
+ * The FIFO threshold interrupt is routed to a device GPIO, whose host side
+ * interrupt must call adpd410x_fifo_stream_irq(). The MCU can then sleep until
+ * the FIFO holds param->packets packets and read them with a single call of
+ * adpd410x_fifo_stream_drain(). The time slots must be set up beforehand.
+ * @param dev - Device handler.
+ * @param param - FIFO stream parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adpd410x_fifo_stream_start(struct adpd410x_dev *dev,
+				   struct adpd410x_fifo_stream_init_param *param)
+{
+	struct adpd410x_fifo_stream *s;
+	uint16_t reg_val, ts_ctrl, shift;
+	uint8_t ts_no, i, width;
+	int32_t ret;
+
+	if (!dev || dev->fifo_stream || !param || !param->packets ||
+	    param->int_gpio > 3)
+		return -EINVAL;
+
+	s = (struct adpd410x_fifo_stream *)no_os_calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	ret = adpd410x_set_opmode(dev, ADPD410X_STANDBY);
+	if (ret != 0)
+		goto error_stream;
+
+	ret = adpd410x_reg_read(dev, ADPD410X_REG_OPMODE, &reg_val);
+	if (ret != 0)
+		goto error_stream;
+	ts_no = ((reg_val & BITM_OPMODE_TIMESLOT_EN) >>
+		 BITP_OPMODE_TIMESLOT_EN) + 1;
+
+	/* Packet layout, same as adpd410x_get_data(). */
+	s->common_width = 0xff;
+	for (i = 0; i < ts_no; i++) {
+		ret = adpd410x_reg_read(dev, ADPD410X_REG_TS_CTRL(i), &ts_ctrl);
+		if (ret != 0)
+			goto error_stream;
+		ret = adpd410x_reg_read(dev, ADPD410X_REG_DATA1(i), &reg_val);
+		if (ret != 0)
+			goto error_stream;
+
+		width = reg_val & BITM_DATA1_A_SIGNAL_SIZE;
+		s->width[s->nb_ch++] = width;
+		if (ts_ctrl & BITM_TS_CTRL_A_CH2_EN)
+			s->width[s->nb_ch++] = width;
+		s->packet_size += width * ((ts_ctrl & BITM_TS_CTRL_A_CH2_EN) ? 2 : 1);
+
+		if (s->common_width == 0xff)
+			s->common_width = width;
+		else if (s->common_width != width)
+			s->common_width = 0;
+	}
+
+	s->threshold = s->packet_size * param->packets;
+	if (!s->packet_size || s->threshold > ADPD410X_FIFO_DEPTH) {
+		ret = -EINVAL;
+		goto error_stream;
+	}
+	s->buf = param->buf;
+
+	ret = adpd410x_reg_write(dev, ADPD410X_REG_FIFO_STATUS,
+				 BITM_INT_STATUS_FIFO_CLEAR_FIFO);
+	if (ret != 0)
+		goto error_stream;
+
+	/* The interrupt is raised once the byte count exceeds FIFO_TH. */
+	ret = adpd410x_reg_write_mask(dev, ADPD410X_REG_FIFO_TH,
+				      s->threshold - 1, BITM_FIFO_CTL_FIFO_TH);
+	if (ret != 0)
+		goto error_stream;
+
+	/* Reading the FIFO clears the threshold interrupt. */
+	ret = adpd410x_reg_write_mask(dev, ADPD410X_REG_INT_ACLEAR, 1,
+				      BITM_INT_ACLEAR_INT_ACLEAR_FIFO);
+	if (ret != 0)
+		goto error_stream;
+
+	ret = adpd410x_reg_read(dev, ADPD410X_REG_INT_ENABLE_XD, &reg_val);
+	if (ret != 0)
+		goto error_stream;
+	ret = adpd410x_reg_write(dev, ADPD410X_REG_INT_ENABLE_XD,
+				 reg_val | ADPD410X_FIFO_STREAM_INTS);
+	if (ret != 0)
+		goto error_stream;
+
+	shift = 3 * param->int_gpio;
+	ret = adpd410x_reg_write_mask(dev, ADPD410X_REG_GPIO_CFG,
+				      ADPD410X_GPIO_CFG_OUTPUT,
+				      BITM_GPIO_CFG_GPIO_PIN_CFG0 << shift);
+	if (ret != 0)
+		goto error_stream;
+
+	ret = adpd410x_reg_write_mask(dev, param->int_gpio < 2 ?
+				      ADPD410X_REG_GPIO01 : ADPD410X_REG_GPIO23,
+				      ADPD410X_GPIOOUT_INTX,
+				      (param->int_gpio & 1) ? BITM_GPIO01_GPIOOUT1 :
+				      BITM_GPIO01_GPIOOUT0);
+	if (ret != 0)
+		goto error_stream;
+
+	dev->fifo_stream = s;
+
+	ret = adpd410x_set_opmode(dev, ADPD410X_GOMODE);
+	if (ret != 0) {
+		dev->fifo_stream = NULL;
+		goto error_stream;
+	}
+
+	return 0;
+
+error_stream:
+	no_os_free(s);
+
+	return ret;
+}
+
+/**
+ * @brief FIFO threshold interrupt handler, to be registered as callback of
+ *        the host GPIO interrupt. Only flags the FIFO for draining.
+ * @param dev - Device handler.
+ */
+void adpd410x_fifo_stream_irq(void *dev)
+{
+	struct adpd410x_dev *d = dev;
+
+	if (d && d->fifo_stream)
+		d->fifo_stream->pending = true;
+}
+
+/**
+ * @brief Read the whole FIFO in one burst and unpack its packets.
+ * @param dev - Device handler.
+ * @param data - Unpacked samples, the active channels of each packet in time
+ *               slot order, as returned by adpd410x_get_data().
+ * @param max_packets - Size of data, in packets.
+ * @param packets - Number of packets read.
+ * @return 0 in case of success, -EAGAIN if no interrupt is pending, negative
+ *         error code otherwise.
+ */
+int32_t adpd410x_fifo_stream_drain(struct adpd410x_dev *dev, uint32_t *data,
+				   uint16_t max_packets, uint16_t *packets)
+{
+	struct adpd410x_fifo_stream *s;
+	uint16_t status, bytes, chunk, offset;
+	int32_t ret;
+
+	if (!dev || !dev->fifo_stream || !data || !packets)
+		return -EINVAL;
+
+	s = dev->fifo_stream;
+	*packets = 0;
+	if (!s->pending)
+		return -EAGAIN;
+	s->pending = false;
+
+	ret = adpd410x_reg_read(dev, ADPD410X_REG_FIFO_STATUS, &status);
+	if (ret != 0)
+		return ret;
+
+	if (status & BITM_INT_STATUS_FIFO_INT_FIFO_OFLOW) {
+		s->overflows++;
+		ret = adpd410x_reg_write(dev, ADPD410X_REG_FIFO_STATUS,
+					 BITM_INT_STATUS_FIFO_INT_FIFO_OFLOW);
+		if (ret != 0)
+			return ret;
+	}
+
+	bytes = status & BITM_INT_STATUS_FIFO_FIFO_BYTE_COUNT;
+	*packets = no_os_min(bytes / s->packet_size, max_packets);
+	bytes = *packets * s->packet_size;
+
+	for (offset = 0; offset < bytes; offset += chunk) {
+		chunk = bytes - offset;
+		/* I2C reads are limited to 255 bytes */
+		if (dev->dev_type == ADPD4101 && chunk > 255)
+			chunk = 255;
+		ret = adpd410x_reg_read_bytes(dev, ADPD410X_REG_FIFO_DATA,
+					      s->raw + offset, chunk);
+		if (ret != 0)
+			return ret;
+	}
+
+	adpd410x_fifo_unpack(s, data, *packets);
+
+	if (s->buf && *packets)
+		no_os_cb_write(s->buf, data,
+			       *packets * s->nb_ch * sizeof(*data));
+
+	/* Data above the threshold left in the FIFO raises no new edge. */
+	ret = adpd410x_reg_read(dev, ADPD410X_REG_FIFO_STATUS, &status);
+	if (ret != 0)
+		return ret;
+	if ((status & BITM_INT_STATUS_FIFO_FIFO_BYTE_COUNT) >= s->threshold)
+		s->pending = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop draining the FIFO and put the device in standby.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adpd410x_fifo_stream_stop(struct adpd410x_dev *dev)
+{
+	uint16_t reg_val;
+	int32_t ret;
+
+	if (!dev || !dev->fifo_stream)
+		return -EINVAL;
+
+	ret = adpd410x_set_opmode(dev, ADPD410X_STANDBY);
+	if (ret != 0)
+		return ret;
+
+	ret = adpd410x_reg_read(dev, ADPD410X_REG_INT_ENABLE_XD, &reg_val);
+	if (ret != 0)
+		return ret;
+	ret = adpd410x_reg_write(dev, ADPD410X_REG_INT_ENABLE_XD,
+				 reg_val & ~ADPD410X_FIFO_STREAM_INTS);
+	if (ret != 0)
+		return ret;
+
+	no_os_free(dev->fifo_stream);
+	dev->fifo_stream = NULL;
+
+	return 0;
+}
+
 /**
  * @brief Setup the device and the driver.
  * @param device - Pointer to the device handler.
@@ -778,6 +1080,12 @@ int32_t adpd410x_remove(struct adpd410x_dev *dev)
 	if(!dev)
 		return -EINVAL;
 
+	if (dev->fifo_stream) {
+		ret = adpd410x_fifo_stream_stop(dev);
+		if (ret != 0)
+			return ret;
+	}
+
 	if(dev->dev_type == ADPD4100)
 		ret = no_os_spi_remove(dev->dev_ops.spi_phy_dev);
 	else
@@ -47,6 +47,7 @@
 #include "no_os_spi.h"
 #include "no_os_i2c.h"
 #include "no_os_gpio.h"
+#include "no_os_circular_buffer.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -876,6 +877,11 @@
 #define ADPD410X_MAX_PULSE_LENGTH           255
 #define ADPD410X_MAX_INTEG_OS               255
 #define ADPD410X_FIFO_DEPTH                 512
+#define ADPD410X_MAX_FIFO_CH                (2 * ADPD410X_MAX_SLOT_NUMBER)
+/* GPIO_PIN_CFGx value of a push-pull output */
+#define ADPD410X_GPIO_CFG_OUTPUT            0x2
+/* GPIOOUTx value routing the INTX interrupt to the pin */
+#define ADPD410X_GPIOOUT_INTX               0x2
 #define ADPD410X_MAX_SAMPLING_FREQ          9000
 
 #define ADPD410X_UPPDER_BYTE_SPI_MASK			0x7f80
@@ -1177,6 +1183,44 @@ struct adpd410x_init_param {
 	uint32_t ext_lfo_freq;
 };
 
+/**
+ * @struct adpd410x_fifo_stream_init_param
+ * @brief Interrupt driven FIFO drain parameters
+ */
+struct adpd410x_fifo_stream_init_param {
+	/** Device GPIO (0 to 3) the INTX interrupt is routed to */
+	uint8_t int_gpio;
+	/** Number of packets in the FIFO that raise the interrupt */
+	uint16_t packets;
+	/** Optional buffer, e.g. of an IIO device, receiving the samples */
+	struct no_os_circular_buffer *buf;
+};
+
+/**
+ * @struct adpd410x_fifo_stream
+ * @brief Interrupt driven FIFO drain descriptor
+ */
+struct adpd410x_fifo_stream {
+	/** Bytes read from the FIFO in one burst */
+	uint8_t raw[ADPD410X_FIFO_DEPTH];
+	/** Bytes of each sample of a packet, in FIFO order */
+	uint8_t width[ADPD410X_MAX_FIFO_CH];
+	/** Number of samples in a packet */
+	uint8_t nb_ch;
+	/** Width shared by all the samples, 0 if they differ */
+	uint8_t common_width;
+	/** Bytes in a packet */
+	uint16_t packet_size;
+	/** FIFO threshold, in bytes */
+	uint16_t threshold;
+	/** Buffer receiving the samples, may be NULL */
+	struct no_os_circular_buffer *buf;
+	/** Set by the interrupt, cleared by the drain */
+	volatile bool pending;
+	/** Number of FIFO overflows seen */
+	uint32_t overflows;
+};
+
 /**
  * @struct adpd410x_dev
  * @brief Device driver handler
@@ -1198,6 +1242,8 @@ struct adpd410x_dev {
 	struct no_os_gpio_desc *gpio3;
 	/** External low frequency oscillator frequency, if applicable */
 	uint32_t ext_lfo_freq;
+	/** Interrupt driven FIFO drain, NULL when not running */
+	struct adpd410x_fifo_stream *fifo_stream;
 };
 
 /******************************************************************************/
@@ -1264,6 +1310,20 @@ int32_t adpd410x_read_fifo(struct adpd410x_dev *dev, uint32_t *data,
  *  slots. */
 int32_t adpd410x_get_data(struct adpd410x_dev *dev, uint32_t *data);
 
+/** Start draining the FIFO on its threshold interrupt. */
+int32_t adpd410x_fifo_stream_start(struct adpd410x_dev *dev,
+				   struct adpd410x_fifo_stream_init_param *param);
+
+/** FIFO threshold interrupt handler. */
+void adpd410x_fifo_stream_irq(void *dev);
+
+/** Read the whole FIFO in one burst and unpack its packets. */
+int32_t adpd410x_fifo_stream_drain(struct adpd410x_dev *dev, uint32_t *data,
+				   uint16_t max_packets, uint16_t *packets);
+
+/** Stop draining the FIFO. */
+int32_t adpd410x_fifo_stream_stop(struct adpd410x_dev *dev);
+
 /** Setup the device and the driver. */
 int32_t adpd410x_setup(struct adpd410x_dev **device,
 		       struct adpd410x_init_param *init_param);
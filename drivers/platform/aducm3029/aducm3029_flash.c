@@ -50,6 +50,8 @@
 #include "aducm3029_flash.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "aducm3029_pwr.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -67,12 +69,83 @@ struct adicup_flash_dev {
 	/** Buffer to read one flash page */
 	uint32_t temp_ptr[FLASH_PAGE_SIZE_WORDS] __attribute__ ((aligned (sizeof(
 				uint32_t))));
+	/** A page write is in progress */
+	bool busy;
 };
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * Wait for the end of the page write in progress, if any. The core sleeps
+ * until the completion interrupt of the flash controller.
+ *
+ * @param [in] adicup_extra - Pointer to the flash controller handler.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t flash_wait(struct adicup_flash_dev *adicup_extra)
+{
+	uint32_t fee_hw_error, state;
+	bool done = false;
+	int32_t ret;
+
+	if (!adicup_extra->busy)
+		return 0;
+
+	do {
+		state = no_os_critical_enter();
+		ret = adi_fee_IsBufferAvailable(adicup_extra->instance, &done);
+		if (ret == ADI_FEE_SUCCESS && !done)
+			aducm3029_pwr_sleep(ADUCM3029_PWR_FLEXI);
+		no_os_critical_exit(state);
+	} while (ret == ADI_FEE_SUCCESS && !done);
+
+	adicup_extra->busy = false;
+
+	ret = adi_fee_GetBuffer(adicup_extra->instance, &fee_hw_error);
+	if (ret != ADI_FEE_SUCCESS || fee_hw_error)
+		return -1;
+
+	return 0;
+}
+
+/**
+ * Start the DMA write of a page, the flash controller interrupts at the end of
+ * the transfer. Waits for the previous page write, if any.
+ *
+ * @param [in] dev     - Pointer to the flash device handler.
+ * @param [in] page_no - Page number, the page has to be erased.
+ * @param [in] data    - Page data, in SRAM, kept until flash_wait().
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t flash_submit_page(struct no_os_flash_dev *dev, int32_t page_no,
+				 uint32_t *data)
+{
+	ADI_FEE_TRANSACTION transaction;
+	struct adicup_flash_dev *adicup_extra = dev->extra;
+	int32_t ret;
+
+	ret = flash_wait(adicup_extra);
+	if (ret)
+		return ret;
+
+	transaction.bUseDma = true;
+	transaction.nSize = FLASH_PAGE_SIZE_BYTES;
+	transaction.pWriteAddr = (uint32_t *)(page_no << FLASH_PAGE_ADDR_SHIFT);
+	transaction.pWriteData = data;
+
+	ret = adi_fee_SubmitBuffer(adicup_extra->instance, &transaction);
+	if (ret != ADI_FEE_SUCCESS)
+		return -1;
+
+	adicup_extra->busy = true;
+
+	return 0;
+}
+
 /**
  * Initialize flash controller.
  *
@@ -138,6 +211,8 @@ int32_t no_os_flash_remove(struct no_os_flash_dev *dev)
 
 	adicup_extra = dev->extra;
 
+	flash_wait(adicup_extra);
+
 	ret = adi_fee_Close(adicup_extra->instance);
 	if (ret != ADI_FEE_SUCCESS)
 		return -1;
@@ -165,6 +240,10 @@ int32_t no_os_flash_clear_page(struct no_os_flash_dev *dev, int32_t page_no)
 	if (page_no > (dev->flash_size / dev->page_size))
 		return -1;
 
+	ret = flash_wait(adicup_extra);
+	if (ret)
+		return ret;
+
 	ret = adi_fee_PageErase(adicup_extra->instance, page_no, page_no,
 				&fee_hw_error);
 	if(ret != ADI_FEE_SUCCESS)
@@ -186,31 +265,24 @@ int32_t no_os_flash_clear_page(struct no_os_flash_dev *dev, int32_t page_no)
 int32_t no_os_flash_write_page(struct no_os_flash_dev *dev, int32_t page_no,
 			       uint32_t *data)
 {
-	ADI_FEE_TRANSACTION transaction;
-	struct adicup_flash_dev *adicup_extra = dev->extra;
-	uint32_t fee_hw_error;
 	int32_t ret;
 
 	if (page_no > (dev->flash_size / dev->page_size))
 		return -1;
 
-	transaction.bUseDma = true;
-	transaction.nSize = FLASH_PAGE_SIZE_BYTES;
-	transaction.pWriteAddr = (uint32_t *)(page_no << FLASH_PAGE_ADDR_SHIFT);
-	transaction.pWriteData = data;
-
-	ret = adi_fee_Write(adicup_extra->instance, &transaction,
-			    &fee_hw_error);
-	if(ret != ADI_FEE_SUCCESS)
-		return -1;
+	ret = flash_submit_page(dev, page_no, data);
+	if (ret)
+		return ret;
 
-	return 0;
+	return flash_wait(dev->extra);
 }
 
 /**
  * Read-modify-write helper function for no_os_flash_write(). Since the smallest write
  * unit for the ADuCM3029 is the page this function helps access data smaller than
  * a page or accross multiple pages.
+ * A whole page in SRAM is written from the caller buffer, without the copy.
+ * The write is only started, no_os_flash_write() waits for its end.
  */
 static int32_t flash_read_then_write(struct no_os_flash_dev *dev,
 				     uint32_t flash_addr,
@@ -218,6 +290,7 @@ static int32_t flash_read_then_write(struct no_os_flash_dev *dev,
 {
 	struct adicup_flash_dev *adicup_extra = dev->extra;
 	uint32_t page_nr, fee_hw_error;
+	uint32_t *data;
 	int32_t ret;
 
 	if ((flash_addr & 0x3) != 0)
@@ -226,12 +299,20 @@ static int32_t flash_read_then_write(struct no_os_flash_dev *dev,
 	    FLASH_PAGE_SIZE_WORDS)
 		return -1;
 
-	no_os_flash_read(dev, FLASH_ADDRESS_PAGE_START(flash_addr),
-			 adicup_extra->temp_ptr,
-			 FLASH_PAGE_SIZE_WORDS);
-
-	memcpy(adicup_extra->temp_ptr + FLASH_OFFSET_IN_PAGE(flash_addr), array,
-	       array_size * sizeof(uint32_t));
+	/* The controller can't read the flash it programs, copy such data */
+	if (array_size == FLASH_PAGE_SIZE_WORDS &&
+	    (uintptr_t)array >= ADUCM3029_FLASH_SIZE_BYTES) {
+		data = array;
+	} else {
+		/* no_os_flash_read() waits for temp_ptr to be written */
+		no_os_flash_read(dev, FLASH_ADDRESS_PAGE_START(flash_addr),
+				 adicup_extra->temp_ptr,
+				 FLASH_PAGE_SIZE_WORDS);
+
+		memcpy(adicup_extra->temp_ptr + FLASH_OFFSET_IN_PAGE(flash_addr), array,
+		       array_size * sizeof(uint32_t));
+		data = adicup_extra->temp_ptr;
+	}
 
 	/* Get the page number */
 	ret = adi_fee_GetPageNumber(adicup_extra->instance, flash_addr,
@@ -239,13 +320,17 @@ static int32_t flash_read_then_write(struct no_os_flash_dev *dev,
 	if(ret != ADI_FEE_SUCCESS)
 		return -1;
 
-	/* First erase page */
+	/* First erase page, once the previous one is written */
+	ret = flash_wait(adicup_extra);
+	if (ret)
+		return ret;
+
 	ret = adi_fee_PageErase(adicup_extra->instance, page_nr, page_nr,
 				&fee_hw_error);
 	if(ret != ADI_FEE_SUCCESS)
 		return -1;
 
-	return no_os_flash_write_page(dev, page_nr, adicup_extra->temp_ptr);
+	return flash_submit_page(dev, page_nr, data);
 }
 
 /**
@@ -261,20 +346,25 @@ static int32_t flash_read_then_write(struct no_os_flash_dev *dev,
 int32_t no_os_flash_write(struct no_os_flash_dev *dev, uint32_t flash_addr,
 			  uint32_t *array, uint32_t array_size)
 {
-	int32_t ret;
+	int32_t ret = 0;
 	uint32_t i, len;
 
 	i = 0;
 	while (i < array_size) {
-		len = FLASH_PAGE_SIZE_WORDS - FLASH_OFFSET_IN_PAGE(flash_addr + i);
+		len = FLASH_PAGE_SIZE_WORDS -
+		      FLASH_OFFSET_IN_PAGE(flash_addr + i * sizeof(uint32_t));
 		if (len > array_size - i)
 			len = array_size - i;
-		ret = flash_read_then_write(dev, flash_addr + i, array + i, len);
+		ret = flash_read_then_write(dev, flash_addr + i * sizeof(uint32_t),
+					    array + i, len);
 		if (ret != 0)
-			return -1;
+			break;
 		i += len;
 	}
 
+	if (flash_wait(dev->extra) || ret)
+		return -1;
+
 	return 0;
 }
 
@@ -292,6 +382,13 @@ int32_t no_os_flash_read(struct no_os_flash_dev *dev, uint32_t flash_addr,
 			 uint32_t *array,
 			 uint32_t size)
 {
+	int32_t ret;
+
+	/* Also frees temp_ptr, when a page is written from it */
+	ret = flash_wait(dev->extra);
+	if (ret)
+		return ret;
+
 	memcpy(array, (uint32_t *)flash_addr, size * sizeof(uint32_t));
 
 	return 0;
@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ *   @file   aducm3029_pwr.c
+ *   @brief  Low-power modes of the ADuCM302x used when the system is idle.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/************************* Include Files **************************************/
+/******************************************************************************/
+
+#include <stdbool.h>
+#include <sys/platform.h>
+#include "no_os_error.h"
+#include "no_os_mutex.h"
+#include "aducm3029_pwr.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Written to PWRKEY right before PWRMOD, which is locked otherwise */
+#define ADUCM3029_PWRKEY	0x4859u
+
+/******************************************************************************/
+/**************************** Global Variables ********************************/
+/******************************************************************************/
+
+/** Mode entered by no_os_wait_for_interrupt() */
+static enum aducm3029_pwr_mode idle_mode = ADUCM3029_PWR_FLEXI;
+/** The SRAM retention is set up for hibernate */
+static bool sram_retained;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Select the mode entered by no_os_wait_for_interrupt(), e.g. when
+ * passed as the idle hook of iio_app. Only an RTC alarm or an external
+ * interrupt ends hibernate, the UART of an IIO client does not.
+ * @param mode - The low-power mode.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int aducm3029_pwr_set_idle_mode(enum aducm3029_pwr_mode mode)
+{
+	if (mode != ADUCM3029_PWR_FLEXI && mode != ADUCM3029_PWR_HIBERNATE)
+		return -EINVAL;
+
+	idle_mode = mode;
+
+	return 0;
+}
+
+/**
+ * @brief Sleep in the given mode until an interrupt is pending.
+ * Meant to be called with the interrupts masked, like
+ * no_os_wait_for_interrupt(): the pending interrupt is served once they are
+ * unmasked.
+ * Hibernate retains the SRAM banks that can be retained (32 kB), the data and
+ * the stack of the application have to fit in them.
+ * @param mode - The low-power mode.
+ */
+void aducm3029_pwr_sleep(enum aducm3029_pwr_mode mode)
+{
+	if (mode == ADUCM3029_PWR_HIBERNATE) {
+		if (!sram_retained) {
+			adi_system_EnableRetention(ADI_SRAM_BANK_1, true);
+			adi_system_EnableRetention(ADI_SRAM_BANK_2, true);
+			sram_retained = true;
+		}
+		pADI_PMG0->PWRKEY = ADUCM3029_PWRKEY;
+		pADI_PMG0->PWRMOD = (pADI_PMG0->PWRMOD & ~BITM_PMG_PWRMOD_MODE) |
+				    ENUM_PMG_PWRMOD_HIBERNATE;
+		SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+	}
+
+	__DSB();
+	__WFI();
+
+	if (mode == ADUCM3029_PWR_HIBERNATE)
+		SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+}
+
+/**
+ * @brief Sleep until an interrupt is pending, in the mode selected by
+ * aducm3029_pwr_set_idle_mode(). Replaces the plain WFI of util/no_os_mutex.c.
+ */
+void no_os_wait_for_interrupt(void)
+{
+	aducm3029_pwr_sleep(idle_mode);
+}
@@ -47,6 +47,8 @@
 #include "aducm3029_rtc.h"
 #include "no_os_irq.h"
 #include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "aducm3029_pwr.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -193,3 +195,57 @@ int32_t no_os_rtc_set_cnt(struct no_os_rtc_desc *dev, uint32_t tmr_cnt)
 
 	return adi_rtc_SetCount(adev->instance, tmr_cnt);
 }
+
+/**
+ * @brief Set the time at which an interrupt will occur.
+ * The alarm interrupt also wakes the part up from hibernate.
+ * @param dev - The RTC descriptor.
+ * @param irq_time - Value of the counter at which the interrupt occurs.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t no_os_rtc_set_irq_time(struct no_os_rtc_desc *dev, uint32_t irq_time)
+{
+	struct aducm_rtc_desc *adev = dev->extra;
+
+	if (adi_rtc_SetAlarm(adev->instance, irq_time))
+		return -1;
+	if (adi_rtc_EnableAlarm(adev->instance, true))
+		return -1;
+
+	return adi_rtc_EnableInterrupts(adev->instance, ADI_RTC_ALARM_INT, true) ?
+	       -1 : 0;
+}
+
+/**
+ * @brief Sleep in the given low-power mode for a number of RTC ticks.
+ * The RTC alarm ends the sleep, other interrupts are served and the part goes
+ * back to sleep until the alarm. The RTC has to be started.
+ * @param dev - The RTC descriptor.
+ * @param ticks - Duration of the sleep, in periods of the RTC prescaler.
+ * @param mode - Low-power mode, ADUCM3029_PWR_HIBERNATE between measurements.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t aducm3029_rtc_sleep(struct no_os_rtc_desc *dev, uint32_t ticks,
+			    enum aducm3029_pwr_mode mode)
+{
+	uint32_t start, cnt, state;
+	int32_t ret;
+
+	ret = no_os_rtc_get_cnt(dev, &start);
+	if (ret)
+		return -1;
+
+	ret = no_os_rtc_set_irq_time(dev, start + ticks);
+	if (ret)
+		return ret;
+
+	do {
+		state = no_os_critical_enter();
+		ret = no_os_rtc_get_cnt(dev, &cnt);
+		if (!ret && cnt - start < ticks)
+			aducm3029_pwr_sleep(mode);
+		no_os_critical_exit(state);
+	} while (!ret && cnt - start < ticks);
+
+	return ret ? -1 : 0;
+}
@@ -45,6 +45,8 @@
 /******************************************************************************/
 
 #include <drivers/rtc/adi_rtc.h>
+#include "no_os_rtc.h"
+#include "aducm3029_pwr.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -84,4 +86,12 @@ struct aducm_rtc_desc {
 	void *memory;
 };
 
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Sleep in the given low-power mode for a number of RTC ticks. */
+int32_t aducm3029_rtc_sleep(struct no_os_rtc_desc *dev, uint32_t ticks,
+			    enum aducm3029_pwr_mode mode);
+
 #endif /* ADUCM3029_RTC_H_ */
@@ -0,0 +1,80 @@
+/***************************************************************************//**
+ *   @file   altera/altera_dcache.c
+ *   @brief  Implementation of Altera data cache maintenance functions.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <sys/alt_cache.h>
+#include "no_os_dma_buf.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Altera specific data cache write back function.
+ * @param addr - Start of the range.
+ * @param len - Length of the range in bytes.
+ */
+void no_os_dcache_flush_range(uintptr_t addr, uint32_t len)
+{
+	alt_dcache_flush((void *)addr, len);
+}
+
+/**
+ * @brief Altera specific data cache invalidate function.
+ * @param addr - Start of the range.
+ * @param len - Length of the range in bytes.
+ */
+void no_os_dcache_invalidate_range(uintptr_t addr, uint32_t len)
+{
+	alt_dcache_flush_no_writeback((void *)addr, len);
+}
+
+/**
+ * @brief Altera specific function returning the non-cacheable alias of a
+ * memory region.
+ * @param addr - Start of the region.
+ * @param len - Length of the region in bytes.
+ * @return The uncached alias of the region.
+ */
+void *no_os_dcache_map_uncached(void *addr, uint32_t len)
+{
+	return alt_remap_uncached(addr, len);
+}
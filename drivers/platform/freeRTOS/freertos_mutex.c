@@ -39,23 +39,21 @@
 
 #include <FreeRTOS.h>
 #include "no_os_mutex.h"
+#include "task.h"
 #include "semphr.h"
 #include "queue.h"
 
 /**
  * @brief Initialize mutex.
+ * The mutex uses priority inheritance, a low priority task holding a bus lock
+ * is raised to the priority of the highest task waiting for it.
  * mutex - Pointer toward the mutex.
  * @return None.
  */
 __attribute__((weak)) inline void no_os_mutex_init(void **mutex)
 {
-	if (*mutex == NULL) {
-		SemaphoreHandle_t* mutexTmp = (SemaphoreHandle_t *)no_os_calloc(1,
-					      sizeof(SemaphoreHandle_t));
-
-		*mutex = xSemaphoreCreateBinary();
-		xSemaphoreGive(*mutex);
-	}
+	if (*mutex == NULL)
+		*mutex = xSemaphoreCreateMutex();
 }
 
 /**
@@ -65,6 +63,9 @@ __attribute__((weak)) inline void no_os_mutex_init(void **mutex)
  */
 __attribute__((weak)) inline void no_os_mutex_lock(void *mutex)
 {
+	/* Mutexes cannot be taken from an ISR, use a spinlock there. */
+	configASSERT(!xPortIsInsideInterrupt());
+
 	if (mutex != NULL)
 		xSemaphoreTake((SemaphoreHandle_t)mutex, portMAX_DELAY);
 }
@@ -91,3 +92,21 @@ __attribute__((weak)) inline void no_os_mutex_remove(void *mutex)
 	}
 }
 
+/**
+ * @brief Enter a critical section, from a task or from an ISR.
+ * @return The interrupt mask before entering the critical section.
+ */
+uint32_t no_os_critical_enter(void)
+{
+	return (uint32_t)taskENTER_CRITICAL_FROM_ISR();
+}
+
+/**
+ * @brief Exit a critical section.
+ * @param state - The value returned by no_os_critical_enter().
+ * @return None.
+ */
+void no_os_critical_exit(uint32_t state)
+{
+	taskEXIT_CRITICAL_FROM_ISR((UBaseType_t)state);
+}
@@ -42,7 +42,10 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <time.h>
 #include <unistd.h>
+#include "no_os_delay.h"
+#include "no_os_profile.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -67,3 +70,41 @@ void no_os_mdelay(uint32_t msecs)
 {
 	usleep(msecs * 1000);
 }
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t;
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	t.s = ts.tv_sec;
+	t.us = ts.tv_nsec / 1000;
+
+	return t;
+}
+
+/**
+ * @brief Read the cycle counter, CLOCK_MONOTONIC in nanoseconds.
+ * @return The counter value.
+ */
+uint32_t no_os_get_cycles(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint32_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief Get the frequency of the counter read by no_os_get_cycles().
+ * @return The frequency in Hz.
+ */
+uint32_t no_os_get_cycles_freq(void)
+{
+	return 1000000000;
+}
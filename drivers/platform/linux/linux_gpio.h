@@ -39,9 +39,30 @@
 #ifndef LINUX_GPIO_H_
 #define LINUX_GPIO_H_
 
+#include "no_os_irq.h"
+
 /**
  * @brief Linux specific GPIO platform ops structure
  */
 extern const struct no_os_gpio_platform_ops linux_gpio_ops;
 
+/**
+ * @brief Linux specific GPIO platform ops structure using the GPIO character
+ * devices, port is the number of /dev/gpiochipN and number the line offset.
+ * The lines of a chip are held with one request, the port ops access several
+ * lines with one ioctl.
+ */
+extern const struct no_os_gpio_platform_ops linux_gpio_cdev_ops;
+
+/**
+ * @brief Linux specific IRQ platform ops structure, the edge events of the
+ * lines of /dev/gpiochipN, N being the irq_ctrl_id and the line offset the
+ * irq_id. A line used as interrupt can't be obtained as GPIO.
+ */
+extern const struct no_os_irq_platform_ops linux_gpio_irq_ops;
+
+/* Kernel timestamp of the last edge event of a line of linux_gpio_irq_ops. */
+int32_t linux_gpio_irq_get_timestamp(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id, uint64_t *timestamp_ns);
+
 #endif // LINUX_GPIO_H_
@@ -0,0 +1,1235 @@
+/***************************************************************************//**
+ *   @file   linux/linux_gpio_cdev.c
+ *   @brief  GPIO and IRQ ops for the GPIO character devices of Linux.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "no_os_error.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "linux_gpio.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/gpio.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Consumer name of the requested lines, shown by gpioinfo */
+#define LINUX_GPIO_CONSUMER	"no-OS"
+/** Edge events read by the IRQ worker with one read() */
+#define LINUX_GPIO_IRQ_EVENTS	16
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_gpio_chip
+ * @brief The lines of a GPIO chip held with one line request.
+ */
+struct linux_gpio_chip {
+	/** Port of the lines, the chip is /dev/gpiochip"port" */
+	int32_t port;
+	/** /dev/gpiochip"port" file descriptor */
+	int chip_fd;
+	/** File descriptor of the line request, -1 if none */
+	int req_fd;
+	/** Number of requested lines */
+	uint32_t nb_lines;
+	/** Offsets of the lines, in the order of the request */
+	uint32_t offsets[GPIO_V2_LINES_MAX];
+	/** Configuration flags of each line */
+	uint64_t flags[GPIO_V2_LINES_MAX];
+	/** Output values, bit i is the value of offsets[i] */
+	uint64_t values;
+	/** Next chip with requested lines */
+	struct linux_gpio_chip *next;
+};
+
+/**
+ * @struct linux_gpio_irq_line
+ * @brief A line of a GPIO chip used as interrupt source.
+ */
+struct linux_gpio_irq_line {
+	/** Offset of the line in the chip */
+	uint32_t offset;
+	/** Edges reported, one of the NO_OS_IRQ_EDGE_* levels */
+	enum no_os_irq_trig_level trig;
+	/** Set while the edge events of the line are reported */
+	bool enabled;
+	/** Callback of the edge events */
+	struct no_os_callback_desc cb;
+	/** Kernel timestamp of the last edge event, CLOCK_MONOTONIC ns */
+	uint64_t timestamp_ns;
+};
+
+/**
+ * @struct linux_gpio_irq_desc
+ * @brief Linux platform specific GPIO interrupt controller descriptor
+ */
+struct linux_gpio_irq_desc {
+	/** /dev/gpiochip"irq_ctrl_id" file descriptor */
+	int chip_fd;
+	/** File descriptor of the line request, -1 if none */
+	int req_fd;
+	/** Incremented each time the lines are requested again */
+	uint32_t req_gen;
+	/** Number of lines with a registered callback */
+	uint32_t nb_lines;
+	/** Lines with a registered callback */
+	struct linux_gpio_irq_line lines[GPIO_V2_LINES_MAX];
+	/** Cleared to hold the callbacks of all the lines */
+	bool global_enabled;
+	/** Set to stop the worker thread */
+	bool stop;
+	/** Pipe waking up the worker when req_fd changes or on remove */
+	int wake_fds[2];
+	/** Worker thread waiting for the edge events */
+	pthread_t worker;
+	/** Protects the fields above */
+	pthread_mutex_t lock;
+};
+
+/** Chips with lines requested as GPIOs */
+static struct linux_gpio_chip *linux_gpio_chips;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Open a GPIO chip.
+ * @param port - Number of the chip, /dev/gpiochip"port".
+ * @return The file descriptor of the chip, negative error code otherwise.
+ */
+static int linux_gpio_chip_open(uint32_t port)
+{
+	char path[32];
+	int fd;
+
+	sprintf(path, "/dev/gpiochip%u", port);
+	fd = open(path, O_RDWR | O_CLOEXEC);
+	if (fd < 0) {
+		printf("%s: Can't open %s\n\r", __func__, path);
+		return -errno;
+	}
+
+	return fd;
+}
+
+/**
+ * @brief Build the configuration of a line request.
+ *
+ * The lines with the flags of the first line use the default flags of the
+ * configuration, every other set of flags takes an attribute, one attribute is
+ * kept for the output values.
+ * @param flags - Configuration flags of each line.
+ * @param nb_lines - Number of lines, 1 at least.
+ * @param values - Output values, bit i is the value of line i.
+ * @param cfg - The configuration.
+ * @return 0 in case of success, -ENOSPC if the lines use too many flag sets.
+ */
+static int32_t linux_gpio_line_config(const uint64_t *flags, uint32_t nb_lines,
+				      uint64_t values,
+				      struct gpio_v2_line_config *cfg)
+{
+	uint64_t outputs = 0;
+	uint32_t i, j;
+
+	memset(cfg, 0, sizeof(*cfg));
+	cfg->flags = flags[0];
+
+	for (i = 0; i < nb_lines; i++) {
+		if (flags[i] & GPIO_V2_LINE_FLAG_OUTPUT)
+			outputs |= 1ULL << i;
+		if (flags[i] == cfg->flags)
+			continue;
+
+		for (j = 0; j < cfg->num_attrs; j++)
+			if (cfg->attrs[j].attr.flags == flags[i])
+				break;
+		if (j == cfg->num_attrs) {
+			if (j == GPIO_V2_LINE_NUM_ATTRS_MAX - 1)
+				return -ENOSPC;
+			cfg->attrs[j].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+			cfg->attrs[j].attr.flags = flags[i];
+			cfg->num_attrs++;
+		}
+		cfg->attrs[j].mask |= 1ULL << i;
+	}
+
+	if (outputs) {
+		j = cfg->num_attrs++;
+		cfg->attrs[j].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		cfg->attrs[j].attr.values = values;
+		cfg->attrs[j].mask = outputs;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Release the lines of a chip and request them again, in one request.
+ *
+ * A line can't be held by two requests, the previous request is released
+ * first, the output values are restored by the new one.
+ * @param chip_fd - File descriptor of the chip.
+ * @param req_fd - File descriptor of the request, updated, -1 if none.
+ * @param offsets - Offsets of the lines.
+ * @param flags - Configuration flags of each line.
+ * @param nb_lines - Number of lines, none only releases the request.
+ * @param values - Output values, bit i is the value of line i.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_request(int chip_fd, int *req_fd,
+				  const uint32_t *offsets, const uint64_t *flags,
+				  uint32_t nb_lines, uint64_t values)
+{
+	struct gpio_v2_line_request req;
+	int32_t ret;
+
+	if (*req_fd >= 0) {
+		close(*req_fd);
+		*req_fd = -1;
+	}
+
+	if (!nb_lines)
+		return 0;
+
+	memset(&req, 0, sizeof(req));
+	memcpy(req.offsets, offsets, nb_lines * sizeof(*offsets));
+	strncpy(req.consumer, LINUX_GPIO_CONSUMER, sizeof(req.consumer) - 1);
+	req.num_lines = nb_lines;
+
+	ret = linux_gpio_line_config(flags, nb_lines, values, &req.config);
+	if (ret)
+		return ret;
+
+	if (ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req) < 0) {
+		printf("%s: Can't request the lines\n\r", __func__);
+		return -errno;
+	}
+
+	*req_fd = req.fd;
+
+	return 0;
+}
+
+/**
+ * @brief Request the lines of a chip again.
+ * @param chip - The chip.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_chip_request(struct linux_gpio_chip *chip)
+{
+	return linux_gpio_request(chip->chip_fd, &chip->req_fd, chip->offsets,
+				  chip->flags, chip->nb_lines, chip->values);
+}
+
+/**
+ * @brief Change the configuration of the lines of a chip, they stay requested.
+ * @param chip - The chip.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_chip_config(struct linux_gpio_chip *chip)
+{
+	struct gpio_v2_line_config cfg;
+	int32_t ret;
+
+	ret = linux_gpio_line_config(chip->flags, chip->nb_lines, chip->values,
+				     &cfg);
+	if (ret)
+		return ret;
+
+	if (ioctl(chip->req_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &cfg) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Index of a line in the request of its chip.
+ * @param chip - The chip.
+ * @param offset - Offset of the line.
+ * @return The index of the line, -ENOENT if the line isn't requested.
+ */
+static int32_t linux_gpio_line_index(struct linux_gpio_chip *chip,
+				     uint32_t offset)
+{
+	uint32_t i;
+
+	for (i = 0; i < chip->nb_lines; i++)
+		if (chip->offsets[i] == offset)
+			return i;
+
+	return -ENOENT;
+}
+
+/**
+ * @brief Release a line of a chip, the chip is closed with its last line.
+ * @param chip - The chip.
+ * @param index - Index of the line in the request of the chip.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_chip_del_line(struct linux_gpio_chip *chip,
+					uint32_t index)
+{
+	struct linux_gpio_chip **p;
+	uint64_t low, high;
+	uint32_t i;
+
+	for (i = index; i + 1 < chip->nb_lines; i++) {
+		chip->offsets[i] = chip->offsets[i + 1];
+		chip->flags[i] = chip->flags[i + 1];
+	}
+	low = chip->values & ((1ULL << index) - 1);
+	high = index < 63 ? (chip->values >> (index + 1)) << index : 0;
+	chip->values = low | high;
+	chip->nb_lines--;
+
+	if (chip->nb_lines)
+		return linux_gpio_chip_request(chip);
+
+	if (chip->req_fd >= 0)
+		close(chip->req_fd);
+	close(chip->chip_fd);
+
+	for (p = &linux_gpio_chips; *p != chip; p = &(*p)->next)
+		;
+	*p = chip->next;
+	no_os_free(chip);
+
+	return 0;
+}
+
+/**
+ * @brief Configuration flags of a line for a pull configuration.
+ * @param pull - Pull configuration of the line.
+ * @return The flags, the direction of a line without pull is left as is.
+ */
+static uint64_t linux_gpio_bias(enum no_os_gpio_pull_up pull)
+{
+	switch (pull) {
+	case NO_OS_PULL_UP:
+	case NO_OS_PULL_UP_WEAK:
+		return GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+	case NO_OS_PULL_DOWN:
+	case NO_OS_PULL_DOWN_WEAK:
+		return GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Obtain the GPIO decriptor.
+ *
+ * The lines of a chip are held with one request, it is released and made again
+ * each time a line of the chip is obtained or removed.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters, the port is the number of the
+ *		  chip and the number is the offset of the line in the chip.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_get(struct no_os_gpio_desc **desc,
+			    const struct no_os_gpio_init_param *param)
+{
+	struct no_os_gpio_desc *descriptor;
+	struct linux_gpio_chip *chip;
+	uint32_t i;
+	int32_t ret;
+
+	if (!desc || !param || param->port < 0 || param->number < 0)
+		return -EINVAL;
+
+	for (chip = linux_gpio_chips; chip; chip = chip->next)
+		if (chip->port == param->port)
+			break;
+
+	if (chip) {
+		if (linux_gpio_line_index(chip, param->number) >= 0)
+			return -EBUSY;
+		if (chip->nb_lines == GPIO_V2_LINES_MAX)
+			return -ENOSPC;
+	}
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	if (!chip) {
+		chip = no_os_calloc(1, sizeof(*chip));
+		if (!chip) {
+			ret = -ENOMEM;
+			goto free_desc;
+		}
+
+		chip->port = param->port;
+		chip->req_fd = -1;
+		chip->chip_fd = linux_gpio_chip_open(param->port);
+		if (chip->chip_fd < 0) {
+			ret = chip->chip_fd;
+			no_os_free(chip);
+			goto free_desc;
+		}
+
+		chip->next = linux_gpio_chips;
+		linux_gpio_chips = chip;
+	}
+
+	i = chip->nb_lines++;
+	chip->offsets[i] = param->number;
+	chip->flags[i] = linux_gpio_bias(param->pull);
+	chip->values &= ~(1ULL << i);
+
+	ret = linux_gpio_chip_request(chip);
+	if (ret) {
+		linux_gpio_chip_del_line(chip, i);
+		goto free_desc;
+	}
+
+	descriptor->port = param->port;
+	descriptor->number = param->number;
+	descriptor->pull = param->pull;
+	descriptor->platform_ops = param->platform_ops;
+	descriptor->extra = chip;
+	*desc = descriptor;
+
+	return 0;
+
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Get the value of an optional GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_get_optional(struct no_os_gpio_desc **desc,
+				     const struct no_os_gpio_init_param *param)
+{
+	if (param == NULL) {
+		*desc = NULL;
+		return 0;
+	}
+
+	return linux_gpio_cdev_get(desc, param);
+}
+
+/**
+ * @brief Free the resources allocated by linux_gpio_cdev_get().
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_remove(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpio_chip *chip;
+	int32_t index;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	chip = desc->extra;
+	index = linux_gpio_line_index(chip, desc->number);
+	if (index < 0)
+		return index;
+
+	ret = linux_gpio_chip_del_line(chip, index);
+	no_os_free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Enable the input direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_direction_input(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	int32_t index;
+
+	index = linux_gpio_line_index(chip, desc->number);
+	if (index < 0)
+		return index;
+
+	chip->flags[index] &= ~GPIO_V2_LINE_FLAG_OUTPUT;
+	chip->flags[index] |= GPIO_V2_LINE_FLAG_INPUT;
+
+	return linux_gpio_chip_config(chip);
+}
+
+/**
+ * @brief Enable the output direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	int32_t index;
+
+	index = linux_gpio_line_index(chip, desc->number);
+	if (index < 0)
+		return index;
+
+	chip->flags[index] &= ~GPIO_V2_LINE_FLAG_INPUT;
+	chip->flags[index] |= GPIO_V2_LINE_FLAG_OUTPUT;
+	if (value)
+		chip->values |= 1ULL << index;
+	else
+		chip->values &= ~(1ULL << index);
+
+	return linux_gpio_chip_config(chip);
+}
+
+/**
+ * @brief Get the direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ *                    Example: NO_OS_GPIO_OUT
+ *                             NO_OS_GPIO_IN
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_get_direction(struct no_os_gpio_desc *desc,
+				      uint8_t *direction)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct gpio_v2_line_info info;
+
+	memset(&info, 0, sizeof(info));
+	info.offset = desc->number;
+	if (ioctl(chip->chip_fd, GPIO_V2_GET_LINEINFO_IOCTL, &info) < 0)
+		return -errno;
+
+	if (info.flags & GPIO_V2_LINE_FLAG_OUTPUT)
+		*direction = NO_OS_GPIO_OUT;
+	else
+		*direction = NO_OS_GPIO_IN;
+
+	return 0;
+}
+
+/**
+ * @brief Set the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_set_value(struct no_os_gpio_desc *desc, uint8_t value)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct gpio_v2_line_values values;
+	int32_t index;
+
+	index = linux_gpio_line_index(chip, desc->number);
+	if (index < 0)
+		return index;
+
+	values.mask = 1ULL << index;
+	values.bits = value ? values.mask : 0;
+	if (ioctl(chip->req_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0)
+		return -errno;
+
+	chip->values = (chip->values & ~values.mask) | values.bits;
+
+	return 0;
+}
+
+/**
+ * @brief Get the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_get_value(struct no_os_gpio_desc *desc, uint8_t *value)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct gpio_v2_line_values values;
+	int32_t index;
+
+	index = linux_gpio_line_index(chip, desc->number);
+	if (index < 0)
+		return index;
+
+	values.mask = 1ULL << index;
+	values.bits = 0;
+	if (ioctl(chip->req_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+		return -errno;
+
+	*value = values.bits ? NO_OS_GPIO_HIGH : NO_OS_GPIO_LOW;
+
+	return 0;
+}
+
+/**
+ * @brief Lines of the request of a chip selected by a port mask.
+ * @param chip - The chip.
+ * @param mask - Lines of the chip, bit n is the line at offset n.
+ * @param req_mask - The lines, bit i is the line at index i of the request.
+ * @return 0 in case of success, -EINVAL if a line isn't requested.
+ */
+static int32_t linux_gpio_port_mask(struct linux_gpio_chip *chip, uint32_t mask,
+				    uint64_t *req_mask)
+{
+	uint32_t found = 0;
+	uint32_t i;
+
+	*req_mask = 0;
+	for (i = 0; i < chip->nb_lines; i++) {
+		if (chip->offsets[i] >= 32 || !(mask & NO_OS_BIT(chip->offsets[i])))
+			continue;
+		*req_mask |= 1ULL << i;
+		found |= NO_OS_BIT(chip->offsets[i]);
+	}
+
+	return found == mask ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Set the masked lines of the chip of a GPIO with one ioctl.
+ * @param desc - Descriptor of any requested line of the chip.
+ * @param mask - Lines to be set, bit n is the line at offset n.
+ * @param value - New values of the masked lines.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_port_set_value(struct no_os_gpio_desc *desc,
+				       uint32_t mask, uint32_t value)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct gpio_v2_line_values values;
+	uint64_t req_mask;
+	uint32_t i;
+	int32_t ret;
+
+	ret = linux_gpio_port_mask(chip, mask, &req_mask);
+	if (ret)
+		return ret;
+
+	values.mask = req_mask;
+
+	values.bits = 0;
+	for (i = 0; i < chip->nb_lines; i++)
+		if ((values.mask & (1ULL << i)) &&
+		    (value & NO_OS_BIT(chip->offsets[i])))
+			values.bits |= 1ULL << i;
+
+	if (ioctl(chip->req_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) < 0)
+		return -errno;
+
+	chip->values = (chip->values & ~values.mask) | values.bits;
+
+	return 0;
+}
+
+/**
+ * @brief Get the masked lines of the chip of a GPIO with one ioctl.
+ * @param desc - Descriptor of any requested line of the chip.
+ * @param mask - Lines to be read, bit n is the line at offset n.
+ * @param value - Values of the masked lines, the other bits are cleared.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_port_get_value(struct no_os_gpio_desc *desc,
+				       uint32_t mask, uint32_t *value)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct gpio_v2_line_values values;
+	uint64_t req_mask;
+	uint32_t i;
+	int32_t ret;
+
+	ret = linux_gpio_port_mask(chip, mask, &req_mask);
+	if (ret)
+		return ret;
+
+	values.mask = req_mask;
+
+	values.bits = 0;
+	if (ioctl(chip->req_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0)
+		return -errno;
+
+	*value = 0;
+	for (i = 0; i < chip->nb_lines; i++)
+		if (values.bits & values.mask & (1ULL << i))
+			*value |= NO_OS_BIT(chip->offsets[i]);
+
+	return 0;
+}
+
+/**
+ * @brief Wake up the IRQ worker, it polls the current line request again.
+ * @param irq - The interrupt controller.
+ */
+static void linux_gpio_irq_wake(struct linux_gpio_irq_desc *irq)
+{
+	char c = 0;
+
+	/* A full pipe wakes the worker up as well */
+	if (write(irq->wake_fds[1], &c, 1) < 0)
+		return;
+}
+
+/**
+ * @brief Apply the configuration of the interrupt lines, called locked.
+ * @param irq - The interrupt controller.
+ * @param lines_changed - Set if a line was added or removed, the lines are
+ *			  requested again, only their configuration is changed
+ *			  otherwise.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_update(struct linux_gpio_irq_desc *irq,
+				     bool lines_changed)
+{
+	uint32_t offsets[GPIO_V2_LINES_MAX];
+	uint64_t flags[GPIO_V2_LINES_MAX];
+	struct gpio_v2_line_config cfg;
+	struct linux_gpio_irq_line *line;
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < irq->nb_lines; i++) {
+		line = &irq->lines[i];
+		offsets[i] = line->offset;
+		flags[i] = GPIO_V2_LINE_FLAG_INPUT;
+		if (!line->enabled)
+			continue;
+		if (line->trig != NO_OS_IRQ_EDGE_FALLING)
+			flags[i] |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+		if (line->trig != NO_OS_IRQ_EDGE_RISING)
+			flags[i] |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	}
+
+	if (!lines_changed && irq->req_fd >= 0) {
+		ret = linux_gpio_line_config(flags, irq->nb_lines, 0, &cfg);
+		if (ret)
+			return ret;
+		if (ioctl(irq->req_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &cfg) < 0)
+			return -errno;
+
+		return 0;
+	}
+
+	ret = linux_gpio_request(irq->chip_fd, &irq->req_fd, offsets, flags,
+				 irq->nb_lines, 0);
+	irq->req_gen++;
+	linux_gpio_irq_wake(irq);
+
+	return ret;
+}
+
+/**
+ * @brief Find an interrupt line, called locked.
+ * @param irq - The interrupt controller.
+ * @param offset - Offset of the line.
+ * @return The line, NULL if it has no registered callback.
+ */
+static struct linux_gpio_irq_line *
+linux_gpio_irq_find(struct linux_gpio_irq_desc *irq, uint32_t offset)
+{
+	uint32_t i;
+
+	for (i = 0; i < irq->nb_lines; i++)
+		if (irq->lines[i].offset == offset)
+			return &irq->lines[i];
+
+	return NULL;
+}
+
+/**
+ * @brief Worker thread reading the edge events and calling the callbacks.
+ *
+ * The callbacks are called unlocked, they may use the interrupt controller.
+ * @param arg - The interrupt controller.
+ * @return NULL
+ */
+static void *linux_gpio_irq_worker(void *arg)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_EVENTS];
+	struct linux_gpio_irq_desc *irq = arg;
+	struct linux_gpio_irq_line *line;
+	struct no_os_callback_desc cb;
+	struct pollfd fds[2];
+	char drain[16];
+	uint32_t gen;
+	ssize_t len;
+	int i;
+
+	pthread_mutex_lock(&irq->lock);
+	while (!irq->stop) {
+		fds[0].fd = irq->req_fd;
+		fds[0].events = POLLIN;
+		fds[0].revents = 0;
+		fds[1].fd = irq->wake_fds[0];
+		fds[1].events = POLLIN;
+		fds[1].revents = 0;
+		gen = irq->req_gen;
+		pthread_mutex_unlock(&irq->lock);
+
+		poll(fds, 2, -1);
+		if (fds[1].revents & POLLIN)
+			while (read(irq->wake_fds[0], drain, sizeof(drain)) > 0)
+				;
+
+		pthread_mutex_lock(&irq->lock);
+		/* The request was made again meanwhile, its fd may be reused */
+		if (gen != irq->req_gen || !(fds[0].revents & POLLIN))
+			continue;
+
+		len = read(irq->req_fd, events, sizeof(events));
+		for (i = 0; i < len / (ssize_t)sizeof(events[0]); i++) {
+			line = linux_gpio_irq_find(irq, events[i].offset);
+			if (!line)
+				continue;
+
+			line->timestamp_ns = events[i].timestamp_ns;
+			if (!irq->global_enabled || !line->enabled ||
+			    !line->cb.callback)
+				continue;
+
+			cb = line->cb;
+			pthread_mutex_unlock(&irq->lock);
+			cb.callback(cb.ctx);
+			pthread_mutex_lock(&irq->lock);
+		}
+	}
+	pthread_mutex_unlock(&irq->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize a GPIO chip as interrupt controller.
+ *
+ * The edge events of the lines are read by a worker thread, the callbacks run
+ * on it. The interrupts are globally enabled after the initialization.
+ * @param desc - The interrupt controller descriptor.
+ * @param param - The initialization parameters, irq_ctrl_id is the number of
+ *		  the chip, /dev/gpiochip"irq_ctrl_id".
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_init(struct no_os_irq_ctrl_desc **desc,
+			    const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_gpio_irq_desc *irq;
+	int32_t ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	irq = no_os_calloc(1, sizeof(*irq));
+	if (!irq) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	irq->req_fd = -1;
+	irq->global_enabled = true;
+	irq->chip_fd = linux_gpio_chip_open(param->irq_ctrl_id);
+	if (irq->chip_fd < 0) {
+		ret = irq->chip_fd;
+		goto free_irq;
+	}
+
+	if (pipe(irq->wake_fds) < 0) {
+		ret = -errno;
+		goto close_chip;
+	}
+	fcntl(irq->wake_fds[0], F_SETFL, O_NONBLOCK);
+	fcntl(irq->wake_fds[1], F_SETFL, O_NONBLOCK);
+
+	if (pthread_mutex_init(&irq->lock, NULL)) {
+		ret = -ENOMEM;
+		goto close_pipe;
+	}
+
+	if (pthread_create(&irq->worker, NULL, linux_gpio_irq_worker, irq)) {
+		ret = -EAGAIN;
+		goto destroy_lock;
+	}
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->platform_ops = param->platform_ops;
+	descriptor->extra = irq;
+	*desc = descriptor;
+
+	return 0;
+
+destroy_lock:
+	pthread_mutex_destroy(&irq->lock);
+close_pipe:
+	close(irq->wake_fds[0]);
+	close(irq->wake_fds[1]);
+close_chip:
+	close(irq->chip_fd);
+free_irq:
+	no_os_free(irq);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by linux_gpio_irq_init().
+ * @param desc - The interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *irq;
+
+	if (!desc)
+		return -EINVAL;
+
+	irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->stop = true;
+	linux_gpio_irq_wake(irq);
+	pthread_mutex_unlock(&irq->lock);
+	pthread_join(irq->worker, NULL);
+	pthread_mutex_destroy(&irq->lock);
+
+	if (irq->req_fd >= 0)
+		close(irq->req_fd);
+	close(irq->wake_fds[0]);
+	close(irq->wake_fds[1]);
+	close(irq->chip_fd);
+	no_os_free(irq);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register the callback of the edge events of a line.
+ *
+ * The line is requested as input, it can't be used as GPIO meanwhile. Its
+ * events are reported once enabled, on the rising edge unless set otherwise.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @param callback - The callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *callback)
+{
+	struct linux_gpio_irq_desc *irq;
+	struct linux_gpio_irq_line *line;
+	int32_t ret = 0;
+
+	if (!desc || !callback)
+		return -EINVAL;
+
+	irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	line = linux_gpio_irq_find(irq, irq_id);
+	if (line) {
+		line->cb = *callback;
+		goto unlock;
+	}
+
+	if (irq->nb_lines == GPIO_V2_LINES_MAX) {
+		ret = -ENOSPC;
+		goto unlock;
+	}
+
+	line = &irq->lines[irq->nb_lines++];
+	memset(line, 0, sizeof(*line));
+	line->offset = irq_id;
+	line->trig = NO_OS_IRQ_EDGE_RISING;
+	line->cb = *callback;
+
+	ret = linux_gpio_irq_update(irq, true);
+	if (ret) {
+		irq->nb_lines--;
+		linux_gpio_irq_update(irq, true);
+	}
+unlock:
+	pthread_mutex_unlock(&irq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Unregister the callback of a line, the line is released.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @param callback - The callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *callback)
+{
+	struct linux_gpio_irq_desc *irq;
+	struct linux_gpio_irq_line *line;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	line = linux_gpio_irq_find(irq, irq_id);
+	if (!line) {
+		pthread_mutex_unlock(&irq->lock);
+		return -ENOENT;
+	}
+
+	*line = irq->lines[--irq->nb_lines];
+	ret = linux_gpio_irq_update(irq, true);
+	pthread_mutex_unlock(&irq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Call the callbacks of the enabled lines.
+ * @param desc - The interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->global_enabled = true;
+	pthread_mutex_unlock(&irq->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Hold the callbacks of all the lines, their events are dropped.
+ * @param desc - The interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	irq->global_enabled = false;
+	pthread_mutex_unlock(&irq->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Set the edges reported for a line.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @param trig - One of the NO_OS_IRQ_EDGE_* levels, the character device has
+ *		 no level interrupts.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	struct linux_gpio_irq_desc *irq = desc->extra;
+	struct linux_gpio_irq_line *line;
+	int32_t ret;
+
+	if (trig != NO_OS_IRQ_EDGE_FALLING && trig != NO_OS_IRQ_EDGE_RISING &&
+	    trig != NO_OS_IRQ_EDGE_BOTH)
+		return -EINVAL;
+
+	pthread_mutex_lock(&irq->lock);
+	line = linux_gpio_irq_find(irq, irq_id);
+	if (!line) {
+		pthread_mutex_unlock(&irq->lock);
+		return -ENOENT;
+	}
+
+	line->trig = trig;
+	ret = linux_gpio_irq_update(irq, false);
+	pthread_mutex_unlock(&irq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable or disable the edge events of a line.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @param enable - Enable the events if set, disable them otherwise.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_set_enabled(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id, bool enable)
+{
+	struct linux_gpio_irq_desc *irq = desc->extra;
+	struct linux_gpio_irq_line *line;
+	int32_t ret;
+
+	pthread_mutex_lock(&irq->lock);
+	line = linux_gpio_irq_find(irq, irq_id);
+	if (!line) {
+		pthread_mutex_unlock(&irq->lock);
+		return -ENOENT;
+	}
+
+	line->enabled = enable;
+	ret = linux_gpio_irq_update(irq, false);
+	pthread_mutex_unlock(&irq->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable the edge events of a line.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	return linux_gpio_irq_set_enabled(desc, irq_id, true);
+}
+
+/**
+ * @brief Disable the edge events of a line.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc,
+			       uint32_t irq_id)
+{
+	return linux_gpio_irq_set_enabled(desc, irq_id, false);
+}
+
+/**
+ * @brief Kernel timestamp of the last edge event of a line.
+ *
+ * Called from the callback, it is the time of the event being handled.
+ * @param desc - The interrupt controller descriptor.
+ * @param irq_id - Offset of the line in the chip.
+ * @param timestamp_ns - The CLOCK_MONOTONIC time of the event in ns, 0 if the
+ *			 line had no event yet.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_irq_get_timestamp(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id, uint64_t *timestamp_ns)
+{
+	struct linux_gpio_irq_desc *irq;
+	struct linux_gpio_irq_line *line;
+
+	if (!desc || !timestamp_ns)
+		return -EINVAL;
+
+	irq = desc->extra;
+
+	pthread_mutex_lock(&irq->lock);
+	line = linux_gpio_irq_find(irq, irq_id);
+	if (line)
+		*timestamp_ns = line->timestamp_ns;
+	pthread_mutex_unlock(&irq->lock);
+
+	return line ? 0 : -ENOENT;
+}
+
+/**
+ * @brief Linux platform specific GPIO platform ops structure, GPIO character
+ * device backend
+ */
+const struct no_os_gpio_platform_ops linux_gpio_cdev_ops = {
+	.gpio_ops_get = &linux_gpio_cdev_get,
+	.gpio_ops_get_optional = &linux_gpio_cdev_get_optional,
+	.gpio_ops_remove = &linux_gpio_cdev_remove,
+	.gpio_ops_direction_input = &linux_gpio_cdev_direction_input,
+	.gpio_ops_direction_output = &linux_gpio_cdev_direction_output,
+	.gpio_ops_get_direction = &linux_gpio_cdev_get_direction,
+	.gpio_ops_set_value = &linux_gpio_cdev_set_value,
+	.gpio_ops_get_value = &linux_gpio_cdev_get_value,
+	.gpio_ops_port_set_value = &linux_gpio_cdev_port_set_value,
+	.gpio_ops_port_get_value = &linux_gpio_cdev_port_get_value,
+};
+
+/**
+ * @brief Linux platform specific IRQ platform ops structure, edge events of
+ * the lines of a GPIO chip
+ */
+const struct no_os_irq_platform_ops linux_gpio_irq_ops = {
+	.init = &linux_gpio_irq_init,
+	.register_callback = &linux_gpio_irq_register_callback,
+	.unregister_callback = &linux_gpio_irq_unregister_callback,
+	.global_enable = &linux_gpio_irq_global_enable,
+	.global_disable = &linux_gpio_irq_global_disable,
+	.trigger_level_set = &linux_gpio_irq_trigger_level_set,
+	.enable = &linux_gpio_irq_enable,
+	.disable = &linux_gpio_irq_disable,
+	.remove = &linux_gpio_irq_remove,
+};
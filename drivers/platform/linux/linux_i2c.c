@@ -46,11 +46,14 @@
 #include "no_os_alloc.h"
 #include "linux_i2c.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
 /******************************************************************************/
@@ -64,6 +67,10 @@
 struct linux_i2c_desc {
 	/** /dev/i2c-"device_id" file descriptor */
 	int fd;
+	/** Set once a slave address was selected on fd */
+	bool selected;
+	/** Slave address selected on fd */
+	uint8_t slave_address;
 };
 
 /******************************************************************************/
@@ -88,7 +95,7 @@ int32_t linux_i2c_init(struct no_os_i2c_desc **desc,
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_i2c_desc*) no_os_malloc(sizeof(
+	linux_desc = (struct linux_i2c_desc*) no_os_calloc(1, sizeof(
 				struct linux_i2c_desc));
 	if (!linux_desc)
 		goto free_desc;
@@ -118,6 +125,31 @@ free_desc:
 	return -1;
 }
 
+/**
+ * @brief Select the slave address of the descriptor on its file, unless it
+ * already is.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, -1 otherwise.
+ */
+static int32_t linux_i2c_select(struct no_os_i2c_desc *desc)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+
+	if (linux_desc->selected &&
+	    linux_desc->slave_address == desc->slave_address)
+		return 0;
+
+	if (ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address) < 0) {
+		printf("%s: Can't select device\n\r", __func__);
+		return -1;
+	}
+
+	linux_desc->selected = true;
+	linux_desc->slave_address = desc->slave_address;
+
+	return 0;
+}
+
 /**
  * @brief Free the resources allocated by no_os_i2c_init().
  * @param desc - The I2C descriptor.
@@ -162,11 +194,9 @@ int32_t linux_i2c_write(struct no_os_i2c_desc *desc,
 
 	linux_desc = desc->extra;
 
-	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
-		return -1;
-	}
+	ret = linux_i2c_select(desc);
+	if (ret)
+		return ret;
 
 	ret = write(linux_desc->fd, data, bytes_number);
 	if (ret < 0) {
@@ -201,11 +231,9 @@ int32_t linux_i2c_read(struct no_os_i2c_desc *desc,
 
 	linux_desc = desc->extra;
 
-	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
-		return -1;
-	}
+	ret = linux_i2c_select(desc);
+	if (ret)
+		return ret;
 
 	ret = read(linux_desc->fd, data, bytes_number);
 	if (ret < 0) {
@@ -220,6 +248,51 @@ int32_t linux_i2c_read(struct no_os_i2c_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Transfer a list of messages joined by repeated starts, with a single
+ * I2C_RDWR ioctl.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_i2c_transfer(struct no_os_i2c_desc *desc,
+				  struct no_os_i2c_msg *msgs,
+				  uint32_t nb_msgs)
+{
+	struct i2c_msg i2c_msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+	struct i2c_rdwr_ioctl_data data = {
+		.msgs = i2c_msgs,
+		.nmsgs = nb_msgs,
+	};
+	struct linux_i2c_desc *linux_desc;
+	uint32_t i;
+	int32_t ret;
+
+	if (nb_msgs > I2C_RDWR_IOCTL_MAX_MSGS)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	for (i = 0; i < nb_msgs; i++) {
+		if (msgs[i].len > UINT16_MAX)
+			return -EINVAL;
+
+		i2c_msgs[i].addr = desc->slave_address;
+		i2c_msgs[i].flags = (msgs[i].flags & NO_OS_I2C_M_RD) ? I2C_M_RD : 0;
+		i2c_msgs[i].len = msgs[i].len;
+		i2c_msgs[i].buf = msgs[i].buf;
+	}
+
+	if (ioctl(linux_desc->fd, I2C_RDWR, &data) < 0) {
+		ret = -errno;
+		printf("%s: Can't transfer messages (%d)\n\r", __func__, ret);
+		return ret;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Linux platform specific I2C platform ops structure
  */
@@ -227,5 +300,6 @@ const struct no_os_i2c_platform_ops linux_i2c_ops = {
 	.i2c_ops_init = &linux_i2c_init,
 	.i2c_ops_write = &linux_i2c_write,
 	.i2c_ops_read = &linux_i2c_read,
+	.i2c_ops_transfer = &linux_i2c_transfer,
 	.i2c_ops_remove = &linux_i2c_remove
 };
@@ -46,7 +46,10 @@
 #include "no_os_alloc.h"
 #include "linux_spi.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/ioctl.h>
@@ -55,6 +58,13 @@
 
 #warning SPI cs_delay_first and cs_delay_last delays are not supported on the linux platform
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Message lists up to this size are converted on the stack */
+#define LINUX_SPI_STACK_MSGS	8
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -66,6 +76,24 @@
 struct linux_spi_desc {
 	/** /dev/spidev"device_id"."chip_select" file descriptor */
 	int spidev_fd;
+	/** Set once the worker thread of the asynchronous transfers runs */
+	bool worker_started;
+	/** Worker thread of the asynchronous transfers */
+	pthread_t worker;
+	/** Protects the asynchronous transfer fields below */
+	pthread_mutex_t lock;
+	/** Signals a new asynchronous transfer or the end of the worker */
+	pthread_cond_t cond;
+	/** Set to stop the worker thread */
+	bool stop;
+	/** Messages of the pending asynchronous transfer, NULL if none */
+	struct no_os_spi_msg *msgs;
+	/** Number of messages of the pending asynchronous transfer */
+	uint32_t len;
+	/** Called once the asynchronous transfer is done */
+	void (*callback)(void *);
+	/** Parameter for the callback */
+	void *ctx;
 };
 
 /******************************************************************************/
@@ -91,7 +119,7 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 	if (!descriptor)
 		return -1;
 
-	linux_desc = (struct linux_spi_desc*) no_os_malloc(sizeof(
+	linux_desc = (struct linux_spi_desc*) no_os_calloc(1, sizeof(
 				struct linux_spi_desc));
 	if (!linux_desc)
 		goto free_desc;
@@ -161,7 +189,7 @@ int32_t linux_spi_write_and_read(struct no_os_spi_desc *desc,
 	linux_desc = desc->extra;
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(1), &tr);
-	if (ret == 1) {
+	if (ret < 0) {
 		printf("%s: Can't send spi message\n\r", __func__);
 		return -1;
 	}
@@ -181,6 +209,16 @@ int32_t linux_spi_remove(struct no_os_spi_desc *desc)
 
 	linux_desc = desc->extra;
 
+	if (linux_desc->worker_started) {
+		pthread_mutex_lock(&linux_desc->lock);
+		linux_desc->stop = true;
+		pthread_cond_signal(&linux_desc->cond);
+		pthread_mutex_unlock(&linux_desc->lock);
+		pthread_join(linux_desc->worker, NULL);
+		pthread_cond_destroy(&linux_desc->cond);
+		pthread_mutex_destroy(&linux_desc->lock);
+	}
+
 	ret = close(linux_desc->spidev_fd);
 	if (ret < 0) {
 		printf("%s: Can't close device\n\r", __func__);
@@ -193,41 +231,164 @@ int32_t linux_spi_remove(struct no_os_spi_desc *desc)
 	return 0;
 }
 
-static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
-				  struct no_os_spi_msg *msgs,
-				  uint32_t len)
-
+/**
+ * @brief Send a list of messages with a single SPI_IOC_MESSAGE ioctl.
+ * @param linux_desc - The Linux SPI descriptor.
+ * @param msgs - The messages to transfer.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_spi_ioc_message(struct linux_spi_desc *linux_desc,
+				     struct no_os_spi_msg *msgs,
+				     uint32_t len)
 {
-	struct spi_ioc_transfer *tr;
-	struct linux_spi_desc	*linux_desc;
+	struct spi_ioc_transfer stack_tr[LINUX_SPI_STACK_MSGS] = {0};
+	struct spi_ioc_transfer *tr = stack_tr;
 	int			ret;
 	uint32_t		i;
 
-	linux_desc = desc->extra;
-
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
+	if (len > LINUX_SPI_STACK_MSGS) {
+		tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
+		if (!tr)
+			return -ENOMEM;
+	}
 
 	for (i = 0; i < len; i++) {
 		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
 		tr[i].rx_buf = (unsigned long) msgs[i].rx_buff;
 		tr[i].len = msgs[i].bytes_number;
 		tr[i].cs_change = msgs[i].cs_change;
-		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
+		tr[i].delay_usecs = msgs[i].cs_change_delay;
 	}
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
+	if (ret < 0)
+		ret = -errno;
 
-	no_os_free(tr);
+	if (tr != stack_tr)
+		no_os_free(tr);
 
 	if (ret < 0) {
-		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
+		printf("%s: Can't send spi message (%d)\n\r", __func__, ret);
 		return ret;
 	}
 
 	return 0;
 }
+
+/**
+ * @brief Send all the messages at once, with a single ioctl.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages to transfer.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs,
+				  uint32_t len)
+{
+	return linux_spi_ioc_message(desc->extra, msgs, len);
+}
+
+/**
+ * @brief Worker thread of the asynchronous transfers. Runs the pending
+ * transfer and invokes its callback, until the descriptor is removed.
+ * @param arg - The Linux SPI descriptor.
+ * @return NULL.
+ */
+static void *linux_spi_worker(void *arg)
+{
+	struct linux_spi_desc *linux_desc = arg;
+	struct no_os_spi_msg *msgs;
+	void (*callback)(void *);
+	void *ctx;
+
+	pthread_mutex_lock(&linux_desc->lock);
+	while (!linux_desc->stop) {
+		if (!linux_desc->msgs) {
+			pthread_cond_wait(&linux_desc->cond, &linux_desc->lock);
+			continue;
+		}
+
+		msgs = linux_desc->msgs;
+		callback = linux_desc->callback;
+		ctx = linux_desc->ctx;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		linux_spi_ioc_message(linux_desc, msgs, linux_desc->len);
+
+		pthread_mutex_lock(&linux_desc->lock);
+		linux_desc->msgs = NULL;
+		pthread_mutex_unlock(&linux_desc->lock);
+
+		if (callback)
+			callback(ctx);
+
+		pthread_mutex_lock(&linux_desc->lock);
+	}
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Hand a list of messages to the worker thread of the descriptor and
+ * return. The worker sends them with a single ioctl and invokes the callback,
+ * from its own thread, once they are done. One transfer may be pending at a
+ * time.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages to transfer. Must be valid until the callback.
+ * @param len - Number of messages.
+ * @param callback - Invoked once the transfer is done.
+ * @param ctx - Parameter for the callback.
+ * @return 0 if the transfer was queued, negative error code otherwise.
+ */
+static int32_t linux_spi_transfer_async(struct no_os_spi_desc *desc,
+					struct no_os_spi_msg *msgs,
+					uint32_t len,
+					void (*callback)(void *),
+					void *ctx)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	int32_t ret = 0;
+
+	if (!linux_desc->worker_started) {
+		if (pthread_mutex_init(&linux_desc->lock, NULL))
+			return -ENOMEM;
+		if (pthread_cond_init(&linux_desc->cond, NULL)) {
+			ret = -ENOMEM;
+			goto error_lock;
+		}
+		if (pthread_create(&linux_desc->worker, NULL, linux_spi_worker,
+				   linux_desc)) {
+			ret = -EAGAIN;
+			goto error_cond;
+		}
+		linux_desc->worker_started = true;
+	}
+
+	pthread_mutex_lock(&linux_desc->lock);
+	if (linux_desc->msgs) {
+		ret = -EBUSY;
+	} else {
+		linux_desc->len = len;
+		linux_desc->callback = callback;
+		linux_desc->ctx = ctx;
+		linux_desc->msgs = msgs;
+		pthread_cond_signal(&linux_desc->cond);
+	}
+	pthread_mutex_unlock(&linux_desc->lock);
+
+	return ret;
+
+error_cond:
+	pthread_cond_destroy(&linux_desc->cond);
+error_lock:
+	pthread_mutex_destroy(&linux_desc->lock);
+
+	return ret;
+}
+
 /**
  * @brief Linux platform specific SPI platform ops structure
  */
@@ -235,5 +396,7 @@ const struct no_os_spi_platform_ops linux_spi_ops = {
 	.init = &linux_spi_init,
 	.write_and_read = &linux_spi_write_and_read,
 	.remove = &linux_spi_remove,
-	.transfer = &linux_spi_transfer
+	.transfer = &linux_spi_transfer,
+	.dma_transfer_sync = &linux_spi_transfer,
+	.dma_transfer_async = &linux_spi_transfer_async
 };
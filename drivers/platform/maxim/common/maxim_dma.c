@@ -229,6 +229,71 @@ static int maxim_dma_config_xfer(struct no_os_dma_ch *channel,
 	return 0;
 }
 
+/**
+ * @brief Load the reload registers with a period of a cyclic transfer. The
+ * 	  controller switches to it without a gap once the count reaches 0.
+ * @param dma_ch - The DMA channel registers.
+ * @param cyclic - Descriptor for the cyclic transfer.
+ * @param period - Index of the period to load.
+ */
+static void maxim_dma_load_period(struct max_dma_ch_regs *dma_ch,
+				  struct no_os_dma_cyclic_desc *cyclic,
+				  uint32_t period)
+{
+	uint32_t offset = period * cyclic->period_len;
+	uint32_t src = (uint32_t)cyclic->xfer.src;
+	uint32_t dst = (uint32_t)cyclic->xfer.dst;
+
+	if (cyclic->xfer.xfer_type != DEV_TO_MEM)
+		src += offset;
+	if (cyclic->xfer.xfer_type != MEM_TO_DEV)
+		dst += offset;
+
+	dma_ch->src_rld = src;
+	dma_ch->dst_rld = dst;
+	dma_ch->cnt_rld = cyclic->period_len | MAX_DMA_CNT_RLDEN;
+	dma_ch->cfg |= MAX_DMA_RLDEN;
+}
+
+/**
+ * @brief Configure a DMA channel for a cyclic transfer. The first period is
+ * 	  loaded in the count registers and the second one in the reload ones.
+ * @param channel - The DMA channel descriptor.
+ * @param cyclic - Descriptor for the cyclic transfer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int maxim_dma_config_cyclic(struct no_os_dma_ch *channel,
+				   struct no_os_dma_cyclic_desc *cyclic)
+{
+	struct max_dma_ch_regs *dma_ch = channel->extra;
+	struct no_os_dma_xfer_desc first = cyclic->xfer;
+	int ret;
+
+	first.length = cyclic->period_len;
+	ret = maxim_dma_config_xfer(channel, &first);
+	if (ret)
+		return ret;
+
+	maxim_dma_load_period(dma_ch, cyclic, 1 % cyclic->num_periods);
+
+	return 0;
+}
+
+/**
+ * @brief Queue the period following the one being transferred.
+ * @param channel - The DMA channel descriptor.
+ * @param cyclic - Descriptor for the cyclic transfer.
+ * @return 0
+ */
+static int maxim_dma_cyclic_next(struct no_os_dma_ch *channel,
+				 struct no_os_dma_cyclic_desc *cyclic)
+{
+	maxim_dma_load_period(channel->extra, cyclic,
+			      (cyclic->period + 1) % cyclic->num_periods);
+
+	return 0;
+}
+
 /**
  * @brief Start a DMA transfer for a specific channel .
  * @param desc - Descriptor for the DMA controller.
@@ -256,7 +321,7 @@ static int maxim_dma_xfer_abort(struct no_os_dma_desc *desc,
 {
 	struct max_dma_ch_regs *max_dma_ch = ch->extra;
 
-	max_dma_ch->cfg &= ~MAX_DMA_ENABLE;
+	max_dma_ch->cfg &= ~(MAX_DMA_ENABLE | MAX_DMA_RLDEN);
 
 	return 0;
 }
@@ -282,6 +347,8 @@ struct no_os_dma_platform_ops max_dma_ops = {
 	.dma_init = maxim_dma_init,
 	.dma_remove = maxim_dma_remove,
 	.dma_config_xfer = maxim_dma_config_xfer,
+	.dma_config_cyclic = maxim_dma_config_cyclic,
+	.dma_cyclic_next = maxim_dma_cyclic_next,
 	.dma_xfer_start = maxim_dma_xfer_start,
 	.dma_xfer_abort = maxim_dma_xfer_abort,
 	.dma_acquire_ch = maxim_dma_acquire_free_ch,
@@ -65,6 +65,8 @@
 #define MAX_DMA_REQSEL_MASK	NO_OS_GENMASK(9, 4)
 #define MAX_DMA_DST_INC		NO_OS_BIT(22)
 #define MAX_DMA_SRC_INC		NO_OS_BIT(18)
+#define MAX_DMA_RLDEN		NO_OS_BIT(1)
+#define MAX_DMA_CNT_RLDEN	NO_OS_BIT(31)
 
 struct max_dma_ch_regs {
 	volatile uint32_t cfg;
@@ -38,6 +38,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -56,6 +57,24 @@
 /** Used to know how many instances are created */
 static uint32_t nb_created_desc[MXC_I2C_INSTANCES];
 
+/**
+ * @struct max_i2c_async
+ * @brief State of the asynchronous transfer of an I2C instance
+ */
+struct max_i2c_async {
+	/** MSDK request, first so the completion callback can find the state */
+	mxc_i2c_req_t req;
+	/** Set while a transfer is ongoing */
+	volatile bool busy;
+	/** Called once the transfer is done */
+	void (*callback)(void *, int32_t);
+	/** Parameter for the callback */
+	void *ctx;
+};
+
+/** Asynchronous transfer of each instance */
+static struct max_i2c_async async_state[MXC_I2C_INSTANCES];
+
 /**
  * @brief I2C0 interrupt handler.
  * @return void
@@ -324,6 +343,132 @@ static int32_t max_i2c_read(struct no_os_i2c_desc *desc,
 	return ret;
 }
 
+/**
+ * @brief Fill a MSDK request with the next messages of a combined transfer:
+ * a write, a read, or a write followed by a read after a repeated start.
+ * A repeated start instead of a stop ends the request if messages are left.
+ * @param desc - Descriptor of the I2C device
+ * @param req - The request to fill.
+ * @param msgs - The remaining messages.
+ * @param nb_msgs - Number of remaining messages.
+ * @return Number of messages covered by the request.
+ */
+static uint32_t max_i2c_msg_group(struct no_os_i2c_desc *desc,
+				  mxc_i2c_req_t *req,
+				  struct no_os_i2c_msg *msgs,
+				  uint32_t nb_msgs)
+{
+	uint32_t n = 0;
+
+	req->i2c = MXC_I2C_GET_I2C(desc->device_id);
+	req->addr = desc->slave_address;
+	req->tx_buf = NULL;
+	req->tx_len = 0;
+	req->rx_buf = NULL;
+	req->rx_len = 0;
+	req->callback = NULL;
+
+	if (!(msgs[0].flags & NO_OS_I2C_M_RD)) {
+		req->tx_buf = msgs[0].buf;
+		req->tx_len = msgs[0].len;
+		n++;
+	}
+
+	if (n < nb_msgs && (msgs[n].flags & NO_OS_I2C_M_RD)) {
+		req->rx_buf = msgs[n].buf;
+		req->rx_len = msgs[n].len;
+		n++;
+	}
+
+	req->restart = n < nb_msgs;
+
+	return n;
+}
+
+/**
+ * @brief Transfer a list of messages joined by repeated starts.
+ * @param desc - Descriptor of the I2C device
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t max_i2c_transfer(struct no_os_i2c_desc *desc,
+				struct no_os_i2c_msg *msgs,
+				uint32_t nb_msgs)
+{
+	mxc_i2c_req_t req;
+	uint32_t i, n;
+
+	if (!desc || !desc->extra || !msgs)
+		return -EINVAL;
+
+	for (i = 0; i < nb_msgs; i += n) {
+		n = max_i2c_msg_group(desc, &req, &msgs[i], nb_msgs - i);
+		if (MXC_I2C_MasterTransaction(&req) != E_NO_ERROR)
+			return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief MSDK completion callback of an asynchronous transfer.
+ * @param req - The request, first member of its max_i2c_async.
+ * @param result - MSDK result of the transaction.
+ */
+static void max_i2c_async_done(mxc_i2c_req_t *req, int result)
+{
+	struct max_i2c_async *async = (struct max_i2c_async *)req;
+
+	async->busy = false;
+	if (async->callback)
+		async->callback(async->ctx, result == E_NO_ERROR ? 0 : -EIO);
+}
+
+/**
+ * @brief Start an interrupt driven transfer of a list of messages and return.
+ * The list must fit in one MSDK request: a write, a read, or a write followed
+ * by a read.
+ * @param desc - Descriptor of the I2C device
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @param callback - Invoked from the I2C interrupt with the result.
+ * @param ctx - Parameter for the callback.
+ * @return 0 if the transfer was started, negative error code otherwise.
+ */
+static int32_t max_i2c_transfer_async(struct no_os_i2c_desc *desc,
+				      struct no_os_i2c_msg *msgs,
+				      uint32_t nb_msgs,
+				      void (*callback)(void *, int32_t),
+				      void *ctx)
+{
+	struct max_i2c_async *async;
+
+	if (!desc || !desc->extra || !msgs)
+		return -EINVAL;
+
+	async = &async_state[desc->device_id];
+	if (async->busy)
+		return -EBUSY;
+
+	if (max_i2c_msg_group(desc, &async->req, msgs, nb_msgs) != nb_msgs)
+		return -ENOTSUP;
+
+	async->req.restart = 0;
+	async->req.callback = max_i2c_async_done;
+	async->callback = callback;
+	async->ctx = ctx;
+	async->busy = true;
+
+	NVIC_EnableIRQ(MXC_I2C_GET_IRQ(desc->device_id));
+	if (MXC_I2C_MasterTransactionAsync(&async->req) != E_NO_ERROR) {
+		async->busy = false;
+		return -EIO;
+	}
+
+	return 0;
+}
+
 /**
  * @brief MAXIM platform specific I2C platform ops structure
  */
@@ -331,5 +476,7 @@ const struct no_os_i2c_platform_ops max_i2c_ops = {
 	.i2c_ops_init = &max_i2c_init,
 	.i2c_ops_write = &max_i2c_write,
 	.i2c_ops_read = &max_i2c_read,
+	.i2c_ops_transfer = &max_i2c_transfer,
+	.i2c_ops_transfer_async = &max_i2c_transfer_async,
 	.i2c_ops_remove = &max_i2c_remove
 };
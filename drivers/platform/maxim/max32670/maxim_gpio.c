@@ -329,6 +329,58 @@ int32_t max_gpio_get_value(struct no_os_gpio_desc *desc, uint8_t *value)
 	return 0;
 }
 
+/**
+ * @brief Set the masked pins of the port of the specified GPIO.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins to be written, bit n is pin n of the port.
+ * @param value - New values of the masked pins.
+ * @return 0 in case of success, errno error codes otherwise.
+ */
+int32_t max_gpio_port_set_value(struct no_os_gpio_desc *desc, uint32_t mask,
+				uint32_t value)
+{
+	mxc_gpio_cfg_t *max_gpio_cfg;
+	mxc_gpio_regs_t *gpio_regs;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	max_gpio_cfg = desc->extra;
+	gpio_regs = max_gpio_cfg->port;
+	mask &= NO_OS_GENMASK(N_PINS - 1, 0);
+
+	set_enable(gpio_regs, mask, true);
+	MXC_GPIO_OutPut(gpio_regs, mask, value);
+
+	return 0;
+}
+
+/**
+ * @brief Get the masked pins of the port of the specified GPIO.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins to be read, bit n is pin n of the port.
+ * @param value - Values of the masked pins.
+ * @return 0 in case of success, errno error codes otherwise.
+ */
+int32_t max_gpio_port_get_value(struct no_os_gpio_desc *desc, uint32_t mask,
+				uint32_t *value)
+{
+	mxc_gpio_cfg_t *max_gpio_cfg;
+	mxc_gpio_regs_t *gpio_regs;
+
+	if (!desc || !desc->extra || !value)
+		return -EINVAL;
+
+	max_gpio_cfg = desc->extra;
+	gpio_regs = max_gpio_cfg->port;
+	mask &= NO_OS_GENMASK(N_PINS - 1, 0);
+
+	set_enable(gpio_regs, mask, true);
+	*value = MXC_GPIO_InGet(gpio_regs, mask);
+
+	return 0;
+}
+
 /**
  * @brief maxim platform specific GPIO platform ops structure
  */
@@ -340,5 +392,7 @@ const struct no_os_gpio_platform_ops max_gpio_ops = {
 	.gpio_ops_direction_output = &max_gpio_direction_output,
 	.gpio_ops_get_direction = &max_gpio_get_direction,
 	.gpio_ops_set_value = &max_gpio_set_value,
-	.gpio_ops_get_value = &max_gpio_get_value
+	.gpio_ops_get_value = &max_gpio_get_value,
+	.gpio_ops_port_set_value = &max_gpio_port_set_value,
+	.gpio_ops_port_get_value = &max_gpio_port_get_value
 };
@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ *   @file   maxim_crc.c
+ *   @brief  Source file for Maxim CRC platform driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+*******************************************************************************/
+
+#include "crc.h"
+#include "maxim_crc.h"
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+
+/* Descriptor the CRC unit is currently programmed for. */
+static struct no_os_crc_desc *max_crc_active;
+/* Number of descriptors using the CRC unit. */
+static uint32_t max_crc_users;
+
+/**
+ * @brief Get the left shift that aligns a non-reflected CRC of the descriptor
+ * width to the 32-bit CRC unit.
+ * @param desc - The CRC descriptor.
+ * @return The shift amount.
+ */
+static uint8_t _get_shift(struct no_os_crc_desc *desc)
+{
+	return desc->reflected ? 0 : 32 - desc->width;
+}
+
+/**
+ * @brief Initialize the CRC unit.
+ * @param desc - The CRC descriptor.
+ * @param param - The structure that contains the CRC parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int max_crc_init(struct no_os_crc_desc **desc,
+			const struct no_os_crc_init_param *param)
+{
+	struct no_os_crc_desc *descriptor;
+	int ret;
+
+	if (!param->width || param->width > 32)
+		return -ENOTSUP;
+
+	descriptor = (struct no_os_crc_desc *)no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	if (!max_crc_users) {
+		ret = MXC_CRC_Init();
+		if (ret) {
+			no_os_free(descriptor);
+			return -EIO;
+		}
+	}
+
+	max_crc_users++;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Compute the CRC over a buffer using the CRC unit.
+ *
+ * The unit is a 32-bit engine. Reflected CRCs of any width use it lsb-first
+ * directly, non-reflected ones are left aligned and run msb-first.
+ *
+ * @param desc - The CRC descriptor.
+ * @param data - Data buffer.
+ * @param len - Number of bytes in the data buffer.
+ * @param crc - Initial CRC value.
+ * @param result - Computed CRC value.
+ * @return 0 in case of success.
+ */
+static int max_crc_compute(struct no_os_crc_desc *desc, const uint8_t *data,
+			   size_t len, uint32_t crc, uint32_t *result)
+{
+	uint8_t shift = _get_shift(desc);
+
+	if (max_crc_active != desc) {
+		MXC_CRC_SetDirection(desc->reflected ? CRC_LSB_FIRST :
+				     CRC_MSB_FIRST);
+		MXC_CRC_SetPoly(desc->polynomial << shift);
+		max_crc_active = desc;
+	}
+
+	MXC_CRC->val = crc << shift;
+
+	while (len--) {
+		MXC_CRC->datain8[0] = *data++;
+		while (MXC_CRC->ctrl & MXC_F_CRC_CTRL_BUSY);
+	}
+
+	*result = MXC_CRC->val >> shift;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by max_crc_init().
+ * @param desc - The CRC descriptor.
+ * @return 0 in case of success.
+ */
+static int max_crc_remove(struct no_os_crc_desc *desc)
+{
+	if (max_crc_active == desc)
+		max_crc_active = NULL;
+
+	if (max_crc_users && !--max_crc_users)
+		MXC_CRC_Shutdown();
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Maxim specific CRC platform ops.
+ */
+const struct no_os_crc_platform_ops max_crc_ops = {
+	.init = &max_crc_init,
+	.compute = &max_crc_compute,
+	.remove = &max_crc_remove
+};
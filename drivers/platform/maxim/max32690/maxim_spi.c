@@ -69,6 +69,9 @@ struct max_dma_spi_xfer_data {
 	/* The callback provided as a parameter in the async transfer case. */
 	void (*cb)(void *);
 	void *ctx;
+
+	/* Set for prepared sequences, which keep the transfer structs */
+	bool keep;
 };
 
 /**
@@ -101,6 +104,9 @@ static void max_dma_xfer_cycle(struct no_os_dma_xfer_desc *old_xfer,
 
 		no_os_dma_chan_unlock(data->tx_ch);
 		no_os_dma_chan_unlock(data->rx_ch);
+		if (data->keep)
+			return;
+
 		no_os_free(data->first_xfer_tx);
 		no_os_free(data->first_xfer_rx);
 		no_os_free(data);
@@ -486,31 +492,67 @@ int32_t max_spi_remove(struct no_os_spi_desc *desc)
 }
 
 /**
- * @brief Configure and start a series of transfers using DMA.
+ * @brief Fill the DMA transfer structs for a series of messages.
  * @param desc - The SPI descriptor.
  * @param msgs - The messages array.
  * @param len - Number of messages.
- * @param callback - Function to be invoked once the transfers are done.
- * @param ctx - User defined parameter for the callback function.
+ * @param tx_ch_xfer - TX channel transfers, len entries.
+ * @param rx_ch_xfer - RX channel transfers, len entries.
+ * @param xfer_data - Context shared by the transfers.
+ * @return None.
+ */
+static void _max_spi_dma_fill(struct no_os_spi_desc *desc,
+			      struct no_os_spi_msg *msgs, uint32_t len,
+			      struct no_os_dma_xfer_desc *tx_ch_xfer,
+			      struct no_os_dma_xfer_desc *rx_ch_xfer,
+			      struct max_dma_spi_xfer_data *xfer_data)
+{
+	struct max_spi_state *max_spi = desc->extra;
+	uint32_t i;
+
+	xfer_data->spi = desc;
+	xfer_data->first_xfer_tx = tx_ch_xfer;
+	xfer_data->first_xfer_rx = rx_ch_xfer;
+
+	for (i = 0; i < len; i++) {
+		tx_ch_xfer[i].src = msgs[i].tx_buff;
+		tx_ch_xfer[i].dst = (uint8_t *)max_spi->dma_req_tx;
+		tx_ch_xfer[i].length = msgs[i].bytes_number;
+		tx_ch_xfer[i].periph = NO_OS_DMA_IRQ;
+		tx_ch_xfer[i].xfer_complete_cb = max_dma_xfer_cycle;
+		tx_ch_xfer[i].xfer_complete_ctx = xfer_data;
+		tx_ch_xfer[i].xfer_type = MEM_TO_DEV;
+		tx_ch_xfer[i].irq_priority = max_spi->init_param->dma_tx_priority;
+
+		rx_ch_xfer[i].dst = msgs[i].rx_buff;
+		rx_ch_xfer[i].src = (uint8_t *)max_spi->dma_req_rx;
+		rx_ch_xfer[i].length = msgs[i].bytes_number;
+		rx_ch_xfer[i].periph = NO_OS_DMA_IRQ;
+		rx_ch_xfer[i].xfer_type = DEV_TO_MEM;
+		rx_ch_xfer[i].irq_priority = max_spi->init_param->dma_rx_priority;
+	}
+}
+
+/**
+ * @brief Start a series of transfers using already filled DMA transfer structs.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages array.
+ * @param len - Number of messages.
+ * @param xfer_data - Context filled by _max_spi_dma_fill().
  * @param is_async - Whether or not the function should wait for the completion.
  * @return 0 in case of success, errno codes otherwise.
  */
-static int32_t max_config_dma_and_start(struct no_os_spi_desc *desc,
-					struct no_os_spi_msg *msgs,
-					uint32_t len,
-					void (*callback)(void *),
-					void *ctx, bool is_async)
+static int32_t _max_spi_dma_start(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs, uint32_t len,
+				  struct max_dma_spi_xfer_data *xfer_data,
+				  bool is_async)
 {
 	mxc_spi_regs_t *spi = MXC_SPI_GET_SPI(desc->device_id);
 	static uint32_t last_slave_id[MXC_SPI_INSTANCES];
-	struct max_dma_spi_xfer_data *sync_xfer_data;
 	struct max_spi_state *max_spi = desc->extra;
-	struct no_os_dma_xfer_desc *rx_ch_xfer;
-	struct no_os_dma_xfer_desc *tx_ch_xfer;
 	struct no_os_dma_ch *tx_ch;
 	struct no_os_dma_ch *rx_ch;
 	uint32_t slave_id;
-	size_t i = 0;
 	int32_t ret;
 
 	slave_id = desc->chip_select;
@@ -527,22 +569,6 @@ static int32_t max_config_dma_and_start(struct no_os_spi_desc *desc,
 	spi->ctrl0 |= no_os_field_prep(MXC_F_SPI_CTRL0_SS_ACTIVE,
 				       NO_OS_BIT(desc->chip_select));
 
-	rx_ch_xfer = no_os_calloc(len, sizeof(*rx_ch_xfer));
-	if (!rx_ch_xfer)
-		return -ENOMEM;
-
-	tx_ch_xfer = no_os_calloc(len, sizeof(*tx_ch_xfer));
-	if (!tx_ch_xfer) {
-		ret = -ENOMEM;
-		goto free_rx_ch_xfer;
-	}
-
-	sync_xfer_data = no_os_calloc(1, sizeof(*sync_xfer_data));
-	if (!sync_xfer_data) {
-		ret = -ENOMEM;
-		goto free_tx_ch_xfer;
-	}
-
 	/* Flush the RX and TX FIFOs */
 	spi->dma |= MXC_F_SPI_DMA_RX_FLUSH | MXC_F_SPI_DMA_TX_FLUSH;
 	/* Enable SPI */
@@ -566,46 +592,22 @@ static int32_t max_config_dma_and_start(struct no_os_spi_desc *desc,
 
 	ret = no_os_dma_acquire_channel(max_spi->dma, &tx_ch);
 	if (ret)
-		goto free_sync_xfer_data;
+		return ret;
 
 	ret = no_os_dma_acquire_channel(max_spi->dma, &rx_ch);
 	if (ret)
 		goto release_tx_ch;
 
-	sync_xfer_data->spi = desc;
-	sync_xfer_data->rx_ch = rx_ch;
-	sync_xfer_data->tx_ch = tx_ch;
-	sync_xfer_data->first_xfer_tx = tx_ch_xfer;
-	sync_xfer_data->first_xfer_rx = rx_ch_xfer;
-
-	if (is_async) {
-		sync_xfer_data->cb = callback;
-		sync_xfer_data->ctx = ctx;
-	}
-
-	for (i = 0; i < len; i++) {
-		tx_ch_xfer[i].src = msgs[i].tx_buff;
-		tx_ch_xfer[i].dst = (uint8_t *)max_spi->dma_req_tx;
-		tx_ch_xfer[i].length = msgs[i].bytes_number;
-		tx_ch_xfer[i].periph = NO_OS_DMA_IRQ;
-		tx_ch_xfer[i].xfer_complete_cb = max_dma_xfer_cycle;
-		tx_ch_xfer[i].xfer_complete_ctx = sync_xfer_data;
-		tx_ch_xfer[i].xfer_type = MEM_TO_DEV;
-		tx_ch_xfer[i].irq_priority = max_spi->init_param->dma_tx_priority;
+	xfer_data->rx_ch = rx_ch;
+	xfer_data->tx_ch = tx_ch;
 
-		rx_ch_xfer[i].dst = msgs[i].rx_buff;
-		rx_ch_xfer[i].src = (uint8_t *)max_spi->dma_req_rx;
-		rx_ch_xfer[i].length = msgs[i].bytes_number;
-		rx_ch_xfer[i].periph = NO_OS_DMA_IRQ;
-		rx_ch_xfer[i].xfer_type = DEV_TO_MEM;
-		rx_ch_xfer[i].irq_priority = max_spi->init_param->dma_rx_priority;
-	}
-
-	ret = no_os_dma_config_xfer(max_spi->dma, tx_ch_xfer, len, tx_ch);
+	ret = no_os_dma_config_xfer(max_spi->dma, xfer_data->first_xfer_tx, len,
+				    tx_ch);
 	if (ret)
 		goto release_rx_ch;
 
-	ret = no_os_dma_config_xfer(max_spi->dma, rx_ch_xfer, len, rx_ch);
+	ret = no_os_dma_config_xfer(max_spi->dma, xfer_data->first_xfer_rx, len,
+				    rx_ch);
 	if (ret)
 		goto abort_rx_tx;
 
@@ -640,6 +642,61 @@ release_rx_ch:
 	no_os_dma_release_channel(max_spi->dma, rx_ch);
 release_tx_ch:
 	no_os_dma_release_channel(max_spi->dma, tx_ch);
+
+	return ret;
+}
+
+/**
+ * @brief Configure and start a series of transfers using DMA.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages array.
+ * @param len - Number of messages.
+ * @param callback - Function to be invoked once the transfers are done.
+ * @param ctx - User defined parameter for the callback function.
+ * @param is_async - Whether or not the function should wait for the completion.
+ * @return 0 in case of success, errno codes otherwise.
+ */
+static int32_t max_config_dma_and_start(struct no_os_spi_desc *desc,
+					struct no_os_spi_msg *msgs,
+					uint32_t len,
+					void (*callback)(void *),
+					void *ctx, bool is_async)
+{
+	struct max_dma_spi_xfer_data *sync_xfer_data;
+	struct no_os_dma_xfer_desc *rx_ch_xfer;
+	struct no_os_dma_xfer_desc *tx_ch_xfer;
+	int32_t ret;
+
+	rx_ch_xfer = no_os_calloc(len, sizeof(*rx_ch_xfer));
+	if (!rx_ch_xfer)
+		return -ENOMEM;
+
+	tx_ch_xfer = no_os_calloc(len, sizeof(*tx_ch_xfer));
+	if (!tx_ch_xfer) {
+		ret = -ENOMEM;
+		goto free_rx_ch_xfer;
+	}
+
+	sync_xfer_data = no_os_calloc(1, sizeof(*sync_xfer_data));
+	if (!sync_xfer_data) {
+		ret = -ENOMEM;
+		goto free_tx_ch_xfer;
+	}
+
+	if (is_async) {
+		sync_xfer_data->cb = callback;
+		sync_xfer_data->ctx = ctx;
+	}
+
+	_max_spi_dma_fill(desc, msgs, len, tx_ch_xfer, rx_ch_xfer,
+			  sync_xfer_data);
+
+	ret = _max_spi_dma_start(desc, msgs, len, sync_xfer_data, is_async);
+	if (ret)
+		goto free_sync_xfer_data;
+
+	return 0;
+
 free_sync_xfer_data:
 	no_os_free(sync_xfer_data);
 free_tx_ch_xfer:
@@ -810,6 +867,85 @@ int32_t max_spi_write_and_read(struct no_os_spi_desc *desc,
 	return max_spi_transfer(desc, &xfer, 1);
 }
 
+/**
+ * @brief Build the DMA transfer structs of a message sequence once, so it can
+ * 	  be replayed by max_spi_seq_run() without any allocation.
+ * @param seq - The SPI message sequence.
+ * @return 0 in case of success, errno codes otherwise.
+ */
+static int32_t max_spi_seq_prepare(struct no_os_spi_seq *seq)
+{
+	struct max_spi_state *max_spi = seq->desc->extra;
+	struct max_dma_spi_xfer_data *xfer_data;
+	struct no_os_dma_xfer_desc *xfers;
+
+	/* Without DMA, the sequence is replayed by max_spi_transfer(). */
+	if (!max_spi->dma)
+		return 0;
+
+	xfer_data = no_os_calloc(1, sizeof(*xfer_data));
+	if (!xfer_data)
+		return -ENOMEM;
+
+	xfers = no_os_calloc(2 * seq->len, sizeof(*xfers));
+	if (!xfers) {
+		no_os_free(xfer_data);
+		return -ENOMEM;
+	}
+
+	xfer_data->keep = true;
+	_max_spi_dma_fill(seq->desc, seq->msgs, seq->len, xfers,
+			  xfers + seq->len, xfer_data);
+	seq->extra = xfer_data;
+
+	return 0;
+}
+
+/**
+ * @brief Replay a prepared message sequence.
+ * @param seq - The SPI message sequence.
+ * @param callback - Function to be invoked once the transfers are done. If
+ * 		     NULL, wait for the completion before returning.
+ * @param ctx - User defined parameter for the callback function.
+ * @return 0 in case of success, errno codes otherwise.
+ */
+static int32_t max_spi_seq_run(struct no_os_spi_seq *seq,
+			       void (*callback)(void *), void *ctx)
+{
+	struct max_dma_spi_xfer_data *xfer_data = seq->extra;
+
+	if (!xfer_data) {
+		if (callback)
+			return -ENOSYS;
+
+		return max_spi_transfer(seq->desc, seq->msgs, seq->len);
+	}
+
+	xfer_data->cb = callback;
+	xfer_data->ctx = ctx;
+
+	return _max_spi_dma_start(seq->desc, seq->msgs, seq->len, xfer_data,
+				  callback != NULL);
+}
+
+/**
+ * @brief Free the DMA transfer structs of a message sequence.
+ * @param seq - The SPI message sequence.
+ * @return 0
+ */
+static int32_t max_spi_seq_release(struct no_os_spi_seq *seq)
+{
+	struct max_dma_spi_xfer_data *xfer_data = seq->extra;
+
+	if (xfer_data)
+		no_os_free(xfer_data->first_xfer_tx);
+
+	no_os_free(xfer_data);
+	seq->extra = NULL;
+
+	return 0;
+}
+
 /**
  * @brief maxim platform specific SPI platform ops structure
  */
@@ -819,5 +955,8 @@ const struct no_os_spi_platform_ops max_spi_ops = {
 	.transfer = &max_spi_transfer,
 	.dma_transfer_sync = &max_spi_dma_transfer_sync,
 	.dma_transfer_async = &max_spi_dma_transfer_async,
+	.seq_prepare = &max_spi_seq_prepare,
+	.seq_run = &max_spi_seq_run,
+	.seq_release = &max_spi_seq_release,
 	.remove = &max_spi_remove
 };
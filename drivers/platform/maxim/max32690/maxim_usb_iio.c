@@ -0,0 +1,652 @@
+/***************************************************************************//**
+ *   @file   maxim_usb_iio.c
+ *   @brief  USB bulk IIO transport for maxim platform.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "maxim_irq.h"
+#include "maxim_usb_iio.h"
+#include "no_os_irq.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "mxc_errors.h"
+#include "mcr_regs.h"
+#include "mxc_sys.h"
+#include "mxc_delay.h"
+#include "usb.h"
+#include "usb_event.h"
+#include "enumerate.h"
+#include "maxim_usb_iio_descriptors.h"
+
+/* Vendor requests of the libiio USB backend, wValue is the pipe */
+#define IIO_USD_CMD_RESET_PIPES		0
+#define IIO_USD_CMD_OPEN_PIPE		1
+#define IIO_USD_CMD_CLOSE_PIPE		2
+
+/* Endpoints of each pipe, must match the configuration descriptor */
+static const uint8_t usb_iio_eps[MAX_USB_IIO_PIPES][2] = {
+	{1, 2},
+	{3, 4},
+};
+
+static void usb_iio_callback(void *context)
+{
+	MXC_USB_EventHandler();
+}
+
+static void usb_iio_delay_us(unsigned int usec)
+{
+	MXC_Delay(usec);
+}
+
+static int usb_iio_startup(void)
+{
+	MXC_SYS_ClockSourceEnable(MXC_SYS_CLOCK_IPO);
+	MXC_MCR->ldoctrl |= MXC_F_MCR_LDOCTRL_0P9EN;
+	MXC_SYS_ClockEnable(MXC_SYS_PERIPH_CLOCK_USB);
+	MXC_SYS_Reset_Periph(MXC_SYS_RESET0_USB);
+
+	return E_NO_ERROR;
+}
+
+static int usb_iio_shutdown(void)
+{
+	MXC_SYS_ClockDisable(MXC_SYS_PERIPH_CLOCK_USB);
+
+	return E_NO_ERROR;
+}
+
+static void usb_iio_rx_done(void *cbdata);
+
+/* Start the OUT transfer in the buffer following the last filled one */
+static int usb_iio_queue_rx(struct max_usb_iio_pipe *pipe)
+{
+	MXC_USB_Req_t *req = &pipe->rx_req;
+
+	req->ep = pipe->out_ep;
+	req->data = pipe->rx_buff[pipe->rx_next];
+	req->reqlen = pipe->desc->rx_buff_size;
+	req->actlen = 0;
+	req->error_code = 0;
+	req->callback = usb_iio_rx_done;
+	req->cbdata = pipe;
+	req->type = MAXUSB_TYPE_TRANS;
+
+	pipe->rx_pending = true;
+	if (MXC_USB_ReadEndpoint(req)) {
+		pipe->rx_pending = false;
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Called from the USB interrupt when an OUT transfer ended */
+static void usb_iio_rx_done(void *cbdata)
+{
+	struct max_usb_iio_pipe *pipe = cbdata;
+	uint32_t next;
+
+	if (pipe->rx_req.error_code) {
+		pipe->rx_pending = false;
+		if (pipe->open && pipe->desc->configured)
+			usb_iio_queue_rx(pipe);
+		return;
+	}
+
+	/* Zero length packet, keep the same buffer */
+	if (!pipe->rx_req.actlen) {
+		usb_iio_queue_rx(pipe);
+		return;
+	}
+
+	next = pipe->rx_next;
+	pipe->rx_len[next] = pipe->rx_req.actlen;
+	pipe->rx_next = next ^ 1;
+
+	/* Continue in the other buffer if it was already read */
+	if (!pipe->rx_len[pipe->rx_next])
+		usb_iio_queue_rx(pipe);
+	else
+		pipe->rx_pending = false;
+}
+
+/* Called from the USB interrupt when an IN transfer and its ZLP ended */
+static void usb_iio_zlp_done(void *cbdata)
+{
+	struct max_usb_iio_pipe *pipe = cbdata;
+
+	pipe->tx_pending = false;
+	pipe->tx_done = true;
+}
+
+/* Called from the USB interrupt when an IN transfer ended */
+static void usb_iio_tx_done(void *cbdata)
+{
+	struct max_usb_iio_pipe *pipe = cbdata;
+	MXC_USB_Req_t *zlp = &pipe->zlp_req;
+
+	/* The host only sees the end of a transfer of whole packets on a ZLP */
+	if (!pipe->tx_req.error_code &&
+	    !(pipe->tx_req.reqlen % pipe->desc->max_packet)) {
+		zlp->ep = pipe->in_ep;
+		zlp->data = NULL;
+		zlp->reqlen = 0;
+		zlp->actlen = 0;
+		zlp->error_code = 0;
+		zlp->callback = usb_iio_zlp_done;
+		zlp->cbdata = pipe;
+		zlp->type = MAXUSB_TYPE_TRANS;
+		if (!MXC_USB_WriteEndpoint(zlp))
+			return;
+	}
+
+	usb_iio_zlp_done(pipe);
+}
+
+/* Drop the state of the pipe, the host starts over after opening it */
+static void usb_iio_pipe_reset(struct max_usb_iio_pipe *pipe, bool open)
+{
+	/* Keep the aborted transfers from being queued again */
+	pipe->open = false;
+	MXC_USB_ResetEp(pipe->in_ep);
+	MXC_USB_ResetEp(pipe->out_ep);
+
+	pipe->tx_pending = false;
+	pipe->tx_done = false;
+	pipe->rx_len[0] = 0;
+	pipe->rx_len[1] = 0;
+	pipe->rx_cur = 0;
+	pipe->rx_pos = 0;
+	pipe->rx_next = 0;
+	pipe->rx_pending = false;
+	pipe->open = open;
+	pipe->reset = true;
+
+	if (open && pipe->desc->configured)
+		usb_iio_queue_rx(pipe);
+}
+
+static int usb_iio_vendor_req(MXC_USB_SetupPkt *sud, void *cbdata)
+{
+	struct max_usb_iio_desc *desc = cbdata;
+	uint32_t i;
+
+	if (sud->wLength)
+		return -1;
+
+	switch (sud->bRequest) {
+	case IIO_USD_CMD_RESET_PIPES:
+		for (i = 0; i < MAX_USB_IIO_PIPES; i++)
+			usb_iio_pipe_reset(&desc->pipes[i], false);
+		break;
+	case IIO_USD_CMD_OPEN_PIPE:
+	case IIO_USD_CMD_CLOSE_PIPE:
+		if (sud->wValue >= MAX_USB_IIO_PIPES)
+			return -1;
+
+		usb_iio_pipe_reset(&desc->pipes[sud->wValue],
+				   sud->bRequest == IIO_USD_CMD_OPEN_PIPE);
+		break;
+	default:
+		return -1;
+	}
+
+	MXC_USB_Ackstat(0);
+
+	return 0;
+}
+
+static void usb_iio_deconfigure(struct max_usb_iio_desc *desc)
+{
+	uint32_t i;
+
+	desc->configured = false;
+	for (i = 0; i < MAX_USB_IIO_PIPES; i++)
+		usb_iio_pipe_reset(&desc->pipes[i], false);
+}
+
+static int usb_iio_setconfig(MXC_USB_SetupPkt *sud, void *cbdata)
+{
+	struct max_usb_iio_desc *desc = cbdata;
+	struct max_usb_iio_pipe *pipe;
+	uint32_t i;
+
+	if (sud->wValue == 0) {
+		usb_iio_deconfigure(desc);
+		return 0;
+	}
+
+	if (sud->wValue !=
+	    usb_iio_config_descriptor.config_descriptor.bConfigurationValue)
+		return -1;
+
+	desc->max_packet = MXC_USB_GetStatus() & MAXUSB_STATUS_HIGH_SPEED ?
+			   512 : 64;
+	for (i = 0; i < MAX_USB_IIO_PIPES; i++) {
+		pipe = &desc->pipes[i];
+		if (MXC_USB_ConfigEp(pipe->in_ep, MAXUSB_EP_TYPE_IN,
+				     desc->max_packet) ||
+		    MXC_USB_ConfigEp(pipe->out_ep, MAXUSB_EP_TYPE_OUT,
+				     desc->max_packet))
+			return -1;
+	}
+	desc->configured = true;
+
+	return 0;
+}
+
+static int usb_iio_setfeature(MXC_USB_SetupPkt *sud, void *cbdata)
+{
+	struct max_usb_iio_desc *desc = cbdata;
+
+	if (sud->wValue != FEAT_REMOTE_WAKE)
+		return -1;
+
+	desc->remote_wake_en = true;
+
+	return 0;
+}
+
+static int usb_iio_clrfeature(MXC_USB_SetupPkt *sud, void *cbdata)
+{
+	struct max_usb_iio_desc *desc = cbdata;
+
+	if (sud->wValue != FEAT_REMOTE_WAKE)
+		return -1;
+
+	desc->remote_wake_en = false;
+
+	return 0;
+}
+
+static int usb_iio_event(maxusb_event_t evt, void *data)
+{
+	struct max_usb_iio_desc *desc = data;
+
+	switch (evt) {
+	case MAXUSB_EVENT_NOVBUS:
+		MXC_USB_EventDisable(MAXUSB_EVENT_BRST);
+		MXC_USB_EventDisable(MAXUSB_EVENT_SUSP);
+		MXC_USB_EventDisable(MAXUSB_EVENT_DPACT);
+		MXC_USB_Disconnect();
+		enum_clearconfig();
+		usb_iio_deconfigure(desc);
+		break;
+
+	case MAXUSB_EVENT_VBUS:
+		MXC_USB_EventClear(MAXUSB_EVENT_BRST);
+		MXC_USB_EventEnable(MAXUSB_EVENT_BRST, usb_iio_event, desc);
+		MXC_USB_EventClear(MAXUSB_EVENT_BRSTDN);
+		MXC_USB_EventEnable(MAXUSB_EVENT_BRSTDN, usb_iio_event, desc);
+		MXC_USB_EventClear(MAXUSB_EVENT_SUSP);
+		MXC_USB_EventEnable(MAXUSB_EVENT_SUSP, usb_iio_event, desc);
+		MXC_USB_Connect();
+		break;
+
+	case MAXUSB_EVENT_BRST:
+		enum_clearconfig();
+		usb_iio_deconfigure(desc);
+		break;
+
+	case MAXUSB_EVENT_BRSTDN:
+		if (MXC_USB_GetStatus() & MAXUSB_STATUS_HIGH_SPEED) {
+			enum_register_descriptor(ENUM_DESC_CONFIG,
+						 (uint8_t *)&usb_iio_config_descriptor_hs, 0);
+			enum_register_descriptor(ENUM_DESC_OTHER,
+						 (uint8_t *)&usb_iio_config_descriptor, 0);
+		} else {
+			enum_register_descriptor(ENUM_DESC_CONFIG,
+						 (uint8_t *)&usb_iio_config_descriptor, 0);
+			enum_register_descriptor(ENUM_DESC_OTHER,
+						 (uint8_t *)&usb_iio_config_descriptor_hs, 0);
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Start an IN transfer straight from buf. The transfer is not copied,
+ * so the function must be called again with the same buf until it returns
+ * the number of bytes sent.
+ * @param conn - The pipe (struct max_usb_iio_pipe).
+ * @param buf - Data to be sent.
+ * @param len - Number of bytes to send.
+ * @return Number of bytes sent, -EAGAIN while the transfer is in progress,
+ * -ENOTCONN once after the host reset the pipe, negative error code otherwise.
+ */
+int max_usb_iio_send(void *conn, uint8_t *buf, uint32_t len)
+{
+	struct max_usb_iio_pipe *pipe = conn;
+	MXC_USB_Req_t *req;
+
+	if (!pipe || !buf)
+		return -EINVAL;
+
+	req = &pipe->tx_req;
+	if (pipe->reset) {
+		pipe->reset = false;
+		return -ENOTCONN;
+	}
+
+	if (pipe->tx_pending)
+		return -EAGAIN;
+
+	if (pipe->tx_done) {
+		pipe->tx_done = false;
+		if (req->data == buf) {
+			if (req->error_code)
+				return -EIO;
+
+			return req->actlen;
+		}
+	}
+
+	if (!len)
+		return 0;
+
+	if (!pipe->open || !pipe->desc->configured)
+		return -EAGAIN;
+
+	req->ep = pipe->in_ep;
+	req->data = buf;
+	req->reqlen = len;
+	req->actlen = 0;
+	req->error_code = 0;
+	req->callback = usb_iio_tx_done;
+	req->cbdata = pipe;
+	req->type = MAXUSB_TYPE_TRANS;
+
+	pipe->tx_pending = true;
+	if (MXC_USB_WriteEndpoint(req)) {
+		pipe->tx_pending = false;
+		return -EIO;
+	}
+
+	return -EAGAIN;
+}
+
+/**
+ * @brief Get the address of the received data, without copying it.
+ * @param conn - The pipe (struct max_usb_iio_pipe).
+ * @param buf - Set to the address of the received data.
+ * @param len - Maximum number of bytes to get.
+ * @return Number of bytes available at buf, -EAGAIN if none, -ENOTCONN once
+ * after the host reset the pipe.
+ */
+int max_usb_iio_recv_nocopy(void *conn, const void **buf, uint32_t len)
+{
+	struct max_usb_iio_pipe *pipe = conn;
+	uint32_t cur;
+
+	if (!pipe || !buf)
+		return -EINVAL;
+
+	if (pipe->reset) {
+		pipe->reset = false;
+		return -ENOTCONN;
+	}
+
+	cur = pipe->rx_cur;
+	if (!pipe->rx_len[cur])
+		return -EAGAIN;
+
+	*buf = pipe->rx_buff[cur] + pipe->rx_pos;
+
+	return no_os_min(len, pipe->rx_len[cur] - pipe->rx_pos);
+}
+
+/**
+ * @brief Consume data obtained with max_usb_iio_recv_nocopy().
+ * @param conn - The pipe (struct max_usb_iio_pipe).
+ * @param len - Number of bytes to consume.
+ * @return 0 in case of success, -ENOTCONN if the host reset the pipe.
+ */
+int max_usb_iio_recv_release(void *conn, uint32_t len)
+{
+	struct max_usb_iio_pipe *pipe = conn;
+	struct max_usb_iio_desc *desc;
+	uint32_t cur;
+
+	if (!pipe)
+		return -EINVAL;
+
+	if (pipe->reset)
+		return -ENOTCONN;
+
+	desc = pipe->desc;
+	cur = pipe->rx_cur;
+	pipe->rx_pos += len;
+	if (pipe->rx_pos < pipe->rx_len[cur])
+		return 0;
+
+	/* Buffer fully read, give it back to the OUT endpoint */
+	no_os_irq_disable(desc->nvic, desc->irq_id);
+	pipe->rx_pos = 0;
+	pipe->rx_len[cur] = 0;
+	pipe->rx_cur = cur ^ 1;
+	if (!pipe->rx_pending && pipe->open && desc->configured)
+		usb_iio_queue_rx(pipe);
+	no_os_irq_enable(desc->nvic, desc->irq_id);
+
+	return 0;
+}
+
+/**
+ * @brief Copy the received data.
+ * @param conn - The pipe (struct max_usb_iio_pipe).
+ * @param buf - Buffer for the data.
+ * @param len - Maximum number of bytes to read.
+ * @return Number of bytes read, -EAGAIN if none, -ENOTCONN once after the
+ * host reset the pipe.
+ */
+int max_usb_iio_recv(void *conn, uint8_t *buf, uint32_t len)
+{
+	const void *data;
+	int ret;
+
+	if (!buf)
+		return -EINVAL;
+
+	ret = max_usb_iio_recv_nocopy(conn, &data, len);
+	if (ret <= 0)
+		return ret;
+
+	memcpy(buf, data, ret);
+	max_usb_iio_recv_release(conn, ret);
+
+	return ret;
+}
+
+/**
+ * @brief Initialize the USB device with the vendor specific "IIO" interface
+ * of the libiio USB backend.
+ * @param desc - The USB IIO descriptor.
+ * @param param - The initialization parameters.
+ * @return 0 in case of success, errno codes otherwise.
+ */
+int max_usb_iio_init(struct max_usb_iio_desc **desc,
+		     struct max_usb_iio_init_param *param)
+{
+	struct max_usb_iio_desc *descriptor;
+	struct max_usb_iio_pipe *pipe;
+	maxusb_cfg_options_t usb_opts;
+	uint32_t i, j;
+	int32_t ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->irq_id = param->irq_id;
+	descriptor->rx_buff_size = param->rx_buff_size ? param->rx_buff_size :
+				   MAX_USB_IIO_RX_BUFF_SIZE;
+	if (descriptor->rx_buff_size % 512) {
+		ret = -EINVAL;
+		goto error;
+	}
+
+	descriptor->max_packet = 64;
+	for (i = 0; i < MAX_USB_IIO_PIPES; i++) {
+		pipe = &descriptor->pipes[i];
+		pipe->desc = descriptor;
+		pipe->in_ep = usb_iio_eps[i][0];
+		pipe->out_ep = usb_iio_eps[i][1];
+		for (j = 0; j < 2; j++) {
+			pipe->rx_buff[j] = no_os_calloc(1, descriptor->rx_buff_size);
+			if (!pipe->rx_buff[j]) {
+				ret = -ENOMEM;
+				goto error;
+			}
+		}
+	}
+
+	if (param->vid)
+		usb_iio_device_descriptor.idVendor = param->vid;
+	if (param->pid)
+		usb_iio_device_descriptor.idProduct = param->pid;
+
+	usb_opts.enable_hs = 1;
+	usb_opts.delay_us = usb_iio_delay_us;
+	usb_opts.init_callback = usb_iio_startup;
+	usb_opts.shutdown_callback = usb_iio_shutdown;
+
+	if (MXC_USB_Init(&usb_opts) != 0) {
+		ret = -EFAULT;
+		goto error;
+	}
+
+	if (enum_init() != 0) {
+		ret = -EFAULT;
+		goto error_usb;
+	}
+
+	enum_register_descriptor(ENUM_DESC_DEVICE,
+				 (uint8_t *)&usb_iio_device_descriptor, 0);
+	enum_register_descriptor(ENUM_DESC_CONFIG,
+				 (uint8_t *)&usb_iio_config_descriptor, 0);
+	enum_register_descriptor(ENUM_DESC_OTHER,
+				 (uint8_t *)&usb_iio_config_descriptor_hs, 0);
+	enum_register_descriptor(ENUM_DESC_QUAL,
+				 (uint8_t *)&usb_iio_device_qualifier_descriptor, 0);
+	enum_register_descriptor(ENUM_DESC_STRING, usb_iio_lang_id_desc, 0);
+	enum_register_descriptor(ENUM_DESC_STRING, usb_iio_mfg_id_desc, 1);
+	enum_register_descriptor(ENUM_DESC_STRING, usb_iio_prod_id_desc, 2);
+	enum_register_descriptor(ENUM_DESC_STRING, usb_iio_serial_id_desc, 3);
+	enum_register_descriptor(ENUM_DESC_STRING, usb_iio_interface_desc, 4);
+
+	enum_register_callback(ENUM_SETCONFIG, usb_iio_setconfig, descriptor);
+	enum_register_callback(ENUM_SETFEATURE, usb_iio_setfeature, descriptor);
+	enum_register_callback(ENUM_CLRFEATURE, usb_iio_clrfeature, descriptor);
+	enum_register_callback(ENUM_VENDOR_REQ, usb_iio_vendor_req, descriptor);
+
+	MXC_USB_EventEnable(MAXUSB_EVENT_NOVBUS, usb_iio_event, descriptor);
+	MXC_USB_EventEnable(MAXUSB_EVENT_VBUS, usb_iio_event, descriptor);
+
+	struct no_os_irq_init_param nvic_ip = {
+		.platform_ops = &max_irq_ops,
+	};
+
+	ret = no_os_irq_ctrl_init(&descriptor->nvic, &nvic_ip);
+	if (ret)
+		goto error_usb;
+
+	struct no_os_callback_desc usb_cb = {
+		.callback = usb_iio_callback,
+		.event = NO_OS_EVT_USB,
+		.peripheral = NO_OS_USB_IRQ,
+		.handle = MXC_USBHS,
+	};
+
+	ret = no_os_irq_register_callback(descriptor->nvic, descriptor->irq_id,
+					  &usb_cb);
+	if (ret)
+		goto error_irq;
+
+	ret = no_os_irq_enable(descriptor->nvic, descriptor->irq_id);
+	if (ret)
+		goto error_irq;
+
+	*desc = descriptor;
+
+	return 0;
+
+error_irq:
+	no_os_irq_ctrl_remove(descriptor->nvic);
+error_usb:
+	MXC_USB_Shutdown();
+error:
+	for (i = 0; i < MAX_USB_IIO_PIPES; i++) {
+		no_os_free(descriptor->pipes[i].rx_buff[0]);
+		no_os_free(descriptor->pipes[i].rx_buff[1]);
+	}
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by max_usb_iio_init().
+ * @param desc - The USB IIO descriptor.
+ * @return 0 in case of success, errno codes otherwise.
+ */
+int max_usb_iio_remove(struct max_usb_iio_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	no_os_irq_disable(desc->nvic, desc->irq_id);
+	MXC_USB_Disconnect();
+	MXC_USB_Shutdown();
+	no_os_irq_ctrl_remove(desc->nvic);
+	for (i = 0; i < MAX_USB_IIO_PIPES; i++) {
+		no_os_free(desc->pipes[i].rx_buff[0]);
+		no_os_free(desc->pipes[i].rx_buff[1]);
+	}
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+/***************************************************************************//**
+ *   @file   maxim_usb_iio.h
+ *   @brief  Header file of the USB bulk IIO transport for maxim platform.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef MAXIM_USB_IIO_H_
+#define MAXIM_USB_IIO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_irq.h"
+#include "usb.h"
+
+/* Number of IN/OUT bulk endpoint pairs, libiio uses one per open buffer */
+#define MAX_USB_IIO_PIPES		2
+#define MAX_USB_IIO_RX_BUFF_SIZE	16384
+
+/**
+ * @brief USB IIO transport initialization parameters
+ */
+struct max_usb_iio_init_param {
+	uint16_t vid;
+	uint16_t pid;
+	/** USB interrupt id */
+	uint32_t irq_id;
+	/**
+	 * Size of each of the two RX buffers of a pipe, multiple of 512.
+	 * MAX_USB_IIO_RX_BUFF_SIZE if 0.
+	 */
+	uint32_t rx_buff_size;
+};
+
+struct max_usb_iio_desc;
+
+/**
+ * @brief State of an IN/OUT bulk endpoint pair, one iiod connection
+ */
+struct max_usb_iio_pipe {
+	struct max_usb_iio_desc *desc;
+	uint32_t in_ep;
+	uint32_t out_ep;
+	/** Opened by the host with IIO_USD_CMD_OPEN_PIPE */
+	volatile bool open;
+	/** Reported once as -ENOTCONN after the host reset the pipe */
+	volatile bool reset;
+	/** The OUT transfers alternate between the two buffers */
+	uint8_t *rx_buff[2];
+	/** Bytes received in each buffer, 0 while it is free */
+	volatile uint32_t rx_len[2];
+	/** Buffer being read and read position in it */
+	uint32_t rx_cur;
+	uint32_t rx_pos;
+	/** Buffer the next OUT transfer is received in */
+	volatile uint32_t rx_next;
+	volatile bool rx_pending;
+	MXC_USB_Req_t rx_req;
+	/** IN transfer, made straight from the buffer given to send */
+	MXC_USB_Req_t tx_req;
+	/** Zero length packet ending the IN transfers of whole packets */
+	MXC_USB_Req_t zlp_req;
+	volatile bool tx_pending;
+	volatile bool tx_done;
+};
+
+/**
+ * @brief USB IIO transport state
+ */
+struct max_usb_iio_desc {
+	/** Controller that handles the USB interrupt */
+	struct no_os_irq_ctrl_desc *nvic;
+	uint32_t irq_id;
+	uint32_t rx_buff_size;
+	/** Max packet size of the bulk endpoints for the current speed */
+	uint32_t max_packet;
+	volatile bool configured;
+	bool remote_wake_en;
+	struct max_usb_iio_pipe pipes[MAX_USB_IIO_PIPES];
+};
+
+/* Initialize the USB device and its vendor specific "IIO" interface. */
+int max_usb_iio_init(struct max_usb_iio_desc **desc,
+		     struct max_usb_iio_init_param *param);
+/* Free the resources allocated by max_usb_iio_init(). */
+int max_usb_iio_remove(struct max_usb_iio_desc *desc);
+
+/*
+ * iio_transport ops, conn is a struct max_usb_iio_pipe. send transfers
+ * straight from buf and returns -EAGAIN until the transfer is done, so buf
+ * must be passed again unchanged.
+ */
+int max_usb_iio_send(void *conn, uint8_t *buf, uint32_t len);
+int max_usb_iio_recv(void *conn, uint8_t *buf, uint32_t len);
+int max_usb_iio_recv_nocopy(void *conn, const void **buf, uint32_t len);
+int max_usb_iio_recv_release(void *conn, uint32_t len);
+
+#endif
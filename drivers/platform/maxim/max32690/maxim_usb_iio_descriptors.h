@@ -0,0 +1,257 @@
+/***************************************************************************//**
+ *   @file   maxim_usb_iio_descriptors.h
+ *   @brief  USB descriptors of the IIO bulk transport for maxim platform.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef MAXIM_USB_IIO_DESCRIPTORS_H_
+#define MAXIM_USB_IIO_DESCRIPTORS_H_
+
+#include <stdint.h>
+#include "usb.h"
+
+static MXC_USB_device_descriptor_t __attribute__((aligned(4)))
+usb_iio_device_descriptor = {
+	0x12, /* bLength = 18                     */
+	0x01, /* bDescriptorType = Device         */
+	0x0200, /* bcdUSB USB spec rev (BCD)        */
+	0x00, /* bDeviceClass = per interface     */
+	0x00, /* bDeviceSubClass                  */
+	0x00, /* bDeviceProtocol                  */
+	0x40, /* bMaxPacketSize0 is 64 bytes      */
+	0x0B6A, /* idVendor (Maxim Integrated)      */
+	0x003C, /* idProduct                        */
+	0x0100, /* bcdDevice                        */
+	0x01, /* iManufacturer Descriptor ID      */
+	0x02, /* iProduct Descriptor ID           */
+	0x03, /* iSerialNumber Descriptor ID      */
+	0x01 /* bNumConfigurations               */
+};
+
+/* Device qualifier needed for high-speed operation */
+static MXC_USB_device_qualifier_descriptor_t __attribute__((aligned(4)))
+usb_iio_device_qualifier_descriptor = {
+	0x0A, /* bLength = 10                       */
+	0x06, /* bDescriptorType = Device Qualifier */
+	0x0200, /* bcdUSB USB spec rev (BCD)          */
+	0x00, /* bDeviceClass = per interface       */
+	0x00, /* bDeviceSubClass                    */
+	0x00, /* bDeviceProtocol                    */
+	0x40, /* bMaxPacketSize0 is 64 bytes        */
+	0x01, /* bNumConfigurations                 */
+	0x00 /* Reserved, must be 0                */
+};
+
+static __attribute__((aligned(4))) struct __attribute__((packed))
+{
+	MXC_USB_configuration_descriptor_t config_descriptor;
+	MXC_USB_interface_descriptor_t iio_interface_descriptor;
+	/* Pipe 0 */
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_1;
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_2;
+	/* Pipe 1 */
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_3;
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_4;
+}
+
+usb_iio_config_descriptor = {
+	{
+		0x09, /*  bLength = 9                     */
+		0x02, /*  bDescriptorType = Config (2)    */
+		0x002E, /*  wTotalLength(L/H)               */
+		0x01, /*  bNumInterfaces                  */
+		0x01, /*  bConfigValue                    */
+		0x00, /*  iConfiguration                  */
+		0xE0, /*  bmAttributes (self-powered, remote wakeup) */
+		0x01, /*  MaxPower (units are 2ma/bit)    */
+	},
+	{
+		/*  Vendor specific interface, matched by name by libiio */
+		0x09, /*  bLength = 9                     */
+		0x04, /*  bDescriptorType = Interface (4) */
+		0x00, /*  bInterfaceNumber                */
+		0x00, /*  bAlternateSetting               */
+		0x04, /*  bNumEndpoints                   */
+		0xFF, /*  bInterfaceClass = Vendor specific */
+		0x00, /*  bInterfaceSubClass              */
+		0x00, /*  bInterfaceProtocol              */
+		0x04, /*  iInterface = "IIO"              */
+	},
+	{
+		/*  IN Endpoint 1 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x81, /*  bEndpointAddress (EP1-IN)        */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0040, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	},
+	{
+		/*  OUT Endpoint 2 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x02, /*  bEndpointAddress (EP2-OUT)       */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0040, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	},
+	{
+		/*  IN Endpoint 3 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x83, /*  bEndpointAddress (EP3-IN)        */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0040, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	},
+	{
+		/*  OUT Endpoint 4 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x04, /*  bEndpointAddress (EP4-OUT)       */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0040, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	}
+};
+
+static __attribute__((aligned(4))) struct __attribute__((packed))
+{
+	MXC_USB_configuration_descriptor_t config_descriptor;
+	MXC_USB_interface_descriptor_t iio_interface_descriptor;
+	/* Pipe 0 */
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_1;
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_2;
+	/* Pipe 1 */
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_3;
+	MXC_USB_endpoint_descriptor_t endpoint_descriptor_4;
+}
+
+usb_iio_config_descriptor_hs = {
+	{
+		0x09, /*  bLength = 9                     */
+		0x02, /*  bDescriptorType = Config (2)    */
+		0x002E, /*  wTotalLength(L/H)               */
+		0x01, /*  bNumInterfaces                  */
+		0x01, /*  bConfigValue                    */
+		0x00, /*  iConfiguration                  */
+		0xE0, /*  bmAttributes (self-powered, remote wakeup) */
+		0x32, /*  MaxPower (units are 2ma/bit)    */
+	},
+	{
+		/*  Vendor specific interface, matched by name by libiio */
+		0x09, /*  bLength = 9                     */
+		0x04, /*  bDescriptorType = Interface (4) */
+		0x00, /*  bInterfaceNumber                */
+		0x00, /*  bAlternateSetting               */
+		0x04, /*  bNumEndpoints                   */
+		0xFF, /*  bInterfaceClass = Vendor specific */
+		0x00, /*  bInterfaceSubClass              */
+		0x00, /*  bInterfaceProtocol              */
+		0x04, /*  iInterface = "IIO"              */
+	},
+	{
+		/*  IN Endpoint 1 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x81, /*  bEndpointAddress (EP1-IN)        */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0200, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	},
+	{
+		/*  OUT Endpoint 2 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x02, /*  bEndpointAddress (EP2-OUT)       */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0200, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	},
+	{
+		/*  IN Endpoint 3 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x83, /*  bEndpointAddress (EP3-IN)        */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0200, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	},
+	{
+		/*  OUT Endpoint 4 */
+		0x07, /*  bLength                          */
+		0x05, /*  bDescriptorType (Endpoint)       */
+		0x04, /*  bEndpointAddress (EP4-OUT)       */
+		0x02, /*  bmAttributes (bulk)              */
+		0x0200, /*  wMaxPacketSize                   */
+		0x00, /*  bInterval (N/A)                  */
+	}
+};
+
+static __attribute__((aligned(4))) uint8_t usb_iio_lang_id_desc[] = {
+	0x04, /* bLength */
+	0x03, /* bDescriptorType */
+	0x09, 0x04 /* bString = wLANGID (see usb_20.pdf 9.6.7 String) */
+};
+
+static __attribute__((aligned(4))) uint8_t usb_iio_mfg_id_desc[] = {
+	0x28, /* bLength */
+	0x03, /* bDescriptorType */
+	'A', 0, 'n', 0, 'a', 0, 'l', 0, 'o', 0, 'g', 0, ' ', 0, 'D', 0,
+	'e', 0, 'v', 0, 'i', 0, 'c', 0, 'e', 0, 's', 0, ' ', 0, 'I', 0,
+	'n', 0, 'c', 0, '.', 0,
+};
+
+static __attribute__((aligned(4))) uint8_t usb_iio_prod_id_desc[] = {
+	0x1A, /* bLength */
+	0x03, /* bDescriptorType */
+	'M', 0, 'A', 0, 'X', 0, '3', 0, '2', 0, '6', 0, '9', 0, '0', 0,
+	' ', 0, 'I', 0, 'I', 0, 'O', 0,
+};
+
+static __attribute__((aligned(4))) uint8_t usb_iio_serial_id_desc[] = {
+	0x14, /* bLength */
+	0x03, /* bDescriptorType */
+	'0', 0, '0', 0, '0', 0, '0', 0, '0', 0, '0', 0, '0', 0, '0', 0,
+	'1', 0,
+};
+
+static __attribute__((aligned(4))) uint8_t usb_iio_interface_desc[] = {
+	0x08, /* bLength */
+	0x03, /* bDescriptorType */
+	'I', 0, 'I', 0, 'O', 0,
+};
+
+#endif // MAXIM_USB_IIO_DESCRIPTORS_H_
@@ -56,6 +56,95 @@ extern "C"
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+#if DEVICE_I2C_ASYNCH
+/**
+ * @brief Work queue handler, invokes the callback of the async transfer.
+ * @param work[in] - The completion work of the I2C descriptor.
+ * @return none.
+ */
+static void mbed_i2c_async_work(struct no_os_work *work)
+{
+	struct mbed_i2c_desc *mbed_desc = (struct mbed_i2c_desc *)work->ctx;
+
+	mbed_desc->callback(mbed_desc->ctx, mbed_desc->status);
+}
+
+/**
+ * @brief End the async transfer in progress and invoke its callback, from the
+ *        work queue when one is set, otherwise from the I2C interrupt.
+ * @param mbed_desc[in] - The mbed I2C descriptor.
+ * @param status[in] - Result of the transfer.
+ * @return none.
+ */
+static void mbed_i2c_async_end(struct mbed_i2c_desc *mbed_desc, int32_t status)
+{
+	mbed_desc->status = status;
+	mbed_desc->async_desc = NULL;
+
+	if (!mbed_desc->callback)
+		return;
+
+	if (mbed_desc->wq)
+		no_os_work_post(mbed_desc->wq, &mbed_desc->work);
+	else
+		mbed_desc->callback(mbed_desc->ctx, status);
+}
+
+static void mbed_i2c_async_event(struct mbed_i2c_desc *mbed_desc, int event);
+
+/**
+ * @brief Start the current message, with a repeated start after it unless it
+ *        is the last one.
+ * @param mbed_desc[in] - The mbed I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t mbed_i2c_async_start(struct mbed_i2c_desc *mbed_desc)
+{
+	struct no_os_i2c_msg *msg = &mbed_desc->msgs[mbed_desc->msg_idx];
+	mbed::I2C *i2c = (I2C *)mbed_desc->i2c_port;
+	bool rd = msg->flags & NO_OS_I2C_M_RD;
+	int ret;
+
+	ret = i2c->transfer(mbed_desc->async_desc->slave_address,
+			    rd ? NULL : (const char *)msg->buf, rd ? 0 : msg->len,
+			    rd ? (char *)msg->buf : NULL, rd ? msg->len : 0,
+			    mbed::callback(mbed_i2c_async_event, mbed_desc),
+			    I2C_EVENT_ALL,
+			    mbed_desc->msg_idx + 1 < mbed_desc->nb_msgs);
+
+	return ret ? -EBUSY : 0;
+}
+
+/**
+ * @brief I2C interrupt event of a message, starts the next one.
+ * @param mbed_desc[in] - The mbed I2C descriptor.
+ * @param event[in] - I2C_EVENT_* flags of the message.
+ * @return none.
+ */
+static void mbed_i2c_async_event(struct mbed_i2c_desc *mbed_desc, int event)
+{
+	int32_t ret;
+
+	if (event & (I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)) {
+		mbed_i2c_async_end(mbed_desc, -ENXIO);
+		return;
+	}
+	if (!(event & I2C_EVENT_TRANSFER_COMPLETE)) {
+		mbed_i2c_async_end(mbed_desc, -EIO);
+		return;
+	}
+
+	if (++mbed_desc->msg_idx == mbed_desc->nb_msgs) {
+		mbed_i2c_async_end(mbed_desc, 0);
+		return;
+	}
+
+	ret = mbed_i2c_async_start(mbed_desc);
+	if (ret)
+		mbed_i2c_async_end(mbed_desc, ret);
+}
+#endif
+
 /**
  * @brief Initialize the I2C communication peripheral.
  * @param desc[in,out] - The I2C descriptor.
@@ -97,6 +186,11 @@ int32_t mbed_i2c_init(struct no_os_i2c_desc **desc,
 	i2c->frequency(param->max_speed_hz);
 
 	mbed_i2c_desc->i2c_port = i2c;
+#if DEVICE_I2C_ASYNCH
+	mbed_i2c_desc->wq = ((struct mbed_i2c_init_param *)param->extra)->wq;
+	mbed_i2c_desc->work.func = mbed_i2c_async_work;
+	mbed_i2c_desc->work.ctx = mbed_i2c_desc;
+#endif
 	i2c_desc->extra = mbed_i2c_desc;
 
 	*desc = i2c_desc;
@@ -121,6 +215,11 @@ int32_t mbed_i2c_remove(struct no_os_i2c_desc *desc)
 	if (!desc || !desc->extra)
 		return -EINVAL;
 
+#if DEVICE_I2C_ASYNCH
+	if (((mbed_i2c_desc *)(desc->extra))->async_desc)
+		((I2C *)(((mbed_i2c_desc *)(desc->extra))->i2c_port))->abort_transfer();
+#endif
+
 	/* Free the I2C port object */
 	if ((I2C *)(((mbed_i2c_desc *)(desc->extra))->i2c_port))
 		delete((I2C *)(((mbed_i2c_desc *)(desc->extra))->i2c_port));
@@ -200,6 +299,49 @@ int32_t mbed_i2c_read(struct no_os_i2c_desc *desc,
 	return 0;
 }
 
+#if DEVICE_I2C_ASYNCH
+/**
+ * @brief Start the transfer of a list of messages, joined by repeated starts,
+ *        and return.
+ * @param desc[in] - The I2C descriptor.
+ * @param msgs[in, out] - The messages, valid until the callback.
+ * @param nb_msgs[in] - Number of messages.
+ * @param callback[in] - Invoked with the result, from the work queue of the
+ *                       init param when set, otherwise from the I2C interrupt.
+ * @param ctx[in] - Parameter of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t mbed_i2c_transfer_async(struct no_os_i2c_desc *desc,
+				struct no_os_i2c_msg *msgs,
+				uint32_t nb_msgs,
+				void (*callback)(void *, int32_t),
+				void *ctx)
+{
+	struct mbed_i2c_desc *mbed_desc;
+	int32_t ret;
+
+	if (!desc || !desc->extra || !msgs || !nb_msgs)
+		return -EINVAL;
+
+	mbed_desc = (struct mbed_i2c_desc *)desc->extra;
+	if (mbed_desc->async_desc)
+		return -EBUSY;
+
+	mbed_desc->msgs = msgs;
+	mbed_desc->nb_msgs = nb_msgs;
+	mbed_desc->msg_idx = 0;
+	mbed_desc->callback = callback;
+	mbed_desc->ctx = ctx;
+	mbed_desc->async_desc = desc;
+
+	ret = mbed_i2c_async_start(mbed_desc);
+	if (ret)
+		mbed_desc->async_desc = NULL;
+
+	return ret;
+}
+#endif
+
 /**
 * @brief Mbed platform specific I2C platform ops structure
 */
@@ -207,6 +349,9 @@ const struct no_os_i2c_platform_ops mbed_i2c_ops = {
 	.i2c_ops_init = &mbed_i2c_init,
 	.i2c_ops_write = &mbed_i2c_write,
 	.i2c_ops_read = &mbed_i2c_read,
+#if DEVICE_I2C_ASYNCH
+	.i2c_ops_transfer_async = &mbed_i2c_transfer_async,
+#endif
 	.i2c_ops_remove = &mbed_i2c_remove
 };
 
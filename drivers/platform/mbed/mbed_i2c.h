@@ -49,6 +49,9 @@ extern "C"
 /******************************************************************************/
 
 #include <stdio.h>
+#include <stdbool.h>
+#include "no_os_i2c.h"
+#include "no_os_work.h"
 
 /******************************************************************************/
 /********************** Variables and User defined data types *****************/
@@ -69,6 +72,8 @@ extern "C"
 struct mbed_i2c_init_param {
 	uint16_t i2c_sda_pin;  	// I2C SDA pin (PinName)
 	uint16_t i2c_scl_pin;  	// I2C SCL pin (PinName)
+	struct no_os_workqueue *wq;	// Runs the async completion callbacks, NULL
+	// to invoke them from the I2C interrupt
 };
 
 /**
@@ -77,6 +82,15 @@ struct mbed_i2c_init_param {
 */
 struct mbed_i2c_desc {
 	void *i2c_port;  		// I2C port instance (mbed::I2C)
+	struct no_os_workqueue *wq;	// Work queue of the async completion callbacks
+	struct no_os_work work;		// Completion of the async transfer
+	struct no_os_i2c_desc *async_desc;	// Descriptor of the async transfer
+	struct no_os_i2c_msg *msgs;	// Messages of the async transfer
+	uint32_t nb_msgs;		// Number of messages
+	uint32_t msg_idx;		// Message in progress
+	void (*callback)(void *, int32_t);	// Invoked with the result
+	void *ctx;				// Parameter of the callback
+	int32_t status;			// Result of the last async transfer
 };
 
 /**
@@ -72,6 +72,16 @@ struct mbed_irq_callback_desc {
 /* Mbed irq callback structure variable */
 static struct mbed_irq_callback_desc mbed_irq_callback[NB_INTERRUPTS];
 
+/* Work queue the ticker callback is deferred to, NULL to run it in the ISR */
+static struct no_os_workqueue *ticker_wq;
+
+static void mbed_ticker_work(struct no_os_work *work);
+
+/* Ticker callback, posted to ticker_wq */
+static struct no_os_work ticker_work = {
+	.func = mbed_ticker_work,
+};
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -90,14 +100,32 @@ static void mbed_uart_rx_id1_callback(void)
 			mbed_irq_callback[UART_RX_INT_ID1].desc.ctx);
 }
 
+/**
+ * @brief	Work queue handler of the ticker event.
+ * @param	work[in] - The ticker work.
+ * @return	none.
+ */
+static void mbed_ticker_work(struct no_os_work *work)
+{
+	if (mbed_irq_callback[TICKER_INT_ID].desc.callback)
+		mbed_irq_callback[TICKER_INT_ID].desc.callback(
+			mbed_irq_callback[TICKER_INT_ID].desc.ctx);
+}
+
 /**
  * @brief	Mbed callback function for ticker ID event.
  * @return	none.
  * @note	This function is called when external IRQ event mapped to
- *			TICKER_INT_ID is triggered.
+ *			TICKER_INT_ID is triggered. The application callback is
+ *			deferred to the work queue of the init param, when set.
  */
 static void mbed_ticker_id_callback(void)
 {
+	if (ticker_wq) {
+		no_os_work_post(ticker_wq, &ticker_work);
+		return;
+	}
+
 	if (mbed_irq_callback[TICKER_INT_ID].desc.callback)
 		/* Invoke the application registered callback function */
 		mbed_irq_callback[TICKER_INT_ID].desc.callback(
@@ -145,6 +173,7 @@ int32_t mbed_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 					     param->extra)->ticker_period_usec;
 	mbed_irq_desc->int_obj = ((struct mbed_irq_init_param *)
 				  param->extra)->int_obj_type;
+	mbed_irq_desc->wq = ((struct mbed_irq_init_param *)param->extra)->wq;
 
 	irq_desc->extra = mbed_irq_desc;
 	*desc = irq_desc;
@@ -265,9 +294,12 @@ int32_t mbed_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 		 * start invoking the interrupt */
 		mbed_irq_callback[irq_id].desc.callback = callback_desc->callback;
 		mbed_irq_callback[irq_id].desc.ctx = callback_desc->ctx;
+		ticker_wq = mbed_irq_desc->wq;
 		break;
 
 	case UART_RX_INT_ID1:
+		/* Not deferred: the received byte has to be read in the ISR,
+		 * or the interrupt keeps firing */
 		/* Callback is attached from 'mbed_irq_enable' as uart attach immediately
 		 * start invoking the interrupt */
 		mbed_irq_callback[irq_id].desc.callback = callback_desc->callback;
@@ -300,6 +332,9 @@ int32_t mbed_irq_unregister(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
 	if (ret)
 		return ret;
 
+	if (irq_id == TICKER_INT_ID && ticker_wq)
+		no_os_work_cancel(ticker_wq, &ticker_work);
+
 	mbed_irq_callback[irq_id].desc.callback = NULL;
 
 	return 0;
@@ -49,6 +49,7 @@ extern "C"
 /******************************************************************************/
 
 #include <stdbool.h>
+#include "no_os_work.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -86,6 +87,9 @@ enum irq_id {
 struct mbed_irq_init_param {
 	uint32_t ticker_period_usec;	// Time period in usec for ticker event
 	void *int_obj_type;		// Other app created Mbed driver instance (e.g. UnBuffered uart)
+	struct no_os_workqueue *wq;	// Runs the ticker callback, NULL to invoke it
+	// from the ticker interrupt. A tick arriving while the previous one is
+	// still queued is merged with it.
 };
 
 /**
@@ -95,6 +99,7 @@ struct mbed_irq_init_param {
 struct mbed_irq_desc {
 	uint32_t ticker_period_usec;	// Time period in usec for ticker event
 	void *int_obj;			// Mbed driver instance (e.g. Ticker, uart)
+	struct no_os_workqueue *wq;	// Work queue of the ticker callback
 };
 
 /**
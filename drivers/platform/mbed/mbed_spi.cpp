@@ -51,6 +51,7 @@ extern "C"
 #include "no_os_error.h"
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_mutex.h"
 #include "mbed_spi.h"
 
 #define		SPI_8_BIT_FRAME			8		// SPI 8-bit frame size
@@ -61,6 +62,95 @@ extern "C"
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+#if DEVICE_SPI_ASYNCH
+/**
+ * @brief Work queue handler, invokes the callback of the DMA transfer.
+ * @param work[in] - The completion work of the SPI descriptor.
+ * @return none.
+ */
+static void mbed_spi_async_work(struct no_os_work *work)
+{
+	struct mbed_spi_desc *mbed_desc = (struct mbed_spi_desc *)work->ctx;
+
+	mbed_desc->callback(mbed_desc->ctx);
+}
+
+/**
+ * @brief End the DMA transfer in progress and invoke its callback, from the
+ *        work queue when one is set, otherwise from the SPI interrupt.
+ * @param mbed_desc[in] - The mbed SPI descriptor.
+ * @param status[in] - Result of the transfer.
+ * @return none.
+ */
+static void mbed_spi_async_end(struct mbed_spi_desc *mbed_desc, int32_t status)
+{
+	((DigitalOut *)mbed_desc->csb_gpio)->write(NO_OS_GPIO_HIGH);
+
+	mbed_desc->status = status;
+	mbed_desc->busy = false;
+
+	if (!mbed_desc->callback)
+		return;
+
+	if (mbed_desc->wq)
+		no_os_work_post(mbed_desc->wq, &mbed_desc->work);
+	else
+		mbed_desc->callback(mbed_desc->ctx);
+}
+
+static void mbed_spi_async_event(struct mbed_spi_desc *mbed_desc, int event);
+
+/**
+ * @brief Assert the chip select and start the transfer of the current message.
+ * @param mbed_desc[in] - The mbed SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t mbed_spi_async_start(struct mbed_spi_desc *mbed_desc)
+{
+	struct no_os_spi_msg *msg = &mbed_desc->msgs[mbed_desc->msg_idx];
+	mbed::SPI *spi = (SPI *)mbed_desc->spi_port;
+
+	((DigitalOut *)mbed_desc->csb_gpio)->write(NO_OS_GPIO_LOW);
+
+	if (spi->transfer((const uint8_t *)msg->tx_buff,
+			  msg->tx_buff ? msg->bytes_number : 0,
+			  msg->rx_buff, msg->rx_buff ? msg->bytes_number : 0,
+			  mbed::callback(mbed_spi_async_event, mbed_desc),
+			  SPI_EVENT_COMPLETE | SPI_EVENT_ERROR))
+		return -EBUSY;
+
+	return 0;
+}
+
+/**
+ * @brief SPI interrupt event of a message, starts the next one.
+ * @param mbed_desc[in] - The mbed SPI descriptor.
+ * @param event[in] - SPI_EVENT_* flags of the message.
+ * @return none.
+ */
+static void mbed_spi_async_event(struct mbed_spi_desc *mbed_desc, int event)
+{
+	int32_t ret;
+
+	if (!(event & SPI_EVENT_COMPLETE)) {
+		mbed_spi_async_end(mbed_desc, -EIO);
+		return;
+	}
+
+	if (mbed_desc->msgs[mbed_desc->msg_idx].cs_change)
+		((DigitalOut *)mbed_desc->csb_gpio)->write(NO_OS_GPIO_HIGH);
+
+	if (++mbed_desc->msg_idx == mbed_desc->nb_msgs) {
+		mbed_spi_async_end(mbed_desc, 0);
+		return;
+	}
+
+	ret = mbed_spi_async_start(mbed_desc);
+	if (ret)
+		mbed_spi_async_end(mbed_desc, ret);
+}
+#endif
+
 /**
  * @brief Initialize the Mbed SPI communication peripheral.
  * @param desc[in,out] - The SPI descriptor.
@@ -140,6 +230,14 @@ int32_t mbed_spi_init(struct no_os_spi_desc **desc,
 	spi->format(SPI_8_BIT_FRAME, param->mode);   // data write/read format
 	spi->set_default_write_value(0x00);          // code to write when reading back
 
+#if DEVICE_SPI_ASYNCH
+	/* Asynchronous transfers use DMA when the target has a channel for it */
+	spi->set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+	mbed_spi_desc->wq = ((struct mbed_spi_init_param *)param->extra)->wq;
+	mbed_spi_desc->work.func = mbed_spi_async_work;
+	mbed_spi_desc->work.ctx = mbed_spi_desc;
+#endif
+
 	return 0;
 
 err_spi:
@@ -166,6 +264,11 @@ int32_t mbed_spi_remove(struct no_os_spi_desc *desc)
 	if (!desc || !desc->extra)
 		return -EINVAL;
 
+#if DEVICE_SPI_ASYNCH
+	if (((struct mbed_spi_desc *)desc->extra)->busy)
+		((SPI *)(((struct mbed_spi_desc *)(desc->extra))->spi_port))->abort_transfer();
+#endif
+
 	if (((struct mbed_spi_desc *)desc->extra)->use_sw_csb) {
 		/* Free the CSB gpio object */
 		if ((DigitalOut *)(((struct mbed_spi_desc *)(desc->extra))->csb_gpio))
@@ -260,6 +363,87 @@ int32_t mbed_spi_transfer(struct no_os_spi_desc *desc, struct no_os_spi_msg *msg
 	return 0;
 }
 
+#if DEVICE_SPI_ASYNCH
+/**
+ * @brief Start the transfer of the SPI messages, by DMA when the target
+ *        supports it, and return.
+ * @param desc[in] - The SPI descriptor.
+ * @param msgs[in, out] - Pointer to SPI messages, valid until the callback.
+ * @param num_of_msgs[in] - Number of SPI messages.
+ * @param callback[in] - Invoked once all the messages are transferred, from
+ *                       the work queue of the init param when set, otherwise
+ *                       from the SPI interrupt. May be NULL.
+ * @param ctx[in] - Parameter of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note Use of this function requires CSB pin to be software controlled.
+ */
+int32_t mbed_spi_dma_transfer_async(struct no_os_spi_desc *desc,
+				    struct no_os_spi_msg *msgs,
+				    uint32_t num_of_msgs,
+				    void (*callback)(void *),
+				    void *ctx)
+{
+	struct mbed_spi_desc *mbed_desc;
+	int32_t ret;
+
+	if (!desc || !desc->extra || !msgs || !num_of_msgs)
+		return -EINVAL;
+
+	mbed_desc = (struct mbed_spi_desc *)desc->extra;
+	if (!mbed_desc->use_sw_csb)
+		return -EINVAL;
+
+	if (mbed_desc->busy)
+		return -EBUSY;
+
+	mbed_desc->msgs = msgs;
+	mbed_desc->nb_msgs = num_of_msgs;
+	mbed_desc->msg_idx = 0;
+	mbed_desc->callback = callback;
+	mbed_desc->ctx = ctx;
+	mbed_desc->busy = true;
+
+	ret = mbed_spi_async_start(mbed_desc);
+	if (ret) {
+		((DigitalOut *)mbed_desc->csb_gpio)->write(NO_OS_GPIO_HIGH);
+		mbed_desc->busy = false;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Transfer the SPI messages by DMA, the core sleeps until the end.
+ * @param desc[in] - The SPI descriptor.
+ * @param msgs[in, out] - Pointer to SPI messages.
+ * @param num_of_msgs[in] - Number of SPI messages.
+ * @return 0 in case of success, negative error code otherwise.
+ * @note Use of this function requires CSB pin to be software controlled.
+ */
+int32_t mbed_spi_dma_transfer_sync(struct no_os_spi_desc *desc,
+				   struct no_os_spi_msg *msgs,
+				   uint32_t num_of_msgs)
+{
+	struct mbed_spi_desc *mbed_desc;
+	uint32_t state;
+	int32_t ret;
+
+	ret = mbed_spi_dma_transfer_async(desc, msgs, num_of_msgs, NULL, NULL);
+	if (ret)
+		return ret;
+
+	mbed_desc = (struct mbed_spi_desc *)desc->extra;
+	while (mbed_desc->busy) {
+		state = no_os_critical_enter();
+		if (mbed_desc->busy)
+			no_os_wait_for_interrupt();
+		no_os_critical_exit(state);
+	}
+
+	return mbed_desc->status;
+}
+#endif
+
 /**
 * @brief Mbed platform specific SPI platform ops structure
 */
@@ -267,6 +451,10 @@ const struct no_os_spi_platform_ops mbed_spi_ops = {
 	.init = &mbed_spi_init,
 	.write_and_read = &mbed_spi_write_and_read,
 	.transfer = &mbed_spi_transfer,
+#if DEVICE_SPI_ASYNCH
+	.dma_transfer_sync = &mbed_spi_dma_transfer_sync,
+	.dma_transfer_async = &mbed_spi_dma_transfer_async,
+#endif
 	.remove = &mbed_spi_remove,
 };
 
@@ -49,6 +49,8 @@ extern "C"
 /******************************************************************************/
 #include <stdio.h>
 #include <stdbool.h>
+#include "no_os_spi.h"
+#include "no_os_work.h"
 
 /******************************************************************************/
 /********************** Variables and User defined data types *****************/
@@ -71,6 +73,8 @@ struct mbed_spi_init_param {
 	uint16_t spi_mosi_pin;  	// SPI MOSI pin (PinName)
 	uint16_t spi_clk_pin;  		// SPI CLK pin (PinName)
 	bool use_sw_csb;			// Software/Hardware control of CSB pin
+	struct no_os_workqueue *wq;	// Runs the DMA completion callbacks, NULL
+	// to invoke them from the SPI interrupt
 };
 
 /**
@@ -81,6 +85,15 @@ struct mbed_spi_desc {
 	void *spi_port; 			// SPI port instance (mbed::SPI)
 	void *csb_gpio;  			// SPI chip select gpio instance (DigitalOut)
 	bool use_sw_csb; 			// Software/Hardware control of CSB pin
+	struct no_os_workqueue *wq;	// Work queue of the DMA completion callbacks
+	struct no_os_work work;		// Completion of the DMA transfer
+	struct no_os_spi_msg *msgs;	// Messages of the DMA transfer
+	uint32_t nb_msgs;			// Number of messages
+	uint32_t msg_idx;			// Message in progress
+	void (*callback)(void *);	// Invoked once the DMA transfer is done
+	void *ctx;					// Parameter of the callback
+	int32_t status;				// Result of the last DMA transfer
+	volatile bool busy;			// A DMA transfer is in progress
 };
 
 /**
@@ -0,0 +1,593 @@
+/***************************************************************************//**
+ *   @file   pico/pico_pio_capture.c
+ *   @brief  PIO and DMA driven capture engines for the pico platform.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/************************* Include Files **************************************/
+/******************************************************************************/
+
+#include <stddef.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "pico_pio_capture.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define PICO_PIO_CAPTURE_MAX_SM		(NUM_PIOS * 4)
+
+/* SAR engine, SCK is side-set */
+#define SAR_SIDE(v)		pio_encode_sideset(1, v)
+#define SAR_WRAP_TARGET		1
+#define SAR_CONV		3
+#define SAR_BIT			6
+#define SAR_WRAP		7
+/* Cycles of a conversion besides the wait loop and the bits */
+#define SAR_FIXED_CYCLES	5
+
+/* Parallel engine, CS and RD are side-set, idle high */
+#define PAR_SIDE(v)		pio_encode_sideset(2, v)
+#define PAR_IDLE		3
+#define PAR_CS			2
+#define PAR_CS_RD		0
+#define PAR_WRAP_TARGET		3
+#define PAR_CH			8
+#define PAR_PAD			12
+#define PAR_WRAP		12
+/* Cycles of a conversion besides BUSY, the channel reads and the padding */
+#define PAR_FIXED_CYCLES	8
+#define PAR_CH_CYCLES		3
+
+/******************************************************************************/
+/************************ Variable Declarations ******************************/
+/******************************************************************************/
+
+static struct pico_pio_capture_desc *active[PICO_PIO_CAPTURE_MAX_SM];
+static bool irq_added;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Re-arm the DMA channel of the filled half and hand it to the callback.
+ */
+static void pico_pio_capture_dma_isr(void)
+{
+	struct pico_pio_capture_desc *desc;
+	uint32_t i, j;
+
+	for (i = 0; i < PICO_PIO_CAPTURE_MAX_SM; i++) {
+		desc = active[i];
+		if (!desc || !desc->running || !desc->half[0])
+			continue;
+
+		for (j = 0; j < 2; j++) {
+			if (!dma_channel_get_irq0_status(desc->dma[j]))
+				continue;
+
+			dma_channel_acknowledge_irq0(desc->dma[j]);
+			/* Runs again when the other half is filled */
+			dma_channel_set_write_addr(desc->dma[j], desc->half[j],
+						   false);
+			desc->filled++;
+			if (desc->callback)
+				desc->callback(desc->ctx, desc->half[j],
+					       desc->half_words);
+		}
+	}
+}
+
+/**
+ * @brief Clock divider of the state machine, in 1/256 of the system clock.
+ * @param pio_hz - Requested PIO clock.
+ * @return The divider.
+ */
+static uint32_t pico_pio_capture_div(uint32_t pio_hz)
+{
+	uint64_t div;
+
+	div = ((uint64_t)clock_get_hz(clk_sys) << 8) / pio_hz;
+
+	return no_os_clamp(div, 1U << 8, 0xFFFFFFU);
+}
+
+/**
+ * @brief Build the SAR read engine.
+ * @param desc - The descriptor.
+ * @param param - The init parameters.
+ * @param c - State machine config.
+ * @param pio_hz - PIO clock.
+ * @param params - Words loaded into the TX FIFO at each start.
+ * @return Number of parameters, negative error code otherwise.
+ */
+static int pico_pio_capture_sar(struct pico_pio_capture_desc *desc,
+				const struct pico_pio_capture_init_param *param,
+				pio_sm_config *c, uint32_t pio_hz,
+				uint32_t *params)
+{
+	uint32_t clocks, conv, period, wait;
+	uint16_t *p = desc->insn;
+
+	if ((param->lanes != 1 && param->lanes != 2 && param->lanes != 4) ||
+	    !param->bits || param->bits > 32 || param->bits % param->lanes)
+		return -EINVAL;
+
+	clocks = param->bits / param->lanes;
+
+	/* The wait loop count stays in OSR */
+	p[0] = pio_encode_pull(false, true) | SAR_SIDE(0);
+	/* CNV high starts the conversion */
+	p[1] = pio_encode_set(pio_pins, 1) | SAR_SIDE(0);
+	p[2] = pio_encode_mov(pio_x, pio_osr) | SAR_SIDE(0);
+	p[3] = pio_encode_jmp_x_dec(SAR_CONV) | SAR_SIDE(0);
+	/* CNV low enables SDO */
+	p[4] = pio_encode_set(pio_pins, 0) | SAR_SIDE(0);
+	p[5] = pio_encode_set(pio_y, clocks - 1) | SAR_SIDE(0);
+	/* Sample on the rising edge of SCK, SDO changes on the falling one */
+	p[6] = pio_encode_in(pio_pins, param->lanes) | SAR_SIDE(1);
+	p[7] = pio_encode_jmp_y_dec(SAR_BIT) | SAR_SIDE(0);
+	desc->program.length = SAR_WRAP + 1;
+
+	conv = NO_OS_DIV_ROUND_UP((uint64_t)param->conv_ns * pio_hz, 1000000000);
+	wait = conv ? conv - 1 : 0;
+	if (param->sample_rate) {
+		period = pio_hz / param->sample_rate;
+		if (period > wait + SAR_FIXED_CYCLES + 2 * clocks)
+			wait = period - SAR_FIXED_CYCLES - 2 * clocks;
+	}
+	params[0] = wait;
+	desc->sample_rate = pio_hz / (wait + SAR_FIXED_CYCLES + 2 * clocks);
+
+	sm_config_set_sideset(c, 1, false, false);
+	sm_config_set_sideset_pins(c, param->clk_pin);
+	sm_config_set_set_pins(c, param->cnv_pin, 1);
+	sm_config_set_in_pins(c, param->data_pin);
+	/* MSB first, one word per conversion */
+	sm_config_set_in_shift(c, false, true, param->bits);
+
+	desc->word_size = sizeof(uint32_t);
+	desc->words = 1;
+
+	return 1;
+}
+
+/**
+ * @brief Build the parallel bus reader.
+ * @param desc - The descriptor.
+ * @param param - The init parameters.
+ * @param c - State machine config.
+ * @param pio_hz - PIO clock.
+ * @param params - Words loaded into the TX FIFO at each start.
+ * @return Number of parameters, negative error code otherwise.
+ */
+static int pico_pio_capture_par(struct pico_pio_capture_desc *desc,
+				const struct pico_pio_capture_init_param *param,
+				pio_sm_config *c, uint32_t pio_hz,
+				uint32_t *params)
+{
+	uint32_t busy, period, pad, used;
+	uint16_t *p = desc->insn;
+
+	if (!param->nb_channels)
+		return -EINVAL;
+
+	/* Padding in Y, channel count in OSR */
+	p[0] = pio_encode_pull(false, true) | PAR_SIDE(PAR_IDLE);
+	p[1] = pio_encode_mov(pio_y, pio_osr) | PAR_SIDE(PAR_IDLE);
+	p[2] = pio_encode_pull(false, true) | PAR_SIDE(PAR_IDLE);
+	/* The rising edge of CONVST starts the conversion */
+	p[3] = pio_encode_set(pio_pins, 0) | PAR_SIDE(PAR_IDLE) |
+	       pio_encode_delay(1);
+	p[4] = pio_encode_set(pio_pins, 1) | PAR_SIDE(PAR_IDLE);
+	p[5] = pio_encode_wait_gpio(true, param->busy_pin) | PAR_SIDE(PAR_IDLE);
+	p[6] = pio_encode_wait_gpio(false, param->busy_pin) | PAR_SIDE(PAR_IDLE);
+	p[7] = pio_encode_mov(pio_x, pio_osr) | PAR_SIDE(PAR_IDLE);
+	/* One channel per RD pulse, sampled before RD rises */
+	p[8] = pio_encode_nop() | PAR_SIDE(PAR_CS_RD);
+	p[9] = pio_encode_in(pio_pins, PICO_PIO_CAPTURE_PARALLEL_BITS) |
+	       PAR_SIDE(PAR_CS_RD);
+	p[10] = pio_encode_jmp_x_dec(PAR_CH) | PAR_SIDE(PAR_CS);
+	p[11] = pio_encode_mov(pio_x, pio_y) | PAR_SIDE(PAR_IDLE);
+	p[12] = pio_encode_jmp_x_dec(PAR_PAD) | PAR_SIDE(PAR_IDLE);
+	desc->program.length = PAR_WRAP + 1;
+
+	busy = NO_OS_DIV_ROUND_UP((uint64_t)param->conv_ns * pio_hz, 1000000000);
+	used = PAR_FIXED_CYCLES + busy + PAR_CH_CYCLES * param->nb_channels;
+	pad = 0;
+	if (param->sample_rate) {
+		period = pio_hz / param->sample_rate;
+		if (period > used)
+			pad = period - used;
+	}
+	params[0] = pad;
+	params[1] = param->nb_channels - 1;
+	desc->sample_rate = pio_hz / (used + pad);
+
+	sm_config_set_sideset(c, 2, false, false);
+	sm_config_set_sideset_pins(c, param->clk_pin);
+	sm_config_set_set_pins(c, param->cnv_pin, 1);
+	sm_config_set_in_pins(c, param->data_pin);
+	sm_config_set_in_shift(c, false, true, PICO_PIO_CAPTURE_PARALLEL_BITS);
+
+	desc->word_size = sizeof(uint16_t);
+	desc->words = param->nb_channels;
+
+	return 2;
+}
+
+/**
+ * @brief Restart the state machine from the beginning of its program.
+ * @param desc - The descriptor.
+ */
+static void pico_pio_capture_arm(struct pico_pio_capture_desc *desc)
+{
+	uint32_t i;
+
+	pio_sm_set_enabled(desc->pio, desc->sm, false);
+	pio_sm_clear_fifos(desc->pio, desc->sm);
+	pio_sm_restart(desc->pio, desc->sm);
+	pio_sm_clkdiv_restart(desc->pio, desc->sm);
+	pio_sm_exec(desc->pio, desc->sm, pio_encode_jmp(desc->offset));
+	for (i = 0; i < desc->nb_params; i++)
+		pio_sm_put(desc->pio, desc->sm, desc->params[i]);
+}
+
+/**
+ * @brief DMA channel reading the RX FIFO of the state machine.
+ * @param desc - The descriptor.
+ * @param ch - Index of the channel.
+ * @param chain - Index of the channel started at the end, ch for none.
+ * @param buf - Destination.
+ * @param nb - Number of words.
+ * @param trigger - Start the channel.
+ */
+static void pico_pio_capture_dma(struct pico_pio_capture_desc *desc,
+				 uint32_t ch, uint32_t chain, void *buf,
+				 uint32_t nb, bool trigger)
+{
+	dma_channel_config c;
+
+	c = dma_channel_get_default_config(desc->dma[ch]);
+	channel_config_set_transfer_data_size(&c, desc->word_size ==
+					      sizeof(uint16_t) ?
+					      DMA_SIZE_16 : DMA_SIZE_32);
+	channel_config_set_read_increment(&c, false);
+	channel_config_set_write_increment(&c, true);
+	channel_config_set_dreq(&c, pio_get_dreq(desc->pio, desc->sm, false));
+	channel_config_set_chain_to(&c, desc->dma[chain]);
+	dma_channel_configure(desc->dma[ch], &c, buf, &desc->pio->rxf[desc->sm],
+			      nb, trigger);
+}
+
+/**
+ * @brief Load the program of a capture engine and claim its state machine and
+ * DMA channels.
+ * @param desc - The descriptor.
+ * @param param - The init parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pico_pio_capture_init(struct pico_pio_capture_desc **desc,
+			  const struct pico_pio_capture_init_param *param)
+{
+	struct pico_pio_capture_desc *d;
+	uint32_t div, pio_hz, nb_out, i;
+	pio_sm_config c;
+	int ret, sm;
+
+	if (!desc || !param || param->pio >= NUM_PIOS || !param->clk_hz)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->mode = param->mode;
+	d->pio = param->pio ? pio1 : pio0;
+	d->callback = param->callback;
+	d->ctx = param->ctx;
+	d->dma[0] = -1;
+	d->dma[1] = -1;
+	d->program.instructions = d->insn;
+	d->program.origin = -1;
+
+	c = pio_get_default_sm_config();
+
+	/* SAR: 2 cycles per SCK period, parallel: 3 cycles per RD period */
+	if (param->mode == PICO_PIO_CAPTURE_SAR) {
+		div = pico_pio_capture_div(2 * param->clk_hz);
+		pio_hz = ((uint64_t)clock_get_hz(clk_sys) << 8) / div;
+		ret = pico_pio_capture_sar(d, param, &c, pio_hz, d->params);
+		nb_out = 2;
+	} else if (param->mode == PICO_PIO_CAPTURE_PARALLEL) {
+		div = pico_pio_capture_div(PAR_CH_CYCLES * param->clk_hz);
+		pio_hz = ((uint64_t)clock_get_hz(clk_sys) << 8) / div;
+		ret = pico_pio_capture_par(d, param, &c, pio_hz, d->params);
+		nb_out = 3;
+	} else {
+		ret = -EINVAL;
+	}
+	if (ret < 0)
+		goto free_desc;
+	d->nb_params = ret;
+
+	if (!pio_can_add_program(d->pio, &d->program)) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	sm = pio_claim_unused_sm(d->pio, false);
+	if (sm < 0) {
+		ret = -EBUSY;
+		goto free_desc;
+	}
+	d->sm = sm;
+
+	for (i = 0; i < 2; i++) {
+		d->dma[i] = dma_claim_unused_channel(false);
+		if (d->dma[i] < 0) {
+			ret = -EBUSY;
+			goto free_dma;
+		}
+	}
+
+	d->offset = pio_add_program(d->pio, &d->program);
+	if (param->mode == PICO_PIO_CAPTURE_SAR)
+		sm_config_set_wrap(&c, d->offset + SAR_WRAP_TARGET,
+				   d->offset + SAR_WRAP);
+	else
+		sm_config_set_wrap(&c, d->offset + PAR_WRAP_TARGET,
+				   d->offset + PAR_WRAP);
+	sm_config_set_clkdiv_int_frac(&c, div >> 8, div & 0xFF);
+	sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+
+	/* CNV and SCK low, or CONVST, CS and RD high, when idle */
+	if (param->mode == PICO_PIO_CAPTURE_SAR) {
+		pio_sm_set_pins_with_mask(d->pio, d->sm, 0,
+					  NO_OS_BIT(param->cnv_pin) |
+					  NO_OS_BIT(param->clk_pin));
+		pio_sm_set_consecutive_pindirs(d->pio, d->sm, param->data_pin,
+					       param->lanes, false);
+		for (i = 0; i < param->lanes; i++)
+			pio_gpio_init(d->pio, param->data_pin + i);
+	} else {
+		pio_sm_set_pins_with_mask(d->pio, d->sm,
+					  NO_OS_BIT(param->cnv_pin) |
+					  NO_OS_GENMASK(param->clk_pin + 1,
+							param->clk_pin),
+					  NO_OS_BIT(param->cnv_pin) |
+					  NO_OS_GENMASK(param->clk_pin + 1,
+							param->clk_pin));
+		pio_sm_set_consecutive_pindirs(d->pio, d->sm, param->data_pin,
+					       PICO_PIO_CAPTURE_PARALLEL_BITS,
+					       false);
+		for (i = 0; i < PICO_PIO_CAPTURE_PARALLEL_BITS; i++)
+			pio_gpio_init(d->pio, param->data_pin + i);
+	}
+	pio_sm_set_consecutive_pindirs(d->pio, d->sm, param->cnv_pin, 1, true);
+	pio_sm_set_consecutive_pindirs(d->pio, d->sm, param->clk_pin,
+				       nb_out - 1, true);
+	pio_gpio_init(d->pio, param->cnv_pin);
+	for (i = 0; i < nb_out - 1; i++)
+		pio_gpio_init(d->pio, param->clk_pin + i);
+
+	pio_sm_init(d->pio, d->sm, d->offset, &c);
+
+	if (!irq_added) {
+		irq_add_shared_handler(DMA_IRQ_0, pico_pio_capture_dma_isr,
+				       PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+		irq_set_enabled(DMA_IRQ_0, true);
+		irq_added = true;
+	}
+	active[pio_get_index(d->pio) * 4 + d->sm] = d;
+
+	*desc = d;
+
+	return 0;
+
+free_dma:
+	for (i = 0; i < 2; i++)
+		if (d->dma[i] >= 0)
+			dma_channel_unclaim(d->dma[i]);
+	pio_sm_unclaim(d->pio, d->sm);
+free_desc:
+	no_os_free(d);
+
+	return ret;
+}
+
+/**
+ * @brief Capture a block of words and wait for its end.
+ * @param desc - The descriptor.
+ * @param buf - Destination, of nb words of desc->word_size bytes.
+ * @param nb - Number of words, a multiple of desc->words.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pico_pio_capture_read(struct pico_pio_capture_desc *desc, void *buf,
+			  uint32_t nb)
+{
+	if (!desc || !buf || !nb || nb % desc->words)
+		return -EINVAL;
+
+	if (desc->running)
+		return -EBUSY;
+
+	pico_pio_capture_arm(desc);
+	pico_pio_capture_dma(desc, 0, 0, buf, nb, true);
+	pio_sm_set_enabled(desc->pio, desc->sm, true);
+
+	dma_channel_wait_for_finish_blocking(desc->dma[0]);
+	pio_sm_set_enabled(desc->pio, desc->sm, false);
+
+	return 0;
+}
+
+/**
+ * @brief Start a continuous capture. Two chained DMA channels fill the halves
+ * of buf in turn, with no gap between them, and the callback is called from
+ * the DMA interrupt with each filled half.
+ * @param desc - The descriptor.
+ * @param buf - Destination, of nb words of desc->word_size bytes.
+ * @param nb - Number of words, twice a multiple of desc->words.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pico_pio_capture_start(struct pico_pio_capture_desc *desc, void *buf,
+			   uint32_t nb)
+{
+	uint32_t i;
+
+	if (!desc || !buf || !nb || nb % (2 * desc->words))
+		return -EINVAL;
+
+	if (desc->running)
+		return -EBUSY;
+
+	desc->half_words = nb / 2;
+	desc->half[0] = buf;
+	desc->half[1] = (uint8_t *)buf + desc->half_words * desc->word_size;
+	desc->filled = 0;
+
+	pico_pio_capture_arm(desc);
+	pico_pio_capture_dma(desc, 1, 0, desc->half[1], desc->half_words,
+			     false);
+	pico_pio_capture_dma(desc, 0, 1, desc->half[0], desc->half_words,
+			     false);
+	for (i = 0; i < 2; i++) {
+		dma_channel_acknowledge_irq0(desc->dma[i]);
+		dma_channel_set_irq0_enabled(desc->dma[i], true);
+	}
+
+	desc->running = true;
+	dma_channel_start(desc->dma[0]);
+	pio_sm_set_enabled(desc->pio, desc->sm, true);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the continuous capture.
+ * @param desc - The descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pico_pio_capture_stop(struct pico_pio_capture_desc *desc)
+{
+	dma_channel_config c;
+	uint32_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->running)
+		return 0;
+
+	pio_sm_set_enabled(desc->pio, desc->sm, false);
+
+	/* Unchain first, an aborted channel may otherwise start the other one */
+	for (i = 0; i < 2; i++) {
+		dma_channel_set_irq0_enabled(desc->dma[i], false);
+		c = dma_get_channel_config(desc->dma[i]);
+		channel_config_set_chain_to(&c, desc->dma[i]);
+		dma_channel_set_config(desc->dma[i], &c, false);
+	}
+	for (i = 0; i < 2; i++) {
+		dma_channel_abort(desc->dma[i]);
+		dma_channel_acknowledge_irq0(desc->dma[i]);
+	}
+
+	desc->running = false;
+	desc->half[0] = NULL;
+	desc->half[1] = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Extract the bits of one SDO lane from a multi-lane SAR word, for the
+ * devices that output one channel per lane. Each SCK period adds one bit per
+ * lane to the word, the lane on data_pin in the lowest bit.
+ * @param word - SAR word.
+ * @param lanes - Number of lanes of the engine.
+ * @param lane - Lane, 0 for data_pin.
+ * @param bits - Bits of the word on all the lanes.
+ * @return The bits of the lane, MSB first.
+ */
+uint32_t pico_pio_capture_lane(uint32_t word, uint8_t lanes, uint8_t lane,
+			       uint8_t bits)
+{
+	uint32_t val = 0;
+	int32_t i;
+
+	if (!lanes || lane >= lanes)
+		return 0;
+
+	for (i = bits / lanes - 1; i >= 0; i--)
+		val = (val << 1) | ((word >> (i * lanes + lane)) & 1);
+
+	return val;
+}
+
+/**
+ * @brief Free the resources allocated by pico_pio_capture_init().
+ * @param desc - The descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int pico_pio_capture_remove(struct pico_pio_capture_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	pico_pio_capture_stop(desc);
+	pio_sm_set_enabled(desc->pio, desc->sm, false);
+	active[pio_get_index(desc->pio) * 4 + desc->sm] = NULL;
+
+	for (i = 0; i < 2; i++)
+		dma_channel_unclaim(desc->dma[i]);
+	pio_remove_program(desc->pio, &desc->program, desc->offset);
+	pio_sm_unclaim(desc->pio, desc->sm);
+
+	no_os_free(desc);
+
+	return 0;
+}
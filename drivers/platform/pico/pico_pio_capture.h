@@ -0,0 +1,190 @@
+/***************************************************************************//**
+ *   @file   pico/pico_pio_capture.h
+ *   @brief  Header file of the pico PIO capture engine.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _PICO_PIO_CAPTURE_H_
+#define _PICO_PIO_CAPTURE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/pio.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define PICO_PIO_CAPTURE_MAX_INSN	16U
+#define PICO_PIO_CAPTURE_PARALLEL_BITS	16U
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Capture engines
+ */
+enum pico_pio_capture_mode {
+	/**
+	 * SAR ADC read engine: CNV is raised to start a conversion, lowered
+	 * after the conversion time, then the result is clocked out of 1, 2 or
+	 * 4 SDO lanes. Each sample is one 32-bit word.
+	 */
+	PICO_PIO_CAPTURE_SAR,
+	/**
+	 * Parallel bus reader (ad7606): CONVST starts a conversion, BUSY is
+	 * waited for, then one 16-bit word is read per channel with CS and RD.
+	 */
+	PICO_PIO_CAPTURE_PARALLEL,
+};
+
+/**
+ * @brief Called from the DMA interrupt each time half of the buffer given to
+ * pico_pio_capture_start() is filled.
+ * @param ctx - The ctx of the init parameters.
+ * @param buf - The filled half of the buffer.
+ * @param nb - Number of words in the half.
+ */
+typedef void (*pico_pio_capture_cb)(void *ctx, void *buf, uint32_t nb);
+
+/**
+ * @struct pico_pio_capture_init_param
+ * @brief Capture engine initialization parameters
+ */
+struct pico_pio_capture_init_param {
+	/** Capture engine */
+	enum pico_pio_capture_mode mode;
+	/** PIO block, 0 or 1 */
+	uint8_t pio;
+	/** CNV (SAR) or CONVST (parallel) pin */
+	uint8_t cnv_pin;
+	/** SCK pin (SAR) or CS pin (parallel, RD is the next GPIO) */
+	uint8_t clk_pin;
+	/** First SDO lane (SAR) or DB0 (parallel), the others follow */
+	uint8_t data_pin;
+	/** BUSY pin, parallel only */
+	uint8_t busy_pin;
+	/** Number of SDO lanes, 1, 2 or 4, SAR only */
+	uint8_t lanes;
+	/** Bits clocked per sample on all the lanes, up to 32, SAR only */
+	uint8_t bits;
+	/** Channels read per conversion, parallel only */
+	uint8_t nb_channels;
+	/** SCK (SAR) or RD (parallel) frequency */
+	uint32_t clk_hz;
+	/** Conversion time, or the BUSY time for the parallel engine */
+	uint32_t conv_ns;
+	/** Conversions per second, 0 to run as fast as possible */
+	uint32_t sample_rate;
+	/** Callback of the continuous capture, may be NULL */
+	pico_pio_capture_cb callback;
+	/** Passed to the callback */
+	void *ctx;
+};
+
+/**
+ * @struct pico_pio_capture_desc
+ * @brief Capture engine descriptor
+ */
+struct pico_pio_capture_desc {
+	/** Capture engine */
+	enum pico_pio_capture_mode mode;
+	/** PIO block */
+	PIO pio;
+	/** State machine */
+	uint32_t sm;
+	/** Offset of the program in the instruction memory */
+	uint32_t offset;
+	/** Program, kept for its removal */
+	struct pio_program program;
+	/** Program instructions */
+	uint16_t insn[PICO_PIO_CAPTURE_MAX_INSN];
+	/** Words loaded into the TX FIFO at each start */
+	uint32_t params[2];
+	/** Number of params */
+	uint32_t nb_params;
+	/** DMA channels, the second one is used by the continuous capture */
+	int dma[2];
+	/** Size of a word in bytes, 4 for SAR and 2 for parallel */
+	uint32_t word_size;
+	/** Words per conversion */
+	uint32_t words;
+	/** Achieved conversion rate */
+	uint32_t sample_rate;
+	/** Continuous capture buffer halves */
+	uint8_t *half[2];
+	/** Words in a half */
+	uint32_t half_words;
+	/** Halves filled since the start, a half not consumed in time is lost */
+	volatile uint32_t filled;
+	/** Callback of the continuous capture */
+	pico_pio_capture_cb callback;
+	/** Passed to the callback */
+	void *ctx;
+	/** Engine running */
+	bool running;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Load the program and claim the state machine and DMA channels. */
+int pico_pio_capture_init(struct pico_pio_capture_desc **desc,
+			  const struct pico_pio_capture_init_param *param);
+
+/* Capture nb words into buf and wait for the end of the capture. */
+int pico_pio_capture_read(struct pico_pio_capture_desc *desc, void *buf,
+			  uint32_t nb);
+
+/* Start a continuous capture into the two halves of buf. */
+int pico_pio_capture_start(struct pico_pio_capture_desc *desc, void *buf,
+			   uint32_t nb);
+
+/* Stop the continuous capture. */
+int pico_pio_capture_stop(struct pico_pio_capture_desc *desc);
+
+/* Bits of one SDO lane from a multi-lane SAR word. */
+uint32_t pico_pio_capture_lane(uint32_t word, uint8_t lanes, uint8_t lane,
+			       uint8_t bits);
+
+/* Free the resources allocated by pico_pio_capture_init(). */
+int pico_pio_capture_remove(struct pico_pio_capture_desc *desc);
+
+#endif // _PICO_PIO_CAPTURE_H_
@@ -0,0 +1,216 @@
+/***************************************************************************//**
+ *   @file   stm32/stm32_crc.c
+ *   @brief  Implementation of the stm32 CRC driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_alloc.h"
+#include "no_os_crc.h"
+#include "stm32_crc.h"
+
+#ifdef HAL_CRC_MODULE_ENABLED
+
+/* Descriptor the CRC unit is currently programmed for. */
+static struct no_os_crc_desc *stm32_crc_active;
+
+/**
+ * @brief Bit reverse the low width bits of a value.
+ * @param val - Value to reverse.
+ * @param width - Number of bits.
+ * @return The reversed value.
+ */
+static uint32_t stm32_crc_reverse(uint32_t val, uint8_t width)
+{
+	uint32_t ret = 0;
+
+	while (width--) {
+		ret = (ret << 1) | (val & 0x1);
+		val >>= 1;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Program the CRC unit for a descriptor.
+ * @param desc - The CRC descriptor.
+ * @return 0 in case of success, -EIO otherwise.
+ */
+static int stm32_crc_config(struct no_os_crc_desc *desc)
+{
+	struct stm32_crc_desc *sdesc = desc->extra;
+	CRC_HandleTypeDef *hcrc = sdesc->hcrc;
+
+	if (stm32_crc_active == desc)
+		return 0;
+
+	hcrc->Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_DISABLE;
+	hcrc->Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_DISABLE;
+	hcrc->Init.InitValue = 0;
+	hcrc->InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+
+	/* The unit takes the msb-first polynomial, without the x^width term. */
+	if (desc->reflected) {
+		hcrc->Init.GeneratingPolynomial =
+			stm32_crc_reverse(desc->polynomial, desc->width);
+		hcrc->Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_BYTE;
+		hcrc->Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_ENABLE;
+	} else {
+		hcrc->Init.GeneratingPolynomial = desc->polynomial;
+		hcrc->Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+		hcrc->Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+	}
+
+	switch (desc->width) {
+	case 8:
+		hcrc->Init.CRCLength = CRC_POLYLENGTH_8B;
+		break;
+	case 16:
+		hcrc->Init.CRCLength = CRC_POLYLENGTH_16B;
+		break;
+	default:
+		hcrc->Init.CRCLength = CRC_POLYLENGTH_32B;
+		break;
+	}
+
+	if (HAL_CRC_Init(hcrc) != HAL_OK)
+		return -EIO;
+
+	stm32_crc_active = desc;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the CRC unit.
+ * @param desc - The CRC descriptor.
+ * @param param - The structure that contains the CRC parameters.
+ * @return 0 in case of success, -ENOTSUP if the unit cannot compute the
+ * 	   requested CRC, negative error code otherwise.
+ */
+static int stm32_crc_init(struct no_os_crc_desc **desc,
+			  const struct no_os_crc_init_param *param)
+{
+	struct stm32_crc_init_param *sinit = param->extra;
+	struct stm32_crc_desc *sdesc;
+	struct no_os_crc_desc *descriptor;
+
+	if (!sinit || !sinit->hcrc)
+		return -EINVAL;
+
+#if defined(CRC_POLYLENGTH_8B)
+	if (param->width != 8 && param->width != 16 && param->width != 32)
+		return -ENOTSUP;
+#else
+	/* Fixed CRC-32 unit operating on words only. */
+	return -ENOTSUP;
+#endif
+
+	descriptor = (struct no_os_crc_desc *)no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	sdesc = (struct stm32_crc_desc *)no_os_calloc(1, sizeof(*sdesc));
+	if (!sdesc) {
+		no_os_free(descriptor);
+		return -ENOMEM;
+	}
+
+	sdesc->hcrc = sinit->hcrc;
+	descriptor->extra = sdesc;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Compute the CRC over a buffer using the CRC unit.
+ * @param desc - The CRC descriptor.
+ * @param data - Data buffer.
+ * @param len - Number of bytes in the data buffer.
+ * @param crc - Initial CRC value.
+ * @param result - Computed CRC value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int stm32_crc_compute(struct no_os_crc_desc *desc, const uint8_t *data,
+			     size_t len, uint32_t crc, uint32_t *result)
+{
+	struct stm32_crc_desc *sdesc = desc->extra;
+	uint32_t mask = desc->width == 32 ? 0xffffffff : (1u << desc->width) - 1;
+	uint32_t val;
+	int ret;
+
+	ret = stm32_crc_config(desc);
+	if (ret)
+		return ret;
+
+	if (desc->reflected)
+		crc = stm32_crc_reverse(crc, desc->width);
+
+	WRITE_REG(sdesc->hcrc->Instance->INIT, crc & mask);
+	val = HAL_CRC_Calculate(sdesc->hcrc, (uint32_t *)data, len);
+
+	*result = val & mask;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by stm32_crc_init().
+ * @param desc - The CRC descriptor.
+ * @return 0 in case of success.
+ */
+static int stm32_crc_remove(struct no_os_crc_desc *desc)
+{
+	if (stm32_crc_active == desc)
+		stm32_crc_active = NULL;
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief stm32 platform specific CRC platform ops structure
+ */
+const struct no_os_crc_platform_ops stm32_crc_ops = {
+	.init = &stm32_crc_init,
+	.compute = &stm32_crc_compute,
+	.remove = &stm32_crc_remove
+};
+
+#endif // HAL_CRC_MODULE_ENABLED
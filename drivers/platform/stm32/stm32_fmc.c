@@ -0,0 +1,106 @@
+/***************************************************************************//**
+ *   @file   stm32/stm32_fmc.c
+ *   @brief  DMA reads from an FMC/FSMC mapped parallel bus, paced by a timer input capture.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include <errno.h>
+#include "stm32_fmc.h"
+
+/**
+ * @brief Get the capture compare DMA request of a timer channel.
+ * @param channel - TIM_CHANNEL_x.
+ * @return The TIM_DMA_CCx request, 0 for an invalid channel.
+ */
+static uint32_t stm32_fmc_dma_request(uint32_t channel)
+{
+	switch (channel) {
+	case TIM_CHANNEL_1:
+		return TIM_DMA_CC1;
+	case TIM_CHANNEL_2:
+		return TIM_DMA_CC2;
+	case TIM_CHANNEL_3:
+		return TIM_DMA_CC3;
+	case TIM_CHANNEL_4:
+		return TIM_DMA_CC4;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Read from an FMC mapped device, one DMA request per BUSY edge.
+ *
+ * The call blocks until the transfer is done, the CPU is not involved in the
+ * individual conversions.
+ * @param ctx - struct stm32_fmc_dma.
+ * @param src - Address of the FMC bank.
+ * @param dst - Destination buffer.
+ * @param nb_words - Number of 32-bit words to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_fmc_dma_read(void *ctx, uintptr_t src, uint32_t *dst,
+			   uint32_t nb_words)
+{
+	struct stm32_fmc_dma *fmc = ctx;
+	uint32_t request;
+	int32_t ret = 0;
+
+	if (!fmc || !fmc->htim || !fmc->hdma || !dst || !nb_words)
+		return -EINVAL;
+
+	request = stm32_fmc_dma_request(fmc->channel);
+	if (!request)
+		return -EINVAL;
+
+	if (HAL_DMA_Start(fmc->hdma, src, (uint32_t)dst, nb_words) != HAL_OK)
+		return -EIO;
+
+	__HAL_TIM_ENABLE_DMA(fmc->htim, request);
+	if (HAL_TIM_IC_Start(fmc->htim, fmc->channel) != HAL_OK) {
+		ret = -EIO;
+		goto abort;
+	}
+
+	if (HAL_DMA_PollForTransfer(fmc->hdma, HAL_DMA_FULL_TRANSFER,
+				    fmc->timeout_ms) != HAL_OK)
+		ret = -ETIMEDOUT;
+
+	HAL_TIM_IC_Stop(fmc->htim, fmc->channel);
+abort:
+	__HAL_TIM_DISABLE_DMA(fmc->htim, request);
+	if (ret)
+		HAL_DMA_Abort(fmc->hdma);
+
+	return ret;
+}
@@ -0,0 +1,69 @@
+/***************************************************************************//**
+ *   @file   stm32/stm32_fmc.h
+ *   @brief  Header file for the stm32 FMC parallel bus DMA helper.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#ifndef STM32_FMC_H_
+#define STM32_FMC_H_
+
+#include <stdint.h>
+#include "stm32_hal.h"
+
+/**
+ * @struct stm32_fmc_dma
+ * @brief DMA from an FMC/FSMC bank, one request per edge of a converter BUSY
+ * signal.
+ *
+ * The FMC bank, the timer input capture channel (BUSY falling edge) and its
+ * DMA stream (peripheral to memory, fixed peripheral address, 32-bit
+ * peripheral size) are configured by CubeMX. A 32-bit read of a 16-bit bank
+ * is split by the FMC into two consecutive RD strobes, and a peripheral burst
+ * of 4, 8 or 16 beats moves that many 32-bit words for each BUSY edge.
+ */
+struct stm32_fmc_dma {
+	/** Timer with the input capture channel wired to BUSY. */
+	TIM_HandleTypeDef *htim;
+	/** Input capture channel, TIM_CHANNEL_x. */
+	uint32_t channel;
+	/** DMA stream linked to the capture compare request of channel. */
+	DMA_HandleTypeDef *hdma;
+	/** Transfer timeout in milliseconds. */
+	uint32_t timeout_ms;
+};
+
+/* Read nb_words 32-bit words from src, paced by the BUSY edges. */
+int32_t stm32_fmc_dma_read(void *ctx, uintptr_t src, uint32_t *dst,
+			   uint32_t nb_words);
+
+#endif // STM32_FMC_H_
@@ -389,6 +389,58 @@ int32_t stm32_gpio_get_value(struct no_os_gpio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Set the masked pins of the port of the specified GPIO.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins to be written, bit n is pin n of the port.
+ * @param value - New values of the masked pins.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_gpio_port_set_value(struct no_os_gpio_desc *desc,
+				  uint32_t mask, uint32_t value)
+{
+	struct stm32_gpio_desc *extra;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->extra)
+		return -EFAULT;
+
+	extra = desc->extra;
+	mask &= 0xFFFF;
+
+	/* set and reset the pins in the same write */
+	extra->port->BSRR = (value & mask) | ((~value & mask) << 16);
+
+	return 0;
+}
+
+/**
+ * @brief Get the masked pins of the port of the specified GPIO.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins to be read, bit n is pin n of the port.
+ * @param value - Values of the masked pins.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_gpio_port_get_value(struct no_os_gpio_desc *desc,
+				  uint32_t mask, uint32_t *value)
+{
+	struct stm32_gpio_desc *extra;
+
+	if (!desc || !value)
+		return -EINVAL;
+
+	if (!desc->extra)
+		return -EFAULT;
+
+	extra = desc->extra;
+
+	*value = extra->port->IDR & mask & 0xFFFF;
+
+	return 0;
+}
+
 /**
  * @brief stm32 platform specific GPIO platform ops structure
  */
@@ -401,4 +453,6 @@ const struct no_os_gpio_platform_ops stm32_gpio_ops = {
 	.gpio_ops_get_direction = &stm32_gpio_get_direction,
 	.gpio_ops_set_value = &stm32_gpio_set_value,
 	.gpio_ops_get_value = &stm32_gpio_get_value,
+	.gpio_ops_port_set_value = &stm32_gpio_port_set_value,
+	.gpio_ops_port_get_value = &stm32_gpio_port_get_value,
 };
@@ -43,10 +43,10 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <errno.h>
-#include "no_os_list.h"
 #include "no_os_irq.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_section.h"
 #include "stm32_gpio_irq.h"
 
 /******************************************************************************/
@@ -59,10 +59,9 @@
 /******************************************************************************/
 
 /**
- * @brief Struct used to store a (peripheral, callback) pair
+ * @brief Callback registered on an EXTI line
  */
 struct irq_action {
-	uint32_t irq_id;
 	void (*callback)(void *context);
 	void *ctx;
 };
@@ -70,13 +69,8 @@ struct irq_action {
 /******************************************************************************/
 /***************************** Static variables *******************************/
 /******************************************************************************/
-static struct no_os_list_desc *actions;
-
-static int32_t irq_action_cmp(void *data1, void *data2)
-{
-	return ((struct irq_action *)data1)->irq_id -
-	       ((struct irq_action *)data2)->irq_id;
-}
+/* Dispatch table indexed by EXTI line, no lookup in the interrupt handler */
+static struct irq_action actions[STM32_IRQ_CTRL_NB];
 
 static bool initialized[STM32_IRQ_CTRL_NB] =  {false};
 
@@ -89,16 +83,9 @@ static bool initialized[STM32_IRQ_CTRL_NB] =  {false};
  */
 static inline void stm32_handle_generic_callback(uint16_t pin)
 {
-	int ret;
 	struct irq_action *action;
-	struct irq_action key;
-
-	key.irq_id = no_os_find_first_set_bit(pin);
-
-	ret = no_os_list_read_find(actions, (void **)&action, &key);
-	if (ret)
-		return;
 
+	action = &actions[no_os_find_first_set_bit(pin) % STM32_IRQ_CTRL_NB];
 	if (action->callback)
 		action->callback(action->ctx);
 }
@@ -107,6 +94,7 @@ static inline void stm32_handle_generic_callback(uint16_t pin)
  * @brief EXTI GPIO Interrupt handler callback
  * @param pin pin number on which the interrupt occurred (GPIO_PIN_pin)
  */
+NO_OS_RAMFUNC
 void HAL_GPIO_EXTI_Callback(uint16_t pin)
 {
 	stm32_handle_generic_callback(pin);
@@ -116,6 +104,7 @@ void HAL_GPIO_EXTI_Callback(uint16_t pin)
  * @brief EXTI GPIO Interrupt handler callback for rising edge detection
  * @param pin pin number on which the interrupt occurred (GPIO_PIN_pin)
  */
+NO_OS_RAMFUNC
 void HAL_GPIO_EXTI_Rising_Callback(uint16_t pin)
 {
 	stm32_handle_generic_callback(pin);
@@ -125,6 +114,7 @@ void HAL_GPIO_EXTI_Rising_Callback(uint16_t pin)
  * @brief EXTI GPIO Interrupt handler callback for falling edge detection
  * @param pin pin number on which the interrupt occurred (GPIO_PIN_pin)
  */
+NO_OS_RAMFUNC
 void HAL_GPIO_EXTI_Falling_Callback(uint16_t pin)
 {
 	stm32_handle_generic_callback(pin);
@@ -176,10 +166,6 @@ static int32_t stm32_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 		gpio_irq_desc->extra = sdesc;
 		gpio_irq_desc->irq_ctrl_id = param->irq_ctrl_id;
 
-		ret = no_os_list_init(&actions, NO_OS_LIST_PRIORITY_LIST, irq_action_cmp);
-		if (ret)
-			goto error;
-
 		gpio_irq_desc_arr[param->irq_ctrl_id] = gpio_irq_desc;
 		initialized[param->irq_ctrl_id] = true;
 	}
@@ -188,9 +174,7 @@ static int32_t stm32_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 
 	return 0;
 error:
-	no_os_list_remove(actions);
 	no_os_free(gpio_irq_desc);
-	no_os_free(sdesc);
 
 	return ret;
 }
@@ -202,15 +186,11 @@ error:
  */
 static int32_t stm32_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	struct no_os_callback_desc *discard;
-
 	if (!desc)
 		return -EINVAL;
 
-	while (0 == no_os_list_get_first(actions, (void **)&discard))
-		no_os_free(discard);
-
-	no_os_list_remove(actions);
+	actions[desc->irq_ctrl_id].callback = NULL;
+	actions[desc->irq_ctrl_id].ctx = NULL;
 
 	initialized[desc->irq_ctrl_id] = false;
 
@@ -282,35 +262,18 @@ static int32_t stm32_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
 {
 	int ret;
 	struct irq_action *action;
-	struct irq_action action_key = {.irq_id = desc->irq_ctrl_id};
 	struct stm32_gpio_irq_desc *sdesc;
 
 	if (!desc || !desc->extra || !cb || !IS_EXTI_GPIO_PIN(desc->irq_ctrl_id))
 		return -EINVAL;
 
 	sdesc = desc->extra;
+	action = &actions[desc->irq_ctrl_id];
 
-	ret = no_os_list_read_find(actions, (void **)&action, &action_key);
-	/*
-	* If no action was found, insert a new one, otherwise update it
-	*/
-	if (ret) {
-		action = no_os_calloc(1, sizeof(*action));
-		if (!action)
-			return -ENOMEM;
-
-		action->irq_id = desc->irq_ctrl_id;
-		action->ctx = cb->ctx;
-		action->callback = cb->callback;
-
-		ret = no_os_list_add_last(actions, action);
-		if (ret)
-			goto free_action;
-	} else {
-		action->irq_id = desc->irq_ctrl_id;
-		action->ctx = cb->ctx;
-		action->callback = cb->callback;
-	}
+	/* The handler may run meanwhile, never pair a callback with a stale ctx */
+	action->callback = NULL;
+	action->ctx = cb->ctx;
+	action->callback = cb->callback;
 
 	EXTI_ConfigTypeDef config;
 	config.Mode = EXTI_MODE_INTERRUPT;
@@ -318,15 +281,11 @@ static int32_t stm32_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
 	config.Line = EXTI_GPIO | desc->irq_ctrl_id;
 	ret = HAL_EXTI_SetConfigLine(&sdesc->hexti, &config);
 	if (ret) {
-		ret = -EFAULT;
-		goto free_action;
+		action->callback = NULL;
+		return -EFAULT;
 	}
 
 	return 0;
-
-free_action:
-	no_os_free(action);
-	return ret;
 }
 
 /**
@@ -340,18 +299,15 @@ static int32_t stm32_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc
 		*desc,
 		uint32_t irq_id, struct no_os_callback_desc *cb)
 {
-	int ret;
-	struct irq_action *discard_action = NULL;
-	struct irq_action action_key = {.irq_id = desc->irq_ctrl_id};
-
 	if (!desc || !cb || !IS_EXTI_GPIO_PIN(desc->irq_ctrl_id))
 		return -EINVAL;
 
-	ret = no_os_list_read_find(actions, (void **)&discard_action, &action_key);
-	if (ret)
+	if (!actions[desc->irq_ctrl_id].callback)
 		return -ENODEV;
 
-	no_os_free(discard_action);
+	actions[desc->irq_ctrl_id].callback = NULL;
+	actions[desc->irq_ctrl_id].ctx = NULL;
+
 	return 0;
 }
 
@@ -222,6 +222,188 @@ int32_t stm32_i2c_read(struct no_os_i2c_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Start one message of a combined transfer, interrupt driven.
+ * Consecutive messages in the same direction are sent as one frame, a
+ * repeated start is only generated when the direction changes.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages of the transfer.
+ * @param idx - Index of the message to start.
+ * @param nb_msgs - Number of messages of the transfer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t stm32_i2c_msg_start(struct no_os_i2c_desc *desc,
+				   struct no_os_i2c_msg *msgs,
+				   uint32_t idx, uint32_t nb_msgs)
+{
+	struct stm32_i2c_desc *xdesc = desc->extra;
+	uint16_t addr = desc->slave_address << 1;
+	uint32_t opt;
+	int ret;
+
+	if (msgs[idx].len > UINT16_MAX)
+		return -EINVAL;
+
+	if (nb_msgs == 1)
+		opt = I2C_FIRST_AND_LAST_FRAME;
+	else if (idx == 0)
+		opt = I2C_FIRST_FRAME;
+	else if (idx == nb_msgs - 1)
+		opt = I2C_LAST_FRAME;
+	else
+		opt = I2C_NEXT_FRAME;
+
+	if (msgs[idx].flags & NO_OS_I2C_M_RD)
+		ret = HAL_I2C_Master_Seq_Receive_IT(&xdesc->hi2c, addr, msgs[idx].buf,
+						    msgs[idx].len, opt);
+	else
+		ret = HAL_I2C_Master_Seq_Transmit_IT(&xdesc->hi2c, addr, msgs[idx].buf,
+						     msgs[idx].len, opt);
+	if (ret != HAL_OK)
+		return -EIO;
+
+	return 0;
+}
+
+/**
+ * @brief Transfer a list of messages joined by repeated starts.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t nb_msgs)
+{
+	struct stm32_i2c_desc *xdesc;
+	uint32_t start;
+	uint32_t i;
+	int32_t ret;
+
+	if (!desc || !desc->extra || !msgs)
+		return -EINVAL;
+
+	xdesc = desc->extra;
+	if (xdesc->async_desc)
+		return -EBUSY;
+
+	for (i = 0; i < nb_msgs; i++) {
+		ret = stm32_i2c_msg_start(desc, msgs, i, nb_msgs);
+		if (ret)
+			return ret;
+
+		start = HAL_GetTick();
+		while (HAL_I2C_GetState(&xdesc->hi2c) != HAL_I2C_STATE_READY) {
+			if (HAL_GetTick() - start > STM32_I2C_TIMEOUT_MS) {
+				HAL_I2C_Master_Abort_IT(&xdesc->hi2c,
+							desc->slave_address << 1);
+				return -ETIMEDOUT;
+			}
+		}
+
+		if (HAL_I2C_GetError(&xdesc->hi2c) != HAL_I2C_ERROR_NONE)
+			return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief End the ongoing asynchronous transfer and invoke its callback.
+ * @param xdesc - The stm32 I2C descriptor.
+ * @param status - Result of the transfer.
+ */
+static void stm32_i2c_async_end(struct stm32_i2c_desc *xdesc, int32_t status)
+{
+	xdesc->async_desc = NULL;
+	if (xdesc->callback)
+		xdesc->callback(xdesc->ctx, status);
+}
+
+/**
+ * @brief HAL completion callback of a message, starts the next one.
+ * @param hi2c - The HAL handle, first member of the stm32 I2C descriptor.
+ */
+static void stm32_i2c_async_next(I2C_HandleTypeDef *hi2c)
+{
+	struct stm32_i2c_desc *xdesc = (struct stm32_i2c_desc *)hi2c;
+	int32_t ret;
+
+	if (!xdesc->async_desc)
+		return;
+
+	if (++xdesc->msg_idx == xdesc->nb_msgs) {
+		stm32_i2c_async_end(xdesc, 0);
+		return;
+	}
+
+	ret = stm32_i2c_msg_start(xdesc->async_desc, xdesc->msgs,
+				  xdesc->msg_idx, xdesc->nb_msgs);
+	if (ret)
+		stm32_i2c_async_end(xdesc, ret);
+}
+
+/**
+ * @brief HAL error callback of an asynchronous transfer.
+ * @param hi2c - The HAL handle, first member of the stm32 I2C descriptor.
+ */
+static void stm32_i2c_async_error(I2C_HandleTypeDef *hi2c)
+{
+	struct stm32_i2c_desc *xdesc = (struct stm32_i2c_desc *)hi2c;
+
+	if (xdesc->async_desc)
+		stm32_i2c_async_end(xdesc, -EIO);
+}
+
+/**
+ * @brief Start an interrupt driven transfer of a list of messages and return.
+ * Requires USE_HAL_I2C_REGISTER_CALLBACKS.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @param callback - Invoked from the I2C interrupt with the result.
+ * @param ctx - Parameter for the callback.
+ * @return 0 if the transfer was started, negative error code otherwise.
+ */
+int32_t stm32_i2c_transfer_async(struct no_os_i2c_desc *desc,
+				 struct no_os_i2c_msg *msgs,
+				 uint32_t nb_msgs,
+				 void (*callback)(void *, int32_t),
+				 void *ctx)
+{
+	struct stm32_i2c_desc *xdesc;
+	int32_t ret;
+
+	if (!desc || !desc->extra || !msgs)
+		return -EINVAL;
+
+	xdesc = desc->extra;
+	if (xdesc->async_desc)
+		return -EBUSY;
+
+	if (HAL_I2C_RegisterCallback(&xdesc->hi2c, HAL_I2C_MASTER_TX_COMPLETE_CB_ID,
+				     stm32_i2c_async_next) != HAL_OK ||
+	    HAL_I2C_RegisterCallback(&xdesc->hi2c, HAL_I2C_MASTER_RX_COMPLETE_CB_ID,
+				     stm32_i2c_async_next) != HAL_OK ||
+	    HAL_I2C_RegisterCallback(&xdesc->hi2c, HAL_I2C_ERROR_CB_ID,
+				     stm32_i2c_async_error) != HAL_OK)
+		return -EFAULT;
+
+	xdesc->msgs = msgs;
+	xdesc->nb_msgs = nb_msgs;
+	xdesc->msg_idx = 0;
+	xdesc->callback = callback;
+	xdesc->ctx = ctx;
+	xdesc->async_desc = desc;
+
+	ret = stm32_i2c_msg_start(desc, msgs, 0, nb_msgs);
+	if (ret)
+		xdesc->async_desc = NULL;
+
+	return ret;
+}
+
 /**
  * @brief stm32 platform specific I2C platform ops structure
  */
@@ -229,5 +411,7 @@ const struct no_os_i2c_platform_ops stm32_i2c_ops = {
 	.i2c_ops_init = &stm32_i2c_init,
 	.i2c_ops_write = &stm32_i2c_write,
 	.i2c_ops_read = &stm32_i2c_read,
+	.i2c_ops_transfer = &stm32_i2c_transfer,
+	.i2c_ops_transfer_async = &stm32_i2c_transfer_async,
 	.i2c_ops_remove = &stm32_i2c_remove
 };
@@ -43,6 +43,9 @@
 #include "no_os_i2c.h"
 #include "stm32_hal.h"
 
+/** Timeout of a message of a blocking combined transfer, in ms */
+#define STM32_I2C_TIMEOUT_MS	100
+
 /**
  * @struct stm32_i2c_desc
  * @brief stm32 platform specific I2C descriptor
@@ -50,6 +53,18 @@
 struct stm32_i2c_desc {
 	/** I2C instance */
 	I2C_HandleTypeDef hi2c;
+	/** Device of the ongoing asynchronous transfer, NULL if none */
+	struct no_os_i2c_desc *async_desc;
+	/** Messages of the ongoing asynchronous transfer */
+	struct no_os_i2c_msg *msgs;
+	/** Number of messages of the ongoing asynchronous transfer */
+	uint32_t nb_msgs;
+	/** Index of the message being transferred */
+	uint32_t msg_idx;
+	/** Called once the asynchronous transfer is done */
+	void (*callback)(void *, int32_t);
+	/** Parameter for the callback */
+	void *ctx;
 };
 
 /**
@@ -46,45 +46,49 @@
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
 
+/**
+ * @brief Select the prescaler giving the fastest speed not above speed_hz.
+ * @param input_clock - SPI input clock.
+ * @param speed_hz - Requested speed, 0 for the default prescaler.
+ * @return The SPI_BAUDRATEPRESCALER_x value.
+ */
+static uint32_t stm32_spi_prescaler(uint32_t input_clock, uint32_t speed_hz)
+{
+	uint32_t div;
+
+	if (!speed_hz)
+		return SPI_BAUDRATEPRESCALER_64;
+
+	div = input_clock / speed_hz;
+	switch (div) {
+	case 0 ... 2:
+		return SPI_BAUDRATEPRESCALER_2;
+	case 3 ... 4:
+		return SPI_BAUDRATEPRESCALER_4;
+	case 5 ... 8:
+		return SPI_BAUDRATEPRESCALER_8;
+	case 9 ... 16:
+		return SPI_BAUDRATEPRESCALER_16;
+	case 17 ... 32:
+		return SPI_BAUDRATEPRESCALER_32;
+	case 33 ... 64:
+		return SPI_BAUDRATEPRESCALER_64;
+	case 65 ... 128:
+		return SPI_BAUDRATEPRESCALER_128;
+	default:
+		return SPI_BAUDRATEPRESCALER_256;
+	}
+}
+
 static int stm32_spi_config(struct no_os_spi_desc *desc)
 {
 	int ret;
-	uint32_t prescaler = 0u;
+	uint32_t prescaler;
 	SPI_TypeDef *base = NULL;
 	struct stm32_spi_desc *sdesc = desc->extra;
 
 	/* automatically select prescaler based on max_speed_hz */
-	if (desc->max_speed_hz != 0u) {
-		uint32_t div = sdesc->input_clock / desc->max_speed_hz;
-
-		switch (div) {
-		case 0 ... 2:
-			prescaler = SPI_BAUDRATEPRESCALER_2;
-			break;
-		case 3 ... 4:
-			prescaler = SPI_BAUDRATEPRESCALER_4;
-			break;
-		case 5 ... 8:
-			prescaler = SPI_BAUDRATEPRESCALER_8;
-			break;
-		case 9 ... 16:
-			prescaler = SPI_BAUDRATEPRESCALER_16;
-			break;
-		case 17 ... 32:
-			prescaler = SPI_BAUDRATEPRESCALER_32;
-			break;
-		case 33 ... 64:
-			prescaler = SPI_BAUDRATEPRESCALER_64;
-			break;
-		case 65 ... 128:
-			prescaler = SPI_BAUDRATEPRESCALER_128;
-			break;
-		default:
-			prescaler = SPI_BAUDRATEPRESCALER_256;
-			break;
-		}
-	} else
-		prescaler = SPI_BAUDRATEPRESCALER_64;
+	prescaler = stm32_spi_prescaler(sdesc->input_clock, desc->max_speed_hz);
 
 	switch (desc->device_id) {
 #if defined(SPI1)
@@ -143,6 +147,7 @@ static int stm32_spi_config(struct no_os_spi_desc *desc)
 		ret = -EIO;
 		goto error;
 	}
+	sdesc->speed_hz = desc->max_speed_hz;
 #ifdef SPI_SR_TXE
 	__HAL_SPI_ENABLE(&sdesc->hspi);
 #endif
@@ -275,10 +280,11 @@ int32_t stm32_spi_transfer(struct no_os_spi_desc *desc,
 
 	// Compute a slave ID based on SPI instance and chip select.
 	// If it did not change since last call to stm32_spi_write_and_read,
-	// no need to reconfigure SPI. Otherwise, reconfigure it.
+	// no need to reconfigure SPI. Otherwise, reconfigure it. The same goes
+	// for a speed changed by stm32_spi_set_speed.
 	slave_id = ((uint64_t)(uintptr_t)sdesc->hspi.Instance << 32) |
 		   sdesc->chip_select->number;
-	if (slave_id != last_slave_id) {
+	if (slave_id != last_slave_id || sdesc->speed_hz != desc->max_speed_hz) {
 		last_slave_id = slave_id;
 		ret = stm32_spi_config(desc);
 		if (ret)
@@ -386,6 +392,28 @@ int32_t stm32_spi_write_and_read(struct no_os_spi_desc *desc,
 	return stm32_spi_transfer(desc, &msg, 1);
 }
 
+/**
+ * @brief Check a new speed against the prescalers. It is applied by the next
+ * transfer, once no_os_spi_set_speed() updated max_speed_hz.
+ * @param desc - The SPI descriptor.
+ * @param speed_hz - New speed.
+ * @return 0 in case of success, -EINVAL if even the largest prescaler is too
+ * fast.
+ */
+int32_t stm32_spi_set_speed(struct no_os_spi_desc *desc, uint32_t speed_hz)
+{
+	struct stm32_spi_desc *sdesc;
+
+	if (!desc || !desc->extra || !speed_hz)
+		return -EINVAL;
+
+	sdesc = desc->extra;
+	if (speed_hz < sdesc->input_clock / 256)
+		return -EINVAL;
+
+	return 0;
+}
+
 /**
  * @brief stm32 platform specific SPI platform ops structure
  */
@@ -393,5 +421,6 @@ const struct no_os_spi_platform_ops stm32_spi_ops = {
 	.init = &stm32_spi_init,
 	.write_and_read = &stm32_spi_write_and_read,
 	.remove = &stm32_spi_remove,
-	.transfer = &stm32_spi_transfer
+	.transfer = &stm32_spi_transfer,
+	.set_speed = &stm32_spi_set_speed
 };
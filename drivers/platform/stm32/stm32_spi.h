@@ -64,6 +64,8 @@ struct stm32_spi_desc {
 	SPI_HandleTypeDef hspi;
 	/** SPI input clock */
 	uint32_t input_clock;
+	/** Speed the prescaler was last configured for */
+	uint32_t speed_hz;
 	/** Chip select gpio descriptor */
 	struct no_os_gpio_desc *chip_select;
 };
@@ -60,6 +60,53 @@ const struct no_os_tdm_platform_ops stm32_tdm_platform_ops = {
 	.tdm_ops_remove = &stm32_tdm_remove
 };
 
+/**
+ * @brief SAI error callback of the continuous reception. An overrun or a DMA
+ * error may leave the DMA stopped or the slots misaligned, so the reception
+ * is restarted on the same buffer, resynchronizing on the next frame sync.
+ * The SAI configuration is kept.
+ * @param hsai - SAI handle, first member of the stm32_tdm_desc.
+ */
+static void stm32_tdm_rx_error(SAI_HandleTypeDef *hsai)
+{
+	struct stm32_tdm_desc *tdesc = (struct stm32_tdm_desc *)hsai;
+
+	if (!tdesc->rx_buff)
+		return;
+
+	HAL_SAI_DMAStop(hsai);
+	tdesc->rx_restarts++;
+	HAL_SAI_Receive_DMA(hsai, tdesc->rx_buff, tdesc->rx_samples);
+}
+
+/**
+ * @brief Configure the RX DMA of the SAI in circular mode.
+ * @param tdesc - The stm32 TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t stm32_tdm_continuous_init(struct stm32_tdm_desc *tdesc)
+{
+#ifdef DMA_CIRCULAR
+	/* Linked to the SAI in HAL_SAI_MspInit() */
+	if (!tdesc->hsai.hdmarx)
+		return -EINVAL;
+
+	tdesc->hsai.hdmarx->Init.Mode = DMA_CIRCULAR;
+	if (HAL_DMA_Init(tdesc->hsai.hdmarx) != HAL_OK)
+		return -EIO;
+
+	if (HAL_SAI_RegisterCallback(&tdesc->hsai, HAL_SAI_ERROR_CB_ID,
+				     stm32_tdm_rx_error) != HAL_OK)
+		return -EIO;
+
+	tdesc->continuous = true;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /**
  * @brief Initialize the TDM communication peripheral.
  * @param desc - The TDM descriptor.
@@ -166,6 +213,12 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 		goto error;
 	}
 
+	if (param->rx_continuous) {
+		ret = stm32_tdm_continuous_init(tdesc);
+		if (ret)
+			goto error;
+	}
+
 	if(param->rx_complete_callback) {
 		ret = lf256fifo_init(&tdm_desc->rx_fifo);
 		if (ret < 0)
@@ -251,6 +304,10 @@ int32_t stm32_tdm_remove(struct no_os_tdm_desc *desc)
 
 /**
  * @brief Read data using SAI TDM mode.
+ * With rx_continuous the reception keeps running on data until
+ * stm32_stop_tdm_transfer(). Giving it the memory of an IIO buffer with two
+ * blocks lets the half complete and complete callbacks hand each half to IIO
+ * with iio_buffer_get_block() and iio_buffer_block_done(), without copies.
  * @param desc - The TDM descriptor.
  * @param data - The buffer to fill with the received data.
  * @param nb_samples - Number of samples to read.
@@ -271,7 +328,16 @@ int32_t stm32_tdm_read(struct no_os_tdm_desc *desc,
 
 	tdesc = desc->extra;
 
-	if (desc->irq_id)
+	if (tdesc->continuous) {
+		if (tdesc->rx_buff)
+			return -EBUSY;
+
+		tdesc->rx_buff = data;
+		tdesc->rx_samples = nb_samples;
+		ret = HAL_SAI_Receive_DMA(&tdesc->hsai, data, nb_samples);
+		if (ret != HAL_OK)
+			tdesc->rx_buff = NULL;
+	} else if (desc->irq_id)
 		ret = HAL_SAI_Receive_DMA(&tdesc->hsai, data, nb_samples);
 	else
 		ret = HAL_SAI_Receive(&tdesc->hsai, data, nb_samples, HAL_MAX_DELAY);
@@ -303,6 +369,7 @@ int32_t stm32_stop_tdm_transfer(struct no_os_tdm_desc *desc)
 		return -ENOSYS;
 
 	tdesc = desc->extra;
+	tdesc->rx_buff = NULL;
 
 	ret = HAL_SAI_DMAStop(&tdesc->hsai);
 	if (ret)
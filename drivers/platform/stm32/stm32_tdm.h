@@ -71,6 +71,14 @@ struct stm32_tdm_desc {
 	struct no_os_callback_desc rx_half_callback;
 	/** Rx complete callback */
 	struct no_os_callback_desc rx_callback;
+	/** DMA runs circularly on the buffer of the last read */
+	bool continuous;
+	/** Buffer of the continuous reception */
+	void *rx_buff;
+	/** Number of samples of the continuous reception buffer */
+	uint16_t rx_samples;
+	/** Number of times the continuous reception was restarted on errors */
+	uint32_t rx_restarts;
 };
 
 /**
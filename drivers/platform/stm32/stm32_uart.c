@@ -38,10 +38,12 @@
 *******************************************************************************/
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_uart.h"
 #include "no_os_irq.h"
 #include "no_os_lf256fifo.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "stm32_irq.h"
 #include "stm32_uart.h"
 #include "stm32_hal.h"
@@ -55,6 +57,169 @@ void uart_rx_callback(void *context)
 	HAL_UART_Receive_IT(((struct stm32_uart_desc *)d->extra)->huart, &c, 1);
 }
 
+/* UARTs in DMA mode, the HAL callbacks only get the UART handle */
+static struct stm32_uart_desc *dma_uarts[STM32_UART_DMA_MAX];
+
+static struct stm32_uart_desc *stm32_uart_dma_find(UART_HandleTypeDef *huart)
+{
+	uint32_t i;
+
+	for (i = 0; i < STM32_UART_DMA_MAX; i++)
+		if (dma_uarts[i] && dma_uarts[i]->huart == huart)
+			return dma_uarts[i];
+
+	return NULL;
+}
+
+/* Called by the HAL on the idle line, half transfer and transfer complete
+ * events, pos is the number of bytes the DMA already wrote in the buffer. */
+static void stm32_uart_dma_rx_event(UART_HandleTypeDef *huart, uint16_t pos)
+{
+	struct stm32_uart_desc *sud = stm32_uart_dma_find(huart);
+
+	if (!sud)
+		return;
+
+	sud->dma_rx_head = pos == sud->dma_rx_size ? 0 : pos;
+}
+
+static int32_t stm32_uart_dma_start_rx(struct stm32_uart_desc *sud)
+{
+	int ret;
+
+	sud->dma_rx_head = 0;
+	sud->dma_rx_tail = 0;
+	ret = HAL_UARTEx_ReceiveToIdle_DMA(sud->huart, sud->dma_rx_buff,
+					   sud->dma_rx_size);
+	if (ret != HAL_OK)
+		return -EIO;
+
+	return 0;
+}
+
+/* The HAL stops the reception on overrun, restart it dropping the unread
+ * bytes. */
+static void stm32_uart_dma_error(UART_HandleTypeDef *huart)
+{
+	struct stm32_uart_desc *sud = stm32_uart_dma_find(huart);
+
+	if (!sud)
+		return;
+
+	if (huart->RxState == HAL_UART_STATE_READY)
+		stm32_uart_dma_start_rx(sud);
+}
+
+/* The TX DMA is done, send the next part of the buffered stdout. */
+static void stm32_uart_dma_tx_done(UART_HandleTypeDef *huart)
+{
+	no_os_uart_stdio_poll();
+}
+
+/**
+ * @brief Allocate the DMA buffers and start the circular RX DMA.
+ * @param sud - The stm32 UART descriptor, huart already initialized.
+ * @param suip - The stm32 UART parameters.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int32_t stm32_uart_dma_init(struct stm32_uart_desc *sud,
+				   struct stm32_uart_init_param *suip)
+{
+	uint32_t slot;
+	int ret;
+
+	if (!sud->huart->hdmarx || !sud->huart->hdmatx)
+		return -EINVAL;
+
+	for (slot = 0; slot < STM32_UART_DMA_MAX; slot++)
+		if (!dma_uarts[slot])
+			break;
+	if (slot == STM32_UART_DMA_MAX)
+		return -ENOMEM;
+
+	sud->dma_rx_size = suip->dma_rx_size ? suip->dma_rx_size :
+			   STM32_UART_DMA_RX_SIZE;
+	sud->dma_tx_size = suip->dma_tx_size ? suip->dma_tx_size :
+			   STM32_UART_DMA_TX_SIZE;
+	if (sud->dma_rx_size > UINT16_MAX || sud->dma_tx_size > UINT16_MAX)
+		return -EINVAL;
+
+	sud->dma_rx_buff = no_os_calloc(1, sud->dma_rx_size);
+	if (!sud->dma_rx_buff)
+		return -ENOMEM;
+
+	sud->dma_tx_buff = no_os_calloc(1, sud->dma_tx_size);
+	if (!sud->dma_tx_buff) {
+		ret = -ENOMEM;
+		goto error_rx_buff;
+	}
+
+	ret = HAL_UART_RegisterRxEventCallback(sud->huart, stm32_uart_dma_rx_event);
+	if (ret != HAL_OK) {
+		ret = -EFAULT;
+		goto error_tx_buff;
+	}
+
+	ret = HAL_UART_RegisterCallback(sud->huart, HAL_UART_ERROR_CB_ID,
+					stm32_uart_dma_error);
+	if (ret != HAL_OK) {
+		ret = -EFAULT;
+		goto error_rx_event;
+	}
+
+	ret = HAL_UART_RegisterCallback(sud->huart, HAL_UART_TX_COMPLETE_CB_ID,
+					stm32_uart_dma_tx_done);
+	if (ret != HAL_OK) {
+		ret = -EFAULT;
+		goto error_err_cb;
+	}
+
+	dma_uarts[slot] = sud;
+	sud->dma = true;
+
+	ret = stm32_uart_dma_start_rx(sud);
+	if (ret)
+		goto error_slot;
+
+	return 0;
+
+error_slot:
+	sud->dma = false;
+	dma_uarts[slot] = NULL;
+	HAL_UART_UnRegisterCallback(sud->huart, HAL_UART_TX_COMPLETE_CB_ID);
+error_err_cb:
+	HAL_UART_UnRegisterCallback(sud->huart, HAL_UART_ERROR_CB_ID);
+error_rx_event:
+	HAL_UART_UnRegisterRxEventCallback(sud->huart);
+error_tx_buff:
+	no_os_free(sud->dma_tx_buff);
+error_rx_buff:
+	no_os_free(sud->dma_rx_buff);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the DMA transfers and free the resources allocated by
+ * stm32_uart_dma_init().
+ * @param sud - The stm32 UART descriptor.
+ */
+static void stm32_uart_dma_remove(struct stm32_uart_desc *sud)
+{
+	uint32_t i;
+
+	HAL_UART_DMAStop(sud->huart);
+	HAL_UART_UnRegisterCallback(sud->huart, HAL_UART_TX_COMPLETE_CB_ID);
+	HAL_UART_UnRegisterCallback(sud->huart, HAL_UART_ERROR_CB_ID);
+	HAL_UART_UnRegisterRxEventCallback(sud->huart);
+	for (i = 0; i < STM32_UART_DMA_MAX; i++)
+		if (dma_uarts[i] == sud)
+			dma_uarts[i] = NULL;
+	no_os_free(sud->dma_tx_buff);
+	no_os_free(sud->dma_rx_buff);
+	sud->dma = false;
+}
+
 /**
  * @brief Initialize the UART communication peripheral.
  * @param desc - The UART descriptor.
@@ -128,8 +293,13 @@ static int32_t stm32_uart_init(struct no_os_uart_desc **desc,
 
 	sud->timeout = suip->timeout ? suip->timeout : HAL_MAX_DELAY;
 
-	// nonblocking uart_read
-	if(param->asynchronous_rx) {
+	if (suip->dma) {
+		// RX is always asynchronous with DMA
+		ret = stm32_uart_dma_init(sud, suip);
+		if (ret)
+			goto error;
+	} else if(param->asynchronous_rx) {
+		// nonblocking uart_read
 		ret = lf256fifo_init(&descriptor->rx_fifo);
 		if (ret < 0)
 			goto error;
@@ -196,6 +366,8 @@ static int32_t stm32_uart_remove(struct no_os_uart_desc *desc)
 		return -EINVAL;
 
 	sud = desc->extra;
+	if (sud->dma)
+		stm32_uart_dma_remove(sud);
 	HAL_UART_DeInit(sud->huart);
 	if (desc->rx_fifo) {
 		no_os_irq_disable(sud->nvic, desc->irq_id);
@@ -210,6 +382,125 @@ static int32_t stm32_uart_remove(struct no_os_uart_desc *desc)
 	return 0;
 };
 
+/**
+ * @brief Read the data already received by the RX DMA or the RX interrupt.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return positive number of read bytes, -EAGAIN if no data was received,
+ * negative error code otherwise.
+ */
+static int32_t stm32_uart_read_nonblocking(struct no_os_uart_desc *desc,
+		uint8_t *data,
+		uint32_t bytes_number)
+{
+	struct stm32_uart_desc *sud;
+	uint32_t head;
+	uint32_t len;
+	uint32_t i = 0;
+
+	if (!desc || !desc->extra || !data)
+		return -EINVAL;
+
+	sud = desc->extra;
+	if (desc->rx_fifo) {
+		i = lf256fifo_read_bulk(desc->rx_fifo, data, bytes_number);
+		return i ? (int32_t)i : -EAGAIN;
+	}
+
+	if (!sud->dma)
+		return -ENOSYS;
+
+	head = sud->dma_rx_head;
+	while (i < bytes_number && sud->dma_rx_tail != head) {
+		if (head > sud->dma_rx_tail)
+			len = head - sud->dma_rx_tail;
+		else
+			len = sud->dma_rx_size - sud->dma_rx_tail;
+		len = no_os_min(len, bytes_number - i);
+
+		memcpy(data + i, sud->dma_rx_buff + sud->dma_rx_tail, len);
+		i += len;
+		sud->dma_rx_tail += len;
+		if (sud->dma_rx_tail == sud->dma_rx_size)
+			sud->dma_rx_tail = 0;
+	}
+
+	return i ? (int32_t)i : -EAGAIN;
+}
+
+/**
+ * @brief Start a TX DMA transfer. The data is copied, so the buffer may be
+ * reused as soon as the function returns.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return positive number of queued bytes (at most dma_tx_size), -EBUSY if the
+ * previous transfer is not done, negative error code otherwise.
+ */
+static int32_t stm32_uart_write_nonblocking(struct no_os_uart_desc *desc,
+		const uint8_t *data,
+		uint32_t bytes_number)
+{
+	struct stm32_uart_desc *sud;
+	uint32_t len;
+	int ret;
+
+	if (!desc || !desc->extra || !data)
+		return -EINVAL;
+
+	sud = desc->extra;
+	if (!sud->dma)
+		return -ENOSYS;
+
+	if (!bytes_number)
+		return 0;
+
+	if (sud->huart->gState != HAL_UART_STATE_READY)
+		return -EBUSY;
+
+	len = no_os_min(bytes_number, sud->dma_tx_size);
+	memcpy(sud->dma_tx_buff, data, len);
+	ret = HAL_UART_Transmit_DMA(sud->huart, sud->dma_tx_buff, len);
+	switch (ret) {
+	case HAL_OK:
+		break;
+	case HAL_BUSY:
+		return -EBUSY;
+	default:
+		return -EIO;
+	};
+
+	return len;
+}
+
+/* Queue all the data on the TX DMA, waiting at most timeout for each chunk */
+static int32_t stm32_uart_dma_write(struct no_os_uart_desc *desc,
+				    const uint8_t *data,
+				    uint32_t bytes_number)
+{
+	struct stm32_uart_desc *sud = desc->extra;
+	uint32_t start = HAL_GetTick();
+	uint32_t i = 0;
+	int32_t ret;
+
+	while (i < bytes_number) {
+		ret = stm32_uart_write_nonblocking(desc, data + i, bytes_number - i);
+		if (ret == -EBUSY) {
+			if (HAL_GetTick() - start > sud->timeout)
+				return -ETIMEDOUT;
+			continue;
+		}
+		if (ret < 0)
+			return ret;
+
+		i += ret;
+		start = HAL_GetTick();
+	}
+
+	return bytes_number;
+}
+
 /**
  * @brief Write data to UART device.
  * @param desc - Instance of UART.
@@ -231,6 +522,9 @@ static int32_t stm32_uart_write(struct no_os_uart_desc *desc,
 		return 0;
 
 	sud = desc->extra;
+	if (sud->dma)
+		return stm32_uart_dma_write(desc, data, bytes_number);
+
 	ret = HAL_UART_Transmit(sud->huart, (uint8_t *)data, bytes_number,
 				sud->timeout);
 
@@ -259,7 +553,6 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 			       uint32_t bytes_number)
 {
 	struct stm32_uart_desc *sud;
-	uint32_t i = 0;
 	int32_t ret;
 
 	if (!desc || !desc->extra || !data)
@@ -270,14 +563,8 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 
 	sud = desc->extra;
 
-	if (desc->rx_fifo) {
-		while(i < bytes_number) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[i]);
-			if (ret < 0)
-				return i ? i : -EAGAIN;
-			i++;
-		}
-		return i;
+	if (desc->rx_fifo || sud->dma) {
+		return stm32_uart_read_nonblocking(desc, data, bytes_number);
 	} else {
 		ret = HAL_UART_Receive(sud->huart, (uint8_t *)data, bytes_number,
 				       sud->timeout);
@@ -304,5 +591,7 @@ const struct no_os_uart_platform_ops stm32_uart_ops = {
 	.init = &stm32_uart_init,
 	.read = &stm32_uart_read,
 	.write = &stm32_uart_write,
+	.read_nonblocking = &stm32_uart_read_nonblocking,
+	.write_nonblocking = &stm32_uart_write_nonblocking,
 	.remove = &stm32_uart_remove
 };
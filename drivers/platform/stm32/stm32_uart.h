@@ -45,6 +45,11 @@
 #include "no_os_irq.h"
 #include "stm32_hal.h"
 
+#define STM32_UART_DMA_RX_SIZE	512
+#define STM32_UART_DMA_TX_SIZE	512
+/* Maximum number of UARTs using DMA at the same time */
+#define STM32_UART_DMA_MAX	8
+
 /**
  * @struct stm32_uart_init_param
  * @brief Specific initialization parameters for stm32 UART.
@@ -54,6 +59,17 @@ struct stm32_uart_init_param {
 	UART_HandleTypeDef *huart;
 	/** UART transaction timeout (HAL_IncTick() units) */
 	uint32_t timeout;
+	/**
+	 * Use the DMA channels linked to huart (hdmarx in circular mode and
+	 * hdmatx) instead of per byte transfers. Requires
+	 * USE_HAL_UART_REGISTER_CALLBACKS. The DMA buffers are allocated on
+	 * the heap, which must not be data cached on cores with a D-cache.
+	 */
+	bool dma;
+	/** Size of the circular RX DMA buffer, STM32_UART_DMA_RX_SIZE if 0 */
+	uint32_t dma_rx_size;
+	/** Size of the TX DMA buffer, STM32_UART_DMA_TX_SIZE if 0 */
+	uint32_t dma_tx_size;
 };
 
 /**
@@ -69,6 +85,20 @@ struct stm32_uart_desc {
 	struct no_os_irq_ctrl_desc *nvic;
 	/** RX complete callback */
 	struct no_os_callback_desc rx_callback;
+	/** DMA transfers enabled */
+	bool dma;
+	/** Circular buffer written by the RX DMA */
+	uint8_t *dma_rx_buff;
+	/** Size of dma_rx_buff */
+	uint32_t dma_rx_size;
+	/** RX DMA position reported by the last idle, half or full event */
+	volatile uint32_t dma_rx_head;
+	/** Position of the next byte to be read from dma_rx_buff */
+	uint32_t dma_rx_tail;
+	/** Buffer the TX DMA sends from */
+	uint8_t *dma_tx_buff;
+	/** Size of dma_tx_buff */
+	uint32_t dma_tx_size;
 };
 
 /**
@@ -85,7 +85,7 @@ int _write(int fd, char* ptr, int len)
 	int ret;
 
 	if (fd == STDOUT_FILENO || fd == STDERR_FILENO) {
-		ret = no_os_uart_write(guart, (uint8_t *)ptr, len);
+		ret = no_os_uart_stdio_write(guart, (uint8_t *)ptr, len);
 		if (ret < 0) {
 			errno = -ret;
 			return -1;
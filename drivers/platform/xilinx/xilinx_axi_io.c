@@ -41,7 +41,6 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
-#include <xil_io.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
 
@@ -58,7 +57,7 @@
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-	*data = Xil_In32(base + offset);
+	*data = no_os_axi_io_read32(base, offset);
 
 	return 0;
 }
@@ -72,7 +71,7 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-	Xil_Out32(base + offset, data);
+	no_os_axi_io_write32(base, offset, data);
 
 	return 0;
 }
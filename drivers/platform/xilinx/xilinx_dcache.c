@@ -0,0 +1,116 @@
+/***************************************************************************//**
+ *   @file   xilinx/xilinx_dcache.c
+ *   @brief  Implementation of Xilinx data cache maintenance functions.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stddef.h>
+#include <xil_cache.h>
+#ifndef PLATFORM_MB
+#include <xil_mmu.h>
+#endif
+#include "no_os_dma_buf.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Granularity of the memory attributes set through the translation table */
+#ifdef PLATFORM_ZYNQMP
+#define XILINX_MMU_BLOCK_SIZE	0x200000
+#else
+#define XILINX_MMU_BLOCK_SIZE	0x100000
+#endif
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Xilinx specific data cache write back function.
+ * @param addr - Start of the range.
+ * @param len - Length of the range in bytes.
+ */
+void no_os_dcache_flush_range(uintptr_t addr, uint32_t len)
+{
+	Xil_DCacheFlushRange(addr, len);
+}
+
+/**
+ * @brief Xilinx specific data cache invalidate function.
+ * @param addr - Start of the range.
+ * @param len - Length of the range in bytes.
+ */
+void no_os_dcache_invalidate_range(uintptr_t addr, uint32_t len)
+{
+	Xil_DCacheInvalidateRange(addr, len);
+}
+
+/**
+ * @brief Xilinx specific function marking a memory region as non-cacheable.
+ *
+ * The attributes are set in whole translation table blocks (1 MB on Zynq,
+ * 2 MB on ZynqMP), so the region must be aligned to them. MicroBlaze has no
+ * MMU and is not supported: its DMA buffers have to be placed in a memory
+ * range excluded from the data cache by the hardware design.
+ * @param addr - Start of the region.
+ * @param len - Length of the region in bytes.
+ * @return The region itself, NULL if it cannot be made non-cacheable.
+ */
+void *no_os_dcache_map_uncached(void *addr, uint32_t len)
+{
+#ifdef PLATFORM_MB
+	return NULL;
+#else
+	uintptr_t block;
+
+	if ((uintptr_t)addr % XILINX_MMU_BLOCK_SIZE ||
+	    len % XILINX_MMU_BLOCK_SIZE)
+		return NULL;
+
+	/* Write back and drop the lines cached for the region */
+	Xil_DCacheFlushRange((uintptr_t)addr, len);
+
+	for (block = (uintptr_t)addr; block < (uintptr_t)addr + len;
+	     block += XILINX_MMU_BLOCK_SIZE)
+		Xil_SetTlbAttributes(block, NORM_NONCACHE);
+
+	return addr;
+#endif
+}
@@ -46,6 +46,7 @@
 #ifdef _XPARAMETERS_PS_H_
 #include "no_os_util.h"
 #include "xtime_l.h"
+#include "no_os_profile.h"
 #endif
 
 /******************************************************************************/
@@ -98,3 +99,27 @@ struct no_os_time no_os_get_time(void)
 
 	return t;
 }
+
+#ifdef _XPARAMETERS_PS_H_
+/**
+ * @brief Read the cycle counter, the low word of the global timer.
+ * @return The counter value.
+ */
+uint32_t no_os_get_cycles(void)
+{
+	XTime Xtime_Global;
+
+	XTime_GetTime(&Xtime_Global);
+
+	return (uint32_t)Xtime_Global;
+}
+
+/**
+ * @brief Get the frequency of the counter read by no_os_get_cycles().
+ * @return The frequency in Hz.
+ */
+uint32_t no_os_get_cycles_freq(void)
+{
+	return COUNTS_PER_SECOND;
+}
+#endif
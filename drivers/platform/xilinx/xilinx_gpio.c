@@ -450,6 +450,114 @@ int32_t xil_gpio_get_value(struct no_os_gpio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Set the masked pins of the port of the specified GPIO. The port is
+ * the channel (PL) or the bank (PS) the GPIO belongs to.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins to be written, bit n is pin n of the port.
+ * @param value - New values of the masked pins.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t xil_gpio_port_set_value(struct no_os_gpio_desc *desc,
+				uint32_t mask, uint32_t value)
+{
+	struct xil_gpio_desc	*extra;
+#ifdef XGPIO_H
+	uint8_t channel;
+	uint32_t reg_val;
+#endif
+#ifdef XGPIOPS_H
+	XGpioPs *ps;
+	uint32_t offset;
+	uint8_t bank;
+	uint8_t pin;
+#endif
+	if (!desc)
+		return -1;
+
+	extra = desc->extra;
+
+	switch (extra->type) {
+	case GPIO_PL:
+#ifdef XGPIO_H
+		channel = desc->number >= 32 ? 2 : 1;
+
+		reg_val = XGpio_DiscreteRead(extra->instance, channel);
+		reg_val = (reg_val & ~mask) | (value & mask);
+		XGpio_DiscreteWrite(extra->instance, channel, reg_val);
+#endif
+		break;
+	case GPIO_PS:
+#ifdef XGPIOPS_H
+		ps = extra->instance;
+		XGpioPs_GetBankPin(desc->number, &bank, &pin);
+		offset = bank * XGPIOPS_DATA_MASK_OFFSET;
+
+		/* The upper half of the masked data registers selects the
+		 * pins that are left untouched. */
+		if (mask & 0xFFFF)
+			XGpioPs_WriteReg(ps->GpioConfig.BaseAddr,
+					 offset + XGPIOPS_DATA_LSW_OFFSET,
+					 ((~mask & 0xFFFF) << 16) |
+					 (value & mask & 0xFFFF));
+		if (mask >> 16)
+			XGpioPs_WriteReg(ps->GpioConfig.BaseAddr,
+					 offset + XGPIOPS_DATA_MSW_OFFSET,
+					 (~mask & 0xFFFF0000) |
+					 ((value & mask) >> 16));
+#endif
+		break;
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the masked pins of the port of the specified GPIO. The port is
+ * the channel (PL) or the bank (PS) the GPIO belongs to.
+ * @param desc - Descriptor of any GPIO of the port.
+ * @param mask - Pins to be read, bit n is pin n of the port.
+ * @param value - Values of the masked pins.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t xil_gpio_port_get_value(struct no_os_gpio_desc *desc,
+				uint32_t mask, uint32_t *value)
+{
+	struct xil_gpio_desc	*extra;
+#ifdef XGPIO_H
+	uint8_t channel;
+#endif
+#ifdef XGPIOPS_H
+	uint8_t bank;
+	uint8_t pin;
+#endif
+	if (!desc || !value)
+		return -1;
+
+	extra = desc->extra;
+
+	switch (extra->type) {
+	case GPIO_PL:
+#ifdef XGPIO_H
+		channel = desc->number >= 32 ? 2 : 1;
+		*value = XGpio_DiscreteRead(extra->instance, channel) & mask;
+#endif
+		break;
+	case GPIO_PS:
+#ifdef XGPIOPS_H
+		XGpioPs_GetBankPin(desc->number, &bank, &pin);
+		*value = XGpioPs_Read(extra->instance, bank) & mask;
+#endif
+		break;
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Xilinx platform specific GPIO platform ops structure
  */
@@ -462,4 +570,6 @@ const struct no_os_gpio_platform_ops xil_gpio_ops = {
 	.gpio_ops_get_direction = &xil_gpio_get_direction,
 	.gpio_ops_set_value = &xil_gpio_set_value,
 	.gpio_ops_get_value = &xil_gpio_get_value,
+	.gpio_ops_port_set_value = &xil_gpio_port_set_value,
+	.gpio_ops_port_get_value = &xil_gpio_port_get_value,
 };
@@ -46,7 +46,6 @@
 #include "no_os_error.h"
 #include "xilinx_gpio_irq.h"
 #include "no_os_util.h"
-#include "no_os_list.h"
 #include "no_os_irq.h"
 #include "no_os_alloc.h"
 
@@ -55,46 +54,57 @@
 /******************************************************************************/
 
 /**
- * @brief Comparing function used by list.
- * @param desc_a - Compared item
- * @param desc_b - Reference item
- * @return - 0 if items match
+ * @brief Get the table entry of a pin.
+ * @param param - GPIO IRQ desc's extra field
+ * @param pin_nb - Pin number.
+ * @return The entry or NULL if the pin does not exist.
  */
-static int32_t call_cmp(struct xil_callback_desc *desc_a,
-			struct xil_callback_desc *desc_b)
+static struct xil_callback_desc *xil_gpio_irq_entry(struct xil_gpio_irq_desc
+		*param, uint32_t pin_nb)
 {
-	return desc_a->pin_nb - desc_b->pin_nb;
+	uint8_t bank;
+	uint8_t pin;
+
+	if (pin_nb >= param->my_Gpio.MaxPinNum)
+		return NULL;
+
+	XGpioPs_GetBankPin(pin_nb, &bank, &pin);
+	if (bank >= XIL_GPIO_IRQ_MAX_BANKS || pin >= XIL_GPIO_IRQ_BANK_PINS)
+		return NULL;
+
+	return &param->callbacks[bank][pin];
 }
 
 /**
- * @brief Function called when GPIO IRQ occurs.
+ * @brief Function called when GPIO IRQ occurs. The pending pins are read per
+ * bank and their callbacks taken from the table, without any search.
  * @param param - GPIO IRQ desc's extra field
  * @return - None.
  */
 static void xil_gpio_irq_handler(struct xil_gpio_irq_desc *param)
 {
-	int32_t status = 0;
-	int32_t pin_nb;
 	struct xil_callback_desc *callback_desc;
+	uint32_t pending;
+	uint32_t bank;
+	uint32_t pin;
 
-	status = no_os_iterator_move_to_idx(param->it, 0);
-	while(!status) {
-		no_os_iterator_read(param->it, &callback_desc);
-		status = no_os_iterator_move(param->it, 1);
-		if(XGpioPs_IntrGetStatusPin(&param->my_Gpio, callback_desc->pin_nb))
-			callback_desc->triggered = true;
-	}
+	for (bank = 0; bank < param->my_Gpio.MaxBanks &&
+	     bank < XIL_GPIO_IRQ_MAX_BANKS; bank++) {
+		pending = XGpioPs_IntrGetStatus(&param->my_Gpio, bank) &
+			  XGpioPs_IntrGetEnabled(&param->my_Gpio, bank);
 
-	status = no_os_iterator_move_to_idx(param->it, 0);
-	while(!status) {
-		no_os_iterator_read(param->it, &callback_desc);
-		status = no_os_iterator_move(param->it, 1);
-		if(callback_desc->triggered == true) {
-			callback_desc->triggered = false;
+		while (pending) {
+			pin = no_os_find_first_set_bit(pending);
+			pending &= ~NO_OS_BIT(pin);
+
+			callback_desc = &param->callbacks[bank][pin];
 			XGpioPs_IntrDisablePin(&param->my_Gpio, callback_desc->pin_nb);
 			XGpioPs_IntrClearPin(&param->my_Gpio, callback_desc->pin_nb);
+			if (!callback_desc->callback.callback)
+				continue;
+
 			callback_desc->callback.callback(callback_desc->callback.ctx);
-			if(callback_desc->enabled)
+			if (callback_desc->enabled)
 				XGpioPs_IntrEnablePin(&param->my_Gpio, callback_desc->pin_nb);
 		}
 	}
@@ -108,22 +118,16 @@ static void xil_gpio_irq_handler(struct xil_gpio_irq_desc *param)
  */
 int32_t xil_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
 {
-	int32_t status;
 	struct xil_gpio_irq_desc *extra;
 	struct xil_callback_desc *callback_desc;
 
 	extra = desc->extra;
 
-	status = no_os_iterator_move_to_idx(extra->it, 0);
-	while(!status) {
-		no_os_iterator_read(extra->it, &callback_desc);
-		status = no_os_iterator_move(extra->it, 1);
-		if(callback_desc->pin_nb == irq_id) {
-			callback_desc->enabled = false;
-			break;
-		}
-	}
+	callback_desc = xil_gpio_irq_entry(extra, irq_id);
+	if (!callback_desc)
+		return -EINVAL;
 
+	callback_desc->enabled = false;
 	XGpioPs_IntrDisablePin(&extra->my_Gpio, irq_id);
 
 	return 0;
@@ -139,7 +143,6 @@ int32_t xil_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
 int32_t xil_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 			       const struct no_os_irq_init_param *param)
 {
-	int32_t i;
 	int32_t status;
 	struct no_os_irq_ctrl_desc *ldesc;
 	static XGpioPs_Config *GPIO_Config;
@@ -167,42 +170,27 @@ int32_t xil_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
 	ldesc->extra = xil_desc;
 	xil_desc->parent_desc = xil_ip->parent_desc;
 
-	status = no_os_list_init(&xil_desc->callback_list, NO_OS_LIST_DEFAULT,
-				 call_cmp);
-	if(status)
-		goto error_list;
-
-	status = no_os_iterator_init(&xil_desc->it, xil_desc->callback_list, 0);
-	if(status) {
-		no_os_iterator_remove(xil_desc->it);
-		goto error_list;
-	}
-
 	ldesc->irq_ctrl_id = param->irq_ctrl_id;
 	status = no_os_irq_trigger_level_set(xil_desc->parent_desc, ldesc->irq_ctrl_id,
 					     NO_OS_IRQ_EDGE_RISING);
 	if(status)
-		goto error_op;
+		goto error_desc;
 
 	status = no_os_irq_enable(xil_desc->parent_desc, ldesc->irq_ctrl_id);
 	if(status)
-		goto error_op;
+		goto error_desc;
 
 	callback.callback = &xil_gpio_irq_handler;
 	callback.ctx = ldesc->extra;
 	status = no_os_irq_register_callback(xil_desc->parent_desc, ldesc->irq_ctrl_id,
 					     &callback);
 	if(status)
-		goto error_op;
+		goto error_desc;
 
 	*desc = ldesc;
 
 	return 0;
 
-error_op:
-	no_os_iterator_remove(xil_desc->it);
-error_list:
-	no_os_list_remove(xil_desc->callback_list);
 error_desc:
 	no_os_free(xil_desc);
 	no_os_free(ldesc);
@@ -248,19 +236,18 @@ int32_t xil_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 	struct xil_callback_desc *dev_callback;
 	struct xil_gpio_irq_desc *extra;
 
-	dev_callback = (struct xil_callback_desc *)no_os_calloc(1,
-			sizeof(*dev_callback));
-	if(!dev_callback)
-		return -1;
+	extra = desc->extra;
+	dev_callback = xil_gpio_irq_entry(extra, irq_id);
+	if (!dev_callback)
+		return -EINVAL;
 
+	dev_callback->callback.callback = NULL;
 	dev_callback->pin_nb = irq_id;
-	dev_callback->callback.callback = callback_desc->callback;
 	dev_callback->callback.ctx = callback_desc->ctx;
+	dev_callback->callback.callback = callback_desc->callback;
 	dev_callback->triggered = false;
 
-	extra = desc->extra;
 	XGpioPs_SetDirectionPin(&extra->my_Gpio, irq_id, 0);
-	no_os_list_add_last(extra->callback_list, dev_callback);
 
 	return 0;
 }
@@ -275,19 +262,17 @@ int32_t xil_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
 int32_t xil_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
 		uint32_t irq_id, struct no_os_callback_desc *cb)
 {
-	int32_t status;
 	struct xil_gpio_irq_desc *extra;
 	struct xil_callback_desc *dev_callback;
-	struct xil_callback_desc search_callback;
 
 	extra = desc->extra;
-	search_callback.pin_nb = irq_id;
-	status = no_os_list_get_find(extra->callback_list, &dev_callback,
-				     &search_callback);
-	if(status)
+	dev_callback = xil_gpio_irq_entry(extra, irq_id);
+	if (!dev_callback || !dev_callback->callback.callback)
 		return -ENXIO;
 
-	no_os_free(dev_callback);
+	dev_callback->callback.callback = NULL;
+	dev_callback->callback.ctx = NULL;
+	dev_callback->enabled = false;
 
 	return 0;
 }
@@ -300,21 +285,18 @@ int32_t xil_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
  */
 int32_t xil_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
 {
-	int32_t status;
 	struct xil_gpio_irq_desc *extra;
 	struct xil_callback_desc *callback_desc;
 
 	extra = desc->extra;
 
-	status = no_os_iterator_move_to_idx(extra->it, 0);
-	while(!status) {
-		no_os_iterator_read(extra->it, &callback_desc);
-		status = no_os_iterator_move(extra->it, 1);
-		if(callback_desc->pin_nb == irq_id) {
-			callback_desc->enabled = true;
-			XGpioPs_IntrClearPin(&extra->my_Gpio, irq_id);
-			break;
-		}
+	callback_desc = xil_gpio_irq_entry(extra, irq_id);
+	if (!callback_desc)
+		return -EINVAL;
+
+	if (callback_desc->callback.callback) {
+		callback_desc->enabled = true;
+		XGpioPs_IntrClearPin(&extra->my_Gpio, irq_id);
 	}
 
 	XGpioPs_IntrEnablePin(&extra->my_Gpio, irq_id);
@@ -329,19 +311,10 @@ int32_t xil_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
  */
 int32_t xil_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
 {
-	struct xil_gpio_irq_desc *extra;
-	struct xil_callback_desc *callback_desc;
-
 	if (!desc)
 		return -EINVAL;
 
-	extra = desc->extra;
-	while (0 == no_os_list_get_first(extra->callback_list, &callback_desc))
-		no_os_free(callback_desc);
-
-	no_os_iterator_remove(extra->it);
-	no_os_list_remove(extra->callback_list);
-	no_os_free(extra);
+	no_os_free(desc->extra);
 	no_os_free(desc);
 
 	return 0;
@@ -45,10 +45,17 @@
 /******************************************************************************/
 
 #include "stdbool.h"
-#include "no_os_list.h"
 #include "xgpiops.h"
 #include "no_os_irq.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* ZynqMP has the most PS GPIO banks */
+#define XIL_GPIO_IRQ_MAX_BANKS	6
+#define XIL_GPIO_IRQ_BANK_PINS	32
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -80,8 +87,9 @@ struct xil_gpio_irq_init_param {
 struct xil_gpio_irq_desc {
 	struct no_os_irq_ctrl_desc *parent_desc;
 	XGpioPs my_Gpio;
-	struct no_os_list_desc *callback_list;
-	struct no_os_iterator *it;
+	/* Callbacks indexed by bank and pin in bank, NULL callback if unused */
+	struct xil_callback_desc callbacks[XIL_GPIO_IRQ_MAX_BANKS]
+	[XIL_GPIO_IRQ_BANK_PINS];
 };
 
 /**
@@ -45,6 +45,7 @@
 
 #include <stdint.h>
 #include "no_os_spi.h"
+#include "no_os_irq.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -80,6 +81,14 @@ struct xil_spi_init_param {
 	enum xil_spi_type	type;
 	/** SPI flags */
 	uint32_t		flags;
+	/**
+	 * Interrupt controller of the AXI Quad SPI interrupt, xil_spi_pl_ops
+	 * only. Enables the interrupt driven dma_transfer_sync/async, NULL to
+	 * only use the polled mode.
+	 */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** Interrupt ID of the AXI Quad SPI, used with irq_ctrl */
+	uint32_t		irq_id;
 };
 
 /**
@@ -53,6 +53,8 @@
 #include "no_os_delay.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "xilinx_spi.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -73,21 +75,38 @@ static struct no_os_spi_desc g_spi_desc[XPAR_XSPI_NUM_INSTANCES];
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/* Position of the interrupt driven or polled stream over a message list */
+struct xspi_xfer {
+	struct no_os_spi_msg	*msgs;
+	uint32_t	len;
+	/* Next message and byte to write */
+	uint32_t	tx_i;
+	uint32_t	tx_off;
+	/* Next message and byte to read */
+	uint32_t	rx_i;
+	uint32_t	rx_off;
+	/* Bytes written and not read yet, at most fifo_depth */
+	uint32_t	in_flight;
+	/* Writing stopped until CS is toggled at the end of a message */
+	bool		cs_pending;
+	/* Interrupt driven transfer in progress */
+	volatile bool	busy;
+	void		(*callback)(void *);
+	void		*ctx;
+};
+
 /* Xilinx PL spi specific data */
 struct xspi_desc {
 	uint32_t base_addr;
 	uint32_t disable_slaves_mask;
 	uint32_t fifo_depth;
 	uint8_t  cs_asserted;
-};
-
-/* Structure used to iterate over SPI messages */
-struct msg_iter {
-	struct no_os_spi_msg	*msgs;
-	uint32_t	len;
-	uint32_t	i;
-	uint32_t	buff_i;
-	uint8_t		is_wr;
+	/* Interrupt controller, NULL when only the polled mode is used */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	uint32_t irq_id;
+	/* SPI descriptor of the interrupt driven transfer */
+	struct no_os_spi_desc *desc;
+	struct xspi_xfer xfer;
 };
 
 /******************************************************************************/
@@ -155,7 +174,7 @@ static int32_t _xil_spi_init_dev(struct xspi_desc *xdesc)
 	if (val != XSP_DEFAULT_SR_VALUE)
 		return -ENODEV;
 
-	/* Disable interrupts. Drivers only works with pooled mode */
+	/* Interrupts are only enabled during the interrupt driven transfers */
 	_write(xdesc, XSP_IIER_OFFSET, 0);
 
 	/* Deasert chip selects */
@@ -179,12 +198,16 @@ static int32_t _xil_spi_init_dev(struct xspi_desc *xdesc)
 	return 0;
 }
 
+static void _xil_spi_irq_handler(void *ctx);
+
 /* Initialize spi_desc structure and device */
 static int32_t xil_spi_init_pl(struct no_os_spi_desc **desc,
 			       const struct no_os_spi_init_param *param)
 {
 	struct no_os_spi_desc		*ldesc;
 	struct xspi_desc	*xdesc;
+	struct xil_spi_init_param *xparam;
+	struct no_os_callback_desc cb = {0};
 	int32_t			err;
 	XSpi_Config		*cfg;
 
@@ -219,6 +242,25 @@ static int32_t xil_spi_init_pl(struct no_os_spi_desc **desc,
 	if (NO_OS_IS_ERR_VALUE(err))
 		goto error;
 
+	xparam = param->extra;
+	if (xparam && xparam->irq_ctrl) {
+		xdesc->irq_ctrl = xparam->irq_ctrl;
+		xdesc->irq_id = xparam->irq_id;
+		cb.callback = _xil_spi_irq_handler;
+		cb.ctx = xdesc;
+		err = no_os_irq_register_callback(xdesc->irq_ctrl, xdesc->irq_id,
+						  &cb);
+		if (err)
+			goto error;
+
+		err = no_os_irq_enable(xdesc->irq_ctrl, xdesc->irq_id);
+		if (err) {
+			no_os_irq_unregister_callback(xdesc->irq_ctrl,
+						      xdesc->irq_id, &cb);
+			goto error;
+		}
+	}
+
 	ldesc->extra = xdesc;
 	*desc = ldesc;
 
@@ -234,64 +276,30 @@ error:
 /* Remove allocated resources */
 static int32_t xil_spi_remove_pl(struct no_os_spi_desc *desc)
 {
+	struct xspi_desc *xdesc;
+	struct no_os_callback_desc cb = {0};
+
 	if (!desc)
 		return -EINVAL;
 
+	xdesc = desc->extra;
+	if (xdesc && xdesc->irq_ctrl) {
+		if (xdesc->xfer.busy)
+			return -EBUSY;
+
+		no_os_irq_disable(xdesc->irq_ctrl, xdesc->irq_id);
+		cb.callback = _xil_spi_irq_handler;
+		cb.ctx = xdesc;
+		no_os_irq_unregister_callback(xdesc->irq_ctrl, xdesc->irq_id,
+					      &cb);
+	}
+
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
 	return 0;
 }
 
-/*
- * Fill fifo until fifo is full or no more data available.
- * Return the number of written bytes.
- */
-static uint32_t _wr_fifo(struct xspi_desc *xdesc, uint8_t *data,
-			 uint32_t len)
-{
-	uint32_t i;
-	uint32_t to_write;
-	uint32_t tx_available;
-
-	tx_available = xdesc->fifo_depth - _read(xdesc, XSP_TFO_OFFSET);
-	to_write = no_os_min(tx_available, len);
-	for (i = 0; i < to_write; ++i)
-		if (data)
-			_write(xdesc, XSP_DTR_OFFSET, data[i]);
-		else
-			_write(xdesc, XSP_DTR_OFFSET, XSP_DUMMY_DATA);
-
-	return to_write;
-}
-
-/*
- * Read fifo until fifo is empty or no more buffer available to read into
- * Returns the number of read bytes
- */
-static uint32_t _rd_fifo(struct xspi_desc *xdesc, uint8_t *data,
-			 uint32_t len)
-{
-	uint32_t rx_available;
-	uint32_t to_read;
-	uint32_t tmp;
-	uint32_t i;
-
-	tmp = _read(xdesc, XSP_SR_OFFSET);
-	if (tmp & XSP_SR_RX_EMPTY_MASK)
-		return 0;
-
-	rx_available = _read(xdesc, XSP_RFO_OFFSET) + 1;
-	to_read = no_os_min(rx_available, len);
-	for (i = 0; i < to_read; ++i) {
-		tmp = _read(xdesc, XSP_DRR_OFFSET);
-		if (data)
-			data[i] = tmp;
-	}
-
-	return to_read;
-}
-
 /* If start is 0 stop transfer, else start it.
  * CS will be asserted if needed. If different CS othere than the one needed
  * is asserted. Deassert it and assert correct one */
@@ -319,206 +327,239 @@ static void _xil_spi_start_transfer(struct no_os_spi_desc *desc, uint8_t start)
 	xdesc->cs_asserted = start;
 }
 
+/* Deassert CS at the end of a message and assert it again for the next one */
+static void _xil_spi_cs_change(struct no_os_spi_desc *desc,
+			       struct no_os_spi_msg *msg)
+{
+	_xil_spi_start_transfer(desc, 0);
+	if (msg->cs_change_delay)
+		no_os_udelay(msg->cs_change_delay);
+	_xil_spi_start_transfer(desc, 1);
+}
 
-/* SPI polled transfer */
-static int32_t xil_spi_write_and_read_pl(struct no_os_spi_desc *desc,
-		uint8_t *data,
-		uint16_t bytes_number)
+/* Skip the messages with no byte left to read */
+static void _xfer_rx_skip(struct xspi_xfer *xfer)
 {
-	struct xspi_desc	*xdesc;
-	uint32_t		rx;
-	uint32_t		tx;
+	while (xfer->rx_i < xfer->len &&
+	       xfer->rx_off == xfer->msgs[xfer->rx_i].bytes_number) {
+		xfer->rx_i++;
+		xfer->rx_off = 0;
+	}
+}
 
-	if (!desc || !desc->extra)
-		return -EINVAL;
+/*
+ * Move the stream forward: read what the RX FIFO holds, toggle CS once every
+ * byte of a cs_change message is read back and top the TX FIFO up. The FIFO
+ * is never reset, the bytes of the write only messages are read and dropped.
+ * Returns true once every byte is read.
+ */
+static bool _xfer_step(struct no_os_spi_desc *desc)
+{
+	struct xspi_desc	*xdesc = desc->extra;
+	struct xspi_xfer	*xfer = &xdesc->xfer;
+	struct no_os_spi_msg	*msg;
+	uint32_t		val;
 
-	xdesc = desc->extra;
-	_update_mode(desc);
+	while (xfer->in_flight) {
+		if (_read(xdesc, XSP_SR_OFFSET) & XSP_SR_RX_EMPTY_MASK) {
+			/*
+			 * Nothing more will be written before the last bytes
+			 * are read, they are in the shift register.
+			 */
+			if (xfer->tx_i < xfer->len && !xfer->cs_pending)
+				break;
+			if (!(_read(xdesc, XSP_SR_OFFSET) & XSP_SR_TX_EMPTY_MASK))
+				break;
+			continue;
+		}
 
-	_xil_spi_start_transfer(desc, 1);
-	rx = 0;
-	tx = 0;
-	while (rx < bytes_number) {
-		if (tx < bytes_number)
-			tx += _wr_fifo(xdesc, data + tx, bytes_number - tx);
-		rx += _rd_fifo(xdesc, data + rx, bytes_number - rx);
+		val = _read(xdesc, XSP_DRR_OFFSET);
+		msg = xfer->msgs + xfer->rx_i;
+		if (msg->rx_buff)
+			msg->rx_buff[xfer->rx_off] = val;
+		xfer->rx_off++;
+		xfer->in_flight--;
+		_xfer_rx_skip(xfer);
 	}
-	_xil_spi_start_transfer(desc, 0);
 
-	return 0;
+	if (xfer->cs_pending) {
+		if (xfer->in_flight)
+			return false;
+		_xil_spi_cs_change(desc, xfer->msgs + xfer->tx_i - 1);
+		xfer->cs_pending = false;
+	}
+
+	while (xfer->tx_i < xfer->len && xfer->in_flight < xdesc->fifo_depth) {
+		msg = xfer->msgs + xfer->tx_i;
+		if (xfer->tx_off < msg->bytes_number) {
+			_write(xdesc, XSP_DTR_OFFSET, msg->tx_buff ?
+			       msg->tx_buff[xfer->tx_off] : XSP_DUMMY_DATA);
+			xfer->tx_off++;
+			xfer->in_flight++;
+		}
+		if (xfer->tx_off < msg->bytes_number)
+			continue;
+
+		xfer->tx_i++;
+		xfer->tx_off = 0;
+		if (msg->cs_change && xfer->tx_i < xfer->len) {
+			xfer->cs_pending = true;
+			break;
+		}
+	}
+
+	return xfer->tx_i == xfer->len && !xfer->in_flight;
 }
 
-/* Get type of message. It can be READ, WRITE or both */
-static uint32_t _get_msg_type(struct no_os_spi_msg *msg)
+/* Prepare the stream and assert CS */
+static void _xfer_start(struct no_os_spi_desc *desc,
+			struct no_os_spi_msg *msgs, uint32_t len)
 {
-	uint32_t	type;
+	struct xspi_desc *xdesc = desc->extra;
+
+	xdesc->xfer.msgs = msgs;
+	xdesc->xfer.len = len;
+	xdesc->xfer.tx_i = 0;
+	xdesc->xfer.tx_off = 0;
+	xdesc->xfer.rx_i = 0;
+	xdesc->xfer.rx_off = 0;
+	xdesc->xfer.in_flight = 0;
+	xdesc->xfer.cs_pending = false;
+	_xfer_rx_skip(&xdesc->xfer);
 
-	type = 0;
-	if (msg->tx_buff)
-		type |= XPS_TYPE_WRITE;
-	if (msg->rx_buff)
-		type |= XPS_TYPE_READ;
+	_update_mode(desc);
+	_xil_spi_start_transfer(desc, 1);
+}
 
-	return type;
+/* CS stays asserted after the last message only if it has cs_change set */
+static void _xfer_end(struct no_os_spi_desc *desc)
+{
+	struct xspi_xfer *xfer = &((struct xspi_desc *)desc->extra)->xfer;
+
+	if (!xfer->len || !xfer->msgs[xfer->len - 1].cs_change)
+		_xil_spi_start_transfer(desc, 0);
 }
 
-/* Get information based on current iterator position */
-static void _get_data(struct msg_iter *it, uint8_t **buff, uint32_t *len,
-		      uint32_t *type)
+/*
+ * SPI polling transfer of multiple messages. The FIFO is kept full over the
+ * whole list and CS is only toggled for the messages with cs_change set.
+ */
+static int32_t xil_spi_transfer_pl(struct no_os_spi_desc *desc,
+				   struct no_os_spi_msg *msgs,
+				   uint32_t len)
 {
-	struct no_os_spi_msg *msg;
+	struct xspi_desc	*xdesc;
 
-	if (it->i == it->len) {
-		*len = 0;
-		return ;
-	}
+	if (!desc || !desc->extra || (!msgs && len))
+		return -EINVAL;
 
-	msg = it->msgs + it->i;
-	if (it->is_wr)
-		*buff = msg->tx_buff;
-	else
-		*buff = msg->rx_buff;
+	xdesc = desc->extra;
+	if (xdesc->xfer.busy)
+		return -EBUSY;
 
-	if (*buff)
-		*buff += it->buff_i;
+	_xfer_start(desc, msgs, len);
+	while (!_xfer_step(desc))
+		;
+	_xfer_end(desc);
 
-	*len = msg->bytes_number - it->buff_i;
-	if (type)
-		*type = _get_msg_type(msg);
+	return 0;
 }
 
-/*
- * Increment iterator position with desired length.
- * If the new position has a different message type, new_type will be set to 1
- * If a CS change is needed, cs_change is set
- */
-static void _increment_iter(struct msg_iter *it, uint32_t len,
-			    uint8_t *cs_change, uint8_t *new_type)
+/* SPI polled transfer */
+static int32_t xil_spi_write_and_read_pl(struct no_os_spi_desc *desc,
+		uint8_t *data,
+		uint16_t bytes_number)
 {
-	struct no_os_spi_msg	*msg;
-	uint32_t	type;
-	uint32_t	extra_len;
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.rx_buff = data,
+		.bytes_number = bytes_number,
+	};
 
-	if (!len)
-		return ;
+	return xil_spi_transfer_pl(desc, &msg, 1);
+}
 
-	*cs_change = 0;
-	*new_type = 0;
-	msg = it->msgs + it->i;
-	if (it->buff_i + len > msg->bytes_number)
-		extra_len = it->buff_i + len - msg->bytes_number;
-	else
-		extra_len = 0;
-	len -= extra_len;
-	it->buff_i += len;
-	if (it->buff_i == msg->bytes_number) {
-		type = _get_msg_type(msg);
-		++it->i;
-		it->buff_i = 0;
-		if (cs_change && msg->cs_change)
-			*cs_change = 1;
-		if (new_type)
-			if (it->i == it->len ||
-			    type != _get_msg_type(it->msgs + it->i))
-				*new_type = 1;
-	}
-	if (extra_len)
-		_increment_iter(it, extra_len, cs_change, new_type);
+/* Refill and drain the FIFO from the TX empty and half empty interrupts */
+static void _xil_spi_irq_handler(void *ctx)
+{
+	struct xspi_desc	*xdesc = ctx;
+	struct no_os_spi_desc	*desc = xdesc->desc;
+	uint32_t		status;
+
+	status = _read(xdesc, XSP_IISR_OFFSET);
+	_write(xdesc, XSP_IISR_OFFSET, status);
+
+	if (!xdesc->xfer.busy || !_xfer_step(desc))
+		return;
+
+	_write(xdesc, XSP_IIER_OFFSET, 0);
+	_write(xdesc, XSP_DGIER_OFFSET, 0);
+	_xfer_end(desc);
+	xdesc->xfer.busy = false;
+	if (xdesc->xfer.callback)
+		xdesc->xfer.callback(xdesc->xfer.ctx);
 }
 
 /*
- * SPI polling transfer of multiple messages.
+ * Interrupt driven transfer of multiple messages. The AXI Quad SPI has no DMA
+ * of its own, the FIFO is refilled from its interrupts so the CPU is free
+ * while the bytes are shifted. Requires the irq_ctrl of xil_spi_init_param.
  */
-static int32_t xil_spi_transfer_pl(struct no_os_spi_desc *desc,
-				   struct no_os_spi_msg *msgs,
-				   uint32_t len)
-
+static int32_t xil_spi_transfer_async_pl(struct no_os_spi_desc *desc,
+		struct no_os_spi_msg *msgs,
+		uint32_t len,
+		void (*callback)(void *),
+		void *ctx)
 {
 	struct xspi_desc	*xdesc;
-	uint8_t			cs_change;
-	uint8_t			new_type;
-	struct msg_iter		rx = {.msgs = msgs, .len = len, .is_wr = 0};
-	struct msg_iter		tx = {.msgs = msgs, .len = len, .is_wr = 1};
-	uint8_t			*buff;
-	uint32_t		bytes;
-	uint32_t		type;
-	/* Bytes to increment rx when only a write transaction is executed */
-	uint32_t		to_inc_rx;
-	/* Difference between rx and tx iterators in bytes */
-	uint32_t		tx_advance;
-	/* Save bytes sent during a write loop */
-	uint32_t		tx_sent;
-	/* Used to loop if need to empty the RX FIFO */
-	uint32_t		loop;
-
-	if (!desc || !desc->extra)
+
+	if (!desc || !desc->extra || (!msgs && len))
 		return -EINVAL;
 
 	xdesc = desc->extra;
-	_update_mode(desc);
+	if (!xdesc->irq_ctrl)
+		return -ENOSYS;
 
-	tx_advance = 0;
-	to_inc_rx = 0;
-	buff = NULL;
-	type = 0;
-	do {
-		_xil_spi_start_transfer(desc, 1);
-
-		tx_sent = 0;
-		/* Writing loop */
-		do {
-			_get_data(&tx, &buff, &bytes, &type);
-			if (type & XPS_TYPE_READ)
-				/*
-				 * Do not write more bytes than fifo_depth if
-				 * they haven't been read.
-				 */
-				bytes = no_os_min(bytes,
-						  xdesc->fifo_depth - tx_advance);
-			bytes = _wr_fifo(xdesc, buff, bytes);
-			tx_sent += bytes;
-			_increment_iter(&tx, bytes, &cs_change, &new_type);
-			tx_advance += bytes;
-		} while (!cs_change && !new_type && bytes);
-
-		if (type & XPS_TYPE_READ) {
-			loop = 1;
-			/*
-			 * Loop only when no more data to write otherwise read
-			 * only available data.
-			 */
-			while (loop) {
-				if (!new_type)
-					loop = 0;
-				_get_data(&rx, &buff, &bytes, NULL);
-				bytes = _rd_fifo(xdesc, buff, bytes);
-				_increment_iter(&rx, bytes, &cs_change, &new_type);
-				tx_advance -= bytes;
-				if (loop && new_type)
-					break;
-			}
-		} else {
-			/* Clean RX FIFO if it was only a WRITE message */
-			to_inc_rx += tx_sent;
-			if (new_type) {
-				/* Wait for TX to be sent */
-				while (!(_read(xdesc, XSP_SR_OFFSET) &
-					 XSP_SR_TX_EMPTY_MASK))
-					;
-				/* Reset fifo. Only write was performed */
-				_wr_mask(xdesc, XSP_CR_OFFSET,
-					 XSP_CR_RXFIFO_RESET_MASK,
-					 XSP_CR_RXFIFO_RESET_MASK);
-
-				_increment_iter(&rx, to_inc_rx, NULL, NULL);
-				tx_advance -= to_inc_rx;
-				to_inc_rx = 0;
-			}
-		}
+	if (xdesc->xfer.busy)
+		return -EBUSY;
 
-		if ((cs_change && rx.i != len) || (!cs_change && rx.i == len))
-			_xil_spi_start_transfer(desc, 0);
-	} while (rx.i < len);
+	xdesc->desc = desc;
+	xdesc->xfer.callback = callback;
+	xdesc->xfer.ctx = ctx;
+	_xfer_start(desc, msgs, len);
+
+	if (_xfer_step(desc)) {
+		_xfer_end(desc);
+		if (callback)
+			callback(ctx);
+
+		return 0;
+	}
+
+	xdesc->xfer.busy = true;
+	_write(xdesc, XSP_IISR_OFFSET, _read(xdesc, XSP_IISR_OFFSET));
+	_write(xdesc, XSP_IIER_OFFSET, XSP_INTR_TX_EMPTY_MASK |
+	       XSP_INTR_TX_HALF_EMPTY_MASK);
+	_write(xdesc, XSP_DGIER_OFFSET, XSP_GINTR_ENABLE_MASK);
+
+	return 0;
+}
+
+/* Interrupt driven transfer, waits for its end */
+static int32_t xil_spi_transfer_sync_pl(struct no_os_spi_desc *desc,
+					struct no_os_spi_msg *msgs,
+					uint32_t len)
+{
+	struct xspi_desc	*xdesc;
+	int32_t			ret;
+
+	ret = xil_spi_transfer_async_pl(desc, msgs, len, NULL, NULL);
+	if (ret)
+		return ret;
+
+	xdesc = desc->extra;
+	while (xdesc->xfer.busy)
+		;
 
 	return 0;
 }
@@ -527,7 +568,9 @@ const struct no_os_spi_platform_ops xil_spi_pl_ops = {
 	.init = xil_spi_init_pl,
 	.remove = xil_spi_remove_pl,
 	.write_and_read = xil_spi_write_and_read_pl,
-	.transfer = xil_spi_transfer_pl
+	.transfer = xil_spi_transfer_pl,
+	.dma_transfer_sync = xil_spi_transfer_sync_pl,
+	.dma_transfer_async = xil_spi_transfer_async_pl
 };
 
 #endif // XPAR_XSPI_NUM_INSTANCES
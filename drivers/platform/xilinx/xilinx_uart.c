@@ -78,8 +78,8 @@ static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
 		ret = no_os_irq_disable(irq_desc, xil_uart_desc->irq_id);
 		if (ret < 0)
 			return ret;
-		ret = no_os_fifo_insert(&xil_uart_desc->fifo, xil_uart_desc->buff,
-					xil_uart_desc->bytes_received);
+		ret = no_os_fifo_ring_insert(&xil_uart_desc->fifo, xil_uart_desc->buff,
+					     xil_uart_desc->bytes_received);
 		if (ret < 0)
 			return ret;
 		xil_uart_desc->bytes_received = 0;
@@ -123,20 +123,14 @@ static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 	switch(xil_uart_desc->type) {
 	case UART_PS:
 #ifdef XUARTPS_H
-		while (xil_uart_desc->fifo == NULL) {
+		while (!no_os_fifo_ring_len(&xil_uart_desc->fifo)) {
 			/* nothing in fifo, wait until something is received */
 			ret = uart_fifo_insert(desc);
 			if (ret < 0)
 				return ret;
 		}
 
-		*data = xil_uart_desc->fifo->data[xil_uart_desc->fifo_read_offset];
-		xil_uart_desc->fifo_read_offset++;
-
-		if (xil_uart_desc->fifo->len - xil_uart_desc->fifo_read_offset <= 0) {
-			xil_uart_desc->fifo_read_offset = 0;
-			xil_uart_desc->fifo = no_os_fifo_remove(xil_uart_desc->fifo);
-		}
+		no_os_fifo_ring_read(&xil_uart_desc->fifo, (char *)data, 1);
 #endif // XUARTPS_H
 		break;
 	case UART_PL:
@@ -429,6 +423,9 @@ static int32_t xil_uart_init(struct no_os_uart_desc **desc,
 		 */
 		XUartPs_SetRecvTimeout(xil_uart_desc->instance, 8);
 
+		no_os_fifo_ring_init(&xil_uart_desc->fifo, xil_uart_desc->fifo_buff,
+				     sizeof(xil_uart_desc->fifo_buff));
+
 		status = uart_irq_init(descriptor);
 		if (status != XST_SUCCESS)
 			goto error_free_instance;
@@ -44,6 +44,8 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include "no_os_fifo.h"
+
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
@@ -90,10 +92,10 @@ struct xil_uart_desc {
 	uint32_t			irq_id;
 	/** Interrupt Request Descriptor */
 	struct no_os_irq_ctrl_desc *irq_desc;
-	/** FIFO */
-	struct no_os_fifo_element	*fifo;
-	/** FIFO read offset */
-	uint32_t 			fifo_read_offset;
+	/** FIFO of received data not yet read */
+	struct no_os_fifo_ring		fifo;
+	/** FIFO storage */
+	char 				fifo_buff[UART_BUFF_LENGTH];
 	/** UART Buffer */
 	char 				buff[UART_BUFF_LENGTH];
 	/** Number of bytes received */
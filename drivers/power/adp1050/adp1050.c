@@ -43,6 +43,19 @@
 #include "no_os_delay.h"
 #include "no_os_error.h"
 
+/* Command and length of each value of a telemetry snapshot */
+static const uint8_t adp1050_telemetry_cmds[ADP1050_TLM_NB][2] = {
+	[ADP1050_TLM_VIN] = {ADP1050_READ_VIN, 2},
+	[ADP1050_TLM_IIN] = {ADP1050_READ_IIN, 2},
+	[ADP1050_TLM_VOUT] = {ADP1050_READ_VOUT, 2},
+	[ADP1050_TLM_TEMP] = {ADP1050_READ_TEMPERATURE, 2},
+	[ADP1050_TLM_STATUS_WORD] = {ADP1050_STATUS_WORD, 2},
+	[ADP1050_TLM_STATUS_VOUT] = {ADP1050_STATUS_VOUT, 1},
+	[ADP1050_TLM_STATUS_INPUT] = {ADP1050_STATUS_INPUT, 1},
+	[ADP1050_TLM_STATUS_TEMP] = {ADP1050_STATUS_TEMPERATURE, 1},
+	[ADP1050_TLM_STATUS_CML] = {ADP1050_STATUS_CML, 1},
+};
+
 /**
  * @brief Send command byte/word to ADP1050
  * @param desc - ADP1050 device descriptor
@@ -1191,3 +1204,51 @@ int adp1050_remove(struct adp1050_desc *desc)
 
 	return 0;
 }
+
+/**
+ * @brief Read all the telemetry of the ADP1050 in one I2C transfer, each
+ * 	  command joined to its read and to the next command by repeated
+ * 	  starts, for no_os_telemetry.
+ * @param dev - ADP1050 device descriptor
+ * @param vals - Values, indexed by enum adp1050_telemetry_val.
+ * @return 0 in case of succes, negative error code otherwise
+*/
+static int adp1050_telemetry_refresh(void *dev, int32_t *vals)
+{
+	struct adp1050_desc *desc = dev;
+	struct no_os_i2c_msg msgs[2 * ADP1050_TLM_NB];
+	uint8_t cmds[ADP1050_TLM_NB];
+	uint8_t data[ADP1050_TLM_NB][2];
+	unsigned int i;
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	for (i = 0; i < ADP1050_TLM_NB; i++) {
+		cmds[i] = adp1050_telemetry_cmds[i][0];
+		msgs[2 * i].buf = &cmds[i];
+		msgs[2 * i].len = 1;
+		msgs[2 * i].flags = 0;
+		msgs[2 * i + 1].buf = data[i];
+		msgs[2 * i + 1].len = adp1050_telemetry_cmds[i][1];
+		msgs[2 * i + 1].flags = NO_OS_I2C_M_RD;
+	}
+
+	ret = no_os_i2c_transfer(desc->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+	if (ret)
+		return ret;
+
+	for (i = 0; i < ADP1050_TLM_NB; i++) {
+		if (adp1050_telemetry_cmds[i][1] == 2)
+			vals[i] = no_os_get_unaligned_le16(data[i]);
+		else
+			vals[i] = data[i][0];
+	}
+
+	return 0;
+}
+
+const struct no_os_telemetry_ops adp1050_telemetry_ops = {
+	.refresh = adp1050_telemetry_refresh,
+};
@@ -47,6 +47,7 @@
 #include "no_os_pwm.h"
 #include "no_os_util.h"
 #include "no_os_units.h"
+#include "no_os_telemetry.h"
 
 #define ADP1050_EXTENDED_COMMAND		0xFF
 #define ADP1050_WRITE_BYTE_MAX_VAL		0xFF
@@ -539,6 +540,23 @@ enum adp1050_status_type {
 	ADP1050_STATUS_CML_TYPE = ADP1050_STATUS_CML
 };
 
+/**
+ * @brief Values of a telemetry snapshot: the READ_* words as read (LINEAR11,
+ * raw VS for VOUT) and the STATUS_* registers.
+*/
+enum adp1050_telemetry_val {
+	ADP1050_TLM_VIN,
+	ADP1050_TLM_IIN,
+	ADP1050_TLM_VOUT,
+	ADP1050_TLM_TEMP,
+	ADP1050_TLM_STATUS_WORD,
+	ADP1050_TLM_STATUS_VOUT,
+	ADP1050_TLM_STATUS_INPUT,
+	ADP1050_TLM_STATUS_TEMP,
+	ADP1050_TLM_STATUS_CML,
+	ADP1050_TLM_NB
+};
+
 enum adp1050_trim_type {
 	ADP1050_CS1_IIN_TRIM,
 	ADP1050_VS_VOUT_TRIM,
@@ -571,6 +589,9 @@ struct adp1050_desc {
 	enum adp1050_freq freq;
 };
 
+/** no_os_telemetry operations, all the values in one I2C transfer. */
+extern const struct no_os_telemetry_ops adp1050_telemetry_ops;
+
 /** Send command to ADP1050 device. */
 int adp1050_send_command(struct adp1050_desc *desc, uint16_t command);
 
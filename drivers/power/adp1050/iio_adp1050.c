@@ -527,6 +527,68 @@ static struct iio_device adp1050_iio_dev = {
 	.debug_attributes = adp1050_debug_attrs
 };
 
+/**
+ * @brief Get a telemetry value, from the snapshot if there is one.
+ * @param iio_adp1050 - The iio device structure.
+ * @param idx - The value to get.
+ * @param val - The value, as read from the device.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+static int adp1050_iio_telemetry_get(struct adp1050_iio_desc *iio_adp1050,
+				     enum adp1050_telemetry_val idx,
+				     uint16_t *val)
+{
+	struct adp1050_desc *adp1050 = iio_adp1050->adp1050_desc;
+	uint8_t exp;
+	int32_t tlm_val;
+	uint16_t mant;
+	int ret;
+
+	if (iio_adp1050->telemetry) {
+		ret = no_os_telemetry_get(iio_adp1050->telemetry, idx, &tlm_val);
+		if (ret)
+			return ret;
+
+		*val = tlm_val;
+
+		return 0;
+	}
+
+	switch (idx) {
+	case ADP1050_TLM_VIN:
+		ret = adp1050_read_value(adp1050, &mant, &exp, ADP1050_VIN);
+		break;
+	case ADP1050_TLM_IIN:
+		ret = adp1050_read_value(adp1050, &mant, &exp, ADP1050_IIN);
+		break;
+	case ADP1050_TLM_TEMP:
+		ret = adp1050_read_value(adp1050, &mant, &exp, ADP1050_TEMP);
+		break;
+	case ADP1050_TLM_VOUT:
+		return adp1050_read_vsense(adp1050, val);
+	case ADP1050_TLM_STATUS_WORD:
+		return adp1050_read_status(adp1050, ADP1050_STATUS_WORD_TYPE, val);
+	case ADP1050_TLM_STATUS_VOUT:
+		return adp1050_read_status(adp1050, ADP1050_STATUS_VOUT_TYPE, val);
+	case ADP1050_TLM_STATUS_INPUT:
+		return adp1050_read_status(adp1050, ADP1050_STATUS_INPUT_TYPE, val);
+	case ADP1050_TLM_STATUS_TEMP:
+		return adp1050_read_status(adp1050, ADP1050_STATUS_TEMPERATURE_TYPE,
+					   val);
+	case ADP1050_TLM_STATUS_CML:
+		return adp1050_read_status(adp1050, ADP1050_STATUS_CML_TYPE, val);
+	default:
+		return -EINVAL;
+	}
+	if (ret)
+		return ret;
+
+	*val = no_os_field_prep(ADP1050_EXP_MASK, exp) |
+	       no_os_field_prep(ADP1050_MANT_MASK, mant);
+
+	return 0;
+}
+
 /**
  * @brief Handles the read request for raw attribute.
  * @param dev     - The iio device structure.
@@ -542,26 +604,25 @@ static int adp1050_iio_read_raw(void *dev, char *buf, uint32_t len,
 				intptr_t priv)
 {
 	int ret;
-	uint16_t mant, val;
+	uint16_t mant, val, word;
 	uint8_t exp;
 	struct adp1050_iio_desc *iio_adp1050 = dev;
-	struct adp1050_desc *adp1050 = iio_adp1050->adp1050_desc;
 
 	switch (channel->address) {
 	case ADP1050_IIO_VIN_CHAN:
-		ret = adp1050_read_value(adp1050, &mant, &exp, ADP1050_VIN);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_VIN, &word);
 		break;
 	case ADP1050_IIO_IIN_CHAN:
-		ret = adp1050_read_value(adp1050, &mant, &exp, ADP1050_IIN);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_IIN, &word);
 		break;
 	case ADP1050_IIO_VOUT_CHAN:
-		ret = adp1050_read_vsense(adp1050, &mant);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_VOUT, &mant);
 		if (ret)
 			return ret;
 
 		return iio_format_value(buf, len, IIO_VAL_INT, 1,  (int32_t *)&mant);
 	case ADP1050_IIO_TEMP_CHAN:
-		ret = adp1050_read_value(adp1050, &mant, &exp, ADP1050_TEMP);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_TEMP, &word);
 		break;
 	default:
 		return -EINVAL;
@@ -570,6 +631,8 @@ static int adp1050_iio_read_raw(void *dev, char *buf, uint32_t len,
 	if (ret)
 		return ret;
 
+	mant = no_os_field_get(ADP1050_MANT_MASK, word);
+	exp = no_os_field_get(ADP1050_EXP_MASK, word);
 	val = no_os_field_get(ADP1050_EXP_MASK, exp) |
 	      no_os_field_get(ADP1050_MANT_MASK, mant);
 
@@ -591,19 +654,18 @@ static int adp1050_iio_read_scale(void *dev, char *buf, uint32_t len,
 				  intptr_t priv)
 {
 	int vals[2], ret;
-	uint16_t mant, exp;
+	uint16_t mant, exp, word;
 	struct adp1050_iio_desc *iio_adp1050 = dev;
-	struct adp1050_desc *adp1050 = iio_adp1050->adp1050_desc;
 
 	switch (channel->address) {
 	case ADP1050_IIO_VIN_CHAN:
-		ret = adp1050_read_value(adp1050, &mant, (uint8_t *)&exp, ADP1050_VIN);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_VIN, &word);
 		break;
 	case ADP1050_IIO_IIN_CHAN:
-		ret = adp1050_read_value(adp1050, &mant, (uint8_t *)&exp, ADP1050_IIN);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_IIN, &word);
 		break;
 	case ADP1050_IIO_VOUT_CHAN:
-		ret = adp1050_read_vsense(adp1050, &mant);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_VOUT, &mant);
 
 		vals[0] = mant;
 		vals[1] = 10;
@@ -611,12 +673,16 @@ static int adp1050_iio_read_scale(void *dev, char *buf, uint32_t len,
 		return iio_format_value(buf, len, IIO_VAL_FRACTIONAL_LOG2, 2,
 					(int32_t *)vals);
 	case ADP1050_IIO_TEMP_CHAN:
-		ret = adp1050_read_value(adp1050, &mant, (uint8_t *)&exp, ADP1050_TEMP);
+		ret = adp1050_iio_telemetry_get(iio_adp1050, ADP1050_TLM_TEMP, &word);
 		break;
+	default:
+		return -EINVAL;
 	}
 	if (ret)
 		return ret;
 
+	mant = no_os_field_get(ADP1050_MANT_MASK, word);
+	exp = no_os_field_get(ADP1050_EXP_MASK, word);
 	vals[0] = no_os_sign_extend16(mant, 10);
 	vals[1] = no_os_sign_extend16(exp, 4) * (-1);
 
@@ -640,9 +706,29 @@ static int adp1050_iio_read_status(void *dev, char *buf, uint32_t len,
 	int ret;
 	uint16_t status;
 	struct adp1050_iio_desc *iio_adp1050 = dev;
-	struct adp1050_desc *adp1050 = iio_adp1050->adp1050_desc;
+	enum adp1050_telemetry_val idx;
 
-	ret = adp1050_read_status(adp1050, priv, &status);
+	switch (priv) {
+	case ADP1050_STATUS_VOUT_TYPE:
+		idx = ADP1050_TLM_STATUS_VOUT;
+		break;
+	case ADP1050_STATUS_INPUT_TYPE:
+		idx = ADP1050_TLM_STATUS_INPUT;
+		break;
+	case ADP1050_STATUS_TEMPERATURE_TYPE:
+		idx = ADP1050_TLM_STATUS_TEMP;
+		break;
+	case ADP1050_STATUS_CML_TYPE:
+		idx = ADP1050_TLM_STATUS_CML;
+		break;
+	case ADP1050_STATUS_WORD_TYPE:
+		idx = ADP1050_TLM_STATUS_WORD;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	ret = adp1050_iio_telemetry_get(iio_adp1050, idx, &status);
 	if (ret)
 		return ret;
 
@@ -1255,6 +1341,24 @@ int adp1050_iio_init(struct adp1050_iio_desc **iio_desc,
 	if (ret)
 		goto free_desc;
 
+	if (init_param->telemetry) {
+		struct no_os_telemetry_init_param tlm_param = {
+			.ops = &adp1050_telemetry_ops,
+			.dev = descriptor->adp1050_desc,
+			.nb_vals = ADP1050_TLM_NB,
+			.wq = init_param->telemetry_wq,
+		};
+
+		ret = no_os_telemetry_init(&descriptor->telemetry, &tlm_param);
+		if (ret)
+			goto free_desc;
+
+		/* Publish a first snapshot before the attributes are read */
+		ret = no_os_telemetry_refresh(descriptor->telemetry);
+		if (ret)
+			goto free_desc;
+	}
+
 	descriptor->iio_dev = &adp1050_iio_dev;
 
 	*iio_desc = descriptor;
@@ -1277,7 +1381,8 @@ int adp1050_iio_remove(struct adp1050_iio_desc *iio_desc)
 	if (!iio_desc)
 		return -ENODEV;
 
-	no_os_free(iio_desc->iio_dev->channels);
+	no_os_free((void *)iio_desc->iio_dev->channels);
+	no_os_telemetry_remove(iio_desc->telemetry);
 	adp1050_remove(iio_desc->adp1050_desc);
 	no_os_free(iio_desc);
 
@@ -42,6 +42,7 @@
 #include <stdbool.h>
 #include "iio.h"
 #include "adp1050.h"
+#include "no_os_telemetry.h"
 
 /**
  * @brief Structure holding the ADP1050 IIO device descriptor
@@ -49,6 +50,8 @@
 struct adp1050_iio_desc {
 	struct adp1050_desc *adp1050_desc;
 	struct iio_device *iio_dev;
+	/** Snapshot serving the telemetry attributes, NULL to read the device */
+	struct no_os_telemetry *telemetry;
 };
 
 /**
@@ -59,6 +62,14 @@ struct adp1050_iio_desc_init_param {
 	uint16_t vout_scale_monitor;
 	uint16_t vin_scale_monitor;
 	uint16_t iin_scale_monitor;
+	/**
+	 * Serve raw, scale and status from a snapshot refreshed by
+	 * no_os_telemetry_refresh() or no_os_telemetry_schedule(), so that
+	 * polling the attributes causes no bus traffic.
+	 */
+	bool telemetry;
+	/** Optional, work queue of no_os_telemetry_schedule() */
+	struct no_os_workqueue *telemetry_wq;
 };
 
 /** Initializes the ADP1050 IIO descriptor. */
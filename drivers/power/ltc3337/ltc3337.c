@@ -500,6 +500,58 @@ int ltc3337_calculate_charge_register(struct ltc3337_dev* dev,
 	return 0;
 }
 
+/**
+ * Reads registers B to G in one I2C transfer, each register address joined
+ * to its read and to the next address by repeated starts, for
+ * no_os_telemetry.
+ * @param dev - Device to read from
+ * @param vals - Values, indexed by enum ltc3337_telemetry_val
+ * @returns 0 on success, Non-0 on error
+ */
+static int ltc3337_telemetry_refresh(void* dev, int32_t* vals)
+{
+	struct ltc3337_dev* ltc = dev;
+	struct no_os_i2c_msg msgs[2 * (LTC3337_REG_G - LTC3337_REG_B + 1)];
+	uint8_t regs[LTC3337_REG_G - LTC3337_REG_B + 1];
+	uint8_t data[LTC3337_REG_G - LTC3337_REG_B + 1][2];
+	uint16_t reg_c;
+	int i, ret;
+
+	if(!ltc)
+		return -EINVAL;
+
+	for(i = 0; i < LTC3337_REG_G - LTC3337_REG_B + 1; i++) {
+		regs[i] = LTC3337_REG_B + i;
+		msgs[2 * i].buf = &regs[i];
+		msgs[2 * i].len = 1;
+		msgs[2 * i].flags = 0;
+		msgs[2 * i + 1].buf = data[i];
+		msgs[2 * i + 1].len = 2;
+		msgs[2 * i + 1].flags = NO_OS_I2C_M_RD;
+	}
+
+	ret = no_os_i2c_transfer(ltc->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+	if(ret)
+		return ret;
+
+	//Data comes Little Endian, registers B to G in order
+	vals[LTC3337_TLM_CHARGE] = no_os_get_unaligned_le16(data[0]);
+	reg_c = no_os_get_unaligned_le16(data[1]);
+	vals[LTC3337_TLM_STATUS] = reg_c;
+	vals[LTC3337_TLM_TEMP_C] = ltc3337_temp_reg_to_c(
+					   no_os_field_get(LTC3337_RC_DIE_TEMP_MSK, reg_c));
+	for(i = 0; i < 4; i++)
+		vals[LTC3337_TLM_BAT_IN_IPEAK_ON_MV + i] = ltc3337_vbat_to_mv(
+					no_os_field_get(LTC3337_BATV_MSK,
+							no_os_get_unaligned_le16(data[2 + i])));
+
+	return 0;
+}
+
+const struct no_os_telemetry_ops ltc3337_telemetry_ops = {
+	.refresh = ltc3337_telemetry_refresh,
+};
+
 /**
  * Reads a register from the device.
  * @param dev - Device instance
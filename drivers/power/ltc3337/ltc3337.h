@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include "no_os_util.h"
 #include "no_os_i2c.h"
+#include "no_os_telemetry.h"
 
 #define LTC3337_I2C_ADDR			0x64 // b1100100[r/w] 0xC8, 0xC9
 
@@ -136,6 +137,23 @@ enum ltc3337_voltage_src_t {
 	BAT_OUT_IPEAK_OFF
 };
 
+/**
+ * Values of a telemetry snapshot, read from registers B to G in one transfer
+ */
+enum ltc3337_telemetry_val {
+	LTC3337_TLM_CHARGE,		//Accumulated charge register
+	LTC3337_TLM_STATUS,		//Register C, interrupts are not cleared
+	LTC3337_TLM_TEMP_C,		//Die temperature, in Deg C
+	LTC3337_TLM_BAT_IN_IPEAK_ON_MV,	//Voltages, in mV
+	LTC3337_TLM_BAT_IN_IPEAK_OFF_MV,
+	LTC3337_TLM_BAT_OUT_IPEAK_ON_MV,
+	LTC3337_TLM_BAT_OUT_IPEAK_OFF_MV,
+	LTC3337_TLM_NB
+};
+
+/* no_os_telemetry operations */
+extern const struct no_os_telemetry_ops ltc3337_telemetry_ops;
+
 /* Initializes the device instance */
 int ltc3337_init(struct ltc3337_dev** dev,
 		 struct ltc3337_init_param* init_param);
@@ -225,6 +225,48 @@ int ltc3350_get_vcap(struct ltc3350_dev *dev, uint8_t n_cap, uint16_t *value)
 
 }
 
+/***************************************************************************//**
+ * @brief Reads the status and measurement registers in one I2C transfer, each
+ *        register address joined to its read and to the next address by
+ *        repeated starts, for no_os_telemetry.
+ *
+ * @param dev          	- The device structure.
+ * @param vals	 	- Values, indexed by enum ltc3350_telemetry_val.
+ *
+ * @return ret         	- Result of the reading procedure.
+*******************************************************************************/
+static int ltc3350_telemetry_refresh(void *dev, int32_t *vals)
+{
+	struct ltc3350_dev *ltc3350 = dev;
+	struct no_os_i2c_msg msgs[2 * LTC3350_TLM_NB];
+	uint8_t regs[LTC3350_TLM_NB];
+	uint8_t rx_buff[LTC3350_TLM_NB][2];
+	int i, ret;
+
+	for (i = 0; i < LTC3350_TLM_NB; i++) {
+		regs[i] = LTC3350_AD_CHRG_STATUS + i;
+		msgs[2 * i].buf = &regs[i];
+		msgs[2 * i].len = 1;
+		msgs[2 * i].flags = 0;
+		msgs[2 * i + 1].buf = rx_buff[i];
+		msgs[2 * i + 1].len = 2;
+		msgs[2 * i + 1].flags = NO_OS_I2C_M_RD;
+	}
+
+	ret = no_os_i2c_transfer(ltc3350->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+	if (ret)
+		return ret;
+
+	for (i = 0; i < LTC3350_TLM_NB; i++)
+		vals[i] = (rx_buff[i][1] << 8) | rx_buff[i][0];
+
+	return 0;
+}
+
+const struct no_os_telemetry_ops ltc3350_telemetry_ops = {
+	.refresh = ltc3350_telemetry_refresh,
+};
+
 #endif
 
 #if LTC3350_USE_ALARMS
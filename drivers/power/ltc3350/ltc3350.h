@@ -49,6 +49,7 @@
 #include <string.h>
 #include "no_os_util.h"
 #include "no_os_i2c.h"
+#include "no_os_telemetry.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -162,6 +163,27 @@ enum ltc3350_enum_alarms_mask {
 	LTC3350_CAP_LO_LVL_BIT        = NO_OS_BIT(15)
 };
 
+/*LTC3350 telemetry snapshot values, registers 0x1B to 0x2A as read*/
+enum ltc3350_telemetry_val {
+	LTC3350_TLM_CHRG_STATUS       = 0,
+	LTC3350_TLM_MON_STATUS        = 1,
+	LTC3350_TLM_ALARM             = 2,
+	LTC3350_TLM_MEAS_CAP          = 3,
+	LTC3350_TLM_MEAS_ESR          = 4,
+	LTC3350_TLM_MEAS_VCAP1        = 5,
+	LTC3350_TLM_MEAS_VCAP2        = 6,
+	LTC3350_TLM_MEAS_VCAP3        = 7,
+	LTC3350_TLM_MEAS_VCAP4        = 8,
+	LTC3350_TLM_MEAS_GPI          = 9,
+	LTC3350_TLM_MEAS_VIN          = 10,
+	LTC3350_TLM_MEAS_VCAP         = 11,
+	LTC3350_TLM_MEAS_VOUT         = 12,
+	LTC3350_TLM_MEAS_IIN          = 13,
+	LTC3350_TLM_MEAS_ICHG         = 14,
+	LTC3350_TLM_MEAS_DTEMP        = 15,
+	LTC3350_TLM_NB
+};
+
 /**
  * @brief Structure holding the parameters for LTC3350 device initialization.
  * @struct ltc3350_init_param
@@ -213,6 +235,9 @@ int ltc3350_get_esr(struct ltc3350_dev *dev, uint16_t *value);
 /*! Reads the Vcap data for selected n_cap, 0 for generic. */
 int ltc3350_get_vcap(struct ltc3350_dev *dev, uint8_t n_cap, uint16_t *value);
 
+/*! no_os_telemetry operations, the status and measurements in one transfer. */
+extern const struct no_os_telemetry_ops ltc3350_telemetry_ops;
+
 #endif
 
 /* LTC3350_USE_ALARMS == 0 */
@@ -38,6 +38,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <stdlib.h>
+#include <string.h>
 #include "ad2s1210.h"
 #include "no_os_util.h"
 #include "no_os_error.h"
@@ -65,6 +66,9 @@ int ad2s1210_reg_write(struct ad2s1210_dev *dev, uint8_t addr, uint8_t val)
 	if (addr < AD2S1210_REG_MIN)
 		return -EINVAL;
 
+	if (dev->stream)
+		return -EBUSY;
+
 	ret = ad2s1210_set_mode_pins(dev, MODE_CONFIG);
 	if (ret)
 		return ret;
@@ -95,6 +99,9 @@ int ad2s1210_reg_read(struct ad2s1210_dev *dev, uint8_t addr, uint8_t *val)
 	if (addr < AD2S1210_REG_MIN)
 		return -EINVAL;
 
+	if (dev->stream)
+		return -EBUSY;
+
 	ret = ad2s1210_set_mode_pins(dev, MODE_CONFIG);
 	if (ret)
 		return ret;
@@ -462,6 +469,9 @@ int ad2s1210_spi_single_conversion(struct ad2s1210_dev *dev,
 	if (size < 2)
 		return -EINVAL;
 
+	if (dev->stream)
+		return -EBUSY;
+
 	if ((size < 4) && (active_mask & AD2S1210_POS_MASK)
 	    && (active_mask & AD2S1210_POS_MASK))
 		return -EINVAL;
@@ -489,6 +499,324 @@ int ad2s1210_spi_single_conversion(struct ad2s1210_dev *dev,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Publishes a sample, lock free for the readers of the latest one.
+ *
+ * @param dev - The device structure.
+ * @param raw - Big endian words of the active channels.
+ * @param fault - Fault register.
+*******************************************************************************/
+static void ad2s1210_stream_publish(struct ad2s1210_dev *dev,
+				    uint8_t *raw, uint8_t fault)
+{
+	struct ad2s1210_stream *s = dev->stream;
+	struct ad2s1210_sample *l = &s->latest;
+	uint32_t seq = s->seq;
+	uint16_t position = l->position;
+	int16_t velocity = 0;
+	uint32_t nb_words = 0;
+
+	if (s->active_mask & AD2S1210_POS_MASK)
+		position = no_os_get_unaligned_be16(raw + 2 *
+						    nb_words++);
+	if (s->active_mask & AD2S1210_VEL_MASK)
+		velocity = (int16_t)no_os_get_unaligned_be16(raw +
+				2 * nb_words++);
+
+	/* Readers retry while seq is odd or changed under them. */
+	__atomic_store_n(&s->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	l->pos_delta = l->count ? (int16_t)(position - l->position) : 0;
+	l->position = position;
+	l->velocity = velocity;
+	l->fault = fault;
+	l->count++;
+	__atomic_store_n(&s->seq, seq + 2, __ATOMIC_RELEASE);
+
+	if (s->buf)
+		no_os_cb_write(s->buf, raw, 2 * nb_words);
+}
+
+/***************************************************************************//**
+ * @brief Called when the read of a tick is done, in interrupt context.
+ *
+ * @param ctx - The device structure.
+*******************************************************************************/
+static void ad2s1210_stream_done(void *ctx)
+{
+	struct ad2s1210_dev *dev = ctx;
+	struct ad2s1210_stream *s = dev->stream;
+	uint8_t raw[4];
+	uint32_t i, n;
+
+	if (!dev->have_mode_pins) {
+		/* Each frame returns the register addressed by the previous one. */
+		n = s->nb_msgs - 2;
+		memcpy(raw, &s->rx[1], n);
+		ad2s1210_stream_publish(dev, raw, s->rx[n + 1]);
+		s->busy = false;
+		return;
+	}
+
+	/*
+	 * In normal mode a 24 bit frame is the channel selected by A0/A1
+	 * followed by the fault register. Switch to velocity after position,
+	 * the SAMPLE pulse latched both.
+	 */
+	if (s->chn == AD2S1210_POS && (s->active_mask & AD2S1210_VEL_MASK)) {
+		s->chn = AD2S1210_VEL;
+		s->msgs[0].rx_buff = &s->rx[3];
+		if (!ad2s1210_set_mode_pins(dev, MODE_VEL) &&
+		    !no_os_spi_transfer_dma_async(dev->spi_desc, s->msgs, 1,
+						  ad2s1210_stream_done, dev))
+			return;
+		s->busy = false;
+		return;
+	}
+
+	n = 0;
+	for (i = 0; i < 2; i++) {
+		if (!(s->active_mask & NO_OS_BIT(i)))
+			continue;
+		raw[n++] = s->rx[3 * i];
+		raw[n++] = s->rx[3 * i + 1];
+	}
+	ad2s1210_stream_publish(dev, raw, s->rx[2] | s->rx[5]);
+	s->busy = false;
+}
+
+/***************************************************************************//**
+ * @brief Starts timer paced acquisition.
+ *
+ * Each tick, the PWM pulse finished interrupt or any timer interrupt, must
+ * call ad2s1210_stream_trigger(). It latches position and velocity with a
+ * SAMPLE pulse, unless the PWM already drives SAMPLE, and reads the active
+ * channels and the fault register by DMA. The control loop then gets the
+ * latest sample with ad2s1210_stream_get_latest(), without using the bus.
+ *
+ * Register accesses and single conversions return -EBUSY while streaming.
+ *
+ * @param dev - The device structure.
+ * @param param - The stream parameters.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad2s1210_stream_start(struct ad2s1210_dev *dev,
+			  struct ad2s1210_stream_init_param *param)
+{
+	struct no_os_pwm_init_param pwm_param;
+	struct ad2s1210_stream *s;
+	uint32_t period_ns, i, n = 0;
+	int ret;
+
+	if (!dev || dev->stream || !param || !param->active_mask ||
+	    (param->active_mask & ~(AD2S1210_POS_MASK | AD2S1210_VEL_MASK)))
+		return -EINVAL;
+
+	if (!param->sample_pwm_init && !dev->gpio_sample)
+		return -EINVAL;
+
+	s = no_os_calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	s->active_mask = param->active_mask;
+	s->buf = param->buf;
+
+	if (dev->have_mode_pins) {
+		s->chn = (s->active_mask & AD2S1210_POS_MASK) ? AD2S1210_POS :
+			 AD2S1210_VEL;
+		ret = ad2s1210_set_mode_pins(dev, s->chn == AD2S1210_POS ?
+					     MODE_POS : MODE_VEL);
+		if (ret)
+			goto free_stream;
+
+		s->msgs[0].bytes_number = 3;
+		s->msgs[0].cs_change = 1;
+		s->nb_msgs = 1;
+	} else {
+		if (s->active_mask & AD2S1210_POS_MASK) {
+			s->tx[n++] = AD2S1210_REG_POSITION;
+			s->tx[n++] = AD2S1210_REG_POSITION + 1;
+		}
+		if (s->active_mask & AD2S1210_VEL_MASK) {
+			s->tx[n++] = AD2S1210_REG_VELOCITY;
+			s->tx[n++] = AD2S1210_REG_VELOCITY + 1;
+		}
+		/* The last frame keeps a valid address on SDI. */
+		s->tx[n++] = AD2S1210_REG_FAULT;
+		s->tx[n++] = AD2S1210_REG_FAULT;
+
+		for (i = 0; i < n; i++) {
+			s->msgs[i].tx_buff = &s->tx[i];
+			s->msgs[i].rx_buff = &s->rx[i];
+			s->msgs[i].bytes_number = 1;
+			s->msgs[i].cs_change = 1;
+		}
+		s->nb_msgs = n;
+	}
+
+	if (param->sample_pwm_init) {
+		if (!param->sample_rate_hz) {
+			ret = -EINVAL;
+			goto free_stream;
+		}
+
+		period_ns = NO_OS_DIV_ROUND_CLOSEST(1000000000,
+						    param->sample_rate_hz);
+		if (period_ns <= AD2S1210_SAMPLE_PULSE_NS) {
+			ret = -EINVAL;
+			goto free_stream;
+		}
+
+		pwm_param = *param->sample_pwm_init;
+		pwm_param.period_ns = period_ns;
+		pwm_param.duty_cycle_ns = AD2S1210_SAMPLE_PULSE_NS;
+		pwm_param.polarity = NO_OS_PWM_POLARITY_LOW;
+		ret = no_os_pwm_init(&s->sample_pwm, &pwm_param);
+		if (ret)
+			goto free_stream;
+	}
+
+	dev->stream = s;
+
+	if (s->sample_pwm) {
+		ret = no_os_pwm_enable(s->sample_pwm);
+		if (ret)
+			goto remove_pwm;
+	}
+
+	return 0;
+
+remove_pwm:
+	dev->stream = NULL;
+	no_os_pwm_remove(s->sample_pwm);
+free_stream:
+	no_os_free(s);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Reads the latched sample, called on each tick. The read runs by DMA,
+ *        the call returns as soon as it is started.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, -EBUSY if the tick was dropped because the
+ *         previous read is still in flight, negative error code otherwise.
+*******************************************************************************/
+int ad2s1210_stream_trigger(struct ad2s1210_dev *dev)
+{
+	struct ad2s1210_stream *s;
+	int ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	s = dev->stream;
+	if (s->busy) {
+		s->overruns++;
+		return -EBUSY;
+	}
+
+	if (!s->sample_pwm) {
+		ret = no_os_gpio_set_value(dev->gpio_sample, NO_OS_GPIO_LOW);
+		if (ret)
+			return ret;
+
+		ret = no_os_gpio_set_value(dev->gpio_sample, NO_OS_GPIO_HIGH);
+		if (ret)
+			return ret;
+	}
+
+	if (dev->have_mode_pins) {
+		s->chn = (s->active_mask & AD2S1210_POS_MASK) ? AD2S1210_POS :
+			 AD2S1210_VEL;
+		ret = ad2s1210_set_mode_pins(dev, s->chn == AD2S1210_POS ?
+					     MODE_POS : MODE_VEL);
+		if (ret)
+			return ret;
+
+		s->msgs[0].rx_buff = &s->rx[s->chn == AD2S1210_POS ? 0 : 3];
+	}
+
+	s->busy = true;
+	ret = no_os_spi_transfer_dma_async(dev->spi_desc, s->msgs, s->nb_msgs,
+					   ad2s1210_stream_done, dev);
+	if (ret)
+		s->busy = false;
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Gets the latest sample without using the bus. Safe to call from any
+ *        context, including one preempted by the read completion.
+ *
+ * @param dev - The device structure.
+ * @param sample - Latest sample.
+ *
+ * @return 0 in case of success, -EAGAIN if no sample was read yet, negative
+ *         error code otherwise.
+*******************************************************************************/
+int ad2s1210_stream_get_latest(struct ad2s1210_dev *dev,
+			       struct ad2s1210_sample *sample)
+{
+	struct ad2s1210_stream *s;
+	uint32_t seq;
+
+	if (!dev || !dev->stream || !sample)
+		return -EINVAL;
+
+	s = dev->stream;
+	do {
+		seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+		*sample = s->latest;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while ((seq & 1) || seq != __atomic_load_n(&s->seq, __ATOMIC_RELAXED));
+
+	return sample->count ? 0 : -EAGAIN;
+}
+
+/***************************************************************************//**
+ * @brief Stops timer paced acquisition.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad2s1210_stream_stop(struct ad2s1210_dev *dev)
+{
+	struct ad2s1210_stream *s;
+	uint32_t timeout = 10000;
+	int ret;
+
+	if (!dev || !dev->stream)
+		return -EINVAL;
+
+	s = dev->stream;
+	if (s->sample_pwm) {
+		ret = no_os_pwm_disable(s->sample_pwm);
+		if (ret)
+			return ret;
+	}
+
+	while (s->busy && --timeout)
+		no_os_udelay(1);
+
+	if (s->sample_pwm) {
+		ret = no_os_pwm_remove(s->sample_pwm);
+		if (ret)
+			return ret;
+	}
+
+	dev->stream = NULL;
+	no_os_free(s);
+
+	return timeout ? 0 : -ETIMEDOUT;
+}
+
 /***************************************************************************//**
  * @brief Remove the driver's descriptor by freeing the associated resources.
  *
@@ -505,6 +833,12 @@ int ad2s1210_remove(struct ad2s1210_dev *dev)
 	if (!dev)
 		return -EINVAL;
 
+	if (dev->stream) {
+		ret = ad2s1210_stream_stop(dev);
+		if (ret)
+			return ret;
+	}
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		return ret;
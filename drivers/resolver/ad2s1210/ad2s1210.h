@@ -44,6 +44,8 @@
 #include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_pwm.h"
+#include "no_os_circular_buffer.h"
 
 #define AD2S1210_REG_POSITION		0x80
 #define AD2S1210_REG_VELOCITY		0x82
@@ -77,6 +79,11 @@
 #define AD2S1210_POS_MASK	NO_OS_BIT(0)
 #define AD2S1210_VEL_MASK	NO_OS_BIT(1)
 
+/* SAMPLE low time when driven by a PWM, above t16 for the slowest CLKIN */
+#define AD2S1210_SAMPLE_PULSE_NS	500
+/* Single byte frames of a streaming read in configuration mode */
+#define AD2S1210_STREAM_MAX_MSGS	6
+
 enum ad2s1210_mode {
 	MODE_POS,
 	MODE_RESERVED,
@@ -107,6 +114,75 @@ struct ad2s1210_init_param {
 	uint32_t clkin_hz;
 };
 
+/**
+ * @struct ad2s1210_sample
+ * @brief Latest result of a streaming acquisition
+ */
+struct ad2s1210_sample {
+	/** Angular position, MSB aligned */
+	uint16_t position;
+	/** Angular velocity, two's complement MSB aligned, 0 if not read */
+	int16_t velocity;
+	/** Position change since the previous sample, MSB aligned */
+	int16_t pos_delta;
+	/** Fault register */
+	uint8_t fault;
+	/** Number of samples since the stream started, including this one */
+	uint32_t count;
+};
+
+/**
+ * @struct ad2s1210_stream_init_param
+ * @brief Parameters of a timer paced acquisition
+ */
+struct ad2s1210_stream_init_param {
+	/**
+	 * PWM wired to SAMPLE. Its period and duty cycle are set from
+	 * sample_rate_hz. NULL to pulse the SAMPLE GPIO on each tick instead.
+	 */
+	struct no_os_pwm_init_param *sample_pwm_init;
+	/** Sample rate, in Hz. Only used with sample_pwm_init */
+	uint32_t sample_rate_hz;
+	/** Channels read on each tick, AD2S1210_POS_MASK and AD2S1210_VEL_MASK */
+	uint32_t active_mask;
+	/**
+	 * Optional buffer, e.g. of an IIO device, receiving every sample in
+	 * the ad2s1210_spi_single_conversion() layout
+	 */
+	struct no_os_circular_buffer *buf;
+};
+
+/**
+ * @struct ad2s1210_stream
+ * @brief Timer paced acquisition descriptor
+ */
+struct ad2s1210_stream {
+	/** PWM driving SAMPLE, NULL if SAMPLE is pulsed by the tick */
+	struct no_os_pwm_desc *sample_pwm;
+	/** Messages of one read */
+	struct no_os_spi_msg msgs[AD2S1210_STREAM_MAX_MSGS];
+	/** Number of messages of one read */
+	uint32_t nb_msgs;
+	/** Addresses clocked out in configuration mode */
+	uint8_t tx[AD2S1210_STREAM_MAX_MSGS];
+	/** Received bytes */
+	uint8_t rx[AD2S1210_STREAM_MAX_MSGS];
+	/** Channels read on each tick */
+	uint32_t active_mask;
+	/** Channel being read when the mode pins select it */
+	enum ad2s1210_channel chn;
+	/** Buffer receiving every sample, may be NULL */
+	struct no_os_circular_buffer *buf;
+	/** Set while a read is in flight */
+	volatile bool busy;
+	/** Odd while latest is being updated */
+	volatile uint32_t seq;
+	/** Latest sample, read with ad2s1210_stream_get_latest() */
+	struct ad2s1210_sample latest;
+	/** Number of ticks dropped because a read was still in flight */
+	uint32_t overruns;
+};
+
 struct ad2s1210_dev {
 	const char *name;
 	bool have_mode_pins;
@@ -120,6 +196,8 @@ struct ad2s1210_dev {
 	struct no_os_gpio_desc *gpio_res1;
 	struct no_os_gpio_desc *gpio_sample;
 	uint32_t clkin_hz;
+	/* Timer paced acquisition, NULL when not running */
+	struct ad2s1210_stream *stream;
 };
 
 int ad2s1210_init(struct ad2s1210_dev **dev,
@@ -138,4 +216,10 @@ int ad2s1210_reinit_excitation_frequency(struct ad2s1210_dev *dev,
 		uint16_t fexcit);
 int ad2s1210_get_excitation_frequency(struct ad2s1210_dev *dev,
 				      uint16_t *fexcit);
+int ad2s1210_stream_start(struct ad2s1210_dev *dev,
+			  struct ad2s1210_stream_init_param *param);
+int ad2s1210_stream_trigger(struct ad2s1210_dev *dev);
+int ad2s1210_stream_get_latest(struct ad2s1210_dev *dev,
+			       struct ad2s1210_sample *sample);
+int ad2s1210_stream_stop(struct ad2s1210_dev *dev);
 #endif
@@ -43,6 +43,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <inttypes.h>
 #include "ad9361.h"
@@ -5038,22 +5039,19 @@ int32_t ad9361_fastlock_load(struct ad9361_rf_phy *phy, bool tx,
 }
 
 /**
- * Fastlock store.
+ * Fastlock get current. Build the fastlock profile values of the current
+ * synthesizer state, without loading them in a profile.
  * @param phy The AD9361 state structure.
  * @param tx
- * @param profile
+ * @param val Buffer of RX_FAST_LOCK_CONFIG_WORD_NUM values.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_fastlock_store(struct ad9361_rf_phy *phy, bool tx,
-			      uint32_t profile)
+int32_t ad9361_fastlock_get_current(struct ad9361_rf_phy *phy, bool tx,
+				    uint8_t *val)
 {
 	struct no_os_spi_desc *spi = phy->spi;
-	uint8_t val[16];
 	uint32_t offs = 0, x, y;
 
-	dev_dbg(&phy->spi->dev, "%s: %s Profile %"PRIu32":",
-		__func__, tx ? "TX" : "RX", profile);
-
 	if (tx)
 		offs = REG_TX_FAST_LOCK_SETUP - REG_RX_FAST_LOCK_SETUP;
 
@@ -5105,6 +5103,26 @@ int32_t ad9361_fastlock_store(struct ad9361_rf_phy *phy, bool tx,
 	y = ad9361_spi_readf(spi, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE);
 	val[15] = (x << 1) | y;
 
+	return 0;
+}
+
+/**
+ * Fastlock store.
+ * @param phy The AD9361 state structure.
+ * @param tx
+ * @param profile
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_fastlock_store(struct ad9361_rf_phy *phy, bool tx,
+			      uint32_t profile)
+{
+	uint8_t val[RX_FAST_LOCK_CONFIG_WORD_NUM];
+
+	dev_dbg(&phy->spi->dev, "%s: %s Profile %"PRIu32":",
+		__func__, tx ? "TX" : "RX", profile);
+
+	ad9361_fastlock_get_current(phy, tx, val);
+
 	return ad9361_fastlock_load(phy, tx, profile, val);
 }
 
@@ -5244,6 +5262,179 @@ int32_t ad9361_fastlock_save(struct ad9361_rf_phy *phy, bool tx,
 	return 0;
 }
 
+/* Setup registers written by the BB DC offset and TX quadrature calibrations */
+static const uint16_t ad9361_cal_state_cfg_regs[] = {
+	REG_BB_DC_OFFSET_COUNT,
+	REG_BB_DC_OFFSET_SHIFT,
+	REG_BB_DC_OFFSET_ATTEN,
+	REG_KEXP_1,
+	REG_KEXP_2,
+	REG_QUAD_CAL_COUNT,
+	REG_MAG_FTEST_THRESH,
+	REG_MAG_FTEST_THRESH_2,
+	REG_TX_QUAD_FULL_LMT_GAIN,
+	REG_QUAD_SETTLE_COUNT,
+	REG_TX_QUAD_LPF_GAIN,
+};
+
+/**
+ * Get the register holding the calibration state byte at a given index.
+ * The setup registers come first, followed by the TX quadrature corrections,
+ * the RX quadrature corrections and the BB DC offset words.
+ * @param idx Index in ad9361_cal_state.regs.
+ * @return The register address.
+ */
+static uint32_t ad9361_cal_state_reg(uint32_t idx)
+{
+	if (idx < NO_OS_ARRAY_SIZE(ad9361_cal_state_cfg_regs))
+		return ad9361_cal_state_cfg_regs[idx];
+
+	idx -= NO_OS_ARRAY_SIZE(ad9361_cal_state_cfg_regs);
+	if (idx <= REG_TX2_OUT_2_OFFSET_Q - REG_TX1_OUT_1_PHASE_CORR)
+		return REG_TX1_OUT_1_PHASE_CORR + idx;
+
+	idx -= REG_TX2_OUT_2_OFFSET_Q - REG_TX1_OUT_1_PHASE_CORR + 1;
+	if (idx <= REG_RX2_INPUT_BC_I_OFFSET - REG_RX1_INPUT_A_PHASE_CORR)
+		return REG_RX1_INPUT_A_PHASE_CORR + idx;
+
+	idx -= REG_RX2_INPUT_BC_I_OFFSET - REG_RX1_INPUT_A_PHASE_CORR + 1;
+
+	return REG_RX1_BB_DC_WORD_I_MSB + idx;
+}
+
+/**
+ * Compute the checksum of a calibration state.
+ * @param state The calibration state.
+ * @return The checksum of all the fields preceding the checksum field.
+ */
+static uint32_t ad9361_cal_state_checksum(const struct ad9361_cal_state *state)
+{
+	const uint8_t *buf = (const uint8_t *)state;
+	uint32_t sum1 = 0xFFFF, sum2 = 0xFFFF;
+	uint32_t i;
+
+	for (i = 0; i < offsetof(struct ad9361_cal_state, checksum); i++) {
+		sum1 = (sum1 + buf[i]) % 65535;
+		sum2 = (sum2 + sum1) % 65535;
+	}
+
+	return (sum2 << 16) | sum1;
+}
+
+/**
+ * Export the results of the last calibrations.
+ * Call it after a successful initialization, store the state to non volatile
+ * memory and pass it back through the cal_state initialization parameter on
+ * the next boot to skip the BB DC offset and TX quadrature calibrations.
+ * @param phy The AD9361 state structure.
+ * @param state The calibration state to be filled.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_cal_state_save(struct ad9361_rf_phy *phy,
+			      struct ad9361_cal_state *state)
+{
+	int32_t ret;
+	uint32_t i;
+
+	memset(state, 0, sizeof(*state));
+
+	ret = ad9361_spi_read(phy->spi, REG_PRODUCT_ID);
+	if (ret < 0)
+		return ret;
+	state->product_id = ret;
+
+	for (i = 0; i < AD9361_CAL_STATE_NUM_REGS; i++) {
+		ret = ad9361_spi_read(phy->spi, ad9361_cal_state_reg(i));
+		if (ret < 0)
+			return ret;
+		state->regs[i] = ret;
+	}
+
+	state->magic = AD9361_CAL_STATE_MAGIC;
+	state->size = sizeof(*state);
+	state->rx_lo_freq = ad9361_from_clk(clk_get_rate(phy,
+					    phy->ref_clk_scale[RX_RFPLL]));
+	state->tx_lo_freq = ad9361_from_clk(clk_get_rate(phy,
+					    phy->ref_clk_scale[TX_RFPLL]));
+	state->rx_bw_Hz = phy->current_rx_bw_Hz;
+	state->tx_bw_Hz = phy->current_tx_bw_Hz;
+	state->temp = ad9361_get_temp(phy);
+	state->tx_quad_cal_phase = phy->last_tx_quad_cal_phase;
+	state->checksum = ad9361_cal_state_checksum(state);
+
+	return 0;
+}
+
+/**
+ * Check if a calibration state can be restored.
+ * The LOs must be within cal_threshold_freq of the saved ones (the same limit
+ * the automatic TX quadrature calibration uses), the bandwidths must match and
+ * the temperature must be within cal_state_temp_tol of the saved one.
+ * @param phy The AD9361 state structure.
+ * @param state The calibration state.
+ * @return 0 if the state is usable, -EINVAL if the state is corrupted or was
+ *         saved from another device, -ERANGE if the conditions changed too much.
+ */
+int32_t ad9361_cal_state_check(struct ad9361_rf_phy *phy,
+			       const struct ad9361_cal_state *state)
+{
+	uint64_t rx_lo, tx_lo;
+	int32_t ret, temp, temp_tol;
+
+	if (state->magic != AD9361_CAL_STATE_MAGIC ||
+	    state->size != sizeof(*state) ||
+	    state->checksum != ad9361_cal_state_checksum(state))
+		return -EINVAL;
+
+	ret = ad9361_spi_read(phy->spi, REG_PRODUCT_ID);
+	if (ret < 0)
+		return ret;
+	if ((uint32_t)ret != state->product_id)
+		return -EINVAL;
+
+	rx_lo = ad9361_from_clk(clk_get_rate(phy, phy->ref_clk_scale[RX_RFPLL]));
+	tx_lo = ad9361_from_clk(clk_get_rate(phy, phy->ref_clk_scale[TX_RFPLL]));
+	temp = ad9361_get_temp(phy);
+	temp_tol = phy->cal_state_temp_tol ? phy->cal_state_temp_tol :
+		   AD9361_CAL_STATE_TEMP_TOL;
+
+	if (state->rx_bw_Hz != phy->current_rx_bw_Hz ||
+	    state->tx_bw_Hz != phy->current_tx_bw_Hz ||
+	    diff_abs(rx_lo, state->rx_lo_freq) > phy->cal_threshold_freq ||
+	    diff_abs(tx_lo, state->tx_lo_freq) > phy->cal_threshold_freq ||
+	    diff_abs(temp, state->temp) > temp_tol)
+		return -ERANGE;
+
+	return 0;
+}
+
+/**
+ * Restore the calibration results exported by ad9361_cal_state_save().
+ * The RF DC offset results live in internal tables which can't be accessed
+ * through SPI, so the RF DC offset calibration still has to run.
+ * @param phy The AD9361 state structure.
+ * @param state The calibration state, validated by ad9361_cal_state_check().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_cal_state_restore(struct ad9361_rf_phy *phy,
+				 const struct ad9361_cal_state *state)
+{
+	int32_t ret;
+	uint32_t i;
+
+	for (i = 0; i < AD9361_CAL_STATE_NUM_REGS; i++) {
+		ret = ad9361_spi_write(phy->spi, ad9361_cal_state_reg(i),
+				       state->regs[i]);
+		if (ret < 0)
+			return ret;
+	}
+
+	phy->last_tx_quad_cal_freq = state->tx_lo_freq;
+	phy->last_tx_quad_cal_phase = state->tx_quad_cal_phase;
+
+	return 0;
+}
+
 /**
  * Multi Chip Sync (MCS) config.
  * @param phy The AD9361 state structure.
@@ -5336,6 +5527,8 @@ void ad9361_clear_state(struct ad9361_rf_phy *phy)
 	phy->cached_synth_pd[0] = 0;
 	phy->cached_synth_pd[1] = 0;
 
+	phy->profile = NULL;
+
 	memset(&phy->fastlock, 0, sizeof(phy->fastlock));
 }
 
@@ -5604,7 +5797,19 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 	if (ret < 0)
 		return ret;
 
-	ret = ad9361_bb_dc_offset_calib(phy);
+	phy->current_rx_bw_Hz = pd->rf_rx_bandwidth_Hz;
+	phy->current_tx_bw_Hz = pd->rf_tx_bandwidth_Hz;
+	phy->cal_threshold_freq = 100000000ULL; /* 100 MHz */
+
+	/* Warm start: reuse the results of a previous boot when still valid */
+	phy->cal_state_restored = phy->cal_state &&
+				  !ad9361_cal_state_check(phy, phy->cal_state);
+	if (phy->cal_state_restored) {
+		dev_dbg(dev, "%s: restoring cached calibration results", __func__);
+		ret = ad9361_cal_state_restore(phy, phy->cal_state);
+	} else {
+		ret = ad9361_bb_dc_offset_calib(phy);
+	}
 	if (ret < 0)
 		return ret;
 
@@ -5613,12 +5818,13 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 	if (ret < 0)
 		return ret;
 
-	phy->current_rx_bw_Hz = pd->rf_rx_bandwidth_Hz;
-	phy->current_tx_bw_Hz = pd->rf_tx_bandwidth_Hz;
-	phy->last_tx_quad_cal_phase = ~0;
-	ret = ad9361_tx_quad_calib(phy, real_rx_bandwidth, real_tx_bandwidth, -1);
-	if (ret < 0)
-		return ret;
+	if (!phy->cal_state_restored) {
+		phy->last_tx_quad_cal_phase = ~0;
+		ret = ad9361_tx_quad_calib(phy, real_rx_bandwidth, real_tx_bandwidth,
+					   -1);
+		if (ret < 0)
+			return ret;
+	}
 
 	ret = ad9361_tracking_control(phy, phy->bbdc_track_en,
 				      phy->rfdc_track_en, phy->quad_track_en);
@@ -5665,7 +5871,6 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 			      pd->ensm_pin_ctrl);
 
 	phy->auto_cal_en = true;
-	phy->cal_threshold_freq = 100000000ULL; /* 100 MHz */
 
 	return 0;
 
@@ -5850,6 +6055,7 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 	}
 
 	ad9361_ensm_force_state(phy, ENSM_STATE_ALERT);
+	phy->profile = NULL;
 
 	if (dest & FIR_IS_RX) {
 		val = 3 - (gain_dB + 12) / 6;
@@ -5908,6 +6114,334 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 	return ret;
 }
 
+/* Baseband registers set by the clock chain and the digital interface tune */
+static const uint16_t ad9361_profile_bb_regs[] = {
+	REG_TX_ENABLE_FILTER_CTRL,
+	REG_RX_ENABLE_FILTER_CTRL,
+	REG_RX_CLOCK_DATA_DELAY,
+	REG_TX_CLOCK_DATA_DELAY,
+	REG_BBPLL,
+};
+
+/* BBPLL registers computed by ad9361_bbpll_set_rate() */
+static const uint16_t ad9361_profile_bbpll_regs[] = {
+	REG_CP_CURRENT,
+	REG_INTEGER_BB_FREQ_WORD,
+	REG_FRACT_BB_FREQ_WORD_3,
+	REG_FRACT_BB_FREQ_WORD_2,
+	REG_FRACT_BB_FREQ_WORD_1,
+};
+
+/**
+ * Read back the FIR filter coefficients of one channel.
+ * @param phy The AD9361 state structure.
+ * @param dest Destination identifier (RX1,2 / TX1,2).
+ * @param ntaps Number of filter Taps.
+ * @param coef Pointer to the read filter coefficients.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_read_fir_filter_coef(struct ad9361_rf_phy *phy,
+		enum fir_dest dest, uint32_t ntaps, int16_t *coef)
+{
+	struct no_os_spi_desc *spi = phy->spi;
+	uint32_t val, offs = 0, gain = 0, conf, sel;
+
+	if (dest & FIR_IS_RX) {
+		gain = ad9361_spi_read(spi, REG_RX_FILTER_GAIN);
+		offs = REG_RX_FILTER_COEF_ADDR - REG_TX_FILTER_COEF_ADDR;
+		ad9361_spi_write(spi, REG_RX_FILTER_GAIN, 0);
+	}
+
+	conf = ad9361_spi_read(spi, REG_TX_FILTER_CONF + offs);
+	sel = ((dest & 3) == 3) ? 1 : (dest & 3);
+
+	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs,
+			 FIR_NUM_TAPS(ntaps / 16 - 1) |
+			 FIR_SELECT(sel) | FIR_START_CLK);
+	for (val = 0; val < ntaps; val++) {
+		ad9361_spi_write(spi, REG_TX_FILTER_COEF_ADDR + offs, val);
+		coef[val] = (ad9361_spi_read(spi, REG_TX_FILTER_COEF_READ_DATA_1 + offs) & 0xFF) |
+			    (ad9361_spi_read(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs) << 8);
+	}
+
+	if (dest & FIR_IS_RX)
+		ad9361_spi_write(spi, REG_RX_FILTER_GAIN, gain);
+
+	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, conf);
+
+	return 0;
+}
+
+/**
+ * Capture the current sample rate, bandwidth and FIR configuration.
+ * Configure the device once through the regular API, then capture it so
+ * ad9361_profile_apply() can switch back to it without computing the clock
+ * chain, reloading unchanged FIR taps, tuning the digital interface or
+ * running the TX quadrature calibration again.
+ * @param phy The AD9361 state structure.
+ * @param profile The profile to be filled.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_profile_capture(struct ad9361_rf_phy *phy,
+			       struct ad9361_profile *profile)
+{
+	struct no_os_spi_desc *spi = phy->spi;
+	uint32_t i, conf;
+	int32_t ret;
+
+	memset(profile, 0, sizeof(*profile));
+
+	memcpy(profile->rx_path_clks, phy->current_rx_path_clks,
+	       sizeof(profile->rx_path_clks));
+	memcpy(profile->tx_path_clks, phy->current_tx_path_clks,
+	       sizeof(profile->tx_path_clks));
+	profile->rf_rx_bw_Hz = phy->current_rx_bw_Hz;
+	profile->rf_tx_bw_Hz = phy->current_tx_bw_Hz;
+
+	for (i = 0; i < AD9361_PROFILE_NUM_CLKS; i++) {
+		profile->clk_rate[i] = phy->clks[BBPLL_CLK + i]->rate;
+		profile->clk_mult[i] = phy->ref_clk_scale[BBPLL_CLK + i]->mult;
+		profile->clk_div[i] = phy->ref_clk_scale[BBPLL_CLK + i]->div;
+	}
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_profile_bbpll_regs); i++) {
+		ret = ad9361_spi_read(spi, ad9361_profile_bbpll_regs[i]);
+		if (ret < 0)
+			return ret;
+		profile->bbpll_regs[i] = ret;
+	}
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_profile_bb_regs); i++) {
+		ret = ad9361_spi_read(spi, ad9361_profile_bb_regs[i]);
+		if (ret < 0)
+			return ret;
+		profile->bb_regs[i] = ret;
+	}
+
+	/* Multi byte transfers stream down from the given address */
+	for (i = 0; i < AD9361_PROFILE_NUM_TXQ_REGS; i += MAX_MBYTE_SPI) {
+		ret = ad9361_spi_readm(spi, REG_TX2_OUT_2_OFFSET_Q - i,
+				       profile->txq_regs + i,
+				       no_os_min(AD9361_PROFILE_NUM_TXQ_REGS - i,
+						 (uint32_t)MAX_MBYTE_SPI));
+		if (ret < 0)
+			return ret;
+	}
+	ret = ad9361_spi_read(spi, REG_KEXP_2);
+	if (ret < 0)
+		return ret;
+	profile->txq_kexp = ret;
+	profile->tx_quad_cal_phase = phy->last_tx_quad_cal_phase;
+	profile->tx_lo_freq = ad9361_from_clk(clk_get_rate(phy,
+					      phy->ref_clk_scale[TX_RFPLL]));
+
+	profile->bypass_rx_fir = phy->bypass_rx_fir;
+	profile->bypass_tx_fir = phy->bypass_tx_fir;
+	profile->rx_fir_dec = phy->rx_fir_dec;
+	profile->tx_fir_int = phy->tx_fir_int;
+	profile->rx_fir_ntaps = phy->rx_fir_ntaps;
+	profile->tx_fir_ntaps = phy->tx_fir_ntaps;
+
+	if (profile->rx_fir_ntaps) {
+		conf = ad9361_spi_read(spi, REG_RX_FILTER_CONFIG);
+		profile->rx_fir_dest = FIR_IS_RX | ((conf >> 3) & 0x3);
+		profile->rx_fir_gain = (3 - (ad9361_spi_read(spi, REG_RX_FILTER_GAIN) &
+					     0x3)) * 6 - 12;
+		ret = ad9361_read_fir_filter_coef(phy, profile->rx_fir_dest,
+						  profile->rx_fir_ntaps,
+						  profile->rx_fir_coef);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (profile->tx_fir_ntaps) {
+		conf = ad9361_spi_read(spi, REG_TX_FILTER_CONF);
+		profile->tx_fir_dest = (conf >> 3) & 0x3;
+		profile->tx_fir_gain = (conf & TX_FIR_GAIN_6DB) ? -6 : 0;
+		ret = ad9361_read_fir_filter_coef(phy, profile->tx_fir_dest,
+						  profile->tx_fir_ntaps,
+						  profile->tx_fir_coef);
+		if (ret < 0)
+			return ret;
+	}
+
+	phy->profile = profile;
+
+	return 0;
+}
+
+/**
+ * Check if the FIR taps of a profile are the ones currently loaded.
+ * @param phy The AD9361 state structure.
+ * @param profile The profile.
+ * @param rx Set true for the RX FIR, false for the TX FIR.
+ * @return true if the FIR doesn't have to be reloaded.
+ */
+static bool ad9361_profile_fir_loaded(struct ad9361_rf_phy *phy,
+				      const struct ad9361_profile *profile,
+				      bool rx)
+{
+	const struct ad9361_profile *curr = phy->profile;
+
+	if (!curr)
+		return false;
+
+	if (rx)
+		return curr->rx_fir_ntaps == profile->rx_fir_ntaps &&
+		       curr->rx_fir_dest == profile->rx_fir_dest &&
+		       curr->rx_fir_gain == profile->rx_fir_gain &&
+		       !memcmp(curr->rx_fir_coef, profile->rx_fir_coef,
+			       profile->rx_fir_ntaps * sizeof(int16_t));
+
+	return curr->tx_fir_ntaps == profile->tx_fir_ntaps &&
+	       curr->tx_fir_dest == profile->tx_fir_dest &&
+	       curr->tx_fir_gain == profile->tx_fir_gain &&
+	       !memcmp(curr->tx_fir_coef, profile->tx_fir_coef,
+		       profile->tx_fir_ntaps * sizeof(int16_t));
+}
+
+/**
+ * Relock the BBPLL on the frequency word of a profile.
+ * Same sequence as ad9361_bbpll_set_rate() without computing the words.
+ * @param phy The AD9361 state structure.
+ * @param profile The profile.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_profile_bbpll_relock(struct ad9361_rf_phy *phy,
+		const struct ad9361_profile *profile)
+{
+	struct no_os_spi_desc *spi = phy->spi;
+	uint8_t lf_defaults[3] = { 0x35, 0x5B, 0xE8 };
+	uint32_t i;
+
+	ad9361_spi_writem(spi, REG_LOOP_FILTER_3, lf_defaults,
+			  NO_OS_ARRAY_SIZE(lf_defaults));
+	ad9361_spi_write(spi, REG_VCO_CTRL,
+			 FREQ_CAL_ENABLE | FREQ_CAL_COUNT_LENGTH(3));
+	ad9361_spi_write(spi, REG_SDM_CTRL, 0x10);
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_profile_bbpll_regs); i++)
+		ad9361_spi_write(spi, ad9361_profile_bbpll_regs[i],
+				 profile->bbpll_regs[i]);
+
+	ad9361_spi_write(spi, REG_SDM_CTRL_1, INIT_BB_FO_CAL | BBPLL_RESET_BAR);
+	ad9361_spi_write(spi, REG_SDM_CTRL_1, BBPLL_RESET_BAR);
+
+	ad9361_spi_write(spi, REG_VCO_PROGRAM_1, 0x86);
+	ad9361_spi_write(spi, REG_VCO_PROGRAM_2, 0x01);
+	ad9361_spi_write(spi, REG_VCO_PROGRAM_2, 0x05);
+
+	return ad9361_check_cal_done(phy, REG_CH_1_OVERFLOW, BBPLL_LOCK, 1);
+}
+
+/**
+ * Switch to a profile captured by ad9361_profile_capture().
+ * The FIR taps are reloaded only if they differ from the loaded ones and the
+ * TX quadrature calibration only runs if the TX LO moved more than
+ * cal_threshold_freq away from the one of the capture. The baseband analog
+ * filters are always tuned again, since their results depend on the die.
+ * @param phy The AD9361 state structure.
+ * @param profile The profile, must stay valid while it is in use.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_profile_apply(struct ad9361_rf_phy *phy,
+			     const struct ad9361_profile *profile)
+{
+	struct no_os_spi_desc *spi = phy->spi;
+	uint64_t tx_lo;
+	uint32_t i;
+	int32_t ret;
+
+	phy->rx_fir_dec = profile->rx_fir_dec;
+	phy->tx_fir_int = profile->tx_fir_int;
+
+	if (profile->rx_fir_ntaps && !ad9361_profile_fir_loaded(phy, profile, true)) {
+		ret = ad9361_load_fir_filter_coef(phy, profile->rx_fir_dest,
+						  profile->rx_fir_gain,
+						  profile->rx_fir_ntaps,
+						  (int16_t *)profile->rx_fir_coef);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (profile->tx_fir_ntaps && !ad9361_profile_fir_loaded(phy, profile, false)) {
+		ret = ad9361_load_fir_filter_coef(phy, profile->tx_fir_dest,
+						  profile->tx_fir_gain,
+						  profile->tx_fir_ntaps,
+						  (int16_t *)profile->tx_fir_coef);
+		if (ret < 0)
+			return ret;
+	}
+
+	ret = ad9361_tracking_control(phy, false, false, false);
+	if (ret < 0)
+		return ret;
+
+	ad9361_ensm_force_state(phy, ENSM_STATE_ALERT);
+
+	if (phy->clks[BBPLL_CLK]->rate != profile->clk_rate[0]) {
+		ret = ad9361_profile_bbpll_relock(phy, profile);
+		if (ret < 0)
+			goto out;
+	}
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_profile_bb_regs); i++)
+		ad9361_spi_write(spi, ad9361_profile_bb_regs[i],
+				 profile->bb_regs[i]);
+
+	for (i = 0; i < AD9361_PROFILE_NUM_CLKS; i++) {
+		phy->clks[BBPLL_CLK + i]->rate = profile->clk_rate[i];
+		phy->ref_clk_scale[BBPLL_CLK + i]->mult = profile->clk_mult[i];
+		phy->ref_clk_scale[BBPLL_CLK + i]->div = profile->clk_div[i];
+	}
+
+	memcpy(phy->current_rx_path_clks, profile->rx_path_clks,
+	       sizeof(phy->current_rx_path_clks));
+	memcpy(phy->current_tx_path_clks, profile->tx_path_clks,
+	       sizeof(phy->current_tx_path_clks));
+	phy->bypass_rx_fir = profile->bypass_rx_fir;
+	phy->bypass_tx_fir = profile->bypass_tx_fir;
+	phy->rx_fir_ntaps = profile->rx_fir_ntaps;
+	phy->tx_fir_ntaps = profile->tx_fir_ntaps;
+
+	ret = ad9361_bb_clk_change_handler(phy);
+	if (ret < 0)
+		goto out;
+
+	ret = __ad9361_update_rf_bandwidth(phy, profile->rf_rx_bw_Hz,
+					   profile->rf_tx_bw_Hz);
+	if (ret < 0)
+		goto out;
+
+	phy->current_rx_bw_Hz = profile->rf_rx_bw_Hz;
+	phy->current_tx_bw_Hz = profile->rf_tx_bw_Hz;
+
+	tx_lo = ad9361_from_clk(clk_get_rate(phy, phy->ref_clk_scale[TX_RFPLL]));
+	if (diff_abs(tx_lo, profile->tx_lo_freq) <= phy->cal_threshold_freq) {
+		for (i = 0; i < AD9361_PROFILE_NUM_TXQ_REGS; i += MAX_MBYTE_SPI)
+			ad9361_spi_writem(spi, REG_TX2_OUT_2_OFFSET_Q - i,
+					  (uint8_t *)profile->txq_regs + i,
+					  no_os_min(AD9361_PROFILE_NUM_TXQ_REGS - i,
+						    (uint32_t)MAX_MBYTE_SPI));
+		ad9361_spi_write(spi, REG_KEXP_2, profile->txq_kexp);
+		phy->last_tx_quad_cal_phase = profile->tx_quad_cal_phase;
+	} else if (!phy->manual_tx_quad_cal_en) {
+		ret = ad9361_tx_quad_calib(phy, profile->rf_rx_bw_Hz / 2,
+					   profile->rf_tx_bw_Hz / 2, -1);
+		if (ret < 0)
+			goto out;
+	}
+
+	phy->profile = profile;
+
+	ret = ad9361_tracking_control(phy, phy->bbdc_track_en,
+				      phy->rfdc_track_en, phy->quad_track_en);
+out:
+	ad9361_ensm_restore_prev_state(phy);
+
+	return ret;
+}
+
 /**
  * Parse the FIR filter file/buffer.
  * @param phy The AD9361 state structure.
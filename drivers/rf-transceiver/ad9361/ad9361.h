@@ -3310,6 +3310,96 @@ struct ad9361_fastlock {
 	struct ad9361_fastlock_entry entry[2][8];
 };
 
+#define AD9361_CAL_STATE_MAGIC		0x41443643 /* "AD6C" */
+#define AD9361_CAL_STATE_NUM_REGS	53
+#define AD9361_CAL_STATE_TEMP_TOL	10000 /* milli-degrees Celsius */
+
+/* Calibration results kept between boots, see ad9361_cal_state_save().
+ * The layout has no implicit padding and is a multiple of 32-bit words, so it
+ * can be written as is to flash or EEPROM. */
+struct ad9361_cal_state {
+	uint32_t	magic;
+	uint32_t	size;
+	uint64_t	rx_lo_freq;
+	uint64_t	tx_lo_freq;
+	uint32_t	product_id;
+	uint32_t	rx_bw_Hz;
+	uint32_t	tx_bw_Hz;
+	int32_t		temp;		/* milli-degrees Celsius */
+	uint32_t	tx_quad_cal_phase;
+	uint8_t		regs[AD9361_CAL_STATE_NUM_REGS];
+	uint8_t		reserved[3];
+	uint32_t	checksum;
+};
+
+#define AD9361_DIG_TUNE_CACHE_MAGIC	0x41443654 /* "AD6T" */
+#ifndef AD9361_DIG_TUNE_CACHE_SIZE
+#define AD9361_DIG_TUNE_CACHE_SIZE	8
+#endif
+#define AD9361_DIG_TUNE_RATE_STEP	1000000 /* Hz */
+#define AD9361_DIG_TUNE_TEMP_STEP	10000 /* milli-degrees Celsius */
+
+/* Interface delays found by the digital tune at a sample rate and a
+ * temperature, rate_band and temp_band being the sample rate and the
+ * temperature divided by AD9361_DIG_TUNE_RATE_STEP and _TEMP_STEP. */
+struct ad9361_dig_tune_entry {
+	uint32_t	rate_band;
+	int16_t		temp_band;
+	/* REG_RX_CLOCK_DATA_DELAY and REG_TX_CLOCK_DATA_DELAY */
+	uint8_t		delay[2];
+	/* NO_OS_BIT(0) if delay[0] is set, NO_OS_BIT(1) if delay[1] is set */
+	uint8_t		valid;
+	uint8_t		reserved[3];
+};
+
+/* Digital tune results, see ad9361_dig_tune_cache_save(). Like struct
+ * ad9361_cal_state, it can be written as is to flash or EEPROM. */
+struct ad9361_dig_tune_cache {
+	uint32_t			magic;
+	uint32_t			size;
+	/* Entry replaced by the next new result */
+	uint32_t			next;
+	struct ad9361_dig_tune_entry	entry[AD9361_DIG_TUNE_CACHE_SIZE];
+	uint32_t			checksum;
+};
+
+#define AD9361_PROFILE_NUM_CLKS		(TX_SAMPL_CLK - BBPLL_CLK + 1)
+#define AD9361_PROFILE_NUM_TXQ_REGS	(REG_TX2_OUT_2_OFFSET_Q - \
+					 REG_TX1_OUT_1_PHASE_CORR + 1)
+
+/* Sample rate, bandwidth and FIR configuration captured by
+ * ad9361_profile_capture() and switched to by ad9361_profile_apply(). */
+struct ad9361_profile {
+	uint32_t	rx_path_clks[NUM_RX_CLOCKS];
+	uint32_t	tx_path_clks[NUM_TX_CLOCKS];
+	uint32_t	rf_rx_bw_Hz;
+	uint32_t	rf_tx_bw_Hz;
+	/* BBPLL_CLK to TX_SAMPL_CLK */
+	uint32_t	clk_rate[AD9361_PROFILE_NUM_CLKS];
+	uint32_t	clk_mult[AD9361_PROFILE_NUM_CLKS];
+	uint32_t	clk_div[AD9361_PROFILE_NUM_CLKS];
+	uint8_t		bbpll_regs[5];
+	uint8_t		bb_regs[5];
+	/* TX quadrature calibration results at tx_lo_freq, from the last
+	 * register down */
+	uint64_t	tx_lo_freq;
+	uint8_t		txq_regs[AD9361_PROFILE_NUM_TXQ_REGS];
+	uint8_t		txq_kexp;
+	uint32_t	tx_quad_cal_phase;
+	bool		bypass_rx_fir;
+	bool		bypass_tx_fir;
+	uint8_t		rx_fir_dec;
+	uint8_t		tx_fir_int;
+	uint8_t		rx_fir_ntaps;
+	uint8_t		tx_fir_ntaps;
+	enum fir_dest	rx_fir_dest;
+	enum fir_dest	tx_fir_dest;
+	int32_t		rx_fir_gain;
+	int32_t		tx_fir_gain;
+	int16_t		rx_fir_coef[128];
+	int16_t		tx_fir_coef[128];
+};
+
 enum dig_tune_flags {
 	BE_VERBOSE = 1,
 	BE_MOREVERBOSE = 2,
@@ -3317,6 +3407,7 @@ enum dig_tune_flags {
 	DO_ODELAY = 8,
 	SKIP_STORE_RESULT = 16,
 	RESTORE_DEFAULT = 32,
+	SKIP_CACHE = 64,
 };
 
 enum ad9361_bist_mode {
@@ -3405,6 +3496,11 @@ struct ad9361_rf_phy {
 	uint32_t 			tx1_atten_cached;
 	uint32_t 			tx2_atten_cached;
 	struct ad9361_fastlock	fastlock;
+	const struct ad9361_cal_state	*cal_state;
+	int32_t			cal_state_temp_tol;
+	bool			cal_state_restored;
+	struct ad9361_dig_tune_cache	dig_tune_cache;
+	const struct ad9361_profile	*profile;
 	struct axiadc_converter	*adc_conv;
 	struct axiadc_state		*adc_state;
 	int32_t					bist_loopback_mode;
@@ -3533,8 +3629,20 @@ int32_t ad9361_rf_port_setup(struct ad9361_rf_phy *phy, bool is_out,
 int32_t ad9361_mcs(struct ad9361_rf_phy *phy, int32_t step);
 int32_t ad9361_do_calib_run(struct ad9361_rf_phy *phy, uint32_t cal,
 			    int32_t arg);
+int32_t ad9361_fastlock_get_current(struct ad9361_rf_phy *phy, bool tx,
+				    uint8_t *val);
 int32_t ad9361_fastlock_store(struct ad9361_rf_phy *phy, bool tx,
 			      uint32_t profile);
+int32_t ad9361_cal_state_save(struct ad9361_rf_phy *phy,
+			      struct ad9361_cal_state *state);
+int32_t ad9361_cal_state_check(struct ad9361_rf_phy *phy,
+			       const struct ad9361_cal_state *state);
+int32_t ad9361_cal_state_restore(struct ad9361_rf_phy *phy,
+				 const struct ad9361_cal_state *state);
+int32_t ad9361_profile_capture(struct ad9361_rf_phy *phy,
+			       struct ad9361_profile *profile);
+int32_t ad9361_profile_apply(struct ad9361_rf_phy *phy,
+			     const struct ad9361_profile *profile);
 int32_t ad9361_fastlock_recall(struct ad9361_rf_phy *phy, bool tx,
 			       uint32_t profile);
 int32_t ad9361_fastlock_load(struct ad9361_rf_phy *phy, bool tx,
@@ -3553,6 +3661,10 @@ int32_t ad9361_dig_interface_timing_analysis(struct ad9361_rf_phy *phy,
 		char *buf, int32_t buflen);
 int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 			enum dig_tune_flags flags);
+int32_t ad9361_dig_tune_cache_save(struct ad9361_rf_phy *phy,
+				   struct ad9361_dig_tune_cache *cache);
+int32_t ad9361_dig_tune_cache_restore(struct ad9361_rf_phy *phy,
+				      const struct ad9361_dig_tune_cache *cache);
 int32_t ad9361_en_dis_tx(struct ad9361_rf_phy *phy, uint32_t tx_if,
 			 uint32_t enable);
 int32_t ad9361_en_dis_rx(struct ad9361_rf_phy *phy, uint32_t rx_if,
@@ -556,6 +556,12 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 	phy->ad9361_rfpll_ext_round_rate = init_param->ad9361_rfpll_ext_round_rate;
 	phy->ad9361_rfpll_ext_set_rate = init_param->ad9361_rfpll_ext_set_rate;
 
+	phy->cal_state = init_param->cal_state;
+	phy->cal_state_temp_tol = init_param->cal_state_temp_tol;
+	/* A cache saved from another build or corrupted is ignored */
+	if (init_param->dig_tune_cache)
+		ad9361_dig_tune_cache_restore(phy, init_param->dig_tune_cache);
+
 	ret = ad9361_register_clocks(phy);
 	if (ret < 0)
 		goto out;
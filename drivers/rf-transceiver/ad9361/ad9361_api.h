@@ -295,6 +295,11 @@ typedef struct {
 	struct axi_adc_init	*rx_adc_init;
 	struct axi_dac_init	*tx_dac_init;
 #endif
+	/* Warm start, see ad9361_cal_state_save() */
+	const struct ad9361_cal_state	*cal_state;
+	int32_t		cal_state_temp_tol;	/* milli-degrees, 0 for default */
+	/* Digital tune results, see ad9361_dig_tune_cache_save() */
+	const struct ad9361_dig_tune_cache	*dig_tune_cache;
 } AD9361_InitParam;
 
 typedef struct {
@@ -0,0 +1,131 @@
+/***************************************************************************//**
+ *   @file   ad9361_cal_store.c
+ *   @brief  AD9361 calibration state storage
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "ad9361_cal_store.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Write a calibration state to flash.
+ * @param dev - The flash device.
+ * @param addr - Flash address of the state, 32-bit aligned.
+ * @param state - The state exported by ad9361_cal_state_save().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_cal_state_flash_write(struct no_os_flash_dev *dev,
+				     uint32_t addr,
+				     const struct ad9361_cal_state *state)
+{
+	uint32_t buf[sizeof(*state) / sizeof(uint32_t)];
+
+	if (!dev || !state)
+		return -EINVAL;
+
+	memcpy(buf, state, sizeof(buf));
+
+	return no_os_flash_write(dev, addr, buf, NO_OS_ARRAY_SIZE(buf));
+}
+
+/**
+ * @brief Read a calibration state from flash.
+ * The state must still be validated with ad9361_cal_state_check(), which is
+ * done by ad9361_init() when the state is passed as cal_state.
+ * @param dev - The flash device.
+ * @param addr - Flash address of the state, 32-bit aligned.
+ * @param state - The read state.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_cal_state_flash_read(struct no_os_flash_dev *dev, uint32_t addr,
+				    struct ad9361_cal_state *state)
+{
+	uint32_t buf[sizeof(*state) / sizeof(uint32_t)];
+	int32_t ret;
+
+	if (!dev || !state)
+		return -EINVAL;
+
+	ret = no_os_flash_read(dev, addr, buf, NO_OS_ARRAY_SIZE(buf));
+	if (ret)
+		return ret;
+
+	memcpy(state, buf, sizeof(buf));
+
+	return 0;
+}
+
+/**
+ * @brief Write a calibration state to EEPROM.
+ * @param desc - The EEPROM descriptor.
+ * @param addr - EEPROM address of the state.
+ * @param state - The state exported by ad9361_cal_state_save().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_cal_state_eeprom_write(struct no_os_eeprom_desc *desc,
+				      uint32_t addr,
+				      const struct ad9361_cal_state *state)
+{
+	if (!desc || !state)
+		return -EINVAL;
+
+	return no_os_eeprom_write(desc, addr, (uint8_t *)state, sizeof(*state));
+}
+
+/**
+ * @brief Read a calibration state from EEPROM.
+ * @param desc - The EEPROM descriptor.
+ * @param addr - EEPROM address of the state.
+ * @param state - The read state.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_cal_state_eeprom_read(struct no_os_eeprom_desc *desc,
+				     uint32_t addr,
+				     struct ad9361_cal_state *state)
+{
+	if (!desc || !state)
+		return -EINVAL;
+
+	return no_os_eeprom_read(desc, addr, (uint8_t *)state, sizeof(*state));
+}
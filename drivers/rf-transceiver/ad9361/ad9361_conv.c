@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <inttypes.h>
+#include <stddef.h>
 #include <string.h>
 #include "ad9361.h"
 #include "no_os_delay.h"
@@ -347,11 +348,90 @@ int32_t ad9361_dig_interface_timing_analysis(struct ad9361_rf_phy *phy,
 	return len;
 }
 
+/**
+ * Find the digital tune cache entry of the current sample rate and
+ * temperature.
+ * @param phy The AD9361 state structure.
+ * @param create Set to replace the oldest entry if none matches.
+ * @return The entry, NULL if none matches and create is not set.
+ */
+static struct ad9361_dig_tune_entry *ad9361_dig_tune_cache_find(
+	struct ad9361_rf_phy *phy, bool create)
+{
+	struct ad9361_dig_tune_cache *cache = &phy->dig_tune_cache;
+	struct ad9361_dig_tune_entry *entry;
+	uint32_t rate_band;
+	int32_t temp;
+	int16_t temp_band;
+	uint32_t i;
+
+	rate_band = clk_get_rate(phy, phy->ref_clk_scale[RX_SAMPL_CLK]) /
+		    AD9361_DIG_TUNE_RATE_STEP;
+	temp = ad9361_get_temp(phy);
+	/* Rounded down, also below 0 */
+	temp_band = (temp - (temp < 0 ? AD9361_DIG_TUNE_TEMP_STEP - 1 : 0)) /
+		    AD9361_DIG_TUNE_TEMP_STEP;
+
+	for (i = 0; i < AD9361_DIG_TUNE_CACHE_SIZE; i++) {
+		entry = &cache->entry[i];
+		if (entry->valid && entry->rate_band == rate_band &&
+		    entry->temp_band == temp_band)
+			return entry;
+	}
+
+	if (!create)
+		return NULL;
+
+	entry = &cache->entry[cache->next];
+	cache->next = (cache->next + 1) % AD9361_DIG_TUNE_CACHE_SIZE;
+	memset(entry, 0, sizeof(*entry));
+	entry->rate_band = rate_band;
+	entry->temp_band = temp_band;
+
+	return entry;
+}
+
+/**
+ * Check that a cached interface delay and its neighbours still pass the PN
+ * check, so that the margin found by the full tune is kept.
+ * @param phy The AD9361 state structure.
+ * @param tx Set if TX.
+ * @param delay Value of REG_RX/TX_CLOCK_DATA_DELAY.
+ * @return true if the delay is set and passes.
+ */
+static bool ad9361_dig_tune_verify(struct ad9361_rf_phy *phy, bool tx,
+				   uint8_t delay)
+{
+	int32_t clock_delay = delay >> 4;
+	int32_t data_delay = delay & 0xF;
+	int32_t c, d, k;
+
+	for (k = -1; k <= 1; k++) {
+		/* Only one of the delays is tuned, the other one is 0 */
+		c = clock_delay ? clock_delay + k : 0;
+		d = clock_delay ? 0 : data_delay + k;
+		if (c < 0 || c > 15 || d < 0 || d > 15)
+			continue;
+
+		ad9361_set_intf_delay(phy, tx, c, d, true);
+		if (ad9361_check_pn(phy, tx, 4))
+			return false;
+	}
+
+	ad9361_set_intf_delay(phy, tx, clock_delay, data_delay, true);
+
+	return true;
+}
+
 /**
  * Digital tune delay.
+ * When tuning at the current rate, the delay found before at the same sample
+ * rate and temperature band is checked first and the sweep is skipped if it
+ * still passes, unless SKIP_CACHE is set.
  * @param phy The AD9361 state structure.
  * @param max_freq Maximum frequency.
- * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY.
+ * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY,
+ *		SKIP_CACHE.
  * @param tx Set if TX.
  * @return 0 in case of success, negative error code otherwise.
  */
@@ -359,10 +439,22 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 				     uint32_t max_freq, enum dig_tune_flags flags, bool tx)
 {
 	static const uint32_t rates[3] = {25000000U, 40000000U, 61440000U};
+	struct ad9361_dig_tune_entry *entry;
 	uint32_t s0, s1, c0, c1;
 	uint32_t i, j, r;
 	bool half_data_rate;
 	uint8_t field[2][16];
+	uint8_t delay;
+
+	if (!max_freq && !(flags & SKIP_CACHE)) {
+		entry = ad9361_dig_tune_cache_find(phy, false);
+		if (entry && (entry->valid & NO_OS_BIT(tx)) &&
+		    ad9361_dig_tune_verify(phy, tx, entry->delay[tx])) {
+			dev_dbg(&phy->spi->dev, "%s: %s cached delay 0x%X\n",
+				__func__, tx ? "TX" : "RX", entry->delay[tx]);
+			return 0;
+		}
+	}
 
 	if (((phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE) ||
 	     !phy->pdata->rx2tx2))
@@ -409,9 +501,16 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 	}
 
 	if (c1 > c0)
-		ad9361_set_intf_delay(phy, tx, s1 + c1 / 2, 0, true);
+		delay = DATA_CLK_DELAY(s1 + c1 / 2);
 	else
-		ad9361_set_intf_delay(phy, tx, 0, s0 + c0 / 2, true);
+		delay = RX_DATA_DELAY(s0 + c0 / 2);
+	ad9361_set_intf_delay(phy, tx, delay >> 4, delay & 0xF, true);
+
+	if (!max_freq) {
+		entry = ad9361_dig_tune_cache_find(phy, true);
+		entry->delay[tx] = delay;
+		entry->valid |= NO_OS_BIT(tx);
+	}
 
 	return 0;
 }
@@ -698,3 +797,70 @@ int32_t ad9361_post_setup(struct ad9361_rf_phy *phy)
 	return 0;
 }
 #endif
+
+/**
+ * Checksum of a digital tune cache.
+ * @param cache The digital tune cache.
+ * @return The Fletcher-32 checksum of the fields before checksum.
+ */
+static uint32_t ad9361_dig_tune_cache_checksum(
+	const struct ad9361_dig_tune_cache *cache)
+{
+	const uint8_t *buf = (const uint8_t *)cache;
+	uint32_t sum1 = 0xFFFF, sum2 = 0xFFFF;
+	uint32_t i;
+
+	for (i = 0; i < offsetof(struct ad9361_dig_tune_cache, checksum); i++) {
+		sum1 = (sum1 + buf[i]) % 65535;
+		sum2 = (sum2 + sum1) % 65535;
+	}
+
+	return (sum2 << 16) | sum1;
+}
+
+/**
+ * Export the digital tune results found so far.
+ * Store the cache to non volatile memory and pass it back through the
+ * dig_tune_cache initialization parameter on the next boot, so the sample
+ * rate changes only check the cached interface delays.
+ * @param phy The AD9361 state structure.
+ * @param cache Where to store the cache.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_dig_tune_cache_save(struct ad9361_rf_phy *phy,
+				   struct ad9361_dig_tune_cache *cache)
+{
+	if (!phy || !cache)
+		return -EINVAL;
+
+	*cache = phy->dig_tune_cache;
+	cache->magic = AD9361_DIG_TUNE_CACHE_MAGIC;
+	cache->size = sizeof(*cache);
+	cache->checksum = ad9361_dig_tune_cache_checksum(cache);
+
+	return 0;
+}
+
+/**
+ * Import the digital tune results exported by ad9361_dig_tune_cache_save().
+ * @param phy The AD9361 state structure.
+ * @param cache The digital tune cache.
+ * @return 0 in case of success, -EINVAL if the cache is corrupted or was
+ *         saved with another AD9361_DIG_TUNE_CACHE_SIZE.
+ */
+int32_t ad9361_dig_tune_cache_restore(struct ad9361_rf_phy *phy,
+				      const struct ad9361_dig_tune_cache *cache)
+{
+	if (!phy || !cache)
+		return -EINVAL;
+
+	if (cache->magic != AD9361_DIG_TUNE_CACHE_MAGIC ||
+	    cache->size != sizeof(*cache) ||
+	    cache->checksum != ad9361_dig_tune_cache_checksum(cache) ||
+	    cache->next >= AD9361_DIG_TUNE_CACHE_SIZE)
+		return -EINVAL;
+
+	phy->dig_tune_cache = *cache;
+
+	return 0;
+}
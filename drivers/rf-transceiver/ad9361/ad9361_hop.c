@@ -0,0 +1,223 @@
+/***************************************************************************//**
+ *   @file   ad9361_hop.c
+ *   @brief  AD9361 frequency hopping on fastlock profiles
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "ad9361_hop.h"
+#include "ad9361_api.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * Tune the synthesizer of the table to each frequency, with a full VCO
+ * calibration, and cache the resulting fastlock profile values. The first
+ * AD9361_HOP_SLOTS entries are loaded in the fastlock slots.
+ * @param table Where to store the hop table descriptor.
+ * @param phy The AD9361 state structure.
+ * @param param The hop table parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ *
+ * Note: This function will/may affect the data path.
+ */
+int32_t ad9361_hop_init(struct ad9361_hop_table **table,
+			struct ad9361_rf_phy *phy,
+			const struct ad9361_hop_init_param *param)
+{
+	struct ad9361_hop_table *t;
+	uint32_t i;
+	int32_t ret;
+
+	if (!table || !phy || !param || !param->lo_freq_hz || !param->nb_freqs)
+		return -EINVAL;
+
+	t = no_os_calloc(1, sizeof(*t));
+	if (!t)
+		return -ENOMEM;
+
+	t->entries = no_os_calloc(param->nb_freqs, sizeof(*t->entries));
+	if (!t->entries) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	t->phy = phy;
+	t->tx = param->tx;
+	t->profile_gpios = param->profile_gpios;
+	t->nb_entries = param->nb_freqs;
+	t->current = -1;
+	for (i = 0; i < AD9361_HOP_SLOTS; i++)
+		t->slot_entry[i] = -1;
+
+	for (i = 0; i < t->nb_entries; i++) {
+		t->entries[i].lo_freq_hz = param->lo_freq_hz[i];
+		t->entries[i].slot = -1;
+
+		if (t->tx)
+			ret = ad9361_set_tx_lo_freq(phy, param->lo_freq_hz[i]);
+		else
+			ret = ad9361_set_rx_lo_freq(phy, param->lo_freq_hz[i]);
+		if (ret < 0)
+			goto error;
+
+		ret = ad9361_fastlock_get_current(phy, t->tx, t->entries[i].values);
+		if (ret < 0)
+			goto error;
+	}
+
+	for (i = 0; i < t->nb_entries && i < AD9361_HOP_SLOTS; i++) {
+		ret = ad9361_hop_preload(t, i, NULL);
+		if (ret < 0)
+			goto error;
+	}
+
+	*table = t;
+
+	return 0;
+error:
+	no_os_free(t->entries);
+	no_os_free(t);
+
+	return ret;
+}
+
+/**
+ * Load an entry in a fastlock slot, unless a slot already holds it. The slots
+ * are reused in turn, skipping the active one. Preloading the next hop while
+ * the current one is in use leaves a single profile switch on the hop itself.
+ * @param table The hop table descriptor.
+ * @param entry Index of the entry.
+ * @param slot Where to store the slot of the entry, may be NULL. Needed to
+ * 	       select the profile by pins.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_preload(struct ad9361_hop_table *table, uint32_t entry,
+			   uint32_t *slot)
+{
+	struct ad9361_hop_entry *e;
+	uint32_t s;
+	int32_t ret;
+
+	if (!table || entry >= table->nb_entries)
+		return -EINVAL;
+
+	e = &table->entries[entry];
+	if (e->slot < 0) {
+		s = table->next_slot;
+		if (table->current >= 0 &&
+		    table->entries[table->current].slot == (int8_t)s)
+			s = (s + 1) % AD9361_HOP_SLOTS;
+
+		ret = ad9361_fastlock_load(table->phy, table->tx, s, e->values);
+		if (ret < 0)
+			return ret;
+
+		if (table->slot_entry[s] >= 0)
+			table->entries[table->slot_entry[s]].slot = -1;
+		table->slot_entry[s] = entry;
+		e->slot = s;
+		table->next_slot = (s + 1) % AD9361_HOP_SLOTS;
+	}
+
+	if (slot)
+		*slot = e->slot;
+
+	return 0;
+}
+
+/**
+ * Switch the synthesizer to an entry of the table: load it in a slot if none
+ * holds it, then select the slot. With profile GPIOs and fastlock pin control
+ * the slot is selected by pins once fastlock mode is entered, otherwise with a
+ * profile recall over SPI.
+ * @param table The hop table descriptor.
+ * @param entry Index of the entry.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_to(struct ad9361_hop_table *table, uint32_t entry)
+{
+	struct ad9361_rf_phy *phy;
+	bool pins;
+	uint32_t slot;
+	int32_t ret;
+
+	ret = ad9361_hop_preload(table, entry, &slot);
+	if (ret < 0)
+		return ret;
+
+	phy = table->phy;
+	pins = table->profile_gpios && phy->pdata->trx_fastlock_pinctrl_en[table->tx];
+	if (pins) {
+		ret = no_os_gpio_array_set_value(table->profile_gpios, slot);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (pins && phy->fastlock.current_profile[table->tx])
+		phy->fastlock.current_profile[table->tx] = slot + 1;
+	else
+		ret = ad9361_fastlock_recall(phy, table->tx, slot);
+	if (ret < 0)
+		return ret;
+
+	table->current = entry;
+
+	return 0;
+}
+
+/**
+ * Free the resources allocated by ad9361_hop_init(). The fastlock slots are
+ * left loaded.
+ * @param table The hop table descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_hop_remove(struct ad9361_hop_table *table)
+{
+	if (!table)
+		return -EINVAL;
+
+	no_os_free(table->entries);
+	no_os_free(table);
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+/***************************************************************************//**
+ *   @file   ad9361_hop.h
+ *   @brief  AD9361 frequency hopping on fastlock profiles
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef AD9361_HOP_H_
+#define AD9361_HOP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "ad9361.h"
+#include "no_os_gpio.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define AD9361_HOP_SLOTS	8
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct ad9361_hop_init_param
+ * @brief Hop table initialization parameters.
+ */
+struct ad9361_hop_init_param {
+	/** Hop the TX synthesizer instead of the RX one */
+	bool tx;
+	/** LO frequencies of the table (Hz) */
+	const uint64_t *lo_freq_hz;
+	/** Number of LO frequencies */
+	uint32_t nb_freqs;
+	/**
+	 * Optional GPIOs wired to the 3 fastlock profile select pins, LSB
+	 * first. Used instead of SPI to switch profiles when the synthesizer
+	 * is in fastlock pin control mode (adi,*x-fastlock-pincontrol-enable).
+	 */
+	struct no_os_gpio_desc_array *profile_gpios;
+};
+
+/**
+ * @struct ad9361_hop_entry
+ * @brief Cached synthesizer settings of a LO frequency.
+ */
+struct ad9361_hop_entry {
+	/** LO frequency (Hz) */
+	uint64_t lo_freq_hz;
+	/** Fastlock profile values, VCO calibration results included */
+	uint8_t values[RX_FAST_LOCK_CONFIG_WORD_NUM];
+	/** Fastlock slot holding the entry, -1 if none */
+	int8_t slot;
+};
+
+/**
+ * @struct ad9361_hop_table
+ * @brief Hop table descriptor.
+ */
+struct ad9361_hop_table {
+	/** AD9361 state structure */
+	struct ad9361_rf_phy *phy;
+	/** TX synthesizer table */
+	bool tx;
+	/** Profile select GPIOs, may be NULL */
+	struct no_os_gpio_desc_array *profile_gpios;
+	/** Table entries */
+	struct ad9361_hop_entry *entries;
+	/** Number of entries */
+	uint32_t nb_entries;
+	/** Entry held by each fastlock slot, -1 if none */
+	int32_t slot_entry[AD9361_HOP_SLOTS];
+	/** Next slot to reuse */
+	uint32_t next_slot;
+	/** Entry of the active profile, -1 if none */
+	int32_t current;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Tune and calibrate each frequency once and cache its profile values. */
+int32_t ad9361_hop_init(struct ad9361_hop_table **table,
+			struct ad9361_rf_phy *phy,
+			const struct ad9361_hop_init_param *param);
+/* Load an entry in a fastlock slot, without switching to it. */
+int32_t ad9361_hop_preload(struct ad9361_hop_table *table, uint32_t entry,
+			   uint32_t *slot);
+/* Switch the synthesizer to an entry of the table. */
+int32_t ad9361_hop_to(struct ad9361_hop_table *table, uint32_t entry);
+/* Free the resources allocated by ad9361_hop_init(). */
+int32_t ad9361_hop_remove(struct ad9361_hop_table *table);
+
+#endif // AD9361_HOP_H_
@@ -1641,6 +1641,46 @@ static int get_filter_fir_config(void *device, char *buf, uint32_t len,
 			ad9361_phy->tx_fir_ntaps, ad9361_phy->tx_fir_int);
 }
 
+/**
+ * @brief get_filter_fir_coefficients().
+ * The loaded filters in the format written to filter_fir_config. The value
+ * is generated again for each chunk sent, reading the coefficients back.
+ * @param device - Physical instance of a iio_axi_adc device.
+ * @param w - Writer of the value.
+ * @param channel - Channel properties.
+ * @return 0 in case of success, negative value on failure.
+ */
+static int get_filter_fir_coefficients(void *device, struct iio_writer *w,
+				       const struct iio_ch_info *channel,
+				       intptr_t priv)
+{
+	struct ad9361_rf_phy *ad9361_phy = (struct ad9361_rf_phy *)device;
+	AD9361_RXFIRConfig rx_fir;
+	AD9361_TXFIRConfig tx_fir;
+	uint32_t i, ntaps;
+	int32_t ret;
+
+	ret = ad9361_get_rx_fir_config(ad9361_phy, 0, &rx_fir);
+	if (ret < 0)
+		return ret;
+
+	ret = ad9361_get_tx_fir_config(ad9361_phy, 0, &tx_fir);
+	if (ret < 0)
+		return ret;
+
+	iio_writer_printf(w, "RX 3 GAIN %"PRIi32" DEC %"PRIu32"\n",
+			  rx_fir.rx_gain, rx_fir.rx_dec);
+	iio_writer_printf(w, "TX 3 GAIN %"PRIi32" INT %"PRIu32"\n",
+			  tx_fir.tx_gain, tx_fir.tx_int);
+
+	ntaps = no_os_max(rx_fir.rx_coef_size, tx_fir.tx_coef_size);
+	for (i = 0; i < ntaps; i++)
+		iio_writer_printf(w, "%"PRIi16",%"PRIi16"\n",
+				  tx_fir.tx_coef[i], rx_fir.rx_coef[i]);
+
+	return w->err;
+}
+
 /**
  * @brief get_calib_mode().
  * @param device - Physical instance of a iio_axi_adc device.
@@ -2162,6 +2202,10 @@ static struct iio_attribute global_attributes[] = {
 		.show = get_filter_fir_config,
 		.store = set_filter_fir_config,
 	},
+	{
+		.name = "filter_fir_coefficients",
+		.show_stream = get_filter_fir_coefficients,
+	},
 	{
 		.name = "calib_mode",
 		.show = get_calib_mode,
@@ -59,11 +59,19 @@ struct hmc630x_vco {
 	uint8_t entries;
 };
 
+/* Synthesizer rows of a VCO frequency, as left by hmc630x_set_vco() once locked. */
+struct hmc630x_channel {
+	uint8_t fbdiv_row;
+	uint8_t bandsel_row;
+	bool valid;
+};
+
 /* Device descriptor created by hmc6300_init() and used by the rest of the driver API. */
 struct hmc630x_dev {
 	enum hmc630x_type type;
 	uint8_t address;
 	struct hmc630x_vco vco;
+	struct hmc630x_channel *channels;
 	struct no_os_gpio_desc *en;
 	struct no_os_gpio_desc *clk;
 	struct no_os_gpio_desc *data;
@@ -232,6 +240,12 @@ int hmc630x_init(struct hmc630x_dev **dev, struct hmc630x_init_param *init)
 			goto error;
 	}
 
+	if (init->enabled && init->channel_table) {
+		ret = hmc630x_build_channel_table(d);
+		if (ret)
+			goto error;
+	}
+
 	if (init->enabled) {
 		ret = hmc630x_set_vco(d, init->vco);
 		if (ret)
@@ -249,6 +263,7 @@ error_3:
 error_2:
 	no_os_gpio_remove(d->en);
 error_1:
+	no_os_free(d->channels);
 	no_os_free(d->vco.freqs);
 	no_os_free(d->vco.fbdiv);
 error_0:
@@ -265,6 +280,8 @@ int hmc630x_remove(struct hmc630x_dev *dev)
 	dev->vco.freqs = NULL;
 	no_os_free(dev->vco.fbdiv);
 	dev->vco.fbdiv = NULL;
+	no_os_free(dev->channels);
+	dev->channels = NULL;
 
 	ret = no_os_gpio_remove(dev->en);
 	if (ret)
@@ -867,6 +884,120 @@ int hmc630x_get_avail_vco(struct hmc630x_dev *dev, const uint64_t **avail,
 	return 0;
 }
 
+/* Lock the synthesizer once on every available VCO frequency and keep the resulting
+ * FBDIV and VCO_BANDSEL rows, so hmc630x_set_channel() can skip the band search.
+ * The chip must be enabled. The frequency in use before the call is restored.
+ */
+int hmc630x_build_channel_table(struct hmc630x_dev *dev)
+{
+	struct hmc630x_channel *channels;
+	uint64_t vco;
+	uint8_t e;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	ret = hmc630x_get_vco(dev, &vco);
+	if (ret)
+		return ret;
+
+	channels = (struct hmc630x_channel *)no_os_calloc(dev->vco.entries,
+			sizeof(*channels));
+	if (!channels)
+		return -ENOMEM;
+
+	for (e = 0; e < dev->vco.entries; e++) {
+		/* Frequencies the PLL can't lock on stay unavailable as channels. */
+		if (hmc630x_set_vco(dev, dev->vco.freqs[e]))
+			continue;
+
+		ret = hmc630x_read_row(dev, HMC630X_ROW(HMC630X_FBDIV_CODE),
+				       &channels[e].fbdiv_row);
+		if (ret)
+			goto error;
+
+		ret = hmc630x_read_row(dev, HMC630X_ROW(HMC630X_VCO_BANDSEL),
+				       &channels[e].bandsel_row);
+		if (ret)
+			goto error;
+
+		channels[e].valid = true;
+	}
+
+	no_os_free(dev->channels);
+	dev->channels = channels;
+
+	if (!vco)
+		return 0;
+
+	return hmc630x_set_vco(dev, vco);
+error:
+	no_os_free(channels);
+	return ret;
+}
+
+/* Switch to the VCO frequency of index channel of the available frequencies, by
+ * writing its two synthesizer rows from the channel table and checking the lock.
+ */
+int hmc630x_set_channel(struct hmc630x_dev *dev, uint8_t channel)
+{
+	struct hmc630x_channel *c;
+	uint8_t lock;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->channels)
+		return -ENODATA;
+
+	if (channel >= dev->vco.entries || !dev->channels[channel].valid)
+		return -EINVAL;
+
+	c = &dev->channels[channel];
+
+	ret = hmc630x_write_row(dev, HMC630X_ROW(HMC630X_FBDIV_CODE), c->fbdiv_row);
+	if (ret)
+		return ret;
+
+	ret = hmc630x_write_row(dev, HMC630X_ROW(HMC630X_VCO_BANDSEL), c->bandsel_row);
+	if (ret)
+		return ret;
+
+	no_os_mdelay(HMC6300_SETTLING_DELAY_MS);
+
+	ret = hmc630x_read(dev, HMC630X_LOCKDET, &lock);
+	if (ret)
+		return ret;
+
+	return lock ? 0 : -EFAULT;
+}
+
+/* Get the index of the VCO frequency in use, -ENODATA if the PLL is not locked. */
+int hmc630x_get_channel(struct hmc630x_dev *dev, uint8_t *channel)
+{
+	uint64_t vco;
+	uint8_t e;
+	int ret;
+
+	if (!dev || !channel)
+		return -EINVAL;
+
+	ret = hmc630x_get_vco(dev, &vco);
+	if (ret)
+		return ret;
+
+	for (e = 0; e < dev->vco.entries; e++) {
+		if (vco && vco == dev->vco.freqs[e]) {
+			*channel = e;
+			return 0;
+		}
+	}
+
+	return -ENODATA;
+}
+
 /* Set the receiver LNA gain. */
 int hmc6301_set_lna_gain(struct hmc630x_dev *dev, enum hmc6301_lna_attn gain)
 {
@@ -308,6 +308,8 @@ struct hmc630x_init_param {
 		scanout; /* SCANOUT GPIO signal of the digital interface. */
 	bool enabled;
 	bool temp_en;
+	/* Build the channel table at init, needs enabled. */
+	bool channel_table;
 	uint64_t vco;
 	uint8_t if_attn;
 	union {
@@ -344,6 +346,9 @@ int hmc630x_set_vco(struct hmc630x_dev *dev, uint64_t frequency);
 int hmc630x_get_vco(struct hmc630x_dev *dev, uint64_t *frequency);
 int hmc630x_get_avail_vco(struct hmc630x_dev *dev, const uint64_t **avail,
 			  uint8_t *avail_num);
+int hmc630x_build_channel_table(struct hmc630x_dev *dev);
+int hmc630x_set_channel(struct hmc630x_dev *dev, uint8_t channel);
+int hmc630x_get_channel(struct hmc630x_dev *dev, uint8_t *channel);
 
 /* hmc6300-only API. */
 int hmc6300_set_fm_en(struct hmc630x_dev *dev, bool enable);
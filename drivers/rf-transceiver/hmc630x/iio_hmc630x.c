@@ -83,6 +83,7 @@ static int hmc630x_iio_read_attr(void *device, char *buf,
 	uint8_t attn;
 	uint8_t band;
 	uint8_t lock;
+	uint8_t ch;
 	enum hmc6301_lna_attn lna_attn;
 	enum hmc6301_bb_attn attn1, attn2;
 	enum hmc6301_bb_attn_fine attni, attnq;
@@ -118,6 +119,13 @@ static int hmc630x_iio_read_attr(void *device, char *buf,
 
 		val = lock;
 		break;
+	case HMC630X_IIO_ATTR_CHANNEL:
+		ret = hmc630x_get_channel(d, &ch);
+		if (ret)
+			return ret;
+
+		val = ch;
+		break;
 	case HMC630X_IIO_ATTR_IF_ATTN:
 		ret = hmc630x_get_if_attn(d, &attn);
 		if (ret)
@@ -210,6 +218,12 @@ static int hmc630x_iio_write_attr(void *device, char *buf,
 	case HMC630X_IIO_ATTR_VCO:
 		ret = hmc630x_set_vco(d, (uint64_t)val * 1000);
 		break;
+	case HMC630X_IIO_ATTR_CHANNEL:
+		if (val < 0 || val > UINT8_MAX)
+			return -EINVAL;
+
+		ret = hmc630x_set_channel(d, (uint8_t)val);
+		break;
 	case HMC630X_IIO_ATTR_IF_ATTN:
 		ret = hmc630x_set_if_attn(d, (uint8_t)val);
 		break;
@@ -357,6 +371,12 @@ static struct iio_channel hmc630x_channels[] = {
 		.priv = HMC630X_IIO_ATTR_VCO_LOCK, \
 		.show = hmc630x_iio_read_attr, \
 	}, \
+	{ \
+		.name = "channel", \
+		.priv = HMC630X_IIO_ATTR_CHANNEL, \
+		.show = hmc630x_iio_read_attr, \
+		.store = hmc630x_iio_write_attr, \
+	}, \
 	{ \
 		.name = "if_attn", \
 		.priv = HMC630X_IIO_ATTR_IF_ATTN, \
@@ -58,6 +58,7 @@ enum hmc630x_iio_attr_id {
 	HMC630X_IIO_ATTR_VCO_AVAILABLE,
 	HMC630X_IIO_ATTR_VCO_BAND,
 	HMC630X_IIO_ATTR_VCO_LOCK,
+	HMC630X_IIO_ATTR_CHANNEL,
 	HMC630X_IIO_ATTR_IF_ATTN,
 	HMC6300_IIO_ATTR_RF_ATTN,
 	HMC6301_IIO_ATTR_RF_LNA_GAIN,
@@ -16,6 +16,7 @@
 #include "adrv9025.h"
 #include "jesd204.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 static int __adrv9025_dev_err(struct adrv9025_rf_phy *phy, const char *function,
@@ -1098,3 +1099,100 @@ int adrv9025_remove(struct adrv9025_rf_phy *phy)
 
 	return 0;
 }
+
+/* Names of the tracking cals, by bit of their ADI_ADRV9025_TRACK_* mask */
+const char * const adrv9025_track_cal_names[NO_OS_TRACK_CAL_MAX] = {
+	"rx1_qec", "rx2_qec", "rx3_qec", "rx4_qec",
+	"orx1_qec", "orx2_qec", "orx3_qec", "orx4_qec",
+	"tx1_lol", "tx2_lol", "tx3_lol", "tx4_lol",
+	"tx1_qec", "tx2_qec", "tx3_qec", "tx4_qec",
+	"tx1_dpd", "tx2_dpd", "tx3_dpd", "tx4_dpd",
+	"tx1_clgc", "tx2_clgc", "tx3_clgc", "tx4_clgc",
+	"tx1_vswr", "tx2_vswr", "tx3_vswr", "tx4_vswr",
+	"rx1_hd2", "rx2_hd2", "rx3_hd2", "rx4_hd2",
+};
+
+/* State of each tracking cal, by bit of its mask */
+static const size_t adrv9025_track_cal_state[NO_OS_TRACK_CAL_MAX] = {
+	offsetof(adi_adrv9025_TrackingCalState_t, rx1Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx2Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx3Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx4Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, orx1Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, orx2Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, orx3Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, orx4Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx1Lol),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx2Lol),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx3Lol),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx4Lol),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx1Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx2Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx3Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx4Qec),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx1Dpd),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx2Dpd),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx3Dpd),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx4Dpd),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx1Clgc),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx2Clgc),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx3Clgc),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx4Clgc),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx1Vswr),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx2Vswr),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx3Vswr),
+	offsetof(adi_adrv9025_TrackingCalState_t, tx4Vswr),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx1Hd2),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx2Hd2),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx3Hd2),
+	offsetof(adi_adrv9025_TrackingCalState_t, rx4Hd2),
+};
+
+/*
+ * The ARM has no pause command for the tracking cals, they are held off by
+ * disabling them. Each call is an ARM mailbox command, keep the scheduling
+ * windows well above its duration.
+ */
+static int adrv9025_track_cal_run(void *dev, uint32_t mask, bool run)
+{
+	struct adrv9025_rf_phy *phy = dev;
+	int ret;
+
+	ret = adi_adrv9025_TrackingCalsEnableSet(phy->madDevice, mask,
+			run ? ADI_ADRV9025_TRACKING_CAL_ENABLE :
+			ADI_ADRV9025_TRACKING_CAL_DISABLE);
+	if (ret)
+		return adrv9025_dev_err(phy);
+
+	return 0;
+}
+
+/* A cal is busy while its main function is executing */
+static int adrv9025_track_cal_status(void *dev, uint32_t *busy, uint32_t *err)
+{
+	struct adrv9025_rf_phy *phy = dev;
+	adi_adrv9025_TrackingCalState_t state;
+	uint8_t *cal;
+	uint32_t i;
+	int ret;
+
+	ret = adi_adrv9025_TrackingCalAllStateGet(phy->madDevice, &state);
+	if (ret)
+		return adrv9025_dev_err(phy);
+
+	*busy = 0;
+	for (i = 0; i < NO_OS_TRACK_CAL_MAX; i++) {
+		cal = (uint8_t *)&state + adrv9025_track_cal_state[i];
+		if (*cal & ADI_ADRV9025_TRACKINGCAL_RUNNING)
+			*busy |= NO_OS_BIT(i);
+	}
+	*err = (uint32_t)state.calError;
+
+	return 0;
+}
+
+/* Tracking cal scheduling of an adrv9025, dev is its adrv9025_rf_phy. */
+const struct no_os_track_cal_ops adrv9025_track_cal_ops = {
+	.run = adrv9025_track_cal_run,
+	.status = adrv9025_track_cal_status,
+};
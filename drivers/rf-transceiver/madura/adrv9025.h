@@ -29,6 +29,7 @@
 #include "no_os_platform.h"
 #include "no_os_mutex.h"
 #include "no_os_clk.h"
+#include "no_os_track_cal.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -127,4 +128,7 @@ adi_adrv9025_SpiSettings_t *adrv9025_spi_settings_get(void);
 
 int adrv9025_post_setup(struct adrv9025_rf_phy *phy);
 
+extern const char * const adrv9025_track_cal_names[NO_OS_TRACK_CAL_MAX];
+extern const struct no_os_track_cal_ops adrv9025_track_cal_ops;
+
 #endif
@@ -37,7 +37,10 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
+#include "no_os_alloc.h"
 #include "no_os_util.h"
 #include "no_os_print_log.h"
 #include "no_os_delay.h"
@@ -998,3 +1001,183 @@ int adrv9002_setup(struct adrv9002_rf_phy *phy)
 
 	return adrv9002_dgpio_config(phy);
 }
+
+/*
+ * Frequency hopping. The profile must have fhModeOn set and phy->fh must hold the hopping
+ * configuration before adrv9002_setup(), since the init calibrations cover the frequency,
+ * gain and attenuation ranges of phy->fh. Any LO of that range can then be loaded in the hop
+ * tables and switched to at a hop edge, with no re-initialization of the device.
+ */
+static int adrv9002_fh_check(const struct adrv9002_rf_phy *phy,
+			     const adi_adrv9001_FhHopSignal_e hop,
+			     const adi_adrv9001_FhHopTable_e table)
+{
+	if (!phy->curr_profile->sysConfig.fhModeOn)
+		return -EOPNOTSUPP;
+
+	if (hop > ADI_ADRV9001_FH_HOP_SIGNAL_2 || table > ADI_ADRV9001_FHHOPTABLE_B)
+		return -EINVAL;
+
+	return 0;
+}
+
+int adrv9002_fh_table_load(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			   const adi_adrv9001_FhHopTable_e table,
+			   adi_adrv9001_FhHopFrame_t *frames, const uint32_t n_frames)
+{
+	uint32_t f;
+	int ret;
+
+	ret = adrv9002_fh_check(phy, hop, table);
+	if (ret)
+		return ret;
+
+	if (!frames || !n_frames || n_frames > ADI_ADRV9001_FH_MAX_HOP_TABLE_SIZE)
+		return -EINVAL;
+
+	for (f = 0; f < n_frames; f++) {
+		if (frames[f].hopFrequencyHz < phy->fh.minOperatingFrequency_Hz ||
+		    frames[f].hopFrequencyHz > phy->fh.maxOperatingFrequency_Hz) {
+			pr_err("Hop frequency %llu out of the calibrated range [%llu %llu]\n",
+			       (unsigned long long)frames[f].hopFrequencyHz,
+			       (unsigned long long)phy->fh.minOperatingFrequency_Hz,
+			       (unsigned long long)phy->fh.maxOperatingFrequency_Hz);
+			return -EINVAL;
+		}
+	}
+
+	return api_call(phy, adi_adrv9001_fh_HopTable_Static_Configure, phy->fh.mode, hop, table,
+			frames, n_frames);
+}
+
+/*
+ * One hop frame per line, as in the tables of the linux driver:
+ *	<hop_freq_hz>,<rx1_offset_hz>,<rx2_offset_hz>,<rx_gain_idx>,<tx_atten_mdb>
+ * Lines not starting with a digit, e.g. a header or a comment, are skipped.
+ */
+static int adrv9002_fh_parse_frame(const char *line, adi_adrv9001_FhHopFrame_t *frame)
+{
+	long long vals[ADRV9002_FH_TABLE_COL_SZ];
+	const char *p = line;
+	char *end;
+	int c;
+
+	for (c = 0; c < ADRV9002_FH_TABLE_COL_SZ; c++) {
+		vals[c] = strtoll(p, &end, 10);
+		if (end == p)
+			return -EINVAL;
+		p = end;
+		while (*p == ' ' || *p == '\t')
+			p++;
+		if (c < ADRV9002_FH_TABLE_COL_SZ - 1 && *p++ != ',')
+			return -EINVAL;
+	}
+
+	if (vals[0] < (long long)ADI_ADRV9001_FH_MIN_CARRIER_FREQUENCY_HZ ||
+	    vals[0] > (long long)ADI_ADRV9001_FH_MAX_CARRIER_FREQUENCY_HZ ||
+	    vals[1] < INT32_MIN || vals[1] > INT32_MAX ||
+	    vals[2] < INT32_MIN || vals[2] > INT32_MAX ||
+	    vals[3] < ADRV9002_RX_MIN_GAIN_IDX || vals[3] > ADRV9002_RX_MAX_GAIN_IDX ||
+	    vals[4] < 0 || vals[4] > 41800)
+		return -EINVAL;
+
+	frame->hopFrequencyHz = vals[0];
+	frame->rx1OffsetFrequencyHz = vals[1];
+	frame->rx2OffsetFrequencyHz = vals[2];
+	frame->rx1GainIndex = vals[3];
+	frame->rx2GainIndex = vals[3];
+	/* 0.2dB steps */
+	frame->tx1Attenuation_fifthdB = vals[4] / 200;
+	frame->tx2Attenuation_fifthdB = vals[4] / 200;
+
+	return 0;
+}
+
+int adrv9002_fh_table_parse(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			    const adi_adrv9001_FhHopTable_e table, const char *csv)
+{
+	adi_adrv9001_FhHopFrame_t *frames;
+	uint32_t n_frames = 0;
+	const char *line = csv;
+	int ret;
+
+	ret = adrv9002_fh_check(phy, hop, table);
+	if (ret)
+		return ret;
+
+	if (!csv)
+		return -EINVAL;
+
+	frames = no_os_calloc(ADI_ADRV9001_FH_MAX_HOP_TABLE_SIZE, sizeof(*frames));
+	if (!frames)
+		return -ENOMEM;
+
+	while (*line) {
+		while (*line == ' ' || *line == '\t' || *line == '\r' || *line == '\n')
+			line++;
+
+		if (*line >= '0' && *line <= '9') {
+			if (n_frames == ADI_ADRV9001_FH_MAX_HOP_TABLE_SIZE) {
+				pr_err("More than %u hop frames\n", ADI_ADRV9001_FH_MAX_HOP_TABLE_SIZE);
+				ret = -E2BIG;
+				goto out;
+			}
+
+			ret = adrv9002_fh_parse_frame(line, &frames[n_frames]);
+			if (ret) {
+				pr_err("Invalid hop frame %u\n", n_frames);
+				goto out;
+			}
+			n_frames++;
+		}
+
+		line = strchr(line, '\n');
+		if (!line)
+			break;
+	}
+
+	ret = adrv9002_fh_table_load(phy, hop, table, frames, n_frames);
+out:
+	no_os_free(frames);
+
+	return ret;
+}
+
+int adrv9002_fh_table_select(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			     const adi_adrv9001_FhHopTable_e table)
+{
+	int ret;
+
+	ret = adrv9002_fh_check(phy, hop, table);
+	if (ret)
+		return ret;
+
+	return api_call(phy, adi_adrv9001_fh_HopTable_Set, hop, table);
+}
+
+int adrv9002_fh_hop(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop)
+{
+	int ret;
+
+	ret = adrv9002_fh_check(phy, hop, ADI_ADRV9001_FHHOPTABLE_A);
+	if (ret)
+		return ret;
+
+	return api_call(phy, adi_adrv9001_fh_Hop, hop);
+}
+
+int adrv9002_fh_frame_get(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			  const adi_adrv9001_FhFrameIndex_e index,
+			  adi_adrv9001_FhHopFrame_t *frame)
+{
+	int ret;
+
+	ret = adrv9002_fh_check(phy, hop, ADI_ADRV9001_FHHOPTABLE_A);
+	if (ret)
+		return ret;
+
+	if (!frame)
+		return -EINVAL;
+
+	return api_call(phy, adi_adrv9001_fh_FrameInfo_Inspect, hop, index, frame);
+}
@@ -315,6 +315,19 @@ uint32_t adrv9002_axi_dds_rate_get(const struct adrv9002_rf_phy *phy,
 
 struct adi_adrv9001_SpiSettings *adrv9002_spi_settings_get(void);
 
+/* Frequency hopping API's, the tables are switched at the hop edges with no re-init */
+int adrv9002_fh_table_load(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			   const adi_adrv9001_FhHopTable_e table,
+			   adi_adrv9001_FhHopFrame_t *frames, const uint32_t n_frames);
+int adrv9002_fh_table_parse(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			    const adi_adrv9001_FhHopTable_e table, const char *csv);
+int adrv9002_fh_table_select(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			     const adi_adrv9001_FhHopTable_e table);
+int adrv9002_fh_hop(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop);
+int adrv9002_fh_frame_get(struct adrv9002_rf_phy *phy, const adi_adrv9001_FhHopSignal_e hop,
+			  const adi_adrv9001_FhFrameIndex_e index,
+			  adi_adrv9001_FhHopFrame_t *frame);
+
 
 static inline void adrv9002_sync_gpio_toogle(const struct adrv9002_rf_phy *phy)
 {
@@ -47,6 +47,7 @@
 #include "no_os_delay.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -60,6 +61,7 @@
 
 #define CMD0_RETRY_NUMBER		(5u)
 #define WAIT_RESP_TIMEOUT		(1000u) //1000ms
+#define FAST_POLL_NUMBER		(512u)  //Bytes polled before sleeping
 
 #define R1_READY_STATE			(0x00u)
 #define R1_IDLE_STATE			(0x01u)
@@ -87,6 +89,10 @@
 #define MASK_RESPONSE_TOKEN		(0x0Eu)
 #define MASK_ERROR_TOKEN		(0xF0u)
 
+#define CSD_TRAN_SPEED			(3u)
+#define MASK_TRAN_SPEED_UNIT		(0x07u)
+#define MASK_TRAN_SPEED_VALUE		(0x78u)
+
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -100,23 +106,21 @@
  */
 static int32_t wait_for_response(struct sd_desc *sd_desc, uint8_t *data_out)
 {
-	uint32_t	not_timeout;
-	int32_t		ret;
+	uint32_t	i;
 
-	ret = -1;
-	not_timeout = WAIT_RESP_TIMEOUT;
-	do {
+	/* Most responses come within a few bytes, only sleep after that */
+	for (i = 0; i < FAST_POLL_NUMBER + WAIT_RESP_TIMEOUT; i++) {
+		*data_out = 0xFF;
 		if (0 != no_os_spi_write_and_read(sd_desc->spi_desc,
 						  data_out, 1))
-			break;
-		if (*data_out != 0xFF) {
-			ret = 0;
-			break;
-		}
-		no_os_mdelay(1);
-	} while (not_timeout--);
+			return -1;
+		if (*data_out != 0xFF)
+			return 0;
+		if (i >= FAST_POLL_NUMBER)
+			no_os_mdelay(1);
+	}
 
-	return ret;
+	return -1;
 }
 
 /**
@@ -126,24 +130,60 @@ static int32_t wait_for_response(struct sd_desc *sd_desc, uint8_t *data_out)
  */
 static int32_t wait_until_not_busy(struct sd_desc *sd_desc)
 {
-	uint32_t	not_timeout;
-	int32_t		ret;
+	uint32_t	i;
 	uint8_t		data;
 
-	ret = -1;
-	not_timeout = WAIT_RESP_TIMEOUT;
-	do {
+	for (i = 0; i < FAST_POLL_NUMBER + WAIT_RESP_TIMEOUT; i++) {
 		data = 0xFF;
 		if (0 != no_os_spi_write_and_read(sd_desc->spi_desc, &data, 1))
-			break;
-		if (data != 0x00) {
-			ret = 0;
-			break;
-		}
-		no_os_mdelay(1);
-	} while (not_timeout--);
+			return -1;
+		if (data != 0x00)
+			return 0;
+		if (i >= FAST_POLL_NUMBER)
+			no_os_mdelay(1);
+	}
+
+	return -1;
+}
+
+/**
+ * Transfer a chain of messages, with DMA if the platform supports it
+ * @param sd_desc	- Instance of the SD card
+ * @param msgs		- Messages to be transferred
+ * @param len		- Number of messages
+ * @return 0 in case of success, -1 otherwise.
+ */
+static int32_t transfer(struct sd_desc *sd_desc, struct no_os_spi_msg *msgs,
+			uint32_t len)
+{
+	int32_t ret;
+
+	ret = no_os_spi_transfer_dma_sync(sd_desc->spi_desc, msgs, len);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_transfer(sd_desc->spi_desc, msgs, len);
 
-	return ret;
+	return ret ? -1 : 0;
+}
+
+/**
+ * Get the maximum SPI clock of the card from the TRAN_SPEED field of the CSD
+ * @param csd	- CSD register
+ * @return Clock in Hz
+ */
+static uint32_t get_max_speed_hz(const uint8_t *csd)
+{
+	/* Time values multiplied by 10 and rate units divided by 10 */
+	static const uint8_t	value[16] = {
+		0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80
+	};
+	static const uint32_t	unit[4] = {10000, 100000, 1000000, 10000000};
+	uint8_t			tran_speed = csd[CSD_TRAN_SPEED];
+
+	if ((tran_speed & MASK_TRAN_SPEED_UNIT) >= NO_OS_ARRAY_SIZE(unit))
+		return 0;
+
+	return unit[tran_speed & MASK_TRAN_SPEED_UNIT] *
+	       value[no_os_field_get(MASK_TRAN_SPEED_VALUE, tran_speed)];
 }
 
 /**
@@ -176,7 +216,8 @@ static int32_t send_command(struct sd_desc *sd_desc, struct cmd_desc *cmd_desc)
 		cmd_desc_local.response_len = R1_LEN;
 		if (0 != send_command(sd_desc, &cmd_desc_local))
 			return -1;
-		if (cmd_desc_local.response[0] != R1_IDLE_STATE) {
+		/* Idle during initialization, ready afterwards */
+		if (cmd_desc_local.response[0] & ~R1_IDLE_STATE) {
 			DEBUG_MSG("Not the expected response for CMD55\n");
 			return -1;
 		}
@@ -221,18 +262,25 @@ static int32_t send_command(struct sd_desc *sd_desc, struct cmd_desc *cmd_desc)
 static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
 			   uint32_t nb_of_blocks)
 {
-	/* Send start block token */
+	struct no_os_spi_msg	msgs[3] = {0};
+
+	/* Send start block token, data and CRC in one transfer */
 	sd_desc->buff[0] = START_N_BLOCK_TOKEN;
 	if (nb_of_blocks == 1)
 		sd_desc->buff[0] = START_1_BLOCK_TOKEN;
-	if (0 != no_os_spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, 1))
-		return -1;
-
-	/* Send data with CRC */
-	if (0 != no_os_spi_write_and_read(sd_desc->spi_desc, data, DATA_BLOCK_LEN))
-		return -1;
-	*((uint16_t *)sd_desc->buff) = 0xFFFF;
-	if (0 != no_os_spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CRC_LEN))
+	sd_desc->buff[1] = 0xFF;
+	sd_desc->buff[2] = 0xFF;
+	msgs[0].tx_buff = sd_desc->buff;
+	msgs[0].rx_buff = sd_desc->buff;
+	msgs[0].bytes_number = 1;
+	msgs[1].tx_buff = data;
+	msgs[1].rx_buff = sd_desc->dummy;
+	msgs[1].bytes_number = DATA_BLOCK_LEN;
+	msgs[2].tx_buff = sd_desc->buff + 1;
+	msgs[2].rx_buff = sd_desc->buff + 1;
+	msgs[2].bytes_number = CRC_LEN;
+	msgs[2].cs_change = 1;
+	if (0 != transfer(sd_desc, msgs, NO_OS_ARRAY_SIZE(msgs)))
 		return -1;
 
 	/* Read response and check if write was ok */
@@ -266,8 +314,10 @@ static int32_t write_block(struct sd_desc *sd_desc, uint8_t *data,
  */
 static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data)
 {
+	struct no_os_spi_msg	msgs[2] = {0};
+	uint8_t			response;
+
 	/* Reading Start block token */
-	uint8_t	response;
 	if (0 != wait_for_response(sd_desc, &response))
 		return -1;
 	if ((response & MASK_ERROR_TOKEN) == 0) {
@@ -296,14 +346,17 @@ static int32_t read_block(struct sd_desc *sd_desc, uint8_t *data)
 		return -1;
 	}
 
-	/* Read data block */
+	/* Read data block and crc in one transfer */
 	memset(data, 0xff, DATA_BLOCK_LEN);
-	if (0 != no_os_spi_write_and_read(sd_desc->spi_desc, data, DATA_BLOCK_LEN))
-		return -1;
-
-	/* Read crc*/
 	*((uint16_t *)sd_desc->buff) = 0xFFFF;
-	if (0 != no_os_spi_write_and_read(sd_desc->spi_desc, sd_desc->buff, CRC_LEN))
+	msgs[0].tx_buff = data;
+	msgs[0].rx_buff = data;
+	msgs[0].bytes_number = DATA_BLOCK_LEN;
+	msgs[1].tx_buff = sd_desc->buff;
+	msgs[1].rx_buff = sd_desc->buff;
+	msgs[1].bytes_number = CRC_LEN;
+	msgs[1].cs_change = 1;
+	if (0 != transfer(sd_desc, msgs, NO_OS_ARRAY_SIZE(msgs)))
 		return -1;
 
 	return 0;
@@ -491,6 +544,17 @@ int32_t sd_write(struct sd_desc *sd_desc, uint8_t *data, uint64_t address,
 		sd_read(sd_desc, last_block, (address + len - 1) & MASK_BLOCK_NUMBER,
 			DATA_BLOCK_LEN);
 
+	/* Let the card pre-erase the blocks of a multiple block write */
+	if (get_nb_of_blocks(address, len) != 1) {
+		cmd_desc.cmd = ACMD(23);
+		cmd_desc.arg = get_nb_of_blocks(address, len) & 0x7FFFFFu;
+		cmd_desc.response_len = R1_LEN;
+		if (0 != send_command(sd_desc, &cmd_desc))
+			return -1;
+		if (cmd_desc.response[0] != R1_READY_STATE)
+			DEBUG_MSG("Pre-erase not accepted\n");
+	}
+
 	/* Send write command to SD */
 	cmd_desc.cmd = (get_nb_of_blocks(address, len) == 1) ? CMD(24): CMD(25);
 	cmd_desc.arg = address >> DATA_BLOCK_BITS; //Address of first block
@@ -623,6 +687,20 @@ int32_t sd_init(struct sd_desc **sd_desc, const struct sd_init_param *param)
 			  local_desc->buff[9];
 	local_desc->memory_size = ((uint64_t)c_size + 1) *
 				  ((uint64_t)DATA_BLOCK_LEN << 10u);
+	local_desc->max_speed_hz = get_max_speed_hz(local_desc->buff);
+
+	/* Switch the data transfers to the fastest clock the card supports */
+	if (param->fast_spi_init) {
+		struct no_os_spi_init_param	fast_spi_init = *param->fast_spi_init;
+
+		if (local_desc->max_speed_hz &&
+		    (!fast_spi_init.max_speed_hz ||
+		     fast_spi_init.max_speed_hz > local_desc->max_speed_hz))
+			fast_spi_init.max_speed_hz = local_desc->max_speed_hz;
+		if (0 != no_os_spi_init(&local_desc->fast_spi_desc, &fast_spi_init))
+			goto failure;
+		local_desc->spi_desc = local_desc->fast_spi_desc;
+	}
 
 	*sd_desc = local_desc;
 
@@ -642,6 +720,9 @@ int32_t sd_remove(struct sd_desc *desc)
 	if (desc == NULL)
 		return -1;
 
+	if (desc->fast_spi_desc && 0 != no_os_spi_remove(desc->fast_spi_desc))
+		return -1;
+
 	no_os_free(desc);
 	return 0;
 }
@@ -85,6 +85,12 @@
 struct sd_init_param {
 	/** Descriptor of an initialized SPI channel */
 	struct no_os_spi_desc *spi_desc;
+	/**
+	 * Optional, SPI channel used for the data transfers once the card is
+	 * initialized. Its max_speed_hz is limited to the card maximum, 0
+	 * selecting the card maximum.
+	 */
+	const struct no_os_spi_init_param *fast_spi_init;
 };
 
 /**
@@ -94,12 +100,18 @@ struct sd_init_param {
 struct sd_desc {
 	/** Descriptor of an initialized SPI channel */
 	struct no_os_spi_desc	*spi_desc;
+	/** Descriptor created from fast_spi_init, NULL if not used */
+	struct no_os_spi_desc	*fast_spi_desc;
+	/** Maximum SPI clock of the card, from the CSD register */
+	uint32_t	max_speed_hz;
 	/** Memory size of the SD card in bytes */
 	uint64_t	memory_size;
 	/** 1 if SD card is HC or XC, 0 otherwise */
 	uint8_t		high_capacity;
 	/** Buffer used for the driver implementation */
 	uint8_t		buff[18];
+	/** Receives the MISO bytes while a data block is written */
+	uint8_t		dummy[DATA_BLOCK_LEN];
 };
 
 /**
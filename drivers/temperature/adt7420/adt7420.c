@@ -452,6 +452,7 @@ int adt7420_i2c_reg_read(struct adt7420_dev *dev, uint16_t register_address,
 			 uint16_t *data)
 {
 	uint8_t data_buffer[3] = { 0, 0 };
+	uint8_t reg = register_address;
 	uint8_t num_bytes;
 
 	if (no_os_field_get(ADT7320_L16, register_address))
@@ -459,10 +460,7 @@ int adt7420_i2c_reg_read(struct adt7420_dev *dev, uint16_t register_address,
 	else
 		num_bytes = 1;
 
-	if (no_os_i2c_write(dev->i2c_desc, &register_address, 1,
-			    0)) //add a repeat start
-		return -1;
-	if (no_os_i2c_read(dev->i2c_desc, data_buffer, num_bytes, 1))
+	if (no_os_i2c_write_read(dev->i2c_desc, &reg, 1, data_buffer, num_bytes))
 		return -1;
 
 	if (num_bytes == 1)
@@ -484,3 +482,57 @@ bool adt7420_is_spi(struct adt7420_dev *dev)
 {
 	return (chip_info[dev->active_device].communication == SPI);
 }
+
+/***************************************************************************//**
+ * @brief Start a one-shot conversion, for no_os_temp_scan.
+ *
+ * @param dev     - The device structure.
+ * @param conv_us - Conversion time, in us.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int adt7420_temp_scan_start(void *dev, uint32_t *conv_us)
+{
+	int ret;
+
+	ret = adt7420_set_operation_mode(dev, ADT7420_OP_MODE_ONE_SHOT);
+	if (ret)
+		return ret;
+
+	*conv_us = ADT7420_ONE_SHOT_DELAY_MS * 1000;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Read the temperature in millidegree Celsius, for no_os_temp_scan.
+ *
+ * @param dev - The device structure.
+ * @param val - Temperature, in millidegree Celsius.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int adt7420_temp_scan_read(void *dev, int32_t *val)
+{
+	struct adt7420_dev *adt = dev;
+	uint16_t temp;
+	int ret;
+
+	ret = adt7420_reg_read(adt, adt7420_is_spi(adt) ? ADT7320_REG_TEMP :
+			       ADT7420_REG_TEMP_MSB, &temp);
+	if (ret)
+		return ret;
+
+	if (adt->resolution_setting)
+		*val = (int32_t)(int16_t)temp * 1000 / ADT7420_16BIT_DIV;
+	else
+		*val = no_os_sign_extend32(temp >> 3, 12) * 1000 /
+		       ADT7420_13BIT_DIV;
+
+	return 0;
+}
+
+const struct no_os_temp_scan_ops adt7420_temp_scan_ops = {
+	.start = adt7420_temp_scan_start,
+	.read = adt7420_temp_scan_read,
+};
@@ -46,6 +46,7 @@
 #include "no_os_spi.h"
 #include "no_os_i2c.h"
 #include "no_os_util.h"
+#include "no_os_temp_scan.h"
 #include <stdbool.h>
 
 /******************************************************************************/
@@ -117,6 +118,9 @@
 
 #define ADT7420_RESET_DELAY 		1
 
+/* One-shot conversion time, in ms */
+#define ADT7420_ONE_SHOT_DELAY_MS	240
+
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -169,6 +173,9 @@ struct adt7420_init_param {
 
 extern const struct adt7420_chip_info chip_info[];
 
+/* no_os_temp_scan operations, one-shot conversions in millidegree Celsius */
+extern const struct no_os_temp_scan_ops adt7420_temp_scan_ops;
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
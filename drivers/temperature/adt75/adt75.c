@@ -178,3 +178,64 @@ int adt75_remove(struct adt75_desc *desc)
 
 	return 0;
 }
+
+/**
+ * @brief Start a one-shot conversion, for no_os_temp_scan.
+ * @param dev - The device structure.
+ * @param conv_us - Conversion time, in us.
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adt75_temp_scan_start(void *dev, uint32_t *conv_us)
+{
+	struct adt75_desc *desc = dev;
+	uint8_t reg = ADT75_ONE_SHOT_REG;
+	uint16_t conf;
+	int ret;
+
+	ret = adt75_reg_read(desc, ADT75_CONF_REG, &conf);
+	if (ret)
+		return ret;
+
+	if (!(conf & ADT75_ONESHOT_MASK)) {
+		ret = adt75_reg_write(desc, ADT75_CONF_REG,
+				      conf | ADT75_ONESHOT_MASK);
+		if (ret)
+			return ret;
+	}
+
+	/** Writing the one-shot register address starts the conversion */
+	ret = no_os_i2c_write(desc->comm_desc, &reg, 1, 1);
+	if (ret)
+		return ret;
+
+	*conv_us = ADT75_CONV_DELAY_MS * 1000;
+
+	return 0;
+}
+
+/**
+ * @brief Read the temperature, for no_os_temp_scan.
+ * @param dev - The device structure.
+ * @param val - Temperature, in millidegree Celsius.
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adt75_temp_scan_read(void *dev, int32_t *val)
+{
+	uint16_t reg_val;
+	int ret;
+
+	ret = adt75_reg_read(dev, ADT75_TEMP_VALUE_REG, &reg_val);
+	if (ret)
+		return ret;
+
+	reg_val = no_os_field_get(ADT75_TEMP_MASK, reg_val);
+	*val = no_os_sign_extend32(reg_val, ADT75_SIGN_BIT);
+	*val *= MILLIDEGREE_PER_DEGREE / ADT75_TEMP_DIV;
+
+	return 0;
+}
+
+const struct no_os_temp_scan_ops adt75_temp_scan_ops = {
+	.start = adt75_temp_scan_start,
+	.read = adt75_temp_scan_read,
+};
@@ -41,6 +41,7 @@
 
 #include <stdint.h>
 #include "no_os_i2c.h"
+#include "no_os_temp_scan.h"
 
 /** x is set based on the value of A2, A1, A0 pins */
 #define ADT75_ADDR(x)		(0x48 + (x))
@@ -95,6 +96,12 @@ int adt75_reg_read(struct adt75_desc *, uint32_t, uint16_t *);
 /** Write a register values */
 int adt75_reg_write(struct adt75_desc *, uint32_t, uint16_t);
 
+/**
+ * no_os_temp_scan operations, one-shot conversions in millidegree Celsius.
+ * The first conversion switches the device to one-shot mode.
+ */
+extern const struct no_os_temp_scan_ops adt75_temp_scan_ops;
+
 /** Initialize the device structure */
 int adt75_init(struct adt75_desc **, struct adt75_init_param *);
 
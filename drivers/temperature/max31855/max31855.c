@@ -49,6 +49,80 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/*
+ * NIST ITS-90 type K tables, from tools/scripts/pwl_table.py. Cold junction
+ * voltage from the internal temperature code (-56 to 128 C, 1.1 uV max error)
+ * and temperature from the thermocouple voltage (0.32 C max error at -200 C,
+ * 0.015 C above -50 C).
+ */
+static const int32_t max31855_k_uv_lut[24] = {
+	-2103, -1818, -1527, -1231, -930, -624,
+	-314, 0, 317, 637, 960, 1285,
+	1612, 1941, 2271, 2602, 2934, 3267,
+	3599, 3931, 4262, 4591, 4920, 5247,
+};
+
+static const struct no_os_scale_lut max31855_k_uv = {
+	.y = max31855_k_uv_lut,
+	.nb = NO_OS_ARRAY_SIZE(max31855_k_uv_lut),
+	.x0 = -896,
+	.shift = 7,
+};
+
+static const int32_t max31855_k_temp_lut[240] = {
+	-218746, -199777, -184433, -171081, -159041, -147952,
+	-137589, -127805, -118494, -109578, -100998, -92706,
+	-84665, -76843, -69215, -61759, -54455, -47289,
+	-40247, -33316, -26487, -19750, -13097, -6517,
+	0, 6464, 12880, 19253, 25586, 31884,
+	38150, 44389, 50604, 56800, 62981, 69151,
+	75315, 81477, 87642, 93813, 99994, 106190,
+	112404, 118637, 124891, 131169, 137470, 143795,
+	150140, 156506, 162889, 169285, 175691, 182104,
+	188519, 194932, 201339, 207738, 214126, 220500,
+	226859, 233202, 239527, 245836, 252127, 258402,
+	264660, 270903, 277131, 283346, 289547, 295737,
+	301916, 308085, 314243, 320393, 326534, 332667,
+	338793, 344911, 351022, 357127, 363225, 369317,
+	375403, 381483, 387557, 393625, 399689, 405747,
+	411800, 417849, 423893, 429933, 435968, 442000,
+	448027, 454052, 460073, 466091, 472106, 478119,
+	484130, 490139, 496146, 502151, 508156, 514159,
+	520162, 526165, 532167, 538170, 544174, 550178,
+	556183, 562189, 568197, 574207, 580219, 586234,
+	592251, 598272, 604295, 610322, 616353, 622388,
+	628427, 634471, 640519, 646572, 652631, 658695,
+	664765, 670840, 676922, 683010, 689104, 695205,
+	701313, 707429, 713551, 719681, 725818, 731964,
+	738117, 744278, 750447, 756625, 762811, 769006,
+	775209, 781422, 787643, 793873, 800113, 806361,
+	812619, 818887, 825164, 831450, 837746, 844052,
+	850368, 856693, 863029, 869374, 875729, 882095,
+	888470, 894856, 901252, 907659, 914075, 920503,
+	926940, 933389, 939848, 946317, 952798, 959289,
+	965791, 972305, 978829, 985365, 991912, 998471,
+	1005042, 1011624, 1018218, 1024824, 1031442, 1038073,
+	1044716, 1051373, 1058042, 1064724, 1071420, 1078130,
+	1084853, 1091591, 1098343, 1105110, 1111892, 1118689,
+	1125503, 1132332, 1139177, 1146039, 1152919, 1159815,
+	1166730, 1173663, 1180614, 1187584, 1194574, 1201583,
+	1208613, 1215663, 1222734, 1229827, 1236941, 1244077,
+	1251235, 1258417, 1265621, 1272849, 1280100, 1287375,
+	1294674, 1301997, 1309344, 1316716, 1324111, 1331531,
+	1338974, 1346442, 1353932, 1361445, 1368981, 1376538,
+};
+
+static const struct no_os_scale_lut max31855_k_temp = {
+	.y = max31855_k_temp_lut,
+	.nb = NO_OS_ARRAY_SIZE(max31855_k_temp_lut),
+	.x0 = -6144,
+	.shift = 8,
+};
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -74,9 +148,18 @@ int max31855_init(struct max31855_dev **device,
 	if (ret)
 		goto spi_err;
 
+	descriptor->linearize = init_param->linearize;
+	/* 1 LSB of the thermocouple code is 4 LSBs of the internal code */
+	ret = no_os_scale_set(&descriptor->uv_scale, MAX31855K_SEEBECK_NV,
+			      MAX31855_INTERNAL_TEMP_DEC_DIV * 1000, 0);
+	if (ret)
+		goto scale_err;
+
 	*device = descriptor;
 
 	return 0;
+scale_err:
+	no_os_spi_remove(descriptor->comm_desc);
 spi_err:
 	no_os_free(descriptor);
 
@@ -164,3 +247,100 @@ int max31855_read_temp(struct max31855_dev *device,
 
 	return 0;
 }
+
+/**
+ * @brief Correct a reading with the NIST type K tables. The device assumes a
+ *	  constant sensitivity, so its thermocouple temperature is converted
+ *	  back to the thermocouple voltage, the voltage of the cold junction is
+ *	  added and the sum converted to a temperature.
+ * @param device - MAX31855 descriptor
+ * @param raw - Raw register value
+ * @return Thermocouple temperature, in millidegree Celsius
+ */
+static int32_t max31855_linearize(struct max31855_dev *device, uint32_t raw)
+{
+	int32_t t_code, i_code;
+	int32_t uv;
+
+	t_code = no_os_sign_extend32(MAX31855_GET_THERMOCOUPLE_TEMP(raw),
+				     MAX31855_THERMOCOUPLE_TEMP_SIGN_POS);
+	i_code = no_os_sign_extend32(MAX31855_GET_INTERNAL_TEMP(raw),
+				     MAX31855_INTERNAL_TEMP_SIGN_POS);
+
+	uv = no_os_scale_apply(&device->uv_scale,
+			       t_code * (MAX31855_INTERNAL_TEMP_DEC_DIV /
+					 MAX31855_THERMOCOUPLE_TEMP_DEC_DIV) - i_code);
+	uv += no_os_scale_lut_apply(&max31855_k_uv, i_code);
+
+	return no_os_scale_lut_apply(&max31855_k_temp, uv);
+}
+
+/**
+ * @brief Read the thermocouple temperature of a MAX31855K, corrected with the
+ *	  NIST type K tables instead of the linear conversion of the device.
+ * @param device - MAX31855 descriptor
+ * @param milli_c - Thermocouple temperature, in millidegree Celsius
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max31855_read_temp_lin(struct max31855_dev *device, int32_t *milli_c)
+{
+	uint32_t buff;
+	int ret;
+
+	if (!device || !milli_c)
+		return -EINVAL;
+
+	ret = max31855_read_raw(device, &buff);
+	if (ret)
+		return ret;
+
+	*milli_c = max31855_linearize(device, buff);
+
+	return 0;
+}
+
+/**
+ * @brief Nothing to start, the device converts continuously.
+ * @param dev - MAX31855 descriptor
+ * @param conv_us - Set to 0
+ * @return 0
+ */
+static int max31855_temp_scan_start(void *dev, uint32_t *conv_us)
+{
+	*conv_us = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Read the thermocouple temperature, for no_os_temp_scan.
+ * @param dev - MAX31855 descriptor
+ * @param val - Thermocouple temperature, in millidegree Celsius
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int max31855_temp_scan_read(void *dev, int32_t *val)
+{
+	struct max31855_dev *device = dev;
+	uint32_t buff;
+	int ret;
+
+	ret = max31855_read_raw(device, &buff);
+	if (ret)
+		return ret;
+
+	if (device->linearize) {
+		*val = max31855_linearize(device, buff);
+		return 0;
+	}
+
+	*val = no_os_sign_extend32(MAX31855_GET_THERMOCOUPLE_TEMP(buff),
+				   MAX31855_THERMOCOUPLE_TEMP_SIGN_POS);
+	*val *= 1000 / MAX31855_THERMOCOUPLE_TEMP_DEC_DIV;
+
+	return 0;
+}
+
+const struct no_os_temp_scan_ops max31855_temp_scan_ops = {
+	.start = max31855_temp_scan_start,
+	.read = max31855_temp_scan_read,
+};
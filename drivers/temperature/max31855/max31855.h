@@ -45,8 +45,11 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_util.h"
+#include "no_os_scale.h"
+#include "no_os_temp_scan.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -68,11 +71,16 @@
 #define MAX31855_THERMOCOUPLE_TEMP_SIGN_POS	13
 #define MAX31855_INTERNAL_TEMP_SIGN_POS		11
 
+/* Sensitivity the MAX31855K assumes for its linear conversion, in nV/C */
+#define MAX31855K_SEEBECK_NV			41276
+
 /**
  * @brief MAX31855 comm init param
  */
 struct max31855_init_param {
 	struct no_os_spi_init_param spi_init;
+	/** MAX31855K only: correct the readings with the NIST type K tables */
+	bool linearize;
 };
 
 /**
@@ -103,6 +111,9 @@ union max31855_fault_sts {
 struct max31855_dev {
 	struct no_os_spi_desc *comm_desc;
 	union max31855_fault_sts fault;
+	bool linearize;
+	/** (4 * thermocouple - internal) code to thermocouple voltage in uV */
+	struct no_os_scale uv_scale;
 };
 
 /** Device and comm init function */
@@ -111,6 +122,13 @@ int max31855_init(struct max31855_dev **, struct max31855_init_param *);
 /** Free resources allocated by the init function */
 int max31855_remove(struct max31855_dev *);
 
+/**
+ * no_os_temp_scan operations. The device converts continuously, the
+ * thermocouple temperature is read in millidegree Celsius, corrected when
+ * linearize is set.
+ */
+extern const struct no_os_temp_scan_ops max31855_temp_scan_ops;
+
 /** Read raw register value */
 int max31855_read_raw(struct max31855_dev *, uint32_t *);
 
@@ -118,4 +136,7 @@ int max31855_read_raw(struct max31855_dev *, uint32_t *);
 int max31855_read_temp(struct max31855_dev *, struct max31855_decimal *,
 		       struct max31855_decimal *);
 
+/** Read the thermocouple temperature corrected with the NIST type K tables */
+int max31855_read_temp_lin(struct max31855_dev *, int32_t *);
+
 #endif
@@ -51,6 +51,45 @@
 #include "no_os_alloc.h"
 #include "no_os_delay.h"
 
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/*
+ * IEC 60751 Callendar-Van Dusen inverse from tools/scripts/pwl_table.py,
+ * -200 to 850 C with a 6.3 mC max error.
+ */
+static const int32_t max31865_rtd_lut[121] = {
+	-206677, -199468, -192215, -184918, -177580, -170201,
+	-162783, -155327, -147834, -140305, -132742, -125146,
+	-117519, -109860, -102172, -94456, -86713, -78943,
+	-71148, -63329, -55487, -47623, -39736, -31829,
+	-23901, -15953, -7986, 0, 8005, 16030,
+	24073, 32136, 40218, 48320, 56441, 64583,
+	72744, 80926, 89128, 97350, 105593, 113857,
+	122141, 130447, 138774, 147123, 155493, 163885,
+	172298, 180734, 189192, 197673, 206176, 214702,
+	223251, 231824, 240419, 249038, 257681, 266348,
+	275039, 283755, 292495, 301259, 310049, 318864,
+	327705, 336571, 345463, 354381, 363325, 372296,
+	381294, 390318, 399370, 408450, 417557, 426693,
+	435857, 445049, 454270, 463520, 472800, 482109,
+	491449, 500818, 510218, 519649, 529111, 538605,
+	548130, 557688, 567278, 576900, 586556, 596245,
+	605969, 615726, 625517, 635344, 645206, 655103,
+	665037, 675007, 685013, 695057, 705139, 715259,
+	725417, 735614, 745851, 756128, 766444, 776802,
+	787201, 797642, 808125, 818651, 829221, 839834,
+	850492,
+};
+
+static const struct no_os_scale_lut max31865_rtd = {
+	.y = max31865_rtd_lut,
+	.nb = NO_OS_ARRAY_SIZE(max31865_rtd_lut),
+	.x0 = 1280,
+	.shift = 8,
+};
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -88,10 +127,22 @@ int max31865_init(struct max31865_dev **device,
 		/* additional 1mS/1000uS delay (1-Shot section)  */
 		descriptor->t_rc_delay += 1000;
 
+	if (init_param->rref && init_param->r0) {
+		/* code = R / Rref * 2^15, R / R0 in Q13 = code * Rref / (4 * R0) */
+		ret = no_os_scale_set(&descriptor->ratio_scale, init_param->rref,
+				      4 * init_param->r0, 0);
+		if (ret)
+			goto err_scale;
+
+		descriptor->lut = init_param->lut ? init_param->lut : &max31865_rtd;
+	}
+
 	*device = descriptor;
 
 	return 0;
 
+err_scale:
+	no_os_spi_remove(descriptor->comm_desc);
 err:
 	no_os_free(descriptor);
 
@@ -432,3 +483,109 @@ int max31865_read_rtd(struct max31865_dev *device, uint16_t *rtd_reg)
 
 	return max31865_enable_bias(device, false);
 }
+
+/**
+ * @brief Convert an RTD code to a temperature, with a piecewise linear table
+ *	  instead of solving the Callendar-Van Dusen equation
+ * @param device MAX31865 descriptor, initialized with rref and r0
+ * @param rtd_code 15-bit RTD code
+ * @param milli_c Temperature in millidegree Celsius
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max31865_rtd_to_temp(struct max31865_dev *device, uint16_t rtd_code,
+			 int32_t *milli_c)
+{
+	if (!device || !device->lut || !milli_c)
+		return -EINVAL;
+
+	*milli_c = no_os_scale_lut_apply(device->lut,
+					 no_os_scale_apply(&device->ratio_scale,
+							 rtd_code));
+
+	return 0;
+}
+
+/**
+ * @brief Read the RTD temperature in one shot mode
+ * @param device MAX31865 descriptor, initialized with rref and r0
+ * @param milli_c Temperature in millidegree Celsius
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max31865_read_temp(struct max31865_dev *device, int32_t *milli_c)
+{
+	uint16_t rtd_code;
+	int ret;
+
+	if (!device || !device->lut)
+		return -EINVAL;
+
+	ret = max31865_read_rtd(device, &rtd_code);
+	if (ret)
+		return ret;
+
+	return max31865_rtd_to_temp(device, rtd_code, milli_c);
+}
+
+/**
+ * @brief Bias the RTD and start a one-shot conversion, for no_os_temp_scan
+ * @param dev MAX31865 descriptor
+ * @param conv_us Conversion time including the bias settling, in us
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int max31865_temp_scan_start(void *dev, uint32_t *conv_us)
+{
+	struct max31865_dev *device = dev;
+	int ret;
+
+	ret = max31865_clear_fault(device);
+	if (ret)
+		return ret;
+
+	ret = max31865_enable_bias(device, true);
+	if (ret)
+		return ret;
+
+	ret = max31865_reg_update(device, MAX31865_CONFIG_REG, MAX31865_CONFIG_1SHOT,
+				  true);
+	if (ret)
+		return ret;
+
+	*conv_us = (device->is_filt_50 ? 62500 : 52000) + device->t_rc_delay;
+
+	return 0;
+}
+
+/**
+ * @brief Read the RTD code and remove the bias, for no_os_temp_scan
+ * @param dev MAX31865 descriptor
+ * @param val Temperature in millidegree Celsius, or the 15-bit RTD code when
+ *	      rref and r0 are not set
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int max31865_temp_scan_read(void *dev, int32_t *val)
+{
+	struct max31865_dev *device = dev;
+	uint8_t msb, lsb;
+	int ret;
+
+	ret = max31865_read(device, MAX31865_RTDMSB_REG, &msb);
+	if (ret)
+		return ret;
+
+	ret = max31865_read(device, MAX31865_RTDLSB_REG, &lsb);
+	if (ret)
+		return ret;
+
+	*val = ((msb << 8) | lsb) >> 1;
+	if (device->lut)
+		*val = no_os_scale_lut_apply(device->lut,
+					     no_os_scale_apply(&device->ratio_scale,
+							       *val));
+
+	return max31865_enable_bias(device, false);
+}
+
+const struct no_os_temp_scan_ops max31865_temp_scan_ops = {
+	.start = max31865_temp_scan_start,
+	.read = max31865_temp_scan_read,
+};
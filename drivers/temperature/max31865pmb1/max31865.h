@@ -48,6 +48,8 @@
 #include <stdbool.h>
 #include "no_os_spi.h"
 #include "no_os_util.h"
+#include "no_os_scale.h"
+#include "no_os_temp_scan.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -84,6 +86,10 @@ struct max31865_dev {
 	bool is_filt_50;
 	bool is_odd_wire;
 	int t_rc_delay;
+	/** RTD code to R / R0 in Q13, set when rref and r0 are known */
+	struct no_os_scale ratio_scale;
+	/** R / R0 in Q13 to millidegree Celsius, NULL when not known */
+	const struct no_os_scale_lut *lut;
 };
 
 /**
@@ -93,8 +99,21 @@ struct max31865_dev {
 struct max31865_init_param {
 	struct no_os_spi_init_param spi_init;
 	float rtd_rc;
+	/** Reference resistor in ohms, 0 when temperatures are not needed */
+	uint32_t rref;
+	/** RTD resistance at 0 C in ohms, e.g. 100 for a PT100 */
+	uint32_t r0;
+	/** R / R0 in Q13 to millidegree Celsius table, NULL for the IEC 60751 one */
+	const struct no_os_scale_lut *lut;
 };
 
+/**
+ * no_os_temp_scan operations, one-shot conversions. The value read is the
+ * temperature in millidegree Celsius when rref and r0 are set, the 15-bit RTD
+ * code of max31865_read_rtd() otherwise.
+ */
+extern const struct no_os_temp_scan_ops max31865_temp_scan_ops;
+
 /** Device and comm init function */
 int max31865_init(struct max31865_dev **, struct max31865_init_param *);
 
@@ -140,4 +159,10 @@ int max31865_set_wires(struct max31865_dev *, bool);
 /** Read RTD **/
 int max31865_read_rtd(struct max31865_dev *, uint16_t *);
 
+/** Convert an RTD code to millidegree Celsius **/
+int max31865_rtd_to_temp(struct max31865_dev *, uint16_t, int32_t *);
+
+/** Read the RTD temperature in millidegree Celsius **/
+int max31865_read_temp(struct max31865_dev *, int32_t *);
+
 #endif // __MAX31865_H__
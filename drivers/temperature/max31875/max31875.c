@@ -187,3 +187,65 @@ int32_t max31875_remove(struct max31875_dev *dev)
 	return 0;
 }
 
+
+/**
+ * @brief Start a one-shot conversion, for no_os_temp_scan.
+ * @param [in] dev - Driver handler pointer.
+ * @param [out] conv_us - Conversion time at the configured resolution, in us.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int max31875_temp_scan_start(void *dev, uint32_t *conv_us)
+{
+	uint32_t conf;
+	int32_t ret;
+
+	ret = max31875_reg_read(dev, MAX31875_CONFIGURATION_REG, &conf);
+	if (ret)
+		return ret;
+
+	ret = max31875_reg_write(dev, MAX31875_CONFIGURATION_REG,
+				 conf | MAX31875_SHUTDOWN_MASK |
+				 MAX31875_ONESHOT_MASK);
+	if (ret)
+		return ret;
+
+	*conv_us = MAX31875_CONV_TIME_US(no_os_field_get(MAX31875_RESOLUTION_MASK,
+					 conf));
+
+	return 0;
+}
+
+/**
+ * @brief Read the temperature, for no_os_temp_scan.
+ * @param [in] dev - Driver handler pointer.
+ * @param [out] val - Temperature, in millidegree Celsius.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int max31875_temp_scan_read(void *dev, int32_t *val)
+{
+	uint32_t conf;
+	uint32_t temp;
+	int32_t ret;
+
+	ret = max31875_reg_read(dev, MAX31875_CONFIGURATION_REG, &conf);
+	if (ret)
+		return ret;
+
+	ret = max31875_reg_read(dev, MAX31875_TEMPERATURE_REG, &temp);
+	if (ret)
+		return ret;
+
+	/* 1/256 degree per LSB, 1/128 in the extended format */
+	*val = (int32_t)(int16_t)temp * 1000;
+	if (conf & MAX31875_DATA_FORMAT_MASK)
+		*val /= 128;
+	else
+		*val /= 256;
+
+	return 0;
+}
+
+const struct no_os_temp_scan_ops max31875_temp_scan_ops = {
+	.start = max31875_temp_scan_start,
+	.read = max31875_temp_scan_read,
+};
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include "no_os_i2c.h"
 #include "no_os_util.h"
+#include "no_os_temp_scan.h"
 
 /******************************************************************************/
 /************************** MAX31875 Definitions ******************************/
@@ -69,6 +70,9 @@
 #define MAX31875_CONVERSION_RATE_MASK	NO_OS_GENMASK(2, 1)
 #define MAX31875_ONESHOT_MASK		NO_OS_BIT(0)
 
+/** Conversion time of the 8, 9, 10 and 12-bit resolutions, in us */
+#define MAX31875_CONV_TIME_US(res)	(17500u << (res))
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -110,6 +114,13 @@ struct max31875_init_param {
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
 
+/**
+ * no_os_temp_scan operations, one-shot conversions in millidegree Celsius.
+ * The first conversion puts the device in shutdown mode, where it only
+ * converts when triggered.
+ */
+extern const struct no_os_temp_scan_ops max31875_temp_scan_ops;
+
 /** Read a device register through the I2C interface. */
 int32_t max31875_reg_read(struct max31875_dev *dev,
 			  uint32_t reg,
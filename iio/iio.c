@@ -53,7 +53,16 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_circular_buffer.h"
+#include "no_os_semaphore.h"
+#include "no_os_mutex.h"
+#include "no_os_timer.h"
+#include "no_os_profile.h"
+#include "no_os_counter.h"
+#include "no_os_bus_trace.h"
+#include "no_os_section.h"
+#include "no_os_work.h"
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -68,6 +77,10 @@
 #include "lwip_socket.h"
 #endif
 
+#ifdef IIO_COMPRESSION
+#include "iio_compress.h"
+#endif
+
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
@@ -75,8 +88,62 @@
 #define IIOD_PORT		30431
 #define MAX_SOCKET_TO_HANDLE	10
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
+#define COMPRESSION_ATTRIBUTE	"compression"
+#define COMPRESSION_AVAIL_ATTRIBUTE	"compression_available"
+#define PRETRIGGER_ATTRIBUTE	"pretrigger_samples"
+#define POSTTRIGGER_ATTRIBUTE	"posttrigger_samples"
+#define THRESHOLD_ATTRIBUTE	"trigger_threshold"
+#define CAPTURE_STATE_ATTRIBUTE	"capture_state"
+#define TRIGGER_EVENT_ATTRIBUTE	"trigger_event"
+/*
+ * Connection buffer of the UART links. Attributes with show_stream and, with
+ * IIO_XML_STREAM, the xml are sent in chunks of this size, so it only has to
+ * fit the other attribute values and the values written.
+ */
+#ifndef IIOD_CONN_BUFFER_SIZE
 #define IIOD_CONN_BUFFER_SIZE	0x1000
+#endif
 #define NO_TRIGGER				(uint32_t)-1
+/*
+ * Number of steps a connection can be skipped in favor of connections running
+ * higher priority commands before it is served.
+ */
+#ifndef IIO_MAX_CONN_SKIPS
+#define IIO_MAX_CONN_SKIPS	8
+#endif
+#ifndef IIO_MAX_BUFFERS_COUNT
+#define IIO_MAX_BUFFERS_COUNT	4
+#endif
+/* Alignment of the buffers taken from iio_init_param.buf_arena, for DMA */
+#ifndef IIO_BUF_ARENA_ALIGN
+#define IIO_BUF_ARENA_ALIGN	32
+#endif
+/*
+ * Bytes of look up indexes kept for all the devices, the least recently used
+ * ones being freed above it. 0 for no limit.
+ */
+#ifndef IIO_INDEX_BUDGET
+#define IIO_INDEX_BUDGET	0
+#endif
+
+/* Separator of the attribute names in batched reads and writes */
+#define IIO_ATTR_LIST_SEP	','
+#define IIO_DEV_ID_PREFIX	"iio:device"
+#define IIO_TRIG_ID_PREFIX	"trigger"
+
+/*
+ * Maximum time iio_step blocks waiting for network activity when there is no
+ * work, if the network interface supports socket_wait.
+ */
+#ifndef IIO_NET_WAIT_MS
+#define IIO_NET_WAIT_MS		100
+#endif
+/* Largest payload of a stream datagram which is not fragmented by IP */
+#define IIO_STREAM_MAX_PAYLOAD	(1500 - 28 - sizeof(struct iio_stream_hdr))
+/* Datagrams sent for each stream in a step, so that connections are served */
+#ifndef IIO_STREAM_MAX_DGRAMS
+#define IIO_STREAM_MAX_DGRAMS	8
+#endif
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -87,6 +154,7 @@
 
 static char uart_buff[IIOD_CONN_BUFFER_SIZE];
 
+#ifndef IIO_NO_XML_GEN
 static char header[] =
 	"<?xml version=\"1.0\" encoding=\"utf-8\"?>"
 	"<!DOCTYPE context ["
@@ -111,6 +179,7 @@ static char header[] =
 	NO_OS_TOSTRING(NO_OS_PROJECT)" "
 	NO_OS_TOSTRING(NO_OS_VERSION)"\" >";
 static char header_end[] = "</context>";
+#endif
 
 static const char * const iio_chan_type_string[] = {
 	[IIO_VOLTAGE] = "voltage",
@@ -129,6 +198,7 @@ static const char * const iio_chan_type_string[] = {
 	[IIO_COUNT] = "count",
 	[IIO_DELTA_ANGL] = "deltaangl",
 	[IIO_DELTA_VELOCITY] = "deltavelocity",
+	[IIO_TIMESTAMP] = "timestamp",
 };
 
 static const char * const iio_modifier_names[] = {
@@ -141,14 +211,91 @@ static const char * const iio_modifier_names[] = {
 	[IIO_MOD_ROLL] = "roll",
 };
 
+#ifdef IIO_COMPRESSION
+static const char * const iio_codec_names[] = {
+	[IIO_CODEC_NONE] = "none",
+	[IIO_CODEC_DELTA] = "delta",
+};
+#endif
+
 /* Parameters used in show and store functions */
 struct attr_fun_params {
 	void			*dev_instance;
 	char			*buf;
 	uint32_t			len;
 	struct iio_ch_info	*ch_info;
+	/* Offset of the chunk to read of a value generated by show_stream */
+	uint32_t		offset;
+	/* Size of the whole value generated by show_stream, 0 otherwise */
+	uint32_t		size;
+};
+
+#ifdef IIO_PRETRIGGER
+/* States of a capture around an event, see iio_buffer_history_fire() */
+enum iio_hist_state {
+	/* The buffer is streamed */
+	IIO_HIST_OFF,
+	/* The buffer is a ring of the last scans, waiting for the event */
+	IIO_HIST_ARMED,
+	/* Pushing the scans after the event */
+	IIO_HIST_TRIGGERED,
+	/* The capture is held for the clients, new scans are dropped */
+	IIO_HIST_FROZEN,
+};
+
+static const char * const iio_hist_state_names[] = {
+	[IIO_HIST_OFF] = "off",
+	[IIO_HIST_ARMED] = "armed",
+	[IIO_HIST_TRIGGERED] = "triggered",
+	[IIO_HIST_FROZEN] = "frozen",
+};
+
+/* Most event detectors of a buffer, one per channel */
+#define IIO_DET_MAX		4
+/* The energy is averaged over 2^IIO_DET_ENERGY_SHIFT scans */
+#define IIO_DET_ENERGY_SHIFT	3
+/* around a mean tracked over 2^IIO_DET_MEAN_SHIFT scans */
+#define IIO_DET_MEAN_SHIFT	6
+
+/* What a detector looks for in the scans of its channel */
+enum iio_det_kind {
+	/* The value goes at or above the level */
+	IIO_DET_RISING,
+	/* The value goes at or below the level */
+	IIO_DET_FALLING,
+	/* The value changes by level or more from one scan to the next */
+	IIO_DET_RATE,
+	/* The mean square of the AC part of the value goes above level */
+	IIO_DET_ENERGY,
+};
+
+static const char * const iio_det_kind_names[] = {
+	[IIO_DET_RISING] = "rising",
+	[IIO_DET_FALLING] = "falling",
+	[IIO_DET_RATE] = "rate",
+	[IIO_DET_ENERGY] = "energy",
 };
 
+struct iio_det {
+	uint32_t		ch;
+	enum iio_det_kind	kind;
+	int32_t			level;
+	/* Where the channel is in a scan, bytes is 0 if not enabled */
+	uint32_t		offset;
+	uint8_t			bytes;
+	bool			sign;
+	/* A scan was seen since the capture was armed */
+	bool			valid;
+	/* The condition held on the previous scan, events are its edges */
+	bool			active;
+	int32_t			prev;
+	/* Running mean << IIO_DET_MEAN_SHIFT */
+	int64_t			mean;
+	/* Mean square of the AC part << IIO_DET_ENERGY_SHIFT */
+	uint64_t		energy;
+};
+#endif
+
 struct iio_buffer_priv {
 	/* Field visible by user */
 	struct iio_buffer	public;
@@ -158,12 +305,90 @@ struct iio_buffer_priv {
 	int8_t			*raw_buf;
 	/* Length of raw_buf */
 	uint32_t		raw_buf_len;
+	/* Number of blocks requested with BUFFERS_COUNT */
+	uint32_t		buffers_count;
+	/* Timer used to timestamp the blocks. Can be NULL */
+	struct no_os_timer_desc	*ts_timer;
+	/* Time in nanoseconds when the previous block was done */
+	uint64_t		ts_last;
+	/* Offset of the timestamp in a scan or -1 if it is not enabled */
+	int32_t			ts_offset;
+	/* Block returned by the last iio_buffer_get_block() */
+	void			*block;
 	/* Set when this devices has buffer */
 	bool			initalized;
 	/* Set when no_os_calloc was used to initalize cb.buf */
 	bool			allocated;
+	/* Part of iio_desc.buf_arena used by cb.buf, NULL if none */
+	int8_t			*arena_buf;
+	uint32_t		arena_len;
+#ifdef IIO_PRETRIGGER
+	/* Scans kept before and after a capture event, both 0 to stream */
+	uint32_t		hist_pre;
+	uint32_t		hist_post;
+	enum iio_hist_state	hist_state;
+	/* Scans pushed since the capture was armed */
+	uint32_t		hist_seen;
+	/* Scans still to be pushed after the event */
+	uint32_t		hist_left;
+	/* Detectors signaling the capture events */
+	struct iio_det		det[IIO_DET_MAX];
+	uint32_t		nb_det;
+	/* Events that started a capture, the last one from det[det_last] */
+	uint32_t		det_events;
+	/* -1 for iio_buffer_history_fire() */
+	int32_t			det_last;
+#endif
+#ifdef NO_OS_PROFILING
+	/* Bytes pushed and read since the buffer was opened */
+	uint32_t		lat_in;
+	uint32_t		lat_out;
+	/* lat_in after the scan being timed, valid if lat_mark is set */
+	uint32_t		lat_pos;
+	/* no_os_get_cycles() when the timed scan was pushed */
+	uint32_t		lat_cycles;
+	bool			lat_mark;
+#endif
+};
+
+/* Hashes of the names used to look up channels and attributes of a device */
+struct iio_dev_index {
+	/* Storage for all the hashes below */
+	uint32_t		*hashes;
+	/* Hash of each channel id */
+	uint32_t		*ch;
+	/* Hashes of the attributes of each channel */
+	uint32_t		**ch_attrs;
+	/* Hashes of device, debug and buffer attributes */
+	uint32_t		*attrs;
+	uint32_t		*debug_attrs;
+	uint32_t		*buffer_attrs;
+	/* Bytes allocated for the index */
+	uint32_t		size;
+	/* Set once the index is built, even if the device has no names */
+	bool			valid;
+	/* Value of iio_desc.index_clock at the last look up */
+	uint32_t		used;
 };
 
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+/* Buffer data sent over UDP, started by the STREAM iiod command */
+struct iio_stream {
+	/* UDP socket to send the datagrams on */
+	struct tcp_socket_desc	*sock;
+	char			address[IIOD_STREAM_ADDR_LEN];
+	struct socket_address	to;
+	/* Sequence number of the next datagram */
+	uint32_t		seq;
+	/* Pending iio_stream_hdr flags */
+	uint16_t		flags;
+	/* Buffer data in each datagram, a multiple of the scan size */
+	uint32_t		payload;
+	/* Header followed by payload bytes */
+	uint8_t			*dgram;
+};
+#endif
+
 /**
  * @struct iio_dev_priv
  * @brief Links a physical device instance "void *dev_instance"
@@ -186,6 +411,51 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/* Next device using the same trigger or NO_TRIGGER */
+	uint32_t		trig_next;
+	/* Used for faster channel and attribute look up */
+	struct iio_dev_index	index;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	/* Set while the buffer data is streamed over UDP */
+	struct iio_stream	*stream;
+#endif
+	/* Block producer used instead of the buffer callbacks. Can be NULL */
+	struct no_os_ain_stream	*ain_stream;
+	/* Block held from ain_stream, NULL if none */
+	uint8_t			*ain_block;
+	/* Bytes of ain_block already sent */
+	uint32_t		ain_sent;
+	/* Bytes returned by the last iio_get_read_block() */
+	uint32_t		ain_pending;
+	/* Overruns of ain_stream already reported */
+	uint32_t		ain_overruns;
+	/* Buffer bytes exchanged with the clients, for NO_OS_COUNTERS */
+	struct no_os_counter	bytes;
+	/* Overruns reported to the clients, for NO_OS_COUNTERS */
+	struct no_os_counter	overruns;
+#ifdef IIO_COMPRESSION
+	/* Codec set by the client with the "compression" buffer attribute */
+	enum iio_codec		codec;
+	/* Codec of the opened buffer, IIO_CODEC_NONE if not compressed */
+	enum iio_codec		zcodec;
+	/* Layout of the scans of the opened buffer */
+	struct iio_compress_layout zlayout;
+	/* Raw scans waiting to be compressed */
+	uint8_t			*zraw;
+	uint32_t		zraw_len;
+	/* Scans compressed in one frame */
+	uint32_t		zscans;
+	/* Frames waiting to be sent */
+	uint8_t			*zbuf;
+	uint32_t		zbuf_size;
+	uint32_t		zlen;
+	/* Bytes of zbuf already sent */
+	uint32_t		zidx;
+	/* Bytes returned by the last iio_get_read_block() */
+	uint32_t		zpending;
+	/* Bytes of the READBUF left after the last iio_get_read_block() */
+	uint32_t		zleft;
+#endif
 };
 
 /**
@@ -202,8 +472,34 @@ struct iio_trig_priv {
 	void	*instance;
 	/** Trigger descriptor(describes type of trigger and its attributes) */
 	struct iio_trigger *descriptor;
-	/** Set to true when the triggering condition is met */
-	bool	triggered;
+	/** Posted when the triggering condition of an asynchronous trigger
+	 *  is met */
+	struct no_os_work work;
+	/** no_os_get_cycles() when the trigger was processed */
+	uint32_t event_cycles;
+	/** First device using this trigger or NO_TRIGGER, see trig_next */
+	uint32_t first_dev;
+};
+
+/* A link of the context and the ops used by its connections */
+struct iio_link_priv {
+	enum pysical_link_type	phy_type;
+	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
+	int (*send)(void *conn, uint8_t *buf, uint32_t len);
+	/* Zero copy receive, for network and transport connections */
+	int (*recv_nocopy)(void *conn, const void **buf, uint32_t len);
+	int (*recv_release)(void *conn, uint32_t len);
+	uint8_t			prio;
+	/* Connection buffer allocated by iio_init for a UART link */
+	char			*alloc_buf;
+};
+
+/* Position in the context xml of the description of a device or trigger */
+struct iio_xml_frag {
+	uint32_t	offset;
+	uint32_t	len;
+	/* Set when the description must be generated again */
+	bool		dirty;
 };
 
 struct iio_desc {
@@ -212,21 +508,48 @@ struct iio_desc {
 	void			*phy_desc;
 	char			*xml_desc;
 	uint32_t		xml_size;
+	/* Previous version of xml_desc, freed when the xml is updated again */
+	char			*xml_prev;
+	/* Position of each device and trigger in xml_desc */
+	struct iio_xml_frag	*xml_frags;
+	/* Set when at least one fragment must be generated again */
+	bool			xml_dirty;
 	struct iio_ctx_attr	*ctx_attrs;
 	uint32_t		nb_ctx_attr;
 	struct iio_dev_priv	*devs;
 	uint32_t		nb_devs;
+	/* Incremented on each look up, orders the device indexes by last use */
+	uint32_t		index_clock;
 	struct iio_trig_priv	*trigs;
 	uint32_t		nb_trigs;
-	struct no_os_uart_desc	*uart_desc;
-	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
-	int (*send)(void *conn, uint8_t *buf, uint32_t len);
+	/* Links served by the context, see iio_init_param.links */
+	struct iio_link_priv	*links;
+	uint32_t		nb_links;
+	/* Index in links of the link of each connection */
+	uint8_t			conn_link[IIOD_MAX_CONNECTIONS];
 	/* FIFO for socket descriptors */
 	struct no_os_circular_buffer	*conns;
+	/* Number of steps each connection was skipped by the scheduler */
+	uint32_t		conn_skips[IIOD_MAX_CONNECTIONS];
+	/* Semaphore to wait on when there is no work to do */
+	void			*wakeup_sem;
+	/* Sleep until an interrupt when there is no work to do */
+	void			(*idle)(void);
+	/* Set by iio_wakeup, makes the next idle call return right away */
+	volatile bool		wakeup_pending;
+	/* Timer used for the timestamp channels */
+	struct no_os_timer_desc	*ts_timer;
+	/* Memory shared by the buffers of the devices, see iio_init_param */
+	int8_t			*buf_arena;
+	uint32_t		buf_arena_len;
+	/* Deferred work run by iio_step, e.g. the asynchronous triggers */
+	struct no_os_workqueue	wq;
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 	struct tcp_socket_desc	*current_sock;
 	/* Instance of server socket */
 	struct tcp_socket_desc	*server;
+	/* Index in links of the network link */
+	uint8_t			net_link;
 #endif
 };
 
@@ -260,21 +583,48 @@ static inline int32_t _nb_active_conns(struct iio_desc *desc)
 }
 
 
+static inline struct iio_link_priv *_conn_link(struct iio_desc *desc,
+		uint32_t conn_id)
+{
+	return &desc->links[desc->conn_link[conn_id]];
+}
+
 static int iio_recv(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
 {
-	struct iio_desc *desc = ctx->instance;
+	struct iio_link_priv *link = _conn_link(ctx->instance, ctx->conn_id);
+
+	return link->recv(ctx->conn, buf, len);
+}
+
+static int iio_recv_nocopy(struct iiod_ctx *ctx, const uint8_t **buf,
+			   uint32_t len)
+{
+	struct iio_link_priv *link = _conn_link(ctx->instance, ctx->conn_id);
+
+	if (!link->recv_nocopy)
+		return -ENOSYS;
 
-	return desc->recv(ctx->conn, buf, len);
+	return link->recv_nocopy(ctx->conn, (const void **)buf, len);
+}
+
+static int iio_recv_release(struct iiod_ctx *ctx, uint32_t len)
+{
+	struct iio_link_priv *link = _conn_link(ctx->instance, ctx->conn_id);
+
+	if (!link->recv_release)
+		return -ENOSYS;
+
+	return link->recv_release(ctx->conn, len);
 }
 
 static int iio_send(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
 {
-	struct iio_desc *desc = ctx->instance;
+	struct iio_link_priv *link = _conn_link(ctx->instance, ctx->conn_id);
 
-	return desc->send(ctx->conn, buf, len);
+	return link->send(ctx->conn, buf, len);
 }
 
-static inline void _print_ch_id(char *buff, struct iio_channel *ch)
+static inline void _print_ch_id(char *buff, const struct iio_channel *ch)
 {
 	if(ch->modified) {
 		sprintf(buff, "%s_%s", iio_chan_type_string[ch->ch_type],
@@ -294,30 +644,226 @@ static inline void _print_ch_id(char *buff, struct iio_channel *ch)
 	}
 }
 
+/* FNV-1a hash of a string */
+static uint32_t iio_hash(const char *str)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*str) {
+		hash ^= (uint8_t)*str++;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static uint32_t iio_nb_attrs(const struct iio_attribute *attributes)
+{
+	uint32_t n = 0;
+
+	if (attributes)
+		while (attributes[n].name)
+			n++;
+
+	return n;
+}
+
+/* Store the hashes of the attribute names at hashes and return their count */
+static uint32_t iio_hash_attrs(const struct iio_attribute *attributes,
+			       uint32_t *hashes)
+{
+	uint32_t i;
+
+	for (i = 0; attributes && attributes[i].name; i++)
+		hashes[i] = iio_hash(attributes[i].name);
+
+	return i;
+}
+
+static void iio_free_dev_index(struct iio_dev_priv *dev)
+{
+	uint32_t used = dev->index.used;
+
+	no_os_free(dev->index.hashes);
+	no_os_free(dev->index.ch_attrs);
+	memset(&dev->index, 0, sizeof(dev->index));
+	dev->index.used = used;
+}
+
+/**
+ * @brief Compute the hashes of the channel ids and attribute names of a device.
+ * @param dev - Device.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_build_dev_index(struct iio_dev_priv *dev)
+{
+	struct iio_device *device = dev->dev_descriptor;
+	struct iio_dev_index *index = &dev->index;
+	char ch_id[MAX_CHN_ID];
+	uint32_t i, n, num_ch;
+	uint32_t *p;
+
+	iio_free_dev_index(dev);
+
+	num_ch = device->channels ? device->num_ch : 0;
+	n = num_ch + iio_nb_attrs(device->attributes) +
+	    iio_nb_attrs(device->debug_attributes) +
+	    iio_nb_attrs(device->buffer_attributes);
+	for (i = 0; i < num_ch; i++)
+		n += iio_nb_attrs(device->channels[i].attributes);
+
+	if (!n) {
+		index->valid = true;
+		return 0;
+	}
+
+	index->hashes = (uint32_t *)no_os_calloc(n, sizeof(*index->hashes));
+	if (!index->hashes)
+		return -ENOMEM;
+	index->size = n * sizeof(*index->hashes);
+
+	p = index->hashes;
+	if (num_ch) {
+		index->ch_attrs = (uint32_t **)no_os_calloc(num_ch,
+				  sizeof(*index->ch_attrs));
+		if (!index->ch_attrs) {
+			iio_free_dev_index(dev);
+			return -ENOMEM;
+		}
+		index->size += num_ch * sizeof(*index->ch_attrs);
+
+		index->ch = p;
+		for (i = 0; i < num_ch; i++) {
+			_print_ch_id(ch_id, &device->channels[i]);
+			index->ch[i] = iio_hash(ch_id);
+		}
+		p += num_ch;
+
+		for (i = 0; i < num_ch; i++) {
+			index->ch_attrs[i] = p;
+			p += iio_hash_attrs(device->channels[i].attributes, p);
+		}
+	}
+
+	index->attrs = p;
+	p += iio_hash_attrs(device->attributes, p);
+	index->debug_attrs = p;
+	p += iio_hash_attrs(device->debug_attributes, p);
+	index->buffer_attrs = p;
+	iio_hash_attrs(device->buffer_attributes, p);
+	index->valid = true;
+
+	return 0;
+}
+
+/* Free the index of the least recently used device other than dev */
+static bool iio_evict_dev_index(struct iio_desc *desc, struct iio_dev_priv *dev)
+{
+	struct iio_dev_priv *lru = NULL;
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		if (&desc->devs[i] == dev || !desc->devs[i].index.size)
+			continue;
+		if (!lru || (int32_t)(desc->devs[i].index.used - lru->index.used) < 0)
+			lru = &desc->devs[i];
+	}
+
+	if (!lru)
+		return false;
+
+	iio_free_dev_index(lru);
+
+	return true;
+}
+
+static uint32_t iio_index_bytes(struct iio_desc *desc)
+{
+	uint32_t i, size = 0;
+
+	for (i = 0; i < desc->nb_devs; i++)
+		size += desc->devs[i].index.size;
+
+	return size;
+}
+
+/**
+ * @brief Build the index of a device on its first look up. Indexes of the
+ * least recently used devices are freed when the memory runs out or when
+ * IIO_INDEX_BUDGET is exceeded, they are built again when needed. If the
+ * index can't be built, look ups fall back to comparing the names.
+ * @param desc - IIO descriptor.
+ * @param dev - Device being looked up.
+ */
+static void iio_use_dev_index(struct iio_desc *desc, struct iio_dev_priv *dev)
+{
+	int32_t ret;
+
+	dev->index.used = ++desc->index_clock;
+	if (dev->index.valid)
+		return;
+
+	ret = iio_build_dev_index(dev);
+	while (ret == -ENOMEM && iio_evict_dev_index(desc, dev))
+		ret = iio_build_dev_index(dev);
+
+	while (IIO_INDEX_BUDGET && iio_index_bytes(desc) > IIO_INDEX_BUDGET &&
+	       iio_evict_dev_index(desc, dev))
+		;
+}
+
 /**
  * @brief Get channel ID from a list of channels.
  * @param channel - Channel name.
- * @param desc - Device descriptor
+ * @param dev - Device
  * @param ch_out - If "true" is output channel, if "false" is input channel.
+ * @param ch_idx - Index of the channel in the device channels.
  * @return Channel ID, or negative value if attribute is not found.
  */
-static inline struct iio_channel *iio_get_channel(const char *channel,
-		struct iio_device *desc, bool ch_out)
+static inline const struct iio_channel *iio_get_channel(const char *channel,
+		struct iio_dev_priv *dev, bool ch_out, uint32_t *ch_idx)
 {
+	struct iio_device *desc = dev->dev_descriptor;
 	int16_t i = 0;
 	char	ch_id[MAX_CHN_ID];
+	uint32_t hash;
 
+	hash = iio_hash(channel);
 	while (i < desc->num_ch) {
+		/* Only print the id of channels with a matching hash */
+		if (dev->index.ch && dev->index.ch[i] != hash) {
+			i++;
+			continue;
+		}
 		_print_ch_id(ch_id, &desc->channels[i]);
 		if (!strcmp(channel, ch_id) &&
-		    (desc->channels[i].ch_out == ch_out))
+		    (desc->channels[i].ch_out == ch_out)) {
+			*ch_idx = i;
 			return &desc->channels[i];
+		}
 		i++;
 	}
 
 	return NULL;
 }
 
+/* Get the index from an id like "<prefix><index>". Returns -1 if not valid */
+static uint32_t iio_parse_id_index(const char *id, const char *prefix,
+				   uint32_t prefix_len)
+{
+	unsigned long idx;
+	char *end;
+
+	if (strncmp(id, prefix, prefix_len) || !isdigit((int)id[prefix_len]))
+		return (uint32_t)-1;
+
+	idx = strtoul(id + prefix_len, &end, 10);
+	if (*end != '\0')
+		return (uint32_t)-1;
+
+	return idx;
+}
+
 /**
  * @brief Find interface with "device_name".
  * @param device_name - Device name.
@@ -329,6 +875,12 @@ static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 {
 	uint32_t i;
 
+	/* Devices are registered as iio:device<index> */
+	i = iio_parse_id_index(device_name, IIO_DEV_ID_PREFIX,
+			       sizeof(IIO_DEV_ID_PREFIX) - 1);
+	if (i < desc->nb_devs && strcmp(desc->devs[i].dev_id, device_name) == 0)
+		return &desc->devs[i];
+
 	for (i = 0; i < desc->nb_devs; i++) {
 		if (strcmp(desc->devs[i].dev_id, device_name) == 0)
 			return &desc->devs[i];
@@ -337,6 +889,7 @@ static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 	return NULL;
 }
 
+#ifndef IIO_NO_TRIGGERS
 /**
  * @brief Find interface with "trigger_id".
  * @param trigger_id - Trigger id (trigger0, trigger1, etc.).
@@ -348,6 +901,11 @@ static struct iio_trig_priv *get_iio_trig_device(struct iio_desc *desc,
 {
 	uint32_t i;
 
+	i = iio_parse_id_index(trigger_id, IIO_TRIG_ID_PREFIX,
+			       sizeof(IIO_TRIG_ID_PREFIX) - 1);
+	if (i < desc->nb_trigs && strcmp(desc->trigs[i].id, trigger_id) == 0)
+		return &desc->trigs[i];
+
 	for (i = 0; i < desc->nb_trigs; i++) {
 		if (strcmp(desc->trigs[i].id, trigger_id) == 0)
 			return &desc->trigs[i];
@@ -356,1127 +914,3384 @@ static struct iio_trig_priv *get_iio_trig_device(struct iio_desc *desc,
 	return NULL;
 }
 
-/**
- * @brief Sets buffers count.
- * @param ctx           - IIO instance and conn instance.
- * @param device        - String containing device name.
- * @param buffers_count - Value to be set.
- * @return Positive if index was set, negative if not.
- */
-static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
-				 uint32_t buffers_count)
+/* Trigger selected for a device, NULL if none */
+static inline struct iio_trig_priv *iio_dev_trig(struct iio_desc *desc,
+		struct iio_dev_priv *dev)
 {
-	struct iio_desc *desc = ctx->instance;
+	if (dev->trig_idx == NO_TRIGGER)
+		return NULL;
 
-	if(!get_iio_device(desc, device))
-		return -ENODEV;
+	return &desc->trigs[dev->trig_idx];
+}
+#else
+static inline struct iio_trig_priv *iio_dev_trig(struct iio_desc *desc,
+		struct iio_dev_priv *dev)
+{
+	return NULL;
+}
+#endif
 
-	/* Our implementation uses a circular buffer to send/receive data so
-	 * only 1 is a valid value.
-	 */
-	if (buffers_count != 1)
-		return -EINVAL;
+#ifdef NO_OS_PROFILING
+#ifndef IIO_NO_TRIGGERS
+/* Latency from the trigger to the end of the device trigger handler */
+static uint32_t iio_trig_lat_hist[NO_OS_PROFILE_HIST_BINS];
+static struct no_os_profile iio_trig_lat =
+	NO_OS_PROFILE_INIT_HIST("iio_trig_to_push", iio_trig_lat_hist);
+#endif
 
-	return 0;
-}
+/* Latency from the push of a scan to its read by a client */
+static uint32_t iio_read_lat_hist[NO_OS_PROFILE_HIST_BINS];
+static struct no_os_profile iio_read_lat =
+	NO_OS_PROFILE_INIT_HIST("iio_push_to_read", iio_read_lat_hist);
 
 /**
- * @brief Read all attributes from an attribute list.
- * @param device - Physical instance of a device.
- * @param buf - Buffer where values are read.
- * @param len - Maximum length of value to be stored in buf.
- * @param channel - Channel properties.
- * @param attributes - List of attributes to be read.
- * @return Number of bytes read or negative value in case of error.
+ * @brief Called at each stage of the path from a trigger to the client, e.g.
+ * to toggle a GPIO watched with a logic analyzer. Does nothing by default.
+ * @param stage - Stage reached.
  */
-static int iio_read_all_attr(struct attr_fun_params *params,
-			     struct iio_attribute *attributes)
+__attribute__((weak)) void iio_latency_mark(enum iio_latency_stage stage)
 {
-	/* TODO Not sure if working corectly */
-	return -EINVAL;
+}
 
-#if 0
-	int16_t i = 0, j = 0;
-	char local_buf[256];
-	int attr_length;
-	uint32_t *pattr_length;
+#ifndef IIO_NO_TRIGGERS
+/* Account the end of a device trigger handler run for a trigger at start */
+static void iio_lat_trig_done(uint32_t start)
+{
+	no_os_profile_add(&iio_trig_lat, no_os_get_cycles() - start);
+	iio_latency_mark(IIO_LATENCY_PUSHED);
+}
+#endif
 
-	while (attributes[i].name) {
-		attr_length = attributes[i].show(params->dev_instance,
-						 local_buf, params->len,
-						 params->ch_info,
-						 attributes[i].priv);
-		if (NO_OS_IS_ERR_VALUE(attr_length))
-			attr_length = snprintf(local_buf, params->len, "%d",
-					       attr_length);
-
-		attr_length += 1;//Add '\0' to the count
-		pattr_length = (uint32_t *)(params->buf + j);
-		if (j + 4 > params->len)
-			return -EINVAL;
-		*pattr_length = no_os_bswap_constant_32(attr_length);
-		j += 4;
-		if (attr_length >= 0) {
-			if (attr_length + j > params->len)
-				return -EINVAL;
-			sprintf(params->buf + j, "%s", local_buf);
-			if (attr_length & 0x3) /* multiple of 4 */
-				attr_length = ((attr_length >> 2) + 1) << 2;
-			j += attr_length;
-		}
-		i++;
-	}
-	if (j == 0)
-		return -ENOENT;
+/*
+ * Account bytes pushed to an input buffer. The first scan pushed while no
+ * other one is timed gets timed, until it is read.
+ */
+static void iio_lat_pushed(struct iio_buffer_priv *priv, uint32_t bytes)
+{
+	priv->lat_in += bytes;
+	if (priv->lat_mark)
+		return;
 
-	return j;
-#endif
+	priv->lat_pos = priv->lat_in;
+	priv->lat_cycles = no_os_get_cycles();
+	priv->lat_mark = true;
 }
 
-/**
- * @brief Write all attributes from an attribute list.
- * @param device - Physical instance of a device.
- * @param buf - Values to be written.
- * @param len - Length of buf.
- * @param channel - Channel properties.
- * @param attributes - List of attributes to be written.
- * @return Number of written bytes or negative value in case of error.
- */
-static int iio_write_all_attr(struct attr_fun_params *params,
-			      struct iio_attribute *attributes)
+/* Account bytes read from an input buffer, ends the timing of a scan */
+static void iio_lat_read(struct iio_buffer_priv *priv, uint32_t bytes)
 {
-	/* TODO Not sure if working corectly */
-	return -EINVAL;
+	priv->lat_out += bytes;
+	if (!priv->lat_mark || (int32_t)(priv->lat_out - priv->lat_pos) < 0)
+		return;
 
-#if 0
-	int16_t i = 0, j = 0;
-	int16_t attr_length;
+	no_os_profile_add(&iio_read_lat, no_os_get_cycles() - priv->lat_cycles);
+	priv->lat_mark = false;
+	iio_latency_mark(IIO_LATENCY_READ);
+}
+#endif
 
-	while (attributes[i].name) {
-		attr_length = no_os_bswap_constant_32((uint32_t)(params->buf + j));
-		j += 4;
-		attributes[i].store(params->dev_instance, (params->buf + j),
-				    attr_length, params->ch_info,
-				    attributes[i].priv);
-		j += attr_length;
-		if (j & 0x3)
-			j = ((j >> 2) + 1) << 2;
-		i++;
+#ifdef IIO_PRETRIGGER
+/*
+ * Hand the capture to the clients: the extra scans pushed after its end are
+ * dropped and only its scans are left to be read.
+ */
+static void iio_hist_freeze(struct iio_buffer_priv *priv, uint32_t extra)
+{
+	struct no_os_circular_buffer *cb = &priv->cb;
+	uint32_t scan = priv->public.bytes_per_scan;
+	uint32_t total;
+
+	total = (no_os_min(priv->hist_pre, priv->hist_seen) + priv->hist_post) *
+		scan;
+
+	/* The oldest scans were overwritten by the extra ones */
+	extra *= scan;
+	total = no_os_min(total, cb->size - extra);
+	if (extra > cb->write.idx) {
+		cb->write.spin_count--;
+		cb->write.idx += cb->size;
 	}
+	cb->write.idx -= extra;
 
-	if (params->len == 0)
-		return -ENOENT;
+	cb->read.idx = (cb->write.idx + cb->size - total) % cb->size;
+	cb->read.spin_count = cb->write.spin_count;
+	if (total && cb->read.idx >= cb->write.idx)
+		cb->read.spin_count--;
 
-	return params->len;
-#endif
+	priv->hist_state = IIO_HIST_FROZEN;
 }
 
-/**
- * @brief Read/write attribute.
- * @param params - Structure describing parameters for store and show functions
- * @param attributes - Array of attributes.
- * @param attr_name - Attribute name to be modified
- * @param is_write -If it has value "1", writes attribute, otherwise reads
- * 		attribute.
- * @return Length of chars written/read or negative value in case of error.
- */
-static int iio_rd_wr_attribute(struct attr_fun_params *params,
-			       struct iio_attribute *attributes,
-			       const char *attr_name,
-			       bool is_write)
+/* Check the scan with det, return true on the start of its condition */
+static bool iio_det_check(struct iio_det *det, const uint8_t *scan)
 {
-	int16_t i = 0;
+	uint32_t raw = 0;
+	int64_t val, ac;
+	uint64_t sq;
+	bool hit;
+
+	memcpy(&raw, scan + det->offset, det->bytes);
+	if (det->sign && det->bytes < 4)
+		val = no_os_sign_extend32(raw, 8 * det->bytes - 1);
+	else if (det->sign)
+		val = (int32_t)raw;
+	else
+		val = raw;
 
-	/* Search attribute */
-	while (attributes[i].name) {
-		if (!strcmp(attr_name, attributes[i].name))
-			break;
-		i++;
+	if (!det->valid) {
+		det->prev = val;
+		det->mean = val * (1 << IIO_DET_MEAN_SHIFT);
+		det->energy = 0;
 	}
 
-	if (!attributes[i].name)
-		return -ENOENT;
-
-	if (is_write) {
-		if (!attributes[i].store)
-			return -ENOENT;
+	switch (det->kind) {
+	case IIO_DET_RISING:
+		hit = val >= det->level;
+		break;
+	case IIO_DET_FALLING:
+		hit = val <= det->level;
+		break;
+	case IIO_DET_RATE:
+		hit = val - det->prev >= det->level ||
+		      det->prev - val >= det->level;
+		break;
+	default:
+		det->mean += val - (det->mean >> IIO_DET_MEAN_SHIFT);
+		ac = val - (det->mean >> IIO_DET_MEAN_SHIFT);
+		sq = no_os_min((uint64_t)(ac * ac),
+			       UINT64_MAX >> (IIO_DET_ENERGY_SHIFT + 1));
+		det->energy += sq - (det->energy >> IIO_DET_ENERGY_SHIFT);
+		hit = (int64_t)(det->energy >> IIO_DET_ENERGY_SHIFT) > det->level;
+		break;
+	}
 
-		return attributes[i].store(params->dev_instance, params->buf,
-					   params->len, params->ch_info,
-					   attributes[i].priv);
-	} else {
-		if (!attributes[i].show)
-			return -ENOENT;
-		return attributes[i].show(params->dev_instance, params->buf,
-					  params->len, params->ch_info,
-					  attributes[i].priv);
+	det->prev = val;
+	if (!det->valid) {
+		/* No event for a condition already met when armed */
+		det->valid = true;
+		det->active = hit;
+		return false;
 	}
+
+	if (hit == det->active)
+		return false;
+	det->active = hit;
+
+	return hit;
 }
 
-/* Read a device register. The register address to read is set on
- * in desc->active_reg_addr in the function set_demo_reg_attr
- */
-static int32_t debug_reg_read(struct iio_dev_priv *dev, char *buf, uint32_t len)
+/* Index of the detector signaling an event in scan, -1 if none */
+static int32_t iio_det_scan(struct iio_buffer_priv *priv, const uint8_t *scan)
 {
-	uint32_t		value;
-	int32_t			ret;
+	uint32_t i;
+	int32_t ret = -1;
 
-	value = 0;
-	ret = dev->dev_descriptor->debug_reg_read(dev->dev_instance,
-			dev->active_reg_addr,
-			&value);
-	if (NO_OS_IS_ERR_VALUE(ret))
-		return ret;
+	/* All the detectors see the scan to keep their state */
+	for (i = 0; i < priv->nb_det; i++)
+		if (priv->det[i].bytes && iio_det_check(&priv->det[i], scan) &&
+		    ret < 0)
+			ret = i;
 
-	return snprintf(buf, len, "%"PRIu32"", value);
+	return ret;
 }
 
-/* Flow of reading and writing registers. This is how iio works for
- * direct_reg_access attribute:
- * Read register:
- * 	   //Reg_addr in decimal
- * 	   reg_addr = "10";
- * 	1. debug_reg_write(dev, reg_addr, len);
- * 	2. debug_reg_read(dev, out_buf, out_len);
- * Write register:
- * 	   sprintf(write_buf, "0x%x 0x%x", reg_addr, value);
- * 	1. debug_reg_write(dev, write_buf,len);
- */
-static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
-			       uint32_t len)
+/* Follow the capture after nb scans were pushed at scans */
+static void iio_hist_pushed(struct iio_buffer_priv *priv, const uint8_t *scans,
+			    uint32_t nb)
 {
-	uint32_t		nb_filled;
-	uint32_t		addr;
-	uint32_t		value;
-	int32_t			ret;
-
-	nb_filled = sscanf(buf, "0x%"PRIx32" 0x%"PRIx32"", &addr, &value);
-	if (nb_filled == 2) {
-		/* Write register */
-		ret = dev->dev_descriptor->debug_reg_write(dev->dev_instance,
-				addr, value);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
-	} else {
-		nb_filled = sscanf(buf, "%"PRIu32, &addr);
-		if (nb_filled == 1) {
-			dev->active_reg_addr = addr;
-			return len;
-		} else {
-			return -EINVAL;
+	uint32_t i = 0;
+	int32_t det;
+
+	if (priv->hist_state == IIO_HIST_ARMED) {
+		for (; i < nb && priv->nb_det; i++) {
+			det = iio_det_scan(priv, scans +
+					   i * priv->public.bytes_per_scan);
+			if (det >= 0) {
+				/* The scan of the event is the first after */
+				priv->det_events++;
+				priv->det_last = det;
+				priv->hist_state = IIO_HIST_TRIGGERED;
+				priv->hist_left = priv->hist_post;
+				break;
+			}
+			priv->hist_seen++;
 		}
+		if (!priv->nb_det)
+			priv->hist_seen += nb;
 	}
 
-	return len;
+	if (priv->hist_state != IIO_HIST_TRIGGERED)
+		return;
+
+	if (nb - i >= priv->hist_left)
+		iio_hist_freeze(priv, nb - i - priv->hist_left);
+	else
+		priv->hist_left -= nb - i;
 }
 
-static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
-			       bool scale_db)
+/* Start a new capture, dropping the scans of the previous one */
+static void iio_hist_arm(struct iio_buffer_priv *priv)
 {
-	char *p;
+	uint32_t i;
 
-	p = strtok(buf, ".");
-	if (p == NULL)
+	for (i = 0; i < priv->nb_det; i++) {
+		priv->det[i].valid = false;
+		priv->det[i].active = false;
+	}
+	priv->hist_seen = 0;
+	priv->hist_state = IIO_HIST_ARMED;
+}
+
+/**
+ * @brief Signal the event of a capture with pre trigger history, e.g. from the
+ * interrupt of an external trigger. The last pretrigger_samples scans and the
+ * posttrigger_samples scans that follow are held for the clients.
+ * @param buffer - Buffer of the device.
+ * @return 0 or -EBUSY if the buffer isn't waiting for an event.
+ */
+int iio_buffer_history_fire(struct iio_buffer *buffer)
+{
+	struct iio_buffer_priv *priv = (struct iio_buffer_priv *)buffer;
+
+	if (!buffer)
 		return -EINVAL;
 
-	*integer = strtol(p, NULL, 0);
+	if (priv->hist_state != IIO_HIST_ARMED)
+		return -EBUSY;
 
-	if (scale_db) {
-		p = strtok(NULL, "db");
-		if (p == NULL)
-			p = strtok(NULL, " db");
-	} else
-		p = strtok(NULL, "\n");
+	priv->det_events++;
+	priv->det_last = -1;
+	priv->hist_left = priv->hist_post;
+	if (priv->hist_left)
+		priv->hist_state = IIO_HIST_TRIGGERED;
+	else
+		iio_hist_freeze(priv, 0);
 
-	if (p == NULL)
+	return 0;
+}
+
+/*
+ * Set up the capture of the opened buffer. The detectors only see the enabled
+ * channels.
+ */
+static int iio_hist_open(struct iio_dev_priv *dev)
+{
+	struct iio_buffer_priv *priv = &dev->buffer;
+	const struct iio_scan_layout *layout = &priv->public.layout;
+	const struct scan_type *type;
+	struct iio_det *det;
+	uint32_t i, j;
+
+	priv->hist_state = IIO_HIST_OFF;
+	if (!priv->hist_pre && !priv->hist_post)
+		return 0;
+
+	if (priv->public.cyclic_info.is_cyclic ||
+	    (uint64_t)(priv->hist_pre + priv->hist_post) *
+	    priv->public.bytes_per_scan > priv->cb.size)
 		return -EINVAL;
 
-	*_fract = strtol(p, NULL, 10);
+	for (j = 0; j < priv->nb_det; j++) {
+		det = &priv->det[j];
+		det->bytes = 0;
+		for (i = 0; i < layout->nb; i++) {
+			if (layout->ch[i] != det->ch)
+				continue;
+
+			type = dev->dev_descriptor->channels[det->ch].scan_type;
+			det->offset = layout->offset[i];
+			det->bytes = no_os_min(layout->bytes[i], 4);
+			det->sign = type->sign == 's';
+		}
+	}
+
+	iio_hist_arm(priv);
 
 	return 0;
 }
 
-static int32_t _iio_fract_interpret(int32_t fract, int32_t subunits)
+static int iio_hist_attr_show(struct iio_dev_priv *dev, const char *name,
+			      char *buf, uint32_t len)
 {
-	int32_t temp = fract;
+	struct iio_buffer_priv *priv = &dev->buffer;
+	uint32_t i;
+	int ret = 0;
 
-	while ((subunits != 0) || (temp != 0)) {
-		temp /= 10;
-		subunits /= 10;
-		if (!temp)
-			break;
-		if (subunits <= 1)
-			fract /= 10;
+	if (strcmp(name, PRETRIGGER_ATTRIBUTE) == 0)
+		return snprintf(buf, len, "%"PRIu32, priv->hist_pre);
+	if (strcmp(name, POSTTRIGGER_ATTRIBUTE) == 0)
+		return snprintf(buf, len, "%"PRIu32, priv->hist_post);
+	if (strcmp(name, THRESHOLD_ATTRIBUTE) == 0) {
+		if (!priv->nb_det)
+			return snprintf(buf, len, "none");
+		for (i = 0; i < priv->nb_det; i++)
+			ret += snprintf(buf + ret, no_os_max((int)len - ret, 0),
+					"%s%"PRIu32" %s %"PRIi32, i ? ", " : "",
+					priv->det[i].ch,
+					iio_det_kind_names[priv->det[i].kind],
+					priv->det[i].level);
+		return ret;
+	}
+	if (strcmp(name, CAPTURE_STATE_ATTRIBUTE) == 0)
+		return snprintf(buf, len, "%s",
+				iio_hist_state_names[priv->hist_state]);
+	if (strcmp(name, TRIGGER_EVENT_ATTRIBUTE) == 0) {
+		if (!priv->det_events)
+			return snprintf(buf, len, "0");
+		if (priv->det_last < 0)
+			return snprintf(buf, len, "%"PRIu32" software",
+					priv->det_events);
+		return snprintf(buf, len, "%"PRIu32" %"PRIu32" %s",
+				priv->det_events, priv->det[priv->det_last].ch,
+				iio_det_kind_names[priv->det[priv->det_last].kind]);
 	}
 
-	return fract * subunits;
+	return -ENOENT;
 }
 
-int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
-			int32_t *val2)
+/*
+ * The capture is set up while the buffer is closed. Writing "trigger" to
+ * capture_state signals the event. Writing "<ch> <kind> <level>" to
+ * trigger_threshold sets the detector of channel ch, "none" removes them all.
+ */
+static int iio_hist_attr_store(struct iio_dev_priv *dev, const char *name,
+			       const char *buf, uint32_t len)
 {
-	int32_t ret = 0;
-	int32_t integer, _fract = 0;
-	char ch;
+	struct iio_buffer_priv *priv = &dev->buffer;
+	char kind[8];
+	uint32_t ch, val, i;
+	int32_t level;
+	int ret;
 
-	switch (fmt) {
-	case IIO_VAL_INT:
-		integer = strtol(buf, NULL, 0);
-		break;
-	case IIO_VAL_INT_PLUS_MICRO_DB:
-		ret = __iio_str_parse(buf, &integer, &_fract, true);
-		if (ret < 0)
-			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000);
-		break;
-	case IIO_VAL_INT_PLUS_MICRO:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
-		if (ret < 0)
-			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000);
-		break;
-	case IIO_VAL_INT_PLUS_NANO:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
-		if (ret < 0)
-			return ret;
-		_fract = _iio_fract_interpret(_fract, 1000000000);
-		break;
-	case IIO_VAL_FRACTIONAL:
-		ret = __iio_str_parse(buf, &integer, &_fract, false);
-		if (ret < 0)
-			return ret;
-		break;
-	case IIO_VAL_CHAR:
-		if (sscanf(buf, "%c", &ch) != 1)
+	if (strcmp(name, CAPTURE_STATE_ATTRIBUTE) == 0) {
+		if (strncmp(buf, "trigger", 7))
 			return -EINVAL;
-		integer = ch;
-		break;
-	default:
-		return -EINVAL;
+		ret = iio_buffer_history_fire(&priv->public);
+		return ret ? ret : (int)len;
 	}
 
-	if (val)
-		*val = integer;
-	if (val2)
-		*val2 = _fract;
+	if (strcmp(name, PRETRIGGER_ATTRIBUTE) &&
+	    strcmp(name, POSTTRIGGER_ATTRIBUTE) &&
+	    strcmp(name, THRESHOLD_ATTRIBUTE))
+		return -ENOENT;
 
-	return ret;
+	if (priv->public.active_mask)
+		return -EBUSY;
+
+	if (strcmp(name, THRESHOLD_ATTRIBUTE) == 0) {
+		if (strncmp(buf, "none", 4) == 0) {
+			priv->nb_det = 0;
+			return len;
+		}
+		if (sscanf(buf, "%"SCNu32" %7s %"SCNi32, &ch, kind, &level) != 3 ||
+		    ch >= dev->dev_descriptor->num_ch)
+			return -EINVAL;
+
+		for (val = 0; val < NO_OS_ARRAY_SIZE(iio_det_kind_names); val++)
+			if (strcmp(kind, iio_det_kind_names[val]) == 0)
+				break;
+		if (val == NO_OS_ARRAY_SIZE(iio_det_kind_names))
+			return -EINVAL;
+
+		for (i = 0; i < priv->nb_det; i++)
+			if (priv->det[i].ch == ch)
+				break;
+		if (i == IIO_DET_MAX)
+			return -ENOSPC;
+		if (i == priv->nb_det)
+			priv->nb_det++;
+
+		priv->det[i].ch = ch;
+		priv->det[i].kind = val;
+		priv->det[i].level = level;
+
+		return len;
+	}
+
+	if (sscanf(buf, "%"SCNu32, &val) != 1)
+		return -EINVAL;
+
+	if (strcmp(name, PRETRIGGER_ATTRIBUTE) == 0)
+		priv->hist_pre = val;
+	else
+		priv->hist_post = val;
+
+	return len;
 }
+#endif
 
-int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
-		     int32_t size, int32_t *vals)
+/**
+ * @brief Sets buffers count.
+ * @param ctx           - IIO instance and conn instance.
+ * @param device        - String containing device name.
+ * @param buffers_count - Value to be set.
+ * @return Positive if index was set, negative if not.
+ */
+static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
+				 uint32_t buffers_count)
 {
-	int64_t tmp;
-	int32_t integer, fractional;
-	bool dB = false;
-	int32_t i = 0;
-	uint32_t l = 0;
+	struct iio_desc *desc = ctx->instance;
+	struct iio_dev_priv *dev;
 
-	switch (fmt) {
-	case IIO_VAL_INT:
-		return snprintf(buf, len, "%"PRIi32"", vals[0]);
-	case IIO_VAL_INT_PLUS_MICRO_DB:
-		dB = true;
-	/* intentional fall through */
-	case IIO_VAL_INT_PLUS_MICRO:
-		return snprintf(buf, len, "%"PRIi32".%06"PRIu32"%s", vals[0],
-				(uint32_t)vals[1], dB ? " dB" : "");
-	case IIO_VAL_INT_PLUS_NANO:
-		return snprintf(buf, len, "%"PRIi32".%09"PRIu32"", vals[0],
-				(uint32_t)vals[1]);
-	case IIO_VAL_FRACTIONAL:
-		tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
-		fractional = vals[1];
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
+	dev = get_iio_device(desc, device);
+	if (!dev)
+		return -ENODEV;
 
-		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
+	/*
+	 * The blocks are consecutive areas of the same circular buffer, used
+	 * once the buffer is opened.
+	 */
+	if (!buffers_count || buffers_count > IIO_MAX_BUFFERS_COUNT)
+		return -EINVAL;
 
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
-	case IIO_VAL_FRACTIONAL_LOG2:
-		tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
-		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000LL, &fractional);
+	dev->buffer.buffers_count = buffers_count;
 
-		if (integer == 0 && fractional < 0)
-			return snprintf(buf, len, "-0.%09u", abs(fractional));
+	return 0;
+}
 
-		return snprintf(buf, len, "%"PRIi32".%09u", integer,
-				abs(fractional));
-	case IIO_VAL_INT_MULTIPLE: {
-		while (i < size) {
-			l += snprintf(&buf[l], len - l, "%"PRIi32" ", vals[i]);
-			if (l >= len)
-				break;
-			i++;
-		}
-		return l;
-	}
-	case IIO_VAL_CHAR:
-		return snprintf(buf, len, "%c", (char)vals[0]);
-	default:
-		return 0;
+/**
+ * @brief Find an attribute by name.
+ * @param attributes - Array of attributes.
+ * @param hashes - Hashes of the attribute names. Can be NULL.
+ * @param attr_name - Attribute name.
+ * @return Index of the attribute or -ENOENT if it is not found.
+ */
+static int32_t iio_find_attr(const struct iio_attribute *attributes,
+			     const uint32_t *hashes, const char *attr_name)
+{
+	int32_t i = 0;
+	uint32_t hash;
+
+	if (!attributes)
+		return -ENOENT;
+
+	/* Compare names only if hashes match */
+	hash = hashes ? iio_hash(attr_name) : 0;
+	while (attributes[i].name) {
+		if ((!hashes || hashes[i] == hash) &&
+		    !strcmp(attr_name, attributes[i].name))
+			return i;
+		i++;
 	}
+
+	return -ENOENT;
 }
 
-static struct iio_attribute *get_attributes(enum iio_attr_type type,
-		struct iio_dev_priv *dev,
-		struct iio_channel *ch)
+/*
+ * Get the index of the next attribute of a batched operation. If names is
+ * empty, all the attributes are used in order. Otherwise names is a list
+ * separated by IIO_ATTR_LIST_SEP and *pos is the position in it.
+ * Returns -ENOENT for names that are not found or -EOVERFLOW when done.
+ */
+static int32_t iio_next_attr(const struct iio_attribute *attributes,
+			     const uint32_t *hashes, const char *names,
+			     uint32_t *pos)
 {
-	switch (type) {
-	case IIO_ATTR_TYPE_DEBUG:
-		return dev->dev_descriptor->debug_attributes;
-		break;
-	case IIO_ATTR_TYPE_DEVICE:
-		return dev->dev_descriptor->attributes;
-		break;
-	case IIO_ATTR_TYPE_BUFFER:
-		return dev->dev_descriptor->buffer_attributes;
-		break;
-	case IIO_ATTR_TYPE_CH_IN:
-	case IIO_ATTR_TYPE_CH_OUT:
-		return ch->attributes;
+	char name[MAX_ATTR_NAME];
+	const char *end;
+	uint32_t len;
+
+	if (!names[0]) {
+		if (!attributes || !attributes[*pos].name)
+			return -EOVERFLOW;
+
+		return (*pos)++;
 	}
 
-	return NULL;
+	if (*pos && !names[*pos - 1])
+		return -EOVERFLOW;
+
+	end = strchr(names + *pos, IIO_ATTR_LIST_SEP);
+	len = end ? (uint32_t)(end - names) - *pos : strlen(names + *pos);
+	if (len >= sizeof(name))
+		return -EINVAL;
+
+	memcpy(name, names + *pos, len);
+	name[len] = '\0';
+	*pos += len + 1;
+
+	return iio_find_attr(attributes, hashes, name);
 }
 
 /**
- * @brief Returns trigger attributes.
- * @param type - Attribute type.
- * @param trig - Trigger instance.
- * @return Attributes pointer if attributes exist, NULL otherwise.
+ * @brief Read an attribute.
+ * For an attribute with show_stream only the chunk at params->offset is
+ * written in params->buf and params->size is set to the size of the value.
+ * @param params - Structure describing parameters for show functions.
+ * @param attr - Attribute.
+ * @return Number of bytes read or negative value in case of error.
  */
-static struct iio_attribute *get_trig_attributes(enum iio_attr_type type,
-		struct iio_trig_priv *trig)
+static int iio_show_attr(struct attr_fun_params *params,
+			 const struct iio_attribute *attr)
 {
-	switch (type) {
-	/* Only device type attributes allowed for triggers */
-	case IIO_ATTR_TYPE_DEVICE:
-		return trig->descriptor->attributes;
-		break;
-	default:
-		break;
+	struct iio_writer w;
+	int ret;
+
+	params->size = 0;
+	if (attr->show_stream) {
+		iio_writer_init(&w, params->buf, params->len, params->offset);
+		ret = attr->show_stream(params->dev_instance, &w,
+					params->ch_info, attr->priv);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		if (w.err)
+			return w.err;
+
+		params->size = w.pos;
+
+		return iio_writer_chunk(&w);
 	}
 
-	return NULL;
+	if (!attr->show)
+		return -ENOENT;
+
+	return attr->show(params->dev_instance, params->buf, params->len,
+			  params->ch_info, attr->priv);
+}
+
+/**
+ * @brief Read a list of attributes in a single reply.
+ * For each attribute, the reply contains the length of the value as a big
+ * endian 32 bit number followed by the null terminated value, padded to a
+ * multiple of 4 bytes. A negative length is the error code of the attribute.
+ * @param params - Structure describing parameters for show functions. buf
+ * and len describe the reply buffer.
+ * @param attributes - Array of attributes.
+ * @param hashes - Hashes of the attribute names. Can be NULL.
+ * @param names - Attributes to read separated by IIO_ATTR_LIST_SEP or "" to
+ * read all of them.
+ * @return Number of bytes read or negative value in case of error.
+ */
+static int iio_read_attr_list(struct attr_fun_params *params,
+			      const struct iio_attribute *attributes,
+			      const uint32_t *hashes, const char *names)
+{
+	struct attr_fun_params lparams = *params;
+	uint32_t pos = 0, j = 0;
+	int32_t idx, len;
+
+	while (true) {
+		idx = iio_next_attr(attributes, hashes, names, &pos);
+		if (idx == -EOVERFLOW)
+			break;
+		if (idx == -EINVAL)
+			return idx;
+
+		if (j + 4 >= params->len)
+			return -EINVAL;
+
+		lparams.buf = params->buf + j + 4;
+		lparams.len = params->len - j - 4;
+		lparams.offset = 0;
+		if (idx < 0)
+			len = idx;
+		else
+			len = iio_show_attr(&lparams, &attributes[idx]);
+		/* Values sent in chunks are not read in a list */
+		if (len >= 0 && lparams.size > (uint32_t)len)
+			len = -EFBIG;
+		if (len >= 0) {
+			/* Add '\0' to the count */
+			if ((uint32_t)len >= lparams.len)
+				return -EINVAL;
+			lparams.buf[len++] = '\0';
+		}
+
+		no_os_put_unaligned_be32(len, (uint8_t *)params->buf + j);
+		j += 4;
+		if (len > 0)
+			j += no_os_min(no_os_align((uint32_t)len, 4),
+				       lparams.len);
+	}
+
+	if (j == 0)
+		return -ENOENT;
+
+	return j;
+}
+
+/**
+ * @brief Write a list of attributes from a single request.
+ * The data has the same format as the reply of iio_read_attr_list().
+ * @param params - Structure describing parameters for store functions. buf
+ * and len describe the received data.
+ * @param attributes - Array of attributes.
+ * @param hashes - Hashes of the attribute names. Can be NULL.
+ * @param names - Attributes to write separated by IIO_ATTR_LIST_SEP or "" to
+ * write all of them.
+ * @return Number of written bytes or negative value in case of error.
+ */
+static int iio_write_attr_list(struct attr_fun_params *params,
+			       const struct iio_attribute *attributes,
+			       const uint32_t *hashes, const char *names)
+{
+	uint32_t pos = 0, j = 0;
+	int32_t idx, len;
+
+	if (params->len == 0)
+		return -ENOENT;
+
+	while (j + 4 <= params->len) {
+		idx = iio_next_attr(attributes, hashes, names, &pos);
+		if (idx == -EOVERFLOW)
+			break;
+		if (idx == -EINVAL)
+			return idx;
+
+		len = no_os_get_unaligned_be32((uint8_t *)params->buf + j);
+		j += 4;
+		if (len < 0 || (uint32_t)len > params->len - j)
+			return -EINVAL;
+
+		if (idx >= 0 && attributes[idx].store)
+			attributes[idx].store(params->dev_instance,
+					      params->buf + j, len,
+					      params->ch_info,
+					      attributes[idx].priv);
+		j += no_os_min(no_os_align((uint32_t)len, 4), params->len - j);
+	}
+
+	return params->len;
+}
+
+/* Check if a read or write must go through the batched functions */
+static inline bool iio_is_attr_list(const char *name)
+{
+	return !name[0] || strchr(name, IIO_ATTR_LIST_SEP);
+}
+
+/**
+ * @brief Read/write attribute.
+ * @param params - Structure describing parameters for store and show functions
+ * @param attributes - Array of attributes.
+ * @param hashes - Hashes of the attribute names. Can be NULL.
+ * @param attr_name - Attribute name to be modified
+ * @param is_write -If it has value "1", writes attribute, otherwise reads
+ * 		attribute.
+ * @return Length of chars written/read or negative value in case of error.
+ */
+static int iio_rd_wr_attribute(struct attr_fun_params *params,
+			       const struct iio_attribute *attributes,
+			       const uint32_t *hashes,
+			       const char *attr_name,
+			       bool is_write)
+{
+	int32_t i;
+
+	i = iio_find_attr(attributes, hashes, attr_name);
+	if (i < 0)
+		return i;
+
+	if (is_write) {
+		if (!attributes[i].store)
+			return -ENOENT;
+
+		return attributes[i].store(params->dev_instance, params->buf,
+					   params->len, params->ch_info,
+					   attributes[i].priv);
+	} else {
+		return iio_show_attr(params, &attributes[i]);
+	}
+}
+
+#ifndef IIO_NO_DEBUG_ATTRS
+/* Read a device register. The register address to read is set on
+ * in desc->active_reg_addr in the function set_demo_reg_attr
+ */
+static int32_t debug_reg_read(struct iio_dev_priv *dev, char *buf, uint32_t len)
+{
+	uint32_t		value;
+	int32_t			ret;
+
+	value = 0;
+	ret = dev->dev_descriptor->debug_reg_read(dev->dev_instance,
+			dev->active_reg_addr,
+			&value);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return snprintf(buf, len, "%"PRIu32"", value);
+}
+
+/* Flow of reading and writing registers. This is how iio works for
+ * direct_reg_access attribute:
+ * Read register:
+ * 	   //Reg_addr in decimal
+ * 	   reg_addr = "10";
+ * 	1. debug_reg_write(dev, reg_addr, len);
+ * 	2. debug_reg_read(dev, out_buf, out_len);
+ * Write register:
+ * 	   sprintf(write_buf, "0x%x 0x%x", reg_addr, value);
+ * 	1. debug_reg_write(dev, write_buf,len);
+ */
+static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
+			       uint32_t len)
+{
+	uint32_t		nb_filled;
+	uint32_t		addr;
+	uint32_t		value;
+	int32_t			ret;
+
+	nb_filled = sscanf(buf, "0x%"PRIx32" 0x%"PRIx32"", &addr, &value);
+	if (nb_filled == 2) {
+		/* Write register */
+		ret = dev->dev_descriptor->debug_reg_write(dev->dev_instance,
+				addr, value);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	} else {
+		nb_filled = sscanf(buf, "%"PRIu32, &addr);
+		if (nb_filled == 1) {
+			dev->active_reg_addr = addr;
+			return len;
+		} else {
+			return -EINVAL;
+		}
+	}
+
+	return len;
+}
+#endif
+
+#ifdef IIO_COMPRESSION
+/* Select the codec of the next buffer opened on the device */
+static int32_t iio_codec_set(struct iio_dev_priv *dev, const char *buf,
+			     uint32_t len)
+{
+	uint32_t i, n;
+
+	if (dev->buffer.public.active_mask)
+		return -EBUSY;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(iio_codec_names); i++) {
+		n = strlen(iio_codec_names[i]);
+		if (strncmp(buf, iio_codec_names[i], n) == 0 &&
+		    (buf[n] == '\0' || buf[n] == '\n')) {
+			dev->codec = i;
+			return len;
+		}
+	}
+
+	return -EINVAL;
+}
+#endif
+
+/*
+ * The attribute values are formatted and parsed without stdio, snprintf() and
+ * strtol() are slow on newlib-nano and these run for every attribute access.
+ * The output matches the one of the printf formats used before, including the
+ * truncation and the return value of snprintf().
+ */
+struct iio_fmt_buf {
+	char *buf;
+	uint32_t len;
+	uint32_t pos;
+};
+
+static void _iio_fmt_char(struct iio_fmt_buf *f, char c)
+{
+	if (f->pos + 1 < f->len)
+		f->buf[f->pos] = c;
+	f->pos++;
+}
+
+static void _iio_fmt_str(struct iio_fmt_buf *f, const char *str)
+{
+	while (*str)
+		_iio_fmt_char(f, *str++);
+}
+
+/* Decimal value, left padded with zeros to min_digits. */
+static void _iio_fmt_uint(struct iio_fmt_buf *f, uint32_t val,
+			  uint32_t min_digits)
+{
+	char digits[10];
+	uint32_t n = 0;
+
+	do {
+		digits[n++] = '0' + val % 10;
+		val /= 10;
+	} while (val);
+
+	for (; min_digits > n; min_digits--)
+		_iio_fmt_char(f, '0');
+
+	while (n)
+		_iio_fmt_char(f, digits[--n]);
+}
+
+static void _iio_fmt_int(struct iio_fmt_buf *f, int32_t val)
+{
+	if (val < 0) {
+		_iio_fmt_char(f, '-');
+		_iio_fmt_uint(f, -(uint32_t)val, 0);
+	} else {
+		_iio_fmt_uint(f, val, 0);
+	}
+}
+
+/* Terminate the string, returns the length it would have untruncated. */
+static int _iio_fmt_end(struct iio_fmt_buf *f)
+{
+	if (f->len)
+		f->buf[no_os_min(f->pos, f->len - 1)] = '\0';
+
+	return f->pos;
+}
+
+/* strtol() with base 0 or 10, saturated to the int32_t range. */
+static int32_t _iio_strtol(const char *str, uint32_t base)
+{
+	int64_t val = 0;
+	bool neg = false;
+	uint32_t digit;
+
+	while (isspace((unsigned char)*str))
+		str++;
+
+	if (*str == '-' || *str == '+')
+		neg = *str++ == '-';
+
+	if (!base) {
+		if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X') &&
+		    isxdigit((unsigned char)str[2])) {
+			base = 16;
+			str += 2;
+		} else if (str[0] == '0') {
+			base = 8;
+		} else {
+			base = 10;
+		}
+	}
+
+	for (;; str++) {
+		if (isdigit((unsigned char)*str))
+			digit = *str - '0';
+		else if (isalpha((unsigned char)*str))
+			digit = tolower((unsigned char)*str) - 'a' + 10;
+		else
+			break;
+
+		if (digit >= base)
+			break;
+
+		val = val * base + digit;
+		if (val > (int64_t)INT32_MAX + 1)
+			val = (int64_t)INT32_MAX + 1;
+	}
+
+	if (neg)
+		val = -val;
+
+	return no_os_clamp(val, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+}
+
+static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
+			       bool scale_db)
+{
+	char *p;
+
+	p = strtok(buf, ".");
+	if (p == NULL)
+		return -EINVAL;
+
+	*integer = _iio_strtol(p, 0);
+
+	if (scale_db) {
+		p = strtok(NULL, "db");
+		if (p == NULL)
+			p = strtok(NULL, " db");
+	} else
+		p = strtok(NULL, "\n");
+
+	if (p == NULL)
+		return -EINVAL;
+
+	*_fract = _iio_strtol(p, 10);
+
+	return 0;
+}
+
+static int32_t _iio_fract_interpret(int32_t fract, int32_t subunits)
+{
+	int32_t temp = fract;
+
+	while ((subunits != 0) || (temp != 0)) {
+		temp /= 10;
+		subunits /= 10;
+		if (!temp)
+			break;
+		if (subunits <= 1)
+			fract /= 10;
+	}
+
+	return fract * subunits;
+}
+
+int32_t iio_parse_value(char *buf, enum iio_val fmt, int32_t *val,
+			int32_t *val2)
+{
+	int32_t ret = 0;
+	int32_t integer, _fract = 0;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		integer = _iio_strtol(buf, 0);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		ret = __iio_str_parse(buf, &integer, &_fract, true);
+		if (ret < 0)
+			return ret;
+		_fract = _iio_fract_interpret(_fract, 1000000);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO:
+		ret = __iio_str_parse(buf, &integer, &_fract, false);
+		if (ret < 0)
+			return ret;
+		_fract = _iio_fract_interpret(_fract, 1000000);
+		break;
+	case IIO_VAL_INT_PLUS_NANO:
+		ret = __iio_str_parse(buf, &integer, &_fract, false);
+		if (ret < 0)
+			return ret;
+		_fract = _iio_fract_interpret(_fract, 1000000000);
+		break;
+	case IIO_VAL_FRACTIONAL:
+		ret = __iio_str_parse(buf, &integer, &_fract, false);
+		if (ret < 0)
+			return ret;
+		break;
+	case IIO_VAL_CHAR:
+		if (buf[0] == '\0')
+			return -EINVAL;
+		integer = buf[0];
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (val)
+		*val = integer;
+	if (val2)
+		*val2 = _fract;
+
+	return ret;
+}
+
+int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
+		     int32_t size, int32_t *vals)
+{
+	struct iio_fmt_buf f = {
+		.buf = buf,
+		.len = len,
+	};
+	int64_t tmp;
+	int32_t integer, fractional;
+	bool dB = false;
+	int32_t i = 0;
+
+	switch (fmt) {
+	case IIO_VAL_INT:
+		_iio_fmt_int(&f, vals[0]);
+		break;
+	case IIO_VAL_INT_PLUS_MICRO_DB:
+		dB = true;
+	/* intentional fall through */
+	case IIO_VAL_INT_PLUS_MICRO:
+		_iio_fmt_int(&f, vals[0]);
+		_iio_fmt_char(&f, '.');
+		_iio_fmt_uint(&f, (uint32_t)vals[1], 6);
+		if (dB)
+			_iio_fmt_str(&f, " dB");
+		break;
+	case IIO_VAL_INT_PLUS_NANO:
+		_iio_fmt_int(&f, vals[0]);
+		_iio_fmt_char(&f, '.');
+		_iio_fmt_uint(&f, (uint32_t)vals[1], 9);
+		break;
+	case IIO_VAL_FRACTIONAL:
+	case IIO_VAL_FRACTIONAL_LOG2:
+		if (fmt == IIO_VAL_FRACTIONAL)
+			tmp = no_os_div_s64((int64_t)vals[0] * 1000000000LL, vals[1]);
+		else
+			tmp = no_os_shift_right((int64_t)vals[0] * 1000000000LL, vals[1]);
+		integer = (int32_t)no_os_div_s64_rem(tmp, 1000000000, &fractional);
+
+		if (integer == 0 && fractional < 0)
+			_iio_fmt_char(&f, '-');
+		_iio_fmt_int(&f, integer);
+		_iio_fmt_char(&f, '.');
+		_iio_fmt_uint(&f, abs(fractional), 9);
+		break;
+	case IIO_VAL_INT_MULTIPLE:
+		while (i < size) {
+			_iio_fmt_int(&f, vals[i]);
+			_iio_fmt_char(&f, ' ');
+			if (f.pos >= len)
+				break;
+			i++;
+		}
+		break;
+	case IIO_VAL_CHAR:
+		_iio_fmt_char(&f, (char)vals[0]);
+		break;
+	default:
+		return 0;
+	}
+
+	return _iio_fmt_end(&f);
+}
+
+static uint32_t *get_attr_hashes(enum iio_attr_type type,
+				 struct iio_dev_priv *dev, uint32_t ch_idx)
+{
+	switch (type) {
+	case IIO_ATTR_TYPE_DEBUG:
+		return dev->index.debug_attrs;
+	case IIO_ATTR_TYPE_DEVICE:
+		return dev->index.attrs;
+	case IIO_ATTR_TYPE_BUFFER:
+		return dev->index.buffer_attrs;
+	case IIO_ATTR_TYPE_CH_IN:
+	case IIO_ATTR_TYPE_CH_OUT:
+		return dev->index.ch_attrs ? dev->index.ch_attrs[ch_idx] : NULL;
+	}
+
+	return NULL;
+}
+
+static const struct iio_attribute *get_attributes(enum iio_attr_type type,
+		struct iio_dev_priv *dev,
+		const struct iio_channel *ch)
+{
+	switch (type) {
+	case IIO_ATTR_TYPE_DEBUG:
+		return dev->dev_descriptor->debug_attributes;
+		break;
+	case IIO_ATTR_TYPE_DEVICE:
+		return dev->dev_descriptor->attributes;
+		break;
+	case IIO_ATTR_TYPE_BUFFER:
+		return dev->dev_descriptor->buffer_attributes;
+		break;
+	case IIO_ATTR_TYPE_CH_IN:
+	case IIO_ATTR_TYPE_CH_OUT:
+		return ch->attributes;
+	}
+
+	return NULL;
+}
+
+#ifndef IIO_NO_TRIGGERS
+/**
+ * @brief Returns trigger attributes.
+ * @param type - Attribute type.
+ * @param trig - Trigger instance.
+ * @return Attributes pointer if attributes exist, NULL otherwise.
+ */
+static const struct iio_attribute *get_trig_attributes(enum iio_attr_type type,
+		struct iio_trig_priv *trig)
+{
+	switch (type) {
+	/* Only device type attributes allowed for triggers */
+	case IIO_ATTR_TYPE_DEVICE:
+		return trig->descriptor->attributes;
+		break;
+	default:
+		break;
+	}
+
+	return NULL;
+}
+#endif
+
+/**
+ * @brief Read global attribute of a device.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param attr - String containing attribute name.
+ * @param buf - Buffer where value is read.
+ * @param len - Maximum length of value to be stored in buf.
+ * @return Number of bytes read.
+ */
+static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
+			 struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	struct iio_dev_priv *dev;
+#ifndef IIO_NO_TRIGGERS
+	struct iio_trig_priv *trig_dev;
+#endif
+	struct iio_ch_info ch_info;
+	const struct iio_channel *ch = NULL;
+	struct attr_fun_params params;
+	const struct iio_attribute *attributes;
+	uint32_t *hashes;
+	uint32_t ch_idx = 0;
+	int8_t ch_out;
+	int ret;
+
+	dev = get_iio_device(ctx->instance, device);
+
+	/* If IIO device with given name is found, handle reading of attributes */
+	if (dev) {
+		iio_use_dev_index(ctx->instance, dev);
+#ifdef IIO_NO_DEBUG_ATTRS
+		if (attr->type == IIO_ATTR_TYPE_DEBUG)
+			return -ENOENT;
+#else
+		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
+		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
+			if (dev->dev_descriptor->debug_reg_read)
+				return debug_reg_read(dev, buf, len);
+			return -ENOENT;
+		}
+#endif
+#ifdef IIO_COMPRESSION
+		if (attr->type == IIO_ATTR_TYPE_BUFFER &&
+		    dev->buffer.initalized) {
+			if (strcmp(attr->name, COMPRESSION_ATTRIBUTE) == 0)
+				return snprintf(buf, len, "%s",
+						iio_codec_names[dev->codec]);
+			if (strcmp(attr->name, COMPRESSION_AVAIL_ATTRIBUTE) == 0)
+				return snprintf(buf, len, "%s %s",
+						iio_codec_names[IIO_CODEC_NONE],
+						iio_codec_names[IIO_CODEC_DELTA]);
+		}
+#endif
+#ifdef IIO_PRETRIGGER
+		if (attr->type == IIO_ATTR_TYPE_BUFFER &&
+		    dev->buffer.initalized) {
+			ret = iio_hist_attr_show(dev, attr->name, buf, len);
+
+			if (ret != -ENOENT)
+				return ret;
+		}
+#endif
+
+		if (attr->channel[0] != '\0') {
+			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
+			ch = iio_get_channel(attr->channel, dev, ch_out,
+					     &ch_idx);
+			if (!ch)
+				return -ENOENT;
+			ch_info.ch_out = ch_out;
+			ch_info.ch_num = ch->channel;
+			ch_info.type = ch->ch_type;
+			ch_info.differential = ch->diferential;
+			ch_info.address = ch->address;
+			params.ch_info = &ch_info;
+		} else {
+			params.ch_info = NULL;
+		}
+
+		params.buf = buf;
+		params.len = len;
+		params.offset = attr->offset;
+		params.dev_instance = dev->dev_instance;
+		attributes = get_attributes(attr->type, dev, ch);
+		hashes = get_attr_hashes(attr->type, dev, ch_idx);
+		if (iio_is_attr_list(attr->name))
+			return iio_read_attr_list(&params, attributes, hashes,
+						  attr->name);
+		ret = iio_rd_wr_attribute(&params, attributes, hashes,
+					  attr->name, 0);
+		attr->size = params.size;
+
+		return ret;
+	}
+
+#ifndef IIO_NO_TRIGGERS
+	/* IIO device with given name is not found, verify if it corresponds to a trigger */
+	trig_dev = get_iio_trig_device(ctx->instance, device);
+
+	/* If IIO trigger with given name is found, handle reading of attributes */
+	if(trig_dev) {
+		params.ch_info = NULL; /* Triggers cannot have channels */
+		params.buf = buf;
+		params.len = len;
+		params.offset = attr->offset;
+		params.dev_instance = trig_dev->instance;
+		attributes = get_trig_attributes(attr->type, trig_dev);
+		if (iio_is_attr_list(attr->name))
+			return iio_read_attr_list(&params, attributes, NULL,
+						  attr->name);
+		ret = iio_rd_wr_attribute(&params, attributes, NULL,
+					  attr->name, 0);
+		attr->size = params.size;
+
+		return ret;
+	}
+#endif
+
+	/* No device and no trigger with given name were found */
+	return -ENODEV;
+}
+
+/**
+ * @brief Write global attribute of a device.
+ * @param device - String containing device name.
+ * @param ctx - IIO instance and conn instance
+ * @param attr - String containing attribute name.
+ * @param buf - Value to be written.
+ * @param len - Length of data.
+ * @return Number of written bytes.
+ */
+static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
+			  struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	struct iio_dev_priv	*dev;
+#ifndef IIO_NO_TRIGGERS
+	struct iio_trig_priv *trig_dev;
+#endif
+	struct attr_fun_params	params;
+	const struct iio_attribute	*attributes;
+	struct iio_ch_info ch_info;
+	const struct iio_channel *ch = NULL;
+	uint32_t *hashes;
+	uint32_t ch_idx = 0;
+	int8_t ch_out;
+
+	dev = get_iio_device(ctx->instance, device);
+
+	/* If IIO device with given name is found, handle writing of attributes */
+	if (dev) {
+		iio_use_dev_index(ctx->instance, dev);
+
+#ifdef IIO_NO_DEBUG_ATTRS
+		if (attr->type == IIO_ATTR_TYPE_DEBUG)
+			return -ENOENT;
+#else
+		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
+		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
+			if (dev->dev_descriptor->debug_reg_write)
+				return debug_reg_write(dev, buf, len);
+			return -ENOENT;
+		}
+#endif
+#ifdef IIO_COMPRESSION
+		if (attr->type == IIO_ATTR_TYPE_BUFFER &&
+		    dev->buffer.initalized &&
+		    strcmp(attr->name, COMPRESSION_ATTRIBUTE) == 0)
+			return iio_codec_set(dev, buf, len);
+#endif
+#ifdef IIO_PRETRIGGER
+		if (attr->type == IIO_ATTR_TYPE_BUFFER &&
+		    dev->buffer.initalized) {
+			int ret = iio_hist_attr_store(dev, attr->name, buf, len);
+
+			if (ret != -ENOENT)
+				return ret;
+		}
+#endif
+
+		if (attr->channel[0] != '\0') {
+			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
+			ch = iio_get_channel(attr->channel, dev, ch_out,
+					     &ch_idx);
+			if (!ch)
+				return -ENOENT;
+
+			ch_info.ch_out = ch_out;
+			ch_info.ch_num = ch->channel;
+			ch_info.type = ch->ch_type;
+			ch_info.differential = ch->diferential;
+			ch_info.address = ch->address;
+			params.ch_info = &ch_info;
+		} else {
+			params.ch_info = NULL;
+		}
+
+		params.buf = (char *)buf;
+		params.len = len;
+		params.dev_instance = dev->dev_instance;
+		attributes = get_attributes(attr->type, dev, ch);
+		hashes = get_attr_hashes(attr->type, dev, ch_idx);
+		if (iio_is_attr_list(attr->name))
+			return iio_write_attr_list(&params, attributes, hashes,
+						   attr->name);
+		return iio_rd_wr_attribute(&params, attributes, hashes,
+					   attr->name, 1);
+	}
+
+#ifndef IIO_NO_TRIGGERS
+	/* IIO device with given name is not found, verify if it corresponds to a trigger */
+	trig_dev = get_iio_trig_device(ctx->instance, device);
+
+	/* If IIO trigger with given name is found, handle writing of attributes */
+	if(trig_dev) {
+		params.ch_info = NULL; /* Triggers cannot have channels */
+		params.buf = (char *)buf;
+		params.len = len;
+		params.dev_instance = trig_dev->instance;
+		attributes = get_trig_attributes(attr->type, trig_dev);
+		if (iio_is_attr_list(attr->name))
+			return iio_write_attr_list(&params, attributes, NULL,
+						   attr->name);
+		return iio_rd_wr_attribute(&params, attributes, NULL,
+					   attr->name, 1);
+	}
+#endif
+
+	/* No device and no trigger with given name were found */
+	return -ENODEV;
+}
+
+#ifndef IIO_NO_TRIGGERS
+/**
+ * @brief Searches for trigger id and returns trigger index.
+ * @param desc - IIO descriptor.
+ * @param id   - Trigger id (trigger0, trigger1, etc.).
+ * @return Trigger index. NO_TRIGGER in case trigger is not found.
+ */
+static uint32_t iio_get_trig_idx_by_id(struct iio_desc *desc, const char *id)
+{
+	uint32_t i;
+
+	if (!id)
+		return NO_TRIGGER;
+
+	for (i = 0; i < desc->nb_trigs; i++)
+		if (strcmp(desc->trigs[i].id, id) == 0)
+			return i;
+
+	return NO_TRIGGER;
+}
+
+/**
+ * @brief Searches for trigger name and returns trigger index.
+ * @param desc - IIO descriptor.
+ * @param name - Trigger name.
+ * @return Trigger index. NO_TRIGGER in case trigger is not found.
+ */
+static uint32_t iio_get_trig_idx_by_name(struct iio_desc *desc,
+		const char *name)
+{
+	uint32_t i;
+
+	if (!name)
+		return NO_TRIGGER;
+
+	for (i = 0; i < desc->nb_trigs; i++)
+		if (strcmp(desc->trigs[i].name, name) == 0)
+			return i;
+
+	return NO_TRIGGER;
+}
+
+/**
+ * @brief Searches for active trigger of the given device and returns trigger name.
+ * @param ctx     - IIO instance and conn instance.
+ * @param device  - String containing device name.
+ * @param trigger - Trigger name to be returned.
+ * @param len     - Maximum length of value to be stored in name.
+ * @return Number of bytes written in name.
+ */
+static int iio_get_trigger(struct iiod_ctx *ctx, const char *device,
+			   char *trigger, uint32_t len)
+{
+	struct iio_dev_priv *dev;
+	struct iio_trig_priv *trig;
+	struct iio_desc *desc = ctx->instance;
+
+	if (!desc->nb_trigs)
+		return -ENOENT;
+
+	trig = get_iio_trig_device(desc, device);
+	/* Device is a trigger and triggers cannot have other triggers */
+	if (trig)
+		return -ENOENT;
+
+	dev = get_iio_device(desc, device);
+	if (!dev)
+		return -ENODEV;
+
+	if (dev->trig_idx == NO_TRIGGER) {
+		trigger[0] = '\0';
+
+		return 0;
+	}
+
+	return snprintf(trigger, len, "%s", desc->trigs[dev->trig_idx].name);
+}
+
+/**
+ * @brief Rebuild the list of the devices using each trigger, in device order,
+ * so a trigger event only visits its own devices instead of all of them.
+ * @param desc - IIO descriptor.
+ */
+static void iio_trig_update_devs(struct iio_desc *desc)
+{
+	struct iio_dev_priv *dev;
+	uint32_t state;
+	uint32_t i;
+
+	/* The lists are walked by the trigger interrupts */
+	state = no_os_critical_enter();
+
+	for (i = 0; i < desc->nb_trigs; i++)
+		desc->trigs[i].first_dev = NO_TRIGGER;
+
+	for (i = desc->nb_devs; i--; ) {
+		dev = desc->devs + i;
+		if (dev->trig_idx == NO_TRIGGER)
+			continue;
+
+		dev->trig_next = desc->trigs[dev->trig_idx].first_dev;
+		desc->trigs[dev->trig_idx].first_dev = i;
+	}
+
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Searches for given trigger id for the given device and if found, it
+ * sets the trigger.
+ * @param ctx     - IIO instance and conn instance.
+ * @param device  - String containing device name.
+ * @param trigger - Trigger id to be set.
+ * @param len     - Maximum length of value to be returned.
+ * @return Positive if index was set, negative if not.
+ */
+static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
+			   const char *trigger, uint32_t len)
+{
+	struct iio_dev_priv	*dev;
+	struct iio_trig_priv	*trig;
+	uint32_t i;
+	struct iio_desc *desc = ctx->instance;
+
+	if (!desc->nb_trigs)
+		return -ENOENT;
+
+	trig = get_iio_trig_device(desc, device);
+	/* Device is a trigger and triggers cannot have other triggers */
+	if (trig)
+		return -ENOENT;
+
+	dev = get_iio_device(desc, device);
+	if (!dev)
+		return -ENODEV;
+
+	if (trigger[0] == '\0') {
+		dev->trig_idx = NO_TRIGGER;
+		iio_trig_update_devs(desc);
+		return 0;
+	}
+
+	i = iio_get_trig_idx_by_id(desc, trigger);
+	if (i == NO_TRIGGER)
+		return -EINVAL;
+
+	dev->trig_idx = i;
+	iio_trig_update_devs(desc);
+
+	return len;
+}
+
+/**
+ * @brief Call the trigger handlers of the devices using a trigger, one after
+ * the other and with the same event time, so their samples stay aligned.
+ * @param desc - IIO descriptor.
+ * @param trig - Trigger that fired.
+ * @param cycles - no_os_get_cycles() of the trigger event.
+ */
+static void iio_trig_run_handlers(struct iio_desc *desc,
+				  struct iio_trig_priv *trig, uint32_t cycles)
+{
+	struct iio_dev_priv *dev;
+	uint32_t i;
+
+	for (i = trig->first_dev; i != NO_TRIGGER; i = dev->trig_next) {
+		dev = desc->devs + i;
+		if (!dev->dev_descriptor->trigger_handler)
+			continue;
+
+		dev->dev_data.trig_cycles = cycles;
+		dev->dev_descriptor->trigger_handler(&dev->dev_data);
+#ifdef NO_OS_PROFILING
+		iio_lat_trig_done(cycles);
+#endif
+	}
+}
+
+/**
+ * @brief Asynchronous trigger processing routine, run from the work queue of
+ * the IIO descriptor.
+ * @param work - Work of the trigger.
+ */
+static void iio_trig_work(struct no_os_work *work)
+{
+	struct iio_trig_priv *trig;
+
+	trig = (struct iio_trig_priv *)((uint8_t *)work -
+					offsetof(struct iio_trig_priv, work));
+	iio_trig_run_handlers(work->ctx, trig, trig->event_cycles);
+}
+#endif
+
+/**
+ * @brief Searches for trigger name and processes the trigger based on its
+ * type (sync or async with the interrupt).
+ * @param desc         - IIO descriptor.
+ * @param trigger_name - Trigger name.
+ *
+ * @return ret - Result of the processing procedure.
+ */
+#ifdef IIO_NO_TRIGGERS
+int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+{
+	return -ENOSYS;
+}
+
+int iio_process_trigger_at(struct iio_desc *desc, char *trigger_name,
+			   uint32_t cycles)
+{
+	return -ENOSYS;
+}
+#else
+int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+{
+	return iio_process_trigger_at(desc, trigger_name, no_os_get_cycles());
+}
+
+/**
+ * @brief Process a trigger whose event occurred at a given time, e.g. from
+ * the bottom half of a deferred hardware trigger. The latency measured in
+ * NO_OS_PROFILING builds then includes the time the event was queued.
+ * @param desc         - IIO descriptor.
+ * @param trigger_name - Trigger name.
+ * @param cycles       - no_os_get_cycles() when the event occurred.
+ *
+ * @return ret - Result of the processing procedure.
+ */
+int iio_process_trigger_at(struct iio_desc *desc, char *trigger_name,
+			   uint32_t cycles)
+{
+	uint32_t trig_id;
+	struct iio_trig_priv *trig;
+
+#ifdef NO_OS_PROFILING
+	iio_latency_mark(IIO_LATENCY_TRIGGER);
+#endif
+
+	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
+
+	if (trig_id == NO_TRIGGER)
+		return -EINVAL;
+
+	trig = &desc->trigs[trig_id];
+	if (trig->first_dev == NO_TRIGGER)
+		return 0;
+
+	if (trig->descriptor->is_synchronous) {
+		iio_trig_run_handlers(desc, trig, cycles);
+	} else {
+		trig->event_cycles = cycles;
+		no_os_work_post(&desc->wq, &trig->work);
+		iio_wakeup(desc);
+	}
+
+	return 0;
+}
+#endif
+
+/*
+ * Compute the layout of the scans of the channels in mask and return the size
+ * of a scan. Each element is aligned to its size and the scan to the largest
+ * element. ts_offset is set to the offset of the enabled timestamp channel in
+ * the scan or to -1.
+ */
+static uint32_t iio_scan_layout_init(struct iio_scan_layout *layout,
+				     const struct iio_channel *channels,
+				     uint32_t mask, int32_t *ts_offset)
+{
+	uint32_t cnt, i, length, largest = 1;
+
+	*ts_offset = -1;
+	layout->nb = 0;
+	layout->uniform = channels[no_os_find_first_set_bit(mask)].scan_type->
+			  storagebits / 8;
+	layout->dense = true;
+
+	cnt = 0;
+	i = 0;
+	while (mask) {
+		if ((mask & 1)) {
+			length = channels[i].scan_type->storagebits / 8;
+
+			if (length > largest)
+				largest = length;
+
+			if (cnt % length)
+				cnt += 2 * length - (cnt % length);
+			else
+				cnt += length;
+
+			if (channels[i].ch_type == IIO_TIMESTAMP &&
+			    length == sizeof(uint64_t))
+				*ts_offset = cnt - length;
+
+			if (length != layout->uniform ||
+			    cnt != (layout->nb + 1) * length)
+				layout->uniform = 0;
+			if (layout->nb && layout->ch[layout->nb - 1] != i - 1)
+				layout->dense = false;
+
+			layout->ch[layout->nb] = i;
+			layout->bytes[layout->nb] = length;
+			layout->offset[layout->nb] = cnt - length;
+			layout->nb++;
+		}
+
+		mask >>= 1;
+		++i;
+	}
+
+	if (cnt % largest)
+		cnt += largest - (cnt % largest);
+	layout->scan_bytes = cnt;
+
+	return cnt;
+}
+
+#ifdef IIO_COMPRESSION
+/* Free the buffers of the compression stage */
+static void iio_compress_close(struct iio_dev_priv *dev)
+{
+	no_os_free(dev->zraw);
+	no_os_free(dev->zbuf);
+	dev->zraw = NULL;
+	dev->zbuf = NULL;
+	dev->zcodec = IIO_CODEC_NONE;
+}
+
+/*
+ * Set up the compression stage for the scans of the opened buffer, with the
+ * codec chosen by the client.
+ */
+static int iio_compress_open(struct iio_dev_priv *dev, bool cyclic)
+{
+	const struct iio_channel *channels = dev->dev_descriptor->channels;
+	const struct iio_scan_layout *scan = &dev->buffer.public.layout;
+	struct iio_compress_layout *layout = &dev->zlayout;
+	uint32_t i;
+
+	/* Free in case iio_close_dev wasn't called to free them */
+	iio_compress_close(dev);
+
+	if (dev->codec == IIO_CODEC_NONE || cyclic)
+		return 0;
+
+	for (i = 0; i < scan->nb; i++) {
+		layout->elems[i].offset = scan->offset[i];
+		layout->elems[i].bytes = scan->bytes[i];
+		layout->elems[i].be =
+			channels[scan->ch[i]].scan_type->is_big_endian;
+	}
+	layout->nb = scan->nb;
+	layout->scan_bytes = scan->scan_bytes;
+
+	dev->zscans = no_os_max(1u, IIO_COMPRESS_BLOCK_SIZE /
+				layout->scan_bytes);
+	dev->zbuf_size = iio_compress_bound(layout, dev->zscans);
+	dev->zraw = no_os_calloc(dev->zscans, layout->scan_bytes);
+	dev->zbuf = no_os_calloc(dev->zbuf_size, sizeof(*dev->zbuf));
+	if (!dev->zraw || !dev->zbuf) {
+		iio_compress_close(dev);
+		return -ENOMEM;
+	}
+
+	dev->zraw_len = 0;
+	dev->zlen = 0;
+	dev->zidx = 0;
+	dev->zpending = 0;
+	dev->zleft = 0;
+	dev->zcodec = dev->codec;
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief Start the block producer of a device opened for input.
+ * @param dev - Device
+ * @param mask - Channels to be opened.
+ * @param samples - Scans in a block.
+ * @param cyclic - Cyclic buffers are output only and not supported.
+ * @return 0, negative value in case of failure.
+ */
+static int iio_ain_stream_open(struct iio_dev_priv *dev, uint32_t mask,
+			       uint32_t samples, bool cyclic)
+{
+	int32_t ret;
+
+	if (cyclic || no_os_ain_stream_scan_bytes(dev->ain_stream) !=
+	    dev->buffer.public.bytes_per_scan)
+		return -EINVAL;
+
+	if (dev->dev_descriptor->pre_enable) {
+		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	dev->ain_block = NULL;
+	dev->ain_sent = 0;
+	dev->ain_pending = 0;
+	dev->ain_overruns = 0;
+
+	ret = no_os_ain_stream_start(dev->ain_stream, samples);
+	if (NO_OS_IS_ERR_VALUE(ret) && dev->dev_descriptor->post_disable)
+		dev->dev_descriptor->post_disable(dev->dev_instance);
+
+	return ret;
+}
+
+/**
+ * @brief Get the unsent data of the oldest block of the producer.
+ * @param dev - Device
+ * @param buf - Where to store the address of the data.
+ * @param bytes - Maximum number of bytes requested.
+ * @return Number of bytes available at buf or negative value in case of error.
+ */
+static int iio_ain_stream_peek(struct iio_dev_priv *dev, char **buf,
+			       uint32_t bytes)
+{
+	uint32_t overruns;
+	int32_t ret;
+
+	if (!dev->ain_block) {
+		ret = no_os_ain_stream_get_block(dev->ain_stream,
+						 (void **)&dev->ain_block);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		dev->ain_sent = 0;
+
+		ret = no_os_ain_stream_get_overruns(dev->ain_stream, &overruns);
+		if (!ret && overruns != dev->ain_overruns) {
+			dev->ain_overruns = overruns;
+			NO_OS_COUNTER_ADD(dev->overruns, 1);
+#ifndef IIO_IGNORE_BUFF_OVERRUN_ERR
+			no_os_ain_stream_release_block(dev->ain_stream);
+			dev->ain_block = NULL;
+
+			return -NO_OS_EOVERRUN;
+#endif
+		}
+	}
+
+	*buf = (char *)dev->ain_block + dev->ain_sent;
+
+	return no_os_min(bytes, dev->buffer.public.size - dev->ain_sent);
+}
+
+/**
+ * @brief Mark data of the held block as sent, the block is given back to the
+ * producer once all of it was sent.
+ * @param dev - Device
+ * @param bytes - Number of bytes sent.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_ain_stream_consume(struct iio_dev_priv *dev, uint32_t bytes)
+{
+	if (!dev->ain_block)
+		return -EINVAL;
+
+	dev->ain_sent += bytes;
+	if (dev->ain_sent < dev->buffer.public.size)
+		return 0;
+
+	dev->ain_block = NULL;
+
+	return no_os_ain_stream_release_block(dev->ain_stream);
+}
+
+/*
+ * Take size bytes from the buffer arena, at the lowest aligned address not
+ * used by the buffer of an opened device. First fit, there are only a few
+ * devices.
+ */
+static int8_t *iio_arena_alloc(struct iio_desc *desc, uint32_t size)
+{
+	uintptr_t start = (uintptr_t)desc->buf_arena;
+	uintptr_t end = start + desc->buf_arena_len;
+	uintptr_t addr, used;
+	uint32_t i, j;
+
+	/* Candidates: the start of the arena and the end of each buffer */
+	for (i = 0; i <= desc->nb_devs; i++) {
+		if (i == desc->nb_devs) {
+			addr = start;
+		} else {
+			if (!desc->devs[i].buffer.arena_buf)
+				continue;
+			addr = (uintptr_t)desc->devs[i].buffer.arena_buf +
+			       desc->devs[i].buffer.arena_len;
+		}
+
+		addr = (addr + IIO_BUF_ARENA_ALIGN - 1) &
+		       ~(uintptr_t)(IIO_BUF_ARENA_ALIGN - 1);
+		if (addr < start || addr > end || end - addr < size)
+			continue;
+
+		for (j = 0; j < desc->nb_devs; j++) {
+			used = (uintptr_t)desc->devs[j].buffer.arena_buf;
+			if (used && used < addr + size &&
+			    addr < used + desc->devs[j].buffer.arena_len)
+				break;
+		}
+		if (j == desc->nb_devs)
+			return (int8_t *)addr;
+	}
+
+	return NULL;
+}
+
+/*
+ * Get the memory of the blocks of an opened buffer: the user buffer of the
+ * device, else a part of the arena, else the heap. From the arena, fewer
+ * blocks than requested are used when all of them don't fit.
+ */
+static int iio_buffer_alloc(struct iio_desc *desc, struct iio_dev_priv *dev,
+			    int8_t **buf, uint32_t *buf_size)
+{
+	struct iio_buffer_priv *buffer = &dev->buffer;
+	uint32_t nb;
+
+	if (buffer->raw_buf && buffer->raw_buf_len) {
+		if (buffer->raw_buf_len < buffer->public.size)
+			/* Need a bigger buffer or to allocate */
+			return -ENOMEM;
+		*buf_size = buffer->raw_buf_len - (buffer->raw_buf_len %
+						   buffer->public.size);
+		*buf = buffer->raw_buf;
+
+		return 0;
+	}
+
+	if (desc->buf_arena) {
+		for (nb = buffer->buffers_count; nb; nb--) {
+			*buf = iio_arena_alloc(desc, buffer->public.size * nb);
+			if (*buf)
+				break;
+		}
+		if (!nb)
+			return -ENOMEM;
+
+		*buf_size = buffer->public.size * nb;
+		buffer->arena_buf = *buf;
+		buffer->arena_len = *buf_size;
+
+		return 0;
+	}
+
+	*buf_size = buffer->public.size * buffer->buffers_count;
+	*buf = (int8_t *)no_os_calloc(*buf_size, sizeof(**buf));
+	if (!*buf)
+		return -ENOMEM;
+	buffer->allocated = 1;
+
+	return 0;
+}
+
+/* Give back the memory taken by iio_buffer_alloc() */
+static void iio_buffer_free(struct iio_dev_priv *dev)
+{
+	if (dev->buffer.allocated) {
+		no_os_free(dev->buffer.cb.buff);
+		dev->buffer.allocated = 0;
+	}
+
+	dev->buffer.arena_buf = NULL;
+	dev->buffer.arena_len = 0;
+}
+
+/**
+ * @brief  Open device.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param sample_size - Sample size.
+ * @param mask - Channels to be opened.
+ * @return 0, negative value in case of failure.
+ */
+static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
+			uint32_t samples, uint32_t mask, bool cyclic)
+{
+	struct iio_dev_priv *dev;
+	struct iio_trig_priv *trig;
+	uint32_t ch_mask;
+	int32_t ret;
+	int8_t *buf;
+	uint32_t buf_size;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -ENODEV;
+
+	if (!dev->buffer.initalized)
+		return -EINVAL;
+
+	ch_mask = 0xFFFFFFFF >> (32 - dev->dev_descriptor->num_ch);
+	mask &= ch_mask;
+	if (!mask)
+		return -ENOENT;
+
+	dev->buffer.public.cyclic_info.is_cyclic = cyclic;
+	dev->buffer.public.cyclic_info.buff_index = 0;
+
+	dev->buffer.public.active_mask = mask;
+	dev->buffer.public.bytes_per_scan =
+		iio_scan_layout_init(&dev->buffer.public.layout,
+				     dev->dev_descriptor->channels, mask,
+				     &dev->buffer.ts_offset);
+	dev->buffer.ts_last = 0;
+	dev->buffer.block = NULL;
+#ifdef NO_OS_PROFILING
+	dev->buffer.lat_in = 0;
+	dev->buffer.lat_out = 0;
+	dev->buffer.lat_mark = false;
+#endif
+	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
+	dev->buffer.public.samples = samples;
+	if (!dev->buffer.public.size)
+		return -EINVAL;
+
+#ifdef IIO_COMPRESSION
+	ret = iio_compress_open(dev, cyclic);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+#endif
+
+	if (dev->ain_stream)
+		return iio_ain_stream_open(dev, mask, samples, cyclic);
+
+	/* Free in case iio_close_dev wasn't called to free it */
+	iio_buffer_free(dev);
+
+	ret = iio_buffer_alloc(ctx->instance, dev, &buf, &buf_size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	dev->buffer.public.nb_blocks = no_os_min(dev->buffer.buffers_count,
+				       buf_size / dev->buffer.public.size);
+
+	ret = no_os_cb_cfg(&dev->buffer.cb, buf, buf_size);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		if (dev->buffer.allocated)
+			no_os_free(buf);
+		dev->buffer.allocated = 0;
+		iio_buffer_free(dev);
+
+		return ret;
+	}
+
+#ifdef IIO_PRETRIGGER
+	ret = iio_hist_open(dev);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		iio_buffer_free(dev);
+
+		return ret;
+	}
+#endif
+
+	if (dev->dev_descriptor->pre_enable) {
+		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			iio_buffer_free(dev);
+			return ret;
+		}
+	}
+
+	trig = iio_dev_trig(ctx->instance, dev);
+	if (trig && trig->descriptor->enable)
+		ret = trig->descriptor->enable(trig->instance);
+
+	return ret;
+}
+
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+/**
+ * @brief Stop streaming the buffer data of a device.
+ * @param dev - Device
+ */
+static void iio_stream_stop(struct iio_dev_priv *dev)
+{
+	if (!dev->stream)
+		return;
+
+	socket_remove(dev->stream->sock);
+	no_os_free(dev->stream);
+	dev->stream = NULL;
+}
+#endif
+
+/**
+ * @brief Close device.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @return 0, negative value in case of failure.
+ */
+static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
+{
+	struct iio_dev_priv *dev;
+	struct iio_trig_priv *trig;
+	int ret = 0;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -1;
+
+	if (!dev->buffer.initalized)
+		return -EINVAL;
+
+#ifdef IIO_COMPRESSION
+	iio_compress_close(dev);
+#endif
+#ifdef IIO_PRETRIGGER
+	dev->buffer.hist_state = IIO_HIST_OFF;
+#endif
+
+	if (dev->ain_stream) {
+		dev->ain_block = NULL;
+		ret = no_os_ain_stream_stop(dev->ain_stream);
+		dev->buffer.public.active_mask = 0;
+		if (dev->dev_descriptor->post_disable)
+			dev->dev_descriptor->post_disable(dev->dev_instance);
+
+		return ret;
+	}
+
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	iio_stream_stop(dev);
+#endif
+
+	iio_buffer_free(dev);
+
+	trig = iio_dev_trig(ctx->instance, dev);
+	if (trig && trig->descriptor->disable) {
+		ret = trig->descriptor->disable(trig->instance);
+		if (ret)
+			return ret;
+	}
+
+	dev->buffer.public.active_mask = 0;
+	if (dev->dev_descriptor->post_disable)
+		ret = dev->dev_descriptor->post_disable(dev->dev_instance);
+
+	return ret;
+}
+
+/* Have the device fill or empty a block of its buffer */
+static int iio_dev_submit(struct iio_dev_priv *dev,
+			  enum iio_buffer_direction dir)
+{
+	if (dev->dev_descriptor->submit && dev->trig_idx==NO_TRIGGER)
+		return dev->dev_descriptor->submit(&dev->dev_data);
+	else if ((dir == IIO_DIRECTION_INPUT && dev->dev_descriptor->read_dev
+		  && dev->trig_idx==NO_TRIGGER)
+		 || (dir == IIO_DIRECTION_OUTPUT &&
+		     dev->dev_descriptor->write_dev && dev->trig_idx==NO_TRIGGER)) {
+		/* Code used to don't break devices using read_dev */
+		int32_t ret;
+		void *buff;
+		struct iio_buffer *buffer = &dev->buffer.public;
+
+		ret = iio_buffer_get_block(buffer, &buff);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (dir == IIO_DIRECTION_INPUT)
+			ret = dev->dev_descriptor->read_dev(dev->dev_instance,
+							    buff, buffer->samples);
+		else
+			ret = dev->dev_descriptor->write_dev(dev->dev_instance,
+							     buff, buffer->samples);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return iio_buffer_block_done(buffer);
+	}
+
+	return 0;
+}
+
+static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
+			   enum iio_buffer_direction dir)
+{
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	dev->buffer.public.dir = dir;
+	if (dev->ain_stream)
+		/* The producer fills its blocks on its own */
+		return dir == IIO_DIRECTION_INPUT ? 0 : -ENOSYS;
+
+#ifdef IIO_PRETRIGGER
+	if (dir == IIO_DIRECTION_INPUT &&
+	    dev->buffer.hist_state != IIO_HIST_OFF)
+		/* The reads drive the capture */
+		return 0;
+#endif
+
+	return iio_dev_submit(dev, dir);
+}
+
+#ifdef IIO_PRETRIGGER
+/* Arm the next capture when the clients read all of the current one */
+static void iio_hist_read(struct iio_dev_priv *dev)
+{
+	uint32_t size;
+
+	if (dev->buffer.hist_state != IIO_HIST_FROZEN)
+		return;
+
+	if (!no_os_cb_size(&dev->buffer.cb, &size) && !size)
+		iio_hist_arm(&dev->buffer);
+}
+
+/*
+ * Return 0 once the capture can be read, driving the devices that fill their
+ * blocks on refills while it is not done.
+ */
+static int iio_hist_ready(struct iio_dev_priv *dev)
+{
+	int ret;
+
+	/* Also rearms after a capture holding no scan */
+	iio_hist_read(dev);
+
+	if (dev->buffer.hist_state == IIO_HIST_OFF ||
+	    dev->buffer.hist_state == IIO_HIST_FROZEN)
+		return 0;
+
+	if (dev->trig_idx == NO_TRIGGER) {
+		ret = iio_dev_submit(dev, IIO_DIRECTION_INPUT);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return dev->buffer.hist_state == IIO_HIST_FROZEN ? 0 : -EAGAIN;
+}
+#endif
+
+static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	return iio_call_submit(ctx, device, IIO_DIRECTION_OUTPUT);
+}
+
+static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+}
+
+/* Copy up to bytes bytes of the buffer data of dev to buf */
+static int iio_read_raw(struct iio_dev_priv *dev, char *buf, uint32_t bytes)
+{
+	int32_t			ret;
+	uint32_t		size;
+
+	if (dev->ain_stream) {
+		char *data;
+
+		ret = iio_ain_stream_peek(dev, &data, bytes);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		memcpy(buf, data, ret);
+		bytes = ret;
+		ret = iio_ain_stream_consume(dev, bytes);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		NO_OS_COUNTER_ADD(dev->bytes, bytes);
+
+		return bytes;
+	}
+
+#ifdef IIO_PRETRIGGER
+	ret = iio_hist_ready(dev);
+	if (ret)
+		return ret;
+#endif
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (ret == -NO_OS_EOVERRUN)
+		NO_OS_COUNTER_ADD(dev->overruns, 1);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+#warning Buffer overrun error checking is disabled.
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	bytes = no_os_min(size, bytes);
+	if (!bytes)
+		return -EAGAIN;
+
+
+	ret = no_os_cb_read(&dev->buffer.cb, buf, bytes);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	NO_OS_COUNTER_ADD(dev->bytes, bytes);
+#ifdef NO_OS_PROFILING
+	iio_lat_read(&dev->buffer, bytes);
+#endif
+#ifdef IIO_PRETRIGGER
+	iio_hist_read(dev);
+#endif
+
+	return bytes;
+}
+
+#ifdef IIO_COMPRESSION
+/*
+ * Get up to bytes bytes of compressed data. When the frames of the previous
+ * reads are sent, the raw data available is read and compressed in frames of
+ * up to zscans scans. A partial scan is kept for the next frame.
+ *
+ * A READBUF must be answered with the number of bytes requested. Devices
+ * that fill a single block on each refill have no more data to compress once
+ * it is sent, so the rest of their READBUF is padded with zeros, which the
+ * clients skip. Devices producing data continuously wait for more instead.
+ */
+static int iio_compress_get_block(struct iio_dev_priv *dev, char **buf,
+				  uint32_t bytes)
+{
+	struct iio_compress_layout *layout = &dev->zlayout;
+	uint32_t nb, used;
+	int32_t ret;
+
+	if (dev->zidx == dev->zlen) {
+		dev->zidx = 0;
+		dev->zlen = 0;
+
+		ret = iio_read_raw(dev, (char *)dev->zraw + dev->zraw_len,
+				   dev->zscans * layout->scan_bytes -
+				   dev->zraw_len);
+		if (ret == -EAGAIN)
+			ret = 0;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		dev->zraw_len += ret;
+
+		nb = dev->zraw_len / layout->scan_bytes;
+		if (nb) {
+			ret = iio_compress_delta(layout, dev->zraw, nb,
+						 dev->zbuf, dev->zbuf_size);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+			dev->zlen = ret;
+
+			used = nb * layout->scan_bytes;
+			dev->zraw_len -= used;
+			memmove(dev->zraw, dev->zraw + used, dev->zraw_len);
+		} else {
+			/* Only pad a READBUF already started */
+			if (bytes != dev->zleft || dev->ain_stream ||
+			    dev->trig_idx != NO_TRIGGER)
+				return -EAGAIN;
+
+			dev->zlen = no_os_min(bytes, dev->zbuf_size);
+			memset(dev->zbuf, 0, dev->zlen);
+		}
+	}
+
+	ret = no_os_min(bytes, dev->zlen - dev->zidx);
+	*buf = (char *)dev->zbuf + dev->zidx;
+	dev->zpending = ret;
+	dev->zleft = bytes - ret;
+
+	return ret;
+}
+#endif
+
+/**
+ * @brief Read chunk of data from RAM to pbuf. Call
+ * "iio_transfer_dev_to_mem()" first.
+ * @param device - String containing device name.
+ * @param pbuf - Buffer where value is stored.
+ * @param offset - Offset to the remaining data after reading n chunks.
+ * @param bytes_count - Number of bytes to read.
+ * @return: Bytes_count or negative value in case of error.
+ */
+static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
+			   uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+#ifdef IIO_COMPRESSION
+	if (dev->zcodec != IIO_CODEC_NONE) {
+		char *data;
+		int32_t ret;
+
+		ret = iio_compress_get_block(dev, &data, bytes);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		memcpy(buf, data, ret);
+		dev->zidx += ret;
+
+		return ret;
+	}
+#endif
+
+	return iio_read_raw(dev, buf, bytes);
+}
+
+/**
+ * @brief Get the address of data ready to be sent, without copying it.
+ * The data remains in the buffer until iio_read_block_done() is called.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param buf - Where to store the address of the data.
+ * @param bytes - Maximum number of bytes requested.
+ * @return Number of bytes available at buf or negative value in case of error.
+ */
+static int iio_get_read_block(struct iiod_ctx *ctx, const char *device,
+			      char **buf, uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+	uint32_t		size;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+#ifdef IIO_COMPRESSION
+	if (dev->zcodec != IIO_CODEC_NONE)
+		return iio_compress_get_block(dev, buf, bytes);
+#endif
+
+	if (dev->ain_stream) {
+		ret = iio_ain_stream_peek(dev, buf, bytes);
+		dev->ain_pending = NO_OS_IS_ERR_VALUE(ret) ? 0 : ret;
+		NO_OS_COUNTER_ADD(dev->bytes, dev->ain_pending);
+
+		return ret;
+	}
+
+#ifdef IIO_PRETRIGGER
+	ret = iio_hist_ready(dev);
+	if (ret)
+		return ret;
+#endif
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (ret == -NO_OS_EOVERRUN)
+		NO_OS_COUNTER_ADD(dev->overruns, 1);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	bytes = no_os_min(size, bytes);
+	if (!bytes)
+		return -EAGAIN;
+
+	ret = no_os_cb_prepare_async_read(&dev->buffer.cb, bytes, (void **)buf,
+					  &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	if (!size)
+		return -EAGAIN;
+
+	NO_OS_COUNTER_ADD(dev->bytes, size);
+#ifdef NO_OS_PROFILING
+	iio_lat_read(&dev->buffer, size);
+#endif
+
+	return size;
+}
+
+/**
+ * @brief Mark the block returned by iio_get_read_block() as consumed.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_read_block_done(struct iiod_ctx *ctx, const char *device)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+#ifdef IIO_COMPRESSION
+	if (dev->zcodec != IIO_CODEC_NONE) {
+		dev->zidx += dev->zpending;
+		dev->zpending = 0;
+		return 0;
+	}
+#endif
+
+	if (dev->ain_stream)
+		return iio_ain_stream_consume(dev, dev->ain_pending);
+
+	ret = no_os_cb_end_async_read(&dev->buffer.cb);
+#ifdef IIO_PRETRIGGER
+	iio_hist_read(dev);
+#endif
+
+	return ret;
+}
+
+/**
+ * @brief Get the address where data for the DAC can be received directly.
+ * The data is committed by iio_write_block_done().
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param buf - Where to store the address of the free space.
+ * @param bytes - Maximum number of bytes requested.
+ * @return Number of bytes that fit at buf or negative value in case of error.
+ */
+static int iio_get_write_block(struct iiod_ctx *ctx, const char *device,
+			       char **buf, uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+	uint32_t		size;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	bytes = no_os_min(dev->buffer.public.size - size, bytes);
+	if (!bytes)
+		return 0;
+
+	ret = no_os_cb_prepare_async_write(&dev->buffer.cb, bytes, (void **)buf,
+					   &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return size;
 }
 
 /**
- * @brief Read global attribute of a device.
+ * @brief Commit the bytes received in the block of iio_get_write_block().
  * @param ctx - IIO instance and conn instance
  * @param device - String containing device name.
- * @param attr - String containing attribute name.
- * @param buf - Buffer where value is read.
- * @param len - Maximum length of value to be stored in buf.
- * @return Number of bytes read.
+ * @param bytes - Number of bytes received.
+ * @return 0 or negative value in case of error.
  */
-static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
-			 struct iiod_attr *attr, char *buf, uint32_t len)
+static int iio_write_block_done(struct iiod_ctx *ctx, const char *device,
+				uint32_t bytes)
 {
-	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig_dev;
-	struct iio_ch_info ch_info;
-	struct iio_channel *ch = NULL;
-	struct attr_fun_params params;
-	struct iio_attribute *attributes;
-	int8_t ch_out;
+	struct iio_dev_priv	*dev;
 
 	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
 
-	/* If IIO device with given name is found, handle reading of attributes */
-	if (dev) {
-		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
-		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
-			if (dev->dev_descriptor->debug_reg_read)
-				return debug_reg_read(dev, buf, len);
-			return -ENOENT;
-		}
-
-		if (attr->channel[0] != '\0') {
-			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
-					     ch_out);
-			if (!ch)
-				return -ENOENT;
-			ch_info.ch_out = ch_out;
-			ch_info.ch_num = ch->channel;
-			ch_info.type = ch->ch_type;
-			ch_info.differential = ch->diferential;
-			ch_info.address = ch->address;
-			params.ch_info = &ch_info;
-		} else {
-			params.ch_info = NULL;
-		}
-
-		params.buf = buf;
-		params.len = len;
-		params.dev_instance = dev->dev_instance;
-		attributes = get_attributes(attr->type, dev, ch);
-		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
-	}
-
-	/* IIO device with given name is not found, verify if it corresponds to a trigger */
-	trig_dev = get_iio_trig_device(ctx->instance, device);
-
-	/* If IIO trigger with given name is found, handle reading of attributes */
-	if(trig_dev) {
-		params.ch_info = NULL; /* Triggers cannot have channels */
-		params.buf = buf;
-		params.len = len;
-		params.dev_instance = trig_dev->instance;
-		attributes = get_trig_attributes(attr->type, trig_dev);
-		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
-	}
+	NO_OS_COUNTER_ADD(dev->bytes, bytes);
 
-	/* No device and no trigger with given name were found */
-	return -ENODEV;
+	return no_os_cb_end_async_write_size(&dev->buffer.cb, bytes);
 }
 
 /**
- * @brief Write global attribute of a device.
+ * @brief Write chunk of data into RAM.
  * @param device - String containing device name.
- * @param ctx - IIO instance and conn instance
- * @param attr - String containing attribute name.
- * @param buf - Value to be written.
- * @param len - Length of data.
- * @return Number of written bytes.
+ * @param buf - Values to write.
+ * @param offset - Offset in memory after the nth chunk of data.
+ * @param bytes_count - Number of bytes to write.
+ * @return Bytes_count or negative value in case of error.
  */
-static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
-			  struct iiod_attr *attr, char *buf, uint32_t len)
+static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
+			    const char *buf, uint32_t bytes)
 {
 	struct iio_dev_priv	*dev;
-	struct iio_trig_priv *trig_dev;
-	struct attr_fun_params	params;
-	struct iio_attribute	*attributes;
-	struct iio_ch_info ch_info;
-	struct iio_channel *ch = NULL;
-	int8_t ch_out;
+	int32_t			ret;
+	uint32_t		available;
+	uint32_t		size;
 
 	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
 
-	/* If IIO device with given name is found, handle writing of attributes */
-	if (dev) {
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
 
-		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
-		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
-			if (dev->dev_descriptor->debug_reg_write)
-				return debug_reg_write(dev, buf, len);
-			return -ENOENT;
-		}
+	available = dev->buffer.public.size - size;
+	bytes = no_os_min(available, bytes);
+	ret = no_os_cb_write(&dev->buffer.cb, buf, bytes);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
 
-		if (attr->channel[0] != '\0') {
-			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
-					     ch_out);
-			if (!ch)
-				return -ENOENT;
+	NO_OS_COUNTER_ADD(dev->bytes, bytes);
 
-			ch_info.ch_out = ch_out;
-			ch_info.ch_num = ch->channel;
-			ch_info.type = ch->ch_type;
-			ch_info.differential = ch->diferential;
-			ch_info.address = ch->address;
-			params.ch_info = &ch_info;
-		} else {
-			params.ch_info = NULL;
-		}
+	return bytes;
+}
 
-		params.buf = (char *)buf;
-		params.len = len;
-		params.dev_instance = dev->dev_instance;
-		attributes = get_attributes(attr->type, dev, ch);
-		if (!strcmp(attr->name, ""))
-			return iio_write_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
-	}
+int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
+{
+	struct iio_buffer_priv *priv = (struct iio_buffer_priv *)buffer;
+	uint32_t size;
+	int ret;
 
-	/* IIO device with given name is not found, verify if it corresponds to a trigger */
-	trig_dev = get_iio_trig_device(ctx->instance, device);
+	if (!buffer)
+		return -EINVAL;
 
-	/* If IIO trigger with given name is found, handle writing of attributes */
-	if(trig_dev) {
-		params.ch_info = NULL; /* Triggers cannot have channels */
-		params.buf = (char *)buf;
-		params.len = len;
-		params.dev_instance = trig_dev->instance;
-		attributes = get_trig_attributes(attr->type, trig_dev);
-		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+	if (buffer->dir == IIO_DIRECTION_INPUT) {
+		ret = no_os_cb_prepare_async_write(buffer->buf, buffer->size,
+						   addr, &size);
+		priv->block = ret ? NULL : *addr;
+
+		return ret;
 	}
 
-	/* No device and no trigger with given name were found */
-	return -ENODEV;
+	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
 }
 
-/**
- * @brief Searches for trigger id and returns trigger index.
- * @param desc - IIO descriptor.
- * @param id   - Trigger id (trigger0, trigger1, etc.).
- * @return Trigger index. NO_TRIGGER in case trigger is not found.
+/*
+ * Fill the timestamp channel of each scan of the block. The time when the
+ * block is done is given to the last scan and the time of the other scans is
+ * interpolated from the time of the previous block.
  */
-static uint32_t iio_get_trig_idx_by_id(struct iio_desc *desc, const char *id)
+static void iio_buffer_timestamp_block(struct iio_buffer_priv *priv)
 {
-	uint32_t i;
-
-	if (!id)
-		return NO_TRIGGER;
+	uint64_t now, step, ts;
+	uint32_t i, nb_scans;
+	uint8_t *scan;
+	int32_t ret;
 
-	for (i = 0; i < desc->nb_trigs; i++)
-		if (strcmp(desc->trigs[i].id, id) == 0)
-			return i;
+	if (priv->ts_offset < 0 || !priv->ts_timer || !priv->block ||
+	    !priv->public.bytes_per_scan)
+		return;
 
-	return NO_TRIGGER;
-}
+	ret = no_os_timer_get_elapsed_time_nsec(priv->ts_timer, &now);
+	if (ret)
+		return;
 
-/**
- * @brief Searches for trigger name and returns trigger index.
- * @param desc - IIO descriptor.
- * @param name - Trigger name.
- * @return Trigger index. NO_TRIGGER in case trigger is not found.
- */
-static uint32_t iio_get_trig_idx_by_name(struct iio_desc *desc,
-		const char *name)
-{
-	uint32_t i;
+	nb_scans = priv->public.size / priv->public.bytes_per_scan;
+	if (!nb_scans)
+		return;
 
-	if (!name)
-		return NO_TRIGGER;
+	step = 0;
+	if (priv->ts_last && now > priv->ts_last)
+		step = (now - priv->ts_last) / nb_scans;
 
-	for (i = 0; i < desc->nb_trigs; i++)
-		if (strcmp(desc->trigs[i].name, name) == 0)
-			return i;
+	scan = (uint8_t *)priv->block + priv->ts_offset;
+	ts = now - step * (nb_scans - 1);
+	for (i = 0; i < nb_scans; i++) {
+		memcpy(scan, &ts, sizeof(ts));
+		scan += priv->public.bytes_per_scan;
+		ts += step;
+	}
 
-	return NO_TRIGGER;
+	priv->ts_last = now;
 }
 
-/**
- * @brief Searches for active trigger of the given device and returns trigger name.
- * @param ctx     - IIO instance and conn instance.
- * @param device  - String containing device name.
- * @param trigger - Trigger name to be returned.
- * @param len     - Maximum length of value to be stored in name.
- * @return Number of bytes written in name.
- */
-static int iio_get_trigger(struct iiod_ctx *ctx, const char *device,
-			   char *trigger, uint32_t len)
+int iio_buffer_block_done(struct iio_buffer *buffer)
 {
-	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
-	struct iio_desc *desc = ctx->instance;
+	struct iio_buffer_priv *priv = (struct iio_buffer_priv *)buffer;
 
-	if (!desc->nb_trigs)
-		return -ENOENT;
+	if (!buffer)
+		return -EINVAL;
 
-	trig = get_iio_trig_device(desc, device);
-	/* Device is a trigger and triggers cannot have other triggers */
-	if (trig)
-		return -ENOENT;
+	if (buffer->dir == IIO_DIRECTION_INPUT) {
+		iio_buffer_timestamp_block(priv);
+#ifdef NO_OS_PROFILING
+		iio_lat_pushed(priv, buffer->size);
+#endif
+#ifdef IIO_PRETRIGGER
+		int ret;
 
-	dev = get_iio_device(desc, device);
-	if (!dev)
-		return -ENODEV;
+		if (priv->hist_state == IIO_HIST_FROZEN)
+			/* Keep the capture until it is read */
+			buffer->buf->write.async_size = 0;
 
-	if (dev->trig_idx == NO_TRIGGER) {
-		trigger[0] = '\0';
+		ret = no_os_cb_end_async_write(buffer->buf);
+		if (!ret && priv->block)
+			iio_hist_pushed(priv, priv->block,
+					buffer->size / buffer->bytes_per_scan);
+		priv->block = NULL;
 
-		return 0;
+		return ret;
+#else
+		priv->block = NULL;
+
+		return no_os_cb_end_async_write(buffer->buf);
+#endif
 	}
 
-	return snprintf(trigger, len, "%s", desc->trigs[dev->trig_idx].name);
+	return no_os_cb_end_async_read(buffer->buf);
 }
 
-/**
- * @brief Searches for given trigger id for the given device and if found, it
- * sets the trigger.
- * @param ctx     - IIO instance and conn instance.
- * @param device  - String containing device name.
- * @param trigger - Trigger id to be set.
- * @param len     - Maximum length of value to be returned.
- * @return Positive if index was set, negative if not.
- */
-static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
-			   const char *trigger, uint32_t len)
+/* Write to buffer iio_buffer.bytes_per_scan bytes from data */
+NO_OS_RAMFUNC
+int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
 {
-	struct iio_dev_priv	*dev;
-	struct iio_trig_priv	*trig;
-	uint32_t i;
-	struct iio_desc *desc = ctx->instance;
-
-	if (!desc->nb_trigs)
-		return -ENOENT;
+	int ret;
 
-	trig = get_iio_trig_device(desc, device);
-	/* Device is a trigger and triggers cannot have other triggers */
-	if (trig)
-		return -ENOENT;
+	if (!buffer)
+		return -EINVAL;
 
-	dev = get_iio_device(desc, device);
-	if (!dev)
-		return -ENODEV;
+#ifdef IIO_PRETRIGGER
+	struct iio_buffer_priv *priv = (struct iio_buffer_priv *)buffer;
 
-	if (trigger[0] == '\0') {
-		dev->trig_idx = NO_TRIGGER;
+	if (priv->hist_state == IIO_HIST_FROZEN)
+		/* Keep the capture until it is read */
 		return 0;
-	}
+#endif
 
-	i = iio_get_trig_idx_by_id(desc, trigger);
-	if (i == NO_TRIGGER)
+	ret = no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
+#ifdef NO_OS_PROFILING
+	if (!ret)
+		iio_lat_pushed((struct iio_buffer_priv *)buffer,
+			       buffer->bytes_per_scan);
+#endif
+#ifdef IIO_PRETRIGGER
+	if (!ret && priv->hist_state != IIO_HIST_OFF)
+		iio_hist_pushed(priv, data, 1);
+#endif
+
+	return ret;
+}
+
+/* Read from buffer iio_buffer.bytes_per_scan bytes into data */
+int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
+{
+	if (!buffer)
 		return -EINVAL;
 
-	dev->trig_idx = i;
+	int ret;
+
+	ret = no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
+
+	if (buffer->cyclic_info.is_cyclic) {
+		if (buffer->buf->read.idx == buffer->buf->write.idx)
+			buffer->buf->read.idx = 0;
+	}
 
-	return len;
+	return ret;
 }
 
-/**
- * @brief Asynchronous trigger processing routine.
- * @param desc - IIO descriptor.
+/*
+ * Write the values of the enabled channels of vals, indexed by channel, to
+ * their place in scan. Values are truncated to the storage size of their
+ * channel and 8 byte elements are zero extended. Layouts with elements of the
+ * same size and no padding are packed in a single loop, or copied at once
+ * when the channels are also consecutive and stored on 4 bytes.
  */
-static void iio_process_async_triggers(struct iio_desc *desc)
+NO_OS_RAMFUNC
+void iio_scan_pack(const struct iio_scan_layout *layout, const uint32_t *vals,
+		   void *scan)
 {
-	struct iio_dev_priv *dev;
+	uint8_t *p = scan;
+	uint64_t val64;
+	uint16_t val16;
 	uint32_t i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == NO_TRIGGER)
-			continue;
-
-		if (!desc->trigs[dev->trig_idx].triggered)
-			continue;
+	switch (layout->uniform) {
+	case 1:
+		for (i = 0; i < layout->nb; i++)
+			p[i] = vals[layout->ch[i]];
+		return;
+	case 2:
+		for (i = 0; i < layout->nb; i++) {
+			val16 = vals[layout->ch[i]];
+			memcpy(p + 2 * i, &val16, 2);
+		}
+		return;
+	case 4:
+		if (layout->dense) {
+			memcpy(p, vals + layout->ch[0], 4 * layout->nb);
+			return;
+		}
+		for (i = 0; i < layout->nb; i++)
+			memcpy(p + 4 * i, &vals[layout->ch[i]], 4);
+		return;
+	default:
+		break;
+	}
 
-		if (dev->dev_descriptor->trigger_handler) {
-			dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			desc->trigs[i].triggered = 0;
+	memset(p, 0, layout->scan_bytes);
+	for (i = 0; i < layout->nb; i++) {
+		switch (layout->bytes[i]) {
+		case 1:
+			p[layout->offset[i]] = vals[layout->ch[i]];
+			break;
+		case 2:
+			val16 = vals[layout->ch[i]];
+			memcpy(p + layout->offset[i], &val16, 2);
+			break;
+		case 4:
+			memcpy(p + layout->offset[i], &vals[layout->ch[i]], 4);
+			break;
+		case 8:
+			val64 = vals[layout->ch[i]];
+			memcpy(p + layout->offset[i], &val64, 8);
+			break;
+		default:
+			break;
 		}
 	}
 }
 
-/**
- * @brief Searches for trigger name and processes the trigger based on its
- * type (sync or async with the interrupt).
- * @param desc         - IIO descriptor.
- * @param trigger_name - Trigger name.
- *
- * @return ret - Result of the processing procedure.
+/*
+ * Read the enabled channels of scan to vals, indexed by channel. Values are
+ * zero extended and 8 byte elements are truncated.
  */
-int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+void iio_scan_unpack(const struct iio_scan_layout *layout, const void *scan,
+		     uint32_t *vals)
 {
+	const uint8_t *p = scan;
+	uint16_t val16;
 	uint32_t i;
-	uint32_t trig_id;
-	struct iio_trig_priv *trig;
 
-	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
+	if (layout->uniform == 4 && layout->dense) {
+		memcpy(vals + layout->ch[0], p, 4 * layout->nb);
+		return;
+	}
 
-	if (trig_id == NO_TRIGGER)
+	for (i = 0; i < layout->nb; i++) {
+		switch (layout->bytes[i]) {
+		case 1:
+			vals[layout->ch[i]] = p[layout->offset[i]];
+			break;
+		case 2:
+			memcpy(&val16, p + layout->offset[i], 2);
+			vals[layout->ch[i]] = val16;
+			break;
+		case 4:
+		case 8:
+			memcpy(&vals[layout->ch[i]], p + layout->offset[i], 4);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/*
+ * Pack vals, indexed by channel, in the next scan of buffer. The scan is
+ * written in place, the blocks of the buffer hold whole scans.
+ */
+NO_OS_RAMFUNC
+int iio_buffer_push_vals(struct iio_buffer *buffer, const uint32_t *vals)
+{
+	void *scan;
+	uint32_t size;
+	int ret;
+
+	if (!buffer || !vals)
 		return -EINVAL;
 
-	struct iio_dev_priv *dev;
+#ifdef IIO_PRETRIGGER
+	struct iio_buffer_priv *priv = (struct iio_buffer_priv *)buffer;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == trig_id) {
-			trig = &desc->trigs[trig_id];
-			if (trig->descriptor->is_synchronous) {
-				if (dev->dev_descriptor->trigger_handler)
-					dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			} else {
-				trig->triggered = 1;
-			}
-		}
+	if (priv->hist_state == IIO_HIST_FROZEN)
+		/* Keep the capture until it is read */
+		return 0;
+#endif
+
+	ret = no_os_cb_prepare_async_write(buffer->buf, buffer->bytes_per_scan,
+					   &scan, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (size == buffer->bytes_per_scan) {
+		iio_scan_pack(&buffer->layout, vals, scan);
+	} else {
+		/* Don't commit a partial scan */
+		buffer->buf->write.async_size = 0;
+		ret = -EINVAL;
 	}
 
-	return 0;
+	no_os_cb_end_async_write(buffer->buf);
+#ifdef NO_OS_PROFILING
+	if (!ret)
+		iio_lat_pushed((struct iio_buffer_priv *)buffer,
+			       buffer->bytes_per_scan);
+#endif
+#ifdef IIO_PRETRIGGER
+	if (!ret && priv->hist_state != IIO_HIST_OFF)
+		iio_hist_pushed(priv, scan, 1);
+#endif
+
+	return ret;
 }
 
-static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+
+static int32_t accept_network_clients(struct iio_desc *desc)
 {
-	uint32_t cnt, i, length, largest = 1;
+	struct tcp_socket_desc *sock;
+	struct iiod_conn_data data;
+	int32_t ret;
+	uint32_t id;
 
-	cnt = 0;
-	i = 0;
-	while (mask) {
-		if ((mask & 1)) {
-			length = channels[i].scan_type->storagebits / 8;
+	do {
+		ret = socket_accept(desc->server, &sock);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 
-			if (length > largest)
-				largest = length;
+		data.conn = sock;
+		data.buf = no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
+		data.len = IIOD_CONN_BUFFER_SIZE;
 
-			if (cnt % length)
-				cnt += 2 * length - (cnt % length);
-			else
-				cnt += length;
+		if (!data.buf) {
+			ret = -ENOMEM;
+			goto close_socket;
 		}
 
-		mask >>= 1;
-		++i;
-	}
+		ret = iiod_conn_add(desc->iiod, &data, &id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto free_buf;
 
-	if (cnt % largest)
-		cnt += largest - (cnt % largest);
+		desc->conn_link[id] = desc->net_link;
+		ret = _push_conn(desc, id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto remove_conn;
+	} while (true);
 
-	return cnt;
+	return 0;
+
+remove_conn:
+	iiod_conn_remove(desc->iiod, id, &data);
+free_buf:
+	no_os_free(data.buf);
+close_socket:
+	socket_remove(sock);
+
+	return ret;
 }
 
 /**
- * @brief  Open device.
+ * @brief Start or stop streaming the data of an opened input buffer as UDP
+ * datagrams. Each datagram starts with a struct iio_stream_hdr.
  * @param ctx - IIO instance and conn instance
  * @param device - String containing device name.
- * @param sample_size - Sample size.
- * @param mask - Channels to be opened.
- * @return 0, negative value in case of failure.
+ * @param address - Destination address, which may be a multicast group, or
+ * NULL to stop the stream.
+ * @param port - Destination port.
+ * @param bytes - Maximum payload of a datagram. 0 for IIO_STREAM_MAX_PAYLOAD.
+ * @return 0 or negative value in case of error.
  */
-static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
-			uint32_t samples, uint32_t mask, bool cyclic)
+static int iio_stream(struct iiod_ctx *ctx, const char *device,
+		      const char *address, uint16_t port, uint32_t bytes)
 {
-	struct iio_desc *desc;
+	struct tcp_socket_init_param sock_param = {0};
+	struct iio_desc *desc = ctx->instance;
+	struct iio_stream *stream;
 	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
-	uint32_t ch_mask;
+	uint32_t scan_size;
 	int32_t ret;
-	int8_t *buf;
-	uint32_t buf_size;
 
-	dev = get_iio_device(ctx->instance, device);
+	dev = get_iio_device(desc, device);
 	if (!dev)
 		return -ENODEV;
 
-	if (!dev->buffer.initalized)
+	if (!address) {
+		iio_stream_stop(dev);
+
+		return 0;
+	}
+
+	if (!desc->server || dev->ain_stream)
+		return -ENOSYS;
+
+	if (!dev->buffer.initalized || !dev->buffer.public.active_mask)
 		return -EINVAL;
 
-	ch_mask = 0xFFFFFFFF >> (32 - dev->dev_descriptor->num_ch);
-	mask &= ch_mask;
-	if (!mask)
-		return -ENOENT;
+	if (strlen(address) >= IIOD_STREAM_ADDR_LEN)
+		return -EINVAL;
 
-	dev->buffer.public.cyclic_info.is_cyclic = cyclic;
-	dev->buffer.public.cyclic_info.buff_index = 0;
+	if (!bytes || bytes > IIO_STREAM_MAX_PAYLOAD)
+		bytes = IIO_STREAM_MAX_PAYLOAD;
+	bytes = no_os_min(bytes, dev->buffer.public.size);
 
-	dev->buffer.public.active_mask = mask;
-	dev->buffer.public.bytes_per_scan =
-		bytes_per_scan(dev->dev_descriptor->channels, mask);
-	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
-	dev->buffer.public.samples = samples;
-	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
-		if (dev->buffer.raw_buf_len < dev->buffer.public.size)
-			/* Need a bigger buffer or to allocate */
-			return -ENOMEM;
-		buf_size = dev->buffer.raw_buf_len - (dev->buffer.raw_buf_len %
-						      dev->buffer.public.size);
-		buf = dev->buffer.raw_buf;
-	} else {
-		if (dev->buffer.allocated) {
-			/* Free in case iio_close_dev wasn't called to free it*/
-			no_os_free(dev->buffer.cb.buff);
-			dev->buffer.allocated = 0;
-		}
-		buf_size = dev->buffer.public.size;
-		buf = (int8_t *)no_os_calloc(dev->buffer.public.size, sizeof(*buf));
-		if (!buf)
-			return -ENOMEM;
-		dev->buffer.allocated = 1;
-	}
+	/* Datagrams hold whole scans, so that each one can be decoded alone */
+	scan_size = dev->buffer.public.bytes_per_scan;
+	bytes -= bytes % scan_size;
+	if (!bytes)
+		return -EINVAL;
 
-	ret = no_os_cb_cfg(&dev->buffer.cb, buf, buf_size);
+	iio_stream_stop(dev);
+
+	stream = no_os_calloc(1, sizeof(*stream) +
+			      sizeof(struct iio_stream_hdr) + bytes);
+	if (!stream)
+		return -ENOMEM;
+
+	sock_param.net = desc->server->net;
+	sock_param.proto = PROTOCOL_UDP;
+	ret = socket_init(&stream->sock, &sock_param);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
-		if (dev->buffer.allocated) {
-			no_os_free(dev->buffer.cb.buff);
-			dev->buffer.allocated = 0;
-		}
+		no_os_free(stream);
 
 		return ret;
 	}
 
-	if (dev->dev_descriptor->pre_enable) {
-		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
-		if (NO_OS_IS_ERR_VALUE(ret)) {
-			if (dev->buffer.allocated) {
-				no_os_free(dev->buffer.cb.buff);
-				dev->buffer.allocated = 0;
-			}
-			return ret;
-		}
-	}
-
-	desc = ctx->instance;
-	if (dev->trig_idx != NO_TRIGGER) {
-		trig = &desc->trigs[dev->trig_idx];
-		if (trig->descriptor->enable)
-			ret = trig->descriptor->enable(trig->instance);
-	}
+	strcpy(stream->address, address);
+	stream->to.addr = stream->address;
+	stream->to.port = port;
+	stream->payload = bytes;
+	stream->dgram = (uint8_t *)(stream + 1);
+	dev->stream = stream;
 
-	return ret;
+	return 0;
 }
 
 /**
- * @brief Close device.
- * @param ctx - IIO instance and conn instance
- * @param device - String containing device name.
- * @return 0, negative value in case of failure.
+ * @brief Send the buffer data of a streaming device. The buffer is refilled
+ * when less than a datagram is left. Datagrams which can't be sent are
+ * dropped, the transfer is never retried.
+ * @param desc - IIO descriptor.
+ * @param dev - Streaming device.
+ * @return 0 or negative value in case of error.
  */
-static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
+static int32_t iio_stream_step(struct iio_desc *desc, struct iio_dev_priv *dev)
 {
-	struct iio_desc *desc;
-	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
-	int ret = 0;
+	struct iiod_ctx ctx = {.instance = desc, .conn = NULL};
+	struct iio_stream *stream = dev->stream;
+	struct iio_stream_hdr *hdr = (struct iio_stream_hdr *)stream->dgram;
+	uint32_t size;
+	uint32_t i;
+	int32_t ret;
 
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev)
-		return -1;
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (ret == -NO_OS_EOVERRUN)
+		stream->flags |= IIO_STREAM_FLAG_OVERRUN;
+	else if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
 
-	if (!dev->buffer.initalized)
-		return -EINVAL;
+	if (size < stream->payload) {
+		ret = iio_refill_buffer(&ctx, dev->dev_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 
-	if (dev->buffer.allocated) {
-		/* Should something else be used to free internal strucutre */
-		no_os_free(dev->buffer.cb.buff);
-		dev->buffer.allocated = 0;
+		ret = no_os_cb_size(&dev->buffer.cb, &size);
+		if (ret == -NO_OS_EOVERRUN)
+			stream->flags |= IIO_STREAM_FLAG_OVERRUN;
+		else if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 	}
 
-	desc = ctx->instance;
-	if(dev->trig_idx != NO_TRIGGER) {
-		trig = &desc->trigs[dev->trig_idx];
-		if (trig->descriptor->disable) {
-			ret = trig->descriptor->disable(trig->instance);
-			if (ret)
-				return ret;
+	for (i = 0; i < IIO_STREAM_MAX_DGRAMS && size >= stream->payload; i++) {
+		ret = no_os_cb_read(&dev->buffer.cb, hdr + 1, stream->payload);
+		if (ret == -NO_OS_EOVERRUN)
+			stream->flags |= IIO_STREAM_FLAG_OVERRUN;
+		else if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		hdr->seq = stream->seq++;
+		hdr->flags = stream->flags;
+		hdr->len = stream->payload;
+
+		ret = socket_sendto(stream->sock, stream->dgram,
+				    sizeof(*hdr) + stream->payload, &stream->to);
+		/* The receiver sees a gap in seq for a dropped datagram */
+		if (!NO_OS_IS_ERR_VALUE(ret)) {
+			if (stream->flags & IIO_STREAM_FLAG_OVERRUN)
+				NO_OS_COUNTER_ADD(dev->overruns, 1);
+			NO_OS_COUNTER_ADD(dev->bytes, stream->payload);
+#ifdef NO_OS_PROFILING
+			iio_lat_read(&dev->buffer, stream->payload);
+#endif
+			stream->flags = 0;
 		}
+
+		size -= stream->payload;
 	}
 
-	dev->buffer.public.active_mask = 0;
-	if (dev->dev_descriptor->post_disable)
-		ret = dev->dev_descriptor->post_disable(dev->dev_instance);
+	return 0;
+}
 
-	return ret;
+/**
+ * @brief Block until a client connects or sends data. Returns right away if
+ * the network interface doesn't support waiting or if other links are served.
+ * @param desc - IIO descriptor.
+ */
+static void iio_wait_network(struct iio_desc *desc)
+{
+	/* The other links would not wake it up */
+	if (desc->server && desc->nb_links == 1)
+		socket_wait(desc->server, IIO_NET_WAIT_MS);
 }
 
-static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
-			   enum iio_buffer_direction dir)
+/**
+ * @brief Advance all the active UDP streams.
+ * @param desc - IIO descriptor.
+ * @return true if at least one stream is active.
+ */
+static bool iio_streams_step(struct iio_desc *desc)
 {
-	struct iio_dev_priv *dev;
+	bool active = false;
+	uint32_t i;
+	int32_t ret;
 
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
-		return -EINVAL;
+	for (i = 0; i < desc->nb_devs; i++) {
+		if (!desc->devs[i].stream)
+			continue;
 
-	dev->buffer.public.dir = dir;
-	if (dev->dev_descriptor->submit && dev->trig_idx==NO_TRIGGER)
-		return dev->dev_descriptor->submit(&dev->dev_data);
-	else if ((dir == IIO_DIRECTION_INPUT && dev->dev_descriptor->read_dev
-		  && dev->trig_idx==NO_TRIGGER)
-		 || (dir == IIO_DIRECTION_OUTPUT &&
-		     dev->dev_descriptor->write_dev && dev->trig_idx==NO_TRIGGER)) {
-		/* Code used to don't break devices using read_dev */
-		int32_t ret;
-		void *buff;
-		struct iio_buffer *buffer = &dev->buffer.public;
+		ret = iio_stream_step(desc, &desc->devs[i]);
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
+			iio_stream_stop(&desc->devs[i]);
+		else
+			active = true;
+	}
+
+	return active;
+}
+#endif
+
+/**
+ * @brief Select the connection to be served in the current step.
+ * Among the connections of the link with the highest priority, the one
+ * running the command with the highest priority is selected. Connections
+ * with the same priority are served in round robin order and a connection
+ * skipped for IIO_MAX_CONN_SKIPS steps is served regardless of its priority. The selected connection is removed from desc->conns.
+ * @param desc - IIO descriptor.
+ * @param conn_id - Selected connection.
+ * @param all_idle - Set if no connection has pending work.
+ * @return 0 in case of success or -EAGAIN if there are no connections.
+ */
+static int32_t iio_pick_conn(struct iio_desc *desc, uint32_t *conn_id,
+			     bool *all_idle)
+{
+	uint32_t ids[IIOD_MAX_CONNECTIONS];
+	int32_t prio, best_prio;
+	uint32_t i, n, best;
+
+	n = _nb_active_conns(desc);
+	if (!n)
+		return -EAGAIN;
 
-		ret = iio_buffer_get_block(buffer, &buff);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	for (i = 0; i < n; i++)
+		_pop_conn(desc, &ids[i]);
 
-		if (dir == IIO_DIRECTION_INPUT)
-			ret = dev->dev_descriptor->read_dev(dev->dev_instance,
-							    buff, buffer->samples);
-		else
-			ret = dev->dev_descriptor->write_dev(dev->dev_instance,
-							     buff, buffer->samples);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	best = 0;
+	best_prio = INT32_MAX;
+	*all_idle = true;
+	for (i = 0; i < n; i++) {
+		prio = iiod_conn_priority(desc->iiod, ids[i]);
+		if (prio != IIOD_CONN_IDLE_PRIORITY) {
+			*all_idle = false;
+			/* The link priority comes first */
+			prio += _conn_link(desc, ids[i])->prio *
+				(IIOD_CONN_IDLE_PRIORITY + 1);
+		} else {
+			prio = INT32_MAX - 1;
+		}
+		if (desc->conn_skips[ids[i]] >= IIO_MAX_CONN_SKIPS) {
+			best = i;
+			best_prio = INT32_MIN;
+		} else if (prio < best_prio) {
+			best = i;
+			best_prio = prio;
+		}
+	}
 
-		return iio_buffer_block_done(buffer);
+	for (i = 0; i < n; i++) {
+		if (i == best)
+			continue;
+		desc->conn_skips[ids[i]]++;
+		_push_conn(desc, ids[i]);
 	}
 
+	desc->conn_skips[ids[best]] = 0;
+	*conn_id = ids[best];
+
 	return 0;
 }
 
-static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
+/**
+ * @brief Wake up iio_step if it waits for new data.
+ * @param desc - IIO descriptor
+ */
+void iio_wakeup(struct iio_desc *desc)
 {
-	return iio_call_submit(ctx, device, IIO_DIRECTION_OUTPUT);
-}
+	if (!desc)
+		return;
 
-static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
-{
-	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
+	desc->wakeup_pending = true;
+	if (desc->wakeup_sem)
+		no_os_semaphore_give(desc->wakeup_sem);
 }
 
 /**
- * @brief Read chunk of data from RAM to pbuf. Call
- * "iio_transfer_dev_to_mem()" first.
- * @param device - String containing device name.
- * @param pbuf - Buffer where value is stored.
- * @param offset - Offset to the remaining data after reading n chunks.
- * @param bytes_count - Number of bytes to read.
- * @return: Bytes_count or negative value in case of error.
+ * @brief Sleep in the idle hook unless a wake up or a trigger is pending.
+ * Both are checked with the interrupts masked, so an interrupt arriving
+ * after the check ends the sleep instead of being missed.
+ * @param desc - IIO descriptor
  */
-static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
-			   uint32_t bytes)
+static void iio_idle(struct iio_desc *desc)
 {
-	struct iio_dev_priv	*dev;
-	int32_t			ret;
-	uint32_t		size;
-
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
-		return -EINVAL;
-
-	ret = no_os_cb_size(&dev->buffer.cb, &size);
-#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
-#warning Buffer overrun error checking is disabled.
-	if (ret != -NO_OS_EOVERRUN)
-#endif
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	uint32_t state;
+	bool pending;
 
-	bytes = no_os_min(size, bytes);
-	if (!bytes)
-		return -EAGAIN;
+	state = no_os_critical_enter();
 
+	pending = desc->wakeup_pending || no_os_workqueue_pending(&desc->wq);
 
-	ret = no_os_cb_read(&dev->buffer.cb, buf, bytes);
-#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
-	if (ret != -NO_OS_EOVERRUN)
-#endif
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	if (!pending)
+		desc->idle();
+	desc->wakeup_pending = false;
 
-	return bytes;
+	no_os_critical_exit(state);
 }
 
-
 /**
- * @brief Write chunk of data into RAM.
- * @param device - String containing device name.
- * @param buf - Values to write.
- * @param offset - Offset in memory after the nth chunk of data.
- * @param bytes_count - Number of bytes to write.
- * @return Bytes_count or negative value in case of error.
+ * @brief Serve one request of a connection, profiled as iio_conn_step when
+ * built with NO_OS_PROFILING.
+ * @param desc - IIO descriptor.
+ * @param conn_id - Connection to serve.
+ * @return The value returned by iiod_conn_step().
  */
-static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
-			    const char *buf, uint32_t bytes)
+static int iio_conn_step(struct iio_desc *desc, uint32_t conn_id)
 {
-	struct iio_dev_priv	*dev;
-	int32_t			ret;
-	uint32_t		available;
-	uint32_t		size;
-
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
-		return -EINVAL;
-
-	ret = no_os_cb_size(&dev->buffer.cb, &size);
-	if (NO_OS_IS_ERR_VALUE(ret))
-		return ret;
-
-	available = dev->buffer.public.size - size;
-	bytes = no_os_min(available, bytes);
-	ret = no_os_cb_write(&dev->buffer.cb, buf, bytes);
-	if (NO_OS_IS_ERR_VALUE(ret))
-		return ret;
+	NO_OS_PROFILE_SCOPE(iio_conn_step);
 
-	return bytes;
+	return iiod_conn_step(desc->iiod, conn_id);
 }
 
-int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
+/**
+ * @brief Release a connection closed by its client. The connection of a link
+ * other than the network is added again, for the next session of the host.
+ * @param desc - IIO descriptor.
+ * @param conn_id - Closed connection.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_conn_closed(struct iio_desc *desc, uint32_t conn_id)
 {
-	uint32_t size;
+	uint8_t link = desc->conn_link[conn_id];
+	struct iiod_conn_data data;
+	int ret;
 
-	if (!buffer)
-		return -EINVAL;
+	desc->conn_skips[conn_id] = 0;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr, &size);
+	iiod_conn_remove(desc->iiod, conn_id, &data);
 
-	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
-}
+	if (desc->links[link].phy_type != USE_NETWORK) {
+		ret = iiod_conn_add(desc->iiod, &data, &conn_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 
-int iio_buffer_block_done(struct iio_buffer *buffer)
-{
-	if (!buffer)
-		return -EINVAL;
+		desc->conn_link[conn_id] = link;
+		_push_conn(desc, conn_id);
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_end_async_write(buffer->buf);
+		return 0;
+	}
 
-	return no_os_cb_end_async_read(buffer->buf);
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	socket_remove(data.conn);
+	no_os_free(data.buf);
+#endif
+
+	return 0;
 }
 
-/* Write to buffer iio_buffer.bytes_per_scan bytes from data */
-int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
+/**
+ * @brief Take a connection to be served by the caller, for runtimes serving
+ * each connection from its own task instead of calling iio_step. New network
+ * clients are accepted first. The connection is owned by the caller until
+ * iio_conn_serve() reports it closed.
+ * @param desc - IIO descriptor.
+ * @param conn_id - Connection taken.
+ * @return 0, -EAGAIN if there is no connection to take or negative value in
+ * case of error.
+ */
+int iio_conn_get(struct iio_desc *desc, uint32_t *conn_id)
 {
-	if (!buffer)
-		return -EINVAL;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	int32_t ret;
+
+	if (desc->server) {
+		ret = accept_network_clients(desc);
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
+			return ret;
+	}
+#endif
 
-	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
+	return _pop_conn(desc, conn_id);
 }
 
-/* Read from buffer iio_buffer.bytes_per_scan bytes into data */
-int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
+/**
+ * @brief Serve one request of a connection taken with iio_conn_get().
+ * @param desc - IIO descriptor.
+ * @param conn_id - Connection to serve.
+ * @return 0 if the connection has more work, -EAGAIN if it waits for data
+ * from its client, -ENOTCONN once it was closed and released or negative
+ * value in case of error.
+ */
+int iio_conn_serve(struct iio_desc *desc, uint32_t conn_id)
 {
-	if (!buffer)
-		return -EINVAL;
-
 	int ret;
 
-	ret = no_os_cb_read(buffer->buf, data, buffer->bytes_per_scan);
+	ret = iio_conn_step(desc, conn_id);
+	if (ret == -ENOTCONN) {
+		ret = iio_conn_closed(desc, conn_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 
-	if (buffer->cyclic_info.is_cyclic) {
-		if (buffer->buf->read.idx == buffer->buf->write.idx)
-			buffer->buf->read.idx = 0;
+		return -ENOTCONN;
 	}
 
+	if (ret == -EAGAIN &&
+	    iiod_conn_priority(desc->iiod, conn_id) != IIOD_CONN_IDLE_PRIORITY)
+		return 0;
+
 	return ret;
 }
 
+/**
+ * @brief Run the work of iio_step that is not tied to a connection: the
+ * asynchronous triggers, the network stack and the UDP streams.
+ * @param desc - IIO descriptor.
+ * @return true while a UDP stream is active.
+ */
+bool iio_service_step(struct iio_desc *desc)
+{
+	bool streaming = false;
+
+	no_os_workqueue_run(&desc->wq);
+
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	if (desc->server) {
+#if defined(NO_OS_LWIP_NETWORKING)
+		no_os_lwip_step(desc->server->net->net, desc->server->net->net);
+#endif
+		streaming = iio_streams_step(desc);
+	}
+#endif
 
-static int32_t accept_network_clients(struct iio_desc *desc)
+	return streaming;
+}
+
+/**
+ * @brief Show the no_os_profile regions, for use as a debug attribute.
+ * @param device - Device instance, unused.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @param channel - Channel info, unused.
+ * @param priv - Attribute id, unused.
+ * @return Length of the output or negative value otherwise.
+ */
+int iio_profile_show(void *device, char *buf, uint32_t len,
+		     const struct iio_ch_info *channel, intptr_t priv)
 {
-	struct tcp_socket_desc *sock;
-	struct iiod_conn_data data;
-	int32_t ret;
-	uint32_t id;
+	return no_os_profile_show(buf, len);
+}
 
-	do {
-		ret = socket_accept(desc->server, &sock);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+/**
+ * @brief Clear the no_os_profile regions on any write.
+ * @param device - Device instance, unused.
+ * @param buf - Written value, ignored.
+ * @param len - Length of the written value.
+ * @param channel - Channel info, unused.
+ * @param priv - Attribute id, unused.
+ * @return Number of bytes consumed.
+ */
+int iio_profile_store(void *device, char *buf, uint32_t len,
+		      const struct iio_ch_info *channel, intptr_t priv)
+{
+	no_os_profile_reset();
 
-		data.conn = sock;
-		data.buf = no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
-		data.len = IIOD_CONN_BUFFER_SIZE;
+	return len;
+}
 
-		if (!data.buf) {
-			ret = -ENOMEM;
-			goto close_socket;
-		}
+/**
+ * @brief Show the no_os_counter values, for use as a debug attribute.
+ * @param device - Device instance, unused.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @param channel - Channel info, unused.
+ * @param priv - Attribute id, unused.
+ * @return Length of the output or negative value otherwise.
+ */
+int iio_counters_show(void *device, char *buf, uint32_t len,
+		      const struct iio_ch_info *channel, intptr_t priv)
+{
+	return no_os_counter_show(buf, len);
+}
 
-		ret = iiod_conn_add(desc->iiod, &data, &id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto free_buf;
+/**
+ * @brief Clear the no_os_counter values on any write.
+ * @param device - Device instance, unused.
+ * @param buf - Written value, ignored.
+ * @param len - Length of the written value.
+ * @param channel - Channel info, unused.
+ * @param priv - Attribute id, unused.
+ * @return Number of bytes consumed.
+ */
+int iio_counters_store(void *device, char *buf, uint32_t len,
+		       const struct iio_ch_info *channel, intptr_t priv)
+{
+	no_os_counter_reset();
 
-		ret = _push_conn(desc, id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto remove_conn;
-	} while (true);
+	return len;
+}
 
-	return 0;
+#ifdef NO_OS_BUS_TRACE
+/**
+ * @brief Show the next part of the no_os_bus_trace capture, for use as a
+ * debug attribute. The output is empty once the whole capture was read.
+ * @param device - Device instance, unused.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @param channel - Channel info, unused.
+ * @param priv - Attribute id, unused.
+ * @return Length of the output or negative value otherwise.
+ */
+int iio_bus_trace_show(void *device, char *buf, uint32_t len,
+		       const struct iio_ch_info *channel, intptr_t priv)
+{
+	return no_os_bus_trace_show(buf, len);
+}
 
-remove_conn:
-	iiod_conn_remove(desc->iiod, id, &data);
-free_buf:
-	no_os_free(data.buf);
-close_socket:
-	socket_remove(sock);
+/**
+ * @brief Control the no_os_bus_trace capture: "start" records until "stop",
+ * "start <count>" stops by itself after count transfers and "rewind" reads
+ * the capture again from its beginning.
+ * @param device - Device instance, unused.
+ * @param buf - Written command.
+ * @param len - Length of the written command.
+ * @param channel - Channel info, unused.
+ * @param priv - Attribute id, unused.
+ * @return Number of bytes consumed or negative value otherwise.
+ */
+int iio_bus_trace_store(void *device, char *buf, uint32_t len,
+			const struct iio_ch_info *channel, intptr_t priv)
+{
+	uint32_t count = 0;
+
+	if (!strncmp(buf, "start", 5)) {
+		if (buf[5] == ' ')
+			count = strtoul(buf + 6, NULL, 0);
+		no_os_bus_trace_start(count);
+	} else if (!strncmp(buf, "stop", 4)) {
+		no_os_bus_trace_stop();
+	} else if (!strncmp(buf, "rewind", 6)) {
+		no_os_bus_trace_rewind();
+	} else {
+		return -EINVAL;
+	}
 
-	return ret;
+	return len;
 }
 #endif
 
@@ -1487,11 +4302,12 @@ close_socket:
  */
 int iio_step(struct iio_desc *desc)
 {
-	struct iiod_conn_data data;
+	bool streaming = false;
 	uint32_t conn_id;
+	bool all_idle;
 	int32_t ret;
 
-	iio_process_async_triggers(desc);
+	no_os_workqueue_run(&desc->wq);
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 	if (desc->server) {
@@ -1501,289 +4317,555 @@ int iio_step(struct iio_desc *desc)
 #if defined(NO_OS_LWIP_NETWORKING)
 		no_os_lwip_step(desc->server->net->net, desc->server->net->net);
 #endif
+		streaming = iio_streams_step(desc);
 	}
 #endif
 
-	ret = _pop_conn(desc, &conn_id);
-	if (NO_OS_IS_ERR_VALUE(ret))
+	ret = iio_pick_conn(desc, &conn_id, &all_idle);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+		/* No clients yet, wait for one to connect */
+		if (!streaming)
+			iio_wait_network(desc);
+#endif
 		return ret;
+	}
 
-	ret = iiod_conn_step(desc->iiod, conn_id);
+	ret = iio_conn_step(desc, conn_id);
 	if (ret == -ENOTCONN) {
+		/* A transport host started over, so does the connection */
+		ret = iio_conn_closed(desc, conn_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return -ENOTCONN;
+	}
+
+	_push_conn(desc, conn_id);
+
+	/* Nothing received since the last step, wait for new data */
+	if (ret == -EAGAIN && all_idle && !streaming &&
+	    iiod_conn_priority(desc->iiod, conn_id) == IIOD_CONN_IDLE_PRIORITY) {
+		if (desc->wakeup_sem)
+			no_os_semaphore_take(desc->wakeup_sem);
+		else if (desc->idle)
+			iio_idle(desc);
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-		iiod_conn_remove(desc->iiod, conn_id, &data);
-		socket_remove(data.conn);
-		no_os_free(data.buf);
+		else
+			iio_wait_network(desc);
 #endif
-	} else {
-		_push_conn(desc, conn_id);
 	}
 
 	return ret;
 }
 
+#ifndef IIO_NO_XML_GEN
 /**
- * @brief Add context attributes into xml string buffer.
+ * @brief Add context attributes into xml.
  * @param desc - IIo descriptor.
- * @param buff - xml buffer.
- * @param buff_size - size of buffer
- * @return 0 in case of success or negative value otherwise.
+ * @param w - Writer of the xml.
  */
-static uint32_t iio_add_ctx_attr_in_xml(struct iio_desc *desc, char *buff,
-					uint32_t buff_size)
+static void iio_add_ctx_attr_in_xml(struct iio_desc *desc, struct iio_writer *w)
 {
 	struct iio_ctx_attr *attr;
-	char dummy_buff[50];
-	int32_t i;
 	int32_t j;
-	int32_t n;
-
-	if ((int32_t)buff_size == -1)
-		n = 0;
-	else
-		n = buff_size;
-
-	if (buff == NULL)
-		/* Set dummy value for buff. It is used only for counting */
-		buff = dummy_buff;
-
-	i = 0;
 
 	attr = desc->ctx_attrs;
 	if (attr)
 		for (j = 0; j < (int32_t)desc->nb_ctx_attr; j++) {
-			i += snprintf(buff + i,
-				      no_os_max(n - i, 0),
-				      "<context-attribute name=\"%s\" ",
-				      attr[j].name);
-
-			i += snprintf(buff + i,
-				      no_os_max(n - i, 0),
-				      "value=\"%s\" />",
-				      attr[j].value);
+			/* Values can be longer than a chunk */
+			iio_writer_printf(w, "<context-attribute name=\"");
+			iio_writer_write(w, attr[j].name, strlen(attr[j].name));
+			iio_writer_printf(w, "\" value=\"");
+			iio_writer_write(w, attr[j].value,
+					 strlen(attr[j].value));
+			iio_writer_printf(w, "\" />");
 		}
-
-	return i;
 }
 
 /*
- * Generate an xml describing a device and write it to buff.
- * Will return the size of the xml.
- * If buff_size is 0, no data will be written to buff, but size will be returned
+ * Generate an xml describing a device with the writer w.
+ * Will return 0 or a negative error code for invalid channels.
  */
-static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
-					char *id, char *buff,
-					uint32_t buff_size)
+static int32_t iio_generate_device_xml(struct iio_device *device, char *name,
+				       char *id, bool has_buffer,
+				       struct iio_writer *w)
 {
-	struct iio_channel	*ch;
-	struct iio_attribute	*attr;
+	const struct iio_channel	*ch;
+	const struct iio_attribute	*attr;
 	char			ch_id[50];
-	int32_t			i;
 	int32_t			j;
-	int32_t			k;
-	int32_t			n;
-
-	if ((int32_t)buff_size == -1)
-		n = 0;
-	else
-		n = buff_size;
-
-	if (buff == NULL)
-		/* Set dummy value for buff. It is used only for counting */
-		buff = ch_id;
-
-	i = 0;
+	int32_t			k;
 
-	i += snprintf(buff + i, no_os_max(n - i, 0),
-		      "<device id=\"%s\" name=\"%s\">", id, name);
+	iio_writer_printf(w,
+			  "<device id=\"%s\" name=\"%s\">", id, name);
 
 	/* Write channels */
 	if (device->channels)
 		for (j = 0; j < device->num_ch; j++) {
 			ch = &device->channels[j];
 			_print_ch_id(ch_id, ch);
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<channel id=\"%s\"",
-				      ch_id);
+			iio_writer_printf(w,
+					  "<channel id=\"%s\"",
+					  ch_id);
 			if(ch->name)
-				i += snprintf(buff + i, no_os_max(n - i, 0),
-					      " name=\"%s\"",
-					      ch->name);
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      " type=\"%s\" >",
-				      ch->ch_out ? "output" : "input");
+				iio_writer_printf(w,
+						  " name=\"%s\"",
+						  ch->name);
+			iio_writer_printf(w,
+					  " type=\"%s\" >",
+					  ch->ch_out ? "output" : "input");
 
 			if (ch->scan_type)
-				i += snprintf(buff + i, no_os_max(n - i, 0),
-					      "<scan-element index=\"%d\""
-					      " format=\"%s:%c%d/%d>>%d\" />",
-					      ch->scan_index,
-					      ch->scan_type->is_big_endian ? "be" : "le",
-					      ch->scan_type->sign,
-					      ch->scan_type->realbits,
-					      ch->scan_type->storagebits,
-					      ch->scan_type->shift);
+				iio_writer_printf(w,
+						  "<scan-element index=\"%d\""
+						  " format=\"%s:%c%d/%d>>%d\" />",
+						  ch->scan_index,
+						  ch->scan_type->is_big_endian ? "be" : "le",
+						  ch->scan_type->sign,
+						  ch->scan_type->realbits,
+						  ch->scan_type->storagebits,
+						  ch->scan_type->shift);
 
 			/* Write channel attributes */
 			if (ch->attributes)
 				for (k = 0; ch->attributes[k].name; k++) {
 					attr = &ch->attributes[k];
-					i += snprintf(buff + i, no_os_max(n - i, 0), "<attribute name=\"%s\" ",
-						      attr->name);
+					iio_writer_printf(w, "<attribute name=\"%s\" ",
+							  attr->name);
 					if (ch->diferential) {
 						switch (attr->shared) {
 						case IIO_SHARED_BY_ALL:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s\"",
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s\"",
+									  attr->name);
 							break;
 						case IIO_SHARED_BY_DIR:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s_%s\"",
+									  ch->ch_out ? "out" : "in",
+									  attr->name);
 							break;
 						case IIO_SHARED_BY_TYPE:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s-%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      iio_chan_type_string[ch->ch_type],
-								      iio_chan_type_string[ch->ch_type],
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s_%s-%s_%s\"",
+									  ch->ch_out ? "out" : "in",
+									  iio_chan_type_string[ch->ch_type],
+									  iio_chan_type_string[ch->ch_type],
+									  attr->name);
 							break;
 						case IIO_SEPARATE:
 							if (!ch->indexed) {
 								// Differential channels must be indexed!
 								return -EINVAL;
 							}
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s%d-%s%d_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      iio_chan_type_string[ch->ch_type],
-								      ch->channel,
-								      iio_chan_type_string[ch->ch_type],
-								      ch->channel2,
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s_%s%d-%s%d_%s\"",
+									  ch->ch_out ? "out" : "in",
+									  iio_chan_type_string[ch->ch_type],
+									  ch->channel,
+									  iio_chan_type_string[ch->ch_type],
+									  ch->channel2,
+									  attr->name);
 							break;
 						}
 					} else {
 						switch (attr->shared) {
 						case IIO_SHARED_BY_ALL:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s\"",
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s\"",
+									  attr->name);
 							break;
 						case IIO_SHARED_BY_DIR:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s_%s\"",
+									  ch->ch_out ? "out" : "in",
+									  attr->name);
 							break;
 						case IIO_SHARED_BY_TYPE:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      iio_chan_type_string[ch->ch_type],
-								      attr->name);
+							iio_writer_printf(w,
+									  "filename=\"%s_%s_%s\"",
+									  ch->ch_out ? "out" : "in",
+									  iio_chan_type_string[ch->ch_type],
+									  attr->name);
 							break;
 						case IIO_SEPARATE:
 							if (ch->indexed)
-								i += snprintf(buff + i, no_os_max(n - i, 0),
-									      "filename=\"%s_%s%d_%s\"",
-									      ch->ch_out ? "out" : "in",
-									      iio_chan_type_string[ch->ch_type],
-									      ch->channel,
-									      attr->name);
+								iio_writer_printf(w,
+										  "filename=\"%s_%s%d_%s\"",
+										  ch->ch_out ? "out" : "in",
+										  iio_chan_type_string[ch->ch_type],
+										  ch->channel,
+										  attr->name);
 							else
-								i += snprintf(buff + i, no_os_max(n - i, 0),
-									      "filename=\"%s_%s_%s\"",
-									      ch->ch_out ? "out" : "in",
-									      iio_chan_type_string[ch->ch_type],
-									      attr->name);
+								iio_writer_printf(w,
+										  "filename=\"%s_%s_%s\"",
+										  ch->ch_out ? "out" : "in",
+										  iio_chan_type_string[ch->ch_type],
+										  attr->name);
 							break;
 						}
 					}
-					i += snprintf(buff + i, no_os_max(n - i, 0), " />");
+					iio_writer_printf(w, " />");
 				}
 
-			i += snprintf(buff + i, no_os_max(n - i, 0), "</channel>");
+			iio_writer_printf(w, "</channel>");
 		}
 
 	/* Write device attributes */
 	if (device->attributes)
 		for (j = 0; device->attributes[j].name; j++)
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<attribute name=\"%s\" />",
-				      device->attributes[j].name);
+			iio_writer_printf(w,
+					  "<attribute name=\"%s\" />",
+					  device->attributes[j].name);
 
+#ifndef IIO_NO_DEBUG_ATTRS
 	/* Write debug attributes */
 	if (device->debug_attributes)
 		for (j = 0; device->debug_attributes[j].name; j++)
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<debug-attribute name=\"%s\" />",
-				      device->debug_attributes[j].name);
+			iio_writer_printf(w,
+					  "<debug-attribute name=\"%s\" />",
+					  device->debug_attributes[j].name);
 	if (device->debug_reg_read || device->debug_reg_write)
-		i += snprintf(buff + i, no_os_max(n - i, 0),
-			      "<debug-attribute name=\""REG_ACCESS_ATTRIBUTE"\" />");
+		iio_writer_printf(w,
+				  "<debug-attribute name=\""REG_ACCESS_ATTRIBUTE"\" />");
+#endif
 
 	/* Write buffer attributes */
 	if (device->buffer_attributes)
 		for (j = 0; device->buffer_attributes[j].name; j++)
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<buffer-attribute name=\"%s\" />",
-				      device->buffer_attributes[j].name);
+			iio_writer_printf(w,
+					  "<buffer-attribute name=\"%s\" />",
+					  device->buffer_attributes[j].name);
+#ifdef IIO_COMPRESSION
+	if (has_buffer)
+		iio_writer_printf(w,
+				  "<buffer-attribute name=\""COMPRESSION_ATTRIBUTE"\" />"
+				  "<buffer-attribute name=\""COMPRESSION_AVAIL_ATTRIBUTE"\" />");
+#endif
+#ifdef IIO_PRETRIGGER
+	if (has_buffer)
+		iio_writer_printf(w,
+				  "<buffer-attribute name=\""PRETRIGGER_ATTRIBUTE"\" />"
+				  "<buffer-attribute name=\""POSTTRIGGER_ATTRIBUTE"\" />"
+				  "<buffer-attribute name=\""THRESHOLD_ATTRIBUTE"\" />"
+				  "<buffer-attribute name=\""CAPTURE_STATE_ATTRIBUTE"\" />"
+				  "<buffer-attribute name=\""TRIGGER_EVENT_ATTRIBUTE"\" />");
+#endif
 
-	i += snprintf(buff + i, no_os_max(n - i, 0), "</device>");
+	iio_writer_printf(w, "</device>");
 
-	return i;
+	return 0;
 }
 
-static int32_t iio_init_xml(struct iio_desc *desc)
+/*
+ * Generate the xml of device or trigger idx (triggers follow the devices) with
+ * the writer w.
+ */
+static int32_t iio_generate_fragment_xml(struct iio_desc *desc, uint32_t idx,
+		struct iio_writer *w)
 {
 	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
+#ifndef IIO_NO_TRIGGERS
 	struct iio_device dummy = { 0 };
-	uint32_t i, size, of;
+	struct iio_trig_priv *trig;
 
-	/* -2 because of the 0 character */
-	size = sizeof(header) + sizeof(header_end) - 2;
-	size += iio_add_ctx_attr_in_xml(desc, NULL, -1);
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		size += iio_generate_device_xml(dev->dev_descriptor,
-						(char *)dev->name,
-						dev->dev_id, NULL, -1);
-	}
-	for (i = 0; i < desc->nb_trigs; i++) {
-		trig = desc->trigs + i;
+	if (idx >= desc->nb_devs) {
+		trig = desc->trigs + idx - desc->nb_devs;
 		dummy.attributes = trig->descriptor->attributes;
-		size += iio_generate_device_xml(&dummy, trig->name, trig->id,
-						NULL, -1);
+
+		return iio_generate_device_xml(&dummy, trig->name, trig->id,
+					       false, w);
+	}
+#endif
+
+	dev = desc->devs + idx;
+	return iio_generate_device_xml(dev->dev_descriptor,
+				       (char *)dev->name, dev->dev_id,
+				       dev->buffer.initalized, w);
+}
+
+/* Find the size of the xml of device or trigger idx */
+static int32_t iio_fragment_xml_size(struct iio_desc *desc, uint32_t idx,
+				     uint32_t *size)
+{
+	struct iio_writer w;
+	int32_t ret;
+
+	iio_writer_init(&w, NULL, 0, 0);
+	ret = iio_generate_fragment_xml(desc, idx, &w);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	*size = w.pos;
+
+	return 0;
+}
+
+#ifdef IIO_XML_STREAM
+/*
+ * Find the size of the invalidated fragments and the position of each
+ * fragment in the xml. The xml itself is not kept, it is generated while it
+ * is sent by iio_read_xml().
+ */
+static int32_t iio_update_xml(struct iio_desc *desc)
+{
+	struct iio_xml_frag *frag;
+	struct iio_writer w;
+	uint32_t i, n, of;
+	int32_t ret;
+
+	if (!desc->xml_dirty)
+		return 0;
+
+	n = desc->nb_devs + desc->nb_trigs;
+	for (i = 0; i < n; i++) {
+		frag = &desc->xml_frags[i];
+		if (!frag->dirty)
+			continue;
+
+		ret = iio_fragment_xml_size(desc, i, &frag->len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		frag->dirty = false;
+	}
+
+	iio_writer_init(&w, NULL, 0, 0);
+	iio_add_ctx_attr_in_xml(desc, &w);
+	of = sizeof(header) - 1 + w.pos;
+	for (i = 0; i < n; i++) {
+		desc->xml_frags[i].offset = of;
+		of += desc->xml_frags[i].len;
+	}
+
+	desc->xml_size = of + sizeof(header_end) - 1;
+	desc->xml_dirty = false;
+
+	return 0;
+}
+#else
+/*
+ * Bring the cached xml up to date. Only the fragments of invalidated devices
+ * are generated again. If their size didn't change they are rewritten in
+ * place, otherwise a new document is built and the other fragments are copied
+ * from the previous one.
+ */
+static int32_t iio_update_xml(struct iio_desc *desc)
+{
+	struct iio_xml_frag *frag;
+	struct iio_writer w;
+	uint32_t i, n, size, of;
+	int32_t ret;
+	bool resize;
+	char *xml;
+	char next;
+
+	if (!desc->xml_dirty)
+		return 0;
+
+	n = desc->nb_devs + desc->nb_trigs;
+	resize = !desc->xml_desc;
+	for (i = 0; i < n; i++) {
+		frag = &desc->xml_frags[i];
+		if (!frag->dirty)
+			continue;
+
+		ret = iio_fragment_xml_size(desc, i, &size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		if (size != frag->len)
+			resize = true;
+		frag->len = size;
 	}
 
-	desc->xml_desc = (char *)no_os_calloc(size + 1, sizeof(*desc->xml_desc));
-	if (!desc->xml_desc)
+	if (!resize) {
+		for (i = 0; i < n; i++) {
+			frag = &desc->xml_frags[i];
+			if (!frag->dirty)
+				continue;
+
+			/* Keep the character overwritten by the terminator */
+			next = desc->xml_desc[frag->offset + frag->len];
+			iio_writer_init(&w, desc->xml_desc + frag->offset,
+					frag->len + 1, 0);
+			iio_generate_fragment_xml(desc, i, &w);
+			desc->xml_desc[frag->offset + frag->len] = next;
+			frag->dirty = false;
+		}
+		desc->xml_dirty = false;
+
+		return 0;
+	}
+
+	/* -2 because of the 0 character */
+	iio_writer_init(&w, NULL, 0, 0);
+	iio_add_ctx_attr_in_xml(desc, &w);
+	size = sizeof(header) + sizeof(header_end) - 2 + w.pos;
+	for (i = 0; i < n; i++)
+		size += desc->xml_frags[i].len;
+
+	xml = (char *)no_os_calloc(size + 1, sizeof(*xml));
+	if (!xml)
 		return -ENOMEM;
 
+	iio_writer_init(&w, xml, size + 1, 0);
+	iio_writer_write(&w, header, sizeof(header) - 1);
+	iio_add_ctx_attr_in_xml(desc, &w);
+	for (i = 0; i < n; i++) {
+		frag = &desc->xml_frags[i];
+		of = w.pos;
+		if (frag->dirty)
+			iio_generate_fragment_xml(desc, i, &w);
+		else
+			iio_writer_write(&w, desc->xml_desc + frag->offset,
+					 frag->len);
+		frag->offset = of;
+		frag->dirty = false;
+	}
+
+	iio_writer_write(&w, header_end, sizeof(header_end) - 1);
+
+	/*
+	 * A connection may still be sending the previous document, so it is
+	 * released only when it gets replaced again.
+	 */
+	no_os_free(desc->xml_prev);
+	desc->xml_prev = desc->xml_desc;
+	desc->xml_desc = xml;
 	desc->xml_size = size;
+	desc->xml_dirty = false;
 
-	strcpy(desc->xml_desc, header);
-	of = sizeof(header) - 1;
-	of += iio_add_ctx_attr_in_xml(desc, desc->xml_desc + of, size - of);
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		of += iio_generate_device_xml(dev->dev_descriptor,
-					      (char *)dev->name, dev->dev_id,
-					      desc->xml_desc + of, size - of);
+	return 0;
+}
+#endif
+
+static int32_t iio_init_xml(struct iio_desc *desc)
+{
+	uint32_t i, n;
+
+	n = desc->nb_devs + desc->nb_trigs;
+	desc->xml_frags = (struct iio_xml_frag *)no_os_calloc(n ? n : 1,
+			  sizeof(*desc->xml_frags));
+	if (!desc->xml_frags)
+		return -ENOMEM;
+
+	/* The xml is generated when it is first requested */
+	for (i = 0; i < n; i++)
+		desc->xml_frags[i].dirty = true;
+	desc->xml_dirty = true;
+
+	return 0;
+}
+
+#ifdef IIO_XML_STREAM
+/**
+ * @brief Read a chunk of the xml of the context.
+ * Only the devices described in the chunk are generated, at the positions
+ * found when the first chunk was read. A device that changed without being
+ * invalidated could leave a gap, filled with spaces.
+ * @param ctx - IIO instance and conn instance
+ * @param buf - Where to write the chunk.
+ * @param len - Size of buf.
+ * @param offset - Offset of the chunk in the xml.
+ * @param size - Where to store the size of the xml.
+ * @return Number of bytes written in buf or negative value otherwise.
+ */
+static int iio_read_xml(struct iiod_ctx *ctx, char *buf, uint32_t len,
+			uint32_t offset, uint32_t *size)
+{
+	struct iio_desc *desc = ctx->instance;
+	struct iio_xml_frag *frag;
+	struct iio_writer w;
+	uint32_t i, n;
+	int32_t ret;
+
+	/* Devices invalidated during a transfer are updated for the next one */
+	if (!offset) {
+		ret = iio_update_xml(desc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 	}
-	for (i = 0; i < desc->nb_trigs; i++) {
-		trig = desc->trigs + i;
-		dummy.attributes = trig->descriptor->attributes;
-		of += iio_generate_device_xml(&dummy, trig->name, trig->id,
-					      desc->xml_desc + of, size - of);
+
+	if (len < 2)
+		return -EINVAL;
+
+	memset(buf, ' ', len);
+	iio_writer_init(&w, buf, len, offset);
+	iio_writer_write(&w, header, sizeof(header) - 1);
+	iio_add_ctx_attr_in_xml(desc, &w);
+
+	n = desc->nb_devs + desc->nb_trigs;
+	for (i = 0; i < n; i++) {
+		frag = &desc->xml_frags[i];
+		if (frag->offset + frag->len <= offset)
+			continue;
+		if (frag->offset >= offset + len - 1)
+			break;
+
+		w.pos = frag->offset;
+		ret = iio_generate_fragment_xml(desc, i, &w);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	w.pos = desc->xml_size - (sizeof(header_end) - 1);
+	iio_writer_write(&w, header_end, sizeof(header_end) - 1);
+	if (w.err)
+		return w.err;
+
+	*size = desc->xml_size;
+
+	return iio_writer_chunk(&w);
+}
+#else
+/**
+ * @brief Get the xml of the context, generating it if needed.
+ * @param ctx - IIO instance and conn instance
+ * @param xml - Where to store the address of the xml.
+ * @param len - Where to store the size of the xml.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int iio_get_xml(struct iiod_ctx *ctx, char **xml, uint32_t *len)
+{
+	struct iio_desc *desc = ctx->instance;
+	int32_t ret;
+
+	ret = iio_update_xml(desc);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	*xml = desc->xml_desc;
+	*len = desc->xml_size;
+
+	return 0;
+}
+#endif
+#endif
+
+/**
+ * @brief Mark the xml description of a device as outdated.
+ * Must be called after the channels or attributes of the device descriptor
+ * were changed. Only this device will be regenerated on the next request.
+ * A pre-built xml (iio_init_param.xml) is not changed, it must already
+ * describe every state of the device.
+ * @param desc - IIO descriptor.
+ * @param dev_idx - Index of the device in iio_init_param.devs.
+ * @return 0 in case of success or negative value otherwise.
+ */
+int iio_invalidate_dev_xml(struct iio_desc *desc, uint32_t dev_idx)
+{
+	if (!desc || dev_idx >= desc->nb_devs)
+		return -EINVAL;
+
+#ifndef IIO_NO_XML_GEN
+	if (desc->xml_frags) {
+		desc->xml_frags[dev_idx].dirty = true;
+		desc->xml_dirty = true;
 	}
+#endif
 
-	strcpy(desc->xml_desc + of, header_end);
+	/* Channels or attributes may have changed as well, built on next use */
+	iio_free_dev_index(&desc->devs[dev_idx]);
 
 	return 0;
 }
@@ -1805,28 +4887,43 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 		ndev = devs + i;
 		ldev = desc->devs + i;
 		ldev->dev_descriptor = ndev->dev_descriptor;
-		sprintf(ldev->dev_id, "iio:device%"PRIu32"", i);
+		sprintf(ldev->dev_id, IIO_DEV_ID_PREFIX"%"PRIu32"", i);
+#ifdef IIO_NO_TRIGGERS
+		ldev->trig_idx = NO_TRIGGER;
+#else
 		ldev->trig_idx = iio_get_trig_idx_by_id(desc, ndev->trigger_id);
+#endif
 		ldev->dev_instance = ndev->dev;
 		ldev->dev_data.dev = ndev->dev;
 		ldev->dev_data.buffer = &ldev->buffer.public;
 		ldev->name = ndev->name;
-		if (ndev->dev_descriptor->read_dev ||
+		ldev->ain_stream = ndev->ain_stream;
+		ldev->bytes.name = "iio_bytes";
+		ldev->bytes.index = i;
+		ldev->overruns.name = "iio_overruns";
+		ldev->overruns.index = i;
+		if (ndev->ain_stream ||
+		    ndev->dev_descriptor->read_dev ||
 		    ndev->dev_descriptor->write_dev ||
 		    ndev->dev_descriptor->submit ||
 		    ndev->dev_descriptor->trigger_handler) {
 			ldev->buffer.raw_buf = ndev->raw_buf;
 			ldev->buffer.raw_buf_len = ndev->raw_buf_len;
+			ldev->buffer.buffers_count = 1;
+			ldev->buffer.ts_timer = desc->ts_timer;
+			ldev->buffer.ts_offset = -1;
 			ldev->buffer.public.buf = &ldev->buffer.cb;
 			ldev->buffer.initalized = 1;
 		} else {
 			ldev->buffer.initalized = 0;
 		}
+		/* The look up index is built by iio_use_dev_index() */
 	}
 
 	return 0;
 }
 
+#ifndef IIO_NO_TRIGGERS
 /**
  * @brief Initializes IIO triggers.
  * @param desc  - IIO descriptor.
@@ -1853,11 +4950,150 @@ static int32_t iio_init_trigs(struct iio_desc *desc,
 		trig_priv_iter->instance = trig_init_iter->trig;
 		trig_priv_iter->name = trig_init_iter->name;
 		trig_priv_iter->descriptor = trig_init_iter->descriptor;
-		sprintf(trig_priv_iter->id, "trigger%"PRIu32"", i);
+		trig_priv_iter->work.func = iio_trig_work;
+		trig_priv_iter->work.ctx = desc;
+		sprintf(trig_priv_iter->id, IIO_TRIG_ID_PREFIX"%"PRIu32"", i);
 	}
 
 	return 0;
 }
+#endif
+
+/**
+ * @brief Set up a link of the context and add its connections.
+ * @param desc - IIO descriptor.
+ * @param link - Link parameters.
+ * @param idx - Index of the link.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_init_link(struct iio_desc *desc, struct iio_link *link,
+			     uint32_t idx)
+{
+	struct iio_link_priv *priv = &desc->links[idx];
+	struct iio_transport *transport;
+	struct iiod_conn_data data;
+	uint32_t conn_id, i;
+	int32_t ret;
+
+	priv->phy_type = link->phy_type;
+	priv->prio = link->prio;
+
+	switch (link->phy_type) {
+	case USE_UART:
+		priv->send = (int (*)())no_os_uart_write;
+		priv->recv = (int (*)())no_os_uart_read;
+
+		data.conn = link->uart_desc;
+		data.buf = link->buff;
+		data.len = link->buff_len;
+		if (!data.buf) {
+			priv->alloc_buf = no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
+			if (!priv->alloc_buf)
+				return -ENOMEM;
+			data.buf = priv->alloc_buf;
+			data.len = IIOD_CONN_BUFFER_SIZE;
+		}
+
+		ret = iiod_conn_add(desc->iiod, &data, &conn_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		desc->conn_link[conn_id] = idx;
+		return _push_conn(desc, conn_id);
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	case USE_NETWORK:
+		if (desc->server)
+			return -EINVAL;
+
+		priv->send = (int (*)())socket_send;
+		priv->recv = (int (*)())socket_recv;
+		priv->recv_nocopy = (int (*)())socket_recv_nocopy;
+		priv->recv_release = (int (*)())socket_recv_release;
+		desc->net_link = idx;
+
+		ret = socket_init(&desc->server, link->tcp_socket_init_param);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		ret = socket_bind(desc->server, IIOD_PORT);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return socket_listen(desc->server, MAX_BACKLOG);
+#endif
+	case USE_TRANSPORT:
+		transport = link->transport;
+		if (!transport || transport->nb_conns > IIOD_MAX_CONNECTIONS)
+			return -EINVAL;
+
+		priv->send = transport->send;
+		priv->recv = transport->recv;
+		priv->recv_nocopy = transport->recv_nocopy;
+		priv->recv_release = transport->recv_release;
+		for (i = 0; i < transport->nb_conns; i++) {
+			data.conn = transport->conns[i];
+			data.buf = transport->buff + i * transport->buff_len;
+			data.len = transport->buff_len;
+			ret = iiod_conn_add(desc->iiod, &data, &conn_id);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+
+			desc->conn_link[conn_id] = idx;
+			_push_conn(desc, conn_id);
+		}
+
+		return 0;
+	case USE_LOCAL_BACKEND:
+		if (!link->local_backend)
+			return -EINVAL;
+
+		priv->recv = link->local_backend->local_backend_event_read;
+		priv->send = link->local_backend->local_backend_event_write;
+
+		data.conn = NULL;
+		data.buf = link->local_backend->local_backend_buff;
+		data.len = link->local_backend->local_backend_buff_len;
+		ret = iiod_conn_add(desc->iiod, &data, &conn_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		desc->conn_link[conn_id] = idx;
+		return _push_conn(desc, conn_id);
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Free the resources of the links: the network clients and server and
+ * the allocated UART buffers.
+ * @param desc - IIO descriptor.
+ */
+static void iio_remove_links(struct iio_desc *desc)
+{
+	uint32_t i;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	struct iiod_conn_data data;
+
+	if (desc->server) {
+		for (i = 0; i < IIOD_MAX_CONNECTIONS; i++) {
+			if (desc->conn_link[i] != desc->net_link ||
+			    iiod_conn_remove(desc->iiod, i, &data))
+				continue;
+
+			no_os_free(data.buf);
+			socket_remove(data.conn);
+		}
+		socket_remove(desc->server);
+		desc->server = NULL;
+	}
+#endif
+
+	for (i = 0; i < desc->nb_links; i++)
+		no_os_free(desc->links[i].alloc_buf);
+	no_os_free(desc->links);
+	desc->links = NULL;
+}
 
 /**
  * @brief Set communication ops and read/write ops
@@ -1871,7 +5107,10 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	struct iio_desc		*ldesc;
 	struct iiod_ops		*ops;
 	struct iiod_init_param	iiod_param;
-	uint32_t		conn_id;
+	struct iio_link		legacy_link = { 0 };
+	struct iio_link		*links;
+	uint32_t		nb_links;
+	uint32_t		i;
 
 	if (!desc || !init_param)
 		return -EINVAL;
@@ -1882,26 +5121,58 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ldesc->ctx_attrs = init_param->ctx_attrs;
 	ldesc->nb_ctx_attr = init_param->nb_ctx_attr;
-
+	ldesc->wakeup_sem = init_param->wakeup_sem;
+	ldesc->idle = init_param->idle;
+	ldesc->ts_timer = init_param->ts_timer;
+	ldesc->buf_arena = init_param->buf_arena;
+	ldesc->buf_arena_len = init_param->buf_arena_len;
+	ldesc->wq = (struct no_os_workqueue)NO_OS_WORKQUEUE_INIT("iio_work");
+
+#ifdef IIO_NO_TRIGGERS
+	if (init_param->nb_trigs) {
+		ret = -ENOSYS;
+		goto free_devs;
+	}
+#else
 	ret = iio_init_trigs(ldesc, init_param->trigs, init_param->nb_trigs);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_devs;
+#endif
 
 	ret = iio_init_devs(ldesc, init_param->devs, init_param->nb_devs);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_desc;
 
-	ret = iio_init_xml(ldesc);
-	if (NO_OS_IS_ERR_VALUE(ret))
+#ifndef IIO_NO_TRIGGERS
+	iio_trig_update_devs(ldesc);
+#endif
+
+#ifdef IIO_NO_XML_GEN
+	if (!init_param->xml) {
+		ret = -EINVAL;
 		goto free_trigs;
+	}
+#else
+	if (!init_param->xml) {
+		ret = iio_init_xml(ldesc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto free_trigs;
+	}
+#endif
 
 	/* device operations */
 	ops = &ldesc->iiod_ops;
 	ops->read_attr = iio_read_attr;
 	ops->write_attr = iio_write_attr;
+#ifndef IIO_NO_TRIGGERS
 	ops->get_trigger = iio_get_trigger;
 	ops->set_trigger = iio_set_trigger;
+#endif
 	ops->read_buffer = iio_read_buffer;
+	ops->get_read_block = iio_get_read_block;
+	ops->read_block_done = iio_read_block_done;
+	ops->get_write_block = iio_get_write_block;
+	ops->write_block_done = iio_write_block_done;
 	ops->write_buffer = iio_write_buffer;
 	ops->refill_buffer = iio_refill_buffer;
 	ops->push_buffer = iio_push_buffer;
@@ -1909,12 +5180,26 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->close = iio_close_dev;
 	ops->send = iio_send;
 	ops->recv = iio_recv;
+	ops->recv_nocopy = iio_recv_nocopy;
+	ops->recv_release = iio_recv_release;
 	ops->set_buffers_count = iio_set_buffers_count;
+#ifndef IIO_NO_XML_GEN
+	/* A pre-built xml is sent as it is by iiod */
+	if (!init_param->xml)
+#ifdef IIO_XML_STREAM
+		ops->read_xml = iio_read_xml;
+#else
+		ops->get_xml = iio_get_xml;
+#endif
+#endif
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	ops->stream = iio_stream;
+#endif
 
 	iiod_param.instance = ldesc;
 	iiod_param.ops = ops;
-	iiod_param.xml = ldesc->xml_desc;
-	iiod_param.xml_len = ldesc->xml_size;
+	iiod_param.xml = (char *)init_param->xml;
+	iiod_param.xml_len = init_param->xml_len;
 
 	ret = iiod_init(&ldesc->iiod, &iiod_param);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1925,69 +5210,67 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_iiod;
 
-	if (init_param->phy_type == USE_UART) {
-		ldesc->send = (int (*)())no_os_uart_write;
-		ldesc->recv = (int (*)())no_os_uart_read;
-		ldesc->uart_desc = init_param->uart_desc;
-
-		struct iiod_conn_data data = {
-			.conn = ldesc->uart_desc,
-			.buf = uart_buff,
-			.len = sizeof(uart_buff)
-		};
-		ret = iiod_conn_add(ldesc->iiod, &data, &conn_id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto free_conns;
-		_push_conn(ldesc, conn_id);
-	}
+	if (init_param->links) {
+		links = init_param->links;
+		nb_links = init_param->nb_links;
+	} else {
+		/* A single link, given by the fields of init_param */
+		legacy_link.phy_type = init_param->phy_type;
+		switch (init_param->phy_type) {
+		case USE_UART:
+			legacy_link.uart_desc = init_param->uart_desc;
+			legacy_link.buff = uart_buff;
+			legacy_link.buff_len = sizeof(uart_buff);
+			break;
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-	else if (init_param->phy_type == USE_NETWORK) {
-		ldesc->send = (int (*)())socket_send;
-		ldesc->recv = (int (*)())socket_recv;
-		ret = socket_init(&ldesc->server,
-				  init_param->tcp_socket_init_param);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto free_conns;
-		ret = socket_bind(ldesc->server, IIOD_PORT);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto free_pylink;
-		ret = socket_listen(ldesc->server, MAX_BACKLOG);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto free_pylink;
-	}
+		case USE_NETWORK:
+			legacy_link.tcp_socket_init_param =
+				init_param->tcp_socket_init_param;
+			break;
 #endif
-	else if (init_param->phy_type == USE_LOCAL_BACKEND) {
-		ldesc->recv = init_param->local_backend->local_backend_event_read;
-		ldesc->send = init_param->local_backend->local_backend_event_write;
+		case USE_TRANSPORT:
+			legacy_link.transport = init_param->transport;
+			break;
+		case USE_LOCAL_BACKEND:
+			legacy_link.local_backend = init_param->local_backend;
+			break;
+		default:
+			break;
+		}
+		links = &legacy_link;
+		nb_links = 1;
+	}
 
-		struct iiod_conn_data data = {
-			.conn = NULL,
-			.buf = init_param->local_backend->local_backend_buff,
-			.len = init_param->local_backend->local_backend_buff_len
-		};
-		ret = iiod_conn_add(ldesc->iiod, &data, &conn_id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto free_conns;
-		_push_conn(ldesc, conn_id);
-	} else {
+	if (!nb_links || nb_links > IIOD_MAX_CONNECTIONS) {
 		ret = -EINVAL;
 		goto free_conns;
 	}
 
+	ldesc->links = no_os_calloc(nb_links, sizeof(*ldesc->links));
+	if (!ldesc->links) {
+		ret = -ENOMEM;
+		goto free_conns;
+	}
+	ldesc->nb_links = nb_links;
+
+	for (i = 0; i < nb_links; i++) {
+		ret = iio_init_link(ldesc, &links[i], i);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto free_links;
+	}
+
 	*desc = ldesc;
 
 	return 0;
 
-free_pylink:
-#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-	socket_remove(ldesc->server);
-#endif
+free_links:
+	iio_remove_links(ldesc);
 free_conns:
 	no_os_cb_remove(ldesc->conns);
 free_iiod:
 	iiod_remove(ldesc->iiod);
 free_xml:
-	no_os_free(ldesc->xml_desc);
+	no_os_free(ldesc->xml_frags);
 free_trigs:
 	no_os_free(ldesc->trigs);
 free_devs:
@@ -2005,27 +5288,26 @@ free_desc:
  */
 int iio_remove(struct iio_desc *desc)
 {
-	struct iiod_conn_data data;
-	int ret;
-
 	if (!desc)
 		return -EINVAL;
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-	for (int i = 0; i < IIOD_MAX_CONNECTIONS; i++) {
-		ret = iiod_conn_remove(desc->iiod, i, &data);
-		if (!ret) {
-			no_os_free(data.buf);
-			socket_remove(data.conn);
-		}
-	}
-	socket_remove(desc->server);
+	for (uint32_t i = 0; i < desc->nb_devs; i++)
+		iio_stream_stop(&desc->devs[i]);
 #endif
+	iio_remove_links(desc);
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
+	for (uint32_t i = 0; i < desc->nb_devs; i++) {
+		iio_free_dev_index(&desc->devs[i]);
+		NO_OS_COUNTER_REMOVE(desc->devs[i].bytes);
+		NO_OS_COUNTER_REMOVE(desc->devs[i].overruns);
+	}
 	no_os_free(desc->devs);
 	no_os_free(desc->trigs);
 	no_os_free(desc->xml_desc);
+	no_os_free(desc->xml_prev);
+	no_os_free(desc->xml_frags);
 	no_os_free(desc);
 
 	return 0;
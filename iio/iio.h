@@ -47,6 +47,8 @@
 
 #include "iio_types.h"
 #include "no_os_uart.h"
+#include "no_os_timer.h"
+#include "no_os_ain.h"
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
 #include "tcp_socket.h"
 #endif
@@ -58,11 +60,52 @@
 enum pysical_link_type {
 	USE_UART,
 	USE_LOCAL_BACKEND,
-	USE_NETWORK
+	USE_NETWORK,
+	USE_TRANSPORT
 };
 
 struct iio_desc;
 
+/* Set in iio_stream_hdr.flags when buffer data was lost since the last datagram */
+#define IIO_STREAM_FLAG_OVERRUN		0x1
+
+/* Debug attribute listing the no_os_profile regions, a write clears them */
+#define IIO_PROFILE_DEBUG_ATTR { \
+	.name = "profile", \
+	.show = iio_profile_show, \
+	.store = iio_profile_store, \
+}
+
+/* Debug attribute listing the no_os_counter values, a write clears them */
+#define IIO_COUNTERS_DEBUG_ATTR { \
+	.name = "counters", \
+	.show = iio_counters_show, \
+	.store = iio_counters_store, \
+}
+
+#ifdef NO_OS_BUS_TRACE
+/*
+ * Debug attribute controlling the no_os_bus_trace capture. Write "start",
+ * "start <count>", "stop" or "rewind", then read it until it is empty.
+ */
+#define IIO_BUS_TRACE_DEBUG_ATTR { \
+	.name = "bus_trace", \
+	.show = iio_bus_trace_show, \
+	.store = iio_bus_trace_store, \
+}
+#endif
+
+/*
+ * Header of the UDP datagrams sent for the STREAM iiod command, in little
+ * endian byte order. It is followed by len bytes of buffer data, made of whole
+ * scans. seq is incremented for each datagram, so gaps show the dropped ones.
+ */
+struct iio_stream_hdr {
+	uint32_t seq;
+	uint16_t flags;
+	uint16_t len;
+};
+
 struct iio_device_init {
 	char *name;
 	void *dev;
@@ -77,6 +120,14 @@ struct iio_device_init {
 	uint32_t raw_buf_len;
 	/* If set, trigger will be linked to this device */
 	char *trigger_id;
+	/*
+	 * Optional block producer of the driver. When set, input buffer data
+	 * is sent straight from its blocks, the read_dev and submit callbacks
+	 * and the internal buffer are not used. The scan layout given by the
+	 * channels must match the stream format. Timestamps and the STREAM
+	 * command are not supported in this mode.
+	 */
+	struct no_os_ain_stream *ain_stream;
 };
 
 struct iio_trigger_init {
@@ -107,6 +158,61 @@ struct iio_local_backend {
 	uint32_t local_backend_buff_len;
 };
 
+/**
+ * @struct iio_transport
+ * @brief Structure holding the connections and ops of a custom transport,
+ * like the USB bulk pipes of maxim_usb_iio
+ */
+struct iio_transport {
+	/* Connections handled by the transport, each one is an iiod client */
+	void **conns;
+	uint32_t nb_conns;
+	/* Payload buffer of nb_conns * buff_len bytes, buff_len for each conn */
+	char *buff;
+	uint32_t buff_len;
+	/*
+	 * Same as iiod_ops.send and recv. send may return -EAGAIN while it
+	 * still uses buf, it is called again with the same buf. -ENOTCONN
+	 * resets the state of the connection, for a host that started over.
+	 */
+	int (*send)(void *conn, uint8_t *buf, uint32_t len);
+	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
+	/* Optional, see iiod_ops.recv_nocopy */
+	int (*recv_nocopy)(void *conn, const void **buf, uint32_t len);
+	int (*recv_release)(void *conn, uint32_t len);
+};
+
+/**
+ * @struct iio_link
+ * @brief One of the links of a context served over several links at once,
+ * see iio_init_param.links
+ */
+struct iio_link {
+	/* USE_UART, USE_NETWORK, USE_TRANSPORT or USE_LOCAL_BACKEND */
+	enum pysical_link_type	phy_type;
+	union {
+		struct no_os_uart_desc *uart_desc;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+		struct tcp_socket_init_param *tcp_socket_init_param;
+#endif
+		struct iio_transport *transport;
+		struct iio_local_backend *local_backend;
+	};
+	/*
+	 * Connection buffer of a UART link. If NULL, IIOD_CONN_BUFFER_SIZE
+	 * bytes are allocated. The other links have their own buffers.
+	 */
+	char *buff;
+	uint32_t buff_len;
+	/*
+	 * Scheduling priority of the connections of the link, lower values
+	 * are served first. It is compared before the priority of the running
+	 * commands, a connection skipped for IIO_MAX_CONN_SKIPS steps is still
+	 * served.
+	 */
+	uint8_t prio;
+};
+
 struct iio_init_param {
 	enum pysical_link_type	phy_type;
 	union {
@@ -116,12 +222,62 @@ struct iio_init_param {
 #endif
 	};
 	struct iio_local_backend *local_backend;
+	/* Used with USE_TRANSPORT */
+	struct iio_transport *transport;
+	/*
+	 * Optional links served at the same time, e.g. a UART and the network.
+	 * When set, phy_type and the link parameters above are not used. At
+	 * most one USE_NETWORK link.
+	 */
+	struct iio_link *links;
+	uint32_t nb_links;
 	struct iio_ctx_attr *ctx_attrs;
 	uint32_t nb_ctx_attr;
 	struct iio_device_init *devs;
 	uint32_t nb_devs;
 	struct iio_trigger_init *trigs;
 	uint32_t nb_trigs;
+	/*
+	 * Optional xml description of the context, e.g. saved with libiio's
+	 * iio_genxml from a build generating it. When set it is sent as it is
+	 * instead of being generated at run time. Required when built with
+	 * IIO_NO_XML_GEN.
+	 */
+	const char *xml;
+	/* Size of xml in bytes */
+	uint32_t xml_len;
+	/*
+	 * Optional semaphore created with no_os_semaphore_init. If set,
+	 * iio_step waits on it when no connection has pending work instead of
+	 * polling. It must be given with iio_wakeup when new data is received.
+	 */
+	void *wakeup_sem;
+	/*
+	 * Optional idle hook, used when wakeup_sem is not set. When no
+	 * connection has pending work, iio_step calls it with the interrupts
+	 * masked and it must return once an interrupt is pending, e.g.
+	 * no_os_wait_for_interrupt. Pending data, trigger and DMA interrupts
+	 * wake it up, sources that need no interrupt of their own to be
+	 * served can call iio_wakeup to skip the next sleep.
+	 */
+	void (*idle)(void);
+	/*
+	 * Optional running timer. If set, the core fills the enabled
+	 * IIO_TIMESTAMP channels (64 bit storage) of each block given to
+	 * iio_buffer_block_done. The driver must leave their place empty in
+	 * the scans.
+	 */
+	struct no_os_timer_desc *ts_timer;
+	/*
+	 * Optional memory shared by the buffers of the devices without a
+	 * raw_buf. When set, a device opening its buffer takes the size of its
+	 * requested blocks from it, aligned to IIO_BUF_ARENA_ALIGN, and gives
+	 * it back when closing it, instead of using the heap. If the requested
+	 * blocks don't fit, fewer are used, then the open fails with -ENOMEM.
+	 */
+	int8_t *buf_arena;
+	/* Size of buf_arena in bytes */
+	uint32_t buf_arena_len;
 };
 
 /******************************************************************************/
@@ -134,18 +290,67 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param);
 int iio_remove(struct iio_desc *desc);
 /* Execut an iio step. */
 int iio_step(struct iio_desc *desc);
+/* Connection level API, used instead of iio_step by runtimes serving each
+   connection from its own task, see iio_rtos.h. The caller serializes the
+   calls. */
+int iio_conn_get(struct iio_desc *desc, uint32_t *conn_id);
+int iio_conn_serve(struct iio_desc *desc, uint32_t conn_id);
+bool iio_service_step(struct iio_desc *desc);
+/* Mark the xml of a device as outdated after its descriptor was changed */
+int iio_invalidate_dev_xml(struct iio_desc *desc, uint32_t dev_idx);
+/* Wake up iio_step waiting on iio_init_param.wakeup_sem. ISR safe. */
+void iio_wakeup(struct iio_desc *desc);
 /* Signal iio that a trigger has been triggered.
  * This will be called in interrupt context. An application callback will be
    called in interrupt context if trigger is synchronous with the interrupt
    (is_synchronous = true) or will be called from iio_step if trigger is
    asynchronous (is_synchronous = false) */
 int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name);
+/* Same as iio_process_trigger_type() for an event that occurred at cycles,
+   a no_os_get_cycles() value, when the trigger processing was deferred */
+int iio_process_trigger_at(struct iio_desc *desc, char *trigger_name,
+			   uint32_t cycles);
 
 int32_t iio_parse_value(char *buf, enum iio_val fmt,
 			int32_t *val, int32_t *val2);
 int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 		     int32_t size, int32_t *vals);
 
+/* Debug attribute callbacks of IIO_PROFILE_DEBUG_ATTR */
+int iio_profile_show(void *device, char *buf, uint32_t len,
+		     const struct iio_ch_info *channel, intptr_t priv);
+int iio_profile_store(void *device, char *buf, uint32_t len,
+		      const struct iio_ch_info *channel, intptr_t priv);
+
+/* Debug attribute callbacks of IIO_COUNTERS_DEBUG_ATTR */
+int iio_counters_show(void *device, char *buf, uint32_t len,
+		      const struct iio_ch_info *channel, intptr_t priv);
+int iio_counters_store(void *device, char *buf, uint32_t len,
+		       const struct iio_ch_info *channel, intptr_t priv);
+
+#ifdef NO_OS_PROFILING
+/* Stages of the path of a triggered scan, see iio_latency_mark() */
+enum iio_latency_stage {
+	/* Trigger processed, usually from its interrupt handler */
+	IIO_LATENCY_TRIGGER,
+	/* Device trigger handler done, the scan is in the buffer */
+	IIO_LATENCY_PUSHED,
+	/* Scan read from the buffer to be sent to the client */
+	IIO_LATENCY_READ,
+};
+
+/* Weak hook called at each stage, e.g. to toggle a GPIO. */
+void iio_latency_mark(enum iio_latency_stage stage);
+#endif
+
+#ifdef NO_OS_BUS_TRACE
+/* Debug attribute callbacks of IIO_BUS_TRACE_DEBUG_ATTR */
+int iio_bus_trace_show(void *device, char *buf, uint32_t len,
+		       const struct iio_ch_info *channel, intptr_t priv);
+int iio_bus_trace_store(void *device, char *buf, uint32_t len,
+			const struct iio_ch_info *channel, intptr_t priv);
+#endif
+
 /* DMA buffer functions. */
 /* Get buffer addr where to write iio_buffer.size bytes */
 int iio_buffer_get_block(struct iio_buffer *buffer, void **addr);
@@ -157,5 +362,19 @@ int iio_buffer_block_done(struct iio_buffer *buffer);
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
+/* Pack vals, indexed by channel, in a scan and write it to buffer */
+int iio_buffer_push_vals(struct iio_buffer *buffer, const uint32_t *vals);
+#ifdef IIO_PRETRIGGER
+/* Signal the event of a pre trigger capture, can be called from an ISR */
+int iio_buffer_history_fire(struct iio_buffer *buffer);
+#endif
+
+/* Scan layout helpers. vals are indexed by channel. */
+/* Write the values of the enabled channels of vals to scan */
+void iio_scan_pack(const struct iio_scan_layout *layout, const uint32_t *vals,
+		   void *scan);
+/* Read the enabled channels of scan to vals */
+void iio_scan_unpack(const struct iio_scan_layout *layout, const void *scan,
+		     uint32_t *vals);
 
 #endif /* IIO_H_ */
@@ -41,6 +41,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "iio_app.h"
 #include "parameters.h"
 #include "no_os_alloc.h"
@@ -235,6 +236,57 @@ static int32_t network_setup(struct iio_init_param *iio_init_param,
 }
 #endif
 
+/**
+ * @brief Build the links served by the context: the default link set up in
+ * iio_init_param, the UART if requested and the links of the application.
+ * @param param - IIO application initialization parameters.
+ * @param iio_init_param - IIO initialization parameters.
+ * @param uart_desc - UART of the application.
+ * @return 0 on success, negative value otherwise. The links are freed by the
+ * 	   caller after iio_init().
+ */
+static int32_t iio_app_links_setup(struct iio_app_init_param *param,
+				   struct iio_init_param *iio_init_param,
+				   struct no_os_uart_desc *uart_desc)
+{
+	struct iio_link *links;
+	uint32_t n = 0;
+
+	links = no_os_calloc(param->nb_links + 2, sizeof(*links));
+	if (!links)
+		return -ENOMEM;
+
+	links[n].phy_type = iio_init_param->phy_type;
+	links[n].prio = param->default_link_prio;
+	if (iio_init_param->phy_type == USE_UART)
+		links[n].uart_desc = iio_init_param->uart_desc;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	else if (iio_init_param->phy_type == USE_NETWORK)
+		links[n].tcp_socket_init_param =
+			iio_init_param->tcp_socket_init_param;
+#endif
+	n++;
+
+	if (param->uart_link && iio_init_param->phy_type != USE_UART) {
+		if (!uart_desc) {
+			no_os_free(links);
+			return -EINVAL;
+		}
+		links[n].phy_type = USE_UART;
+		links[n].uart_desc = uart_desc;
+		links[n].prio = param->uart_link_prio;
+		n++;
+	}
+
+	if (param->nb_links)
+		memcpy(&links[n], param->links, param->nb_links * sizeof(*links));
+
+	iio_init_param->links = links;
+	iio_init_param->nb_links = n + param->nb_links;
+
+	return 0;
+}
+
 static int32_t uart_setup(struct no_os_uart_desc **uart_desc,
 			  struct no_os_uart_init_param *uart_init_par)
 {
@@ -303,7 +355,7 @@ int iio_app_init(struct iio_app_desc **app,
 		 struct iio_app_init_param app_init_param)
 {
 	struct iio_device_init *iio_init_devs;
-	struct iio_init_param iio_init_param;
+	struct iio_init_param iio_init_param = { 0 };
 	struct no_os_uart_desc *uart_desc;
 	struct iio_app_desc *application;
 	struct iio_data_buffer *buff;
@@ -317,6 +369,9 @@ int iio_app_init(struct iio_app_desc **app,
 
 	application->post_step_callback = app_init_param.post_step_callback;
 	application->arg = app_init_param.arg;
+#ifdef IIO_RTOS
+	application->rtos = app_init_param.rtos;
+#endif
 
 #if defined(ADUCM_PLATFORM) || defined(STM32_PLATFORM)
 	/* Only one irq controller can exist and be initialized in
@@ -359,10 +414,17 @@ int iio_app_init(struct iio_app_desc **app,
 	iio_init_param.uart_desc = uart_desc;
 #endif
 
+	if (app_init_param.nb_links || app_init_param.uart_link) {
+		status = iio_app_links_setup(&app_init_param, &iio_init_param,
+					     uart_desc);
+		if (status)
+			goto error;
+	}
+
 	iio_init_devs = no_os_calloc(app_init_param.nb_devices, sizeof(*iio_init_devs));
 	if (!iio_init_devs) {
 		status = -ENOMEM;
-		goto error;
+		goto error_links;
 	}
 
 	for (i = 0; i < app_init_param.nb_devices; ++i) {
@@ -380,6 +442,7 @@ int iio_app_init(struct iio_app_desc **app,
 		iio_init_devs[i].dev = app_init_param.devices[i].dev;
 		iio_init_devs[i].dev_descriptor = app_init_param.devices[i].dev_descriptor;
 		iio_init_devs[i].trigger_id = app_init_param.devices[i].default_trigger_id;
+		iio_init_devs[i].ain_stream = app_init_param.devices[i].ain_stream;
 		buff = app_init_param.devices[i].read_buff ?
 		       app_init_param.devices[i].read_buff :
 		       app_init_param.devices[i].write_buff;
@@ -397,17 +460,23 @@ int iio_app_init(struct iio_app_desc **app,
 	iio_init_param.trigs = app_init_param.trigs;
 	iio_init_param.nb_trigs = app_init_param.nb_trigs;
 	iio_init_param.ctx_attrs = app_init_param.ctx_attrs;
+	iio_init_param.idle = app_init_param.idle;
+	iio_init_param.buf_arena = app_init_param.buf_arena;
+	iio_init_param.buf_arena_len = app_init_param.buf_arena_len;
 	iio_init_param.nb_ctx_attr = app_init_param.nb_ctx_attr;
 
 	status = iio_init(&application->iio_desc, &iio_init_param);
+	no_os_free(iio_init_devs);
 	if(status < 0)
-		goto error;
+		goto error_links;
 
-	no_os_free(iio_init_devs);
+	no_os_free(iio_init_param.links);
 
 	*app = application;
 
 	return 0;
+error_links:
+	no_os_free(iio_init_param.links);
 error:
 	/** We might have to reinit UART, settings might have changed for IIO */
 	uart_setup(&uart_desc, &app_init_param.uart_init_params);
@@ -432,6 +501,10 @@ int iio_app_run(struct iio_app_desc *app)
 {
 	int status;
 
+#ifdef IIO_RTOS
+	return iio_rtos_run(app->iio_desc, &app->rtos);
+#endif
+
 	do {
 		status = iio_step(app->iio_desc);
 		if (status && status != -EAGAIN && status != -ENOTCONN
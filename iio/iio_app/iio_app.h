@@ -50,6 +50,10 @@
 #include "lwip_socket.h"
 #endif
 
+#ifdef IIO_RTOS
+#include "iio_rtos.h"
+#endif
+
 #define IIO_APP_DEVICE(_name, _dev, _dev_descriptor, _read_buff, _write_buff, _default_trigger_id) {\
 	.name = _name,\
 	.dev = _dev,\
@@ -77,6 +81,8 @@ struct iio_app_device {
 	struct iio_data_buffer *read_buff;
 	struct iio_data_buffer *write_buff;
 	char *default_trigger_id;
+	/* Optional block producer, see struct iio_device_init */
+	struct no_os_ain_stream *ain_stream;
 };
 
 /**
@@ -98,6 +104,10 @@ struct iio_app_desc {
 #ifdef NO_OS_LWIP_NETWORKING
 	struct lwip_network_desc *lwip_desc;
 #endif
+#ifdef IIO_RTOS
+	/** FreeRTOS runtime used by iio_app_run */
+	struct iio_rtos_init_param rtos;
+#endif
 };
 
 /**
@@ -125,10 +135,45 @@ struct iio_app_init_param {
 	int (*post_step_callback)(void *arg);
 	/** Function parameteres */
 	void *arg;
+	/**
+	 * Optional idle hook called with the interrupts masked when there is
+	 * no work, e.g. no_os_wait_for_interrupt (see iio_init_param.idle)
+	 */
+	void (*idle)(void);
+	/**
+	 * Optional links served together with the default one (the UART, or
+	 * the network in network builds), e.g. a USB transport
+	 */
+	struct iio_link *links;
+	/** Number of links in the array above */
+	uint32_t nb_links;
+	/** Scheduling priority of the default link, see iio_link.prio */
+	uint8_t default_link_prio;
+	/**
+	 * Network builds: also serve the UART, which must not be used as the
+	 * console or by the network interface then
+	 */
+	bool uart_link;
+	/** Scheduling priority of the UART served with uart_link */
+	uint8_t uart_link_prio;
+	/**
+	 * Optional memory shared by the buffers of the devices given without
+	 * read_buff and write_buff, see iio_init_param.buf_arena
+	 */
+	int8_t *buf_arena;
+	/** Size of buf_arena in bytes */
+	uint32_t buf_arena_len;
 
 #ifdef NO_OS_LWIP_NETWORKING
 	struct lwip_network_param lwip_param;
 #endif
+#ifdef IIO_RTOS
+	/**
+	 * FreeRTOS runtime used by iio_app_run instead of the iio_step loop,
+	 * post_step_callback is not called with it
+	 */
+	struct iio_rtos_init_param rtos;
+#endif
 };
 
 /** Register devices for an IIO application */
@@ -0,0 +1,223 @@
+/***************************************************************************//**
+ *   @file   iio_compress.c
+ *   @brief  Lossless compression of the IIO buffer streams.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "iio_compress.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Bit writer, LSB first */
+struct iio_bits {
+	uint8_t *p;
+	uint64_t acc;
+	uint32_t n;
+};
+
+static inline void iio_bits_put(struct iio_bits *b, uint32_t val,
+				uint32_t width)
+{
+	b->acc |= (uint64_t)val << b->n;
+	b->n += width;
+	while (b->n >= 8) {
+		*b->p++ = b->acc;
+		b->acc >>= 8;
+		b->n -= 8;
+	}
+}
+
+static inline void iio_bits_flush(struct iio_bits *b)
+{
+	if (b->n)
+		*b->p++ = b->acc;
+	b->acc = 0;
+	b->n = 0;
+}
+
+/* Inlined, this runs for every sample */
+static inline uint64_t iio_elem_get(const uint8_t *p,
+				    const struct iio_compress_elem *e)
+{
+	uint64_t val = 0;
+	uint32_t i;
+
+	if (e->be)
+		for (i = 0; i < e->bytes; i++)
+			val = (val << 8) | p[i];
+	else
+		for (i = e->bytes; i; i--)
+			val = (val << 8) | p[i - 1];
+
+	return val;
+}
+
+/*
+ * Zigzag encoded difference of two samples of bytes * 8 bits: the modular
+ * difference is sign extended, so a wrap around costs as little as a step.
+ */
+static inline uint64_t iio_elem_zigzag(uint64_t cur, uint64_t prev,
+				       uint8_t bytes)
+{
+	uint32_t shift = 64 - 8 * bytes;
+	int64_t d = (int64_t)((cur - prev) << shift) >> shift;
+
+	return ((uint64_t)d << 1) ^ (uint64_t)(d >> 63);
+}
+
+static inline uint32_t iio_width64(uint64_t v)
+{
+	uint32_t w = 0;
+
+	if (v >> 32) {
+		w = 32;
+		v >>= 32;
+	}
+
+	return w + (v ? 32 - __builtin_clz((uint32_t)v) : 0);
+}
+
+/**
+ * @brief Largest frame produced by iio_compress_delta() for nb_scans scans.
+ * @param layout - Scan layout.
+ * @param nb_scans - Number of scans.
+ * @return Size in bytes.
+ */
+uint32_t iio_compress_bound(const struct iio_compress_layout *layout,
+			    uint32_t nb_scans)
+{
+	uint32_t i, len = IIO_COMPRESS_HDR_SIZE;
+
+	/* Width, first sample, deltas that may take one more bit than a sample */
+	for (i = 0; i < layout->nb; i++)
+		len += 1 + layout->elems[i].bytes +
+		       NO_OS_DIV_ROUND_UP((nb_scans - 1) *
+					  (8 * layout->elems[i].bytes + 1), 8);
+
+	return len;
+}
+
+/**
+ * @brief Compress scans into one frame:
+ *	u8	IIO_COMPRESS_MAGIC
+ *	u8	IIO_CODEC_DELTA
+ *	u16le	number of scans
+ *	u16le	length of the payload
+ * and for each element of the layout, in order:
+ *	u8	width of its deltas in bits
+ *	the element of the first scan, as stored in the scan
+ *	the zigzag encoded deltas of the next scans, width bits each, packed
+ *	LSB first and padded to a byte
+ * The alignment padding of the scans is not sent.
+ * @param layout - Scan layout.
+ * @param scans - The scans.
+ * @param nb_scans - Number of scans, at least 1.
+ * @param frame - Where to write the frame.
+ * @param len - Size of frame, at least iio_compress_bound().
+ * @return Length of the frame, negative error code otherwise.
+ */
+int32_t iio_compress_delta(const struct iio_compress_layout *layout,
+			   const uint8_t *scans, uint32_t nb_scans,
+			   uint8_t *frame, uint32_t len)
+{
+	const struct iio_compress_elem *e;
+	const uint8_t *p;
+	struct iio_bits bits;
+	uint64_t prev, cur, zz, max;
+	uint32_t i, j, width, payload;
+
+	if (!nb_scans || nb_scans > UINT16_MAX ||
+	    len < iio_compress_bound(layout, nb_scans))
+		return -EINVAL;
+
+	bits.p = frame + IIO_COMPRESS_HDR_SIZE;
+	bits.acc = 0;
+	bits.n = 0;
+
+	for (i = 0; i < layout->nb; i++) {
+		e = &layout->elems[i];
+		p = scans + e->offset;
+
+		/* First pass for the width of the deltas */
+		max = 0;
+		prev = iio_elem_get(p, e);
+		for (j = 1; j < nb_scans; j++) {
+			cur = iio_elem_get(p + j * layout->scan_bytes, e);
+			max |= iio_elem_zigzag(cur, prev, e->bytes);
+			prev = cur;
+		}
+		width = iio_width64(max);
+
+		*bits.p++ = width;
+		memcpy(bits.p, p, e->bytes);
+		bits.p += e->bytes;
+
+		if (!width)
+			continue;
+
+		prev = iio_elem_get(p, e);
+		for (j = 1; j < nb_scans; j++) {
+			cur = iio_elem_get(p + j * layout->scan_bytes, e);
+			zz = iio_elem_zigzag(cur, prev, e->bytes);
+			if (width > 32) {
+				iio_bits_put(&bits, zz, 32);
+				iio_bits_put(&bits, zz >> 32, width - 32);
+			} else {
+				iio_bits_put(&bits, zz, width);
+			}
+			prev = cur;
+		}
+		iio_bits_flush(&bits);
+	}
+
+	payload = bits.p - frame - IIO_COMPRESS_HDR_SIZE;
+	if (payload > UINT16_MAX)
+		return -EINVAL;
+
+	frame[0] = IIO_COMPRESS_MAGIC;
+	frame[1] = IIO_CODEC_DELTA;
+	no_os_put_unaligned_le16(nb_scans, &frame[2]);
+	no_os_put_unaligned_le16(payload, &frame[4]);
+
+	return payload + IIO_COMPRESS_HDR_SIZE;
+}
@@ -0,0 +1,112 @@
+/***************************************************************************//**
+ *   @file   iio_compress.h
+ *   @brief  Header file of the IIO buffer stream compression.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_COMPRESS_H_
+#define IIO_COMPRESS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** First byte of a frame, the zero bytes between frames are padding */
+#define IIO_COMPRESS_MAGIC	0x5A
+/** magic, codec, u16 number of scans, u16 payload length */
+#define IIO_COMPRESS_HDR_SIZE	6
+/** Most elements in a scan */
+#define IIO_COMPRESS_MAX_ELEMS	32
+/** Raw bytes compressed in one frame */
+#define IIO_COMPRESS_BLOCK_SIZE	2048
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @enum iio_codec
+ * @brief Codecs of the compressed buffer stream, chosen by the client with the
+ * "compression" buffer attribute
+ */
+enum iio_codec {
+	/** Raw data, the stream is not framed */
+	IIO_CODEC_NONE,
+	/** Per element delta, zigzag and bit packing */
+	IIO_CODEC_DELTA,
+};
+
+/**
+ * @struct iio_compress_elem
+ * @brief Element of a scan, the sample of an enabled channel
+ */
+struct iio_compress_elem {
+	/** Offset in the scan */
+	uint16_t offset;
+	/** Storage size: 1, 2, 4 or 8 bytes */
+	uint8_t bytes;
+	/** Set if stored big endian */
+	bool be;
+};
+
+/**
+ * @struct iio_compress_layout
+ * @brief Layout of a scan
+ */
+struct iio_compress_layout {
+	struct iio_compress_elem elems[IIO_COMPRESS_MAX_ELEMS];
+	/** Number of elements */
+	uint32_t nb;
+	/** Size of a scan, with the alignment padding */
+	uint32_t scan_bytes;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Largest frame produced for nb_scans scans. */
+uint32_t iio_compress_bound(const struct iio_compress_layout *layout,
+			    uint32_t nb_scans);
+
+/* Compress nb_scans scans into one frame. */
+int32_t iio_compress_delta(const struct iio_compress_layout *layout,
+			   const uint8_t *scans, uint32_t nb_scans,
+			   uint8_t *frame, uint32_t len);
+
+#endif /* IIO_COMPRESS_H_ */
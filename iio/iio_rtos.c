@@ -0,0 +1,200 @@
+/***************************************************************************//**
+ *   @file   iio_rtos.c
+ *   @brief  FreeRTOS runtime of the IIO server, one task per connection.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <FreeRTOS.h>
+#include "task.h"
+#include "queue.h"
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "iio_rtos.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+struct iio_rtos_desc {
+	struct iio_desc *iio_desc;
+	/* Serializes the calls to the IIO core */
+	void *lock;
+	/* Connections waiting for a worker */
+	QueueHandle_t conns;
+	TaskHandle_t workers[IIO_RTOS_MAX_WORKERS];
+	uint32_t nb_workers;
+	/* Poll period in ticks */
+	TickType_t poll;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+/**
+ * @brief Worker task. Takes a connection and serves it until its client
+ * closes it. While the connection is idle, the task sleeps until the next
+ * poll of the service task, so the other tasks get the CPU.
+ *
+ * @param arg - Runtime descriptor.
+ */
+static void iio_rtos_worker(void *arg)
+{
+	struct iio_rtos_desc *rtos = arg;
+	uint32_t conn_id;
+	int ret;
+
+	while (true) {
+		xQueueReceive(rtos->conns, &conn_id, portMAX_DELAY);
+
+		do {
+			no_os_mutex_lock(rtos->lock);
+			ret = iio_conn_serve(rtos->iio_desc, conn_id);
+			no_os_mutex_unlock(rtos->lock);
+
+			if (ret == -EAGAIN)
+				ulTaskNotifyTake(pdTRUE, rtos->poll);
+			else
+				taskYIELD();
+		} while (ret != -ENOTCONN);
+	}
+}
+
+/**
+ * @brief Service loop, run by the task that called iio_rtos_run(). Runs the
+ * asynchronous triggers, the network stack and the UDP streams, and hands the
+ * new connections to the workers.
+ *
+ * @param rtos - Runtime descriptor.
+ */
+static void iio_rtos_service(struct iio_rtos_desc *rtos)
+{
+	uint32_t conn_id;
+	bool streaming;
+	uint32_t i;
+
+	while (true) {
+		no_os_mutex_lock(rtos->lock);
+		streaming = iio_service_step(rtos->iio_desc);
+		while (!iio_conn_get(rtos->iio_desc, &conn_id))
+			xQueueSend(rtos->conns, &conn_id, 0);
+		no_os_mutex_unlock(rtos->lock);
+
+		for (i = 0; i < rtos->nb_workers; i++)
+			xTaskNotifyGive(rtos->workers[i]);
+
+		if (streaming)
+			taskYIELD();
+		else
+			vTaskDelay(rtos->poll);
+	}
+}
+
+/**
+ * @brief Serve the IIO clients of desc from a pool of worker tasks, instead
+ * of calling iio_step() in a loop. Each connection is owned by one worker for
+ * its lifetime, so a client waiting for data does not delay the requests of
+ * the others. The IIO core runs under a mutex, one request at a time.
+ * Must be called from a task, which becomes the service task.
+ *
+ * @param desc  - IIO descriptor.
+ * @param param - Runtime parameters.
+ *
+ * @return ret  - Negative error code, returns only on error.
+ */
+int iio_rtos_run(struct iio_desc *desc, struct iio_rtos_init_param *param)
+{
+	struct iio_rtos_desc *rtos;
+	UBaseType_t prio;
+	uint32_t stack;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !param || param->nb_workers > IIO_RTOS_MAX_WORKERS)
+		return -EINVAL;
+
+	rtos = no_os_calloc(1, sizeof(*rtos));
+	if (!rtos)
+		return -ENOMEM;
+
+	rtos->iio_desc = desc;
+	rtos->nb_workers = param->nb_workers ? param->nb_workers : 1;
+	rtos->poll = pdMS_TO_TICKS(param->poll_ms ? param->poll_ms :
+				   IIO_RTOS_POLL_MS);
+	if (!rtos->poll)
+		rtos->poll = 1;
+
+	rtos->lock = param->lock;
+	no_os_mutex_init(&rtos->lock);
+	if (!rtos->lock) {
+		ret = -ENOMEM;
+		goto free_rtos;
+	}
+
+	rtos->conns = xQueueCreate(IIOD_MAX_CONNECTIONS, sizeof(uint32_t));
+	if (!rtos->conns) {
+		ret = -ENOMEM;
+		goto free_lock;
+	}
+
+	prio = param->worker_prio ? param->worker_prio : uxTaskPriorityGet(NULL);
+	stack = param->worker_stack ? param->worker_stack :
+		configMINIMAL_STACK_SIZE;
+	for (i = 0; i < rtos->nb_workers; i++) {
+		if (xTaskCreate(iio_rtos_worker, "iio_worker", stack, rtos, prio,
+				&rtos->workers[i]) != pdPASS) {
+			ret = -ENOMEM;
+			goto free_workers;
+		}
+	}
+
+	iio_rtos_service(rtos);
+
+	return 0;
+
+free_workers:
+	while (i--)
+		vTaskDelete(rtos->workers[i]);
+	vQueueDelete(rtos->conns);
+free_lock:
+	if (!param->lock)
+		no_os_mutex_remove(rtos->lock);
+free_rtos:
+	no_os_free(rtos);
+
+	return ret;
+}
@@ -0,0 +1,87 @@
+/***************************************************************************//**
+ *   @file   iio_rtos.h
+ *   @brief  Header file of the FreeRTOS runtime of the IIO server.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_RTOS_H_
+#define IIO_RTOS_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "iio.h"
+#include "iiod.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define IIO_RTOS_MAX_WORKERS	IIOD_MAX_CONNECTIONS
+/* Default period at which the idle connections are checked for new data */
+#define IIO_RTOS_POLL_MS	1
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct iio_rtos_init_param
+ * @brief Parameters of the FreeRTOS runtime of the IIO server.
+ */
+struct iio_rtos_init_param {
+	/** Connections served at the same time, one worker task each, up to
+	 *  IIO_RTOS_MAX_WORKERS. 1 if 0. */
+	uint32_t nb_workers;
+	/** Priority of the worker tasks, the one of the caller if 0 */
+	uint32_t worker_prio;
+	/** Stack size of the worker tasks in words, configMINIMAL_STACK_SIZE
+	 *  if 0 */
+	uint32_t worker_stack;
+	/** Period in ms at which idle connections are checked for new data,
+	 *  IIO_RTOS_POLL_MS if 0 */
+	uint32_t poll_ms;
+	/** Optional mutex created with no_os_mutex_init(), held while the IIO
+	 *  core and the device callbacks run. Application tasks accessing the
+	 *  same devices take it too. One is created if NULL. */
+	void *lock;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/** Serve the IIO clients from worker tasks, returns only on error */
+int iio_rtos_run(struct iio_desc *desc, struct iio_rtos_init_param *param);
+
+#endif /* IIO_RTOS_H_ */
@@ -0,0 +1,381 @@
+/***************************************************************************//**
+ *   @file   iio_spectrum.c
+ *   @brief  Implementation of the IIO magnitude spectrum device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "iio.h"
+#include "iio_spectrum.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+enum iio_spectrum_attr {
+	IIO_SPECTRUM_LENGTH,
+	IIO_SPECTRUM_WINDOW,
+	IIO_SPECTRUM_WINDOW_AVAIL,
+	IIO_SPECTRUM_AVERAGES,
+	IIO_SPECTRUM_SAMPLE_RATE,
+	IIO_SPECTRUM_BIN_SPACING,
+};
+
+static const char * const iio_spectrum_windows[] = {
+	[NO_OS_DSP_FFT_RECT] = "rect",
+	[NO_OS_DSP_FFT_HANN] = "hann",
+	[NO_OS_DSP_FFT_BLACKMAN_HARRIS] = "blackman-harris",
+};
+
+/* Magnitudes, one sample per bin */
+static const struct scan_type iio_spectrum_scan_type = {
+	.sign = 'u',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+static int iio_spectrum_attr_get(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	struct iio_spectrum_desc *desc = device;
+	enum no_os_dsp_fft_window w;
+	uint64_t spacing;
+	int ret = 0;
+
+	switch (priv) {
+	case IIO_SPECTRUM_LENGTH:
+		return snprintf(buf, len, "%"PRIu32, desc->length);
+	case IIO_SPECTRUM_WINDOW:
+		return snprintf(buf, len, "%s", iio_spectrum_windows[desc->window]);
+	case IIO_SPECTRUM_WINDOW_AVAIL:
+		for (w = 0; w < NO_OS_ARRAY_SIZE(iio_spectrum_windows); w++)
+			ret += snprintf(buf + ret, no_os_max((int)len - ret, 0),
+					"%s%s", w ? " " : "",
+					iio_spectrum_windows[w]);
+		return ret;
+	case IIO_SPECTRUM_AVERAGES:
+		return snprintf(buf, len, "%"PRIu32, desc->averages);
+	case IIO_SPECTRUM_SAMPLE_RATE:
+		return snprintf(buf, len, "%"PRIu32, desc->sample_rate);
+	case IIO_SPECTRUM_BIN_SPACING:
+		/* In Hz, with 3 decimals */
+		spacing = (uint64_t)desc->sample_rate * 1000 / desc->length;
+		return snprintf(buf, len, "%"PRIu32".%03"PRIu32,
+				(uint32_t)(spacing / 1000),
+				(uint32_t)(spacing % 1000));
+	default:
+		return -EINVAL;
+	}
+}
+
+static int iio_spectrum_attr_set(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	struct iio_spectrum_desc *desc = device;
+	uint32_t val, ch;
+	int ret;
+
+	switch (priv) {
+	case IIO_SPECTRUM_WINDOW:
+		for (val = 0; val < NO_OS_ARRAY_SIZE(iio_spectrum_windows); val++)
+			if (!strncmp(buf, iio_spectrum_windows[val],
+				     strlen(iio_spectrum_windows[val])))
+				break;
+		if (val == NO_OS_ARRAY_SIZE(iio_spectrum_windows))
+			return -EINVAL;
+
+		for (ch = 0; ch < desc->nb_channels; ch++) {
+			ret = no_os_dsp_fft_set_window(desc->fft[ch], val);
+			if (ret)
+				return ret;
+		}
+		desc->window = val;
+
+		return len;
+	case IIO_SPECTRUM_AVERAGES:
+		val = no_os_str_to_uint32(buf);
+		if (!val)
+			return -EINVAL;
+
+		for (ch = 0; ch < desc->nb_channels; ch++) {
+			ret = no_os_dsp_fft_set_averages(desc->fft[ch], val);
+			if (ret)
+				return ret;
+		}
+		desc->averages = val;
+
+		return len;
+	case IIO_SPECTRUM_SAMPLE_RATE:
+		desc->sample_rate = no_os_str_to_uint32(buf);
+
+		return len;
+	default:
+		return -EINVAL;
+	}
+}
+
+static struct iio_attribute iio_spectrum_attrs[] = {
+	{
+		.name = "fft_length",
+		.priv = IIO_SPECTRUM_LENGTH,
+		.show = iio_spectrum_attr_get,
+	},
+	{
+		.name = "fft_window",
+		.priv = IIO_SPECTRUM_WINDOW,
+		.show = iio_spectrum_attr_get,
+		.store = iio_spectrum_attr_set,
+	},
+	{
+		.name = "fft_window_available",
+		.priv = IIO_SPECTRUM_WINDOW_AVAIL,
+		.show = iio_spectrum_attr_get,
+	},
+	{
+		.name = "fft_averages",
+		.priv = IIO_SPECTRUM_AVERAGES,
+		.show = iio_spectrum_attr_get,
+		.store = iio_spectrum_attr_set,
+	},
+	{
+		.name = "sampling_frequency",
+		.priv = IIO_SPECTRUM_SAMPLE_RATE,
+		.show = iio_spectrum_attr_get,
+		.store = iio_spectrum_attr_set,
+	},
+	{
+		.name = "fft_bin_spacing",
+		.priv = IIO_SPECTRUM_BIN_SPACING,
+		.show = iio_spectrum_attr_get,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/* Start the spectra of the clients with fresh frames */
+static int32_t iio_spectrum_pre_enable(void *dev, uint32_t mask)
+{
+	struct iio_spectrum_desc *desc = dev;
+	uint32_t ch;
+	int ret;
+
+	for (ch = 0; ch < desc->nb_channels; ch++) {
+		ret = no_os_dsp_fft_reset(desc->fft[ch]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int32_t iio_spectrum_post_disable(void *dev)
+{
+	struct iio_spectrum_desc *desc = dev;
+
+	desc->buffer = NULL;
+
+	return 0;
+}
+
+/* The spectra are pushed by iio_spectrum_push() as they are ready */
+static int32_t iio_spectrum_submit(struct iio_device_data *dev_data)
+{
+	struct iio_spectrum_desc *desc = dev_data->dev;
+
+	desc->buffer = dev_data->buffer;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a spectrum device.
+ * The device turns the scans of an input device, fed with
+ * iio_spectrum_push(), into averaged magnitude spectra. Each spectrum is
+ * pushed to its buffer as length / 2 scans, one per bin, so the clients
+ * read a spectrum per refill with a buffer of length / 2 samples.
+ * @param desc - The spectrum device descriptor.
+ * @param init_param - The spectrum device initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_spectrum_init(struct iio_spectrum_desc **desc,
+		      struct iio_spectrum_init_param *init_param)
+{
+	struct no_os_dsp_fft_config config;
+	struct iio_spectrum_desc *d;
+	uint32_t ch;
+	int ret;
+
+	if (!desc || !init_param || !init_param->nb_channels ||
+	    init_param->nb_channels > IIO_SPECTRUM_MAX_CHANNELS)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	config.length = init_param->length;
+	config.window = init_param->window;
+	config.averages = init_param->averages;
+	config.shift = init_param->shift;
+
+	d->nb_channels = init_param->nb_channels;
+	d->length = init_param->length;
+	d->window = init_param->window;
+	d->averages = init_param->averages;
+	d->sample_rate = init_param->sample_rate;
+
+	for (ch = 0; ch < d->nb_channels; ch++) {
+		ret = no_os_dsp_fft_init(&d->fft[ch], config);
+		if (ret)
+			goto error;
+
+		d->channels[ch].ch_type = init_param->ch_type;
+		d->channels[ch].channel = ch;
+		d->channels[ch].scan_index = ch;
+		d->channels[ch].scan_type = &iio_spectrum_scan_type;
+		d->channels[ch].indexed = true;
+	}
+
+	d->bins = no_os_calloc(d->nb_channels * d->length / 2,
+			       sizeof(*d->bins));
+	if (!d->bins) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	d->iio_dev.num_ch = d->nb_channels;
+	d->iio_dev.channels = d->channels;
+	d->iio_dev.attributes = iio_spectrum_attrs;
+	d->iio_dev.pre_enable = iio_spectrum_pre_enable;
+	d->iio_dev.post_disable = iio_spectrum_post_disable;
+	d->iio_dev.submit = iio_spectrum_submit;
+
+	*desc = d;
+
+	return 0;
+
+error:
+	iio_spectrum_remove(d);
+
+	return ret;
+}
+
+/**
+ * @brief Feed interleaved input scans to the spectrum device.
+ * Meant to be called with the scans read from the input device, e.g. at the
+ * end of a no_os_dsp_scan chain. The spectra completed are pushed to the
+ * buffer of the spectrum device if it is enabled, and dropped otherwise.
+ * @param desc - The spectrum device descriptor.
+ * @param scans - nb_scans scans of nb_channels samples each.
+ * @param nb_scans - Number of scans.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_spectrum_push(struct iio_spectrum_desc *desc, const int32_t *scans,
+		      uint32_t nb_scans)
+{
+	uint32_t vals[IIO_SPECTRUM_MAX_CHANNELS];
+	uint32_t half, i, ch, k;
+	int ret;
+
+	if (!desc || (nb_scans && !scans))
+		return -EINVAL;
+
+	half = desc->length / 2;
+	for (i = 0; i < nb_scans; i++, scans += desc->nb_channels) {
+		for (ch = 0; ch < desc->nb_channels; ch++) {
+			ret = no_os_dsp_fft_push(desc->fft[ch], &scans[ch], 1);
+			if (ret)
+				return ret;
+		}
+
+		/* The channels complete their spectra on the same scan */
+		for (ch = 0; ch < desc->nb_channels; ch++) {
+			ret = no_os_dsp_fft_read(desc->fft[ch],
+						 &desc->bins[ch * half]);
+			if (ret == -EAGAIN)
+				break;
+			if (ret)
+				return ret;
+		}
+
+		if (ch < desc->nb_channels || !desc->buffer)
+			continue;
+
+		for (k = 0; k < half; k++) {
+			for (ch = 0; ch < desc->nb_channels; ch++)
+				vals[ch] = desc->bins[ch * half + k];
+
+			ret = iio_buffer_push_vals(desc->buffer, vals);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by iio_spectrum_init().
+ * @param desc - The spectrum device descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_spectrum_remove(struct iio_spectrum_desc *desc)
+{
+	uint32_t ch;
+
+	if (!desc)
+		return -EINVAL;
+
+	for (ch = 0; ch < desc->nb_channels; ch++)
+		if (desc->fft[ch])
+			no_os_dsp_fft_remove(desc->fft[ch]);
+	no_os_free(desc->bins);
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+/***************************************************************************//**
+ *   @file   iio_spectrum.h
+ *   @brief  Header file of the IIO magnitude spectrum device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_SPECTRUM_H_
+#define IIO_SPECTRUM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "iio_types.h"
+#include "no_os_dsp.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Most input channels of a spectrum device */
+#define IIO_SPECTRUM_MAX_CHANNELS	8
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct iio_spectrum_init_param
+ * @brief IIO spectrum device initialization structure
+ */
+struct iio_spectrum_init_param {
+	/** Number of channels of the input scans */
+	uint32_t nb_channels;
+	/** Type of the channels, as the ones of the input device */
+	enum iio_chan_type ch_type;
+	/** FFT length, the device has length / 2 bins per spectrum */
+	uint32_t length;
+	/** Window applied to each frame */
+	enum no_os_dsp_fft_window window;
+	/** Number of frames averaged in each spectrum, at least 1 */
+	uint32_t averages;
+	/** Fractional bits of the bins, see struct no_os_dsp_fft_config */
+	uint32_t shift;
+	/** Rate of the input scans, used for the bin spacing */
+	uint32_t sample_rate;
+};
+
+/**
+ * @struct iio_spectrum_desc
+ * @brief IIO spectrum device descriptor
+ */
+struct iio_spectrum_desc {
+	/** Number of channels of the input scans */
+	uint32_t nb_channels;
+	/** FFT length */
+	uint32_t length;
+	/** Window applied to each frame */
+	enum no_os_dsp_fft_window window;
+	/** Number of frames averaged in each spectrum */
+	uint32_t averages;
+	/** Rate of the input scans */
+	uint32_t sample_rate;
+	/** Spectrum of each channel */
+	struct no_os_dsp_fft *fft[IIO_SPECTRUM_MAX_CHANNELS];
+	/** Last spectrum of each channel, nb_channels * length / 2 bins */
+	uint32_t *bins;
+	/** Buffer the spectra are pushed to, NULL while it is disabled */
+	struct iio_buffer *buffer;
+	/** Channels of the IIO device, one per input channel */
+	struct iio_channel channels[IIO_SPECTRUM_MAX_CHANNELS];
+	/** IIO device to register with iio_init() */
+	struct iio_device iio_dev;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/** Initialize a spectrum device */
+int iio_spectrum_init(struct iio_spectrum_desc **desc,
+		      struct iio_spectrum_init_param *init_param);
+/** Feed interleaved input scans to the spectrum device */
+int iio_spectrum_push(struct iio_spectrum_desc *desc, const int32_t *scans,
+		      uint32_t nb_scans);
+/** Free the resources allocated by iio_spectrum_init() */
+int iio_spectrum_remove(struct iio_spectrum_desc *desc);
+
+#endif /* IIO_SPECTRUM_H_ */
@@ -0,0 +1,297 @@
+/***************************************************************************//**
+ *   @file   iio_track_cal.c
+ *   @brief  Implementation of the IIO tracking calibration scheduler device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include "iio.h"
+#include "iio_track_cal.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+enum iio_track_cal_attr {
+	IIO_TRACK_CAL_MODE,
+	IIO_TRACK_CAL_PAUSED,
+	IIO_TRACK_CAL_WINDOWS,
+	IIO_TRACK_CAL_SKIPPED,
+	IIO_TRACK_CAL_PAUSES,
+	IIO_TRACK_CAL_WINDOW_TIME,
+	IIO_TRACK_CAL_STATS_RESET,
+	IIO_TRACK_CAL_RUNS,
+	IIO_TRACK_CAL_DEFERRED,
+	IIO_TRACK_CAL_ERRORS,
+	IIO_TRACK_CAL_BUSY_TIME,
+	IIO_TRACK_CAL_MAX_TIME,
+};
+
+static const char * const iio_track_cal_modes[] = {
+	[NO_OS_TRACK_CAL_FREE_RUN] = "free_run",
+	[NO_OS_TRACK_CAL_WINDOWED] = "windowed",
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+static int iio_track_cal_attr_get(void *device, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv)
+{
+	struct iio_track_cal_desc *desc = device;
+	struct no_os_track_cal *tc = desc->track_cal;
+
+	switch (priv) {
+	case IIO_TRACK_CAL_MODE:
+		return snprintf(buf, len, "%s", iio_track_cal_modes[tc->mode]);
+	case IIO_TRACK_CAL_PAUSED:
+		return snprintf(buf, len, "%d", tc->paused ? 1 : 0);
+	case IIO_TRACK_CAL_WINDOWS:
+		return snprintf(buf, len, "%"PRIu32, tc->windows);
+	case IIO_TRACK_CAL_SKIPPED:
+		return snprintf(buf, len, "%"PRIu32, tc->skipped);
+	case IIO_TRACK_CAL_PAUSES:
+		return snprintf(buf, len, "%"PRIu32, tc->pauses);
+	case IIO_TRACK_CAL_WINDOW_TIME:
+		return snprintf(buf, len, "%"PRIu64, tc->window_ns / 1000);
+	default:
+		return -EINVAL;
+	}
+}
+
+static int iio_track_cal_attr_set(void *device, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv)
+{
+	struct iio_track_cal_desc *desc = device;
+	bool pause;
+	int ret;
+
+	switch (priv) {
+	case IIO_TRACK_CAL_PAUSED:
+		/* The pauses of the application are not undone from here */
+		pause = !!no_os_str_to_uint32(buf);
+		if (pause == desc->paused)
+			return len;
+
+		if (pause)
+			ret = no_os_track_cal_pause(desc->track_cal);
+		else
+			ret = no_os_track_cal_resume(desc->track_cal);
+		if (ret)
+			return ret;
+		desc->paused = pause;
+
+		return len;
+	case IIO_TRACK_CAL_STATS_RESET:
+		ret = no_os_track_cal_reset_stats(desc->track_cal);
+		if (ret)
+			return ret;
+
+		return len;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int iio_track_cal_ch_attr_get(void *device, char *buf, uint32_t len,
+				     const struct iio_ch_info *channel,
+				     intptr_t priv)
+{
+	struct iio_track_cal_desc *desc = device;
+	struct no_os_track_cal_stats stats;
+	int ret;
+
+	ret = no_os_track_cal_get_stats(desc->track_cal, channel->address,
+					&stats);
+	if (ret)
+		return ret;
+
+	switch (priv) {
+	case IIO_TRACK_CAL_RUNS:
+		return snprintf(buf, len, "%"PRIu32, stats.runs);
+	case IIO_TRACK_CAL_DEFERRED:
+		return snprintf(buf, len, "%"PRIu32, stats.deferred);
+	case IIO_TRACK_CAL_ERRORS:
+		return snprintf(buf, len, "%"PRIu32, stats.errors);
+	case IIO_TRACK_CAL_BUSY_TIME:
+		return snprintf(buf, len, "%"PRIu64, stats.busy_ns / 1000);
+	case IIO_TRACK_CAL_MAX_TIME:
+		return snprintf(buf, len, "%"PRIu64, stats.max_ns / 1000);
+	default:
+		return -EINVAL;
+	}
+}
+
+static struct iio_attribute iio_track_cal_attrs[] = {
+	{
+		.name = "mode",
+		.priv = IIO_TRACK_CAL_MODE,
+		.show = iio_track_cal_attr_get,
+	},
+	{
+		.name = "paused",
+		.priv = IIO_TRACK_CAL_PAUSED,
+		.show = iio_track_cal_attr_get,
+		.store = iio_track_cal_attr_set,
+	},
+	{
+		.name = "windows",
+		.priv = IIO_TRACK_CAL_WINDOWS,
+		.show = iio_track_cal_attr_get,
+	},
+	{
+		.name = "windows_skipped",
+		.priv = IIO_TRACK_CAL_SKIPPED,
+		.show = iio_track_cal_attr_get,
+	},
+	{
+		.name = "pauses",
+		.priv = IIO_TRACK_CAL_PAUSES,
+		.show = iio_track_cal_attr_get,
+	},
+	{
+		.name = "window_time_us",
+		.priv = IIO_TRACK_CAL_WINDOW_TIME,
+		.show = iio_track_cal_attr_get,
+	},
+	{
+		.name = "stats_reset",
+		.priv = IIO_TRACK_CAL_STATS_RESET,
+		.store = iio_track_cal_attr_set,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute iio_track_cal_ch_attrs[] = {
+	{
+		.name = "runs",
+		.priv = IIO_TRACK_CAL_RUNS,
+		.show = iio_track_cal_ch_attr_get,
+	},
+	{
+		.name = "deferred",
+		.priv = IIO_TRACK_CAL_DEFERRED,
+		.show = iio_track_cal_ch_attr_get,
+	},
+	{
+		.name = "errors",
+		.priv = IIO_TRACK_CAL_ERRORS,
+		.show = iio_track_cal_ch_attr_get,
+	},
+	{
+		.name = "busy_time_us",
+		.priv = IIO_TRACK_CAL_BUSY_TIME,
+		.show = iio_track_cal_ch_attr_get,
+	},
+	{
+		.name = "max_time_us",
+		.priv = IIO_TRACK_CAL_MAX_TIME,
+		.show = iio_track_cal_ch_attr_get,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/**
+ * @brief Initialize a tracking calibration device. The device has a channel
+ * per calibration of the scheduler, named after it, with its counters, and
+ * a paused attribute for the captures driven by the clients. The counters
+ * are updated by the calls of the application to the scheduler, e.g. its
+ * periodic no_os_track_cal_poll().
+ * @param desc - The tracking calibration device descriptor.
+ * @param track_cal - The scheduler, it must outlive the device.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_track_cal_init(struct iio_track_cal_desc **desc,
+		       struct no_os_track_cal *track_cal)
+{
+	struct iio_track_cal_desc *d;
+	struct iio_channel *ch;
+	uint32_t i;
+
+	if (!desc || !track_cal)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->track_cal = track_cal;
+
+	for (i = 0; i < NO_OS_TRACK_CAL_MAX; i++) {
+		if (!(track_cal->mask & NO_OS_BIT(i)))
+			continue;
+
+		ch = &d->channels[d->iio_dev.num_ch++];
+		ch->name = track_cal->names ? track_cal->names[i] : NULL;
+		ch->ch_type = IIO_COUNT;
+		ch->channel = i;
+		ch->address = i;
+		ch->attributes = iio_track_cal_ch_attrs;
+		ch->indexed = true;
+	}
+
+	d->iio_dev.channels = d->channels;
+	d->iio_dev.attributes = iio_track_cal_attrs;
+
+	*desc = d;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by iio_track_cal_init(), the pause
+ * made through the paused attribute is undone.
+ * @param desc - The tracking calibration device descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_track_cal_remove(struct iio_track_cal_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->paused)
+		no_os_track_cal_resume(desc->track_cal);
+	no_os_free(desc);
+
+	return 0;
+}
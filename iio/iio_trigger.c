@@ -44,6 +44,7 @@
 #include <string.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_profile.h"
 #include "iio.h"
 #include "iio_trigger.h"
 
@@ -77,6 +78,9 @@ int iio_hw_trig_init(struct iio_hw_trig **iio_trig,
 	trig_desc->irq_ctrl = init_param->irq_ctrl;
 	trig_desc->irq_id = init_param->irq_id;
 	trig_desc->irq_trig_lvl = init_param->irq_trig_lvl;
+	trig_desc->bh = init_param->bh;
+	trig_desc->bh_notify = init_param->bh_notify;
+	trig_desc->bh_ctx = init_param->bh_ctx;
 
 	struct no_os_callback_desc irq_cb = {
 		.callback = iio_hw_trig_handler,
@@ -144,6 +148,10 @@ int iio_trig_disable(void *trig)
  * @brief Trigger interrupt handler. This function will be called when a system
  * interrupt is asserted for the configured trigger.
  *
+ * This is the top half of the trigger: it timestamps the event and, for an
+ * IIO_HW_TRIG_BH_DEFERRED trigger, only queues it for iio_hw_trig_bh_run(), so
+ * the interrupt stays short whatever the device trigger handler does.
+ *
  * @param trig - Trigger structure which is linked to this handler.
 */
 void iio_hw_trig_handler(void *trig)
@@ -152,8 +160,56 @@ void iio_hw_trig_handler(void *trig)
 		return;
 
 	struct iio_hw_trig *desc = trig;
+	uint32_t cycles = no_os_get_cycles();
+
+	if (desc->bh == IIO_HW_TRIG_BH_INLINE) {
+		desc->event_cycles = cycles;
+		iio_process_trigger_at(desc->iio_desc, desc->name, cycles);
+		return;
+	}
+
+	if (desc->head - desc->tail >= IIO_HW_TRIG_QUEUE_SIZE) {
+		desc->dropped++;
+		return;
+	}
+
+	desc->queue[desc->head & (IIO_HW_TRIG_QUEUE_SIZE - 1)] = cycles;
+	desc->head++;
+
+	if (desc->bh_notify)
+		desc->bh_notify(desc->bh_ctx);
+}
+
+/**
+ * @brief Bottom half of a deferred trigger, processes the queued events in
+ * order. Call it from a context with a lower priority than the trigger
+ * interrupt: a software interrupt, a high priority task or the main loop.
+ * While an event is processed, event_cycles holds the time of its interrupt.
+ *
+ * @param trig - The trigger structure.
+ *
+ * @return ret - Number of events processed or negative error code.
+*/
+int iio_hw_trig_bh_run(struct iio_hw_trig *trig)
+{
+	int cnt = 0;
+	int ret;
+
+	if (!trig)
+		return -EINVAL;
+
+	while (trig->tail != trig->head) {
+		trig->event_cycles = trig->queue[trig->tail &
+						 (IIO_HW_TRIG_QUEUE_SIZE - 1)];
+		ret = iio_process_trigger_at(trig->iio_desc, trig->name,
+					     trig->event_cycles);
+		trig->tail++;
+		if (ret)
+			return ret;
+		cnt++;
+	}
 
-	iio_process_trigger_type(desc->iio_desc, desc->name);
+	return cnt;
 }
 
 /**
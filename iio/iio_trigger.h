@@ -51,10 +51,24 @@
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 #define TRIG_MAX_NAME_SIZE 20
+/* Events a deferred hardware trigger can queue, must be a power of 2 */
+#define IIO_HW_TRIG_QUEUE_SIZE 8
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
+/**
+ * @enum iio_hw_trig_bh
+ * @brief Where the bottom half of a hardware trigger, the processing of the
+ * trigger by the IIO core and the device trigger handler, runs.
+ */
+enum iio_hw_trig_bh {
+	/** In the trigger interrupt, right after the top half */
+	IIO_HW_TRIG_BH_INLINE,
+	/** In iio_hw_trig_bh_run(), the top half only queues the event */
+	IIO_HW_TRIG_BH_DEFERRED,
+};
+
 /**
  * @struct iio_hw_trig
  * @brief IIO hardware trigger structure
@@ -70,6 +84,22 @@ struct iio_hw_trig {
 	enum no_os_irq_trig_level irq_trig_lvl;
 	/** Device trigger name */
 	char name[TRIG_MAX_NAME_SIZE + 1];
+	/** Where the bottom half runs */
+	enum iio_hw_trig_bh bh;
+	/** Called by the top half of a deferred trigger, see init param */
+	void (*bh_notify)(void *ctx);
+	/** Parameter of bh_notify */
+	void *bh_ctx;
+	/** no_os_get_cycles() of the queued events, written by the top half */
+	volatile uint32_t queue[IIO_HW_TRIG_QUEUE_SIZE];
+	/** Events queued, only written by the top half */
+	volatile uint32_t head;
+	/** Events processed, only written by the bottom half */
+	volatile uint32_t tail;
+	/** Events lost because the queue was full */
+	volatile uint32_t dropped;
+	/** no_os_get_cycles() in the interrupt of the event being processed */
+	uint32_t event_cycles;
 };
 
 /**
@@ -102,6 +132,17 @@ struct iio_hw_trig_init_param {
 	struct iio_hw_trig_cb_info cb_info;
 	/** Device trigger name */
 	const char *name;
+	/** Where the bottom half runs, inline in the interrupt by default */
+	enum iio_hw_trig_bh bh;
+	/**
+	 * Optional, called in interrupt context after a deferred event is
+	 * queued. It can pend a software interrupt or wake up a high priority
+	 * task that calls iio_hw_trig_bh_run(). Without it, the owner of the
+	 * trigger polls iio_hw_trig_bh_run().
+	 */
+	void (*bh_notify)(void *ctx);
+	/** Parameter of bh_notify */
+	void *bh_ctx;
 };
 
 /**
@@ -136,6 +177,8 @@ int iio_trig_enable(void *trig);
 int iio_trig_disable(void *trig);
 /** API for hardware trigger handler */
 void iio_hw_trig_handler(void *trig);
+/** API to run the bottom half of the queued events of a deferred trigger */
+int iio_hw_trig_bh_run(struct iio_hw_trig *trig);
 /** API to remove a hardware trigger */
 int iio_hw_trig_remove(struct iio_hw_trig *trig);
 #endif
@@ -46,6 +46,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "no_os_circular_buffer.h"
+#include "iio_writer.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -84,6 +85,7 @@ enum iio_chan_type {
 	IIO_COUNT,
 	IIO_DELTA_ANGL,
 	IIO_DELTA_VELOCITY,
+	IIO_TIMESTAMP,
 };
 
 /**
@@ -147,6 +149,13 @@ struct iio_attribute {
 	/** Store function pointer */
 	int (*store)(void *device, char *buf, uint32_t len,
 		     const struct iio_ch_info *channel, intptr_t priv);
+	/** Optional, used instead of show for values that may not fit the
+	 * connection buffer. The value is generated with iio_writer_printf()
+	 * and iio_writer_write() and sent in chunks, the function is called
+	 * again for each chunk.
+	 */
+	int (*show_stream)(void *device, struct iio_writer *w,
+			   const struct iio_ch_info *channel, intptr_t priv);
 };
 
 /**
@@ -186,9 +195,9 @@ struct iio_channel {
 	/** Index to give ordering in scans when read  from a buffer. */
 	int			scan_index;
 	/** */
-	struct scan_type	*scan_type;
+	const struct scan_type	*scan_type;
 	/** Array of attributes. Last one should have its name set to NULL */
-	struct iio_attribute	*attributes;
+	const struct iio_attribute	*attributes;
 	/** if true, the channel is an output channel */
 	bool			ch_out;
 	/** Set if channel has a modifier. Use channel2 property to
@@ -211,6 +220,31 @@ struct iio_cyclic_buffer_info {
 	uint32_t buff_index;
 };
 
+/* Most elements in a scan, one per bit of iio_buffer.active_mask */
+#define IIO_SCAN_MAX_ELEMS	32
+
+/*
+ * Layout of the scans of an opened buffer, computed once by the core when the
+ * buffer is opened. Element i is the i-th enabled channel.
+ */
+struct iio_scan_layout {
+	/* Number of enabled channels */
+	uint32_t nb;
+	/* Size of a scan, with the alignment padding */
+	uint32_t scan_bytes;
+	/* Storage size of all the elements if they are the same and the scan
+	 * has no padding, 0 otherwise */
+	uint8_t uniform;
+	/* Set if the enabled channels are consecutive */
+	bool dense;
+	/* Index of the channel of each element */
+	uint8_t ch[IIO_SCAN_MAX_ELEMS];
+	/* Storage size of each element in bytes */
+	uint8_t bytes[IIO_SCAN_MAX_ELEMS];
+	/* Offset of each element in the scan */
+	uint16_t offset[IIO_SCAN_MAX_ELEMS];
+};
+
 struct iio_buffer {
 	/* Mask with active channels */
 	uint32_t active_mask;
@@ -218,8 +252,15 @@ struct iio_buffer {
 	uint32_t size;
 	/* Number of bytes per sample * number of active channels */
 	uint32_t bytes_per_scan;
+	/* Where the enabled channels are in a scan */
+	struct iio_scan_layout layout;
 	/* Number of requested samples */
 	uint32_t samples;
+	/*
+	 * Number of blocks of size bytes that fit in buf. When greater than 1
+	 * the next block can be filled while the previous one is sent.
+	 */
+	uint32_t nb_blocks;
 	/* Buffer direction */
 	enum iio_buffer_direction dir;
 	/* Buffer where data is stored */
@@ -231,6 +272,9 @@ struct iio_buffer {
 struct iio_device_data {
 	void *dev;
 	struct iio_buffer *buffer;
+	/** no_os_get_cycles() of the trigger event being handled, the same for
+	 *  all the devices fired by one event */
+	uint32_t trig_cycles;
 };
 
 struct iio_trigger {
@@ -238,7 +282,7 @@ struct iio_trigger {
 	 *  If false the handler will be called from iio_step */
 	bool is_synchronous;
 	/** Array of attributes. Last one should have its name set to NULL */
-	struct iio_attribute *attributes;
+	const struct iio_attribute *attributes;
 	/** Called when needs to be enabled */
 	int (*enable)(void *trig);
 	/** Called when needs to be disabled */
@@ -248,6 +292,10 @@ struct iio_trigger {
 /**
  * @struct iio_device
  * @brief Structure holding channels and attributes of a device.
+ *
+ * The channel, attribute and scan type tables are only read by the IIO core,
+ * so they can be declared const and shared by all the instances of a driver.
+ * The instance is reached through the device pointer given to the callbacks.
  */
 struct iio_device {
 	/** Structure for existing initialized irq controllers. Has to be
@@ -256,13 +304,13 @@ struct iio_device {
 	/** Device number of channels */
 	uint16_t num_ch;
 	/** List of channels */
-	struct iio_channel *channels;
+	const struct iio_channel *channels;
 	/** Array of attributes. Last one should have its name set to NULL */
-	struct iio_attribute *attributes;
+	const struct iio_attribute *attributes;
 	/** Array of attributes. Last one should have its name set to NULL */
-	struct iio_attribute *debug_attributes;
+	const struct iio_attribute *debug_attributes;
 	/** Array of attributes. Last one should have its name set to NULL */
-	struct iio_attribute *buffer_attributes;
+	const struct iio_attribute *buffer_attributes;
 	/* Numbers of bytes will be:
 	 * samples * (storage_size_of_first_active_ch / 8) * nb_active_channels
 	 * DEPRECATED.
@@ -0,0 +1,405 @@
+/***************************************************************************//**
+ *   @file   iio_wavegen.c
+ *   @brief  IIO device driving the DDS waveform generator.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "iio.h"
+#include "iio_wavegen.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define IIO_WAVEGEN_FULL_SCALE	1000000
+#define IIO_WAVEGEN_TURN_MDEG	360000
+
+enum iio_wavegen_attr {
+	IIO_WAVEGEN_FREQ,
+	IIO_WAVEGEN_PHASE,
+	IIO_WAVEGEN_SCALE,
+	IIO_WAVEGEN_SAMPLE_RATE,
+	IIO_WAVEGEN_WAVEFORM,
+	IIO_WAVEGEN_WAVEFORM_AVAIL,
+	IIO_WAVEGEN_SWEEP_START,
+	IIO_WAVEGEN_SWEEP_STOP,
+	IIO_WAVEGEN_SWEEP_TIME,
+	IIO_WAVEGEN_SWEEP_SCALE,
+};
+
+static const char * const iio_wavegen_waveforms[] = {
+	[NO_OS_WAVEGEN_TONES] = "tones",
+	[NO_OS_WAVEGEN_CHIRP] = "sweep",
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+static uint32_t iio_wavegen_ftw(struct iio_wavegen_desc *desc, uint32_t freq)
+{
+	if (desc->cyclic_samples)
+		return no_os_wavegen_cyclic_ftw(freq, desc->sample_rate,
+						desc->cyclic_samples);
+
+	return no_os_wavegen_ftw(freq, desc->sample_rate);
+}
+
+static uint16_t iio_wavegen_amplitude(uint32_t scale)
+{
+	return (uint64_t)scale * INT16_MAX / IIO_WAVEGEN_FULL_SCALE;
+}
+
+/* Rebuild the waveform from the attributes and let the application play it */
+static int iio_wavegen_apply(struct iio_wavegen_desc *desc)
+{
+	struct no_os_wavegen_config config = {
+		.mode = desc->mode,
+		.shift = desc->shift,
+		.offset_binary = desc->offset_binary,
+	};
+	struct iio_wavegen_sweep *sweep = &desc->sweep;
+	uint32_t t, span, nb_samples;
+	int ret;
+
+	for (t = 0; t < NO_OS_WAVEGEN_MAX_TONES; t++) {
+		if (!desc->tones[t].scale)
+			continue;
+
+		config.tones[config.nb_tones].ftw = iio_wavegen_ftw(desc,
+						    desc->tones[t].freq);
+		config.tones[config.nb_tones].phase =
+			no_os_div_u64((uint64_t)desc->tones[t].phase << 32,
+				      IIO_WAVEGEN_TURN_MDEG);
+		config.tones[config.nb_tones].amplitude =
+			iio_wavegen_amplitude(desc->tones[t].scale);
+		config.nb_tones++;
+	}
+
+	config.chirp.start_ftw = no_os_wavegen_ftw(sweep->start,
+				 desc->sample_rate);
+	config.chirp.stop_ftw = no_os_wavegen_ftw(sweep->stop,
+				desc->sample_rate);
+	config.chirp.amplitude = iio_wavegen_amplitude(sweep->scale);
+	span = config.chirp.stop_ftw >= config.chirp.start_ftw ?
+	       config.chirp.stop_ftw - config.chirp.start_ftw :
+	       config.chirp.start_ftw - config.chirp.stop_ftw;
+	nb_samples = no_os_div_u64((uint64_t)sweep->time_us * desc->sample_rate,
+				   1000000);
+	config.chirp.rate = no_os_max(span / no_os_max(nb_samples, 1u), 1u);
+
+	ret = no_os_wavegen_set_config(desc->wg, &config);
+	if (ret)
+		return ret;
+
+	if (desc->update)
+		return desc->update(desc->ctx, desc->wg);
+
+	return 0;
+}
+
+static int iio_wavegen_attr_get(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct iio_wavegen_desc *desc = device;
+	int32_t vals[2];
+	uint32_t w;
+	int ret = 0;
+
+	switch (priv) {
+	case IIO_WAVEGEN_FREQ:
+		return snprintf(buf, len, "%"PRIu32,
+				desc->tones[channel->ch_num].freq);
+	case IIO_WAVEGEN_PHASE:
+		return snprintf(buf, len, "%"PRIu32,
+				desc->tones[channel->ch_num].phase);
+	case IIO_WAVEGEN_SCALE:
+	case IIO_WAVEGEN_SWEEP_SCALE:
+		w = priv == IIO_WAVEGEN_SCALE ?
+		    desc->tones[channel->ch_num].scale : desc->sweep.scale;
+		vals[0] = w / IIO_WAVEGEN_FULL_SCALE;
+		vals[1] = w % IIO_WAVEGEN_FULL_SCALE;
+		return iio_format_value(buf, len, IIO_VAL_INT_PLUS_MICRO, 2,
+					vals);
+	case IIO_WAVEGEN_SAMPLE_RATE:
+		return snprintf(buf, len, "%"PRIu32, desc->sample_rate);
+	case IIO_WAVEGEN_WAVEFORM:
+		return snprintf(buf, len, "%s", iio_wavegen_waveforms[desc->mode]);
+	case IIO_WAVEGEN_WAVEFORM_AVAIL:
+		for (w = 0; w < NO_OS_ARRAY_SIZE(iio_wavegen_waveforms); w++)
+			ret += snprintf(buf + ret, no_os_max((int)len - ret, 0),
+					"%s%s", w ? " " : "",
+					iio_wavegen_waveforms[w]);
+		return ret;
+	case IIO_WAVEGEN_SWEEP_START:
+		return snprintf(buf, len, "%"PRIu32, desc->sweep.start);
+	case IIO_WAVEGEN_SWEEP_STOP:
+		return snprintf(buf, len, "%"PRIu32, desc->sweep.stop);
+	case IIO_WAVEGEN_SWEEP_TIME:
+		return snprintf(buf, len, "%"PRIu32, desc->sweep.time_us);
+	default:
+		return -EINVAL;
+	}
+}
+
+static int iio_wavegen_attr_set(void *device, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct iio_wavegen_desc *desc = device;
+	int32_t val, val2;
+	uint32_t w;
+	int ret;
+
+	switch (priv) {
+	case IIO_WAVEGEN_FREQ:
+		w = no_os_str_to_uint32(buf);
+		if (w >= desc->sample_rate / 2)
+			return -EINVAL;
+		desc->tones[channel->ch_num].freq = w;
+		break;
+	case IIO_WAVEGEN_PHASE:
+		desc->tones[channel->ch_num].phase = no_os_str_to_uint32(buf) %
+						     IIO_WAVEGEN_TURN_MDEG;
+		break;
+	case IIO_WAVEGEN_SCALE:
+	case IIO_WAVEGEN_SWEEP_SCALE:
+		ret = iio_parse_value(buf, IIO_VAL_INT_PLUS_MICRO, &val, &val2);
+		if (ret)
+			return ret;
+		if (val < 0 || val2 < 0 || val > 1 || (val == 1 && val2))
+			return -EINVAL;
+		w = val * IIO_WAVEGEN_FULL_SCALE + val2;
+		if (priv == IIO_WAVEGEN_SCALE)
+			desc->tones[channel->ch_num].scale = w;
+		else
+			desc->sweep.scale = w;
+		break;
+	case IIO_WAVEGEN_SAMPLE_RATE:
+		w = no_os_str_to_uint32(buf);
+		if (!w)
+			return -EINVAL;
+		desc->sample_rate = w;
+		break;
+	case IIO_WAVEGEN_WAVEFORM:
+		for (w = 0; w < NO_OS_ARRAY_SIZE(iio_wavegen_waveforms); w++)
+			if (!strncmp(buf, iio_wavegen_waveforms[w],
+				     strlen(iio_wavegen_waveforms[w])))
+				break;
+		if (w == NO_OS_ARRAY_SIZE(iio_wavegen_waveforms))
+			return -EINVAL;
+		desc->mode = w;
+		break;
+	case IIO_WAVEGEN_SWEEP_START:
+	case IIO_WAVEGEN_SWEEP_STOP:
+		w = no_os_str_to_uint32(buf);
+		if (w >= desc->sample_rate / 2)
+			return -EINVAL;
+		if (priv == IIO_WAVEGEN_SWEEP_START)
+			desc->sweep.start = w;
+		else
+			desc->sweep.stop = w;
+		break;
+	case IIO_WAVEGEN_SWEEP_TIME:
+		desc->sweep.time_us = no_os_str_to_uint32(buf);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	ret = iio_wavegen_apply(desc);
+	if (ret)
+		return ret;
+
+	return len;
+}
+
+static struct iio_attribute iio_wavegen_ch_attrs[] = {
+	{
+		.name = "frequency",
+		.priv = IIO_WAVEGEN_FREQ,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "phase",
+		.priv = IIO_WAVEGEN_PHASE,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "scale",
+		.priv = IIO_WAVEGEN_SCALE,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute iio_wavegen_attrs[] = {
+	{
+		.name = "sampling_frequency",
+		.priv = IIO_WAVEGEN_SAMPLE_RATE,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "waveform",
+		.priv = IIO_WAVEGEN_WAVEFORM,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "waveform_available",
+		.priv = IIO_WAVEGEN_WAVEFORM_AVAIL,
+		.show = iio_wavegen_attr_get,
+	},
+	{
+		.name = "sweep_start_frequency",
+		.priv = IIO_WAVEGEN_SWEEP_START,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "sweep_stop_frequency",
+		.priv = IIO_WAVEGEN_SWEEP_STOP,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "sweep_time_us",
+		.priv = IIO_WAVEGEN_SWEEP_TIME,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	{
+		.name = "sweep_scale",
+		.priv = IIO_WAVEGEN_SWEEP_SCALE,
+		.show = iio_wavegen_attr_get,
+		.store = iio_wavegen_attr_set,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/**
+ * @brief Initialize a waveform generator device.
+ * The device has an output channel per tone, with frequency, phase and scale
+ * attributes, and device attributes selecting the waveform and setting up
+ * the sweep. The application plays the waveform from the update callback,
+ * called once here and after each attribute change, e.g. by filling a cyclic
+ * DAC buffer with no_os_wavegen_fill().
+ * @param desc - The waveform generator device descriptor.
+ * @param init_param - The waveform generator device initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_wavegen_init(struct iio_wavegen_desc **desc,
+		     struct iio_wavegen_init_param *init_param)
+{
+	struct no_os_wavegen_config config = { 0 };
+	struct iio_wavegen_desc *d;
+	uint32_t t;
+	int ret;
+
+	if (!desc || !init_param || !init_param->sample_rate)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	ret = no_os_wavegen_init(&d->wg, &config);
+	if (ret)
+		goto error;
+
+	d->sample_rate = init_param->sample_rate;
+	d->cyclic_samples = init_param->cyclic_samples;
+	d->mode = init_param->mode;
+	memcpy(d->tones, init_param->tones, sizeof(d->tones));
+	d->sweep = init_param->sweep;
+	d->shift = init_param->shift;
+	d->offset_binary = init_param->offset_binary;
+	d->update = init_param->update;
+	d->ctx = init_param->ctx;
+
+	for (t = 0; t < NO_OS_WAVEGEN_MAX_TONES; t++) {
+		d->channels[t].ch_type = IIO_ALTVOLTAGE;
+		d->channels[t].channel = t;
+		d->channels[t].attributes = iio_wavegen_ch_attrs;
+		d->channels[t].ch_out = true;
+		d->channels[t].indexed = true;
+	}
+
+	d->iio_dev.num_ch = NO_OS_WAVEGEN_MAX_TONES;
+	d->iio_dev.channels = d->channels;
+	d->iio_dev.attributes = iio_wavegen_attrs;
+
+	ret = iio_wavegen_apply(d);
+	if (ret)
+		goto error;
+
+	*desc = d;
+
+	return 0;
+
+error:
+	iio_wavegen_remove(d);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by iio_wavegen_init().
+ * @param desc - The waveform generator device descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_wavegen_remove(struct iio_wavegen_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->wg)
+		no_os_wavegen_remove(desc->wg);
+	no_os_free(desc);
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/***************************************************************************//**
+ *   @file   iio_wavegen.h
+ *   @brief  Header file of the IIO waveform generator device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_WAVEGEN_H_
+#define IIO_WAVEGEN_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "iio_types.h"
+#include "no_os_wavegen.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct iio_wavegen_tone
+ * @brief Settings of one tone, exposed as an output channel
+ */
+struct iio_wavegen_tone {
+	/** Frequency in Hz */
+	uint32_t freq;
+	/** Phase in millidegrees */
+	uint32_t phase;
+	/** Amplitude in millionths of the full scale, 0 when the tone is off */
+	uint32_t scale;
+};
+
+/**
+ * @struct iio_wavegen_sweep
+ * @brief Settings of the linear frequency sweep
+ */
+struct iio_wavegen_sweep {
+	/** Start frequency in Hz */
+	uint32_t start;
+	/** Stop frequency in Hz */
+	uint32_t stop;
+	/** Duration of a sweep in microseconds */
+	uint32_t time_us;
+	/** Amplitude in millionths of the full scale */
+	uint32_t scale;
+};
+
+/**
+ * @struct iio_wavegen_init_param
+ * @brief IIO waveform generator device initialization structure
+ */
+struct iio_wavegen_init_param {
+	/** Rate of the DAC samples */
+	uint32_t sample_rate;
+	/**
+	 * Length of the cyclic buffer the waveform is played from, the tones
+	 * are then moved to a whole number of periods in it. 0 when the
+	 * waveform is streamed.
+	 */
+	uint32_t cyclic_samples;
+	/** Initial waveform */
+	enum no_os_wavegen_mode mode;
+	/** Initial tones */
+	struct iio_wavegen_tone tones[NO_OS_WAVEGEN_MAX_TONES];
+	/** Initial sweep */
+	struct iio_wavegen_sweep sweep;
+	/** Sample format, see struct no_os_wavegen_config */
+	unsigned int shift;
+	bool offset_binary;
+	/** Called after each change of the waveform, e.g. to refill the buffer */
+	int (*update)(void *ctx, struct no_os_wavegen *wg);
+	/** First parameter of update */
+	void *ctx;
+};
+
+/**
+ * @struct iio_wavegen_desc
+ * @brief IIO waveform generator device descriptor
+ */
+struct iio_wavegen_desc {
+	/** Generator filling the DAC buffers */
+	struct no_os_wavegen *wg;
+	/** Rate of the DAC samples */
+	uint32_t sample_rate;
+	/** Length of the cyclic buffer, 0 when streamed */
+	uint32_t cyclic_samples;
+	/** Waveform */
+	enum no_os_wavegen_mode mode;
+	/** Tones */
+	struct iio_wavegen_tone tones[NO_OS_WAVEGEN_MAX_TONES];
+	/** Sweep */
+	struct iio_wavegen_sweep sweep;
+	/** Sample format */
+	unsigned int shift;
+	bool offset_binary;
+	/** Called after each change of the waveform */
+	int (*update)(void *ctx, struct no_os_wavegen *wg);
+	/** First parameter of update */
+	void *ctx;
+	/** Channels of the IIO device, one per tone */
+	struct iio_channel channels[NO_OS_WAVEGEN_MAX_TONES];
+	/** IIO device to register with iio_init() */
+	struct iio_device iio_dev;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/** Initialize a waveform generator device */
+int iio_wavegen_init(struct iio_wavegen_desc **desc,
+		     struct iio_wavegen_init_param *init_param);
+/** Free the resources allocated by iio_wavegen_init() */
+int iio_wavegen_remove(struct iio_wavegen_desc *desc);
+
+#endif /* IIO_WAVEGEN_H_ */
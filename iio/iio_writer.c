@@ -0,0 +1,159 @@
+/***************************************************************************//**
+ *   @file   iio_writer.c
+ *   @brief  Chunked writer for IIO attribute values and the xml.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "iio_writer.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/* Offset in the value following the last byte of the chunk */
+static inline uint32_t iio_writer_end(const struct iio_writer *w)
+{
+	return w->skip + (w->buf && w->len ? w->len - 1 : 0);
+}
+
+/**
+ * @brief Start the generation of a chunk of a value.
+ * @param w - Writer.
+ * @param buf - Destination of the chunk, NULL to only count the bytes of the
+ * value.
+ * @param len - Size of buf. The chunk has up to len - 1 bytes, the last byte
+ * is used by the terminator of the formatted text.
+ * @param skip - Offset in the value of the first byte of the chunk.
+ */
+void iio_writer_init(struct iio_writer *w, char *buf, uint32_t len,
+		     uint32_t skip)
+{
+	w->buf = buf;
+	w->len = len;
+	w->skip = skip;
+	w->pos = 0;
+	w->err = 0;
+}
+
+/**
+ * @brief Append bytes to the value, those in the chunk are stored.
+ * @param w - Writer.
+ * @param data - Bytes to append.
+ * @param len - Number of bytes.
+ * @return 0 in case of success.
+ */
+int iio_writer_write(struct iio_writer *w, const char *data, uint32_t len)
+{
+	uint32_t lo, hi;
+
+	lo = no_os_max(w->pos, w->skip);
+	hi = no_os_min(w->pos + len, iio_writer_end(w));
+	if (lo < hi)
+		memcpy(w->buf + lo - w->skip, data + lo - w->pos, hi - lo);
+	w->pos += len;
+
+	return 0;
+}
+
+/**
+ * @brief Append formatted text to the value, the part in the chunk is stored.
+ * Text starting before the chunk is formatted at the start of the chunk
+ * buffer and moved, so it must be shorter than the buffer. Longer strings
+ * can be appended with iio_writer_write().
+ * @param w - Writer.
+ * @param fmt - Format, as for printf.
+ * @return 0 in case of success or the first error of the writer otherwise.
+ */
+int iio_writer_printf(struct iio_writer *w, const char *fmt, ...)
+{
+	uint32_t end = iio_writer_end(w);
+	va_list args;
+	int n;
+
+	va_start(args, fmt);
+	n = vsnprintf(NULL, 0, fmt, args);
+	va_end(args);
+	if (n < 0) {
+		if (!w->err)
+			w->err = -EINVAL;
+		return -EINVAL;
+	}
+
+	if (w->pos + n <= w->skip || w->pos >= end) {
+		/* Not in the chunk, only counted */
+		w->pos += n;
+		return 0;
+	}
+
+	va_start(args, fmt);
+	if (w->pos >= w->skip) {
+		/* Truncated at the end of the chunk, on the spare byte */
+		vsnprintf(w->buf + w->pos - w->skip, end - w->pos + 1, fmt,
+			  args);
+	} else if ((uint32_t)n < w->len) {
+		vsnprintf(w->buf, w->len, fmt, args);
+		memmove(w->buf, w->buf + w->skip - w->pos,
+			no_os_min(w->pos + n, end) - w->skip);
+	} else if (!w->err) {
+		w->err = -E2BIG;
+	}
+	va_end(args);
+
+	/* The following text is still placed right on error */
+	w->pos += n;
+
+	return w->err;
+}
+
+/**
+ * @brief Get the size of the chunk.
+ * @param w - Writer.
+ * @return Number of bytes of the value stored in the chunk buffer.
+ */
+uint32_t iio_writer_chunk(const struct iio_writer *w)
+{
+	if (w->pos <= w->skip)
+		return 0;
+
+	return no_os_min(w->pos, iio_writer_end(w)) - w->skip;
+}
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ *   @file   iio_writer.h
+ *   @brief  Header file of the chunked writer for IIO attribute values.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_WRITER_H_
+#define IIO_WRITER_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct iio_writer
+ * @brief Output of a value generated in chunks. The whole value is generated
+ * on every call, only the bytes of the current chunk are stored, so no buffer
+ * of the size of the value is needed. The generated value must be the same
+ * across the calls made for its chunks.
+ */
+struct iio_writer {
+	/** Destination of the chunk, NULL to only count the bytes */
+	char *buf;
+	/** Size of buf, up to len - 1 bytes of the value are stored */
+	uint32_t len;
+	/** Offset in the value of the first byte of the chunk */
+	uint32_t skip;
+	/** Bytes of the value generated so far */
+	uint32_t pos;
+	/** First error, the chunk is not valid if set */
+	int err;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Start a chunk of len - 1 bytes at offset skip of the value. */
+void iio_writer_init(struct iio_writer *w, char *buf, uint32_t len,
+		     uint32_t skip);
+
+/* Append len bytes to the value. */
+int iio_writer_write(struct iio_writer *w, const char *data, uint32_t len);
+
+/* Append formatted text, shorter than the chunk buffer, to the value. */
+int iio_writer_printf(struct iio_writer *w, const char *fmt, ...);
+
+/* Number of bytes of the value stored in the chunk. */
+uint32_t iio_writer_chunk(const struct iio_writer *w);
+
+#endif /* IIO_WRITER_H_ */
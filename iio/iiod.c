@@ -75,7 +75,9 @@ static struct iiod_str cmds[] = {
 	[IIOD_CMD_WRITEBUF]	= IIOD_STR("WRITEBUF"),
 	[IIOD_CMD_GETTRIG]	= IIOD_STR("GETTRIG"),
 	[IIOD_CMD_SETTRIG]	= IIOD_STR("SETTRIG"),
-	[IIOD_CMD_SET]		= IIOD_STR("SET")
+	[IIOD_CMD_SET]		= IIOD_STR("SET"),
+	[IIOD_CMD_BINARY]	= IIOD_STR("BINARY"),
+	[IIOD_CMD_STREAM]	= IIOD_STR("STREAM")
 };
 static const uint32_t priority_array[] = {
 	/* Order not tested, just personal expectation. Function can
@@ -93,7 +95,9 @@ static const uint32_t priority_array[] = {
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
 	IIOD_CMD_HELP,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY,
+	IIOD_CMD_STREAM
 };
 
 static_assert(NO_OS_ARRAY_SIZE(cmds) == NO_OS_ARRAY_SIZE(priority_array),
@@ -179,6 +183,40 @@ static int32_t iiod_parse_set(const char *token, struct comand_desc *res,
 	return parse_num(token, &res->count, 10);
 }
 
+/* STREAM <device> <address> <port> [<bytes>] or STREAM <device> STOP */
+static int32_t iiod_parse_stream(const char *token, struct comand_desc *res,
+				 char **ctx)
+{
+	int32_t ret;
+
+	if (!token)
+		return -EINVAL;
+
+	memset(res->address, 0, sizeof(res->address));
+	res->port = 0;
+	res->bytes_count = 0;
+	if (strcmp(token, "STOP") == 0)
+		return 0;
+
+	if (strlen(token) >= sizeof(res->address))
+		return -EINVAL;
+	strcpy(res->address, token);
+
+	token = strtok_r(NULL, delim, ctx);
+	if (!token)
+		return -EINVAL;
+
+	ret = parse_num(token, &res->port, 10);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	token = strtok_r(NULL, delim, ctx);
+	if (token)
+		return parse_num(token, &res->bytes_count, 10);
+
+	return 0;
+}
+
 static int32_t iiod_parse_rw_attr(const char *token, struct comand_desc *res,
 				  char **ctx)
 {
@@ -246,6 +284,7 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	case IIOD_CMD_EXIT:
 	case IIOD_CMD_PRINT:
 	case IIOD_CMD_VERSION:
+	case IIOD_CMD_BINARY:
 		return 0;
 	case IIOD_CMD_TIMEOUT:
 		return parse_num(token, &res->timeout, 10);
@@ -276,6 +315,106 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 		return 0;
 	case IIOD_CMD_SET:
 		return iiod_parse_set(token, res, ctx);
+	case IIOD_CMD_STREAM:
+		return iiod_parse_stream(token, res, ctx);
+	default:
+		break;
+	}
+
+	return -EINVAL;
+}
+
+/* Copy src in dst. Fails if src doesn't fit in dst */
+static int32_t iiod_copy_str(char *dst, const char *src, uint32_t size)
+{
+	uint32_t len = strlen(src);
+
+	if (len >= size)
+		return -EINVAL;
+
+	memcpy(dst, src, len + 1);
+
+	return 0;
+}
+
+/* Fill res from a binary request. No I/O */
+static int32_t iiod_parse_bin(struct iiod_bin_hdr *hdr, char *buf,
+			      struct comand_desc *res)
+{
+	const char *strs[3] = {"", "", ""};
+	char *end = buf + hdr->len;
+	uint32_t i;
+	int32_t ret;
+
+	if (hdr->op >= NO_OS_ARRAY_SIZE(cmds))
+		return -EINVAL;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(strs) && buf < end; i++) {
+		strs[i] = buf;
+		buf += strnlen(buf, end - buf) + 1;
+	}
+
+	res->cmd = hdr->op;
+	switch (res->cmd) {
+	case IIOD_CMD_HELP:
+	case IIOD_CMD_EXIT:
+	case IIOD_CMD_PRINT:
+	case IIOD_CMD_VERSION:
+	case IIOD_CMD_BINARY:
+		return 0;
+	case IIOD_CMD_TIMEOUT:
+		res->timeout = hdr->code;
+		return 0;
+	default:
+		break;
+	}
+
+	if (!strs[0][0])
+		return -EINVAL;
+
+	ret = iiod_copy_str(res->device, strs[0], sizeof(res->device));
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	switch (res->cmd) {
+	case IIOD_CMD_CLOSE:
+	case IIOD_CMD_GETTRIG:
+		return 0;
+	case IIOD_CMD_OPEN:
+		res->sample_count = hdr->code;
+		res->mask = hdr->arg;
+		res->cyclic = !!(hdr->flags & IIOD_BIN_FLAG_CYCLIC);
+		return 0;
+	case IIOD_CMD_READ:
+	case IIOD_CMD_WRITE:
+		if (hdr->flags > IIO_ATTR_TYPE_DEVICE)
+			return -EINVAL;
+		res->type = hdr->flags;
+		if ((res->type == IIO_ATTR_TYPE_CH_IN ||
+		     res->type == IIO_ATTR_TYPE_CH_OUT) && !strs[1][0])
+			return -EINVAL;
+		ret = iiod_copy_str(res->channel, strs[1],
+				    sizeof(res->channel));
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		res->bytes_count = hdr->arg;
+
+		return iiod_copy_str(res->attr, strs[2], sizeof(res->attr));
+	case IIOD_CMD_READBUF:
+	case IIOD_CMD_WRITEBUF:
+		res->bytes_count = hdr->arg;
+		return 0;
+	case IIOD_CMD_SETTRIG:
+		return iiod_copy_str(res->trigger, strs[1],
+				     sizeof(res->trigger));
+	case IIOD_CMD_SET:
+		res->count = hdr->arg;
+		return 0;
+	case IIOD_CMD_STREAM:
+		res->port = hdr->code;
+		res->bytes_count = hdr->arg;
+		return iiod_copy_str(res->address, strs[1],
+				     sizeof(res->address));
 	default:
 		break;
 	}
@@ -317,6 +456,12 @@ static int dummy_set_timeout(struct iiod_ctx *ctx, uint32_t timeout)
 	return -EINVAL;
 }
 
+static int dummy_stream(struct iiod_ctx *ctx, const char *device,
+			const char *address, uint16_t port, uint32_t bytes)
+{
+	return -ENOSYS;
+}
+
 static int dummy_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 				   uint32_t buffers_count)
 {
@@ -346,6 +491,31 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 					       dummy_close);
 	ops->push_buffer = SET_DUMMY_IF_NULL(new_ops->push_buffer,
 					     dummy_close);
+	ops->stream = SET_DUMMY_IF_NULL(new_ops->stream, dummy_stream);
+	ops->get_xml = new_ops->get_xml;
+	ops->read_xml = new_ops->read_xml;
+	/* Zero copy is used only when both ops are provided */
+	if (new_ops->get_read_block && new_ops->read_block_done) {
+		ops->get_read_block = new_ops->get_read_block;
+		ops->read_block_done = new_ops->read_block_done;
+	} else {
+		ops->get_read_block = NULL;
+		ops->read_block_done = NULL;
+	}
+	if (new_ops->get_write_block && new_ops->write_block_done) {
+		ops->get_write_block = new_ops->get_write_block;
+		ops->write_block_done = new_ops->write_block_done;
+	} else {
+		ops->get_write_block = NULL;
+		ops->write_block_done = NULL;
+	}
+	if (new_ops->recv_nocopy && new_ops->recv_release) {
+		ops->recv_nocopy = new_ops->recv_nocopy;
+		ops->recv_release = new_ops->recv_release;
+	} else {
+		ops->recv_nocopy = NULL;
+		ops->recv_release = NULL;
+	}
 
 	return 0;
 }
@@ -388,6 +558,7 @@ static void conn_clean_state(struct iiod_conn_priv *conn)
 	memset(&conn->cmd_data, 0, sizeof(conn->cmd_data));
 	memset(&conn->res, 0, sizeof(conn->res));
 	memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+	memset(&conn->bin_rx, 0, sizeof(conn->bin_rx));
 
 	conn->res.buf.buf = NULL;
 	conn->res.buf.idx = 0;
@@ -411,12 +582,13 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 			conn->used = 1;
 			conn->conn = data->conn;
 			/*
-			 * TODO in future:
-			 * think of using other buffer (e.g. ciruclar_buffer)
-			 * to somehow implement zero copy
+			 * Buffer data is sent directly from the device buffer
+			 * when get_read_block is provided. Otherwise it is
+			 * copied here first.
 			 */
 			conn->payload_buf = data->buf;
 			conn->payload_buf_len = data->len;
+			conn->out.buf = conn->out_buf;
 			*new_conn_id = i;
 
 			return 0;
@@ -459,6 +631,13 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 					strlen(data->trigger));
 	case IIOD_CMD_SET:
 		return ops->set_buffers_count(ctx, data->device, data->count);
+	case IIOD_CMD_STREAM:
+		if (data->port > UINT16_MAX)
+			return -EINVAL;
+
+		return ops->stream(ctx, data->device,
+				   data->address[0] ? data->address : NULL,
+				   data->port, data->bytes_count);
 	default:
 		break;
 	}
@@ -466,10 +645,65 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 	return -EINVAL;
 }
 
+/*
+ * Send the replies stored in the output buffer of the connection.
+ * Returns -EAGAIN if not all the data could be sent.
+ */
+static int32_t iiod_flush(struct iiod_desc *desc, struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret;
+
+	if (conn->out.idx < conn->out.len) {
+		ret = desc->ops.send(&ctx, (uint8_t *)conn->out.buf + conn->out.idx,
+				     conn->out.len - conn->out.idx);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		conn->out.idx += ret;
+		if (conn->out.idx < conn->out.len)
+			return -EAGAIN;
+	}
+
+	conn->out.idx = 0;
+	conn->out.len = 0;
+
+	return 0;
+}
+
+/*
+ * Send data through the output buffer of the connection, so that the
+ * fragments of a reply go out in a single send. Data that does not fit in the
+ * buffer is sent directly after flushing it.
+ * Returns the number of bytes accepted or a negative error code.
+ */
+static int32_t iiod_send(struct iiod_desc *desc, struct iiod_conn_priv *conn,
+			 uint8_t *buf, uint32_t len)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret;
+
+	if (conn->out.len + len > IIOD_OUT_BUF_SIZE) {
+		ret = iiod_flush(desc, conn);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (len >= IIOD_OUT_BUF_SIZE)
+			return desc->ops.send(&ctx, buf, len);
+	}
+
+	memcpy(conn->out.buf + conn->out.len, buf, len);
+	conn->out.len += len;
+
+	return len;
+}
+
 /*
  * Unload data from buf without blocking.
  * When done will return 0, if there is still data to be sent it will return
  * -EAGIAN. On error, an negative error code is returned
+ * With IIOD_ENDL, idx is incremented past len once the '\n' is sent, so a
+ * '\n' that couldn't be sent is sent by the next call.
  */
 static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 			    struct iiod_buff *buf, uint8_t flags)
@@ -479,11 +713,11 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 	int32_t ret;
 	int32_t len;
 
-	len = buf->len - buf->idx;
-	if (len) {
+	if (buf->idx < buf->len) {
+		len = buf->len - buf->idx;
 		tmp_buf = (uint8_t *)buf->buf + buf->idx;
 		if (flags & IIOD_WR)
-			ret = desc->ops.send(&ctx, tmp_buf, len);
+			ret = iiod_send(desc, conn, tmp_buf, len);
 		else
 			ret = desc->ops.recv(&ctx, tmp_buf, len);
 		if (NO_OS_IS_ERR_VALUE(ret))
@@ -494,13 +728,15 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 			return -EAGAIN;
 	}
 
-	if (flags & IIOD_ENDL) {
-		ret = desc->ops.send(&ctx, (uint8_t *)"\n", 1);
+	if ((flags & IIOD_ENDL) && buf->idx == buf->len) {
+		ret = iiod_send(desc, conn, (uint8_t *)"\n", 1);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
 		if (ret != 1)
 			return -EAGAIN;
+
+		buf->idx++;
 	}
 
 	return 0;
@@ -512,12 +748,20 @@ static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 	int32_t ret, len;
 
 	if (conn->nb_buf.len == 0) {
-		conn->nb_buf.buf = conn->payload_buf;
-		len = no_os_min(conn->payload_buf_len,
-				conn->cmd_data.bytes_count);
-		/* Read from dev */
-		ret = desc->ops.read_buffer(&ctx, conn->cmd_data.device,
-					    conn->nb_buf.buf, len);
+		if (desc->ops.get_read_block) {
+			/* Send directly from the device buffer */
+			ret = desc->ops.get_read_block(&ctx,
+						       conn->cmd_data.device,
+						       &conn->nb_buf.buf,
+						       conn->cmd_data.bytes_count);
+		} else {
+			conn->nb_buf.buf = conn->payload_buf;
+			len = no_os_min(conn->payload_buf_len,
+					conn->cmd_data.bytes_count);
+			/* Read from dev */
+			ret = desc->ops.read_buffer(&ctx, conn->cmd_data.device,
+						    conn->nb_buf.buf, len);
+		}
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 		len = ret;
@@ -530,6 +774,13 @@ static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
+		if (desc->ops.read_block_done) {
+			ret = desc->ops.read_block_done(&ctx,
+							conn->cmd_data.device);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+
 		conn->cmd_data.bytes_count -= conn->nb_buf.len;
 		conn->nb_buf.len = 0;
 		if (conn->cmd_data.bytes_count)
@@ -539,12 +790,95 @@ static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 	return 0;
 }
 
+/*
+ * Write the data of WRITEBUF to the device straight from the buffers of the
+ * connection. Return -ENOSYS if the connection doesn't support it.
+ */
+static int32_t do_write_buff_nocopy(struct iiod_desc *desc,
+				    struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	const uint8_t *data;
+	int32_t ret, len;
+
+	ret = desc->ops.recv_nocopy(&ctx, &data, conn->cmd_data.bytes_count);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	if (!ret)
+		return -EAGAIN;
+
+	ret = desc->ops.write_buffer(&ctx, conn->cmd_data.device,
+				     (const char *)data, ret);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	/* Device buffer full, keep the rest in the connection */
+	if (!ret)
+		return -EAGAIN;
+
+	len = ret;
+	ret = desc->ops.recv_release(&ctx, len);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	conn->cmd_data.bytes_count -= len;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
+
+	return 0;
+}
+
+/*
+ * Receive the data of WRITEBUF directly in the device buffer, without going
+ * through the connection buffer.
+ */
+static int32_t do_write_buff_direct(struct iiod_desc *desc,
+				    struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret, len;
+	char *block;
+
+	ret = desc->ops.get_write_block(&ctx, conn->cmd_data.device, &block,
+					conn->cmd_data.bytes_count);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	/* Device buffer full */
+	if (!ret)
+		return -EAGAIN;
+
+	len = desc->ops.recv(&ctx, (uint8_t *)block, ret);
+	if (len == -EAGAIN)
+		len = 0;
+
+	ret = desc->ops.write_block_done(&ctx, conn->cmd_data.device,
+					 NO_OS_IS_ERR_VALUE(len) ? 0 : len);
+	if (NO_OS_IS_ERR_VALUE(len))
+		return len;
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	conn->cmd_data.bytes_count -= len;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
+
+	return 0;
+}
+
 static int32_t do_write_buff(struct iiod_desc *desc,
 			     struct iiod_conn_priv *conn)
 {
 	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
 	int32_t ret, len;
 
+	if (conn->nb_buf.len == 0 && desc->ops.recv_nocopy) {
+		ret = do_write_buff_nocopy(desc, conn);
+		if (ret != -ENOSYS)
+			return ret;
+	}
+
+	if (conn->nb_buf.len == 0 && desc->ops.get_write_block)
+		return do_write_buff_direct(desc, conn);
+
 	if (conn->nb_buf.len == 0) {
 		conn->nb_buf.buf = conn->payload_buf;
 		len = no_os_min(conn->payload_buf_len,
@@ -591,6 +925,7 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	case IIOD_CMD_CLOSE:
 	case IIOD_CMD_SETTRIG:
 	case IIOD_CMD_SET:
+	case IIOD_CMD_STREAM:
 		if (data->cmd == IIOD_CMD_OPEN) {
 			conn->mask = data->mask;
 			if (data->cyclic)
@@ -607,7 +942,35 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		conn->res.write_val = 1;
 
 		return -ENOTCONN;
+	case IIOD_CMD_BINARY:
+		/* Switch takes place after the response is sent */
+		conn->res.val = conn->binary ? -EINVAL : 0;
+		conn->res.write_val = 1;
+		break;
 	case IIOD_CMD_PRINT:
+		if (desc->ops.read_xml) {
+			ret = desc->ops.read_xml(&ctx, conn->payload_buf,
+						 conn->payload_buf_len, 0,
+						 &conn->res.size);
+			conn->res.write_val = 1;
+			if (NO_OS_IS_ERR_VALUE(ret)) {
+				conn->res.val = ret;
+				break;
+			}
+			conn->res.val = conn->res.size;
+			conn->res.buf.buf = conn->payload_buf;
+			conn->res.buf.len = ret;
+			break;
+		}
+		if (desc->ops.get_xml) {
+			ret = desc->ops.get_xml(&ctx, &desc->xml,
+						&desc->xml_len);
+			if (NO_OS_IS_ERR_VALUE(ret)) {
+				conn->res.val = ret;
+				conn->res.write_val = 1;
+				break;
+			}
+		}
 		conn->res.val = desc->xml_len;
 		conn->res.write_val = 1;
 		conn->res.buf.buf = desc->xml;
@@ -616,6 +979,9 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	case IIOD_CMD_VERSION:
 		conn->res.buf.buf = IIOD_VERSION;
 		conn->res.buf.len = IIOD_VERSION_LEN;
+		/* Binary responses always start with a header */
+		conn->res.val = IIOD_VERSION_LEN;
+		conn->res.write_val = conn->binary;
 		break;
 	case IIOD_CMD_READ:
 	case IIOD_CMD_GETTRIG:
@@ -632,6 +998,11 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		if (!NO_OS_IS_ERR_VALUE(ret)) {
 			conn->res.buf.buf = conn->payload_buf;
 			conn->res.buf.len = ret;
+			if (attr.size > (uint32_t)ret) {
+				/* The rest is read while it is sent */
+				conn->res.size = attr.size;
+				conn->res.val = attr.size;
+			}
 		}
 		break;
 	case IIOD_CMD_WRITE:
@@ -651,6 +1022,9 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			break;
 		}
 		conn->res.val = data->bytes_count;
+		/* Binary responses have the mask in the header */
+		if (conn->binary)
+			break;
 		ret = snprintf(conn->buf_mask, 10, "%08"PRIx32, conn->mask);
 		conn->res.buf.buf = conn->buf_mask;
 		conn->res.buf.len = ret;
@@ -666,16 +1040,117 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	return 0;
 }
 
+/*
+ * Read the chunk following the one sent from payload_buf, for a value larger
+ * than payload_buf. The size announced with the first chunk is kept: if the
+ * value got shorter meanwhile, it is padded with '\0' bytes.
+ */
+static int32_t iiod_next_chunk(struct iiod_desc *desc,
+			       struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct comand_desc *data = &conn->cmd_data;
+	struct iiod_attr attr = {
+		.type = data->type,
+		.name = data->attr,
+		.channel = data->channel
+	};
+	uint32_t size, len;
+	int32_t ret;
+
+	conn->res.offset += conn->res.buf.len;
+	attr.offset = conn->res.offset;
+	if (data->cmd == IIOD_CMD_PRINT)
+		ret = desc->ops.read_xml(&ctx, conn->payload_buf,
+					 conn->payload_buf_len,
+					 conn->res.offset, &size);
+	else
+		ret = desc->ops.read_attr(&ctx, data->device, &attr,
+					  conn->payload_buf,
+					  conn->payload_buf_len);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	len = no_os_min(conn->res.size - conn->res.offset,
+			conn->payload_buf_len - 1);
+	if ((uint32_t)ret < len)
+		memset(conn->payload_buf + ret, 0, len - ret);
+
+	conn->res.buf.len = len;
+	conn->res.buf.idx = 0;
+
+	return 0;
+}
+
+/*
+ * Receive a line from the bytes the connection already holds, scanned in place
+ * instead of with a recv call per byte. The bytes following the line are left
+ * in the connection for the next state, e.g. the value of a WRITE command.
+ * Returns -ENOSYS if the connection doesn't support recv_nocopy.
+ */
+static int32_t iiod_read_line_nocopy(struct iiod_desc *desc,
+				     struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	const uint8_t *data;
+	int32_t ret, len, i;
+
+	while (conn->parser_idx < IIOD_PARSER_MAX_BUF_SIZE - 1) {
+		ret = desc->ops.recv_nocopy(&ctx, &data,
+					    IIOD_PARSER_MAX_BUF_SIZE - 1 -
+					    conn->parser_idx);
+		if (ret == -EAGAIN || ret == 0)
+			return -EAGAIN;
+		if (ret == -ENOSYS)
+			return ret;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto end;
+
+		len = ret;
+		for (i = 0; i < len; i++) {
+			if (conn->parser_idx == 0 &&
+			    (data[i] == '\n' || data[i] == '\r'))
+				continue;
+
+			conn->parser_buf[conn->parser_idx++] = data[i];
+			if (data[i] == '\n') {
+				i++;
+				break;
+			}
+		}
+
+		ret = desc->ops.recv_release(&ctx, i);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto end;
+
+		if (conn->parser_idx &&
+		    conn->parser_buf[conn->parser_idx - 1] == '\n') {
+			conn->parser_buf[conn->parser_idx] = '\0';
+			ret = 0;
+			goto end;
+		}
+	}
+
+	ret = -EIO;
+end:
+	conn->parser_idx = 0;
+	return ret;
+}
+
 static int32_t iiod_read_line(struct iiod_desc *desc,
 			      struct iiod_conn_priv *conn)
 {
-	struct iiod_ctx ctx = {
-		.instance = desc->app_instance,
-		.conn = conn->conn
-	};
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
 	int32_t ret;
 	char *ch;
 
+	if (desc->ops.recv_nocopy) {
+		ret = iiod_read_line_nocopy(desc, conn);
+		if (ret != -ENOSYS)
+			return ret;
+	}
+
+	/* Blocking links like UART can't be asked for more than a byte */
 	while (conn->parser_idx < IIOD_PARSER_MAX_BUF_SIZE - 1) {
 		ch = conn->parser_buf + conn->parser_idx;
 		ret = desc->ops.recv(&ctx,(uint8_t *)ch, 1);
@@ -702,6 +1177,90 @@ end:
 	return ret;
 }
 
+/*
+ * Receive a binary request header and the strings following it without
+ * blocking. Returns 0 when the whole request was received.
+ */
+static int32_t iiod_read_bin_cmd(struct iiod_desc *desc,
+				 struct iiod_conn_priv *conn)
+{
+	int32_t ret;
+
+	if (!conn->bin_rx.buf) {
+		conn->bin_rx.buf = (char *)&conn->bin_hdr;
+		conn->bin_rx.len = sizeof(conn->bin_hdr);
+		conn->bin_rx.idx = 0;
+	}
+
+	ret = rw_iiod_buff(desc, conn, &conn->bin_rx, IIOD_RD);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (conn->bin_rx.buf == (char *)&conn->bin_hdr) {
+		if (conn->bin_hdr.len >= IIOD_PARSER_MAX_BUF_SIZE) {
+			conn->bin_rx.buf = NULL;
+			return -EIO;
+		}
+
+		conn->bin_rx.buf = conn->parser_buf;
+		conn->bin_rx.len = conn->bin_hdr.len;
+		conn->bin_rx.idx = 0;
+		ret = rw_iiod_buff(desc, conn, &conn->bin_rx, IIOD_RD);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	conn->parser_buf[conn->bin_hdr.len] = '\0';
+	conn->bin_rx.buf = NULL;
+
+	return 0;
+}
+
+/* Receive a command in the protocol used by the connection. I/O Calls */
+static int32_t iiod_recv_cmd(struct iiod_desc *desc,
+			     struct iiod_conn_priv *conn)
+{
+	if (conn->binary)
+		return iiod_read_bin_cmd(desc, conn);
+
+	return iiod_read_line(desc, conn);
+}
+
+/* Fill struct comand_desc with the received command. No I/O */
+static int32_t iiod_parse_cmd(struct iiod_conn_priv *conn)
+{
+	if (conn->binary)
+		return iiod_parse_bin(&conn->bin_hdr, conn->parser_buf,
+				      &conn->cmd_data);
+
+	return iiod_parse_line(conn->parser_buf, &conn->cmd_data,
+			       &conn->strtok_ctx);
+}
+
+/* Prepare the binary response header of the current command in nb_buf */
+static void iiod_fill_bin_resp(struct iiod_conn_priv *conn)
+{
+	struct iiod_bin_hdr *resp = &conn->bin_resp;
+
+	resp->client_id = conn->bin_hdr.client_id;
+	resp->op = IIOD_BIN_OP_RESPONSE;
+	resp->flags = 0;
+	resp->code = (int32_t)conn->res.val;
+	resp->arg = 0;
+	resp->len = conn->res.buf.buf ? conn->res.buf.len : 0;
+	if (conn->res.size)
+		resp->len = conn->res.size;
+	if (conn->cmd_data.cmd == IIOD_CMD_READBUF &&
+	    !NO_OS_IS_ERR_VALUE(resp->code)) {
+		/* Buffer data follows in IIOD_RW_BUF state */
+		resp->arg = conn->mask;
+		resp->len = conn->cmd_data.bytes_count;
+	}
+
+	conn->nb_buf.buf = (char *)resp;
+	conn->nb_buf.len = sizeof(*resp);
+}
+
 /*
  * Function will return SUCCESS when a state was processed.
  * If a state is still in processing state, it will return -EAGAIN.
@@ -711,22 +1270,23 @@ end:
 static int32_t iiod_run_state(struct iiod_desc *desc,
 			      struct iiod_conn_priv *conn)
 {
-	struct iiod_ctx ctx = {
-		.instance = desc->app_instance,
-		.conn = conn->conn
-	};
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
 	int32_t ret;
+	bool last;
 
 	switch (conn->state) {
 	case IIOD_READING_LINE:
-		/* Read input data until \n. I/O Calls */
-		ret = iiod_read_line(desc, conn);
+		/* Read input data until \n or a binary request. I/O Calls */
+		ret = iiod_recv_cmd(desc, conn);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
 		/* Fill struct comand_desc with data from line. No I/O */
-		ret = iiod_parse_line(conn->parser_buf, &conn->cmd_data,
-				      &conn->strtok_ctx);
+		ret = iiod_parse_cmd(conn);
+		if (!NO_OS_IS_ERR_VALUE(ret) &&
+		    conn->cmd_data.cmd == IIOD_CMD_WRITE &&
+		    conn->cmd_data.bytes_count >= conn->payload_buf_len)
+			ret = -EINVAL;
 		if (NO_OS_IS_ERR_VALUE(ret)) {
 			/* Parsing line failed */
 			conn->res.write_val = 1;
@@ -756,15 +1316,20 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		/* Write result or the length of data to be sent*/
 		if (conn->res.write_val) {
 			if (conn->nb_buf.len == 0) {
-				conn->nb_buf.buf = conn->parser_buf;
-				ret = sprintf(conn->nb_buf.buf, "%"PRIi32,
-					      conn->res.val);
-				conn->nb_buf.len = ret;
+				if (conn->binary)
+					iiod_fill_bin_resp(conn);
+				else {
+					conn->nb_buf.buf = conn->parser_buf;
+					ret = sprintf(conn->nb_buf.buf, "%"PRIi32,
+						      conn->res.val);
+					conn->nb_buf.len = ret;
+				}
 				conn->nb_buf.idx = 0;
 			}
 			/* Non-blocking. Will enter here until val is sent */
-			if (conn->nb_buf.idx < conn->nb_buf.len) {
+			if (conn->nb_buf.idx <= conn->nb_buf.len) {
 				ret = rw_iiod_buff(desc, conn, &conn->nb_buf,
+						   conn->binary ? IIOD_WR :
 						   IIOD_WR | IIOD_ENDL);
 				if (NO_OS_IS_ERR_VALUE(ret))
 					return ret;
@@ -772,13 +1337,23 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		}
 		/* Send buf from result. Non blocking */
 		if (conn->res.buf.buf &&
-		    conn->res.buf.idx < conn->res.buf.len) {
+		    conn->res.buf.idx <= conn->res.buf.len) {
+			last = conn->res.offset + conn->res.buf.len >=
+			       conn->res.size;
 			ret = rw_iiod_buff(desc, conn, &conn->res.buf,
+					   conn->binary || !last ? IIOD_WR :
 					   IIOD_WR | IIOD_ENDL);
 			if (NO_OS_IS_ERR_VALUE(ret))
 				return ret;
+
+			/* Chunk sent, the next one is sent on the next run */
+			if (!last)
+				return iiod_next_chunk(desc, conn);
 		}
 
+		if (conn->cmd_data.cmd == IIOD_CMD_BINARY && !conn->res.val)
+			conn->binary = true;
+
 		if (conn->cmd_data.cmd != IIOD_CMD_READBUF &&
 		    conn->cmd_data.cmd != IIOD_CMD_WRITEBUF) {
 			if (conn->is_cyclic_buffer && conn->cmd_data.cmd != IIOD_CMD_OPEN)
@@ -846,13 +1421,12 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		}
 
 		/* Read data from the client to verify whether a close command has been sent */
-		ret = iiod_read_line(desc, conn);
+		ret = iiod_recv_cmd(desc, conn);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return 0;
 
 		/* Fill struct comand_desc with data from line */
-		ret = iiod_parse_line(conn->parser_buf, &conn->cmd_data,
-				      &conn->strtok_ctx);
+		ret = iiod_parse_cmd(conn);
 		if (!NO_OS_IS_ERR_VALUE(ret) && conn->cmd_data.cmd == IIOD_CMD_CLOSE) {
 			/* Exit this state only if a close command is received
 			   All other commands will be ignored.
@@ -872,6 +1446,7 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 {
 	struct iiod_conn_priv *conn;
+	int32_t flush_ret;
 	int32_t ret;
 
 	if (!desc || conn_id > IIOD_MAX_CONNECTIONS ||
@@ -881,14 +1456,43 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 	conn = &desc->conns[conn_id];
 	do {
 		ret = iiod_run_state(desc, conn);
-		if (ret == -EAGAIN)
-			return ret;
 		if (NO_OS_IS_ERR_VALUE(ret) || conn->state == IIOD_LINE_DONE)
 			break;
 		//The loop will continue because the state was changed.
 	} while (true);
 
+	/* Send the replies coalesced during this step */
+	flush_ret = iiod_flush(desc, conn);
+	if (NO_OS_IS_ERR_VALUE(flush_ret) && flush_ret != -EAGAIN)
+		ret = flush_ret;
+	if (ret == -EAGAIN)
+		return ret;
+
+	/* Data left in the output buffer is sent by the next step */
 	conn_clean_state(conn);
 
 	return ret;
 }
+
+int32_t iiod_conn_priority(struct iiod_desc *desc, uint32_t conn_id)
+{
+	struct iiod_conn_priv *conn;
+	uint32_t i;
+
+	if (!desc || conn_id >= IIOD_MAX_CONNECTIONS ||
+	    !desc->conns[conn_id].used)
+		return -EINVAL;
+
+	conn = &desc->conns[conn_id];
+	if (conn->state == IIOD_READING_LINE)
+		/* Command not known yet, part of the line may be received */
+		return (conn->parser_idx || conn->bin_rx.idx || conn->out.len ||
+			conn->bin_rx.buf == conn->parser_buf) ?
+		       IIOD_CONN_IDLE_PRIORITY - 1 : IIOD_CONN_IDLE_PRIORITY;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(priority_array); ++i)
+		if (priority_array[i] == conn->cmd_data.cmd)
+			return i;
+
+	return IIOD_CONN_IDLE_PRIORITY - 1;
+}
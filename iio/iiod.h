@@ -52,6 +52,11 @@
 #define MAX_TRIG_ID		64
 #define MAX_CHN_ID		64
 #define MAX_ATTR_NAME		256
+/* Maximum length of the STREAM destination address, including the null */
+#define IIOD_STREAM_ADDR_LEN	48
+
+/* Priority of a connection waiting for a new command */
+#define IIOD_CONN_IDLE_PRIORITY	255
 
 enum iio_attr_type {
 	IIO_ATTR_TYPE_DEBUG,
@@ -70,6 +75,16 @@ struct iiod_attr {
 	 */
 	const char *name;
 	const char *channel;
+	/*
+	 * Offset in the value of the chunk to read. Values larger than the
+	 * connection buffer are read in chunks.
+	 */
+	uint32_t offset;
+	/*
+	 * Set by read_attr to the size of the whole value when only a chunk of
+	 * it was read, left 0 otherwise.
+	 */
+	uint32_t size;
 };
 
 struct iiod_ctx {
@@ -77,6 +92,8 @@ struct iiod_ctx {
 	void *instance;
 	/* Value specified in iiod_conn_data.conn in iiod_conn_add */
 	void *conn;
+	/* Id returned by iiod_conn_add, 0 when conn is NULL */
+	uint32_t conn_id;
 };
 
 struct iiod_conn_data {
@@ -101,6 +118,17 @@ struct iiod_ops {
 	 */
 	int (*send)(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len);
 	int (*recv)(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len);
+	/*
+	 * Optional zero copy alternative to recv, used for the data of
+	 * WRITEBUF. Set in buf the address of maximum len received bytes and
+	 * return their number. They are consumed only when recv_release is
+	 * called. Can return -ENOSYS for connections that don't support it,
+	 * then recv is used.
+	 */
+	int (*recv_nocopy)(struct iiod_ctx *ctx, const uint8_t **buf,
+			   uint32_t len);
+	/* Consume len bytes obtained with recv_nocopy */
+	int (*recv_release)(struct iiod_ctx *ctx, uint32_t len);
 
 	/*
 	 * This is the equivalent of libiio iio_device_create_buffer.
@@ -120,10 +148,35 @@ struct iiod_ops {
 			   uint32_t bytes);
 	/* Called to notify that buffer must be refiiled */
 	int (*refill_buffer)(struct iiod_ctx *ctx, const char *device);
+	/*
+	 * Optional zero copy alternative to read_buffer.
+	 * Set in buf the address of maximum bytes of data from the opened
+	 * buffer and return the number of bytes available at that address.
+	 * Data must remain valid and is consumed only when read_block_done is
+	 * called. If not set, read_buffer is used.
+	 */
+	int (*get_read_block)(struct iiod_ctx *ctx, const char *device,
+			      char **buf, uint32_t bytes);
+	/* Release the block obtained with get_read_block */
+	int (*read_block_done)(struct iiod_ctx *ctx, const char *device);
 
 	/* Write data to opened buffer */
 	int (*write_buffer)(struct iiod_ctx *ctx, const char *device,
 			    const char *buf, uint32_t bytes);
+	/*
+	 * Optional, used for the data of WRITEBUF when recv_nocopy is not
+	 * available. Set in buf the address where maximum bytes of data can be
+	 * written in the opened buffer and return the number of bytes that fit
+	 * there. The data is received directly at buf and write_block_done is
+	 * called with the number of bytes received, which can be 0. If not set,
+	 * the data is received in the connection buffer and written with
+	 * write_buffer.
+	 */
+	int (*get_write_block)(struct iiod_ctx *ctx, const char *device,
+			       char **buf, uint32_t bytes);
+	/* Commit bytes of the block obtained with get_write_block */
+	int (*write_block_done)(struct iiod_ctx *ctx, const char *device,
+				uint32_t bytes);
 	/* Called to notify that buffer must be pushed to hardware */
 	int (*push_buffer)(struct iiod_ctx *ctx, const char *device);
 
@@ -146,6 +199,31 @@ struct iiod_ops {
 	int (*set_trigger)(struct iiod_ctx *ctx, const char *device,
 			   const char *trigger, uint32_t len);
 
+	/*
+	 * Optional. Get the xml description of the context. When set, it is
+	 * used instead of iiod_init_param.xml, so the xml can be generated or
+	 * updated when it is requested.
+	 */
+	int (*get_xml)(struct iiod_ctx *ctx, char **xml, uint32_t *len);
+	/*
+	 * Optional. Alternative to get_xml for an xml that is not kept in
+	 * memory. Write in buf the chunk of maximum len bytes of the xml at
+	 * offset, set size to the size of the whole xml and return the number
+	 * of bytes written. Called again for the following chunks while they
+	 * are sent.
+	 */
+	int (*read_xml)(struct iiod_ctx *ctx, char *buf, uint32_t len,
+			uint32_t offset, uint32_t *size);
+
+	/*
+	 * Optional. Send the data of the opened input buffer as UDP datagrams
+	 * of at most bytes bytes (0 for the default) to address:port, instead
+	 * of waiting for READBUF. Datagrams that can't be sent are dropped.
+	 * Called with address set to NULL to stop the stream.
+	 */
+	int (*stream)(struct iiod_ctx *ctx, const char *device,
+		      const char *address, uint16_t port, uint32_t bytes);
+
 	/* I don't know what this should be used for :) */
 	int (*set_timeout)(struct iiod_ctx *ctx, uint32_t timeout);
 
@@ -190,5 +268,11 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data);
 /* Advance in the state machine of a connection. Will not block */
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id);
+/*
+ * Get the priority of the command being processed on a connection.
+ * Lower values mean higher priority. IIOD_CONN_IDLE_PRIORITY is returned when
+ * the connection waits for a new command.
+ */
+int32_t iiod_conn_priority(struct iiod_desc *desc, uint32_t conn_id);
 
 #endif //IIOD_H
@@ -44,11 +44,19 @@
 #define IIOD_ENDL			0x2
 #define IIOD_RD				0x4
 #define IIOD_PARSER_MAX_BUF_SIZE	128
+/*
+ * Size of the per connection buffer where small replies are coalesced before
+ * being sent. Bigger sends bypass it.
+ */
+#ifndef IIOD_OUT_BUF_SIZE
+#define IIOD_OUT_BUF_SIZE		256
+#endif
 
 #define IIOD_STR(cmd) {(cmd), sizeof(cmd) - 1}
 
 #define IIOD_CTX(desc, conn) {.instance = (desc)->app_instance,\
-			      .conn = (conn)->conn}
+			      .conn = (conn)->conn,\
+			      .conn_id = (conn) - (desc)->conns}
 
 
 /* Used to store a string and its size */
@@ -75,7 +83,42 @@ enum iiod_cmd {
 	IIOD_CMD_WRITEBUF,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY,
+	IIOD_CMD_STREAM
+};
+
+/* Value of iiod_bin_hdr.op for responses */
+#define IIOD_BIN_OP_RESPONSE		0xFF
+/* iiod_bin_hdr.flags bit for IIOD_CMD_OPEN requesting a cyclic buffer */
+#define IIOD_BIN_FLAG_CYCLIC		0x1
+
+/*
+ * Header of the binary protocol, enabled on a connection by the BINARY
+ * command. Fields are in little endian byte order.
+ *
+ * Request: op is a value of enum iiod_cmd and is followed by len bytes of
+ * null separated strings: device, channel (or trigger for SETTRIG) and
+ * attribute name. Remaining parameters are passed in the header:
+ *  - OPEN: code = samples count, arg = channel mask, flags = cyclic flag.
+ *  - READ/WRITE: flags = enum iio_attr_type, arg = bytes to write. The value
+ *    follows the strings for WRITE.
+ *  - READBUF/WRITEBUF: arg = bytes count. Data follows for WRITEBUF.
+ *  - TIMEOUT: code = timeout. SET: arg = buffers count.
+ *  - STREAM: the second string is the destination address (empty to stop),
+ *    code = destination port, arg = datagram payload size.
+ *
+ * Response: op is IIOD_BIN_OP_RESPONSE, client_id is the one of the request,
+ * code is the result and len bytes of data follow. For READBUF arg contains
+ * the channel mask and code bytes of buffer data follow.
+ */
+struct iiod_bin_hdr {
+	uint16_t	client_id;
+	uint8_t		op;
+	uint8_t		flags;
+	int32_t		code;
+	uint32_t	arg;
+	uint32_t	len;
 };
 
 /*
@@ -95,6 +138,9 @@ struct comand_desc {
 	char attr[MAX_ATTR_NAME];
 	char trigger[MAX_TRIG_ID];
 	enum iio_attr_type type;
+	/* Destination of a STREAM command. Empty to stop the stream */
+	char address[IIOD_STREAM_ADDR_LEN];
+	uint32_t port;
 };
 
 /* Used to store buffer indexes for non blocking transfers */
@@ -111,6 +157,10 @@ struct iiod_run_cmd_result {
 	bool write_val;
 	/* If buf.len != 0 buf has to be sent */
 	struct iiod_buff buf;
+	/* Size of a value sent in chunks of payload_buf, 0 if buf holds it */
+	uint32_t size;
+	/* Offset in the value of the chunk in buf */
+	uint32_t offset;
 };
 
 /* Internal structure to handle a connection state */
@@ -161,6 +211,18 @@ struct iiod_conn_priv {
 	char *strtok_ctx;
 	/* True if the device was open with cyclic buffer flag */
 	bool is_cyclic_buffer;
+	/* Set when the connection switched to the binary protocol */
+	bool binary;
+	/* Header of the last binary request */
+	struct iiod_bin_hdr bin_hdr;
+	/* Header of the binary response */
+	struct iiod_bin_hdr bin_resp;
+	/* Used to receive binary requests without blocking */
+	struct iiod_buff bin_rx;
+	/* Replies waiting to be sent, flushed once per iiod_conn_step */
+	char out_buf[IIOD_OUT_BUF_SIZE];
+	/* Index of the data in out_buf that was not sent yet */
+	struct iiod_buff out;
 };
 
 /* Private iiod information */
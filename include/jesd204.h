@@ -272,6 +272,9 @@ int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx);
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx);
 
+/* no-OS specific */
+int jesd204_fsm_link_restart(struct jesd204_dev *jdev, unsigned int link_id);
+
 void *jesd204_dev_priv(struct jesd204_dev *jdev);
 
 int jesd204_link_get_lmfc_lemc_rate(struct jesd204_link *lnk,
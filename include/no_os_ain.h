@@ -43,6 +43,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -74,6 +75,64 @@ struct no_os_ain_desc {
 	void *extra;
 };
 
+/**
+ * @struct no_os_ain_stream_format
+ * @brief Layout of the samples in the blocks of an analog input stream
+ */
+struct no_os_ain_stream_format {
+	/* Number of samples in a scan */
+	uint16_t nb_samples;
+	/* Valid bits of a sample */
+	uint8_t realbits;
+	/* Bits taken by a sample in the block: 8, 16, 32 or 64 */
+	uint8_t storagebits;
+	/* Right shift giving the valid bits */
+	uint8_t shift;
+	/* Set for two's complement samples */
+	bool is_signed;
+	/* Set for big endian samples */
+	bool is_big_endian;
+};
+
+/**
+ * @struct no_os_ain_stream_ops
+ * @brief Block producer implemented by an ADC driver
+ */
+struct no_os_ain_stream_ops {
+	/* Start producing blocks of block_scans scans */
+	int32_t (*start)(void *dev, uint32_t block_scans);
+	/* Stop producing blocks */
+	int32_t (*stop)(void *dev);
+	/*
+	 * Get the oldest complete block, -EAGAIN if none is ready. The block
+	 * must not be overwritten until release_block is called.
+	 */
+	int32_t (*get_block)(void *dev, void **block);
+	/* Give back the block returned by get_block */
+	int32_t (*release_block)(void *dev);
+	/* Optional, number of scans or blocks lost since start */
+	int32_t (*get_overruns)(void *dev, uint32_t *overruns);
+};
+
+/**
+ * @struct no_os_ain_stream
+ * @brief Streaming analog input, a driver instance and its block producer
+ */
+struct no_os_ain_stream {
+	/* Driver instance passed to the ops */
+	void *dev;
+	/* Block producer of the driver */
+	const struct no_os_ain_stream_ops *ops;
+	/* Sample layout of the blocks */
+	struct no_os_ain_stream_format format;
+	/* Scans in a block, set by no_os_ain_stream_start() */
+	uint32_t block_scans;
+	/* Set while the caller holds a block */
+	bool held;
+	/* Set while the stream is started */
+	bool started;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -88,4 +147,25 @@ int32_t no_os_ain_init(struct no_os_ain_desc **desc,
 /* Free the resources allocated by no_os_ain_init() */
 int32_t no_os_ain_remove(struct no_os_ain_desc *desc);
 
+/* Start producing blocks of block_scans scans */
+int32_t no_os_ain_stream_start(struct no_os_ain_stream *stream,
+			       uint32_t block_scans);
+
+/* Stop producing blocks */
+int32_t no_os_ain_stream_stop(struct no_os_ain_stream *stream);
+
+/* Get the oldest complete block */
+int32_t no_os_ain_stream_get_block(struct no_os_ain_stream *stream,
+				   void **block);
+
+/* Give back the block returned by no_os_ain_stream_get_block() */
+int32_t no_os_ain_stream_release_block(struct no_os_ain_stream *stream);
+
+/* Get the number of scans or blocks lost since start */
+int32_t no_os_ain_stream_get_overruns(struct no_os_ain_stream *stream,
+				      uint32_t *overruns);
+
+/* Size of a scan in bytes */
+uint32_t no_os_ain_stream_scan_bytes(struct no_os_ain_stream *stream);
+
 #endif	// end of NO_OS_AIN_H
@@ -41,6 +41,41 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+/**
+ * @struct no_os_alloc_stats
+ * @brief Statistics of the allocator, used to size the pools.
+ */
+struct no_os_alloc_stats {
+	/** Bytes currently allocated from the pool or the arena */
+	uint32_t in_use;
+	/** Maximum value reached by in_use */
+	uint32_t high_water;
+	/** Number of allocation requests */
+	uint32_t nb_allocs;
+	/** Number of requests that returned NULL */
+	uint32_t nb_failures;
+	/** Number of pool requests served by malloc */
+	uint32_t nb_fallbacks;
+};
+
+/**
+ * @struct no_os_alloc_class_stats
+ * @brief Statistics of a size class of the pool allocator.
+ */
+struct no_os_alloc_class_stats {
+	/** Size of a block in bytes */
+	uint32_t block_size;
+	/** Number of blocks of the class */
+	uint32_t nb_blocks;
+	/** Blocks currently allocated */
+	uint32_t in_use;
+	/** Maximum value reached by in_use */
+	uint32_t high_water;
+	/** Number of requests that found the class empty */
+	uint32_t nb_failures;
+};
 
 /* Allocate memory and return a pointer to it */
 void *no_os_malloc(size_t size);
@@ -52,4 +87,11 @@ void *no_os_calloc(size_t nitems, size_t size);
  * no_os_malloc */
 void no_os_free(void *ptr);
 
+/* Get the statistics of the allocator */
+int no_os_alloc_get_stats(struct no_os_alloc_stats *stats);
+
+/* Get the statistics of a size class of the pool allocator */
+int no_os_alloc_get_class_stats(uint32_t idx,
+				struct no_os_alloc_class_stats *stats);
+
 #endif // _NO_OS_ALLOC_H_
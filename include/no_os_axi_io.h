@@ -45,6 +45,11 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#if defined(XILINX_PLATFORM)
+#include <xil_io.h>
+#elif defined(ALTERA_PLATFORM)
+#include <io.h>
+#endif
 
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
@@ -56,4 +61,43 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data);
 /* AXI IO Write data */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data);
 
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/*
+ * Inline accessors for the register accesses on hot paths. On the platforms
+ * where the cores are memory mapped they compile to a single load or store,
+ * elsewhere (Linux UIO, generic) they call the functions above.
+ */
+
+/* AXI IO Read data, inlined when possible */
+static inline uint32_t no_os_axi_io_read32(uint32_t base, uint32_t offset)
+{
+#if defined(XILINX_PLATFORM)
+	return Xil_In32(base + offset);
+#elif defined(ALTERA_PLATFORM)
+	return IORD_32DIRECT(base, offset);
+#else
+	uint32_t data = 0;
+
+	no_os_axi_io_read(base, offset, &data);
+
+	return data;
+#endif
+}
+
+/* AXI IO Write data, inlined when possible */
+static inline void no_os_axi_io_write32(uint32_t base, uint32_t offset,
+					uint32_t data)
+{
+#if defined(XILINX_PLATFORM)
+	Xil_Out32(base + offset, data);
+#elif defined(ALTERA_PLATFORM)
+	IOWR_32DIRECT(base, offset, data);
+#else
+	no_os_axi_io_write(base, offset, data);
+#endif
+}
+
 #endif // _NO_OS_AXI_IO_H_
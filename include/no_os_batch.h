@@ -0,0 +1,161 @@
+/***************************************************************************//**
+ *   @file   no_os_batch.h
+ *   @brief  Batched, delta encoded telemetry uplink.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_BATCH_H_
+#define _NO_OS_BATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_lfring.h"
+
+/** Version of the payload format, first byte of each message */
+#define NO_OS_BATCH_VERSION	1
+/** Maximum number of values of a sample */
+#define NO_OS_BATCH_MAX_VALS	16
+/** Maximum downsampling factor */
+#define NO_OS_BATCH_MAX_DECIM	128
+
+/**
+ * @enum no_os_batch_policy
+ * @brief What to do with new samples when the uplink does not keep up
+ */
+enum no_os_batch_policy {
+	/** Drop the samples that do not fit in the ring */
+	NO_OS_BATCH_DROP,
+	/**
+	 * Double the downsampling each time the ring is 3/4 full and halve it
+	 * once a publish brings it under 1/4; drop the samples that still do
+	 * not fit
+	 */
+	NO_OS_BATCH_DOWNSAMPLE,
+};
+
+/**
+ * @struct no_os_batch_init_param
+ * @brief Parameters of a telemetry batch
+ */
+struct no_os_batch_init_param {
+	/** Values of each sample, at most NO_OS_BATCH_MAX_VALS */
+	uint32_t nb_vals;
+	/** Samples buffered between publishes, a power of two */
+	uint32_t depth;
+	/** Most samples in a message, 0 for depth */
+	uint32_t max_samples;
+	/** Publish at least every period_ms when samples are buffered */
+	uint32_t period_ms;
+	/** Backpressure policy */
+	enum no_os_batch_policy policy;
+	/**
+	 * Send a message, e.g. with mqtt_publish(). A negative return keeps
+	 * the message, which is sent again by the next no_os_batch_poll().
+	 */
+	int (*publish)(void *ctx, const uint8_t *payload, uint32_t len);
+	/** Context of publish */
+	void *ctx;
+};
+
+/**
+ * @struct no_os_batch
+ * @brief Telemetry batch. Samples are queued by no_os_batch_add() and sent by
+ * no_os_batch_poll() as one message of up to max_samples samples:
+ *
+ *	u8	NO_OS_BATCH_VERSION
+ *	u8	values per sample
+ *	u8	downsampling factor when the message was encoded
+ *	u8	reserved, 0
+ *	varint	number of samples
+ *	varint	samples dropped since the previous message
+ *	u32le	timestamp of the first sample in ms
+ *	zigzag	values of the first sample
+ *	then for each next sample:
+ *	varint	timestamp increment in ms
+ *	zigzag	increment of each value
+ *
+ * varint is the LEB128 encoding and zigzag maps a signed value v to
+ * the varint of (v << 1) ^ (v >> 31), so slowly changing values take one
+ * or two bytes. tools/scripts/no_os_batch_decode.py decodes the messages.
+ */
+struct no_os_batch {
+	/** Queued samples: timestamp then values */
+	struct no_os_lfring *ring;
+	/** Values of each sample */
+	uint32_t nb_vals;
+	/** Ring depth */
+	uint32_t depth;
+	/** Most samples in a message */
+	uint32_t max_samples;
+	/** Publish period */
+	uint32_t period_ms;
+	/** Backpressure policy */
+	enum no_os_batch_policy policy;
+	/** Send a message */
+	int (*publish)(void *ctx, const uint8_t *payload, uint32_t len);
+	/** Context of publish */
+	void *ctx;
+	/** Message being sent */
+	uint8_t *payload;
+	/** Length of the message not sent yet, 0 if none */
+	uint32_t pending;
+	/** Time of the last publish */
+	uint32_t last_ms;
+	/** Current downsampling factor */
+	uint32_t decim;
+	/** Samples to skip before the next one is queued */
+	uint32_t skip;
+	/** Samples dropped since the last message */
+	uint32_t dropped;
+	/** Messages sent */
+	uint32_t sent;
+	/** Publishes that failed */
+	uint32_t errors;
+};
+
+/* Allocate a telemetry batch. */
+int no_os_batch_init(struct no_os_batch **batch,
+		     const struct no_os_batch_init_param *param);
+
+/* Queue a sample, from the same context as no_os_batch_poll(). */
+int no_os_batch_add(struct no_os_batch *batch, uint32_t ts_ms,
+		    const int32_t *vals);
+
+/* Send a message if one is due or the previous one failed. */
+int no_os_batch_poll(struct no_os_batch *batch, uint32_t now_ms);
+
+/* Free the resources allocated by no_os_batch_init(). */
+void no_os_batch_remove(struct no_os_batch *batch);
+
+#endif // _NO_OS_BATCH_H_
@@ -0,0 +1,98 @@
+/***************************************************************************//**
+ *   @file   no_os_boot.h
+ *   @brief  Header file of the boot stage orchestration.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_BOOT_H_
+#define _NO_OS_BOOT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_util.h"
+
+#define NO_OS_BOOT_MAX_STAGES	32
+
+/* Dependency mask of a stage on the stage at index _i */
+#define NO_OS_BOOT_DEP(_i)	NO_OS_BIT(_i)
+
+/**
+ * @struct no_os_boot_stage
+ * @brief Initialization step of a project. The stages form a dependency
+ * graph, a stage is started once all the stages in its deps mask are done.
+ */
+struct no_os_boot_stage {
+	/** Stage name, for the report */
+	const char *name;
+	/** NO_OS_BOOT_DEP() of the stages that must be done first */
+	uint32_t deps;
+	/**
+	 * Run the step. Returns 0 when done, -EINPROGRESS when it goes on in
+	 * the background (async SPI, DMA, PLL lock) and poll has to be called
+	 * until it is done, or a negative error code.
+	 */
+	int (*start)(void *ctx);
+	/** Returns 0 when done, -EINPROGRESS or a negative error code */
+	int (*poll)(void *ctx);
+	/** Parameter of start and poll */
+	void *ctx;
+	/** Result, -ECANCELED if not run because another stage failed */
+	int status;
+	/** Start and end in cycles from no_os_boot_run(), NO_OS_PROFILING */
+	uint64_t begin;
+	uint64_t end;
+};
+
+/**
+ * @struct no_os_boot
+ * @brief Stages of a boot and its timeline.
+ */
+struct no_os_boot {
+	/** Stages, a stage must be listed after its dependencies */
+	struct no_os_boot_stage *stages;
+	/** Number of stages, up to NO_OS_BOOT_MAX_STAGES */
+	uint32_t nb_stages;
+	/** Time from no_os_boot_run() to the end of the last stage */
+	uint64_t total;
+	/** Cycle counter extended to 64 bits, used internally */
+	uint32_t last;
+};
+
+/* Run the stages, overlapping the ones that complete in the background. */
+int no_os_boot_run(struct no_os_boot *boot);
+
+/* Print the start, duration and result of every stage in microseconds. */
+int no_os_boot_show(struct no_os_boot *boot, char *buf, uint32_t len);
+
+#endif // _NO_OS_BOOT_H_
@@ -0,0 +1,132 @@
+/***************************************************************************//**
+ *   @file   no_os_bus_trace.h
+ *   @brief  Header file of the SPI and I2C transfer tracer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_BUS_TRACE_H_
+#define _NO_OS_BUS_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_profile.h"
+
+/* Number of transfers kept by the tracer */
+#ifndef NO_OS_BUS_TRACE_SIZE
+#define NO_OS_BUS_TRACE_SIZE		256
+#endif
+
+/* Buses of each type for which the gap between transfers is computed */
+#ifndef NO_OS_BUS_TRACE_MAX_BUS
+#define NO_OS_BUS_TRACE_MAX_BUS		8
+#endif
+
+/* Size of a record packed by no_os_bus_trace_dump() */
+#define NO_OS_BUS_TRACE_REC_SIZE	18
+
+/**
+ * @enum no_os_bus_trace_type
+ * @brief Bus of a traced transfer.
+ */
+enum no_os_bus_trace_type {
+	NO_OS_BUS_TRACE_SPI,
+	NO_OS_BUS_TRACE_I2C,
+	NO_OS_BUS_TRACE_NB_TYPES,
+};
+
+/**
+ * @struct no_os_bus_trace_rec
+ * @brief Metadata of a transfer, times in cycles of no_os_get_cycles().
+ */
+struct no_os_bus_trace_rec {
+	/** Counter value at the start of the transfer */
+	uint32_t start;
+	/** Duration of the transfer */
+	uint32_t duration;
+	/** Time since the end of the previous transfer on the bus, 0 if none */
+	uint32_t gap;
+	/** Number of bytes transferred */
+	uint16_t len;
+	/** enum no_os_bus_trace_type */
+	uint8_t type;
+	/** Bus number */
+	uint8_t bus;
+	/** Chip select for SPI, slave address for I2C */
+	uint8_t dev;
+	/** Set if the transfer returned an error */
+	uint8_t err;
+};
+
+#ifdef NO_OS_BUS_TRACE
+/* Take the start time of a transfer in variable _t. */
+#define NO_OS_BUS_TRACE_BEGIN(_t)	uint32_t _t = no_os_get_cycles()
+/* Record the transfer started at _t. */
+#define NO_OS_BUS_TRACE_END(_t, _type, _bus, _dev, _len, _ret) \
+	no_os_bus_trace_record((_type), (_bus), (_dev), (_len), (_t), (_ret))
+#else
+#define NO_OS_BUS_TRACE_BEGIN(_t)
+#define NO_OS_BUS_TRACE_END(_t, _type, _bus, _dev, _len, _ret) \
+	do {} while (0)
+#endif
+
+/* Clear the capture and record the next transfers. */
+void no_os_bus_trace_start(uint32_t count);
+
+/* Stop recording, the capture is kept. */
+void no_os_bus_trace_stop(void);
+
+/* Whether transfers are being recorded. */
+bool no_os_bus_trace_running(void);
+
+/* Add a transfer to the capture, used by the SPI and I2C APIs. */
+void no_os_bus_trace_record(enum no_os_bus_trace_type type, uint32_t bus,
+			    uint32_t dev, uint32_t len, uint32_t start,
+			    int32_t ret);
+
+/* Number of transfers in the capture. */
+uint32_t no_os_bus_trace_count(void);
+
+/* Get a transfer of the capture, 0 being the oldest. */
+int no_os_bus_trace_get(uint32_t idx, struct no_os_bus_trace_rec *rec);
+
+/* Print the capture as text, continuing from the previous call. */
+int no_os_bus_trace_show(char *buf, uint32_t len);
+
+/* Restart no_os_bus_trace_show() from the oldest transfer. */
+void no_os_bus_trace_rewind(void);
+
+/* Pack the capture in the binary format read by tools/scripts/bus_trace.py. */
+int no_os_bus_trace_dump(uint8_t *buf, uint32_t len);
+
+#endif // _NO_OS_BUS_TRACE_H_
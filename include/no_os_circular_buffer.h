@@ -79,6 +79,11 @@ struct no_os_circular_buffer {
 	struct no_os_cb_ptr	write;
 	/** Read pointer */
 	struct no_os_cb_ptr	read;
+	/**
+	 * size - 1 when size is a power of two, 0 otherwise. Enables the
+	 * masked fast path, where spin_count and idx form a single position.
+	 */
+	uint32_t	mask;
 };
 
 /******************************************************************************/
@@ -102,6 +107,8 @@ int32_t no_os_cb_prepare_async_write(struct no_os_circular_buffer *desc,
 				     void **write_buff,
 				     uint32_t *raw_size_avilable);
 int32_t no_os_cb_end_async_write(struct no_os_circular_buffer *desc);
+int32_t no_os_cb_end_async_write_size(struct no_os_circular_buffer *desc,
+				      uint32_t size);
 
 int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
 				    uint32_t raw_size_to_read,
@@ -0,0 +1,105 @@
+/***************************************************************************//**
+ *   @file   no_os_clk_plan.h
+ *   @brief  Header file of the clock tree planner.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_CLK_PLAN_H_
+#define _NO_OS_CLK_PLAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_clk.h"
+
+/** Number of solved configurations kept by a planner */
+#define NO_OS_CLK_PLAN_CACHE_SIZE	4
+
+/**
+ * @struct no_os_clk_plan_init_param
+ * @brief Clock tree planner initialization parameters
+ */
+struct no_os_clk_plan_init_param {
+	/** Outputs handled by the planner, in the order rates are given */
+	struct no_os_clk_desc **clks;
+	/** Number of outputs */
+	uint32_t nb_clks;
+};
+
+/**
+ * @struct no_os_clk_plan_desc
+ * @brief Clock tree planner descriptor
+ */
+struct no_os_clk_plan_desc {
+	/** Outputs handled by the planner */
+	struct no_os_clk_desc **clks;
+	/** Number of outputs */
+	uint32_t nb_clks;
+	/** Rate currently programmed on each output, 0 if unknown */
+	uint64_t *applied;
+	/** Requested rates of each cached plan, nb_clks per plan */
+	uint64_t *requested;
+	/** Rounded rates of each cached plan, nb_clks per plan */
+	uint64_t *solved;
+	/** Cached plans holding a valid solution */
+	bool valid[NO_OS_CLK_PLAN_CACHE_SIZE];
+	/** Next cache slot to be replaced */
+	uint32_t next;
+};
+
+/* Initialize a clock tree planner. */
+int no_os_clk_plan_init(struct no_os_clk_plan_desc **desc,
+			const struct no_os_clk_plan_init_param *param);
+
+/* Free the resources allocated by no_os_clk_plan_init(). */
+int no_os_clk_plan_remove(struct no_os_clk_plan_desc *desc);
+
+/* Solve the dividers for a set of output rates, reusing a cached plan. */
+int no_os_clk_plan_solve(struct no_os_clk_plan_desc *desc,
+			 const uint64_t *rates, uint32_t *plan_id);
+
+/* Get the rate a solved plan produces on one output. */
+int no_os_clk_plan_get_rate(struct no_os_clk_plan_desc *desc,
+			    uint32_t plan_id, uint32_t idx, uint64_t *rate);
+
+/* Program the outputs whose rate differs from the current one. */
+int no_os_clk_plan_apply(struct no_os_clk_plan_desc *desc, uint32_t plan_id);
+
+/* Solve and apply a set of output rates. */
+int no_os_clk_plan_set(struct no_os_clk_plan_desc *desc,
+		       const uint64_t *rates);
+
+/* Forget the programmed rates, e.g. after the clock chip was reset. */
+void no_os_clk_plan_invalidate(struct no_os_clk_plan_desc *desc);
+
+#endif // _NO_OS_CLK_PLAN_H_
@@ -0,0 +1,99 @@
+/***************************************************************************//**
+ *   @file   no_os_counter.h
+ *   @brief  Header file of the runtime performance counters.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_COUNTER_H_
+#define _NO_OS_COUNTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @struct no_os_counter
+ * @brief Named event or byte counter, e.g. the bytes streamed by a device or
+ * the transfers of a SPI bus.
+ */
+struct no_os_counter {
+	/** Counter name */
+	const char *name;
+	/** Instance number appended to the name, -1 if none */
+	int32_t index;
+	/** Counter value */
+	uint64_t value;
+	/** Counter is in the list reported by no_os_counter_show() */
+	bool listed;
+	/** Next counter in the list */
+	struct no_os_counter *next;
+};
+
+#define NO_OS_COUNTER_INIT(_name)	{ .name = (_name), .index = -1 }
+#define NO_OS_COUNTER_INIT_IDX(_name, _idx) \
+	{ .name = (_name), .index = (int32_t)(_idx) }
+
+#ifdef NO_OS_COUNTERS
+/* Define a named counter. */
+#define NO_OS_COUNTER_DEFINE(_var) \
+	struct no_os_counter _var = NO_OS_COUNTER_INIT(#_var)
+
+#define NO_OS_COUNTER_ADD(_cnt, _n)	no_os_counter_add(&(_cnt), (_n))
+#define NO_OS_COUNTER_MAX(_cnt, _v)	no_os_counter_max(&(_cnt), (_v))
+#define NO_OS_COUNTER_REMOVE(_cnt)	no_os_counter_remove(&(_cnt))
+#else
+#define NO_OS_COUNTER_DEFINE(_var)	struct no_os_counter _var
+#define NO_OS_COUNTER_ADD(_cnt, _n)	do {} while (0)
+#define NO_OS_COUNTER_MAX(_cnt, _v)	do {} while (0)
+#define NO_OS_COUNTER_REMOVE(_cnt)	do {} while (0)
+#endif
+
+/* Add n to a counter. */
+void no_os_counter_add(struct no_os_counter *cnt, uint32_t n);
+
+/* Raise a counter to v if it is lower, for high-water marks. */
+void no_os_counter_max(struct no_os_counter *cnt, uint64_t v);
+
+/* Take a counter out of the list before its memory is freed. */
+void no_os_counter_remove(struct no_os_counter *cnt);
+
+/* Clear all the counters. */
+void no_os_counter_reset(void);
+
+/* Print every counter as "name value", one per line. */
+int no_os_counter_show(char *buf, uint32_t len);
+
+/* Pack every counter in the binary format of no_os_counter_dump(). */
+int no_os_counter_dump(uint8_t *buf, uint32_t len);
+
+#endif // _NO_OS_COUNTER_H_
@@ -39,8 +39,97 @@
 #ifndef _NO_OS_CRC_H_
 #define _NO_OS_CRC_H_
 
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 #include "no_os_crc8.h"
 #include "no_os_crc16.h"
 #include "no_os_crc24.h"
+#include "no_os_crc32.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+struct no_os_crc_platform_ops;
+
+/**
+ * @struct no_os_crc_init_param
+ * @brief  Structure holding the parameters for CRC engine initialization
+ */
+struct no_os_crc_init_param {
+	/** CRC width in bits (8, 16, 24 or 32) */
+	uint8_t width;
+	/**
+	 * Polynomial: msb-first for non-reflected CRCs (e.g. 0x07 for CRC-8),
+	 * lsb-first for reflected ones (e.g. 0xEDB88320 for CRC-32).
+	 */
+	uint32_t polynomial;
+	/** Data and CRC are processed lsb-first */
+	bool reflected;
+	/**
+	 * Platform operations of a hardware CRC unit. NULL or a platform
+	 * reporting -ENOTSUP for the requested CRC selects the software
+	 * slice-by-8 implementation.
+	 */
+	const struct no_os_crc_platform_ops *platform_ops;
+	/** CRC extra parameters (device specific) */
+	void *extra;
+};
+
+/**
+ * @struct no_os_crc_desc
+ * @brief Structure holding CRC engine descriptor
+ */
+struct no_os_crc_desc {
+	/** CRC width in bits */
+	uint8_t width;
+	/** Polynomial, same representation as in the init param */
+	uint32_t polynomial;
+	/** Data and CRC are processed lsb-first */
+	bool reflected;
+	/** CRC platform operations */
+	const struct no_os_crc_platform_ops *platform_ops;
+	/** CRC extra parameters (device specific) */
+	void *extra;
+};
+
+/**
+ * @struct no_os_crc_platform_ops
+ * @brief Structure holding CRC function pointers that point to the platform
+ * specific function
+ */
+struct no_os_crc_platform_ops {
+	/** CRC initialization function pointer, -ENOTSUP if not handled */
+	int (*init)(struct no_os_crc_desc **,
+		    const struct no_os_crc_init_param *);
+	/** CRC computation function pointer */
+	int (*compute)(struct no_os_crc_desc *, const uint8_t *, size_t,
+		       uint32_t, uint32_t *);
+	/** CRC remove function pointer */
+	int (*remove)(struct no_os_crc_desc *);
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Software slice-by-8 CRC implementation. */
+extern const struct no_os_crc_platform_ops no_os_crc_sw_ops;
+
+/* Initialize a CRC engine, on the hardware unit if it supports the CRC. */
+int no_os_crc_init(struct no_os_crc_desc **desc,
+		   const struct no_os_crc_init_param *param);
+
+/* Compute the CRC over a buffer, starting from the crc value. */
+int no_os_crc_compute(struct no_os_crc_desc *desc, const uint8_t *data,
+		      size_t len, uint32_t crc, uint32_t *result);
+
+/* Free the resources allocated by no_os_crc_init(). */
+int no_os_crc_remove(struct no_os_crc_desc *desc);
 
 #endif // _NO_OS_CRC_H_
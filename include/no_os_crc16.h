@@ -43,13 +43,22 @@
 #include <stddef.h>
 
 #define NO_OS_CRC16_TABLE_SIZE 256
+#define NO_OS_CRC16_SLICES 8
 
 #define NO_OS_DECLARE_CRC16_TABLE(_table) \
 	static uint16_t _table[NO_OS_CRC16_TABLE_SIZE]
 
+#define NO_OS_DECLARE_CRC16_SLICE_TABLE(_table) \
+	static uint16_t _table[NO_OS_CRC16_SLICES][NO_OS_CRC16_TABLE_SIZE]
+
 void no_os_crc16_populate_msb(uint16_t * table, const uint16_t polynomial);
 uint16_t no_os_crc16(const uint16_t * table, const uint8_t *pdata,
 		     size_t nbytes,
 		     uint16_t crc);
+void no_os_crc16_populate_slice_msb(uint16_t table[][NO_OS_CRC16_TABLE_SIZE],
+				    const uint16_t polynomial);
+uint16_t no_os_crc16_slice(const uint16_t table[][NO_OS_CRC16_TABLE_SIZE],
+			   const uint8_t *pdata, size_t nbytes, uint16_t crc);
+const uint16_t *no_os_crc16_get_table(const uint16_t polynomial);
 
 #endif // _NO_OS_CRC16_H_
@@ -43,13 +43,22 @@
 #include <stddef.h>
 
 #define NO_OS_CRC24_TABLE_SIZE 256
+#define NO_OS_CRC24_SLICES 8
 
 #define NO_OS_DECLARE_CRC24_TABLE(_table) \
 	static uint32_t _table[NO_OS_CRC24_TABLE_SIZE]
 
+#define NO_OS_DECLARE_CRC24_SLICE_TABLE(_table) \
+	static uint32_t _table[NO_OS_CRC24_SLICES][NO_OS_CRC24_TABLE_SIZE]
+
 void no_os_crc24_populate_msb(uint32_t * table, const uint32_t polynomial);
 uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 		     size_t nbytes,
 		     uint32_t crc);
+void no_os_crc24_populate_slice_msb(uint32_t table[][NO_OS_CRC24_TABLE_SIZE],
+				    const uint32_t polynomial);
+uint32_t no_os_crc24_slice(const uint32_t table[][NO_OS_CRC24_TABLE_SIZE],
+			   const uint8_t *pdata, size_t nbytes, uint32_t crc);
+const uint32_t *no_os_crc24_get_table(const uint32_t polynomial);
 
 #endif // _NO_OS_CRC24_H_
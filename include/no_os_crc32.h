@@ -0,0 +1,63 @@
+/***************************************************************************//**
+ *   @file   no_os_crc32.h
+ *   @brief  Header file of CRC-32 computation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_CRC32_H_
+#define _NO_OS_CRC32_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NO_OS_CRC32_TABLE_SIZE 256
+#define NO_OS_CRC32_SLICES 8
+
+#define NO_OS_DECLARE_CRC32_TABLE(_table) \
+	static uint32_t _table[NO_OS_CRC32_TABLE_SIZE]
+
+#define NO_OS_DECLARE_CRC32_SLICE_TABLE(_table) \
+	static uint32_t _table[NO_OS_CRC32_SLICES][NO_OS_CRC32_TABLE_SIZE]
+
+void no_os_crc32_populate_lsb(uint32_t * table, const uint32_t polynomial);
+uint32_t no_os_crc32(const uint32_t * table, const uint8_t *pdata,
+		     size_t nbytes,
+		     uint32_t crc);
+void no_os_crc32_populate_slice_lsb(uint32_t table[][NO_OS_CRC32_TABLE_SIZE],
+				    const uint32_t polynomial);
+uint32_t no_os_crc32_slice(const uint32_t table[][NO_OS_CRC32_TABLE_SIZE],
+			   const uint8_t *pdata, size_t nbytes, uint32_t crc);
+const uint32_t *no_os_crc32_get_table(const uint32_t polynomial);
+
+#endif // _NO_OS_CRC32_H_
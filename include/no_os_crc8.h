@@ -43,12 +43,21 @@
 #include <stddef.h>
 
 #define NO_OS_CRC8_TABLE_SIZE 256
+#define NO_OS_CRC8_SLICES 8
 
 #define NO_OS_DECLARE_CRC8_TABLE(_table) \
 	static uint8_t _table[NO_OS_CRC8_TABLE_SIZE]
 
+#define NO_OS_DECLARE_CRC8_SLICE_TABLE(_table) \
+	static uint8_t _table[NO_OS_CRC8_SLICES][NO_OS_CRC8_TABLE_SIZE]
+
 void no_os_crc8_populate_msb(uint8_t * table, const uint8_t polynomial);
 uint8_t no_os_crc8(const uint8_t * table, const uint8_t *pdata, size_t nbytes,
 		   uint8_t crc);
+void no_os_crc8_populate_slice_msb(uint8_t table[][NO_OS_CRC8_TABLE_SIZE],
+				   const uint8_t polynomial);
+uint8_t no_os_crc8_slice(const uint8_t table[][NO_OS_CRC8_TABLE_SIZE],
+			 const uint8_t *pdata, size_t nbytes, uint8_t crc);
+const uint8_t *no_os_crc8_get_table(const uint8_t polynomial);
 
 #endif // _NO_OS_CRC8_H_
@@ -0,0 +1,110 @@
+/***************************************************************************//**
+ *   @file   no_os_crc_table.h
+ *   @brief  Compile time generation of CRC lookup tables.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_CRC_TABLE_H_
+#define _NO_OS_CRC_TABLE_H_
+
+/*
+ * The macros below expand to the 256 initializers of a CRC lookup table, so
+ * tables for known polynomials are computed by the compiler and can live in
+ * flash:
+ *
+ *	static const uint8_t table[NO_OS_CRC8_TABLE_SIZE] = {
+ *		NO_OS_CRC8_MSB_TABLE(0x07)
+ *	};
+ *
+ * The content is identical to what the no_os_crc*_populate_*() functions
+ * write at runtime.
+ */
+
+#define _NO_OS_CRC_TABLE_4(_e, _p, _n) \
+	_e(_p, (_n)), _e(_p, (_n) + 1), _e(_p, (_n) + 2), _e(_p, (_n) + 3)
+#define _NO_OS_CRC_TABLE_16(_e, _p, _n) \
+	_NO_OS_CRC_TABLE_4(_e, _p, (_n)), \
+	_NO_OS_CRC_TABLE_4(_e, _p, (_n) + 4), \
+	_NO_OS_CRC_TABLE_4(_e, _p, (_n) + 8), \
+	_NO_OS_CRC_TABLE_4(_e, _p, (_n) + 12)
+#define _NO_OS_CRC_TABLE_64(_e, _p, _n) \
+	_NO_OS_CRC_TABLE_16(_e, _p, (_n)), \
+	_NO_OS_CRC_TABLE_16(_e, _p, (_n) + 16), \
+	_NO_OS_CRC_TABLE_16(_e, _p, (_n) + 32), \
+	_NO_OS_CRC_TABLE_16(_e, _p, (_n) + 48)
+#define _NO_OS_CRC_TABLE_256(_e, _p) \
+	_NO_OS_CRC_TABLE_64(_e, _p, 0), \
+	_NO_OS_CRC_TABLE_64(_e, _p, 64), \
+	_NO_OS_CRC_TABLE_64(_e, _p, 128), \
+	_NO_OS_CRC_TABLE_64(_e, _p, 192)
+
+/* One msb-first shift of a _w bits wide CRC register. */
+#define _NO_OS_CRC_MSB_STEP(_w, _p, _c) \
+	((((_c) << 1) ^ ((((_c) >> ((_w) - 1)) & 1) * (_p))) & \
+	 ((1ull << (_w)) - 1))
+/* One lsb-first shift of a reflected CRC register. */
+#define _NO_OS_CRC_LSB_STEP(_p, _c) \
+	(((_c) >> 1) ^ (((_c) & 1) * (_p)))
+
+#define _NO_OS_CRC_MSB_BYTE(_w, _p, _c) \
+	_NO_OS_CRC_MSB_STEP(_w, _p, _NO_OS_CRC_MSB_STEP(_w, _p, \
+	_NO_OS_CRC_MSB_STEP(_w, _p, _NO_OS_CRC_MSB_STEP(_w, _p, \
+	_NO_OS_CRC_MSB_STEP(_w, _p, _NO_OS_CRC_MSB_STEP(_w, _p, \
+	_NO_OS_CRC_MSB_STEP(_w, _p, _NO_OS_CRC_MSB_STEP(_w, _p, (_c)))))))))
+#define _NO_OS_CRC_LSB_BYTE(_p, _c) \
+	_NO_OS_CRC_LSB_STEP(_p, _NO_OS_CRC_LSB_STEP(_p, \
+	_NO_OS_CRC_LSB_STEP(_p, _NO_OS_CRC_LSB_STEP(_p, \
+	_NO_OS_CRC_LSB_STEP(_p, _NO_OS_CRC_LSB_STEP(_p, \
+	_NO_OS_CRC_LSB_STEP(_p, _NO_OS_CRC_LSB_STEP(_p, (_c)))))))))
+
+#define _NO_OS_CRC8_MSB_ENTRY(_p, _n) \
+	(uint8_t)_NO_OS_CRC_MSB_BYTE(8, (uint64_t)(_p), (uint64_t)(_n))
+#define _NO_OS_CRC16_MSB_ENTRY(_p, _n) \
+	(uint16_t)_NO_OS_CRC_MSB_BYTE(16, (uint64_t)(_p), (uint64_t)(_n) << 8)
+#define _NO_OS_CRC24_MSB_ENTRY(_p, _n) \
+	(uint32_t)_NO_OS_CRC_MSB_BYTE(24, (uint64_t)(_p), (uint64_t)(_n) << 16)
+#define _NO_OS_CRC32_LSB_ENTRY(_p, _n) \
+	(uint32_t)_NO_OS_CRC_LSB_BYTE((uint32_t)(_p), (uint32_t)(_n))
+
+/* Initializers of a CRC lookup table, see no_os_crc*_populate_*(). */
+#define NO_OS_CRC8_MSB_TABLE(_poly) \
+	_NO_OS_CRC_TABLE_256(_NO_OS_CRC8_MSB_ENTRY, _poly)
+#define NO_OS_CRC16_MSB_TABLE(_poly) \
+	_NO_OS_CRC_TABLE_256(_NO_OS_CRC16_MSB_ENTRY, _poly)
+#define NO_OS_CRC24_MSB_TABLE(_poly) \
+	_NO_OS_CRC_TABLE_256(_NO_OS_CRC24_MSB_ENTRY, _poly)
+#define NO_OS_CRC32_LSB_TABLE(_poly) \
+	_NO_OS_CRC_TABLE_256(_NO_OS_CRC32_LSB_ENTRY, _poly)
+
+#endif // _NO_OS_CRC_TABLE_H_
@@ -0,0 +1,142 @@
+/***************************************************************************//**
+ *   @file   no_os_dac_stream.h
+ *   @brief  Header file for timer paced DAC waveform streaming.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_DAC_STREAM_H_
+#define _NO_OS_DAC_STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_spi.h"
+#include "no_os_pwm.h"
+
+/** Largest SPI frame written for one sample */
+#define NO_OS_DAC_STREAM_MAX_FRAME	8
+
+/**
+ * @struct no_os_dac_stream_init_param
+ * @brief Parameters of a timer paced DAC stream
+ */
+struct no_os_dac_stream_init_param {
+	/** SPI descriptor of the DAC, set by the driver */
+	struct no_os_spi_desc *spi_desc;
+	/**
+	 * PWM generating the update tick. Its period is set from
+	 * sample_rate_hz. If ldac_pwm is set its output drives the LDAC pin,
+	 * which must be configured active low, for ldac_pulse_ns.
+	 */
+	struct no_os_pwm_init_param *tick_pwm_init;
+	/**
+	 * Set if the PWM drives LDAC. The outputs then update on the PWM edge,
+	 * free of interrupt jitter. Otherwise each frame updates the output
+	 * when it is written.
+	 */
+	bool ldac_pwm;
+	/** Update rate, in Hz */
+	uint32_t sample_rate_hz;
+	/** LDAC low pulse width, in ns, set by the driver */
+	uint32_t ldac_pulse_ns;
+	/** Bytes written for one sample, set by the driver */
+	uint8_t frame_bytes;
+	/** Ring buffer, nb_blocks * block_samples * frame_bytes large */
+	uint8_t *ring;
+	/** Number of samples in a block */
+	uint32_t block_samples;
+	/** Number of blocks in the ring */
+	uint32_t nb_blocks;
+	/**
+	 * Set to play the blocks written before start in a loop. Otherwise
+	 * blocks are played once and refilled while running.
+	 */
+	bool cyclic;
+};
+
+/**
+ * @struct no_os_dac_stream
+ * @brief Timer paced DAC stream descriptor
+ */
+struct no_os_dac_stream {
+	/** SPI descriptor of the DAC */
+	struct no_os_spi_desc *spi_desc;
+	/** Update tick PWM */
+	struct no_os_pwm_desc *tick_pwm;
+	/** Frame write message */
+	struct no_os_spi_msg msg;
+	/** Ring buffer */
+	uint8_t *ring;
+	/** Bytes written for one sample */
+	uint32_t frame_bytes;
+	/** Number of samples in a block */
+	uint32_t block_samples;
+	/** Number of blocks in the ring */
+	uint32_t nb_blocks;
+	/** Play the filled blocks in a loop */
+	bool cyclic;
+	/** Number of filled blocks */
+	volatile uint32_t wr;
+	/** Number of played blocks, wraps to 0 in cyclic mode */
+	volatile uint32_t rd;
+	/** Sample index in the block being played */
+	volatile uint32_t idx;
+	/** Set while a frame write is in flight */
+	volatile bool busy;
+	/** Set once the PWM runs */
+	bool started;
+	/** Number of ticks without a new sample */
+	uint32_t underruns;
+};
+
+/* Prepare a timer paced DAC stream. */
+int no_os_dac_stream_init(struct no_os_dac_stream **stream,
+			  const struct no_os_dac_stream_init_param *param);
+
+/* Get the next free block of the ring. */
+int no_os_dac_stream_get_block(struct no_os_dac_stream *stream,
+			       uint8_t **block);
+
+/* Queue the block returned by no_os_dac_stream_get_block(). */
+int no_os_dac_stream_block_done(struct no_os_dac_stream *stream);
+
+/* Start the update tick. */
+int no_os_dac_stream_start(struct no_os_dac_stream *stream);
+
+/* Write the next sample, to be called on each update tick. */
+int no_os_dac_stream_trigger(struct no_os_dac_stream *stream);
+
+/* Stop the stream and free its resources. */
+int no_os_dac_stream_remove(struct no_os_dac_stream *stream);
+
+#endif // _NO_OS_DAC_STREAM_H_
@@ -104,6 +104,37 @@ struct no_os_dma_xfer_desc {
 
 	/** User or platform defined data */
 	void *extra;
+
+	/** Link in the channel's list of transfers. Used internally */
+	struct no_os_ilist_node sg_node;
+};
+
+/**
+ * @struct no_os_dma_cyclic_desc
+ * @brief Describes a cyclic (ring) transfer. The buffer is split into equal
+ * periods which the DMA controller transfers endlessly, one after the other.
+ */
+struct no_os_dma_cyclic_desc {
+	/**
+	 * Transfer covering the whole ring. src and dst are the start
+	 * addresses, length is the size of the ring in bytes and must be a
+	 * multiple of num_periods. The completion callback is not used.
+	 */
+	struct no_os_dma_xfer_desc xfer;
+	/** Number of periods in the ring */
+	uint32_t num_periods;
+	/**
+	 * Called from interrupt context once a period was transferred. The
+	 * period may be processed until it comes around again.
+	 */
+	void (*period_cb)(struct no_os_dma_cyclic_desc *, uint32_t, void *);
+	/** Parameter for the period callback */
+	void *period_ctx;
+
+	/** Length of a period in bytes. Used internally */
+	uint32_t period_len;
+	/** Index of the period being transferred. Used internally */
+	volatile uint32_t period;
 };
 
 /**
@@ -115,8 +146,8 @@ struct no_os_dma_ch {
 	uint32_t id;
 	/** Whether or not there is a transfer in progress on this channel */
 	bool free;
-	/** List of transfers for this channel */
-	struct no_os_list_desc *sg_list;
+	/** List of transfers for this channel, linked through sg_node */
+	struct no_os_ilist sg_list;
 	/** Channel specific interrupt line number */
 	uint32_t irq_num;
 	/** IRQ parameter for the default inter transfer handler */
@@ -131,6 +162,12 @@ struct no_os_dma_ch {
 	 * even if it's free. Used as a synchronization mechanism between channels.
 	 */
 	bool sync_lock;
+
+	/** Cyclic transfer running on this channel, NULL if none */
+	struct no_os_dma_cyclic_desc *cyclic;
+
+	/** no_os_get_cycles() at the last transfer start, for NO_OS_PROFILING */
+	uint32_t start_cycles;
 };
 
 /**
@@ -207,6 +244,11 @@ int no_os_dma_config_xfer(struct no_os_dma_desc *,
 			  uint32_t,
 			  struct no_os_dma_ch *);
 
+/** Configure a cyclic transfer with a callback for each period. */
+int no_os_dma_config_cyclic(struct no_os_dma_desc *,
+			    struct no_os_dma_cyclic_desc *,
+			    struct no_os_dma_ch *);
+
 /** Prevent a channel from being acquired, even if it's free. */
 int no_os_dma_chan_lock(struct no_os_dma_ch *);
 
@@ -253,6 +295,15 @@ struct no_os_dma_platform_ops {
 	/** Configure platform specific settings required for the current DMA transfer */
 	int (*dma_config_xfer)(struct no_os_dma_ch *,
 			       struct no_os_dma_xfer_desc *);
+	/** Configure the first periods of a cyclic transfer */
+	int (*dma_config_cyclic)(struct no_os_dma_ch *,
+				 struct no_os_dma_cyclic_desc *);
+	/**
+	 * Called after a period completed, to queue the period following the
+	 * one being transferred.
+	 */
+	int (*dma_cyclic_next)(struct no_os_dma_ch *,
+			       struct no_os_dma_cyclic_desc *);
 	/** Signal the DMA controller to start the transfer. */
 	int (*dma_xfer_start)(struct no_os_dma_desc *, struct no_os_dma_ch *);
 	/** Signal the DMA controller to stop the transfer. */
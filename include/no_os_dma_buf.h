@@ -0,0 +1,104 @@
+/***************************************************************************//**
+ *   @file   no_os_dma_buf.h
+ *   @brief  Header file for the DMA buffer allocator.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_DMA_BUF_H_
+#define _NO_OS_DMA_BUF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Alignment of DMA buffers. Covers the largest data cache line of the
+ * supported platforms, so that maintenance of one buffer never touches
+ * another.
+ */
+#define NO_OS_DMA_BUF_ALIGN	64
+
+/**
+ * @enum no_os_dma_buf_type
+ * @brief Where a DMA buffer is allocated from
+ */
+enum no_os_dma_buf_type {
+	/** Cached heap memory, kept coherent by the sync functions */
+	NO_OS_DMA_BUF_CACHED,
+	/** Non-cacheable pool, which needs no cache maintenance */
+	NO_OS_DMA_BUF_COHERENT,
+};
+
+/**
+ * @struct no_os_dma_buf
+ * @brief Buffer shared between the CPU and a DMA controller
+ */
+struct no_os_dma_buf {
+	/** Start of the buffer, aligned to NO_OS_DMA_BUF_ALIGN */
+	void *addr;
+	/** Size of the buffer, rounded up to NO_OS_DMA_BUF_ALIGN */
+	uint32_t size;
+	/** Whether the buffer comes from the non-cacheable pool */
+	bool coherent;
+	/** Start of the underlying allocation */
+	void *mem;
+};
+
+/* Provide a memory region for coherent buffers */
+int no_os_dma_buf_pool_init(void *base, uint32_t size);
+
+/* Allocate a DMA buffer */
+int no_os_dma_buf_alloc(struct no_os_dma_buf **buf, uint32_t size,
+			enum no_os_dma_buf_type type);
+
+/* Free a DMA buffer */
+int no_os_dma_buf_free(struct no_os_dma_buf *buf);
+
+/* Make the CPU writes to a part of the buffer visible to the DMA */
+void no_os_dma_buf_sync_for_device(struct no_os_dma_buf *buf,
+				   uint32_t offset, uint32_t len);
+
+/* Make the DMA writes to a part of the buffer visible to the CPU */
+void no_os_dma_buf_sync_for_cpu(struct no_os_dma_buf *buf,
+				uint32_t offset, uint32_t len);
+
+/* Platform specific: write back the data cache lines of a range */
+void no_os_dcache_flush_range(uintptr_t addr, uint32_t len);
+
+/* Platform specific: discard the data cache lines of a range */
+void no_os_dcache_invalidate_range(uintptr_t addr, uint32_t len);
+
+/* Platform specific: get a non-cacheable view of a memory region */
+void *no_os_dcache_map_uncached(void *addr, uint32_t len);
+
+#endif // _NO_OS_DMA_BUF_H_
@@ -0,0 +1,246 @@
+/***************************************************************************//**
+ *   @file   no_os_dsp.h
+ *   @brief  Header file for fixed point signal processing utilities.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_DSP_H
+#define _NO_OS_DSP_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Maximum order of a CIC decimator */
+#define NO_OS_DSP_CIC_MAX_ORDER	6
+
+/**
+ * @struct no_os_dsp_cic_config
+ * @brief Configuration of a CIC decimator (differential delay of 1)
+ */
+struct no_os_dsp_cic_config {
+	/** Number of integrator and comb sections (1 to NO_OS_DSP_CIC_MAX_ORDER) */
+	unsigned int order;
+	/** Decimation ratio, order * log2(decimation) must not exceed 32 */
+	unsigned int decimation;
+};
+
+/**
+ * @struct no_os_dsp_fir_config
+ * @brief Configuration of a block FIR filter with optional decimation
+ */
+struct no_os_dsp_fir_config {
+	/** Filter coefficients in Q15, zero taps (half-band) are skipped */
+	const int16_t *coeffs;
+	/** Number of coefficients */
+	unsigned int nb_taps;
+	/** Decimation ratio, 1 for a plain FIR */
+	unsigned int decimation;
+};
+
+/**
+ * @struct no_os_dsp_window_config
+ * @brief Configuration of a running mean and RMS window
+ */
+struct no_os_dsp_window_config {
+	/** Number of samples in the window */
+	unsigned int length;
+};
+
+struct no_os_dsp_cic;
+struct no_os_dsp_fir;
+struct no_os_dsp_window;
+
+/**
+ * @enum no_os_dsp_stage_type
+ * @brief Filter types that can be chained by no_os_dsp_scan
+ */
+enum no_os_dsp_stage_type {
+	/** CIC decimator, desc is a struct no_os_dsp_cic */
+	NO_OS_DSP_CIC,
+	/** FIR filter, desc is a struct no_os_dsp_fir */
+	NO_OS_DSP_FIR,
+	/** Running mean, desc is a struct no_os_dsp_window */
+	NO_OS_DSP_MEAN,
+	/** Running RMS, desc is a struct no_os_dsp_window */
+	NO_OS_DSP_RMS,
+};
+
+/**
+ * @struct no_os_dsp_stage
+ * @brief One filter of a processing chain
+ */
+struct no_os_dsp_stage {
+	/** Filter type */
+	enum no_os_dsp_stage_type type;
+	/** Filter descriptor */
+	void *desc;
+};
+
+/**
+ * @struct no_os_dsp_scan_config
+ * @brief Per channel processing of interleaved scans
+ *
+ * Meant to sit between a driver read and iio_buffer_push_scan(): every
+ * channel of a scan goes through its own chain of stages and a scan is passed
+ * to push once all the chains produced a sample, e.g.
+ *
+ *	.push = (int (*)(void *, int32_t *))iio_buffer_push_scan,
+ *	.arg = iio_dev_data->buffer,
+ */
+struct no_os_dsp_scan_config {
+	/** Number of channels in a scan */
+	unsigned int nb_channels;
+	/** Number of stages of each channel */
+	unsigned int nb_stages;
+	/** nb_channels * nb_stages stages, the chain of channel 0 first */
+	struct no_os_dsp_stage *stages;
+	/** Called with each processed scan */
+	int (*push)(void *arg, int32_t *scan);
+	/** First parameter of push */
+	void *arg;
+};
+
+struct no_os_dsp_scan;
+
+/** Longest frame of no_os_dsp_fft */
+#define NO_OS_DSP_FFT_MAX_LENGTH	8192
+
+/**
+ * @enum no_os_dsp_fft_window
+ * @brief Windows applied to the frames of a spectrum
+ */
+enum no_os_dsp_fft_window {
+	/** Rectangular, no window */
+	NO_OS_DSP_FFT_RECT,
+	/** Hann */
+	NO_OS_DSP_FFT_HANN,
+	/** 4 term Blackman-Harris, for the lowest leakage */
+	NO_OS_DSP_FFT_BLACKMAN_HARRIS,
+};
+
+/**
+ * @struct no_os_dsp_fft_config
+ * @brief Configuration of a magnitude spectrum
+ */
+struct no_os_dsp_fft_config {
+	/** Frame length, a power of 2 from 16 to NO_OS_DSP_FFT_MAX_LENGTH */
+	unsigned int length;
+	/** Window applied to each frame */
+	enum no_os_dsp_fft_window window;
+	/** Number of frames whose magnitudes are averaged, at least 1 */
+	unsigned int averages;
+	/**
+	 * Fractional bits of the spectrum. The samples are shifted left by
+	 * this before the transform, so it has to leave their sign bit in
+	 * place, e.g. up to 15 for 16-bit samples.
+	 */
+	unsigned int shift;
+};
+
+struct no_os_dsp_fft;
+
+/**
+ * @struct no_os_dsp_os_split
+ * @brief Split of an averaging ratio between the on-chip oversampling of a
+ * converter and a CIC decimator running on the host
+ */
+struct no_os_dsp_os_split {
+	/** On-chip oversampling index, the ratio being 1 << osr_idx */
+	unsigned int osr_idx;
+	/** Host decimation ratio, 1 if no decimator is needed */
+	unsigned int decimation;
+	/** Rate at which the converter has to be triggered */
+	uint32_t conv_rate_hz;
+};
+
+int no_os_dsp_cic_init(struct no_os_dsp_cic **cic,
+		       struct no_os_dsp_cic_config config);
+int no_os_dsp_cic_process(struct no_os_dsp_cic *cic, const int32_t *in,
+			  uint32_t nb, int32_t *out, uint32_t *nb_out);
+int no_os_dsp_cic_process16(struct no_os_dsp_cic *cic, const int16_t *in,
+			    uint32_t nb, int16_t *out, uint32_t *nb_out);
+int no_os_dsp_cic_reset(struct no_os_dsp_cic *cic);
+int no_os_dsp_cic_remove(struct no_os_dsp_cic *cic);
+
+int no_os_dsp_fir_init(struct no_os_dsp_fir **fir,
+		       struct no_os_dsp_fir_config config);
+int no_os_dsp_fir_process(struct no_os_dsp_fir *fir, const int32_t *in,
+			  uint32_t nb, int32_t *out, uint32_t *nb_out);
+int no_os_dsp_fir_process16(struct no_os_dsp_fir *fir, const int16_t *in,
+			    uint32_t nb, int16_t *out, uint32_t *nb_out);
+int no_os_dsp_fir_reset(struct no_os_dsp_fir *fir);
+int no_os_dsp_fir_remove(struct no_os_dsp_fir *fir);
+
+int no_os_dsp_window_init(struct no_os_dsp_window **win,
+			  struct no_os_dsp_window_config config);
+int no_os_dsp_window_push(struct no_os_dsp_window *win, const int32_t *in,
+			  uint32_t nb);
+int no_os_dsp_window_push16(struct no_os_dsp_window *win, const int16_t *in,
+			    uint32_t nb);
+int32_t no_os_dsp_window_mean(struct no_os_dsp_window *win);
+uint32_t no_os_dsp_window_rms(struct no_os_dsp_window *win);
+int no_os_dsp_window_reset(struct no_os_dsp_window *win);
+int no_os_dsp_window_remove(struct no_os_dsp_window *win);
+
+int no_os_dsp_stage_process(struct no_os_dsp_stage *stage, const int32_t *in,
+			    uint32_t nb, int32_t *out, uint32_t *nb_out);
+
+int no_os_dsp_scan_init(struct no_os_dsp_scan **scan,
+			struct no_os_dsp_scan_config config);
+int no_os_dsp_scan_process(struct no_os_dsp_scan *scan, const int32_t *data,
+			   uint32_t nb_scans);
+int no_os_dsp_scan_remove(struct no_os_dsp_scan *scan);
+
+int no_os_dsp_os_split(const uint32_t *tconv_ns, unsigned int nb_osr,
+		       uint32_t out_rate_hz, uint32_t ratio,
+		       uint32_t overhead_ns, struct no_os_dsp_os_split *split);
+
+int no_os_dsp_polar(const int32_t *in, uint32_t nb, int32_t *out);
+
+int no_os_dsp_fft_init(struct no_os_dsp_fft **fft,
+		       struct no_os_dsp_fft_config config);
+int no_os_dsp_fft_frame(struct no_os_dsp_fft *fft, const int32_t *in,
+			uint32_t *bins);
+int no_os_dsp_fft_push(struct no_os_dsp_fft *fft, const int32_t *in,
+		       uint32_t nb);
+int no_os_dsp_fft_push16(struct no_os_dsp_fft *fft, const int16_t *in,
+			 uint32_t nb);
+int no_os_dsp_fft_read(struct no_os_dsp_fft *fft, uint32_t *bins);
+int no_os_dsp_fft_set_window(struct no_os_dsp_fft *fft,
+			     enum no_os_dsp_fft_window window);
+int no_os_dsp_fft_set_averages(struct no_os_dsp_fft *fft,
+			       unsigned int averages);
+int no_os_dsp_fft_reset(struct no_os_dsp_fft *fft);
+int no_os_dsp_fft_remove(struct no_os_dsp_fft *fft);
+
+#endif
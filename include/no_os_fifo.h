@@ -62,6 +62,21 @@ struct no_os_fifo_element {
 	uint32_t len;
 };
 
+/**
+ * @struct no_os_fifo_ring
+ * @brief Byte FIFO stored in a caller provided contiguous buffer.
+ */
+struct no_os_fifo_ring {
+	/** Storage */
+	char *buff;
+	/** Storage size */
+	uint32_t size;
+	/** Position of the oldest byte */
+	uint32_t head;
+	/** Number of bytes in the FIFO */
+	uint32_t len;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -73,4 +88,19 @@ int32_t no_os_fifo_insert(struct no_os_fifo_element **p_fifo, char *buff,
 /* Remove fifo head. */
 struct no_os_fifo_element *no_os_fifo_remove(struct no_os_fifo_element *p_fifo);
 
+/* Initialize a ring FIFO over the given storage. */
+int32_t no_os_fifo_ring_init(struct no_os_fifo_ring *ring, char *buff,
+			     uint32_t size);
+
+/* Append a chunk to the ring FIFO tail, all or nothing. */
+int32_t no_os_fifo_ring_insert(struct no_os_fifo_ring *ring, const char *buff,
+			       uint32_t len);
+
+/* Read up to len bytes from the ring FIFO head. */
+int32_t no_os_fifo_ring_read(struct no_os_fifo_ring *ring, char *buff,
+			     uint32_t len);
+
+/* Number of bytes in the ring FIFO. */
+uint32_t no_os_fifo_ring_len(struct no_os_fifo_ring *ring);
+
 #endif // _NO_OS_FIFO_H_
@@ -112,6 +112,18 @@ struct no_os_gpio_desc {
 	void		*extra;
 };
 
+/**
+ * @struct no_os_gpio_desc_array
+ * @brief Set of GPIOs driven or read together, bit i of the values is
+ * desc[i]. Pins of the same port are accessed in a single port operation.
+ */
+struct no_os_gpio_desc_array {
+	/** GPIO descriptors */
+	struct no_os_gpio_desc **desc;
+	/** Number of descriptors, 32 at most */
+	uint32_t count;
+};
+
 /**
  * @enum no_os_gpio_values
  * @brief Enum that holds the possible output states of a GPIO.
@@ -149,6 +161,12 @@ struct no_os_gpio_platform_ops {
 	int32_t (*gpio_ops_set_value)(struct no_os_gpio_desc *, uint8_t);
 	/** gpio get value function pointer */
 	int32_t (*gpio_ops_get_value)(struct no_os_gpio_desc *, uint8_t *);
+	/** gpio port masked set value function pointer */
+	int32_t (*gpio_ops_port_set_value)(struct no_os_gpio_desc *, uint32_t,
+					   uint32_t);
+	/** gpio port masked get value function pointer */
+	int32_t (*gpio_ops_port_get_value)(struct no_os_gpio_desc *, uint32_t,
+					   uint32_t *);
 };
 
 /******************************************************************************/
@@ -185,4 +203,28 @@ int32_t no_os_gpio_set_value(struct no_os_gpio_desc *desc,
 int32_t no_os_gpio_get_value(struct no_os_gpio_desc *desc,
 			     uint8_t *value);
 
+/* Set the masked pins of the port of the specified GPIO. */
+int32_t no_os_gpio_port_set_value(struct no_os_gpio_desc *desc,
+				  uint32_t mask, uint32_t value);
+
+/* Get the masked pins of the port of the specified GPIO. */
+int32_t no_os_gpio_port_get_value(struct no_os_gpio_desc *desc,
+				  uint32_t mask, uint32_t *value);
+
+/* Obtain the descriptors of a set of GPIOs. */
+int32_t no_os_gpio_array_get(struct no_os_gpio_desc_array **array,
+			     const struct no_os_gpio_init_param *param,
+			     uint32_t count);
+
+/* Free the resources allocated by no_os_gpio_array_get(). */
+int32_t no_os_gpio_array_remove(struct no_os_gpio_desc_array *array);
+
+/* Set the values of a set of GPIOs. */
+int32_t no_os_gpio_array_set_value(struct no_os_gpio_desc_array *array,
+				   uint32_t values);
+
+/* Get the values of a set of GPIOs. */
+int32_t no_os_gpio_array_get_value(struct no_os_gpio_desc_array *array,
+				   uint32_t *values);
+
 #endif // _NO_OS_GPIO_H_
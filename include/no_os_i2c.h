@@ -52,6 +52,9 @@
 
 #define I2C_MAX_BUS_NUMBER 4
 
+/** The message reads from the slave, otherwise it writes to it */
+#define NO_OS_I2C_M_RD		0x01
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -63,6 +66,21 @@
  */
 struct no_os_i2c_platform_ops ;
 
+/**
+ * @struct no_os_i2c_msg
+ * @brief One message of a combined transfer. The messages of a transfer are
+ * joined by repeated starts and a stop condition is only generated after the
+ * last one.
+ */
+struct no_os_i2c_msg {
+	/** Data to write or buffer where to store the read data */
+	uint8_t		*buf;
+	/** Number of bytes to transfer */
+	uint32_t	len;
+	/** NO_OS_I2C_M_RD for reads, 0 for writes */
+	uint8_t		flags;
+};
+
 /**
  * @struct no_os_i2c_init_param
  * @brief Structure holding the parameters for I2C initialization.
@@ -132,6 +150,16 @@ struct no_os_i2c_platform_ops {
 	int32_t (*i2c_ops_write)(struct no_os_i2c_desc *, uint8_t *, uint8_t, uint8_t);
 	/** i2c write function pointer */
 	int32_t (*i2c_ops_read)(struct no_os_i2c_desc *, uint8_t *, uint8_t, uint8_t);
+	/** i2c combined transfer of a message list function pointer */
+	int32_t (*i2c_ops_transfer)(struct no_os_i2c_desc *, struct no_os_i2c_msg *,
+				    uint32_t);
+	/**
+	 * i2c combined transfer function pointer. Returns once the transfer
+	 * is started and invokes the callback with its result at the end.
+	 */
+	int32_t (*i2c_ops_transfer_async)(struct no_os_i2c_desc *,
+					  struct no_os_i2c_msg *, uint32_t,
+					  void (*)(void *, int32_t), void *);
 	/** i2c remove function pointer */
 	int32_t (*i2c_ops_remove)(struct no_os_i2c_desc *);
 };
@@ -159,6 +187,26 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 		       uint8_t bytes_number,
 		       uint8_t stop_bit);
 
+/* Transfer a list of messages joined by repeated starts. */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t nb_msgs);
+
+/* Write data and read the answer after a repeated start. */
+int32_t no_os_i2c_write_read(struct no_os_i2c_desc *desc,
+			     uint8_t *tx, uint32_t tx_len,
+			     uint8_t *rx, uint32_t rx_len);
+
+/*
+ * Start the transfer of a list of messages and invoke a callback with the
+ * result once it is done.
+ */
+int32_t no_os_i2c_transfer_async(struct no_os_i2c_desc *desc,
+				 struct no_os_i2c_msg *msgs,
+				 uint32_t nb_msgs,
+				 void (*callback)(void *ctx, int32_t status),
+				 void *ctx);
+
 /* Initialize I2C bus descriptor*/
 int32_t no_os_i2cbus_init(const struct no_os_i2c_init_param *param);
 
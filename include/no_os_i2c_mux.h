@@ -0,0 +1,162 @@
+/***************************************************************************//**
+ *   @file   no_os_i2c_mux.h
+ *   @brief  Header file for I2C bus multiplexers with a cached channel selection.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_I2C_MUX_H_
+#define _NO_OS_I2C_MUX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_i2c.h"
+
+/** Largest number of downstream channels of a multiplexer */
+#define NO_OS_I2C_MUX_MAX_CHANNELS	8
+
+struct no_os_i2c_mux;
+
+/**
+ * @struct no_os_i2c_mux_ops
+ * @brief Multiplexer specific operations
+ */
+struct no_os_i2c_mux_ops {
+	/**
+	 * Connect the channels set in the mask, bit n being channel n, and
+	 * disconnect the others. Called with the bus locked, the multiplexer
+	 * must be written with no_os_i2c_mux_write().
+	 */
+	int (*select)(struct no_os_i2c_mux *mux, uint32_t mask);
+};
+
+/**
+ * @struct no_os_i2c_mux_init_param
+ * @brief Parameters of an I2C multiplexer
+ */
+struct no_os_i2c_mux_init_param {
+	/** I2C descriptor of the multiplexer on the upstream bus */
+	struct no_os_i2c_desc *i2c_desc;
+	/** Number of downstream channels */
+	uint32_t nb_channels;
+	/**
+	 * Keep the connected channels when another one is needed, as long as
+	 * the addresses of their devices don't collide. Saves switches at the
+	 * cost of a larger bus capacitance.
+	 */
+	bool parallel;
+	/** Multiplexer specific operations */
+	const struct no_os_i2c_mux_ops *ops;
+	/** Multiplexer driver descriptor, for the operations */
+	void *dev;
+};
+
+/**
+ * @struct no_os_i2c_mux
+ * @brief I2C multiplexer descriptor
+ */
+struct no_os_i2c_mux {
+	/** I2C descriptor of the multiplexer on the upstream bus */
+	struct no_os_i2c_desc *i2c_desc;
+	/** Number of downstream channels */
+	uint32_t nb_channels;
+	/** Keep the channels whose addresses don't collide connected */
+	bool parallel;
+	/** Multiplexer specific operations */
+	const struct no_os_i2c_mux_ops *ops;
+	/** Multiplexer driver descriptor */
+	void *dev;
+	/** Set while connected matches the multiplexer state */
+	bool cached;
+	/** Connected channels, bit n being channel n */
+	uint32_t connected;
+	/** Slave addresses of the devices of each channel, one bit each */
+	uint32_t addrs[NO_OS_I2C_MUX_MAX_CHANNELS][8];
+	/** Number of channel selections written to the multiplexer */
+	uint32_t switches;
+};
+
+/**
+ * @struct no_os_i2c_mux_chan_init_param
+ * @brief Extra parameters of a device behind a multiplexer. The device is
+ * initialized with no_os_i2c_init(), with no_os_i2c_mux_platform_ops as
+ * platform_ops and the device_id of the upstream bus.
+ */
+struct no_os_i2c_mux_chan_init_param {
+	/** Multiplexer the device is behind */
+	struct no_os_i2c_mux *mux;
+	/** Downstream channel of the device */
+	uint32_t channel;
+	/** Platform specific functions of the upstream bus */
+	const struct no_os_i2c_platform_ops *platform_ops;
+	/** Platform specific parameters of the upstream bus */
+	void *extra;
+};
+
+/**
+ * @struct no_os_i2c_mux_xfer
+ * @brief One transfer of a no_os_i2c_mux_transfer_list() batch
+ */
+struct no_os_i2c_mux_xfer {
+	/** Descriptor of a device behind the multiplexer */
+	struct no_os_i2c_desc *desc;
+	/** Messages of the transfer */
+	struct no_os_i2c_msg *msgs;
+	/** Number of messages */
+	uint32_t nb_msgs;
+	/** Result of the transfer */
+	int32_t ret;
+};
+
+/** Platform ops of the devices behind a multiplexer */
+extern const struct no_os_i2c_platform_ops no_os_i2c_mux_platform_ops;
+
+/* Initialize an I2C multiplexer. */
+int no_os_i2c_mux_init(struct no_os_i2c_mux **mux,
+		       const struct no_os_i2c_mux_init_param *param);
+
+/* Free the resources allocated by no_os_i2c_mux_init(). */
+int no_os_i2c_mux_remove(struct no_os_i2c_mux *mux);
+
+/* Write to the multiplexer from its select operation. */
+int no_os_i2c_mux_write(struct no_os_i2c_mux *mux, uint8_t *data,
+			uint8_t bytes_number);
+
+/* Forget the cached selection, after the multiplexer was written directly. */
+void no_os_i2c_mux_invalidate(struct no_os_i2c_mux *mux);
+
+/* Run a list of transfers, grouped by channel to limit the switches. */
+int no_os_i2c_mux_transfer_list(struct no_os_i2c_mux_xfer *xfers,
+				uint32_t nb_xfers);
+
+#endif // _NO_OS_I2C_MUX_H_
@@ -0,0 +1,131 @@
+/***************************************************************************//**
+ *   @file   no_os_kv.h
+ *   @brief  Header file of the log-structured key/value store on flash.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_KV_H_
+#define _NO_OS_KV_H_
+
+#include <stdint.h>
+#include "no_os_flash.h"
+
+/** Free pages no_os_kv_gc() keeps available by default */
+#define NO_OS_KV_GC_FREE_PAGES	2
+
+/**
+ * @struct no_os_kv_init_param
+ * @brief Key/value store initialization parameters
+ */
+struct no_os_kv_init_param {
+	/** Initialized flash device */
+	struct no_os_flash_dev *flash;
+	/** Address of the first page of the store, page aligned */
+	uint32_t start_addr;
+	/** Pages used by the store, at least 2 */
+	uint32_t nb_pages;
+	/** Keys are 0 to nb_keys - 1 */
+	uint16_t nb_keys;
+	/** Largest value in bytes, a record must fit in a page */
+	uint16_t max_value_size;
+	/** no_os_kv_gc() works while fewer pages are free, 0 for default */
+	uint32_t gc_free_pages;
+};
+
+/**
+ * @struct no_os_kv_entry
+ * @brief Location of the current value of a key
+ */
+struct no_os_kv_entry {
+	/** Flash address of the record, 0xFFFFFFFF if the key is not set */
+	uint32_t addr;
+	/** Size of the value in bytes */
+	uint16_t len;
+};
+
+/**
+ * @struct no_os_kv_desc
+ * @brief Key/value store descriptor
+ */
+struct no_os_kv_desc {
+	/** Flash device */
+	struct no_os_flash_dev *flash;
+	/** Address of the first page */
+	uint32_t start_addr;
+	/** Pages used by the store */
+	uint32_t nb_pages;
+	/** Number of keys */
+	uint16_t nb_keys;
+	/** Largest value in bytes */
+	uint16_t max_value_size;
+	/** Free pages kept by no_os_kv_gc() */
+	uint32_t gc_free_pages;
+	/** Current record of each key */
+	struct no_os_kv_entry *index;
+	/** Sequence number of each page, 0xFFFFFFFF for erased pages */
+	uint32_t *page_seq;
+	/** Bytes of each page taken by outdated records */
+	uint32_t *page_dead;
+	/** Page records are appended to, nb_pages if none */
+	uint32_t head;
+	/** Offset of the next record in the head page */
+	uint32_t head_off;
+	/** Sequence number of the next page opened */
+	uint32_t next_seq;
+	/** Erased pages */
+	uint32_t nb_free;
+	/** Record staging buffer */
+	uint32_t *buf;
+	/** CRC32 lookup table */
+	const uint32_t *crc_table;
+};
+
+/* Mount a store, building the index from the records in flash. */
+int no_os_kv_init(struct no_os_kv_desc **desc,
+		  const struct no_os_kv_init_param *param);
+/* Free the resources allocated by no_os_kv_init(). */
+int no_os_kv_remove(struct no_os_kv_desc *desc);
+/* Read the value of a key. */
+int no_os_kv_read(struct no_os_kv_desc *desc, uint16_t key, void *data,
+		  uint16_t size, uint16_t *len);
+/* Append a new value of a key. */
+int no_os_kv_write(struct no_os_kv_desc *desc, uint16_t key,
+		   const void *data, uint16_t len);
+/* Delete a key. */
+int no_os_kv_delete(struct no_os_kv_desc *desc, uint16_t key);
+/* Compact at most one page when free pages run low. */
+int no_os_kv_gc(struct no_os_kv_desc *desc);
+
+#endif // _NO_OS_KV_H_
@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ *   @file   no_os_lfring.h
+ *   @brief  Lock-free ring of fixed size elements with SPSC and MPSC variants.
+********************************************************************************
+ *   @copyright
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_LFRING_H_
+#define _NO_OS_LFRING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Initialize a ring holding elements of the given type.
+ */
+#define NO_OS_LFRING_INIT(ring, type, depth, mpsc) \
+	no_os_lfring_init(ring, sizeof(type), depth, mpsc)
+
+/**
+ * @struct no_os_lfring
+ * @brief Lock-free ring of depth elements of elem_size bytes.
+ *
+ * Positions are free running counters masked on access, so depth must be a
+ * power of two. In the SPSC variant one producer and one consumer (e.g. an
+ * ISR and a task) can use the ring at the same time without locking. The MPSC
+ * variant also allows several producers, like ISRs with different priorities;
+ * it uses a compare and swap, which needs a core with exclusive access
+ * instructions (LDREX/STREX on ARMv7-M).
+ */
+struct no_os_lfring {
+	/** Memory holding the elements */
+	uint8_t *data;
+	/** Sequence number of each element. Only used by the MPSC variant */
+	uint32_t *seq;
+	/** Size of an element in bytes */
+	uint32_t elem_size;
+	/** depth - 1 */
+	uint32_t mask;
+	/** Next position to write */
+	uint32_t head;
+	/** Next position to read */
+	uint32_t tail;
+	/** Set if several producers can push */
+	bool mpsc;
+	/** Set when data and seq were allocated by no_os_lfring_init */
+	bool allocated;
+};
+
+/* Initialize and allocate a ring. */
+int no_os_lfring_init(struct no_os_lfring **ring, uint32_t elem_size,
+		      uint32_t depth, bool mpsc);
+/* Initialize a SPSC ring in user provided memory of depth * elem_size bytes. */
+int no_os_lfring_cfg(struct no_os_lfring *ring, void *buf, uint32_t elem_size,
+		     uint32_t depth);
+/* Free the resources allocated by no_os_lfring_init. */
+void no_os_lfring_remove(struct no_os_lfring *ring);
+/* Push up to nb_elems elements. Returns the number of pushed elements. */
+uint32_t no_os_lfring_push(struct no_os_lfring *ring, const void *elems,
+			   uint32_t nb_elems);
+/* Pop up to nb_elems elements. Returns the number of popped elements. */
+uint32_t no_os_lfring_pop(struct no_os_lfring *ring, void *elems,
+			  uint32_t nb_elems);
+/* Number of elements in the ring. */
+uint32_t no_os_lfring_count(struct no_os_lfring *ring);
+/* Drop all the elements. Must be called from the consumer. */
+void no_os_lfring_flush(struct no_os_lfring *ring);
+
+#endif
@@ -96,6 +96,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -324,4 +325,134 @@ int32_t no_os_list_get_find(struct no_os_list_desc *list_desc, void **data,
 			    void *cmp_data);
 /** @}*/
 
+/**
+ * @name Intrusive list
+ * The links live inside the user structure, so adding and removing elements
+ * never allocates memory and both are O(1). Safe to use from interrupt
+ * context as long as the accesses are not concurrent.
+ * @code{.c}
+ *	struct my_item {
+ *		uint32_t value;
+ *		struct no_os_ilist_node node;
+ *	};
+ *	struct no_os_ilist list;
+ *	struct no_os_ilist_node *n;
+ *	struct my_item a = {.value = 1};
+ *
+ *	no_os_ilist_init(&list);
+ *	no_os_ilist_add_last(&list, &a.node);
+ *	no_os_ilist_for_each(&list, n)
+ *		printf("%d\n", NO_OS_ILIST_ENTRY(n, struct my_item, node)->value);
+ *	no_os_ilist_del(&list, &a.node);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @struct no_os_ilist_node
+ * @brief Link to embed in the structures stored in a \ref no_os_ilist
+ */
+struct no_os_ilist_node {
+	/** Previous node. The list head for the first node */
+	struct no_os_ilist_node	*prev;
+	/** Next node. The list head for the last node */
+	struct no_os_ilist_node	*next;
+};
+
+/**
+ * @struct no_os_ilist
+ * @brief Circular intrusive list with a sentinel node
+ */
+struct no_os_ilist {
+	/** Sentinel node */
+	struct no_os_ilist_node	head;
+	/** Number of elements in the list */
+	uint32_t		nb_elements;
+};
+
+/** Get the structure of type in which member is the node */
+#define NO_OS_ILIST_ENTRY(node, type, member) \
+	((type *)((char *)(node) - offsetof(type, member)))
+
+/** Iterate over the nodes of the list. The node can't be removed */
+#define no_os_ilist_for_each(list, node) \
+	for ((node) = (list)->head.next; (node) != &(list)->head; \
+	     (node) = (node)->next)
+
+/* Initialize an empty list. Also drops all the elements of a list. */
+static inline void no_os_ilist_init(struct no_os_ilist *list)
+{
+	list->head.prev = &list->head;
+	list->head.next = &list->head;
+	list->nb_elements = 0;
+}
+
+static inline bool no_os_ilist_is_empty(struct no_os_ilist *list)
+{
+	return list->head.next == &list->head;
+}
+
+/* Insert node between prev and next */
+static inline void no_os_ilist_insert(struct no_os_ilist *list,
+				      struct no_os_ilist_node *node,
+				      struct no_os_ilist_node *prev,
+				      struct no_os_ilist_node *next)
+{
+	node->prev = prev;
+	node->next = next;
+	prev->next = node;
+	next->prev = node;
+	list->nb_elements++;
+}
+
+static inline void no_os_ilist_add_first(struct no_os_ilist *list,
+		struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert(list, node, &list->head, list->head.next);
+}
+
+static inline void no_os_ilist_add_last(struct no_os_ilist *list,
+					struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert(list, node, list->head.prev, &list->head);
+}
+
+/* Remove a node that is in the list */
+static inline void no_os_ilist_del(struct no_os_ilist *list,
+				   struct no_os_ilist_node *node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->prev = NULL;
+	node->next = NULL;
+	list->nb_elements--;
+}
+
+/* First node of the list or NULL if the list is empty */
+static inline struct no_os_ilist_node *no_os_ilist_first(
+	struct no_os_ilist *list)
+{
+	return no_os_ilist_is_empty(list) ? NULL : list->head.next;
+}
+
+/* Last node of the list or NULL if the list is empty */
+static inline struct no_os_ilist_node *no_os_ilist_last(
+	struct no_os_ilist *list)
+{
+	return no_os_ilist_is_empty(list) ? NULL : list->head.prev;
+}
+
+/* Remove and return the first node of the list or NULL if it is empty */
+static inline struct no_os_ilist_node *no_os_ilist_get_first(
+	struct no_os_ilist *list)
+{
+	struct no_os_ilist_node *node = no_os_ilist_first(list);
+
+	if (node)
+		no_os_ilist_del(list, node);
+
+	return node;
+}
+/** @}*/
+
 #endif // _NO_OS_LIST_H_
@@ -0,0 +1,131 @@
+/***************************************************************************//**
+ *   @file   no_os_log.h
+ *   @brief  Header file for the deferred binary log.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_LOG_H_
+#define _NO_OS_LOG_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/** Maximum number of arguments of a deferred log call */
+#define NO_OS_LOG_MAX_ARGS	6
+
+/** First byte of a record sent by no_os_log_drain() */
+#define NO_OS_LOG_SYNC		0xA5
+/** Format ID of the record reporting the number of dropped records */
+#define NO_OS_LOG_DROPPED_ID	0xFFFFFFFF
+
+#define NO_OS_LOG_STR_(x)	#x
+#define NO_OS_LOG_STR(x)	NO_OS_LOG_STR_(x)
+
+/*
+ * Convert an argument to a 32 bit word: integers and pointers are cast,
+ * float and double are stored as the bits of a float. 64 bit integers are
+ * truncated.
+ */
+#define NO_OS_LOG_ARG(x) _Generic((x),					\
+	float: no_os_log_float_bits(_Generic((x), float: (x),		\
+					     double: (x), default: 0.0)),	\
+	double: no_os_log_float_bits(_Generic((x), float: (x),		\
+					      double: (x), default: 0.0)),	\
+	default: (uint32_t)(uintptr_t)(x))
+
+#define NO_OS_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, n, ...)	n
+#define NO_OS_LOG_NARGS(args...) \
+	NO_OS_LOG_NARGS_(_0, ##args, 6, 5, 4, 3, 2, 1, 0)
+
+#define NO_OS_LOG_MAP_0()
+#define NO_OS_LOG_MAP_1(a)		NO_OS_LOG_ARG(a)
+#define NO_OS_LOG_MAP_2(a, args...)	NO_OS_LOG_ARG(a), NO_OS_LOG_MAP_1(args)
+#define NO_OS_LOG_MAP_3(a, args...)	NO_OS_LOG_ARG(a), NO_OS_LOG_MAP_2(args)
+#define NO_OS_LOG_MAP_4(a, args...)	NO_OS_LOG_ARG(a), NO_OS_LOG_MAP_3(args)
+#define NO_OS_LOG_MAP_5(a, args...)	NO_OS_LOG_ARG(a), NO_OS_LOG_MAP_4(args)
+#define NO_OS_LOG_MAP_6(a, args...)	NO_OS_LOG_ARG(a), NO_OS_LOG_MAP_5(args)
+#define NO_OS_LOG_MAP__(n, args...)	NO_OS_LOG_MAP_##n(args)
+#define NO_OS_LOG_MAP_(n, args...)	NO_OS_LOG_MAP__(n, args)
+#define NO_OS_LOG_MAP(args...)		NO_OS_LOG_MAP_(NO_OS_LOG_NARGS(args), args)
+
+/*
+ * Log a string literal format and up to NO_OS_LOG_MAX_ARGS arguments
+ * without formatting them. The format is placed in the .no_os_log_fmt
+ * section, which tools/scripts/no_os_log.ld keeps out of the loaded image,
+ * and its offset in that section is the ID of the record. %s arguments are
+ * logged as pointers since the strings are not copied.
+ */
+#define NO_OS_LOG(fmt, args...) do {					\
+	static const char _no_os_log_fmt[]				\
+	__attribute__((section(".no_os_log_fmt"), used)) = fmt;	\
+	const uint32_t _no_os_log_args[] = {0, NO_OS_LOG_MAP(args)};	\
+	no_os_log_push((uint32_t)(uintptr_t)_no_os_log_fmt,		\
+		       &_no_os_log_args[1], NO_OS_LOG_NARGS(args));	\
+} while (0)
+
+/**
+ * @struct no_os_log_record
+ * @brief Log call queued until no_os_log_drain()
+ */
+struct no_os_log_record {
+	/** Offset of the format in the .no_os_log_fmt section */
+	uint32_t fmt;
+	/** Number of arguments */
+	uint32_t nargs;
+	/** Arguments converted by NO_OS_LOG_ARG() */
+	uint32_t args[NO_OS_LOG_MAX_ARGS];
+};
+
+/* Bits of a float, used for the floating point arguments. */
+static inline uint32_t no_os_log_float_bits(float f)
+{
+	uint32_t bits;
+
+	memcpy(&bits, &f, sizeof(bits));
+
+	return bits;
+}
+
+/* Allocate the queue of depth records, a power of two. */
+int no_os_log_init(uint32_t depth);
+/* Free the queue. Records logged afterwards are dropped. */
+void no_os_log_remove(void);
+/* Queue a record, safe from any interrupt priority. */
+void no_os_log_push(uint32_t fmt, const uint32_t *args, uint32_t nargs);
+/* Send the queued records through write, from a low priority context. */
+int no_os_log_drain(int32_t (*write)(void *ctx, const void *buf,
+				     uint32_t len), void *ctx);
+
+#endif // _NO_OS_LOG_H_
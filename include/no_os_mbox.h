@@ -0,0 +1,124 @@
+/***************************************************************************//**
+ *   @file   no_os_mbox.h
+ *   @brief  Header file of the shared memory inter-core mailbox.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_MBOX_H_
+#define _NO_OS_MBOX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_lfring.h"
+#include "no_os_section.h"
+
+/*
+ * Mailbox between the two cores of a dual core chip, e.g. the ARM and RISC-V
+ * cores of the MAX78000 and MAX32655, made of two SPSC no_os_lfring, one per
+ * direction. The mailbox and its buffers live in memory seen at the same
+ * address by both cores (see NO_OS_SHARED), and both images are built with
+ * this file.
+ *
+ * Typical split, with the RISC-V core acquiring and the ARM core serving IIO:
+ * - ARM: no_os_mbox_init(&mbox, &ep, ...), then MXC_SYS_RISCVRun() to start
+ *   the RISC-V core, then no_os_mbox_recv() of the samples, e.g. from the
+ *   read_dev or submit callback of the IIO device.
+ * - RISC-V: no_os_mbox_attach(&mbox, &ep) until it returns 0, then the SPI
+ *   acquisition loop pushes the samples with no_os_mbox_send() and takes the
+ *   commands of the ARM core (rate, start, stop) with no_os_mbox_recv().
+ * The doorbell of an endpoint can raise an interrupt on the other core, e.g.
+ * through the semaphore peripheral, otherwise the receiver polls.
+ */
+
+#define NO_OS_MBOX_MAGIC	0x584f424d /* "MBOX" */
+
+/**
+ * @struct no_os_mbox
+ * @brief Mailbox shared by the two cores.
+ */
+struct no_os_mbox {
+	/** NO_OS_MBOX_MAGIC once initialized by the owner core */
+	uint32_t magic;
+	/** Set once the remote core attached */
+	uint32_t attached;
+	/** Written by the owner core, read by the remote core */
+	struct no_os_lfring to_remote;
+	/** Written by the remote core, read by the owner core */
+	struct no_os_lfring to_owner;
+};
+
+/**
+ * @struct no_os_mbox_ep
+ * @brief View of the mailbox from one core, local to that core.
+ */
+struct no_os_mbox_ep {
+	/** Ring written by this core */
+	struct no_os_lfring *tx;
+	/** Ring read by this core */
+	struct no_os_lfring *rx;
+	/** Optional, called after elements were sent to signal the other core */
+	void (*doorbell)(void *ctx);
+	/** Parameter of doorbell */
+	void *doorbell_ctx;
+};
+
+/* Define a mailbox of depth elements of type in each direction, in the
+   NO_OS_SHARED section. */
+#define NO_OS_MBOX_DEFINE(_name, _type, _depth) \
+	NO_OS_SHARED struct no_os_mbox _name; \
+	NO_OS_SHARED _type _name##_to_remote_buf[_depth]; \
+	NO_OS_SHARED _type _name##_to_owner_buf[_depth]
+
+/* Initialize the mailbox, from the core that owns it. */
+int no_os_mbox_init(struct no_os_mbox *mbox, struct no_os_mbox_ep *ep,
+		    void *to_remote_buf, void *to_owner_buf,
+		    uint32_t elem_size, uint32_t depth);
+
+/* Attach to a mailbox from the remote core, -EAGAIN until it is ready. */
+int no_os_mbox_attach(struct no_os_mbox *mbox, struct no_os_mbox_ep *ep);
+
+/* Check whether the remote core attached, from the owner core. */
+bool no_os_mbox_attached(struct no_os_mbox *mbox);
+
+/* Send up to nb elements. Returns the number of elements sent. */
+uint32_t no_os_mbox_send(struct no_os_mbox_ep *ep, const void *elems,
+			 uint32_t nb);
+
+/* Receive up to nb elements. Returns the number of elements received. */
+uint32_t no_os_mbox_recv(struct no_os_mbox_ep *ep, void *elems, uint32_t nb);
+
+/* Number of elements waiting to be received. */
+uint32_t no_os_mbox_count(struct no_os_mbox_ep *ep);
+
+#endif // _NO_OS_MBOX_H_
@@ -89,6 +89,19 @@ struct no_os_mdio_desc {
 	void *extra;
 };
 
+/**
+ * @struct no_os_mdio_xfer
+ * @brief One register access of a no_os_mdio_transfer() batch.
+ */
+struct no_os_mdio_xfer {
+	/** Register address, as for no_os_mdio_read() and no_os_mdio_write(). */
+	uint32_t reg;
+	/** Value to write, or value read. */
+	uint16_t val;
+	/** Write val into the register, otherwise read the register into val. */
+	bool write;
+};
+
 /**
  * @struct no_os_mdio_ops
  * @brief Collection of MDIO ops that point to specific implementations.
@@ -100,6 +113,9 @@ struct no_os_mdio_ops {
 	int (*write)(struct no_os_mdio_desc *, uint32_t, uint16_t);
 	/** MDIO read register op */
 	int (*read)(struct no_os_mdio_desc *, uint32_t, uint16_t *);
+	/** MDIO batch of register accesses op, optional */
+	int (*transfer)(struct no_os_mdio_desc *, struct no_os_mdio_xfer *,
+			uint32_t);
 	/** MDIO remove op */
 	int (*remove)(struct no_os_mdio_desc *);
 };
@@ -109,5 +125,7 @@ int no_os_mdio_init(struct no_os_mdio_desc **desc,
 int no_os_mdio_remove(struct no_os_mdio_desc *desc);
 int no_os_mdio_write(struct no_os_mdio_desc *desc, uint32_t reg, uint16_t val);
 int no_os_mdio_read(struct no_os_mdio_desc *desc, uint32_t reg, uint16_t *val);
+int no_os_mdio_transfer(struct no_os_mdio_desc *desc,
+			struct no_os_mdio_xfer *xfers, uint32_t nb);
 
 #endif
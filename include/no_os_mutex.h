@@ -39,6 +39,20 @@
 #ifndef _NO_OS_MUTEX_H_
 #define _NO_OS_MUTEX_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @struct no_os_spinlock
+ * @brief Lock protecting short sections shared with interrupt handlers.
+ */
+struct no_os_spinlock {
+	/** Lock is held */
+	volatile bool locked;
+};
+
+#define NO_OS_SPINLOCK_INIT	{ .locked = false }
+
 /**
 * @brief Function for no-os mutex initialization and thread safety.
 * This function is implemented based on different platforms/OS libraries
@@ -81,4 +95,59 @@ void no_os_mutex_unlock(void *mutex);
 */
 void no_os_mutex_remove(void *mutex);
 
+/*
+ * Locks of the SPI and I2C buses and of the UARTs, taken around each transfer.
+ * A build with a single thread of execution may drop them with BUS_MUTEX=n.
+ */
+#ifdef NO_OS_NO_BUS_MUTEX
+#define no_os_bus_lock(mutex)		do {} while (0)
+#define no_os_bus_unlock(mutex)		do {} while (0)
+#else
+#define no_os_bus_lock(mutex)		no_os_mutex_lock(mutex)
+#define no_os_bus_unlock(mutex)		no_os_mutex_unlock(mutex)
+#endif
+
+/**
+ * @brief Enter a critical section, masking the interrupts.
+ * The function is safe to call from interrupt context and can be nested, the
+ * returned state has to be passed to the matching no_os_critical_exit(). The
+ * default implementation masks the interrupts on Cortex-M, RTOS backends
+ * replace it with their own critical section.
+ * @return The interrupt state before entering the critical section.
+ */
+uint32_t no_os_critical_enter(void);
+
+/**
+ * @brief Exit a critical section entered with no_os_critical_enter().
+ * @param state - The value returned by no_os_critical_enter().
+ */
+void no_os_critical_exit(uint32_t state);
+
+/**
+ * @brief Sleep until an interrupt is pending. Meant to be called inside a
+ * critical section after checking that there is no work left: a pending
+ * interrupt still ends the sleep and is served on no_os_critical_exit(), so
+ * no wake up is lost. The default implementation is WFI on Cortex-M and
+ * returns immediately elsewhere, platforms may replace it with a deeper
+ * low-power mode.
+ */
+void no_os_wait_for_interrupt(void);
+
+/**
+ * @brief Take a spinlock with the interrupts masked.
+ * Unlike the mutex, the spinlock can be taken from interrupt handlers and
+ * never sleeps, so it is meant for sections of a few instructions such as
+ * updating a descriptor shared with an ISR.
+ * @param lock - The spinlock.
+ * @return The interrupt state to pass to no_os_spin_unlock_irqrestore().
+ */
+uint32_t no_os_spin_lock_irqsave(struct no_os_spinlock *lock);
+
+/**
+ * @brief Release a spinlock taken with no_os_spin_lock_irqsave().
+ * @param lock - The spinlock.
+ * @param state - The value returned by no_os_spin_lock_irqsave().
+ */
+void no_os_spin_unlock_irqrestore(struct no_os_spinlock *lock, uint32_t state);
+
 #endif // _NO_OS_MUTEX_H_
@@ -82,4 +82,38 @@ int no_os_pid_hysteresis(struct no_os_pid *pid, unsigned int hyst);
 int no_os_pid_reset(struct no_os_pid *pid);
 int no_os_pid_remove(struct no_os_pid *pid);
 
+/**
+ * @struct no_os_pid_q15_config
+ * @brief Configuration of one loop of a fixed point PID bank
+ *
+ * Set point, process variable and output are Q15 fractions of the full scale
+ * of the loop. The gains are Q15 too, 32768 being a gain of 1, and the
+ * integral and derivative gains apply per update, at the rate the bank is
+ * updated.
+ */
+struct no_os_pid_q15_config {
+	/** Proportional gain */
+	int32_t Kp;
+	/** Integral gain */
+	int32_t Ki;
+	/** Derivative gain, applied to the change of the process variable */
+	int32_t Kd;
+	/** Low limit of the output */
+	int16_t out_min;
+	/** High limit of the output */
+	int16_t out_max;
+};
+
+struct no_os_pid_bank;
+
+int no_os_pid_bank_init(struct no_os_pid_bank **bank,
+			const struct no_os_pid_q15_config *config,
+			unsigned int nb_loops);
+int no_os_pid_bank_tune(struct no_os_pid_bank *bank, unsigned int loop,
+			const struct no_os_pid_q15_config *config);
+void no_os_pid_bank_update(struct no_os_pid_bank *bank, const int16_t *SP,
+			   const int16_t *PV, int16_t *output);
+int no_os_pid_bank_reset(struct no_os_pid_bank *bank);
+int no_os_pid_bank_remove(struct no_os_pid_bank *bank);
+
 #endif
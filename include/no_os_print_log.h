@@ -63,74 +63,78 @@
 #define pr_time			;
 #endif
 
-#if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_EMERG && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_emerg(fmt, args...) do {							\
+/*
+ * With NO_OS_LOG_DEFERRED (LOG_DEFERRED=y) the messages are queued in binary
+ * form by NO_OS_LOG() and formatted later by the host, see no_os_log.h. The
+ * format must then be a string literal and the location is logged as
+ * file:line, without the function name.
+ */
+#if defined(NO_OS_LOG_DEFERRED)
+#include "no_os_log.h"
+
+#define pr_log_loc(tag, fmt, args...) \
+	NO_OS_LOG(tag ": " __FILE__ ":" NO_OS_LOG_STR(__LINE__) ": " fmt, ##args)
+#define pr_log(tag, fmt, args...)	NO_OS_LOG(tag fmt, ##args)
+#define pr_log_plain(fmt, args...)	NO_OS_LOG(fmt, ##args)
+#else
+#define pr_log_loc(tag, fmt, args...) do {					\
 	pr_time										\
-	printf("EMERG: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
+	printf(tag ": %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
+} while (0)
+#define pr_log(tag, fmt, args...) do {	\
+	pr_time				\
+	printf(tag fmt, ##args);	\
 } while (0)
+#define pr_log_plain(fmt, args...) do {	\
+	pr_time				\
+	printf(fmt, ##args);		\
+} while (0)
+#endif
+
+#if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_EMERG && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
+#define pr_emerg(fmt, args...)	pr_log_loc("EMERG", fmt, ##args)
 #else
 #define pr_emerg(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_ALERT && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_alert(fmt, args...) do {							\
-	pr_time										\
-	printf("ALERT: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
-} while (0)
+#define pr_alert(fmt, args...)	pr_log_loc("ALERT", fmt, ##args)
 #else
 #define pr_alert(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_CRIT && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_crit(fmt, args...) do { 						\
-	pr_time									\
-	printf("CRIT: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
-} while (0)
+#define pr_crit(fmt, args...)	pr_log_loc("CRIT", fmt, ##args)
 #else
 #define pr_crit(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_ERR && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_err(fmt, args...) do {						\
-	pr_time									\
-	printf("ERR: %s:%d:%s(): " fmt, __FILE__, __LINE__, __func__, ##args);	\
-} while (0)
+#define pr_err(fmt, args...)	pr_log_loc("ERR", fmt, ##args)
 #else
 #define pr_err(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_WARNING && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_warning(fmt, args...) do {		\
-	pr_time					\
-	printf("WARNING: " fmt, ##args);	\
-} while (0)
+#define pr_warning(fmt, args...)	pr_log("WARNING: ", fmt, ##args)
 #else
 #define pr_warning(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_NOTICE && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_notice(fmt, args...) do {	\
-	pr_time				\
-	printf("NOTICE: " fmt, ##args);	\
-} while (0)
+#define pr_notice(fmt, args...)	pr_log("NOTICE: ", fmt, ##args)
 #else
 #define pr_notice(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL >= NO_OS_LOG_INFO && NO_OS_LOG_LEVEL <= NO_OS_LOG_DEBUG
-#define pr_info(fmt, args...) do {	\
-	pr_time 			\
-	printf(fmt, ##args);		\
-} while(0)
+#define pr_info(fmt, args...)	pr_log_plain(fmt, ##args)
 #else
 #define pr_info(fmt, args...)
 #endif
 
 #if defined(NO_OS_LOG_LEVEL) && NO_OS_LOG_LEVEL == NO_OS_LOG_DEBUG
-#define pr_debug(fmt, args...) do {	\
-	pr_time				\
-	printf("DEBUG: " fmt, ##args);	\
-} while(0)
+#define pr_debug(fmt, args...)	pr_log("DEBUG: ", fmt, ##args)
 #else
 #define pr_debug(fmt, args...)
 #endif
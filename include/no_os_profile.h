@@ -0,0 +1,130 @@
+/***************************************************************************//**
+ *   @file   no_os_profile.h
+ *   @brief  Cycle counter and code region profiling
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_PROFILE_H_
+#define _NO_OS_PROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Bins of a region histogram. Bin 0 counts the samples of 0 cycles and bin i
+ * those of [2^(i-1), 2^i) cycles, the last bin also counts the longer ones.
+ */
+#define NO_OS_PROFILE_HIST_BINS		32
+
+/**
+ * @struct no_os_profile
+ * @brief Statistics of a profiled code region, in cycles of the counter
+ * returned by no_os_get_cycles().
+ */
+struct no_os_profile {
+	/** Region name */
+	const char *name;
+	/** Number of samples */
+	uint32_t count;
+	/** Shortest sample */
+	uint32_t min;
+	/** Longest sample */
+	uint32_t max;
+	/** Sum of the samples */
+	uint64_t total;
+	/** Counter value at no_os_profile_start() */
+	uint32_t start;
+	/** NO_OS_PROFILE_HIST_BINS samples counters, NULL for no histogram */
+	uint32_t *hist;
+	/** Region is in the list reported by no_os_profile_show() */
+	bool listed;
+	/** Next region in the list */
+	struct no_os_profile *next;
+};
+
+#define NO_OS_PROFILE_INIT(_name)	{ .name = (_name), .min = UINT32_MAX }
+#define NO_OS_PROFILE_INIT_HIST(_name, _hist) \
+	{ .name = (_name), .min = UINT32_MAX, .hist = (_hist) }
+
+#ifdef NO_OS_PROFILING
+/* Define a named profiling region. */
+#define NO_OS_PROFILE_DEFINE(_var) \
+	struct no_os_profile _var = NO_OS_PROFILE_INIT(#_var)
+
+#define NO_OS_PROFILE_START(_var)	no_os_profile_start(&(_var))
+#define NO_OS_PROFILE_STOP(_var)	no_os_profile_stop(&(_var))
+
+/* Profile the rest of the enclosing scope as region _name. */
+#define NO_OS_PROFILE_SCOPE(_name) \
+	static struct no_os_profile _name##_profile = \
+		NO_OS_PROFILE_INIT(#_name); \
+	struct no_os_profile *_name##_profile_scope \
+		__attribute__((cleanup(no_os_profile_scope_exit))) = \
+		no_os_profile_scope_enter(&_name##_profile)
+#else
+#define NO_OS_PROFILE_DEFINE(_var)	struct no_os_profile _var
+#define NO_OS_PROFILE_START(_var)	do {} while (0)
+#define NO_OS_PROFILE_STOP(_var)	do {} while (0)
+#define NO_OS_PROFILE_SCOPE(_name)	do {} while (0)
+#endif
+
+/* Free running cycle counter, wraps around at 32 bits. */
+uint32_t no_os_get_cycles(void);
+
+/* Frequency of the cycle counter in Hz. */
+uint32_t no_os_get_cycles_freq(void);
+
+/* Convert a number of cycles to nanoseconds. */
+uint64_t no_os_cycles_to_ns(uint32_t cycles);
+
+/* Start a sample of a profiling region. */
+void no_os_profile_start(struct no_os_profile *prof);
+
+/* End the sample started by no_os_profile_start(). */
+void no_os_profile_stop(struct no_os_profile *prof);
+
+/* Add a sample measured by the caller to a profiling region. */
+void no_os_profile_add(struct no_os_profile *prof, uint32_t cycles);
+
+/* Clear the samples of all the regions. */
+void no_os_profile_reset(void);
+
+/* Print min/max/avg in nanoseconds of every region, and the histograms. */
+int no_os_profile_show(char *buf, uint32_t len);
+
+/* Used by NO_OS_PROFILE_SCOPE(). */
+struct no_os_profile *no_os_profile_scope_enter(struct no_os_profile *prof);
+void no_os_profile_scope_exit(struct no_os_profile **prof);
+
+#endif // _NO_OS_PROFILE_H_
@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ *   @file   no_os_reg_seq.h
+ *   @brief  Header file for the register sequence writer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_REG_SEQ_H
+#define _NO_OS_REG_SEQ_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_spi.h"
+
+/**
+ * @struct no_os_reg_seq
+ * @brief One register write of an initialization table
+ */
+struct no_os_reg_seq {
+	/** Register address */
+	uint16_t reg;
+	/** Register value */
+	uint8_t val;
+};
+
+/**
+ * @struct no_os_reg_seq_config
+ * @brief Describes how a device accepts streaming register writes
+ */
+struct no_os_reg_seq_config {
+	/** SPI descriptor of the device */
+	struct no_os_spi_desc *spi;
+	/** Number of instruction bytes sent before the register data */
+	uint8_t cmd_size;
+	/** Fill in the write instruction of a transfer starting at reg */
+	void (*format_cmd)(uint16_t reg, uint8_t *cmd);
+	/**
+	 * Maximum number of registers written in a single transfer. Use 1 for
+	 * devices without address auto-increment.
+	 */
+	uint16_t max_burst;
+	/**
+	 * True when the device decrements the address after each data byte,
+	 * as in the default streaming mode of the ADI SPI register map.
+	 */
+	bool descending;
+};
+
+int no_os_reg_seq_write(const struct no_os_reg_seq_config *cfg,
+			const struct no_os_reg_seq *seq, uint32_t nb_seq);
+
+#endif
@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.h
+ *   @brief  Header file for the register map cache utility.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_REGMAP_H
+#define _NO_OS_REGMAP_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @enum no_os_regmap_cache_mode
+ * @brief When writes to cached registers reach the device
+ */
+enum no_os_regmap_cache_mode {
+	/** Each write goes to the device and to the cache */
+	NO_OS_REGMAP_WRITE_THROUGH,
+	/** Writes only update the cache, until no_os_regmap_sync() is called */
+	NO_OS_REGMAP_WRITE_BACK,
+};
+
+/**
+ * @struct no_os_regmap_config
+ * @brief Configuration of a register map
+ */
+struct no_os_regmap_config {
+	/** Highest register address. The cache covers addresses 0 to max_reg */
+	uint32_t max_reg;
+	/** Write policy for the cached registers */
+	enum no_os_regmap_cache_mode mode;
+	/**
+	 * (Optional) Returns true for registers changed by the device itself,
+	 * such as status or data registers, which are never cached. If NULL,
+	 * all registers are cached.
+	 */
+	bool (*volatile_reg)(uint32_t reg);
+	/** Read a register from the device */
+	int (*reg_read)(void *dev, uint32_t reg, uint32_t *val);
+	/** Write a register of the device */
+	int (*reg_write)(void *dev, uint32_t reg, uint32_t val);
+	/** Device parameter for the read and write functions */
+	void *dev;
+};
+
+struct no_os_regmap;
+
+int no_os_regmap_init(struct no_os_regmap **map,
+		      struct no_os_regmap_config config);
+int no_os_regmap_read(struct no_os_regmap *map, uint32_t reg, uint32_t *val);
+int no_os_regmap_write(struct no_os_regmap *map, uint32_t reg, uint32_t val);
+int no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t mask, uint32_t val);
+int no_os_regmap_sync(struct no_os_regmap *map);
+int no_os_regmap_cache_drop(struct no_os_regmap *map);
+int no_os_regmap_remove(struct no_os_regmap *map);
+
+#endif
@@ -0,0 +1,141 @@
+/***************************************************************************//**
+ *   @file   no_os_sar_stream.h
+ *   @brief  Header file for timer paced SAR ADC acquisition.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_SAR_STREAM_H_
+#define _NO_OS_SAR_STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_spi.h"
+#include "no_os_pwm.h"
+
+/** Largest SPI frame read for one sample */
+#define NO_OS_SAR_STREAM_MAX_FRAME	4
+
+/**
+ * @struct no_os_sar_stream_init_param
+ * @brief Parameters of a timer paced SAR ADC acquisition
+ */
+struct no_os_sar_stream_init_param {
+	/** SPI descriptor of the ADC, owned by the driver */
+	struct no_os_spi_desc *spi_desc;
+	/**
+	 * PWM generating the conversion start signal. Its period and duty cycle
+	 * are set from sample_rate_hz and cnv_high_ns. On parts where the SPI
+	 * chip select starts the conversion it only serves as timebase.
+	 */
+	struct no_os_pwm_init_param *cnv_pwm_init;
+	/** Sample rate, in Hz */
+	uint32_t sample_rate_hz;
+	/** Time the conversion start signal is held high, in ns */
+	uint32_t cnv_high_ns;
+	/** Bytes read for one sample, up to NO_OS_SAR_STREAM_MAX_FRAME */
+	uint8_t frame_bytes;
+	/** Value clocked out on SDI while reading a sample */
+	uint8_t frame_tx[NO_OS_SAR_STREAM_MAX_FRAME];
+	/** Optional frame sent after each read to start the next conversion */
+	uint8_t cnv_cmd[NO_OS_SAR_STREAM_MAX_FRAME];
+	/** Size of cnv_cmd, 0 if unused */
+	uint8_t cnv_cmd_bytes;
+	/**
+	 * Number of reads to drop after start, for parts returning the result
+	 * of the previous conversion
+	 */
+	uint8_t discard;
+	/** Ring buffer, nb_blocks * block_samples * frame_bytes large */
+	uint8_t *ring;
+	/** Number of samples in a block */
+	uint32_t block_samples;
+	/** Number of blocks in the ring, at least 2 */
+	uint32_t nb_blocks;
+};
+
+/**
+ * @struct no_os_sar_stream
+ * @brief Timer paced SAR ADC acquisition descriptor
+ */
+struct no_os_sar_stream {
+	/** SPI descriptor of the ADC */
+	struct no_os_spi_desc *spi_desc;
+	/** Conversion start PWM */
+	struct no_os_pwm_desc *cnv_pwm;
+	/** Read and optional conversion start messages */
+	struct no_os_spi_msg msgs[2];
+	/** Number of messages sent on each tick */
+	uint32_t nb_msgs;
+	/** Value clocked out on SDI while reading a sample */
+	uint8_t frame_tx[NO_OS_SAR_STREAM_MAX_FRAME];
+	/** Conversion start frame */
+	uint8_t cnv_cmd[NO_OS_SAR_STREAM_MAX_FRAME];
+	/** Ring buffer */
+	uint8_t *ring;
+	/** Bytes read for one sample */
+	uint32_t frame_bytes;
+	/** Number of samples in a block */
+	uint32_t block_samples;
+	/** Number of blocks in the ring */
+	uint32_t nb_blocks;
+	/** Number of completed blocks */
+	volatile uint32_t wr;
+	/** Sample index in the block being filled */
+	volatile uint32_t idx;
+	/** Number of consumed blocks */
+	uint32_t rd;
+	/** Set while a read is in flight */
+	volatile bool busy;
+	/** Set while the caller holds the block returned by the last read */
+	bool held;
+	/** Reads still to be dropped */
+	volatile uint32_t discard;
+	/** Number of ticks dropped because a read was in flight or the ring full */
+	uint32_t overruns;
+};
+
+/* Start a timer paced acquisition. */
+int no_os_sar_stream_init(struct no_os_sar_stream **stream,
+			  const struct no_os_sar_stream_init_param *param);
+
+/* Read the last conversion, to be called on each conversion tick. */
+int no_os_sar_stream_trigger(struct no_os_sar_stream *stream);
+
+/* Get the oldest complete block. */
+int no_os_sar_stream_read(struct no_os_sar_stream *stream, uint8_t **block);
+
+/* Stop the acquisition and free its resources. */
+int no_os_sar_stream_remove(struct no_os_sar_stream *stream);
+
+#endif // _NO_OS_SAR_STREAM_H_
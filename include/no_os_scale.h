@@ -0,0 +1,105 @@
+/***************************************************************************//**
+ *   @file   no_os_scale.h
+ *   @brief  Header file for fixed point conversion of ADC codes.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_SCALE_H
+#define _NO_OS_SCALE_H
+#include <stdint.h>
+
+/**
+ * @struct no_os_scale
+ * @brief Fixed point conversion of a code: ((code + offset) * mult) >> shift
+ *
+ * Filled by no_os_scale_set() when the range, gain or reference of a channel
+ * changes, so that conversions need neither divisions nor floating point.
+ */
+struct no_os_scale {
+	/** Added to the code before the multiplication */
+	int32_t offset;
+	/** Multiplier, normalized to 2^30 <= |mult| < 2^31 when possible */
+	int32_t mult;
+	/** Right shift applied to the product */
+	uint8_t shift;
+};
+
+/**
+ * @struct no_os_scale_lut
+ * @brief Piecewise linear conversion, for the sensors that are not linear
+ *
+ * The breakpoints are spaced by 2^shift input units from x0, so that the
+ * segment of an input is found with a shift. Halving the spacing divides the
+ * interpolation error by about four for twice the table size. Tables are
+ * const, generated by tools/scripts/pwl_table.py, so they stay in flash.
+ */
+struct no_os_scale_lut {
+	/** Output at each breakpoint */
+	const int32_t *y;
+	/** Number of breakpoints, at least 2 */
+	uint32_t nb;
+	/** Input at the first breakpoint */
+	int32_t x0;
+	/** log2 of the breakpoint spacing */
+	uint8_t shift;
+};
+
+int no_os_scale_set(struct no_os_scale *scale, int32_t num, uint32_t den,
+		    int32_t offset);
+int32_t no_os_scale_lut_apply(const struct no_os_scale_lut *lut, int32_t x);
+
+/**
+ * @brief Convert one code.
+ * @param scale - Scale computed by no_os_scale_set()
+ * @param code - Code to convert
+ * @return The converted value, rounded to nearest.
+ */
+static inline int32_t no_os_scale_apply(const struct no_os_scale *scale,
+					int32_t code)
+{
+	int64_t val = ((int64_t)code + scale->offset) * scale->mult;
+
+	if (scale->shift)
+		val += 1LL << (scale->shift - 1);
+
+	return (int32_t)(val >> scale->shift);
+}
+
+int no_os_scale_buffer(const struct no_os_scale *scale, const int32_t *in,
+		       int32_t *out, uint32_t nb);
+int no_os_scale_scans(const struct no_os_scale *scales,
+		      uint32_t nb_channels, const int32_t *in, int32_t *out,
+		      uint32_t nb_scans);
+
+#endif
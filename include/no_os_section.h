@@ -0,0 +1,80 @@
+/***************************************************************************//**
+ *   @file   no_os_section.h
+ *   @brief  Code and data placement attributes
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_SECTION_H_
+#define _NO_OS_SECTION_H_
+
+/*
+ * NO_OS_RAMFUNC places a function in a section that the startup code of the
+ * platform copies from flash to SRAM, so it runs without flash wait states:
+ * .RamFunc in the STM32CubeMX linker scripts, .flashprog in the Maxim SDK
+ * ones and .time_critical in the Pico SDK one. The functions are not inlined,
+ * so their callers may stay in flash. It is only applied when building with
+ * NO_OS_RAMFUNCS defined (RAMFUNCS=y), since it costs SRAM, and it is empty
+ * on the other platforms, which do not execute from flash.
+ *
+ * NO_OS_FASTDATA places a variable in NO_OS_FASTDATA_SECTION, when the
+ * project defines it together with a matching linker script output section,
+ * e.g. for a tightly coupled memory. Otherwise it is empty.
+ *
+ * NO_OS_SHARED places a variable in NO_OS_SHARED_SECTION, an output section
+ * that the linker scripts of the images of both cores of a dual core chip
+ * place at the same SRAM address, e.g. for a no_os_mbox.
+ */
+#if defined(NO_OS_RAMFUNCS) && defined(STM32_PLATFORM)
+#define NO_OS_RAMFUNC	__attribute__((section(".RamFunc"), noinline))
+#elif defined(NO_OS_RAMFUNCS) && defined(MAXIM_PLATFORM)
+#define NO_OS_RAMFUNC	__attribute__((section(".flashprog"), noinline))
+#elif defined(NO_OS_RAMFUNCS) && defined(PICO_PLATFORM)
+#define NO_OS_RAMFUNC	__attribute__((section(".time_critical.no_os"), noinline))
+#else
+#define NO_OS_RAMFUNC
+#endif
+
+#ifdef NO_OS_FASTDATA_SECTION
+#define NO_OS_FASTDATA	__attribute__((section(NO_OS_FASTDATA_SECTION)))
+#else
+#define NO_OS_FASTDATA
+#endif
+
+#ifdef NO_OS_SHARED_SECTION
+#define NO_OS_SHARED	__attribute__((section(NO_OS_SHARED_SECTION)))
+#else
+#define NO_OS_SHARED
+#endif
+
+#endif // _NO_OS_SECTION_H_
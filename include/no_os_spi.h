@@ -45,6 +45,8 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "no_os_counter.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -53,6 +55,8 @@
 #define	NO_OS_SPI_CPHA	0x01
 #define	NO_OS_SPI_CPOL	0x02
 #define SPI_MAX_BUS_NUMBER 8
+/* Number of messages handed to one DMA transfer by no_os_spi_write_chunked(). */
+#define NO_OS_SPI_CHUNKED_MSGS 8
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -84,6 +88,28 @@ enum no_os_spi_bit_order {
 	NO_OS_SPI_BIT_ORDER_LSB_FIRST = 1,
 };
 
+/**
+ * @enum no_os_spi_lane_format
+ * @brief How a device spreads one data word over several SDO lanes.
+ */
+enum no_os_spi_lane_format {
+	/** Bits are dealt in turn, lane 0 carrying the MSB */
+	NO_OS_SPI_LANES_BIT_INTERLEAVED,
+	/** Each lane carries a contiguous slice, lane 0 carrying the MSBs */
+	NO_OS_SPI_LANES_WORD_SLICED,
+};
+
+/**
+ * @enum no_os_spi_speed
+ * @brief Speed profile of a SPI device, selected with no_os_spi_set_speed().
+ */
+enum no_os_spi_speed {
+	/** Register accesses, at the init max_speed_hz */
+	NO_OS_SPI_SPEED_CONFIG,
+	/** Data reads, at data_speed_hz (max_speed_hz if not set) */
+	NO_OS_SPI_SPEED_DATA,
+};
+
 /**
  * @struct no_os_spi_msg_list
  * @brief List item describing a SPI transfer
@@ -133,6 +159,8 @@ struct no_os_spi_init_param {
 	uint32_t	device_id;
 	/** maximum transfer speed */
 	uint32_t	max_speed_hz;
+	/** Speed of the data profile, 0 to use max_speed_hz */
+	uint32_t	data_speed_hz;
 	/** SPI chip select */
 	uint8_t		chip_select;
 	/** SPI mode */
@@ -147,6 +175,31 @@ struct no_os_spi_init_param {
 	struct no_os_spi_desc *parent;
 };
 
+/**
+ * @struct no_os_spi_request
+ * @brief Asynchronous request, queued on the bus of its SPI device
+ */
+struct no_os_spi_request {
+	/** SPI descriptor of the device */
+	struct no_os_spi_desc *desc;
+	/** Messages to transfer. Must be valid until the request is done */
+	struct no_os_spi_msg *msgs;
+	/** Number of messages */
+	uint32_t len;
+	/** Higher priority requests are served first, equal ones in order */
+	uint8_t priority;
+	/** Called once the request is done, may be NULL */
+	void (*complete)(struct no_os_spi_request *, void *);
+	/** Parameter for the complete callback */
+	void *ctx;
+	/** Result of the transfer, valid once done is set */
+	int32_t status;
+	/** Set once the request is done */
+	volatile bool done;
+	/** Next request in the bus queue. Used internally */
+	struct no_os_spi_request *next;
+};
+
 /**
  * @struct no_os_spibus_desc
  * @brief SPI bus descriptor
@@ -168,6 +221,12 @@ struct no_os_spibus_desc {
 	const struct no_os_spi_platform_ops *platform_ops;
 	/** SPI bus extra */
 	void		*extra;
+	/** Pending requests, sorted by priority */
+	struct no_os_spi_request	*queue;
+	/** Set while the queued requests are being served */
+	volatile bool	queue_busy;
+	/** Transfers made on the bus, counted when built with NO_OS_COUNTERS */
+	struct no_os_counter	xfers;
 };
 
 /**
@@ -179,8 +238,12 @@ struct no_os_spi_desc {
 	struct no_os_spibus_desc	*bus;
 	/** SPI bus number (0 for SPI0, 1 for SPI1, ...) */
 	uint32_t	device_id;
-	/** maximum transfer speed */
+	/** maximum transfer speed, the one of the active speed profile */
 	uint32_t	max_speed_hz;
+	/** Speed of the config profile */
+	uint32_t	config_speed_hz;
+	/** Speed of the data profile, 0 to use config_speed_hz */
+	uint32_t	data_speed_hz;
 	/** SPI chip select */
 	uint8_t		chip_select;
 	/** SPI mode */
@@ -195,6 +258,22 @@ struct no_os_spi_desc {
 	struct no_os_spi_desc *parent;
 };
 
+/**
+ * @struct no_os_spi_seq
+ * @brief Message sequence validated and translated once by
+ * no_os_spi_seq_init(), then replayed as many times as needed.
+ */
+struct no_os_spi_seq {
+	/** SPI descriptor the sequence runs on */
+	struct no_os_spi_desc *desc;
+	/** Messages of the sequence. Must be valid until the sequence is removed */
+	struct no_os_spi_msg *msgs;
+	/** Number of messages */
+	uint32_t len;
+	/** Platform specific translation of the messages */
+	void *extra;
+};
+
 /**
  * @struct no_os_spi_platform_ops
  * @brief Structure holding SPI function pointers that point to the platform
@@ -218,6 +297,21 @@ struct no_os_spi_platform_ops {
 	 */
 	int32_t (*dma_transfer_async)(struct no_os_spi_desc *, struct no_os_spi_msg *,
 				      uint32_t, void (*)(void *), void *);
+	/** Build the platform descriptors of a message sequence */
+	int32_t (*seq_prepare)(struct no_os_spi_seq *);
+	/**
+	 * Replay a prepared sequence. Blocks until done if the callback is
+	 * NULL, otherwise returns once started and invokes the callback
+	 * at the end.
+	 */
+	int32_t (*seq_run)(struct no_os_spi_seq *, void (*)(void *), void *);
+	/** Free the platform descriptors of a message sequence */
+	int32_t (*seq_release)(struct no_os_spi_seq *);
+	/**
+	 * Apply a new speed to the next transfers. Fails if the speed is
+	 * below the slowest the dividers can reach.
+	 */
+	int32_t (*set_speed)(struct no_os_spi_desc *, uint32_t);
 	/** SPI remove function pointer */
 	int32_t (*remove)(struct no_os_spi_desc *);
 };
@@ -257,6 +351,40 @@ int32_t no_os_spi_transfer_dma_async(struct no_os_spi_desc *desc,
 				     void (*callback)(void *),
 				     void *ctx);
 
+/* Write a buffer as chip select framed chunks, by DMA when available. */
+int32_t no_os_spi_write_chunked(struct no_os_spi_desc *desc, uint8_t *data,
+				uint32_t len, uint32_t max_chunk);
+
+/* Queue a request on the bus of its device, served by priority. */
+int32_t no_os_spi_submit(struct no_os_spi_request *req);
+
+/* Validate a message sequence and prepare it for replay. */
+int32_t no_os_spi_seq_init(struct no_os_spi_seq **seq,
+			   struct no_os_spi_desc *desc,
+			   struct no_os_spi_msg *msgs,
+			   uint32_t len);
+
+/* Replay a sequence and wait until all messages are done. */
+int32_t no_os_spi_seq_run(struct no_os_spi_seq *seq);
+
+/* Start replaying a sequence and invoke a callback when it's done. */
+int32_t no_os_spi_seq_run_async(struct no_os_spi_seq *seq,
+				void (*callback)(void *),
+				void *ctx);
+
+/* Free the resources allocated by no_os_spi_seq_init(). */
+int32_t no_os_spi_seq_remove(struct no_os_spi_seq *seq);
+
+/* Switch the device to the rate of a speed profile. */
+int32_t no_os_spi_set_speed(struct no_os_spi_desc *desc,
+			    enum no_os_spi_speed speed);
+
+/* Rebuild data words received on several SDO lanes. */
+void no_os_spi_lanes_deinterleave(uint32_t *dst, const uint32_t *src,
+				  uint32_t nb_words, uint8_t nb_lanes,
+				  uint8_t lane_bits,
+				  enum no_os_spi_lane_format format);
+
 /* Initialize SPI bus descriptor*/
 int32_t no_os_spibus_init(const struct no_os_spi_init_param *param);
 
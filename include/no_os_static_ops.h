@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ *   @file   no_os_static_ops.h
+ *   @brief  Platform ops of the peripheral APIs resolved at compile time.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_STATIC_OPS_H_
+#define _NO_OS_STATIC_OPS_H_
+
+/*
+ * A build using a single platform driver for a peripheral type may name it at
+ * compile time, with STATIC_PLATFORM_OPS=y and a no_os_platform_config.h in
+ * the include path of the project, e.g. for a STM32 build:
+ *
+ *	#include "stm32_spi.h"
+ *	#include "stm32_gpio.h"
+ *	#define NO_OS_SPI_PLATFORM_OPS	stm32_spi_ops
+ *	#define NO_OS_GPIO_PLATFORM_OPS	stm32_gpio_ops
+ *
+ * NO_OS_SPI_PLATFORM_OPS, NO_OS_I2C_PLATFORM_OPS, NO_OS_GPIO_PLATFORM_OPS and
+ * NO_OS_UART_PLATFORM_OPS are each optional, a peripheral type left out keeps
+ * the platform_ops of its descriptors. For the named ones the API calls the
+ * ops structure directly instead of loading it from the descriptor, which LTO
+ * turns into direct calls inlined in the drivers. The init functions then
+ * reject a descriptor using other ops with -EINVAL.
+ */
+#ifdef NO_OS_STATIC_PLATFORM_OPS
+#include "no_os_platform_config.h"
+#endif
+
+#endif // _NO_OS_STATIC_OPS_H_
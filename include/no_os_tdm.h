@@ -85,6 +85,15 @@ struct no_os_tdm_init_param {
 	void (*rx_complete_callback)(void *rx_arg);
 	/** DMA receive Half complete callback **/
 	void (*rx_half_complete_callback)(void *rx_arg);
+	/**
+	 * Keep the DMA receiving into the buffer given to no_os_tdm_read()
+	 * until no_os_tdm_stop(), using it as a ping-pong buffer: the half
+	 * complete and complete callbacks signal that the first or the second
+	 * half is ready and has to be consumed before the DMA wraps around.
+	 * Reception errors restart the DMA without reinitializing the
+	 * peripheral.
+	 */
+	bool rx_continuous;
 	/** Platform operation function pointers */
 	const struct no_os_tdm_platform_ops *platform_ops;
 	/**  TDM extra parameters (platform specific) */
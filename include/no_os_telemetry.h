@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ *   @file   no_os_telemetry.h
+ *   @brief  Double buffered telemetry snapshots of monitoring devices.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_TELEMETRY_H_
+#define _NO_OS_TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_work.h"
+
+/**
+ * @struct no_os_telemetry_ops
+ * @brief Telemetry operations of a monitoring device driver
+ */
+struct no_os_telemetry_ops {
+	/**
+	 * Read all the values of the device, in as few bus transfers as it
+	 * allows. The meaning and order of the values is defined by the
+	 * driver, e.g. enum adp1050_telemetry_val.
+	 */
+	int (*refresh)(void *dev, int32_t *vals);
+};
+
+/**
+ * @struct no_os_telemetry_init_param
+ * @brief Parameters of a telemetry snapshot
+ */
+struct no_os_telemetry_init_param {
+	/** Driver operations, e.g. adp1050_telemetry_ops */
+	const struct no_os_telemetry_ops *ops;
+	/** Driver descriptor */
+	void *dev;
+	/** Number of values, as defined by the driver */
+	uint32_t nb_vals;
+	/** Optional, queue on which no_os_telemetry_schedule() refreshes */
+	struct no_os_workqueue *wq;
+	/** Priority of the refresh work */
+	uint8_t prio;
+};
+
+/**
+ * @struct no_os_telemetry
+ * @brief Telemetry snapshot. The snapshot of buf[seq & 1] is published while
+ * the next one is read into the other buffer, so readers never wait for the
+ * bus and never see a snapshot being refreshed.
+ */
+struct no_os_telemetry {
+	/** Driver operations */
+	const struct no_os_telemetry_ops *ops;
+	/** Driver descriptor */
+	void *dev;
+	/** Number of values of a snapshot */
+	uint32_t nb_vals;
+	/** The two snapshots */
+	int32_t *buf[2];
+	/** Number of snapshots published, 0 until the first refresh */
+	uint32_t seq;
+	/** Refreshes that failed, the previous snapshot stays published */
+	uint32_t errors;
+	/** Error of the last refresh */
+	int last_err;
+	/** Queue of the scheduled refreshes */
+	struct no_os_workqueue *wq;
+	/** Scheduled refresh */
+	struct no_os_work work;
+};
+
+/* Allocate a telemetry snapshot. */
+int no_os_telemetry_init(struct no_os_telemetry **tlm,
+			 const struct no_os_telemetry_init_param *param);
+
+/* Read the device and publish a new snapshot. */
+int no_os_telemetry_refresh(struct no_os_telemetry *tlm);
+
+/* Queue a refresh on the work queue, safe from interrupts. */
+int no_os_telemetry_schedule(struct no_os_telemetry *tlm);
+
+/* Get a value of the published snapshot, without bus traffic. */
+int no_os_telemetry_get(struct no_os_telemetry *tlm, uint32_t idx,
+			int32_t *val);
+
+/* Copy the published snapshot, without bus traffic. */
+int no_os_telemetry_read(struct no_os_telemetry *tlm, int32_t *vals,
+			 uint32_t *seq);
+
+/* Free the resources allocated by no_os_telemetry_init(). */
+int no_os_telemetry_remove(struct no_os_telemetry *tlm);
+
+#endif // _NO_OS_TELEMETRY_H_
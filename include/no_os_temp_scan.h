@@ -0,0 +1,124 @@
+/***************************************************************************//**
+ *   @file   no_os_temp_scan.h
+ *   @brief  Header file for the bulk acquisition of temperature sensors.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_TEMP_SCAN_H_
+#define _NO_OS_TEMP_SCAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_circular_buffer.h"
+
+/**
+ * @struct no_os_temp_scan_ops
+ * @brief Conversion operations of a temperature sensor driver
+ */
+struct no_os_temp_scan_ops {
+	/**
+	 * Start a conversion and set the time it takes, in us. Sensors that
+	 * convert continuously start nothing and set 0.
+	 */
+	int (*start)(void *dev, uint32_t *conv_us);
+	/**
+	 * Read the result of the conversion, in millidegree Celsius unless
+	 * the driver documents another unit.
+	 */
+	int (*read)(void *dev, int32_t *val);
+};
+
+/**
+ * @struct no_os_temp_scan_sensor
+ * @brief Sensor of a scan
+ */
+struct no_os_temp_scan_sensor {
+	/** Driver operations, e.g. adt7420_temp_scan_ops */
+	const struct no_os_temp_scan_ops *ops;
+	/** Driver descriptor */
+	void *dev;
+};
+
+/**
+ * @struct no_os_temp_scan_init_param
+ * @brief Parameters of a temperature scan
+ */
+struct no_os_temp_scan_init_param {
+	/** Sensors, copied by no_os_temp_scan_init() */
+	const struct no_os_temp_scan_sensor *sensors;
+	/** Number of sensors */
+	uint32_t nb_sensors;
+	/**
+	 * Buffer where each scan is written as nb_sensors int32_t values,
+	 * e.g. the one of an IIO device. Optional.
+	 */
+	struct no_os_circular_buffer *buf;
+};
+
+/**
+ * @struct no_os_temp_scan
+ * @brief Temperature scan descriptor
+ */
+struct no_os_temp_scan {
+	/** Sensors */
+	struct no_os_temp_scan_sensor *sensors;
+	/** Number of sensors */
+	uint32_t nb_sensors;
+	/** Values of the last scan, one per sensor */
+	int32_t *values;
+	/** Result of the last scan of each sensor, 0 or a negative error */
+	int *status;
+	/** Number of scans done, incremented once values are updated */
+	volatile uint32_t count;
+	/** Buffer where each scan is written, optional */
+	struct no_os_circular_buffer *buf;
+	/** Number of scans that overwrote unread data of buf */
+	uint32_t overruns;
+};
+
+/* Allocate a temperature scan. */
+int no_os_temp_scan_init(struct no_os_temp_scan **scan,
+			 const struct no_os_temp_scan_init_param *param);
+
+/* Convert all the sensors together and read them. */
+int no_os_temp_scan_run(struct no_os_temp_scan *scan);
+
+/* Get the last value of a sensor. */
+int no_os_temp_scan_get(struct no_os_temp_scan *scan, uint32_t sensor,
+			int32_t *val);
+
+/* Free the resources allocated by no_os_temp_scan_init(). */
+int no_os_temp_scan_remove(struct no_os_temp_scan *scan);
+
+#endif // _NO_OS_TEMP_SCAN_H_
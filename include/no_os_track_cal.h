@@ -0,0 +1,186 @@
+/***************************************************************************//**
+ *   @file   no_os_track_cal.h
+ *   @brief  Header file for the scheduling of transceiver tracking calibrations.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_TRACK_CAL_H_
+#define _NO_OS_TRACK_CAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Most tracking calibrations of a scheduler, one bit of a mask each */
+#define NO_OS_TRACK_CAL_MAX	32
+
+/**
+ * @struct no_os_track_cal_ops
+ * @brief Tracking calibration operations of a transceiver driver
+ */
+struct no_os_track_cal_ops {
+	/**
+	 * Let the calibrations of mask run, or hold them off when run is
+	 * false. The calibrations out of mask are left as they are.
+	 */
+	int (*run)(void *dev, uint32_t mask, bool run);
+	/**
+	 * Get the calibrations that have work in progress, i.e. the ones the
+	 * ARM still has to run, and the ones that reported an error.
+	 */
+	int (*status)(void *dev, uint32_t *busy, uint32_t *err);
+};
+
+/**
+ * @enum no_os_track_cal_mode
+ * @brief When the calibrations are let run
+ */
+enum no_os_track_cal_mode {
+	/** Whenever the ARM schedules them, unless paused */
+	NO_OS_TRACK_CAL_FREE_RUN,
+	/** Only in the windows opened by no_os_track_cal_window_open() */
+	NO_OS_TRACK_CAL_WINDOWED,
+};
+
+/**
+ * @struct no_os_track_cal_init_param
+ * @brief Parameters of a tracking calibration scheduler
+ */
+struct no_os_track_cal_init_param {
+	/** Driver operations, e.g. adrv9025_track_cal_ops */
+	const struct no_os_track_cal_ops *ops;
+	/** Driver descriptor */
+	void *dev;
+	/** Calibrations scheduled, they must be enabled on the device */
+	uint32_t mask;
+	/** Name of the calibration of each bit, e.g. adrv9025_track_cal_names */
+	const char * const *names;
+	/** Scheduling mode */
+	enum no_os_track_cal_mode mode;
+};
+
+/**
+ * @struct no_os_track_cal_stats
+ * @brief Counters of a tracking calibration. The times are measured between
+ * the status reads of the scheduler, poll it in long windows for a finer
+ * resolution.
+ */
+struct no_os_track_cal_stats {
+	/** Runs completed, the calibration was seen done after being busy */
+	uint32_t runs;
+	/** Times it was held off while busy, by a window end or a pause */
+	uint32_t deferred;
+	/** Errors reported by the device */
+	uint32_t errors;
+	/** Time busy while let run, in ns */
+	uint64_t busy_ns;
+	/** Longest run, in ns */
+	uint64_t max_ns;
+	/** Time busy in the run in progress, in ns */
+	uint64_t cur_ns;
+};
+
+/**
+ * @struct no_os_track_cal
+ * @brief Tracking calibration scheduler descriptor
+ */
+struct no_os_track_cal {
+	/** Driver operations */
+	const struct no_os_track_cal_ops *ops;
+	/** Driver descriptor */
+	void *dev;
+	/** Calibrations scheduled */
+	uint32_t mask;
+	/** Name of the calibration of each bit */
+	const char * const *names;
+	/** Scheduling mode */
+	enum no_os_track_cal_mode mode;
+	/** Calibrations let run */
+	uint32_t running;
+	/** Busy calibrations at the last status read */
+	uint32_t busy;
+	/** Errored calibrations at the last status read */
+	uint32_t err;
+	/** no_os_get_cycles() at the last status read */
+	uint32_t last;
+	/** Nesting of no_os_track_cal_pause() */
+	uint32_t paused;
+	/** A window is open */
+	bool window;
+	/** no_os_get_cycles() at the opening of the window */
+	uint32_t window_start;
+	/** Windows opened */
+	uint32_t windows;
+	/** Windows opened while paused, the calibrations were not let run */
+	uint32_t skipped;
+	/** Pauses, the nested ones are not counted */
+	uint32_t pauses;
+	/** Time the windows were open, in ns */
+	uint64_t window_ns;
+	/** Counters of each calibration, by bit */
+	struct no_os_track_cal_stats stats[NO_OS_TRACK_CAL_MAX];
+	/** Serializes the calls, e.g. the IIO ones and the application ones */
+	void *lock;
+};
+
+/* Allocate a scheduler, hold off the calibrations in windowed mode. */
+int no_os_track_cal_init(struct no_os_track_cal **desc,
+			 const struct no_os_track_cal_init_param *param);
+
+/* Let the calibrations run until no_os_track_cal_window_close(). */
+int no_os_track_cal_window_open(struct no_os_track_cal *desc);
+
+/* Hold off the calibrations opened by no_os_track_cal_window_open(). */
+int no_os_track_cal_window_close(struct no_os_track_cal *desc);
+
+/* Hold off the calibrations, e.g. before a critical capture. */
+int no_os_track_cal_pause(struct no_os_track_cal *desc);
+
+/* Undo a no_os_track_cal_pause(). */
+int no_os_track_cal_resume(struct no_os_track_cal *desc);
+
+/* Read the status of the calibrations to update their counters. */
+int no_os_track_cal_poll(struct no_os_track_cal *desc);
+
+/* Get the counters of the calibration of a bit. */
+int no_os_track_cal_get_stats(struct no_os_track_cal *desc, uint32_t cal,
+			      struct no_os_track_cal_stats *stats);
+
+/* Clear the counters. */
+int no_os_track_cal_reset_stats(struct no_os_track_cal *desc);
+
+/* Let the calibrations run freely and free the scheduler. */
+int no_os_track_cal_remove(struct no_os_track_cal *desc);
+
+#endif // _NO_OS_TRACK_CAL_H_
@@ -0,0 +1,116 @@
+/***************************************************************************//**
+ *   @file   no_os_trng_pool.h
+ *   @brief  Header file of the buffered entropy pool and DRBG over a TRNG.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_TRNG_POOL_H_
+#define _NO_OS_TRNG_POOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_trng.h"
+#include "no_os_lfring.h"
+
+/* Bytes of hardware entropy kept in the pool, a power of two */
+#ifndef NO_OS_TRNG_POOL_SIZE
+#define NO_OS_TRNG_POOL_SIZE		256
+#endif
+/* Bytes generated by the DRBG before it is reseeded from the pool */
+#ifndef NO_OS_TRNG_POOL_RESEED
+#define NO_OS_TRNG_POOL_RESEED		4096
+#endif
+/* Bytes read from the hardware TRNG in one call of the refill */
+#ifndef NO_OS_TRNG_POOL_CHUNK
+#define NO_OS_TRNG_POOL_CHUNK		32
+#endif
+
+#define NO_OS_TRNG_POOL_SEED_SIZE	32
+
+/**
+ * @struct no_os_trng_pool_init_param
+ * @brief Parameters of the pool, given in no_os_trng_init_param.extra with
+ * no_os_trng_pool_ops as platform ops.
+ */
+struct no_os_trng_pool_init_param {
+	/** Hardware TRNG feeding the pool */
+	const struct no_os_trng_init_param *trng;
+};
+
+/**
+ * @struct no_os_trng_pool_stats
+ * @brief Counters of the pool.
+ */
+struct no_os_trng_pool_stats {
+	/** Bytes read from the hardware TRNG */
+	uint32_t hw_bytes;
+	/** Reseeds of the DRBG */
+	uint32_t reseeds;
+	/** Reseeds which had to wait for the hardware, the pool being short */
+	uint32_t waits;
+	/** Refills skipped because the hardware was in use */
+	uint32_t busy;
+};
+
+/**
+ * @struct no_os_trng_pool
+ * @brief Pool of hardware entropy and ChaCha20 DRBG serving the requests.
+ */
+struct no_os_trng_pool {
+	/** Hardware TRNG */
+	struct no_os_trng_desc *trng;
+	/** Entropy read ahead from the hardware */
+	struct no_os_lfring *ring;
+	/** Set while the hardware TRNG is read */
+	volatile bool hw_busy;
+	/** DRBG key, replaced after each request */
+	uint32_t key[8];
+	/** Bytes generated since the last reseed */
+	uint32_t generated;
+	/** Serializes the requests */
+	void *lock;
+	struct no_os_trng_pool_stats stats;
+};
+
+/* TRNG platform ops serving the requests from the pool and the DRBG */
+extern const struct no_os_trng_platform_ops no_os_trng_pool_ops;
+
+/* Read hardware entropy into the pool, up to max bytes or until full if 0. */
+int no_os_trng_pool_refill(struct no_os_trng_desc *desc, uint32_t max);
+/* Get the counters of the pool. */
+int no_os_trng_pool_get_stats(struct no_os_trng_desc *desc,
+			      struct no_os_trng_pool_stats *stats);
+
+#endif
@@ -176,6 +176,17 @@ struct no_os_uart_platform_ops {
 	uint32_t (*get_errors)(struct no_os_uart_desc *);
 };
 
+/**
+ * @enum no_os_uart_stdio_overflow
+ * @brief What a write to the buffered stdout does when the buffer is full.
+ */
+enum no_os_uart_stdio_overflow {
+	/** Drop the bytes which don't fit, counted by no_os_uart_stdio_dropped() */
+	NO_OS_UART_STDIO_DROP,
+	/** Wait for the UART to drain the buffer */
+	NO_OS_UART_STDIO_BLOCK
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -210,4 +221,22 @@ uint32_t no_os_uart_get_errors(struct no_os_uart_desc *desc);
 /* Make stdio to use this UART. */
 void no_os_uart_stdio(struct no_os_uart_desc *desc);
 
+/* Buffer the stdout written to this UART, drained by write_nonblocking. */
+int32_t no_os_uart_stdio_buffered(struct no_os_uart_desc *desc, uint8_t *buf,
+				  uint32_t size,
+				  enum no_os_uart_stdio_overflow overflow);
+
+/* Write stdout data, buffered if enabled for the UART. */
+int32_t no_os_uart_stdio_write(struct no_os_uart_desc *desc,
+			       const uint8_t *data, uint32_t bytes_number);
+
+/* Start sending the buffered stdout, from the TX done interrupt or a loop. */
+int32_t no_os_uart_stdio_poll(void);
+
+/* Send all the buffered stdout, blocking. */
+int32_t no_os_uart_stdio_flush(void);
+
+/* Number of stdout bytes dropped because the buffer was full. */
+uint32_t no_os_uart_stdio_dropped(void);
+
 #endif // _NO_OS_UART_H_
@@ -202,4 +202,16 @@ uint64_t no_os_mul_u64_u32_shr(uint64_t a, uint32_t mul, unsigned int shift);
 bool no_os_is_big_endian(void);
 void no_os_memswap64(void *buf, uint32_t bytes, uint32_t step);
 
+/* Bulk versions of the helpers above, nb is the number of samples. */
+void no_os_get_unaligned_be16_array(const uint8_t *buf, uint32_t *vals,
+				    uint32_t nb);
+void no_os_get_unaligned_be24_array(const uint8_t *buf, uint32_t *vals,
+				    uint32_t nb);
+void no_os_get_unaligned_be32_array(const uint8_t *buf, uint32_t *vals,
+				    uint32_t nb);
+void no_os_sign_extend32_array(uint32_t *vals, uint32_t nb, int index);
+void no_os_field_get_array(uint32_t mask, uint32_t *vals, uint32_t nb);
+void no_os_bswap16_array(uint16_t *vals, uint32_t nb);
+void no_os_bswap32_array(uint32_t *vals, uint32_t nb);
+
 #endif // _NO_OS_UTIL_H_
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ *   @file   no_os_wavegen.h
+ *   @brief  Header file of the DDS waveform generator.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_WAVEGEN_H
+#define _NO_OS_WAVEGEN_H
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Most tones summed by a generator */
+#define NO_OS_WAVEGEN_MAX_TONES	4
+
+/** Phase of a quarter turn, phases and tuning words are 2^32 per turn */
+#define NO_OS_WAVEGEN_PHASE_90	0x40000000u
+
+/**
+ * @enum no_os_wavegen_mode
+ * @brief Waveform made by a generator
+ */
+enum no_os_wavegen_mode {
+	/** Sum of up to NO_OS_WAVEGEN_MAX_TONES sines */
+	NO_OS_WAVEGEN_TONES,
+	/** Linear frequency sweep, restarted when the stop frequency is reached */
+	NO_OS_WAVEGEN_CHIRP,
+};
+
+/**
+ * @struct no_os_wavegen_tone
+ * @brief One sine of a multi-tone waveform
+ */
+struct no_os_wavegen_tone {
+	/** Phase increment per sample, see no_os_wavegen_ftw() */
+	uint32_t ftw;
+	/** Phase of the first sample */
+	uint32_t phase;
+	/** Amplitude in Q15 of the full scale */
+	uint16_t amplitude;
+};
+
+/**
+ * @struct no_os_wavegen_chirp
+ * @brief Linear frequency sweep
+ */
+struct no_os_wavegen_chirp {
+	/** Tuning word at the start of the sweep */
+	uint32_t start_ftw;
+	/** Tuning word at the end of the sweep, below start_ftw for a down sweep */
+	uint32_t stop_ftw;
+	/** Change of the tuning word per sample, in the direction of stop_ftw */
+	uint32_t rate;
+	/** Amplitude in Q15 of the full scale */
+	uint16_t amplitude;
+};
+
+/**
+ * @struct no_os_wavegen_config
+ * @brief Configuration of a waveform generator
+ *
+ * Samples are written as 16-bit two's complement values, full scale being
+ * +/-32767. DACs with fewer bits or offset binary codes are served by
+ * shifting the samples right and by flipping their sign bit.
+ */
+struct no_os_wavegen_config {
+	/** Waveform */
+	enum no_os_wavegen_mode mode;
+	/** Number of tones used in NO_OS_WAVEGEN_TONES mode */
+	unsigned int nb_tones;
+	/** Tones of NO_OS_WAVEGEN_TONES mode */
+	struct no_os_wavegen_tone tones[NO_OS_WAVEGEN_MAX_TONES];
+	/** Sweep of NO_OS_WAVEGEN_CHIRP mode */
+	struct no_os_wavegen_chirp chirp;
+	/** Right shift applied to the samples, e.g. 4 for 12-bit LSB aligned codes */
+	unsigned int shift;
+	/** Write offset binary codes instead of two's complement */
+	bool offset_binary;
+};
+
+struct no_os_wavegen;
+
+uint32_t no_os_wavegen_ftw(uint32_t freq_hz, uint32_t sample_rate_hz);
+uint32_t no_os_wavegen_cyclic_ftw(uint32_t freq_hz, uint32_t sample_rate_hz,
+				  uint32_t nb_samples);
+int no_os_wavegen_init(struct no_os_wavegen **wg,
+		       const struct no_os_wavegen_config *config);
+int no_os_wavegen_set_config(struct no_os_wavegen *wg,
+			     const struct no_os_wavegen_config *config);
+int no_os_wavegen_fill(struct no_os_wavegen *wg, int16_t *buf,
+		       uint32_t nb_samples, uint32_t stride);
+int no_os_wavegen_fill_iq(struct no_os_wavegen *wg, int16_t *buf,
+			  uint32_t nb_samples, uint32_t stride);
+int no_os_wavegen_reset(struct no_os_wavegen *wg);
+int no_os_wavegen_remove(struct no_os_wavegen *wg);
+
+#endif
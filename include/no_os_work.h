@@ -0,0 +1,97 @@
+/***************************************************************************//**
+ *   @file   no_os_work.h
+ *   @brief  Header file of the deferred work queue.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_WORK_H_
+#define _NO_OS_WORK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_profile.h"
+
+/**
+ * @struct no_os_work
+ * @brief Deferred work item, embedded in the structure of its owner.
+ */
+struct no_os_work {
+	/** Called when the work runs, the owner is found from work */
+	void (*func)(struct no_os_work *work);
+	/** Parameter of func */
+	void *ctx;
+	/** Lower values run first, equal priorities in posting order */
+	uint8_t prio;
+	/** Set while queued, posting a queued work does nothing */
+	volatile bool pending;
+	/** no_os_get_cycles() when posted, for NO_OS_PROFILING */
+	uint32_t posted;
+	/** Next work of the queue */
+	struct no_os_work *next;
+};
+
+/**
+ * @struct no_os_workqueue
+ * @brief Queue of pending work items, posted from tasks or interrupts and run
+ * by no_os_workqueue_run() from the main loop or a task.
+ */
+struct no_os_workqueue {
+	/** Pending work, by priority */
+	struct no_os_work *head;
+	/** Optional, called after a work is posted, e.g. to wake up a task */
+	void (*notify)(void *ctx);
+	/** Parameter of notify */
+	void *notify_ctx;
+	/** Time from post to run, for NO_OS_PROFILING */
+	struct no_os_profile latency;
+};
+
+#define NO_OS_WORK_INIT(_func, _ctx, _prio) \
+	{ .func = (_func), .ctx = (_ctx), .prio = (_prio) }
+#define NO_OS_WORKQUEUE_INIT(_name) \
+	{ .latency = NO_OS_PROFILE_INIT(_name) }
+
+/* Queue a work, safe from interrupts. */
+int no_os_work_post(struct no_os_workqueue *wq, struct no_os_work *work);
+
+/* Remove a work from the queue if it did not run yet. */
+int no_os_work_cancel(struct no_os_workqueue *wq, struct no_os_work *work);
+
+/* Run the pending work by priority, returns the number of works run. */
+int no_os_workqueue_run(struct no_os_workqueue *wq);
+
+/* Check whether a work is pending. */
+bool no_os_workqueue_pending(struct no_os_workqueue *wq);
+
+#endif // _NO_OS_WORK_H_
@@ -108,6 +108,7 @@ int jesd204_topology_init(struct jesd204_topology **topology,
 			jesd204_dev_alloc_links(top->dev_top);
 		} else {
 			top->devs[d] = devs[i];
+			top->devs[d].jdev->topology = top;
 			if (top->devs[d].is_sysref_provider)
 				top->dev_top->jdev_sysref = top->devs[d].jdev;
 			d++;
@@ -4,58 +4,198 @@
  * Copyright (c) 2022 Analog Devices Inc.
  */
 
+#include <string.h>
 #include "no_os_error.h"
+#include "no_os_delay.h"
+#include "no_os_print_log.h"
+#include "no_os_util.h"
 #include "jesd204-priv.h"
 
+/* Callbacks of all the links are polled together while any of them defers */
+#define JESD204_FSM_DEFER_TIMEOUT_MS	1000
+#define JESD204_FSM_MAX_DEVS		16
+#define JESD204_FSM_TOP			JESD204_FSM_MAX_DEVS
+
+/**
+ * struct jesd204_fsm_pending - deferred callbacks of the current state
+ * @link		per link index, bit n is set while the per_link callback
+ *			of device n defers, bit JESD204_FSM_TOP for the top device
+ * @dev			same for the per_device callbacks
+ */
+struct jesd204_fsm_pending {
+	uint32_t	link[JESD204_MAX_LINKS];
+	uint32_t	dev;
+};
+
+static int jesd204_fsm_update(int ret, uint32_t *pending, unsigned int bit)
+{
+	if (ret < 0)
+		return ret;
+
+	if (ret == JESD204_STATE_CHANGE_DEFER)
+		*pending |= NO_OS_BIT(bit);
+	else
+		*pending &= ~NO_OS_BIT(bit);
+
+	return 0;
+}
+
+static bool jesd204_fsm_is_pending(struct jesd204_fsm_pending *pending)
+{
+	unsigned int i;
+
+	if (pending->dev)
+		return true;
+
+	for (i = 0; i < JESD204_MAX_LINKS; i++)
+		if (pending->link[i])
+			return true;
+
+	return false;
+}
+
 /* no-OS specific */
-int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+static int jesd204_fsm_run_state(struct jesd204_topology *topology,
+				 enum jesd204_dev_op op,
+				 enum jesd204_state_op_reason reason,
+				 uint32_t link_mask, bool per_link_only,
+				 struct jesd204_fsm_pending *pending, bool first)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	enum jesd204_dev_op op;
+	const struct jesd204_state_op *top_op = &jdev_top->jdev->dev_data->state_ops[op];
+	const struct jesd204_state_op *dev_op;
+	struct jesd204_link *lnk;
+	uint32_t dev_seen = 0;
 	int lnk_dev;
 	int lnk_id;
 	int dev;
+	int ret;
 
-	for (op = 0; op < __JESD204_MAX_OPS; op++) {
-		for (dev = 0; dev < topology->devs_number; dev++)
-			per_device_op_done[dev] = false;
+	for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
+		if (!(link_mask & NO_OS_BIT(lnk_id)))
+			continue;
 
-		for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
-			for (dev = 0; dev < topology->devs_number; dev++) {
-				for (lnk_dev = 0; lnk_dev < topology->devs[dev].links_number; lnk_dev++) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
+		lnk = &jdev_top->active_links[lnk_id].link;
+		for (dev = 0; dev < topology->devs_number; dev++) {
+			dev_op = &topology->devs[dev].jdev->dev_data->state_ops[op];
+			for (lnk_dev = 0; lnk_dev < topology->devs[dev].links_number; lnk_dev++) {
+				if (topology->devs[dev].link_ids[lnk_dev] != jdev_top->link_ids[lnk_id])
+					continue;
+
+				if (dev_op->per_device && !per_link_only &&
+				    !(dev_seen & NO_OS_BIT(dev)) &&
+				    (first || (pending->dev & NO_OS_BIT(dev)))) {
+					ret = dev_op->per_device(topology->devs[dev].jdev, reason);
+					ret = jesd204_fsm_update(ret, &pending->dev, dev);
+					if (ret)
+						return ret;
+				}
+				dev_seen |= NO_OS_BIT(dev);
+
+				if (dev_op->per_link &&
+				    (first || (pending->link[lnk_id] & NO_OS_BIT(dev)))) {
+					ret = dev_op->per_link(topology->devs[dev].jdev, reason, lnk);
+					ret = jesd204_fsm_update(ret, &pending->link[lnk_id], dev);
+					if (ret) {
+						lnk->error = ret;
+						return ret;
 					}
 				}
 			}
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link) {
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-				if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-					jesd204_sysref_async(jdev_top->jdev);
+		}
+
+		if (top_op->per_link &&
+		    (first || (pending->link[lnk_id] & NO_OS_BIT(JESD204_FSM_TOP)))) {
+			ret = top_op->per_link(jdev_top->jdev, reason, lnk);
+			ret = jesd204_fsm_update(ret, &pending->link[lnk_id],
+						 JESD204_FSM_TOP);
+			if (ret) {
+				lnk->error = ret;
+				return ret;
 			}
 		}
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device) {
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-			if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-				jesd204_sysref_async(jdev_top->jdev);
+	}
+
+	if (top_op->per_device && !per_link_only &&
+	    (first || (pending->dev & NO_OS_BIT(JESD204_FSM_TOP)))) {
+		ret = top_op->per_device(jdev_top->jdev, reason);
+		return jesd204_fsm_update(ret, &pending->dev, JESD204_FSM_TOP);
+	}
+
+	return 0;
+}
+
+/*
+ * Every state is completed on all the links before moving to the next one, so
+ * the links go up in lockstep. Deferred callbacks are polled together and a
+ * single SYSREF is issued once all of them are done.
+ */
+static int jesd204_fsm_run(struct jesd204_topology *topology,
+			   enum jesd204_dev_op first_op,
+			   enum jesd204_dev_op last_op,
+			   enum jesd204_state_op_reason reason,
+			   uint32_t link_mask, bool per_link_only)
+{
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	struct jesd204_fsm_pending pending;
+	unsigned int timeout;
+	int op, step;
+	int ret;
+
+	step = (first_op <= last_op) ? 1 : -1;
+	for (op = first_op; op != (int)last_op + step; op += step) {
+		memset(&pending, 0, sizeof(pending));
+
+		ret = jesd204_fsm_run_state(topology, op, reason, link_mask,
+					    per_link_only, &pending, true);
+		timeout = JESD204_FSM_DEFER_TIMEOUT_MS;
+		while (!ret && jesd204_fsm_is_pending(&pending)) {
+			if (!timeout--) {
+				ret = -ETIMEDOUT;
+				break;
+			}
+			no_os_mdelay(1);
+			ret = jesd204_fsm_run_state(topology, op, reason, link_mask,
+						    per_link_only, &pending, false);
 		}
+		if (ret) {
+			pr_err("JESD204 state %d %s failed (%d)\n", op,
+			       jesd204_state_op_reason_str(reason), ret);
+			return ret;
+		}
+
+		if (reason == JESD204_STATE_OP_REASON_INIT &&
+		    jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
+			jesd204_sysref_async(jdev_top->jdev);
 	}
 
 	return 0;
 }
 
+/* no-OS specific */
+int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	uint32_t link_mask;
+
+	if (topology->devs_number > JESD204_FSM_MAX_DEVS)
+		return -EINVAL;
+
+	if (!jdev_top->num_links)
+		return 0;
+
+	if (link_idx == JESD204_LINKS_ALL)
+		link_mask = NO_OS_GENMASK(jdev_top->num_links - 1, 0);
+	else if (link_idx < jdev_top->num_links)
+		link_mask = NO_OS_BIT(link_idx);
+	else
+		return -EINVAL;
+
+	return jesd204_fsm_run(topology, 0, __JESD204_MAX_OPS - 1, reason,
+			       link_mask, false);
+}
+
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
 {
@@ -99,3 +239,41 @@ int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
 
 	return 0;
 }
+
+/* no-OS specific */
+int jesd204_fsm_link_restart(struct jesd204_dev *jdev, unsigned int link_id)
+{
+	struct jesd204_topology *topology;
+	struct jesd204_dev_top *jdev_top;
+	unsigned int i;
+	int ret;
+
+	if (!jdev || !jdev->topology)
+		return -EINVAL;
+
+	topology = jdev->topology;
+	if (topology->devs_number > JESD204_FSM_MAX_DEVS)
+		return -EINVAL;
+
+	jdev_top = topology->dev_top;
+	for (i = 0; i < jdev_top->num_links; i++)
+		if (jdev_top->link_ids[i] == link_id)
+			break;
+	if (i == jdev_top->num_links)
+		return -ENODEV;
+
+	/*
+	 * Only the per link callbacks from the lane clocks up are run again,
+	 * the devices and the other links of the topology are left untouched.
+	 */
+	jdev_top->active_links[i].link.error = 0;
+	ret = jesd204_fsm_run(topology, JESD204_OP_LINK_RUNNING,
+			      JESD204_OP_CLOCKS_ENABLE,
+			      JESD204_STATE_OP_REASON_UNINIT, NO_OS_BIT(i), true);
+	if (ret)
+		return ret;
+
+	return jesd204_fsm_run(topology, JESD204_OP_CLOCKS_ENABLE,
+			       JESD204_OP_LINK_RUNNING,
+			       JESD204_STATE_OP_REASON_INIT, NO_OS_BIT(i), true);
+}
@@ -0,0 +1,311 @@
+/***************************************************************************//**
+ *   @file   sd_logger.c
+ *   @brief  Implementation of the FatFs data logger.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+#include "sd_logger.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/**
+ * @brief Bytes of a cluster of the volume hosting a file.
+ * @param file - The file.
+ * @return The cluster size.
+ */
+static uint32_t sd_logger_cluster_size(FIL *file)
+{
+#if FF_MAX_SS != FF_MIN_SS
+	return (uint32_t)file->obj.fs->csize * file->obj.fs->ssize;
+#else
+	return (uint32_t)file->obj.fs->csize * FF_MAX_SS;
+#endif
+}
+
+/**
+ * @brief Write the oldest full buffer to the file.
+ *
+ * The file position and the length are multiples of the cluster size, so
+ * FatFs passes the buffer to disk_write() as one multiple sector transfer
+ * without copying it through its sector window.
+ * @param desc - The logger.
+ * @param len - Bytes of the buffer to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int sd_logger_write_buffer(struct sd_logger_desc *desc, uint32_t len)
+{
+	FRESULT res;
+	UINT bw;
+
+	res = f_write(&desc->file, desc->buffers +
+		      (uint32_t)desc->write_idx * desc->buffer_size, len, &bw);
+	if (res != FR_OK || bw != len) {
+		desc->stats.write_errors++;
+		return res != FR_OK ? -EIO : -ENOSPC;
+	}
+
+	desc->stats.bytes_written += len;
+
+	return 0;
+}
+
+/**
+ * @brief Create the log file and allocate the write-behind buffers.
+ *
+ * The volume must be mounted. When file_size is set the clusters are
+ * allocated contiguously up front, so no FAT update happens while logging.
+ * @param desc - The logger.
+ * @param param - The logger parameters.
+ * @return 0 in case of success, -ENOSPC if there is no contiguous space
+ *	   for the file, negative error code otherwise.
+ */
+int sd_logger_init(struct sd_logger_desc **desc,
+		   const struct sd_logger_init_param *param)
+{
+	struct sd_logger_desc *d;
+	uint32_t cluster;
+	FRESULT res;
+	int ret;
+
+	if (!desc || !param || !param->path)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	res = f_open(&d->file, param->path, FA_CREATE_ALWAYS | FA_WRITE);
+	if (res != FR_OK) {
+		ret = -EIO;
+		goto free_desc;
+	}
+
+	cluster = sd_logger_cluster_size(&d->file);
+	d->buffer_size = param->buffer_size ?
+			 NO_OS_DIV_ROUND_UP(param->buffer_size, cluster) * cluster :
+			 cluster;
+	d->nb_buffers = param->nb_buffers ? param->nb_buffers :
+			SD_LOGGER_NB_BUFFERS;
+
+	if (param->file_size) {
+		d->file_size = NO_OS_DIV_ROUND_UP(param->file_size,
+						  d->buffer_size) * d->buffer_size;
+		res = f_expand(&d->file, d->file_size, 1);
+		if (res != FR_OK) {
+			ret = res == FR_DENIED ? -ENOSPC : -EIO;
+			goto close_file;
+		}
+	}
+
+	d->buffers = no_os_calloc(d->nb_buffers, d->buffer_size);
+	if (!d->buffers) {
+		ret = -ENOMEM;
+		goto close_file;
+	}
+
+	*desc = d;
+
+	return 0;
+
+close_file:
+	f_close(&d->file);
+free_desc:
+	no_os_free(d);
+
+	return ret;
+}
+
+/**
+ * @brief Flush the buffers, trim the file to the logged data and close it.
+ * @param desc - The logger.
+ * @return 0 in case of success, negative error code otherwise. The logger
+ *	   is freed in any case.
+ */
+int sd_logger_remove(struct sd_logger_desc *desc)
+{
+	int ret = 0;
+
+	if (!desc)
+		return -EINVAL;
+
+	while (desc->nb_full && !ret) {
+		ret = sd_logger_write_buffer(desc, desc->buffer_size);
+		desc->write_idx = (desc->write_idx + 1) % desc->nb_buffers;
+		desc->nb_full--;
+	}
+
+	if (desc->fill_len && !ret)
+		ret = sd_logger_write_buffer(desc, desc->fill_len);
+
+	/* Give back the preallocated clusters that were not used */
+	if (desc->file_size && f_truncate(&desc->file) != FR_OK && !ret)
+		ret = -EIO;
+
+	if (f_close(&desc->file) != FR_OK && !ret)
+		ret = -EIO;
+
+	no_os_free(desc->buffers);
+	no_os_free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Queue a block of data in the write-behind buffers.
+ *
+ * The block is copied to the buffer being filled, spilling into the next
+ * free ones. A block that does not fit in the free buffers, or past the
+ * preallocated file size, is dropped whole and counted.
+ * @param desc - The logger.
+ * @param data - The block.
+ * @param len - Bytes of the block.
+ * @return 0 in case of success, -EAGAIN if the block was dropped, negative
+ *	   error code otherwise.
+ */
+int sd_logger_write(struct sd_logger_desc *desc, const void *data,
+		    uint32_t len)
+{
+	const uint8_t *src = data;
+	uint64_t queued;
+	uint32_t idx;
+	uint32_t n;
+
+	if (!desc || (!data && len))
+		return -EINVAL;
+
+	queued = (uint64_t)desc->nb_full * desc->buffer_size + desc->fill_len;
+	if (queued + len > (uint64_t)desc->nb_buffers * desc->buffer_size ||
+	    (desc->file_size &&
+	     desc->stats.bytes_written + queued + len > desc->file_size)) {
+		desc->stats.blocks_dropped++;
+		return -EAGAIN;
+	}
+
+	while (len) {
+		idx = (desc->write_idx + desc->nb_full) % desc->nb_buffers;
+		n = no_os_min(len, desc->buffer_size - desc->fill_len);
+		memcpy(desc->buffers + idx * desc->buffer_size + desc->fill_len,
+		       src, n);
+		desc->fill_len += n;
+		src += n;
+		len -= n;
+		if (desc->fill_len == desc->buffer_size) {
+			desc->nb_full++;
+			desc->fill_len = 0;
+		}
+	}
+
+	desc->stats.blocks_logged++;
+
+	return 0;
+}
+
+/**
+ * @brief Drain a stream into the buffers and write at most one full buffer.
+ *
+ * Call it from the main loop. The stream keeps filling its blocks from
+ * interrupts or DMA while f_write() blocks, and the next call moves them to
+ * the free buffers, so a slow card write only costs dropped blocks once all
+ * the buffers are full.
+ * @param desc - The logger.
+ * @param stream - Started analog input stream, NULL to only write the
+ *		   blocks queued with sd_logger_write().
+ * @return 0 in case of success, negative error code otherwise. Dropped
+ *	   blocks are not an error, they are reported by the counters.
+ */
+int sd_logger_step(struct sd_logger_desc *desc,
+		   struct no_os_ain_stream *stream)
+{
+	uint32_t block_bytes;
+	void *block;
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (stream) {
+		block_bytes = no_os_ain_stream_scan_bytes(stream) *
+			      stream->block_scans;
+		while (1) {
+			ret = no_os_ain_stream_get_block(stream, &block);
+			if (ret == -EAGAIN)
+				break;
+			if (ret)
+				return ret;
+
+			sd_logger_write(desc, block, block_bytes);
+
+			ret = no_os_ain_stream_release_block(stream);
+			if (ret)
+				return ret;
+		}
+
+		ret = no_os_ain_stream_get_overruns(stream,
+						    &desc->stats.stream_overruns);
+		if (ret && ret != -ENOSYS)
+			return ret;
+	}
+
+	if (!desc->nb_full)
+		return 0;
+
+	ret = sd_logger_write_buffer(desc, desc->buffer_size);
+	if (ret)
+		return ret;
+
+	desc->write_idx = (desc->write_idx + 1) % desc->nb_buffers;
+	desc->nb_full--;
+
+	return 0;
+}
+
+/**
+ * @brief Get the counters of the logger.
+ * @param desc - The logger.
+ * @param stats - The counters.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int sd_logger_get_stats(struct sd_logger_desc *desc,
+			struct sd_logger_stats *stats)
+{
+	if (!desc || !stats)
+		return -EINVAL;
+
+	*stats = desc->stats;
+
+	return 0;
+}
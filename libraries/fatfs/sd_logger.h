@@ -0,0 +1,132 @@
+/***************************************************************************//**
+ *   @file   sd_logger.h
+ *   @brief  Header file of the FatFs data logger.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _SD_LOGGER_H_
+#define _SD_LOGGER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ff.h"
+#include "no_os_ain.h"
+
+/** Default number of write-behind buffers */
+#define SD_LOGGER_NB_BUFFERS	2
+
+/**
+ * @struct sd_logger_init_param
+ * @brief Parameters of a data logger
+ */
+struct sd_logger_init_param {
+	/** File created, or truncated, on a mounted volume */
+	const TCHAR *path;
+	/**
+	 * Bytes allocated contiguously with f_expand() when the file is
+	 * created, rounded up to buffer_size. Data past it is dropped. 0 lets
+	 * the file grow cluster by cluster.
+	 */
+	FSIZE_t file_size;
+	/**
+	 * Bytes of a write-behind buffer, rounded up to the cluster size. 0
+	 * selects one cluster.
+	 */
+	uint32_t buffer_size;
+	/** Write-behind buffers, 0 selects SD_LOGGER_NB_BUFFERS */
+	uint8_t nb_buffers;
+};
+
+/**
+ * @struct sd_logger_stats
+ * @brief Counters of a data logger
+ */
+struct sd_logger_stats {
+	/** Bytes written to the file */
+	uint64_t bytes_written;
+	/** Blocks queued in the write-behind buffers */
+	uint32_t blocks_logged;
+	/** Blocks dropped because the buffers or the file were full */
+	uint32_t blocks_dropped;
+	/** Overruns reported by the analog input stream */
+	uint32_t stream_overruns;
+	/** Failed f_write() calls */
+	uint32_t write_errors;
+};
+
+/**
+ * @struct sd_logger_desc
+ * @brief Data logger descriptor
+ */
+struct sd_logger_desc {
+	/** Log file */
+	FIL file;
+	/** Write-behind buffers */
+	uint8_t *buffers;
+	/** Bytes of a buffer, a multiple of the cluster size */
+	uint32_t buffer_size;
+	/** Number of buffers */
+	uint8_t nb_buffers;
+	/** Oldest full buffer */
+	uint8_t write_idx;
+	/** Full buffers waiting to be written */
+	uint8_t nb_full;
+	/** Bytes in the buffer being filled */
+	uint32_t fill_len;
+	/** Preallocated file size, 0 if the file grows */
+	FSIZE_t file_size;
+	/** Counters */
+	struct sd_logger_stats stats;
+};
+
+/* Create the log file and allocate the write-behind buffers. */
+int sd_logger_init(struct sd_logger_desc **desc,
+		   const struct sd_logger_init_param *param);
+
+/* Flush the buffers, trim the file to the logged data and close it. */
+int sd_logger_remove(struct sd_logger_desc *desc);
+
+/* Queue a block of data, dropping it whole if it does not fit. */
+int sd_logger_write(struct sd_logger_desc *desc, const void *data,
+		    uint32_t len);
+
+/* Drain a stream into the buffers and write at most one full buffer. */
+int sd_logger_step(struct sd_logger_desc *desc,
+		   struct no_os_ain_stream *stream);
+
+/* Get the counters of the logger. */
+int sd_logger_get_stats(struct sd_logger_desc *desc,
+			struct sd_logger_stats *stats);
+
+#endif // _SD_LOGGER_H_
@@ -32,6 +32,57 @@
 #ifndef LWIP_LWIPOPTS_H
 #define LWIP_LWIPOPTS_H
 
+/* ---------- Profiles ---------- */
+/* Heap, pools and TCP windows, selected with LWIP_PROFILE in
+   tools/scripts/lwip.mk. Static RAM of the heap and of the pbuf pool:
+   LOW_MEM         ~35 KB, 4 segment windows, control and small transfers;
+   BALANCED        ~110 KB, the default, 8 segment windows;
+   MAX_THROUGHPUT  ~290 KB, 48 segment windows with window scaling and
+                   SACK, IIO streaming at the 100 Mbit line rate.
+   Measure a board with tools/scripts/iio_bench.py. */
+#define NO_OS_LWIP_PROFILE_LOW_MEM		0
+#define NO_OS_LWIP_PROFILE_BALANCED		1
+#define NO_OS_LWIP_PROFILE_MAX_THROUGHPUT	2
+
+#ifndef NO_OS_LWIP_PROFILE
+#define NO_OS_LWIP_PROFILE			NO_OS_LWIP_PROFILE_BALANCED
+#endif
+
+#if NO_OS_LWIP_PROFILE == NO_OS_LWIP_PROFILE_LOW_MEM
+#define MEM_SIZE				16384
+#define MEMP_NUM_PBUF				16
+#define PBUF_POOL_SIZE				12
+#define TCP_SND_BUF				(4 * TCP_MSS)
+#define TCP_SND_QUEUELEN			(4 * TCP_SND_BUF / TCP_MSS)
+#define TCP_WND					(4 * TCP_MSS)
+#define ARP_TABLE_SIZE				16
+#elif NO_OS_LWIP_PROFILE == NO_OS_LWIP_PROFILE_MAX_THROUGHPUT
+/* Twice the send buffer, segments are copied in the heap until acked */
+#define MEM_SIZE				196608
+#define MEMP_NUM_PBUF				64
+/* The receive window must fit in the pool */
+#define PBUF_POOL_SIZE				64
+#define TCP_SND_BUF				(48 * TCP_MSS)
+#define TCP_SND_QUEUELEN			(8 * TCP_SND_BUF / TCP_MSS)
+#define TCP_WND					(48 * TCP_MSS)
+/* Windows above 64 KB, advertised as TCP_WND >> TCP_RCV_SCALE */
+#define LWIP_WND_SCALE				1
+#define TCP_RCV_SCALE				1
+/* Report the out of sequence segments, a loss is resent without the
+   segments that followed it */
+#define LWIP_TCP_SACK_OUT			1
+#define LWIP_TCP_MAX_SACK_NUM			4
+#define ARP_TABLE_SIZE				255
+#else
+#define MEM_SIZE				65536
+#define MEMP_NUM_PBUF				32
+#define PBUF_POOL_SIZE				30
+#define TCP_SND_BUF				8192
+#define TCP_SND_QUEUELEN			(30 * TCP_SND_BUF / TCP_MSS)
+#define TCP_WND					(8 * TCP_MSS)
+#define ARP_TABLE_SIZE				255
+#endif
+
 /* NO_SYS==1: Use lwIP without OS-awareness (no thread and etc.) */
 #define NO_SYS                     		1
 #define LWIP_SOCKET                		0
@@ -55,14 +106,8 @@
    byte alignment -> define MEM_ALIGNMENT to 2. */
 #define MEM_ALIGNMENT           		4
 
-/* MEM_SIZE: the size of the heap memory. If the application will send
-a lot of data that needs to be copied, this should be set high. */
-#define MEM_SIZE               			65536
-
-/* MEMP_NUM_PBUF: the number of memp struct pbufs. If the application
-   sends a lot of data out of ROM (or other static memory), this
-   should be set high. */
-#define MEMP_NUM_PBUF				32
+/* MEM_SIZE: the size of the heap memory, MEMP_NUM_PBUF: the number of
+   memp struct pbufs, see the profiles above. */
 
 /* MEMP_NUM_RAW_PCB: the number of UDP protocol control blocks. One
    per active RAW "connection". */
@@ -89,13 +134,23 @@ a lot of data that needs to be copied, this should be set high. */
 #define MEMP_NUM_SYS_TIMEOUT    		17
 
 /* ---------- PBUF Options ---------- */
-#define PBUF_POOL_SIZE				30
+/* PBUF_POOL_BUFSIZE: the size of each pbuf in the pool. Large enough to hold
+   a full frame, including the FCS some MACs leave in the RX FIFO, so that
+   received frames are not split in a pbuf chain. */
+#ifndef PBUF_POOL_BUFSIZE
+#define PBUF_POOL_BUFSIZE			LWIP_MEM_ALIGN_SIZE(TCP_MSS + 40 + \
+						PBUF_LINK_ENCAPSULATION_HLEN + \
+						PBUF_LINK_HLEN + 4)
+#endif
 
 #define LWIP_CHECKSUM_ON_COPY			1
 
+/* The checksums a MAC computes and checks itself are disabled for its
+   netif, from the checksum_offload of its no_os_lwip_ops. */
+#define LWIP_CHECKSUM_CTRL_PER_NETIF		1
+
 /* ---------- ARP Options ---------- */
 #define LWIP_ARP                		1
-#define ARP_TABLE_SIZE          		255
 #define ARP_QUEUEING            		1
 #define ETHARP_TABLE_MATCH_NETIF		1
 #define ETHARP_SUPPORT_STATIC_ENTRIES		1
@@ -130,20 +185,16 @@ a lot of data that needs to be copied, this should be set high. */
 
 /* TCP Maximum segment size. */
 #define TCP_MSS                 		1460
-/* TCP sender buffer space (bytes). */
-#define TCP_SND_BUF             		8192
-
-/* TCP sender buffer space (pbufs). This must be at least = 2 *
-   TCP_SND_BUF/TCP_MSS for things to work. */
-#define TCP_SND_QUEUELEN       			(30 * TCP_SND_BUF / TCP_MSS)
+/* TCP sender buffer space, in bytes (TCP_SND_BUF) and in pbufs
+   (TCP_SND_QUEUELEN, at least 2 * TCP_SND_BUF / TCP_MSS), see the
+   profiles above. */
 
 /* TCP writable space (bytes). This must be less than or equal
    to TCP_SND_BUF. It is the amount of space which must be
    available in the tcp snd_buf for select to return writable */
 #define TCP_SNDLOWAT           			(TCP_SND_BUF / 2)
 
-/* TCP receive window. */
-#define TCP_WND                 		(8 * TCP_MSS)
+/* TCP receive window (TCP_WND), see the profiles above. */
 
 #define TCP_OVERSIZE				TCP_MSS
 
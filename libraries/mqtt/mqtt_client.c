@@ -41,19 +41,64 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include "mqtt_client.h"
 #include "MQTTClient.h"
+#include "no_os_delay.h"
 #include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Fixed header byte and at most 4 remaining length bytes, plus a packet id */
+#define MQTT_RX_HDR_MAX		7
+/* Packets handled by a mqtt_yield call besides the first one */
+#define MQTT_YIELD_MAX_PACKETS	16
+/* DUP flag of the PUBLISH fixed header */
+#define MQTT_PUBLISH_DUP	0x08
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/* QoS 1 message sent and not yet acknowledged */
+struct mqtt_inflight {
+	/* Serialized PUBLISH packet, kept to be sent again after a reconnect */
+	uint8_t		*buff;
+	uint32_t	len;
+	uint16_t	packet_id;
+	bool		used;
+};
+
 struct mqtt_desc {
 	MQTTClient		mqtt_client[1];
 	Network			network;
+	uint32_t		command_timeout_ms;
+	struct mqtt_inflight	*inflight;
+	uint32_t		inflight_window;
+	uint32_t		inflight_buff_size;
+	/*
+	 * Start of the packet being received. It is read here, without
+	 * blocking, before being handed to the paho client. This way a yield
+	 * with 0 timeout returns at once and the PUBACKs can be seen.
+	 */
+	uint8_t			rx_hdr[MQTT_RX_HDR_MAX];
+	/* Bytes in rx_hdr */
+	uint8_t			rx_len;
+	/* Bytes of rx_hdr already handed to the paho client */
+	uint8_t			rx_pos;
+	/* Length of the fixed header, 0 while it is not complete */
+	uint8_t			rx_hdr_len;
+	/* Set when rx_hdr holds a full header */
+	bool			rx_ready;
+	/* Value of the remaining length field */
+	uint32_t		rx_rem;
+	/* Bytes of the packet not in rx_hdr and not yet read */
+	uint32_t		rx_body_left;
 };
 
 /******************************************************************************/
@@ -91,6 +136,178 @@ static void mqtt_default_message_handler(MessageData *msg)
 	free(data.topic);
 }
 
+/* Mark a QoS 1 message as delivered */
+static void mqtt_inflight_release(struct mqtt_desc *desc, uint16_t packet_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->inflight_window; i++)
+		if (desc->inflight[i].used &&
+		    desc->inflight[i].packet_id == packet_id) {
+			desc->inflight[i].used = false;
+			return;
+		}
+}
+
+/*
+ * Read from the socket, without blocking, the bytes of the next packet header.
+ * PUBACK packets are read completely, to release their in-flight slot.
+ */
+static int32_t mqtt_rx_pump(struct mqtt_desc *desc)
+{
+	uint8_t		*hdr = desc->rx_hdr;
+	int32_t		ret;
+	uint32_t	shift;
+
+	/* The body of the previous packet was not read yet */
+	if (desc->rx_body_left)
+		return 0;
+
+	while (!desc->rx_ready) {
+		ret = socket_recv(desc->network.sock, &hdr[desc->rx_len], 1);
+		if (ret == -EAGAIN || ret == 0)
+			return 0;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		desc->rx_len++;
+		if (desc->rx_len == 1) {
+			desc->rx_rem = 0;
+			continue;
+		}
+
+		if (!desc->rx_hdr_len) {
+			/* Remaining length, 7 bits per byte */
+			shift = 7 * (desc->rx_len - 2);
+			desc->rx_rem |= (uint32_t)(hdr[desc->rx_len - 1] & 0x7F)
+					<< shift;
+			if (hdr[desc->rx_len - 1] & 0x80) {
+				if (desc->rx_len == 5)
+					return -EPROTO;
+				continue;
+			}
+
+			desc->rx_hdr_len = desc->rx_len;
+			if ((hdr[0] >> 4) == PUBACK && desc->rx_rem == 2)
+				continue;
+		} else if (desc->rx_len < desc->rx_hdr_len + 2) {
+			continue;
+		} else {
+			mqtt_inflight_release(desc, no_os_get_unaligned_be16(
+						      &hdr[desc->rx_hdr_len]));
+		}
+
+		desc->rx_body_left = desc->rx_rem -
+				     (desc->rx_len - desc->rx_hdr_len);
+		desc->rx_ready = true;
+	}
+
+	return 0;
+}
+
+/*
+ * Network read used by the paho client. The packet header comes from rx_hdr,
+ * the rest of the packet straight from the socket.
+ */
+static int mqtt_client_read(Network *net, unsigned char *buff, int len,
+			    int timeout)
+{
+	struct mqtt_desc	*desc;
+	uint32_t		cnt;
+	int32_t			ret;
+
+	desc = (struct mqtt_desc *)((uint8_t *)net -
+				    offsetof(struct mqtt_desc, network));
+
+	if (!len)
+		return 0;
+
+	cnt = 0;
+	if (!desc->rx_body_left || desc->rx_ready) {
+		while (true) {
+			ret = mqtt_rx_pump(desc);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+			if (desc->rx_ready)
+				break;
+			if (timeout-- <= 0)
+				return 0;
+			no_os_mdelay(1);
+		}
+
+		cnt = no_os_min((uint32_t)len,
+				(uint32_t)(desc->rx_len - desc->rx_pos));
+		memcpy(buff, &desc->rx_hdr[desc->rx_pos], cnt);
+		desc->rx_pos += cnt;
+		if (desc->rx_pos == desc->rx_len) {
+			desc->rx_ready = false;
+			desc->rx_len = 0;
+			desc->rx_pos = 0;
+			desc->rx_hdr_len = 0;
+		}
+		if (cnt == (uint32_t)len || !desc->rx_body_left)
+			return cnt;
+	}
+
+	/* The packet has started, the rest of it must follow shortly */
+	len = no_os_min((uint32_t)len - cnt, desc->rx_body_left);
+	ret = mqtt_noos_read(net, buff + cnt, len,
+			     no_os_max((uint32_t)timeout,
+				       desc->command_timeout_ms));
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	desc->rx_body_left -= ret;
+
+	return cnt + ret;
+}
+
+/* Send a serialized packet, the same way the paho client does */
+static int32_t mqtt_send_packet(struct mqtt_desc *desc, uint8_t *buff,
+				uint32_t len)
+{
+	MQTTClient	*c = desc->mqtt_client;
+	uint32_t	sent;
+	int32_t		ret;
+
+	sent = 0;
+	while (sent < len) {
+		ret = desc->network.mqttwrite(&desc->network, buff + sent,
+					      len - sent,
+					      desc->command_timeout_ms);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+		if (!ret)
+			return -ETIMEDOUT;
+		sent += ret;
+	}
+
+	/* A packet was sent, the keep alive ping can be delayed */
+	TimerCountdown(&c->last_sent, c->keepAliveInterval);
+
+	return 0;
+}
+
+/* Send again the unacknowledged messages, after a reconnect */
+static int32_t mqtt_inflight_resend(struct mqtt_desc *desc)
+{
+	struct mqtt_inflight	*msg;
+	uint32_t		i;
+	int32_t			ret;
+
+	for (i = 0; i < desc->inflight_window; i++) {
+		msg = &desc->inflight[i];
+		if (!msg->used)
+			continue;
+
+		msg->buff[0] |= MQTT_PUBLISH_DUP;
+		ret = mqtt_send_packet(desc, msg->buff, msg->len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Initialize the MQTT client
  * @param desc - Address where to store the MQTT client reference
@@ -103,23 +320,44 @@ int32_t mqtt_init(struct mqtt_desc **desc,
 		  struct mqtt_init_param *param)
 {
 	struct mqtt_desc	*ldesc;
+	uint32_t		i;
 	int32_t			ret;
 
 	if (!desc || !param)
 		return -1;
 
+	if (param->inflight_window && !param->inflight_buff_size)
+		return -1;
+
 	ldesc = (struct mqtt_desc *)calloc(1, sizeof(*ldesc));
 	if (!ldesc)
 		return -1;
 
-	ret = mqtt_timer_init(param->timer_init_param);
-	if (NO_OS_IS_ERR_VALUE(ret)) {
-		free(ldesc);
-		return -1;
+	if (param->inflight_window) {
+		ldesc->inflight = calloc(param->inflight_window,
+					 sizeof(*ldesc->inflight));
+		if (!ldesc->inflight)
+			goto free_desc;
+
+		ldesc->inflight[0].buff = calloc(param->inflight_window,
+						 param->inflight_buff_size);
+		if (!ldesc->inflight[0].buff)
+			goto free_inflight;
+
+		for (i = 1; i < param->inflight_window; i++)
+			ldesc->inflight[i].buff = ldesc->inflight[0].buff +
+						  i * param->inflight_buff_size;
 	}
+	ldesc->inflight_window = param->inflight_window;
+	ldesc->inflight_buff_size = param->inflight_buff_size;
+	ldesc->command_timeout_ms = param->command_timeout_ms;
+
+	ret = mqtt_timer_init(param->timer_init_param);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto free_buff;
 
 	ldesc->network.sock = param->sock;
-	ldesc->network.mqttread = mqtt_noos_read;
+	ldesc->network.mqttread = mqtt_client_read;
 	ldesc->network.mqttwrite = mqtt_noos_write;
 
 	app_handler = param->message_handler;
@@ -134,6 +372,16 @@ int32_t mqtt_init(struct mqtt_desc **desc,
 	*desc = ldesc;
 
 	return 0;
+
+free_buff:
+	if (ldesc->inflight)
+		free(ldesc->inflight[0].buff);
+free_inflight:
+	free(ldesc->inflight);
+free_desc:
+	free(ldesc);
+
+	return -1;
 }
 
 /**
@@ -148,6 +396,10 @@ int32_t mqtt_remove(struct mqtt_desc *desc)
 	if (!desc)
 		return -1;
 
+	if (desc->inflight) {
+		free(desc->inflight[0].buff);
+		free(desc->inflight);
+	}
 	free(desc);
 	mqtt_timer_remove();
 
@@ -186,8 +438,11 @@ int32_t mqtt_connect(struct mqtt_desc *desc,
 		result_optional->rc = res.rc;
 		result_optional->session_present = res.sessionPresent;
 	}
+	if (ret)
+		return ret;
 
-	return ret;
+	/* QoS 1 messages not acknowledged before the connection was lost */
+	return mqtt_inflight_resend(desc);
 }
 
 /**
@@ -230,6 +485,192 @@ int32_t mqtt_publish(struct mqtt_desc *desc, const int8_t* topic,
 	return MQTTPublish(desc->mqtt_client, (char *)topic, &message);
 }
 
+/**
+ * @brief Send publish to MQTT broker without waiting for the broker response
+ *
+ * For QoS 1 the packet is kept until the broker acknowledges it, when
+ * \ref mqtt_yield is called, and sent again by \ref mqtt_connect if the
+ * connection is lost before. The payload may be reused as soon as this
+ * function returns. At most \ref mqtt_init_param.inflight_window messages can
+ * wait for the acknowledge. QoS 2 is not supported.
+ * @param desc - Reference to MQTT client
+ * @param topic - Topic to publish to
+ * @param msg - Message to send
+ * @return
+ *  - 0 : On success
+ *  - -EAGAIN : All the in-flight slots are used, call \ref mqtt_yield and
+ *  try again
+ *  - Negative error code otherwise
+ */
+int32_t mqtt_publish_async(struct mqtt_desc *desc, const int8_t *topic,
+			   const struct mqtt_message *msg)
+{
+	MQTTString		topic_str = MQTTString_initializer;
+	struct mqtt_inflight	*slot;
+	MQTTClient		*c;
+	uint8_t			*buff;
+	uint32_t		size;
+	uint16_t		packet_id;
+	uint32_t		i;
+	int32_t			len;
+	int32_t			ret;
+
+	if (!desc || !topic || !msg)
+		return -EINVAL;
+
+	c = desc->mqtt_client;
+	if (!c->isconnected)
+		return -ENOTCONN;
+
+	topic_str.cstring = (char *)topic;
+	switch (msg->qos) {
+	case MQTT_QOS0:
+		slot = NULL;
+		packet_id = 0;
+		buff = c->buf;
+		size = c->buf_size;
+		break;
+	case MQTT_QOS1:
+		slot = NULL;
+		for (i = 0; i < desc->inflight_window; i++)
+			if (!desc->inflight[i].used) {
+				slot = &desc->inflight[i];
+				break;
+			}
+		if (!slot)
+			return desc->inflight_window ? -EAGAIN : -EINVAL;
+
+		c->next_packetid = (c->next_packetid == MAX_PACKET_ID) ?
+				   1 : c->next_packetid + 1;
+		packet_id = c->next_packetid;
+		buff = slot->buff;
+		size = desc->inflight_buff_size;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	len = MQTTSerialize_publish(buff, size, 0, msg->qos, msg->retained,
+				    packet_id, topic_str, msg->payload,
+				    msg->len);
+	if (len <= 0)
+		return -ENOMEM;
+
+	ret = mqtt_send_packet(desc, buff, len);
+	if (NO_OS_IS_ERR_VALUE(ret) || !slot)
+		return ret;
+
+	slot->len = len;
+	slot->packet_id = packet_id;
+	slot->used = true;
+
+	return 0;
+}
+
+/**
+ * @brief Wait for the broker to acknowledge all the messages sent with
+ * \ref mqtt_publish_async
+ * @param desc - Reference to MQTT client
+ * @param timeout_ms - Maximum time to wait
+ * @return
+ *  - 0 : On success
+ *  - -ETIMEDOUT : Some messages were not acknowledged in time
+ *  - Negative error code otherwise
+ */
+int32_t mqtt_flush(struct mqtt_desc *desc, uint32_t timeout_ms)
+{
+	Timer		timer;
+	uint32_t	i;
+	int32_t		ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	TimerInit(&timer);
+	TimerCountdownMS(&timer, timeout_ms);
+	while (true) {
+		for (i = 0; i < desc->inflight_window; i++)
+			if (desc->inflight[i].used)
+				break;
+		if (i == desc->inflight_window)
+			return 0;
+
+		if (TimerIsExpired(&timer))
+			return -ETIMEDOUT;
+
+		ret = mqtt_yield(desc, 1);
+		if (ret)
+			return -ENOTCONN;
+	}
+}
+
+/**
+ * @brief Pack a sample at the end of a batch
+ * @param batch - Batch to add the sample to
+ * @param data - Sample, in the format expected by the subscribers
+ * @param len - Size of the sample
+ * @return
+ *  - 0 : On success
+ *  - -ENOSPC : The sample does not fit, publish the batch first
+ *  - -EINVAL : Invalid parameters
+ */
+int32_t mqtt_batch_add(struct mqtt_batch *batch, const void *data,
+		       uint32_t len)
+{
+	if (!batch || !data)
+		return -EINVAL;
+
+	if (len > batch->size - batch->len)
+		return -ENOSPC;
+
+	memcpy(batch->buff + batch->len, data, len);
+	batch->len += len;
+	batch->count++;
+
+	return 0;
+}
+
+/**
+ * @brief Send all the samples in a batch as the payload of one publish
+ *
+ * The message is sent with \ref mqtt_publish_async and the batch is emptied,
+ * so new samples can be added right away.
+ * @param desc - Reference to MQTT client
+ * @param topic - Topic to publish to
+ * @param batch - Batch to send
+ * @param qos - MQTT_QOS0 or MQTT_QOS1
+ * @return
+ *  - 0 : On success, or if the batch is empty
+ *  - -EAGAIN : All the in-flight slots are used, the batch is kept
+ *  - Negative error code otherwise
+ */
+int32_t mqtt_batch_publish(struct mqtt_desc *desc, const int8_t *topic,
+			   struct mqtt_batch *batch, enum mqtt_qos qos)
+{
+	struct mqtt_message	msg;
+	int32_t			ret;
+
+	if (!batch)
+		return -EINVAL;
+
+	if (!batch->len)
+		return 0;
+
+	msg = (struct mqtt_message) {
+		.qos = qos,
+		.payload = batch->buff,
+		.len = batch->len
+	};
+	ret = mqtt_publish_async(desc, topic, &msg);
+	if (ret)
+		return ret;
+
+	batch->len = 0;
+	batch->count = 0;
+
+	return 0;
+}
+
 /**
  * @brief Send subscribe to MQTT broker
  * @param desc - Reference to MQTT client
@@ -282,7 +723,9 @@ int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic)
  * A call to this API must be made within the
  * \ref mqtt_connect_config.keep_alive_ms interval to keep the MQTT connection
  * alive. \n
- * Yield can be called if no other MQTT operation is needed.
+ * Yield can be called if no other MQTT operation is needed. With a 0 timeout
+ * it only handles the packets already received, so it can be called from the
+ * main loop, next to no_os_lwip_step().
  * @param desc - Reference to MQTT client
  * @param timeout_ms - Time for yield to be executed
  * @return
@@ -291,5 +734,22 @@ int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const int8_t* topic)
  */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms)
 {
-	return MQTTYield(desc->mqtt_client, timeout_ms);
+	uint32_t	i;
+	int32_t		ret;
+
+	if (!desc)
+		return -1;
+
+	ret = MQTTYield(desc->mqtt_client, timeout_ms);
+
+	/* Do not leave queued packets, like PUBACKs, for the next call */
+	for (i = 0; !ret && i < MQTT_YIELD_MAX_PACKETS; i++) {
+		ret = mqtt_rx_pump(desc);
+		if (ret || !desc->rx_ready)
+			break;
+
+		ret = MQTTYield(desc->mqtt_client, 0);
+	}
+
+	return ret ? -1 : 0;
 }
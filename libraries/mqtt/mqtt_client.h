@@ -92,6 +92,10 @@
  * 		.len = strlen("Hello World\n")
  * 	};
  * 	mqtt_publish(mqtt, "my_publish", &msg);
+ * 	//Publish without waiting for the broker (needs inflight_window set)
+ * 	msg.qos = MQTT_QOS1;
+ * 	while (mqtt_publish_async(mqtt, "my_publish", &msg) == -EAGAIN)
+ * 		mqtt_yield(mqtt, 0); //Window full, process the PUBACKs
  * 	//Subscribe
  * 	mqtt_subscribe(mqtt, "my_subscribe", MQTT_QOS0, NULL);
  * 	while (true)
@@ -230,6 +234,33 @@ struct mqtt_init_param {
 	 * @param Message received from the broker.
 	 */
 	void			(*message_handler)(struct mqtt_message_data *);
+	/**
+	 * Maximum number of QoS 1 messages sent with \ref mqtt_publish_async
+	 * and not yet acknowledged by the broker. 0 to only allow QoS 0
+	 * asynchronous publishing.
+	 */
+	uint32_t		inflight_window;
+	/**
+	 * Size of the buffer kept for each in-flight message. It must fit the
+	 * PUBLISH packet: payload, topic and up to 9 bytes of header.
+	 */
+	uint32_t		inflight_buff_size;
+};
+
+/**
+ * @struct mqtt_batch
+ * @brief Samples packed one after the other in a single payload, to send many
+ * small samples with one publish.
+ */
+struct mqtt_batch {
+	/** Buffer where the samples are packed */
+	uint8_t		*buff;
+	/** Size of buff */
+	uint32_t	size;
+	/** Number of bytes packed */
+	uint32_t	len;
+	/** Number of samples packed */
+	uint32_t	count;
 };
 
 /**
@@ -258,6 +289,17 @@ int32_t mqtt_disconnect(struct mqtt_desc *desc);
 /* Send publish to MQTT broker */
 int32_t mqtt_publish(struct mqtt_desc *desc, const int8_t* topic,
 		     const struct mqtt_message* msg);
+/* Send publish to MQTT broker without waiting for the acknowledge */
+int32_t mqtt_publish_async(struct mqtt_desc *desc, const int8_t *topic,
+			   const struct mqtt_message *msg);
+/* Wait for the broker to acknowledge all the asynchronous publishes */
+int32_t mqtt_flush(struct mqtt_desc *desc, uint32_t timeout_ms);
+/* Pack a sample in a batch */
+int32_t mqtt_batch_add(struct mqtt_batch *batch, const void *data,
+		       uint32_t len);
+/* Send the samples in a batch with one asynchronous publish */
+int32_t mqtt_batch_publish(struct mqtt_desc *desc, const int8_t *topic,
+			   struct mqtt_batch *batch, enum mqtt_qos qos);
 /* Send subscribe to MQTT broker */
 int32_t mqtt_subscribe(struct mqtt_desc *desc, const int8_t *topic,
 		       enum mqtt_qos qos, enum mqtt_qos *granted_qos_optional);
@@ -59,6 +59,38 @@
 #include <netdb.h>
 #include <string.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <sys/epoll.h>
+
+/* Maximum number of events handled in a single linux_socket_wait call */
+#define LINUX_SOCKET_MAX_EVENTS	16
+
+/* Set of all the opened sockets, used to wait for activity on them */
+static int linux_epoll_fd = -1;
+
+/**
+ * @brief Add a socket in the epoll set, creating it the first time.
+ * @param sock_id - Socket file descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_socket_watch(uint32_t sock_id)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLRDHUP,
+		.data.fd = sock_id,
+	};
+
+	if (linux_epoll_fd < 0) {
+		linux_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (linux_epoll_fd < 0)
+			return -errno;
+	}
+
+	if (epoll_ctl(linux_epoll_fd, EPOLL_CTL_ADD, sock_id, &ev) < 0)
+		return -errno;
+
+	return 0;
+}
 
 /******************************************************************************/
 /*************************** FUnctions Declarations *******************************/
@@ -71,14 +103,23 @@ static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 	int32_t flags;
 	int err;
 
-	err = socket(AF_INET,SOCK_STREAM,IPPROTO_TCP);
+	if (prot == PROTOCOL_UDP)
+		err = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	else
+		err = socket(AF_INET,SOCK_STREAM,IPPROTO_TCP);
 	if(err < 0)
-		return err;
+		return -errno;
 
 	*sock_id = err;
 	flags = fcntl(*sock_id, F_GETFL);
 	fcntl(*sock_id, F_SETFL, flags | O_NONBLOCK);
 
+	err = linux_socket_watch(*sock_id);
+	if (err) {
+		close(*sock_id);
+		return err;
+	}
+
 	return 0;
 }
 
@@ -137,12 +178,17 @@ static int32_t linux_socket_send(void *desc, uint32_t sock_id,
 {
 	int32_t ret;
 
-	ret = send(sock_id, data, size, 0);
+	/*
+	 * The socket is non blocking, so only part of a large buffer may be
+	 * queued. Report it, the caller sends the rest once there is space.
+	 * Don't raise SIGPIPE if the client went away, -EPIPE is returned.
+	 */
+	ret = send(sock_id, data, size, MSG_NOSIGNAL);
 
 	if(ret < 0)
 		return -errno;
 
-	return size;
+	return ret;
 }
 
 /** @brief See \ref network_interface.socket_recv */
@@ -255,13 +301,40 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 {
 	int32_t ret;
 
-	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK);
+	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
 
 	if(ret < 0)
 		return -errno;
 
 	*client_socket_id = ret;
 
+	ret = linux_socket_watch(*client_socket_id);
+	if (ret) {
+		close(*client_socket_id);
+		return ret;
+	}
+
+	return 0;
+}
+
+/** @brief See \ref network_interface.socket_wait */
+static int32_t linux_socket_wait(void *desc, uint32_t timeout_ms)
+{
+	struct epoll_event events[LINUX_SOCKET_MAX_EVENTS];
+	int ret;
+
+	if (linux_epoll_fd < 0)
+		return -EINVAL;
+
+	/* Level triggered, the events are consumed by recv and accept */
+	ret = epoll_wait(linux_epoll_fd, events, LINUX_SOCKET_MAX_EVENTS,
+			 timeout_ms);
+	if (ret < 0)
+		return errno == EINTR ? 0 : -errno;
+
+	if (!ret)
+		return -ETIMEDOUT;
+
 	return 0;
 }
 
@@ -277,7 +350,8 @@ struct network_interface linux_net = {
 	.socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t, struct socket_address* from))linux_socket_recvfrom,
 	.socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))linux_socket_bind,
 	.socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))linux_socket_listen,
-	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept
+	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept,
+	.socket_wait = linux_socket_wait,
 };
 
 #endif
@@ -50,6 +50,7 @@
 #include "lwip/tcpbase.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/udp.h"
 #include "lwip/netif.h"
 #include "lwip/api.h"
 #include "lwip/etharp.h"
@@ -146,6 +147,34 @@ static err_t lwip_netif_output(struct netif *netif, struct pbuf *p)
 	return desc->platform_ops->netif_output(netif, p);
 }
 
+#if LWIP_IGMP
+/**
+ * @brief Add or drop the MAC filter of an IPv4 multicast group, called by
+ * lwIP when the group is joined or left on the interface.
+ * @param netif - the interface.
+ * @param group - the multicast group.
+ * @param action - NETIF_ADD_MAC_FILTER or NETIF_DEL_MAC_FILTER.
+ * @return ERR_OK in the case of success, ERR_IF otherwise
+ */
+static err_t lwip_igmp_mac_filter(struct netif *netif, const ip4_addr_t *group,
+				  enum netif_mac_filter_action action)
+{
+	uint8_t addr[NETIF_MAX_HWADDR_LEN] = {0x01, 0x00, 0x5E};
+	struct lwip_network_desc *desc = netif->state;
+	int32_t ret;
+
+	/* The low 23 bits of the group */
+	addr[3] = ip4_addr2(group) & 0x7F;
+	addr[4] = ip4_addr3(group);
+	addr[5] = ip4_addr4(group);
+
+	ret = desc->platform_ops->mac_filter(desc->mac_desc, addr,
+					     action == NETIF_ADD_MAC_FILTER);
+
+	return ret ? ERR_IF : ERR_OK;
+}
+#endif
+
 /**
  * @brief Setup a network interface with a set of predefined options.
  * @param netif - the interface be setup.
@@ -165,6 +194,10 @@ static err_t lwip_netif_init(struct netif *netif)
 	netif->mtu = NO_OS_MTU_SIZE;
 	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP |
 		       NETIF_FLAG_ETHERNET | NETIF_FLAG_IGMP;
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_ENABLE_ALL &
+				~desc->platform_ops->checksum_offload);
+#endif
 
 	memcpy(netif->hwaddr, desc->hwaddr, NETIF_MAX_HWADDR_LEN);
 	netif->hwaddr_len = NETIF_MAX_HWADDR_LEN;
@@ -285,6 +318,12 @@ int32_t no_os_lwip_init(struct lwip_network_desc **desc,
 	struct lwip_network_desc *descriptor;
 	struct netif *netif_descriptor;
 	ip4_addr_t ipaddr, netmask, gw;
+#if LWIP_IGMP
+	/* MAC address of 224.0.0.1, joined by netif_add() */
+	const uint8_t allsystems[NETIF_MAX_HWADDR_LEN] = {
+		0x01, 0x00, 0x5E, 0x00, 0x00, 0x01
+	};
+#endif
 	uint32_t raw_netmask[4] = {0};
 	uint32_t raw_gateway[4] = {0};
 	uint32_t raw_ip[4] = {0};
@@ -308,6 +347,8 @@ int32_t no_os_lwip_init(struct lwip_network_desc **desc,
 	}
 
 	memcpy(descriptor->hwaddr, param->hwaddr, NETIF_MAX_HWADDR_LEN);
+	/* Used by lwip_netif_init(), called from netif_add() */
+	descriptor->platform_ops = param->platform_ops;
 
 	lwip_init();
 
@@ -342,7 +383,19 @@ int32_t no_os_lwip_init(struct lwip_network_desc **desc,
 	if (ret)
 		goto free_netif;
 
-	descriptor->platform_ops = param->platform_ops;
+#if LWIP_IGMP
+	if (descriptor->platform_ops->mac_filter) {
+		/* The group was joined before the MAC was initialized */
+		ret = descriptor->platform_ops->mac_filter(descriptor->mac_desc,
+				allsystems, true);
+		if (ret) {
+			descriptor->platform_ops->remove(descriptor->mac_desc);
+			goto free_netif;
+		}
+
+		netif_set_igmp_mac_filter(netif_descriptor, lwip_igmp_mac_filter);
+	}
+#endif
 
 	netif_set_default(netif_descriptor);
 	netif_set_up(netif_descriptor);
@@ -406,6 +459,27 @@ free_network_descriptor:
 	return ret;
 }
 
+/**
+ * @brief Give the acknowledged zero-copy buffers back to their owners.
+ * @param sock - lwip socket descriptor.
+ * @param all - Release all the buffers, once lwIP dropped the connection.
+ */
+static void lwip_nocopy_release(struct lwip_socket_desc *sock, bool all)
+{
+	struct lwip_nocopy_chunk *chunk;
+
+	while (sock->nocopy_count) {
+		chunk = &sock->nocopy[sock->nocopy_head];
+		if (!all && (int32_t)(sock->snd_acked - chunk->end) < 0)
+			break;
+
+		sock->nocopy_head = (sock->nocopy_head + 1) %
+				    NO_OS_LWIP_NOCOPY_SLOTS;
+		sock->nocopy_count--;
+		chunk->sent(chunk->ctx);
+	}
+}
+
 /**
  * @brief Called in case of a lwip error. The pcb may have already been freed.
  * @param arg - lwip sockets layer specific descriptor.
@@ -416,6 +490,8 @@ static void lwip_err_callback(void *arg, err_t err)
 	struct lwip_socket_desc *socket = arg;
 
 	socket->state = SOCKET_CLOSED;
+	/* The pcb and its segments are gone */
+	lwip_nocopy_release(socket, true);
 }
 
 /**
@@ -433,6 +509,14 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 	if (!sock)
 		return -EINVAL;
 
+	if (sock->udp_pcb) {
+		udp_remove(sock->udp_pcb);
+		sock->udp_pcb = NULL;
+		_release_socket(desc, sock_id);
+
+		return 0;
+	}
+
 	if (!sock->pcb)
 		return 0;
 
@@ -441,9 +525,25 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 		pbuf_free(sock->p);
 	}
 
-	tcp_close(sock->pcb);
-	tcp_recv(sock->pcb, NULL);
-	tcp_err(sock->pcb, NULL);
+	if (sock->nocopy_count) {
+		/*
+		 * A graceful close keeps sending the queued segments, which may
+		 * still reference caller buffers. Drop them instead.
+		 */
+		tcp_recv(sock->pcb, NULL);
+		tcp_err(sock->pcb, NULL);
+		tcp_sent(sock->pcb, NULL);
+		tcp_abort(sock->pcb);
+		lwip_nocopy_release(sock, true);
+	} else {
+		/* Listening pcbs have no sent callback */
+		if (sock->state != SOCKET_LISTENING &&
+		    sock->state != SOCKET_ACCEPTING)
+			tcp_sent(sock->pcb, NULL);
+		tcp_close(sock->pcb);
+		tcp_recv(sock->pcb, NULL);
+		tcp_err(sock->pcb, NULL);
+	}
 
 	sock->p_idx = 0;
 	sock->pcb = NULL;
@@ -465,15 +565,18 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 				err_t err)
 {
 	struct lwip_socket_desc *sock = arg;
+	bool abort;
 
 	/* The remote side has closed the connection. */
 	if (!p) {
 		tcp_recv(sock->pcb, NULL);
 		sock->state = SOCKET_CLOSED;
 
+		/* The close aborts the pcb if zero-copy data is pending. */
+		abort = sock->nocopy_count != 0;
 		lwip_socket_close(sock->desc, sock->id);
 
-		return ERR_OK;
+		return abort ? ERR_ABRT : ERR_OK;
 	}
 
 	if (err != ERR_OK) {
@@ -492,14 +595,37 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 }
 
 /**
- * @brief Configure the receive and error callbacks.
+ * @brief Called when the remote acknowledged sent data.
+ * @param arg - lwip socket descriptor.
+ * @param tpcb - lwip TCP descriptor of the socket.
+ * @param len - number of bytes acknowledged.
+ * @return ERR_OK
+ */
+static err_t lwip_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+	struct lwip_socket_desc *sock = arg;
+
+	sock->snd_acked += len;
+	lwip_nocopy_release(sock, false);
+
+	return ERR_OK;
+}
+
+/**
+ * @brief Configure the receive, sent and error callbacks.
  * @param desc - lwip sockets layer specific descriptor.
  * @param err - error code.
  */
 static void lwip_config_socket(struct lwip_socket_desc *desc)
 {
+	desc->snd_queued = 0;
+	desc->snd_acked = 0;
+	desc->nocopy_head = 0;
+	desc->nocopy_count = 0;
+
 	tcp_arg(desc->pcb, desc);
 	tcp_recv(desc->pcb, lwip_recv_callback);
+	tcp_sent(desc->pcb, lwip_sent_callback);
 	tcp_err(desc->pcb, lwip_err_callback);
 }
 
@@ -516,18 +642,38 @@ static int32_t lwip_socket_open(void *net, uint32_t *sock_id,
 				uint32_t buff_size)
 {
 	struct lwip_network_desc *desc = net;
+	struct udp_pcb *udp_pcb;
 	struct tcp_pcb *pcb;
 	uint32_t socket_id;
 	int32_t ret;
 
 	NO_OS_UNUSED_PARAM(buff_size);
-	if (proto != PROTOCOL_TCP)
+	if (proto != PROTOCOL_TCP && proto != PROTOCOL_UDP)
 		return -EPROTONOSUPPORT;
 
 	ret = _get_closed_socket(desc, &socket_id);
 	if (ret)
 		return ret;
 
+	if (proto == PROTOCOL_UDP) {
+		/* Send only, there is no receive callback */
+		udp_pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+		if (!udp_pcb) {
+			_release_socket(desc, socket_id);
+			return -ENOMEM;
+		}
+
+		desc->sockets[socket_id].udp_pcb = udp_pcb;
+		desc->sockets[socket_id].pcb = NULL;
+		desc->sockets[socket_id].desc = desc;
+		desc->sockets[socket_id].id = socket_id;
+		desc->sockets[socket_id].p = NULL;
+		desc->sockets[socket_id].state = SOCKET_CONNECTED;
+		*sock_id = socket_id;
+
+		return 0;
+	}
+
 	pcb = tcp_new_ip_type(IPADDR_TYPE_ANY);
 	if (!pcb) {
 		_release_socket(desc, socket_id);
@@ -584,6 +730,8 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 	if (err != ERR_OK)
 		return err;
 
+	sock->snd_queued += size;
+
 	if (!(flags & TCP_WRITE_FLAG_MORE)) {
 		/* Mark data as ready to be sent */
 		err = tcp_output(sock->pcb);
@@ -595,29 +743,85 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 }
 
 /**
- * @brief Receive a TCP packet.
+ * @brief Send a TCP packet referencing the caller's buffer instead of copying
+ * it. The sent bytes must stay unchanged until the sent callback is called,
+ * once the remote acknowledged them or the connection was dropped.
  * @param net - lwip sockets layer specific descriptor.
- * @param sock_id - index of the socket to receive data from.
+ * @param sock_id - index of the socket to send data to.
  * @param data - pointer to the data array.
- * @param size - size of data to be read.
- * @return 0 in the case of success, negative error code otherwise
+ * @param size - size of data array.
+ * @param sent - called when the sent part of the buffer can be reused.
+ * @param ctx - parameter of the sent callback.
+ * @return number of bytes sent in the case of success, negative error code
+ * otherwise. The callback is only called when at least one byte was sent.
  */
-static int32_t lwip_socket_recv(void *net, uint32_t sock_id, void *data,
-				uint32_t size)
+static int32_t lwip_socket_send_nocopy(void *net, uint32_t sock_id,
+				       const void *data, uint32_t size,
+				       void (*sent)(void *ctx), void *ctx)
 {
 	struct lwip_network_desc *desc = net;
-	struct lwip_socket_desc *socket;
-	struct pbuf *p, *old_p;
-	uint8_t *buf, *pdata;
-	uint32_t i, len;
+	struct lwip_nocopy_chunk *chunk;
+	struct lwip_socket_desc *sock;
+	uint32_t avail;
+	uint32_t flags = 0;
+	err_t err;
 
-	socket = _get_sock(desc, sock_id);
-	if (!socket)
+	sock = _get_sock(desc, sock_id);
+	if (!sock || !sent)
 		return -EINVAL;
 
-	if (socket->state != SOCKET_CONNECTED)
+	if (sock->state != SOCKET_CONNECTED)
 		return -ENOTCONN;
 
+	if (sock->nocopy_count == NO_OS_LWIP_NOCOPY_SLOTS)
+		return -EAGAIN;
+
+	avail = tcp_sndbuf(sock->pcb);
+	if (!avail || !size)
+		return 0;
+
+	if (avail < size)
+		/* Partial write */
+		flags |= TCP_WRITE_FLAG_MORE;
+
+	size = no_os_min(avail, size);
+	err = tcp_write(sock->pcb, data, size, flags);
+	if (err != ERR_OK)
+		return err;
+
+	sock->snd_queued += size;
+	chunk = &sock->nocopy[(sock->nocopy_head + sock->nocopy_count) %
+			       NO_OS_LWIP_NOCOPY_SLOTS];
+	chunk->end = sock->snd_queued;
+	chunk->sent = sent;
+	chunk->ctx = ctx;
+	sock->nocopy_count++;
+
+	if (!(flags & TCP_WRITE_FLAG_MORE)) {
+		/* Mark data as ready to be sent */
+		err = tcp_output(sock->pcb);
+		if (err != ERR_OK)
+			return err;
+	}
+
+	return size;
+}
+
+/**
+ * @brief Copy and consume received data. The pbufs whose payload is consumed
+ * are freed and the remote is allowed to send more.
+ * @param socket - lwip socket descriptor.
+ * @param data - pointer to the data array, NULL to only consume the data.
+ * @param size - size of data to be consumed.
+ * @return number of bytes consumed
+ */
+static int32_t lwip_socket_consume(struct lwip_socket_desc *socket,
+				   void *data, uint32_t size)
+{
+	struct pbuf *p, *old_p;
+	uint8_t *buf, *pdata;
+	uint32_t i, len;
+
 	i = 0;
 	p = socket->p;
 	pdata = data;
@@ -625,9 +829,11 @@ static int32_t lwip_socket_recv(void *net, uint32_t sock_id, void *data,
 	/* Iterate over payloads until requested data has been read */
 	while (p && i < size) {
 		len = no_os_min(size - i, p->len - socket->p_idx);
-		buf = p->payload;
-		buf += socket->p_idx;
-		memcpy(pdata + i, buf, len);
+		if (pdata) {
+			buf = p->payload;
+			buf += socket->p_idx;
+			memcpy(pdata + i, buf, len);
+		}
 		i += len;
 		socket->p_idx += len;
 		if (socket->p_idx == p->len) {
@@ -649,6 +855,87 @@ static int32_t lwip_socket_recv(void *net, uint32_t sock_id, void *data,
 	return i;
 }
 
+/**
+ * @brief Receive a TCP packet.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to receive data from.
+ * @param data - pointer to the data array.
+ * @param size - size of data to be read.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+static int32_t lwip_socket_recv(void *net, uint32_t sock_id, void *data,
+				uint32_t size)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *socket;
+
+	socket = _get_sock(desc, sock_id);
+	if (!socket)
+		return -EINVAL;
+
+	if (socket->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	return lwip_socket_consume(socket, data, size);
+}
+
+/**
+ * @brief Get the address of the received data, in the payload of the first
+ * pbuf, without copying it.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to receive data from.
+ * @param data - address where to store the start of the data.
+ * @param size - maximum size of data to return.
+ * @return number of bytes at data in the case of success, negative error code
+ * otherwise
+ */
+static int32_t lwip_socket_recv_nocopy(void *net, uint32_t sock_id,
+				       const void **data, uint32_t size)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *socket;
+	uint8_t *buf;
+
+	socket = _get_sock(desc, sock_id);
+	if (!socket)
+		return -EINVAL;
+
+	if (socket->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	if (!socket->p)
+		return -EAGAIN;
+
+	buf = socket->p->payload;
+	*data = buf + socket->p_idx;
+
+	return no_os_min(size, (uint32_t)(socket->p->len - socket->p_idx));
+}
+
+/**
+ * @brief Release data returned by lwip_socket_recv_nocopy(). The pbufs are
+ * freed and the TCP window is opened once their payload is consumed.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket the data was received from.
+ * @param size - bytes consumed.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+static int32_t lwip_socket_recv_release(void *net, uint32_t sock_id,
+					uint32_t size)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *socket;
+
+	socket = _get_sock(desc, sock_id);
+	if (!socket)
+		return -EINVAL;
+
+	if (lwip_socket_consume(socket, NULL, size) != (int32_t)size)
+		return -EINVAL;
+
+	return 0;
+}
+
 /**
  * @brief Bind a socket to a port.
  * @param net - lwip sockets layer specific descriptor.
@@ -778,18 +1065,48 @@ static int32_t lwip_socket_accept(void *net, uint32_t sock_id,
 }
 
 /**
- * @brief Not implemented.
- * @param net - Not used.
- * @param sock_id - Not used.
- * @param data - Not used.
- * @param size - Not used.
- * @param to - Not used.
- * @return -ENOSYS
+ * @brief Send a UDP datagram. Multicast addresses may be used as well.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of a socket opened with PROTOCOL_UDP.
+ * @param data - pointer to the data array.
+ * @param size - size of data array.
+ * @param to - address of the remote host.
+ * @return the number of bytes sent in the case of success, negative error code
+ * otherwise. -ENOMEM is returned when the datagram is dropped for lack of
+ * buffers, in which case it may be retried or discarded.
  */
 static int32_t lwip_socket_sendto(void *net, uint32_t sock_id, const void *data,
 				  uint32_t size, const struct socket_address *to)
 {
-	return -ENOSYS;
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *sock;
+	ip_addr_t addr;
+	struct pbuf *p;
+	err_t err;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock || !sock->udp_pcb || !to || !to->addr)
+		return -EINVAL;
+
+	if (size > 0xFFFF)
+		return -EMSGSIZE;
+
+	if (!ipaddr_aton(to->addr, &addr))
+		return -EINVAL;
+
+	p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+	if (!p)
+		return -ENOMEM;
+
+	pbuf_take(p, data, size);
+	err = udp_sendto(sock->udp_pcb, p, &addr, to->port);
+	pbuf_free(p);
+	if (err == ERR_MEM || err == ERR_BUF)
+		return -ENOMEM;
+	if (err != ERR_OK)
+		return -EIO;
+
+	return size;
 }
 
 /**
@@ -848,7 +1165,10 @@ struct network_interface lwip_socket_ops = {
 	.socket_connect = lwip_socket_connect,
 	.socket_disconnect = lwip_socket_disconnect,
 	.socket_send = lwip_socket_send,
+	.socket_send_nocopy = lwip_socket_send_nocopy,
 	.socket_recv = lwip_socket_recv,
+	.socket_recv_nocopy = lwip_socket_recv_nocopy,
+	.socket_recv_release = lwip_socket_recv_release,
 	.socket_sendto = lwip_socket_sendto,
 	.socket_recvfrom = lwip_socket_recvfrom,
 	.socket_bind = lwip_socket_bind,
@@ -869,7 +1189,10 @@ static void lwip_config_if(struct lwip_network_desc *desc)
 	net->socket_connect = lwip_socket_connect;
 	net->socket_disconnect = lwip_socket_disconnect;
 	net->socket_send = lwip_socket_send;
+	net->socket_send_nocopy = lwip_socket_send_nocopy;
 	net->socket_recv = lwip_socket_recv;
+	net->socket_recv_nocopy = lwip_socket_recv_nocopy;
+	net->socket_recv_release = lwip_socket_recv_release;
 	net->socket_sendto = lwip_socket_sendto;
 	net->socket_recvfrom = lwip_socket_recvfrom;
 	net->socket_bind = lwip_socket_bind;
@@ -42,6 +42,7 @@
 
 #ifdef NO_OS_LWIP_NETWORKING
 
+#include <stdbool.h>
 #include "lwip/netif.h"
 #include "network_interface.h"
 #include "tcp_socket.h"
@@ -55,8 +56,22 @@
 #define NO_OS_LWIP_INIT_ONETIME		0
 #endif
 
+/* Number of zero-copy sends which can wait for an ACK on each socket */
+#ifndef NO_OS_LWIP_NOCOPY_SLOTS
+#define NO_OS_LWIP_NOCOPY_SLOTS		8
+#endif
+
 struct lwip_network_desc;
 
+/* Caller buffer referenced by lwIP until the peer acknowledges it */
+struct lwip_nocopy_chunk {
+	/* Stream position of the byte following the buffer */
+	uint32_t end;
+	/* Called once lwIP no longer references the buffer */
+	void (*sent)(void *ctx);
+	void *ctx;
+};
+
 struct lwip_socket_desc {
 	/* Unique identifier */
 	uint32_t id;
@@ -75,10 +90,20 @@ struct lwip_socket_desc {
 	} state;
 	/* Lwip specific descriptor for each connection. */
 	struct tcp_pcb *pcb;
+	/* Set instead of pcb for sockets opened with PROTOCOL_UDP */
+	struct udp_pcb *udp_pcb;
 	/* Either a packet buffer chain or queue containing the received frames */
 	struct pbuf *p;
 	/* Index of the current read byte in the first pbuf of the chain */
 	uint32_t p_idx;
+	/* Number of bytes written to the connection */
+	uint32_t snd_queued;
+	/* Number of bytes acknowledged by the remote */
+	uint32_t snd_acked;
+	/* Zero-copy sends waiting for an ACK, oldest first */
+	struct lwip_nocopy_chunk nocopy[NO_OS_LWIP_NOCOPY_SLOTS];
+	uint32_t nocopy_head;
+	uint32_t nocopy_count;
 	/* Reference to the parent network descriptor. */
 	struct lwip_network_desc *desc;
 };
@@ -108,6 +133,14 @@ struct no_os_lwip_ops {
 	int32_t (*remove)(void *);
 	int32_t (*netif_output)(struct netif *, struct pbuf *);
 	int32_t (*step)(struct lwip_network_desc *desc, void *);
+	/*
+	 * Add (add set) or drop a destination MAC address filter, for the
+	 * multicast groups joined. Optional, for MACs dropping the frames of the
+	 * groups not joined.
+	 */
+	int32_t (*mac_filter)(void *mac_desc, const uint8_t *addr, bool add);
+	/* NETIF_CHECKSUM_* generated and checked by the MAC, skipped by lwIP */
+	uint16_t checksum_offload;
 };
 
 /* Initialize lwip stack */
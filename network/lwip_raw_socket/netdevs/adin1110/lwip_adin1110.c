@@ -66,7 +66,8 @@
 static uint8_t lwip_buff[ADIN1110_LWIP_BUFF_SIZE];
 
 /**
- * @brief Read a frame from the RX FIFO.
+ * @brief Read a frame from the RX FIFO. The frame is copied from the SPI
+ * buffer directly into a pool pbuf.
  * @param desc - ADIN1110 descriptor.
  * @param p - the received pbuf.
  * @param len - length of the frame.
@@ -75,31 +76,28 @@ static uint8_t lwip_buff[ADIN1110_LWIP_BUFF_SIZE];
 static int adin1110_read_frames(struct adin1110_desc *desc, struct pbuf **p,
 				uint32_t *len)
 {
-	struct adin1110_eth_buff mac_buff = {0};
+	uint8_t *frame;
 	int ret;
 
-	mac_buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
-
-	ret = adin1110_read_fifo(desc, 0, &mac_buff);
+	ret = adin1110_read_fifo_raw(desc, 0, &frame, len);
 	if (ret)
 		return ret;
 
-	*len = mac_buff.len;
-	if (!mac_buff.len)
+	if (!*len)
 		return 0;
 
-	memcpy(lwip_buff, mac_buff.mac_dest, ADIN1110_ETH_HDR_LEN);
-	*p = pbuf_alloc(PBUF_RAW, mac_buff.len, PBUF_POOL);
+	*p = pbuf_alloc(PBUF_RAW, *len, PBUF_POOL);
 	if (!*p)
 		return -ENOMEM;
 
-	pbuf_take(*p, lwip_buff, mac_buff.len);
+	pbuf_take(*p, frame, *len);
 
 	return 0;
 }
 
 /**
- * @brief Read all the frames from the RX FIFO.
+ * @brief Read all the frames from the RX FIFO. If the INT pin is used, the
+ * FIFO is only accessed after the ADIN1110 signaled that frames are available.
  * @param desc - lwip sockets layer specific descriptor.
  * @param data - netif to RX data.
  * @return 0 in case of success, negative error otherwise.
@@ -115,10 +113,20 @@ static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
 	netif_desc = desc->lwip_netif;
 	mac_desc = desc->mac_desc;
 
+	if (mac_desc->int_irq_desc) {
+		if (!mac_desc->rx_pending)
+			return 0;
+
+		mac_desc->rx_pending = false;
+		ret = adin1110_irq_ack(mac_desc, NULL);
+		if (ret)
+			goto retry;
+	}
+
 	do {
 		ret = adin1110_read_frames(mac_desc, &p, &len);
 		if (ret)
-			return ret;
+			goto retry;
 
 		if (len) {
 			LINK_STATS_INC(link.recv);
@@ -131,37 +139,72 @@ static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
 	} while(len);
 
 	return 0;
+
+retry:
+	/* Frames may still be in the FIFO, so check it on the next step */
+	mac_desc->rx_pending = true;
+
+	return ret;
 }
 
 /**
- * @brief Write the data inside a pbuf on the wire.
+ * @brief Write the data inside a pbuf on the wire. Each pbuf in the chain is
+ * sent as a separate fragment, so the frame is not copied unless the chain is
+ * longer than ADIN1110_TX_MAX_FRAGS.
  * @param net - lwip network descriptor to send data to.
  * @param p - pbuf to be sent.
  * @return 0 in case of success, negative error otherwise.
  */
 static int32_t adin1110_netif_output(struct netif *net, struct pbuf *p)
 {
+	struct adin1110_frag frags[ADIN1110_TX_MAX_FRAGS];
 	struct lwip_network_desc *lwip_desc;
 	struct adin1110_desc *mac_desc;
-	struct adin1110_eth_buff buff;
-	uint32_t frame_len;
+	uint32_t nb_frags = 0;
+	struct pbuf *q;
 
 	lwip_desc = net->state;
 	mac_desc = lwip_desc->mac_desc;
 
 	LINK_STATS_INC(link.xmit);
-	frame_len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
 
-	memcpy(&buff.mac_dest, lwip_buff, ADIN1110_ETH_HDR_LEN);
+	for (q = p; q && nb_frags < ADIN1110_TX_MAX_FRAGS; q = q->next) {
+		frags[nb_frags].data = q->payload;
+		frags[nb_frags++].len = q->len;
+	}
+
+	if (q) {
+		frags[0].data = lwip_buff;
+		frags[0].len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
+		nb_frags = 1;
+	}
+
+	return adin1110_write_fifo_sg(mac_desc, 0, frags, nb_frags);
+}
+
+/**
+ * @brief Add or drop a destination MAC address filter of the ADIN1110, the
+ * frames of the multicast groups not joined are dropped by the MAC.
+ * @param desc - descriptor for the ADIN1110.
+ * @param addr - the MAC address.
+ * @param add - add the filter if set, drop it otherwise.
+ * @return 0 in case of success, negative error otherwise.
+ */
+static int32_t adin1110_mac_filter(void *desc, const uint8_t *addr, bool add)
+{
+	uint8_t mac_address[ADIN1110_ETH_ALEN];
 
-	buff.len = frame_len;
-	buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
+	memcpy(mac_address, addr, ADIN1110_ETH_ALEN);
+	if (add)
+		return adin1110_set_mac_addr(desc, mac_address);
 
-	return adin1110_write_fifo(mac_desc, 0, &buff);
+	return adin1110_clear_mac_addr(desc, mac_address);
 }
 
 /**
- * @brief Intialize and configure filters for the ADIN1110.
+ * @brief Intialize and configure filters for the ADIN1110. The filter of the
+ * unicast address is set by adin1110_init(), the multicast ones are added by
+ * adin1110_mac_filter() as the groups are joined.
  * @param desc - descriptor for the ADIN1110.
  * @param param - parameter for the ADIN1110.
  * @return 0 in case of success, negative error otherwise.
@@ -170,25 +213,16 @@ static int32_t adin1110_lwip_init(void **desc, void *param)
 {
 	struct adin1110_desc *adin1110;
 	struct adin1110_init_param *adin1110_ip = param;
-	uint8_t mdns_mcast_addr[NETIF_MAX_HWADDR_LEN] = {0x01, 0x00, 0x5E, 0x00, 0x00, 0xFB};
 	int32_t ret;
 
 	ret = adin1110_init(&adin1110, adin1110_ip);
 	if (ret)
 		return ret;
 
-	ret = adin1110_set_mac_addr(adin1110, adin1110->mac_address);
-	if (ret)
-		goto free_descriptor;
-
 	ret = adin1110_broadcast_filter(adin1110, true);
 	if (ret)
 		goto free_descriptor;
 
-	ret = adin1110_set_mac_addr(adin1110, mdns_mcast_addr);
-	if (ret)
-		goto free_descriptor;
-
 	*desc = adin1110;
 
 	return 0;
@@ -216,6 +250,7 @@ const struct no_os_lwip_ops adin1110_lwip_ops = {
 	.remove = adin1110_lwip_remove,
 	.netif_output = adin1110_netif_output,
 	.step = adin1110_step,
+	.mac_filter = adin1110_mac_filter,
 };
 
 #endif /* NO_OS_LWIP_NETWORKING */
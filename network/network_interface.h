@@ -133,6 +133,24 @@ struct network_interface {
 	 */
 	int32_t (*socket_send)(void *net, uint32_t sock_id,
 			       const void *data, uint32_t size);
+	/**
+	 * @brief (Optional) Send data over a TCP socket without copying it.
+	 *
+	 * The sent bytes are referenced by the network stack until the sent
+	 * callback is called, so they must stay unchanged until then.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param data - Buffer of data to send to the host
+	 * @param size - Size of the buffer in bytes
+	 * @param sent - Called when the sent bytes can be reused
+	 * @param ctx - Parameter of the sent callback
+	 * @return
+	 *  - Number of sent bytes : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_send_nocopy)(void *net, uint32_t sock_id,
+				      const void *data, uint32_t size,
+				      void (*sent)(void *ctx), void *ctx);
 	/**
 	 * @brief Receive data over a TCP socket.
 	 *
@@ -148,6 +166,34 @@ struct network_interface {
 	 */
 	int32_t (*socket_recv)(void *net, uint32_t sock_id,
 			       void *data, uint32_t size);
+	/**
+	 * @brief (Optional) Get a view of the received data, without copying.
+	 *
+	 * The data stays in the network stack buffers until it is released
+	 * with socket_recv_release. Only data contiguous in memory is
+	 * returned, call again after the release to get the rest.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param data - Address where to store the start of the data
+	 * @param size - Maximum data to return
+	 * @return
+	 *  - Number of bytes available at *data : On success
+	 *  - -EAGAIN : No data was received
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_recv_nocopy)(void *net, uint32_t sock_id,
+				      const void **data, uint32_t size);
+	/**
+	 * @brief (Optional) Release data returned by socket_recv_nocopy.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param size - Bytes consumed from the start of the received data
+	 * @return
+	 *  - 0 : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_recv_release)(void *net, uint32_t sock_id,
+				       uint32_t size);
 	/**
 	 * @brief Send a packet over a UDP socket.
 	 * @param net - Network interface
@@ -218,6 +264,20 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+	/**
+	 * @brief (Optional) Wait for network activity.
+	 *
+	 * Blocks until data can be received on one of the open sockets or a
+	 * new connection can be accepted, so that the caller doesn't need to
+	 * poll.
+	 * @param net - Network interface
+	 * @param timeout_ms - Maximum time to wait, in milliseconds
+	 * @return
+	 *  - 0 : A socket is ready
+	 *  - -ETIMEDOUT : Nothing happened until timeout_ms passed
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_wait)(void *net, uint32_t timeout_ms);
 };
 
 #endif
@@ -99,6 +99,22 @@
  */
 #define ENABLE_MEMORY_OPTIMIZATIONS
 
+/*
+ * Resume TLS sessions with RFC 5077 session tickets (in addition to session
+ * IDs), so that reconnects to the same server skip the certificate checks and
+ * the key exchange. Used by sockets with secure_init_param.session set.
+ */
+#define ENABLE_SESSION_TICKETS
+
+/*
+ * Hardware crypto. Define NO_OS_MBEDTLS_ALT_CONFIG to the name of a header
+ * enabling MBEDTLS_AES_ALT, MBEDTLS_SHA256_ALT, MBEDTLS_ECP_ALT etc. for the
+ * accelerators of the platform. The header is included at the end of this
+ * file, and the aes_alt.h, sha256_alt.h... implementations must be in the
+ * include path. Random numbers always come from the platform TRNG.
+ */
+//#define NO_OS_MBEDTLS_ALT_CONFIG "platform_mbedtls_alt.h"
+
 /******************************************************************************/
 /********************* Minimal tls client requirements ************************/
 /******************************************************************************/
@@ -235,6 +251,14 @@
 #endif
 #endif /* MBEDTLS_SSL_PROTO_TLS1_2 */
 
+#ifdef ENABLE_SESSION_TICKETS
+#define MBEDTLS_SSL_SESSION_TICKETS
+#endif /* ENABLE_SESSION_TICKETS */
+
+#ifdef NO_OS_MBEDTLS_ALT_CONFIG
+#include NO_OS_MBEDTLS_ALT_CONFIG
+#endif /* NO_OS_MBEDTLS_ALT_CONFIG */
+
 /* Check if the configuration is ok */
 #include "mbedtls/check_config.h"
 
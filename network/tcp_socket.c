@@ -96,6 +96,8 @@ struct secure_socket_desc {
 	mbedtls_ssl_config	conf;
 	/** Mbedtls tls context */
 	mbedtls_ssl_context	ssl;
+	/** Session to resume, can be NULL */
+	struct secure_session	*session;
 };
 #endif /* DISABLE_SECURE_SOCKET */
 
@@ -127,6 +129,7 @@ static int tls_net_send(struct tcp_socket_desc *sock, unsigned char *buff,
 /* Remove secure descriptor*/
 static void stcp_socket_remove(struct secure_socket_desc *desc)
 {
+	mbedtls_ssl_free(&desc->ssl);
 	mbedtls_pk_free(&desc->pkey);
 	mbedtls_x509_crt_free(&desc->clicert);
 	mbedtls_x509_crt_free(&desc->cacert);
@@ -220,6 +223,16 @@ static int32_t stcp_socket_init(struct secure_socket_desc **desc,
 			goto exit;
 	}
 
+#ifdef MBEDTLS_SSL_SESSION_TICKETS
+	if (param->session)
+		mbedtls_ssl_conf_session_tickets(&ldesc->conf,
+						 MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+	else
+		mbedtls_ssl_conf_session_tickets(&ldesc->conf,
+						 MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+	ldesc->session = param->session;
+
 	/* Config Random number generator */
 	mbedtls_ssl_conf_rng(&ldesc->conf,
 			     (int (*)(void *, unsigned char *, size_t))
@@ -249,6 +262,63 @@ exit:
 
 	return ret;
 }
+
+/*
+ * Do the TLS handshake, offering the saved session if there is one. The
+ * server may refuse it, in which case a full handshake takes place. The
+ * negotiated session is saved for the next connection.
+ */
+static int32_t stcp_socket_handshake(struct secure_socket_desc *desc)
+{
+	struct secure_session *session = desc->session;
+	int32_t ret;
+
+	/* The context may be used by a previous connection */
+	ret = mbedtls_ssl_session_reset(&desc->ssl);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (session && session->valid) {
+		ret = mbedtls_ssl_set_session(&desc->ssl, &session->session);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			secure_session_free(session);
+	}
+
+	do {
+		ret = mbedtls_ssl_handshake(&desc->ssl);
+	} while (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+		 ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		if (session)
+			secure_session_free(session);
+
+		return ret;
+	}
+
+	if (session) {
+		secure_session_free(session);
+		ret = mbedtls_ssl_get_session(&desc->ssl, &session->session);
+		/* Not fatal, the next connection does a full handshake */
+		session->valid = !ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Forget a TLS session, so that the next connection using it does a
+ * full handshake.
+ * @param session - Session saved by a previous connection.
+ */
+void secure_session_free(struct secure_session *session)
+{
+	if (!session)
+		return;
+
+	mbedtls_ssl_session_free(&session->session);
+	mbedtls_ssl_session_init(&session->session);
+	session->valid = false;
+}
 #endif /* DISABLE_SECURE_SOCKET */
 
 /**
@@ -280,7 +350,15 @@ int32_t socket_init(struct tcp_socket_desc **desc,
 	else
 		buff_size = DEFAULT_CONNECTION_BUFFER_SIZE;
 
-	ret = ldesc->net->socket_open(ldesc->net->net, &ldesc->id, PROTOCOL_TCP,
+#ifndef DISABLE_SECURE_SOCKET
+	/* TLS is only supported over TCP */
+	if (param->proto != PROTOCOL_TCP && param->secure_init_param) {
+		no_os_free(ldesc);
+		return -1;
+	}
+#endif /* DISABLE_SECURE_SOCKET */
+
+	ret = ldesc->net->socket_open(ldesc->net->net, &ldesc->id, param->proto,
 				      buff_size);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
 		no_os_free(ldesc);
@@ -348,9 +426,7 @@ int32_t socket_connect(struct tcp_socket_desc *desc,
 
 #ifndef DISABLE_SECURE_SOCKET
 	if (desc->secure) {
-		do {
-			ret = mbedtls_ssl_handshake(&desc->secure->ssl);
-		} while (ret == MBEDTLS_ERR_SSL_WANT_READ);
+		ret = stcp_socket_handshake(desc->secure);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 	}
@@ -390,6 +466,44 @@ int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 				      data, len);
 }
 
+/**
+ * @brief See \ref network_interface.socket_send_nocopy. Falls back to a copying
+ * send on secure sockets and on network interfaces without zero-copy support,
+ * calling the sent callback right away.
+ */
+int32_t socket_send_nocopy(struct tcp_socket_desc *desc, const void *data,
+			   uint32_t len, void (*sent)(void *ctx), void *ctx)
+{
+	int32_t ret;
+
+	if (!desc || !sent)
+		return -1;
+
+#ifndef DISABLE_SECURE_SOCKET
+	if (!desc->secure && desc->net->socket_send_nocopy)
+#else
+	if (desc->net->socket_send_nocopy)
+#endif /* DISABLE_SECURE_SOCKET */
+		return desc->net->socket_send_nocopy(desc->net->net, desc->id,
+						     data, len, sent, ctx);
+
+	ret = socket_send(desc, data, len);
+	if (ret > 0)
+		sent(ctx);
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_sendto */
+int32_t socket_sendto(struct tcp_socket_desc *desc, const void *data,
+		      uint32_t len, const struct socket_address *to)
+{
+	if (!desc || !desc->net->socket_sendto)
+		return -1;
+
+	return desc->net->socket_sendto(desc->net->net, desc->id, data, len, to);
+}
+
 /** @brief See \ref network_interface.socket_recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len)
 {
@@ -412,6 +526,56 @@ int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len)
 				      len);
 }
 
+/**
+ * @brief See \ref network_interface.socket_recv_nocopy. Not available on secure
+ * sockets, whose data must be decrypted in a buffer of the caller.
+ * @return -ENOSYS if not supported, so the caller can use socket_recv instead.
+ */
+int32_t socket_recv_nocopy(struct tcp_socket_desc *desc, const void **data,
+			   uint32_t len)
+{
+	if (!desc || !data)
+		return -EINVAL;
+
+#ifndef DISABLE_SECURE_SOCKET
+	if (desc->secure)
+		return -ENOSYS;
+#endif /* DISABLE_SECURE_SOCKET */
+
+	if (!desc->net->socket_recv_nocopy || !desc->net->socket_recv_release)
+		return -ENOSYS;
+
+	return desc->net->socket_recv_nocopy(desc->net->net, desc->id, data,
+					     len);
+}
+
+/** @brief See \ref network_interface.socket_recv_release */
+int32_t socket_recv_release(struct tcp_socket_desc *desc, uint32_t len)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->net->socket_recv_release)
+		return -ENOSYS;
+
+	return desc->net->socket_recv_release(desc->net->net, desc->id, len);
+}
+
+/**
+ * @brief See \ref network_interface.socket_wait. Waits for activity on all
+ * the sockets of the network interface of desc.
+ */
+int32_t socket_wait(struct tcp_socket_desc *desc, uint32_t timeout_ms)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->net->socket_wait)
+		return -ENOSYS;
+
+	return desc->net->socket_wait(desc->net->net, timeout_ms);
+}
+
 /** @brief See \ref network_interface.socket_bind */
 int32_t socket_bind(struct tcp_socket_desc *desc, uint16_t port)
 {
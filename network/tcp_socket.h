@@ -69,6 +69,19 @@ struct tcp_socket_desc {
 };
 
 #ifndef DISABLE_SECURE_SOCKET
+/**
+ * @struct secure_session
+ * @brief TLS session saved after a handshake, offered to the server on the
+ * next connection so that a full handshake is avoided. Must be zero initialized
+ * and outlive the sockets using it.
+ */
+struct secure_session {
+	/** Session ID or ticket and the master secret */
+	mbedtls_ssl_session	session;
+	/** Set when session can be offered for resumption */
+	bool			valid;
+};
+
 /**
  * @struct stcp_socket_init_param
  * @brief Parameter to initialize a TCP Socket
@@ -109,6 +122,11 @@ struct secure_init_param {
 	uint8_t			*cli_pk;
 	/** cli_pk length */
 	uint32_t		cli_pk_len;
+	/**
+	 * Storage for the session, kept between connections to resume it.
+	 * NULL to do a full handshake on each connection.
+	 */
+	struct secure_session	*session;
 };
 
 #endif /* DISABLE_SECURE_SOCKET */
@@ -126,6 +144,11 @@ struct tcp_socket_init_param {
 	 *  DEFAULT_CONNECTION_BUFFER_SIZE from tcp_socket.c
 	 */
 	uint32_t			max_buff_size;
+	/**
+	 * Protocol of the socket. 0 (PROTOCOL_TCP) by default. PROTOCOL_UDP
+	 * sockets are used with socket_sendto.
+	 */
+	enum socket_protocol		proto;
 #ifndef DISABLE_SECURE_SOCKET
 	/**
 	 * Reference to \ref secure_init_param if a TCP socket over TLS should
@@ -157,8 +180,29 @@ int32_t socket_disconnect(struct tcp_socket_desc *desc);
 int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 		    uint32_t len);
 
+/* Socket send, referencing the data until the sent callback */
+int32_t socket_send_nocopy(struct tcp_socket_desc *desc, const void *data,
+			   uint32_t len, void (*sent)(void *ctx), void *ctx);
+
+/* Socket send over UDP */
+int32_t socket_sendto(struct tcp_socket_desc *desc, const void *data,
+		      uint32_t len, const struct socket_address *to);
+
+#ifndef DISABLE_SECURE_SOCKET
+/* Forget a saved TLS session */
+void secure_session_free(struct secure_session *session);
+#endif /* DISABLE_SECURE_SOCKET */
+
 /* Socket recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len);
+/* Socket recv without copy. The data must be released */
+int32_t socket_recv_nocopy(struct tcp_socket_desc *desc, const void **data,
+			   uint32_t len);
+/* Release data returned by socket_recv_nocopy */
+int32_t socket_recv_release(struct tcp_socket_desc *desc, uint32_t len);
+
+/* Wait for activity on the sockets of the network interface */
+int32_t socket_wait(struct tcp_socket_desc *desc, uint32_t timeout_ms);
 
 /* Socket bind */
 int32_t socket_bind(struct tcp_socket_desc *desc, uint16_t port);
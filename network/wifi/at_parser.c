@@ -72,6 +72,8 @@
 #define PUI8(X)			((uint8_t *)(X))
 /* Timeout waiting for module response. (20 seconds) */
 #define MODULE_TIMEOUT		20000
+/* Bytes taken from the UART software FIFO at once in streaming mode */
+#define STREAM_CHUNK_LEN	64u
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -128,6 +130,12 @@ struct at_desc {
 	struct no_os_irq_ctrl_desc	*irq_desc;
 	/* Uart irq id */
 	uint32_t		uart_irq_id;
+	/*
+	 * Set when the UART fills its own FIFO (asynchronous_rx). The module
+	 * output is then parsed in bulk by at_step, instead of from a callback
+	 * for each character.
+	 */
+	bool			stream;
 
 	/* - Connection related fields */
 	/* Structures storing connections status */
@@ -366,17 +374,14 @@ static inline void end_conn_read(struct at_desc *desc)
 	no_os_cb_end_async_write(conn->cbuff);
 }
 
-/* Start new read operation */
-static inline void start_conn_read(struct at_desc *desc, bool is_new_message)
+/* Get a buffer from the application if the +IPD is for a new connection */
+static inline void open_conn(struct at_desc *desc)
 {
 	struct connection_desc	*conn;
-	uint8_t			*buff;
-	uint32_t		available_len;
-	int32_t			ret;
 
 	conn = &desc->conn[desc->current_conn];
 
-	if (is_new_message && !conn->active) {
+	if (!conn->active) {
 		/*
 		 * Notify that a new connection has started. Application needs
 		 * to set a cbuff for the connection where data will be written.
@@ -394,6 +399,20 @@ static inline void start_conn_read(struct at_desc *desc, bool is_new_message)
 		 * no_os_uart_write_nonblocking
 		 */
 	}
+}
+
+/* Start new read operation */
+static inline void start_conn_read(struct at_desc *desc, bool is_new_message)
+{
+	struct connection_desc	*conn;
+	uint8_t			*buff;
+	uint32_t		available_len;
+	int32_t			ret;
+
+	conn = &desc->conn[desc->current_conn];
+
+	if (is_new_message)
+		open_conn(desc);
 
 	if (!conn->cbuff)
 		/* There is no buffer set for this connection */
@@ -417,37 +436,50 @@ dummy_read:
 	conn->to_read -= 1;
 }
 
-/* Handle the uart read done */
-static void at_callback_rd_done(struct at_desc *desc)
+/*
+ * Interpret a character outside of a payload. Return true if it ends an +IPD
+ * header, so the payload follows.
+ */
+static bool parse_ch(struct at_desc *desc, uint8_t ch)
 {
 	static const struct at_buff ready_msg = {PUI8("ready\r\n"), 7};
 
+	if (desc->callback_operation == RESETTING_MODULE) {
+		if (match_message(&ready_msg, &desc->ready_idx, ch))
+			desc->callback_operation = READING_RESPONSES;
+		return false;
+	}
+
+	if (is_payload_message(desc, ch)) {
+		/* New payload received */
+		desc->callback_operation = READING_PAYLOAD;
+		return true;
+	}
+
+	if (ch == '>' && desc->callback_operation == WAITING_SEND) {
+		desc->callback_operation = READING_RESPONSES;
+	} else if (desc->result.len >= RESULT_BUFF_LEN) {
+		desc->errors |= AT_ERROR_INTERNAL_BUFFER_OVERFLOW;
+		desc->result.len = 0;
+	} else if (!is_async_messages(desc, ch)) {
+		/* Add received character to result buffer */
+		desc->result.buff[desc->result.len++] = ch;
+	}
+
+	return false;
+}
+
+/* Handle the uart read done */
+static void at_callback_rd_done(struct at_desc *desc)
+{
 	switch (desc->callback_operation) {
 	case RESETTING_MODULE:
-		if (match_message(&ready_msg, &desc->ready_idx,
-				  desc->read_ch))
-			desc->callback_operation = READING_RESPONSES;
-		break;
 	case WAITING_SEND:
 	case READING_RESPONSES:
-		if (is_payload_message(desc, desc->read_ch)) {
-			/* New payload received */
-			desc->callback_operation = READING_PAYLOAD;
+		if (parse_ch(desc, desc->read_ch)) {
 			start_conn_read(desc, true);
 			return ;
 		}
-
-		if (desc->read_ch == '>' && desc->callback_operation ==
-		    WAITING_SEND) {
-			desc->callback_operation = READING_RESPONSES;
-		} else if (desc->result.len >= RESULT_BUFF_LEN) {
-			desc->errors |=
-				AT_ERROR_INTERNAL_BUFFER_OVERFLOW;
-			desc->result.len = 0;
-		} else if (!is_async_messages(desc, desc->read_ch))
-			/* Add received character to result buffer */
-			desc->result.buff[desc->result.len++] =
-				desc->read_ch;
 		break;
 	case READING_PAYLOAD:
 		/* Receiving payload from connection */
@@ -477,6 +509,78 @@ static void at_callback_error(struct at_desc *desc)
 	no_os_uart_read_nonblocking(desc->uart_desc, &desc->read_ch, 1);
 }
 
+/* Parse data read from the UART in streaming mode */
+static void stream_parse(struct at_desc *desc, uint8_t *buff, uint32_t len)
+{
+	struct connection_desc	*conn;
+	uint32_t		i;
+	uint32_t		n;
+
+	i = 0;
+	while (i < len) {
+		if (desc->callback_operation != READING_PAYLOAD) {
+			if (parse_ch(desc, buff[i++]))
+				open_conn(desc);
+			continue;
+		}
+
+		if (desc->current_conn < 0) {
+			desc->callback_operation = READING_RESPONSES;
+			continue;
+		}
+
+		/* Payload goes straight to the connection buffer */
+		conn = &desc->conn[desc->current_conn];
+		n = no_os_min(len - i, conn->to_read);
+		if (conn->cbuff && n)
+			if (NO_OS_IS_ERR_VALUE(no_os_cb_write(conn->cbuff,
+							      buff + i, n)))
+				desc->errors |= AT_ERROR_CONN_BUFFER_OVERRUN;
+		conn->to_read -= n;
+		i += n;
+		if (!conn->to_read) {
+			desc->callback_operation = READING_RESPONSES;
+			desc->current_conn = -1;
+		}
+	}
+}
+
+/**
+ * @brief Process the data received from the module.
+ *
+ * Only needed when the UART was initialized with asynchronous_rx. In this
+ * case the module output is read from the UART FIFO here and by
+ * \ref at_run_cmd, so this must be called often enough for the FIFO not to
+ * overflow while no command runs.
+ * @param desc - AT parser reference
+ * @return
+ *  - 0 : On success
+ *  - Negative error code otherwise
+ */
+int32_t at_step(struct at_desc *desc)
+{
+	uint8_t	buff[STREAM_CHUNK_LEN];
+	int32_t	ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->stream)
+		return 0;
+
+	while (true) {
+		ret = no_os_uart_read(desc->uart_desc, buff, sizeof(buff));
+		if (ret == -EAGAIN || ret == 0)
+			return 0;
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			desc->errors |= AT_ERROR_UART;
+			return ret;
+		}
+
+		stream_parse(desc, buff, ret);
+	}
+}
+
 /* Wait the response for the last command for MODULE_TIMEOUT milliseconds */
 static int32_t wait_for_response(struct at_desc *desc)
 {
@@ -495,6 +599,7 @@ static int32_t wait_for_response(struct at_desc *desc)
 	timeout = MODULE_TIMEOUT;
 	result = -1;
 	do {
+		at_step(desc);
 		if (i < desc->result.len) {
 			for (j = 0; j < NB_RESPONSE_MESSAGES; j++)
 				if (match_message(&responses[j],
@@ -542,6 +647,7 @@ static int32_t send_cmd(struct at_desc *desc, enum at_cmd cmd,
 			return -1;
 		/* Wait until '>' is received */
 		while (timeout--) {
+			at_step(desc);
 			if (WAITING_SEND != desc->callback_operation)
 				break;
 			no_os_mdelay(1);
@@ -555,6 +661,7 @@ static int32_t send_cmd(struct at_desc *desc, enum at_cmd cmd,
 		if (desc->is_wifi_connected) {
 			/* Wait for WIFI_DISCONNECT */
 			do {
+				at_step(desc);
 				if (desc->is_wifi_connected == 0)
 					break;
 				no_os_mdelay(1);
@@ -799,6 +906,7 @@ static int32_t handle_special(struct at_desc *desc, enum at_cmd cmd)
 		timeout = MODULE_TIMEOUT;
 		do {
 			/* Wait for "ready" message */
+			at_step(desc);
 			if (desc->callback_operation != RESETTING_MODULE)
 				break;
 			no_os_mdelay(1);
@@ -928,6 +1036,9 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 	ldesc->uart_desc = param->uart_desc;
 	ldesc->irq_desc = param->irq_desc;
 	ldesc->uart_irq_id = param->uart_irq_id;
+	ldesc->stream = !!ldesc->uart_desc->rx_fifo;
+	if (ldesc->stream)
+		goto init_buffers;
 
 	callback_desc_rd.ctx = ldesc;
 	callback_desc_rd.event = NO_OS_EVT_UART_RX_COMPLETE;
@@ -951,6 +1062,7 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 	if (0 != no_os_irq_enable(ldesc->irq_desc, ldesc->uart_irq_id))
 		goto free_irq;
 
+init_buffers:
 	/* Link buffer structure with static buffers */
 	ldesc->result.buff = ldesc->buffers.result_buff;
 	ldesc->result.len = 0;
@@ -960,7 +1072,9 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 	ldesc->callback_operation = READING_RESPONSES;
 
 	/* The read will be handled by the callback */
-	no_os_uart_read_nonblocking(ldesc->uart_desc, &ldesc->read_ch, 1);
+	if (!ldesc->stream)
+		no_os_uart_read_nonblocking(ldesc->uart_desc, &ldesc->read_ch,
+					    1);
 
 	/** Software reset */
 	if (param->sw_reset_en)
@@ -996,7 +1110,9 @@ int32_t at_init(struct at_desc **desc, const struct at_init_param *param)
 	return 0;
 
 free_irq:
-	no_os_irq_unregister_callback(ldesc->irq_desc, ldesc->uart_irq_id, NULL);
+	if (!ldesc->stream)
+		no_os_irq_unregister_callback(ldesc->irq_desc,
+					      ldesc->uart_irq_id, NULL);
 free_desc:
 	no_os_free(ldesc);
 	*desc = NULL;
@@ -1015,7 +1131,9 @@ int32_t at_remove(struct at_desc *desc)
 	if (!desc)
 		return -1;
 
-	no_os_irq_unregister_callback(desc->irq_desc, desc->uart_irq_id, NULL);
+	if (!desc->stream)
+		no_os_irq_unregister_callback(desc->irq_desc,
+					      desc->uart_irq_id, NULL);
 	no_os_free(desc);
 
 	return 0;
@@ -46,6 +46,11 @@
  *  A command can be executed with \ref at_run_cmd and data from a connection
  *  can be read with \ref at_read_buffer .
  *
+ *  By default the module output is read one character at a time, from the
+ *  UART callback. If the UART is initialized with asynchronous_rx, its
+ *  software FIFO is read in bulk by \ref at_step instead and the +IPD payloads
+ *  are copied in the connection buffers in one go.
+ *
  *  How AT command work can be found at:\n
  *  https://cdn.sparkfun.com/datasheets/Wireless/WiFi/Command%20Doc.pdf\n
  *  https://github.com/espressif/ESP8266_AT/wiki/basic_at_0019000902
@@ -348,6 +353,8 @@ int32_t at_init(struct at_desc **desc,const struct at_init_param *param);
 /* Free resources used by parser */
 int32_t at_remove(struct at_desc *desc);
 
+/* Process the data received from the module in streaming mode */
+int32_t at_step(struct at_desc *desc);
 /* Execute an AT command */
 int32_t at_run_cmd(struct at_desc *desc, enum at_cmd cmd, enum cmd_operation op,
 		   union in_out_param *param);
@@ -681,6 +681,10 @@ static int32_t wifi_socket_recv(struct wifi_desc *desc, uint32_t sock_id,
 	if (sock->state != SOCKET_CONNECTED)
 		return -ENOTCONN;
 
+	ret = at_step(desc->at);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
 	no_os_cb_size(sock->cb, &available_size);
 	if (available_size == 0)
 		return -EAGAIN;
@@ -26,15 +26,19 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_units.h \
 		$(INCLUDE)/no_os_init.h \
 		$(INCLUDE)/no_os_crc8.h \
+		$(INCLUDE)/no_os_crc_table.h \
 		$(INCLUDE)/no_os_alloc.h \
 		$(INCLUDE)/no_os_mutex.h \
-		$(INCLUDE)/no_os_circular_buffer.h
+		$(INCLUDE)/no_os_circular_buffer.h \
+		$(INCLUDE)/no_os_dsp.h \
+		$(INCLUDE)/no_os_pwm.h
 
 SRCS += $(DRIVERS)/api/no_os_gpio.c \
 		$(DRIVERS)/api/no_os_i2c.c  \
 		$(NO-OS)/util/no_os_lf256fifo.c \
 		$(DRIVERS)/api/no_os_irq.c  \
 		$(DRIVERS)/api/no_os_spi.c  \
+		$(DRIVERS)/api/no_os_pwm.c  \
 		$(DRIVERS)/api/no_os_timer.c  \
 		$(DRIVERS)/api/no_os_uart.c \
 		$(NO-OS)/util/no_os_list.c \
@@ -42,7 +46,8 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 		$(NO-OS)/util/no_os_crc8.c \
 		$(NO-OS)/util/no_os_alloc.c \
 		$(NO-OS)/util/no_os_mutex.c \
-		$(NO-OS)/util/no_os_circular_buffer.c
+		$(NO-OS)/util/no_os_circular_buffer.c \
+		$(NO-OS)/util/no_os_dsp.c
 
 INCS += $(DRIVERS)/adc/ad7616/ad7616.h
 
@@ -1,5 +1,6 @@
 CFLAGS += -DENABLE_UART_STDIO
 SRCS += $(NO-OS)/util/no_os_util.c \
+	$(NO-OS)/util/no_os_lfring.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_delay.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_i2c.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c \
@@ -14,6 +15,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 	$(PLATFORM_DRIVERS)/aducm3029_timer.c \
 	$(DRIVERS)/cdc/ad7746/ad7746.c \
 	$(DRIVERS)/api/no_os_i2c.c \
+	$(DRIVERS)/api/no_os_gpio.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(DRIVERS)/api/no_os_timer.c \
 	$(DRIVERS)/api/no_os_uart.c \
@@ -22,6 +24,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 INCS +=	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
 	$(INCLUDE)/no_os_util.h \
+	$(INCLUDE)/no_os_lfring.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_timer.h \
 	$(INCLUDE)/no_os_error.h \
@@ -41,7 +41,8 @@ SRCS += $(PROJECT)/src/app.c \
 	$(NO-OS)/jesd204/jesd204-core.c \
 	$(NO-OS)/jesd204/jesd204-fsm.c
 ifeq (y,$(strip $(QUAD_MXFE)))
-SRCS += $(DRIVERS)/frequency/adf4371/adf4371.c
+SRCS += $(DRIVERS)/frequency/adf4371/adf4371.c \
+	$(NO-OS)/util/no_os_reg_seq.c
 endif
 ifeq (y,$(strip $(IIOD)))
 LIBRARIES += iio
@@ -104,7 +105,8 @@ INCS +=	$(PROJECT)/src/app_clock.h \
 	$(INCLUDE)/jesd204.h \
 	$(NO-OS)/jesd204/jesd204-priv.h
 ifeq (y,$(strip $(QUAD_MXFE)))
-INCS += $(DRIVERS)/frequency/adf4371/adf4371.h
+INCS += $(DRIVERS)/frequency/adf4371/adf4371.h \
+	$(INCLUDE)/no_os_reg_seq.h
 endif
 ifeq (y,$(strip $(IIOD)))
 INCS += $(NO-OS)/iio/iio_app/iio_app.h \
@@ -21,6 +21,7 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 		$(INCLUDE)/no_os_list.h		\
 		$(INCLUDE)/no_os_dma.h		\
 		$(INCLUDE)/no_os_crc8.h		\
+		$(INCLUDE)/no_os_crc_table.h		\
 		$(INCLUDE)/no_os_uart.h		\
 		$(INCLUDE)/no_os_lf256fifo.h	\
 		$(INCLUDE)/no_os_util.h		\
@@ -210,9 +210,6 @@ int32_t no_os_spi_write(void *devHalCfg, const uint8_t txData[],
 			uint32_t numTxBytes)
 {
 	static const int32_t MAX_SIZE = 4096;
-	uint32_t toWrite = 0;
-	int32_t result = 0;
-	int32_t remaining = numTxBytes;
 	struct adrv9002_hal_cfg *halCfg = NULL;
 
 	if (devHalCfg == NULL)
@@ -220,15 +217,9 @@ int32_t no_os_spi_write(void *devHalCfg, const uint8_t txData[],
 
 	halCfg = (struct adrv9002_hal_cfg *)devHalCfg;
 
-	do {
-		toWrite = (remaining > MAX_SIZE) ? MAX_SIZE : remaining;
-		result = no_os_spi_write_and_read(halCfg->spi, &txData[numTxBytes - remaining],
-						  toWrite);
-		if (result < 0)
-			return ADI_COMMON_ERR_API_FAIL;
-
-		remaining -= toWrite;
-	} while (remaining > 0);
+	if (no_os_spi_write_chunked(halCfg->spi, (uint8_t *)txData, numTxBytes,
+				    MAX_SIZE))
+		return ADI_COMMON_ERR_API_FAIL;
 
 	return ADI_COMMON_ERR_OK;
 }
@@ -56,6 +56,7 @@ SRCS += $(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.c \
 ifeq (y,$(strip $(IIOD)))
 SRC_DIRS += $(NO-OS)/iio/iio_app
 LIBRARIES += iio
+IIO_TRACK_CAL = y
 SRCS += $(NO-OS)/util/no_os_fifo.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
@@ -69,7 +70,10 @@ endif
 SRCS +=	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
-	$(NO-OS)/util/no_os_clk.c
+	$(NO-OS)/util/no_os_crc32.c \
+	$(NO-OS)/util/no_os_clk.c \
+	$(NO-OS)/util/no_os_profile.c \
+	$(NO-OS)/util/no_os_track_cal.c
 ifeq (xilinx,$(strip $(PLATFORM)))
 SRCS += $(DRIVERS)/axi_core/jesd204/xilinx_transceiver.c \
 	$(DRIVERS)/axi_core/jesd204/axi_adxcvr.c \
@@ -155,6 +159,9 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_units.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_clk.h \
+	$(INCLUDE)/no_os_crc32.h \
+	$(INCLUDE)/no_os_profile.h \
+	$(INCLUDE)/no_os_track_cal.h \
 	$(INCLUDE)/jesd204.h \
 	$(NO-OS)/jesd204/jesd204-priv.h
 ifeq (y,$(strip $(IIOD)))
@@ -58,4 +58,10 @@
 // #define DMA_EXAMPLE
 // #define IIO_SUPPORT
 
+/* Skip the second ARM checksum poll for an image whose CRC-32 matches the
+ * last image that passed it. Set to 0 to always verify. */
+#ifndef TALISE_ARM_SKIP_REVERIFY
+#define TALISE_ARM_SKIP_REVERIFY 1
+#endif
+
 #endif /* APP_CONFIG_H_ */
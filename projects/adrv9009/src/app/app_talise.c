@@ -46,6 +46,7 @@
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
+#include "no_os_crc32.h"
 
 // talise
 #include "talise.h"
@@ -73,6 +74,10 @@
 #include "app_jesd.h"
 
 
+/* CRC-32 of the last ARM image the device reported a valid checksum for. */
+static uint32_t talise_arm_verified_crc;
+static bool talise_arm_verified;
+
 bool adrv9009_check_sysref_rate(uint32_t lmfc, uint32_t sysref)
 {
 	uint32_t div, mod;
@@ -93,6 +98,7 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 	uint16_t deframerStatus = 0;
 	uint8_t framerStatus = 0;
 	uint32_t count = sizeof(armBinary);
+	uint32_t armCrc;
 	taliseArmVersionInfo_t talArmVersionInfo;
 #if defined(ADRV9008_1)
 	uint32_t initCalMask = TAL_ADC_TUNER | TAL_TIA_3DB_CORNER | TAL_DC_OFFSET |
@@ -220,14 +226,24 @@ adiHalErr_t talise_setup(taliseDevice_t * const pd, taliseInit_t * const pi)
 			goto error_11;
 		}
 
-		/* TALISE_verifyArmChecksum() will timeout after 200ms
-		 * if ARM checksum is not computed
+		/* TALISE_loadArmFromBinary() already waited for the ARM checksum.
+		 * Verify it again, which may take up to 200ms, only for an image
+		 * that did not pass the check before.
 		 */
-		talAction = TALISE_verifyArmChecksum(pd);
-		if (talAction != TAL_ERR_OK) {
-			/*< user code- ARM did not load properly - check armBinary & clock/profile settings >*/
-			printf("error: TALISE_verifyArmChecksum() failed\n");
-			goto error_11;
+		armCrc = no_os_crc32(no_os_crc32_get_table(0xEDB88320),
+				     &armBinary[0], count, 0);
+		if (!TALISE_ARM_SKIP_REVERIFY || !talise_arm_verified ||
+		    armCrc != talise_arm_verified_crc) {
+			talAction = TALISE_verifyArmChecksum(pd);
+			if (talAction != TAL_ERR_OK) {
+				/*< user code- ARM did not load properly - check armBinary & clock/profile settings >*/
+				printf("error: TALISE_verifyArmChecksum() failed\n");
+				talise_arm_verified = false;
+				goto error_11;
+			}
+
+			talise_arm_verified_crc = armCrc;
+			talise_arm_verified = true;
 		}
 
 	} else {
@@ -768,3 +784,80 @@ void talise_shutdown(taliseDevice_t * const pd)
 		/*** < User: decide what to do based on Talise recovery action returned > ***/
 	}
 }
+
+/* Names of the tracking cals, by bit of their taliseTrackingCalibrations_t */
+const char * const talise_track_cal_names[NO_OS_TRACK_CAL_MAX] = {
+	"rx1_qec", "rx2_qec", "orx1_qec", "orx2_qec",
+	"tx1_lol", "tx2_lol", "tx1_qec", "tx2_qec",
+	"rx1_hd2", "rx2_hd2",
+};
+
+/* Pause or resume the tracking cals of mask, they must be enabled. */
+static int talise_track_cal_run(void *dev, uint32_t mask, bool run)
+{
+	uint32_t talAction;
+
+	talAction = TALISE_setAllTrackCalState(dev, mask, run ? mask : 0);
+	if (talAction != TALACT_NO_ACTION)
+		return -EIO;
+
+	return 0;
+}
+
+/*
+ * The pending and error flags come in pairs, in the order of the cal bits.
+ * The HD2 cals have no flags, they are paused and resumed but never busy.
+ */
+static int talise_track_cal_status(void *dev, uint32_t *busy, uint32_t *err)
+{
+	uint32_t talAction;
+	uint32_t pending;
+	uint32_t i;
+
+	talAction = TALISE_getPendingTrackingCals(dev, &pending);
+	if (talAction != TALACT_NO_ACTION)
+		return -EIO;
+
+	*busy = 0;
+	*err = 0;
+	for (i = 0; i < 8; i++) {
+		if (pending & NO_OS_BIT(2 * i))
+			*busy |= NO_OS_BIT(i);
+		if (pending & NO_OS_BIT(2 * i + 1))
+			*err |= NO_OS_BIT(i);
+	}
+
+	return 0;
+}
+
+/* Tracking cal scheduling of a talise device, dev is its taliseDevice_t. */
+const struct no_os_track_cal_ops talise_track_cal_ops = {
+	.run = talise_track_cal_run,
+	.status = talise_track_cal_status,
+};
+
+/**
+ * Allocate a tracking cal scheduler for the cals enabled on a talise device.
+ * @param track_cal - The scheduler descriptor.
+ * @param pd - The talise device, in the radioOn state.
+ * @param mode - The scheduling mode.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int talise_track_cal_init(struct no_os_track_cal **track_cal,
+			  taliseDevice_t * const pd,
+			  enum no_os_track_cal_mode mode)
+{
+	struct no_os_track_cal_init_param init = {
+		.ops = &talise_track_cal_ops,
+		.dev = pd,
+		.names = talise_track_cal_names,
+		.mode = mode,
+	};
+	uint32_t talAction;
+
+	talAction = TALISE_getEnabledTrackingCals(pd, &init.mask);
+	if (talAction != TALACT_NO_ACTION)
+		return -EIO;
+
+	return no_os_track_cal_init(track_cal, &init);
+}
@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include "talise_types.h"
 #include "adi_hal.h"
+#include "no_os_track_cal.h"
 
 enum taliseDeviceId {
 	TALISE_A = 0u,
@@ -62,4 +63,10 @@ int talise_multi_chip_sync(taliseDevice_t * pd, int step);
 void talise_shutdown(taliseDevice_t * const pd);
 bool adrv9009_check_sysref_rate(uint32_t lmfc, uint32_t sysref);
 
+extern const char * const talise_track_cal_names[NO_OS_TRACK_CAL_MAX];
+extern const struct no_os_track_cal_ops talise_track_cal_ops;
+int talise_track_cal_init(struct no_os_track_cal **track_cal,
+			  taliseDevice_t * const pd,
+			  enum no_os_track_cal_mode mode);
+
 #endif /* __APP_TALISE_H */
\ No newline at end of file
@@ -43,15 +43,41 @@
 #include "iio_app.h"
 #include "iio_axi_adc.h"
 #include "iio_axi_dac.h"
+#include "iio_track_cal.h"
+#include "no_os_profile.h"
 #ifndef ALTERA_PLATFORM
 #include "xilinx_uart.h"
 #else
 #include "altera_uart.h"
 #endif
 
+/* Period of the tracking cal status reads, in ms */
+#define TRACK_CAL_POLL_MS	100
+
+/* Update the tracking cal counters read by the clients */
+static int track_cal_poll(void *arg)
+{
+	struct no_os_track_cal **track_cal = arg;
+	static uint32_t last;
+	uint32_t now = no_os_get_cycles();
+	int t;
+
+	if ((uint64_t)(now - last) * 1000 <
+	    (uint64_t)no_os_get_cycles_freq() * TRACK_CAL_POLL_MS)
+		return 0;
+	last = now;
+
+	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++)
+		no_os_track_cal_poll(track_cal[t]);
+
+	return 0;
+}
+
 int32_t start_iiod(struct axi_dmac *rx_dmac, struct axi_dmac *tx_dmac,
-		   struct axi_adc *rx_adc, struct axi_dac *tx_dac)
+		   struct axi_adc *rx_adc, struct axi_dac *tx_dac,
+		   struct no_os_track_cal **track_cal)
 {
+	struct iio_track_cal_desc	*track_cal_desc[TALISE_DEVICE_ID_MAX];
 	struct iio_axi_adc_init_param	iio_axi_adc_init_par;
 	struct iio_axi_dac_init_param	iio_axi_dac_init_par;
 	struct iio_app_init_param app_init_param = { 0 };
@@ -61,6 +87,7 @@ int32_t start_iiod(struct axi_dmac *rx_dmac, struct axi_dmac *tx_dmac,
 	struct iio_device		*dac_dev_desc;
 	struct iio_app_desc *app;
 	int32_t				status;
+	int				t;
 	struct xil_uart_init_param platform_uart_init_par = {
 #ifdef XPAR_XUARTLITE_NUM_INSTANCES
 		.type = UART_PL,
@@ -120,6 +147,12 @@ int32_t start_iiod(struct axi_dmac *rx_dmac, struct axi_dmac *tx_dmac,
 	iio_axi_dac_get_dev_descriptor(iio_axi_dac_desc, &dac_dev_desc);
 #endif
 
+	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++) {
+		status = iio_track_cal_init(&track_cal_desc[t], track_cal[t]);
+		if (status)
+			return status;
+	}
+
 #ifndef ADRV9008_2
 	struct iio_data_buffer read_buff = {
 		.buff = (void *)ADC_DDR_BASEADDR,
@@ -140,13 +173,23 @@ int32_t start_iiod(struct axi_dmac *rx_dmac, struct axi_dmac *tx_dmac,
 #endif
 #ifndef ADRV9008_1
 		IIO_APP_DEVICE("axi_dac", iio_axi_dac_desc, dac_dev_desc,
-			       NULL, &write_buff, NULL)
+			       NULL, &write_buff, NULL),
+#endif
+		IIO_APP_DEVICE("adrv9009-track-cal", track_cal_desc[TALISE_A],
+			       &track_cal_desc[TALISE_A]->iio_dev,
+			       NULL, NULL, NULL),
+#if defined(ZU11EG) || defined(FMCOMMS8_ZCU102)
+		IIO_APP_DEVICE("adrv9009-b-track-cal", track_cal_desc[TALISE_B],
+			       &track_cal_desc[TALISE_B]->iio_dev,
+			       NULL, NULL, NULL),
 #endif
 	};
 
 	app_init_param.devices = devices;
 	app_init_param.nb_devices = NO_OS_ARRAY_SIZE(devices);
 	app_init_param.uart_init_params = iio_uart_ip;
+	app_init_param.post_step_callback = track_cal_poll;
+	app_init_param.arg = track_cal;
 
 	status = iio_app_init(&app, app_init_param);
 	if (status)
@@ -279,6 +322,7 @@ int main(void)
 	hal.extra_gpio = &hal_gpio_param;
 #endif
 	int t;
+	struct no_os_track_cal *track_cal[TALISE_DEVICE_ID_MAX];
 	struct adi_hal hal[TALISE_DEVICE_ID_MAX];
 	taliseDevice_t tal[TALISE_DEVICE_ID_MAX];
 	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++) {
@@ -351,6 +395,17 @@ int main(void)
 	/* Print JESD status */
 	jesd_status();
 
+	/* The tracking cals run freely, they are only paused for the captures */
+	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++) {
+		status = talise_track_cal_init(&track_cal[t], &tal[t],
+					       NO_OS_TRACK_CAL_FREE_RUN);
+		if (status) {
+			printf("talise_track_cal_init() failed with status %d\n",
+			       status);
+			goto error_3;
+		}
+	}
+
 	/* Initialize the DAC core */
 #ifndef ADRV9008_1
 	status = axi_dac_init(&tx_dac, &tx_dac_init);
@@ -458,6 +513,9 @@ int main(void)
 		// Address of data destination
 		.dest_addr = (uintptr_t)(DDR_MEM_BASEADDR + 0x800000)
 	};
+	/* Keep the tracking cals from disturbing the capture */
+	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++)
+		no_os_track_cal_pause(track_cal[t]);
 #ifndef ADRV9008_2
 	status = axi_dmac_transfer_start(rx_dmac, &transfer_rx);
 	if(status)
@@ -473,6 +531,8 @@ int main(void)
 	status = axi_dmac_transfer_wait_completion(rx_os_dmac, 500);
 	uint8_t num_chans = rx_os_adc_init.num_channels;
 #endif
+	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++)
+		no_os_track_cal_resume(track_cal[t]);
 	if(status)
 		return status;
 #ifndef ALTERA_PLATFORM
@@ -488,12 +548,13 @@ int main(void)
 #endif
 
 #ifdef IIO_SUPPORT
-	status = start_iiod(rx_dmac, tx_dmac, rx_adc, tx_dac);
+	status = start_iiod(rx_dmac, tx_dmac, rx_adc, tx_dac, track_cal);
 	if (status)
 		printf("iiod error: %d\n", status);
 #endif // IIO_SUPPORT
 
 	for (t = TALISE_A; t < TALISE_DEVICE_ID_MAX; t++) {
+		no_os_track_cal_remove(track_cal[t]);
 		talise_shutdown(&tal[t]);
 	}
 error_3:
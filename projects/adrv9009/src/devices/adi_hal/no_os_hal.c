@@ -55,6 +55,9 @@
 #include "altera_gpio.h"
 #endif
 
+/* Register accesses handed to the SPI driver in one no_os_spi_transfer(). */
+#define ADIHAL_SPI_BATCH	64
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -184,21 +187,52 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 		return ADIHAL_OK;
 }
 
-adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
-				 uint16_t *addr, uint8_t *data, uint32_t count)
+/* Pack up to ADIHAL_SPI_BATCH single register accesses into one transfer. */
+static adiHalErr_t ADIHAL_spiBatch(void *devHalInfo, uint16_t *addr,
+				   uint8_t *data, uint8_t rw, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	static struct no_os_spi_msg msgs[ADIHAL_SPI_BATCH];
+	static uint8_t buf[ADIHAL_SPI_BATCH][3];
+	uint32_t i, n;
+	int32_t status;
 
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
+	while (count) {
+		n = (count > ADIHAL_SPI_BATCH) ? ADIHAL_SPI_BATCH : count;
+		for (i = 0; i < n; i++) {
+			buf[i][0] = rw | ((addr[i] >> 8) & 0x7F);
+			buf[i][1] = addr[i] & 0xFF;
+			buf[i][2] = rw ? 0x00 : data[i];
+			msgs[i] = (struct no_os_spi_msg) {
+				.tx_buff = buf[i],
+				.rx_buff = buf[i],
+				.bytes_number = 3,
+				.cs_change = 1,
+			};
+		}
+
+		status = no_os_spi_transfer(devHalData->spi_adrv_desc, msgs, n);
+		if (status != 0)
+			return ADIHAL_SPI_FAIL;
+
+		if (rw)
+			for (i = 0; i < n; i++)
+				data[i] = buf[i][2];
+
+		addr += n;
+		data += n;
+		count -= n;
 	}
 
 	return ADIHAL_OK;
 }
 
+adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
+				 uint16_t *addr, uint8_t *data, uint32_t count)
+{
+	return ADIHAL_spiBatch(devHalInfo, addr, data, 0x00, count);
+}
+
 adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 			       uint16_t addr, uint8_t *readdata)
 {
@@ -223,16 +257,7 @@ adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiReadBytes(void *devHalInfo,
 				uint16_t *addr, uint8_t *readdata, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
-
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
-		if (errVal)
-			return errVal;
-	}
-
-	return ADIHAL_OK;
+	return ADIHAL_spiBatch(devHalInfo, addr, readdata, 0x80, count);
 }
 
 adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo,
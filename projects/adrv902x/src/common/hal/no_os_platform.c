@@ -307,9 +307,6 @@ int32_t no_os_SpiWrite(void *devHalCfg, const uint8_t txData[],
 	int32_t halError = (int32_t)ADI_HAL_OK;
 	struct adrv9025_hal_cfg *halCfg = NULL;
 	static const uint32_t MAX_SIZE = 4096;
-	int32_t remaining = numTxBytes;
-	uint32_t toWrite = 0;
-	int32_t result = 0;
 
 	if (devHalCfg == NULL) {
 		halError = (int32_t)ADI_HAL_NULL_PTR;
@@ -318,16 +315,9 @@ int32_t no_os_SpiWrite(void *devHalCfg, const uint8_t txData[],
 
 	halCfg = (struct adrv9025_hal_cfg *)devHalCfg;
 
-	do {
-		toWrite = (remaining > MAX_SIZE) ? MAX_SIZE : remaining;
-		result = no_os_spi_write_and_read(halCfg->spi,
-						  &txData[numTxBytes - remaining],
-						  toWrite);
-		if (result < 0) {
-			return ADI_HAL_SPI_FAIL;
-		}
-		remaining -= toWrite;
-	} while (remaining > 0);
+	if (no_os_spi_write_chunked(halCfg->spi, (uint8_t *)txData,
+				    numTxBytes, MAX_SIZE))
+		return ADI_HAL_SPI_FAIL;
 
 	return halError;
 }
@@ -43,6 +43,7 @@
 
 #include "app_config.h"
 #include "no_os_error.h"
+#include "no_os_mutex.h"
 #include "iio.h"
 #include "no_os_irq.h"
 #include "aducm3029_irq.h"
@@ -145,6 +146,7 @@ int main(void)
 	app_init_param.devices = devices;
 	app_init_param.nb_devices = NO_OS_ARRAY_SIZE(devices);
 	app_init_param.uart_init_params = uart_ip;
+	app_init_param.idle = no_os_wait_for_interrupt;
 
 	status = iio_app_init(&app, app_init_param);
 	if (status)
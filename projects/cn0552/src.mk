@@ -1,4 +1,5 @@
 SRCS += $(NO-OS)/util/no_os_util.c \
+	$(NO-OS)/util/no_os_lfring.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
@@ -14,6 +15,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 	$(DRIVERS)/cdc/ad7746/iio_ad7746.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(DRIVERS)/api/no_os_i2c.c \
+	$(DRIVERS)/api/no_os_gpio.c \
 	$(DRIVERS)/api/no_os_timer.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(PROJECT)/src/app/headless.c
@@ -21,6 +23,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 INCS +=	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
 	$(INCLUDE)/no_os_util.h \
+	$(INCLUDE)/no_os_lfring.h \
 	$(INCLUDE)/no_os_list.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_timer.h \
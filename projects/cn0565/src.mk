@@ -14,7 +14,9 @@ INCS +=	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_rtc.h \
 	$(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_alloc.h \
-	$(INCLUDE)/no_os_mutex.h
+	$(INCLUDE)/no_os_mutex.h \
+	$(INCLUDE)/no_os_ain.h \
+	$(INCLUDE)/no_os_dsp.h
 
 SRCS += $(DRIVERS)/api/no_os_spi.c \
 	$(DRIVERS)/api/no_os_gpio.c \
@@ -22,11 +24,13 @@ SRCS += $(DRIVERS)/api/no_os_spi.c \
 	$(DRIVERS)/api/no_os_i2c.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(DRIVERS)/api/no_os_uart.c \
+	$(DRIVERS)/api/no_os_ain.c \
 	$(NO-OS)/util/no_os_lf256fifo.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
+	$(NO-OS)/util/no_os_dsp.c \
 	$(DRIVERS)/afe/ad5940/bia_measurement.c \
 	$(DRIVERS)/afe/ad5940/ad5940.c
 
@@ -63,6 +67,7 @@ SRCS += $(PLATFORM_DRIVERS)/aducm3029_delay.c \
 	$(PLATFORM_DRIVERS)/aducm3029_irq.c \
 	$(PLATFORM_DRIVERS)/aducm3029_gpio_irq.c \
 	$(PLATFORM_DRIVERS)/aducm3029_rtc.c \
+	$(PLATFORM_DRIVERS)/aducm3029_pwr.c \
 	$(PLATFORM_DRIVERS)/aducm3029_uart.c \
 	$(PLATFORM_DRIVERS)/aducm3029_uart_stdio.c \
 	$(PLATFORM_DRIVERS)/platform_init.c
@@ -76,6 +81,7 @@ INCS +=	$(INCLUDE)/no_os_delay.h \
 	$(PLATFORM_DRIVERS)/aducm3029_timer.h \
 	$(PLATFORM_DRIVERS)/aducm3029_i2c.h \
 	$(PLATFORM_DRIVERS)/aducm3029_rtc.h \
+	$(PLATFORM_DRIVERS)/aducm3029_pwr.h \
 	$(PLATFORM_DRIVERS)/aducm3029_spi.h \
 	$(PLATFORM_DRIVERS)/aducm3029_uart.h \
 	$(PLATFORM_DRIVERS)/aducm3029_gpio.h \
@@ -222,7 +222,6 @@ int main(void)
 		.reset_gpio_init = reset_gip,
 		.gp0_gpio_init = gp0_gip,
 	};
-#ifndef IIO_SUPPORT
 	/* interrupt controller  */
 	struct no_os_irq_init_param nvic_ip = {
 		.irq_ctrl_id = INTC_DEVICE_ID,
@@ -255,6 +254,7 @@ int main(void)
 	if (ret < 0)
 		return ret;
 
+#ifndef IIO_SUPPORT
 	/* callback */
 	struct no_os_callback_desc int_cb = {
 		.callback = ad5940_int_callback,
@@ -301,8 +301,14 @@ int main(void)
 	struct iio_app_desc *app;
 	struct iio_app_init_param app_init_param = { 0 };
 	struct ad5940_iio_dev *ad5940_iio = NULL;
+	/* Buffered measurements are drained on the GP0 interrupt */
+	AppBiaStreamCfg_Type stream_cfg = {
+		.IrqCtrl = gic,
+		.IrqId = INT_IRQn,
+	};
 	struct ad5940_iio_init_param ad5940_iio_ip = {
 		.ad5940_init = &ad5940_ip,
+		.stream_cfg = &stream_cfg,
 	};
 	ret = ad5940_iio_init(&ad5940_iio, &ad5940_iio_ip);
 	if (ret < 0)
@@ -319,7 +325,8 @@ int main(void)
 			.dev = ad5940_iio,
 			.dev_descriptor = ad5940_iio->iio,
 			.read_buff = NULL,
-			.write_buff = NULL
+			.write_buff = NULL,
+			.ain_stream = &ad5940_iio->stream,
 		},
 		{
 			.name = "adg2128",
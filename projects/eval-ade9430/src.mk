@@ -20,6 +20,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 	$(INCLUDE)/no_os_mutex.h \
 	$(INCLUDE)/no_os_circular_buffer.h \
 	$(INCLUDE)/no_os_trng.h \
+	$(INCLUDE)/no_os_trng_pool.h \
+	$(INCLUDE)/no_os_lfring.h \
 	$(INCLUDE)/no_os_rtc.h \
 	$(DRIVERS)/rtc/pcf85263/pcf85263.h \
 	$(DRIVERS)/meter/ade9430/ade9430.h \
@@ -49,6 +51,8 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 	$(DRIVERS)/api/no_os_uart.c  \
 	$(DRIVERS)/api/no_os_timer.c  \
 	$(DRIVERS)/api/no_os_trng.c  \
+	$(NO-OS)/util/no_os_trng_pool.c \
+	$(NO-OS)/util/no_os_lfring.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(NO-OS)/util/no_os_util.c	\
 	$(NO-OS)/util/no_os_circular_buffer.c \
@@ -72,6 +76,14 @@ SRC_DIRS += $(NO-OS)/network
 
 LIBRARIES += mqtt
 
+ifeq (y,$(strip $(TELEMETRY_BATCH)))
+CFLAGS += -DTELEMETRY_BATCH
+INCS += $(INCLUDE)/no_os_batch.h \
+	$(INCLUDE)/no_os_lfring.h
+SRCS += $(NO-OS)/util/no_os_batch.c \
+	$(NO-OS)/util/no_os_lfring.c
+endif
+
 ifeq (y,$(strip $(AZURE_IOT_HUB)))
 INCS += $(PROJECT)/src/app/iot_sample_common.h
 SRCS += $(PROJECT)/src/app/iot_sample_common.c
@@ -62,6 +62,7 @@
 #include "maxim_spi.h"
 #include "maxim_timer.h"
 #include "maxim_trng.h"
+#include "no_os_trng_pool.h"
 #include "no_os_irq.h"
 #include "no_os_error.h"
 #include "no_os_print_log.h"
@@ -69,6 +70,10 @@
 #include "wifi.h"
 #include "tcp_socket.h"
 
+#ifdef TELEMETRY_BATCH
+#include "no_os_batch.h"
+#endif
+
 #ifndef DISABLE_SECURE_SOCKET
 #include "az_iot_hub_client.h"
 #include "az_iot_provisioning_client.h"
@@ -188,13 +193,77 @@ int create_and_configure_mqtt_client_for_iot_hub(void)
 }
 #endif
 
+/* Publish a telemetry message with the MQTT client */
+static int telemetry_publish(struct mqtt_desc *mqtt, const void *payload,
+			     uint32_t len)
+{
+	struct mqtt_message	msg;
+	char			telemetry_topic[128];
+	int			ret;
+
+	/* Get the topic to send a telemetry message */
+#ifndef DISABLE_SECURE_SOCKET
+	ret = az_iot_hub_client_telemetry_get_publish_topic(&my_client, NULL,
+			telemetry_topic,
+			sizeof(telemetry_topic), NULL);
+	if (ret != AZ_OK) {
+		pr_err("Error getting telemetry topic!\n");
+		return ret;
+	}
+#else
+	sprintf(telemetry_topic, MQTT_PUBLISH_TOPIC);
+#endif
+
+	/* Send the telemetry message with the MQTT client */
+	msg = (struct mqtt_message) {
+#ifndef DISABLE_SECURE_SOCKET
+		.qos = AZ_HUB_CLIENT_DEFAULT_MQTT_TELEMETRY_QOS,
+#else
+		.qos = MQTT_QOS0,
+#endif
+		.payload = (void *)payload,
+		.len = len,
+		.retained = false
+	};
+	return mqtt_publish(mqtt, telemetry_topic, &msg);
+}
+
+#ifdef TELEMETRY_BATCH
+static struct no_os_batch *batch;
+
+static int batch_publish(void *ctx, const uint8_t *payload, uint32_t len)
+{
+	return telemetry_publish(ctx, payload, len);
+}
+
+static struct no_os_batch_init_param batch_param = {
+	/* Temperature, AIRMS, AVRMS, AWATT */
+	.nb_vals = 4,
+	.depth = BATCH_DEPTH,
+	.max_samples = BATCH_MAX_SAMPLES,
+	.period_ms = BATCH_PERIOD_MS,
+	.policy = NO_OS_BATCH_DOWNSAMPLE,
+	.publish = batch_publish,
+};
+
+static uint32_t batch_time_ms(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return t.s * 1000 + t.us / 1000;
+}
+#endif
+
 int read_and_send(struct mqtt_desc *mqtt, struct ade9430_dev *ade9430_dev,
 		  struct nhd_c12832a1z_dev *nhd_c12832a1z_dev,
 		  struct pcf85263_dev *pcf85263_dev)
 {
-	struct mqtt_message	msg;
+#ifdef TELEMETRY_BATCH
+	int32_t			vals[4];
+#else
 	struct pcf85263_date	ts;
-	char			buff[100], telemetry_topic[128];
+#endif
+	char			buff[100];
 	uint32_t		len;
 	int			ret;
 
@@ -223,6 +292,23 @@ int read_and_send(struct mqtt_desc *mqtt, struct ade9430_dev *ade9430_dev,
 		return ret;
 	}
 
+#ifdef TELEMETRY_BATCH
+	/* Queue the reading, the batch is published at its own cadence */
+	vals[0] = ade9430_dev->temp_deg;
+	vals[1] = ade9430_dev->irms_val;
+	vals[2] = ade9430_dev->vrms_val;
+	vals[3] = ade9430_dev->watt_val;
+
+	ret = no_os_batch_add(batch, batch_time_ms(), vals);
+	if (ret == -ENOSPC)
+		pr_warning("Telemetry batch full, reading dropped\n");
+
+	ret = no_os_batch_poll(batch, batch_time_ms());
+	if (ret)
+		pr_warning("Telemetry batch not sent, retrying: %d\n", ret);
+
+	return 0;
+#else
 	ret = pcf85263_read_ts(pcf85263_dev, &ts);
 	if (ret) {
 		pr_err("Error reading timestamp!\n");
@@ -241,31 +327,8 @@ int read_and_send(struct mqtt_desc *mqtt, struct ade9430_dev *ade9430_dev,
 		      ts.min,
 		      ts.sec);
 
-	/* Get the topic to send a telemetry message */
-#ifndef DISABLE_SECURE_SOCKET
-	ret = az_iot_hub_client_telemetry_get_publish_topic(&my_client, NULL,
-			telemetry_topic,
-			sizeof(telemetry_topic), NULL);
-	if (ret != AZ_OK) {
-		pr_err("Error getting telemetry topic!\n");
-		return ret;
-	}
-#else
-	sprintf(telemetry_topic, MQTT_PUBLISH_TOPIC);
-#endif
-
-	/* Send the telemetry message with the MQTT client */
-	msg = (struct mqtt_message) {
-#ifndef DISABLE_SECURE_SOCKET
-		.qos = AZ_HUB_CLIENT_DEFAULT_MQTT_TELEMETRY_QOS,
-#else
-		.qos = MQTT_QOS0,
+	return telemetry_publish(mqtt, buff, len);
 #endif
-		.payload = buff,
-		.len = len,
-		.retained = false
-	};
-	return mqtt_publish(mqtt, telemetry_topic, &msg);
 }
 
 void mqtt_message_handler(struct mqtt_message_data *msg)
@@ -605,9 +668,17 @@ int main()
 	char my_cli_cert[] = DEVICE_CERT;
 	char my_cli_pk[] = DEVICE_PRIVATE_KEY;
 
-	struct no_os_trng_init_param trng_ip = {
+	struct no_os_trng_init_param max_trng_ip = {
 		.platform_ops = &max_trng_ops
 	};
+	/* Serve the TLS handshakes from the pool instead of the hardware */
+	struct no_os_trng_pool_init_param trng_pool_ip = {
+		.trng = &max_trng_ip
+	};
+	struct no_os_trng_init_param trng_ip = {
+		.platform_ops = &no_os_trng_pool_ops,
+		.extra = &trng_pool_ip
+	};
 
 	struct secure_init_param sip = {
 		.trng_init_param = &trng_ip,
@@ -816,6 +887,15 @@ int main()
 	pr_info("Subscribed to topic: %s\n", MQTT_SUBSCRIBE_TOPIC);
 #endif
 
+#ifdef TELEMETRY_BATCH
+	batch_param.ctx = mqtt;
+	ret = no_os_batch_init(&batch, &batch_param);
+	if (ret) {
+		pr_err("Error no_os_batch_init!\n");
+		goto error_mqtt;
+	}
+#endif
+
 	ret = no_os_gpio_set_value(red_led_gpio, NO_OS_GPIO_HIGH);
 	if (ret) {
 		pr_err("Error setting red LED gpio high!\n");
@@ -842,12 +922,17 @@ int main()
 			goto error_mqtt;
 		}
 
+#ifdef TELEMETRY_BATCH
+		/* Dispatch new mqtt mesages if any during BATCH_SCAN_TIME */
+		ret = mqtt_yield(mqtt, BATCH_SCAN_TIME);
+#else
 		pr_info("Data sent to broker\n");
 
 		no_os_mdelay(1000);
 
 		/* Dispatch new mqtt mesages if any during SCAN_SENSOR_TIME */
 		ret = mqtt_yield(mqtt, SCAN_SENSOR_TIME);
+#endif
 		if (ret) {
 			pr_err("Error mqtt_yield!\n");
 			goto error_mqtt;
@@ -857,6 +942,9 @@ int main()
 	return 0;
 
 error_mqtt:
+#ifdef TELEMETRY_BATCH
+	no_os_batch_remove(batch);
+#endif
 	mqtt_remove(mqtt);
 error_sock:
 	socket_remove(sock);
@@ -113,6 +113,12 @@
 #define MQTT_CONFIG_KEEP_ALIVE	7200
 #define SCAN_SENSOR_TIME	500
 
+/* TELEMETRY_BATCH=y: readings queued and published in batches */
+#define BATCH_DEPTH		64
+#define BATCH_MAX_SAMPLES	32
+#define BATCH_PERIOD_MS		5000
+#define BATCH_SCAN_TIME		100
+
 #ifndef DISABLE_SECURE_SOCKET
 /* Populate here your CA certificate content */
 #define CA_CERT                                                            \
@@ -17,6 +17,7 @@ INCS += $(INCLUDE)/no_os_delay.h        \
         $(INCLUDE)/no_os_error.h        \
         $(INCLUDE)/no_os_print_log.h    \
         $(INCLUDE)/no_os_i2c.h          \
+        $(INCLUDE)/no_os_i2c_mux.h      \
         $(INCLUDE)/no_os_irq.h          \
         $(INCLUDE)/no_os_init.h          \
         $(INCLUDE)/no_os_list.h         \
@@ -34,6 +35,7 @@ SRCS += $(NO-OS)/util/no_os_lf256fifo.c \
         $(DRIVERS)/api/no_os_dma.c      \
         $(DRIVERS)/api/no_os_timer.c    \
         $(DRIVERS)/api/no_os_i2c.c      \
+        $(NO-OS)/util/no_os_i2c_mux.c   \
         $(DRIVERS)/api/no_os_uart.c     \
         $(NO-OS)/util/no_os_list.c      \
         $(NO-OS)/util/no_os_util.c      \
@@ -30,6 +30,7 @@ SRCS += $(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
+	$(NO-OS)/util/no_os_boot.c \
 	$(NO-OS)/jesd204/jesd204-core.c \
 	$(NO-OS)/jesd204/jesd204-fsm.c
 SRCS +=	$(PLATFORM_DRIVERS)/xilinx_axi_io.c \
@@ -75,6 +76,7 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_spi.h \
 	$(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_error.h \
+	$(INCLUDE)/no_os_boot.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_clk.h \
 	$(INCLUDE)/no_os_util.h \
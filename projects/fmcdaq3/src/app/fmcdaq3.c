@@ -61,6 +61,7 @@
 #include "xilinx_gpio.h"
 #include "no_os_delay.h"
 #include "no_os_error.h"
+#include "no_os_boot.h"
 #include "ad9152.h"
 #include "ad9528.h"
 #include "ad9680.h"
@@ -125,6 +126,276 @@ void fmcdaq3_reconfig(struct ad9152_init_param *ad9152_param,
 	}
 }
 
+/* Devices and parameters of main() used by the boot stages */
+struct fmcdaq3_boot_ctx {
+	struct ad9528_dev **ad9528_device;
+	struct ad9528_init_param *ad9528_param;
+#ifdef ALTERA_PLATFORM
+	struct altera_a10_fpll **ad9680_device_clk_pll;
+	struct altera_a10_fpll_init *ad9680_device_clk_pll_param;
+	struct altera_a10_fpll **ad9152_device_clk_pll;
+	struct altera_a10_fpll_init *ad9152_device_clk_pll_param;
+#endif
+	struct ad9680_dev **ad9680_device;
+	struct ad9680_init_param *ad9680_param;
+	struct ad9152_dev **ad9152_device;
+	struct ad9152_init_param *ad9152_param;
+	struct axi_jesd204_tx **ad9152_jesd;
+	struct jesd204_tx_init *ad9152_jesd_param;
+	struct axi_jesd204_rx **ad9680_jesd;
+	struct jesd204_rx_init *ad9680_jesd_param;
+	struct adxcvr **ad9152_xcvr;
+	struct adxcvr_init *ad9152_xcvr_param;
+	struct adxcvr **ad9680_xcvr;
+	struct adxcvr_init *ad9680_xcvr_param;
+	struct axi_adc **ad9680_core;
+	struct axi_adc_init *ad9680_core_param;
+	struct axi_dac **ad9152_core;
+	struct axi_dac_init *ad9152_core_param;
+};
+
+/*
+ * The stages report their errors and return 0, the bring up goes on as it
+ * always did.
+ */
+static int fmcdaq3_clk_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+	int32_t status;
+
+	status = ad9528_setup(c->ad9528_device, *c->ad9528_param);
+	if (status != 0) {
+		printf("error: ad9523_setup() failed\n");
+	}
+
+#ifdef ALTERA_PLATFORM
+	/* Initialize A10 FPLLs */
+	status = altera_a10_fpll_init(c->ad9680_device_clk_pll,
+				      c->ad9680_device_clk_pll_param);
+	if (status != 0) {
+		printf("error: %s: altera_a10_fpll_init() failed\n",
+		       c->ad9680_device_clk_pll_param->name);
+	}
+	status = altera_a10_fpll_init(c->ad9152_device_clk_pll,
+				      c->ad9152_device_clk_pll_param);
+	if (status != 0) {
+		printf("error: %s: altera_a10_fpll_init() failed\n",
+		       c->ad9152_device_clk_pll_param->name);
+	}
+
+	altera_a10_fpll_disable(*c->ad9680_device_clk_pll);
+	status = altera_a10_fpll_set_rate(*c->ad9680_device_clk_pll,
+					  c->ad9680_jesd_param->device_clk_khz * 1000);
+	if (status != 0) {
+		printf("error: %s: altera_a10_fpll_set_rate() failed\n",
+		       (*c->ad9680_device_clk_pll)->name);
+	}
+	altera_a10_fpll_enable(*c->ad9680_device_clk_pll);
+	altera_a10_fpll_disable(*c->ad9152_device_clk_pll);
+	status = altera_a10_fpll_set_rate(*c->ad9152_device_clk_pll,
+					  c->ad9152_jesd_param->device_clk_khz * 1000);
+	if (status != 0) {
+		printf("error: %s: altera_a10_fpll_set_rate() failed\n",
+		       (*c->ad9152_device_clk_pll)->name);
+	}
+	altera_a10_fpll_enable(*c->ad9152_device_clk_pll);
+#endif
+
+	return 0;
+}
+
+static int fmcdaq3_adc_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+
+	if (ad9680_setup(c->ad9680_device, c->ad9680_param) != 0)
+		printf("error: ad9680_setup() failed\n");
+
+	return 0;
+}
+
+static int fmcdaq3_tx_link_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+	int32_t status;
+
+	status = axi_jesd204_tx_init_legacy(c->ad9152_jesd, c->ad9152_jesd_param);
+	if (status != 0) {
+		printf("error: %s: axi_jesd204_rx_init_legacy() failed\n",
+		       (*c->ad9152_jesd)->name);
+	}
+	status = axi_jesd204_tx_lane_clk_enable(*c->ad9152_jesd);
+	if (status != 0) {
+		printf("error: %s: axi_jesd204_tx_lane_clk_enable() failed\n",
+		       (*c->ad9152_jesd)->name);
+	}
+
+	return 0;
+}
+
+static int fmcdaq3_xcvr_stage(struct adxcvr **xcvr, struct adxcvr_init *param)
+{
+	int32_t status;
+
+	status = adxcvr_init(xcvr, param);
+	if (status != 0) {
+		printf("error: %s: adxcvr_init() failed\n", (*xcvr)->name);
+	}
+#ifndef ALTERA_PLATFORM
+	status = adxcvr_clk_enable(*xcvr);
+	if (status != 0) {
+		printf("error: %s: adxcvr_clk_enable() failed\n", (*xcvr)->name);
+	}
+#endif
+
+	return 0;
+}
+
+static int fmcdaq3_tx_phy_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+
+	return fmcdaq3_xcvr_stage(c->ad9152_xcvr, c->ad9152_xcvr_param);
+}
+
+static int fmcdaq3_rx_phy_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+
+	return fmcdaq3_xcvr_stage(c->ad9680_xcvr, c->ad9680_xcvr_param);
+}
+
+static int fmcdaq3_rx_link_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+	int32_t status;
+
+	status = axi_jesd204_rx_init_legacy(c->ad9680_jesd, c->ad9680_jesd_param);
+	if (status != 0) {
+		printf("error: %s: axi_jesd204_rx_init_legacy() failed\n",
+		       (*c->ad9680_jesd)->name);
+	}
+	status = axi_jesd204_rx_lane_clk_enable(*c->ad9680_jesd);
+	if (status != 0) {
+		printf("error: %s: axi_jesd204_tx_lane_clk_enable() failed\n",
+		       (*c->ad9680_jesd)->name);
+	}
+
+	return 0;
+}
+
+static int fmcdaq3_dac_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+
+	if (ad9152_setup(c->ad9152_device, *c->ad9152_param) != 0)
+		printf("error: ad9152_setup() failed\n");
+
+	return 0;
+}
+
+static int fmcdaq3_adc_core_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+
+	if (axi_adc_init(c->ad9680_core, c->ad9680_core_param) != 0)
+		printf("axi_adc_init() error: %s\n", (*c->ad9680_core)->name);
+
+	return 0;
+}
+
+static int fmcdaq3_dac_core_stage(void *ctx)
+{
+	struct fmcdaq3_boot_ctx *c = ctx;
+
+	if (axi_dac_init(c->ad9152_core, c->ad9152_core_param) != 0)
+		printf("axi_dac_init() error: %s\n", (*c->ad9152_core)->name);
+
+	return 0;
+}
+
+enum fmcdaq3_boot_stages {
+	FMCDAQ3_CLK,
+	FMCDAQ3_ADC,
+	FMCDAQ3_TX_LINK,
+	FMCDAQ3_TX_PHY,
+	FMCDAQ3_RX_PHY,
+	FMCDAQ3_RX_LINK,
+	FMCDAQ3_DAC,
+	FMCDAQ3_ADC_CORE,
+	FMCDAQ3_DAC_CORE,
+};
+
+static struct fmcdaq3_boot_ctx boot_ctx;
+
+/*
+ * Bring up order. Recommended DAC JESD204 link startup sequence:
+ *   1. FPGA JESD204 Link Layer
+ *   2. FPGA JESD204 PHY Layer
+ *   3. DAC
+ */
+static struct no_os_boot_stage boot_stages[] = {
+	[FMCDAQ3_CLK] = {
+		.name = "clk",
+		.start = fmcdaq3_clk_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_ADC] = {
+		.name = "ad9680",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_CLK),
+		.start = fmcdaq3_adc_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_TX_LINK] = {
+		.name = "tx_link",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_CLK),
+		.start = fmcdaq3_tx_link_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_TX_PHY] = {
+		.name = "tx_phy",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_TX_LINK),
+		.start = fmcdaq3_tx_phy_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_RX_PHY] = {
+		.name = "rx_phy",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_CLK),
+		.start = fmcdaq3_rx_phy_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_RX_LINK] = {
+		.name = "rx_link",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_RX_PHY),
+		.start = fmcdaq3_rx_link_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_DAC] = {
+		.name = "ad9152",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_TX_PHY),
+		.start = fmcdaq3_dac_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_ADC_CORE] = {
+		.name = "adc_core",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_ADC) |
+		NO_OS_BOOT_DEP(FMCDAQ3_RX_LINK),
+		.start = fmcdaq3_adc_core_stage,
+		.ctx = &boot_ctx,
+	},
+	[FMCDAQ3_DAC_CORE] = {
+		.name = "dac_core",
+		.deps = NO_OS_BOOT_DEP(FMCDAQ3_DAC),
+		.start = fmcdaq3_dac_core_stage,
+		.ctx = &boot_ctx,
+	},
+};
+
+static struct no_os_boot boot = {
+	.stages = boot_stages,
+	.nb_stages = NO_OS_ARRAY_SIZE(boot_stages),
+};
+
 /***************************************************************************//**
  * @brief main
  ******************************************************************************/
@@ -132,6 +403,9 @@ int main(void)
 {
 
 	int32_t status;
+#ifdef NO_OS_PROFILING
+	char boot_report[512];
+#endif
 
 	/* Initialize SPI structures */
 	struct no_os_spi_init_param ad9528_spi_param = {
@@ -467,101 +741,40 @@ int main(void)
 	ad9152_jesd_param.lane_clk_khz = ad9152_xcvr_param.lane_rate_khz;
 	ad9152_jesd_param.device_clk_khz = ad9152_xcvr_param.lane_rate_khz / 40;
 
-	status = ad9528_setup(&ad9528_device, ad9528_param);
-	if (status != 0) {
-		printf("error: ad9523_setup() failed\n");
-	}
-	// Recommended DAC JESD204 link startup sequence
-	//   1. FPGA JESD204 Link Layer
-	//   2. FPGA JESD204 PHY Layer
-	//   3. DAC
-
+	boot_ctx = (struct fmcdaq3_boot_ctx) {
+		.ad9528_device = &ad9528_device,
+		.ad9528_param = &ad9528_param,
 #ifdef ALTERA_PLATFORM
-	/* Initialize A10 FPLLs */
-	status = altera_a10_fpll_init(&ad9680_device_clk_pll,
-				      &ad9680_device_clk_pll_param);
-	if (status != 0) {
-		printf("error: %s: altera_a10_fpll_init() failed\n",
-		       ad9680_device_clk_pll_param.name);
-	}
-	status = altera_a10_fpll_init(&ad9152_device_clk_pll,
-				      &ad9152_device_clk_pll_param);
-	if (status != 0) {
-		printf("error: %s: altera_a10_fpll_init() failed\n",
-		       ad9152_device_clk_pll_param.name);
-	}
-
-	altera_a10_fpll_disable(ad9680_device_clk_pll);
-	status = altera_a10_fpll_set_rate(ad9680_device_clk_pll,
-					  ad9680_jesd_param.device_clk_khz * 1000);
-	if (status != 0) {
-		printf("error: %s: altera_a10_fpll_set_rate() failed\n",
-		       ad9680_device_clk_pll->name);
-	}
-	altera_a10_fpll_enable(ad9680_device_clk_pll);
-	altera_a10_fpll_disable(ad9152_device_clk_pll);
-	status = altera_a10_fpll_set_rate(ad9152_device_clk_pll,
-					  ad9152_jesd_param.device_clk_khz * 1000);
-	if (status != 0) {
-		printf("error: %s: altera_a10_fpll_set_rate() failed\n",
-		       ad9152_device_clk_pll->name);
-	}
-	altera_a10_fpll_enable(ad9152_device_clk_pll);
-#endif
-	status = ad9680_setup(&ad9680_device, &ad9680_param);
-	if (status != 0) {
-		printf("error: ad9680_setup() failed\n");
-	}
-	status = axi_jesd204_tx_init_legacy(&ad9152_jesd, &ad9152_jesd_param);
-	if (status != 0) {
-		printf("error: %s: axi_jesd204_rx_init_legacy() failed\n", ad9152_jesd->name);
-	}
-	status = axi_jesd204_tx_lane_clk_enable(ad9152_jesd);
-	if (status != 0) {
-		printf("error: %s: axi_jesd204_tx_lane_clk_enable() failed\n",
-		       ad9152_jesd->name);
-	}
-	status = adxcvr_init(&ad9152_xcvr, &ad9152_xcvr_param);
-	if (status != 0) {
-		printf("error: %s: adxcvr_init() failed\n", ad9152_xcvr->name);
-	}
-#ifndef ALTERA_PLATFORM
-	status = adxcvr_clk_enable(ad9152_xcvr);
-	if (status != 0) {
-		printf("error: %s: adxcvr_clk_enable() failed\n", ad9152_xcvr->name);
-	}
+		.ad9680_device_clk_pll = &ad9680_device_clk_pll,
+		.ad9680_device_clk_pll_param = &ad9680_device_clk_pll_param,
+		.ad9152_device_clk_pll = &ad9152_device_clk_pll,
+		.ad9152_device_clk_pll_param = &ad9152_device_clk_pll_param,
 #endif
-	status = adxcvr_init(&ad9680_xcvr, &ad9680_xcvr_param);
-	if (status != 0) {
-		printf("error: %s: adxcvr_init() failed\n", ad9680_xcvr->name);
-	}
-#ifndef ALTERA_PLATFORM
-	status = adxcvr_clk_enable(ad9680_xcvr);
-	if (status != 0) {
-		printf("error: %s: adxcvr_clk_enable() failed\n", ad9680_xcvr->name);
-	}
+		.ad9680_device = &ad9680_device,
+		.ad9680_param = &ad9680_param,
+		.ad9152_device = &ad9152_device,
+		.ad9152_param = &ad9152_param,
+		.ad9152_jesd = &ad9152_jesd,
+		.ad9152_jesd_param = &ad9152_jesd_param,
+		.ad9680_jesd = &ad9680_jesd,
+		.ad9680_jesd_param = &ad9680_jesd_param,
+		.ad9152_xcvr = &ad9152_xcvr,
+		.ad9152_xcvr_param = &ad9152_xcvr_param,
+		.ad9680_xcvr = &ad9680_xcvr,
+		.ad9680_xcvr_param = &ad9680_xcvr_param,
+		.ad9680_core = &ad9680_core,
+		.ad9680_core_param = &ad9680_core_param,
+		.ad9152_core = &ad9152_core,
+		.ad9152_core_param = &ad9152_core_param,
+	};
+
+	status = no_os_boot_run(&boot);
+	if (status != 0)
+		printf("error: boot failed: %"PRIi32"\n", status);
+#ifdef NO_OS_PROFILING
+	if (no_os_boot_show(&boot, boot_report, sizeof(boot_report)) > 0)
+		printf("%s", boot_report);
 #endif
-	status = axi_jesd204_rx_init_legacy(&ad9680_jesd, &ad9680_jesd_param);
-	if (status != 0) {
-		printf("error: %s: axi_jesd204_rx_init_legacy() failed\n", ad9680_jesd->name);
-	}
-	status = axi_jesd204_rx_lane_clk_enable(ad9680_jesd);
-	if (status != 0) {
-		printf("error: %s: axi_jesd204_tx_lane_clk_enable() failed\n",
-		       ad9680_jesd->name);
-	}
-	status = ad9152_setup(&ad9152_device, ad9152_param);
-	if (status != 0) {
-		printf("error: ad9152_setup() failed\n");
-	}
-	status = axi_adc_init(&ad9680_core,  &ad9680_core_param);
-	if (status != 0) {
-		printf("axi_adc_init() error: %s\n", ad9680_core->name);
-	}
-	status = axi_dac_init(&ad9152_core, &ad9152_core_param);
-	if (status != 0) {
-		printf("axi_dac_init() error: %s\n", ad9152_core->name);
-	}
 
 	status = axi_jesd204_rx_status_read(ad9680_jesd);
 	if (status != 0) {
@@ -50,6 +50,9 @@
 #include "aducm3029_uart.h"
 #include "no_os_pwm.h"
 #include "no_os_util.h"
+#include "no_os_mutex.h"
+#include "no_os_rtc.h"
+#include "aducm3029_rtc.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -153,6 +156,8 @@ int main(void)
 	app_init_param.devices = devices;
 	app_init_param.nb_devices = NO_OS_ARRAY_SIZE(devices);
 	app_init_param.uart_init_params = uart_ip;
+	/* Flexi mode: the UART keeps receiving from the IIO client */
+	app_init_param.idle = no_os_wait_for_interrupt;
 
 	status = iio_app_init(&app, app_init_param);
 	if (status)
@@ -165,6 +170,12 @@ int main(void)
 	struct adc_desc		*adc;
 	struct no_os_uart_desc	*uart;
 	struct no_os_pwm_desc		*pwms[3];
+	struct no_os_rtc_desc		*rtc;
+	struct no_os_rtc_init_param	rtc_init_param = {
+		.id = RTC_DEVICE_ID,
+		.freq = AUDCM_1HZ,
+		.load = 0,
+	};
 
 	status = aducm3029_adc_init(&adc, &adc_init_param);
 	if (NO_OS_IS_ERR_VALUE(status))
@@ -197,6 +208,15 @@ int main(void)
 	status = aducm3029_adc_update_active_channels(adc, ch_mask);
 	if (NO_OS_IS_ERR_VALUE(status))
 		return status;
+
+	status = no_os_rtc_init(&rtc, &rtc_init_param);
+	if (NO_OS_IS_ERR_VALUE(status))
+		return status;
+
+	status = no_os_rtc_start(rtc);
+	if (NO_OS_IS_ERR_VALUE(status))
+		return status;
+
 	while (true) {
 		status = aducm3029_adc_read(adc, adc_buffer, nb_samples);
 		if (NO_OS_IS_ERR_VALUE(status))
@@ -215,5 +235,11 @@ int main(void)
 			if (NO_OS_IS_ERR_VALUE(status))
 				return status;
 		}
+
+		/* Hibernate until the RTC alarm of the next measurement */
+		status = aducm3029_rtc_sleep(rtc, MEASUREMENT_PERIOD_S,
+					     ADUCM3029_PWR_HIBERNATE);
+		if (NO_OS_IS_ERR_VALUE(status))
+			return status;
 	}
 }
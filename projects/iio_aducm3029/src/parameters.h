@@ -49,5 +49,8 @@
 #define UART_BAUDRATE			115200
 #define DEFAULT_SAMPLES			400
 #define ADC_BUFF_SIZE			(ADUCM3029_ADC_NUM_CH * DEFAULT_SAMPLES)
+/* RTC1, clocked at 1 Hz, wakes the part up from hibernate */
+#define RTC_DEVICE_ID			1
+#define MEASUREMENT_PERIOD_S		1
 
 #endif
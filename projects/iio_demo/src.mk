@@ -3,6 +3,10 @@ include $(PROJECT)/src/examples/examples_src.mk
 
 SRCS += $(PROJECT)/src/platform/$(PLATFORM)/main.c
 
+ifeq (y,$(strip $(ADC_DEMO_BENCH)))
+CFLAGS += -DADC_DEMO_BENCH
+endif
+
 INCS += $(PROJECT)/src/common/app_config.h
 INCS += $(PROJECT)/src/common/common_data.h
 SRCS += $(PROJECT)/src/common/common_data.c
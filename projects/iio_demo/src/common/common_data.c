@@ -68,7 +68,11 @@ struct adc_demo_init_param adc_init_par = {
 	.dev_ch_attr = {
 		1111, 1112, 1113, 1114, 1115, 1116, 1117, 1118,
 		1119, 1120,	1121, 1122, 1123, 1124, 1125, 1126
-	}
+	},
+#ifdef ADC_DEMO_BENCH
+	.bench = true,
+	.bench_rate = ADC_DEMO_BENCH_RATE,
+#endif
 };
 
 struct dac_demo_init_param dac_init_par = {
@@ -165,3 +169,19 @@ struct iio_hw_trig_init_param dac_demo_timer_trig_ip = {
 	.name = DAC_DEMO_TIMER_TRIG_NAME,
 };
 #endif
+
+#ifdef IIO_TRIG_LATENCY
+#define TRIG_LATENCY_GPIO(_pin) { \
+	.port = TRIG_LATENCY_GPIO_PORT, \
+	.number = (_pin), \
+	.pull = NO_OS_PULL_NONE, \
+	.platform_ops = TRIG_LATENCY_GPIO_OPS, \
+	.extra = TRIG_LATENCY_GPIO_EXTRA, \
+}
+
+struct no_os_gpio_init_param trig_latency_gpio_ip[TRIG_LATENCY_NB_GPIOS] = {
+	TRIG_LATENCY_GPIO(TRIG_LATENCY_GPIO_TRIGGER),
+	TRIG_LATENCY_GPIO(TRIG_LATENCY_GPIO_PUSHED),
+	TRIG_LATENCY_GPIO(TRIG_LATENCY_GPIO_READ),
+};
+#endif
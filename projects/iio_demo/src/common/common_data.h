@@ -50,6 +50,9 @@
 #if defined(IIO_SW_TRIGGER_EXAMPLE) || defined(IIO_TIMER_TRIGGER_EXAMPLE)
 #include "iio_trigger.h"
 #endif
+#ifdef IIO_TRIG_LATENCY
+#include "no_os_gpio.h"
+#endif
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -74,6 +77,11 @@ extern uint8_t out_buff[];
 #define DAC_DDR_BASEADDR	out_buff
 #define ADC_DDR_BASEADDR	in_buff
 
+#ifndef ADC_DEMO_BENCH_RATE
+/* Scans per second of the ADC_DEMO_BENCH stream, 0 for as fast as possible */
+#define ADC_DEMO_BENCH_RATE	0
+#endif
+
 extern struct adc_demo_init_param adc_init_par;
 extern struct dac_demo_init_param dac_init_par;
 
@@ -97,4 +105,10 @@ extern struct no_os_irq_init_param dac_demo_timer_irq_ip;
 extern struct iio_hw_trig_init_param dac_demo_timer_trig_ip;
 #endif
 
+#ifdef IIO_TRIG_LATENCY
+/* GPIOs toggled at the trigger, push and read stages of a scan */
+#define TRIG_LATENCY_NB_GPIOS	3
+extern struct no_os_gpio_init_param trig_latency_gpio_ip[TRIG_LATENCY_NB_GPIOS];
+#endif
+
 #endif /* __COMMON_DATA_H__ */
@@ -16,6 +16,17 @@ SRCS += $(DRIVERS)/adc/adc_demo/iio_adc_demo_trig.c \
         $(DRIVERS)/dac/dac_demo/iio_dac_demo_trig.c
 endif
 
+ifeq (y,$(strip $(IIO_TRIG_LATENCY)))
+CFLAGS += -DIIO_TRIG_LATENCY -DNO_OS_PROFILING
+SRCS += $(PROJECT)/src/examples/iio_trig_latency/iio_trig_latency.c
+INCS += $(PROJECT)/src/examples/iio_trig_latency/iio_trig_latency.h
+
+SRCS += $(DRIVERS)/api/no_os_gpio.c \
+        $(PLATFORM_DRIVERS)/$(PLATFORM)_gpio.c
+INCS += $(INCLUDE)/no_os_gpio.h \
+        $(PLATFORM_DRIVERS)/$(PLATFORM)_gpio.h
+endif
+
 ifeq (y,$(strip $(IIO_SW_TRIGGER_EXAMPLE)))
 CFLAGS += -DIIO_SW_TRIGGER_EXAMPLE=1
 
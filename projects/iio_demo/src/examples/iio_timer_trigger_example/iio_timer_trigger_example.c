@@ -45,6 +45,9 @@
 #include "iio_dac_demo.h"
 #include "common_data.h"
 #include "no_os_util.h"
+#ifdef IIO_TRIG_LATENCY
+#include "iio_trig_latency.h"
+#endif
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -146,6 +149,12 @@ int iio_timer_trigger_example_main()
 	if (ret)
 		return ret;
 
+#ifdef IIO_TRIG_LATENCY
+	ret = iio_trig_latency_init();
+	if (ret)
+		return ret;
+#endif
+
 	ret = no_os_timer_start(adc_demo_tim_desc);
 	if (ret)
 		return ret;
@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ *   @file   iio_trig_latency.c
+ *   @brief  Trigger to client latency measurement of the timer trigger example.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "iio_trig_latency.h"
+#include "common_data.h"
+#include "no_os_gpio.h"
+#include "no_os_util.h"
+#include "iio.h"
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+/* One GPIO per enum iio_latency_stage, toggled when the stage is reached */
+static struct no_os_gpio_desc *trig_latency_gpios[TRIG_LATENCY_NB_GPIOS];
+static uint8_t trig_latency_levels[TRIG_LATENCY_NB_GPIOS];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+/***************************************************************************//**
+ * @brief Set up the GPIOs toggled at each stage of the path of a triggered
+ *        scan. The latency statistics and histograms are read from the profile
+ *        debug attribute of adc_demo.
+ *
+ * @return ret - 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int iio_trig_latency_init(void)
+{
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < TRIG_LATENCY_NB_GPIOS; i++) {
+		ret = no_os_gpio_get(&trig_latency_gpios[i],
+				     &trig_latency_gpio_ip[i]);
+		if (ret)
+			return ret;
+
+		ret = no_os_gpio_direction_output(trig_latency_gpios[i],
+						  NO_OS_GPIO_LOW);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Toggle the GPIO of a stage, overrides the weak hook of the IIO core.
+ *        Each edge marks one scan reaching the stage, so a logic analyzer
+ *        measures the latency from the timer output to any stage.
+ *
+ * @param stage - Stage reached.
+*******************************************************************************/
+void iio_latency_mark(enum iio_latency_stage stage)
+{
+	if (stage >= TRIG_LATENCY_NB_GPIOS || !trig_latency_gpios[stage])
+		return;
+
+	trig_latency_levels[stage] ^= 1;
+	no_os_gpio_set_value(trig_latency_gpios[stage],
+			     trig_latency_levels[stage]);
+}
@@ -49,6 +49,12 @@ struct max_uart_init_param iio_demo_uart_extra_ip = {
 	.flow = UART_FLOW_DIS
 };
 
+#ifdef IIO_TRIG_LATENCY
+struct max_gpio_init_param trig_latency_gpio_extra_ip = {
+	.vssel = MXC_GPIO_VSSEL_VDDIOH,
+};
+#endif
+
 #ifdef NO_OS_USB_UART
 struct max_usb_uart_init_param iio_demo_usb_uart_extra_ip = {
 	.vid = 0x0B6B,
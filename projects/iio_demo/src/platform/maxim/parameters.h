@@ -53,6 +53,9 @@
 #ifdef NO_OS_USB_UART
 #include "maxim_usb_uart.h"
 #endif
+#ifdef IIO_TRIG_LATENCY
+#include "maxim_gpio.h"
+#endif
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -115,4 +118,15 @@ extern struct max_usb_uart_init_param iio_demo_usb_uart_extra_ip;
 
 #endif
 
+#ifdef IIO_TRIG_LATENCY
+/* Free pins toggled at each stage of a triggered scan */
+extern struct max_gpio_init_param trig_latency_gpio_extra_ip;
+#define TRIG_LATENCY_GPIO_PORT      2
+#define TRIG_LATENCY_GPIO_TRIGGER   0
+#define TRIG_LATENCY_GPIO_PUSHED    1
+#define TRIG_LATENCY_GPIO_READ      2
+#define TRIG_LATENCY_GPIO_OPS       &max_gpio_ops
+#define TRIG_LATENCY_GPIO_EXTRA     &trig_latency_gpio_extra_ip
+#endif
+
 #endif /* __PARAMETERS_H__ */
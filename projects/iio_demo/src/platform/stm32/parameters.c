@@ -57,3 +57,10 @@ struct stm32_timer_init_param dac_demo_xtip = {
 	.htimer = &htim14,
 };
 #endif
+
+#ifdef IIO_TRIG_LATENCY
+struct stm32_gpio_init_param trig_latency_gpio_extra_ip = {
+	.mode = GPIO_MODE_OUTPUT_PP,
+	.speed = GPIO_SPEED_FREQ_VERY_HIGH,
+};
+#endif
@@ -49,6 +49,9 @@
 #include "stm32_uart.h"
 #include "stm32_uart_stdio.h"
 #include "common_data.h"
+#ifdef IIO_TRIG_LATENCY
+#include "stm32_gpio.h"
+#endif
 #include "no_os_util.h"
 
 /******************************************************************************/
@@ -109,4 +112,15 @@ extern TIM_HandleTypeDef htim14;
 
 #endif
 
+#ifdef IIO_TRIG_LATENCY
+/* Free pins toggled at each stage of a triggered scan */
+extern struct stm32_gpio_init_param trig_latency_gpio_extra_ip;
+#define TRIG_LATENCY_GPIO_PORT      6
+#define TRIG_LATENCY_GPIO_TRIGGER   6
+#define TRIG_LATENCY_GPIO_PUSHED    7
+#define TRIG_LATENCY_GPIO_READ      8
+#define TRIG_LATENCY_GPIO_OPS       &stm32_gpio_ops
+#define TRIG_LATENCY_GPIO_EXTRA     &trig_latency_gpio_extra_ip
+#endif
+
 #endif /* __PARAMETERS_H__ */
@@ -99,6 +99,11 @@ int iio_example_main()
 	app_init_param.devices = devices;
 	app_init_param.nb_devices = NO_OS_ARRAY_SIZE(devices);
 	app_init_param.uart_init_params = iio_demo_uart_ip;
+#ifdef IIO_RTOS
+	/* A single worker, the UART is one connection */
+	app_init_param.rtos.nb_workers = 1;
+	app_init_param.rtos.worker_stack = configIIO_APP_STACK_SIZE;
+#endif
 
 	status = iio_app_init(&app, app_init_param);
 	if (status)
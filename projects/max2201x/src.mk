@@ -25,6 +25,7 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 	$(INCLUDE)/no_os_units.h		\
 	$(INCLUDE)/no_os_mutex.h		\
 	$(INCLUDE)/no_os_crc8.h			\
+	$(INCLUDE)/no_os_crc_table.h			\
 	$(INCLUDE)/no_os_dma.h
 
 SRCS += $(DRIVERS)/api/no_os_spi.c		\
@@ -23,6 +23,7 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_uart.h      \
 		$(INCLUDE)/no_os_lf256fifo.h \
 		$(INCLUDE)/no_os_util.h 	\
+		$(INCLUDE)/no_os_scale.h	\
 		$(INCLUDE)/no_os_units.h	\
                 $(INCLUDE)/no_os_mutex.h 
 
@@ -34,6 +35,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 		$(DRIVERS)/api/no_os_dma.c \
 		$(NO-OS)/util/no_os_list.c \
 		$(NO-OS)/util/no_os_util.c \
+		$(NO-OS)/util/no_os_scale.c \
 		$(NO-OS)/util/no_os_alloc.c \
                 $(NO-OS)/util/no_os_mutex.c
 
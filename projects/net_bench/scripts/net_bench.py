@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+# Copyright 2026(c) Analog Devices, Inc.
+#
+# Host side of the net_bench project. Every test opens a new connection to the
+# device, sends a net_bench_cmd, exchanges the test data and reads back the
+# net_bench_result (see src/common/net_bench.h).
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+MAGIC = 0x4e42454e
+CMD = struct.Struct('<IIIIHH40s')
+RESULT = struct.Struct('<IiQQ16I')
+HIST_BUCKETS = 16
+
+TCP_RX = 1
+TCP_TX = 2
+ECHO = 3
+UDP_TX = 4
+CONNECT = 5
+
+
+def recv_all(sock, size):
+    data = bytearray()
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError('connection closed by the device')
+        data += chunk
+    return bytes(data)
+
+
+def connect(args):
+    sock = socket.create_connection((args.host, args.port), args.timeout)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+
+def command(sock, test, size=0, count=0, addr='', port=0):
+    sock.sendall(CMD.pack(MAGIC, test, size, count, port, 0,
+                          addr.encode()))
+
+
+def result(sock):
+    res = RESULT.unpack(recv_all(sock, RESULT.size))
+    if res[0] != MAGIC:
+        raise ValueError('bad result magic 0x%08x' % res[0])
+    if res[1]:
+        raise RuntimeError('device error %d' % res[1])
+    return {'bytes': res[2], 'time_us': res[3], 'hist': res[4:]}
+
+
+def rate(nbytes, seconds):
+    if seconds <= 0:
+        return 'n/a'
+    return '%.2f Mbit/s' % (nbytes * 8 / seconds / 1e6)
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def print_hist(title, hist):
+    print(title)
+    total = sum(hist) or 1
+    for i, n in enumerate(hist):
+        if not n:
+            continue
+        print('  [%6d, %6d) us %8d %s' % (1 << i if i else 0, 1 << (i + 1),
+                                         n, '#' * (50 * n // total)))
+
+
+def test_tcp_rx(args):
+    buff = bytes(args.size)
+    with connect(args) as sock:
+        command(sock, TCP_RX, args.size, args.count)
+        start = time.monotonic()
+        for _ in range(args.count):
+            sock.sendall(buff)
+        res = result(sock)
+        host = time.monotonic() - start
+    print('tcp_rx: %d bytes, device %s, host %s' %
+          (res['bytes'], rate(res['bytes'], res['time_us'] / 1e6),
+           rate(res['bytes'], host)))
+
+
+def test_tcp_tx(args):
+    total = args.size * args.count
+    with connect(args) as sock:
+        command(sock, TCP_TX, args.size, args.count)
+        start = time.monotonic()
+        received = 0
+        while received < total:
+            chunk = sock.recv(min(65536, total - received))
+            if not chunk:
+                raise ConnectionError('connection closed by the device')
+            received += len(chunk)
+        host = time.monotonic() - start
+        res = result(sock)
+    print('tcp_tx: %d bytes, device %s, host %s' %
+          (res['bytes'], rate(res['bytes'], res['time_us'] / 1e6),
+           rate(received, host)))
+
+
+def test_echo(args):
+    buff = bytes(args.size)
+    rtt = []
+    hist = [0] * HIST_BUCKETS
+    with connect(args) as sock:
+        command(sock, ECHO, args.size, args.count)
+        for _ in range(args.count):
+            start = time.monotonic()
+            sock.sendall(buff)
+            recv_all(sock, args.size)
+            us = (time.monotonic() - start) * 1e6
+            rtt.append(us)
+            hist[min(HIST_BUCKETS - 1, max(0, int(us).bit_length() - 1))] += 1
+        res = result(sock)
+    print('echo: %d requests of %d bytes, rtt p50 %.0f us, p90 %.0f us, '
+          'p99 %.0f us, max %.0f us' %
+          (args.count, args.size, percentile(rtt, 50), percentile(rtt, 90),
+           percentile(rtt, 99), max(rtt)))
+    print_hist('host round trip time:', hist)
+    print_hist('device service time:', res['hist'])
+
+
+def test_udp_tx(args):
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as udp, \
+            connect(args) as sock:
+        local = sock.getsockname()[0]
+        udp.bind((local, args.udp_port))
+        udp.settimeout(1)
+        command(sock, UDP_TX, args.size, args.count, local,
+                udp.getsockname()[1])
+        seen = set()
+        first = last = None
+        while len(seen) < args.count:
+            try:
+                data = udp.recv(65536)
+            except socket.timeout:
+                break
+            last = time.monotonic()
+            if first is None:
+                first = last
+            seen.add(struct.unpack_from('<I', data)[0])
+        res = result(sock)
+    received = len(seen) * args.size
+    host = (last - first) if first is not None else 0
+    print('udp_tx: %d/%d datagrams (%.2f%% lost), device %s, host %s' %
+          (len(seen), args.count, 100 * (args.count - len(seen)) / args.count,
+           rate(res['bytes'], res['time_us'] / 1e6), rate(received, host)))
+
+
+def test_connect(args):
+    times = []
+    for _ in range(args.count):
+        start = time.monotonic()
+        with connect(args) as sock:
+            command(sock, CONNECT)
+            result(sock)
+        times.append((time.monotonic() - start) * 1e6)
+    print('connect: %d connections, p50 %.0f us, p90 %.0f us, max %.0f us' %
+          (args.count, percentile(times, 50), percentile(times, 90),
+           max(times)))
+
+
+TESTS = {
+    'tcp_rx': test_tcp_rx,
+    'tcp_tx': test_tcp_tx,
+    'echo': test_echo,
+    'udp_tx': test_udp_tx,
+    'connect': test_connect,
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='net_bench host companion')
+    parser.add_argument('host', help='address of the device')
+    parser.add_argument('tests', nargs='*', metavar='test',
+                        help='%s (default: all)' % ', '.join(TESTS))
+    parser.add_argument('-p', '--port', type=int, default=5201,
+                        help='benchmark port of the device')
+    parser.add_argument('-s', '--size', type=int, default=1024,
+                        help='size of a transfer, request or datagram')
+    parser.add_argument('-n', '--count', type=int, default=1000,
+                        help='number of transfers, requests or connections')
+    parser.add_argument('-u', '--udp-port', type=int, default=0,
+                        help='local UDP port for udp_tx (default: any)')
+    parser.add_argument('-t', '--timeout', type=float, default=10,
+                        help='socket timeout in seconds')
+    args = parser.parse_args()
+    for test in args.tests:
+        if test not in TESTS:
+            parser.error('unknown test %s' % test)
+
+    for test in args.tests or list(TESTS):
+        try:
+            TESTS[test](args)
+        except (OSError, ValueError, RuntimeError) as err:
+            print('%s: %s' % (test, err), file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,32 @@
+include $(PROJECT)/src/platform/$(PLATFORM)/platform_src.mk
+
+SRCS += $(PROJECT)/src/platform/$(PLATFORM)/main.c
+
+INCS += $(PROJECT)/src/platform/platform_includes.h
+
+INCS += $(PROJECT)/src/platform/$(PLATFORM)/parameters.h
+SRCS += $(PROJECT)/src/platform/$(PLATFORM)/parameters.c
+
+INCS += $(PROJECT)/src/common/net_bench.h
+SRCS += $(PROJECT)/src/common/net_bench.c
+
+SRCS += $(NO-OS)/network/tcp_socket.c		\
+	$(NO-OS)/util/no_os_circular_buffer.c	\
+	$(NO-OS)/util/no_os_list.c		\
+	$(NO-OS)/util/no_os_util.c		\
+	$(NO-OS)/util/no_os_alloc.c		\
+	$(NO-OS)/util/no_os_mutex.c
+
+INCS += $(NO-OS)/network/tcp_socket.h		\
+	$(NO-OS)/network/network_interface.h	\
+	$(NO-OS)/network/noos_mbedtls_config.h	\
+	$(INCLUDE)/no_os_circular_buffer.h	\
+	$(INCLUDE)/no_os_delay.h		\
+	$(INCLUDE)/no_os_error.h		\
+	$(INCLUDE)/no_os_print_log.h		\
+	$(INCLUDE)/no_os_list.h			\
+	$(INCLUDE)/no_os_util.h			\
+	$(INCLUDE)/no_os_alloc.h		\
+	$(INCLUDE)/no_os_mutex.h
+
+CFLAGS += -DDISABLE_SECURE_SOCKET
@@ -0,0 +1,354 @@
+/***************************************************************************//**
+ *   @file   net_bench.c
+ *   @brief  Network throughput and latency benchmark.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <inttypes.h>
+#include <string.h>
+#include "net_bench.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+#include "no_os_print_log.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/**************************** Global Variables ********************************/
+/******************************************************************************/
+
+static uint8_t bench_buff[NET_BENCH_BUFF_SIZE];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+static uint64_t net_bench_time_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
+static void net_bench_step(struct net_bench_init_param *param)
+{
+	if (param->step)
+		param->step(param->step_ctx);
+}
+
+/* Receive exactly len bytes */
+static int32_t net_bench_recv(struct net_bench_init_param *param,
+			      struct tcp_socket_desc *sock, void *buff,
+			      uint32_t len)
+{
+	uint32_t i = 0;
+	int32_t ret;
+
+	while (i < len) {
+		ret = socket_recv(sock, (uint8_t *)buff + i, len - i);
+		if (ret == -EAGAIN || ret == 0) {
+			net_bench_step(param);
+			continue;
+		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		i += ret;
+	}
+
+	return 0;
+}
+
+/* Send exactly len bytes */
+static int32_t net_bench_send(struct net_bench_init_param *param,
+			      struct tcp_socket_desc *sock, const void *buff,
+			      uint32_t len)
+{
+	uint32_t i = 0;
+	int32_t ret;
+
+	while (i < len) {
+		ret = socket_send(sock, (const uint8_t *)buff + i, len - i);
+		if (ret == -EAGAIN || ret == 0) {
+			net_bench_step(param);
+			continue;
+		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		i += ret;
+	}
+
+	return 0;
+}
+
+static int32_t net_bench_tcp_rx(struct net_bench_init_param *param,
+				struct tcp_socket_desc *sock,
+				struct net_bench_cmd *cmd,
+				struct net_bench_result *res)
+{
+	uint64_t total = (uint64_t)cmd->size * cmd->count;
+	uint64_t start = 0;
+	uint32_t len;
+	int32_t ret;
+
+	while (res->bytes < total) {
+		len = no_os_min(total - res->bytes, (uint64_t)sizeof(bench_buff));
+		ret = socket_recv(sock, bench_buff, len);
+		if (ret == -EAGAIN || ret == 0) {
+			net_bench_step(param);
+			continue;
+		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (!res->bytes)
+			start = net_bench_time_us();
+		res->bytes += ret;
+	}
+	res->time_us = net_bench_time_us() - start;
+
+	return 0;
+}
+
+static int32_t net_bench_tcp_tx(struct net_bench_init_param *param,
+				struct tcp_socket_desc *sock,
+				struct net_bench_cmd *cmd,
+				struct net_bench_result *res)
+{
+	uint64_t total = (uint64_t)cmd->size * cmd->count;
+	uint64_t start;
+	uint32_t len;
+	int32_t ret;
+
+	start = net_bench_time_us();
+	while (res->bytes < total) {
+		len = no_os_min(total - res->bytes, (uint64_t)sizeof(bench_buff));
+		ret = net_bench_send(param, sock, bench_buff, len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		res->bytes += len;
+	}
+	res->time_us = net_bench_time_us() - start;
+
+	return 0;
+}
+
+static int32_t net_bench_echo(struct net_bench_init_param *param,
+			      struct tcp_socket_desc *sock,
+			      struct net_bench_cmd *cmd,
+			      struct net_bench_result *res)
+{
+	uint64_t start, req, lat;
+	uint32_t bucket;
+	uint32_t i;
+	int32_t ret;
+
+	if (cmd->size > sizeof(bench_buff))
+		return -EINVAL;
+
+	start = net_bench_time_us();
+	for (i = 0; i < cmd->count; i++) {
+		ret = net_bench_recv(param, sock, bench_buff, cmd->size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		req = net_bench_time_us();
+		ret = net_bench_send(param, sock, bench_buff, cmd->size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		lat = net_bench_time_us() - req;
+		bucket = 0;
+		while (lat > 1 && bucket < NET_BENCH_HIST_BUCKETS - 1) {
+			lat >>= 1;
+			bucket++;
+		}
+		res->hist[bucket]++;
+		res->bytes += 2 * cmd->size;
+	}
+	res->time_us = net_bench_time_us() - start;
+
+	return 0;
+}
+
+static int32_t net_bench_udp_tx(struct net_bench_init_param *param,
+				struct net_bench_cmd *cmd,
+				struct net_bench_result *res)
+{
+	struct socket_address to;
+	struct tcp_socket_desc *udp;
+	uint64_t start;
+	uint32_t i;
+	int32_t ret;
+
+	if (!param->udp_socket_param)
+		return -ENOSYS;
+
+	if (cmd->size < sizeof(i) || cmd->size > sizeof(bench_buff))
+		return -EINVAL;
+
+	cmd->addr[NET_BENCH_ADDR_LEN - 1] = '\0';
+	to.addr = cmd->addr;
+	to.port = cmd->port;
+
+	ret = socket_init(&udp, param->udp_socket_param);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	start = net_bench_time_us();
+	for (i = 0; i < cmd->count; i++) {
+		/* Sequence number, for the host to count the lost datagrams */
+		memcpy(bench_buff, &i, sizeof(i));
+		ret = socket_sendto(udp, bench_buff, cmd->size, &to);
+		if (ret == -EAGAIN || ret == -ENOMEM) {
+			net_bench_step(param);
+			i--;
+			continue;
+		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto out;
+
+		res->bytes += cmd->size;
+	}
+	res->time_us = net_bench_time_us() - start;
+	ret = 0;
+out:
+	socket_remove(udp);
+
+	return ret;
+}
+
+/* Run the test requested on a new connection and send back the result */
+static int32_t net_bench_serve(struct net_bench_init_param *param,
+			       struct tcp_socket_desc *sock)
+{
+	struct net_bench_result res = {0};
+	struct net_bench_cmd cmd;
+	int32_t ret;
+
+	ret = net_bench_recv(param, sock, &cmd, sizeof(cmd));
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (cmd.magic != NET_BENCH_MAGIC)
+		return -EPROTO;
+
+	switch (cmd.test) {
+	case NET_BENCH_TCP_RX:
+		ret = net_bench_tcp_rx(param, sock, &cmd, &res);
+		break;
+	case NET_BENCH_TCP_TX:
+		ret = net_bench_tcp_tx(param, sock, &cmd, &res);
+		break;
+	case NET_BENCH_ECHO:
+		ret = net_bench_echo(param, sock, &cmd, &res);
+		break;
+	case NET_BENCH_UDP_TX:
+		ret = net_bench_udp_tx(param, &cmd, &res);
+		break;
+	case NET_BENCH_CONNECT:
+		ret = 0;
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	res.magic = NET_BENCH_MAGIC;
+	res.status = ret;
+	pr_info("test %"PRIu32": %d, %"PRIu32" bytes in %"PRIu32" us\n",
+		cmd.test, (int)ret, (uint32_t)res.bytes, (uint32_t)res.time_us);
+
+	return net_bench_send(param, sock, &res, sizeof(res));
+}
+
+/**
+ * @brief Serve the benchmark tests requested by scripts/net_bench.py.
+ *
+ * Each test runs on its own connection: the host sends a
+ * \ref net_bench_cmd, the data of the test follows and the device answers with
+ * a \ref net_bench_result. Only returns on a server socket error.
+ * @param param - Sockets and polling function to use.
+ * @return Negative error code.
+ */
+int32_t net_bench_run(struct net_bench_init_param *param)
+{
+	struct tcp_socket_desc *server;
+	struct tcp_socket_desc *client;
+	int32_t ret;
+
+	if (!param || !param->socket_param)
+		return -EINVAL;
+
+	ret = socket_init(&server, param->socket_param);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = socket_bind(server, param->port ? param->port : NET_BENCH_PORT);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto out;
+
+	ret = socket_listen(server, 1);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto out;
+
+	pr_info("Benchmark server listening on port %u\n",
+		param->port ? param->port : NET_BENCH_PORT);
+
+	while (true) {
+		ret = socket_accept(server, &client);
+		if (ret == -EAGAIN) {
+			net_bench_step(param);
+			continue;
+		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto out;
+
+		ret = net_bench_serve(param, client);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			pr_err("Benchmark connection ended with %d\n", (int)ret);
+		socket_remove(client);
+	}
+
+out:
+	socket_remove(server);
+
+	return ret;
+}
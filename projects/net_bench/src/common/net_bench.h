@@ -0,0 +1,155 @@
+/***************************************************************************//**
+ *   @file   net_bench.h
+ *   @brief  Network throughput and latency benchmark.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __NET_BENCH_H__
+#define __NET_BENCH_H__
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "tcp_socket.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** TCP port the benchmark server listens on */
+#define NET_BENCH_PORT		5201
+/** "NBEN", first word of the commands and of the results */
+#define NET_BENCH_MAGIC		0x4e42454eu
+/** Number of log2 buckets of the latency histogram */
+#define NET_BENCH_HIST_BUCKETS	16
+/** Maximum length of the host address in a command */
+#define NET_BENCH_ADDR_LEN	40
+
+/** Size of the buffer used to send and receive the test data */
+#ifndef NET_BENCH_BUFF_SIZE
+#define NET_BENCH_BUFF_SIZE	4096
+#endif
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @enum net_bench_test
+ * @brief Tests run by the host. Sizes and counts come from the command.
+ */
+enum net_bench_test {
+	/** The host sends count * size bytes, the device discards them */
+	NET_BENCH_TCP_RX = 1,
+	/** The device sends count * size bytes */
+	NET_BENCH_TCP_TX,
+	/** count requests of size bytes, each echoed back by the device */
+	NET_BENCH_ECHO,
+	/** The device sends count datagrams of size bytes to addr:port */
+	NET_BENCH_UDP_TX,
+	/** The device answers at once, for the host to time the connection */
+	NET_BENCH_CONNECT,
+};
+
+/**
+ * @struct net_bench_cmd
+ * @brief Command sent by the host at the start of a connection. All the fields
+ * are little endian.
+ */
+struct net_bench_cmd {
+	/** NET_BENCH_MAGIC */
+	uint32_t	magic;
+	/** One of \ref net_bench_test */
+	uint32_t	test;
+	/** Size of a transfer, request or datagram */
+	uint32_t	size;
+	/** Number of transfers, requests or datagrams */
+	uint32_t	count;
+	/** UDP port of the host for NET_BENCH_UDP_TX */
+	uint16_t	port;
+	uint16_t	reserved;
+	/** Null terminated address of the host for NET_BENCH_UDP_TX */
+	char		addr[NET_BENCH_ADDR_LEN];
+};
+
+/**
+ * @struct net_bench_result
+ * @brief Measurements of the device, sent back at the end of a test
+ */
+struct net_bench_result {
+	/** NET_BENCH_MAGIC */
+	uint32_t	magic;
+	/** 0 or the negative error code that stopped the test */
+	int32_t		status;
+	/** Bytes sent or received by the device */
+	uint64_t	bytes;
+	/** Time from the first to the last byte, in microseconds */
+	uint64_t	time_us;
+	/**
+	 * For NET_BENCH_ECHO, number of requests served in [2^i, 2^(i+1)) us,
+	 * from the reception of the request to the send of the response.
+	 */
+	uint32_t	hist[NET_BENCH_HIST_BUCKETS];
+};
+
+/**
+ * @struct net_bench_init_param
+ * @brief Parameters of the benchmark server
+ */
+struct net_bench_init_param {
+	/** Parameters of the server and client sockets */
+	struct tcp_socket_init_param	*socket_param;
+	/** Parameters of the UDP socket, NULL if UDP is not supported */
+	struct tcp_socket_init_param	*udp_socket_param;
+	/** Port to listen on, NET_BENCH_PORT if 0 */
+	uint16_t			port;
+	/**
+	 * Called while waiting for data, for the network stacks that must be
+	 * polled (no_os_lwip_step). Can be NULL.
+	 */
+	void				(*step)(void *ctx);
+	/** Parameter of step */
+	void				*step_ctx;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Serve the benchmark tests of the host script, one connection at a time */
+int32_t net_bench_run(struct net_bench_init_param *param);
+
+#endif /* __NET_BENCH_H__ */
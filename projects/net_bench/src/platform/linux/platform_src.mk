@@ -0,0 +1,6 @@
+CFLAGS += -DNO_OS_NETWORKING
+
+SRCS += $(NO-OS)/network/linux_socket/linux_socket.c	\
+	$(DRIVERS)/platform/linux/linux_delay.c
+
+INCS += $(NO-OS)/network/linux_socket/linux_socket.h
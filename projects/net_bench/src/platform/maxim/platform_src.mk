@@ -0,0 +1,47 @@
+LIBRARIES += lwip
+CFLAGS += -DNO_OS_LWIP_NETWORKING
+
+INCS += $(INCLUDE)/no_os_crc8.h		\
+	$(INCLUDE)/no_os_crc_table.h	\
+	$(INCLUDE)/no_os_dma.h		\
+	$(INCLUDE)/no_os_gpio.h		\
+	$(INCLUDE)/no_os_init.h		\
+	$(INCLUDE)/no_os_irq.h		\
+	$(INCLUDE)/no_os_lf256fifo.h	\
+	$(INCLUDE)/no_os_spi.h		\
+	$(INCLUDE)/no_os_timer.h	\
+	$(INCLUDE)/no_os_uart.h		\
+	$(INCLUDE)/no_os_units.h
+
+SRCS += $(DRIVERS)/api/no_os_dma.c	\
+	$(DRIVERS)/api/no_os_gpio.c	\
+	$(DRIVERS)/api/no_os_irq.c	\
+	$(DRIVERS)/api/no_os_spi.c	\
+	$(DRIVERS)/api/no_os_timer.c	\
+	$(DRIVERS)/api/no_os_uart.c	\
+	$(NO-OS)/util/no_os_crc8.c	\
+	$(NO-OS)/util/no_os_lf256fifo.c
+
+INCS += $(DRIVERS)/net/adin1110/adin1110.h
+SRCS += $(DRIVERS)/net/adin1110/adin1110.c
+
+INCS += $(NO-OS)/network/lwip_raw_socket/netdevs/adin1110/lwip_adin1110.h
+SRCS += $(NO-OS)/network/lwip_raw_socket/netdevs/adin1110/lwip_adin1110.c
+
+SRCS += $(PLATFORM_DRIVERS)/maxim_delay.c		\
+	$(PLATFORM_DRIVERS)/maxim_gpio.c		\
+	$(PLATFORM_DRIVERS)/maxim_init.c		\
+	$(PLATFORM_DRIVERS)/maxim_irq.c			\
+	$(PLATFORM_DRIVERS)/maxim_spi.c			\
+	$(PLATFORM_DRIVERS)/maxim_timer.c		\
+	$(PLATFORM_DRIVERS)/maxim_uart.c		\
+	$(PLATFORM_DRIVERS)/maxim_uart_stdio.c		\
+	$(PLATFORM_DRIVERS)/../common/maxim_dma.c
+
+INCS += $(PLATFORM_DRIVERS)/maxim_gpio.h		\
+	$(PLATFORM_DRIVERS)/maxim_irq.h			\
+	$(PLATFORM_DRIVERS)/maxim_spi.h			\
+	$(PLATFORM_DRIVERS)/maxim_timer.h		\
+	$(PLATFORM_DRIVERS)/maxim_uart.h		\
+	$(PLATFORM_DRIVERS)/maxim_uart_stdio.h		\
+	$(PLATFORM_DRIVERS)/../common/maxim_dma.h
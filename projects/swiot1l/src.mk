@@ -32,6 +32,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_dma.h      \
 		$(INCLUDE)/no_os_mutex.h      \
 		$(INCLUDE)/no_os_crc8.h      \
+		$(INCLUDE)/no_os_crc_table.h   \
+		$(INCLUDE)/no_os_regmap.h      \
 		$(INCLUDE)/no_os_uart.h      \
 		$(INCLUDE)/no_os_mutex.h      \
 		$(INCLUDE)/no_os_i2c.h      \
@@ -39,6 +41,7 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_timer.h      \
 		$(INCLUDE)/no_os_lf256fifo.h \
 		$(INCLUDE)/no_os_util.h \
+		$(INCLUDE)/no_os_scale.h \
 		$(INCLUDE)/no_os_units.h \
 		$(INCLUDE)/no_os_alloc.h
 
@@ -53,6 +56,8 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 		$(DRIVERS)/api/no_os_dma.c \
 		$(NO-OS)/util/no_os_list.c \
 		$(NO-OS)/util/no_os_crc8.c \
+		$(NO-OS)/util/no_os_regmap.c \
+		$(NO-OS)/util/no_os_scale.c \
 		$(NO-OS)/util/no_os_util.c \
 		$(NO-OS)/util/no_os_mutex.c \
 		$(NO-OS)/util/no_os_alloc.c
@@ -78,6 +83,7 @@ INCS += $(DRIVERS)/temperature/adt75/iio_adt75.h
 SRCS += $(DRIVERS)/temperature/adt75/iio_adt75.c
 
 INCS += $(INCLUDE)/no_os_crc8.h
+INCS += $(INCLUDE)/no_os_crc_table.h
 INCS += $(DRIVERS)/net/adin1110/adin1110.h
 INCS += $(NO-OS)/network/lwip_raw_socket/netdevs/adin1110/lwip_adin1110.h
 SRCS += $(NO-OS)/network/lwip_raw_socket/netdevs/adin1110/lwip_adin1110.c
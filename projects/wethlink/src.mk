@@ -41,6 +41,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 	$(NO-OS)/util/no_os_crc8.c \
 	$(NO-OS)/util/no_os_pid.c \
 	$(NO-OS)/util/no_os_mutex.c \
+	$(NO-OS)/util/no_os_telemetry.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_delay.c
 
 INCS += $(INCLUDE)/no_os_gpio.h \
@@ -75,7 +76,9 @@ INCS += $(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_units.h \
 	$(INCLUDE)/no_os_list.h \
 	$(INCLUDE)/no_os_crc8.h \
+	$(INCLUDE)/no_os_crc_table.h \
 	$(INCLUDE)/no_os_pid.h \
+	$(INCLUDE)/no_os_telemetry.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_delay.h \
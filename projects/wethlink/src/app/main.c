@@ -111,8 +111,7 @@ int main(void)
 	struct max24287_iio_desc *iio_max24287;
 	struct adm1177_iio_dev *iio_adm1177;
 
-	NO_OS_DECLARE_CRC8_TABLE(crc8);
-	no_os_crc8_populate_msb(crc8, 0x7);
+	const uint8_t *crc8 = no_os_crc8_get_table(0x7);
 
 	// Greeting
 	struct no_os_uart_init_param uart_greeting_ip = uart_console_ip;
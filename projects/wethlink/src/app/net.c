@@ -23,16 +23,16 @@ volatile bool selfchange;
 void adin1300_int(void *context)
 {
 	uint16_t spd;
-	uint16_t status = 0;
+	struct adin1300_status status = {0};
 	struct net_context *ctx = context;
 
 	no_os_irq_disable(ctx->nvic, ADIN1300_INT_IRQn);
 
 	// this also clears the flags
-	adin1300_read(ctx->adin1300, ADIN1300_IRQ_STATUS, &status);
+	adin1300_get_status(ctx->adin1300, &status);
 
-	if (status & ADIN1300_LNK_STAT_CHNG_IRQ_MASK) {
-		spd = adin1300_resolved_speed(ctx->adin1300);
+	if (status.irq_status & ADIN1300_LNK_STAT_CHNG_IRQ_MASK) {
+		spd = status.speed;
 
 		if (spd <= 5) {
 			led_rj45((enum rj45_led)spd / 2);
@@ -60,19 +60,17 @@ void adin1300_int(void *context)
 void max24287_int(void *context)
 {
 	struct net_context *ctx = context;
-	uint16_t reg;
+	uint16_t reg[3] = {0};
+	const uint8_t addrs[] = {MAX24287_IR, MAX24287_AN_EXP, MAX24287_AN_RX};
 	enum max24287_speed remote_speed;
 	enum adin1300_speed local_speed;
 
 	no_os_irq_disable(ctx->nvic, MAX24287_INT_IRQn);
-	max24287_read(ctx->max24287, MAX24287_IR, NULL);
-	max24287_read(ctx->max24287, MAX24287_AN_EXP, &reg);
-
-	if (reg & MAX24287_AN_RX_PAGE) {
-		max24287_read(ctx->max24287, MAX24287_AN_RX, &reg);
-		remote_speed = (no_os_field_get(MAX24287_SPD_MASK, reg) << 1) |
-			       no_os_field_get(MAX24287_DPLX_MASK, reg);
-		max24287_read(ctx->max24287, MAX24287_AN_ADV, &reg);
+	max24287_read_regs(ctx->max24287, addrs, reg, NO_OS_ARRAY_SIZE(addrs));
+
+	if (reg[1] & MAX24287_AN_RX_PAGE) {
+		remote_speed = (no_os_field_get(MAX24287_SPD_MASK, reg[2]) << 1) |
+			       no_os_field_get(MAX24287_DPLX_MASK, reg[2]);
 		local_speed = adin1300_resolved_speed(ctx->adin1300);
 
 		if (remote_speed < local_speed) {
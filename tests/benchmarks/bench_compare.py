@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# Compare two runs of a micro-benchmark, e.g. the results of two commits:
+#	python bench_compare.py previous.jsonl results.jsonl -threshold 10 -fail
+#
+# Each file holds one JSON object per line, as printed by util_bench_run().
+# A benchmark that got slower by more than -threshold percent is flagged, and
+# -fail makes the script exit with an error in that case.
+
+import argparse
+import json
+import sys
+
+def load(path):
+	results = {}
+	with open(path) as f:
+		for line in f:
+			line = line.strip()
+			if not line.startswith('{'):
+				# Target output may be mixed with other logs
+				continue
+			entry = json.loads(line)
+			if 'bench' in entry and 'cycles_per_unit' in entry:
+				results[(entry['bench'], entry['size'])] = entry
+	return results
+
+def main():
+	parser = argparse.ArgumentParser(description='no-OS benchmark comparison')
+	parser.add_argument('previous', help='results of the reference run')
+	parser.add_argument('current', help='results of the run to check')
+	parser.add_argument('-threshold', type=float, default=10,
+			    help='slowdown in percent tolerated before a regression is flagged')
+	parser.add_argument('-fail', action='store_true',
+			    help='exit with an error when a regression is flagged')
+	args = parser.parse_args()
+
+	prev = load(args.previous)
+	cur = load(args.current)
+
+	regressions = 0
+	print('%-28s %6s %12s %12s %8s' % ('bench', 'size', 'previous', 'current',
+					   'change'))
+	for key in sorted(cur):
+		entry = cur[key]
+		old = prev.get(key)
+		if old is None:
+			print('%-28s %6d %12s %12.2f %8s' % (key[0], key[1], '-',
+			      entry['cycles_per_unit'], 'new'))
+			continue
+		change = 0.0
+		if old['cycles_per_unit']:
+			change = (entry['cycles_per_unit'] /
+				  old['cycles_per_unit'] - 1) * 100
+		mark = ''
+		if change > args.threshold:
+			mark = ' <-- regression'
+			regressions += 1
+		print('%-28s %6d %12.2f %12.2f %+7.1f%%%s' % (key[0], key[1],
+		      old['cycles_per_unit'], entry['cycles_per_unit'], change,
+		      mark))
+
+	for key in sorted(set(prev) - set(cur)):
+		print('%-28s %6d %12.2f %12s %8s' % (key[0], key[1],
+		      prev[key]['cycles_per_unit'], '-', 'removed'))
+
+	if regressions:
+		print('%d regression(s) above %g%%' % (regressions, args.threshold))
+		if args.fail:
+			sys.exit(1)
+
+if __name__ == '__main__':
+	main()
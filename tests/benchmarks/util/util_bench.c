@@ -0,0 +1,497 @@
+/***************************************************************************//**
+ *   @file   util_bench.c
+ *   @brief  Micro-benchmarks of the util/ primitives, on target and on host.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "util_bench.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_lf256fifo.h"
+#include "no_os_list.h"
+#include "no_os_crc8.h"
+#include "no_os_crc16.h"
+#include "no_os_crc24.h"
+#include "no_os_crc32.h"
+#include "no_os_pid.h"
+#include "no_os_profile.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+
+/* The best of UTIL_BENCH_RUNS runs is reported */
+#define UTIL_BENCH_RUNS		5
+/* Units processed by one run, so the counter overhead is negligible */
+#define UTIL_BENCH_WORK		65536
+#define UTIL_BENCH_DATA_SIZE	4096
+
+struct util_bench {
+	/** Name of the benchmark */
+	const char *name;
+	/** What size counts, "byte" or "op" */
+	const char *unit;
+	/** Sizes the benchmark is run with */
+	const uint32_t *sizes;
+	uint32_t nb_sizes;
+	/** Optional, prepare a run of the given size */
+	int (*setup)(uint32_t size);
+	/** Process size units, returns a value depending on all of them */
+	uint32_t (*run)(uint32_t size);
+	/** Optional, undo setup */
+	void (*teardown)(void);
+};
+
+static volatile uint32_t util_bench_sink;
+static uint8_t util_bench_data[UTIL_BENCH_DATA_SIZE];
+static uint32_t util_bench_words[256];
+
+static struct no_os_circular_buffer *util_bench_cb;
+static struct lf256fifo *util_bench_fifo;
+static struct no_os_list_desc *util_bench_list;
+static uint32_t util_bench_items[256];
+
+#define UTIL_BENCH_MAX_LOOPS	16
+static struct no_os_pid *util_bench_pid[UTIL_BENCH_MAX_LOOPS];
+static struct no_os_pid_bank *util_bench_pid_bank;
+static int16_t util_bench_pid_io[3][UTIL_BENCH_MAX_LOOPS];
+
+NO_OS_DECLARE_CRC8_TABLE(util_bench_crc8);
+NO_OS_DECLARE_CRC8_SLICE_TABLE(util_bench_crc8_slice);
+NO_OS_DECLARE_CRC16_TABLE(util_bench_crc16);
+NO_OS_DECLARE_CRC16_SLICE_TABLE(util_bench_crc16_slice);
+NO_OS_DECLARE_CRC24_TABLE(util_bench_crc24);
+NO_OS_DECLARE_CRC24_SLICE_TABLE(util_bench_crc24_slice);
+NO_OS_DECLARE_CRC32_TABLE(util_bench_crc32);
+NO_OS_DECLARE_CRC32_SLICE_TABLE(util_bench_crc32_slice);
+
+static const uint32_t util_bench_buf_sizes[] = {16, 256, 4096};
+static const uint32_t util_bench_fifo_sizes[] = {16, 128, 255};
+static const uint32_t util_bench_list_sizes[] = {16, 256};
+static const uint32_t util_bench_word_sizes[] = {256};
+static const uint32_t util_bench_loop_sizes[] = {4, UTIL_BENCH_MAX_LOOPS};
+
+static int bench_cb_setup(uint32_t size)
+{
+	return no_os_cb_init(&util_bench_cb, 2 * UTIL_BENCH_DATA_SIZE);
+}
+
+static uint32_t bench_cb(uint32_t size)
+{
+	no_os_cb_write(util_bench_cb, util_bench_data, size);
+	no_os_cb_read(util_bench_cb, util_bench_data, size);
+
+	return util_bench_data[0];
+}
+
+static void bench_cb_teardown(void)
+{
+	no_os_cb_remove(util_bench_cb);
+}
+
+static int bench_fifo_setup(uint32_t size)
+{
+	return lf256fifo_init(&util_bench_fifo);
+}
+
+static uint32_t bench_fifo(uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i < size; i++)
+		lf256fifo_write(util_bench_fifo, util_bench_data[i]);
+
+	return lf256fifo_read_bulk(util_bench_fifo, util_bench_data, size);
+}
+
+static void bench_fifo_teardown(void)
+{
+	lf256fifo_remove(util_bench_fifo);
+}
+
+static int32_t bench_list_cmp(void *data1, void *data2)
+{
+	return (int32_t)(*(uint32_t *)data1 - *(uint32_t *)data2);
+}
+
+static int bench_list_setup(uint32_t size)
+{
+	uint32_t i;
+	int ret;
+
+	ret = no_os_list_init(&util_bench_list, NO_OS_LIST_DEFAULT,
+			      bench_list_cmp);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < size; i++) {
+		util_bench_items[i] = i;
+		ret = no_os_list_add_last(util_bench_list, &util_bench_items[i]);
+		if (ret) {
+			no_os_list_remove(util_bench_list);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Rotate the whole list, one add_last and get_first per element */
+static uint32_t bench_list_queue(uint32_t size)
+{
+	uint32_t i, sum = 0;
+	void *data;
+
+	for (i = 0; i < size; i++) {
+		no_os_list_get_first(util_bench_list, &data);
+		sum += *(uint32_t *)data;
+		no_os_list_add_last(util_bench_list, data);
+	}
+
+	return sum;
+}
+
+/* Look every element up by value */
+static uint32_t bench_list_find(uint32_t size)
+{
+	uint32_t i, sum = 0;
+	void *data;
+
+	for (i = 0; i < size; i++) {
+		no_os_list_read_find(util_bench_list, &data, &util_bench_items[i]);
+		sum += *(uint32_t *)data;
+	}
+
+	return sum;
+}
+
+static void bench_list_teardown(void)
+{
+	no_os_list_remove(util_bench_list);
+}
+
+static uint32_t bench_crc8(uint32_t size)
+{
+	return no_os_crc8(util_bench_crc8, util_bench_data, size, 0);
+}
+
+static uint32_t bench_crc8_slice(uint32_t size)
+{
+	return no_os_crc8_slice((const uint8_t (*)[NO_OS_CRC8_TABLE_SIZE])
+				util_bench_crc8_slice, util_bench_data, size, 0);
+}
+
+static uint32_t bench_crc16(uint32_t size)
+{
+	return no_os_crc16(util_bench_crc16, util_bench_data, size, 0);
+}
+
+static uint32_t bench_crc16_slice(uint32_t size)
+{
+	return no_os_crc16_slice((const uint16_t (*)[NO_OS_CRC16_TABLE_SIZE])
+				 util_bench_crc16_slice, util_bench_data, size,
+				 0);
+}
+
+static uint32_t bench_crc24(uint32_t size)
+{
+	return no_os_crc24(util_bench_crc24, util_bench_data, size, 0);
+}
+
+static uint32_t bench_crc24_slice(uint32_t size)
+{
+	return no_os_crc24_slice((const uint32_t (*)[NO_OS_CRC24_TABLE_SIZE])
+				 util_bench_crc24_slice, util_bench_data, size,
+				 0);
+}
+
+static uint32_t bench_crc32(uint32_t size)
+{
+	return no_os_crc32(util_bench_crc32, util_bench_data, size, 0);
+}
+
+static uint32_t bench_crc32_slice(uint32_t size)
+{
+	return no_os_crc32_slice((const uint32_t (*)[NO_OS_CRC32_TABLE_SIZE])
+				 util_bench_crc32_slice, util_bench_data, size,
+				 0);
+}
+
+static uint32_t bench_field_get(uint32_t size)
+{
+	uint32_t i, sum = 0;
+
+	for (i = 0; i < size; i++)
+		sum += no_os_field_get(NO_OS_GENMASK(11, 4), util_bench_words[i]);
+
+	return sum;
+}
+
+static uint32_t bench_field_prep(uint32_t size)
+{
+	uint32_t i, sum = 0;
+
+	for (i = 0; i < size; i++)
+		sum += no_os_field_prep(NO_OS_GENMASK(11, 4), util_bench_words[i]);
+
+	return sum;
+}
+
+static uint32_t bench_field_get_array(uint32_t size)
+{
+	no_os_field_get_array(NO_OS_GENMASK(31, 0), util_bench_words, size);
+
+	return util_bench_words[0];
+}
+
+static int bench_pid_setup(uint32_t size)
+{
+	struct no_os_pid_config config = {
+		.Kp = 500000,
+		.Ki = 30000,
+		.Kd = 100000,
+		.output_clip = { .high = 20000, .low = -20000 },
+	};
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < size; i++) {
+		ret = no_os_pid_init(&util_bench_pid[i], config);
+		if (ret) {
+			while (i--)
+				no_os_pid_remove(util_bench_pid[i]);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* One no_os_pid_control() call per loop */
+static uint32_t bench_pid(uint32_t size)
+{
+	uint32_t i, sum = 0;
+	int out;
+
+	for (i = 0; i < size; i++) {
+		no_os_pid_control(util_bench_pid[i], 1000, util_bench_data[i],
+				  &out);
+		sum += out;
+	}
+
+	return sum;
+}
+
+static void bench_pid_teardown(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < UTIL_BENCH_MAX_LOOPS; i++) {
+		if (util_bench_pid[i])
+			no_os_pid_remove(util_bench_pid[i]);
+		util_bench_pid[i] = NULL;
+	}
+}
+
+static int bench_pid_bank_setup(uint32_t size)
+{
+	struct no_os_pid_q15_config config[UTIL_BENCH_MAX_LOOPS];
+	uint32_t i;
+
+	for (i = 0; i < size; i++) {
+		config[i] = (struct no_os_pid_q15_config) {
+			.Kp = 16384,
+			.Ki = 1000,
+			.Kd = 3000,
+			.out_min = -20000,
+			.out_max = 20000,
+		};
+		util_bench_pid_io[0][i] = 1000;
+		util_bench_pid_io[1][i] = util_bench_data[i];
+	}
+
+	return no_os_pid_bank_init(&util_bench_pid_bank, config, size);
+}
+
+/* All the loops in one no_os_pid_bank_update() call */
+static uint32_t bench_pid_bank(uint32_t size)
+{
+	no_os_pid_bank_update(util_bench_pid_bank, util_bench_pid_io[0],
+			      util_bench_pid_io[1], util_bench_pid_io[2]);
+
+	return util_bench_pid_io[2][0];
+}
+
+static void bench_pid_bank_teardown(void)
+{
+	no_os_pid_bank_remove(util_bench_pid_bank);
+}
+
+#define UTIL_BENCH(_name, _unit, _sizes, _setup, _run, _teardown) { \
+	.name = _name, \
+	.unit = _unit, \
+	.sizes = _sizes, \
+	.nb_sizes = NO_OS_ARRAY_SIZE(_sizes), \
+	.setup = _setup, \
+	.run = _run, \
+	.teardown = _teardown, \
+}
+
+static const struct util_bench util_benches[] = {
+	UTIL_BENCH("cb_write_read", "byte", util_bench_buf_sizes,
+		   bench_cb_setup, bench_cb, bench_cb_teardown),
+	UTIL_BENCH("lf256fifo_write_read", "byte", util_bench_fifo_sizes,
+		   bench_fifo_setup, bench_fifo, bench_fifo_teardown),
+	UTIL_BENCH("list_queue", "op", util_bench_list_sizes,
+		   bench_list_setup, bench_list_queue, bench_list_teardown),
+	UTIL_BENCH("list_find", "op", util_bench_list_sizes,
+		   bench_list_setup, bench_list_find, bench_list_teardown),
+	UTIL_BENCH("crc8", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc8, NULL),
+	UTIL_BENCH("crc8_slice", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc8_slice, NULL),
+	UTIL_BENCH("crc16", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc16, NULL),
+	UTIL_BENCH("crc16_slice", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc16_slice, NULL),
+	UTIL_BENCH("crc24", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc24, NULL),
+	UTIL_BENCH("crc24_slice", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc24_slice, NULL),
+	UTIL_BENCH("crc32", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc32, NULL),
+	UTIL_BENCH("crc32_slice", "byte", util_bench_buf_sizes,
+		   NULL, bench_crc32_slice, NULL),
+	UTIL_BENCH("field_get", "op", util_bench_word_sizes,
+		   NULL, bench_field_get, NULL),
+	UTIL_BENCH("field_prep", "op", util_bench_word_sizes,
+		   NULL, bench_field_prep, NULL),
+	UTIL_BENCH("field_get_array", "op", util_bench_word_sizes,
+		   NULL, bench_field_get_array, NULL),
+	UTIL_BENCH("pid_control", "op", util_bench_loop_sizes,
+		   bench_pid_setup, bench_pid, bench_pid_teardown),
+	UTIL_BENCH("pid_bank_update", "op", util_bench_loop_sizes,
+		   bench_pid_bank_setup, bench_pid_bank, bench_pid_bank_teardown),
+};
+
+static void util_bench_init_data(void)
+{
+	uint32_t seed = 0x12345678;
+	uint32_t i;
+
+	/* xorshift, the same data on every platform */
+	for (i = 0; i < NO_OS_ARRAY_SIZE(util_bench_data); i++) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		util_bench_data[i] = seed;
+	}
+	for (i = 0; i < NO_OS_ARRAY_SIZE(util_bench_words); i++)
+		util_bench_words[i] = i * 0x9E3779B9;
+
+	no_os_crc8_populate_msb(util_bench_crc8, 0x07);
+	no_os_crc8_populate_slice_msb(util_bench_crc8_slice, 0x07);
+	no_os_crc16_populate_msb(util_bench_crc16, 0x1021);
+	no_os_crc16_populate_slice_msb(util_bench_crc16_slice, 0x1021);
+	no_os_crc24_populate_msb(util_bench_crc24, 0x864CFB);
+	no_os_crc24_populate_slice_msb(util_bench_crc24_slice, 0x864CFB);
+	no_os_crc32_populate_lsb(util_bench_crc32, 0xEDB88320);
+	no_os_crc32_populate_slice_lsb(util_bench_crc32_slice, 0xEDB88320);
+}
+
+static int util_bench_measure(const struct util_bench *bench, uint32_t size)
+{
+	uint32_t reps = no_os_max(UTIL_BENCH_WORK / size, 1u);
+	uint32_t best = UINT32_MAX;
+	uint32_t start, cycles;
+	uint64_t per_unit;
+	uint32_t run, i;
+	int ret;
+
+	if (bench->setup) {
+		ret = bench->setup(size);
+		if (ret)
+			return ret;
+	}
+
+	for (run = 0; run < UTIL_BENCH_RUNS; run++) {
+		start = no_os_get_cycles();
+		for (i = 0; i < reps; i++)
+			util_bench_sink += bench->run(size);
+		cycles = no_os_get_cycles() - start;
+		best = no_os_min(best, cycles);
+	}
+
+	if (bench->teardown)
+		bench->teardown();
+
+	/* Hundredths of a cycle */
+	per_unit = (uint64_t)best * 100 / ((uint64_t)reps * size);
+	printf("{\"bench\":\"%s\",\"size\":%"PRIu32",\"unit\":\"%s\","
+	       "\"count\":%"PRIu32",\"cycles\":%"PRIu32",\"ns\":%"PRIu64","
+	       "\"cycles_per_unit\":%"PRIu64".%02"PRIu64"}\n",
+	       bench->name, size, bench->unit, reps * size, best,
+	       no_os_cycles_to_ns(best), per_unit / 100, per_unit % 100);
+
+	return 0;
+}
+
+/**
+ * @brief Run every benchmark and print the results, one JSON object per line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int util_bench_run(void)
+{
+	uint32_t i, j;
+	int ret;
+
+	util_bench_init_data();
+
+	printf("{\"cycles_freq\":%"PRIu32"}\n", no_os_get_cycles_freq());
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(util_benches); i++) {
+		for (j = 0; j < util_benches[i].nb_sizes; j++) {
+			ret = util_bench_measure(&util_benches[i],
+						 util_benches[i].sizes[j]);
+			if (ret) {
+				printf("{\"bench\":\"%s\",\"error\":%d}\n",
+				       util_benches[i].name, ret);
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
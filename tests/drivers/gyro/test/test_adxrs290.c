@@ -0,0 +1,217 @@
+/***************************************************************************//**
+ *   @file   test_adxrs290.c
+ *   @brief  Bus budget tests of the ADXRS290 driver.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <string.h>
+#include "unity.h"
+#include "adxrs290.h"
+#include "bus_count.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_util.h"
+#include "mock_no_os_gpio.h"
+#include "mock_no_os_spi.h"
+#include "mock_no_os_irq.h"
+#include "mock_no_os_timer.h"
+#include "mock_no_os_lfring.h"
+#include "mock_no_os_alloc.h"
+#include <errno.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+static struct adxrs290_dev dev;
+static struct no_os_spi_desc spi_desc;
+static struct no_os_gpio_desc gpio_sync_desc;
+static struct no_os_irq_ctrl_desc irq_ctrl;
+static struct no_os_spi_seq seq;
+static struct no_os_callback_desc *isr;
+static int retval;
+
+/*******************************************************************************
+ *    CALLBACKS
+ ******************************************************************************/
+
+static int32_t get_optional_cb(struct no_os_gpio_desc **desc,
+			       const struct no_os_gpio_init_param *param,
+			       int cmock_num_calls)
+{
+	*desc = &gpio_sync_desc;
+
+	return 0;
+}
+
+static int32_t seq_init_cb(struct no_os_spi_seq **s, struct no_os_spi_desc *desc,
+			   struct no_os_spi_msg *msgs, uint32_t len,
+			   int cmock_num_calls)
+{
+	seq.desc = desc;
+	seq.msgs = msgs;
+	seq.len = len;
+	*s = &seq;
+
+	return 0;
+}
+
+static int32_t register_callback_cb(struct no_os_irq_ctrl_desc *desc,
+				    uint32_t irq_id,
+				    struct no_os_callback_desc *callback_desc,
+				    int cmock_num_calls)
+{
+	isr = callback_desc;
+
+	return 0;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&dev, 0, sizeof(dev));
+	dev.spi_desc = &spi_desc;
+	dev.ch_mask = ADXRS290_CHANNEL_MASK;
+	bus_count_start();
+}
+
+void tearDown(void)
+{
+	bus_count_set_rx(NULL, 0);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief The burst read of all the channels is a single 7 byte transfer.
+ */
+void test_adxrs290_budget_burst_data(void)
+{
+	int16_t data[ADXRS290_CHANNEL_COUNT];
+	uint8_t ch_cnt;
+
+	no_os_get_unaligned_le16_IgnoreAndReturn(0);
+	retval = adxrs290_get_burst_data(&dev, data, &ch_cnt);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_EQUAL_INT(ADXRS290_CHANNEL_COUNT, ch_cnt);
+	TEST_ASSERT_SPI_BUDGET(1, 1, ADXRS290_BURST_LEN);
+}
+
+/**
+ * @brief A scan is read in a single transfer.
+ */
+void test_adxrs290_budget_read_scan(void)
+{
+	struct adxrs290_scan scan;
+
+	no_os_get_unaligned_le16_IgnoreAndReturn(0);
+	retval = adxrs290_read_scan(&dev, &scan);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 1, ADXRS290_BURST_LEN);
+}
+
+/**
+ * @brief The rate of one axis is read in a single transfer.
+ */
+void test_adxrs290_budget_rate_data(void)
+{
+	int16_t rate;
+
+	retval = adxrs290_get_rate_data(&dev, ADXRS290_CHANNEL_X, &rate);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 1, 3);
+}
+
+/**
+ * @brief Setting the low-pass filter is a read-modify-write.
+ */
+void test_adxrs290_budget_set_lpf(void)
+{
+	retval = adxrs290_set_lpf(&dev, ADXRS290_LPF_80HZ);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(2, 2, 4);
+}
+
+/**
+ * @brief The streaming mode reads each scan in a single transfer from the
+ * data ready interrupt.
+ */
+void test_adxrs290_budget_stream(void)
+{
+	struct adxrs290_init_param ip = {
+		.mode = ADXRS290_MODE_MEASUREMENT,
+		.irq_ctrl = &irq_ctrl,
+	};
+	struct adxrs290_dev *device;
+	/* DEV_ID answer */
+	uint8_t rx[] = {0, ADXRS290_DEV_ID};
+	uint32_t i;
+
+	bus_count_set_rx(rx, sizeof(rx));
+	no_os_calloc_IgnoreAndReturn(&dev);
+	no_os_spi_init_IgnoreAndReturn(0);
+	no_os_gpio_get_optional_StubWithCallback(get_optional_cb);
+	no_os_gpio_direction_input_IgnoreAndReturn(0);
+	no_os_lfring_init_IgnoreAndReturn(0);
+	no_os_spi_seq_init_StubWithCallback(seq_init_cb);
+	no_os_irq_register_callback_StubWithCallback(register_callback_cb);
+	no_os_irq_trigger_level_set_IgnoreAndReturn(0);
+	retval = adxrs290_init(&device, &ip);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_NOT_NULL(isr);
+
+	no_os_lfring_flush_Ignore();
+	no_os_get_unaligned_le16_IgnoreAndReturn(0);
+	no_os_irq_enable_IgnoreAndReturn(0);
+	retval = adxrs290_stream_start(device);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+
+	bus_count_start();
+	no_os_spi_seq_run_async_IgnoreAndReturn(-ENOSYS);
+	no_os_lfring_push_IgnoreAndReturn(1);
+	for (i = 0; i < 4; i++)
+		isr->callback(isr->ctx);
+	TEST_ASSERT_SPI_BUDGET(4, 4, 4 * ADXRS290_BURST_LEN);
+	TEST_ASSERT_EQUAL_INT(0, device->stream_overruns);
+	TEST_ASSERT_EQUAL_INT(0, device->stream_errors);
+}
@@ -50,6 +50,7 @@
 #include "mock_no_os_gpio.h"
 #include "mock_no_os_spi.h"
 #include "mock_no_os_alloc.h"
+#include "bus_count.h"
 #include <errno.h>
 
 /*******************************************************************************
@@ -4362,3 +4363,93 @@ void test_adis_get_temp_scale_4(void)
 	retval = adis_get_temp_scale(&device_alloc, &scale);
 	TEST_ASSERT_EQUAL_INT(0, retval);
 }
+
+/**
+ * @brief Test the bus budget of a 16 bit adis_read_reg on the current page:
+ * one transfer, the read command then the answer.
+ */
+void test_adis_budget_read_reg_1(void)
+{
+	uint32_t val;
+	device_alloc.info = adis_chip_info;
+	device_alloc.current_page = 0;
+
+	bus_count_start();
+	no_os_get_unaligned_be16_IgnoreAndReturn(0);
+	retval = adis_read_reg(&device_alloc, 0, &val, 2);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 2, 4);
+}
+
+/**
+ * @brief Test the bus budget of a 32 bit adis_read_reg on another page: one
+ * transfer, with the page selection.
+ */
+void test_adis_budget_read_reg_2(void)
+{
+	uint32_t val;
+	device_alloc.info = adis_chip_info;
+	device_alloc.current_page = 1;
+
+	bus_count_start();
+	no_os_get_unaligned_be32_IgnoreAndReturn(0);
+	retval = adis_read_reg(&device_alloc, 0, &val, 4);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 4, 8);
+	TEST_ASSERT_EQUAL_INT(0, device_alloc.current_page);
+}
+
+/**
+ * @brief Test the bus budget of a 16 bit adis_write_reg: one transfer and no
+ * read back.
+ */
+void test_adis_budget_write_reg_1(void)
+{
+	device_alloc.info = adis_chip_info;
+	device_alloc.current_page = 0;
+
+	bus_count_start();
+	retval = adis_write_reg(&device_alloc, 0, 0x1234, 2);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 2, 4);
+}
+
+/**
+ * @brief Test the bus budget of a 32 bit adis_write_reg on another page: one
+ * transfer, with the page selection.
+ */
+void test_adis_budget_write_reg_2(void)
+{
+	device_alloc.info = adis_chip_info;
+	device_alloc.current_page = 1;
+
+	bus_count_start();
+	retval = adis_write_reg(&device_alloc, 0, 0x12345678, 4);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 5, 10);
+	device_alloc.current_page = 0;
+}
+
+/**
+ * @brief Test the bus budget of a 16 bit adis_read_burst_data: a single
+ * transfer of the command and the whole burst.
+ */
+void test_adis_budget_read_burst_data(void)
+{
+	uint16_t burst_data[9] = {0};
+	/* One non zero data byte, matched by the checksum */
+	uint8_t rx[8] = {0, 0, 0, 0, 1};
+
+	device_alloc.info = adis_chip_info;
+	device_alloc.burst32 = 0;
+	device_alloc.burst_sel = 0;
+
+	bus_count_start();
+	bus_count_set_rx(rx, sizeof(rx));
+	no_os_get_unaligned_be16_IgnoreAndReturn(1);
+	retval = adis_read_burst_data(&device_alloc, sizeof(burst_data), burst_data,
+				      device_alloc.burst32, device_alloc.burst_sel, true);
+	bus_count_set_rx(NULL, 0);
+	TEST_ASSERT_EQUAL_INT(0, retval);
+	TEST_ASSERT_SPI_BUDGET(1, 1, 22);
+}
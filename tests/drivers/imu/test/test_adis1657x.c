@@ -51,6 +51,7 @@
 #include "mock_no_os_gpio.h"
 #include "mock_no_os_spi.h"
 #include "mock_no_os_alloc.h"
+#include "bus_count.h"
 #include <errno.h>
 
 /*******************************************************************************
@@ -862,3 +863,12 @@ void test_adis1657x_get_temp_scale(void)
 	test_adis_get_temp_scale_3();
 	test_adis_get_temp_scale_4();
 }
+
+void test_adis1657x_bus_budget(void)
+{
+	test_adis_budget_read_reg_1();
+	test_adis_budget_read_reg_2();
+	test_adis_budget_write_reg_1();
+	test_adis_budget_write_reg_2();
+	test_adis_budget_read_burst_data();
+}
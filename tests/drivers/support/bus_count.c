@@ -0,0 +1,116 @@
+/***************************************************************************//**
+ *   @file   bus_count.c
+ *   @brief  Count the SPI transactions of a driver under test.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include "bus_count.h"
+#include "mock_no_os_spi.h"
+
+struct bus_count bus_count;
+
+static const uint8_t *bus_count_rx;
+static uint32_t bus_count_rx_len;
+
+void bus_count_set_rx(const uint8_t *rx, uint32_t len)
+{
+	bus_count_rx = rx;
+	bus_count_rx_len = rx ? len : 0;
+}
+
+void bus_count_fill_rx(uint8_t *buf, uint32_t len)
+{
+	uint32_t n = len < bus_count_rx_len ? len : bus_count_rx_len;
+
+	if (n)
+		memcpy(buf, bus_count_rx, n);
+	memset(buf + n, 0, len - n);
+}
+
+/* Count a list of messages sent in one transaction */
+static void bus_count_spi_msgs(struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	bus_count.spi_transfers++;
+	bus_count.spi_cs++;
+
+	for (i = 0; i < len; i++) {
+		bus_count.spi_bytes += msgs[i].bytes_number;
+		if (msgs[i].rx_buff)
+			bus_count_fill_rx(msgs[i].rx_buff, msgs[i].bytes_number);
+		/* The chip select is asserted again for the next message */
+		if (msgs[i].cs_change && i + 1 < len)
+			bus_count.spi_cs++;
+	}
+}
+
+static int32_t bus_count_spi_write_and_read(struct no_os_spi_desc *desc,
+		uint8_t *data, uint16_t bytes_number, int cmock_num_calls)
+{
+	bus_count.spi_transfers++;
+	bus_count.spi_cs++;
+	bus_count.spi_bytes += bytes_number;
+	bus_count_fill_rx(data, bytes_number);
+
+	return 0;
+}
+
+static int32_t bus_count_spi_transfer(struct no_os_spi_desc *desc,
+				      struct no_os_spi_msg *msgs, uint32_t len,
+				      int cmock_num_calls)
+{
+	bus_count_spi_msgs(msgs, len);
+
+	return 0;
+}
+
+static int32_t bus_count_spi_seq_run(struct no_os_spi_seq *seq,
+				     int cmock_num_calls)
+{
+	bus_count_spi_msgs(seq->msgs, seq->len);
+
+	return 0;
+}
+
+void bus_count_start(void)
+{
+	memset(&bus_count, 0, sizeof(bus_count));
+
+	no_os_spi_write_and_read_StubWithCallback(bus_count_spi_write_and_read);
+	no_os_spi_transfer_StubWithCallback(bus_count_spi_transfer);
+	no_os_spi_seq_run_StubWithCallback(bus_count_spi_seq_run);
+}
@@ -0,0 +1,102 @@
+/***************************************************************************//**
+ *   @file   bus_count.h
+ *   @brief  Count the bus transactions of a driver under test.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef __BUS_COUNT_H__
+#define __BUS_COUNT_H__
+
+#include <stdint.h>
+#include "unity.h"
+
+/**
+ * @struct bus_count
+ * @brief Bus traffic since the last bus_count_start().
+ */
+struct bus_count {
+	/** Calls of the SPI API, each one is a transaction on the bus */
+	uint32_t spi_transfers;
+	/** Chip select assertions */
+	uint32_t spi_cs;
+	/** Bytes clocked on the SPI bus */
+	uint32_t spi_bytes;
+	/** Calls of the I2C API */
+	uint32_t i2c_transfers;
+	/** Bytes written and read on the I2C bus */
+	uint32_t i2c_bytes;
+};
+
+extern struct bus_count bus_count;
+
+/*
+ * Check that the operation counted since bus_count_start() used at most the
+ * given number of SPI transactions, chip select assertions and bytes.
+ */
+#define TEST_ASSERT_SPI_BUDGET(transfers, cs, bytes)				\
+	do {									\
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE((transfers),		\
+			bus_count.spi_transfers, "SPI transfers over budget");	\
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE((cs),			\
+			bus_count.spi_cs, "SPI CS assertions over budget");	\
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE((bytes),		\
+			bus_count.spi_bytes, "SPI bytes over budget");		\
+	} while (0)
+
+/* Same for the I2C transactions and bytes. */
+#define TEST_ASSERT_I2C_BUDGET(transfers, bytes)				\
+	do {									\
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE((transfers),		\
+			bus_count.i2c_transfers, "I2C transfers over budget");	\
+		TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE((bytes),		\
+			bus_count.i2c_bytes, "I2C bytes over budget");		\
+	} while (0)
+
+/*
+ * Clear the counters and stub the SPI API of the mock with counting
+ * callbacks, replacing the expectations of the current test.
+ */
+void bus_count_start(void);
+
+/*
+ * Data returned by the counted reads, from the start of each receive buffer.
+ * Bytes past len are read as 0. The data must stay valid while it is used.
+ */
+void bus_count_set_rx(const uint8_t *rx, uint32_t len);
+
+/* Fill a receive buffer from the data set by bus_count_set_rx(). */
+void bus_count_fill_rx(uint8_t *buf, uint32_t len);
+
+#endif // __BUS_COUNT_H__
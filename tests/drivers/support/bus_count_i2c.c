@@ -0,0 +1,98 @@
+/***************************************************************************//**
+ *   @file   bus_count_i2c.c
+ *   @brief  Count the I2C transactions of a driver under test.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include "bus_count_i2c.h"
+#include "mock_no_os_i2c.h"
+
+static int32_t bus_count_i2c_write(struct no_os_i2c_desc *desc, uint8_t *data,
+				   uint8_t bytes_number, uint8_t stop_bit,
+				   int cmock_num_calls)
+{
+	bus_count.i2c_transfers++;
+	bus_count.i2c_bytes += bytes_number;
+
+	return 0;
+}
+
+static int32_t bus_count_i2c_read(struct no_os_i2c_desc *desc, uint8_t *data,
+				  uint8_t bytes_number, uint8_t stop_bit,
+				  int cmock_num_calls)
+{
+	bus_count.i2c_transfers++;
+	bus_count.i2c_bytes += bytes_number;
+	bus_count_fill_rx(data, bytes_number);
+
+	return 0;
+}
+
+static int32_t bus_count_i2c_transfer(struct no_os_i2c_desc *desc,
+				      struct no_os_i2c_msg *msgs,
+				      uint32_t nb_msgs, int cmock_num_calls)
+{
+	uint32_t i;
+
+	bus_count.i2c_transfers++;
+
+	for (i = 0; i < nb_msgs; i++) {
+		bus_count.i2c_bytes += msgs[i].len;
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			bus_count_fill_rx(msgs[i].buf, msgs[i].len);
+	}
+
+	return 0;
+}
+
+static int32_t bus_count_i2c_write_read(struct no_os_i2c_desc *desc,
+					uint8_t *tx, uint32_t tx_len,
+					uint8_t *rx, uint32_t rx_len,
+					int cmock_num_calls)
+{
+	bus_count.i2c_transfers++;
+	bus_count.i2c_bytes += tx_len + rx_len;
+	bus_count_fill_rx(rx, rx_len);
+
+	return 0;
+}
+
+void bus_count_i2c_start(void)
+{
+	no_os_i2c_write_StubWithCallback(bus_count_i2c_write);
+	no_os_i2c_read_StubWithCallback(bus_count_i2c_read);
+	no_os_i2c_transfer_StubWithCallback(bus_count_i2c_transfer);
+	no_os_i2c_write_read_StubWithCallback(bus_count_i2c_write_read);
+}
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+# Decode a SPI/I2C transfer capture of a BUS_TRACE=y build and report the bus
+# utilization. The capture is either the binary of no_os_bus_trace_dump(),
+# from a file or a serial port, or the text read from the bus_trace IIO debug
+# attribute, directly with libiio or saved to a file:
+#	python bus_trace.py capture.bin
+#	python bus_trace.py /dev/ttyUSB0 -baud 115200
+#	python bus_trace.py -u ip:192.168.2.1 -d adc_demo -start 1000 -wait 2
+#
+# For each bus and device it prints the number of transfers and bytes, the
+# time the bus was busy, the average duration and gap between transfers, and
+# the fixed cost per transfer estimated from the duration of the shortest one.
+
+import argparse
+import struct
+import sys
+import time
+
+MAGIC = b'NOBT'
+HDR = struct.Struct('<4sBBHIII')
+REC = struct.Struct('<BBBBHIII')
+TYPES = {0: 'spi', 1: 'i2c'}
+
+class Transfer:
+	def __init__(self, type, bus, dev, length, start, duration, gap, err):
+		self.type = type
+		self.bus = bus
+		self.dev = dev
+		self.len = length
+		self.start = start
+		self.duration = duration
+		self.gap = gap
+		self.err = err
+
+def parse_binary(data):
+	magic, version, rec_size, _, freq, total, count = HDR.unpack_from(data)
+	if magic != MAGIC or version != 1 or rec_size != REC.size:
+		sys.exit('Not a version 1 bus trace capture')
+	transfers = []
+	for i in range(count):
+		t, bus, dev, err, length, start, dur, gap = REC.unpack_from(data,
+				HDR.size + i * REC.size)
+		transfers.append(Transfer(TYPES.get(t, str(t)), bus, dev, length,
+					  start, dur, gap, err))
+	return freq, total, transfers
+
+def parse_text(text):
+	freq = total = None
+	transfers = []
+	for line in text.splitlines():
+		f = line.split()
+		if not f:
+			continue
+		if f[0] == '#':
+			freq, total = int(f[2]), int(f[4])
+			continue
+		transfers.append(Transfer(f[0], int(f[1]), int(f[2]), int(f[3]),
+					  int(f[4]), int(f[5]), int(f[6]), int(f[7])))
+	if freq is None:
+		sys.exit('No capture header found')
+	return freq, total, transfers
+
+def read_iio(args):
+	import iio
+
+	ctx = iio.Context(args.u)
+	dev = ctx.find_device(args.d)
+	if dev is None:
+		sys.exit('Device ' + args.d + ' not found')
+	attr = dev.debug_attrs['bus_trace']
+	if args.start is not None:
+		attr.value = 'start %d' % args.start if args.start else 'start'
+		time.sleep(args.wait)
+		if not args.start:
+			attr.value = 'stop'
+	attr.value = 'rewind'
+	text = ''
+	while True:
+		part = attr.value
+		if not part:
+			return text
+		text += part + '\n'
+
+def read_input(path, baud):
+	if path.startswith(('/dev/', 'COM')):
+		import serial
+		port = serial.Serial(path, baud, timeout=2)
+		data = port.read(HDR.size)
+		count = HDR.unpack(data)[6]
+		return data + port.read(count * REC.size)
+	with open(path, 'rb') as f:
+		return f.read()
+
+def to_us(cycles, freq):
+	return cycles * 1e6 / freq
+
+def report(freq, total, transfers, list_all):
+	if list_all:
+		print('%-4s %3s %4s %6s %12s %10s %10s %3s' % ('bus', 'nb', 'dev',
+		      'len', 'start', 'dur us', 'gap us', 'err'))
+		for t in transfers:
+			print('%-4s %3d 0x%02x %6d %12d %10.2f %10.2f %3d' % (t.type,
+			      t.bus, t.dev, t.len, t.start, to_us(t.duration, freq),
+			      to_us(t.gap, freq), t.err))
+		print()
+
+	if not transfers:
+		print('Empty capture')
+		return
+
+	print('%d transfers captured, %d recorded, counter at %d Hz' %
+	      (len(transfers), total, freq))
+	if total > len(transfers):
+		print('The oldest %d transfers were overwritten' %
+		      (total - len(transfers)))
+	print()
+
+	groups = {}
+	for t in transfers:
+		groups.setdefault((t.type, t.bus), {}).setdefault(t.dev, []).append(t)
+
+	for (type, bus), devs in sorted(groups.items()):
+		xfers = [t for d in devs.values() for t in d]
+		first = min(t.start for t in xfers)
+		end = max((t.start + t.duration) & 0xFFFFFFFF for t in xfers)
+		span = (end - first) & 0xFFFFFFFF
+		busy = sum(t.duration for t in xfers)
+		print('%s%d: %d transfers, %d bytes in %.1f us, %.1f%% busy' %
+		      (type, bus, len(xfers), sum(t.len for t in xfers),
+		       to_us(span, freq), 100.0 * busy / span if span else 100.0))
+		print('  %-6s %8s %8s %10s %10s %10s %10s %5s' % ('dev', 'count',
+		      'bytes', 'busy us', 'avg us', 'gap us', 'fixed us', 'err'))
+		for dev, d in sorted(devs.items()):
+			gaps = [t.gap for t in d if t.gap]
+			shortest = min(d, key=lambda t: t.duration)
+			print('  0x%02x   %8d %8d %10.1f %10.2f %10.2f %10.2f %5d' %
+			      (dev, len(d), sum(t.len for t in d),
+			       to_us(sum(t.duration for t in d), freq),
+			       to_us(sum(t.duration for t in d) / len(d), freq),
+			       to_us(sum(gaps) / len(gaps), freq) if gaps else 0,
+			       to_us(shortest.duration, freq),
+			       sum(t.err for t in d)))
+		print()
+
+def main():
+	parser = argparse.ArgumentParser(description='no-OS bus trace decoder')
+	parser.add_argument('input', nargs='?',
+			    help='binary or text capture file, or serial port')
+	parser.add_argument('-baud', type=int, default=115200,
+			    help='baud rate when input is a serial port')
+	parser.add_argument('-u', help='libiio context uri, instead of input')
+	parser.add_argument('-d', default='adc_demo',
+			    help='IIO device with the bus_trace debug attribute')
+	parser.add_argument('-start', type=int,
+			    help='start a capture of this many transfers first, '
+				 '0 to capture for -wait seconds')
+	parser.add_argument('-wait', type=float, default=1,
+			    help='seconds to wait for the capture with -start')
+	parser.add_argument('-list', action='store_true',
+			    help='also list every transfer')
+	args = parser.parse_args()
+
+	if args.u:
+		freq, total, transfers = parse_text(read_iio(args))
+	elif args.input:
+		data = read_input(args.input, args.baud)
+		if data.startswith(MAGIC):
+			freq, total, transfers = parse_binary(data)
+		else:
+			freq, total, transfers = parse_text(data.decode())
+	else:
+		parser.error('an input or -u is required')
+
+	report(freq, total, transfers, args.list)
+
+if __name__ == '__main__':
+	main()
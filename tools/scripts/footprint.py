@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+# Report the flash and RAM used by each object and subsystem of a build, from
+# the GNU ld map file, and compare it with the previous report of the build:
+#	python footprint.py build/app.map build/app-footprint.json
+#
+# The report of the previous run is read from the JSON file before it is
+# overwritten. A subsystem or object that grew by more than -threshold bytes
+# is flagged, and -fail makes the script exit with an error in that case.
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# Subsystems, the first whose pattern matches the object path is used
+SUBSYSTEMS = [
+	('iio', re.compile(r'(^|/)iio/')),
+	('lwip', re.compile(r'lwip', re.I)),
+	('mbedtls', re.compile(r'mbedtls', re.I)),
+	('freertos', re.compile(r'freertos', re.I)),
+	('platform', re.compile(r'(^|/)drivers/platform/')),
+	('drivers', re.compile(r'(^|/)drivers/')),
+	('network', re.compile(r'(^|/)network/')),
+	('libraries', re.compile(r'(^|/)libraries/')),
+	('util', re.compile(r'(^|/)util/')),
+	('toolchain', re.compile(r'\.a\(')),
+]
+
+MEM_REGION = re.compile(r'^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s*(\S*)$')
+OUT_SECTION = re.compile(r'^(\.\S+|\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)'
+			 r'(?:\s+load address 0x([0-9a-fA-F]+))?\s*$')
+IN_SECTION = re.compile(r'^\s+(\S+)?\s*0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+
+RAM_ONLY = ('.bss', '.sbss', 'COMMON', '.noinit', '.heap', '.stack')
+
+def subsystem(obj):
+	for name, pattern in SUBSYSTEMS:
+		if pattern.search(obj):
+			return name
+	# Objects linked from outside the build directory, e.g. crt0
+	if os.path.isabs(obj):
+		return 'toolchain'
+	return 'project'
+
+def short_path(obj):
+	obj = obj.replace('\\', '/')
+	if '/objs/' in obj:
+		return obj.split('/objs/', 1)[1]
+	return obj
+
+class Region:
+	def __init__(self, origin, length, writable):
+		self.origin = origin
+		self.end = origin + length
+		self.writable = writable
+
+def find_region(regions, addr):
+	for region in regions:
+		if region.origin <= addr < region.end:
+			return region
+	return None
+
+def placement(regions, name, vma, lma):
+	"""Returns (flash, ram), whether an output section uses flash and RAM."""
+	vma_region = find_region(regions, vma)
+	if vma_region is None:
+		# No memory configuration, guess from the section name
+		if name.startswith(RAM_ONLY):
+			return False, True
+		if name.startswith('.data'):
+			return True, True
+		return True, False
+
+	ram = vma_region.writable
+	if lma is not None:
+		lma_region = find_region(regions, lma)
+		flash = lma_region is not None and not lma_region.writable
+	else:
+		flash = not ram
+	return flash, ram
+
+def parse_map(path):
+	with open(path, errors='replace') as f:
+		lines = f.read().splitlines()
+
+	regions = []
+	objects = {}
+	i = 0
+
+	while i < len(lines) and not lines[i].startswith('Memory Configuration'):
+		i += 1
+	while i < len(lines) and not lines[i].startswith('Linker script and memory map'):
+		m = MEM_REGION.match(lines[i])
+		if m and m.group(1) != '*default*':
+			regions.append(Region(int(m.group(2), 16), int(m.group(3), 16),
+					      'w' in m.group(4)))
+		i += 1
+
+	flash = ram = False
+	pending = None
+	for line in lines[i:]:
+		if line.startswith('/DISCARD/'):
+			flash = ram = False
+			continue
+
+		m = OUT_SECTION.match(line)
+		if m and not line[0].isspace():
+			lma = int(m.group(4), 16) if m.group(4) else None
+			flash, ram = placement(regions, m.group(1),
+					       int(m.group(2), 16), lma)
+			pending = None
+			continue
+
+		if line.startswith(' ') and len(line.split()) == 1 and \
+		   not line.strip().startswith('0x'):
+			# Long input section name, its address is on the next line
+			pending = line.strip()
+			continue
+
+		m = IN_SECTION.match(line)
+		if not m:
+			pending = None
+			continue
+
+		name = m.group(1) or pending
+		pending = None
+		size = int(m.group(3), 16)
+		obj = m.group(4).strip()
+		if not size or not name or name == '*fill*' or not (flash or ram):
+			continue
+		if obj.startswith('load address'):
+			continue
+
+		obj = short_path(obj)
+		entry = objects.setdefault(obj, {'flash': 0, 'ram': 0})
+		if flash:
+			entry['flash'] += size
+		if ram:
+			entry['ram'] += size
+
+	return objects
+
+def summarize(objects):
+	subsystems = {}
+	for obj, entry in objects.items():
+		total = subsystems.setdefault(subsystem(obj), {'flash': 0, 'ram': 0})
+		total['flash'] += entry['flash']
+		total['ram'] += entry['ram']
+	return subsystems
+
+def delta(cur, prev, key):
+	if prev is None:
+		return ''
+	d = cur[key] - prev.get(key, 0)
+	return '%+d' % d if d else ''
+
+def print_table(title, rows, prev, threshold):
+	regressions = []
+	print('%-48s %10s %8s %10s %8s' % (title, 'flash', '', 'ram', ''))
+	for name, entry in rows:
+		old = prev.get(name) if prev is not None else None
+		if prev is not None and old is None:
+			old = {'flash': 0, 'ram': 0}
+		mark = ''
+		if old is not None and (entry['flash'] - old['flash'] > threshold or
+					entry['ram'] - old['ram'] > threshold):
+			mark = ' <-- regression'
+			regressions.append(name)
+		print('%-48s %10d %8s %10d %8s%s' % (name[-48:], entry['flash'],
+			delta(entry, old, 'flash'), entry['ram'],
+			delta(entry, old, 'ram'), mark))
+	print()
+	return regressions
+
+def main():
+	parser = argparse.ArgumentParser(description='no-OS memory footprint report')
+	parser.add_argument('map', help='GNU ld map file of the build')
+	parser.add_argument('report', help='JSON report, compared then overwritten')
+	parser.add_argument('-top', type=int, default=20,
+			    help='number of objects listed, 0 for all')
+	parser.add_argument('-threshold', type=int, default=0,
+			    help='growth in bytes tolerated before a regression is flagged')
+	parser.add_argument('-fail', action='store_true',
+			    help='exit with an error when a regression is flagged')
+	args = parser.parse_args()
+
+	if not os.path.isfile(args.map):
+		sys.exit(args.map + ' not found, link the project first')
+
+	objects = parse_map(args.map)
+	subsystems = summarize(objects)
+
+	prev = None
+	if os.path.isfile(args.report):
+		with open(args.report) as f:
+			prev = json.load(f)
+
+	total = {'flash': sum(e['flash'] for e in objects.values()),
+		 'ram': sum(e['ram'] for e in objects.values())}
+
+	regressions = print_table('subsystem',
+		sorted(subsystems.items(), key=lambda e: -e[1]['flash'] - e[1]['ram']),
+		prev['subsystems'] if prev else None, args.threshold)
+
+	rows = sorted(objects.items(), key=lambda e: -e[1]['flash'] - e[1]['ram'])
+	if args.top:
+		rows = rows[:args.top]
+	regressions += print_table('object', rows,
+		prev['objects'] if prev else None, args.threshold)
+
+	print_table('total', [('total', total)],
+		    {'total': prev['total']} if prev else None, args.threshold)
+
+	with open(args.report, 'w') as f:
+		json.dump({'total': total, 'subsystems': subsystems,
+			   'objects': objects}, f, indent=1, sort_keys=True)
+
+	if regressions:
+		print('%d regression(s) above %d bytes' % (len(regressions),
+							   args.threshold))
+		if args.fail:
+			sys.exit(1)
+
+if __name__ == '__main__':
+	main()
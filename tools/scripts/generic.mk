@@ -162,6 +162,13 @@ relative_to_project = $(addprefix $(PROJECT_BUILD)/,$(call get_relative_path,$1)
 
 include $(NO-OS)/tools/scripts/libraries.mk
 
+# Headers used by the common utilities and the platform drivers
+INCS += $(INCLUDE)/no_os_profile.h \
+	$(INCLUDE)/no_os_counter.h \
+	$(INCLUDE)/no_os_bus_trace.h \
+	$(INCLUDE)/no_os_static_ops.h \
+	$(INCLUDE)/no_os_section.h
+
 ifeq (y,$(strip $(RELEASE)))
 CFLAGS += -O2
 endif
@@ -174,6 +181,72 @@ ifeq (y,$(strip $(DISABLE_SECURE_SOCKET)))
 CFLAGS += -DDISABLE_SECURE_SOCKET
 endif
 
+ifeq (y,$(strip $(RAMFUNCS)))
+CFLAGS += -DNO_OS_RAMFUNCS
+endif
+
+ifeq (y,$(strip $(PROFILING)))
+CFLAGS += -DNO_OS_PROFILING
+SRCS += $(NO-OS)/util/no_os_profile.c
+endif
+
+ifeq (y,$(strip $(COUNTERS)))
+CFLAGS += -DNO_OS_COUNTERS
+SRCS += $(NO-OS)/util/no_os_counter.c
+endif
+
+ifeq (y,$(strip $(BUS_TRACE)))
+CFLAGS += -DNO_OS_BUS_TRACE
+SRCS += $(NO-OS)/util/no_os_bus_trace.c \
+	$(NO-OS)/util/no_os_profile.c
+endif
+
+# Platform ops named by the no_os_platform_config.h of the project
+ifeq (y,$(strip $(STATIC_PLATFORM_OPS)))
+CFLAGS += -DNO_OS_STATIC_PLATFORM_OPS
+endif
+
+ifeq (n,$(strip $(BUS_MUTEX)))
+CFLAGS += -DNO_OS_NO_BUS_MUTEX
+endif
+
+ifeq (y,$(strip $(LTO)))
+CFLAGS += -flto
+LDFLAGS += -flto
+endif
+
+ifeq (y,$(strip $(LOG_DEFERRED)))
+CFLAGS += -DNO_OS_LOG_DEFERRED
+LDFLAGS += -Wl,-T,$(NO-OS)/tools/scripts/no_os_log.ld
+SRCS += $(NO-OS)/util/no_os_log.c \
+	$(NO-OS)/util/no_os_lfring.c
+INCS += $(INCLUDE)/no_os_log.h \
+	$(INCLUDE)/no_os_lfring.h
+endif
+
+# Optional parts of the IIO core, built unless set to n
+ifeq (n,$(strip $(IIO_TRIGGERS)))
+CFLAGS += -DIIO_NO_TRIGGERS
+endif
+
+ifeq (n,$(strip $(IIO_DEBUG_ATTRS)))
+CFLAGS += -DIIO_NO_DEBUG_ATTRS
+endif
+
+ifeq (n,$(strip $(IIO_XML_GEN)))
+CFLAGS += -DIIO_NO_XML_GEN
+endif
+
+# Map file of the link, used by the footprint target
+comma := ,
+ifeq (,$(findstring -Map=,$(LDFLAGS)))
+MAP_FILE ?= $(basename $(BINARY)).map
+LDFLAGS += -Wl,-Map=$(MAP_FILE)
+else
+MAP_FILE ?= $(patsubst -Wl$(comma)-Map=%,%,$(filter -Wl$(comma)-Map=%,$(LDFLAGS)))
+endif
+FOOTPRINT_FILE ?= $(BUILD_DIR)/$(PROJECT_NAME)-footprint.json
+
 SRC_DIRS := $(patsubst %/,%,$(SRC_DIRS))
 
 # Get all .c, .cpp and .h files from SRC_DIRS
@@ -400,6 +473,14 @@ reset: clean_libs
 	$(call print,[Delete] $(BUILD_DIR))
 	$(call remove_dir,$(BUILD_DIR))
 
+# Flash and RAM used per subsystem and object, compared with the last run.
+# FOOTPRINT_ARGS="-threshold 256 -fail" fails on a growth above 256 bytes.
+PHONY += footprint
+footprint: $(BINARY)
+	$(call print,Memory footprint of $(notdir $(BINARY)))
+	python $(NO-OS)/tools/scripts/footprint.py $(MAP_FILE) $(FOOTPRINT_FILE) \
+		$(FOOTPRINT_ARGS)
+
 PHONY += list
 list:
 	$(call print_lines, $(sort $(SRCS) $(INCS)))
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+# Measure the IIO throughput of a no-OS target with libiio, over any backend
+# libiio supports (serial, ip, usb):
+#	python iio_bench.py -u ip:127.0.0.1
+#	python iio_bench.py -u serial:/dev/ttyUSB0,921600 -t 30 -rate 10000
+#
+# Reports the sustained MB/s of the buffer refills, the latency of each refill
+# and the round trip time of an attribute read. With the ramp streamed by
+# adc_demo in benchmark mode (ADC_DEMO_BENCH=y in projects/iio_demo), -verify
+# also counts the samples lost between refills.
+
+import argparse
+import array
+import json
+import sys
+import time
+
+import iio
+
+def percentile(values, p):
+	values = sorted(values)
+	return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+def summary(values):
+	"""min, avg, p50, p99 and max of values in ms."""
+	return {
+		'min': min(values) * 1e3,
+		'avg': sum(values) / len(values) * 1e3,
+		'p50': percentile(values, 50) * 1e3,
+		'p99': percentile(values, 99) * 1e3,
+		'max': max(values) * 1e3,
+	}
+
+def print_summary(name, s):
+	print('%-16s min %8.3f  avg %8.3f  p50 %8.3f  p99 %8.3f  max %8.3f ms' %
+	      (name, s['min'], s['avg'], s['p50'], s['p99'], s['max']))
+
+def attr_rtt(dev, attr, count):
+	times = []
+	for _ in range(count):
+		start = time.perf_counter()
+		dev.attrs[attr].value
+		times.append(time.perf_counter() - start)
+	return times
+
+def lost_scans(data, nb_ch, expected):
+	"""Scans missing before this block, from the ramp of its first channel."""
+	samples = array.array('H', data)
+	first = samples[0]
+	last = samples[len(samples) - nb_ch]
+	lost = 0 if expected is None else (first - expected) & 0xFFFF
+	return lost, (last + 1) & 0xFFFF
+
+def main():
+	parser = argparse.ArgumentParser(description='no-OS IIO throughput benchmark')
+	parser.add_argument('-u', required=True, help='libiio context uri')
+	parser.add_argument('-d', default='adc_demo', help='input device name')
+	parser.add_argument('-c', nargs='*', help='channels to enable, all by default')
+	parser.add_argument('-b', type=int, default=4096, help='buffer size in scans')
+	parser.add_argument('-t', type=float, default=10, help='duration in seconds')
+	parser.add_argument('-rate', type=int,
+			    help='scans per second, written to sampling_frequency')
+	parser.add_argument('-attr', default='sampling_frequency',
+			    help='device attribute used for the round trip time')
+	parser.add_argument('-attr-count', type=int, default=100,
+			    help='number of attribute reads')
+	parser.add_argument('-verify', action='store_true',
+			    help='check the adc_demo benchmark ramp for lost scans')
+	parser.add_argument('-json', help='also write the results to this file')
+	args = parser.parse_args()
+
+	ctx = iio.Context(args.u)
+	dev = ctx.find_device(args.d)
+	if dev is None:
+		sys.exit('Device ' + args.d + ' not found')
+
+	if args.rate is not None:
+		dev.attrs['sampling_frequency'].value = str(args.rate)
+
+	rtt = attr_rtt(dev, args.attr, args.attr_count) if args.attr_count else []
+
+	channels = [ch for ch in dev.channels if ch.scan_element and not ch.output]
+	if args.c:
+		channels = [ch for ch in channels if ch.id in args.c]
+	if not channels:
+		sys.exit('No input scan channel to enable')
+	for ch in channels:
+		ch.enabled = True
+
+	buf = iio.Buffer(dev, args.b)
+	refills = []
+	nbytes = 0
+	lost = 0
+	expected = None
+
+	start = time.perf_counter()
+	while time.perf_counter() - start < args.t:
+		t = time.perf_counter()
+		buf.refill()
+		data = buf.read()
+		refills.append(time.perf_counter() - t)
+		nbytes += len(data)
+		if args.verify:
+			n, expected = lost_scans(data, len(channels), expected)
+			lost += n
+	elapsed = time.perf_counter() - start
+
+	del buf
+	for ch in channels:
+		ch.enabled = False
+
+	results = {
+		'uri': args.u,
+		'device': args.d,
+		'channels': [ch.id for ch in channels],
+		'buffer_scans': args.b,
+		'bytes': nbytes,
+		'seconds': elapsed,
+		'mb_per_s': nbytes / elapsed / 1e6,
+		'refill_ms': summary(refills),
+	}
+	if rtt:
+		results['attr_rtt_ms'] = summary(rtt)
+	if args.verify:
+		results['lost_scans'] = lost
+
+	print('%s, %s, %d channels, %d scans per buffer' % (args.u, args.d,
+	      len(channels), args.b))
+	print('%-16s %.3f MB/s (%d bytes in %.1f s)' % ('throughput',
+	      results['mb_per_s'], nbytes, elapsed))
+	print_summary('refill', results['refill_ms'])
+	if rtt:
+		print_summary('attribute', results['attr_rtt_ms'])
+	if args.verify:
+		print('%-16s %d' % ('lost scans', lost))
+
+	if args.json:
+		with open(args.json, 'w') as f:
+			json.dump(results, f, indent=1, sort_keys=True)
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+# Read the buffer of a no-OS IIO device built with IIO_COMPRESSION=y, with the
+# delta codec, and decode it back to the raw scans:
+#	python iio_decompress.py -u ip:127.0.0.1 -d adc_demo -t 10 -o scans.bin
+#
+# The frames are decoded across refills, a READBUF no longer holds a whole
+# number of scans. Reports the compression ratio and the rate of raw data.
+
+import argparse
+import sys
+import time
+
+import iio
+
+MAGIC = 0x5A
+CODEC_DELTA = 1
+HDR_SIZE = 6
+
+def scan_layout(channels):
+	"""(offset, bytes, big endian) of each channel and the size of a scan,
+	aligned as by the IIO core."""
+	layout = []
+	cnt = 0
+	largest = 1
+	for ch in channels:
+		length = ch.data_format.length // 8
+		largest = max(largest, length)
+		if cnt % length:
+			cnt += 2 * length - cnt % length
+		else:
+			cnt += length
+		layout.append((cnt - length, length, ch.data_format.is_be))
+	if cnt % largest:
+		cnt += largest - cnt % largest
+	return layout, cnt
+
+class Decoder:
+	def __init__(self, layout, scan_bytes):
+		self.layout = layout
+		self.scan_bytes = scan_bytes
+		self.pending = bytearray()
+		self.frames = 0
+
+	def feed(self, data):
+		"""Decode the complete frames of data, return the raw scans."""
+		self.pending += data
+		out = bytearray()
+		i = 0
+		while True:
+			# Zero bytes between the frames are padding
+			while i < len(self.pending) and self.pending[i] == 0:
+				i += 1
+			if len(self.pending) - i < HDR_SIZE:
+				break
+			if self.pending[i] != MAGIC or self.pending[i + 1] != CODEC_DELTA:
+				raise ValueError('bad frame header at byte %d' % i)
+			nb = int.from_bytes(self.pending[i + 2:i + 4], 'little')
+			size = int.from_bytes(self.pending[i + 4:i + 6], 'little')
+			if len(self.pending) - i < HDR_SIZE + size:
+				break
+			start = i + HDR_SIZE
+			out += self.frame(self.pending[start:start + size], nb)
+			self.frames += 1
+			i = start + size
+		del self.pending[:i]
+		return bytes(out)
+
+	def frame(self, payload, nb):
+		scans = bytearray(nb * self.scan_bytes)
+		pos = 0
+		for offset, length, be in self.layout:
+			order = 'big' if be else 'little'
+			bits = 8 * length
+			mask = (1 << bits) - 1
+			width = payload[pos]
+			val = int.from_bytes(payload[pos + 1:pos + 1 + length], order)
+			pos += 1 + length
+			scans[offset:offset + length] = val.to_bytes(length, order)
+			if not width:
+				for j in range(1, nb):
+					o = offset + j * self.scan_bytes
+					scans[o:o + length] = scans[offset:offset + length]
+				continue
+
+			packed = (nb - 1) * width
+			size = (packed + 7) // 8
+			acc = int.from_bytes(payload[pos:pos + size], 'little')
+			pos += size
+			zmask = (1 << width) - 1
+			for j in range(1, nb):
+				zz = acc & zmask
+				acc >>= width
+				val = (val + ((zz >> 1) ^ -(zz & 1))) & mask
+				o = offset + j * self.scan_bytes
+				scans[o:o + length] = val.to_bytes(length, order)
+		return scans
+
+def main():
+	parser = argparse.ArgumentParser(description='no-OS IIO compressed buffer reader')
+	parser.add_argument('-u', required=True, help='libiio context uri')
+	parser.add_argument('-d', default='adc_demo', help='input device name')
+	parser.add_argument('-c', nargs='*', help='channels to enable, all by default')
+	parser.add_argument('-b', type=int, default=4096, help='buffer size in scans')
+	parser.add_argument('-t', type=float, default=10, help='duration in seconds')
+	parser.add_argument('-o', help='write the decoded scans to this file')
+	args = parser.parse_args()
+
+	ctx = iio.Context(args.u)
+	dev = ctx.find_device(args.d)
+	if dev is None:
+		sys.exit('Device ' + args.d + ' not found')
+	if 'compression' not in dev.buffer_attrs:
+		sys.exit(args.d + ' has no compression, was it built with IIO_COMPRESSION=y?')
+
+	channels = [ch for ch in dev.channels if ch.scan_element and not ch.output]
+	if args.c:
+		channels = [ch for ch in channels if ch.id in args.c]
+	if not channels:
+		sys.exit('No input scan channel to enable')
+	for ch in channels:
+		ch.enabled = True
+
+	layout, scan_bytes = scan_layout(channels)
+	decoder = Decoder(layout, scan_bytes)
+	out = open(args.o, 'wb') if args.o else None
+
+	dev.buffer_attrs['compression'].value = 'delta'
+	buf = iio.Buffer(dev, args.b)
+	wire = 0
+	raw = 0
+
+	start = time.perf_counter()
+	try:
+		while time.perf_counter() - start < args.t:
+			buf.refill()
+			data = buf.read()
+			wire += len(data)
+			scans = decoder.feed(data)
+			raw += len(scans)
+			if out:
+				out.write(scans)
+	finally:
+		elapsed = time.perf_counter() - start
+		del buf
+		dev.buffer_attrs['compression'].value = 'none'
+		for ch in channels:
+			ch.enabled = False
+		if out:
+			out.close()
+
+	print('%s, %s, %d channels, %d bytes per scan' % (args.u, args.d,
+	      len(channels), scan_bytes))
+	print('%-16s %d bytes in %d frames, %d scans' % ('decoded', raw,
+	      decoder.frames, raw // scan_bytes))
+	print('%-16s %d bytes, ratio %.2f' % ('received', wire,
+	      raw / wire if wire else 0))
+	print('%-16s %.3f MB/s of raw data' % ('throughput', raw / elapsed / 1e6))
+
+if __name__ == '__main__':
+	main()
@@ -1,12 +1,69 @@
 SRCS += $(NO-OS)/iio/iio.c
 SRCS += $(NO-OS)/iio/iiod.c
+SRCS += $(NO-OS)/iio/iio_writer.c
 SRCS += $(NO-OS)/util/no_os_circular_buffer.c
+SRCS += $(DRIVERS)/api/no_os_ain.c
+SRCS += $(DRIVERS)/api/no_os_timer.c
+SRCS += $(NO-OS)/util/no_os_semaphore.c
+SRCS += $(NO-OS)/util/no_os_profile.c
+SRCS += $(NO-OS)/util/no_os_counter.c
+SRCS += $(NO-OS)/util/no_os_work.c
 
 INCS += $(NO-OS)/iio/iio.h
 INCS += $(NO-OS)/iio/iio_types.h
 INCS += $(NO-OS)/iio/iiod.h
 INCS += $(NO-OS)/iio/iiod_private.h
+INCS += $(NO-OS)/iio/iio_writer.h
 INCS += $(INCLUDE)/no_os_circular_buffer.h
+INCS += $(INCLUDE)/no_os_ain.h
+INCS += $(INCLUDE)/no_os_timer.h
+INCS += $(INCLUDE)/no_os_semaphore.h
+INCS += $(INCLUDE)/no_os_profile.h
+INCS += $(INCLUDE)/no_os_counter.h
+INCS += $(INCLUDE)/no_os_work.h
+
+ifeq (y,$(strip $(IIO_RTOS)))
+CFLAGS += -DIIO_RTOS
+SRCS += $(NO-OS)/iio/iio_rtos.c
+INCS += $(NO-OS)/iio/iio_rtos.h
+endif
+
+ifeq (y,$(strip $(IIO_COMPRESSION)))
+CFLAGS += -DIIO_COMPRESSION
+SRCS += $(NO-OS)/iio/iio_compress.c
+INCS += $(NO-OS)/iio/iio_compress.h
+endif
+
+ifeq (y,$(strip $(IIO_PRETRIGGER)))
+CFLAGS += -DIIO_PRETRIGGER
+endif
+
+# Don't keep the generated xml in memory, generate it while it is sent
+ifeq (y,$(strip $(IIO_XML_STREAM)))
+CFLAGS += -DIIO_XML_STREAM
+endif
+
+ifeq (y,$(strip $(IIO_SPECTRUM)))
+SRCS += $(NO-OS)/iio/iio_spectrum.c
+SRCS += $(NO-OS)/util/no_os_dsp.c
+INCS += $(NO-OS)/iio/iio_spectrum.h
+INCS += $(INCLUDE)/no_os_dsp.h
+endif
+
+ifeq (y,$(strip $(IIO_WAVEGEN)))
+SRCS += $(NO-OS)/iio/iio_wavegen.c
+SRCS += $(NO-OS)/util/no_os_wavegen.c
+SRCS += $(NO-OS)/util/no_os_sin_lut.c
+INCS += $(NO-OS)/iio/iio_wavegen.h
+INCS += $(INCLUDE)/no_os_wavegen.h
+endif
+
+ifeq (y,$(strip $(IIO_TRACK_CAL)))
+SRCS += $(NO-OS)/iio/iio_track_cal.c
+SRCS += $(NO-OS)/util/no_os_track_cal.c
+INCS += $(NO-OS)/iio/iio_track_cal.h
+INCS += $(INCLUDE)/no_os_track_cal.h
+endif
 
 ifeq (y,$(strip $(NETWORKING)))
 DISABLE_SECURE_SOCKET ?= y
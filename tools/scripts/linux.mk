@@ -8,9 +8,14 @@ PROJECT_BUILD = $(BUILD_DIR)/app
 CFLAGS +=  -g3 \
 		-DLINUX_PLATFORM \
 
+# linux_spi and the GPIO character device interrupts run worker threads
+LIB_FLAGS += -lpthread
+
 $(PLATFORM)_project:
 	$(call mk_dir, $(BUILD_DIR)) $(HIDE)
 
+$(PLATFORM)_post_build:
+
 $(PLATFORM)_sdkopen:
 	$(call mk_dir, $(PROJECT_BUILD)) $(HIDE)
 	$(call copy_dir, $(PLATFORM_TOOLS)/.vscode, $(PROJECT_BUILD)/.vscode) $(HIDE)
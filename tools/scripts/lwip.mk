@@ -2,6 +2,19 @@ LWIP_DIR := $(NO-OS)/libraries/lwip/lwip
 
 CFLAGS += -DLWIP_PROVIDE_ERRNO
 
+# Memory and TCP window profile of libraries/lwip/configs/lwipopts.h:
+# low_mem, balanced or max_throughput
+LWIP_PROFILE ?= balanced
+ifeq (low_mem,$(strip $(LWIP_PROFILE)))
+CFLAGS += -DNO_OS_LWIP_PROFILE=0
+else ifeq (balanced,$(strip $(LWIP_PROFILE)))
+CFLAGS += -DNO_OS_LWIP_PROFILE=1
+else ifeq (max_throughput,$(strip $(LWIP_PROFILE)))
+CFLAGS += -DNO_OS_LWIP_PROFILE=2
+else
+$(error LWIP_PROFILE must be low_mem, balanced or max_throughput)
+endif
+
 INCS += $(LWIP_DIR)/src/include/lwip
 INCS += $(LWIP_DIR)/src/include/compat
 INCS += $(LWIP_DIR)/src/include/netif
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# Decode the telemetry messages built by no_os_batch_poll(), one per file or
+# hex encoded line of a capture (e.g. the payloads saved by an IoT Hub route):
+#	python no_os_batch_decode.py msg0.bin msg1.bin
+#	python no_os_batch_decode.py -hex messages.txt
+#
+# Each sample is printed as its timestamp in ms followed by its values, or as
+# one JSON object per message with -json.
+
+import argparse
+import json
+import struct
+import sys
+
+VERSION = 1
+
+def varint(data, pos):
+	val = 0
+	shift = 0
+	while True:
+		b = data[pos]
+		pos += 1
+		val |= (b & 0x7F) << shift
+		if not b & 0x80:
+			return val, pos
+		shift += 7
+
+def zigzag(data, pos):
+	val, pos = varint(data, pos)
+	return (val >> 1) ^ -(val & 1), pos
+
+def s32(val):
+	val &= 0xFFFFFFFF
+	return val - (1 << 32) if val & 0x80000000 else val
+
+def decode(data):
+	if len(data) < 4 or data[0] != VERSION:
+		raise ValueError('not a version %d message' % VERSION)
+	nb_vals = data[1]
+	decim = data[2]
+	pos = 4
+	nb, pos = varint(data, pos)
+	dropped, pos = varint(data, pos)
+
+	samples = []
+	ts = 0
+	vals = [0] * nb_vals
+	for i in range(nb):
+		if i == 0:
+			ts, = struct.unpack_from('<I', data, pos)
+			pos += 4
+			for j in range(nb_vals):
+				vals[j], pos = zigzag(data, pos)
+		else:
+			delta, pos = varint(data, pos)
+			ts = (ts + delta) & 0xFFFFFFFF
+			for j in range(nb_vals):
+				delta, pos = zigzag(data, pos)
+				vals[j] = s32(vals[j] + delta)
+		samples.append([ts] + list(vals))
+
+	return {'decimation': decim, 'dropped': dropped, 'samples': samples}
+
+def messages(args):
+	for path in args.input:
+		if args.hex:
+			with open(path) as f:
+				for line in f:
+					line = line.strip()
+					if line:
+						yield bytes.fromhex(line)
+		else:
+			with open(path, 'rb') as f:
+				yield f.read()
+
+def main():
+	parser = argparse.ArgumentParser(description='Decode no-OS telemetry batches')
+	parser.add_argument('input', nargs='+', help='message files')
+	parser.add_argument('-hex', action='store_true',
+			    help='inputs hold one hex encoded message per line')
+	parser.add_argument('-json', action='store_true',
+			    help='print one JSON object per message')
+	args = parser.parse_args()
+
+	for data in messages(args):
+		try:
+			msg = decode(data)
+		except (ValueError, IndexError, struct.error) as e:
+			sys.stderr.write('bad message: %s\n' % e)
+			continue
+
+		if args.json:
+			print(json.dumps(msg))
+			continue
+
+		if msg['dropped']:
+			print('<%d samples dropped>' % msg['dropped'])
+		for sample in msg['samples']:
+			print(' '.join(str(v) for v in sample))
+
+if __name__ == '__main__':
+	main()
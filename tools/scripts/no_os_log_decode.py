@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+# Decode the records sent by no_os_log_drain() of a LOG_DEFERRED=y build.
+#
+# The formats are read from the .no_os_log_fmt section of the ELF file of the
+# build and the records from a capture file, a serial port or stdin:
+#	python no_os_log_decode.py build/app.elf capture.bin
+#	python no_os_log_decode.py build/app.elf /dev/ttyUSB0 -baud 115200
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+DROPPED_ID = 0xFFFFFFFF
+MAX_ARGS = 6
+
+# %[flags][width][.precision][length]specifier
+CONV = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|j|z|t|L)?([diouxXeEfFgGcspn%])')
+
+def read_formats(elf_path):
+	with open(elf_path, 'rb') as f:
+		elf = f.read()
+
+	if elf[:4] != b'\x7fELF':
+		sys.exit(elf_path + ' is not an ELF file')
+	is64 = elf[4] == 2
+	end = '<' if elf[5] == 1 else '>'
+
+	if is64:
+		shoff, = struct.unpack_from(end + 'Q', elf, 0x28)
+		shentsize, shnum, shstrndx = struct.unpack_from(end + 'HHH', elf, 0x3A)
+		sh_fmt = end + 'IIQQQQIIQQ'
+	else:
+		shoff, = struct.unpack_from(end + 'I', elf, 0x20)
+		shentsize, shnum, shstrndx = struct.unpack_from(end + 'HHH', elf, 0x2E)
+		sh_fmt = end + 'IIIIIIIIII'
+
+	sections = [struct.unpack_from(sh_fmt, elf, shoff + i * shentsize)
+		    for i in range(shnum)]
+	strtab = sections[shstrndx]
+	for sh in sections:
+		name_off = strtab[4] + sh[0]
+		name = elf[name_off:elf.index(b'\0', name_off)].decode()
+		if name == '.no_os_log_fmt':
+			return elf[sh[4]:sh[4] + sh[5]]
+
+	sys.exit('No .no_os_log_fmt section, was the build made with LOG_DEFERRED=y?')
+
+def get_format(formats, fmt_id):
+	if fmt_id >= len(formats):
+		return None
+	return formats[fmt_id:formats.index(b'\0', fmt_id)].decode(errors='replace')
+
+def format_record(fmt, args):
+	args = list(args)
+
+	def conv(m):
+		flags, length, spec = m.groups()
+		if spec == '%':
+			return '%'
+		if not args:
+			return m.group(0)
+		word = args.pop(0)
+		if spec in 'di':
+			word = struct.unpack('<i', struct.pack('<I', word))[0]
+		elif spec in 'eEfFgG':
+			word = struct.unpack('<f', struct.pack('<I', word))[0]
+		elif spec in 'sp':
+			# Strings are not copied by the target, only their address
+			return '0x%08x' % word
+		elif spec == 'n':
+			return ''
+		return ('%' + flags + spec) % word
+
+	return CONV.sub(conv, fmt)
+
+def records(stream):
+	while True:
+		b = stream.read(1)
+		if not b:
+			return
+		if b[0] != SYNC:
+			continue
+		hdr = stream.read(5)
+		if len(hdr) < 5:
+			return
+		nargs = hdr[0]
+		if nargs > MAX_ARGS:
+			continue
+		fmt_id, = struct.unpack('<I', hdr[1:])
+		payload = stream.read(4 * nargs)
+		if len(payload) < 4 * nargs:
+			return
+		yield fmt_id, struct.unpack('<%dI' % nargs, payload)
+
+def main():
+	parser = argparse.ArgumentParser(description='Decode no-OS deferred logs')
+	parser.add_argument('elf', help='ELF file of the build')
+	parser.add_argument('input', nargs='?', default='-',
+			    help='capture file or serial port, stdin by default')
+	parser.add_argument('-baud', type=int, default=115200,
+			    help='baud rate when input is a serial port')
+	args = parser.parse_args()
+
+	formats = read_formats(args.elf)
+
+	if args.input == '-':
+		stream = sys.stdin.buffer
+	elif args.input.startswith(('/dev/', 'COM')):
+		import serial
+		stream = serial.Serial(args.input, args.baud)
+	else:
+		stream = open(args.input, 'rb')
+
+	for fmt_id, words in records(stream):
+		if fmt_id == DROPPED_ID:
+			sys.stdout.write('<%d records dropped>\n' % words[0])
+			continue
+		fmt = get_format(formats, fmt_id)
+		if fmt is None:
+			sys.stdout.write('<unknown format 0x%08x>\n' % fmt_id)
+			continue
+		sys.stdout.write(format_record(fmt, words))
+		sys.stdout.flush()
+
+if __name__ == '__main__':
+	main()
@@ -53,9 +53,11 @@ PLATFORM_SRCS += $(PICO_SDK_PATH)/src/common/pico_util/pheap.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/common/pico_util/queue.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_claim/claim.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_clocks/clocks.c
+PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_dma/dma.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_gpio/gpio.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_i2c/i2c.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_irq/irq.c
+PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_pio/pio.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_pll/pll.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_spi/spi.c
 PLATFORM_SRCS += $(PICO_SDK_PATH)/src/rp2_common/hardware_sync/sync.c
@@ -101,9 +103,11 @@ PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_base/inc
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_claim/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_clocks/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_divider/include
+PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_dma/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_gpio/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_i2c/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_irq/include
+PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_pio/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_pll/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_resets/include
 PLATFORM_HARDWARE_INCS_PATH += $(PICO_SDK_PATH)/src/rp2_common/hardware_spi/include
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# Generate the piecewise linear tables of no_os_scale_lut for the non linear
+# temperature sensors, and print their worst case interpolation error:
+#	python pwl_table.py rtd -shift 9
+#	python pwl_table.py k-inv -shift 9
+#
+# The breakpoints are spaced by 2^shift input units: each step of -shift
+# halves the error for about twice the flash. The tables:
+#	rtd	IEC 60751 platinum RTD, R / R0 in Q13 to millidegree Celsius
+#	k	NIST ITS-90 type K thermocouple, 1/16 degree Celsius to uV
+#	k-inv	NIST ITS-90 type K thermocouple, uV to millidegree Celsius
+
+import argparse
+import math
+import sys
+
+# Callendar-Van Dusen coefficients of IEC 60751
+CVD_A = 3.9083e-3
+CVD_B = -5.775e-7
+CVD_C = -4.183e-12
+
+# NIST ITS-90 type K, E in mV from t in degree Celsius
+K_NEG = [0.0, 0.394501280250e-1, 0.236223735980e-4, -0.328589067840e-6,
+	 -0.499048287770e-8, -0.675090591730e-10, -0.574103274280e-12,
+	 -0.310888728940e-14, -0.104516093650e-16, -0.198892668780e-19,
+	 -0.163226974860e-22]
+K_POS = [-0.176004136860e-1, 0.389212049750e-1, 0.185587700320e-4,
+	 -0.994575928740e-7, 0.318409457190e-9, -0.560728448890e-12,
+	 0.560750590590e-15, -0.320207200030e-18, 0.971511471520e-22,
+	 -0.121047212750e-25]
+K_EXP = (0.1185976, -0.1183432e-3, 126.9686)
+
+def poly(coefs, x):
+	return sum(c * x ** i for i, c in enumerate(coefs))
+
+def rtd_ratio(t):
+	r = 1 + CVD_A * t + CVD_B * t * t
+	if t < 0:
+		r += CVD_C * (t - 100) * t ** 3
+	return r
+
+def k_mv(t):
+	if t < 0:
+		return poly(K_NEG, t)
+	a0, a1, a2 = K_EXP
+	return poly(K_POS, t) + a0 * math.exp(a1 * (t - a2) ** 2)
+
+def inverse(f, y, lo, hi):
+	"""Solve f(t) = y by bisection, f increasing on [lo, hi]."""
+	for _ in range(100):
+		mid = (lo + hi) / 2
+		if f(mid) < y:
+			lo = mid
+		else:
+			hi = mid
+	return (lo + hi) / 2
+
+# name: (conversion of an input unit, input range from -200 degree Celsius,
+#	output scale, description)
+TABLES = {
+	'rtd': (lambda x: inverse(rtd_ratio, x / 8192, -273, 1000),
+		(1517, 32000), 1000, 'R / R0 in Q13 to millidegree Celsius'),
+	'k': (lambda x: k_mv(x / 16) * 1000,
+	      (-880, 2000), 1, '1/16 degree Celsius to uV'),
+	'k-inv': (lambda x: inverse(k_mv, x / 1000, -270, 1500),
+		  (-5891, 54886), 1000, 'uV to millidegree Celsius'),
+}
+
+def interpolate(y, x0, shift, x):
+	idx = min(max((x - x0) >> shift, 0), len(y) - 2)
+	frac = x - x0 - (idx << shift)
+	return y[idx] + ((y[idx + 1] - y[idx]) * frac + (1 << (shift - 1))) / (1 << shift)
+
+def main():
+	parser = argparse.ArgumentParser(description='no-OS piecewise linear tables')
+	parser.add_argument('table', choices=sorted(TABLES))
+	parser.add_argument('-shift', type=int, default=9,
+			    help='log2 of the breakpoint spacing, in input units')
+	parser.add_argument('-name', help='name of the C array')
+	args = parser.parse_args()
+
+	f, (lo, hi), scale, desc = TABLES[args.table]
+	step = 1 << args.shift
+	x0 = lo - lo % step
+	nb = (hi - x0 + step - 1) // step + 1
+	y = [round(f(x0 + i * step) * scale) for i in range(nb)]
+
+	# Worst case error over the input range, in output units
+	err = 0
+	for x in range(lo, hi + 1, max(step // 64, 1)):
+		err = max(err, abs(interpolate(y, x0, args.shift, x) - f(x) * scale))
+
+	name = args.name or args.table.replace('-', '_') + '_lut'
+	print('/* %s, x0 = %d, shift = %d, %d points, max error %.1f */' %
+	      (desc, x0, args.shift, nb, err))
+	print('static const int32_t %s[%d] = {' % (name, nb))
+	for i in range(0, nb, 6):
+		print('\t' + ' '.join('%d,' % v for v in y[i:i + 6]))
+	print('};')
+
+if __name__ == '__main__':
+	main()
@@ -37,7 +37,223 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
 #include "no_os_alloc.h"
+#include "no_os_counter.h"
+
+/*
+ * Allocator backends, selected at build time:
+ *  - default: the libc malloc/calloc/free.
+ *  - NO_OS_ALLOC_POOL: fixed size blocks in size classes. The block sizes and
+ *    the number of blocks of each class are given by NO_OS_POOL_BLOCK_SIZES
+ *    and NO_OS_POOL_BLOCK_COUNTS. The memory for all the classes is taken
+ *    once from the heap, on the first allocation. Requests no class can serve
+ *    go to malloc when NO_OS_POOL_FALLBACK is set.
+ *  - NO_OS_ALLOC_ARENA: bump allocation from a static area of
+ *    NO_OS_ARENA_SIZE bytes, for applications that only allocate during
+ *    initialization. no_os_free does nothing for memory of the arena.
+ * The functions are not reentrant in pool and arena modes, same as most libc
+ * allocators they must not be called from interrupt context.
+ */
+#if defined(NO_OS_ALLOC_POOL) && defined(NO_OS_ALLOC_ARENA)
+#error "NO_OS_ALLOC_POOL and NO_OS_ALLOC_ARENA can't be used together"
+#endif
+
+/* Alignment of the returned blocks */
+#define NO_OS_ALLOC_ALIGN	8
+#define NO_OS_ALLOC_ROUND(x)	(((x) + NO_OS_ALLOC_ALIGN - 1) & \
+				 ~(size_t)(NO_OS_ALLOC_ALIGN - 1))
+
+static struct no_os_alloc_stats alloc_stats;
+
+#ifdef NO_OS_COUNTERS
+/* Peak of alloc_stats.in_use, only tracked in pool and arena modes */
+static NO_OS_COUNTER_DEFINE(heap_high_water);
+#endif
+
+#if defined(NO_OS_ALLOC_POOL)
+
+#ifndef NO_OS_POOL_BLOCK_SIZES
+#define NO_OS_POOL_BLOCK_SIZES	32, 64, 256, 1024
+#endif
+
+#ifndef NO_OS_POOL_BLOCK_COUNTS
+#define NO_OS_POOL_BLOCK_COUNTS	32, 16, 8, 4
+#endif
+
+#ifndef NO_OS_POOL_FALLBACK
+#define NO_OS_POOL_FALLBACK	1
+#endif
+
+static const uint32_t pool_sizes[] = {NO_OS_POOL_BLOCK_SIZES};
+static const uint32_t pool_counts[] = {NO_OS_POOL_BLOCK_COUNTS};
+
+#define NO_OS_POOL_NB_CLASSES	(sizeof(pool_sizes) / sizeof(pool_sizes[0]))
+
+_Static_assert(sizeof(pool_sizes) == sizeof(pool_counts),
+	       "NO_OS_POOL_BLOCK_SIZES and NO_OS_POOL_BLOCK_COUNTS differ");
+
+struct no_os_pool_class {
+	/* Memory of the class */
+	uint8_t *start;
+	uint8_t *end;
+	/* Size of a block, rounded to NO_OS_ALLOC_ALIGN */
+	uint32_t block_size;
+	/* Free blocks, linked through their first word */
+	void *free_list;
+	struct no_os_alloc_class_stats stats;
+};
+
+static struct no_os_pool_class pool_classes[NO_OS_POOL_NB_CLASSES];
+static uint8_t *pool_mem;
+
+/* Take the memory of the pool from the heap and build the free lists */
+static int no_os_pool_init(void)
+{
+	struct no_os_pool_class *c;
+	size_t total = 0;
+	uint8_t *p;
+	uint32_t i, j;
+
+	for (i = 0; i < NO_OS_POOL_NB_CLASSES; i++)
+		total += NO_OS_ALLOC_ROUND(pool_sizes[i]) * pool_counts[i];
+
+	pool_mem = malloc(total);
+	if (!pool_mem)
+		return -ENOMEM;
+
+	p = pool_mem;
+	for (i = 0; i < NO_OS_POOL_NB_CLASSES; i++) {
+		c = &pool_classes[i];
+		c->block_size = NO_OS_ALLOC_ROUND(pool_sizes[i]);
+		c->start = p;
+		c->free_list = NULL;
+		/* Link the blocks so that they are handed out in order */
+		for (j = pool_counts[i]; j > 0; j--) {
+			*(void **)(p + (j - 1) * c->block_size) = c->free_list;
+			c->free_list = p + (j - 1) * c->block_size;
+		}
+		p += c->block_size * pool_counts[i];
+		c->end = p;
+		c->stats.block_size = c->block_size;
+		c->stats.nb_blocks = pool_counts[i];
+	}
+
+	return 0;
+}
+
+static void *no_os_pool_alloc(size_t size)
+{
+	struct no_os_pool_class *c;
+	void *block;
+	uint32_t i;
+
+	if (!pool_mem && no_os_pool_init())
+		return NULL;
+
+	for (i = 0; i < NO_OS_POOL_NB_CLASSES; i++) {
+		c = &pool_classes[i];
+		if (c->block_size < size)
+			continue;
+
+		if (!c->free_list) {
+			/* Try the next class, but remember this one was short */
+			c->stats.nb_failures++;
+			continue;
+		}
+
+		block = c->free_list;
+		c->free_list = *(void **)block;
+		c->stats.in_use++;
+		if (c->stats.in_use > c->stats.high_water)
+			c->stats.high_water = c->stats.in_use;
+		alloc_stats.in_use += c->block_size;
+
+		return block;
+	}
+
+#if NO_OS_POOL_FALLBACK
+	block = malloc(size);
+	if (block)
+		alloc_stats.nb_fallbacks++;
+
+	return block;
+#else
+	return NULL;
+#endif
+}
+
+static void no_os_pool_free(void *ptr)
+{
+	struct no_os_pool_class *c;
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_POOL_NB_CLASSES; i++) {
+		c = &pool_classes[i];
+		if ((uint8_t *)ptr >= c->start && (uint8_t *)ptr < c->end) {
+			*(void **)ptr = c->free_list;
+			c->free_list = ptr;
+			c->stats.in_use--;
+			alloc_stats.in_use -= c->block_size;
+
+			return;
+		}
+	}
+
+	free(ptr);
+}
+
+#elif defined(NO_OS_ALLOC_ARENA)
+
+#ifndef NO_OS_ARENA_SIZE
+#define NO_OS_ARENA_SIZE	16384
+#endif
+
+static uint8_t arena_mem[NO_OS_ARENA_SIZE]
+__attribute__((aligned(NO_OS_ALLOC_ALIGN)));
+static size_t arena_used;
+
+static void *no_os_arena_alloc(size_t size)
+{
+	void *p;
+
+	size = NO_OS_ALLOC_ROUND(size);
+	if (size > NO_OS_ARENA_SIZE - arena_used)
+		return NULL;
+
+	p = arena_mem + arena_used;
+	arena_used += size;
+	alloc_stats.in_use = arena_used;
+
+	return p;
+}
+
+#endif
+
+/* Allocate from the selected backend and update the statistics */
+static void *no_os_alloc(size_t size)
+{
+	void *p;
+
+#if defined(NO_OS_ALLOC_POOL)
+	p = no_os_pool_alloc(size);
+#elif defined(NO_OS_ALLOC_ARENA)
+	p = no_os_arena_alloc(size);
+#else
+	p = malloc(size);
+#endif
+	alloc_stats.nb_allocs++;
+	if (!p)
+		alloc_stats.nb_failures++;
+	else if (alloc_stats.in_use > alloc_stats.high_water) {
+		alloc_stats.high_water = alloc_stats.in_use;
+		NO_OS_COUNTER_MAX(heap_high_water, alloc_stats.high_water);
+	}
+
+	return p;
+}
 
 /**
  * @brief Allocate memory and return a pointer to it.
@@ -46,7 +262,7 @@
  */
 __attribute__((weak)) void *no_os_malloc(size_t size)
 {
-	return malloc(size);
+	return no_os_alloc(size);
 }
 
 /**
@@ -57,7 +273,16 @@ __attribute__((weak)) void *no_os_malloc(size_t size)
  */
 __attribute__((weak)) void *no_os_calloc(size_t nitems, size_t size)
 {
-	return calloc(nitems, size);
+	void *p;
+
+	if (size && nitems > SIZE_MAX / size)
+		return NULL;
+
+	p = no_os_alloc(nitems * size);
+	if (p)
+		memset(p, 0, nitems * size);
+
+	return p;
 }
 
 /**
@@ -69,5 +294,61 @@ __attribute__((weak)) void *no_os_calloc(size_t nitems, size_t size)
  */
 __attribute__((weak)) void no_os_free(void *ptr)
 {
+	if (!ptr)
+		return;
+
+#if defined(NO_OS_ALLOC_POOL)
+	no_os_pool_free(ptr);
+#elif defined(NO_OS_ALLOC_ARENA)
+	if ((uint8_t *)ptr >= arena_mem &&
+	    (uint8_t *)ptr < arena_mem + NO_OS_ARENA_SIZE)
+		return;
+	free(ptr);
+#else
 	free(ptr);
+#endif
+}
+
+/**
+ * @brief Get the statistics of the allocator.
+ * @param stats - Where to store the statistics. in_use and high_water are
+ * 		  only tracked by the pool and arena backends.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int no_os_alloc_get_stats(struct no_os_alloc_stats *stats)
+{
+	if (!stats)
+		return -EINVAL;
+
+	*stats = alloc_stats;
+
+	return 0;
+}
+
+/**
+ * @brief Get the statistics of a size class of the pool allocator.
+ * @param idx - Index of the class, in the order of NO_OS_POOL_BLOCK_SIZES.
+ * @param stats - Where to store the statistics.
+ * @return 0 in case of success, -ENOENT if there is no such class.
+ */
+int no_os_alloc_get_class_stats(uint32_t idx,
+				struct no_os_alloc_class_stats *stats)
+{
+	if (!stats)
+		return -EINVAL;
+
+#if defined(NO_OS_ALLOC_POOL)
+	if (idx >= NO_OS_POOL_NB_CLASSES)
+		return -ENOENT;
+
+	*stats = pool_classes[idx].stats;
+	if (!stats->nb_blocks) {
+		stats->block_size = NO_OS_ALLOC_ROUND(pool_sizes[idx]);
+		stats->nb_blocks = pool_counts[idx];
+	}
+
+	return 0;
+#else
+	return -ENOENT;
+#endif
 }
@@ -0,0 +1,281 @@
+/***************************************************************************//**
+ *   @file   no_os_batch.c
+ *   @brief  Batched, delta encoded telemetry uplink.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_batch.h"
+#include "no_os_alloc.h"
+
+/* Worst case length of a 32 bit varint */
+#define NO_OS_BATCH_VARINT_MAX	5
+#define NO_OS_BATCH_HDR_MAX	(4 + 2 * NO_OS_BATCH_VARINT_MAX + 4)
+
+/**
+ * @brief Write an unsigned LEB128 varint.
+ * @param p - Where to write.
+ * @param val - The value.
+ * @return The number of bytes written.
+ */
+static uint32_t no_os_batch_varint(uint8_t *p, uint32_t val)
+{
+	uint32_t n = 0;
+
+	while (val >= 0x80) {
+		p[n++] = (val & 0x7F) | 0x80;
+		val >>= 7;
+	}
+	p[n++] = val;
+
+	return n;
+}
+
+/**
+ * @brief Write a zigzag encoded signed varint.
+ * @param p - Where to write.
+ * @param val - The value.
+ * @return The number of bytes written.
+ */
+static uint32_t no_os_batch_zigzag(uint8_t *p, int32_t val)
+{
+	return no_os_batch_varint(p, ((uint32_t)val << 1) ^ (uint32_t)(val >> 31));
+}
+
+/**
+ * @brief Allocate a telemetry batch.
+ * @param batch - The batch descriptor.
+ * @param param - The batch parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_batch_init(struct no_os_batch **batch,
+		     const struct no_os_batch_init_param *param)
+{
+	struct no_os_batch *b;
+	uint32_t max_samples;
+	int ret;
+
+	if (!batch || !param || !param->publish || !param->nb_vals ||
+	    param->nb_vals > NO_OS_BATCH_MAX_VALS || param->max_samples > param->depth)
+		return -EINVAL;
+
+	max_samples = param->max_samples ? param->max_samples : param->depth;
+
+	b = no_os_calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	ret = no_os_lfring_init(&b->ring, (param->nb_vals + 1) * sizeof(int32_t),
+				param->depth, false);
+	if (ret)
+		goto free_batch;
+
+	b->payload = no_os_calloc(NO_OS_BATCH_HDR_MAX + max_samples *
+				  (param->nb_vals + 1) * NO_OS_BATCH_VARINT_MAX, 1);
+	if (!b->payload) {
+		ret = -ENOMEM;
+		goto free_ring;
+	}
+
+	b->nb_vals = param->nb_vals;
+	b->depth = param->depth;
+	b->max_samples = max_samples;
+	b->period_ms = param->period_ms;
+	b->policy = param->policy;
+	b->publish = param->publish;
+	b->ctx = param->ctx;
+	b->decim = 1;
+
+	*batch = b;
+
+	return 0;
+
+free_ring:
+	no_os_lfring_remove(b->ring);
+free_batch:
+	no_os_free(b);
+
+	return ret;
+}
+
+/**
+ * @brief Queue a sample. With NO_OS_BATCH_DOWNSAMPLE only one sample out of
+ * the current downsampling factor is kept.
+ * @param batch - The batch descriptor.
+ * @param ts_ms - Timestamp of the sample in ms.
+ * @param vals - The nb_vals values of the sample.
+ * @return 0 if the sample was queued or skipped by the downsampling, -ENOSPC
+ * 	   if it was dropped, negative error code otherwise.
+ */
+int no_os_batch_add(struct no_os_batch *batch, uint32_t ts_ms,
+		    const int32_t *vals)
+{
+	int32_t sample[NO_OS_BATCH_MAX_VALS + 1];
+	uint32_t count;
+
+	if (!batch || !vals)
+		return -EINVAL;
+
+	if (batch->skip) {
+		batch->skip--;
+		return 0;
+	}
+
+	count = no_os_lfring_count(batch->ring);
+	if (batch->policy == NO_OS_BATCH_DOWNSAMPLE &&
+	    count >= batch->depth - batch->depth / 4 &&
+	    batch->decim < NO_OS_BATCH_MAX_DECIM)
+		batch->decim *= 2;
+
+	sample[0] = ts_ms;
+	memcpy(&sample[1], vals, batch->nb_vals * sizeof(*vals));
+	batch->skip = batch->decim - 1;
+
+	if (!no_os_lfring_push(batch->ring, sample, 1)) {
+		batch->dropped++;
+		return -ENOSPC;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Encode the next message from the queued samples.
+ * @param batch - The batch descriptor.
+ * @return The length of the message.
+ */
+static uint32_t no_os_batch_encode(struct no_os_batch *batch)
+{
+	int32_t sample[NO_OS_BATCH_MAX_VALS + 1];
+	int32_t prev[NO_OS_BATCH_MAX_VALS + 1];
+	uint8_t *p = batch->payload;
+	uint32_t nb, i, j, len;
+
+	nb = no_os_lfring_count(batch->ring);
+	if (nb > batch->max_samples)
+		nb = batch->max_samples;
+
+	p[0] = NO_OS_BATCH_VERSION;
+	p[1] = batch->nb_vals;
+	p[2] = batch->decim;
+	p[3] = 0;
+	len = 4;
+	len += no_os_batch_varint(&p[len], nb);
+	len += no_os_batch_varint(&p[len], batch->dropped);
+	batch->dropped = 0;
+
+	for (i = 0; i < nb; i++) {
+		no_os_lfring_pop(batch->ring, sample, 1);
+
+		if (!i) {
+			p[len++] = sample[0];
+			p[len++] = (uint32_t)sample[0] >> 8;
+			p[len++] = (uint32_t)sample[0] >> 16;
+			p[len++] = (uint32_t)sample[0] >> 24;
+			for (j = 1; j <= batch->nb_vals; j++)
+				len += no_os_batch_zigzag(&p[len], sample[j]);
+		} else {
+			len += no_os_batch_varint(&p[len],
+						  (uint32_t)sample[0] - (uint32_t)prev[0]);
+			for (j = 1; j <= batch->nb_vals; j++)
+				len += no_os_batch_zigzag(&p[len],
+							  (uint32_t)sample[j] - (uint32_t)prev[j]);
+		}
+
+		memcpy(prev, sample, (batch->nb_vals + 1) * sizeof(*sample));
+	}
+
+	return len;
+}
+
+/**
+ * @brief Send a message if max_samples samples are queued, period_ms passed
+ * since the last one or the previous message could not be sent. A message
+ * that fails is kept and the samples queue up behind it, which is what
+ * triggers the backpressure policy on a slow link.
+ * @param batch - The batch descriptor.
+ * @param now_ms - Current time in ms.
+ * @return 0 if nothing was due or the message was sent, the error of publish
+ * 	   otherwise.
+ */
+int no_os_batch_poll(struct no_os_batch *batch, uint32_t now_ms)
+{
+	uint32_t count;
+	int ret;
+
+	if (!batch)
+		return -EINVAL;
+
+	if (!batch->pending) {
+		count = no_os_lfring_count(batch->ring);
+		if (!count)
+			return 0;
+		if (count < batch->max_samples &&
+		    now_ms - batch->last_ms < batch->period_ms)
+			return 0;
+
+		batch->pending = no_os_batch_encode(batch);
+	}
+
+	ret = batch->publish(batch->ctx, batch->payload, batch->pending);
+	if (ret < 0) {
+		batch->errors++;
+		return ret;
+	}
+
+	batch->pending = 0;
+	batch->last_ms = now_ms;
+	batch->sent++;
+
+	if (batch->decim > 1 &&
+	    no_os_lfring_count(batch->ring) < batch->depth / 4)
+		batch->decim /= 2;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_batch_init().
+ * @param batch - The batch descriptor.
+ */
+void no_os_batch_remove(struct no_os_batch *batch)
+{
+	if (!batch)
+		return;
+
+	no_os_lfring_remove(batch->ring);
+	no_os_free(batch->payload);
+	no_os_free(batch);
+}
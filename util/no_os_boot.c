@@ -0,0 +1,258 @@
+/***************************************************************************//**
+ *   @file   no_os_boot.c
+ *   @brief  Dependency ordered project initialization with per stage timing.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stddef.h>
+#include "no_os_boot.h"
+#include "no_os_error.h"
+#include "no_os_profile.h"
+
+/**
+ * @brief Time since no_os_boot_run() in cycles. The 32-bit counter is extended
+ * at each call, so no single stage may run longer than one counter period.
+ * @param boot - The boot.
+ * @return The time, 0 without NO_OS_PROFILING.
+ */
+static uint64_t no_os_boot_now(struct no_os_boot *boot)
+{
+#ifdef NO_OS_PROFILING
+	uint32_t cycles = no_os_get_cycles();
+
+	boot->total += cycles - boot->last;
+	boot->last = cycles;
+#endif
+	return boot->total;
+}
+
+/**
+ * @brief Record the end of a stage.
+ * @param boot - The boot.
+ * @param stage - The stage.
+ * @param status - Its result.
+ */
+static void no_os_boot_done(struct no_os_boot *boot,
+			    struct no_os_boot_stage *stage, int status)
+{
+	stage->status = status;
+	stage->end = no_os_boot_now(boot);
+}
+
+/**
+ * @brief Check that every stage only depends on stages listed before it, which
+ * also rules out cycles.
+ * @param boot - The boot.
+ * @return 0 if the graph is valid, -EINVAL otherwise.
+ */
+static int no_os_boot_check(struct no_os_boot *boot)
+{
+	uint32_t i;
+
+	if (!boot->stages || !boot->nb_stages ||
+	    boot->nb_stages > NO_OS_BOOT_MAX_STAGES)
+		return -EINVAL;
+
+	for (i = 0; i < boot->nb_stages; i++) {
+		if (!boot->stages[i].start)
+			return -EINVAL;
+		if (boot->stages[i].deps & ~(NO_OS_BIT(i) - 1))
+			return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Run the stages of a boot. Every stage whose dependencies are done is
+ * started, in the order of the list, and the stages running in the background
+ * are polled in between. The stages returning -EINPROGRESS therefore overlap
+ * with the others, e.g. a clock chip programmed by async SPI on one bus while
+ * a firmware is loaded on another. After a failure no other stage is started,
+ * the running ones are polled to their end.
+ * @param boot - The boot.
+ * @return 0 if every stage succeeded, the first error otherwise.
+ */
+int no_os_boot_run(struct no_os_boot *boot)
+{
+	struct no_os_boot_stage *stage;
+	uint32_t all, done, running;
+	uint32_t i;
+	int ret = 0;
+	int status;
+
+	if (!boot)
+		return -EINVAL;
+
+	status = no_os_boot_check(boot);
+	if (status)
+		return status;
+
+	all = (uint32_t)(((uint64_t)1 << boot->nb_stages) - 1);
+	done = 0;
+	running = 0;
+	boot->total = 0;
+#ifdef NO_OS_PROFILING
+	boot->last = no_os_get_cycles();
+#endif
+	for (i = 0; i < boot->nb_stages; i++) {
+		boot->stages[i].status = -ECANCELED;
+		boot->stages[i].begin = 0;
+		boot->stages[i].end = 0;
+	}
+
+	while (done != all) {
+		for (i = 0; i < boot->nb_stages; i++) {
+			if (!(running & NO_OS_BIT(i)))
+				continue;
+
+			stage = &boot->stages[i];
+			status = stage->poll(stage->ctx);
+			if (status == -EINPROGRESS)
+				continue;
+
+			no_os_boot_done(boot, stage, status);
+			running &= ~NO_OS_BIT(i);
+			done |= NO_OS_BIT(i);
+			if (status && !ret)
+				ret = status;
+		}
+
+		if (ret) {
+			if (!running)
+				break;
+			continue;
+		}
+
+		for (i = 0; i < boot->nb_stages; i++) {
+			stage = &boot->stages[i];
+			if ((done | running) & NO_OS_BIT(i) ||
+			    (stage->deps & done) != stage->deps)
+				continue;
+
+			stage->begin = no_os_boot_now(boot);
+			status = stage->start(stage->ctx);
+			if (status == -EINPROGRESS && stage->poll) {
+				running |= NO_OS_BIT(i);
+				continue;
+			}
+
+			no_os_boot_done(boot, stage, status);
+			done |= NO_OS_BIT(i);
+			if (status) {
+				ret = status;
+				break;
+			}
+		}
+	}
+
+	no_os_boot_now(boot);
+
+	return ret;
+}
+
+/**
+ * @brief Convert cycles to microseconds.
+ * @param cycles - Number of cycles.
+ * @return The time, 0 without NO_OS_PROFILING.
+ */
+static uint64_t no_os_boot_us(uint64_t cycles)
+{
+#ifdef NO_OS_PROFILING
+	uint32_t freq = no_os_get_cycles_freq();
+	uint32_t rem;
+	uint64_t sec;
+
+	if (!freq)
+		return 0;
+
+	sec = no_os_div_u64_rem(cycles, freq, &rem);
+
+	return sec * 1000000 + no_os_div_u64((uint64_t)rem * 1000000, freq);
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief Print the timeline of the last no_os_boot_run(), one line per stage:
+ * name, start and duration in microseconds and result. The last line gives
+ * the total and the sum of the stage durations, the difference being the time
+ * saved by the overlapping stages.
+ * @param boot - The boot.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Number of characters written, negative error code otherwise.
+ */
+int no_os_boot_show(struct no_os_boot *boot, char *buf, uint32_t len)
+{
+	struct no_os_boot_stage *stage;
+	uint64_t serial = 0;
+	uint32_t pos = 0;
+	uint32_t i;
+	int ret;
+
+	if (!boot || !buf || !len)
+		return -EINVAL;
+
+	buf[0] = '\0';
+	for (i = 0; i < boot->nb_stages; i++) {
+		stage = &boot->stages[i];
+		serial += stage->end - stage->begin;
+		ret = snprintf(buf + pos, len - pos, "%s %llu %llu %d\n",
+			       stage->name,
+			       (unsigned long long)no_os_boot_us(stage->begin),
+			       (unsigned long long)no_os_boot_us(stage->end -
+					       stage->begin),
+			       stage->status);
+		if (ret < 0)
+			return ret;
+		if ((uint32_t)ret >= len - pos)
+			return -ENOBUFS;
+
+		pos += ret;
+	}
+
+	ret = snprintf(buf + pos, len - pos, "total %llu %llu\n",
+		       (unsigned long long)no_os_boot_us(boot->total),
+		       (unsigned long long)no_os_boot_us(serial));
+	if (ret < 0)
+		return ret;
+	if ((uint32_t)ret >= len - pos)
+		return -ENOBUFS;
+
+	return pos + ret;
+}
@@ -0,0 +1,316 @@
+/***************************************************************************//**
+ *   @file   no_os_bus_trace.c
+ *   @brief  SPI and I2C transfer tracer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "no_os_bus_trace.h"
+#include "no_os_mutex.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+
+#define NO_OS_BUS_TRACE_MAGIC		"NOBT"
+#define NO_OS_BUS_TRACE_VERSION		1
+#define NO_OS_BUS_TRACE_HDR_SIZE	20
+
+static struct no_os_bus_trace_rec trace_ring[NO_OS_BUS_TRACE_SIZE];
+/* Transfers recorded since no_os_bus_trace_start() */
+static uint32_t trace_total;
+/* Stop after this many transfers, 0 for never */
+static uint32_t trace_limit;
+static volatile bool trace_running;
+/* End of the previous transfer of each bus, valid if trace_seen is set */
+static uint32_t trace_last_end[NO_OS_BUS_TRACE_NB_TYPES][NO_OS_BUS_TRACE_MAX_BUS];
+static bool trace_seen[NO_OS_BUS_TRACE_NB_TYPES][NO_OS_BUS_TRACE_MAX_BUS];
+/* Next transfer printed by no_os_bus_trace_show() */
+static uint32_t trace_cursor;
+static bool trace_hdr_shown;
+
+static const char * const trace_type_names[] = {
+	[NO_OS_BUS_TRACE_SPI] = "spi",
+	[NO_OS_BUS_TRACE_I2C] = "i2c",
+};
+
+/**
+ * @brief Clear the capture and record the next transfers.
+ * @param count - Stop by itself after this many transfers. 0 records until
+ * 		  no_os_bus_trace_stop(), keeping the last NO_OS_BUS_TRACE_SIZE
+ * 		  transfers.
+ * @return None.
+ */
+void no_os_bus_trace_start(uint32_t count)
+{
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	trace_total = 0;
+	trace_limit = count;
+	trace_cursor = 0;
+	trace_hdr_shown = false;
+	memset(trace_seen, 0, sizeof(trace_seen));
+	trace_running = true;
+
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Stop recording, the capture is kept until the next start.
+ * @return None.
+ */
+void no_os_bus_trace_stop(void)
+{
+	trace_running = false;
+}
+
+/**
+ * @brief Whether transfers are being recorded.
+ * @return true until no_os_bus_trace_stop() or the end of a counted capture.
+ */
+bool no_os_bus_trace_running(void)
+{
+	return trace_running;
+}
+
+/**
+ * @brief Add a transfer to the capture. Does nothing unless the tracer is
+ * running. Safe to call from interrupt context.
+ * @param type - Bus type.
+ * @param bus - Bus number.
+ * @param dev - Chip select for SPI, slave address for I2C.
+ * @param len - Number of bytes transferred.
+ * @param start - no_os_get_cycles() at the start of the transfer.
+ * @param ret - Value returned by the transfer.
+ * @return None.
+ */
+void no_os_bus_trace_record(enum no_os_bus_trace_type type, uint32_t bus,
+			    uint32_t dev, uint32_t len, uint32_t start,
+			    int32_t ret)
+{
+	struct no_os_bus_trace_rec *rec;
+	uint32_t state;
+	uint32_t now;
+
+	if (!trace_running || type >= NO_OS_BUS_TRACE_NB_TYPES)
+		return;
+
+	now = no_os_get_cycles();
+
+	state = no_os_critical_enter();
+
+	if (!trace_running)
+		goto out;
+
+	rec = &trace_ring[trace_total % NO_OS_BUS_TRACE_SIZE];
+	rec->start = start;
+	rec->duration = now - start;
+	rec->gap = 0;
+	rec->len = no_os_min(len, UINT16_MAX);
+	rec->type = type;
+	rec->bus = bus;
+	rec->dev = dev;
+	rec->err = ret < 0;
+
+	if (bus < NO_OS_BUS_TRACE_MAX_BUS) {
+		if (trace_seen[type][bus])
+			rec->gap = start - trace_last_end[type][bus];
+		trace_last_end[type][bus] = now;
+		trace_seen[type][bus] = true;
+	}
+
+	trace_total++;
+	if (trace_limit && trace_total >= trace_limit)
+		trace_running = false;
+out:
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Get the number of transfers in the capture.
+ * @return The number of transfers, at most NO_OS_BUS_TRACE_SIZE.
+ */
+uint32_t no_os_bus_trace_count(void)
+{
+	return no_os_min(trace_total, (uint32_t)NO_OS_BUS_TRACE_SIZE);
+}
+
+/**
+ * @brief Get a transfer of the capture.
+ * @param idx - Index of the transfer, 0 being the oldest one.
+ * @param rec - Where to copy the transfer.
+ * @return 0 in case of success, -ENOENT if idx is out of the capture.
+ */
+int no_os_bus_trace_get(uint32_t idx, struct no_os_bus_trace_rec *rec)
+{
+	uint32_t state;
+	uint32_t first;
+	int ret = 0;
+
+	if (!rec)
+		return -EINVAL;
+
+	state = no_os_critical_enter();
+
+	if (idx >= no_os_bus_trace_count()) {
+		ret = -ENOENT;
+	} else {
+		first = trace_total - no_os_bus_trace_count();
+		*rec = trace_ring[(first + idx) % NO_OS_BUS_TRACE_SIZE];
+	}
+
+	no_os_critical_exit(state);
+
+	return ret;
+}
+
+/**
+ * @brief Restart no_os_bus_trace_show() from the oldest transfer.
+ * @return None.
+ */
+void no_os_bus_trace_rewind(void)
+{
+	trace_cursor = 0;
+	trace_hdr_shown = false;
+}
+
+/**
+ * @brief Print the capture as text, as many transfers as fit in buf. Each
+ * call continues after the last transfer printed by the previous one, an
+ * empty output marks the end. The first call after a start or a rewind
+ * begins with the line "# freq <Hz> total <n> count <n>", then each transfer
+ * is a line: type bus dev len start duration gap err.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Number of characters written, negative error code otherwise.
+ */
+int no_os_bus_trace_show(char *buf, uint32_t len)
+{
+	struct no_os_bus_trace_rec rec;
+	uint32_t pos = 0;
+	int ret;
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	buf[0] = '\0';
+	if (!trace_hdr_shown) {
+		ret = snprintf(buf, len, "# freq %lu total %lu count %lu\n",
+			       (unsigned long)no_os_get_cycles_freq(),
+			       (unsigned long)trace_total,
+			       (unsigned long)no_os_bus_trace_count());
+		if (ret < 0)
+			return ret;
+		if ((uint32_t)ret >= len)
+			return -ENOBUFS;
+
+		pos = ret;
+		trace_hdr_shown = true;
+	}
+
+	while (!no_os_bus_trace_get(trace_cursor, &rec)) {
+		ret = snprintf(buf + pos, len - pos,
+			       "%s %u %u %u %lu %lu %lu %u\n",
+			       trace_type_names[rec.type], rec.bus, rec.dev,
+			       rec.len, (unsigned long)rec.start,
+			       (unsigned long)rec.duration,
+			       (unsigned long)rec.gap, rec.err);
+		if (ret < 0)
+			return ret;
+		if ((uint32_t)ret >= len - pos) {
+			buf[pos] = '\0';
+			break;
+		}
+
+		pos += ret;
+		trace_cursor++;
+	}
+
+	return pos;
+}
+
+/**
+ * @brief Pack the capture for tools/scripts/bus_trace.py. The header is the
+ * "NOBT" magic, the format version (1 byte), the record size (1 byte),
+ * 2 reserved bytes, the frequency of the cycle counter, the number of
+ * transfers recorded since the start and the number of records that follow
+ * (uint32 each). A record is type, bus, dev, err (1 byte each), len (uint16),
+ * start, duration and gap (uint32 each). All values are little endian.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Number of bytes written, negative error code otherwise.
+ */
+int no_os_bus_trace_dump(uint8_t *buf, uint32_t len)
+{
+	struct no_os_bus_trace_rec rec;
+	uint32_t count;
+	uint32_t pos;
+	uint32_t i;
+
+	if (!buf)
+		return -EINVAL;
+
+	count = no_os_bus_trace_count();
+	if (len < NO_OS_BUS_TRACE_HDR_SIZE + count * NO_OS_BUS_TRACE_REC_SIZE)
+		return -ENOBUFS;
+
+	memcpy(buf, NO_OS_BUS_TRACE_MAGIC, 4);
+	buf[4] = NO_OS_BUS_TRACE_VERSION;
+	buf[5] = NO_OS_BUS_TRACE_REC_SIZE;
+	buf[6] = 0;
+	buf[7] = 0;
+	no_os_put_unaligned_le32(no_os_get_cycles_freq(), buf + 8);
+	no_os_put_unaligned_le32(trace_total, buf + 12);
+	no_os_put_unaligned_le32(count, buf + 16);
+	pos = NO_OS_BUS_TRACE_HDR_SIZE;
+
+	for (i = 0; i < count; i++) {
+		if (no_os_bus_trace_get(i, &rec))
+			break;
+
+		buf[pos] = rec.type;
+		buf[pos + 1] = rec.bus;
+		buf[pos + 2] = rec.dev;
+		buf[pos + 3] = rec.err;
+		no_os_put_unaligned_le16(rec.len, buf + pos + 4);
+		no_os_put_unaligned_le32(rec.start, buf + pos + 6);
+		no_os_put_unaligned_le32(rec.duration, buf + pos + 10);
+		no_os_put_unaligned_le32(rec.gap, buf + pos + 14);
+		pos += NO_OS_BUS_TRACE_REC_SIZE;
+	}
+
+	return pos;
+}
@@ -49,11 +49,28 @@
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_section.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/* Mask used on power of two sizes, 0 if the fast path can't be used */
+static inline uint32_t no_os_cb_get_mask(uint32_t size)
+{
+	return (size > 1 && !(size & (size - 1))) ? size - 1 : 0;
+}
+
+/*
+ * Free running position of a pointer. Only valid when desc->mask is set: the
+ * size divides 2^32 so the position wraps together with spin_count.
+ */
+static inline uint32_t no_os_cb_pos(struct no_os_circular_buffer *desc,
+				    struct no_os_cb_ptr *ptr)
+{
+	return ptr->spin_count * desc->size + ptr->idx;
+}
+
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 		     uint32_t size)
 {
@@ -63,6 +80,7 @@ int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 	memset(desc, 0, sizeof(*desc));
 	desc->size = size;
 	desc->buff = buff;
+	desc->mask = no_os_cb_get_mask(size);
 
 	return 0;
 }
@@ -96,6 +114,7 @@ int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t buff_size)
 	*desc = ldesc;
 
 	ldesc->size = buff_size;
+	ldesc->mask = no_os_cb_get_mask(buff_size);
 	ldesc->buff = no_os_calloc(1, buff_size);
 	if (!ldesc->buff) {
 		no_os_free(ldesc);
@@ -140,6 +159,17 @@ int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size)
 	if (!desc || !size)
 		return -EINVAL;
 
+	if (desc->mask) {
+		*size = no_os_cb_pos(desc, &desc->write) -
+			no_os_cb_pos(desc, &desc->read);
+		if (*size > desc->size) {
+			*size = desc->size;
+			return -NO_OS_EOVERRUN;
+		}
+
+		return 0;
+	}
+
 	if (desc->write.spin_count > desc->read.spin_count)
 		nb_spins = desc->write.spin_count - desc->read.spin_count;
 	else
@@ -164,6 +194,7 @@ int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size)
  * Functionality described at no_os_cb_prepare_async_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
  */
+NO_OS_RAMFUNC
 static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 		*desc,
 		uint32_t requested_size,
@@ -222,6 +253,7 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
  * Functionality described at no_os_cb_end_async_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
  */
+NO_OS_RAMFUNC
 static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 		bool is_read)
 {
@@ -243,7 +275,10 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	new_val = ptr->idx + ptr->async_size;
 	if (new_val >= desc->size) {
 		ptr->spin_count++;
-		new_val %= desc->size;
+		if (desc->mask)
+			new_val &= desc->mask;
+		else
+			new_val %= desc->size;
 	}
 	ptr->idx = new_val;
 	ptr->async_size = 0;
@@ -252,10 +287,66 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	return 0;
 }
 
+/*
+ * no_os_cb_operation for power of two sizes without an async transaction
+ * started. The data is copied in at most two parts and the pointer is updated
+ * once, without going through the async functions.
+ */
+NO_OS_RAMFUNC
+static int32_t no_os_cb_masked_operation(struct no_os_circular_buffer *desc,
+		void *data, uint32_t size,
+		bool is_read)
+{
+	struct no_os_cb_ptr	*ptr;
+	uint32_t	available_size;
+	uint32_t	pos, first;
+	int32_t		ret = 0;
+
+	ptr = is_read ? &desc->read : &desc->write;
+	pos = no_os_cb_pos(desc, ptr);
+
+	if (is_read) {
+		available_size = no_os_cb_pos(desc, &desc->write) - pos;
+		if (available_size > desc->size) {
+			/* Same recovery as no_os_cb_prepare_async_read */
+			desc->read.spin_count = desc->write.spin_count - 1;
+#ifndef IIO_IGNORE_BUFF_OVERRUN_ERR
+			desc->read.idx = desc->write.idx;
+#endif
+			pos = no_os_cb_pos(desc, ptr);
+			available_size = no_os_cb_pos(desc, &desc->write) - pos;
+			ret = -NO_OS_EOVERRUN;
+		}
+		if (!available_size)
+			return -1;
+		if (available_size < size) {
+			size = available_size;
+			ret = -1;
+		}
+	}
+
+	first = no_os_min(size, desc->size - ptr->idx);
+	if (is_read) {
+		memcpy(data, desc->buff + ptr->idx, first);
+		memcpy((uint8_t *)data + first, desc->buff, size - first);
+	} else {
+		memcpy(desc->buff + ptr->idx, data, first);
+		memcpy(desc->buff, (uint8_t *)data + first, size - first);
+	}
+
+	pos = ptr->idx + size;
+	if (pos >= desc->size)
+		ptr->spin_count++;
+	ptr->idx = pos & desc->mask;
+
+	return ret;
+}
+
 /*
  * Functionality described at cb_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
  */
+NO_OS_RAMFUNC
 static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
 				  void *data, uint32_t size,
 				  bool is_read)
@@ -269,6 +360,10 @@ static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
 	if (!desc || !data || !size)
 		return -EINVAL;
 
+	if (desc->mask && size <= desc->size &&
+	    !(is_read ? desc->read.async_started : desc->write.async_started))
+		return no_os_cb_masked_operation(desc, data, size, is_read);
+
 	sticky_overrun = 0;
 	i = 0;
 	while (i < size) {
@@ -372,6 +467,29 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
 }
 /** @} */
 
+/**
+ * @brief End an asynchronous write of which only the first size bytes were
+ * written, e.g. when the data is received directly in the buffer.
+ *
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes written, at most raw_size_avilable returned
+ * by no_os_cb_prepare_async_write()
+ * @return
+ *  - 0   - No errors
+ *  - -1   - Asynchronous transaction not started
+ *  - -EINVAL        - Wrong parameters used
+ */
+int32_t no_os_cb_end_async_write_size(struct no_os_circular_buffer *desc,
+				      uint32_t size)
+{
+	if (!desc || size > desc->write.async_size)
+		return -EINVAL;
+
+	desc->write.async_size = size;
+
+	return no_os_cb_end_async_operation(desc, 0);
+}
+
 /**
  * @brief Write data to the buffer (Blocking).
  * @param desc - Circular buffer reference
@@ -381,6 +499,7 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
  *  - 0 - No errors
  *  - -EINVAL      - Wrong parameters used
  */
+NO_OS_RAMFUNC
 int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
 		       uint32_t size)
 {
@@ -397,6 +516,7 @@ int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
  *  - -EINVAL   - Wrong parameters used
  *  - -NO_OS_EOVERRUN - An overrun occurred and some data have been overwritten
  */
+NO_OS_RAMFUNC
 int32_t no_os_cb_read(struct no_os_circular_buffer *desc, void *data,
 		      uint32_t size)
 {
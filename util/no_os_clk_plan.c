@@ -0,0 +1,254 @@
+/***************************************************************************//**
+ *   @file   no_os_clk_plan.c
+ *   @brief  Clock tree planner built on the no_os_clk API.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_clk_plan.h"
+
+/**
+ * @brief Initialize a clock tree planner.
+ *
+ * The rate of every output is read back when the clock supports it, so the
+ * first applied plan already skips the outputs that are correctly set.
+ * @param desc - Planner descriptor.
+ * @param param - Planner parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_clk_plan_init(struct no_os_clk_plan_desc **desc,
+			const struct no_os_clk_plan_init_param *param)
+{
+	struct no_os_clk_plan_desc *plan;
+	uint32_t i;
+
+	if (!desc || !param || !param->clks || !param->nb_clks)
+		return -EINVAL;
+
+	for (i = 0; i < param->nb_clks; i++)
+		if (!param->clks[i])
+			return -EINVAL;
+
+	plan = no_os_calloc(1, sizeof(*plan));
+	if (!plan)
+		return -ENOMEM;
+
+	plan->applied = no_os_calloc(param->nb_clks, sizeof(*plan->applied));
+	plan->requested = no_os_calloc(NO_OS_CLK_PLAN_CACHE_SIZE * param->nb_clks,
+				       sizeof(*plan->requested));
+	plan->solved = no_os_calloc(NO_OS_CLK_PLAN_CACHE_SIZE * param->nb_clks,
+				    sizeof(*plan->solved));
+	if (!plan->applied || !plan->requested || !plan->solved) {
+		no_os_clk_plan_remove(plan);
+		return -ENOMEM;
+	}
+
+	plan->clks = param->clks;
+	plan->nb_clks = param->nb_clks;
+
+	for (i = 0; i < plan->nb_clks; i++)
+		if (no_os_clk_recalc_rate(plan->clks[i], &plan->applied[i]))
+			plan->applied[i] = 0;
+
+	*desc = plan;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_clk_plan_init().
+ * @param desc - Planner descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_clk_plan_remove(struct no_os_clk_plan_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->solved);
+	no_os_free(desc->requested);
+	no_os_free(desc->applied);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Solve the dividers for a set of output rates.
+ *
+ * Every output rate is rounded by its clock driver once and the result is
+ * kept in a small cache, so switching back and forth between known
+ * configurations (e.g. JESD lane rates) does not solve them again.
+ * @param desc - Planner descriptor.
+ * @param rates - Requested rate of each output, 0 to leave it untouched.
+ * @param plan_id - Identifier of the solved plan.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_clk_plan_solve(struct no_os_clk_plan_desc *desc,
+			 const uint64_t *rates, uint32_t *plan_id)
+{
+	uint64_t *requested, *solved;
+	size_t size;
+	uint32_t i, slot;
+	int ret;
+
+	if (!desc || !rates || !plan_id)
+		return -EINVAL;
+
+	size = desc->nb_clks * sizeof(*rates);
+
+	for (slot = 0; slot < NO_OS_CLK_PLAN_CACHE_SIZE; slot++) {
+		if (desc->valid[slot] &&
+		    !memcmp(&desc->requested[slot * desc->nb_clks], rates, size)) {
+			*plan_id = slot;
+			return 0;
+		}
+	}
+
+	slot = desc->next;
+	requested = &desc->requested[slot * desc->nb_clks];
+	solved = &desc->solved[slot * desc->nb_clks];
+	desc->valid[slot] = false;
+
+	for (i = 0; i < desc->nb_clks; i++) {
+		solved[i] = 0;
+		if (!rates[i])
+			continue;
+
+		ret = no_os_clk_round_rate(desc->clks[i], rates[i], &solved[i]);
+		if (ret)
+			return ret;
+	}
+
+	memcpy(requested, rates, size);
+	desc->valid[slot] = true;
+	desc->next = (slot + 1) % NO_OS_CLK_PLAN_CACHE_SIZE;
+	*plan_id = slot;
+
+	return 0;
+}
+
+/**
+ * @brief Get the rate a solved plan produces on one output.
+ * @param desc - Planner descriptor.
+ * @param plan_id - Identifier returned by no_os_clk_plan_solve().
+ * @param idx - Output index.
+ * @param rate - Rounded output rate, 0 if the output is left untouched.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_clk_plan_get_rate(struct no_os_clk_plan_desc *desc,
+			    uint32_t plan_id, uint32_t idx, uint64_t *rate)
+{
+	if (!desc || !rate || plan_id >= NO_OS_CLK_PLAN_CACHE_SIZE ||
+	    idx >= desc->nb_clks || !desc->valid[plan_id])
+		return -EINVAL;
+
+	*rate = desc->solved[plan_id * desc->nb_clks + idx];
+
+	return 0;
+}
+
+/**
+ * @brief Program a solved plan.
+ *
+ * Only the outputs whose rate differs from the one currently programmed
+ * are written. The drivers themselves only touch the divider registers
+ * that change, so the remaining outputs keep running undisturbed.
+ * @param desc - Planner descriptor.
+ * @param plan_id - Identifier returned by no_os_clk_plan_solve().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_clk_plan_apply(struct no_os_clk_plan_desc *desc, uint32_t plan_id)
+{
+	uint64_t *solved;
+	uint32_t i;
+	int ret;
+
+	if (!desc || plan_id >= NO_OS_CLK_PLAN_CACHE_SIZE ||
+	    !desc->valid[plan_id])
+		return -EINVAL;
+
+	solved = &desc->solved[plan_id * desc->nb_clks];
+
+	for (i = 0; i < desc->nb_clks; i++) {
+		if (!solved[i] || solved[i] == desc->applied[i])
+			continue;
+
+		desc->applied[i] = 0;
+		ret = no_os_clk_set_rate(desc->clks[i], solved[i]);
+		if (ret)
+			return ret;
+
+		desc->applied[i] = solved[i];
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Solve and apply a set of output rates.
+ * @param desc - Planner descriptor.
+ * @param rates - Requested rate of each output, 0 to leave it untouched.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_clk_plan_set(struct no_os_clk_plan_desc *desc,
+		       const uint64_t *rates)
+{
+	uint32_t plan_id;
+	int ret;
+
+	ret = no_os_clk_plan_solve(desc, rates, &plan_id);
+	if (ret)
+		return ret;
+
+	return no_os_clk_plan_apply(desc, plan_id);
+}
+
+/**
+ * @brief Forget the programmed rates.
+ *
+ * Must be called after the clock chip was reset or reprogrammed outside
+ * the planner, so the next apply writes every output again.
+ * @param desc - Planner descriptor.
+ */
+void no_os_clk_plan_invalidate(struct no_os_clk_plan_desc *desc)
+{
+	if (!desc)
+		return;
+
+	memset(desc->applied, 0, desc->nb_clks * sizeof(*desc->applied));
+}
@@ -0,0 +1,227 @@
+/***************************************************************************//**
+ *   @file   no_os_counter.c
+ *   @brief  Runtime performance counters.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "no_os_counter.h"
+#include "no_os_mutex.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+
+static struct no_os_counter *counter_list;
+
+/* Add a counter to the list, called in a critical section */
+static void no_os_counter_list(struct no_os_counter *cnt)
+{
+	if (cnt->listed)
+		return;
+
+	cnt->listed = true;
+	cnt->next = counter_list;
+	counter_list = cnt;
+}
+
+/**
+ * @brief Add n to a counter. The counter is registered on its first use.
+ * Safe to call from interrupt context.
+ * @param cnt - The counter.
+ * @param n - Value to add.
+ * @return None.
+ */
+void no_os_counter_add(struct no_os_counter *cnt, uint32_t n)
+{
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	no_os_counter_list(cnt);
+	cnt->value += n;
+
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Raise a counter to v if it is lower, for high-water marks. Safe to
+ * call from interrupt context.
+ * @param cnt - The counter.
+ * @param v - New sample.
+ * @return None.
+ */
+void no_os_counter_max(struct no_os_counter *cnt, uint64_t v)
+{
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	no_os_counter_list(cnt);
+	if (v > cnt->value)
+		cnt->value = v;
+
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Take a counter out of the list, must be called before the memory
+ * of a counter that was used is freed.
+ * @param cnt - The counter.
+ * @return None.
+ */
+void no_os_counter_remove(struct no_os_counter *cnt)
+{
+	struct no_os_counter **p;
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	for (p = &counter_list; *p; p = &(*p)->next) {
+		if (*p == cnt) {
+			*p = cnt->next;
+			break;
+		}
+	}
+	cnt->listed = false;
+	cnt->next = NULL;
+
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Clear all the counters.
+ * @return None.
+ */
+void no_os_counter_reset(void)
+{
+	struct no_os_counter *cnt;
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	for (cnt = counter_list; cnt; cnt = cnt->next)
+		cnt->value = 0;
+
+	no_os_critical_exit(state);
+}
+
+/* Read a counter consistently, the 64 bit value may be updated by an IRQ */
+static uint64_t no_os_counter_read(struct no_os_counter *cnt)
+{
+	uint32_t state;
+	uint64_t value;
+
+	state = no_os_critical_enter();
+	value = cnt->value;
+	no_os_critical_exit(state);
+
+	return value;
+}
+
+/**
+ * @brief Print every counter, one line per counter: the name, followed by
+ * ".index" for counters of an instance, and the value.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Number of characters written, negative error code otherwise.
+ */
+int no_os_counter_show(char *buf, uint32_t len)
+{
+	struct no_os_counter *cnt;
+	uint32_t pos = 0;
+	uint64_t value;
+	int ret;
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	buf[0] = '\0';
+	for (cnt = counter_list; cnt; cnt = cnt->next) {
+		value = no_os_counter_read(cnt);
+		if (cnt->index < 0)
+			ret = snprintf(buf + pos, len - pos, "%s %llu\n",
+				       cnt->name, (unsigned long long)value);
+		else
+			ret = snprintf(buf + pos, len - pos, "%s.%ld %llu\n",
+				       cnt->name, (long)cnt->index,
+				       (unsigned long long)value);
+		if (ret < 0)
+			return ret;
+		if ((uint32_t)ret >= len - pos)
+			return -ENOBUFS;
+
+		pos += ret;
+	}
+
+	return pos;
+}
+
+/**
+ * @brief Pack every counter for a host tool, without any formatting on the
+ * target. Each record is the name length (1 byte), the name without its
+ * terminator, the index (int16, -1 if none) and the value (uint64), all in
+ * little endian.
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Number of bytes written, negative error code otherwise.
+ */
+int no_os_counter_dump(uint8_t *buf, uint32_t len)
+{
+	struct no_os_counter *cnt;
+	uint32_t pos = 0;
+	uint32_t name_len;
+	uint64_t value;
+
+	if (!buf)
+		return -EINVAL;
+
+	for (cnt = counter_list; cnt; cnt = cnt->next) {
+		name_len = no_os_min(strlen(cnt->name), UINT8_MAX);
+		if (len - pos < 1 + name_len + 2 + 8)
+			return -ENOBUFS;
+
+		value = no_os_counter_read(cnt);
+		buf[pos++] = name_len;
+		memcpy(buf + pos, cnt->name, name_len);
+		pos += name_len;
+		no_os_put_unaligned_le16((uint16_t)cnt->index, buf + pos);
+		pos += 2;
+		no_os_put_unaligned_le32((uint32_t)value, buf + pos);
+		no_os_put_unaligned_le32((uint32_t)(value >> 32), buf + pos + 4);
+		pos += 8;
+	}
+
+	return pos;
+}
@@ -0,0 +1,239 @@
+/***************************************************************************//**
+ *   @file   no_os_crc.c
+ *   @brief  Source file of the generic CRC engine.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_crc.h"
+#include "no_os_alloc.h"
+
+/**
+ * @struct no_os_crc_sw_desc
+ * @brief Slice-by-8 tables of the software CRC engine.
+ */
+struct no_os_crc_sw_desc {
+	union {
+		uint8_t crc8[NO_OS_CRC8_SLICES][NO_OS_CRC8_TABLE_SIZE];
+		uint16_t crc16[NO_OS_CRC16_SLICES][NO_OS_CRC16_TABLE_SIZE];
+		uint32_t crc24[NO_OS_CRC24_SLICES][NO_OS_CRC24_TABLE_SIZE];
+		uint32_t crc32[NO_OS_CRC32_SLICES][NO_OS_CRC32_TABLE_SIZE];
+	} table;
+};
+
+/**
+ * @brief Initialize the software CRC engine.
+ * @param desc - The CRC descriptor.
+ * @param param - The structure that contains the CRC parameters.
+ * @return 0 in case of success, -ENOTSUP if the CRC is not supported,
+ * 	   negative error code otherwise.
+ */
+static int no_os_crc_sw_init(struct no_os_crc_desc **desc,
+			     const struct no_os_crc_init_param *param)
+{
+	struct no_os_crc_sw_desc *sw;
+	struct no_os_crc_desc *descriptor;
+
+	/* Only msb-first CRC-8/16/24 and lsb-first CRC-32 have tables. */
+	if (param->reflected != (param->width == 32))
+		return -ENOTSUP;
+
+	if (param->width != 8 && param->width != 16 && param->width != 24 &&
+	    param->width != 32)
+		return -ENOTSUP;
+
+	descriptor = (struct no_os_crc_desc *)no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	sw = (struct no_os_crc_sw_desc *)no_os_calloc(1, sizeof(*sw));
+	if (!sw) {
+		no_os_free(descriptor);
+		return -ENOMEM;
+	}
+
+	switch (param->width) {
+	case 8:
+		no_os_crc8_populate_slice_msb(sw->table.crc8, param->polynomial);
+		break;
+	case 16:
+		no_os_crc16_populate_slice_msb(sw->table.crc16, param->polynomial);
+		break;
+	case 24:
+		no_os_crc24_populate_slice_msb(sw->table.crc24,
+					       param->polynomial & 0xffffff);
+		break;
+	default:
+		no_os_crc32_populate_slice_lsb(sw->table.crc32, param->polynomial);
+		break;
+	}
+
+	descriptor->extra = sw;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Compute the CRC in software.
+ * @param desc - The CRC descriptor.
+ * @param data - Data buffer.
+ * @param len - Number of bytes in the data buffer.
+ * @param crc - Initial CRC value.
+ * @param result - Computed CRC value.
+ * @return 0 in case of success.
+ */
+static int no_os_crc_sw_compute(struct no_os_crc_desc *desc,
+				const uint8_t *data, size_t len, uint32_t crc,
+				uint32_t *result)
+{
+	struct no_os_crc_sw_desc *sw = desc->extra;
+
+	switch (desc->width) {
+	case 8:
+		*result = no_os_crc8_slice(sw->table.crc8, data, len, crc);
+		break;
+	case 16:
+		*result = no_os_crc16_slice(sw->table.crc16, data, len, crc);
+		break;
+	case 24:
+		*result = no_os_crc24_slice(sw->table.crc24, data, len, crc);
+		break;
+	default:
+		*result = no_os_crc32_slice(sw->table.crc32, data, len, crc);
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_crc_sw_init().
+ * @param desc - The CRC descriptor.
+ * @return 0 in case of success.
+ */
+static int no_os_crc_sw_remove(struct no_os_crc_desc *desc)
+{
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Software slice-by-8 CRC platform ops.
+ */
+const struct no_os_crc_platform_ops no_os_crc_sw_ops = {
+	.init = &no_os_crc_sw_init,
+	.compute = &no_os_crc_sw_compute,
+	.remove = &no_os_crc_sw_remove
+};
+
+/**
+ * @brief Initialize a CRC engine.
+ *
+ * The platform ops from the init param are tried first, a hardware unit that
+ * reports -ENOTSUP for the requested width or polynomial falls back to the
+ * software slice-by-8 implementation.
+ *
+ * @param desc - The CRC descriptor.
+ * @param param - The structure that contains the CRC parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_crc_init(struct no_os_crc_desc **desc,
+		   const struct no_os_crc_init_param *param)
+{
+	const struct no_os_crc_platform_ops *ops;
+	int ret = -ENOTSUP;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	if (param->platform_ops && param->platform_ops->init) {
+		ops = param->platform_ops;
+		ret = ops->init(desc, param);
+	}
+
+	if (ret == -ENOTSUP) {
+		ops = &no_os_crc_sw_ops;
+		ret = ops->init(desc, param);
+	}
+
+	if (ret)
+		return ret;
+
+	(*desc)->width = param->width;
+	(*desc)->polynomial = param->polynomial;
+	(*desc)->reflected = param->reflected;
+	(*desc)->platform_ops = ops;
+
+	return 0;
+}
+
+/**
+ * @brief Compute the CRC over a buffer.
+ * @param desc - The CRC descriptor.
+ * @param data - Data buffer.
+ * @param len - Number of bytes in the data buffer.
+ * @param crc - Initial CRC value, or a previous result to cascade calls.
+ * @param result - Computed CRC value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_crc_compute(struct no_os_crc_desc *desc, const uint8_t *data,
+		      size_t len, uint32_t crc, uint32_t *result)
+{
+	if (!desc || !desc->platform_ops || (!data && len) || !result)
+		return -EINVAL;
+
+	if (!desc->platform_ops->compute)
+		return -ENOSYS;
+
+	return desc->platform_ops->compute(desc, data, len, crc, result);
+}
+
+/**
+ * @brief Free the resources allocated by no_os_crc_init().
+ * @param desc - The CRC descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_crc_remove(struct no_os_crc_desc *desc)
+{
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	if (!desc->platform_ops->remove)
+		return -ENOSYS;
+
+	return desc->platform_ops->remove(desc);
+}
@@ -37,6 +37,40 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include "no_os_crc16.h"
+#include "no_os_crc_table.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_section.h"
+
+/* Tables for the polynomials used by the drivers, generated at compile time. */
+static const uint16_t no_os_crc16_msb_1021[NO_OS_CRC16_TABLE_SIZE] = {
+	NO_OS_CRC16_MSB_TABLE(0x1021)
+};
+
+static const uint16_t no_os_crc16_msb_755b[NO_OS_CRC16_TABLE_SIZE] = {
+	NO_OS_CRC16_MSB_TABLE(0x755B)
+};
+
+/**
+ * @struct no_os_crc16_table_entry
+ * @brief CRC-16 lookup table shared by all the users of a polynomial.
+ */
+struct no_os_crc16_table_entry {
+	/** Polynomial the table was created for */
+	uint16_t polynomial;
+	/** Lookup table */
+	const uint16_t *table;
+	/** Next table populated at runtime */
+	struct no_os_crc16_table_entry *next;
+};
+
+static const struct no_os_crc16_table_entry no_os_crc16_builtin[] = {
+	{ 0x1021, no_os_crc16_msb_1021 },
+	{ 0x755B, no_os_crc16_msb_755b },
+};
+
+/* Tables of the other polynomials, populated on first use. */
+static struct no_os_crc16_table_entry *no_os_crc16_registry;
 
 /***************************************************************************//**
  * @brief Creates the CRC-16 lookup table for a given polynomial.
@@ -87,6 +121,7 @@ void no_os_crc16_populate_msb(uint16_t * table, const uint16_t polynomial)
  *
  * @return crc      - Computed CRC-16 value.
 *******************************************************************************/
+NO_OS_RAMFUNC
 uint16_t no_os_crc16(const uint16_t * table, const uint8_t *pdata,
 		     size_t nbytes,
 		     uint16_t crc)
@@ -101,3 +136,99 @@ uint16_t no_os_crc16(const uint16_t * table, const uint8_t *pdata,
 
 	return crc;
 }
+
+/***************************************************************************//**
+ * @brief Creates the slice-by-8 CRC-16 lookup tables for a given polynomial.
+ *
+ * @param table      - Lookup tables to write to. table[0] is the regular
+ *                     CRC-16 table, table[k] holds the CRC of each byte value
+ *                     followed by k zero bytes.
+ * @param polynomial - Msb-first representation of desired polynomial.
+ *
+ * @return None.
+*******************************************************************************/
+void no_os_crc16_populate_slice_msb(uint16_t table[][NO_OS_CRC16_TABLE_SIZE],
+				    const uint16_t polynomial)
+{
+	uint16_t prev;
+
+	if (!table)
+		return;
+
+	no_os_crc16_populate_msb(table[0], polynomial);
+
+	for (int16_t n = 0; n < NO_OS_CRC16_TABLE_SIZE; n++) {
+		for (uint8_t k = 1; k < NO_OS_CRC16_SLICES; k++) {
+			prev = table[k - 1][n];
+			table[k][n] = (prev << 8) ^ table[0][prev >> 8];
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-16 over a buffer of data, 8 bytes per iteration.
+ *
+ * @param table     - Slice tables created with no_os_crc16_populate_slice_msb().
+ * @param pdata     - Pointer to 8-bit data buffer.
+ * @param nbytes    - Number of bytes to compute the CRC-16 over.
+ * @param crc       - Initial value for the CRC-16 computation.
+ *
+ * @return crc      - Computed CRC-16 value, same as no_os_crc16() would return.
+*******************************************************************************/
+NO_OS_RAMFUNC
+uint16_t no_os_crc16_slice(const uint16_t table[][NO_OS_CRC16_TABLE_SIZE],
+			   const uint8_t *pdata, size_t nbytes, uint16_t crc)
+{
+	while (nbytes >= NO_OS_CRC16_SLICES) {
+		crc = table[7][pdata[0] ^ (crc >> 8)] ^
+		      table[6][pdata[1] ^ (crc & 0xff)] ^
+		      table[5][pdata[2]] ^ table[4][pdata[3]] ^
+		      table[3][pdata[4]] ^ table[2][pdata[5]] ^
+		      table[1][pdata[6]] ^ table[0][pdata[7]];
+		pdata += NO_OS_CRC16_SLICES;
+		nbytes -= NO_OS_CRC16_SLICES;
+	}
+
+	return no_os_crc16(table[0], pdata, nbytes, crc);
+}
+
+/***************************************************************************//**
+ * @brief Get the shared CRC-16 lookup table of a polynomial.
+ *
+ * Tables of the common polynomials are constant and generated at compile
+ * time, any other polynomial gets a table populated on first use and then
+ * shared by all the later callers. The function is meant to be called from
+ * driver initialization, it is not reentrant.
+ *
+ * @param polynomial - msb-first representation of desired polynomial.
+ *
+ * @return Pointer to the lookup table, NULL if it could not be allocated.
+*******************************************************************************/
+const uint16_t *no_os_crc16_get_table(const uint16_t polynomial)
+{
+	struct no_os_crc16_table_entry *entry;
+	uint16_t *table;
+
+	for (uint32_t i = 0; i < NO_OS_ARRAY_SIZE(no_os_crc16_builtin); i++)
+		if (no_os_crc16_builtin[i].polynomial == polynomial)
+			return no_os_crc16_builtin[i].table;
+
+	for (entry = no_os_crc16_registry; entry; entry = entry->next)
+		if (entry->polynomial == polynomial)
+			return entry->table;
+
+	entry = no_os_calloc(1, sizeof(*entry) +
+			     NO_OS_CRC16_TABLE_SIZE * sizeof(uint16_t));
+	if (!entry)
+		return NULL;
+
+	table = (uint16_t *)(entry + 1);
+	no_os_crc16_populate_msb(table, polynomial);
+
+	entry->polynomial = polynomial;
+	entry->table = table;
+	entry->next = no_os_crc16_registry;
+	no_os_crc16_registry = entry;
+
+	return table;
+}
@@ -37,6 +37,35 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include "no_os_crc24.h"
+#include "no_os_crc_table.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_section.h"
+
+/* Tables for the polynomials used by the drivers, generated at compile time. */
+static const uint32_t no_os_crc24_msb_5d6dcb[NO_OS_CRC24_TABLE_SIZE] = {
+	NO_OS_CRC24_MSB_TABLE(0x5D6DCB)
+};
+
+/**
+ * @struct no_os_crc24_table_entry
+ * @brief CRC-24 lookup table shared by all the users of a polynomial.
+ */
+struct no_os_crc24_table_entry {
+	/** Polynomial the table was created for */
+	uint32_t polynomial;
+	/** Lookup table */
+	const uint32_t *table;
+	/** Next table populated at runtime */
+	struct no_os_crc24_table_entry *next;
+};
+
+static const struct no_os_crc24_table_entry no_os_crc24_builtin[] = {
+	{ 0x5D6DCB, no_os_crc24_msb_5d6dcb },
+};
+
+/* Tables of the other polynomials, populated on first use. */
+static struct no_os_crc24_table_entry *no_os_crc24_registry;
 
 /***************************************************************************//**
  * @brief Creates the CRC-24 lookup table for a given polynomial.
@@ -88,6 +117,7 @@ void no_os_crc24_populate_msb(uint32_t * table, const uint32_t polynomial)
  *
  * @return crc      - Computed CRC-24 value.
 *******************************************************************************/
+NO_OS_RAMFUNC
 uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 		     size_t nbytes,
 		     uint32_t crc)
@@ -102,3 +132,101 @@ uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 
 	return (crc & 0xffffff);
 }
+
+/***************************************************************************//**
+ * @brief Creates the slice-by-8 CRC-24 lookup tables for a given polynomial.
+ *
+ * @param table      - Lookup tables to write to. table[0] is the regular
+ *                     CRC-24 table, table[k] holds the CRC of each byte value
+ *                     followed by k zero bytes.
+ * @param polynomial - Msb-first representation of desired polynomial.
+ *
+ * @return None.
+*******************************************************************************/
+void no_os_crc24_populate_slice_msb(uint32_t table[][NO_OS_CRC24_TABLE_SIZE],
+				    const uint32_t polynomial)
+{
+	uint32_t prev;
+
+	if (!table)
+		return;
+
+	no_os_crc24_populate_msb(table[0], polynomial);
+
+	for (int16_t n = 0; n < NO_OS_CRC24_TABLE_SIZE; n++) {
+		for (uint8_t k = 1; k < NO_OS_CRC24_SLICES; k++) {
+			prev = table[k - 1][n];
+			table[k][n] = ((prev << 8) ^
+				       table[0][(prev >> 16) & 0xff]) & 0xffffff;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-24 over a buffer of data, 8 bytes per iteration.
+ *
+ * @param table     - Slice tables created with no_os_crc24_populate_slice_msb().
+ * @param pdata     - Pointer to 8-bit data buffer.
+ * @param nbytes    - Number of bytes to compute the CRC-24 over.
+ * @param crc       - Initial value for the CRC-24 computation.
+ *
+ * @return crc      - Computed CRC-24 value, same as no_os_crc24() would return.
+*******************************************************************************/
+NO_OS_RAMFUNC
+uint32_t no_os_crc24_slice(const uint32_t table[][NO_OS_CRC24_TABLE_SIZE],
+			   const uint8_t *pdata, size_t nbytes, uint32_t crc)
+{
+	while (nbytes >= NO_OS_CRC24_SLICES) {
+		crc = table[7][pdata[0] ^ ((crc >> 16) & 0xff)] ^
+		      table[6][pdata[1] ^ ((crc >> 8) & 0xff)] ^
+		      table[5][pdata[2] ^ (crc & 0xff)] ^
+		      table[4][pdata[3]] ^ table[3][pdata[4]] ^
+		      table[2][pdata[5]] ^ table[1][pdata[6]] ^
+		      table[0][pdata[7]];
+		pdata += NO_OS_CRC24_SLICES;
+		nbytes -= NO_OS_CRC24_SLICES;
+	}
+
+	return no_os_crc24(table[0], pdata, nbytes, crc);
+}
+
+/***************************************************************************//**
+ * @brief Get the shared CRC-24 lookup table of a polynomial.
+ *
+ * Tables of the common polynomials are constant and generated at compile
+ * time, any other polynomial gets a table populated on first use and then
+ * shared by all the later callers. The function is meant to be called from
+ * driver initialization, it is not reentrant.
+ *
+ * @param polynomial - msb-first representation of desired polynomial.
+ *
+ * @return Pointer to the lookup table, NULL if it could not be allocated.
+*******************************************************************************/
+const uint32_t *no_os_crc24_get_table(const uint32_t polynomial)
+{
+	struct no_os_crc24_table_entry *entry;
+	uint32_t *table;
+
+	for (uint32_t i = 0; i < NO_OS_ARRAY_SIZE(no_os_crc24_builtin); i++)
+		if (no_os_crc24_builtin[i].polynomial == polynomial)
+			return no_os_crc24_builtin[i].table;
+
+	for (entry = no_os_crc24_registry; entry; entry = entry->next)
+		if (entry->polynomial == polynomial)
+			return entry->table;
+
+	entry = no_os_calloc(1, sizeof(*entry) +
+			     NO_OS_CRC24_TABLE_SIZE * sizeof(uint32_t));
+	if (!entry)
+		return NULL;
+
+	table = (uint32_t *)(entry + 1);
+	no_os_crc24_populate_msb(table, polynomial);
+
+	entry->polynomial = polynomial;
+	entry->table = table;
+	entry->next = no_os_crc24_registry;
+	no_os_crc24_registry = entry;
+
+	return table;
+}
@@ -0,0 +1,233 @@
+/***************************************************************************//**
+ *   @file   no_os_crc32.c
+ *   @brief  Source file of CRC-32 computation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include "no_os_crc32.h"
+#include "no_os_crc_table.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_section.h"
+
+/* Tables for the polynomials used by the drivers, generated at compile time. */
+static const uint32_t no_os_crc32_lsb_edb88320[NO_OS_CRC32_TABLE_SIZE] = {
+	NO_OS_CRC32_LSB_TABLE(0xEDB88320)
+};
+
+/**
+ * @struct no_os_crc32_table_entry
+ * @brief CRC-32 lookup table shared by all the users of a polynomial.
+ */
+struct no_os_crc32_table_entry {
+	/** Polynomial the table was created for */
+	uint32_t polynomial;
+	/** Lookup table */
+	const uint32_t *table;
+	/** Next table populated at runtime */
+	struct no_os_crc32_table_entry *next;
+};
+
+static const struct no_os_crc32_table_entry no_os_crc32_builtin[] = {
+	{ 0xEDB88320, no_os_crc32_lsb_edb88320 },
+};
+
+/* Tables of the other polynomials, populated on first use. */
+static struct no_os_crc32_table_entry *no_os_crc32_registry;
+
+/***************************************************************************//**
+ * @brief Creates the CRC-32 lookup table for a given polynomial.
+ *
+ * @param table      - Pointer to a CRC-32 lookup table to write to.
+ * @param polynomial - lsb-first (reflected) representation of desired
+ *                     polynomial.
+ *
+ * Polynomials in CRC algorithms are typically represented as shown below.
+ *
+ *    poly = x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 +
+ *           x^7 + x^5 + x^4 + x^2 + x^1 + 1
+ *
+ * Using lsb-first direction, x^0 maps to the msb.
+ *
+ *    lsb first: poly = 0xEDB88320 (IEEE 802.3)
+ *
+ * @return None.
+*******************************************************************************/
+void no_os_crc32_populate_lsb(uint32_t * table, const uint32_t polynomial)
+{
+	if (!table)
+		return;
+
+	for (int16_t n = 0; n < NO_OS_CRC32_TABLE_SIZE; n++) {
+		uint32_t currByte = (uint32_t)n;
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			if ((currByte & 0x1) != 0) {
+				currByte >>= 1;
+				currByte ^= polynomial;
+			} else {
+				currByte >>= 1;
+			}
+		}
+		table[n] = currByte;
+	}
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-32 over a buffer of data.
+ *
+ * @param table     - Pointer to a CRC-32 lookup table for the desired polynomial.
+ * @param pdata     - Pointer to 8-bit data buffer.
+ * @param nbytes    - Number of bytes to compute the CRC-32 over.
+ * @param crc       - Initial value for the CRC-32 computation. Can be used to
+ *                    cascade calls to this function by providing a previous
+ *                    output of this function as the crc parameter.
+ *
+ * The final xor (0xFFFFFFFF for IEEE 802.3) is left to the caller so that
+ * calls can be cascaded.
+ *
+ * @return crc      - Computed CRC-32 value.
+*******************************************************************************/
+NO_OS_RAMFUNC
+uint32_t no_os_crc32(const uint32_t * table, const uint8_t *pdata,
+		     size_t nbytes,
+		     uint32_t crc)
+{
+	unsigned int idx;
+
+	while (nbytes--) {
+		idx = (crc ^ *pdata) & 0xff;
+		crc = table[idx] ^ (crc >> 8);
+		pdata++;
+	}
+
+	return crc;
+}
+
+/***************************************************************************//**
+ * @brief Creates the slice-by-8 CRC-32 lookup tables for a given polynomial.
+ *
+ * @param table      - Lookup tables to write to. table[0] is the regular
+ *                     CRC-32 table, table[k] holds the CRC of each byte value
+ *                     followed by k zero bytes.
+ * @param polynomial - lsb-first (reflected) representation of desired
+ *                     polynomial.
+ *
+ * @return None.
+*******************************************************************************/
+void no_os_crc32_populate_slice_lsb(uint32_t table[][NO_OS_CRC32_TABLE_SIZE],
+				    const uint32_t polynomial)
+{
+	uint32_t prev;
+
+	if (!table)
+		return;
+
+	no_os_crc32_populate_lsb(table[0], polynomial);
+
+	for (int16_t n = 0; n < NO_OS_CRC32_TABLE_SIZE; n++) {
+		for (uint8_t k = 1; k < NO_OS_CRC32_SLICES; k++) {
+			prev = table[k - 1][n];
+			table[k][n] = (prev >> 8) ^ table[0][prev & 0xff];
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-32 over a buffer of data, 8 bytes per iteration.
+ *
+ * @param table     - Slice tables created with no_os_crc32_populate_slice_lsb().
+ * @param pdata     - Pointer to 8-bit data buffer.
+ * @param nbytes    - Number of bytes to compute the CRC-32 over.
+ * @param crc       - Initial value for the CRC-32 computation.
+ *
+ * @return crc      - Computed CRC-32 value, same as no_os_crc32() would return.
+*******************************************************************************/
+NO_OS_RAMFUNC
+uint32_t no_os_crc32_slice(const uint32_t table[][NO_OS_CRC32_TABLE_SIZE],
+			   const uint8_t *pdata, size_t nbytes, uint32_t crc)
+{
+	while (nbytes >= NO_OS_CRC32_SLICES) {
+		crc = table[7][pdata[0] ^ (crc & 0xff)] ^
+		      table[6][pdata[1] ^ ((crc >> 8) & 0xff)] ^
+		      table[5][pdata[2] ^ ((crc >> 16) & 0xff)] ^
+		      table[4][pdata[3] ^ (crc >> 24)] ^
+		      table[3][pdata[4]] ^ table[2][pdata[5]] ^
+		      table[1][pdata[6]] ^ table[0][pdata[7]];
+		pdata += NO_OS_CRC32_SLICES;
+		nbytes -= NO_OS_CRC32_SLICES;
+	}
+
+	return no_os_crc32(table[0], pdata, nbytes, crc);
+}
+
+/***************************************************************************//**
+ * @brief Get the shared CRC-32 lookup table of a polynomial.
+ *
+ * Tables of the common polynomials are constant and generated at compile
+ * time, any other polynomial gets a table populated on first use and then
+ * shared by all the later callers. The function is meant to be called from
+ * driver initialization, it is not reentrant.
+ *
+ * @param polynomial - lsb-first representation of desired polynomial.
+ *
+ * @return Pointer to the lookup table, NULL if it could not be allocated.
+*******************************************************************************/
+const uint32_t *no_os_crc32_get_table(const uint32_t polynomial)
+{
+	struct no_os_crc32_table_entry *entry;
+	uint32_t *table;
+
+	for (uint32_t i = 0; i < NO_OS_ARRAY_SIZE(no_os_crc32_builtin); i++)
+		if (no_os_crc32_builtin[i].polynomial == polynomial)
+			return no_os_crc32_builtin[i].table;
+
+	for (entry = no_os_crc32_registry; entry; entry = entry->next)
+		if (entry->polynomial == polynomial)
+			return entry->table;
+
+	entry = no_os_calloc(1, sizeof(*entry) +
+			     NO_OS_CRC32_TABLE_SIZE * sizeof(uint32_t));
+	if (!entry)
+		return NULL;
+
+	table = (uint32_t *)(entry + 1);
+	no_os_crc32_populate_lsb(table, polynomial);
+
+	entry->polynomial = polynomial;
+	entry->table = table;
+	entry->next = no_os_crc32_registry;
+	no_os_crc32_registry = entry;
+
+	return table;
+}
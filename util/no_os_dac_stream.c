@@ -0,0 +1,248 @@
+/***************************************************************************//**
+ *   @file   no_os_dac_stream.c
+ *   @brief  Source file for timer paced DAC waveform streaming.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_dac_stream.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
+
+/**
+ * @brief DMA completion callback of a frame write.
+ * @param ctx - The stream descriptor.
+ */
+static void no_os_dac_stream_done(void *ctx)
+{
+	struct no_os_dac_stream *stream = ctx;
+
+	if (++stream->idx == stream->block_samples) {
+		stream->idx = 0;
+		stream->rd++;
+		if (stream->cyclic && stream->rd == stream->wr)
+			stream->rd = 0;
+	}
+
+	stream->busy = false;
+}
+
+/**
+ * @brief Prepare a timer paced DAC stream.
+ *
+ * The caller fills blocks with no_os_dac_stream_get_block() and
+ * no_os_dac_stream_block_done(), then calls no_os_dac_stream_start() and routes
+ * the PWM tick (pulse finished interrupt) to no_os_dac_stream_trigger(). Each
+ * tick writes the next frame by DMA. With ldac_pwm, the frame lands in the
+ * input registers and the next LDAC pulse of the PWM updates the outputs, so
+ * the update instant only depends on the timer.
+ * @param stream - The stream descriptor.
+ * @param param  - The stream parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_stream_init(struct no_os_dac_stream **stream,
+			  const struct no_os_dac_stream_init_param *param)
+{
+	struct no_os_pwm_init_param pwm_param;
+	struct no_os_dac_stream *s;
+	uint32_t period_ns;
+	int ret;
+
+	if (!stream || !param || !param->spi_desc || !param->tick_pwm_init ||
+	    !param->ring || !param->block_samples || !param->nb_blocks ||
+	    !param->sample_rate_hz || !param->frame_bytes ||
+	    param->frame_bytes > NO_OS_DAC_STREAM_MAX_FRAME)
+		return -EINVAL;
+
+	period_ns = NO_OS_DIV_ROUND_CLOSEST(1000000000, param->sample_rate_hz);
+	if (param->ldac_pwm && period_ns <= param->ldac_pulse_ns)
+		return -EINVAL;
+
+	s = no_os_calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	s->spi_desc = param->spi_desc;
+	s->ring = param->ring;
+	s->frame_bytes = param->frame_bytes;
+	s->block_samples = param->block_samples;
+	s->nb_blocks = param->nb_blocks;
+	s->cyclic = param->cyclic;
+	s->msg.bytes_number = s->frame_bytes;
+	s->msg.cs_change = 1;
+
+	pwm_param = *param->tick_pwm_init;
+	pwm_param.period_ns = period_ns;
+	pwm_param.duty_cycle_ns = param->ldac_pwm ? param->ldac_pulse_ns :
+				  period_ns / 2;
+	ret = no_os_pwm_init(&s->tick_pwm, &pwm_param);
+	if (ret) {
+		no_os_free(s);
+		return ret;
+	}
+
+	*stream = s;
+
+	return 0;
+}
+
+/**
+ * @brief Get the next free block of the ring. In cyclic mode blocks can only
+ *	  be filled before start.
+ * @param stream - The stream descriptor.
+ * @param block  - Start of the block, block_samples frames of frame_bytes.
+ * @return 0 in case of success, -EAGAIN if no block is free.
+ */
+int no_os_dac_stream_get_block(struct no_os_dac_stream *stream,
+			       uint8_t **block)
+{
+	if (!stream || !block)
+		return -EINVAL;
+
+	if (stream->cyclic ? stream->started || stream->wr == stream->nb_blocks :
+	    stream->wr - stream->rd >= stream->nb_blocks)
+		return -EAGAIN;
+
+	*block = stream->ring + (stream->wr % stream->nb_blocks) *
+		 stream->block_samples * stream->frame_bytes;
+
+	return 0;
+}
+
+/**
+ * @brief Queue the block returned by no_os_dac_stream_get_block().
+ * @param stream - The stream descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_stream_block_done(struct no_os_dac_stream *stream)
+{
+	if (!stream)
+		return -EINVAL;
+
+	stream->wr++;
+
+	return 0;
+}
+
+/**
+ * @brief Start the update tick. At least one block must be queued.
+ * @param stream - The stream descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_stream_start(struct no_os_dac_stream *stream)
+{
+	int ret;
+
+	if (!stream || !stream->wr || stream->started)
+		return -EINVAL;
+
+	ret = no_os_pwm_enable(stream->tick_pwm);
+	if (ret)
+		return ret;
+
+	stream->started = true;
+
+	return 0;
+}
+
+/**
+ * @brief Write the next sample, to be called on each update tick. The write
+ *	  runs by DMA, the call returns as soon as it is started.
+ * @param stream - The stream descriptor.
+ * @return 0 in case of success, -EBUSY if the previous write is still in
+ *	   flight, -EAGAIN if no block is queued, negative error code otherwise.
+ *	   The outputs keep their value when the tick is missed.
+ */
+int no_os_dac_stream_trigger(struct no_os_dac_stream *stream)
+{
+	uint32_t slot;
+	int ret;
+
+	if (!stream)
+		return -EINVAL;
+
+	if (stream->busy) {
+		stream->underruns++;
+		return -EBUSY;
+	}
+
+	if (!stream->cyclic && stream->rd == stream->wr) {
+		stream->underruns++;
+		return -EAGAIN;
+	}
+
+	slot = (stream->rd % stream->nb_blocks) * stream->block_samples +
+	       stream->idx;
+	stream->msg.tx_buff = stream->ring + slot * stream->frame_bytes;
+
+	stream->busy = true;
+	ret = no_os_spi_transfer_dma_async(stream->spi_desc, &stream->msg, 1,
+					   no_os_dac_stream_done, stream);
+	if (ret)
+		stream->busy = false;
+
+	return ret;
+}
+
+/**
+ * @brief Stop the stream and free its resources.
+ * @param stream - The stream descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dac_stream_remove(struct no_os_dac_stream *stream)
+{
+	uint32_t timeout = 10000;
+	int ret;
+
+	if (!stream)
+		return -EINVAL;
+
+	if (stream->started) {
+		ret = no_os_pwm_disable(stream->tick_pwm);
+		if (ret)
+			return ret;
+	}
+
+	while (stream->busy && --timeout)
+		no_os_udelay(1);
+
+	ret = no_os_pwm_remove(stream->tick_pwm);
+	if (ret)
+		return ret;
+
+	no_os_free(stream);
+
+	return timeout ? 0 : -ETIMEDOUT;
+}
@@ -0,0 +1,249 @@
+/***************************************************************************//**
+ *   @file   no_os_dma_buf.c
+ *   @brief  Implementation of the DMA buffer allocator.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_dma_buf.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+#define DMA_BUF_ALIGN_UP(x)	(((x) + NO_OS_DMA_BUF_ALIGN - 1) & \
+				 ~(uintptr_t)(NO_OS_DMA_BUF_ALIGN - 1))
+#define DMA_BUF_ALIGN_DOWN(x)	((x) & ~(uintptr_t)(NO_OS_DMA_BUF_ALIGN - 1))
+
+static uint8_t *dma_buf_pool; // non-cacheable view of the pool
+static uint32_t dma_buf_pool_size;
+static uint32_t dma_buf_pool_used;
+
+/**
+ * @brief Write back the data cache lines of a range. Default implementation
+ * 	  for platforms without a data cache.
+ * @param addr - Start of the range.
+ * @param len - Length of the range in bytes.
+ */
+__attribute__((weak)) void no_os_dcache_flush_range(uintptr_t addr,
+		uint32_t len) {}
+
+/**
+ * @brief Discard the data cache lines of a range. Default implementation
+ * 	  for platforms without a data cache.
+ * @param addr - Start of the range.
+ * @param len - Length of the range in bytes.
+ */
+__attribute__((weak)) void no_os_dcache_invalidate_range(uintptr_t addr,
+		uint32_t len) {}
+
+/**
+ * @brief Get a non-cacheable view of a memory region. Default implementation
+ * 	  for platforms without a data cache, where all memory is coherent.
+ * @param addr - Start of the region.
+ * @param len - Length of the region in bytes.
+ * @return The region itself.
+ */
+__attribute__((weak)) void *no_os_dcache_map_uncached(void *addr, uint32_t len)
+{
+	return addr;
+}
+
+/**
+ * @brief Provide a memory region for coherent buffers.
+ *
+ * The region is made non-cacheable by the platform, so it should be reserved
+ * for DMA buffers (e.g. a dedicated linker section). Calling the function
+ * again replaces the pool, buffers of the previous pool stay valid.
+ * @param base - Start of the region.
+ * @param size - Size of the region in bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dma_buf_pool_init(void *base, uint32_t size)
+{
+	uint8_t *pool;
+	uint32_t skip;
+
+	if (!base || !size)
+		return -EINVAL;
+
+	pool = no_os_dcache_map_uncached(base, size);
+	if (!pool)
+		return -ENOTSUP;
+
+	skip = DMA_BUF_ALIGN_UP((uintptr_t)pool) - (uintptr_t)pool;
+	if (skip >= size)
+		return -EINVAL;
+
+	dma_buf_pool = pool + skip;
+	dma_buf_pool_size = DMA_BUF_ALIGN_DOWN(size - skip);
+	dma_buf_pool_used = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate a DMA buffer.
+ *
+ * Coherent buffers are taken from the pool set by no_os_dma_buf_pool_init().
+ * Cached buffers come from the heap and are written back before being
+ * returned, so that no dirty line is evicted over data written by the DMA.
+ * @param buf - Double pointer to the buffer that the function allocates.
+ * @param size - Size of the buffer in bytes.
+ * @param type - Where the buffer is allocated from.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dma_buf_alloc(struct no_os_dma_buf **buf, uint32_t size,
+			enum no_os_dma_buf_type type)
+{
+	struct no_os_dma_buf *b;
+
+	if (!buf || !size)
+		return -EINVAL;
+
+	b = no_os_calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->size = DMA_BUF_ALIGN_UP(size);
+
+	if (type == NO_OS_DMA_BUF_COHERENT) {
+		if (b->size > dma_buf_pool_size - dma_buf_pool_used) {
+			no_os_free(b);
+			return -ENOMEM;
+		}
+
+		b->addr = dma_buf_pool + dma_buf_pool_used;
+		b->coherent = true;
+		dma_buf_pool_used += b->size;
+	} else {
+		b->mem = no_os_malloc(b->size + NO_OS_DMA_BUF_ALIGN - 1);
+		if (!b->mem) {
+			no_os_free(b);
+			return -ENOMEM;
+		}
+
+		b->addr = (void *)DMA_BUF_ALIGN_UP((uintptr_t)b->mem);
+		no_os_dcache_flush_range((uintptr_t)b->addr, b->size);
+	}
+
+	*buf = b;
+
+	return 0;
+}
+
+/**
+ * @brief Free a DMA buffer.
+ *
+ * Pool space is given back when the most recent coherent buffer is freed, so
+ * coherent buffers should be freed in the reverse order of their allocation.
+ * @param buf - The buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_dma_buf_free(struct no_os_dma_buf *buf)
+{
+	if (!buf)
+		return -EINVAL;
+
+	if (buf->coherent) {
+		if ((uint8_t *)buf->addr + buf->size ==
+		    dma_buf_pool + dma_buf_pool_used)
+			dma_buf_pool_used -= buf->size;
+	} else {
+		no_os_free(buf->mem);
+	}
+
+	no_os_free(buf);
+
+	return 0;
+}
+
+/**
+ * @brief Get the cache lines covering a part of a DMA buffer.
+ * @param buf - The buffer.
+ * @param offset - Start of the part, relative to the buffer.
+ * @param len - Length of the part in bytes.
+ * @param start - Start of the first cache line.
+ * @param size - Length of the cache lines in bytes.
+ * @return true if maintenance is needed, false otherwise.
+ */
+static bool no_os_dma_buf_lines(struct no_os_dma_buf *buf, uint32_t offset,
+				uint32_t len, uintptr_t *start, uint32_t *size)
+{
+	uintptr_t end;
+
+	if (!buf || buf->coherent || !len || offset >= buf->size)
+		return false;
+
+	len = no_os_min(len, buf->size - offset);
+	*start = DMA_BUF_ALIGN_DOWN((uintptr_t)buf->addr + offset);
+	end = DMA_BUF_ALIGN_UP((uintptr_t)buf->addr + offset + len);
+	*size = end - *start;
+
+	return true;
+}
+
+/**
+ * @brief Make the CPU writes to a part of the buffer visible to the DMA.
+ * Call before starting a transfer which reads the buffer. Does nothing for
+ * coherent buffers.
+ * @param buf - The buffer.
+ * @param offset - Start of the part, relative to the buffer.
+ * @param len - Length of the part in bytes.
+ */
+void no_os_dma_buf_sync_for_device(struct no_os_dma_buf *buf,
+				   uint32_t offset, uint32_t len)
+{
+	uintptr_t start;
+	uint32_t size;
+
+	if (no_os_dma_buf_lines(buf, offset, len, &start, &size))
+		no_os_dcache_flush_range(start, size);
+}
+
+/**
+ * @brief Make the DMA writes to a part of the buffer visible to the CPU.
+ * Call after a transfer which wrote the buffer, for the written part only.
+ * Does nothing for coherent buffers.
+ * @param buf - The buffer.
+ * @param offset - Start of the part, relative to the buffer.
+ * @param len - Length of the part in bytes.
+ */
+void no_os_dma_buf_sync_for_cpu(struct no_os_dma_buf *buf,
+				uint32_t offset, uint32_t len)
+{
+	uintptr_t start;
+	uint32_t size;
+
+	if (no_os_dma_buf_lines(buf, offset, len, &start, &size))
+		no_os_dcache_invalidate_range(start, size);
+}
@@ -0,0 +1,1348 @@
+/***************************************************************************//**
+ *   @file   no_os_dsp.c
+ *   @brief  Source file for fixed point signal processing utilities.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_dsp.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+struct no_os_dsp_cic {
+	unsigned int order;
+	unsigned int decimation;
+	unsigned int count; // inputs since the last output
+	unsigned int shift; // gain normalization when decimation is a power of 2
+	uint64_t gain; // gain normalization otherwise
+	/* Unsigned so that the integrators wrap around as the algorithm expects */
+	uint64_t integ[NO_OS_DSP_CIC_MAX_ORDER];
+	uint64_t comb[NO_OS_DSP_CIC_MAX_ORDER];
+};
+
+struct no_os_dsp_fir {
+	unsigned int nb_taps;
+	unsigned int nb_nz; // number of non-zero taps
+	unsigned int decimation;
+	unsigned int count; // inputs since the last output
+	unsigned int idx; // position of the newest sample in the history
+	int32_t *coeffs; // non-zero coefficients
+	uint16_t *taps; // delay of each non-zero coefficient
+	int32_t *hist; // 2 * nb_taps, each sample stored twice
+};
+
+struct no_os_dsp_window {
+	unsigned int length;
+	unsigned int count; // valid samples, up to length
+	unsigned int idx; // position of the oldest sample
+	int64_t sum;
+	uint64_t sum_sq;
+	int32_t *samples;
+};
+
+struct no_os_dsp_scan {
+	struct no_os_dsp_scan_config config;
+	int32_t *scan;
+};
+
+struct no_os_dsp_fft {
+	struct no_os_dsp_fft_config config;
+	unsigned int count; // samples in the current frame
+	unsigned int frames; // frames in the current average
+	bool ready; // bins holds a spectrum not read yet
+	uint32_t gain; // Q16 scaling of the magnitudes to sine amplitudes
+	int16_t *cos; // cos(2 * pi * k / length), Q15, k < length / 2
+	int16_t *sin; // -sin(2 * pi * k / length), Q15, k < length / 2
+	int16_t *window; // length / 2 + 1 coefficients, Q15, it is symmetric
+	int32_t *work; // length interleaved (real, imaginary) pairs
+	uint64_t *acc; // length / 2 magnitude sums
+	uint32_t *bins; // length / 2, the last averaged spectrum
+};
+
+/* Saturate a 64-bit value to the int32_t range. */
+static inline int32_t _sat32(int64_t val)
+{
+	if (val > INT32_MAX)
+		return INT32_MAX;
+	if (val < INT32_MIN)
+		return INT32_MIN;
+
+	return (int32_t)val;
+}
+
+/* Saturate a 32-bit value to the int16_t range. */
+static inline int16_t _sat16(int32_t val)
+{
+	if (val > INT16_MAX)
+		return INT16_MAX;
+	if (val < INT16_MIN)
+		return INT16_MIN;
+
+	return (int16_t)val;
+}
+
+/* Integer square root, rounded down. */
+static uint32_t _isqrt64(uint64_t val)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ull << 62;
+
+	while (bit > val)
+		bit >>= 2;
+
+	while (bit) {
+		if (val >= res + bit) {
+			val -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return (uint32_t)res;
+}
+
+/**
+ * @brief Initialize a CIC decimator.
+ * @param cic - Double pointer to a CIC descriptor that the function allocates
+ * @param config - CIC configuration structure
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_dsp_cic_init(struct no_os_dsp_cic **cic,
+		       struct no_os_dsp_cic_config config)
+{
+	uint64_t gain = 1;
+	unsigned int i;
+
+	if (!cic || !config.order || config.order > NO_OS_DSP_CIC_MAX_ORDER ||
+	    !config.decimation)
+		return -EINVAL;
+
+	/* R^N has to leave room for a 32-bit input in the 64-bit registers. */
+	for (i = 0; i < config.order; i++) {
+		gain *= config.decimation;
+		if (gain > (1ull << 32))
+			return -EINVAL;
+	}
+
+	*cic = no_os_calloc(1, sizeof(**cic));
+	if (!*cic)
+		return -ENOMEM;
+
+	(*cic)->order = config.order;
+	(*cic)->decimation = config.decimation;
+	(*cic)->gain = gain;
+	if (!(gain & (gain - 1))) {
+		(*cic)->shift = no_os_find_first_set_bit(gain);
+		if (gain == (1ull << 32))
+			(*cic)->shift = 32;
+		(*cic)->gain = 0;
+	}
+
+	return 0;
+}
+
+/* Feed one sample, returns true and the output when one is produced. */
+static inline bool _cic_step(struct no_os_dsp_cic *cic, int32_t x,
+			     int32_t *y)
+{
+	uint64_t acc = (uint64_t)(int64_t)x;
+	uint64_t prev;
+	unsigned int i;
+
+	for (i = 0; i < cic->order; i++) {
+		cic->integ[i] += acc;
+		acc = cic->integ[i];
+	}
+
+	if (++cic->count < cic->decimation)
+		return false;
+
+	cic->count = 0;
+
+	for (i = 0; i < cic->order; i++) {
+		prev = cic->comb[i];
+		cic->comb[i] = acc;
+		acc -= prev;
+	}
+
+	if (cic->gain)
+		*y = _sat32((int64_t)acc / (int64_t)cic->gain);
+	else
+		*y = _sat32((int64_t)acc >> cic->shift);
+
+	return true;
+}
+
+/**
+ * @brief Decimate a buffer of samples.
+ * @param cic - CIC descriptor created with no_os_dsp_cic_init()
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @param out - Output samples, may be the same buffer as in
+ * @param nb_out - Number of output samples written
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_cic_process(struct no_os_dsp_cic *cic, const int32_t *in,
+			  uint32_t nb, int32_t *out, uint32_t *nb_out)
+{
+	uint32_t i, n = 0;
+
+	if (!cic || (nb && (!in || !out)) || !nb_out)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		if (_cic_step(cic, in[i], &out[n]))
+			n++;
+
+	*nb_out = n;
+
+	return 0;
+}
+
+/**
+ * @brief Decimate a buffer of 16-bit samples.
+ * @param cic - CIC descriptor created with no_os_dsp_cic_init()
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @param out - Output samples, may be the same buffer as in
+ * @param nb_out - Number of output samples written
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_cic_process16(struct no_os_dsp_cic *cic, const int16_t *in,
+			    uint32_t nb, int16_t *out, uint32_t *nb_out)
+{
+	uint32_t i, n = 0;
+	int32_t y;
+
+	if (!cic || (nb && (!in || !out)) || !nb_out)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		if (_cic_step(cic, in[i], &y))
+			out[n++] = _sat16(y);
+
+	*nb_out = n;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the CIC state.
+ * @param cic - CIC descriptor created with no_os_dsp_cic_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_cic_reset(struct no_os_dsp_cic *cic)
+{
+	if (!cic)
+		return -EINVAL;
+
+	memset(cic->integ, 0, sizeof(cic->integ));
+	memset(cic->comb, 0, sizeof(cic->comb));
+	cic->count = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Free a CIC descriptor.
+ * @param cic - CIC descriptor created with no_os_dsp_cic_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_cic_remove(struct no_os_dsp_cic *cic)
+{
+	if (!cic)
+		return -EINVAL;
+
+	no_os_free(cic);
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a FIR filter.
+ * @param fir - Double pointer to a FIR descriptor that the function allocates
+ * @param config - FIR configuration structure, the coefficients are copied
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_dsp_fir_init(struct no_os_dsp_fir **fir,
+		       struct no_os_dsp_fir_config config)
+{
+	struct no_os_dsp_fir *f;
+	unsigned int i, n = 0;
+
+	if (!fir || !config.coeffs || !config.nb_taps ||
+	    config.nb_taps > UINT16_MAX || !config.decimation)
+		return -EINVAL;
+
+	for (i = 0; i < config.nb_taps; i++)
+		if (config.coeffs[i])
+			n++;
+
+	if (!n)
+		return -EINVAL;
+
+	f = no_os_calloc(1, sizeof(*f));
+	if (!f)
+		return -ENOMEM;
+
+	f->coeffs = no_os_calloc(n, sizeof(*f->coeffs));
+	f->taps = no_os_calloc(n, sizeof(*f->taps));
+	f->hist = no_os_calloc(2 * config.nb_taps, sizeof(*f->hist));
+	if (!f->coeffs || !f->taps || !f->hist) {
+		no_os_dsp_fir_remove(f);
+		return -ENOMEM;
+	}
+
+	f->nb_taps = config.nb_taps;
+	f->nb_nz = n;
+	f->decimation = config.decimation;
+
+	for (i = 0, n = 0; i < config.nb_taps; i++) {
+		if (!config.coeffs[i])
+			continue;
+		f->coeffs[n] = config.coeffs[i];
+		f->taps[n] = i;
+		n++;
+	}
+
+	*fir = f;
+
+	return 0;
+}
+
+/* Feed one sample, returns true and the output when one is produced. */
+static inline bool _fir_step(struct no_os_dsp_fir *fir, int32_t x,
+			     int32_t *y)
+{
+	const int32_t *newest;
+	int64_t acc = 0;
+	unsigned int i;
+
+	if (++fir->idx == fir->nb_taps)
+		fir->idx = 0;
+
+	/* The second copy keeps the last nb_taps samples contiguous. */
+	fir->hist[fir->idx] = x;
+	fir->hist[fir->idx + fir->nb_taps] = x;
+
+	if (++fir->count < fir->decimation)
+		return false;
+
+	fir->count = 0;
+
+	newest = &fir->hist[fir->idx + fir->nb_taps];
+	for (i = 0; i < fir->nb_nz; i++)
+		acc += (int64_t)fir->coeffs[i] * newest[-(int32_t)fir->taps[i]];
+
+	*y = _sat32((acc + (1 << 14)) >> 15);
+
+	return true;
+}
+
+/**
+ * @brief Filter a buffer of samples.
+ * @param fir - FIR descriptor created with no_os_dsp_fir_init()
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @param out - Output samples, may be the same buffer as in
+ * @param nb_out - Number of output samples written
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fir_process(struct no_os_dsp_fir *fir, const int32_t *in,
+			  uint32_t nb, int32_t *out, uint32_t *nb_out)
+{
+	uint32_t i, n = 0;
+
+	if (!fir || (nb && (!in || !out)) || !nb_out)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		if (_fir_step(fir, in[i], &out[n]))
+			n++;
+
+	*nb_out = n;
+
+	return 0;
+}
+
+/**
+ * @brief Filter a buffer of 16-bit samples.
+ * @param fir - FIR descriptor created with no_os_dsp_fir_init()
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @param out - Output samples, may be the same buffer as in
+ * @param nb_out - Number of output samples written
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fir_process16(struct no_os_dsp_fir *fir, const int16_t *in,
+			    uint32_t nb, int16_t *out, uint32_t *nb_out)
+{
+	uint32_t i, n = 0;
+	int32_t y;
+
+	if (!fir || (nb && (!in || !out)) || !nb_out)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		if (_fir_step(fir, in[i], &y))
+			out[n++] = _sat16(y);
+
+	*nb_out = n;
+
+	return 0;
+}
+
+/**
+ * @brief Clear the FIR history.
+ * @param fir - FIR descriptor created with no_os_dsp_fir_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fir_reset(struct no_os_dsp_fir *fir)
+{
+	if (!fir)
+		return -EINVAL;
+
+	memset(fir->hist, 0, 2 * fir->nb_taps * sizeof(*fir->hist));
+	fir->count = 0;
+	fir->idx = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Free a FIR descriptor.
+ * @param fir - FIR descriptor created with no_os_dsp_fir_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fir_remove(struct no_os_dsp_fir *fir)
+{
+	if (!fir)
+		return -EINVAL;
+
+	no_os_free(fir->coeffs);
+	no_os_free(fir->taps);
+	no_os_free(fir->hist);
+	no_os_free(fir);
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a running mean and RMS window.
+ * @param win - Double pointer to a window descriptor that the function allocates
+ * @param config - Window configuration structure
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_dsp_window_init(struct no_os_dsp_window **win,
+			  struct no_os_dsp_window_config config)
+{
+	if (!win || !config.length)
+		return -EINVAL;
+
+	*win = no_os_calloc(1, sizeof(**win));
+	if (!*win)
+		return -ENOMEM;
+
+	(*win)->samples = no_os_calloc(config.length, sizeof(*(*win)->samples));
+	if (!(*win)->samples) {
+		no_os_free(*win);
+		return -ENOMEM;
+	}
+
+	(*win)->length = config.length;
+
+	return 0;
+}
+
+/* Add one sample, dropping the oldest one once the window is full. */
+static inline void _window_step(struct no_os_dsp_window *win, int32_t x)
+{
+	int32_t old;
+
+	if (win->count == win->length) {
+		old = win->samples[win->idx];
+		win->sum -= old;
+		win->sum_sq -= (uint64_t)((int64_t)old * old);
+	} else {
+		win->count++;
+	}
+
+	win->samples[win->idx] = x;
+	win->sum += x;
+	win->sum_sq += (uint64_t)((int64_t)x * x);
+
+	if (++win->idx == win->length)
+		win->idx = 0;
+}
+
+/**
+ * @brief Add samples to the window.
+ * @param win - Window descriptor created with no_os_dsp_window_init()
+ * @param in - Samples
+ * @param nb - Number of samples
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_window_push(struct no_os_dsp_window *win, const int32_t *in,
+			  uint32_t nb)
+{
+	uint32_t i;
+
+	if (!win || (nb && !in))
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		_window_step(win, in[i]);
+
+	return 0;
+}
+
+/**
+ * @brief Add 16-bit samples to the window.
+ * @param win - Window descriptor created with no_os_dsp_window_init()
+ * @param in - Samples
+ * @param nb - Number of samples
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_window_push16(struct no_os_dsp_window *win, const int16_t *in,
+			    uint32_t nb)
+{
+	uint32_t i;
+
+	if (!win || (nb && !in))
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		_window_step(win, in[i]);
+
+	return 0;
+}
+
+/**
+ * @brief Mean of the samples in the window.
+ * @param win - Window descriptor created with no_os_dsp_window_init()
+ * @return The mean, 0 for an empty window.
+ */
+int32_t no_os_dsp_window_mean(struct no_os_dsp_window *win)
+{
+	if (!win || !win->count)
+		return 0;
+
+	return (int32_t)(win->sum / (int64_t)win->count);
+}
+
+/**
+ * @brief Root mean square of the samples in the window.
+ * @param win - Window descriptor created with no_os_dsp_window_init()
+ * @return The RMS, 0 for an empty window.
+ */
+uint32_t no_os_dsp_window_rms(struct no_os_dsp_window *win)
+{
+	if (!win || !win->count)
+		return 0;
+
+	return _isqrt64(win->sum_sq / win->count);
+}
+
+/**
+ * @brief Empty the window.
+ * @param win - Window descriptor created with no_os_dsp_window_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_window_reset(struct no_os_dsp_window *win)
+{
+	if (!win)
+		return -EINVAL;
+
+	win->count = 0;
+	win->idx = 0;
+	win->sum = 0;
+	win->sum_sq = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Free a window descriptor.
+ * @param win - Window descriptor created with no_os_dsp_window_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_window_remove(struct no_os_dsp_window *win)
+{
+	if (!win)
+		return -EINVAL;
+
+	no_os_free(win->samples);
+	no_os_free(win);
+
+	return 0;
+}
+
+/**
+ * @brief Run a buffer of samples through one stage.
+ * Mean and RMS stages output the running value for every input sample.
+ * @param stage - The stage
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @param out - Output samples, may be the same buffer as in
+ * @param nb_out - Number of output samples written
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_stage_process(struct no_os_dsp_stage *stage, const int32_t *in,
+			    uint32_t nb, int32_t *out, uint32_t *nb_out)
+{
+	struct no_os_dsp_window *win;
+	uint32_t i;
+
+	if (!stage || !stage->desc)
+		return -EINVAL;
+
+	switch (stage->type) {
+	case NO_OS_DSP_CIC:
+		return no_os_dsp_cic_process(stage->desc, in, nb, out, nb_out);
+	case NO_OS_DSP_FIR:
+		return no_os_dsp_fir_process(stage->desc, in, nb, out, nb_out);
+	case NO_OS_DSP_MEAN:
+	case NO_OS_DSP_RMS:
+		if ((nb && (!in || !out)) || !nb_out)
+			return -EINVAL;
+
+		win = stage->desc;
+		for (i = 0; i < nb; i++) {
+			_window_step(win, in[i]);
+			if (stage->type == NO_OS_DSP_MEAN)
+				out[i] = no_os_dsp_window_mean(win);
+			else
+				out[i] = _sat32(no_os_dsp_window_rms(win));
+		}
+		*nb_out = nb;
+
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Initialize the per channel processing of interleaved scans.
+ * @param scan - Double pointer to a descriptor that the function allocates
+ * @param config - Configuration, the stages stay owned by the caller
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_dsp_scan_init(struct no_os_dsp_scan **scan,
+			struct no_os_dsp_scan_config config)
+{
+	if (!scan || !config.nb_channels || (config.nb_stages && !config.stages) ||
+	    !config.push)
+		return -EINVAL;
+
+	*scan = no_os_calloc(1, sizeof(**scan));
+	if (!*scan)
+		return -ENOMEM;
+
+	(*scan)->scan = no_os_calloc(config.nb_channels, sizeof(*(*scan)->scan));
+	if (!(*scan)->scan) {
+		no_os_free(*scan);
+		return -ENOMEM;
+	}
+
+	(*scan)->config = config;
+
+	return 0;
+}
+
+/**
+ * @brief Process interleaved scans and push the resulting ones.
+ * All the channel chains have to decimate by the same ratio, so that they
+ * produce their outputs for the same input scans.
+ * @param scan - Descriptor created with no_os_dsp_scan_init()
+ * @param data - nb_scans scans of nb_channels samples each
+ * @param nb_scans - Number of scans
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - The push callback error otherwise
+ */
+int no_os_dsp_scan_process(struct no_os_dsp_scan *scan, const int32_t *data,
+			   uint32_t nb_scans)
+{
+	struct no_os_dsp_scan_config *cfg;
+	struct no_os_dsp_stage *stage;
+	unsigned int ch, st, ready;
+	uint32_t s, nb;
+	int32_t val;
+	int ret;
+
+	if (!scan || (nb_scans && !data))
+		return -EINVAL;
+
+	cfg = &scan->config;
+
+	for (s = 0; s < nb_scans; s++, data += cfg->nb_channels) {
+		ready = 0;
+		for (ch = 0; ch < cfg->nb_channels; ch++) {
+			val = data[ch];
+			nb = 1;
+			stage = &cfg->stages[ch * cfg->nb_stages];
+			for (st = 0; st < cfg->nb_stages && nb; st++) {
+				ret = no_os_dsp_stage_process(&stage[st], &val, 1,
+							      &val, &nb);
+				if (ret)
+					return ret;
+			}
+
+			if (nb) {
+				scan->scan[ch] = val;
+				ready++;
+			}
+		}
+
+		if (ready == cfg->nb_channels) {
+			ret = cfg->push(cfg->arg, scan->scan);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the scan processing descriptor.
+ * @param scan - Descriptor created with no_os_dsp_scan_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_scan_remove(struct no_os_dsp_scan *scan)
+{
+	if (!scan)
+		return -EINVAL;
+
+	no_os_free(scan->scan);
+	no_os_free(scan);
+
+	return 0;
+}
+
+/**
+ * @brief Split an averaging ratio between on-chip oversampling and host
+ * decimation.
+ * On-chip averaging costs no host cycles, so the largest on-chip ratio whose
+ * conversion time still fits the trigger period is picked and the remainder
+ * is left to a CIC decimator (see no_os_dsp_cic_init()).
+ * @param tconv_ns - Conversion time for each on-chip ratio 1 << index
+ * @param nb_osr - Number of entries in tconv_ns
+ * @param out_rate_hz - Requested output rate
+ * @param ratio - Requested total averaging ratio, rounded up to a multiple of
+ *		  the on-chip ratio
+ * @param overhead_ns - Per conversion time spent outside of the converter,
+ *		        e.g. for the readout
+ * @param split - The selected split
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ERANGE : The output rate can't be reached with the requested ratio
+ */
+int no_os_dsp_os_split(const uint32_t *tconv_ns, unsigned int nb_osr,
+		       uint32_t out_rate_hz, uint32_t ratio,
+		       uint32_t overhead_ns, struct no_os_dsp_os_split *split)
+{
+	uint64_t conv_rate;
+	uint32_t decimation;
+	unsigned int i;
+
+	if (!tconv_ns || !nb_osr || !out_rate_hz || !ratio || !split)
+		return -EINVAL;
+
+	for (i = nb_osr; i-- > 0;) {
+		if ((1u << i) > ratio)
+			continue;
+
+		decimation = NO_OS_DIV_ROUND_UP(ratio, 1u << i);
+		conv_rate = (uint64_t)out_rate_hz * decimation;
+		if (conv_rate * ((uint64_t)tconv_ns[i] + overhead_ns) > 1000000000ull)
+			continue;
+
+		split->osr_idx = i;
+		split->decimation = decimation;
+		split->conv_rate_hz = conv_rate;
+
+		return 0;
+	}
+
+	return -ERANGE;
+}
+
+/* atan(2^-i) in microradians, for the CORDIC iterations. */
+static const int32_t _atan_urad[] = {
+	785398, 463648, 244979, 124355, 62419, 31240, 15624, 7812, 3906, 1953,
+	977, 488, 244, 122, 61, 31, 15, 8, 4, 2, 1
+};
+
+/**
+ * @brief Convert complex samples to magnitude and phase.
+ * The phase is computed with a CORDIC in vectoring mode and the magnitude
+ * with an integer square root, so no floating point is used. in and out may
+ * be the same buffer.
+ * @param in - nb interleaved (real, imaginary) pairs
+ * @param nb - Number of complex samples
+ * @param out - nb interleaved (magnitude, phase) pairs, the phase being in
+ *		microradians in the [-pi, pi] range
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_polar(const int32_t *in, uint32_t nb, int32_t *out)
+{
+	int64_t x, y, tmp;
+	int32_t angle;
+	uint32_t i, j;
+
+	if (!in || !out)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++) {
+		x = in[2 * i];
+		y = in[2 * i + 1];
+		out[2 * i] = _isqrt64((uint64_t)(x * x) + (uint64_t)(y * y));
+
+		angle = 0;
+		if (x < 0) {
+			angle = y < 0 ? -3141593 : 3141593;
+			x = -x;
+			y = -y;
+		}
+
+		/* Scale up so the last iterations still resolve the angle */
+		x *= 1 << 24;
+		y *= 1 << 24;
+		for (j = 0; j < NO_OS_ARRAY_SIZE(_atan_urad); j++) {
+			tmp = x;
+			if (y > 0) {
+				x += y >> j;
+				y -= tmp >> j;
+				angle += _atan_urad[j];
+			} else {
+				x -= y >> j;
+				y += tmp >> j;
+				angle -= _atan_urad[j];
+			}
+		}
+
+		out[2 * i + 1] = angle;
+	}
+
+	return 0;
+}
+
+/* CORDIC gain compensation, 1 / prod(sqrt(1 + 2^-2i)) in Q30. */
+#define _CORDIC_K_Q30		652032874
+#define _PI_URAD		3141593
+
+/* cos and sin of angle in microradians, in [0, pi / 2], in Q15. */
+static void _cordic_rotate(int32_t angle, int16_t *c, int16_t *s)
+{
+	int64_t x = _CORDIC_K_Q30;
+	int64_t y = 0;
+	int64_t tmp;
+	uint32_t j;
+
+	for (j = 0; j < NO_OS_ARRAY_SIZE(_atan_urad); j++) {
+		tmp = x;
+		if (angle >= 0) {
+			x -= y >> j;
+			y += tmp >> j;
+			angle -= _atan_urad[j];
+		} else {
+			x += y >> j;
+			y -= tmp >> j;
+			angle += _atan_urad[j];
+		}
+	}
+
+	*c = _sat16((int32_t)((x + (1 << 14)) >> 15));
+	*s = _sat16((int32_t)((y + (1 << 14)) >> 15));
+}
+
+/* cos(2 * pi * k / length) for any k, in Q15. */
+static inline int32_t _fft_cos(struct no_os_dsp_fft *fft, uint32_t k)
+{
+	uint32_t half = fft->config.length / 2;
+
+	k &= fft->config.length - 1;
+	if (k < half)
+		return fft->cos[k];
+
+	return -fft->cos[k - half];
+}
+
+/*
+ * Compute the window coefficients and the gain that makes a sine of
+ * amplitude A read A in its bin, whatever the window.
+ */
+static void _fft_window(struct no_os_dsp_fft *fft)
+{
+	/* Blackman-Harris a0 to a3 in Q15 */
+	static const int32_t bh[] = {11756, 16000, 4630, 383};
+	uint32_t n = fft->config.length;
+	uint64_t sum = 0;
+	int32_t w;
+	uint32_t i;
+
+	for (i = 0; i <= n / 2; i++) {
+		switch (fft->config.window) {
+		case NO_OS_DSP_FFT_HANN:
+			w = (32768 - _fft_cos(fft, i)) / 2;
+			break;
+		case NO_OS_DSP_FFT_BLACKMAN_HARRIS:
+			w = (bh[0] * 32768 - bh[1] * _fft_cos(fft, i) +
+			     bh[2] * _fft_cos(fft, 2 * i) -
+			     bh[3] * _fft_cos(fft, 3 * i)) >> 15;
+			break;
+		default:
+			w = INT16_MAX;
+			break;
+		}
+		fft->window[i] = _sat16(w);
+
+		/* Every coefficient but the first and the middle one is used twice */
+		sum += fft->window[i] * ((i && i != n / 2) ? 2 : 1);
+	}
+
+	/* 2 * length / sum of the window, the transform divides by length */
+	fft->gain = sum ? (uint32_t)NO_OS_DIV_ROUND_CLOSEST_ULL(
+				(uint64_t)n << 32, sum) : 0;
+}
+
+/**
+ * @brief Initialize a magnitude spectrum.
+ * A radix-2 fixed point FFT of windowed frames of real samples. The bins are
+ * scaled so that a sine of amplitude A reads A, in the units of the samples
+ * with config.shift fractional bits, and the DC bin reads the mean.
+ * @param fft - Double pointer to a spectrum descriptor that the function
+ *		allocates
+ * @param config - Spectrum configuration structure
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_dsp_fft_init(struct no_os_dsp_fft **fft,
+		       struct no_os_dsp_fft_config config)
+{
+	struct no_os_dsp_fft *f;
+	uint32_t half, k;
+	int32_t angle;
+
+	if (!fft || config.length < 16 ||
+	    config.length > NO_OS_DSP_FFT_MAX_LENGTH ||
+	    (config.length & (config.length - 1)) || !config.averages ||
+	    config.shift > 30 || config.window > NO_OS_DSP_FFT_BLACKMAN_HARRIS)
+		return -EINVAL;
+
+	f = no_os_calloc(1, sizeof(*f));
+	if (!f)
+		return -ENOMEM;
+
+	half = config.length / 2;
+	f->config = config;
+	f->cos = no_os_calloc(half, sizeof(*f->cos));
+	f->sin = no_os_calloc(half, sizeof(*f->sin));
+	f->window = no_os_calloc(half + 1, sizeof(*f->window));
+	f->work = no_os_calloc(2 * config.length, sizeof(*f->work));
+	f->acc = no_os_calloc(half, sizeof(*f->acc));
+	f->bins = no_os_calloc(half, sizeof(*f->bins));
+	if (!f->cos || !f->sin || !f->window || !f->work || !f->acc ||
+	    !f->bins) {
+		no_os_dsp_fft_remove(f);
+		return -ENOMEM;
+	}
+
+	/* The twiddles of the second quarter mirror the ones of the first */
+	for (k = 0; k <= half / 2; k++) {
+		angle = (int32_t)NO_OS_DIV_ROUND_CLOSEST_ULL(
+				2ull * _PI_URAD * k, config.length);
+		_cordic_rotate(angle, &f->cos[k], &f->sin[k]);
+		f->sin[k] = -f->sin[k];
+		if (k && k < half / 2) {
+			f->cos[half - k] = -f->cos[k];
+			f->sin[half - k] = f->sin[k];
+		}
+	}
+
+	_fft_window(f);
+	*fft = f;
+
+	return 0;
+}
+
+/* In place transform of fft->work, scaled by 1 / length. */
+static void _fft_transform(struct no_os_dsp_fft *fft)
+{
+	uint32_t n = fft->config.length;
+	uint32_t size, half, step, i, j, k, bit;
+	int32_t *a, *b;
+	int64_t tr, ti;
+	int32_t tmp;
+
+	/* Bit reversed order */
+	for (i = 1, j = 0; i < n; i++) {
+		for (bit = n >> 1; j & bit; bit >>= 1)
+			j ^= bit;
+		j |= bit;
+		if (i < j) {
+			tmp = fft->work[2 * i];
+			fft->work[2 * i] = fft->work[2 * j];
+			fft->work[2 * j] = tmp;
+			tmp = fft->work[2 * i + 1];
+			fft->work[2 * i + 1] = fft->work[2 * j + 1];
+			fft->work[2 * j + 1] = tmp;
+		}
+	}
+
+	/* Each stage halves the values so that they can't overflow */
+	for (size = 2; size <= n; size <<= 1) {
+		half = size / 2;
+		step = n / size;
+		for (i = 0; i < n; i += size) {
+			for (j = 0, k = 0; j < half; j++, k += step) {
+				a = &fft->work[2 * (i + j)];
+				b = &fft->work[2 * (i + j + half)];
+				tr = ((int64_t)b[0] * fft->cos[k] -
+				      (int64_t)b[1] * fft->sin[k]) >> 15;
+				ti = ((int64_t)b[0] * fft->sin[k] +
+				      (int64_t)b[1] * fft->cos[k]) >> 15;
+				b[0] = (int32_t)((a[0] - tr + 1) >> 1);
+				b[1] = (int32_t)((a[1] - ti + 1) >> 1);
+				a[0] = (int32_t)((a[0] + tr + 1) >> 1);
+				a[1] = (int32_t)((a[1] + ti + 1) >> 1);
+			}
+		}
+	}
+}
+
+/* Window the real samples in fft->work and transform them. */
+static void _fft_run(struct no_os_dsp_fft *fft)
+{
+	uint32_t n = fft->config.length;
+	uint32_t i;
+	int32_t w;
+
+	for (i = 0; i < n; i++) {
+		w = fft->window[i <= n / 2 ? i : n - i];
+		fft->work[2 * i] = (int32_t)(((int64_t)fft->work[2 * i] * w +
+					      (1 << 14)) >> 15);
+		fft->work[2 * i + 1] = 0;
+	}
+
+	_fft_transform(fft);
+}
+
+/* Magnitude of bin k of the transform. */
+static uint32_t _fft_mag(struct no_os_dsp_fft *fft, uint32_t k)
+{
+	int64_t re = fft->work[2 * k];
+	int64_t im = fft->work[2 * k + 1];
+
+	return _isqrt64((uint64_t)(re * re) + (uint64_t)(im * im));
+}
+
+/* A magnitude scaled to a sine amplitude. */
+static uint32_t _fft_bin(struct no_os_dsp_fft *fft, uint64_t mag)
+{
+	mag = (mag * fft->gain) >> 16;
+
+	return (uint32_t)no_os_min(mag, (uint64_t)UINT32_MAX);
+}
+
+/* The shifted sample, the samples are held in fft->work during a frame. */
+static inline int32_t _fft_sample(struct no_os_dsp_fft *fft, int32_t x)
+{
+	return _sat32((int64_t)x * (1ll << fft->config.shift));
+}
+
+/**
+ * @brief Magnitude spectrum of a single frame, without averaging.
+ * It resets the frame being filled by no_os_dsp_fft_push().
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @param in - config.length samples
+ * @param bins - config.length / 2 magnitudes
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_frame(struct no_os_dsp_fft *fft, const int32_t *in,
+			uint32_t *bins)
+{
+	uint32_t i;
+
+	if (!fft || !in || !bins)
+		return -EINVAL;
+
+	for (i = 0; i < fft->config.length; i++)
+		fft->work[2 * i] = _fft_sample(fft, in[i]);
+	fft->count = 0;
+
+	_fft_run(fft);
+
+	for (i = 0; i < fft->config.length / 2; i++)
+		bins[i] = _fft_bin(fft, _fft_mag(fft, i));
+	bins[0] /= 2;
+
+	return 0;
+}
+
+/* Add the spectrum of the complete frame to the average. */
+static void _fft_frame_done(struct no_os_dsp_fft *fft)
+{
+	uint32_t half = fft->config.length / 2;
+	uint32_t i;
+
+	_fft_run(fft);
+	fft->count = 0;
+
+	for (i = 0; i < half; i++)
+		fft->acc[i] += _fft_mag(fft, i);
+
+	if (++fft->frames < fft->config.averages)
+		return;
+
+	for (i = 0; i < half; i++) {
+		fft->bins[i] = _fft_bin(fft, fft->acc[i] / fft->config.averages);
+		fft->acc[i] = 0;
+	}
+	fft->bins[0] /= 2;
+	fft->frames = 0;
+	fft->ready = true;
+}
+
+/**
+ * @brief Add samples to the averaged spectrum.
+ * A spectrum is computed each time a frame is complete, and the average is
+ * made available to no_os_dsp_fft_read() after config.averages frames.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_push(struct no_os_dsp_fft *fft, const int32_t *in,
+		       uint32_t nb)
+{
+	uint32_t i;
+
+	if (!fft || (nb && !in))
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++) {
+		fft->work[2 * fft->count] = _fft_sample(fft, in[i]);
+		if (++fft->count == fft->config.length)
+			_fft_frame_done(fft);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Add 16-bit samples to the averaged spectrum.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @param in - Input samples
+ * @param nb - Number of input samples
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_push16(struct no_os_dsp_fft *fft, const int16_t *in,
+			 uint32_t nb)
+{
+	uint32_t i;
+
+	if (!fft || (nb && !in))
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++) {
+		fft->work[2 * fft->count] = _fft_sample(fft, in[i]);
+		if (++fft->count == fft->config.length)
+			_fft_frame_done(fft);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the last averaged spectrum, once.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @param bins - config.length / 2 magnitudes
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -EAGAIN : No new spectrum since the last read
+ */
+int no_os_dsp_fft_read(struct no_os_dsp_fft *fft, uint32_t *bins)
+{
+	if (!fft || !bins)
+		return -EINVAL;
+
+	if (!fft->ready)
+		return -EAGAIN;
+
+	memcpy(bins, fft->bins, fft->config.length / 2 * sizeof(*bins));
+	fft->ready = false;
+
+	return 0;
+}
+
+/**
+ * @brief Change the window, the average restarts.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @param window - The new window
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_set_window(struct no_os_dsp_fft *fft,
+			     enum no_os_dsp_fft_window window)
+{
+	if (!fft || window > NO_OS_DSP_FFT_BLACKMAN_HARRIS)
+		return -EINVAL;
+
+	fft->config.window = window;
+	_fft_window(fft);
+
+	return no_os_dsp_fft_reset(fft);
+}
+
+/**
+ * @brief Change the number of frames averaged, the average restarts.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @param averages - The new number of frames, at least 1
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_set_averages(struct no_os_dsp_fft *fft,
+			       unsigned int averages)
+{
+	if (!fft || !averages)
+		return -EINVAL;
+
+	fft->config.averages = averages;
+
+	return no_os_dsp_fft_reset(fft);
+}
+
+/**
+ * @brief Drop the current frame and average.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_reset(struct no_os_dsp_fft *fft)
+{
+	if (!fft)
+		return -EINVAL;
+
+	fft->count = 0;
+	fft->frames = 0;
+	fft->ready = false;
+	memset(fft->acc, 0, fft->config.length / 2 * sizeof(*fft->acc));
+
+	return 0;
+}
+
+/**
+ * @brief Free a spectrum descriptor.
+ * @param fft - Descriptor created with no_os_dsp_fft_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_dsp_fft_remove(struct no_os_dsp_fft *fft)
+{
+	if (!fft)
+		return -EINVAL;
+
+	no_os_free(fft->cos);
+	no_os_free(fft->sin);
+	no_os_free(fft->window);
+	no_os_free(fft->work);
+	no_os_free(fft->acc);
+	no_os_free(fft->bins);
+	no_os_free(fft);
+
+	return 0;
+}
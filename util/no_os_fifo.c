@@ -46,6 +46,7 @@
 #include "no_os_fifo.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -138,3 +139,99 @@ struct no_os_fifo_element * no_os_fifo_remove(struct no_os_fifo_element *p_fifo)
 
 	return p_fifo;
 }
+
+/**
+ * @brief Initialize a ring FIFO.
+ * Unlike the element FIFO, no memory is allocated: data is copied into the
+ * given storage, so insert and read are O(1) and memory use is bounded.
+ * @param ring - Ring FIFO.
+ * @param buff - Storage of the FIFO.
+ * @param size - Storage size in bytes.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int32_t no_os_fifo_ring_init(struct no_os_fifo_ring *ring, char *buff,
+			     uint32_t size)
+{
+	if (!ring || !buff || !size)
+		return -EINVAL;
+
+	ring->buff = buff;
+	ring->size = size;
+	ring->head = 0;
+	ring->len = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Insert a chunk of data at the FIFO tail.
+ * @param ring - Ring FIFO.
+ * @param buff - Data to be saved in fifo.
+ * @param len - Length of the data.
+ * @return 0 in case of success, -ENOSPC if the chunk does not fit,
+ * 	   -EINVAL otherwise.
+ */
+int32_t no_os_fifo_ring_insert(struct no_os_fifo_ring *ring, const char *buff,
+			       uint32_t len)
+{
+	uint32_t tail, first;
+
+	if (!ring || !buff || !len)
+		return -EINVAL;
+
+	if (len > ring->size - ring->len)
+		return -ENOSPC;
+
+	tail = ring->head + ring->len;
+	if (tail >= ring->size)
+		tail -= ring->size;
+
+	first = no_os_min(len, ring->size - tail);
+	memcpy(ring->buff + tail, buff, first);
+	memcpy(ring->buff, buff + first, len - first);
+	ring->len += len;
+
+	return 0;
+}
+
+/**
+ * @brief Read data from the FIFO head.
+ * @param ring - Ring FIFO.
+ * @param buff - Where the data is copied.
+ * @param len - Maximum number of bytes to read.
+ * @return Number of bytes read in case of success, -EINVAL otherwise.
+ */
+int32_t no_os_fifo_ring_read(struct no_os_fifo_ring *ring, char *buff,
+			     uint32_t len)
+{
+	uint32_t first;
+
+	if (!ring || (len && !buff))
+		return -EINVAL;
+
+	len = no_os_min(len, ring->len);
+	first = no_os_min(len, ring->size - ring->head);
+	memcpy(buff, ring->buff + ring->head, first);
+	memcpy(buff + first, ring->buff, len - first);
+
+	ring->head += len;
+	if (ring->head >= ring->size)
+		ring->head -= ring->size;
+	ring->len -= len;
+
+	return len;
+}
+
+/**
+ * @brief Get the number of bytes in the FIFO.
+ * @param ring - Ring FIFO.
+ * @return Number of bytes, 0 for an invalid FIFO.
+ */
+uint32_t no_os_fifo_ring_len(struct no_os_fifo_ring *ring)
+{
+	if (!ring)
+		return 0;
+
+	return ring->len;
+}
+
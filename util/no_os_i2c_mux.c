@@ -0,0 +1,485 @@
+/***************************************************************************//**
+ *   @file   no_os_i2c_mux.c
+ *   @brief  Source file for I2C bus multiplexers with a cached channel selection.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_i2c_mux.h"
+#include "no_os_mutex.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/**
+ * @struct no_os_i2c_mux_chan
+ * @brief Extra of the descriptor of a device behind a multiplexer
+ */
+struct no_os_i2c_mux_chan {
+	/** Multiplexer the device is behind */
+	struct no_os_i2c_mux *mux;
+	/** Downstream channel of the device */
+	uint32_t channel;
+	/** Descriptor of the device on the upstream bus */
+	struct no_os_i2c_desc *parent;
+};
+
+/**
+ * @brief Check if the devices of two sets of channels have common addresses.
+ * @param mux - The multiplexer descriptor.
+ * @param a - First set of channels.
+ * @param b - Second set of channels.
+ * @return true if an address is used in both sets.
+ */
+static bool no_os_i2c_mux_collide(struct no_os_i2c_mux *mux, uint32_t a,
+				  uint32_t b)
+{
+	uint32_t addrs_a[8] = {0};
+	uint32_t addrs_b[8] = {0};
+	uint32_t i, j;
+
+	for (i = 0; i < mux->nb_channels; i++) {
+		for (j = 0; j < 8; j++) {
+			if (a & NO_OS_BIT(i))
+				addrs_a[j] |= mux->addrs[i][j];
+			if (b & NO_OS_BIT(i))
+				addrs_b[j] |= mux->addrs[i][j];
+		}
+	}
+
+	for (j = 0; j < 8; j++)
+		if (addrs_a[j] & addrs_b[j])
+			return true;
+
+	return false;
+}
+
+/**
+ * @brief Write a channel selection, unless it is the cached one.
+ * @param mux - The multiplexer descriptor.
+ * @param mask - Channels to connect.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_i2c_mux_select(struct no_os_i2c_mux *mux, uint32_t mask)
+{
+	int ret;
+
+	if (mux->cached && mux->connected == mask)
+		return 0;
+
+	ret = mux->ops->select(mux, mask);
+	if (ret) {
+		mux->cached = false;
+		return ret;
+	}
+
+	mux->cached = true;
+	mux->connected = mask;
+	mux->switches++;
+
+	return 0;
+}
+
+/**
+ * @brief Connect the channel of a device, keeping the connected channels whose
+ * devices don't collide with it in parallel mode. Called with the bus locked.
+ * @param chan - The device channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_i2c_mux_connect(struct no_os_i2c_mux_chan *chan)
+{
+	struct no_os_i2c_mux *mux = chan->mux;
+	uint32_t mask = NO_OS_BIT(chan->channel);
+
+	if (mux->cached && (mux->connected & mask))
+		return 0;
+
+	if (mux->parallel && mux->cached &&
+	    !no_os_i2c_mux_collide(mux, mux->connected, mask))
+		mask |= mux->connected;
+
+	return no_os_i2c_mux_select(mux, mask);
+}
+
+/**
+ * @brief Initialize a device behind a multiplexer.
+ * @param desc - The I2C descriptor.
+ * @param param - I2C parameters, extra is a no_os_i2c_mux_chan_init_param.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t no_os_i2c_mux_chan_init(struct no_os_i2c_desc **desc,
+				       const struct no_os_i2c_init_param *param)
+{
+	struct no_os_i2c_mux_chan_init_param *cip = param->extra;
+	struct no_os_i2c_init_param parent_param = *param;
+	struct no_os_i2c_mux_chan *chan;
+	struct no_os_i2c_desc *d;
+	int32_t ret;
+
+	if (!cip || !cip->mux || !cip->platform_ops ||
+	    !cip->platform_ops->i2c_ops_init ||
+	    cip->channel >= cip->mux->nb_channels)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	chan = no_os_calloc(1, sizeof(*chan));
+	if (!chan) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	parent_param.platform_ops = cip->platform_ops;
+	parent_param.extra = cip->extra;
+	ret = cip->platform_ops->i2c_ops_init(&chan->parent, &parent_param);
+	if (ret)
+		goto free_chan;
+	chan->parent->platform_ops = cip->platform_ops;
+
+	chan->mux = cip->mux;
+	chan->channel = cip->channel;
+	chan->mux->addrs[chan->channel][param->slave_address / 32] |=
+		NO_OS_BIT(param->slave_address % 32);
+
+	d->device_id = param->device_id;
+	d->max_speed_hz = param->max_speed_hz;
+	d->slave_address = param->slave_address;
+	d->extra = chan;
+	*desc = d;
+
+	return 0;
+
+free_chan:
+	no_os_free(chan);
+free_desc:
+	no_os_free(d);
+
+	return ret;
+}
+
+/**
+ * @brief Write to a device behind a multiplexer, after connecting its channel.
+ * @param desc - The I2C descriptor.
+ * @param data - Data to write.
+ * @param bytes_number - Number of bytes to write.
+ * @param stop_bit - Generate a stop condition at the end.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t no_os_i2c_mux_chan_write(struct no_os_i2c_desc *desc,
+					uint8_t *data, uint8_t bytes_number,
+					uint8_t stop_bit)
+{
+	struct no_os_i2c_mux_chan *chan = desc->extra;
+	int32_t ret;
+
+	if (!chan->parent->platform_ops->i2c_ops_write)
+		return -ENOSYS;
+
+	ret = no_os_i2c_mux_connect(chan);
+	if (ret)
+		return ret;
+
+	return chan->parent->platform_ops->i2c_ops_write(chan->parent, data,
+			bytes_number, stop_bit);
+}
+
+/**
+ * @brief Read from a device behind a multiplexer, after connecting its channel.
+ * @param desc - The I2C descriptor.
+ * @param data - Buffer where to store the read data.
+ * @param bytes_number - Number of bytes to read.
+ * @param stop_bit - Generate a stop condition at the end.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t no_os_i2c_mux_chan_read(struct no_os_i2c_desc *desc,
+				       uint8_t *data, uint8_t bytes_number,
+				       uint8_t stop_bit)
+{
+	struct no_os_i2c_mux_chan *chan = desc->extra;
+	int32_t ret;
+
+	if (!chan->parent->platform_ops->i2c_ops_read)
+		return -ENOSYS;
+
+	ret = no_os_i2c_mux_connect(chan);
+	if (ret)
+		return ret;
+
+	return chan->parent->platform_ops->i2c_ops_read(chan->parent, data,
+			bytes_number, stop_bit);
+}
+
+/**
+ * @brief Transfer a list of messages to a device behind a multiplexer, after
+ * connecting its channel. Upstream buses without combined transfers fall back
+ * to a sequence of reads and writes, as no_os_i2c_transfer() does.
+ * @param desc - The I2C descriptor.
+ * @param msgs - The messages to transfer.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t no_os_i2c_mux_chan_transfer(struct no_os_i2c_desc *desc,
+		struct no_os_i2c_msg *msgs,
+		uint32_t nb_msgs)
+{
+	struct no_os_i2c_mux_chan *chan = desc->extra;
+	const struct no_os_i2c_platform_ops *ops = chan->parent->platform_ops;
+	int32_t ret;
+	uint32_t i;
+
+	if (!ops->i2c_ops_transfer && (!ops->i2c_ops_write || !ops->i2c_ops_read))
+		return -ENOSYS;
+
+	ret = no_os_i2c_mux_connect(chan);
+	if (ret)
+		return ret;
+
+	if (ops->i2c_ops_transfer)
+		return ops->i2c_ops_transfer(chan->parent, msgs, nb_msgs);
+
+	for (i = 0; i < nb_msgs; i++) {
+		if (msgs[i].len > UINT8_MAX)
+			return -EINVAL;
+
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			ret = ops->i2c_ops_read(chan->parent, msgs[i].buf,
+						msgs[i].len, i == nb_msgs - 1);
+		else
+			ret = ops->i2c_ops_write(chan->parent, msgs[i].buf,
+						 msgs[i].len, i == nb_msgs - 1);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources of a device behind a multiplexer.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t no_os_i2c_mux_chan_remove(struct no_os_i2c_desc *desc)
+{
+	struct no_os_i2c_mux_chan *chan = desc->extra;
+	int32_t ret = 0;
+
+	chan->mux->addrs[chan->channel][desc->slave_address / 32] &=
+		~NO_OS_BIT(desc->slave_address % 32);
+
+	if (chan->parent->platform_ops->i2c_ops_remove)
+		ret = chan->parent->platform_ops->i2c_ops_remove(chan->parent);
+
+	no_os_free(chan);
+	no_os_free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Initialize an I2C multiplexer. The first access to a device behind
+ * it writes the channel selection, which is then cached: the following
+ * accesses to devices of the connected channels go straight to the bus.
+ * @param mux - The multiplexer descriptor.
+ * @param param - The multiplexer parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_i2c_mux_init(struct no_os_i2c_mux **mux,
+		       const struct no_os_i2c_mux_init_param *param)
+{
+	struct no_os_i2c_mux *m;
+
+	if (!mux || !param || !param->i2c_desc || !param->ops ||
+	    !param->ops->select || !param->nb_channels ||
+	    param->nb_channels > NO_OS_I2C_MUX_MAX_CHANNELS)
+		return -EINVAL;
+
+	m = no_os_calloc(1, sizeof(*m));
+	if (!m)
+		return -ENOMEM;
+
+	m->i2c_desc = param->i2c_desc;
+	m->nb_channels = param->nb_channels;
+	m->parallel = param->parallel;
+	m->ops = param->ops;
+	m->dev = param->dev;
+	*mux = m;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_i2c_mux_init(). The devices
+ * behind the multiplexer must be removed first.
+ * @param mux - The multiplexer descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_i2c_mux_remove(struct no_os_i2c_mux *mux)
+{
+	if (!mux)
+		return -EINVAL;
+
+	no_os_free(mux);
+
+	return 0;
+}
+
+/**
+ * @brief Write to the multiplexer from its select operation, without locking
+ * the bus again.
+ * @param mux - The multiplexer descriptor.
+ * @param data - Data to write.
+ * @param bytes_number - Number of bytes to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_i2c_mux_write(struct no_os_i2c_mux *mux, uint8_t *data,
+			uint8_t bytes_number)
+{
+	struct no_os_i2c_desc *desc;
+
+	if (!mux || !data)
+		return -EINVAL;
+
+	desc = mux->i2c_desc;
+	if (!desc->platform_ops->i2c_ops_write)
+		return -ENOSYS;
+
+	return desc->platform_ops->i2c_ops_write(desc, data, bytes_number, 1);
+}
+
+/**
+ * @brief Forget the cached channel selection. To be called after the
+ * multiplexer was written without going through its select operation.
+ * @param mux - The multiplexer descriptor.
+ */
+void no_os_i2c_mux_invalidate(struct no_os_i2c_mux *mux)
+{
+	if (mux)
+		mux->cached = false;
+}
+
+/**
+ * @brief Run a list of transfers to devices behind the same multiplexer, with
+ * the bus locked once. The transfers of the connected channels run first,
+ * then the channels are switched in the order they first appear in the list,
+ * connecting in parallel mode all the pending channels whose addresses don't
+ * collide. Transfers of the same channel keep their order.
+ * @param xfers - The transfers, their result is stored in their ret.
+ * @param nb_xfers - Number of transfers.
+ * @return 0 in case of success, the first error otherwise. A failed channel
+ * 	   selection aborts the transfers left.
+ */
+int no_os_i2c_mux_transfer_list(struct no_os_i2c_mux_xfer *xfers,
+				uint32_t nb_xfers)
+{
+	struct no_os_i2c_mux_chan *chan;
+	struct no_os_i2c_mux *mux;
+	void *mutex;
+	uint32_t pending = nb_xfers;
+	uint32_t mask, bit;
+	uint32_t i;
+	int ret = 0;
+	int err;
+
+	if (!xfers || !nb_xfers || !xfers[0].desc || !xfers[0].desc->bus)
+		return -EINVAL;
+
+	mux = ((struct no_os_i2c_mux_chan *)xfers[0].desc->extra)->mux;
+	for (i = 0; i < nb_xfers; i++) {
+		if (!xfers[i].desc ||
+		    xfers[i].desc->platform_ops != &no_os_i2c_mux_platform_ops ||
+		    ((struct no_os_i2c_mux_chan *)xfers[i].desc->extra)->mux != mux ||
+		    !xfers[i].msgs || !xfers[i].nb_msgs)
+			return -EINVAL;
+		xfers[i].ret = -EINPROGRESS;
+	}
+
+	mutex = xfers[0].desc->bus->mutex;
+	no_os_mutex_lock(mutex);
+
+	while (pending) {
+		/* Everything reachable without switching */
+		for (i = 0; i < nb_xfers && mux->cached; i++) {
+			chan = xfers[i].desc->extra;
+			if (xfers[i].ret != -EINPROGRESS ||
+			    !(mux->connected & NO_OS_BIT(chan->channel)))
+				continue;
+
+			xfers[i].ret = no_os_i2c_mux_chan_transfer(xfers[i].desc,
+				       xfers[i].msgs,
+				       xfers[i].nb_msgs);
+			if (xfers[i].ret && !ret)
+				ret = xfers[i].ret;
+			pending--;
+		}
+		if (!pending)
+			break;
+
+		mask = 0;
+		for (i = 0; i < nb_xfers; i++) {
+			chan = xfers[i].desc->extra;
+			bit = NO_OS_BIT(chan->channel);
+			if (xfers[i].ret != -EINPROGRESS || (mask & bit))
+				continue;
+			if (!mask)
+				mask = bit;
+			else if (mux->parallel &&
+				 !no_os_i2c_mux_collide(mux, mask, bit))
+				mask |= bit;
+		}
+
+		err = no_os_i2c_mux_select(mux, mask);
+		if (err) {
+			for (i = 0; i < nb_xfers; i++)
+				if (xfers[i].ret == -EINPROGRESS)
+					xfers[i].ret = err;
+			if (!ret)
+				ret = err;
+			break;
+		}
+	}
+
+	no_os_mutex_unlock(mutex);
+
+	return ret;
+}
+
+const struct no_os_i2c_platform_ops no_os_i2c_mux_platform_ops = {
+	.i2c_ops_init = no_os_i2c_mux_chan_init,
+	.i2c_ops_write = no_os_i2c_mux_chan_write,
+	.i2c_ops_read = no_os_i2c_mux_chan_read,
+	.i2c_ops_transfer = no_os_i2c_mux_chan_transfer,
+	.i2c_ops_remove = no_os_i2c_mux_chan_remove,
+};
@@ -0,0 +1,687 @@
+/***************************************************************************//**
+ *   @file   no_os_kv.c
+ *   @brief  Implementation of the log-structured key/value store on flash.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include <stdbool.h>
+#include "no_os_kv.h"
+#include "no_os_crc32.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+#define NO_OS_KV_MAGIC		0x4E4B5631
+#define NO_OS_KV_ERASED		0xFFFFFFFF
+#define NO_OS_KV_NO_ADDR	0xFFFFFFFF
+/* Page header: magic, sequence number and its complement */
+#define NO_OS_KV_PAGE_HDR	12
+/* Record header: key and length, then CRC */
+#define NO_OS_KV_REC_HDR	8
+#define NO_OS_KV_CRC_POLY	0xEDB88320
+
+#define NO_OS_KV_KEY(w)		((w) & 0xFFFF)
+#define NO_OS_KV_LEN(w)		((w) >> 16)
+
+/**
+ * @brief Bytes taken in flash by a record.
+ * @param len - Size of the value.
+ * @return Record size, a multiple of 4.
+ */
+static uint32_t no_os_kv_rec_size(uint32_t len)
+{
+	return NO_OS_KV_REC_HDR + NO_OS_DIV_ROUND_UP(len, 4) * 4;
+}
+
+/**
+ * @brief Flash address of a page of the store.
+ * @param desc - The store.
+ * @param page - Page of the store.
+ * @return The address.
+ */
+static uint32_t no_os_kv_page_addr(struct no_os_kv_desc *desc, uint32_t page)
+{
+	return desc->start_addr + page * desc->flash->page_size;
+}
+
+/**
+ * @brief Page of the store holding an address.
+ * @param desc - The store.
+ * @param addr - Address in the store.
+ * @return The page.
+ */
+static uint32_t no_os_kv_addr_page(struct no_os_kv_desc *desc, uint32_t addr)
+{
+	return (addr - desc->start_addr) / desc->flash->page_size;
+}
+
+/**
+ * @brief CRC of a record, covering the header word and the value.
+ * @param desc - The store.
+ * @param hdr - First header word.
+ * @param data - The value.
+ * @param len - Size of the value.
+ * @return The CRC.
+ */
+static uint32_t no_os_kv_crc(struct no_os_kv_desc *desc, uint32_t hdr,
+			     const void *data, uint32_t len)
+{
+	uint8_t h[4];
+
+	no_os_put_unaligned_le32(hdr, h);
+
+	return no_os_crc32(desc->crc_table, data, len,
+			   no_os_crc32(desc->crc_table, h, sizeof(h), 0));
+}
+
+/**
+ * @brief Erase a page of the store.
+ * @param desc - The store.
+ * @param page - Page of the store.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_kv_erase(struct no_os_kv_desc *desc, uint32_t page)
+{
+	int ret;
+
+	ret = no_os_flash_clear_page(desc->flash,
+				     no_os_kv_page_addr(desc, page) /
+				     desc->flash->page_size);
+	if (ret)
+		return ret;
+
+	desc->page_seq[page] = NO_OS_KV_ERASED;
+	desc->page_dead[page] = 0;
+	desc->nb_free++;
+
+	return 0;
+}
+
+/**
+ * @brief Mark the current record of a key as outdated.
+ * @param desc - The store.
+ * @param key - The key.
+ */
+static void no_os_kv_drop(struct no_os_kv_desc *desc, uint16_t key)
+{
+	struct no_os_kv_entry *e = &desc->index[key];
+
+	if (e->addr == NO_OS_KV_NO_ADDR)
+		return;
+
+	desc->page_dead[no_os_kv_addr_page(desc, e->addr)] +=
+		no_os_kv_rec_size(e->len);
+	e->addr = NO_OS_KV_NO_ADDR;
+}
+
+/**
+ * @brief Start appending to the next erased page.
+ *
+ * Pages are taken round-robin after the head, which spreads the erase
+ * cycles over the whole store.
+ * @param desc - The store.
+ * @param use_spare - Allow taking the last erased page, kept for compaction.
+ * @return 0 in case of success, -ENOSPC if no page can be taken, negative
+ *	   error code otherwise.
+ */
+static int no_os_kv_open_page(struct no_os_kv_desc *desc, bool use_spare)
+{
+	uint32_t page = 0;
+	uint32_t hdr[3];
+	uint32_t i;
+	int ret;
+
+	if (desc->nb_free <= (use_spare ? 0 : 1))
+		return -ENOSPC;
+
+	for (i = 1; i <= desc->nb_pages; i++) {
+		page = (desc->head + i) % desc->nb_pages;
+		if (desc->page_seq[page] == NO_OS_KV_ERASED)
+			break;
+	}
+
+	hdr[0] = NO_OS_KV_MAGIC;
+	hdr[1] = desc->next_seq;
+	hdr[2] = ~desc->next_seq;
+	ret = no_os_flash_write(desc->flash, no_os_kv_page_addr(desc, page),
+				hdr, NO_OS_ARRAY_SIZE(hdr));
+	if (ret)
+		return ret;
+
+	desc->page_seq[page] = desc->next_seq++;
+	desc->nb_free--;
+	desc->head = page;
+	desc->head_off = NO_OS_KV_PAGE_HDR;
+
+	return 0;
+}
+
+/**
+ * @brief Append a record and point the index to it.
+ * @param desc - The store.
+ * @param key - The key.
+ * @param data - The value, may be in the staging buffer.
+ * @param len - Size of the value, 0 for a deletion.
+ * @param use_spare - Allow taking the page kept for compaction.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_kv_append(struct no_os_kv_desc *desc, uint16_t key,
+			   const void *data, uint16_t len, bool use_spare)
+{
+	uint32_t size = no_os_kv_rec_size(len);
+	uint32_t addr;
+	int ret;
+
+	if (desc->head == desc->nb_pages ||
+	    desc->head_off + size > desc->flash->page_size) {
+		ret = no_os_kv_open_page(desc, use_spare);
+		if (ret)
+			return ret;
+	}
+
+	if (len)
+		memmove(&desc->buf[2], data, len);
+	memset((uint8_t *)&desc->buf[2] + len, 0xFF, size - NO_OS_KV_REC_HDR - len);
+	desc->buf[0] = key | ((uint32_t)len << 16);
+	desc->buf[1] = no_os_kv_crc(desc, desc->buf[0], &desc->buf[2], len);
+
+	addr = no_os_kv_page_addr(desc, desc->head) + desc->head_off;
+	ret = no_os_flash_write(desc->flash, addr, desc->buf, size / 4);
+	/* A failed write may have used the space, skip it either way */
+	desc->head_off += size;
+	if (ret)
+		return ret;
+
+	no_os_kv_drop(desc, key);
+	if (len) {
+		desc->index[key].addr = addr;
+		desc->index[key].len = len;
+	} else {
+		/* Deletions are only needed until older records are erased */
+		desc->page_dead[desc->head] += size;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Move the live records of the oldest page to the head and erase it.
+ * @param desc - The store.
+ * @return 0 in case of success, -ENOSPC if no page holds outdated records,
+ *	   negative error code otherwise.
+ */
+static int no_os_kv_compact(struct no_os_kv_desc *desc)
+{
+	uint32_t oldest = desc->nb_pages;
+	uint32_t dead = 0;
+	struct no_os_kv_entry *e;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < desc->nb_pages; i++) {
+		if (desc->page_seq[i] == NO_OS_KV_ERASED)
+			continue;
+		dead += desc->page_dead[i];
+		if (oldest == desc->nb_pages ||
+		    desc->page_seq[i] < desc->page_seq[oldest])
+			oldest = i;
+	}
+
+	/* Moving pages around would not free anything */
+	if (oldest == desc->nb_pages || !dead)
+		return -ENOSPC;
+
+	if (oldest == desc->head)
+		desc->head_off = desc->flash->page_size;
+
+	for (i = 0; i < desc->nb_keys; i++) {
+		e = &desc->index[i];
+		if (e->addr == NO_OS_KV_NO_ADDR ||
+		    no_os_kv_addr_page(desc, e->addr) != oldest)
+			continue;
+
+		ret = no_os_flash_read(desc->flash, e->addr + NO_OS_KV_REC_HDR,
+				       &desc->buf[2], NO_OS_DIV_ROUND_UP(e->len, 4));
+		if (ret)
+			return ret;
+
+		ret = no_os_kv_append(desc, i, &desc->buf[2], e->len, true);
+		if (ret)
+			return ret;
+	}
+
+	return no_os_kv_erase(desc, oldest);
+}
+
+/**
+ * @brief Replay the records of a page into the index.
+ * @param desc - The store.
+ * @param page - Page of the store.
+ * @return Offset after the last valid record, the page size if the page
+ *	   ends with a damaged record. Negative error code on read failure.
+ */
+static int32_t no_os_kv_replay(struct no_os_kv_desc *desc, uint32_t page)
+{
+	uint32_t base = no_os_kv_page_addr(desc, page);
+	uint32_t off = NO_OS_KV_PAGE_HDR;
+	uint32_t size;
+	uint16_t key;
+	uint16_t len;
+	int ret;
+
+	while (off + NO_OS_KV_REC_HDR <= desc->flash->page_size) {
+		ret = no_os_flash_read(desc->flash, base + off, desc->buf, 2);
+		if (ret)
+			return ret;
+		if (desc->buf[0] == NO_OS_KV_ERASED)
+			return off;
+
+		key = NO_OS_KV_KEY(desc->buf[0]);
+		len = NO_OS_KV_LEN(desc->buf[0]);
+		size = no_os_kv_rec_size(len);
+		if (len > desc->max_value_size ||
+		    off + size > desc->flash->page_size)
+			break;
+
+		ret = no_os_flash_read(desc->flash, base + off + NO_OS_KV_REC_HDR,
+				       &desc->buf[2], NO_OS_DIV_ROUND_UP(len, 4));
+		if (ret)
+			return ret;
+		/* Torn write, nothing after it can be trusted */
+		if (no_os_kv_crc(desc, desc->buf[0], &desc->buf[2], len) !=
+		    desc->buf[1])
+			break;
+
+		if (key < desc->nb_keys)
+			no_os_kv_drop(desc, key);
+		if (key < desc->nb_keys && len) {
+			desc->index[key].addr = base + off;
+			desc->index[key].len = len;
+		} else {
+			desc->page_dead[page] += size;
+		}
+		off += size;
+	}
+
+	desc->page_dead[page] += desc->flash->page_size - off;
+
+	return desc->flash->page_size;
+}
+
+/**
+ * @brief Check that a page without header is fully erased.
+ * @param desc - The store.
+ * @param page - Page of the store.
+ * @return 1 if erased, 0 if not, negative error code on read failure.
+ */
+static int no_os_kv_is_erased(struct no_os_kv_desc *desc, uint32_t page)
+{
+	uint32_t words = 2 + NO_OS_DIV_ROUND_UP(desc->max_value_size, 4);
+	uint32_t addr = no_os_kv_page_addr(desc, page);
+	uint32_t end = addr + desc->flash->page_size;
+	uint32_t n;
+	uint32_t i;
+	int ret;
+
+	for (; addr < end; addr += n * 4) {
+		n = no_os_min(words, (end - addr) / 4);
+		ret = no_os_flash_read(desc->flash, addr, desc->buf, n);
+		if (ret)
+			return ret;
+		for (i = 0; i < n; i++)
+			if (desc->buf[i] != NO_OS_KV_ERASED)
+				return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief Build the index from the records in flash.
+ *
+ * Pages are replayed from the oldest to the newest so the last record of a
+ * key wins. Pages without a valid header that are not erased, like those
+ * left by an interrupted erase, are erased again.
+ * @param desc - The store.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_kv_mount(struct no_os_kv_desc *desc)
+{
+	uint32_t last_seq = 0;
+	uint32_t page;
+	uint32_t min;
+	int32_t off;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < desc->nb_keys; i++)
+		desc->index[i].addr = NO_OS_KV_NO_ADDR;
+
+	desc->head = desc->nb_pages;
+	desc->head_off = 0;
+	desc->next_seq = 0;
+	desc->nb_free = 0;
+
+	for (page = 0; page < desc->nb_pages; page++) {
+		desc->page_dead[page] = 0;
+
+		ret = no_os_flash_read(desc->flash, no_os_kv_page_addr(desc, page),
+				       desc->buf, 3);
+		if (ret)
+			return ret;
+
+		/* A torn header write leaves a sequence that fails the check */
+		if (desc->buf[0] == NO_OS_KV_MAGIC &&
+		    desc->buf[1] == ~desc->buf[2]) {
+			desc->page_seq[page] = desc->buf[1];
+			continue;
+		}
+
+		desc->page_seq[page] = NO_OS_KV_ERASED;
+		ret = desc->buf[0] == NO_OS_KV_ERASED ?
+		      no_os_kv_is_erased(desc, page) : 0;
+		if (ret < 0)
+			return ret;
+		if (ret) {
+			desc->nb_free++;
+			continue;
+		}
+		ret = no_os_kv_erase(desc, page);
+		if (ret)
+			return ret;
+	}
+
+	/* Replay in sequence order, the newest page becomes the head */
+	for (i = 0; i < desc->nb_pages - desc->nb_free; i++) {
+		min = desc->nb_pages;
+		for (page = 0; page < desc->nb_pages; page++) {
+			if (desc->page_seq[page] == NO_OS_KV_ERASED ||
+			    (i && desc->page_seq[page] <= last_seq))
+				continue;
+			if (min == desc->nb_pages ||
+			    desc->page_seq[page] < desc->page_seq[min])
+				min = page;
+		}
+
+		last_seq = desc->page_seq[min];
+		off = no_os_kv_replay(desc, min);
+		if (off < 0)
+			return off;
+		desc->head = min;
+		desc->head_off = off;
+		desc->next_seq = last_seq + 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Finish a compaction interrupted by a reset.
+ *
+ * Only compaction takes the last erased page. If none is left, the newest
+ * page holds copies of the oldest one. If every live record was copied the
+ * oldest page is erased, otherwise the partial copy is.
+ * @param desc - The store.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_kv_recover(struct no_os_kv_desc *desc)
+{
+	uint32_t oldest = 0;
+	uint32_t page;
+	uint32_t i;
+
+	for (page = 1; page < desc->nb_pages; page++)
+		if (desc->page_seq[page] < desc->page_seq[oldest])
+			oldest = page;
+
+	for (i = 0; i < desc->nb_keys; i++)
+		if (desc->index[i].addr != NO_OS_KV_NO_ADDR &&
+		    no_os_kv_addr_page(desc, desc->index[i].addr) == oldest)
+			return no_os_kv_erase(desc, desc->head);
+
+	return no_os_kv_erase(desc, oldest);
+}
+
+/**
+ * @brief Mount a store, building the index from the records in flash.
+ *
+ * Flash that never held a store is used as is if erased, otherwise it is
+ * erased.
+ * @param desc - The store.
+ * @param param - The store parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_kv_init(struct no_os_kv_desc **desc,
+		  const struct no_os_kv_init_param *param)
+{
+	struct no_os_kv_desc *d;
+	int ret;
+
+	if (!desc || !param || !param->flash || param->nb_pages < 2 ||
+	    !param->nb_keys || !param->max_value_size ||
+	    !param->flash->page_size ||
+	    param->start_addr % param->flash->page_size ||
+	    NO_OS_KV_PAGE_HDR + no_os_kv_rec_size(param->max_value_size) >
+	    param->flash->page_size)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->flash = param->flash;
+	d->start_addr = param->start_addr;
+	d->nb_pages = param->nb_pages;
+	d->nb_keys = param->nb_keys;
+	d->max_value_size = param->max_value_size;
+	d->gc_free_pages = param->gc_free_pages ? param->gc_free_pages :
+			   NO_OS_KV_GC_FREE_PAGES;
+
+	d->crc_table = no_os_crc32_get_table(NO_OS_KV_CRC_POLY);
+	d->index = no_os_calloc(d->nb_keys, sizeof(*d->index));
+	d->page_seq = no_os_calloc(d->nb_pages, sizeof(*d->page_seq));
+	d->page_dead = no_os_calloc(d->nb_pages, sizeof(*d->page_dead));
+	d->buf = no_os_calloc(2 + NO_OS_DIV_ROUND_UP(d->max_value_size, 4),
+			      sizeof(*d->buf));
+	if (!d->crc_table || !d->index || !d->page_seq || !d->page_dead ||
+	    !d->buf) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	ret = no_os_kv_mount(d);
+	if (ret)
+		goto error;
+
+	if (!d->nb_free) {
+		ret = no_os_kv_recover(d);
+		if (ret)
+			goto error;
+
+		ret = no_os_kv_mount(d);
+		if (ret)
+			goto error;
+	}
+
+	*desc = d;
+
+	return 0;
+
+error:
+	no_os_kv_remove(d);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_kv_init().
+ * @param desc - The store.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int no_os_kv_remove(struct no_os_kv_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->buf);
+	no_os_free(desc->page_dead);
+	no_os_free(desc->page_seq);
+	no_os_free(desc->index);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Read the value of a key, located through the RAM index.
+ * @param desc - The store.
+ * @param key - The key.
+ * @param data - Buffer receiving the value.
+ * @param size - Size of the buffer.
+ * @param len - Size of the value, may be NULL.
+ * @return 0 in case of success, -ENOENT if the key is not set, -EOVERFLOW
+ *	   if the buffer is too small (len is still set), negative error code
+ *	   otherwise.
+ */
+int no_os_kv_read(struct no_os_kv_desc *desc, uint16_t key, void *data,
+		  uint16_t size, uint16_t *len)
+{
+	struct no_os_kv_entry *e;
+	int ret;
+
+	if (!desc || key >= desc->nb_keys || (!data && size))
+		return -EINVAL;
+
+	e = &desc->index[key];
+	if (e->addr == NO_OS_KV_NO_ADDR)
+		return -ENOENT;
+
+	if (len)
+		*len = e->len;
+	if (size < e->len)
+		return -EOVERFLOW;
+
+	ret = no_os_flash_read(desc->flash, e->addr + NO_OS_KV_REC_HDR,
+			       desc->buf, NO_OS_DIV_ROUND_UP(e->len, 4));
+	if (ret)
+		return ret;
+
+	memcpy(data, desc->buf, e->len);
+
+	return 0;
+}
+
+/**
+ * @brief Append a new value of a key.
+ *
+ * The record goes after the previous ones, so no page is erased unless the
+ * store is full, in which case pages are compacted first.
+ * @param desc - The store.
+ * @param key - The key.
+ * @param data - The value.
+ * @param len - Size of the value, 1 to max_value_size.
+ * @return 0 in case of success, -ENOSPC if the live values fill the store,
+ *	   negative error code otherwise.
+ */
+int no_os_kv_write(struct no_os_kv_desc *desc, uint16_t key,
+		   const void *data, uint16_t len)
+{
+	int ret;
+
+	if (!desc || key >= desc->nb_keys || !data || !len ||
+	    len > desc->max_value_size)
+		return -EINVAL;
+
+	while (1) {
+		ret = no_os_kv_append(desc, key, data, len, false);
+		if (ret != -ENOSPC)
+			return ret;
+
+		ret = no_os_kv_compact(desc);
+		if (ret)
+			return ret;
+	}
+}
+
+/**
+ * @brief Delete a key.
+ * @param desc - The store.
+ * @param key - The key.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_kv_delete(struct no_os_kv_desc *desc, uint16_t key)
+{
+	int ret;
+
+	if (!desc || key >= desc->nb_keys)
+		return -EINVAL;
+
+	if (desc->index[key].addr == NO_OS_KV_NO_ADDR)
+		return 0;
+
+	while (1) {
+		ret = no_os_kv_append(desc, key, NULL, 0, false);
+		if (ret != -ENOSPC)
+			return ret;
+
+		ret = no_os_kv_compact(desc);
+		if (ret)
+			return ret;
+	}
+}
+
+/**
+ * @brief Compact at most one page when free pages run low.
+ *
+ * Meant for the idle loop, so that no_os_kv_write() rarely has to erase.
+ * @param desc - The store.
+ * @return 0 if nothing had to be done or a page was compacted, negative
+ *	   error code otherwise.
+ */
+int no_os_kv_gc(struct no_os_kv_desc *desc)
+{
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->nb_free >= desc->gc_free_pages)
+		return 0;
+
+	ret = no_os_kv_compact(desc);
+
+	return ret == -ENOSPC ? 0 : ret;
+}
@@ -38,6 +38,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <errno.h>
+#include <string.h>
 #include "no_os_lf256fifo.h"
 #include "no_os_alloc.h"
 
@@ -114,6 +115,36 @@ int lf256fifo_read(struct lf256fifo * fifo, uint8_t *c)
 	return 0;
 }
 
+/**
+* @brief Read multiple chars from fifo.
+* @param fifo - pointer to fifo descriptor.
+* @param buf - pointer to memory where the chars are read.
+* @param len - maximum number of chars to read.
+* @return number of chars read, 0 if buffer empty.
+*/
+uint32_t lf256fifo_read_bulk(struct lf256fifo *fifo, uint8_t *buf,
+			     uint32_t len)
+{
+	uint8_t fempty = fifo->fempty;
+	uint32_t n, i = 0;
+
+	while (i < len && fifo->ffilled != fempty) {
+		/* Contiguous data until fempty or the end of the buffer */
+		if (fempty > fifo->ffilled)
+			n = fempty - fifo->ffilled;
+		else
+			n = 256 - fifo->ffilled;
+		if (n > len - i)
+			n = len - i;
+
+		memcpy(buf + i, fifo->data + fifo->ffilled, n);
+		fifo->ffilled += n; // intended overflow at 256 (data size is 256)
+		i += n;
+	}
+
+	return i;
+}
+
 /**
 * @brief Write char to fifo.
 * @param fifo - pointer to fifo descriptor.
@@ -0,0 +1,295 @@
+/***************************************************************************//**
+ *   @file   no_os_lfring.c
+ *   @brief  Lock-free ring of fixed size elements with SPSC and MPSC variants.
+********************************************************************************
+ *   @copyright
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+#include "no_os_lfring.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/* Positions shared between producers and consumer */
+#define lfring_load(p)		__atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define lfring_store(p, v)	__atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+static inline bool lfring_is_pow2(uint32_t n)
+{
+	return n && !(n & (n - 1));
+}
+
+/* Copy nb elements to the ring starting with position pos. */
+static void lfring_copy_in(struct no_os_lfring *ring, uint32_t pos,
+			   const uint8_t *src, uint32_t nb)
+{
+	uint32_t idx = pos & ring->mask;
+	uint32_t first = no_os_min(nb, ring->mask + 1 - idx);
+
+	memcpy(ring->data + idx * ring->elem_size, src, first * ring->elem_size);
+	memcpy(ring->data, src + first * ring->elem_size,
+	       (nb - first) * ring->elem_size);
+}
+
+/* Copy nb elements from the ring starting with position pos. */
+static void lfring_copy_out(struct no_os_lfring *ring, uint32_t pos,
+			    uint8_t *dst, uint32_t nb)
+{
+	uint32_t idx = pos & ring->mask;
+	uint32_t first = no_os_min(nb, ring->mask + 1 - idx);
+
+	if (!dst)
+		return;
+
+	memcpy(dst, ring->data + idx * ring->elem_size, first * ring->elem_size);
+	memcpy(dst + first * ring->elem_size, ring->data,
+	       (nb - first) * ring->elem_size);
+}
+
+/**
+ * @brief Initialize and allocate a lock-free ring.
+ * @param ring - Pointer to a ring descriptor pointer.
+ * @param elem_size - Size of an element in bytes.
+ * @param depth - Number of elements. Must be a power of two.
+ * @param mpsc - Allow several producers.
+ * @return 0 if successful, negative error code otherwise.
+ */
+int no_os_lfring_init(struct no_os_lfring **ring, uint32_t elem_size,
+		      uint32_t depth, bool mpsc)
+{
+	struct no_os_lfring *r;
+	uint32_t i;
+
+	if (!ring || !elem_size || !lfring_is_pow2(depth))
+		return -EINVAL;
+
+	r = no_os_calloc(1, sizeof(*r));
+	if (!r)
+		return -ENOMEM;
+
+	r->data = no_os_calloc(depth, elem_size);
+	if (!r->data)
+		goto error;
+
+	if (mpsc) {
+		r->seq = no_os_calloc(depth, sizeof(*r->seq));
+		if (!r->seq)
+			goto error;
+		for (i = 0; i < depth; i++)
+			r->seq[i] = i;
+	}
+
+	r->elem_size = elem_size;
+	r->mask = depth - 1;
+	r->mpsc = mpsc;
+	r->allocated = true;
+	*ring = r;
+
+	return 0;
+error:
+	no_os_free(r->data);
+	no_os_free(r);
+
+	return -ENOMEM;
+}
+
+/**
+ * @brief Initialize a SPSC ring using user provided memory.
+ * @param ring - Ring descriptor.
+ * @param buf - Memory of depth * elem_size bytes.
+ * @param elem_size - Size of an element in bytes.
+ * @param depth - Number of elements. Must be a power of two.
+ * @return 0 if successful, negative error code otherwise.
+ */
+int no_os_lfring_cfg(struct no_os_lfring *ring, void *buf, uint32_t elem_size,
+		     uint32_t depth)
+{
+	if (!ring || !buf || !elem_size || !lfring_is_pow2(depth))
+		return -EINVAL;
+
+	memset(ring, 0, sizeof(*ring));
+	ring->data = buf;
+	ring->elem_size = elem_size;
+	ring->mask = depth - 1;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_lfring_init.
+ * @param ring - Ring descriptor.
+ * @return void
+ */
+void no_os_lfring_remove(struct no_os_lfring *ring)
+{
+	if (!ring || !ring->allocated)
+		return;
+
+	no_os_free(ring->seq);
+	no_os_free(ring->data);
+	no_os_free(ring);
+}
+
+/*
+ * MPSC push of a single element. Each slot has a sequence number telling if
+ * it is free for position pos (seq == pos) or holds the element of position
+ * pos (seq == pos + 1), so producers never wait for each other.
+ */
+static bool lfring_mpsc_push_one(struct no_os_lfring *ring, const uint8_t *src)
+{
+	uint32_t pos, seq, idx;
+	int32_t dif;
+
+	pos = lfring_load(&ring->head);
+	while (true) {
+		idx = pos & ring->mask;
+		seq = lfring_load(&ring->seq[idx]);
+		dif = (int32_t)(seq - pos);
+		if (dif < 0)
+			/* Full */
+			return false;
+		if (dif == 0 &&
+		    __atomic_compare_exchange_n(&ring->head, &pos, pos + 1, false,
+						__ATOMIC_ACQ_REL,
+						__ATOMIC_ACQUIRE))
+			break;
+		if (dif > 0)
+			pos = lfring_load(&ring->head);
+	}
+
+	memcpy(ring->data + idx * ring->elem_size, src, ring->elem_size);
+	lfring_store(&ring->seq[idx], pos + 1);
+
+	return true;
+}
+
+/**
+ * @brief Push elements to the ring.
+ * @param ring - Ring descriptor.
+ * @param elems - Elements to push.
+ * @param nb_elems - Number of elements to push.
+ * @return Number of pushed elements. Less than nb_elems if the ring is full.
+ */
+uint32_t no_os_lfring_push(struct no_os_lfring *ring, const void *elems,
+			   uint32_t nb_elems)
+{
+	const uint8_t *src = elems;
+	uint32_t head, tail, i;
+
+	if (!ring || !elems)
+		return 0;
+
+	if (ring->mpsc) {
+		for (i = 0; i < nb_elems; i++)
+			if (!lfring_mpsc_push_one(ring, src + i * ring->elem_size))
+				break;
+
+		return i;
+	}
+
+	head = ring->head;
+	tail = lfring_load(&ring->tail);
+	nb_elems = no_os_min(nb_elems, ring->mask + 1 - (head - tail));
+
+	lfring_copy_in(ring, head, src, nb_elems);
+	lfring_store(&ring->head, head + nb_elems);
+
+	return nb_elems;
+}
+
+/**
+ * @brief Pop elements from the ring.
+ * @param ring - Ring descriptor.
+ * @param elems - Where to store the elements. If NULL they are dropped.
+ * @param nb_elems - Maximum number of elements to pop.
+ * @return Number of popped elements. Less than nb_elems if the ring is empty.
+ */
+uint32_t no_os_lfring_pop(struct no_os_lfring *ring, void *elems,
+			  uint32_t nb_elems)
+{
+	uint8_t *dst = elems;
+	uint32_t head, tail, idx, i;
+
+	if (!ring)
+		return 0;
+
+	tail = ring->tail;
+	if (ring->mpsc) {
+		for (i = 0; i < nb_elems; i++) {
+			idx = (tail + i) & ring->mask;
+			if (lfring_load(&ring->seq[idx]) != tail + i + 1)
+				break;
+			lfring_copy_out(ring, tail + i,
+					dst ? dst + i * ring->elem_size : NULL, 1);
+			lfring_store(&ring->seq[idx], tail + i + ring->mask + 1);
+		}
+		lfring_store(&ring->tail, tail + i);
+
+		return i;
+	}
+
+	head = lfring_load(&ring->head);
+	nb_elems = no_os_min(nb_elems, head - tail);
+
+	lfring_copy_out(ring, tail, dst, nb_elems);
+	lfring_store(&ring->tail, tail + nb_elems);
+
+	return nb_elems;
+}
+
+/**
+ * @brief Get the number of elements in the ring.
+ * @param ring - Ring descriptor.
+ * @return Number of elements. For MPSC rings it includes elements that are
+ * still being pushed.
+ */
+uint32_t no_os_lfring_count(struct no_os_lfring *ring)
+{
+	if (!ring)
+		return 0;
+
+	return lfring_load(&ring->head) - lfring_load(&ring->tail);
+}
+
+/**
+ * @brief Drop all the elements of the ring.
+ * @param ring - Ring descriptor.
+ * @return void
+ */
+void no_os_lfring_flush(struct no_os_lfring *ring)
+{
+	no_os_lfring_pop(ring, NULL, UINT32_MAX);
+}
@@ -0,0 +1,165 @@
+/***************************************************************************//**
+ *   @file   no_os_log.c
+ *   @brief  Implementation of the deferred binary log.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include "no_os_log.h"
+#include "no_os_lfring.h"
+#include "no_os_util.h"
+
+/* Queue of the records, NULL until no_os_log_init() */
+static struct no_os_lfring *no_os_log_ring;
+/* Records lost because the queue was full */
+static uint32_t no_os_log_dropped;
+
+/**
+ * @brief Allocate the queue of the deferred log.
+ * @param depth - Number of records, must be a power of two.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_log_init(uint32_t depth)
+{
+	if (no_os_log_ring)
+		return -EBUSY;
+
+	/* Several interrupt priorities may log at the same time */
+	return NO_OS_LFRING_INIT(&no_os_log_ring, struct no_os_log_record,
+				 depth, true);
+}
+
+/**
+ * @brief Free the queue of the deferred log.
+ */
+void no_os_log_remove(void)
+{
+	struct no_os_lfring *ring = no_os_log_ring;
+
+	no_os_log_ring = NULL;
+	no_os_lfring_remove(ring);
+}
+
+/**
+ * @brief Queue a record. Called by NO_OS_LOG().
+ *
+ * Only copies the arguments, so it can be used from interrupt handlers and
+ * the sample path. A record that does not fit is counted as dropped.
+ * @param fmt - ID of the format.
+ * @param args - Arguments converted to words.
+ * @param nargs - Number of arguments.
+ */
+void no_os_log_push(uint32_t fmt, const uint32_t *args, uint32_t nargs)
+{
+	struct no_os_log_record rec;
+	uint32_t i;
+
+	if (!no_os_log_ring)
+		return;
+
+	rec.fmt = fmt;
+	rec.nargs = nargs;
+	for (i = 0; i < nargs; i++)
+		rec.args[i] = args[i];
+
+	if (!no_os_lfring_push(no_os_log_ring, &rec, 1))
+		__atomic_fetch_add(&no_os_log_dropped, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Send a record as NO_OS_LOG_SYNC, nargs, the format ID and the
+ * arguments, all little endian.
+ * @param rec - The record.
+ * @param write - Output function.
+ * @param ctx - Output function context.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_log_send(const struct no_os_log_record *rec,
+			  int32_t (*write)(void *ctx, const void *buf,
+					   uint32_t len), void *ctx)
+{
+	uint8_t frame[6 + NO_OS_LOG_MAX_ARGS * 4];
+	uint32_t i;
+	int32_t ret;
+
+	frame[0] = NO_OS_LOG_SYNC;
+	frame[1] = rec->nargs;
+	no_os_put_unaligned_le32(rec->fmt, &frame[2]);
+	for (i = 0; i < rec->nargs; i++)
+		no_os_put_unaligned_le32(rec->args[i], &frame[6 + i * 4]);
+
+	ret = write(ctx, frame, 6 + rec->nargs * 4);
+
+	return ret < 0 ? ret : 0;
+}
+
+/**
+ * @brief Send the queued records.
+ *
+ * Meant for the main loop or a low priority task. The records are decoded
+ * by tools/scripts/no_os_log_decode.py using the ELF file of the build.
+ * Lost records are reported by a NO_OS_LOG_DROPPED_ID record.
+ * @param write - Output function, e.g. a wrapper of no_os_uart_write().
+ * @param ctx - Output function context.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_log_drain(int32_t (*write)(void *ctx, const void *buf,
+				     uint32_t len), void *ctx)
+{
+	struct no_os_log_record rec;
+	int ret;
+
+	if (!write)
+		return -EINVAL;
+
+	if (!no_os_log_ring)
+		return -ENODEV;
+
+	while (no_os_lfring_pop(no_os_log_ring, &rec, 1)) {
+		ret = no_os_log_send(&rec, write, ctx);
+		if (ret)
+			return ret;
+	}
+
+	rec.nargs = 1;
+	rec.args[0] = __atomic_exchange_n(&no_os_log_dropped, 0,
+					  __ATOMIC_RELAXED);
+	if (!rec.args[0])
+		return 0;
+
+	rec.fmt = NO_OS_LOG_DROPPED_ID;
+
+	return no_os_log_send(&rec, write, ctx);
+}
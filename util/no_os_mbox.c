@@ -0,0 +1,169 @@
+/***************************************************************************//**
+ *   @file   no_os_mbox.c
+ *   @brief  Shared memory inter-core mailbox.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include "no_os_mbox.h"
+
+/* Fields shared with the other core */
+#define mbox_load(p)		__atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define mbox_store(p, v)	__atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+/**
+ * @brief Initialize the mailbox, from the core that owns it, before the other
+ * core is started or while it waits in no_os_mbox_attach().
+ * @param mbox - Mailbox, in memory shared by the two cores.
+ * @param ep - Endpoint of this core.
+ * @param to_remote_buf - Shared memory of depth elements for the ring to the
+ * remote core.
+ * @param to_owner_buf - Shared memory of depth elements for the ring to this
+ * core.
+ * @param elem_size - Size of an element in bytes.
+ * @param depth - Elements of each ring, must be a power of two.
+ * @return 0 on success, negative error code otherwise.
+ */
+int no_os_mbox_init(struct no_os_mbox *mbox, struct no_os_mbox_ep *ep,
+		    void *to_remote_buf, void *to_owner_buf,
+		    uint32_t elem_size, uint32_t depth)
+{
+	int ret;
+
+	if (!mbox || !ep)
+		return -EINVAL;
+
+	mbox_store(&mbox->magic, 0);
+	mbox_store(&mbox->attached, 0);
+
+	ret = no_os_lfring_cfg(&mbox->to_remote, to_remote_buf, elem_size,
+			       depth);
+	if (ret)
+		return ret;
+
+	ret = no_os_lfring_cfg(&mbox->to_owner, to_owner_buf, elem_size, depth);
+	if (ret)
+		return ret;
+
+	ep->tx = &mbox->to_remote;
+	ep->rx = &mbox->to_owner;
+
+	/* Publishes the rings to the remote core */
+	mbox_store(&mbox->magic, NO_OS_MBOX_MAGIC);
+
+	return 0;
+}
+
+/**
+ * @brief Attach to a mailbox from the remote core.
+ * @param mbox - Mailbox, in memory shared by the two cores.
+ * @param ep - Endpoint of this core.
+ * @return 0 on success, -EAGAIN while the owner core did not initialize the
+ * mailbox, negative error code otherwise.
+ */
+int no_os_mbox_attach(struct no_os_mbox *mbox, struct no_os_mbox_ep *ep)
+{
+	if (!mbox || !ep)
+		return -EINVAL;
+
+	if (mbox_load(&mbox->magic) != NO_OS_MBOX_MAGIC)
+		return -EAGAIN;
+
+	ep->tx = &mbox->to_owner;
+	ep->rx = &mbox->to_remote;
+	mbox_store(&mbox->attached, 1);
+
+	return 0;
+}
+
+/**
+ * @brief Check whether the remote core attached, from the owner core.
+ * @param mbox - Mailbox.
+ * @return true once no_os_mbox_attach() succeeded on the remote core.
+ */
+bool no_os_mbox_attached(struct no_os_mbox *mbox)
+{
+	return mbox && mbox_load(&mbox->attached);
+}
+
+/**
+ * @brief Send elements to the other core and ring its doorbell.
+ * @param ep - Endpoint of this core.
+ * @param elems - Elements to send.
+ * @param nb - Number of elements.
+ * @return The number of elements sent, lower than nb if the ring is full.
+ */
+uint32_t no_os_mbox_send(struct no_os_mbox_ep *ep, const void *elems,
+			 uint32_t nb)
+{
+	uint32_t sent;
+
+	if (!ep || !ep->tx)
+		return 0;
+
+	sent = no_os_lfring_push(ep->tx, elems, nb);
+	if (sent && ep->doorbell)
+		ep->doorbell(ep->doorbell_ctx);
+
+	return sent;
+}
+
+/**
+ * @brief Receive elements sent by the other core.
+ * @param ep - Endpoint of this core.
+ * @param elems - Received elements, NULL to drop them.
+ * @param nb - Maximum number of elements.
+ * @return The number of elements received.
+ */
+uint32_t no_os_mbox_recv(struct no_os_mbox_ep *ep, void *elems, uint32_t nb)
+{
+	if (!ep || !ep->rx)
+		return 0;
+
+	return no_os_lfring_pop(ep->rx, elems, nb);
+}
+
+/**
+ * @brief Number of elements sent by the other core and not received yet.
+ * @param ep - Endpoint of this core.
+ * @return The number of elements.
+ */
+uint32_t no_os_mbox_count(struct no_os_mbox_ep *ep)
+{
+	if (!ep || !ep->rx)
+		return 0;
+
+	return no_os_lfring_count(ep->rx);
+}
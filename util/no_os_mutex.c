@@ -67,3 +67,89 @@ __attribute((weak)) inline void no_os_mutex_unlock(void *mutex) {}
  */
 __attribute__((weak)) inline void no_os_mutex_remove(void *mutex) {}
 
+
+/**
+ * @brief Enter a critical section.
+ * @return The interrupt state before entering the critical section.
+ */
+__attribute__((weak)) uint32_t no_os_critical_enter(void)
+{
+	uint32_t state = 0;
+
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || \
+	defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || \
+	defined(__ARM_ARCH_8M_BASE__)
+	__asm volatile("mrs %0, primask\n"
+		       "cpsid i" : "=r"(state) : : "memory");
+#endif
+
+	return state;
+}
+
+/**
+ * @brief Exit a critical section.
+ * @param state - The value returned by no_os_critical_enter().
+ * @return None.
+ */
+__attribute__((weak)) void no_os_critical_exit(uint32_t state)
+{
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || \
+	defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || \
+	defined(__ARM_ARCH_8M_BASE__)
+	__asm volatile("msr primask, %0" : : "r"(state) : "memory");
+#else
+	(void)state;
+#endif
+}
+
+/**
+ * @brief Sleep until an interrupt is pending.
+ * @return None.
+ */
+__attribute__((weak)) void no_os_wait_for_interrupt(void)
+{
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || \
+	defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || \
+	defined(__ARM_ARCH_8M_BASE__)
+	__asm volatile("dsb\n"
+		       "wfi" : : : "memory");
+#endif
+}
+
+/**
+ * @brief Take a spinlock with the interrupts masked.
+ * @param lock - The spinlock.
+ * @return The interrupt state to pass to no_os_spin_unlock_irqrestore().
+ */
+uint32_t no_os_spin_lock_irqsave(struct no_os_spinlock *lock)
+{
+	uint32_t state = no_os_critical_enter();
+
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+	/* Single core without exclusive access, masking is enough. */
+	lock->locked = true;
+#else
+	/* Other cores may still contend for the lock. */
+	while (__atomic_test_and_set((void *)&lock->locked, __ATOMIC_ACQUIRE))
+		;
+#endif
+
+	return state;
+}
+
+/**
+ * @brief Release a spinlock taken with no_os_spin_lock_irqsave().
+ * @param lock - The spinlock.
+ * @param state - The value returned by no_os_spin_lock_irqsave().
+ * @return None.
+ */
+void no_os_spin_unlock_irqrestore(struct no_os_spinlock *lock, uint32_t state)
+{
+#if defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_BASE__)
+	lock->locked = false;
+#else
+	__atomic_clear((void *)&lock->locked, __ATOMIC_RELEASE);
+#endif
+
+	no_os_critical_exit(state);
+}
@@ -37,9 +37,12 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <errno.h>
+#include <stdbool.h>
 #include "no_os_pid.h"
 #include "no_os_alloc.h"
 #include "no_os_print_log.h"
+#include "no_os_section.h"
+#include "no_os_util.h"
 
 struct no_os_pid {
 	int iacc; // integral accumulator
@@ -48,6 +51,19 @@ struct no_os_pid {
 	struct no_os_pid_config config; // copy of the user-provided configuration
 };
 
+// loops of a bank, one array per field so the update walks them in sequence
+struct no_os_pid_bank {
+	unsigned int nb_loops;
+	bool primed; // prev_pv holds the process variables of the last update
+	int32_t *Kp;
+	int32_t *Ki;
+	int32_t *Kd;
+	int32_t *iacc; // integral component in Q30, within the output limits
+	int16_t *out_min;
+	int16_t *out_max;
+	int16_t *prev_pv;
+};
+
 /**
  * @brief Initialize a PID controller with given configuration
  * @param pid - Double pointer to a PID descriptor that the function allocates
@@ -206,3 +222,180 @@ int no_os_pid_remove(struct no_os_pid *pid)
 
 	return 0;
 }
+
+/**
+ * @brief Initialize a bank of fixed point PID loops, updated together by
+ * no_os_pid_bank_update().
+ * @param bank - Double pointer to a PID bank that the function allocates
+ * @param config - Configuration of each loop
+ * @param nb_loops - Number of loops
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_pid_bank_init(struct no_os_pid_bank **bank,
+			const struct no_os_pid_q15_config *config,
+			unsigned int nb_loops)
+{
+	struct no_os_pid_bank *b;
+	unsigned int i;
+	int ret;
+
+	if (!bank || !config || !nb_loops)
+		return -EINVAL;
+
+	// the 32-bit arrays first, then the 16-bit ones, all in one allocation
+	b = no_os_calloc(1, sizeof(*b) + nb_loops * (4 * sizeof(int32_t) +
+			 3 * sizeof(int16_t)));
+	if (!b)
+		return -ENOMEM;
+
+	b->nb_loops = nb_loops;
+	b->Kp = (int32_t *)(b + 1);
+	b->Ki = b->Kp + nb_loops;
+	b->Kd = b->Ki + nb_loops;
+	b->iacc = b->Kd + nb_loops;
+	b->out_min = (int16_t *)(b->iacc + nb_loops);
+	b->out_max = b->out_min + nb_loops;
+	b->prev_pv = b->out_max + nb_loops;
+
+	for (i = 0; i < nb_loops; i++) {
+		ret = no_os_pid_bank_tune(b, i, &config[i]);
+		if (ret) {
+			no_os_free(b);
+			return ret;
+		}
+	}
+
+	*bank = b;
+
+	return 0;
+}
+
+/**
+ * @brief Set the gains and limits of a loop of a PID bank.
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @param loop - Index of the loop
+ * @param config - New configuration of the loop
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_tune(struct no_os_pid_bank *bank, unsigned int loop,
+			const struct no_os_pid_q15_config *config)
+{
+	if (!bank || !config || loop >= bank->nb_loops)
+		return -EINVAL;
+
+	if (config->out_max < config->out_min)
+		return -EINVAL;
+
+	bank->Kp[loop] = config->Kp;
+	bank->Ki[loop] = config->Ki;
+	bank->Kd[loop] = config->Kd;
+	bank->out_min[loop] = config->out_min;
+	bank->out_max[loop] = config->out_max;
+	bank->iacc[loop] = no_os_clamp(bank->iacc[loop],
+				       (int32_t)config->out_min << 15,
+				       (int32_t)config->out_max << 15);
+
+	return 0;
+}
+
+/**
+ * @brief Update every loop of a PID bank, meant to be called at a fixed rate
+ * from a timer interrupt.
+ *
+ * The arguments are not checked, the bank must have been created with
+ * no_os_pid_bank_init() and the arrays must hold an element per loop. The
+ * integral component is kept within the output limits and stops integrating
+ * while the output saturates in the direction of the error (anti-windup).
+ * The derivative component acts on the process variable, so changing the set
+ * point does not kick the output.
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @param SP - Set point of each loop
+ * @param PV - Process variable of each loop
+ * @param output - Output of each loop
+ */
+NO_OS_RAMFUNC void no_os_pid_bank_update(struct no_os_pid_bank *bank,
+		const int16_t *SP, const int16_t *PV, int16_t *output)
+{
+	unsigned int i;
+	int32_t err, iacc, high, low;
+	int64_t acc;
+
+	if (!bank->primed) {
+		for (i = 0; i < bank->nb_loops; i++)
+			bank->prev_pv[i] = PV[i];
+		bank->primed = true;
+	}
+
+	for (i = 0; i < bank->nb_loops; i++) {
+		err = no_os_clamp((int32_t)SP[i] - PV[i], INT16_MIN, INT16_MAX);
+		high = (int32_t)bank->out_max[i] << 15;
+		low = (int32_t)bank->out_min[i] << 15;
+
+		acc = (int64_t)bank->Ki[i] * err + bank->iacc[i];
+		iacc = no_os_clamp(acc, low, high);
+
+		// Q15 gains times Q15 values, the sum is in Q30
+		acc = (int64_t)bank->Kp[i] * err + iacc +
+		      (int64_t)bank->Kd[i] * (bank->prev_pv[i] - PV[i]);
+
+		if (acc > high) {
+			output[i] = bank->out_max[i];
+			if (err < 0)
+				bank->iacc[i] = iacc;
+		} else if (acc < low) {
+			output[i] = bank->out_min[i];
+			if (err > 0)
+				bank->iacc[i] = iacc;
+		} else {
+			output[i] = acc >> 15;
+			bank->iacc[i] = iacc;
+		}
+
+		bank->prev_pv[i] = PV[i];
+	}
+}
+
+/**
+ * @brief Reset the integral components of a PID bank and restart the
+ * derivative components from the next process variables.
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_reset(struct no_os_pid_bank *bank)
+{
+	unsigned int i;
+
+	if (!bank)
+		return -EINVAL;
+
+	for (i = 0; i < bank->nb_loops; i++)
+		bank->iacc[i] = no_os_clamp(0, (int32_t)bank->out_min[i] << 15,
+					    (int32_t)bank->out_max[i] << 15);
+	bank->primed = false;
+
+	return 0;
+}
+
+/**
+ * @brief Free a PID bank.
+ * @param bank - PID bank created with no_os_pid_bank_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_pid_bank_remove(struct no_os_pid_bank *bank)
+{
+	if (!bank)
+		return -EINVAL;
+
+	no_os_free(bank);
+
+	return 0;
+}
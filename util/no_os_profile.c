@@ -0,0 +1,327 @@
+/***************************************************************************//**
+ *   @file   no_os_profile.c
+ *   @brief  Cycle counter and code region profiling
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "no_os_profile.h"
+#include "no_os_delay.h"
+#include "no_os_mutex.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+	defined(__ARM_ARCH_8M_MAIN__)
+#define NO_OS_PROFILE_DWT
+#define NO_OS_DEMCR		(*(volatile uint32_t *)0xE000EDFC)
+#define NO_OS_DEMCR_TRCENA	NO_OS_BIT(24)
+#define NO_OS_DWT_CTRL		(*(volatile uint32_t *)0xE0001000)
+#define NO_OS_DWT_CTRL_CYCCNTENA	NO_OS_BIT(0)
+#define NO_OS_DWT_CYCCNT	(*(volatile uint32_t *)0xE0001004)
+#define NO_OS_DWT_LAR		(*(volatile uint32_t *)0xE0001FB0)
+#define NO_OS_DWT_LAR_KEY	0xC5ACCE55
+
+/* Provided by the CMSIS system file of every Cortex-M platform. */
+extern uint32_t SystemCoreClock;
+#else
+/* Not every platform implements it, the counter then stays at 0. */
+#pragma weak no_os_get_time
+#endif
+
+static struct no_os_profile *profile_list;
+
+/* Histogram bin of a sample, see NO_OS_PROFILE_HIST_BINS */
+static inline uint32_t no_os_profile_bin(uint32_t cycles)
+{
+	uint32_t bin = 0;
+
+	while (cycles && bin < NO_OS_PROFILE_HIST_BINS - 1) {
+		cycles >>= 1;
+		bin++;
+	}
+
+	return bin;
+}
+
+/**
+ * @brief Read the free running cycle counter. This default uses the DWT
+ * cycle counter on Cortex-M3/M4/M7/M33 and the microseconds of
+ * no_os_get_time() elsewhere, platforms with a better counter override it.
+ * @return The counter value.
+ */
+__attribute__((weak)) uint32_t no_os_get_cycles(void)
+{
+#ifdef NO_OS_PROFILE_DWT
+	if (!(NO_OS_DWT_CTRL & NO_OS_DWT_CTRL_CYCCNTENA)) {
+		NO_OS_DEMCR |= NO_OS_DEMCR_TRCENA;
+		NO_OS_DWT_LAR = NO_OS_DWT_LAR_KEY;
+		NO_OS_DWT_CTRL |= NO_OS_DWT_CTRL_CYCCNTENA;
+	}
+
+	return NO_OS_DWT_CYCCNT;
+#else
+	struct no_os_time t;
+
+	if (!no_os_get_time)
+		return 0;
+
+	t = no_os_get_time();
+
+	return t.s * 1000000 + t.us;
+#endif
+}
+
+/**
+ * @brief Get the frequency of the counter read by no_os_get_cycles().
+ * @return The frequency in Hz.
+ */
+__attribute__((weak)) uint32_t no_os_get_cycles_freq(void)
+{
+#ifdef NO_OS_PROFILE_DWT
+	return SystemCoreClock;
+#else
+	return 1000000;
+#endif
+}
+
+/**
+ * @brief Convert a number of cycles to nanoseconds.
+ * @param cycles - Number of cycles of the no_os_get_cycles() counter.
+ * @return The duration in nanoseconds.
+ */
+uint64_t no_os_cycles_to_ns(uint32_t cycles)
+{
+	uint32_t freq = no_os_get_cycles_freq();
+
+	if (!freq)
+		return 0;
+
+	return no_os_div_u64((uint64_t)cycles * 1000000000ULL, freq);
+}
+
+/**
+ * @brief Start a sample of a profiling region.
+ * @param prof - The profiling region.
+ * @return None.
+ */
+void no_os_profile_start(struct no_os_profile *prof)
+{
+	prof->start = no_os_get_cycles();
+}
+
+/**
+ * @brief End the sample started by no_os_profile_start() and account it.
+ * @param prof - The profiling region.
+ * @return None.
+ */
+void no_os_profile_stop(struct no_os_profile *prof)
+{
+	no_os_profile_add(prof, no_os_get_cycles() - prof->start);
+}
+
+/**
+ * @brief Add a sample measured by the caller to a profiling region, e.g. the
+ * latency between an event timestamp and its interrupt handler. Safe to call
+ * from interrupt context.
+ * @param prof - The profiling region.
+ * @param cycles - Duration of the sample in cycles.
+ * @return None.
+ */
+void no_os_profile_add(struct no_os_profile *prof, uint32_t cycles)
+{
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	if (!prof->listed) {
+		prof->listed = true;
+		prof->next = profile_list;
+		profile_list = prof;
+	}
+
+	prof->count++;
+	prof->total += cycles;
+	if (cycles < prof->min)
+		prof->min = cycles;
+	if (cycles > prof->max)
+		prof->max = cycles;
+	if (prof->hist)
+		prof->hist[no_os_profile_bin(cycles)]++;
+
+	no_os_critical_exit(state);
+}
+
+/**
+ * @brief Clear the samples of all the profiling regions.
+ * @return None.
+ */
+void no_os_profile_reset(void)
+{
+	struct no_os_profile *prof;
+	uint32_t state;
+
+	state = no_os_critical_enter();
+
+	for (prof = profile_list; prof; prof = prof->next) {
+		prof->count = 0;
+		prof->total = 0;
+		prof->min = UINT32_MAX;
+		prof->max = 0;
+		if (prof->hist)
+			memset(prof->hist, 0,
+			       NO_OS_PROFILE_HIST_BINS * sizeof(*prof->hist));
+	}
+
+	no_os_critical_exit(state);
+}
+
+/*
+ * Print the histogram of a region as "<name>.hist" followed by
+ * "<bin upper bound in ns>:<count>" for each bin that has samples.
+ */
+static int no_os_profile_show_hist(struct no_os_profile *prof, char *buf,
+				   uint32_t len)
+{
+	uint32_t pos;
+	uint32_t i;
+	int ret;
+
+	ret = snprintf(buf, len, "%s.hist", prof->name);
+	if (ret < 0)
+		return ret;
+	if ((uint32_t)ret >= len)
+		return -ENOBUFS;
+
+	pos = ret;
+	for (i = 0; i < NO_OS_PROFILE_HIST_BINS; i++) {
+		if (!prof->hist[i])
+			continue;
+
+		ret = snprintf(buf + pos, len - pos, " %llu:%lu",
+			       (unsigned long long)no_os_cycles_to_ns(1UL << i),
+			       (unsigned long)prof->hist[i]);
+		if (ret < 0)
+			return ret;
+		if ((uint32_t)ret >= len - pos)
+			return -ENOBUFS;
+
+		pos += ret;
+	}
+
+	if (pos + 1 >= len)
+		return -ENOBUFS;
+
+	buf[pos++] = '\n';
+	buf[pos] = '\0';
+
+	return pos;
+}
+
+/**
+ * @brief Print the statistics of every region that has samples, one line
+ * per region: name, count, min, max and average duration in nanoseconds.
+ * Regions with a histogram get a second line, see no_os_profile_show_hist().
+ * @param buf - Output buffer.
+ * @param len - Size of the output buffer.
+ * @return Number of characters written, negative error code otherwise.
+ */
+int no_os_profile_show(char *buf, uint32_t len)
+{
+	struct no_os_profile *prof;
+	struct no_os_profile snap;
+	uint32_t state;
+	uint32_t pos = 0;
+	int ret;
+
+	if (!buf || !len)
+		return -EINVAL;
+
+	buf[0] = '\0';
+	for (prof = profile_list; prof; prof = prof->next) {
+		state = no_os_critical_enter();
+		snap = *prof;
+		no_os_critical_exit(state);
+
+		if (!snap.count)
+			continue;
+
+		ret = snprintf(buf + pos, len - pos, "%s %lu %llu %llu %llu\n",
+			       snap.name, (unsigned long)snap.count,
+			       (unsigned long long)no_os_cycles_to_ns(snap.min),
+			       (unsigned long long)no_os_cycles_to_ns(snap.max),
+			       (unsigned long long)no_os_cycles_to_ns(
+				       no_os_div_u64(snap.total, snap.count)));
+		if (ret < 0)
+			return ret;
+		if ((uint32_t)ret >= len - pos)
+			return -ENOBUFS;
+
+		pos += ret;
+
+		if (snap.hist) {
+			ret = no_os_profile_show_hist(&snap, buf + pos, len - pos);
+			if (ret < 0)
+				return ret;
+
+			pos += ret;
+		}
+	}
+
+	return pos;
+}
+
+/**
+ * @brief Start the region of NO_OS_PROFILE_SCOPE().
+ * @param prof - The profiling region.
+ * @return The region, stored in the scope guard variable.
+ */
+struct no_os_profile *no_os_profile_scope_enter(struct no_os_profile *prof)
+{
+	no_os_profile_start(prof);
+
+	return prof;
+}
+
+/**
+ * @brief End the region of NO_OS_PROFILE_SCOPE() when leaving its scope.
+ * @param prof - The scope guard variable.
+ * @return None.
+ */
+void no_os_profile_scope_exit(struct no_os_profile **prof)
+{
+	no_os_profile_stop(*prof);
+}
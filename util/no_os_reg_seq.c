@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ *   @file   no_os_reg_seq.c
+ *   @brief  Implementation of the register sequence writer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_reg_seq.h"
+#include "no_os_alloc.h"
+
+/**
+ * @brief Get the length of the run of consecutive addresses starting at seq.
+ * @param cfg - Device streaming description.
+ * @param seq - First entry of the run.
+ * @param nb_seq - Number of entries left in the table.
+ * @return Number of entries which can be written in a single transfer.
+ */
+static uint32_t no_os_reg_seq_run(const struct no_os_reg_seq_config *cfg,
+				  const struct no_os_reg_seq *seq,
+				  uint32_t nb_seq)
+{
+	uint32_t len = 1;
+
+	while (len < nb_seq && len < cfg->max_burst &&
+	       seq[len].reg == seq[len - 1].reg + 1)
+		len++;
+
+	return len;
+}
+
+/**
+ * @brief Write a table of registers, merging consecutive addresses into
+ * 	  streaming writes.
+ *
+ * Each run of consecutive addresses becomes one SPI message holding the
+ * instruction and the data of the whole run. All the messages are then sent
+ * in a single DMA transfer when the platform supports it, or through
+ * no_os_spi_transfer() otherwise.
+ * @param cfg - Device streaming description.
+ * @param seq - Table of register writes, in ascending address order for the
+ * 		entries which should be merged.
+ * @param nb_seq - Number of entries in the table.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_reg_seq_write(const struct no_os_reg_seq_config *cfg,
+			const struct no_os_reg_seq *seq, uint32_t nb_seq)
+{
+	struct no_os_spi_msg *msgs;
+	uint32_t nb_msgs = 0;
+	uint32_t i, j, len;
+	uint8_t *buf;
+	int ret;
+
+	if (!cfg || !cfg->spi || !cfg->format_cmd || !cfg->max_burst || !seq)
+		return -EINVAL;
+
+	if (!nb_seq)
+		return 0;
+
+	for (i = 0; i < nb_seq; i += len) {
+		len = no_os_reg_seq_run(cfg, &seq[i], nb_seq - i);
+		nb_msgs++;
+	}
+
+	msgs = no_os_calloc(1, nb_msgs * (sizeof(*msgs) + cfg->cmd_size) +
+			    nb_seq);
+	if (!msgs)
+		return -ENOMEM;
+
+	buf = (uint8_t *)&msgs[nb_msgs];
+	nb_msgs = 0;
+	for (i = 0; i < nb_seq; i += len) {
+		len = no_os_reg_seq_run(cfg, &seq[i], nb_seq - i);
+
+		msgs[nb_msgs].tx_buff = buf;
+		msgs[nb_msgs].rx_buff = buf;
+		msgs[nb_msgs].bytes_number = cfg->cmd_size + len;
+		msgs[nb_msgs].cs_change = 1;
+		nb_msgs++;
+
+		/* A descending stream starts at the last address of the run. */
+		if (cfg->descending) {
+			cfg->format_cmd(seq[i + len - 1].reg, buf);
+			buf += cfg->cmd_size;
+			for (j = len; j > 0; j--)
+				*buf++ = seq[i + j - 1].val;
+		} else {
+			cfg->format_cmd(seq[i].reg, buf);
+			buf += cfg->cmd_size;
+			for (j = 0; j < len; j++)
+				*buf++ = seq[i + j].val;
+		}
+	}
+
+	ret = no_os_spi_transfer_dma_sync(cfg->spi, msgs, nb_msgs);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_transfer(cfg->spi, msgs, nb_msgs);
+
+	no_os_free(msgs);
+
+	return ret;
+}
@@ -0,0 +1,272 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.c
+ *   @brief  Implementation of the register map cache utility.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_regmap.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+struct no_os_regmap {
+	uint32_t *cache; // cached register values
+	uint32_t *valid; // bitmap of the registers held in the cache
+	uint32_t *dirty; // bitmap of the registers not yet written to the device
+	struct no_os_regmap_config config; // copy of the user-provided configuration
+};
+
+#define REGMAP_WORD(reg)	((reg) / 32)
+#define REGMAP_BIT(reg)		NO_OS_BIT((reg) % 32)
+
+static bool no_os_regmap_test(const uint32_t *bitmap, uint32_t reg)
+{
+	return bitmap[REGMAP_WORD(reg)] & REGMAP_BIT(reg);
+}
+
+static bool no_os_regmap_cached(struct no_os_regmap *map, uint32_t reg)
+{
+	return !map->config.volatile_reg || !map->config.volatile_reg(reg);
+}
+
+/**
+ * @brief Initialize a register map with given configuration
+ * @param map - Double pointer to a register map that the function allocates
+ * @param config - Register map configuration structure
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_regmap_init(struct no_os_regmap **map,
+		      struct no_os_regmap_config config)
+{
+	struct no_os_regmap *m;
+	uint32_t words;
+
+	if (!map || !config.reg_read || !config.reg_write)
+		return -EINVAL;
+
+	m = no_os_calloc(1, sizeof(*m));
+	if (!m)
+		return -ENOMEM;
+
+	words = REGMAP_WORD(config.max_reg) + 1;
+	m->cache = no_os_calloc(config.max_reg + 1, sizeof(*m->cache));
+	m->valid = no_os_calloc(words, sizeof(*m->valid));
+	m->dirty = no_os_calloc(words, sizeof(*m->dirty));
+	if (!m->cache || !m->valid || !m->dirty) {
+		no_os_regmap_remove(m);
+		return -ENOMEM;
+	}
+
+	m->config = config;
+	*map = m;
+
+	return 0;
+}
+
+/**
+ * @brief Read a register, from the cache if it holds it
+ * @param map - Register map
+ * @param reg - Register address
+ * @param val - Register value
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - negative error code returned by the device read function
+ */
+int no_os_regmap_read(struct no_os_regmap *map, uint32_t reg, uint32_t *val)
+{
+	int ret;
+
+	if (!map || !val || reg > map->config.max_reg)
+		return -EINVAL;
+
+	if (no_os_regmap_test(map->valid, reg)) {
+		*val = map->cache[reg];
+		return 0;
+	}
+
+	ret = map->config.reg_read(map->config.dev, reg, val);
+	if (ret)
+		return ret;
+
+	if (no_os_regmap_cached(map, reg)) {
+		map->cache[reg] = *val;
+		map->valid[REGMAP_WORD(reg)] |= REGMAP_BIT(reg);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write a register. In write back mode, cached registers are only
+ * written to the device by no_os_regmap_sync().
+ * @param map - Register map
+ * @param reg - Register address
+ * @param val - Register value
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - negative error code returned by the device write function
+ */
+int no_os_regmap_write(struct no_os_regmap *map, uint32_t reg, uint32_t val)
+{
+	int ret;
+
+	if (!map || reg > map->config.max_reg)
+		return -EINVAL;
+
+	if (!no_os_regmap_cached(map, reg))
+		return map->config.reg_write(map->config.dev, reg, val);
+
+	if (map->config.mode == NO_OS_REGMAP_WRITE_BACK) {
+		map->dirty[REGMAP_WORD(reg)] |= REGMAP_BIT(reg);
+	} else {
+		ret = map->config.reg_write(map->config.dev, reg, val);
+		if (ret)
+			return ret;
+	}
+
+	map->cache[reg] = val;
+	map->valid[REGMAP_WORD(reg)] |= REGMAP_BIT(reg);
+
+	return 0;
+}
+
+/**
+ * @brief Update the masked bits of a register. The write is skipped when a
+ * cached register already holds the new value.
+ * @param map - Register map
+ * @param reg - Register address
+ * @param mask - Bits to update
+ * @param val - New value of the bits, already in position
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - negative error code returned by the device functions
+ */
+int no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t mask, uint32_t val)
+{
+	uint32_t old, new;
+	int ret;
+
+	ret = no_os_regmap_read(map, reg, &old);
+	if (ret)
+		return ret;
+
+	new = (old & ~mask) | (val & mask);
+	if (new == old && no_os_regmap_test(map->valid, reg))
+		return 0;
+
+	return no_os_regmap_write(map, reg, new);
+}
+
+/**
+ * @brief Write all the registers changed in write back mode to the device, in
+ * address order.
+ * @param map - Register map
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - negative error code returned by the device write function. The registers
+ *    not written yet stay dirty.
+ */
+int no_os_regmap_sync(struct no_os_regmap *map)
+{
+	uint32_t word, reg;
+	int ret;
+
+	if (!map)
+		return -EINVAL;
+
+	for (word = 0; word <= REGMAP_WORD(map->config.max_reg); word++) {
+		while (map->dirty[word]) {
+			reg = word * 32 + no_os_find_first_set_bit(map->dirty[word]);
+			ret = map->config.reg_write(map->config.dev, reg,
+						    map->cache[reg]);
+			if (ret)
+				return ret;
+
+			map->dirty[word] &= ~REGMAP_BIT(reg);
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Drop the cached values, e.g. after a device reset. Changes not
+ * synced yet are lost.
+ * @param map - Register map
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_regmap_cache_drop(struct no_os_regmap *map)
+{
+	uint32_t words;
+
+	if (!map)
+		return -EINVAL;
+
+	words = REGMAP_WORD(map->config.max_reg) + 1;
+	memset(map->valid, 0, words * sizeof(*map->valid));
+	memset(map->dirty, 0, words * sizeof(*map->dirty));
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_regmap_init()
+ * @param map - Register map
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_regmap_remove(struct no_os_regmap *map)
+{
+	if (!map)
+		return -EINVAL;
+
+	no_os_free(map->cache);
+	no_os_free(map->valid);
+	no_os_free(map->dirty);
+	no_os_free(map);
+
+	return 0;
+}
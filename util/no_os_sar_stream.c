@@ -0,0 +1,231 @@
+/***************************************************************************//**
+ *   @file   no_os_sar_stream.c
+ *   @brief  Source file for timer paced SAR ADC acquisition.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_sar_stream.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
+
+/**
+ * @brief DMA completion callback of a sample read.
+ * @param ctx - The stream descriptor.
+ */
+static void no_os_sar_stream_done(void *ctx)
+{
+	struct no_os_sar_stream *stream = ctx;
+
+	if (stream->discard) {
+		stream->discard--;
+	} else if (++stream->idx == stream->block_samples) {
+		stream->idx = 0;
+		stream->wr++;
+	}
+
+	stream->busy = false;
+}
+
+/**
+ * @brief Start a timer paced acquisition.
+ *
+ * The PWM generates the conversion start signal at the requested rate and the
+ * caller routes its tick (PWM pulse finished interrupt, or the BUSY falling
+ * edge) to no_os_sar_stream_trigger(). Each tick reads the last conversion by
+ * DMA while the PWM already schedules the next one, so the CPU never waits for
+ * the conversion time.
+ * @param stream - The stream descriptor.
+ * @param param  - The stream parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sar_stream_init(struct no_os_sar_stream **stream,
+			  const struct no_os_sar_stream_init_param *param)
+{
+	struct no_os_pwm_init_param pwm_param;
+	struct no_os_sar_stream *s;
+	uint32_t period_ns;
+	int ret;
+
+	if (!stream || !param || !param->spi_desc || !param->cnv_pwm_init ||
+	    !param->ring || !param->block_samples || param->nb_blocks < 2 ||
+	    !param->sample_rate_hz || !param->frame_bytes ||
+	    param->frame_bytes > NO_OS_SAR_STREAM_MAX_FRAME ||
+	    param->cnv_cmd_bytes > NO_OS_SAR_STREAM_MAX_FRAME)
+		return -EINVAL;
+
+	period_ns = NO_OS_DIV_ROUND_CLOSEST(1000000000, param->sample_rate_hz);
+	if (period_ns <= param->cnv_high_ns)
+		return -EINVAL;
+
+	s = no_os_calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	s->spi_desc = param->spi_desc;
+	s->ring = param->ring;
+	s->frame_bytes = param->frame_bytes;
+	s->block_samples = param->block_samples;
+	s->nb_blocks = param->nb_blocks;
+	s->discard = param->discard;
+	memcpy(s->frame_tx, param->frame_tx, sizeof(s->frame_tx));
+	memcpy(s->cnv_cmd, param->cnv_cmd, sizeof(s->cnv_cmd));
+
+	s->msgs[0].tx_buff = s->frame_tx;
+	s->msgs[0].bytes_number = s->frame_bytes;
+	s->msgs[0].cs_change = 1;
+	s->nb_msgs = 1;
+	if (param->cnv_cmd_bytes) {
+		s->msgs[1].tx_buff = s->cnv_cmd;
+		s->msgs[1].bytes_number = param->cnv_cmd_bytes;
+		s->msgs[1].cs_change = 1;
+		s->nb_msgs = 2;
+	}
+
+	pwm_param = *param->cnv_pwm_init;
+	pwm_param.period_ns = period_ns;
+	pwm_param.duty_cycle_ns = param->cnv_high_ns;
+	ret = no_os_pwm_init(&s->cnv_pwm, &pwm_param);
+	if (ret)
+		goto free_stream;
+
+	ret = no_os_pwm_enable(s->cnv_pwm);
+	if (ret)
+		goto remove_pwm;
+
+	*stream = s;
+
+	return 0;
+
+remove_pwm:
+	no_os_pwm_remove(s->cnv_pwm);
+free_stream:
+	no_os_free(s);
+
+	return ret;
+}
+
+/**
+ * @brief Read the last conversion into the ring, to be called on each
+ *	  conversion tick. The read runs by DMA, the call returns as soon as it
+ *	  is started.
+ * @param stream - The stream descriptor.
+ * @return 0 in case of success, -EBUSY if the tick was dropped because a read
+ *	   is still in flight or the ring is full, negative error code otherwise.
+ */
+int no_os_sar_stream_trigger(struct no_os_sar_stream *stream)
+{
+	uint32_t slot;
+	int ret;
+
+	if (!stream)
+		return -EINVAL;
+
+	if (stream->busy ||
+	    (!stream->idx && stream->wr - stream->rd >= stream->nb_blocks)) {
+		stream->overruns++;
+		return -EBUSY;
+	}
+
+	slot = (stream->wr % stream->nb_blocks) * stream->block_samples +
+	       stream->idx;
+	stream->msgs[0].rx_buff = stream->ring + slot * stream->frame_bytes;
+
+	stream->busy = true;
+	ret = no_os_spi_transfer_dma_async(stream->spi_desc, stream->msgs,
+					   stream->nb_msgs,
+					   no_os_sar_stream_done, stream);
+	if (ret)
+		stream->busy = false;
+
+	return ret;
+}
+
+/**
+ * @brief Get the oldest complete block. The block stays valid until the next
+ *	  call.
+ * @param stream - The stream descriptor.
+ * @param block  - Start of the block, block_samples raw frames of frame_bytes.
+ * @return 0 in case of success, -EAGAIN if no block is available.
+ */
+int no_os_sar_stream_read(struct no_os_sar_stream *stream, uint8_t **block)
+{
+	if (!stream || !block)
+		return -EINVAL;
+
+	if (stream->held) {
+		stream->rd++;
+		stream->held = false;
+	}
+
+	if (stream->wr == stream->rd)
+		return -EAGAIN;
+
+	*block = stream->ring + (stream->rd % stream->nb_blocks) *
+		 stream->block_samples * stream->frame_bytes;
+	stream->held = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the acquisition and free its resources.
+ * @param stream - The stream descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sar_stream_remove(struct no_os_sar_stream *stream)
+{
+	uint32_t timeout = 10000;
+	int ret;
+
+	if (!stream)
+		return -EINVAL;
+
+	ret = no_os_pwm_disable(stream->cnv_pwm);
+	if (ret)
+		return ret;
+
+	while (stream->busy && --timeout)
+		no_os_udelay(1);
+
+	ret = no_os_pwm_remove(stream->cnv_pwm);
+	if (ret)
+		return ret;
+
+	no_os_free(stream);
+
+	return timeout ? 0 : -ETIMEDOUT;
+}
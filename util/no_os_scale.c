@@ -0,0 +1,187 @@
+/***************************************************************************//**
+ *   @file   no_os_scale.c
+ *   @brief  Fixed point conversion of ADC codes.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_scale.h"
+#ifdef NO_OS_SCALE_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+/**
+ * @brief Compute the fixed point form of a linear conversion
+ *	  value = (code + offset) * num / den. Meant to be called whenever the
+ *	  range, gain or reference of a channel changes.
+ * @param scale - Scale to fill
+ * @param num - Numerator of the conversion factor, e.g. 2 * Vref in uV
+ * @param den - Denominator of the conversion factor, e.g. 2^24
+ * @param offset - Added to the code before scaling, e.g. to center a range
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ERANGE : The factor does not fit in 31 bits
+ */
+int no_os_scale_set(struct no_os_scale *scale, int32_t num, uint32_t den,
+		    int32_t offset)
+{
+	uint64_t abs_num;
+	uint64_t q, rem;
+	uint8_t shift = 0;
+
+	if (!scale || !den)
+		return -EINVAL;
+
+	abs_num = (num < 0) ? -(int64_t)num : num;
+	q = abs_num / den;
+	rem = abs_num % den;
+	if (q >> 31)
+		return -ERANGE;
+
+	/* Long division, one bit at a time, until the multiplier has 31 bits */
+	while (abs_num && q < (1ULL << 30) && shift < 62) {
+		q <<= 1;
+		rem <<= 1;
+		if (rem >= den) {
+			q |= 1;
+			rem -= den;
+		}
+		shift++;
+	}
+
+	/* Round to nearest */
+	if (2 * rem >= den)
+		q++;
+	if (q >> 31) {
+		if (!shift)
+			return -ERANGE;
+		q >>= 1;
+		shift--;
+	}
+
+	scale->offset = offset;
+	scale->mult = (num < 0) ? -(int32_t)q : (int32_t)q;
+	scale->shift = shift;
+
+	return 0;
+}
+
+/**
+ * @brief Convert one input with a piecewise linear table. Inputs outside of
+ *	  the table are extrapolated from its first or last segment.
+ * @param lut - Table, nb must be at least 2 and shift at least 1
+ * @param x - Input, in the unit of the table
+ * @return The interpolated value, rounded to nearest.
+ */
+int32_t no_os_scale_lut_apply(const struct no_os_scale_lut *lut, int32_t x)
+{
+	int64_t d = (int64_t)x - lut->x0;
+	int64_t idx = d >> lut->shift;
+	int64_t frac;
+
+	if (idx < 0)
+		idx = 0;
+	else if (idx > lut->nb - 2)
+		idx = lut->nb - 2;
+
+	frac = d - (idx << lut->shift);
+	frac = frac * (lut->y[idx + 1] - lut->y[idx]) +
+	       (1LL << (lut->shift - 1));
+
+	return lut->y[idx] + (int32_t)(frac >> lut->shift);
+}
+
+/**
+ * @brief Convert a buffer of codes of the same channel. With
+ *	  NO_OS_SCALE_CMSIS_DSP defined, CMSIS-DSP does the work and the result is
+ *	  truncated instead of rounded.
+ * @param scale - Scale computed by no_os_scale_set()
+ * @param in - Codes
+ * @param out - Converted values, may be the same as in
+ * @param nb - Number of codes
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_scale_buffer(const struct no_os_scale *scale, const int32_t *in,
+		       int32_t *out, uint32_t nb)
+{
+	uint32_t i;
+
+	if (!scale || !in || !out)
+		return -EINVAL;
+
+#ifdef NO_OS_SCALE_CMSIS_DSP
+	if (scale->offset) {
+		arm_offset_q31((q31_t *)in, scale->offset, out, nb);
+		in = out;
+	}
+	/* out = ((in * mult) >> 32) << (32 - shift) */
+	arm_scale_q31((q31_t *)in, scale->mult, 31 - scale->shift, out, nb);
+	(void)i;
+#else
+	for (i = 0; i < nb; i++)
+		out[i] = no_os_scale_apply(scale, in[i]);
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Convert interleaved scans, each channel with its own scale.
+ * @param scales - One scale per channel
+ * @param nb_channels - Number of channels in a scan
+ * @param in - Codes
+ * @param out - Converted values, may be the same as in
+ * @param nb_scans - Number of scans
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_scale_scans(const struct no_os_scale *scales,
+		      uint32_t nb_channels, const int32_t *in, int32_t *out,
+		      uint32_t nb_scans)
+{
+	uint32_t i, ch;
+
+	if (!scales || !nb_channels || !in || !out)
+		return -EINVAL;
+
+	for (i = 0; i < nb_scans; i++)
+		for (ch = 0; ch < nb_channels; ch++, in++, out++)
+			*out = no_os_scale_apply(&scales[ch], *in);
+
+	return 0;
+}
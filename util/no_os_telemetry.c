@@ -0,0 +1,212 @@
+/***************************************************************************//**
+ *   @file   no_os_telemetry.c
+ *   @brief  Double buffered telemetry snapshots of monitoring devices.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_telemetry.h"
+#include "no_os_alloc.h"
+
+#define telemetry_load(p)	__atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define telemetry_store(p, v)	__atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+/**
+ * @brief Work function of the scheduled refreshes.
+ * @param work - The work of the snapshot.
+ */
+static void no_os_telemetry_work(struct no_os_work *work)
+{
+	no_os_telemetry_refresh(work->ctx);
+}
+
+/**
+ * @brief Allocate a telemetry snapshot.
+ * @param tlm - The snapshot descriptor.
+ * @param param - The snapshot parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_telemetry_init(struct no_os_telemetry **tlm,
+			 const struct no_os_telemetry_init_param *param)
+{
+	struct no_os_telemetry *t;
+
+	if (!tlm || !param || !param->ops || !param->ops->refresh ||
+	    !param->nb_vals)
+		return -EINVAL;
+
+	t = no_os_calloc(1, sizeof(*t));
+	if (!t)
+		return -ENOMEM;
+
+	t->buf[0] = no_os_calloc(2 * param->nb_vals, sizeof(*t->buf[0]));
+	if (!t->buf[0]) {
+		no_os_free(t);
+		return -ENOMEM;
+	}
+
+	t->buf[1] = t->buf[0] + param->nb_vals;
+	t->ops = param->ops;
+	t->dev = param->dev;
+	t->nb_vals = param->nb_vals;
+	t->wq = param->wq;
+	t->work.func = no_os_telemetry_work;
+	t->work.ctx = t;
+	t->work.prio = param->prio;
+	*tlm = t;
+
+	return 0;
+}
+
+/**
+ * @brief Read the device into the unpublished buffer and publish it. Must not
+ * run concurrently with itself, readers may preempt it or be preempted by it.
+ * @param tlm - The snapshot descriptor.
+ * @return 0 in case of success, negative error code otherwise. On errors the
+ * 	   previous snapshot stays published.
+ */
+int no_os_telemetry_refresh(struct no_os_telemetry *tlm)
+{
+	uint32_t seq;
+	int ret;
+
+	if (!tlm)
+		return -EINVAL;
+
+	seq = tlm->seq;
+	ret = tlm->ops->refresh(tlm->dev, tlm->buf[(seq + 1) & 1]);
+	tlm->last_err = ret;
+	if (ret) {
+		tlm->errors++;
+		return ret;
+	}
+
+	telemetry_store(&tlm->seq, seq + 1);
+
+	return 0;
+}
+
+/**
+ * @brief Queue a refresh, e.g. from a periodic timer callback, to be run by
+ * no_os_workqueue_run(). Does nothing if one is already queued.
+ * @param tlm - The snapshot descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_telemetry_schedule(struct no_os_telemetry *tlm)
+{
+	if (!tlm || !tlm->wq)
+		return -EINVAL;
+
+	return no_os_work_post(tlm->wq, &tlm->work);
+}
+
+/**
+ * @brief Get a value of the published snapshot, without bus traffic.
+ * @param tlm - The snapshot descriptor.
+ * @param idx - Index of the value, as defined by the driver.
+ * @param val - The value.
+ * @return 0 in case of success, -ENODATA before the first refresh, negative
+ * 	   error code otherwise.
+ */
+int no_os_telemetry_get(struct no_os_telemetry *tlm, uint32_t idx,
+			int32_t *val)
+{
+	uint32_t seq;
+
+	if (!tlm || !val || idx >= tlm->nb_vals)
+		return -EINVAL;
+
+	do {
+		seq = telemetry_load(&tlm->seq);
+		if (!seq)
+			return -ENODATA;
+
+		*val = tlm->buf[seq & 1][idx];
+	} while (telemetry_load(&tlm->seq) != seq);
+
+	return 0;
+}
+
+/**
+ * @brief Copy the published snapshot, without bus traffic. The copy is
+ * retried if a refresh published a new snapshot meanwhile, so its values
+ * always come from the same refresh.
+ * @param tlm - The snapshot descriptor.
+ * @param vals - The nb_vals values.
+ * @param seq - Optional, number of the snapshot, to tell whether it changed
+ * 		since the previous read.
+ * @return 0 in case of success, -ENODATA before the first refresh, negative
+ * 	   error code otherwise.
+ */
+int no_os_telemetry_read(struct no_os_telemetry *tlm, int32_t *vals,
+			 uint32_t *seq)
+{
+	uint32_t s;
+
+	if (!tlm || !vals)
+		return -EINVAL;
+
+	do {
+		s = telemetry_load(&tlm->seq);
+		if (!s)
+			return -ENODATA;
+
+		memcpy(vals, tlm->buf[s & 1], tlm->nb_vals * sizeof(*vals));
+	} while (telemetry_load(&tlm->seq) != s);
+
+	if (seq)
+		*seq = s;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_telemetry_init().
+ * @param tlm - The snapshot descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_telemetry_remove(struct no_os_telemetry *tlm)
+{
+	if (!tlm)
+		return -EINVAL;
+
+	if (tlm->wq)
+		no_os_work_cancel(tlm->wq, &tlm->work);
+
+	no_os_free(tlm->buf[0]);
+	no_os_free(tlm);
+
+	return 0;
+}
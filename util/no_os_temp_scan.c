@@ -0,0 +1,176 @@
+/***************************************************************************//**
+ *   @file   no_os_temp_scan.c
+ *   @brief  Source file for the bulk acquisition of temperature sensors.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_temp_scan.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+
+/**
+ * @brief Allocate a temperature scan.
+ * @param scan - The scan descriptor.
+ * @param param - The scan parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_temp_scan_init(struct no_os_temp_scan **scan,
+			 const struct no_os_temp_scan_init_param *param)
+{
+	struct no_os_temp_scan *s;
+	uint32_t i;
+
+	if (!scan || !param || !param->sensors || !param->nb_sensors)
+		return -EINVAL;
+
+	for (i = 0; i < param->nb_sensors; i++)
+		if (!param->sensors[i].ops || !param->sensors[i].ops->start ||
+		    !param->sensors[i].ops->read)
+			return -EINVAL;
+
+	s = no_os_calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	s->sensors = no_os_calloc(param->nb_sensors, sizeof(*s->sensors));
+	s->values = no_os_calloc(param->nb_sensors, sizeof(*s->values));
+	s->status = no_os_calloc(param->nb_sensors, sizeof(*s->status));
+	if (!s->sensors || !s->values || !s->status) {
+		no_os_temp_scan_remove(s);
+		return -ENOMEM;
+	}
+
+	memcpy(s->sensors, param->sensors,
+	       param->nb_sensors * sizeof(*s->sensors));
+	s->nb_sensors = param->nb_sensors;
+	s->buf = param->buf;
+	for (i = 0; i < s->nb_sensors; i++)
+		s->status[i] = -ENODATA;
+	*scan = s;
+
+	return 0;
+}
+
+/**
+ * @brief Start a conversion on every sensor, wait once for the longest one
+ * and read them all. The new values and status replace the ones of the
+ * previous scan, then the scan is written to the buffer if there is one. The
+ * sensors that failed keep their previous value.
+ * @param scan - The scan descriptor.
+ * @return 0 if all the sensors were read, the first error otherwise. The
+ * 	   values of the other sensors are still updated.
+ */
+int no_os_temp_scan_run(struct no_os_temp_scan *scan)
+{
+	uint32_t conv_us;
+	uint32_t wait_us = 0;
+	uint32_t i;
+	int ret = 0;
+
+	if (!scan)
+		return -EINVAL;
+
+	for (i = 0; i < scan->nb_sensors; i++) {
+		conv_us = 0;
+		scan->status[i] = scan->sensors[i].ops->start(scan->sensors[i].dev,
+				  &conv_us);
+		if (!scan->status[i] && conv_us > wait_us)
+			wait_us = conv_us;
+	}
+
+	if (wait_us >= 1000)
+		no_os_mdelay(wait_us / 1000);
+	if (wait_us % 1000)
+		no_os_udelay(wait_us % 1000);
+
+	for (i = 0; i < scan->nb_sensors; i++) {
+		if (!scan->status[i])
+			scan->status[i] = scan->sensors[i].ops->read(
+						  scan->sensors[i].dev,
+						  &scan->values[i]);
+		if (scan->status[i] && !ret)
+			ret = scan->status[i];
+	}
+
+	scan->count++;
+
+	if (scan->buf && no_os_cb_write(scan->buf, scan->values,
+					scan->nb_sensors * sizeof(*scan->values)))
+		scan->overruns++;
+
+	return ret;
+}
+
+/**
+ * @brief Get the value of a sensor from the last scan.
+ * @param scan - The scan descriptor.
+ * @param sensor - Index of the sensor.
+ * @param val - The value.
+ * @return 0 in case of success, the error of the sensor in the last scan,
+ * 	   or -ENODATA before the first scan.
+ */
+int no_os_temp_scan_get(struct no_os_temp_scan *scan, uint32_t sensor,
+			int32_t *val)
+{
+	if (!scan || !val || sensor >= scan->nb_sensors)
+		return -EINVAL;
+
+	if (scan->status[sensor])
+		return scan->status[sensor];
+
+	*val = scan->values[sensor];
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_temp_scan_init().
+ * @param scan - The scan descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_temp_scan_remove(struct no_os_temp_scan *scan)
+{
+	if (!scan)
+		return -EINVAL;
+
+	no_os_free(scan->status);
+	no_os_free(scan->values);
+	no_os_free(scan->sensors);
+	no_os_free(scan);
+
+	return 0;
+}
@@ -0,0 +1,388 @@
+/***************************************************************************//**
+ *   @file   no_os_track_cal.c
+ *   @brief  Source file for the scheduling of transceiver tracking calibrations.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_track_cal.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "no_os_profile.h"
+#include "no_os_util.h"
+
+/*
+ * Read the status of the calibrations and account the time since the
+ * previous read to the ones that were busy and let run.
+ */
+static int no_os_track_cal_sample(struct no_os_track_cal *desc)
+{
+	struct no_os_track_cal_stats *s;
+	uint32_t busy, err, now, bit;
+	uint64_t dt;
+	uint32_t i;
+	int ret;
+
+	ret = desc->ops->status(desc->dev, &busy, &err);
+	if (ret)
+		return ret;
+
+	now = no_os_get_cycles();
+	dt = no_os_cycles_to_ns(now - desc->last);
+	desc->last = now;
+	busy &= desc->mask;
+	err &= desc->mask;
+
+	for (i = 0; i < NO_OS_TRACK_CAL_MAX; i++) {
+		bit = NO_OS_BIT(i);
+		if (!(desc->mask & bit))
+			continue;
+
+		s = &desc->stats[i];
+		if (err & ~desc->err & bit)
+			s->errors++;
+		if (desc->busy & desc->running & bit) {
+			s->busy_ns += dt;
+			s->cur_ns += dt;
+		}
+		if (desc->busy & ~busy & bit) {
+			s->runs++;
+			s->max_ns = no_os_max(s->max_ns, s->cur_ns);
+			s->cur_ns = 0;
+		}
+	}
+
+	desc->busy = busy;
+	desc->err = err;
+
+	return 0;
+}
+
+/* Let all the calibrations run */
+static int no_os_track_cal_release(struct no_os_track_cal *desc)
+{
+	int ret, ret2;
+
+	ret = no_os_track_cal_sample(desc);
+	ret2 = desc->ops->run(desc->dev, desc->mask, true);
+	if (ret2)
+		return ret2;
+
+	desc->running = desc->mask;
+
+	return ret;
+}
+
+/* Hold off the calibrations let run, the busy ones are deferred */
+static int no_os_track_cal_hold(struct no_os_track_cal *desc)
+{
+	uint32_t i;
+	int ret;
+
+	ret = desc->ops->run(desc->dev, desc->running, false);
+	if (ret)
+		return ret;
+
+	/* The time until now is still accounted to the calibrations */
+	ret = no_os_track_cal_sample(desc);
+	for (i = 0; i < NO_OS_TRACK_CAL_MAX; i++)
+		if (desc->running & desc->busy & NO_OS_BIT(i))
+			desc->stats[i].deferred++;
+	desc->running = 0;
+
+	return ret;
+}
+
+/**
+ * @brief Allocate a tracking calibration scheduler. In windowed mode the
+ * calibrations are held off until the first window, in free running mode
+ * they are expected to be running already.
+ * @param desc - The scheduler descriptor.
+ * @param param - The scheduler parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_init(struct no_os_track_cal **desc,
+			 const struct no_os_track_cal_init_param *param)
+{
+	struct no_os_track_cal *d;
+	int ret;
+
+	if (!desc || !param || !param->ops || !param->ops->run ||
+	    !param->ops->status || !param->mask)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->ops = param->ops;
+	d->dev = param->dev;
+	d->mask = param->mask;
+	d->names = param->names;
+	d->mode = param->mode;
+	d->last = no_os_get_cycles();
+	no_os_mutex_init(&d->lock);
+
+	if (d->mode == NO_OS_TRACK_CAL_WINDOWED) {
+		ret = d->ops->run(d->dev, d->mask, false);
+		if (ret)
+			goto error;
+	} else {
+		d->running = d->mask;
+	}
+
+	ret = no_os_track_cal_sample(d);
+	if (ret)
+		goto error;
+
+	*desc = d;
+
+	return 0;
+
+error:
+	no_os_mutex_remove(d->lock);
+	no_os_free(d);
+
+	return ret;
+}
+
+/**
+ * @brief Let the calibrations run until no_os_track_cal_window_close(), e.g.
+ * at the start of a TDD gap or of any period the data path is idle. The
+ * window is only counted while the scheduler is paused. Windowed mode only.
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_window_open(struct no_os_track_cal *desc)
+{
+	int ret = 0;
+
+	if (!desc || desc->mode != NO_OS_TRACK_CAL_WINDOWED)
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+
+	if (desc->window)
+		goto out;
+
+	desc->window = true;
+	desc->window_start = no_os_get_cycles();
+	desc->windows++;
+	if (desc->paused) {
+		desc->skipped++;
+		goto out;
+	}
+
+	ret = no_os_track_cal_release(desc);
+out:
+	no_os_mutex_unlock(desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Hold off the calibrations at the end of the window, the ones that
+ * did not complete go on in the next window.
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_window_close(struct no_os_track_cal *desc)
+{
+	int ret = 0;
+
+	if (!desc || desc->mode != NO_OS_TRACK_CAL_WINDOWED)
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+
+	if (!desc->window)
+		goto out;
+
+	desc->window = false;
+	desc->window_ns += no_os_cycles_to_ns(no_os_get_cycles() -
+					      desc->window_start);
+	if (desc->running)
+		ret = no_os_track_cal_hold(desc);
+out:
+	no_os_mutex_unlock(desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Hold off the calibrations, e.g. around a capture that must not be
+ * disturbed, in any mode. The pauses nest, the calibrations may run again
+ * after the last no_os_track_cal_resume().
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_pause(struct no_os_track_cal *desc)
+{
+	int ret = 0;
+
+	if (!desc)
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+
+	if (desc->paused++)
+		goto out;
+
+	desc->pauses++;
+	if (desc->running)
+		ret = no_os_track_cal_hold(desc);
+out:
+	no_os_mutex_unlock(desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Undo a no_os_track_cal_pause(). The calibrations run again in free
+ * running mode, or if a window is open in windowed mode.
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_resume(struct no_os_track_cal *desc)
+{
+	int ret = 0;
+
+	if (!desc)
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+
+	if (!desc->paused) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	if (--desc->paused)
+		goto out;
+
+	if (desc->mode == NO_OS_TRACK_CAL_FREE_RUN || desc->window)
+		ret = no_os_track_cal_release(desc);
+out:
+	no_os_mutex_unlock(desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Read the status of the calibrations to update their counters. The
+ * completion of the runs and their time are only seen at the status reads,
+ * poll in the windows and while free running for a finer resolution.
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_poll(struct no_os_track_cal *desc)
+{
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+	ret = no_os_track_cal_sample(desc);
+	no_os_mutex_unlock(desc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Get the counters of a calibration.
+ * @param desc - The scheduler descriptor.
+ * @param cal - Bit of the calibration in the mask.
+ * @param stats - The counters.
+ * @return 0 in case of success, -EINVAL if the calibration is not scheduled.
+ */
+int no_os_track_cal_get_stats(struct no_os_track_cal *desc, uint32_t cal,
+			      struct no_os_track_cal_stats *stats)
+{
+	if (!desc || !stats || cal >= NO_OS_TRACK_CAL_MAX ||
+	    !(desc->mask & NO_OS_BIT(cal)))
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+	*stats = desc->stats[cal];
+	no_os_mutex_unlock(desc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Clear the counters of the scheduler and of the calibrations.
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_track_cal_reset_stats(struct no_os_track_cal *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->lock);
+	desc->windows = 0;
+	desc->skipped = 0;
+	desc->pauses = 0;
+	desc->window_ns = 0;
+	if (desc->window)
+		desc->window_start = no_os_get_cycles();
+	memset(desc->stats, 0, sizeof(desc->stats));
+	no_os_mutex_unlock(desc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Let the calibrations run freely again and free the scheduler.
+ * @param desc - The scheduler descriptor.
+ * @return 0 in case of success, the error of the device otherwise, the
+ * 	   scheduler is freed in any case.
+ */
+int no_os_track_cal_remove(struct no_os_track_cal *desc)
+{
+	int ret = 0;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->running != desc->mask)
+		ret = desc->ops->run(desc->dev, desc->mask, true);
+
+	no_os_mutex_remove(desc->lock);
+	no_os_free(desc);
+
+	return ret;
+}
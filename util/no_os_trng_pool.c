@@ -0,0 +1,364 @@
+/***************************************************************************//**
+ *   @file   no_os_trng_pool.c
+ *   @brief  Buffered entropy pool and DRBG over a TRNG.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "no_os_trng_pool.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "no_os_util.h"
+
+/*
+ * The requests are served by a ChaCha20 DRBG with fast key erasure: each
+ * request generates blocks from the current key, the first 32 bytes of the
+ * first block becoming the next key and the rest being returned. The key is
+ * mixed with 32 bytes of hardware entropy at init and every
+ * NO_OS_TRNG_POOL_RESEED generated bytes. That entropy is read ahead into the
+ * pool by no_os_trng_pool_refill(), called when the system is idle, from a
+ * timer interrupt or a low priority task, so the requests don't wait for the
+ * hardware unless the pool ran dry.
+ */
+
+#define CHACHA_ROTL(v, n)	(((v) << (n)) | ((v) >> (32 - (n))))
+#define CHACHA_QR(a, b, c, d) do { \
+	a += b; d ^= a; d = CHACHA_ROTL(d, 16); \
+	c += d; b ^= c; b = CHACHA_ROTL(b, 12); \
+	a += b; d ^= a; d = CHACHA_ROTL(d, 8); \
+	c += d; b ^= c; b = CHACHA_ROTL(b, 7); \
+} while (0)
+
+/* ChaCha20 block of key with a zero nonce */
+static void no_os_trng_pool_chacha(const uint32_t *key, uint32_t counter,
+				   uint8_t *out)
+{
+	static const uint32_t sigma[4] = {
+		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
+	};
+	uint32_t in[16], x[16];
+	uint32_t i;
+
+	memcpy(in, sigma, sizeof(sigma));
+	memcpy(&in[4], key, 32);
+	in[12] = counter;
+	in[13] = 0;
+	in[14] = 0;
+	in[15] = 0;
+	memcpy(x, in, sizeof(x));
+
+	for (i = 0; i < 10; i++) {
+		CHACHA_QR(x[0], x[4], x[8], x[12]);
+		CHACHA_QR(x[1], x[5], x[9], x[13]);
+		CHACHA_QR(x[2], x[6], x[10], x[14]);
+		CHACHA_QR(x[3], x[7], x[11], x[15]);
+		CHACHA_QR(x[0], x[5], x[10], x[15]);
+		CHACHA_QR(x[1], x[6], x[11], x[12]);
+		CHACHA_QR(x[2], x[7], x[8], x[13]);
+		CHACHA_QR(x[3], x[4], x[9], x[14]);
+	}
+
+	for (i = 0; i < 16; i++)
+		no_os_put_unaligned_le32(x[i] + in[i], &out[4 * i]);
+}
+
+/* Fill buff with len bytes of the DRBG and replace its key */
+static void no_os_trng_pool_generate(struct no_os_trng_pool *pool,
+				     uint8_t *buff, uint32_t len)
+{
+	uint8_t block[64];
+	uint32_t counter = 0;
+	uint32_t n, i;
+
+	no_os_trng_pool_chacha(pool->key, counter++, block);
+	for (i = 0; i < 8; i++)
+		pool->key[i] = no_os_get_unaligned_le32(&block[4 * i]);
+
+	n = no_os_min(len, 32u);
+	memcpy(buff, &block[32], n);
+	buff += n;
+	len -= n;
+
+	while (len) {
+		no_os_trng_pool_chacha(pool->key, counter++, block);
+		n = no_os_min(len, 64u);
+		memcpy(buff, block, n);
+		buff += n;
+		len -= n;
+	}
+
+	memset(block, 0, sizeof(block));
+}
+
+/* Read len bytes of the hardware TRNG, unless the other context is reading */
+static int no_os_trng_pool_hw(struct no_os_trng_pool *pool, uint8_t *buff,
+			      uint32_t len)
+{
+	int ret;
+
+	if (pool->hw_busy) {
+		pool->stats.busy++;
+		return -EBUSY;
+	}
+
+	pool->hw_busy = true;
+	ret = no_os_trng_fill_buffer(pool->trng, buff, len);
+	pool->hw_busy = false;
+	if (ret)
+		return ret;
+
+	pool->stats.hw_bytes += len;
+
+	return 0;
+}
+
+/* Mix 32 bytes of hardware entropy in the key, from the pool if it has them */
+static int no_os_trng_pool_reseed(struct no_os_trng_pool *pool)
+{
+	uint8_t seed[NO_OS_TRNG_POOL_SEED_SIZE];
+	uint32_t n, i;
+	int ret;
+
+	n = no_os_lfring_pop(pool->ring, seed, sizeof(seed));
+	if (n < sizeof(seed)) {
+		pool->stats.waits++;
+		ret = no_os_trng_pool_hw(pool, &seed[n], sizeof(seed) - n);
+		if (ret)
+			goto out;
+	}
+
+	for (i = 0; i < 8; i++)
+		pool->key[i] ^= no_os_get_unaligned_le32(&seed[4 * i]);
+	pool->generated = 0;
+	pool->stats.reseeds++;
+	ret = 0;
+out:
+	memset(seed, 0, sizeof(seed));
+
+	return ret;
+}
+
+/**
+ * @brief Read hardware entropy into the pool. Only one context may call it at
+ * a time, it can be an interrupt preempting no_os_trng_fill_buffer().
+ * @param desc - Descriptor created with no_os_trng_pool_ops.
+ * @param max - Bytes to read at most, 0 to fill the pool.
+ * @return Bytes added, negative error code otherwise. -EBUSY if the hardware
+ * was being read by a request.
+ */
+int no_os_trng_pool_refill(struct no_os_trng_desc *desc, uint32_t max)
+{
+	struct no_os_trng_pool *pool;
+	uint8_t chunk[NO_OS_TRNG_POOL_CHUNK];
+	uint32_t room, n, added = 0;
+	int ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	pool = desc->extra;
+	room = NO_OS_TRNG_POOL_SIZE - no_os_lfring_count(pool->ring);
+	if (max)
+		room = no_os_min(room, max);
+
+	while (added < room) {
+		n = no_os_min(room - added, (uint32_t)sizeof(chunk));
+		ret = no_os_trng_pool_hw(pool, chunk, n);
+		if (ret)
+			break;
+		added += no_os_lfring_push(pool->ring, chunk, n);
+	}
+
+	memset(chunk, 0, sizeof(chunk));
+
+	return added ? (int)added : ret;
+}
+
+/**
+ * @brief Get the counters of the pool.
+ * @param desc - Descriptor created with no_os_trng_pool_ops.
+ * @param stats - The counters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_trng_pool_get_stats(struct no_os_trng_desc *desc,
+			      struct no_os_trng_pool_stats *stats)
+{
+	struct no_os_trng_pool *pool;
+
+	if (!desc || !desc->extra || !stats)
+		return -EINVAL;
+
+	pool = desc->extra;
+	*stats = pool->stats;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the hardware TRNG, fill the pool and seed the DRBG.
+ * @param desc - The TRNG descriptor.
+ * @param param - Parameters with a struct no_os_trng_pool_init_param in extra.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_init(struct no_os_trng_desc **desc,
+				const struct no_os_trng_init_param *param)
+{
+	const struct no_os_trng_pool_init_param *pparam;
+	struct no_os_trng_desc *d;
+	struct no_os_trng_pool *pool;
+	int ret;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	pparam = param->extra;
+	if (!pparam->trng)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	pool = no_os_calloc(1, sizeof(*pool));
+	if (!pool) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+	d->extra = pool;
+
+	ret = NO_OS_LFRING_INIT(&pool->ring, uint8_t, NO_OS_TRNG_POOL_SIZE,
+				false);
+	if (ret)
+		goto free_pool;
+
+	ret = no_os_trng_init(&pool->trng, pparam->trng);
+	if (ret)
+		goto free_ring;
+
+	no_os_mutex_init(&pool->lock);
+
+	ret = no_os_trng_pool_refill(d, 0);
+	if (ret < 0)
+		goto remove_trng;
+
+	ret = no_os_trng_pool_reseed(pool);
+	if (ret)
+		goto remove_trng;
+
+	*desc = d;
+
+	return 0;
+
+remove_trng:
+	no_os_mutex_remove(pool->lock);
+	no_os_trng_remove(pool->trng);
+free_ring:
+	no_os_lfring_remove(pool->ring);
+free_pool:
+	no_os_free(pool);
+free_desc:
+	no_os_free(d);
+
+	return ret;
+}
+
+/**
+ * @brief Fill buff with DRBG output, reseeding it first if it is due.
+ * @param desc - The TRNG descriptor.
+ * @param buff - Buffer to be filled.
+ * @param len - Size of the buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_fill_buffer(struct no_os_trng_desc *desc,
+				       uint8_t *buff, uint32_t len)
+{
+	struct no_os_trng_pool *pool;
+	int ret = 0;
+
+	if (!desc || !desc->extra || (!buff && len))
+		return -EINVAL;
+
+	pool = desc->extra;
+
+	no_os_mutex_lock(pool->lock);
+
+	if (pool->generated >= NO_OS_TRNG_POOL_RESEED) {
+		ret = no_os_trng_pool_reseed(pool);
+		if (ret)
+			goto out;
+	}
+
+	if (len) {
+		no_os_trng_pool_generate(pool, buff, len);
+		pool->generated += len;
+	}
+out:
+	no_os_mutex_unlock(pool->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Remove the hardware TRNG and free the pool.
+ * @param desc - The TRNG descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_remove(struct no_os_trng_desc *desc)
+{
+	struct no_os_trng_pool *pool;
+	int ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	pool = desc->extra;
+	ret = no_os_trng_remove(pool->trng);
+	if (ret)
+		return ret;
+
+	no_os_mutex_remove(pool->lock);
+	no_os_lfring_remove(pool->ring);
+	memset(pool, 0, sizeof(*pool));
+	no_os_free(pool);
+	no_os_free(desc);
+
+	return 0;
+}
+
+const struct no_os_trng_platform_ops no_os_trng_pool_ops = {
+	.init = no_os_trng_pool_init,
+	.fill_buffer = no_os_trng_pool_fill_buffer,
+	.remove = no_os_trng_pool_remove
+};
@@ -458,3 +458,152 @@ void no_os_memswap64(void *buf, uint32_t bytes, uint32_t step)
 		}
 	}
 }
+
+/*
+ * The bulk helpers below are written as plain loops over the samples so that
+ * the compiler can vectorize them (NEON on Zynq) and map the swaps to the
+ * REV/REV16 instructions of the Cortex-M4/M7.
+ */
+
+/**
+ * @brief Load a big endian word from a possibly unaligned buffer.
+ * @param buf - Buffer holding at least 4 bytes.
+ * @return The word in CPU endianness.
+ */
+static inline uint32_t _load_be32(const uint8_t *buf)
+{
+	uint32_t val;
+
+	memcpy(&val, buf, sizeof(val));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	val = __builtin_bswap32(val);
+#endif
+
+	return val;
+}
+
+/**
+ * @brief Unpack big endian 16-bit samples from a byte buffer.
+ * @param buf - Buffer holding nb * 2 bytes.
+ * @param vals - Destination, nb samples.
+ * @param nb - Number of samples.
+ * @return None.
+ */
+void no_os_get_unaligned_be16_array(const uint8_t *buf, uint32_t *vals,
+				    uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = ((uint32_t)buf[2 * i] << 8) | buf[2 * i + 1];
+}
+
+/**
+ * @brief Unpack big endian 24-bit samples from a byte buffer.
+ * Four samples are extracted from three word loads per iteration.
+ * @param buf - Buffer holding nb * 3 bytes.
+ * @param vals - Destination, nb samples.
+ * @param nb - Number of samples.
+ * @return None.
+ */
+void no_os_get_unaligned_be24_array(const uint8_t *buf, uint32_t *vals,
+				    uint32_t nb)
+{
+	uint32_t w0, w1, w2;
+
+	for (; nb >= 4; nb -= 4, buf += 12, vals += 4) {
+		w0 = _load_be32(buf);
+		w1 = _load_be32(buf + 4);
+		w2 = _load_be32(buf + 8);
+
+		vals[0] = w0 >> 8;
+		vals[1] = ((w0 & 0xFF) << 16) | (w1 >> 16);
+		vals[2] = ((w1 & 0xFFFF) << 8) | (w2 >> 24);
+		vals[3] = w2 & 0xFFFFFF;
+	}
+
+	for (; nb; nb--, buf += 3)
+		*vals++ = ((uint32_t)buf[0] << 16) | ((uint32_t)buf[1] << 8) |
+			  buf[2];
+}
+
+/**
+ * @brief Unpack big endian 32-bit samples from a byte buffer.
+ * @param buf - Buffer holding nb * 4 bytes.
+ * @param vals - Destination, nb samples.
+ * @param nb - Number of samples.
+ * @return None.
+ */
+void no_os_get_unaligned_be32_array(const uint8_t *buf, uint32_t *vals,
+				    uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = _load_be32(buf + 4 * i);
+}
+
+/**
+ * @brief Sign extend a buffer of samples in place.
+ * @param vals - Samples, the result is to be read as int32_t.
+ * @param nb - Number of samples.
+ * @param index - Position of the sign bit, as for no_os_sign_extend32().
+ * @return None.
+ */
+void no_os_sign_extend32_array(uint32_t *vals, uint32_t nb, int index)
+{
+	uint8_t shift = 31 - index;
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = (uint32_t)((int32_t)(vals[i] << shift) >> shift);
+}
+
+/**
+ * @brief Extract a field from a buffer of words in place.
+ * @param mask - Field mask, as for no_os_field_get().
+ * @param vals - Words, replaced by the field values.
+ * @param nb - Number of words.
+ * @return None.
+ */
+void no_os_field_get_array(uint32_t mask, uint32_t *vals, uint32_t nb)
+{
+	uint32_t shift;
+	uint32_t i;
+
+	if (!mask)
+		return;
+
+	shift = no_os_find_first_set_bit(mask);
+	for (i = 0; i < nb; i++)
+		vals[i] = (vals[i] & mask) >> shift;
+}
+
+/**
+ * @brief Swap the bytes of each 16-bit word of a buffer in place.
+ * @param vals - Words to swap.
+ * @param nb - Number of words.
+ * @return None.
+ */
+void no_os_bswap16_array(uint16_t *vals, uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = __builtin_bswap16(vals[i]);
+}
+
+/**
+ * @brief Swap the bytes of each 32-bit word of a buffer in place.
+ * @param vals - Words to swap.
+ * @param nb - Number of words.
+ * @return None.
+ */
+void no_os_bswap32_array(uint32_t *vals, uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = __builtin_bswap32(vals[i]);
+}
+
@@ -0,0 +1,324 @@
+/***************************************************************************//**
+ *   @file   no_os_wavegen.c
+ *   @brief  DDS waveform generator filling DAC and DMA buffers.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <errno.h>
+#include "no_os_wavegen.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+#if defined(__ARM_FEATURE_SAT)
+#include <arm_acle.h>
+#endif
+
+// sine of 512 points, offset binary, from no_os_sin_lut.c
+extern const uint16_t no_os_sine_lut_16[512];
+
+struct no_os_wavegen {
+	struct no_os_wavegen_config config; // copy of the user-provided configuration
+	uint32_t phase[NO_OS_WAVEGEN_MAX_TONES]; // next phase of each tone
+	uint32_t chirp_phase; // phase of the next sample of the sweep
+	uint32_t chirp_ftw; // tuning word of the next sample of the sweep
+};
+
+// sine of a 32-bit phase in Q15, linear interpolation between the table points
+static inline int32_t no_os_wavegen_sin(uint32_t phase)
+{
+	uint32_t idx = phase >> 23;
+	int32_t frac = (phase >> 7) & 0xFFFF;
+	int32_t a = (int32_t)no_os_sine_lut_16[idx] - 0x8000;
+	int32_t b = (int32_t)no_os_sine_lut_16[(idx + 1) & 511] - 0x8000;
+
+	return a + (((b - a) * frac) >> 16);
+}
+
+static inline int16_t no_os_wavegen_code(const struct no_os_wavegen_config *c,
+		int32_t val)
+{
+#if defined(__ARM_FEATURE_SAT)
+	val = __ssat(val, 16);
+#else
+	val = no_os_clamp(val, INT16_MIN, INT16_MAX);
+#endif
+	val >>= c->shift;
+	if (c->offset_binary)
+		val += 1 << (15 - c->shift);
+
+	return (int16_t)val;
+}
+
+/**
+ * @brief Tuning word of a frequency.
+ * @param freq_hz - Frequency of the waveform
+ * @param sample_rate_hz - Rate of the samples
+ * @return The phase increment per sample, 0 if freq_hz is not below
+ * sample_rate_hz / 2
+ */
+uint32_t no_os_wavegen_ftw(uint32_t freq_hz, uint32_t sample_rate_hz)
+{
+	if (!sample_rate_hz || freq_hz >= sample_rate_hz / 2 + sample_rate_hz % 2)
+		return 0;
+
+	return no_os_div_u64(((uint64_t)freq_hz << 32) + sample_rate_hz / 2,
+			     sample_rate_hz);
+}
+
+/**
+ * @brief Tuning word of the frequency closest to freq_hz that makes a whole
+ * number of periods in a buffer, so that the buffer can be played cyclically
+ * without a phase jump at the wrap.
+ * @param freq_hz - Frequency of the waveform
+ * @param sample_rate_hz - Rate of the samples
+ * @param nb_samples - Length of the cyclic buffer
+ * @return The phase increment per sample, 0 if freq_hz is not below
+ * sample_rate_hz / 2
+ */
+uint32_t no_os_wavegen_cyclic_ftw(uint32_t freq_hz, uint32_t sample_rate_hz,
+				  uint32_t nb_samples)
+{
+	uint64_t cycles;
+
+	if (!nb_samples || !no_os_wavegen_ftw(freq_hz, sample_rate_hz))
+		return 0;
+
+	cycles = no_os_div_u64((uint64_t)freq_hz * nb_samples +
+			       sample_rate_hz / 2, sample_rate_hz);
+
+	return no_os_div_u64((cycles << 32) + nb_samples / 2, nb_samples);
+}
+
+/**
+ * @brief Initialize a waveform generator.
+ * @param wg - Double pointer to a generator that the function allocates
+ * @param config - Waveform of the generator
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_wavegen_init(struct no_os_wavegen **wg,
+		       const struct no_os_wavegen_config *config)
+{
+	struct no_os_wavegen *w;
+	int ret;
+
+	if (!wg)
+		return -EINVAL;
+
+	w = no_os_calloc(1, sizeof(*w));
+	if (!w)
+		return -ENOMEM;
+
+	ret = no_os_wavegen_set_config(w, config);
+	if (ret) {
+		no_os_free(w);
+		return ret;
+	}
+
+	*wg = w;
+
+	return 0;
+}
+
+/**
+ * @brief Change the waveform of a generator, the next sample is the first
+ * one of the new waveform.
+ * @param wg - Generator created with no_os_wavegen_init()
+ * @param config - New waveform
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_wavegen_set_config(struct no_os_wavegen *wg,
+			     const struct no_os_wavegen_config *config)
+{
+	if (!wg || !config || config->nb_tones > NO_OS_WAVEGEN_MAX_TONES ||
+	    config->shift > 15)
+		return -EINVAL;
+
+	if (config->mode != NO_OS_WAVEGEN_TONES &&
+	    config->mode != NO_OS_WAVEGEN_CHIRP)
+		return -EINVAL;
+
+	wg->config = *config;
+
+	return no_os_wavegen_reset(wg);
+}
+
+// Both fill functions, specialized by the compiler on iq
+static inline void no_os_wavegen_gen(struct no_os_wavegen *wg, int16_t *buf,
+				     uint32_t nb_samples, uint32_t stride,
+				     bool iq)
+{
+	const struct no_os_wavegen_config *c = &wg->config;
+	const struct no_os_wavegen_chirp *ch = &c->chirp;
+	uint32_t i_ofs = iq ? NO_OS_WAVEGEN_PHASE_90 : 0;
+	bool up = ch->stop_ftw >= ch->start_ftw;
+	uint32_t span, ph, ftw, k;
+	int32_t i_val, q_val, amp;
+	unsigned int t;
+
+	if (c->mode == NO_OS_WAVEGEN_TONES) {
+		for (k = 0; k < nb_samples; k++, buf += stride) {
+			i_val = 0;
+			q_val = 0;
+			for (t = 0; t < c->nb_tones; t++) {
+				ph = wg->phase[t];
+				amp = c->tones[t].amplitude;
+				i_val += (no_os_wavegen_sin(ph + i_ofs) * amp) >> 15;
+				if (iq)
+					q_val += (no_os_wavegen_sin(ph) * amp) >> 15;
+				wg->phase[t] = ph + c->tones[t].ftw;
+			}
+			buf[0] = no_os_wavegen_code(c, i_val);
+			if (iq)
+				buf[1] = no_os_wavegen_code(c, q_val);
+		}
+
+		return;
+	}
+
+	span = up ? ch->stop_ftw - ch->start_ftw : ch->start_ftw - ch->stop_ftw;
+	ph = wg->chirp_phase;
+	ftw = wg->chirp_ftw;
+	for (k = 0; k < nb_samples; k++, buf += stride) {
+		i_val = no_os_wavegen_sin(ph + i_ofs) * ch->amplitude;
+		buf[0] = no_os_wavegen_code(c, i_val >> 15);
+		if (iq) {
+			q_val = no_os_wavegen_sin(ph) * ch->amplitude;
+			buf[1] = no_os_wavegen_code(c, q_val >> 15);
+		}
+
+		ph += ftw;
+		if (up) {
+			ftw += ch->rate;
+			if (ftw - ch->start_ftw > span)
+				ftw = ch->start_ftw;
+		} else {
+			ftw -= ch->rate;
+			if (ch->start_ftw - ftw > span)
+				ftw = ch->start_ftw;
+		}
+	}
+	wg->chirp_phase = ph;
+	wg->chirp_ftw = ftw;
+}
+
+/**
+ * @brief Write the next samples of the waveform, e.g. straight to a DMA
+ * buffer. The phase carries on from one call to the next, so a buffer can be
+ * filled in blocks or refilled while streaming.
+ * @param wg - Generator created with no_os_wavegen_init()
+ * @param buf - First sample to write
+ * @param nb_samples - Number of samples
+ * @param stride - Distance between two samples, in samples, e.g. the number
+ * of channels of an interleaved buffer
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_wavegen_fill(struct no_os_wavegen *wg, int16_t *buf,
+		       uint32_t nb_samples, uint32_t stride)
+{
+	if (!wg || !buf || !stride)
+		return -EINVAL;
+
+	no_os_wavegen_gen(wg, buf, nb_samples, stride, false);
+
+	return 0;
+}
+
+/**
+ * @brief Write the next samples of the waveform as I/Q pairs, the cosine
+ * followed by the sine, e.g. for the two channels of a complex DAC path.
+ * @param wg - Generator created with no_os_wavegen_init()
+ * @param buf - I sample of the first pair
+ * @param nb_samples - Number of pairs
+ * @param stride - Distance between two pairs, in samples, at least 2
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_wavegen_fill_iq(struct no_os_wavegen *wg, int16_t *buf,
+			  uint32_t nb_samples, uint32_t stride)
+{
+	if (!wg || !buf || stride < 2)
+		return -EINVAL;
+
+	no_os_wavegen_gen(wg, buf, nb_samples, stride, true);
+
+	return 0;
+}
+
+/**
+ * @brief Restart the waveform from the initial phases of the tones or from
+ * the start of the sweep.
+ * @param wg - Generator created with no_os_wavegen_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_wavegen_reset(struct no_os_wavegen *wg)
+{
+	unsigned int t;
+
+	if (!wg)
+		return -EINVAL;
+
+	for (t = 0; t < NO_OS_WAVEGEN_MAX_TONES; t++)
+		wg->phase[t] = wg->config.tones[t].phase;
+	wg->chirp_phase = 0;
+	wg->chirp_ftw = wg->config.chirp.start_ftw;
+
+	return 0;
+}
+
+/**
+ * @brief Free a waveform generator.
+ * @param wg - Generator created with no_os_wavegen_init()
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid input
+ */
+int no_os_wavegen_remove(struct no_os_wavegen *wg)
+{
+	if (!wg)
+		return -EINVAL;
+
+	no_os_free(wg);
+
+	return 0;
+}
@@ -0,0 +1,162 @@
+/***************************************************************************//**
+ *   @file   no_os_work.c
+ *   @brief  Allocation free, priority ordered deferred work queue.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "no_os_work.h"
+#include "no_os_mutex.h"
+#include "no_os_error.h"
+
+/**
+ * @brief Queue a work to be run by no_os_workqueue_run(), after the pending
+ * works of the same or a higher priority. Posting a work that is already
+ * pending does nothing, so events posted faster than they are served are
+ * coalesced. Safe to call from interrupts.
+ * @param wq - Work queue.
+ * @param work - Work, its memory must stay valid until it runs.
+ * @return 0 on success, negative error code otherwise.
+ */
+int no_os_work_post(struct no_os_workqueue *wq, struct no_os_work *work)
+{
+	struct no_os_work **pos;
+	uint32_t state;
+
+	if (!wq || !work || !work->func)
+		return -EINVAL;
+
+	state = no_os_critical_enter();
+
+	if (work->pending) {
+		no_os_critical_exit(state);
+		return 0;
+	}
+
+#ifdef NO_OS_PROFILING
+	work->posted = no_os_get_cycles();
+#endif
+	for (pos = &wq->head; *pos && (*pos)->prio <= work->prio;
+	     pos = &(*pos)->next)
+		;
+	work->next = *pos;
+	*pos = work;
+	work->pending = true;
+
+	no_os_critical_exit(state);
+
+	if (wq->notify)
+		wq->notify(wq->notify_ctx);
+
+	return 0;
+}
+
+/**
+ * @brief Remove a work from the queue if it did not run yet.
+ * @param wq - Work queue.
+ * @param work - Work.
+ * @return 0 on success, -ENOENT if the work was not pending.
+ */
+int no_os_work_cancel(struct no_os_workqueue *wq, struct no_os_work *work)
+{
+	struct no_os_work **pos;
+	uint32_t state;
+	int ret = -ENOENT;
+
+	if (!wq || !work)
+		return -EINVAL;
+
+	state = no_os_critical_enter();
+
+	for (pos = &wq->head; *pos; pos = &(*pos)->next) {
+		if (*pos == work) {
+			*pos = work->next;
+			work->pending = false;
+			ret = 0;
+			break;
+		}
+	}
+
+	no_os_critical_exit(state);
+
+	return ret;
+}
+
+/**
+ * @brief Run the pending works, highest priority first. A work posted while
+ * the queue runs, including by a running work, is run in the same call.
+ * @param wq - Work queue.
+ * @return The number of works run or negative error code.
+ */
+int no_os_workqueue_run(struct no_os_workqueue *wq)
+{
+	struct no_os_work *work;
+	uint32_t state;
+	int cnt = 0;
+
+	if (!wq)
+		return -EINVAL;
+
+	while (wq->head) {
+		state = no_os_critical_enter();
+		work = wq->head;
+		if (work) {
+			wq->head = work->next;
+			work->pending = false;
+		}
+		no_os_critical_exit(state);
+
+		if (!work)
+			break;
+
+#ifdef NO_OS_PROFILING
+		no_os_profile_add(&wq->latency, no_os_get_cycles() - work->posted);
+#endif
+		work->func(work);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+/**
+ * @brief Check whether a work is pending, e.g. before sleeping.
+ * @param wq - Work queue.
+ * @return true if no_os_workqueue_run() has work to run.
+ */
+bool no_os_workqueue_pending(struct no_os_workqueue *wq)
+{
+	return wq && wq->head;
+}